@@ -15,6 +15,17 @@ python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/full_testbench/config
 python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/full_testbench/fast_configuration_chain --debug --show_thread_logs
 python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/preconfig_testbench/configuration_chain --debug --show_thread_logs
 
+echo -e "Testing bitstream loaded from a memory file by the full testbench of a K4N4 FPGA";
+python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/full_testbench/readmem_configuration_chain --debug --show_thread_logs
+python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/full_testbench/readmem_configuration_frame --debug --show_thread_logs
+python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/full_testbench/readmem_memory_bank --debug --show_thread_logs
+
+echo -e "Testing configuration chain of a K4N4 FPGA loaded from a compressed bitstream";
+python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/full_testbench/compressed_configuration_chain --debug --show_thread_logs
+
+echo -e "Testing configuration chains of multiple regions of a K4N4 FPGA";
+python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/full_testbench/multi_region_configuration_chain --debug --show_thread_logs
+
 echo -e "Testing fram-based configuration protocol of a K4N4 FPGA";
 python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/full_testbench/configuration_frame --debug --show_thread_logs
 python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/full_testbench/fast_configuration_frame --debug --show_thread_logs
@@ -25,6 +36,10 @@ python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/full_testbench/memory
 python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/full_testbench/fast_memory_bank --debug --show_thread_logs
 python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/preconfig_testbench/memory_bank --debug --show_thread_logs
 
+echo -e "Testing memory bank configuration protocol with word writes of a K4N4 FPGA";
+python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/full_testbench/word_memory_bank --debug --show_thread_logs
+python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/full_testbench/word_fast_memory_bank --debug --show_thread_logs
+
 echo -e "Testing standalone (flatten memory) configuration protocol of a K4N4 FPGA";
 python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/full_testbench/flatten_memory --debug --show_thread_logs
 python3 openfpga_flow/scripts/run_fpga_task.py basic_tests/preconfig_testbench/flatten_memory --debug --show_thread_logs
@@ -20,7 +20,35 @@ python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/generate_bitstream
 echo -e "Testing bitstream generation for an 96x96 FPGA device";
 python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/generate_bitstream/device_96x96 --debug --show_thread_logs
 
+echo -e "Testing bitstream generation with multiple threads";
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/parallel_bitstream --debug --show_thread_logs
+
+echo -e "Testing repacking with the A* search in fracturable logic tiles";
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/repack_astar --debug --show_thread_logs
+
+echo -e "Testing bitstream update of a few grids and routing blocks";
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/update_bitstream --debug --show_thread_logs
+
 echo -e "Testing loading architecture bitstream from an external file";
 python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/load_external_architecture_bitstream --debug --show_thread_logs
 
+echo -e "Testing fabric bitstream streamed to a file for a configuration chain";
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/stream_fabric_bitstream --debug --show_thread_logs
+
+echo -e "Testing binary fabric bitstream of each configuration protocol";
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/binary_fabric_bitstream/configuration_chain --debug --show_thread_logs
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/binary_fabric_bitstream/configuration_frame --debug --show_thread_logs
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/binary_fabric_bitstream/memory_bank --debug --show_thread_logs
+
+echo -e "Testing partial fabric bitstream of frame-based and memory bank protocols";
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/partial_fabric_bitstream/configuration_frame --debug --show_thread_logs
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/partial_fabric_bitstream/memory_bank --debug --show_thread_logs
+
+echo -e "Testing saving and restoring a checkpoint of OpenFPGA context";
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/context_checkpoint/save_context --debug --show_thread_logs
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/context_checkpoint/load_context --debug --show_thread_logs
+
+echo -e "Testing the performance of bitstream generation for each configuration protocol and fabric size";
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/performance --debug --show_thread_logs
+
 end_section "OpenFPGA.TaskTun"
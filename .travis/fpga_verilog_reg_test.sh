@@ -55,6 +55,9 @@ python3 openfpga_flow/scripts/run_fpga_task.py fpga_verilog/mux_design/stdcell_m
 echo -e "Testing Verilog generation with routing multiplexers implemented by local encoders";
 python3 openfpga_flow/scripts/run_fpga_task.py fpga_verilog/mux_design/local_encoder --debug --show_thread_logs
 
+echo -e "Testing Verilog generation for routing multiplexers as parameterized modules";
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_verilog/mux_design/parameterized_mux --debug --show_thread_logs
+
 echo -e "Testing Verilog generation with behavioral description";
 python3 openfpga_flow/scripts/run_fpga_task.py fpga_verilog/behavioral_verilog --debug --show_thread_logs
 
@@ -81,6 +84,12 @@ python3 openfpga_flow/scripts/run_fpga_task.py fpga_verilog/power_gated_design/p
 echo -e "Testing Depopulated crossbar in local routing";
 python3 openfpga_flow/scripts/run_fpga_task.py fpga_verilog/depopulate_crossbar --debug --show_thread_logs
 
+echo -e "Testing incremental writing of fabric netlists";
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_verilog/incremental_verilog --debug --show_thread_logs
+
+echo -e "Testing compact top-level module with instance arrays";
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_verilog/compact_top_module --debug --show_thread_logs
+
 # Verify MCNC big20 benchmark suite with ModelSim 
 # Please make sure you have ModelSim installed in the environment
 # Otherwise, it will fail
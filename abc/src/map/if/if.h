@@ -102,6 +102,7 @@ struct If_Par_t_
     // user-controlable parameters
     int                nLutSize;      // the LUT size
     int                nCutsMax;      // the max number of cuts
+    int                nProcNum;      // the number of threads used for cut enumeration
     int                nFlowIters;    // the number of iterations of area recovery
     int                nAreaIters;    // the number of iterations of area recovery
     int                nGateSize;     // the max size of the AND/OR gate to map into
@@ -241,6 +242,7 @@ struct If_Man_t_
     If_Set_t *         pMemCi;        // memory for CI cutsets
     If_Set_t *         pMemAnd;       // memory for AND cutsets
     If_Set_t *         pFreeList;     // the list of free cutsets
+    Vec_Ptr_t *        vMemSets;      // memory for cutsets added by If_ManSetupSetReserve()
     int                nSmallSupp;    // the small support
     int                nCutsTotal;
     int                nCutsUseless[32];
@@ -627,11 +629,16 @@ extern If_Set_t *      If_ManSetupNodeCutSet( If_Man_t * p, If_Obj_t * pObj );
 extern void            If_ManDerefNodeCutSet( If_Man_t * p, If_Obj_t * pObj );
 extern void            If_ManDerefChoiceCutSet( If_Man_t * p, If_Obj_t * pObj );
 extern void            If_ManSetupSetAll( If_Man_t * p, int nCrossCut );
+extern void            If_ManSetupSetReserve( If_Man_t * p, int nCutSets );
 /*=== ifMap.c =============================================================*/
 extern int *           If_CutArrTimeProfile( If_Man_t * p, If_Cut_t * pCut );
+extern int             If_ObjPerformMappingAndInt( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess, int fFirst );
 extern void            If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess, int fFirst );
+extern void            If_ObjPerformMappingChoiceInt( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess );
 extern void            If_ObjPerformMappingChoice( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess );
 extern int             If_ManPerformMappingRound( If_Man_t * p, int nCutsUsed, int Mode, int fPreprocess, int fFirst, char * pLabel );
+/*=== ifPth.c =============================================================*/
+extern int             If_ManPerformMappingNodesMt( If_Man_t * p, int Mode, int fPreprocess, int fFirst );
 /*=== ifReduce.c ==========================================================*/
 extern void            If_ManImproveMapping( If_Man_t * p );
 /*=== ifSat.c ==========================================================*/
@@ -49,6 +49,7 @@ void If_ManSetDefaultPars( If_Par_t * pPars )
     memset( pPars, 0, sizeof(If_Par_t) );
     pPars->nLutSize    = -1;
     pPars->nCutsMax    =  8;
+    pPars->nProcNum    =  1;
     pPars->nFlowIters  =  1;
     pPars->nAreaIters  =  2;
     pPars->DelayTarget = -1;
@@ -286,6 +286,8 @@ void If_ManStop( If_Man_t * p )
     Mem_FixedStop( p->pMemObj, 0 );
     ABC_FREE( p->pMemCi );
     ABC_FREE( p->pMemAnd );
+    if ( p->vMemSets )
+        Vec_PtrFreeFree( p->vMemSets );
     ABC_FREE( p->puTemp[0] );
     ABC_FREE( p->puTempW );
     // free pars memory
@@ -711,6 +713,41 @@ void If_ManSetupSetAll( If_Man_t * p, int nCrossCut )
 
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Makes sure that the given number of cutsets is free.]
+
+  Description [The memory allocated by If_ManSetupSetAll() is enough when 
+  the nodes are mapped in the topological order. Other orders may keep 
+  more cutsets at the same time, so more memory is allocated if needed.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void If_ManSetupSetReserve( If_Man_t * p, int nCutSets )
+{
+    If_Set_t * pCutSet;
+    char * pArray;
+    int i, nFree = 0;
+    for ( pCutSet = p->pFreeList; pCutSet && nFree < nCutSets; pCutSet = pCutSet->pNext )
+        nFree++;
+    if ( nFree == nCutSets )
+        return;
+    nCutSets = Abc_MaxInt( nCutSets - nFree, 128 );
+    pArray = ABC_ALLOC( char, nCutSets * p->nSetBytes );
+    if ( p->vMemSets == NULL )
+        p->vMemSets = Vec_PtrAlloc( 16 );
+    Vec_PtrPush( p->vMemSets, pArray );
+    for ( i = 0; i < nCutSets; i++ )
+    {
+        pCutSet = (If_Set_t *)(pArray + i * p->nSetBytes);
+        If_ManSetupSet( p, pCutSet );
+        If_ManCutSetRecycle( p, pCutSet );
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
 ////////////////////////////////////////////////////////////////////////
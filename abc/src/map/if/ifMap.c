@@ -150,22 +150,26 @@ int * If_CutArrTimeProfile( If_Man_t * p, If_Cut_t * pCut )
 
 /**Function*************************************************************
 
-  Synopsis    [Finds the best cut for the given node.]
+  Synopsis    [Computes the cuts of the node and finds its best cut.]
 
-  Description [Mapping modes: delay (0), area flow (1), area (2).]
+  Description [Mapping modes: delay (0), area flow (1), area (2).
+  Expects the cutset of the node to be prepared. Does not reference
+  the best cut and does not free the cutsets, so that, in the delay
+  mode, the nodes whose fanins are mapped can be processed concurrently.
+  Returns the number of merged cuts.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-void If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess, int fFirst )
+int If_ObjPerformMappingAndInt( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess, int fFirst )
 {
-    If_Set_t * pCutSet;
+    If_Set_t * pCutSet = pObj->pCutSet;
     If_Cut_t * pCut0, * pCut1, * pCut;
     If_Cut_t * pCut0R, * pCut1R;
     int fFunc0R, fFunc1R;
-    int i, k, v, iCutDsd, fChange;
+    int i, k, v, iCutDsd, fChange, nCutsMerged = 0;
     int fSave0 = p->pPars->fDelayOpt || p->pPars->fDelayOptLut || p->pPars->fDsdBalance || p->pPars->fUserRecLib || p->pPars->fUserSesLib || 
         p->pPars->fUseDsdTune || p->pPars->fUseCofVars || p->pPars->fUseAndVars || p->pPars->fUse34Spec || p->pPars->pLutStruct || p->pPars->pFuncCell2;
     int fUseAndCut = (p->pPars->nAndDelay > 0) || (p->pPars->nAndArea > 0);
@@ -177,12 +181,6 @@ void If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPrep
         pObj->EstRefs = (float)pObj->nRefs;
     else if ( Mode == 1 )
         pObj->EstRefs = (float)((2.0 * pObj->EstRefs + pObj->nRefs) / 3.0);
-    // deref the selected cut
-    if ( Mode && pObj->nRefs > 0 )
-        If_CutAreaDeref( p, If_ObjCutBest(pObj) );
-
-    // prepare the cutset
-    pCutSet = If_ManSetupNodeCutSet( p, pObj );
 
     // get the current assigned best cut
     pCut = If_ObjCutBest(pObj);
@@ -266,8 +264,7 @@ void If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPrep
         }
         if ( pObj->fSpec && pCut->nLeaves == (unsigned)p->pPars->nLutSize )
             continue;
-        p->nCutsMerged++;
-        p->nCutsTotal++;
+        nCutsMerged++;
         // check if this cut is contained in any of the available cuts
         if ( !p->pPars->fSkipCutFilter && If_CutFilter( pCutSet, pCut, fSave0 ) )
             continue;
@@ -475,6 +472,35 @@ void If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPrep
 //        p->nBestCutSmall[0]++;
 //    else if ( If_ObjCutBest(pObj)->nLeaves == 1 )
 //        p->nBestCutSmall[1]++;
+    return nCutsMerged;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Finds the best cut for the given node.]
+
+  Description [Mapping modes: delay (0), area flow (1), area (2).]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess, int fFirst )
+{
+    If_Cut_t * pCut;
+    int i, nCutsMerged;
+    // deref the selected cut
+    if ( Mode && pObj->nRefs > 0 )
+        If_CutAreaDeref( p, If_ObjCutBest(pObj) );
+
+    // prepare the cutset
+    If_ManSetupNodeCutSet( p, pObj );
+
+    // compute the cuts
+    nCutsMerged = If_ObjPerformMappingAndInt( p, pObj, Mode, fPreprocess, fFirst );
+    p->nCutsMerged += nCutsMerged;
+    p->nCutsTotal  += nCutsMerged;
 
     // ref the selected cut
     if ( Mode && pObj->nRefs > 0 )
@@ -491,16 +517,17 @@ void If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPrep
 
 /**Function*************************************************************
 
-  Synopsis    [Finds the best cut for the choice node.]
+  Synopsis    [Merges the cuts of the choice class and finds its best cut.]
 
-  Description []
+  Description [Does not reference the best cut and does not free the
+  cutsets, similar to If_ObjPerformMappingAndInt().]
                
-  SideEffects []
+  SideEffects [Removes the elementary cuts of the nodes of the class.]
 
   SeeAlso     []
 
 ***********************************************************************/
-void If_ObjPerformMappingChoice( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess )
+void If_ObjPerformMappingChoiceInt( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess )
 {
     If_Set_t * pCutSet;
     If_Obj_t * pTemp;
@@ -508,10 +535,6 @@ void If_ObjPerformMappingChoice( If_Man_t * p, If_Obj_t * pObj, int Mode, int fP
     int i, fSave0 = p->pPars->fDelayOpt || p->pPars->fDelayOptLut || p->pPars->fDsdBalance || p->pPars->fUserRecLib || p->pPars->fUserSesLib || p->pPars->fUse34Spec;
     assert( pObj->pEquiv != NULL );
 
-    // prepare
-    if ( Mode && pObj->nRefs > 0 )
-        If_CutAreaDeref( p, If_ObjCutBest(pObj) );
-
     // remove elementary cuts
     for ( pTemp = pObj; pTemp; pTemp = pTemp->pEquiv )
         pTemp->pCutSet->nCuts--;
@@ -565,6 +588,27 @@ void If_ObjPerformMappingChoice( If_Man_t * p, If_Obj_t * pObj, int Mode, int fP
         If_ManSetupCutTriv( p, pCutSet->ppCuts[pCutSet->nCuts++], pObj->Id );
         assert( pCutSet->nCuts <= pCutSet->nCutsMax+1 );
     }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Finds the best cut for the choice node.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void If_ObjPerformMappingChoice( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess )
+{
+    // prepare
+    if ( Mode && pObj->nRefs > 0 )
+        If_CutAreaDeref( p, If_ObjCutBest(pObj) );
+
+    // compute the cuts
+    If_ObjPerformMappingChoiceInt( p, pObj, Mode, fPreprocess );
 
     // ref the selected cut
     if ( Mode && pObj->nRefs > 0 )
@@ -637,7 +681,7 @@ int If_ManPerformMappingRound( If_Man_t * p, int nCutsUsed, int Mode, int fPrepr
         }
 //        Tim_ManPrint( p->pManTim );
     }
-    else
+    else if ( !If_ManPerformMappingNodesMt( p, Mode, fPreprocess, fFirst ) )
     {
         pProgress = Extra_ProgressBarStart( stdout, If_ManObjNum(p) );
         If_ManForEachNode( p, pObj, i )
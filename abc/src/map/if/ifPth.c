@@ -0,0 +1,346 @@
+/**CFile****************************************************************
+
+  FileName    [ifPth.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [FPGA mapping based on priority cuts.]
+
+  Synopsis    [Multi-threaded cut enumeration.]
+
+  Author      []
+
+  Affiliation []
+
+  Date        [Ver. 1.0. Started - October 14, 2026.]
+
+  Revision    [$Id: ifPth.c,v 1.00 2026/10/14 00:00:00 Exp $]
+
+***********************************************************************/
+
+#include "if.h"
+
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#endif
+
+ABC_NAMESPACE_IMPL_START
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef ABC_USE_PTHREADS
+
+int If_ManPerformMappingNodesMt( If_Man_t * p, int Mode, int fPreprocess, int fFirst ) { return 0; }
+
+#else // pthreads are used
+
+#define IF_PROC_MAX      64   // the max number of threads
+#define IF_PROC_TASKS    64   // the min number of nodes in a level mapped by the threads
+
+/*
+    The nodes are mapped level by level, where the level of a node is computed
+    from the steps it waits for: the mapping of its fanins and the choice steps
+    (If_ObjPerformMappingChoiceInt) of the classes of its fanins, which remove
+    the elementary cuts of the nodes of the class. As in the topological order,
+    a node sees the cuts of a fanin after the choice step only if its class
+    representative precedes the node; otherwise, the choice step waits for the node.
+    The nodes of one level only update themselves, so the mapping does not depend
+    on the number of threads and is the same as the mapping in the topological order.
+    The cutsets are prepared and freed by the main thread in the order of the nodes.
+*/
+
+typedef struct If_Pth_t_ If_Pth_t;
+typedef struct If_ThData_t_ If_ThData_t;
+struct If_ThData_t_
+{
+    If_Pth_t *      pPth;
+    int             iThread;       // the index of the thread
+    int             nCutsMerged;   // the number of cuts merged by the thread
+};
+struct If_Pth_t_
+{
+    If_Man_t *      pMan;
+    int             Mode;          // the mapping mode
+    int             fPreprocess;
+    int             fFirst;
+    int             nProcs;        // the number of threads, including the main one
+    Vec_Int_t *     vLevel;        // the nodes of the current level
+    int             nRounds;       // the number of levels started
+    int             nBusy;         // the number of threads mapping the current level
+    int             fStop;         // set to 1 when the threads should exit
+    pthread_mutex_t Mutex;
+    pthread_cond_t  CondStart;
+    pthread_cond_t  CondDone;
+    If_ThData_t     ThData[IF_PROC_MAX];
+};
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Returns 1 if the nodes can be mapped concurrently.]
+
+  Description [Computing the cost of a cut with the truth tables, the user
+  functions or the timing manager uses the shared data of the manager, and
+  the area recovery modes update the references of the fanin cones.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int If_ManMappingNodesMtIsUsable( If_Man_t * p, int Mode )
+{
+    If_Par_t * pPars = p->pPars;
+    if ( pPars->nProcNum < 2 || Mode != 0 || p->pManTim != NULL )
+        return 0;
+    if ( pPars->fTruth || pPars->fUseTtPerm || pPars->fDelayOpt || pPars->fDelayOptLut || pPars->fDsdBalance ||
+         pPars->fUserRecLib || pPars->fUserSesLib || pPars->nGateSize > 0 || pPars->fLiftLeaves ||
+         pPars->pFuncCost || pPars->pFuncUser )
+        return 0;
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Groups the mapping steps by level.]
+
+  Description [Returns the steps of each level, in the topological order.
+  A step is the literal of the node, which is complemented for the choice
+  step of a class representative.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static Vec_Wec_t * If_ManMappingNodesMtLevels( If_Man_t * p )
+{
+    Vec_Wec_t * vLevels = Vec_WecAlloc( p->nLevelMax + 2 );
+    Vec_Int_t * vRepr   = Vec_IntStartFull( If_ManObjNum(p) ); // the class representative of the node
+    Vec_Int_t * vReady  = Vec_IntStart( If_ManObjNum(p) );     // the level after which the cutset is read
+    Vec_Int_t * vReader = Vec_IntStart( If_ManObjNum(p) );     // the last level reading the cutset before the choice step
+    If_Obj_t * pObj, * pFanin, * pTemp;
+    int i, k, Level;
+    If_ManForEachNode( p, pObj, i )
+        if ( pObj->fRepr )
+            for ( pTemp = pObj; pTemp; pTemp = pTemp->pEquiv )
+            {
+                assert( pTemp->Id <= pObj->Id );
+                Vec_IntWriteEntry( vRepr, pTemp->Id, pObj->Id );
+            }
+    If_ManForEachNode( p, pObj, i )
+    {
+        // the node is mapped after its fanins
+        Level = 1 + Abc_MaxInt( Vec_IntEntry(vReady, If_ObjFanin0(pObj)->Id), Vec_IntEntry(vReady, If_ObjFanin1(pObj)->Id) );
+        Vec_IntWriteEntry( vReady, pObj->Id, Level );
+        Vec_WecPush( vLevels, Level, Abc_Var2Lit(pObj->Id, 0) );
+        // the choice step of a fanin coming later waits for the node
+        for ( k = 0; k < 2; k++ )
+        {
+            pFanin = k ? If_ObjFanin1(pObj) : If_ObjFanin0(pObj);
+            if ( Vec_IntEntry(vRepr, pFanin->Id) > pObj->Id )
+                Vec_IntWriteEntry( vReader, pFanin->Id, Abc_MaxInt(Vec_IntEntry(vReader, pFanin->Id), Level) );
+        }
+        if ( !pObj->fRepr )
+            continue;
+        // the choice step follows the nodes of the class and their readers
+        Level = 0;
+        for ( pTemp = pObj; pTemp; pTemp = pTemp->pEquiv )
+            Level = Abc_MaxInt( Level, Abc_MaxInt(Vec_IntEntry(vReady, pTemp->Id), Vec_IntEntry(vReader, pTemp->Id)) );
+        Level++;
+        for ( pTemp = pObj; pTemp; pTemp = pTemp->pEquiv )
+            Vec_IntWriteEntry( vReady, pTemp->Id, Level );
+        Vec_WecPush( vLevels, Level, Abc_Var2Lit(pObj->Id, 1) );
+    }
+    Vec_IntFree( vRepr );
+    Vec_IntFree( vReady );
+    Vec_IntFree( vReader );
+    return vLevels;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Performs the mapping steps of the level assigned to the thread.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void If_ManMappingNodesMtPerform( If_Pth_t * pPth, If_ThData_t * pThData, int nThreads )
+{
+    If_Man_t * p = pPth->pMan;
+    If_Obj_t * pObj;
+    int i, Step;
+    for ( i = pThData->iThread; i < Vec_IntSize(pPth->vLevel); i += nThreads )
+    {
+        Step = Vec_IntEntry( pPth->vLevel, i );
+        pObj = If_ManObj( p, Abc_Lit2Var(Step) );
+        if ( Abc_LitIsCompl(Step) )
+            If_ObjPerformMappingChoiceInt( p, pObj, pPth->Mode, pPth->fPreprocess );
+        else
+            pThData->nCutsMerged += If_ObjPerformMappingAndInt( p, pObj, pPth->Mode, pPth->fPreprocess, pPth->fFirst );
+    }
+}
+void * If_ManMappingNodesMtWorker( void * pArg )
+{
+    If_ThData_t * pThData = (If_ThData_t *)pArg;
+    If_Pth_t * pPth = pThData->pPth;
+    int nRounds = 0, status;
+    while ( 1 )
+    {
+        status = pthread_mutex_lock( &pPth->Mutex );  assert( status == 0 );
+        while ( pPth->nRounds == nRounds && !pPth->fStop )
+            pthread_cond_wait( &pPth->CondStart, &pPth->Mutex );
+        nRounds = pPth->nRounds;
+        if ( pPth->fStop )
+        {
+            status = pthread_mutex_unlock( &pPth->Mutex );  assert( status == 0 );
+            return NULL;
+        }
+        status = pthread_mutex_unlock( &pPth->Mutex );  assert( status == 0 );
+        If_ManMappingNodesMtPerform( pPth, pThData, pPth->nProcs );
+        status = pthread_mutex_lock( &pPth->Mutex );  assert( status == 0 );
+        if ( --pPth->nBusy == 0 )
+            pthread_cond_signal( &pPth->CondDone );
+        status = pthread_mutex_unlock( &pPth->Mutex );  assert( status == 0 );
+    }
+    assert( 0 );
+    return NULL;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Maps the nodes of one level.]
+
+  Description [Small levels are mapped by the main thread.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void If_ManMappingNodesMtLevel( If_Pth_t * pPth, Vec_Int_t * vLevel )
+{
+    int status;
+    pPth->vLevel = vLevel;
+    if ( Vec_IntSize(vLevel) < IF_PROC_TASKS )
+    {
+        If_ManMappingNodesMtPerform( pPth, pPth->ThData, 1 );
+        return;
+    }
+    status = pthread_mutex_lock( &pPth->Mutex );  assert( status == 0 );
+    pPth->nBusy = pPth->nProcs - 1;
+    pPth->nRounds++;
+    pthread_cond_broadcast( &pPth->CondStart );
+    status = pthread_mutex_unlock( &pPth->Mutex );  assert( status == 0 );
+    If_ManMappingNodesMtPerform( pPth, pPth->ThData, pPth->nProcs );
+    status = pthread_mutex_lock( &pPth->Mutex );  assert( status == 0 );
+    while ( pPth->nBusy > 0 )
+        pthread_cond_wait( &pPth->CondDone, &pPth->Mutex );
+    status = pthread_mutex_unlock( &pPth->Mutex );  assert( status == 0 );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Maps the internal nodes using several threads.]
+
+  Description [Returns 0 if the mapping parameters require the nodes
+  to be mapped in the topological order, in which case nothing is done.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int If_ManPerformMappingNodesMt( If_Man_t * p, int Mode, int fPreprocess, int fFirst )
+{
+    pthread_t WorkerThread[IF_PROC_MAX];
+    If_Pth_t Pth, * pPth = &Pth;
+    Vec_Wec_t * vLevels;
+    Vec_Int_t * vLevel;
+    If_Obj_t * pObj;
+    int i, k, Step, status;
+    if ( !If_ManMappingNodesMtIsUsable( p, Mode ) )
+        return 0;
+    vLevels = If_ManMappingNodesMtLevels( p );
+    // start the threads
+    memset( pPth, 0, sizeof(If_Pth_t) );
+    pPth->pMan        = p;
+    pPth->Mode        = Mode;
+    pPth->fPreprocess = fPreprocess;
+    pPth->fFirst      = fFirst;
+    pPth->nProcs      = Abc_MinInt( p->pPars->nProcNum, IF_PROC_MAX );
+    status = pthread_mutex_init( &pPth->Mutex, NULL );     assert( status == 0 );
+    status = pthread_cond_init( &pPth->CondStart, NULL );  assert( status == 0 );
+    status = pthread_cond_init( &pPth->CondDone, NULL );   assert( status == 0 );
+    for ( i = 0; i < pPth->nProcs; i++ )
+    {
+        pPth->ThData[i].pPth = pPth;
+        pPth->ThData[i].iThread = i;
+        if ( i == 0 ) // the main thread
+            continue;
+        status = pthread_create( WorkerThread + i, NULL, If_ManMappingNodesMtWorker, (void *)(pPth->ThData + i) );  assert( status == 0 );
+    }
+    // map the levels
+    Vec_WecForEachLevel( vLevels, vLevel, i )
+    {
+        // prepare the cutsets
+        If_ManSetupSetReserve( p, Vec_IntSize(vLevel) );
+        Vec_IntForEachEntry( vLevel, Step, k )
+            if ( !Abc_LitIsCompl(Step) )
+                If_ManSetupNodeCutSet( p, If_ManObj(p, Abc_Lit2Var(Step)) );
+        If_ManMappingNodesMtLevel( pPth, vLevel );
+        // free the cutsets that are no longer read
+        Vec_IntForEachEntry( vLevel, Step, k )
+        {
+            pObj = If_ManObj( p, Abc_Lit2Var(Step) );
+            if ( Abc_LitIsCompl(Step) )
+                If_ManDerefChoiceCutSet( p, pObj );
+            else
+                If_ManDerefNodeCutSet( p, pObj );
+        }
+    }
+    // stop the threads
+    status = pthread_mutex_lock( &pPth->Mutex );  assert( status == 0 );
+    pPth->fStop = 1;
+    pthread_cond_broadcast( &pPth->CondStart );
+    status = pthread_mutex_unlock( &pPth->Mutex );  assert( status == 0 );
+    for ( i = 1; i < pPth->nProcs; i++ )
+    {
+        status = pthread_join( WorkerThread[i], NULL );  assert( status == 0 );
+    }
+    for ( i = 0; i < pPth->nProcs; i++ )
+    {
+        p->nCutsMerged += pPth->ThData[i].nCutsMerged;
+        p->nCutsTotal  += pPth->ThData[i].nCutsMerged;
+    }
+    pthread_cond_destroy( &pPth->CondDone );
+    pthread_cond_destroy( &pPth->CondStart );
+    pthread_mutex_destroy( &pPth->Mutex );
+    Vec_WecFree( vLevels );
+    return 1;
+}
+
+#endif // pthreads are used
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
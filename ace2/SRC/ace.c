@@ -4,6 +4,9 @@
 
 #include <stdio.h>
 #include <inttypes.h>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 #include "ace.h"
 #include "io_ace.h"
@@ -25,7 +28,11 @@ void alloc_and_init_activity_info(Abc_Ntk_t * ntk);
 void ace_update_latch_probs(Abc_Ntk_t * ntk);
 void print_node_bdd(Abc_Ntk_t * ntk);
 void print_nodes(Vec_Ptr_t * nodes);
-int ace_calc_activity(Abc_Ntk_t * ntk, int num_vectors, char * clk_name);
+void ace_calc_node_switch_act(Abc_Ntk_t * ntk, Abc_Obj_t * obj);
+void ace_calc_logic_switch_acts(Abc_Ntk_t * ntk, Vec_Ptr_t * nodes_logic,
+		int num_threads);
+int ace_calc_activity(Abc_Ntk_t * ntk, int num_vectors, char * clk_name,
+		int num_threads);
 
 st__table * ace_info_hash_table;
 
@@ -143,14 +150,76 @@ void print_nodes(Vec_Ptr_t * nodes) {
 	fflush(0);
 }
 
-int ace_calc_activity(Abc_Ntk_t * ntk, int num_vectors, char * clk_name) {
+void ace_calc_node_switch_act(Abc_Ntk_t * ntk, Abc_Obj_t * obj) {
+	Ace_Obj_Info_t * info = Ace_ObjInfo(obj);
+	int j;
+
+	VTR_ASSERT(Abc_ObjType(obj) == ABC_OBJ_NODE);
+
+	if (Abc_ObjFaninNum(obj) < 1) {
+		info->switch_act = 0.0;
+		return;
+	} else {
+		Vec_Ptr_t * literals = Vec_PtrAlloc(0);
+		Abc_Obj_t * fanin;
+
+		VTR_ASSERT(obj->Type == ABC_OBJ_NODE);
+
+		Abc_ObjForEachFanin(obj, fanin, j)
+		{
+			Vec_PtrPush(literals, fanin);
+		}
+		info->switch_act = ace_bdd_calc_switch_act((DdManager*)ntk->pManFunc, obj,
+				literals);
+		Vec_PtrFree(literals);
+	}
+	VTR_ASSERT(info->switch_act >= 0);
+}
+
+/* The switching activity of a logic node only depends on the probabilities
+ * of its fanins, which are no longer modified at this stage.
+ * Therefore, the nodes can be computed in any order by a number of threads,
+ * and the activities are the same as computing them one by one */
+void ace_calc_logic_switch_acts(Abc_Ntk_t * ntk, Vec_Ptr_t * nodes_logic,
+		int num_threads) {
+	Abc_Obj_t * obj;
+	int i;
+
+	if (num_threads < 2) {
+		Vec_PtrForEachEntry(Abc_Obj_t*, nodes_logic, obj, i)
+		{
+			ace_calc_node_switch_act(ntk, obj);
+		}
+		return;
+	}
+
+	std::atomic<int> next_node(0);
+	auto calc_switch_acts = [&]() {
+		int inode;
+		while ((inode = next_node.fetch_add(1)) < Vec_PtrSize(nodes_logic)) {
+			ace_calc_node_switch_act(ntk, (Abc_Obj_t*) Vec_PtrEntry(nodes_logic, inode));
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (i = 1; i < num_threads; i++) {
+		threads.push_back(std::thread(calc_switch_acts));
+	}
+	calc_switch_acts();
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+}
+
+int ace_calc_activity(Abc_Ntk_t * ntk, int num_vectors, char * clk_name,
+		int num_threads) {
 	int error = 0;
 	Vec_Ptr_t * nodes_all;
 	Vec_Ptr_t * nodes_logic;
 	Vec_Ptr_t * next_state_node_vec;
 	Vec_Ptr_t * latches_in_cycles_vec;
 	Abc_Obj_t * obj;
-	int i, j;
+	int i;
 	Ace_Obj_Info_t * info;
 
 	//Build BDD
@@ -196,7 +265,8 @@ int ace_calc_activity(Abc_Ntk_t * ntk, int num_vectors, char * clk_name) {
 
 		//print_nodes(next_state_node_vec);
 
-		ace_sim_activities(ntk, next_state_node_vec, num_vectors, 0.05);
+		ace_sim_activities(ntk, next_state_node_vec, num_vectors, 0.05,
+				num_threads);
 		//ace_sim_activities(ntk, nodes_logic, num_vectors, 0.05);
 
 		ace_update_latch_probs(ntk);
@@ -272,32 +342,7 @@ int ace_calc_activity(Abc_Ntk_t * ntk, int num_vectors, char * clk_name) {
 		}
 	}
 
-	Vec_PtrForEachEntry(Abc_Obj_t*, nodes_logic, obj, i)
-	{
-		Ace_Obj_Info_t * info2 = Ace_ObjInfo(obj);
-		//Ace_Obj_Info_t * fanin_info2;
-
-		VTR_ASSERT(Abc_ObjType(obj) == ABC_OBJ_NODE);
-
-		if (Abc_ObjFaninNum(obj) < 1) {
-			info2->switch_act = 0.0;
-			continue;
-		} else {
-			Vec_Ptr_t * literals = Vec_PtrAlloc(0);
-			Abc_Obj_t * fanin;
-
-			VTR_ASSERT(obj->Type == ABC_OBJ_NODE);
-
-			Abc_ObjForEachFanin(obj, fanin, j)
-			{
-				Vec_PtrPush(literals, fanin);
-			}
-			info2->switch_act = ace_bdd_calc_switch_act((DdManager*)ntk->pManFunc, obj,
-					literals);
-			Vec_PtrFree(literals);
-		}
-		VTR_ASSERT(info2->switch_act >= 0);
-	}
+	ace_calc_logic_switch_acts(ntk, nodes_logic, num_threads);
     Vec_PtrFree(nodes_logic);
     Vec_PtrFree(latches_in_cycles_vec);
 
@@ -338,6 +383,7 @@ int main(int argc, char * argv[]) {
 	Abc_Ntk_t * ntk;
 	Abc_Obj_t * obj;
 	int seed = 0;
+	int num_threads = 1;
 
 	p = ACE_PI_STATIC_PROB;
 	d = ACE_PI_SWITCH_PROB;
@@ -345,8 +391,10 @@ int main(int argc, char * argv[]) {
 	char blif_file_name[BLIF_FILE_NAME_LEN];
 	char new_blif_file_name[BLIF_FILE_NAME_LEN];
     char* clk_name = NULL;
+    char* bin_act_file_name = NULL;
 	ace_io_parse_argv(argc, argv, &BLIF, &IN_ACT, &OUT_ACT, blif_file_name,
-			new_blif_file_name, &pi_format, &p, &d, &seed, &clk_name);
+			new_blif_file_name, &pi_format, &p, &d, &seed, &clk_name,
+			&num_threads, &bin_act_file_name);
 
 	srand(seed);
 
@@ -428,7 +476,8 @@ int main(int argc, char * argv[]) {
 	}
 
 	if (!error) {
-		error = ace_calc_activity(ntk, ACE_NUM_VECTORS, clk_name);
+		printf("Activities will be computed by %d thread(s)\n", num_threads);
+		error = ace_calc_activity(ntk, ACE_NUM_VECTORS, clk_name, num_threads);
 	}
 
 	//Abc_NtkToSop(ntk, 0);
@@ -439,6 +488,10 @@ int main(int argc, char * argv[]) {
 		ace_io_print_activity(ntk, OUT_ACT);
 	}
 
+	if (!error && bin_act_file_name != NULL) {
+		error = ace_io_print_binary_activity(ntk, bin_act_file_name);
+	}
+
 	if (!error) {
 		Io_WriteHie(ntk, blif_file_name, new_blif_file_name);
 		printf("Done\n");
@@ -9,7 +9,8 @@
 #include "misc/st/st.h"
 
 double calc_cube_switch_prob_recur(DdManager * mgr, DdNode * bdd,
-		ace_cube_t * cube, Vec_Ptr_t * inputs, st__table * visited, int phase);
+		ace_cube_t * cube, Vec_Ptr_t * inputs, double * probs0to1,
+		double * probs1to0, st__table * visited, int phase);
 
 void ace_bdd_get_literals(Abc_Ntk_t * ntk, st__table ** lit_st_table,
 		Vec_Ptr_t ** literals);
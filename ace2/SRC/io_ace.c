@@ -1,6 +1,9 @@
 #include <stdlib.h>
+#include <string.h>
+#include <vector>
 
 #include "vtr_assert.h"
+#include "vtr_binary_activity.h"
 
 #include "ace.h"
 #include "io_ace.h"
@@ -8,6 +11,7 @@
 #include "base/abc/abc.h"
 
 bool check_if_fanout_is_po(Abc_Ntk_t * ntk, Abc_Obj_t * obj);
+char * ace_io_get_net_name(Abc_Obj_t * obj);
 
 char * hdl_name_ptr = NULL;
 
@@ -29,50 +33,57 @@ bool check_if_fanout_is_po(Abc_Ntk_t * /*ntk*/, Abc_Obj_t * obj) {
 	return FALSE;
 }
 
-void ace_io_print_activity(Abc_Ntk_t * ntk, FILE * fp) {
-	Abc_Obj_t * obj;
+/* Name of the net driven by an object in the netlist, NULL if the object does not drive a net */
+char * ace_io_get_net_name(Abc_Obj_t * obj) {
 	Abc_Obj_t * obj_new;
-	int i;
+	char * name = NULL;
 
-	Abc_NtkForEachObj(ntk, obj, i)
-	{
-		VTR_ASSERT(obj->pCopy);
-		obj_new = obj->pCopy;
+	VTR_ASSERT(obj->pCopy);
+	obj_new = obj->pCopy;
 
-		Ace_Obj_Info_t * info = Ace_ObjInfo(obj);
-		//Ace_Obj_Info_t * info = malloc(sizeof(Ace_Obj_Info_t));
+	switch (Abc_ObjType(obj)) {
 
-		char * name = NULL;
+	case ABC_OBJ_PI:
 
-		if (check_if_fanout_is_po(ntk, obj)) {
-			//continue;
-		}
+		name = Abc_ObjName(Abc_ObjFanout0(obj_new));
+		break;
 
-		switch (Abc_ObjType(obj)) {
+	case ABC_OBJ_BO:
+		name = Abc_ObjName(Abc_ObjFanout0(obj_new));
+		break;
 
-		case ABC_OBJ_PI:
+	case ABC_OBJ_LATCH:
+	case ABC_OBJ_PO:
+	case ABC_OBJ_BI:
+		break;
 
-			name = Abc_ObjName(Abc_ObjFanout0(obj_new));
-			break;
+	case ABC_OBJ_NODE:
+		name = Abc_ObjName(Abc_ObjFanout0(obj_new));
+		//name = Abc_ObjName(obj);
+		break;
 
-		case ABC_OBJ_BO:
-			name = Abc_ObjName(Abc_ObjFanout0(obj_new));
-			break;
+	default:
+		//printf("Unkown Type: %d\n", Abc_ObjType(obj));
+		//VTR_ASSERT(0);
+		break;
+	}
 
-		case ABC_OBJ_LATCH:
-		case ABC_OBJ_PO:
-		case ABC_OBJ_BI:
-			break;
+	return name;
+}
 
-		case ABC_OBJ_NODE:
-			name = Abc_ObjName(Abc_ObjFanout0(obj_new));
-			//name = Abc_ObjName(obj);
-			break;
+void ace_io_print_activity(Abc_Ntk_t * ntk, FILE * fp) {
+	Abc_Obj_t * obj;
+	int i;
 
-		default:
-			//printf("Unkown Type: %d\n", Abc_ObjType(obj));
-			//VTR_ASSERT(0);
-			break;
+	Abc_NtkForEachObj(ntk, obj, i)
+	{
+		Ace_Obj_Info_t * info = Ace_ObjInfo(obj);
+		//Ace_Obj_Info_t * info = malloc(sizeof(Ace_Obj_Info_t));
+
+		char * name = ace_io_get_net_name(obj);
+
+		if (check_if_fanout_is_po(ntk, obj)) {
+			//continue;
 		}
 
 		/*
@@ -98,9 +109,59 @@ void ace_io_print_activity(Abc_Ntk_t * ntk, FILE * fp) {
 	}
 }
 
+/* Write the same activities as ace_io_print_activity() in the binary format
+ * of vtr_binary_activity.h, which VPR loads without parsing */
+int ace_io_print_binary_activity(Abc_Ntk_t * ntk, const char * file_name) {
+	Abc_Obj_t * obj;
+	int i;
+	FILE * fp;
+	vtr::t_binary_activity_header header;
+	std::vector<vtr::t_binary_activity_record> records;
+	std::vector<char> names;
+
+	memcpy(header.magic, vtr::BINARY_ACTIVITY_MAGIC, sizeof(header.magic));
+	header.version = vtr::BINARY_ACTIVITY_VERSION;
+	header.reserved = 0;
+	header.net_names_checksum = vtr::BINARY_ACTIVITY_CHECKSUM_INIT;
+
+	Abc_NtkForEachObj(ntk, obj, i)
+	{
+		Ace_Obj_Info_t * info = Ace_ObjInfo(obj);
+		char * name = ace_io_get_net_name(obj);
+
+		if (name && strcmp(name, "unconn")) {
+			vtr::t_binary_activity_record record;
+			record.probability = info->static_prob;
+			record.density = info->switch_act;
+			record.name_offset = names.size();
+			record.name_length = strlen(name);
+			records.push_back(record);
+
+			names.insert(names.end(), name, name + record.name_length);
+			header.net_names_checksum = vtr::binary_activity_checksum(
+					header.net_names_checksum, name, record.name_length);
+		}
+	}
+	header.num_nets = records.size();
+	header.names_size = names.size();
+
+	fp = fopen(file_name, "wb");
+	if (fp == NULL) {
+		printf("Error: could not open binary activity file: %s\n", file_name);
+		return ACE_ERROR;
+	}
+	fwrite(&header, sizeof(header), 1, fp);
+	fwrite(records.data(), sizeof(vtr::t_binary_activity_record), records.size(), fp);
+	fwrite(names.data(), sizeof(char), names.size(), fp);
+	fclose(fp);
+
+	return 0;
+}
+
 int ace_io_parse_argv(int argc, char ** argv, FILE ** BLIF, FILE ** IN_ACT,
 		FILE ** OUT_ACT, char * blif_file_name, char * new_blif_file_name,
-		ace_pi_format_t * pi_format, double *p, double * d, int * seed, char** clk_name) {
+		ace_pi_format_t * pi_format, double *p, double * d, int * seed, char** clk_name,
+		int * num_threads, char** bin_act_file_name) {
 	int i;
 	char option;
 
@@ -128,6 +189,9 @@ int ace_io_parse_argv(int argc, char ** argv, FILE ** BLIF, FILE ** IN_ACT,
 			case 'o':
 				*OUT_ACT = fopen(argv[i], "w");
 				break;
+			case 'x':
+				*bin_act_file_name = argv[i];
+				break;
 			case 'a':
 				*pi_format = ACE_ACT;
 				*IN_ACT = fopen(argv[i], "r");
@@ -150,6 +214,14 @@ int ace_io_parse_argv(int argc, char ** argv, FILE ** BLIF, FILE ** IN_ACT,
 			case 'c':
 				*clk_name = argv[i];
 				break;
+			case 'j':
+				*num_threads = atoi(argv[i]);
+				if (*num_threads < 1) {
+					printf("Number of threads must be a positive integer\n");
+					ace_io_print_usage();
+					exit(1);
+				}
+				break;
 			default:
 				ace_io_print_usage();
 				exit(1);
@@ -183,6 +255,8 @@ void ace_io_print_usage() {
 	(void) fprintf(stderr, "\n");
 	(void) fprintf(stderr, "                                --+\n");
 	(void) fprintf(stderr, "    -o [output activity filename] | optional\n");
+	(void) fprintf(stderr, "    -x [output binary activity    |\n");
+	(void) fprintf(stderr, "        filename]                 |\n");
 	(void) fprintf(stderr, "                                --+\n");
 	(void) fprintf(stderr, "\n");
 	(void) fprintf(stderr, "                                --+\n");
@@ -193,6 +267,10 @@ void ace_io_print_usage() {
 	(void) fprintf(stderr, "    -p [PI static probability]    |\n");
 	(void) fprintf(stderr, "    -d [PI switching activity]    |\n");
 	(void) fprintf(stderr, "                                --+\n");
+	(void) fprintf(stderr, "\n");
+	(void) fprintf(stderr, "                                --+\n");
+	(void) fprintf(stderr, "    -j [number of threads]        | optional\n");
+	(void) fprintf(stderr, "                                --+\n");
 }
 
 int ace_io_read_activity(Abc_Ntk_t * ntk, FILE * in_file_desc,
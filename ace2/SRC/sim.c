@@ -1,3 +1,8 @@
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "vtr_assert.h"
 
 #include "ace.h"
@@ -9,8 +14,39 @@
 void get_pi_values(Abc_Ntk_t * ntk, Vec_Ptr_t * nodes, int cycle);
 int * getFaninValues(Abc_Obj_t * obj_ptr);
 ace_status_t getFaninStatus(Abc_Obj_t * obj_ptr);
+void evaluate_node(Abc_Ntk_t * ntk, Abc_Obj_t * obj);
 void evaluate_circuit(Abc_Ntk_t * ntk, Vec_Ptr_t * node_vec, int cycle);
 void update_FFs(Abc_Ntk_t * ntk);
+std::vector<std::vector<Abc_Obj_t*>> group_nodes_by_depth(Vec_Ptr_t * node_vec);
+void sim_activities_parallel(Abc_Ntk_t * ntk, Vec_Ptr_t * nodes,
+		Vec_Ptr_t * logic_nodes, int max_cycles, int num_threads);
+
+/* Barrier to synchronize the threads simulating a network level by level */
+class Ace_Sim_Barrier {
+public:
+	explicit Ace_Sim_Barrier(int num_threads) :
+			num_threads_(num_threads), num_waiting_(0), generation_(0) {
+	}
+
+	void wait() {
+		std::unique_lock<std::mutex> lock(mutex_);
+		int generation = generation_;
+		if (++num_waiting_ == num_threads_) {
+			num_waiting_ = 0;
+			generation_++;
+			cv_.notify_all();
+		} else {
+			cv_.wait(lock, [&] {return generation != generation_;});
+		}
+	}
+
+private:
+	std::mutex mutex_;
+	std::condition_variable cv_;
+	int num_threads_;
+	int num_waiting_;
+	int generation_;
+};
 
 void get_pi_values(Abc_Ntk_t * ntk, Vec_Ptr_t * /*nodes*/, int cycle) {
 	Abc_Obj_t * obj;
@@ -177,78 +213,86 @@ ace_status_t getFaninStatus(Abc_Obj_t * obj_ptr) {
 	return ACE_OLD;
 }
 
-void evaluate_circuit(Abc_Ntk_t * ntk, Vec_Ptr_t * node_vec, int /*cycle*/) {
-	Abc_Obj_t * obj;
+/* Evaluate a node for the current cycle, from the values of its fanins.
+ * Only the activity info of the node itself is modified, so nodes
+ * whose fanins have been evaluated can be evaluated at the same time */
+void evaluate_node(Abc_Ntk_t * ntk, Abc_Obj_t * obj) {
 	Ace_Obj_Info_t * info;
-	int i;
 	int value = -1;
 	int * faninValues;
 	ace_status_t status;
 	DdNode * dd_node;
 
-	Vec_PtrForEachEntry(Abc_Obj_t*, node_vec, obj, i)
-	{
-		info = Ace_ObjInfo(obj);
+	info = Ace_ObjInfo(obj);
 
-		switch (Abc_ObjType(obj)) {
-		case ABC_OBJ_PI:
-		case ABC_OBJ_BO:
-			break;
+	switch (Abc_ObjType(obj)) {
+	case ABC_OBJ_PI:
+	case ABC_OBJ_BO:
+		break;
 
-		case ABC_OBJ_PO:
-		case ABC_OBJ_BI:
-		case ABC_OBJ_LATCH:
-		case ABC_OBJ_NODE:
-			status = getFaninStatus(obj);
-			switch (status) {
-			case ACE_UNDEF:
-				info->status = ACE_UNDEF;
-				break;
-			case ACE_OLD:
-				info->status = ACE_OLD;
-				info->num_ones += info->value;
-				break;
-			case ACE_NEW:
-				if (Abc_ObjIsNode(obj)) {
-					faninValues = getFaninValues(obj);
-					VTR_ASSERT(faninValues);
-					dd_node = Cudd_Eval((DdManager*) ntk->pManFunc, (DdNode*) obj->pData, faninValues);
-					VTR_ASSERT(Cudd_IsConstant(dd_node));
-					if (dd_node == Cudd_ReadOne((DdManager*) ntk->pManFunc)) {
-						value = 1;
-					} else if (dd_node == Cudd_ReadLogicZero((DdManager*) ntk->pManFunc)) {
-						value = 0;
-					} else {
-						VTR_ASSERT(0);
-					}
-					free(faninValues);
+	case ABC_OBJ_PO:
+	case ABC_OBJ_BI:
+	case ABC_OBJ_LATCH:
+	case ABC_OBJ_NODE:
+		status = getFaninStatus(obj);
+		switch (status) {
+		case ACE_UNDEF:
+			info->status = ACE_UNDEF;
+			break;
+		case ACE_OLD:
+			info->status = ACE_OLD;
+			info->num_ones += info->value;
+			break;
+		case ACE_NEW:
+			if (Abc_ObjIsNode(obj)) {
+				faninValues = getFaninValues(obj);
+				VTR_ASSERT(faninValues);
+				dd_node = Cudd_Eval((DdManager*) ntk->pManFunc, (DdNode*) obj->pData, faninValues);
+				VTR_ASSERT(Cudd_IsConstant(dd_node));
+				if (dd_node == Cudd_ReadOne((DdManager*) ntk->pManFunc)) {
+					value = 1;
+				} else if (dd_node == Cudd_ReadLogicZero((DdManager*) ntk->pManFunc)) {
+					value = 0;
 				} else {
-					Ace_Obj_Info_t * fanin_info = Ace_ObjInfo(
-							Abc_ObjFanin0(obj));
-					value = fanin_info->value;
+					VTR_ASSERT(0);
 				}
+				free(faninValues);
+			} else {
+				Ace_Obj_Info_t * fanin_info = Ace_ObjInfo(
+						Abc_ObjFanin0(obj));
+				value = fanin_info->value;
+			}
 
-				if (info->value != value || info->status == ACE_UNDEF) {
-					info->value = value;
-					if (info->status != ACE_UNDEF) {
-						/* Don't count the first value as a toggle */
-						info->num_toggles++;
-					}
-					info->status = ACE_NEW;
-				} else {
-					info->status = ACE_OLD;
+			if (info->value != value || info->status == ACE_UNDEF) {
+				info->value = value;
+				if (info->status != ACE_UNDEF) {
+					/* Don't count the first value as a toggle */
+					info->num_toggles++;
 				}
-				info->num_ones += info->value;
-				break;
-			default:
-				VTR_ASSERT(0);
-				break;
+				info->status = ACE_NEW;
+			} else {
+				info->status = ACE_OLD;
 			}
+			info->num_ones += info->value;
 			break;
 		default:
 			VTR_ASSERT(0);
 			break;
 		}
+		break;
+	default:
+		VTR_ASSERT(0);
+		break;
+	}
+}
+
+void evaluate_circuit(Abc_Ntk_t * ntk, Vec_Ptr_t * node_vec, int /*cycle*/) {
+	Abc_Obj_t * obj;
+	int i;
+
+	Vec_PtrForEachEntry(Abc_Obj_t*, node_vec, obj, i)
+	{
+		evaluate_node(ntk, obj);
 	}
 }
 
@@ -289,14 +333,75 @@ void update_FFs(Abc_Ntk_t * ntk) {
 	}
 }
 
+/* Group the nodes by their depth, see ace_calc_network_depth().
+ * The fanins of a node are always in a lower level than the node,
+ * so the nodes of the same level are independent from each other.
+ * Nodes keep their order of the input vector inside a level */
+std::vector<std::vector<Abc_Obj_t*>> group_nodes_by_depth(Vec_Ptr_t * node_vec) {
+	std::vector<std::vector<Abc_Obj_t*>> levels;
+	Abc_Obj_t * obj;
+	int i;
+
+	Vec_PtrForEachEntry(Abc_Obj_t*, node_vec, obj, i)
+	{
+		Ace_Obj_Info_t * info = Ace_ObjInfo(obj);
+		VTR_ASSERT(info->depth >= 0);
+		if (levels.size() <= (size_t) info->depth) {
+			levels.resize(info->depth + 1);
+		}
+		levels[info->depth].push_back(obj);
+	}
+
+	return levels;
+}
+
+/* Simulate the network with a number of threads, level by level.
+ * The primary inputs and flip-flops are updated by the calling thread
+ * between cycles, as they use random numbers and must stay in order.
+ * Each node is evaluated from the same fanin values as in evaluate_circuit(),
+ * so the activities are exactly the same whatever the number of threads */
+void sim_activities_parallel(Abc_Ntk_t * ntk, Vec_Ptr_t * nodes,
+		Vec_Ptr_t * logic_nodes, int max_cycles, int num_threads) {
+	std::vector<std::vector<Abc_Obj_t*>> levels = group_nodes_by_depth(logic_nodes);
+	Ace_Sim_Barrier barrier(num_threads);
+
+	auto simulate = [&](int thread_id) {
+		for (int cycle = 0; cycle < max_cycles; cycle++) {
+			if (thread_id == 0) {
+				get_pi_values(ntk, nodes, cycle);
+			}
+			barrier.wait();
+			for (const std::vector<Abc_Obj_t*>& level : levels) {
+				for (size_t inode = thread_id; inode < level.size(); inode += num_threads) {
+					evaluate_node(ntk, level[inode]);
+				}
+				barrier.wait();
+			}
+			if (thread_id == 0) {
+				update_FFs(ntk);
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (int ithread = 1; ithread < num_threads; ithread++) {
+		threads.push_back(std::thread(simulate, ithread));
+	}
+	simulate(0);
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+}
+
 void ace_sim_activities(Abc_Ntk_t * ntk, Vec_Ptr_t * nodes, int max_cycles,
-		double threshold) {
+		double threshold, int num_threads) {
 	Abc_Obj_t * obj;
 	Ace_Obj_Info_t * info;
 	int i;
 
 	VTR_ASSERT(max_cycles > 0);
 	VTR_ASSERT(threshold > 0.0);
+	VTR_ASSERT(num_threads > 0);
 
 //	srand((unsigned) time(NULL));
 
@@ -316,10 +421,14 @@ void ace_sim_activities(Abc_Ntk_t * ntk, Vec_Ptr_t * nodes, int max_cycles,
 	}
 
 	Vec_Ptr_t * logic_nodes = Abc_NtkDfs(ntk, TRUE);
-	for (i = 0; i < max_cycles; i++) {
-		get_pi_values(ntk, nodes, i);
-		evaluate_circuit(ntk, logic_nodes, i);
-		update_FFs(ntk);
+	if (num_threads > 1) {
+		sim_activities_parallel(ntk, nodes, logic_nodes, max_cycles, num_threads);
+	} else {
+		for (i = 0; i < max_cycles; i++) {
+			get_pi_values(ntk, nodes, i);
+			evaluate_circuit(ntk, logic_nodes, i);
+			update_FFs(ntk);
+		}
 	}
 
 	//Vec_PtrForEachEntry(Abc_Obj_t *, nodes, obj, i)
@@ -4,6 +4,6 @@
 #include "ace.h"
 
 void ace_sim_activities(Abc_Ntk_t * ntk, Vec_Ptr_t * node_vec, int max_cycles,
-		double threshold);
+		double threshold, int num_threads);
 
 #endif
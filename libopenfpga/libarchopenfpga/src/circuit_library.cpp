@@ -1066,23 +1066,11 @@ CircuitModelId CircuitLibrary::model(const char* name) const {
 
 /* Find a circuit model by a given name and return its id */
 CircuitModelId CircuitLibrary::model(const std::string& name) const { 
-  CircuitModelId ret = CircuitModelId::INVALID();
-  size_t num_found = 0;
-  for (circuit_model_string_iterator it = model_names_.begin();
-       it != model_names_.end();
-       it++) {
-    /* Bypass unmatched names */
-    if ( 0 != name.compare(*it) ) {
-      continue;
-    }
-    /* Find one and record it 
-     * FIXME: I feel that we may have a better way in getting the CircuitModelId
-     */
-    ret = CircuitModelId(it - model_names_.begin()); 
-    num_found++;
+  auto result = model_name_lookup_.find(name);
+  if (result == model_name_lookup_.end()) {
+    return CircuitModelId::INVALID();
   }
-  VTR_ASSERT((0 == num_found) || (1 == num_found));
-  return ret;
+  return result->second;
 }
 
 /* Get the CircuitModelId of a default circuit model with a given type */
@@ -1119,6 +1107,85 @@ CircuitEdgeId CircuitLibrary::edge(const CircuitPortId& from_port, const size_t
  * Public Mutators 
  ***********************************************************************/
 /* Add a circuit model to the library, and return it Id */
+/* Reserve the memory for a number of circuit models,
+ * so that adding them one by one does not reallocate the lists
+ */
+void CircuitLibrary::reserve_models(const size_t& num_models) {
+  model_ids_.reserve(num_models);
+  model_types_.reserve(num_models);
+  model_names_.reserve(num_models);
+  model_prefix_.reserve(num_models);
+  model_verilog_netlists_.reserve(num_models);
+  model_circuit_netlists_.reserve(num_models);
+  model_is_default_.reserve(num_models);
+  sub_models_.reserve(num_models);
+  dump_structural_verilog_.reserve(num_models);
+  dump_explicit_port_map_.reserve(num_models);
+  design_tech_types_.reserve(num_models);
+  is_power_gated_.reserve(num_models);
+  device_model_names_.reserve(num_models);
+  buffer_existence_.reserve(num_models);
+  buffer_model_names_.reserve(num_models);
+  buffer_model_ids_.reserve(num_models);
+  buffer_location_maps_.reserve(num_models);
+  pass_gate_logic_model_names_.reserve(num_models);
+  pass_gate_logic_model_ids_.reserve(num_models);
+  delay_types_.reserve(num_models);
+  delay_in_port_names_.reserve(num_models);
+  delay_out_port_names_.reserve(num_models);
+  delay_values_.reserve(num_models);
+  buffer_types_.reserve(num_models);
+  buffer_sizes_.reserve(num_models);
+  buffer_num_levels_.reserve(num_models);
+  buffer_f_per_stage_.reserve(num_models);
+  pass_gate_logic_types_.reserve(num_models);
+  pass_gate_logic_sizes_.reserve(num_models);
+  mux_structure_.reserve(num_models);
+  mux_num_levels_.reserve(num_models);
+  mux_const_input_values_.reserve(num_models);
+  mux_use_local_encoder_.reserve(num_models);
+  mux_use_advanced_rram_design_.reserve(num_models);
+  lut_is_fracturable_.reserve(num_models);
+  gate_types_.reserve(num_models);
+  rram_res_.reserve(num_models);
+  wprog_set_.reserve(num_models);
+  wprog_reset_.reserve(num_models);
+  wire_types_.reserve(num_models);
+  wire_rc_.reserve(num_models);
+  wire_num_levels_.reserve(num_models);
+}
+
+/* Reserve the memory for a number of circuit ports (of all the circuit models),
+ * so that adding them one by one does not reallocate the lists
+ */
+void CircuitLibrary::reserve_ports(const size_t& num_ports) {
+  port_ids_.reserve(num_ports);
+  port_model_ids_.reserve(num_ports);
+  port_types_.reserve(num_ports);
+  port_sizes_.reserve(num_ports);
+  port_prefix_.reserve(num_ports);
+  port_lib_names_.reserve(num_ports);
+  port_inv_prefix_.reserve(num_ports);
+  port_default_values_.reserve(num_ports);
+  port_is_io_.reserve(num_ports);
+  port_is_mode_select_.reserve(num_ports);
+  port_is_global_.reserve(num_ports);
+  port_is_reset_.reserve(num_ports);
+  port_is_set_.reserve(num_ports);
+  port_is_config_enable_.reserve(num_ports);
+  port_is_prog_.reserve(num_ports);
+  port_tri_state_model_names_.reserve(num_ports);
+  port_tri_state_model_ids_.reserve(num_ports);
+  port_inv_model_names_.reserve(num_ports);
+  port_inv_model_ids_.reserve(num_ports);
+  port_tri_state_maps_.reserve(num_ports);
+  port_lut_frac_level_.reserve(num_ports);
+  port_lut_output_masks_.reserve(num_ports);
+  port_sram_orgz_.reserve(num_ports);
+  port_in_edge_ids_.reserve(num_ports);
+  port_out_edge_ids_.reserve(num_ports);
+}
+
 CircuitModelId CircuitLibrary::add_model(const enum e_circuit_model_type& type) {
   /* Create a new id*/
   CircuitModelId model_id = CircuitModelId(model_ids_.size());
@@ -1205,7 +1272,24 @@ CircuitModelId CircuitLibrary::add_model(const enum e_circuit_model_type& type)
 void CircuitLibrary::set_model_name(const CircuitModelId& model_id, const std::string& name) {
   /* validate the model_id */
   VTR_ASSERT(valid_model_id(model_id));
+
+  /* Keep the fast look-up in sync, a model with the old name which is registered first is kept */
+  auto result = model_name_lookup_.find(model_names_[model_id]);
+  if ( (result != model_name_lookup_.end()) && (result->second == model_id) ) {
+    model_name_lookup_.erase(result);
+    for (const CircuitModelId& other_model : models()) {
+      if ( (other_model != model_id) && (model_names_[other_model] == model_names_[model_id]) ) {
+        model_name_lookup_[model_names_[other_model]] = other_model;
+        break;
+      }
+    }
+  }
+
   model_names_[model_id] = name;
+  auto inserted = model_name_lookup_.emplace(name, model_id);
+  if ( (false == inserted.second) && (size_t(model_id) < size_t(inserted.first->second)) ) {
+    inserted.first->second = model_id;
+  }
   return;
 }
 
@@ -1387,8 +1471,14 @@ CircuitPortId CircuitLibrary::add_model_port(const CircuitModelId& model_id,
   port_in_edge_ids_.emplace_back();
   port_out_edge_ids_.emplace_back();
  
-  /* Build the fast look-up for circuit model ports */
-  build_model_port_lookup();
+  /* Update the fast look-up for circuit model ports,
+   * which is only built from scratch for the first port of a new circuit model
+   */
+  if (size_t(model_id) < model_port_lookup_.size()) {
+    model_port_lookup_[model_id][port_type].push_back(circuit_port_id);
+  } else {
+    build_model_port_lookup();
+  }
 
   return circuit_port_id;
 }
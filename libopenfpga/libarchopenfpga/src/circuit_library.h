@@ -13,6 +13,7 @@
 /* Header files should be included in a sequence */
 /* Standard header files required go first */
 #include <string>
+#include <unordered_map>
 
 #include "vtr_geometry.h"
 
@@ -309,6 +310,8 @@ class CircuitLibrary {
     CircuitEdgeId edge(const CircuitPortId& from_port, const size_t from_pin,
                        const CircuitPortId& to_port, const size_t to_pin);
   public: /* Public Mutators */
+    void reserve_models(const size_t& num_models);
+    void reserve_ports(const size_t& num_ports);
     CircuitModelId add_model(const enum e_circuit_model_type& type);
     /* Fundamental information */
     void set_model_name(const CircuitModelId& model_id, const std::string& name);
@@ -509,6 +512,10 @@ class CircuitLibrary {
     mutable CircuitModelLookup model_lookup_; /* [model_type][model_ids] */
     typedef vtr::vector<CircuitModelId, std::vector<std::vector<CircuitPortId>>> CircuitModelPortLookup;
     mutable CircuitModelPortLookup model_port_lookup_; /* [model_id][port_type][port_ids] */
+    /* fast look-up for circuit models by name
+     * Names should be unique (see check_circuit_library), otherwise the first model with a name is found
+     */
+    std::unordered_map<std::string, CircuitModelId> model_name_lookup_;
 
     /* Verilog generator options */ 
     vtr::vector<CircuitModelId, bool> dump_structural_verilog_;
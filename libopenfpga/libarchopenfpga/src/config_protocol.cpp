@@ -10,7 +10,8 @@
  * Constructors
  ***********************************************************************/
 ConfigProtocol::ConfigProtocol() {
-  return;
+  num_regions_ = 1;
+  word_write_ = false;
 }
 
 /************************************************************************
@@ -28,6 +29,14 @@ CircuitModelId ConfigProtocol::memory_model() const {
   return memory_model_;
 }
 
+size_t ConfigProtocol::num_regions() const {
+  return num_regions_;
+}
+
+bool ConfigProtocol::word_write() const {
+  return word_write_;
+}
+
 /************************************************************************
  * Public Mutators
  ***********************************************************************/
@@ -42,3 +51,12 @@ void ConfigProtocol::set_memory_model_name(const std::string& memory_model_name)
 void ConfigProtocol::set_memory_model(const CircuitModelId& memory_model) {
   memory_model_ = memory_model;
 }
+
+void ConfigProtocol::set_num_regions(const size_t& num_regions) {
+  VTR_ASSERT(0 < num_regions);
+  num_regions_ = num_regions;
+}
+
+void ConfigProtocol::set_word_write(const bool& word_write) {
+  word_write_ = word_write;
+}
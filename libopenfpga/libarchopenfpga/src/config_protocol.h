@@ -15,10 +15,14 @@ class ConfigProtocol {
     e_config_protocol_type type() const;
     std::string memory_model_name() const;
     CircuitModelId memory_model() const;
+    size_t num_regions() const;
+    bool word_write() const;
   public: /* Public Mutators */
     void set_type(const e_config_protocol_type& type);
     void set_memory_model_name(const std::string& memory_model_name);
     void set_memory_model(const CircuitModelId& memory_model);
+    void set_num_regions(const size_t& num_regions);
+    void set_word_write(const bool& word_write);
   private: /* Internal data */
     /* The type of configuration protocol. 
      * In other words, it is about how to organize and access each configurable memory 
@@ -28,6 +32,17 @@ class ConfigProtocol {
     /* The circuit model of configuration memory to be used in the protocol */
     std::string memory_model_name_;
     CircuitModelId memory_model_;
+
+    /* Number of configuration regions, which are programmed in parallel
+     * Each region has its own configuration chain head and tail 
+     */
+    size_t num_regions_;
+
+    /* Only applicable to memory banks:
+     * When enabled, each WL address writes a full word of BLs,
+     * which are driven by a data input port of the fabric instead of a BL decoder
+     */
+    bool word_write_;
 };
 
 #endif
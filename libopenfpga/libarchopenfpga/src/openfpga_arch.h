@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <map>
+#include <string>
 
 #include "circuit_library.h"
 #include "technology_library.h"
@@ -56,6 +57,11 @@ struct Arch {
    * Bind from physical to circuit model
    */
   std::vector<PbTypeAnnotation> pb_type_annotations;
+
+  /* Secure digest of the architecture file, 
+   * used to identify the architecture in the caches of later steps
+   */
+  std::string arch_id;
 };
 
 } /* namespace openfpga ends */
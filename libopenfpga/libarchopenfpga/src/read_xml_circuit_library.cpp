@@ -655,6 +655,11 @@ void read_xml_circuit_model(pugi::xml_node& xml_model,
   /* Translate the type of circuit model to enumerate */
   e_circuit_model_type model_type = string_to_circuit_model_type(std::string(type_attr));
 
+  /* Error out on any unknown attribute at once, rather than ignoring it silently */
+  expect_only_attributes(xml_model,
+                         {"type", "name", "prefix", "spice_netlist", "verilog_netlist", "is_default", "dump_structural_verilog"},
+                         loc_data);
+
   if (NUM_CIRCUIT_MODEL_TYPES == model_type) {
     archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_model),
                    "Invalid 'type' attribute '%s'\n",
@@ -793,6 +798,18 @@ CircuitLibrary read_xml_circuit_library(pugi::xml_node& Node,
                                         const pugiutil::loc_data& loc_data) {
   CircuitLibrary circuit_lib;
 
+  /* Count the circuit models and their ports in a first pass,
+   * so that the circuit library is allocated only once
+   */
+  size_t num_models = 0;
+  size_t num_ports = 0;
+  for (pugi::xml_node xml_model : Node.children("circuit_model")) {
+    num_models++;
+    num_ports += count_children(xml_model, "port", loc_data, pugiutil::ReqOpt::OPTIONAL);
+  }
+  circuit_lib.reserve_models(num_models);
+  circuit_lib.reserve_ports(num_ports);
+
   /* Iterate over the children under this node,
    * each child should be named after circuit_model
    */
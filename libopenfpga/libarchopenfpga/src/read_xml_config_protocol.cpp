@@ -64,6 +64,30 @@ void read_xml_config_organization(pugi::xml_node& xml_config_orgz,
 
   config_protocol.set_memory_model_name(get_attribute(xml_config_orgz, "circuit_model_name", loc_data).as_string());
 
+  /* Only configuration chains can be split into regions which are programmed in parallel */
+  int num_regions = get_attribute(xml_config_orgz, "num_regions", loc_data, pugiutil::ReqOpt::OPTIONAL).as_int(1);
+  if (1 > num_regions) {
+    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_config_orgz),
+                   "Invalid 'num_regions' attribute '%d' which should be at least 1\n",
+                   num_regions);
+  }
+  if ( (1 < num_regions)
+    && (CONFIG_MEM_SCAN_CHAIN != config_orgz_type) ) {
+    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_config_orgz),
+                   "Attribute 'num_regions' is only applicable to configuration protocol '%s'\n",
+                   CONFIG_PROTOCOL_TYPE_STRING[CONFIG_MEM_SCAN_CHAIN]);
+  }
+  config_protocol.set_num_regions(num_regions);
+
+  /* Only memory banks can write a word of BLs at each WL address */
+  bool word_write = get_attribute(xml_config_orgz, "word_write", loc_data, pugiutil::ReqOpt::OPTIONAL).as_bool(false);
+  if ( (true == word_write)
+    && (CONFIG_MEM_MEMORY_BANK != config_orgz_type) ) {
+    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_config_orgz),
+                   "Attribute 'word_write' is only applicable to configuration protocol '%s'\n",
+                   CONFIG_PROTOCOL_TYPE_STRING[CONFIG_MEM_MEMORY_BANK]);
+  }
+  config_protocol.set_word_write(word_write);
 }
 
 /********************************************************************
@@ -27,7 +27,7 @@ void write_xml_openfpga_arch(const char* fname,
   vtr::ScopedStartFinishTimer timer("Write OpenFPGA architecture");
 
   /* Create a file handler */
-  std::fstream fp;
+  openfpga::BufferedFileStream fp;
   /* Open the file stream */
   fp.open(std::string(fname), std::fstream::out | std::fstream::trunc);
 
@@ -75,7 +75,7 @@ void write_xml_openfpga_simulation_settings(const char* fname,
   vtr::ScopedStartFinishTimer timer("Write OpenFPGA simulation settings");
 
   /* Create a file handler */
-  std::fstream fp;
+  openfpga::BufferedFileStream fp;
   /* Open the file stream */
   fp.open(std::string(fname), std::fstream::out | std::fstream::trunc);
 
@@ -67,7 +67,7 @@ int write_xml_fabric_key(const char* fname,
   vtr::ScopedStartFinishTimer timer("Write Fabric Key");
 
   /* Create a file handler */
-  std::fstream fp;
+  openfpga::BufferedFileStream fp;
   /* Open the file stream */
   fp.open(std::string(fname), std::fstream::out | std::fstream::trunc);
 
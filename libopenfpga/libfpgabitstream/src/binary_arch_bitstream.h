@@ -0,0 +1,66 @@
+/******************************************************************************
+ * This file introduces the binary file format of the architecture bitstream,
+ * which is a sibling of the XML format with the same block hierarchy.
+ * The file is much smaller than the XML file and can be loaded
+ * without any parsing, i.e., at the speed of file I/O.
+ *
+ * File layout
+ * -----------
+ * All the fields are stored in the native byte order (little-endian on all the hosts we support)
+ *
+ *  +------------------------------------------+  offset 0
+ *  | Header (BinaryArchBitstreamHeader)       |
+ *  +------------------------------------------+
+ *  | Block 0 (the top block)                  |
+ *  +------------------------------------------+
+ *  | Block 1                                  |
+ *  +------------------------------------------+
+ *  | ...                                      |
+ *  +------------------------------------------+
+ *
+ * Blocks are stored in the Depth-First Search order from the top block,
+ * so that a parent block always comes before its children,
+ * and children of a block are in the same order as in the bitstream manager.
+ * Each block is stored as
+ *  - a block header (BinaryArchBitstreamBlockHeader)
+ *  - the name of the block, input net ids and output net ids, without any terminator
+ *  - the configuration bits, packed in ceil(num_bits / 64) 64-bit words,
+ *    where bit i is the (i % 64)-th least significant bit of word (i / 64)
+ ******************************************************************************/
+#ifndef BINARY_ARCH_BITSTREAM_H
+#define BINARY_ARCH_BITSTREAM_H
+
+#include <cstdint>
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+constexpr char BINARY_ARCH_BITSTREAM_MAGIC[8] = {'O', 'F', 'P', 'G', 'A', 'A', 'B', 'S'};
+constexpr uint32_t BINARY_ARCH_BITSTREAM_VERSION = 1;
+
+/* Index of the parent block for the top block */
+constexpr uint64_t BINARY_ARCH_BITSTREAM_NO_PARENT = ~uint64_t(0);
+
+struct BinaryArchBitstreamHeader {
+  char magic[8];
+  uint32_t version;
+  /* 1 if net ids of blocks are stored, 0 otherwise */
+  uint32_t use_net_ids;
+  uint64_t num_blocks;
+  uint64_t num_bits;
+};
+
+struct BinaryArchBitstreamBlockHeader {
+  /* Index of the parent block in the file */
+  uint64_t parent_block;
+  /* Path id of the block, -2 if not defined */
+  int32_t path_id;
+  uint32_t name_length;
+  uint32_t input_net_ids_length;
+  uint32_t output_net_ids_length;
+  uint64_t num_bits;
+};
+
+} /* end namespace openfpga */
+
+#endif
@@ -2,19 +2,27 @@
  * This file includes member functions for data structure BitstreamManager 
  ******************************************************************************/
 #include <algorithm>
+#include <limits>
 
 #include "vtr_assert.h"
+#include "openfpga_memory_footprint.h"
 #include "bitstream_manager.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Blocks with fewer children than this are searched by name without an index */
+constexpr size_t MIN_NUM_CHILDREN_TO_LOOKUP_BY_NAME = 16;
+
 /**************************************************
  * Public Constructors
  *************************************************/
 BitstreamManager::BitstreamManager() {
   num_blocks_ = 0;
   num_bits_ = 0;
+  use_net_ids_ = true;
+  /* Blocks without a name refer to the empty string */
+  intern_block_name(std::string());
   invalid_block_ids_.clear();
   invalid_bit_ids_.clear();
 }
@@ -49,21 +57,31 @@ bool BitstreamManager::bit_value(const ConfigBitId& bit_id) const {
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_bit_id(bit_id));
 
-  return '1' == bit_values_[bit_id];
+  return 0 != ((bit_words_[size_t(bit_id) / 64] >> (size_t(bit_id) % 64)) & 1);
 }
 
 ConfigBlockId BitstreamManager::bit_parent_block(const ConfigBitId& bit_id) const {
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_bit_id(bit_id));
 
-  return bit_parent_blocks_[bit_id];
+  /* Find the last block whose lsb is not larger than the bit id */
+  auto it = std::upper_bound(bit_owner_blocks_.begin(), bit_owner_blocks_.end(), size_t(bit_id),
+                                                                   [&](const size_t& bit, const ConfigBlockId& block) {
+                                                                     return bit < block_bit_id_lsbs_[block];
+                                                                   });
+  /* Every bit belongs to a block */
+  VTR_ASSERT(it != bit_owner_blocks_.begin());
+  --it;
+  VTR_ASSERT_SAFE(size_t(bit_id) < block_bit_id_lsbs_[*it] + block_bit_lengths_[*it]);
+
+  return *it;
 }
 
-std::string BitstreamManager::block_name(const ConfigBlockId& block_id) const {
+const std::string& BitstreamManager::block_name(const ConfigBlockId& block_id) const {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
 
-  return block_names_[block_id];
+  return block_name_pool_[block_names_[block_id]];
 }
 
 ConfigBlockId BitstreamManager::block_parent(const ConfigBlockId& block_id) const {
@@ -73,7 +91,7 @@ ConfigBlockId BitstreamManager::block_parent(const ConfigBlockId& block_id) cons
   return parent_block_ids_[block_id];
 }
 
-std::vector<ConfigBlockId> BitstreamManager::block_children(const ConfigBlockId& block_id) const {
+const std::vector<ConfigBlockId>& BitstreamManager::block_children(const ConfigBlockId& block_id) const {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
 
@@ -106,21 +124,39 @@ ConfigBlockId BitstreamManager::find_child_block(const ConfigBlockId& block_id,
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
 
-  std::vector<ConfigBlockId> candidates;
+  /* No block can have a name which is not in the pool */
+  auto name_id = block_name_ids_.find(child_block_name);
+  if (name_id == block_name_ids_.end()) {
+    return ConfigBlockId::INVALID();
+  }
 
-  for (const ConfigBlockId& child : block_children(block_id)) {
-    if (0 == child_block_name.compare(block_name(child))) {
-      candidates.push_back(child);
+  const std::vector<ConfigBlockId>& children = child_block_ids_[block_id];
+
+  /* Blocks with a few children are searched directly */
+  if (MIN_NUM_CHILDREN_TO_LOOKUP_BY_NAME > children.size()) {
+    ConfigBlockId candidate = ConfigBlockId::INVALID();
+    for (const ConfigBlockId& child : children) {
+      if (name_id->second == block_names_[child]) {
+        /* We should have 0 or 1 candidate! */
+        VTR_ASSERT(ConfigBlockId::INVALID() == candidate);
+        candidate = child;
+      }
     }
+    return candidate;
+  }
+
+  auto lookup = child_block_name_lookup_.find(block_id);
+  if (lookup == child_block_name_lookup_.end()) {
+    build_child_block_name_lookup(block_id);
+    lookup = child_block_name_lookup_.find(block_id);
   }
 
-  /* We should have 0 or 1 candidate! */
-  VTR_ASSERT(0 == candidates.size() || 1 == candidates.size());
-  if (0 == candidates.size()) {
+  auto result = lookup->second.find(name_id->second);
+  if (result == lookup->second.end()) {
     /* Not found, return an invalid value */
     return ConfigBlockId::INVALID();
   }
-  return candidates[0];
+  return result->second;
 }
 
 int BitstreamManager::block_path_id(const ConfigBlockId& block_id) const {
@@ -134,59 +170,72 @@ std::string BitstreamManager::block_input_net_ids(const ConfigBlockId& block_id)
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
 
-  return block_input_net_ids_[block_id];
+  auto result = block_input_net_ids_.find(block_id);
+  if (result == block_input_net_ids_.end()) {
+    return std::string();
+  }
+  return result->second;
 }
 
 std::string BitstreamManager::block_output_net_ids(const ConfigBlockId& block_id) const {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
 
-  return block_output_net_ids_[block_id];
-}
-
-/******************************************************************************
- * Public Mutators
- ******************************************************************************/
-ConfigBitId BitstreamManager::add_bit(const ConfigBlockId& parent_block, const bool& bit_value) {
-  ConfigBitId bit = ConfigBitId(num_bits_);
-  /* Add a new bit, and allocate associated data structures */
-  num_bits_++;
-  if (true == bit_value) {
-    bit_values_.push_back('1');
-  } else {
-    bit_values_.push_back('0');
+  auto result = block_output_net_ids_.find(block_id);
+  if (result == block_output_net_ids_.end()) {
+    return std::string();
   }
+  return result->second;
+}
 
-  bit_parent_blocks_.push_back(parent_block);
+bool BitstreamManager::use_net_ids() const {
+  return use_net_ids_;
+}
 
-  return bit; 
+size_t BitstreamManager::memory_footprint() const {
+  size_t footprint = sizeof(BitstreamManager);
+  footprint += container_footprint(invalid_block_ids_);
+  footprint += container_footprint(block_bit_id_lsbs_);
+  footprint += container_footprint(block_bit_lengths_);
+  footprint += container_footprint(block_names_);
+  footprint += container_footprint(parent_block_ids_);
+  footprint += container_footprint(child_block_ids_);
+  footprint += container_footprint(child_block_name_lookup_);
+  footprint += container_footprint(block_name_pool_);
+  footprint += container_footprint(block_name_ids_);
+  footprint += container_footprint(block_path_ids_);
+  footprint += container_footprint(block_input_net_ids_);
+  footprint += container_footprint(block_output_net_ids_);
+  footprint += container_footprint(invalid_bit_ids_);
+  footprint += container_footprint(bit_words_);
+  footprint += container_footprint(bit_owner_blocks_);
+  return footprint;
 }
 
+/******************************************************************************
+ * Public Mutators
+ ******************************************************************************/
 void BitstreamManager::reserve_blocks(const size_t& num_blocks) {
   block_names_.reserve(num_blocks);
   block_bit_id_lsbs_.reserve(num_blocks);
   block_bit_lengths_.reserve(num_blocks);
   block_path_ids_.reserve(num_blocks);
-  block_input_net_ids_.reserve(num_blocks);
-  block_output_net_ids_.reserve(num_blocks);
   parent_block_ids_.reserve(num_blocks);
   child_block_ids_.reserve(num_blocks);
 }
 
 void BitstreamManager::reserve_bits(const size_t& num_bits) {
-  bit_values_.reserve(num_bits);
+  bit_words_.reserve((num_bits + 63) / 64);
 }
 
 ConfigBlockId BitstreamManager::create_block() {
   ConfigBlockId block = ConfigBlockId(num_blocks_);
   /* Add a new bit, and allocate associated data structures */
   num_blocks_++;
-  block_names_.emplace_back();
+  block_names_.push_back(0);
   block_bit_id_lsbs_.emplace_back(-1);
   block_bit_lengths_.emplace_back(0);
   block_path_ids_.push_back(-2);
-  block_input_net_ids_.emplace_back();
-  block_output_net_ids_.emplace_back();
   parent_block_ids_.push_back(ConfigBlockId::INVALID());
   child_block_ids_.emplace_back();
 
@@ -204,7 +253,21 @@ void BitstreamManager::set_block_name(const ConfigBlockId& block_id,
                                       const std::string& block_name) {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
-  block_names_[block_id] = block_name;
+
+  uint32_t name_id = intern_block_name(block_name);
+
+  /* Keep the name index of the parent block up-to-date */
+  const ConfigBlockId& parent_block = parent_block_ids_[block_id];
+  if (true == valid_block_id(parent_block)) {
+    auto lookup = child_block_name_lookup_.find(parent_block);
+    if (lookup != child_block_name_lookup_.end()) {
+      lookup->second.erase(block_names_[block_id]);
+      VTR_ASSERT(0 == lookup->second.count(name_id));
+      lookup->second[name_id] = block_id;
+    }
+  }
+
+  block_names_[block_id] = name_id;
 }
 
 void BitstreamManager::reserve_child_blocks(const ConfigBlockId& parent_block,
@@ -224,27 +287,74 @@ void BitstreamManager::add_child_block(const ConfigBlockId& parent_block, const
   /* We should have only a parent block for each block! */
   VTR_ASSERT(ConfigBlockId::INVALID() == parent_block_ids_[child_block]);
 
-  /* Ensure the child block is not in the list of children of the parent block */
-  std::vector<ConfigBlockId>::iterator it = std::find(child_block_ids_[parent_block].begin(), child_block_ids_[parent_block].end(), child_block);
-  VTR_ASSERT(it == child_block_ids_[parent_block].end());
+  /* Ensure the child block is not in the list of children of the parent block
+   * This is implied by the check on the parent block above,
+   * so it is only done in the safe mode, as it scales with the number of children
+   */
+  VTR_ASSERT_SAFE(child_block_ids_[parent_block].end() == std::find(child_block_ids_[parent_block].begin(), child_block_ids_[parent_block].end(), child_block));
 
   /* Add the child_block to the parent_block */
   child_block_ids_[parent_block].push_back(child_block);
+
+  /* Keep the name index of the parent block up-to-date */
+  auto lookup = child_block_name_lookup_.find(parent_block);
+  if (lookup != child_block_name_lookup_.end()) {
+    VTR_ASSERT(0 == lookup->second.count(block_names_[child_block]));
+    lookup->second[block_names_[child_block]] = child_block;
+  }
   /* Register the block in the parent of the block */
   parent_block_ids_[child_block] = parent_block;
 }
 
+ConfigBitId BitstreamManager::add_bit(const ConfigBlockId& parent_block, const bool& bit_value) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(parent_block));
+
+  /* Bits of a block are contiguous, so only the block owning the last bits can grow */
+  if (0 == block_bit_lengths_[parent_block]) {
+    block_bit_id_lsbs_[parent_block] = num_bits_;
+    bit_owner_blocks_.push_back(parent_block);
+  } else {
+    VTR_ASSERT(num_bits_ == block_bit_id_lsbs_[parent_block] + block_bit_lengths_[parent_block]);
+  }
+  block_bit_lengths_[parent_block]++;
+
+  ConfigBitId bit = ConfigBitId(num_bits_);
+  uint64_t bit_word = bit_value ? 1 : 0;
+  append_bit_words(&bit_word, 1);
+
+  return bit;
+}
+
 void BitstreamManager::add_block_bits(const ConfigBlockId& block,
-                                      const std::vector<bool>& block_bitstream) {
+                                      const uint64_t* block_bit_words, const size_t& num_block_bits) {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block));
 
+  /* A block can only own a range of contiguous bits */
+  VTR_ASSERT(0 == block_bit_lengths_[block]);
+
   /* Add the bit to the block, record anchors in bit indexing for block-level searching */
   block_bit_id_lsbs_[block] = num_bits_;
-  block_bit_lengths_[block] = block_bitstream.size();
-  for (const bool& bit : block_bitstream) {
-    add_bit(block, bit);
+  block_bit_lengths_[block] = num_block_bits;
+  if (0 == num_block_bits) {
+    return;
   }
+  bit_owner_blocks_.push_back(block);
+
+  append_bit_words(block_bit_words, num_block_bits);
+}
+
+void BitstreamManager::add_block_bits(const ConfigBlockId& block,
+                                      const std::vector<bool>& block_bitstream) {
+  /* Pack the bits into words */
+  std::vector<uint64_t> block_bit_words((block_bitstream.size() + 63) / 64, 0);
+  for (size_t ibit = 0; ibit < block_bitstream.size(); ++ibit) {
+    if (true == block_bitstream[ibit]) {
+      block_bit_words[ibit / 64] |= (uint64_t(1) << (ibit % 64));
+    }
+  }
+  add_block_bits(block, block_bit_words.data(), block_bitstream.size());
 }
 
 void BitstreamManager::add_path_id_to_block(const ConfigBlockId& block, const int& path_id) {
@@ -259,6 +369,7 @@ void BitstreamManager::add_input_net_id_to_block(const ConfigBlockId& block,
                                                  const std::string& input_net_id) {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block));
+  VTR_ASSERT(true == use_net_ids_);
 
   /* Add the bit to the block */
   block_input_net_ids_[block] = input_net_id;
@@ -268,11 +379,337 @@ void BitstreamManager::add_output_net_id_to_block(const ConfigBlockId& block,
                                                   const std::string& output_net_id) {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block));
+  VTR_ASSERT(true == use_net_ids_);
 
   /* Add the bit to the block */
   block_output_net_ids_[block] = output_net_id;
 }
 
+void BitstreamManager::set_use_net_ids(const bool& enable) {
+  use_net_ids_ = enable;
+  if (false == use_net_ids_) {
+    block_input_net_ids_.clear();
+    block_output_net_ids_.clear();
+  }
+}
+
+void BitstreamManager::add_child_bitstream(const ConfigBlockId& parent_block,
+                                           const BitstreamManager& child_bitstream,
+                                           const ConfigBlockId& child_top_block) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(parent_block));
+  VTR_ASSERT(ConfigBlockId(0) == child_top_block);
+  VTR_ASSERT(true == child_bitstream.valid_block_id(child_top_block));
+  VTR_ASSERT(0 == child_bitstream.block_bit_lengths_[child_top_block]);
+  /* Ids are mapped by offsets, so the other bitstream manager should not have any invalid id */
+  VTR_ASSERT(true == child_bitstream.invalid_block_ids_.empty());
+  VTR_ASSERT(true == child_bitstream.invalid_bit_ids_.empty());
+
+  /* A block of the other bitstream manager is mapped to (id + block_offset) here,
+   * and a bit is mapped to (id + bit_offset)
+   */
+  size_t block_offset = num_blocks_ - 1;
+  size_t bit_offset = num_bits_;
+
+  /* Create the blocks */
+  for (size_t iblk = 1; iblk < child_bitstream.num_blocks_; ++iblk) {
+    ConfigBlockId child_block = ConfigBlockId(iblk);
+    ConfigBlockId block = create_block();
+    VTR_ASSERT_SAFE(size_t(block) == iblk + block_offset);
+
+    block_names_[block] = intern_block_name(child_bitstream.block_name(child_block));
+    block_path_ids_[block] = child_bitstream.block_path_ids_[child_block];
+    block_bit_lengths_[block] = child_bitstream.block_bit_lengths_[child_block];
+    if (size_t(-1) != child_bitstream.block_bit_id_lsbs_[child_block]) {
+      block_bit_id_lsbs_[block] = child_bitstream.block_bit_id_lsbs_[child_block] + bit_offset;
+    }
+  }
+
+  /* Connect the blocks */
+  for (size_t iblk = 1; iblk < child_bitstream.num_blocks_; ++iblk) {
+    ConfigBlockId child_block = ConfigBlockId(iblk);
+    ConfigBlockId block = ConfigBlockId(iblk + block_offset);
+
+    const ConfigBlockId& child_parent_block = child_bitstream.parent_block_ids_[child_block];
+    if ( (ConfigBlockId::INVALID() != child_parent_block)
+      && (child_top_block != child_parent_block) ) {
+      parent_block_ids_[block] = ConfigBlockId(size_t(child_parent_block) + block_offset);
+    }
+    child_block_ids_[block].reserve(child_bitstream.child_block_ids_[child_block].size());
+    for (const ConfigBlockId& grandchild_block : child_bitstream.child_block_ids_[child_block]) {
+      child_block_ids_[block].push_back(ConfigBlockId(size_t(grandchild_block) + block_offset));
+    }
+  }
+  for (const ConfigBlockId& child_block : child_bitstream.child_block_ids_[child_top_block]) {
+    add_child_block(parent_block, ConfigBlockId(size_t(child_block) + block_offset));
+  }
+
+  /* Copy the bits */
+  append_bit_words(child_bitstream.bit_words_.data(), child_bitstream.num_bits_);
+  for (const ConfigBlockId& child_block : child_bitstream.bit_owner_blocks_) {
+    bit_owner_blocks_.push_back(ConfigBlockId(size_t(child_block) + block_offset));
+  }
+
+  /* Copy the net ids */
+  if (true == use_net_ids_) {
+    for (const auto& net_ids : child_bitstream.block_input_net_ids_) {
+      block_input_net_ids_[ConfigBlockId(size_t(net_ids.first) + block_offset)] = net_ids.second;
+    }
+    for (const auto& net_ids : child_bitstream.block_output_net_ids_) {
+      block_output_net_ids_[ConfigBlockId(size_t(net_ids.first) + block_offset)] = net_ids.second;
+    }
+  }
+}
+
+size_t BitstreamManager::update_child_bitstream(const ConfigBlockId& parent_block,
+                                                const BitstreamManager& child_bitstream,
+                                                const ConfigBlockId& child_top_block) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(parent_block));
+  VTR_ASSERT(true == child_bitstream.valid_block_id(child_top_block));
+
+  size_t num_changed_bits = 0;
+  for (const ConfigBlockId& child_block : child_bitstream.block_children(child_top_block)) {
+    ConfigBlockId block = find_child_block(parent_block, child_bitstream.block_name(child_block));
+    VTR_ASSERT(true == valid_block_id(block));
+    num_changed_bits += rec_update_block(block, child_bitstream, child_block);
+  }
+  return num_changed_bits;
+}
+
+void BitstreamManager::set_bit_value(const ConfigBitId& bit_id, const bool& bit_value) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_bit_id(bit_id));
+
+  const uint64_t mask = uint64_t(1) << (size_t(bit_id) % 64);
+  if (true == bit_value) {
+    bit_words_[size_t(bit_id) / 64] |= mask;
+  } else {
+    bit_words_[size_t(bit_id) / 64] &= ~mask;
+  }
+}
+
+void BitstreamManager::compress() {
+  /* Nothing to do when all the ids are valid */
+  if ( (true == invalid_block_ids_.empty())
+    && (true == invalid_bit_ids_.empty()) ) {
+    return;
+  }
+
+  /* Build the mapping from old ids to new ids */
+  vtr::vector<ConfigBlockId, ConfigBlockId> block_id_map(num_blocks_, ConfigBlockId::INVALID());
+  size_t num_valid_blocks = 0;
+  for (size_t iblk = 0; iblk < num_blocks_; ++iblk) {
+    if (0 == invalid_block_ids_.count(ConfigBlockId(iblk))) {
+      block_id_map[ConfigBlockId(iblk)] = ConfigBlockId(num_valid_blocks);
+      num_valid_blocks++;
+    }
+  }
+
+  vtr::vector<ConfigBitId, ConfigBitId> bit_id_map(num_bits_, ConfigBitId::INVALID());
+  size_t num_valid_bits = 0;
+  for (size_t ibit = 0; ibit < num_bits_; ++ibit) {
+    if (0 == invalid_bit_ids_.count(ConfigBitId(ibit))) {
+      bit_id_map[ConfigBitId(ibit)] = ConfigBitId(num_valid_bits);
+      num_valid_bits++;
+    }
+  }
+
+  /* Update the block ranges of bits before the bits are moved */
+  for (size_t iblk = 0; iblk < num_blocks_; ++iblk) {
+    ConfigBlockId block = ConfigBlockId(iblk);
+    size_t lsb = block_bit_id_lsbs_[block];
+    size_t length = block_bit_lengths_[block];
+    block_bit_id_lsbs_[block] = size_t(-1);
+    block_bit_lengths_[block] = 0;
+    for (size_t ibit = lsb; ibit < lsb + length; ++ibit) {
+      const ConfigBitId& new_bit = bit_id_map[ConfigBitId(ibit)];
+      if (ConfigBitId::INVALID() == new_bit) {
+        continue;
+      }
+      if (0 == block_bit_lengths_[block]) {
+        block_bit_id_lsbs_[block] = size_t(new_bit);
+      }
+      block_bit_lengths_[block]++;
+    }
+  }
+
+  /* Move the bits, a new id is never larger than its old id so the words can be updated in place */
+  for (size_t ibit = 0; ibit < num_bits_; ++ibit) {
+    const ConfigBitId& new_bit = bit_id_map[ConfigBitId(ibit)];
+    if (ConfigBitId::INVALID() == new_bit) {
+      continue;
+    }
+    const uint64_t mask = uint64_t(1) << (size_t(new_bit) % 64);
+    if (true == bit_value(ConfigBitId(ibit))) {
+      bit_words_[size_t(new_bit) / 64] |= mask;
+    } else {
+      bit_words_[size_t(new_bit) / 64] &= ~mask;
+    }
+  }
+  bit_words_.resize((num_valid_bits + 63) / 64);
+
+  /* Update the owners of bits, which keep the same order */
+  std::vector<ConfigBlockId, vtr::MappedAllocator<ConfigBlockId>> bit_owner_blocks;
+  bit_owner_blocks.reserve(bit_owner_blocks_.size());
+  for (const ConfigBlockId& block : bit_owner_blocks_) {
+    if ( (ConfigBlockId::INVALID() != block_id_map[block])
+      && (0 < block_bit_lengths_[block]) ) {
+      bit_owner_blocks.push_back(block_id_map[block]);
+    }
+  }
+  bit_owner_blocks_.swap(bit_owner_blocks);
+
+  /* Move the blocks */
+  for (size_t iblk = 0; iblk < num_blocks_; ++iblk) {
+    ConfigBlockId block = ConfigBlockId(iblk);
+    const ConfigBlockId& new_block = block_id_map[block];
+    if (ConfigBlockId::INVALID() == new_block) {
+      continue;
+    }
+    block_names_[new_block] = block_names_[block];
+    block_bit_id_lsbs_[new_block] = block_bit_id_lsbs_[block];
+    block_bit_lengths_[new_block] = block_bit_lengths_[block];
+    block_path_ids_[new_block] = block_path_ids_[block];
+
+    const ConfigBlockId& parent_block = parent_block_ids_[block];
+    parent_block_ids_[new_block] = valid_block_id(parent_block) ? block_id_map[parent_block] : ConfigBlockId::INVALID();
+
+    std::vector<ConfigBlockId> new_children;
+    new_children.reserve(child_block_ids_[block].size());
+    for (const ConfigBlockId& child_block : child_block_ids_[block]) {
+      if (ConfigBlockId::INVALID() != block_id_map[child_block]) {
+        new_children.push_back(block_id_map[child_block]);
+      }
+    }
+    child_block_ids_[new_block] = new_children;
+  }
+  block_names_.resize(num_valid_blocks);
+  block_bit_id_lsbs_.resize(num_valid_blocks);
+  block_bit_lengths_.resize(num_valid_blocks);
+  block_path_ids_.resize(num_valid_blocks);
+  parent_block_ids_.resize(num_valid_blocks);
+
+  /* Move the net ids of the blocks */
+  for (std::unordered_map<ConfigBlockId, std::string>* net_ids : {&block_input_net_ids_, &block_output_net_ids_}) {
+    std::unordered_map<ConfigBlockId, std::string> new_net_ids;
+    new_net_ids.reserve(net_ids->size());
+    for (auto& block_net_ids : *net_ids) {
+      const ConfigBlockId& new_block = block_id_map[block_net_ids.first];
+      if (ConfigBlockId::INVALID() != new_block) {
+        new_net_ids[new_block] = std::move(block_net_ids.second);
+      }
+    }
+    net_ids->swap(new_net_ids);
+  }
+  child_block_ids_.resize(num_valid_blocks);
+
+  /* The name indices are rebuilt on demand with the new block ids */
+  child_block_name_lookup_.clear();
+
+  num_blocks_ = num_valid_blocks;
+  num_bits_ = num_valid_bits;
+  invalid_block_ids_.clear();
+  invalid_bit_ids_.clear();
+}
+
+/******************************************************************************
+ * Private Mutators
+ ******************************************************************************/
+void BitstreamManager::append_bit_words(const uint64_t* new_bit_words, const size_t& num_new_bits) {
+  if (0 == num_new_bits) {
+    return;
+  }
+
+  /* Words are copied as they are when the last word is full,
+   * otherwise each word is split into the free bits of the last word and a new word
+   */
+  size_t num_new_words = (num_new_bits + 63) / 64;
+  size_t offset = num_bits_ % 64;
+  if (0 == offset) {
+    bit_words_.insert(bit_words_.end(), new_bit_words, new_bit_words + num_new_words);
+  } else {
+    for (size_t iword = 0; iword < num_new_words; ++iword) {
+      bit_words_.back() |= (new_bit_words[iword] << offset);
+      bit_words_.push_back(new_bit_words[iword] >> (64 - offset));
+    }
+  }
+  num_bits_ += num_new_bits;
+
+  /* Drop the words beyond the last bit and clear the unused bits of the last word */
+  bit_words_.resize((num_bits_ + 63) / 64);
+  if (0 != num_bits_ % 64) {
+    bit_words_.back() &= (uint64_t(1) << (num_bits_ % 64)) - 1;
+  }
+}
+
+uint32_t BitstreamManager::intern_block_name(const std::string& block_name) {
+  auto result = block_name_ids_.find(block_name);
+  if (result != block_name_ids_.end()) {
+    return result->second;
+  }
+  VTR_ASSERT(std::numeric_limits<uint32_t>::max() > block_name_pool_.size());
+  uint32_t name_id = block_name_pool_.size();
+  block_name_pool_.push_back(block_name);
+  block_name_ids_[block_name] = name_id;
+  return name_id;
+}
+
+size_t BitstreamManager::rec_update_block(const ConfigBlockId& block,
+                                          const BitstreamManager& other_bitstream,
+                                          const ConfigBlockId& other_block) {
+  /* The blocks should be built for the same fabric */
+  VTR_ASSERT(block_name(block) == other_bitstream.block_name(other_block));
+  VTR_ASSERT(block_bit_lengths_[block] == other_bitstream.block_bit_lengths_[other_block]);
+  VTR_ASSERT(child_block_ids_[block].size() == other_bitstream.child_block_ids_[other_block].size());
+
+  size_t num_changed_bits = 0;
+  for (size_t ibit = 0; ibit < size_t(block_bit_lengths_[block]); ++ibit) {
+    ConfigBitId bit = ConfigBitId(block_bit_id_lsbs_[block] + ibit);
+    bool other_bit_value = other_bitstream.bit_value(ConfigBitId(other_bitstream.block_bit_id_lsbs_[other_block] + ibit));
+    if (other_bit_value != bit_value(bit)) {
+      set_bit_value(bit, other_bit_value);
+      num_changed_bits++;
+    }
+  }
+
+  block_path_ids_[block] = other_bitstream.block_path_ids_[other_block];
+
+  if (true == use_net_ids_) {
+    block_input_net_ids_.erase(block);
+    block_output_net_ids_.erase(block);
+    if (true == other_bitstream.use_net_ids_) {
+      std::string input_net_ids = other_bitstream.block_input_net_ids(other_block);
+      if (false == input_net_ids.empty()) {
+        block_input_net_ids_[block] = input_net_ids;
+      }
+      std::string output_net_ids = other_bitstream.block_output_net_ids(other_block);
+      if (false == output_net_ids.empty()) {
+        block_output_net_ids_[block] = output_net_ids;
+      }
+    }
+  }
+
+  /* Children are created in the same order for the same fabric */
+  for (size_t ichild = 0; ichild < child_block_ids_[block].size(); ++ichild) {
+    num_changed_bits += rec_update_block(child_block_ids_[block][ichild],
+                                         other_bitstream,
+                                         other_bitstream.child_block_ids_[other_block][ichild]);
+  }
+
+  return num_changed_bits;
+}
+
+void BitstreamManager::build_child_block_name_lookup(const ConfigBlockId& parent_block) const {
+  std::unordered_map<uint32_t, ConfigBlockId>& lookup = child_block_name_lookup_[parent_block];
+  lookup.reserve(child_block_ids_[parent_block].size());
+  for (const ConfigBlockId& child : child_block_ids_[parent_block]) {
+    /* Children should have unique names */
+    VTR_ASSERT(0 == lookup.count(block_names_[child]));
+    lookup[block_names_[child]] = child;
+  }
+}
+
 /******************************************************************************
  * Public Validators
  ******************************************************************************/
@@ -34,11 +34,15 @@
 #ifndef BITSTREAM_MANAGER_H
 #define BITSTREAM_MANAGER_H
 
+#include <cstdint>
+#include <string>
 #include <vector>
 #include <map>
 #include <unordered_set>
 #include <unordered_map>
 #include "vtr_vector.h"
+#include "vtr_memory_stats.h"
+#include "vtr_mapped_storage.h"
 
 #include "bitstream_manager_fwd.h"
 
@@ -57,6 +61,9 @@ class BitstreamManager {
      * It is used to lazily create an iteration range (e.g. as returned by RRGraph::edges() RRGraph::nodes())
      * just based on the count of allocated elements (i.e. RRGraph::num_nodes_ or RRGraph::num_edges_),
      * and the set of any invalid IDs (i.e. RRGraph::invalid_node_ids_, RRGraph::invalid_edge_ids_).
+     *
+     * When the invalid ID set is empty at the time the iterator is created, 
+     * the range is a plain contiguous ID range and dereferencing skips the look-up on the set.
      */
     template<class ID>
     class lazy_id_iterator : public std::iterator<std::bidirectional_iterator_tag, ID> {
@@ -68,7 +75,8 @@ class BitstreamManager {
 
         lazy_id_iterator(value_type init, const std::unordered_set<ID>& invalid_ids)
             : value_(init)
-            , invalid_ids_(invalid_ids) {}
+            , invalid_ids_(invalid_ids)
+            , is_compact_(invalid_ids.empty()) {}
 
         //Advance to the next ID value
         iterator operator++() {
@@ -83,7 +91,7 @@ class BitstreamManager {
         }
 
         //Dereference the iterator
-        value_type operator*() const { return (invalid_ids_.count(value_)) ? ID::INVALID() : value_; }
+        value_type operator*() const { return (!is_compact_ && invalid_ids_.count(value_)) ? ID::INVALID() : value_; }
 
         friend bool operator==(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return lhs.value_ == rhs.value_; }
         friend bool operator!=(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return !(lhs == rhs); }
@@ -91,6 +99,7 @@ class BitstreamManager {
       private:
         value_type value_;
         const std::unordered_set<ID>& invalid_ids_;
+        bool is_compact_;
     };
 
   public: /* Public constructor */
@@ -123,18 +132,21 @@ class BitstreamManager {
     ConfigBlockId bit_parent_block(const ConfigBitId& bit_id) const;
 
     /* Find a name of a block */
-    std::string block_name(const ConfigBlockId& block_id) const;
+    const std::string& block_name(const ConfigBlockId& block_id) const;
 
     /* Find the parent of a block */
     ConfigBlockId block_parent(const ConfigBlockId& block_id) const;
 
     /* Find the children of a block */
-    std::vector<ConfigBlockId> block_children(const ConfigBlockId& block_id) const;
+    const std::vector<ConfigBlockId>& block_children(const ConfigBlockId& block_id) const;
 
     /* Find all the bits that belong to a block */
     std::vector<ConfigBitId> block_bits(const ConfigBlockId& block_id) const;
 
-    /* Find the child block in a bitstream manager with a given name */
+    /* Find the child block in a bitstream manager with a given name 
+     * Blocks with many children are indexed by name on the first search,
+     * so that the search does not scale with the number of children
+     */
     ConfigBlockId find_child_block(const ConfigBlockId& block_id, const std::string& child_block_name) const;
 
     /* Find path id of a block */
@@ -146,8 +158,16 @@ class BitstreamManager {
     /* Find input net ids of a block */
     std::string block_output_net_ids(const ConfigBlockId& block_id) const;
 
+    /* Check if net ids of blocks are stored or not */
+    bool use_net_ids() const;
+
+    /* Estimate the memory (in bytes) occupied by the bitstream database */
+    size_t memory_footprint() const;
+
   public:  /* Public Mutators */
-    /* Add a new configuration bit to the bitstream manager */
+    /* Add a new configuration bit to a block of the bitstream manager
+     * Bits of a block are contiguous, so the block should be the last one which owns bits
+     */
     ConfigBitId add_bit(const ConfigBlockId& parent_block, const bool& bit_value);
 
     /* Reserve memory for a number of clocks */
@@ -173,7 +193,12 @@ class BitstreamManager {
     /* Set a block as a child block of another */
     void add_child_block(const ConfigBlockId& parent_block, const ConfigBlockId& child_block);
 
-    /* Add a bitstream to a block */
+    /* Add a bitstream to a block 
+     * The bits are packed in words, where bit i is the (i % 64)-th least significant bit of word (i / 64)
+     * A block can only own one range of bits, so bits should be added once for each block
+     */
+    void add_block_bits(const ConfigBlockId& block,
+                        const uint64_t* block_bit_words, const size_t& num_block_bits);
     void add_block_bits(const ConfigBlockId& block,
                         const std::vector<bool>& block_bitstream);
 
@@ -186,6 +211,46 @@ class BitstreamManager {
     /* Add an output net id to a block */
     void add_output_net_id_to_block(const ConfigBlockId& block, const std::string& output_net_id);
 
+    /* Enable the storage of input and output net ids of blocks (enabled by default)
+     * They are only useful when the bitstream is written to a file,
+     * so the bitstream builders can skip them to save memory when disabled
+     * Disabling it will drop any stored net ids
+     */
+    void set_use_net_ids(const bool& enable);
+
+    /* Move all the blocks and bits of another bitstream manager under a block
+     * The children of the top block of the other bitstream manager become
+     * the children of the parent block, while the top block itself is dropped.
+     * Blocks and bits keep their order, so that building a part of the bitstream
+     * in a separated bitstream manager and adding it here leads to the same ids
+     * as building it here directly.
+     * The top block should be the first block of the other bitstream manager
+     * and should not have any bits
+     */
+    void add_child_bitstream(const ConfigBlockId& parent_block,
+                             const BitstreamManager& child_bitstream,
+                             const ConfigBlockId& child_top_block);
+
+    /* Update the blocks which are children of a block with another bitstream manager
+     * Each child of the top block of the other bitstream manager replaces
+     * the bits, path ids and net ids of the child block with the same name under the parent block.
+     * The blocks should have the same hierarchy, which is the case when 
+     * they are built for the same fabric.
+     * Return the number of bits whose values are changed
+     */
+    size_t update_child_bitstream(const ConfigBlockId& parent_block,
+                                  const BitstreamManager& child_bitstream,
+                                  const ConfigBlockId& child_top_block);
+
+    /* Change the value of a bit */
+    void set_bit_value(const ConfigBitId& bit_id, const bool& bit_value);
+
+    /* Remove the invalid blocks and bits, and renumber the remaining ones
+     * so that the ranges of blocks and bits become contiguous.
+     * Note that any block or bit id obtained before this call may be outdated
+     */
+    void compress();
+
   public:  /* Public Validators */
     bool valid_bit_id(const ConfigBitId& bit_id) const;
 
@@ -193,12 +258,39 @@ class BitstreamManager {
 
     bool valid_block_path_id(const ConfigBlockId& block_id) const;
 
+  private: /* Private Mutators */
+    /* Append a number of configuration bits, packed in words, to the bitstream manager */
+    void append_bit_words(const uint64_t* new_bit_words, const size_t& num_new_bits);
+
+    /* Update a block and its children with the same block of another bitstream manager */
+    size_t rec_update_block(const ConfigBlockId& block,
+                            const BitstreamManager& other_bitstream,
+                            const ConfigBlockId& other_block);
+
+    /* Build the name index of the children of a block */
+    void build_child_block_name_lookup(const ConfigBlockId& parent_block) const;
+
+    /* Find the id of a name in the pool, which is added if not found */
+    uint32_t intern_block_name(const std::string& block_name);
+
   private: /* Internal data */
+    /* Owner of the memory of the bits, when memory accounting is enabled (see vtr_memory_stats.h) */
+    struct BitMemoryTag {
+      static const char* name() { return "BitstreamManager bits"; }
+    };
+
+    /* The arrays whose size is proportional to the number of blocks or bits
+     * are placed in mapped storage when it is enabled (see vtr_mapped_storage.h),
+     * so that the bitstream of a large fabric may exceed the physical memory
+     */
+    template<typename T>
+    using BlockVector = vtr::vector<ConfigBlockId, T, vtr::MappedAllocator<T>>;
+
     /* Unique id of a block of bits in the Bitstream */
     size_t num_blocks_; 
     std::unordered_set<ConfigBlockId> invalid_block_ids_;
-    vtr::vector<ConfigBlockId, size_t> block_bit_id_lsbs_; 
-    vtr::vector<ConfigBlockId, short> block_bit_lengths_; 
+    BlockVector<size_t> block_bit_id_lsbs_; 
+    BlockVector<short> block_bit_lengths_; 
 
     /* Back-annotation for the bits */
     /* Parent block of a bit in the Bitstream 
@@ -207,10 +299,23 @@ class BitstreamManager {
      * Note that the blocks here all unique, unlike ModuleManager where modules can be instanciated 
      * Therefore, this block graph can be considered as a flattened graph of ModuleGraph
      */
-    vtr::vector<ConfigBlockId, std::string> block_names_; 
-    vtr::vector<ConfigBlockId, ConfigBlockId> parent_block_ids_; 
+    BlockVector<uint32_t> block_names_; 
+    BlockVector<ConfigBlockId> parent_block_ids_; 
     vtr::vector<ConfigBlockId, std::vector<ConfigBlockId>> child_block_ids_; 
 
+    /* Fast look-up for children by name, only for the parent blocks which have many children
+     * and have been searched by find_child_block().
+     * It is built on demand and kept up-to-date by the mutators
+     */
+    mutable std::unordered_map<ConfigBlockId, std::unordered_map<uint32_t, ConfigBlockId>> child_block_name_lookup_;
+
+    /* Pool of block names
+     * Many blocks share the same name (e.g., the memories of identical switch blocks),
+     * so each distinct name is stored once and blocks refer to it by its index in the pool
+     */
+    std::vector<std::string> block_name_pool_;
+    std::unordered_map<std::string, uint32_t> block_name_ids_;
+
     /* The ids of the inputs of routing multiplexer blocks which is propagated to outputs 
      * By default, it will be -2 (which is invalid)
      * A valid id starts from -1 
@@ -222,23 +327,32 @@ class BitstreamManager {
      *   -Bitstream manager will NOT check if the id is good for bitstream builders
      *    It just store the results
      */
-    vtr::vector<ConfigBlockId, short> block_path_ids_; 
+    BlockVector<short> block_path_ids_; 
 
     /* Net ids that are mapped to inputs and outputs of this block
+     * Only a few blocks (routing multiplexers) have net ids, 
+     * so they are stored in side tables for the blocks which have them
      * 
      * Note: 
      *   -Bitstream manager will NOT check if the id is good for bitstream builders
      *    It just store the results
      */
-    vtr::vector<ConfigBlockId, std::string> block_input_net_ids_; 
-    vtr::vector<ConfigBlockId, std::string> block_output_net_ids_; 
+    bool use_net_ids_;
+    std::unordered_map<ConfigBlockId, std::string> block_input_net_ids_; 
+    std::unordered_map<ConfigBlockId, std::string> block_output_net_ids_; 
 
     /* Unique id of a bit in the Bitstream */
     size_t num_bits_; 
     std::unordered_set<ConfigBitId> invalid_bit_ids_; 
-    /* value of a bit in the Bitstream */
-    vtr::vector<ConfigBitId, char> bit_values_;
-    vtr::vector<ConfigBitId, ConfigBlockId> bit_parent_blocks_;
+    /* Value of bits in the Bitstream, packed in 64-bit words 
+     * The value of bit i is the (i % 64)-th least significant bit of word (i / 64)
+     */
+    std::vector<uint64_t, vtr::TaggedAllocator<uint64_t, BitMemoryTag, vtr::MappedAllocator<uint64_t>>> bit_words_;
+    /* Blocks which own bits, in the increasing order of their bit lsbs
+     * Since bits of a block are contiguous, the parent block of a bit 
+     * is found by a binary search on the bit ranges of these blocks
+     */
+    std::vector<ConfigBlockId, vtr::MappedAllocator<ConfigBlockId>> bit_owner_blocks_;
 };
 
 } /* end namespace openfpga */
@@ -0,0 +1,202 @@
+/********************************************************************
+ * This file includes functions to compare two bitstream databases,
+ * e.g., the bitstreams generated by two versions of OpenFPGA.
+ *
+ * The hash of a block covers its path id, its bits and the names and
+ * hashes of its children, so that two blocks with the same hash have
+ * the same subtree. The comparison only descends into the children
+ * whose hashes differ, so that its cost follows the number of differences
+ * rather than the size of the bitstreams.
+ *******************************************************************/
+#include <algorithm>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_hash.h"
+
+#include "bitstream_manager_utils.h"
+#include "compare_arch_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Compute the hash of the subtree of each block of a bitstream database 
+ * The blocks are visited in the reversed depth-first order, 
+ * so that the hashes of the children are computed before their parents
+ *******************************************************************/
+vtr::vector<ConfigBlockId, uint64_t> build_bitstream_block_hashes(const BitstreamManager& bitstream_manager) {
+  vtr::vector<ConfigBlockId, uint64_t> block_hashes(bitstream_manager.num_blocks(), vtr::CHECKSUM_INIT);
+
+  std::vector<ConfigBlockId> dfs_blocks;
+  dfs_blocks.reserve(bitstream_manager.num_blocks());
+  std::vector<ConfigBlockId> block_stack = find_bitstream_manager_top_blocks(bitstream_manager);
+  while (!block_stack.empty()) {
+    ConfigBlockId block = block_stack.back();
+    block_stack.pop_back();
+    dfs_blocks.push_back(block);
+    for (const ConfigBlockId& child_block : bitstream_manager.block_children(block)) {
+      block_stack.push_back(child_block);
+    }
+  }
+
+  for (auto it = dfs_blocks.rbegin(); it != dfs_blocks.rend(); ++it) {
+    const ConfigBlockId& block = *it;
+    uint64_t& block_hash = block_hashes[block];
+
+    vtr::checksum_combine(block_hash, bitstream_manager.block_path_id(block));
+    std::vector<ConfigBitId> block_bits = bitstream_manager.block_bits(block);
+    vtr::checksum_combine(block_hash, block_bits.size());
+    for (const ConfigBitId& bit : block_bits) {
+      vtr::checksum_combine(block_hash, bitstream_manager.bit_value(bit));
+    }
+
+    for (const ConfigBlockId& child_block : bitstream_manager.block_children(block)) {
+      for (const char& name_char : bitstream_manager.block_name(child_block)) {
+        vtr::checksum_combine(block_hash, name_char);
+      }
+      vtr::checksum_combine(block_hash, block_hashes[child_block]);
+    }
+  }
+
+  return block_hashes;
+}
+
+/********************************************************************
+ * Return a description of the difference between the path ids 
+ * and the bits of two blocks, or an empty string if they are the same
+ *******************************************************************/
+static 
+std::string compare_bitstream_block_bits(const BitstreamManager& bitstream_manager,
+                                         const ConfigBlockId& block,
+                                         const BitstreamManager& ref_bitstream_manager,
+                                         const ConfigBlockId& ref_block) {
+  if (bitstream_manager.block_path_id(block) != ref_bitstream_manager.block_path_id(ref_block)) {
+    return std::string("path id ") + std::to_string(bitstream_manager.block_path_id(block))
+         + std::string(" (reference: ") + std::to_string(ref_bitstream_manager.block_path_id(ref_block)) + std::string(")");
+  }
+
+  std::vector<ConfigBitId> block_bits = bitstream_manager.block_bits(block);
+  std::vector<ConfigBitId> ref_block_bits = ref_bitstream_manager.block_bits(ref_block);
+  if (block_bits.size() != ref_block_bits.size()) {
+    return std::to_string(block_bits.size()) + std::string(" bits (reference: ")
+         + std::to_string(ref_block_bits.size()) + std::string(")");
+  }
+
+  std::string bits;
+  std::string ref_bits;
+  bool bits_differ = false;
+  for (size_t ibit = 0; ibit < block_bits.size(); ++ibit) {
+    bits.push_back(bitstream_manager.bit_value(block_bits[ibit]) ? '1' : '0');
+    ref_bits.push_back(ref_bitstream_manager.bit_value(ref_block_bits[ibit]) ? '1' : '0');
+    bits_differ |= (bits.back() != ref_bits.back()); 
+  }
+  if (true == bits_differ) {
+    return std::string("bits ") + bits + std::string(" (reference: ") + ref_bits + std::string(")");
+  }
+
+  return std::string();
+}
+
+/********************************************************************
+ * Recursively compare two blocks whose subtrees have different hashes 
+ *******************************************************************/
+static 
+void rec_compare_bitstream_blocks(const BitstreamManager& bitstream_manager,
+                                  const vtr::vector<ConfigBlockId, uint64_t>& block_hashes,
+                                  const ConfigBlockId& block,
+                                  const BitstreamManager& ref_bitstream_manager,
+                                  const vtr::vector<ConfigBlockId, uint64_t>& ref_block_hashes,
+                                  const ConfigBlockId& ref_block,
+                                  const std::string& block_path,
+                                  const size_t& max_differences,
+                                  std::vector<BitstreamDifference>& differences) {
+  if (block_hashes[block] == ref_block_hashes[ref_block]) {
+    return;
+  }
+  size_t num_prev_differences = differences.size();
+
+  std::string bits_difference = compare_bitstream_block_bits(bitstream_manager, block,
+                                                             ref_bitstream_manager, ref_block);
+  if (false == bits_difference.empty()) {
+    differences.push_back({block_path, bits_difference});
+  }
+
+  /* Children are matched by their names */
+  for (const ConfigBlockId& ref_child_block : ref_bitstream_manager.block_children(ref_block)) {
+    if (differences.size() >= max_differences) {
+      return;
+    }
+    const std::string& child_name = ref_bitstream_manager.block_name(ref_child_block);
+    std::string child_path = block_path + std::string(".") + child_name;
+    ConfigBlockId child_block = bitstream_manager.find_child_block(block, child_name);
+    if (false == bitstream_manager.valid_block_id(child_block)) {
+      differences.push_back({child_path, std::string("missing block")});
+      continue;
+    }
+    rec_compare_bitstream_blocks(bitstream_manager, block_hashes, child_block,
+                                 ref_bitstream_manager, ref_block_hashes, ref_child_block,
+                                 child_path, max_differences, differences);
+  }
+  for (const ConfigBlockId& child_block : bitstream_manager.block_children(block)) {
+    if (differences.size() >= max_differences) {
+      return;
+    }
+    const std::string& child_name = bitstream_manager.block_name(child_block);
+    if (false == ref_bitstream_manager.valid_block_id(ref_bitstream_manager.find_child_block(ref_block, child_name))) {
+      differences.push_back({block_path + std::string(".") + child_name, std::string("extra block")});
+    }
+  }
+
+  /* The same children with the same contents, which are in a different order */
+  if (num_prev_differences == differences.size()) {
+    differences.push_back({block_path, std::string("different order of child blocks")});
+  }
+}
+
+/********************************************************************
+ * Compare a bitstream database to a reference, and return the blocks which differ,
+ * up to a maximum number of differences
+ * Top-level blocks and child blocks are matched by their names
+ *******************************************************************/
+std::vector<BitstreamDifference> compare_architecture_bitstreams(const BitstreamManager& bitstream_manager,
+                                                                 const BitstreamManager& ref_bitstream_manager,
+                                                                 const size_t& max_differences) {
+  std::vector<BitstreamDifference> differences;
+
+  vtr::vector<ConfigBlockId, uint64_t> block_hashes = build_bitstream_block_hashes(bitstream_manager);
+  vtr::vector<ConfigBlockId, uint64_t> ref_block_hashes = build_bitstream_block_hashes(ref_bitstream_manager);
+
+  std::vector<ConfigBlockId> top_blocks = find_bitstream_manager_top_blocks(bitstream_manager);
+  std::vector<ConfigBlockId> ref_top_blocks = find_bitstream_manager_top_blocks(ref_bitstream_manager);
+
+  for (const ConfigBlockId& ref_top_block : ref_top_blocks) {
+    if (differences.size() >= max_differences) {
+      break;
+    }
+    const std::string& top_name = ref_bitstream_manager.block_name(ref_top_block);
+    auto top_block = std::find_if(top_blocks.begin(), top_blocks.end(),
+                                  [&](const ConfigBlockId& cand_block) { return bitstream_manager.block_name(cand_block) == top_name; });
+    if (top_block == top_blocks.end()) {
+      differences.push_back({top_name, std::string("missing block")});
+      continue;
+    }
+    rec_compare_bitstream_blocks(bitstream_manager, block_hashes, *top_block,
+                                 ref_bitstream_manager, ref_block_hashes, ref_top_block,
+                                 top_name, max_differences, differences);
+  }
+  for (const ConfigBlockId& top_block : top_blocks) {
+    if (differences.size() >= max_differences) {
+      break;
+    }
+    const std::string& top_name = bitstream_manager.block_name(top_block);
+    if (ref_top_blocks.end() == std::find_if(ref_top_blocks.begin(), ref_top_blocks.end(),
+                                             [&](const ConfigBlockId& cand_block) { return ref_bitstream_manager.block_name(cand_block) == top_name; })) {
+      differences.push_back({top_name, std::string("extra block")});
+    }
+  }
+
+  return differences;
+}
+
+} /* end namespace openfpga */
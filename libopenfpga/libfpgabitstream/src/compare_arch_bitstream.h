@@ -0,0 +1,36 @@
+#ifndef COMPARE_ARCH_BITSTREAM_H
+#define COMPARE_ARCH_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "vtr_vector.h"
+#include "bitstream_manager.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* A block which differs between two bitstream databases */
+struct BitstreamDifference {
+  /* Path of the block from its top-level block, e.g., fpga_top.grid_clb_1__1_.mem_fle_0 */
+  std::string block_path;
+  /* What differs in the block */
+  std::string reason;
+};
+
+vtr::vector<ConfigBlockId, uint64_t> build_bitstream_block_hashes(const BitstreamManager& bitstream_manager);
+
+std::vector<BitstreamDifference> compare_architecture_bitstreams(const BitstreamManager& bitstream_manager,
+                                                                 const BitstreamManager& ref_bitstream_manager,
+                                                                 const size_t& max_differences);
+
+} /* end namespace openfpga */
+
+#endif
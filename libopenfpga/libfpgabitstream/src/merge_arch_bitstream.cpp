@@ -0,0 +1,71 @@
+/********************************************************************
+ * This file includes functions to merge the bitstream databases
+ * built for a number of shards of a device, i.e., windows of the grids
+ * and routing blocks, into the bitstream database of the whole device.
+ *
+ * The blocks under the top-level block of a shard are appended to the
+ * top-level block of the merged database. Their order does not matter,
+ * since the fabric-dependent bitstream finds the blocks by their names
+ * while walking the configuration order of the fabric.
+ *******************************************************************/
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+#include "merge_arch_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Merge the bitstream database of a shard into a bitstream database,
+ * which is empty before the first shard is merged.
+ * The shards should be built for the same fabric, and should not overlap
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int merge_architecture_bitstream(BitstreamManager& bitstream_manager,
+                                 const BitstreamManager& shard_bitstream_manager,
+                                 const std::string& shard_name) {
+  /* The first block of a database is its top-level block */
+  const ConfigBlockId shard_top_block = ConfigBlockId(0);
+  if ( (false == shard_bitstream_manager.valid_block_id(shard_top_block))
+    || (ConfigBlockId::INVALID() != shard_bitstream_manager.block_parent(shard_top_block))
+    || (0 != shard_bitstream_manager.block_bits(shard_top_block).size()) ) {
+    VTR_LOG_ERROR("Bitstream database of shard '%s' does not start with a top-level block without bits!\n",
+                  shard_name.c_str());
+    return 1;
+  }
+
+  if (0 == bitstream_manager.num_blocks()) {
+    bitstream_manager.set_use_net_ids(shard_bitstream_manager.use_net_ids());
+    bitstream_manager.add_block(shard_bitstream_manager.block_name(shard_top_block));
+  }
+  const ConfigBlockId top_block = ConfigBlockId(0);
+
+  if (bitstream_manager.block_name(top_block) != shard_bitstream_manager.block_name(shard_top_block)) {
+    VTR_LOG_ERROR("Top-level block '%s' of shard '%s' does not match the top-level block '%s' of the other shards!\n",
+                  shard_bitstream_manager.block_name(shard_top_block).c_str(),
+                  shard_name.c_str(),
+                  bitstream_manager.block_name(top_block).c_str());
+    return 1;
+  }
+
+  /* Overlapping shards would duplicate the blocks */
+  for (const ConfigBlockId& shard_block : shard_bitstream_manager.block_children(shard_top_block)) {
+    const std::string& block_name = shard_bitstream_manager.block_name(shard_block);
+    if (true == bitstream_manager.valid_block_id(bitstream_manager.find_child_block(top_block, block_name))) {
+      VTR_LOG_ERROR("Block '%s' of shard '%s' is already merged from another shard!\n",
+                    block_name.c_str(), shard_name.c_str());
+      return 1;
+    }
+  }
+
+  bitstream_manager.add_child_bitstream(top_block, shard_bitstream_manager, shard_top_block);
+
+  return 0;
+}
+
+} /* end namespace openfpga */
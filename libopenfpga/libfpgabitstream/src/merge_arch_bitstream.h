@@ -0,0 +1,23 @@
+#ifndef MERGE_ARCH_BITSTREAM_H
+#define MERGE_ARCH_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "bitstream_manager.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int merge_architecture_bitstream(BitstreamManager& bitstream_manager,
+                                 const BitstreamManager& shard_bitstream_manager,
+                                 const std::string& shard_name);
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,196 @@
+/********************************************************************
+ * This file includes the top-level function of this library
+ * which reads an architecture bitstream in binary format
+ * to the associated data structures
+ * See binary_arch_bitstream.h for the details of the file layout
+ *******************************************************************/
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <string>
+#include <vector>
+
+/* Headers from vtr util library */
+#include "vtr_assert.h"
+#include "vtr_time.h"
+
+/* Headers from libarchfpga */
+#include "arch_error.h"
+
+#include "openfpga_reserved_words.h"
+
+#include "binary_arch_bitstream.h"
+#include "read_binary_arch_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Read a number of bytes from the file and error out if the file is truncated
+ *******************************************************************/
+static
+void read_binary_arch_bitstream_bytes(std::istream& fp,
+                                      char* data,
+                                      const size_t& num_bytes,
+                                      const char* fname) {
+  fp.read(data, num_bytes);
+  if (size_t(fp.gcount()) != num_bytes) {
+    archfpga_throw(fname, 0,
+                   "Binary architecture bitstream file '%s' is truncated!\n",
+                   fname);
+  }
+}
+
+/********************************************************************
+ * Read an architecture bitstream in binary format from a stream
+ * to an object of BitstreamManager
+ * The bitstream is read from the current position of the stream,
+ * so that it can be embedded in other binary files, e.g., a context checkpoint.
+ * The file name is only used in error messages
+ *******************************************************************/
+BitstreamManager read_binary_architecture_bitstream_from_stream(std::istream& fp,
+                                                                const char* fname) {
+  BitstreamManager bitstream_manager;
+
+  BinaryArchBitstreamHeader header;
+  read_binary_arch_bitstream_bytes(fp, reinterpret_cast<char*>(&header), sizeof(header), fname);
+
+  /* Validate the header */
+  if ((0 != std::memcmp(header.magic, BINARY_ARCH_BITSTREAM_MAGIC, sizeof(BINARY_ARCH_BITSTREAM_MAGIC)))
+    || (BINARY_ARCH_BITSTREAM_VERSION != header.version)) {
+    archfpga_throw(fname, 0,
+                   "File '%s' is not a binary architecture bitstream of version %u!\n",
+                   fname, BINARY_ARCH_BITSTREAM_VERSION);
+  }
+  if (0 == header.num_blocks) {
+    archfpga_throw(fname, 0,
+                   "Binary architecture bitstream file '%s' does not contain any block!\n",
+                   fname);
+  }
+
+  /* Each block has a header and each bit takes at least 1 bit of the file,
+   * so a corrupted header is found before reserving any memory
+   */
+  std::streampos cur_pos = fp.tellg();
+  fp.seekg(0, std::ios::end);
+  std::streampos end_pos = fp.tellg();
+  fp.seekg(cur_pos);
+  if ( (!fp) || (end_pos < cur_pos)
+    || (header.num_blocks > uint64_t(end_pos - cur_pos) / sizeof(BinaryArchBitstreamBlockHeader))
+    || (header.num_bits / 8 > uint64_t(end_pos - cur_pos)) ) {
+    archfpga_throw(fname, 0,
+                   "Numbers of blocks (%lu) and bits (%lu) of binary architecture bitstream file '%s' exceed its size!\n",
+                   header.num_blocks, header.num_bits, fname);
+  }
+
+  /* Reserve bitstream blocks and bits in the data base */
+  bitstream_manager.set_use_net_ids(1 == header.use_net_ids);
+  bitstream_manager.reserve_blocks(header.num_blocks);
+  bitstream_manager.reserve_bits(header.num_bits);
+
+  std::vector<ConfigBlockId> blocks;
+  blocks.reserve(header.num_blocks);
+
+  std::string block_name;
+  std::string net_ids;
+  std::vector<uint64_t> bit_words;
+  uint64_t num_bits = 0;
+
+  for (uint64_t iblock = 0; iblock < header.num_blocks; ++iblock) {
+    BinaryArchBitstreamBlockHeader block_header;
+    read_binary_arch_bitstream_bytes(fp, reinterpret_cast<char*>(&block_header), sizeof(block_header), fname);
+
+    /* Only the first block is the top block, and parents always come first */
+    if ( ((0 == iblock) && (BINARY_ARCH_BITSTREAM_NO_PARENT != block_header.parent_block))
+      || ((0 < iblock) && (iblock <= block_header.parent_block)) ) {
+      archfpga_throw(fname, 0,
+                     "Invalid parent of block %lu in binary architecture bitstream file '%s'!\n",
+                     iblock, fname);
+    }
+
+    /* Create the bitstream block and add it to parent block */
+    block_name.resize(block_header.name_length);
+    read_binary_arch_bitstream_bytes(fp, &block_name[0], block_name.size(), fname);
+    if ( (0 == iblock)
+      && (block_name != std::string(FPGA_TOP_MODULE_NAME)) ) {
+      archfpga_throw(fname, 0,
+                     "Top-level block must be named as '%s'!\n",
+                     FPGA_TOP_MODULE_NAME);
+    }
+    ConfigBlockId curr_block = bitstream_manager.add_block(block_name);
+    if (0 < iblock) {
+      bitstream_manager.add_child_block(blocks[block_header.parent_block], curr_block);
+    }
+    blocks.push_back(curr_block);
+
+    /* Parse path_id: -2 is an invalid value defined in the bitstream manager internally */
+    if (-2 < block_header.path_id) {
+      bitstream_manager.add_path_id_to_block(curr_block, block_header.path_id);
+    }
+
+    /* Net ids are only added when stored, which the header should allow */
+    if ( (false == bitstream_manager.use_net_ids())
+      && ( (0 < block_header.input_net_ids_length)
+        || (0 < block_header.output_net_ids_length) ) ) {
+      archfpga_throw(fname, 0,
+                     "Block %lu of binary architecture bitstream file '%s' contains net ids while its header disables them!\n",
+                     iblock, fname);
+    }
+    net_ids.resize(block_header.input_net_ids_length);
+    read_binary_arch_bitstream_bytes(fp, &net_ids[0], net_ids.size(), fname);
+    if (false == net_ids.empty()) {
+      bitstream_manager.add_input_net_id_to_block(curr_block, net_ids);
+    }
+    net_ids.resize(block_header.output_net_ids_length);
+    read_binary_arch_bitstream_bytes(fp, &net_ids[0], net_ids.size(), fname);
+    if (false == net_ids.empty()) {
+      bitstream_manager.add_output_net_id_to_block(curr_block, net_ids);
+    }
+
+    /* Configuration bits are already packed as in the bitstream manager */
+    if (0 < block_header.num_bits) {
+      bit_words.resize((block_header.num_bits + 63) / 64);
+      read_binary_arch_bitstream_bytes(fp, reinterpret_cast<char*>(bit_words.data()),
+                                       bit_words.size() * sizeof(uint64_t), fname);
+      bitstream_manager.add_block_bits(curr_block, bit_words.data(), block_header.num_bits);
+      num_bits += block_header.num_bits;
+    }
+  }
+
+  if (num_bits != header.num_bits) {
+    archfpga_throw(fname, 0,
+                   "Size of binary architecture bitstream file '%s' does not match its header!\n",
+                   fname);
+  }
+
+  return bitstream_manager;
+}
+
+/********************************************************************
+ * Read a binary file of architecture bitstream to an object of BitstreamManager
+ * Blocks are created in the order of the file, so the block and bit ids
+ * are the same as reading the XML file of the same bitstream
+ *******************************************************************/
+BitstreamManager read_binary_architecture_bitstream(const char* fname) {
+
+  vtr::ScopedStartFinishTimer timer("Read Architecture Bitstream binary file");
+
+  std::ifstream fp(fname, std::ios::in | std::ios::binary);
+  if (!fp.is_open()) {
+    archfpga_throw(fname, 0,
+                   "Unable to open architecture bitstream file '%s'!\n",
+                   fname);
+  }
+
+  BitstreamManager bitstream_manager = read_binary_architecture_bitstream_from_stream(fp, fname);
+
+  if (std::ifstream::traits_type::eof() != fp.peek()) {
+    archfpga_throw(fname, 0,
+                   "Size of binary architecture bitstream file '%s' does not match its header!\n",
+                   fname);
+  }
+
+  return bitstream_manager;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,23 @@
+#ifndef READ_BINARY_ARCH_BITSTREAM_H
+#define READ_BINARY_ARCH_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <istream>
+#include "bitstream_manager.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+/* begin namespace openfpga */
+namespace openfpga {
+
+BitstreamManager read_binary_architecture_bitstream_from_stream(std::istream& fp,
+                                                                const char* fname);
+
+BitstreamManager read_binary_architecture_bitstream(const char* fname);
+
+} /* end namespace openfpga */
+
+#endif
@@ -1,13 +1,20 @@
 /********************************************************************
  * This file includes the top-level function of this library
- * which reads an XML of a fabric key to the associated
+ * which reads an XML of an architecture bitstream to the associated
  * data structures
+ *
+ * The file is parsed in a streaming way: tags are pulled one by one
+ * from a buffered file stream and the blocks and bits are added to the
+ * bitstream manager on the fly, without building any XML document in memory
  *******************************************************************/
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
 #include <string>
-
-/* Headers from pugi XML library */
-#include "pugixml.hpp"
-#include "pugixml_util.hpp"
+#include <utility>
+#include <vector>
 
 /* Headers from vtr util library */
 #include "vtr_assert.h"
@@ -15,7 +22,6 @@
 
 /* Headers from libarchfpga */
 #include "arch_error.h"
-#include "read_xml_util.h"
 
 #include "openfpga_reserved_words.h"
 
@@ -25,120 +31,396 @@
 namespace openfpga {
 
 /********************************************************************
- * Parse XML codes of a <bitstream_block> to an object of BitstreamManager
- * This function goes recursively until we reach the leaf node
+ * Size of the buffer where the file is read into
+ *******************************************************************/
+constexpr size_t XML_ARCH_BITSTREAM_BUFFER_SIZE = 1 << 20;
+
+/********************************************************************
+ * A tag of the XML file: <name attr="value" ...>, </name> or <name .../>
+ *******************************************************************/
+enum e_xml_arch_bitstream_tag_type {
+  XML_ARCH_BITSTREAM_START_TAG,
+  XML_ARCH_BITSTREAM_END_TAG,
+  XML_ARCH_BITSTREAM_EMPTY_TAG
+};
+
+struct XmlArchBitstreamTag {
+  e_xml_arch_bitstream_tag_type type;
+  std::string name;
+  std::vector<std::pair<std::string, std::string>> attributes;
+  size_t line;
+};
+
+/********************************************************************
+ * A pull reader which provides the tags of an XML file one by one
+ * Comments, declarations and text between tags are skipped,
+ * as the architecture bitstream does not store anything in text
  *******************************************************************/
-static 
-void rec_read_xml_bitstream_block(pugi::xml_node& xml_bitstream_block,
-                                  const pugiutil::loc_data& loc_data,
-                                  BitstreamManager& bitstream_manager,
-                                  const ConfigBlockId& parent_block) {
-
-  /* Find the name of this bitstream block */
-  const std::string& block_name = get_attribute(xml_bitstream_block, "name", loc_data).as_string();
-
-  /* Create the bitstream block */
-  ConfigBlockId curr_block = bitstream_manager.add_block(block_name);
-
-  /* Add it to parent block */
-  bitstream_manager.add_child_block(parent_block, curr_block);
-
-  /* Parse input nets if defined */
-  pugi::xml_node xml_input_nets = get_single_child(xml_bitstream_block, "input_nets", loc_data, pugiutil::ReqOpt::OPTIONAL);
-  if (xml_input_nets) {
-    std::vector<std::string> input_nets;
-    size_t num_input_nets = count_children(xml_input_nets, "path", loc_data, pugiutil::ReqOpt::OPTIONAL);
-    input_nets.resize(num_input_nets);
-
-    /* Find the child paths/nets */
-    for (pugi::xml_node xml_input_net : xml_input_nets.children()) {
-      /* We only care child bitstream blocks here */
-      if (xml_input_net.name() != std::string("path")) {
-        bad_tag(xml_input_net, loc_data, xml_input_nets, {"path"});
-      }
-      const int& id = get_attribute(xml_input_net, "id", loc_data).as_int();
-      const std::string& net_name = get_attribute(xml_input_net, "net_name", loc_data).as_string();
-      VTR_ASSERT((size_t)id < input_nets.size());
-      input_nets[id] = net_name; 
-    } 
-
-    std::string input_nets_str;
-    bool need_splitter = false;
-    for (const std::string& input_net : input_nets) {
-      if (true == need_splitter) {
-        input_nets_str += std::string(" ");
-      }
-      input_nets_str += input_net;
-      need_splitter = true;
-    }
-    bitstream_manager.add_input_net_id_to_block(curr_block, input_nets_str); 
+class XmlArchBitstreamReader {
+  public: /* Public constructor */
+    XmlArchBitstreamReader(const char* fname)
+      : fname_(fname)
+      , fp_(fname, std::ios::in | std::ios::binary)
+      , buffer_(XML_ARCH_BITSTREAM_BUFFER_SIZE)
+      , pos_(0)
+      , size_(0)
+      , line_(1) {
+      if (!fp_.is_open()) {
+        archfpga_throw(fname_, 0,
+                       "Unable to open architecture bitstream file '%s'!\n",
+                       fname_);
+      }
+    }
+
+  public: /* Public Accessors */
+    size_t line() const {
+      return line_;
+    }
+
+  public: /* Public Mutators */
+    /* Read the next tag. Return false when the end of file is reached */
+    bool read_tag(XmlArchBitstreamTag& tag) {
+      while (true) {
+        /* Skip any text until the next tag */
+        int c = get_char();
+        while ((-1 != c) && ('<' != c)) {
+          c = get_char();
+        }
+        if (-1 == c) {
+          return false;
+        }
+        tag.line = line_;
+
+        c = peek_char();
+        if ('!' == c) {
+          /* Comments and document type declarations */
+          get_char();
+          if ('-' == peek_char()) {
+            skip_until("-->");
+          } else {
+            skip_until(">");
+          }
+          continue;
+        }
+        if ('?' == c) {
+          /* XML declarations */
+          skip_until("?>");
+          continue;
+        }
+
+        tag.attributes.clear();
+        if ('/' == c) {
+          get_char();
+          tag.type = XML_ARCH_BITSTREAM_END_TAG;
+          read_name(tag.name);
+          skip_spaces();
+          expect_char('>');
+          return true;
+        }
+
+        tag.type = XML_ARCH_BITSTREAM_START_TAG;
+        read_name(tag.name);
+        while (true) {
+          skip_spaces();
+          c = get_char();
+          if ('>' == c) {
+            return true;
+          }
+          if ('/' == c) {
+            expect_char('>');
+            tag.type = XML_ARCH_BITSTREAM_EMPTY_TAG;
+            return true;
+          }
+          if (-1 == c) {
+            archfpga_throw(fname_, line_,
+                           "Unexpected end of file in tag '%s'!\n",
+                           tag.name.c_str());
+          }
+          unget_char();
+
+          std::pair<std::string, std::string> attribute;
+          read_name(attribute.first);
+          skip_spaces();
+          expect_char('=');
+          skip_spaces();
+          read_value(attribute.second);
+          tag.attributes.push_back(attribute);
+        }
+      }
+    }
+
+  private: /* Internal utilities */
+    int get_char() {
+      if (pos_ == size_) {
+        fp_.read(buffer_.data(), buffer_.size());
+        size_ = size_t(fp_.gcount());
+        pos_ = 0;
+        if (0 == size_) {
+          return -1;
+        }
+      }
+      char c = buffer_[pos_++];
+      if ('\n' == c) {
+        line_++;
+      }
+      return (unsigned char)c;
+    }
+
+    int peek_char() {
+      int c = get_char();
+      if (-1 != c) {
+        unget_char();
+      }
+      return c;
+    }
+
+    /* Only the character which has just been read can be put back */
+    void unget_char() {
+      VTR_ASSERT_SAFE(0 < pos_);
+      pos_--;
+      if ('\n' == buffer_[pos_]) {
+        line_--;
+      }
+    }
+
+    void skip_spaces() {
+      int c = get_char();
+      while ((' ' == c) || ('\t' == c) || ('\n' == c) || ('\r' == c)) {
+        c = get_char();
+      }
+      if (-1 != c) {
+        unget_char();
+      }
+    }
+
+    void skip_until(const char* pattern) {
+      size_t pattern_length = std::strlen(pattern);
+      size_t num_matched = 0;
+      while (num_matched < pattern_length) {
+        int c = get_char();
+        if (-1 == c) {
+          archfpga_throw(fname_, line_,
+                         "Unexpected end of file while looking for '%s'!\n",
+                         pattern);
+        }
+        if (c == pattern[num_matched]) {
+          num_matched++;
+        } else {
+          num_matched = (c == pattern[0]) ? 1 : 0;
+        }
+      }
+    }
+
+    void expect_char(const char& expected) {
+      int c = get_char();
+      if (c != (unsigned char)expected) {
+        archfpga_throw(fname_, line_,
+                       "Expect '%c' in the XML file!\n",
+                       expected);
+      }
+    }
+
+    void read_name(std::string& name) {
+      name.clear();
+      int c = get_char();
+      while ( (-1 != c)
+           && (' ' != c) && ('\t' != c) && ('\n' != c) && ('\r' != c)
+           && ('>' != c) && ('/' != c) && ('=' != c)) {
+        name.push_back(char(c));
+        c = get_char();
+      }
+      if (-1 != c) {
+        unget_char();
+      }
+      if (true == name.empty()) {
+        archfpga_throw(fname_, line_,
+                       "Expect a name in the XML file!\n");
+      }
+    }
+
+    /* Read a quoted value of an attribute, where the predefined entities are decoded
+     * Any other '&' is kept as it is, as the names are not escaped by the writer
+     */
+    void read_value(std::string& value) {
+      int quote = get_char();
+      if (('"' != quote) && ('\'' != quote)) {
+        archfpga_throw(fname_, line_,
+                       "Expect a quoted value of an attribute!\n");
+      }
+      raw_value_.clear();
+      int c = get_char();
+      while (quote != c) {
+        if (-1 == c) {
+          archfpga_throw(fname_, line_,
+                         "Unexpected end of file in the value of an attribute!\n");
+        }
+        raw_value_.push_back(char(c));
+        c = get_char();
+      }
+
+      value.clear();
+      for (size_t ichar = 0; ichar < raw_value_.size(); ++ichar) {
+        if ('&' == raw_value_[ichar]) {
+          bool decoded = false;
+          for (const std::pair<const char*, char>& entity : {std::make_pair("&lt;", '<'),
+                                                             std::make_pair("&gt;", '>'),
+                                                             std::make_pair("&amp;", '&'),
+                                                             std::make_pair("&quot;", '"'),
+                                                             std::make_pair("&apos;", '\'')}) {
+            size_t entity_length = std::strlen(entity.first);
+            if (0 == raw_value_.compare(ichar, entity_length, entity.first)) {
+              value.push_back(entity.second);
+              ichar += entity_length - 1;
+              decoded = true;
+              break;
+            }
+          }
+          if (true == decoded) {
+            continue;
+          }
+        }
+        value.push_back(raw_value_[ichar]);
+      }
+    }
+
+  private: /* Internal data */
+    const char* fname_;
+    std::ifstream fp_;
+    std::vector<char> buffer_;
+    size_t pos_;
+    size_t size_;
+    size_t line_;
+    std::string raw_value_;
+};
+
+/********************************************************************
+ * Find the value of an attribute of a tag, or nullptr if not defined
+ *******************************************************************/
+static
+const std::string* find_xml_arch_bitstream_attribute(const XmlArchBitstreamTag& tag,
+                                                     const char* name) {
+  for (const std::pair<std::string, std::string>& attribute : tag.attributes) {
+    if (attribute.first == name) {
+      return &attribute.second;
+    }
   }
+  return nullptr;
+}
 
-  /* Parse output nets if defined */
-  pugi::xml_node xml_output_nets = get_single_child(xml_bitstream_block, "output_nets", loc_data, pugiutil::ReqOpt::OPTIONAL);
-  if (xml_output_nets) {
-    std::vector<std::string> output_nets;
-    size_t num_output_nets = count_children(xml_output_nets, "path", loc_data, pugiutil::ReqOpt::OPTIONAL);
-    output_nets.resize(num_output_nets);
-
-    /* Find the child paths/nets */
-    for (pugi::xml_node xml_output_net : xml_output_nets.children()) {
-      /* We only care child bitstream blocks here */
-      if (xml_output_net.name() != std::string("path")) {
-        bad_tag(xml_output_net, loc_data, xml_output_nets, {"path"});
-      }
-      const int& id = get_attribute(xml_output_net, "id", loc_data).as_int();
-      const std::string& net_name = get_attribute(xml_output_net, "net_name", loc_data).as_string();
-      VTR_ASSERT((size_t)id < output_nets.size());
-      output_nets[id] = net_name; 
-    } 
-
-    std::string output_nets_str;
-    bool need_splitter = false;
-    for (const std::string& output_net : output_nets) {
-      if (true == need_splitter) {
-        output_nets_str += std::string(" ");
-      }
-      output_nets_str += output_net;
-      need_splitter = true;
-    }
-    bitstream_manager.add_output_net_id_to_block(curr_block, output_nets_str); 
+static
+const std::string& get_xml_arch_bitstream_attribute(const XmlArchBitstreamTag& tag,
+                                                    const char* name,
+                                                    const char* fname) {
+  const std::string* value = find_xml_arch_bitstream_attribute(tag, name);
+  if (nullptr == value) {
+    archfpga_throw(fname, tag.line,
+                   "Missing required attribute '%s' in tag '%s'!\n",
+                   name, tag.name.c_str());
   }
+  return *value;
+}
 
-  /* Parse configuration bits */
-  pugi::xml_node xml_bitstream = get_single_child(xml_bitstream_block, "bitstream", loc_data, pugiutil::ReqOpt::OPTIONAL);
-  if (xml_bitstream) {
-    /* Parse path_id: -2 is an invalid value defined in the bitstream manager internally */
-    const int& path_id = get_attribute(xml_bitstream, "path_id", loc_data, pugiutil::ReqOpt::OPTIONAL).as_int(-2);
-    if (-2 < path_id) {
-      bitstream_manager.add_path_id_to_block(curr_block, path_id); 
+static
+size_t get_xml_arch_bitstream_size_attribute(const XmlArchBitstreamTag& tag,
+                                             const char* name,
+                                             const char* fname) {
+  const std::string& value = get_xml_arch_bitstream_attribute(tag, name, fname);
+  size_t result = 0;
+  for (const char& c : value) {
+    if (('0' > c) || ('9' < c)) {
+      archfpga_throw(fname, tag.line,
+                     "Invalid value '%s' of attribute '%s' which should be a non-negative integer!\n",
+                     value.c_str(), name);
     }
+    /* Error out rather than wrapping around on a too large value */
+    if ((std::numeric_limits<size_t>::max() - size_t(c - '0')) / 10 < result) {
+      archfpga_throw(fname, tag.line,
+                     "Value '%s' of attribute '%s' is too large!\n",
+                     value.c_str(), name);
+    }
+    result = result * 10 + size_t(c - '0');
+  }
+  if (true == value.empty()) {
+    archfpga_throw(fname, tag.line,
+                   "Empty value of attribute '%s'!\n",
+                   name);
+  }
+  return result;
+}
+
+static
+int get_xml_arch_bitstream_int_attribute(const XmlArchBitstreamTag& tag,
+                                         const char* name,
+                                         const char* fname) {
+  const std::string& value = get_xml_arch_bitstream_attribute(tag, name, fname);
+  char* end = nullptr;
+  long result = std::strtol(value.c_str(), &end, 10);
+  if ( (true == value.empty())
+    || ('\0' != *end) ) {
+    archfpga_throw(fname, tag.line,
+                   "Invalid value '%s' of attribute '%s' which should be an integer!\n",
+                   value.c_str(), name);
+  }
+  return int(result);
+}
 
-    /* Find the child paths/nets */
-    std::vector<bool> block_bits;
-    for (pugi::xml_node xml_bit : xml_bitstream.children()) {
-      /* We only care child bitstream blocks here */
-      if (xml_bit.name() != std::string("bit")) {
-        bad_tag(xml_bit, loc_data, xml_bitstream, {"bit"});
+/********************************************************************
+ * Count the blocks and bits in the XML file, so that memory can be reserved
+ * before parsing. The file is scanned for the tag names only,
+ * which is much faster than parsing it
+ *******************************************************************/
+static
+void count_xml_arch_bitstream_tags(const char* fname,
+                                   size_t& num_blocks,
+                                   size_t& num_bits) {
+  const std::string block_tag("<bitstream_block");
+  const std::string bit_tag("<bit ");
+
+  num_blocks = 0;
+  num_bits = 0;
+
+  std::ifstream fp(fname, std::ios::in | std::ios::binary);
+  if (!fp.is_open()) {
+    return;
+  }
+
+  /* The end of a chunk is kept in case a tag name is split over two chunks */
+  std::vector<char> buffer(XML_ARCH_BITSTREAM_BUFFER_SIZE + block_tag.size());
+  size_t num_kept_chars = 0;
+  while (true) {
+    fp.read(buffer.data() + num_kept_chars, XML_ARCH_BITSTREAM_BUFFER_SIZE);
+    size_t num_read_chars = size_t(fp.gcount());
+    size_t size = num_kept_chars + num_read_chars;
+    size_t limit = (0 == num_read_chars) ? size : size - std::min(size, block_tag.size() - 1);
+
+    const char* begin = buffer.data();
+    const char* cur = static_cast<const char*>(std::memchr(begin, '<', limit));
+    while (nullptr != cur) {
+      size_t num_remaining_chars = size - (cur - begin);
+      if ( (block_tag.size() <= num_remaining_chars)
+        && (0 == std::memcmp(cur, block_tag.data(), block_tag.size())) ) {
+        num_blocks++;
+      } else if ( (bit_tag.size() <= num_remaining_chars)
+               && (0 == std::memcmp(cur, bit_tag.data(), bit_tag.size())) ) {
+        num_bits++;
       }
-      const int& bit_value = get_attribute(xml_bit, "value", loc_data).as_int();
-      block_bits.push_back(1 == bit_value);
+      cur = static_cast<const char*>(std::memchr(cur + 1, '<', limit - (cur + 1 - begin)));
+    }
+
+    if (0 == num_read_chars) {
+      break;
     }
-    /* Link the bit to parent block */
-    bitstream_manager.add_block_bits(curr_block, block_bits);
+    num_kept_chars = size - limit;
+    std::memmove(buffer.data(), buffer.data() + limit, num_kept_chars);
   }
-  
-  /* Go recursively: find all the child blocks and parse */
-  for (pugi::xml_node xml_child : xml_bitstream_block.children()) {
-    /* We only care child bitstream blocks here */
-    if (xml_child.name() == std::string("bitstream_block")) {
-      rec_read_xml_bitstream_block(xml_child, loc_data, bitstream_manager, curr_block);
-    }
-  } 
 }
 
 /********************************************************************
  * Parse XML codes about <bitstream> to an object of Bitstream
+ * The XML file contains nested <bitstream_block> where each block may include
+ *   <hierarchy>: the names of the parent blocks, which are not stored
+ *   <input_nets>/<output_nets>: the net ids of the block
+ *   <bitstream>: the path id and configuration bits of the block
  *******************************************************************/
 BitstreamManager read_xml_architecture_bitstream(const char* fname) {
 
@@ -146,51 +428,165 @@ BitstreamManager read_xml_architecture_bitstream(const char* fname) {
 
   BitstreamManager bitstream_manager;
 
-  /* Parse the file */
-  pugi::xml_document doc;
-  pugiutil::loc_data loc_data;
-
-  try {
-    loc_data = pugiutil::load_xml(doc, fname);
-
-    /* Count the child <bitstream_block> */
-
-    pugi::xml_node xml_root = get_single_child(doc, "bitstream_block", loc_data);
-
-    /* Find the name of the top block*/
-    const std::string& top_block_name = get_attribute(xml_root, "name", loc_data).as_string();
-    
-    if (top_block_name != std::string(FPGA_TOP_MODULE_NAME)) {
-      archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_root),
-                     "Top-level block must be named as '%s'!\n",
-                     FPGA_TOP_MODULE_NAME);
+  /* Reserve bitstream blocks and bits in the data base */
+  size_t num_blocks = 0;
+  size_t num_bits = 0;
+  count_xml_arch_bitstream_tags(fname, num_blocks, num_bits);
+  bitstream_manager.reserve_blocks(num_blocks);
+  bitstream_manager.reserve_bits(num_bits);
+
+  XmlArchBitstreamReader reader(fname);
+  XmlArchBitstreamTag tag;
+
+  /* The blocks which are being parsed, from the top block */
+  std::vector<ConfigBlockId> block_stack;
+  bool top_block_done = false;
+
+  /* The child of a block which is being parsed, e.g., <bitstream> */
+  std::string section;
+  std::vector<std::string> net_ids;
+  std::vector<bool> block_bits;
+
+  while (true == reader.read_tag(tag)) {
+    bool is_start = (XML_ARCH_BITSTREAM_END_TAG != tag.type);
+    bool is_end = (XML_ARCH_BITSTREAM_START_TAG != tag.type);
+
+    if (true == is_start) {
+      if (tag.name == std::string("bitstream_block")) {
+        if (false == section.empty()) {
+          archfpga_throw(fname, tag.line,
+                         "Unexpected <bitstream_block> in <%s>!\n",
+                         section.c_str());
+        }
+        const std::string& block_name = get_xml_arch_bitstream_attribute(tag, "name", fname);
+        if (true == block_stack.empty()) {
+          if (true == top_block_done) {
+            archfpga_throw(fname, tag.line,
+                           "Only one top-level block is allowed!\n");
+          }
+          if (block_name != std::string(FPGA_TOP_MODULE_NAME)) {
+            archfpga_throw(fname, tag.line,
+                           "Top-level block must be named as '%s'!\n",
+                           FPGA_TOP_MODULE_NAME);
+          }
+        }
+
+        /* Create the bitstream block and add it to parent block */
+        ConfigBlockId curr_block = bitstream_manager.add_block(block_name);
+        if (false == block_stack.empty()) {
+          bitstream_manager.add_child_block(block_stack.back(), curr_block);
+        }
+        block_stack.push_back(curr_block);
+      } else if ( (tag.name == std::string("hierarchy"))
+               || (tag.name == std::string("input_nets"))
+               || (tag.name == std::string("output_nets"))
+               || (tag.name == std::string("bitstream")) ) {
+        if ( (true == block_stack.empty())
+          || (false == section.empty()) ) {
+          archfpga_throw(fname, tag.line,
+                         "Tag <%s> should be a child of <bitstream_block>!\n",
+                         tag.name.c_str());
+        }
+        section = tag.name;
+        net_ids.clear();
+        block_bits.clear();
+
+        /* Parse path_id: -2 is an invalid value defined in the bitstream manager internally */
+        if (tag.name == std::string("bitstream")) {
+          if (nullptr != find_xml_arch_bitstream_attribute(tag, "path_id")) {
+            int path_id = get_xml_arch_bitstream_int_attribute(tag, "path_id", fname);
+            if (-2 < path_id) {
+              bitstream_manager.add_path_id_to_block(block_stack.back(), path_id);
+            }
+          }
+        }
+      } else if (tag.name == std::string("instance")) {
+        if (section != std::string("hierarchy")) {
+          archfpga_throw(fname, tag.line,
+                         "Tag <instance> should be a child of <hierarchy>!\n");
+        }
+      } else if (tag.name == std::string("path")) {
+        if ( (section != std::string("input_nets"))
+          && (section != std::string("output_nets")) ) {
+          archfpga_throw(fname, tag.line,
+                         "Tag <path> should be a child of <input_nets> or <output_nets>!\n");
+        }
+        /* Paths are written in the order of their ids, so an id can only extend the list by one */
+        size_t id = get_xml_arch_bitstream_size_attribute(tag, "id", fname);
+        if (id > net_ids.size()) {
+          archfpga_throw(fname, tag.line,
+                         "Invalid path id '%lu' which should not exceed the number of previous paths (%lu)!\n",
+                         id, net_ids.size());
+        }
+        if (id == net_ids.size()) {
+          net_ids.resize(id + 1);
+        }
+        net_ids[id] = get_xml_arch_bitstream_attribute(tag, "net_name", fname);
+      } else if (tag.name == std::string("bit")) {
+        if (section != std::string("bitstream")) {
+          archfpga_throw(fname, tag.line,
+                         "Tag <bit> should be a child of <bitstream>!\n");
+        }
+        block_bits.push_back(1 == get_xml_arch_bitstream_size_attribute(tag, "value", fname));
+      } else {
+        archfpga_throw(fname, tag.line,
+                       "Unexpected tag <%s> in architecture bitstream!\n",
+                       tag.name.c_str());
+      }
     }
 
-    /* Create the top-level block */
-    ConfigBlockId top_block = bitstream_manager.add_block(top_block_name);
-
-    size_t num_blks = count_children(xml_root, "bitstream_block", loc_data, pugiutil::ReqOpt::OPTIONAL);
+    if (false == is_end) {
+      continue;
+    }
 
-    /* Reserve bitstream blocks in the data base */
-    bitstream_manager.reserve_blocks(num_blks);
+    if (tag.name == std::string("bitstream_block")) {
+      if ( (true == block_stack.empty())
+        || (false == section.empty()) ) {
+        archfpga_throw(fname, tag.line,
+                       "Unexpected end of <bitstream_block>!\n");
+      }
+      block_stack.pop_back();
+      top_block_done = block_stack.empty();
+    } else if (tag.name == section) {
+      const ConfigBlockId& curr_block = block_stack.back();
+      if ( (section == std::string("input_nets"))
+        || (section == std::string("output_nets")) ) {
+        /* Net ids are stored as a string split with space */
+        std::string net_ids_str;
+        bool need_splitter = false;
+        for (const std::string& net_id : net_ids) {
+          if (true == need_splitter) {
+            net_ids_str += std::string(" ");
+          }
+          net_ids_str += net_id;
+          need_splitter = true;
+        }
+        if (section == std::string("input_nets")) {
+          bitstream_manager.add_input_net_id_to_block(curr_block, net_ids_str);
+        } else {
+          bitstream_manager.add_output_net_id_to_block(curr_block, net_ids_str);
+        }
+      } else if (section == std::string("bitstream")) {
+        /* Link the bit to parent block */
+        bitstream_manager.add_block_bits(curr_block, block_bits);
+      }
+      section.clear();
+    } else if ( (tag.name != std::string("instance"))
+             && (tag.name != std::string("path"))
+             && (tag.name != std::string("bit")) ) {
+      archfpga_throw(fname, tag.line,
+                     "Unexpected end of tag <%s>!\n",
+                     tag.name.c_str());
+    }
+  }
 
-    /* Iterate over the children under this node,
-     * each child should be named after circuit_model
-     */
-    for (pugi::xml_node xml_blk : xml_root.children()) {
-      /* Error out if the XML child has an invalid name! */
-      if (xml_blk.name() != std::string("bitstream_block")) {
-        bad_tag(xml_blk, loc_data, xml_root, {"bitstream_block"});
-      }
-      rec_read_xml_bitstream_block(xml_blk, loc_data, bitstream_manager, top_block);
-    } 
-  } catch (pugiutil::XmlError& e) {
-    archfpga_throw(fname, e.line(),
-                   "%s", e.what());
+  if ( (false == top_block_done)
+    || (false == block_stack.empty()) ) {
+    archfpga_throw(fname, reader.line(),
+                   "Missing or incomplete top-level <bitstream_block>!\n");
   }
 
-  return bitstream_manager; 
+  return bitstream_manager;
 }
 
 } /* end namespace openfpga */
-
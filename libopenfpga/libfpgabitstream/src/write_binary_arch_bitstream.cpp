@@ -0,0 +1,140 @@
+/********************************************************************
+ * This file includes functions that output bitstream database
+ * to files in binary format
+ * See binary_arch_bitstream.h for the details of the file layout
+ *******************************************************************/
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "bitstream_manager_utils.h"
+#include "binary_arch_bitstream.h"
+#include "write_binary_arch_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Recursively write the bitstream of a block and its children to a binary file
+ * Blocks are indexed in the order they are written, i.e.,
+ * the Depth-First Search order of the block hierarchy
+ *******************************************************************/
+static
+void rec_write_block_bitstream_to_binary_file(std::ostream& fp,
+                                              const BitstreamManager& bitstream_manager,
+                                              const ConfigBlockId& block,
+                                              const uint64_t& parent_index,
+                                              BinaryArchBitstreamHeader& header,
+                                              std::vector<uint64_t>& bit_words) {
+  const std::string& block_name = bitstream_manager.block_name(block);
+  std::string input_net_ids = bitstream_manager.block_input_net_ids(block);
+  std::string output_net_ids = bitstream_manager.block_output_net_ids(block);
+  std::vector<ConfigBitId> block_bits = bitstream_manager.block_bits(block);
+
+  BinaryArchBitstreamBlockHeader block_header;
+  block_header.parent_block = parent_index;
+  block_header.path_id = int32_t(bitstream_manager.block_path_id(block));
+  block_header.name_length = uint32_t(block_name.size());
+  block_header.input_net_ids_length = uint32_t(input_net_ids.size());
+  block_header.output_net_ids_length = uint32_t(output_net_ids.size());
+  block_header.num_bits = block_bits.size();
+
+  fp.write(reinterpret_cast<const char*>(&block_header), sizeof(block_header));
+  fp.write(block_name.data(), block_name.size());
+  fp.write(input_net_ids.data(), input_net_ids.size());
+  fp.write(output_net_ids.data(), output_net_ids.size());
+
+  /* Pack the bits into words */
+  bit_words.assign((block_bits.size() + 63) / 64, 0);
+  for (size_t ibit = 0; ibit < block_bits.size(); ++ibit) {
+    if (true == bitstream_manager.bit_value(block_bits[ibit])) {
+      bit_words[ibit / 64] |= (uint64_t(1) << (ibit % 64));
+    }
+  }
+  fp.write(reinterpret_cast<const char*>(bit_words.data()), bit_words.size() * sizeof(uint64_t));
+
+  uint64_t block_index = header.num_blocks++;
+  header.num_bits += block_bits.size();
+
+  /* Dive to child blocks if this block has any */
+  for (const ConfigBlockId& child_block : bitstream_manager.block_children(block)) {
+    rec_write_block_bitstream_to_binary_file(fp, bitstream_manager, child_block,
+                                             block_index, header, bit_words);
+  }
+}
+
+/********************************************************************
+ * Write the bitstream to a stream in binary format
+ * The bitstream is written from the current position of the stream,
+ * so that it can be embedded in other binary files, e.g., a context checkpoint
+ *******************************************************************/
+void write_binary_architecture_bitstream_to_stream(std::ostream& fp,
+                                                   const BitstreamManager& bitstream_manager) {
+  /* Find the top block, which has not parents */
+  std::vector<ConfigBlockId> top_block = find_bitstream_manager_top_blocks(bitstream_manager);
+  /* Make sure we have only 1 top block */
+  VTR_ASSERT(1 == top_block.size());
+
+  BinaryArchBitstreamHeader header;
+  std::memcpy(header.magic, BINARY_ARCH_BITSTREAM_MAGIC, sizeof(BINARY_ARCH_BITSTREAM_MAGIC));
+  header.version = BINARY_ARCH_BITSTREAM_VERSION;
+  header.use_net_ids = bitstream_manager.use_net_ids() ? 1 : 0;
+  header.num_blocks = 0;
+  header.num_bits = 0;
+
+  /* Reserve space for the header, which is finalized once the blocks and bits are counted */
+  std::streampos header_pos = fp.tellp();
+  fp.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  /* Write bitstream, block by block, in a recursive way */
+  std::vector<uint64_t> bit_words;
+  rec_write_block_bitstream_to_binary_file(fp, bitstream_manager, top_block[0],
+                                           BINARY_ARCH_BITSTREAM_NO_PARENT,
+                                           header, bit_words);
+
+  /* Finalize the header and get back to the end of the bitstream */
+  std::streampos end_pos = fp.tellp();
+  fp.seekp(header_pos);
+  fp.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  fp.seekp(end_pos);
+}
+
+/********************************************************************
+ * Write the bitstream to a file without binding to the configuration
+ * procotols of a given FPGA fabric in binary format
+ *
+ * The file contains the same information as the XML file,
+ * except the hierarchy of each block, which can be inferred from the parents
+ *******************************************************************/
+void write_binary_architecture_bitstream(const BitstreamManager& bitstream_manager,
+                                         const std::string& fname) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to output bitstream!\n\tPlease specify a valid file name.\n");
+  }
+
+  std::string timer_message = std::string("Write ") + std::to_string(bitstream_manager.bits().size()) + std::string(" architecture independent bitstream into binary file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Create the file stream */
+  BufferedFileStream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+
+  check_file_stream(fname.c_str(), fp);
+
+  write_binary_architecture_bitstream_to_stream(fp, bitstream_manager);
+
+  /* Close file handler */
+  fp.close();
+}
+
+} /* end namespace openfpga */
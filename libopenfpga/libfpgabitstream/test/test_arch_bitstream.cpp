@@ -3,17 +3,26 @@
  * 1. parser of data structures
  * 2. writer of data structures
  *******************************************************************/
+#include <cstddef>
+#include <fstream>
+
 /* Headers from vtrutils */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
+/* Headers from libarchfpga */
+#include "arch_error.h"
+
 /* Headers from fabric key */
 #include "read_xml_arch_bitstream.h"
 #include "write_xml_arch_bitstream.h"
+#include "read_binary_arch_bitstream.h"
+#include "write_binary_arch_bitstream.h"
+#include "binary_arch_bitstream.h"
 
 int main(int argc, const char** argv) {
-  /* Ensure we have only one or two argument */
-  VTR_ASSERT((2 == argc) || (3 == argc));
+  /* Ensure we have one to three arguments */
+  VTR_ASSERT((2 == argc) || (3 == argc) || (4 == argc));
 
   /* Parse the bitstream from an XML file */
   openfpga::BitstreamManager test_bitstream = openfpga::read_xml_architecture_bitstream(argv[1]);
@@ -28,6 +37,55 @@ int main(int argc, const char** argv) {
     VTR_LOG("Echo the bitstream to an XML file: %s.\n",
             argv[2]);
   }
-}
 
+  /* Output the bitstream to a binary file and read it back
+   * This is optional only used when there is a third argument
+   */
+  if (4 <= argc) {
+    openfpga::write_binary_architecture_bitstream(test_bitstream, argv[3]);
+    openfpga::BitstreamManager binary_bitstream = openfpga::read_binary_architecture_bitstream(argv[3]);
+    VTR_LOG("Echo the bitstream to a binary file: %s.\n",
+            argv[3]);
+
+    /* Blocks are read in the same order, so the ids should be the same */
+    VTR_ASSERT(test_bitstream.num_blocks() == binary_bitstream.num_blocks());
+    VTR_ASSERT(test_bitstream.num_bits() == binary_bitstream.num_bits());
+    for (const openfpga::ConfigBlockId& block : test_bitstream.blocks()) {
+      VTR_ASSERT(test_bitstream.block_name(block) == binary_bitstream.block_name(block));
+      VTR_ASSERT(test_bitstream.block_parent(block) == binary_bitstream.block_parent(block));
+      VTR_ASSERT(test_bitstream.block_path_id(block) == binary_bitstream.block_path_id(block));
+      VTR_ASSERT(test_bitstream.block_input_net_ids(block) == binary_bitstream.block_input_net_ids(block));
+      VTR_ASSERT(test_bitstream.block_output_net_ids(block) == binary_bitstream.block_output_net_ids(block));
+    }
+    for (const openfpga::ConfigBitId& bit : test_bitstream.bits()) {
+      VTR_ASSERT(test_bitstream.bit_value(bit) == binary_bitstream.bit_value(bit));
+    }
+    VTR_LOG("The bitstream read from the binary file is the same as the XML file.\n");
+
+    /* Net ids stored in a file whose header disables them should be reported as an error */
+    bool has_net_ids = false;
+    for (const openfpga::ConfigBlockId& block : test_bitstream.blocks()) {
+      if ( (false == test_bitstream.block_input_net_ids(block).empty())
+        || (false == test_bitstream.block_output_net_ids(block).empty()) ) {
+        has_net_ids = true;
+        break;
+      }
+    }
+    if (true == has_net_ids) {
+      std::fstream fp(argv[3], std::ios::in | std::ios::out | std::ios::binary);
+      uint32_t use_net_ids = 0;
+      fp.seekp(offsetof(openfpga::BinaryArchBitstreamHeader, use_net_ids));
+      fp.write(reinterpret_cast<const char*>(&use_net_ids), sizeof(use_net_ids));
+      fp.close();
 
+      bool rejected = false;
+      try {
+        openfpga::read_binary_architecture_bitstream(argv[3]);
+      } catch (const ArchFpgaError&) {
+        rejected = true;
+      }
+      VTR_ASSERT(true == rejected);
+      VTR_LOG("The binary file with net ids disabled in its header is rejected.\n");
+    }
+  }
+}
@@ -2,6 +2,7 @@
 #define SHELL_H
 
 #include <string>
+#include <istream>
 #include <map>
 #include <vector>
 #include <functional>
@@ -135,15 +136,50 @@ class Shell {
 
     void set_command_dependency(const ShellCommandId& cmd_id,
                                 const std::vector<ShellCommandId>& cmd_dependency);
+    /* Mark a command as successfully executed without running it,
+     * e.g., when its results are restored from a file by another command,
+     * so that the commands depending on it can be executed
+     */
+    void mark_command_executed(const ShellCommandId& cmd_id);
+    /* Mark a command as never executed, e.g., when its results are released by another command,
+     * so that the commands depending on it can no longer be executed until it is executed again
+     */
+    void mark_command_unexecuted(const ShellCommandId& cmd_id);
     ShellCommandClassId add_command_class(const char* name);
+    /* Profile each executed command (wall time, CPU time and peak memory)
+     * and write a report to the file when the shell exits.
+     * The report is in JSON when the file name ends with '.json', otherwise in CSV
+     */
+    void set_profile_file(const std::string& profile_file);
   public: /* Public validators */
     bool valid_command_id(const ShellCommandId& cmd_id) const;
     bool valid_command_class_id(const ShellCommandClassId& cmd_class_id) const;
   public: /* Public executors */
     /* Start the interactive mode, where users will type-in command by command */
     void run_interactive_mode(T& context, const bool& quiet_mode = false);
-    /* Start the script mode, where users provide a file which includes all the commands to run */
-    void run_script_mode(const char* script_file_name, T& context);
+    /* Start the script mode, where users provide a file which includes all the commands to run
+     * In parallel mode, the independent commands which only read the context (const execute functions)
+     * are executed concurrently
+     */
+    void run_script_mode(const char* script_file_name, T& context, const bool& parallel_mode = false);
+    /* Start the batch mode, where the script is executed for each design of the batch file
+     * Each line of the batch file defines the variables of a design, e.g., NAME=VALUE,
+     * which replace the ${NAME} in the script.
+     * The data exchange <T> is kept from one design to the next,
+     * except the data reset by the reset function, which is called before each design but the first.
+     * The 'exit' command of the script only ends the current design,
+     * and the shell exits when all the designs are done
+     */
+    void run_batch_mode(const char* script_file_name, const char* batch_file_name, T& context,
+                        std::function<void(T&)> reset_function);
+    /* Start the server mode, where the shell listens at a local socket and 
+     * executes the script sent by each client (see shell_socket.h) 
+     * The data exchange <T> and the status of the commands are kept from one session to the next,
+     * so that the commands executed in earlier sessions do not have to be executed again.
+     * The 'exit' command only ends the current session,
+     * and the shell exits when it receives a SIGINT or SIGTERM signal
+     */
+    void run_server_mode(const char* socket_file_name, T& context);
     /* Print all the commands by their classes. This is actually the help desk */
     void print_commands() const;
     /* Quit the shell */
@@ -153,6 +189,27 @@ class Shell {
      * The common_context is the data structure to exchange data between commands
      */
     int execute_command(const char* cmd_line, T& common_context);
+    int execute_command_line(const char* cmd_line, T& common_context);
+    /* Read the command lines of a script file */
+    bool read_script_file(const char* script_file_name, std::vector<std::string>& cmd_lines) const;
+    void read_script_stream(std::istream& fp, std::vector<std::string>& cmd_lines) const;
+    /* Read the variables of each design of a batch file */
+    bool read_batch_file(const char* batch_file_name, std::vector<std::map<std::string, std::string>>& designs) const;
+    /* Replace the ${NAME} of a command line with the values of the variables */
+    bool substitute_variables(const std::string& cmd_line,
+                              const std::map<std::string, std::string>& variables,
+                              std::string& substituted_cmd_line) const;
+    /* Execute the command lines of a script, concurrently for independent const commands */
+    void execute_script_in_parallel(const std::vector<std::string>& cmd_lines, T& context);
+    /* Execute a group of command lines of const commands concurrently */
+    int execute_const_commands(const std::vector<std::string>& cmd_lines, const T& common_context);
+    int execute_const_command(const ShellCommandId& cmd_id, const CommandContext& cmd_context, const T& common_context) const;
+    bool check_command_dependency(const ShellCommandId& cmd_id) const;
+    bool const_command(const ShellCommandId& cmd_id) const;
+    /* Peak memory of each owner since the last reset, empty if memory accounting is disabled */
+    static std::vector<size_t> memory_peak_bytes();
+    /* Write the profiling results of the executed commands */
+    void write_profile_report() const;
   private: /* Internal data */ 
     /* Name of the shell, this will appear in the interactive mode */
     std::string name_;
@@ -215,6 +272,28 @@ class Shell {
 
     /* Timer */
     std::clock_t time_start_;
+
+    /* Number of designs with errors in batch mode */
+    size_t num_failed_batch_designs_;
+
+    /* Profiling results of each executed command line, in execution order
+     * The CPU time and the peak memory of concurrent commands are those of their whole group
+     */
+    struct t_command_profile {
+      std::string cmd_line;
+      int status;
+      bool concurrent;
+      double wall_sec;
+      double cpu_sec;
+      float max_rss_mib;
+      float delta_max_rss_mib;
+      /* Peak memory of each owner (see vtr_memory_stats.h) when memory accounting is enabled,
+       * indexed in the order of the owners
+       */
+      std::vector<size_t> memory_peak_bytes;
+    };
+    std::string profile_file_;
+    std::vector<t_command_profile> command_profiles_;
 };
 
 } /* End namespace openfpga */
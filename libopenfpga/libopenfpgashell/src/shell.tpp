@@ -2,11 +2,18 @@
  * Member functions for class Shell
  ********************************************************************/
 #include <fstream>
+#include <sstream>
 #include <algorithm>
+#include <exception>
+#include <thread>
 
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
+#include "vtr_time.h"
+#include "vtr_trace.h"
+#include "vtr_rusage.h"
+#include "vtr_memory_stats.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_tokenizer.h"
@@ -18,6 +25,7 @@
 /* Headers from openfpgashell library */
 #include "command_parser.h"
 #include "command_echo.h"
+#include "shell_socket.h"
 
 /* Begin namespace openfpga */
 namespace openfpga {
@@ -29,6 +37,7 @@ template<class T>
 Shell<T>::Shell(const char* name) {
   name_ = std::string(name);
   time_start_ = 0;
+  num_failed_batch_designs_ = 0;
 }
 
 /************************************************************************
@@ -213,6 +222,18 @@ void Shell<T>::set_command_dependency(const ShellCommandId& cmd_id,
   command_dependencies_[cmd_id] = dependent_cmds;
 }
 
+template<class T>
+void Shell<T>::mark_command_executed(const ShellCommandId& cmd_id) {
+  VTR_ASSERT(true == valid_command_id(cmd_id));
+  command_status_[cmd_id] = CMD_EXEC_SUCCESS;
+}
+
+template<class T>
+void Shell<T>::mark_command_unexecuted(const ShellCommandId& cmd_id) {
+  VTR_ASSERT(true == valid_command_id(cmd_id));
+  command_status_[cmd_id] = CMD_EXEC_NONE;
+}
+
 /* Add a command with it description */
 template<class T>
 ShellCommandClassId Shell<T>::add_command_class(const char* name) {
@@ -236,6 +257,11 @@ ShellCommandClassId Shell<T>::add_command_class(const char* name) {
   return cmd_class;
 } 
 
+template<class T>
+void Shell<T>::set_profile_file(const std::string& profile_file) {
+  profile_file_ = profile_file;
+}
+
 /************************************************************************
  * Public executors
  ***********************************************************************/
@@ -269,10 +295,50 @@ void Shell<T>::run_interactive_mode(T& context, const bool& quiet_mode) {
     /* Free the line as readline malloc a new line each time */
     free(cmd_line);
   }
+
+  /* End of input: the shell is left without the exit command */
+  write_profile_report();
+}
+
+template <class T>
+void Shell<T>::run_script_mode(const char* script_file_name, T& context, const bool& parallel_mode) {
+
+  time_start_ = std::clock();
+
+  VTR_LOG("Reading script file %s...\n", script_file_name);
+
+  /* Print the title of the shell */
+  if (!title().empty()) {
+    VTR_LOG("%s\n", title().c_str());
+  } 
+
+  std::vector<std::string> cmd_lines;
+  if (false == read_script_file(script_file_name, cmd_lines)) {
+    return;
+  }
+
+  if (true == parallel_mode) {
+    execute_script_in_parallel(cmd_lines, context);
+  } else {
+    for (const std::string& cmd_line : cmd_lines) {
+      VTR_LOG("\nCommand line to execute: %s\n", cmd_line.c_str());
+      int status = execute_command(cmd_line.c_str(), context);
+
+      /* Check the execution status of the command, if fatal error happened, we should abort immediately */
+      if (CMD_EXEC_FATAL_ERROR == status) {
+        VTR_LOG("Fatal error occurred!\nAbort and enter interactive mode\n");
+        break;
+      }
+    }
+  }
+
+  /* Return to interactive mode, stay tuned */
+  run_interactive_mode(context, true); 
 }
 
 template <class T>
-void Shell<T>::run_script_mode(const char* script_file_name, T& context) {
+void Shell<T>::run_batch_mode(const char* script_file_name, const char* batch_file_name, T& context,
+                              std::function<void(T&)> reset_function) {
 
   time_start_ = std::clock();
 
@@ -283,8 +349,267 @@ void Shell<T>::run_script_mode(const char* script_file_name, T& context) {
     VTR_LOG("%s\n", title().c_str());
   } 
 
+  std::vector<std::string> cmd_lines;
+  if (false == read_script_file(script_file_name, cmd_lines)) {
+    return;
+  }
+
+  VTR_LOG("Reading batch file %s...\n", batch_file_name);
+
+  std::vector<std::map<std::string, std::string>> designs;
+  if (false == read_batch_file(batch_file_name, designs)) {
+    return;
+  }
+
+  const ShellCommandId& exit_cmd_id = command(std::string("exit"));
+
+  std::vector<size_t> failed_designs;
+  for (size_t idesign = 0; idesign < designs.size(); ++idesign) {
+    VTR_LOG("\nBatch design %lu/%lu\n", idesign + 1, designs.size());
+
+    vtr::ScopedTraceEvent trace_event("Batch design", std::to_string(idesign + 1));
+
+    /* Start each design from a clean state, except the data kept by the reset function */
+    if (0 < idesign) {
+      reset_function(context);
+      for (const ShellCommandId& cmd_id : commands()) {
+        command_status_[cmd_id] = CMD_EXEC_NONE;
+      }
+    }
+
+    bool failed = false;
+    for (const std::string& cmd_line : cmd_lines) {
+      std::string design_cmd_line;
+      if (false == substitute_variables(cmd_line, designs[idesign], design_cmd_line)) {
+        failed = true;
+        break;
+      }
+
+      /* The 'exit' command ends the current design */
+      openfpga::StringToken tokenizer(design_cmd_line);
+      if ( (true == valid_command_id(exit_cmd_id))
+        && (exit_cmd_id == command(tokenizer.split(" ")[0])) ) {
+        break;
+      }
+
+      VTR_LOG("\nCommand line to execute: %s\n", design_cmd_line.c_str());
+      int status = execute_command(design_cmd_line.c_str(), context);
+
+      /* Check the execution status of the command, if fatal error happened, we should abort the design immediately */
+      if (CMD_EXEC_FATAL_ERROR == status) {
+        VTR_LOG("Fatal error occurred!\nAbort batch design %lu\n", idesign + 1);
+        break;
+      }
+    }
+
+    for (const int& status : command_status_) {
+      if ( (status == CMD_EXEC_FATAL_ERROR)
+        || (status == CMD_EXEC_MINOR_ERROR) ) {
+        failed = true;
+        break;
+      }
+    }
+    if (true == failed) {
+      failed_designs.push_back(idesign);
+    }
+  }
+
+  /* Summarize the failed designs */
+  VTR_LOG("\nBatch mode finished %lu designs with %lu failures\n",
+          designs.size(), failed_designs.size());
+  for (const size_t& idesign : failed_designs) {
+    std::string design_variables;
+    for (const auto& variable : designs[idesign]) {
+      design_variables += std::string(" ") + variable.first + std::string("=") + variable.second;
+    }
+    VTR_LOG_ERROR("Batch design %lu has errors:%s\n",
+                  idesign + 1, design_variables.c_str());
+  }
+  num_failed_batch_designs_ = failed_designs.size();
+
+  exit();
+}
+
+template <class T>
+void Shell<T>::run_server_mode(const char* socket_file_name, T& context) {
+  time_start_ = std::clock();
+
+  int server_fd = open_server_socket(socket_file_name);
+  if (-1 == server_fd) {
+    return;
+  }
+
+  VTR_LOG("Start server mode of %s at socket %s...\n",
+          name().c_str(), socket_file_name);
+
+  /* Print the title of the shell */
+  if (!title().empty()) {
+    VTR_LOG("%s\n", title().c_str());
+  } 
+
+  const ShellCommandId& exit_cmd_id = command(std::string("exit"));
+
+  size_t num_sessions = 0;
+  int client_fd;
+  while (-1 != (client_fd = accept_server_client(server_fd))) {
+    ++num_sessions;
+    vtr::ScopedTraceEvent trace_event("Server session", std::to_string(num_sessions));
+
+    std::string request;
+    if (false == read_client_request(client_fd, request)) {
+      close_server_client(client_fd);
+      continue;
+    }
+    std::istringstream request_stream(request);
+    std::vector<std::string> cmd_lines;
+    read_script_stream(request_stream, cmd_lines);
+
+    VTR_LOG("\nSession %lu: %lu command lines\n", num_sessions, cmd_lines.size());
+
+    size_t num_failed_cmds = 0;
+    {
+      /* The client receives the outputs of its commands */
+      ScopedOutputRedirect output_redirect(client_fd);
+
+      for (const std::string& cmd_line : cmd_lines) {
+        /* The 'exit' command ends the current session */
+        openfpga::StringToken tokenizer(cmd_line);
+        if ( (true == valid_command_id(exit_cmd_id))
+          && (exit_cmd_id == command(tokenizer.split(" ")[0])) ) {
+          break;
+        }
+
+        VTR_LOG("\nCommand line to execute: %s\n", cmd_line.c_str());
+        int status = execute_command(cmd_line.c_str(), context);
+        if ( (CMD_EXEC_FATAL_ERROR == status)
+          || (CMD_EXEC_MINOR_ERROR == status) ) {
+          ++num_failed_cmds;
+        }
+
+        /* Check the execution status of the command, if fatal error happened, we should abort the session immediately */
+        if (CMD_EXEC_FATAL_ERROR == status) {
+          VTR_LOG("Fatal error occurred!\nAbort the session\n");
+          break;
+        }
+      }
+
+      VTR_LOG("\nFinish session with %lu failed commands\n", num_failed_cmds);
+      VTR_LOG("%s%d\n", SHELL_SESSION_EXIT_CODE_TAG, 0 < num_failed_cmds ? 1 : 0);
+    }
+    close_server_client(client_fd);
+
+    VTR_LOG("Session %lu finished with %lu failed commands\n", num_sessions, num_failed_cmds);
+  }
+
+  close_server_socket(server_fd, socket_file_name);
+  VTR_LOG("\nServer stopped after %lu sessions\n", num_sessions);
+
+  write_profile_report();
+}
+
+/************************************************************************
+ * Read the variables of each design of a batch file, where
+ * - empty lines and comments are skipped
+ * - each line defines the variables of a design as NAME=VALUE,
+ *   which are separated by spaces
+ * Return false if the file can not be opened or is invalid
+ ***********************************************************************/
+template <class T>
+bool Shell<T>::read_batch_file(const char* batch_file_name,
+                               std::vector<std::map<std::string, std::string>>& designs) const {
+  /* Create an input file stream */
+  std::ifstream fp(batch_file_name);
+
+  if (!fp.is_open()) {
+    /* Fail to open the file, ask user to check */
+    VTR_LOG("Fail to open the batch file: %s! Please check its location\n",
+            batch_file_name);
+    return false; 
+  }
+
   std::string line;
+  size_t line_num = 0;
+  while (getline(fp, line)) {
+    line_num++;
+
+    /* The string before '#' is the definition of the design */
+    std::size_t comment_pos = line.find_first_of('#');
+    if (comment_pos != std::string::npos) {
+      line = line.substr(0, comment_pos);
+    }
+
+    std::map<std::string, std::string> variables;
+    std::istringstream line_stream(line);
+    std::string variable;
+    while (line_stream >> variable) {
+      std::size_t assign_pos = variable.find_first_of('=');
+      if ( (assign_pos == std::string::npos)
+        || (0 == assign_pos) ) {
+        VTR_LOG_ERROR("Invalid variable '%s' at line %lu of the batch file %s! Expect NAME=VALUE\n",
+                      variable.c_str(), line_num, batch_file_name);
+        return false;
+      }
+      variables[variable.substr(0, assign_pos)] = variable.substr(assign_pos + 1);
+    }
+
+    /* Skip empty line */
+    if (false == variables.empty()) {
+      designs.push_back(variables);
+    }
+  }
+  fp.close();
 
+  if (true == designs.empty()) {
+    VTR_LOG_ERROR("No design is defined in the batch file %s!\n",
+                  batch_file_name);
+    return false;
+  }
+
+  return true;
+}
+
+/************************************************************************
+ * Replace the ${NAME} of a command line with the values of the variables
+ * Return false if a variable is not defined
+ ***********************************************************************/
+template <class T>
+bool Shell<T>::substitute_variables(const std::string& cmd_line,
+                                    const std::map<std::string, std::string>& variables,
+                                    std::string& substituted_cmd_line) const {
+  substituted_cmd_line.clear();
+
+  size_t pos = 0;
+  while (pos < cmd_line.size()) {
+    size_t var_start = cmd_line.find("${", pos);
+    size_t var_end = (var_start == std::string::npos) ? std::string::npos : cmd_line.find('}', var_start);
+    if (var_end == std::string::npos) {
+      substituted_cmd_line += cmd_line.substr(pos);
+      break;
+    }
+
+    std::string name = cmd_line.substr(var_start + 2, var_end - var_start - 2);
+    auto result = variables.find(name);
+    if (result == variables.end()) {
+      VTR_LOG_ERROR("Variable '%s' is not defined for command line: %s\n",
+                    name.c_str(), cmd_line.c_str());
+      return false;
+    }
+    substituted_cmd_line += cmd_line.substr(pos, var_start - pos) + result->second;
+    pos = var_end + 1;
+  }
+
+  return true;
+}
+
+/************************************************************************
+ * Read the command lines of a script file, where
+ * - empty lines and comments are skipped
+ * - lines ending with '\' are continued on the next line
+ * Return false if the file can not be opened
+ ***********************************************************************/
+template <class T>
+bool Shell<T>::read_script_file(const char* script_file_name,
+                                std::vector<std::string>& cmd_lines) const {
   /* Create an input file stream */
   std::ifstream fp(script_file_name);
 
@@ -292,9 +617,24 @@ void Shell<T>::run_script_mode(const char* script_file_name, T& context) {
     /* Fail to open the file, ask user to check */
     VTR_LOG("Fail to open the script file: %s! Please check its location\n",
             script_file_name);
-    return; 
+    return false; 
   }
 
+  read_script_stream(fp, cmd_lines);
+  fp.close();
+
+  return true;
+}
+
+/************************************************************************
+ * Read the command lines of a script from a stream, 
+ * in the same format as a script file
+ ***********************************************************************/
+template <class T>
+void Shell<T>::read_script_stream(std::istream& fp,
+                                  std::vector<std::string>& cmd_lines) const {
+  std::string line;
+
   /* Consider that each line may not end due to the continued line charactor 
    * Use cmd_line to conjunct multiple lines 
    */
@@ -349,24 +689,90 @@ void Shell<T>::run_script_mode(const char* script_file_name, T& context) {
     cmd_line_tokenizer.ltrim(std::string(" "));
     cmd_line = cmd_line_tokenizer.data();
 
-    /* Process the command only when the full command line in ended */
+    /* Keep the command only when the full command line in ended */
     if (!cmd_line.empty()) {
-      VTR_LOG("\nCommand line to execute: %s\n", cmd_line.c_str());
-      int status = execute_command(cmd_line.c_str(), context);
+      cmd_lines.push_back(cmd_line);
       /* Empty the line ready to start a new line */
       cmd_line.clear();
+    }
+  }
+}
 
-      /* Check the execution status of the command, if fatal error happened, we should abort immediately */
-      if (CMD_EXEC_FATAL_ERROR == status) {
-        VTR_LOG("Fatal error occurred!\nAbort and enter interactive mode\n");
-        break;
+/************************************************************************
+ * Execute the command lines of a script, where the commands which only
+ * read the data exchange <T> (const execute functions) may run concurrently.
+ *
+ * The command lines are organized in a DAG, whose levels are executed one after another.
+ * A command line is placed at a level above
+ * - any earlier command which is not const (which is alone at its level)
+ * - any earlier command it depends on (see set_command_dependency())
+ * so that each command sees the same data as in the sequential execution. 
+ ***********************************************************************/
+template <class T>
+void Shell<T>::execute_script_in_parallel(const std::vector<std::string>& cmd_lines,
+                                          T& context) {
+  /* Find the command of each line */
+  std::vector<ShellCommandId> line_cmds;
+  for (const std::string& cmd_line : cmd_lines) {
+    openfpga::StringToken tokenizer(cmd_line);  
+    line_cmds.push_back(command(tokenizer.split(" ")[0]));
+  }
+
+  /* Assign the levels */
+  std::vector<size_t> line_levels(cmd_lines.size(), 0);
+  size_t num_levels = 0;
+  /* The first level after the last non-const command */
+  size_t min_level = 0;
+  for (size_t iline = 0; iline < cmd_lines.size(); ++iline) {
+    if (false == const_command(line_cmds[iline])) {
+      line_levels[iline] = num_levels;
+      num_levels++;
+      min_level = num_levels;
+      continue;
+    }
+
+    size_t level = min_level;
+    for (size_t jline = 0; jline < iline; ++jline) {
+      /* Lines below the minimum level are all executed earlier */
+      if (line_levels[jline] < min_level) {
+        continue;
+      }
+      const std::vector<ShellCommandId>& dep_cmds = command_dependencies_[line_cmds[iline]];
+      if (dep_cmds.end() != std::find(dep_cmds.begin(), dep_cmds.end(), line_cmds[jline])) {
+        level = std::max(level, line_levels[jline] + 1);
       }
     }
+    line_levels[iline] = level;
+    num_levels = std::max(num_levels, level + 1);
   }
-  fp.close();
 
-  /* Return to interactive mode, stay tuned */
-  run_interactive_mode(context, true); 
+  /* Execute the levels in order */
+  for (size_t level = 0; level < num_levels; ++level) {
+    std::vector<std::string> level_cmd_lines;
+    bool const_level = true;
+    for (size_t iline = 0; iline < cmd_lines.size(); ++iline) {
+      if (level == line_levels[iline]) {
+        level_cmd_lines.push_back(cmd_lines[iline]);
+        const_level = const_command(line_cmds[iline]);
+      }
+    }
+
+    int status = CMD_EXEC_SUCCESS;
+    if (false == const_level) {
+      /* A non-const command is alone at its level */
+      VTR_ASSERT(1 == level_cmd_lines.size());
+      VTR_LOG("\nCommand line to execute: %s\n", level_cmd_lines[0].c_str());
+      status = execute_command(level_cmd_lines[0].c_str(), context);
+    } else {
+      status = execute_const_commands(level_cmd_lines, context);
+    }
+
+    /* Check the execution status of the commands, if fatal error happened, we should abort immediately */
+    if (CMD_EXEC_FATAL_ERROR == status) {
+      VTR_LOG("Fatal error occurred!\nAbort and enter interactive mode\n");
+      break;
+    }
+  }
 }
 
 template <class T>
@@ -402,6 +808,9 @@ void Shell<T>::exit() const {
       break;
     }
   } 
+  if (0 < num_failed_batch_designs_) {
+    exit_code = 1;
+  }
 
   /* Show error message if we detect any errors */
   int num_err = 0;
@@ -428,6 +837,8 @@ void Shell<T>::exit() const {
   VTR_LOG("\nThe entire OpenFPGA flow took %g seconds\n",
           (double)(std::clock() - time_start_) / (double)CLOCKS_PER_SEC);
 
+  write_profile_report();
+
   VTR_LOG("\nThank you for using %s!\n",
           name().c_str());
 
@@ -440,6 +851,31 @@ void Shell<T>::exit() const {
 template <class T>
 int Shell<T>::execute_command(const char* cmd_line,
                                T& common_context) {
+  /* Each command is a trace event (see vtr_trace.h) */
+  vtr::ScopedTraceEvent trace_event("Command", cmd_line);
+
+  if (profile_file_.empty()) {
+    return execute_command_line(cmd_line, common_context);
+  }
+
+  /* Profile the command */
+  vtr::Timer timer;
+  double cpu_start = vtr::get_cpu_time();
+  vtr::reset_memory_peaks();
+
+  int status = execute_command_line(cmd_line, common_context);
+
+  command_profiles_.push_back({std::string(cmd_line), status, false,
+                               timer.elapsed_sec(), vtr::get_cpu_time() - cpu_start,
+                               timer.max_rss_mib(), timer.delta_max_rss_mib(),
+                               memory_peak_bytes()});
+
+  return status;
+}
+
+template <class T>
+int Shell<T>::execute_command_line(const char* cmd_line,
+                                   T& common_context) {
   /* Tokenize the line */
   openfpga::StringToken tokenizer(cmd_line);  
   std::vector<std::string> tokens = tokenizer.split(" ");
@@ -453,15 +889,8 @@ int Shell<T>::execute_command(const char* cmd_line,
   }
 
   /* Check the dependency graph to see if all the prequistics have been met */
-  for (const ShellCommandId& dep_cmd : command_dependencies_[cmd_id]) {
-    if ( (CMD_EXEC_NONE == command_status_[dep_cmd])
-      || (CMD_EXEC_FATAL_ERROR == command_status_[dep_cmd]) ) {
-      VTR_LOG("Command '%s' is required to be executed before command '%s'!\n",
-              commands_[dep_cmd].name().c_str(), commands_[cmd_id].name().c_str());
-      /* Echo the command help desk */
-      print_command_options(commands_[cmd_id]);
-      return CMD_EXEC_FATAL_ERROR;
-    } 
+  if (false == check_command_dependency(cmd_id)) {
+    return CMD_EXEC_FATAL_ERROR;
   }
 
   /* Find the command! Parse the options 
@@ -503,14 +932,12 @@ int Shell<T>::execute_command(const char* cmd_line,
   /* Execute the command depending on the type of function ! */ 
   switch (command_execute_function_types_[cmd_id]) {
   case CONST_STANDARD:
-    command_status_[cmd_id] = command_const_execute_functions_[cmd_id](common_context, commands_[cmd_id], command_contexts_[cmd_id]);
+  case CONST_SHORT:
+    command_status_[cmd_id] = execute_const_command(cmd_id, command_contexts_[cmd_id], common_context);
     break;
   case STANDARD:
     command_status_[cmd_id] = command_standard_execute_functions_[cmd_id](common_context, commands_[cmd_id], command_contexts_[cmd_id]);
     break;
-  case CONST_SHORT:
-    command_status_[cmd_id] = command_short_const_execute_functions_[cmd_id](common_context);
-    break;
   case SHORT:
     command_status_[cmd_id] = command_short_execute_functions_[cmd_id](common_context);
     break;
@@ -537,6 +964,287 @@ int Shell<T>::execute_command(const char* cmd_line,
   return command_status_[cmd_id];
 }
 
+/************************************************************************
+ * Execute a group of command lines whose commands are all const,
+ * each command in its own thread.
+ * The command lines are parsed (and echoed) before any execution,
+ * and the execution status are recorded in the order of the command lines
+ ***********************************************************************/
+template <class T>
+int Shell<T>::execute_const_commands(const std::vector<std::string>& cmd_lines,
+                                     const T& common_context) {
+  std::vector<ShellCommandId> cmd_ids;
+  std::vector<CommandContext> cmd_contexts;
+  int status = CMD_EXEC_SUCCESS;
+
+  for (const std::string& cmd_line : cmd_lines) {
+    VTR_LOG("\nCommand line to execute: %s\n", cmd_line.c_str());
+
+    openfpga::StringToken tokenizer(cmd_line);  
+    std::vector<std::string> tokens = tokenizer.split(" ");
+
+    ShellCommandId cmd_id = command(tokens[0]);
+    VTR_ASSERT(true == const_command(cmd_id));
+
+    if (false == check_command_dependency(cmd_id)) {
+      status = CMD_EXEC_FATAL_ERROR;
+      break;
+    }
+
+    CommandContext cmd_context(commands_[cmd_id]);
+    if (false == parse_command(tokens, commands_[cmd_id], cmd_context)) {
+      /* Echo the command */
+      print_command_options(commands_[cmd_id]);
+      status = CMD_EXEC_FATAL_ERROR;
+      break;
+    }
+    print_command_context(commands_[cmd_id], cmd_context);
+
+    cmd_ids.push_back(cmd_id);
+    cmd_contexts.push_back(cmd_context);
+  }
+  /* The commands before a fatal error are still executed, as in the sequential execution */
+
+  if (1 < cmd_ids.size()) {
+    VTR_LOG("\nExecute %lu commands concurrently\n", cmd_ids.size());
+  }
+
+  std::vector<int> cmd_status(cmd_ids.size(), CMD_EXEC_NONE);
+  std::vector<std::exception_ptr> cmd_errors(cmd_ids.size());
+  std::vector<double> cmd_wall_sec(cmd_ids.size(), 0.);
+  auto execute = [&](const size_t& icmd) {
+    vtr::ScopedTraceEvent trace_event("Command", cmd_lines[icmd]);
+    vtr::Timer cmd_timer;
+    try {
+      cmd_status[icmd] = execute_const_command(cmd_ids[icmd], cmd_contexts[icmd], common_context);
+    } catch (...) {
+      cmd_errors[icmd] = std::current_exception();
+    }
+    cmd_wall_sec[icmd] = cmd_timer.elapsed_sec();
+  };
+
+  vtr::Timer timer;
+  double cpu_start = vtr::get_cpu_time();
+  vtr::reset_memory_peaks();
+
+  /* The first command runs in this thread */
+  std::vector<std::thread> threads;
+  for (size_t icmd = 1; icmd < cmd_ids.size(); ++icmd) {
+    threads.emplace_back(execute, icmd);
+  }
+  if (!cmd_ids.empty()) {
+    execute(0);
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  if (!profile_file_.empty()) {
+    double cpu_sec = vtr::get_cpu_time() - cpu_start;
+    std::vector<size_t> group_memory_peak_bytes = memory_peak_bytes();
+    for (size_t icmd = 0; icmd < cmd_ids.size(); ++icmd) {
+      command_profiles_.push_back({cmd_lines[icmd], cmd_status[icmd], 1 < cmd_ids.size(),
+                                   cmd_wall_sec[icmd], cpu_sec,
+                                   timer.max_rss_mib(), timer.delta_max_rss_mib(),
+                                   group_memory_peak_bytes});
+    }
+  }
+
+  for (size_t icmd = 0; icmd < cmd_ids.size(); ++icmd) {
+    if (cmd_errors[icmd]) {
+      std::rethrow_exception(cmd_errors[icmd]);
+    }
+
+    command_contexts_[cmd_ids[icmd]] = cmd_contexts[icmd];
+    command_status_[cmd_ids[icmd]] = cmd_status[icmd];
+
+    /* Forbid users to return the status CMD_EXEC_NONE */
+    if (CMD_EXEC_NONE == cmd_status[icmd]) {
+      VTR_LOG_ERROR("It is illegal to return never-executed status for an executed command!\n");
+      status = CMD_EXEC_FATAL_ERROR;
+    } else if (CMD_EXEC_FATAL_ERROR == cmd_status[icmd]) {
+      status = CMD_EXEC_FATAL_ERROR;
+    } else if ( (CMD_EXEC_MINOR_ERROR == cmd_status[icmd])
+             && (CMD_EXEC_SUCCESS == status) ) {
+      status = CMD_EXEC_MINOR_ERROR;
+    }
+  }
+
+  return status;
+}
+
+/************************************************************************
+ * Execute a command with a const execute function 
+ * This does not modify the shell, so that it can be called by several threads
+ ***********************************************************************/
+template <class T>
+int Shell<T>::execute_const_command(const ShellCommandId& cmd_id,
+                                    const CommandContext& cmd_context,
+                                    const T& common_context) const {
+  switch (command_execute_function_types_[cmd_id]) {
+  case CONST_STANDARD:
+    return command_const_execute_functions_[cmd_id](common_context, commands_[cmd_id], cmd_context);
+  case CONST_SHORT:
+    return command_short_const_execute_functions_[cmd_id](common_context);
+  default:
+    /* This is not allowed! */
+    VTR_LOG_ERROR("Invalid type of execute function for command '%s'!\n",
+                  commands_[cmd_id].name().c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+}
+
+/************************************************************************
+ * Check if all the commands that a command depends on have been executed
+ * successfully. If not, echo the help desk of the command
+ ***********************************************************************/
+template <class T>
+bool Shell<T>::check_command_dependency(const ShellCommandId& cmd_id) const {
+  for (const ShellCommandId& dep_cmd : command_dependencies_[cmd_id]) {
+    if ( (CMD_EXEC_NONE == command_status_[dep_cmd])
+      || (CMD_EXEC_FATAL_ERROR == command_status_[dep_cmd]) ) {
+      VTR_LOG("Command '%s' is required to be executed before command '%s'!\n",
+              commands_[dep_cmd].name().c_str(), commands_[cmd_id].name().c_str());
+      /* Echo the command help desk */
+      print_command_options(commands_[cmd_id]);
+      return false;
+    } 
+  }
+
+  return true;
+}
+
+/************************************************************************
+ * Check if a command only reads the data exchange <T>, 
+ * i.e., it has a const execute function
+ ***********************************************************************/
+template <class T>
+bool Shell<T>::const_command(const ShellCommandId& cmd_id) const {
+  if (false == valid_command_id(cmd_id)) {
+    return false;
+  }
+  return (CONST_STANDARD == command_execute_function_types_[cmd_id])
+      || (CONST_SHORT == command_execute_function_types_[cmd_id]);
+}
+
+/************************************************************************
+ * Collect the peak memory of each owner since the peaks were reset
+ ***********************************************************************/
+template <class T>
+std::vector<size_t> Shell<T>::memory_peak_bytes() {
+  std::vector<size_t> peak_bytes;
+  if (false == vtr::memory_stats_enabled()) {
+    return peak_bytes;
+  }
+  for (const vtr::MemoryOwner* owner : vtr::memory_owners()) {
+    peak_bytes.push_back(owner->peak_bytes());
+  }
+  return peak_bytes;
+}
+
+/************************************************************************
+ * Write the profiling results of the executed commands to the profile file
+ * The format is JSON if the file name ends with '.json', otherwise CSV
+ * When memory accounting is enabled, the peak memory of each owner
+ * is reported as well. Owners created after a command have no peak for it
+ ***********************************************************************/
+template <class T>
+void Shell<T>::write_profile_report() const {
+  if (profile_file_.empty()) {
+    return;
+  }
+
+  std::ofstream fp(profile_file_);
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open the profile file: %s!\n",
+                  profile_file_.c_str());
+    return;
+  }
+
+  const std::string json_suffix(".json");
+  bool json = (profile_file_.size() >= json_suffix.size())
+           && (0 == profile_file_.compare(profile_file_.size() - json_suffix.size(), json_suffix.size(), json_suffix));
+
+  /* Command lines are quoted, with the special characters escaped */
+  auto quote = [&](const std::string& str) {
+    std::string quoted("\"");
+    for (const char& c : str) {
+      if ('"' == c) {
+        quoted += json ? "\\\"" : "\"\"";
+      } else if (json && ('\\' == c)) {
+        quoted += "\\\\";
+      } else if (json && ('\t' == c)) {
+        quoted += "\\t";
+      } else {
+        quoted += c;
+      }
+    }
+    quoted += "\"";
+    return quoted;
+  };
+
+  std::vector<const vtr::MemoryOwner*> memory_owners;
+  if (true == vtr::memory_stats_enabled()) {
+    memory_owners = vtr::memory_owners();
+  }
+  auto memory_peak_mib = [&](const t_command_profile& profile, const size_t& iowner) {
+    if (iowner >= profile.memory_peak_bytes.size()) {
+      return 0.;
+    }
+    return profile.memory_peak_bytes[iowner] / (1024. * 1024.);
+  };
+
+  if (json) {
+    fp << "{\n";
+    fp << "  \"commands\": [";
+    for (size_t icmd = 0; icmd < command_profiles_.size(); ++icmd) {
+      const t_command_profile& profile = command_profiles_[icmd];
+      fp << (0 == icmd ? "\n" : ",\n");
+      fp << "    {";
+      fp << "\"command\": " << quote(profile.cmd_line) << ", ";
+      fp << "\"status\": " << profile.status << ", ";
+      fp << "\"concurrent\": " << (profile.concurrent ? "true" : "false") << ", ";
+      fp << "\"wall_time_sec\": " << profile.wall_sec << ", ";
+      fp << "\"cpu_time_sec\": " << profile.cpu_sec << ", ";
+      fp << "\"peak_rss_mib\": " << profile.max_rss_mib << ", ";
+      fp << "\"delta_peak_rss_mib\": " << profile.delta_max_rss_mib;
+      if (!memory_owners.empty()) {
+        fp << ", \"owner_peak_mib\": {";
+        for (size_t iowner = 0; iowner < memory_owners.size(); ++iowner) {
+          fp << (0 == iowner ? "" : ", ");
+          fp << quote(memory_owners[iowner]->name()) << ": " << memory_peak_mib(profile, iowner);
+        }
+        fp << "}";
+      }
+      fp << "}";
+    }
+    fp << "\n  ]\n";
+    fp << "}\n";
+  } else {
+    fp << "command,status,concurrent,wall_time_sec,cpu_time_sec,peak_rss_mib,delta_peak_rss_mib";
+    for (const vtr::MemoryOwner* owner : memory_owners) {
+      fp << "," << quote(owner->name() + " peak_mib");
+    }
+    fp << "\n";
+    for (const t_command_profile& profile : command_profiles_) {
+      fp << quote(profile.cmd_line) << ",";
+      fp << profile.status << ",";
+      fp << (profile.concurrent ? 1 : 0) << ",";
+      fp << profile.wall_sec << ",";
+      fp << profile.cpu_sec << ",";
+      fp << profile.max_rss_mib << ",";
+      fp << profile.delta_max_rss_mib;
+      for (size_t iowner = 0; iowner < memory_owners.size(); ++iowner) {
+        fp << "," << memory_peak_mib(profile, iowner);
+      }
+      fp << "\n";
+    }
+  }
+
+  VTR_LOG("Wrote the profile of %lu commands to %s\n",
+          command_profiles_.size(), profile_file_.c_str());
+}
+
 /************************************************************************
  * Public invalidators/validators 
  ***********************************************************************/
@@ -0,0 +1,272 @@
+/*********************************************************************
+ * Functions to communicate between the shell in server mode and its clients
+ ********************************************************************/
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+#include "shell_socket.h"
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/* Number of clients waiting for a connection */
+constexpr int SERVER_SOCKET_BACKLOG = 16;
+
+/* Flag set by the signal handlers to stop the server */
+static volatile std::sig_atomic_t server_stop_requested = 0;
+
+static
+void request_server_stop(int /*signal*/) {
+  server_stop_requested = 1;
+}
+
+/********************************************************************
+ * Fill the address of a socket file. Return false if the name is too long
+ *******************************************************************/
+static 
+bool fill_socket_address(const char* socket_file_name, sockaddr_un& address) {
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (std::strlen(socket_file_name) >= sizeof(address.sun_path)) {
+    VTR_LOG_ERROR("Socket file name '%s' is too long (at most %lu characters)!\n",
+                  socket_file_name, sizeof(address.sun_path) - 1);
+    return false;
+  }
+  std::strncpy(address.sun_path, socket_file_name, sizeof(address.sun_path) - 1);
+  return true;
+}
+
+/********************************************************************
+ * Write a buffer entirely to a file descriptor
+ *******************************************************************/
+static 
+bool write_all(const int& fd, const char* buffer, size_t size) {
+  while (0 < size) {
+    ssize_t num_written = write(fd, buffer, size);
+    if (0 > num_written) {
+      if (EINTR == errno) {
+        continue;
+      }
+      return false;
+    }
+    buffer += num_written;
+    size -= size_t(num_written);
+  }
+  return true;
+}
+
+int open_server_socket(const char* socket_file_name) {
+  sockaddr_un address;
+  if (false == fill_socket_address(socket_file_name, address)) {
+    return -1;
+  }
+
+  /* Remove the socket left by a previous server, but never any other kind of file */
+  struct stat file_status;
+  if (0 == lstat(socket_file_name, &file_status)) {
+    if (!S_ISSOCK(file_status.st_mode)) {
+      VTR_LOG_ERROR("File '%s' exists and is not a socket!\n", socket_file_name);
+      return -1;
+    }
+    if (0 != unlink(socket_file_name)) {
+      VTR_LOG_ERROR("Fail to remove the previous socket '%s': %s\n",
+                    socket_file_name, std::strerror(errno));
+      return -1;
+    }
+  } else if (ENOENT != errno) {
+    VTR_LOG_ERROR("Fail to access socket '%s': %s\n",
+                  socket_file_name, std::strerror(errno));
+    return -1;
+  }
+
+  int server_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (-1 == server_fd) {
+    VTR_LOG_ERROR("Fail to create a socket: %s\n", std::strerror(errno));
+    return -1;
+  }
+
+  /* Clients may execute any command, so only the owner of the server can connect:
+   * the socket is created without any permission for the group and the others
+   */
+  mode_t saved_umask = umask(S_IRWXG | S_IRWXO);
+  int bind_status = bind(server_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+  umask(saved_umask);
+
+  if ( (0 != bind_status)
+    || (0 != chmod(socket_file_name, S_IRUSR | S_IWUSR))
+    || (0 != listen(server_fd, SERVER_SOCKET_BACKLOG)) ) {
+    VTR_LOG_ERROR("Fail to listen at socket '%s': %s\n",
+                  socket_file_name, std::strerror(errno));
+    close(server_fd);
+    if (0 == bind_status) {
+      unlink(socket_file_name);
+    }
+    return -1;
+  }
+
+  /* Stop the server at SIGINT and SIGTERM, without restarting the pending accept()
+   * A client leaving early should not kill the server when it writes outputs (SIGPIPE)
+   */
+  struct sigaction stop_action;
+  std::memset(&stop_action, 0, sizeof(stop_action));
+  stop_action.sa_handler = request_server_stop;
+  sigemptyset(&stop_action.sa_mask);
+  sigaction(SIGINT, &stop_action, nullptr);
+  sigaction(SIGTERM, &stop_action, nullptr);
+  std::signal(SIGPIPE, SIG_IGN);
+
+  return server_fd;
+}
+
+void close_server_socket(const int& server_fd, const char* socket_file_name) {
+  close(server_fd);
+  unlink(socket_file_name);
+}
+
+int accept_server_client(const int& server_fd) {
+  while (0 == server_stop_requested) {
+    int client_fd = accept(server_fd, nullptr, nullptr);
+    if (-1 != client_fd) {
+      return client_fd;
+    }
+    if (EINTR != errno) {
+      VTR_LOG_ERROR("Fail to accept a client: %s\n", std::strerror(errno));
+      return -1;
+    }
+  }
+  return -1;
+}
+
+void close_server_client(const int& client_fd) {
+  close(client_fd);
+}
+
+bool read_client_request(const int& client_fd, std::string& request) {
+  char buffer[4096];
+  request.clear();
+  while (true) {
+    ssize_t num_read = read(client_fd, buffer, sizeof(buffer));
+    if (0 == num_read) {
+      return true;
+    }
+    if (0 > num_read) {
+      if (EINTR == errno) {
+        continue;
+      }
+      VTR_LOG_ERROR("Fail to read the request of a client: %s\n", std::strerror(errno));
+      return false;
+    }
+    request.append(buffer, size_t(num_read));
+  }
+}
+
+int run_shell_client(const char* socket_file_name, const char* script_file_name) {
+  /* Read the script first, so that the server is not blocked by a missing file */
+  std::ifstream fp(script_file_name);
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open the script file: %s! Please check its location\n",
+                  script_file_name);
+    return 1;
+  }
+  std::stringstream script;
+  script << fp.rdbuf();
+
+  sockaddr_un address;
+  if (false == fill_socket_address(socket_file_name, address)) {
+    return 1;
+  }
+
+  int client_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if ( (-1 == client_fd)
+    || (0 != connect(client_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address))) ) {
+    VTR_LOG_ERROR("Fail to connect to the server at socket '%s': %s\n",
+                  socket_file_name, std::strerror(errno));
+    if (-1 != client_fd) {
+      close(client_fd);
+    }
+    return 1;
+  }
+
+  /* Send the script and tell the server that the request is complete */
+  const std::string& request = script.str();
+  if ( (false == write_all(client_fd, request.c_str(), request.size()))
+    || (0 != shutdown(client_fd, SHUT_WR)) ) {
+    VTR_LOG_ERROR("Fail to send the script to the server: %s\n", std::strerror(errno));
+    close(client_fd);
+    return 1;
+  }
+
+  /* Print the outputs of the session as they come, except the line of the exit code,
+   * which is the last one
+   */
+  std::string pending;
+  char buffer[4096];
+  ssize_t num_read;
+  while (0 != (num_read = read(client_fd, buffer, sizeof(buffer)))) {
+    if (0 > num_read) {
+      if (EINTR == errno) {
+        continue;
+      }
+      break;
+    }
+    pending.append(buffer, size_t(num_read));
+    /* Print the complete lines but the last one, which may be the line of the exit code */
+    size_t last_newline = pending.rfind('\n');
+    if ( (std::string::npos == last_newline) || (0 == last_newline) ) {
+      continue;
+    }
+    size_t prev_newline = pending.rfind('\n', last_newline - 1);
+    if (std::string::npos != prev_newline) {
+      std::fwrite(pending.c_str(), 1, prev_newline + 1, stdout);
+      pending.erase(0, prev_newline + 1);
+    }
+  }
+  close(client_fd);
+
+  size_t tag_pos = pending.rfind(SHELL_SESSION_EXIT_CODE_TAG);
+  if (std::string::npos == tag_pos) {
+    std::fwrite(pending.c_str(), 1, pending.size(), stdout);
+    VTR_LOG_ERROR("Connection to the server is closed before the end of the session!\n");
+    return 1;
+  }
+  std::fwrite(pending.c_str(), 1, tag_pos, stdout);
+  std::fflush(stdout);
+
+  return std::atoi(pending.c_str() + tag_pos + std::strlen(SHELL_SESSION_EXIT_CODE_TAG));
+}
+
+/********************************************************************
+ * Member functions for class ScopedOutputRedirect
+ *******************************************************************/
+ScopedOutputRedirect::ScopedOutputRedirect(const int& client_fd) {
+  std::fflush(stdout);
+  std::fflush(stderr);
+  saved_stdout_fd_ = dup(STDOUT_FILENO);
+  saved_stderr_fd_ = dup(STDERR_FILENO);
+  dup2(client_fd, STDOUT_FILENO);
+  dup2(client_fd, STDERR_FILENO);
+}
+
+ScopedOutputRedirect::~ScopedOutputRedirect() {
+  std::fflush(stdout);
+  std::fflush(stderr);
+  dup2(saved_stdout_fd_, STDOUT_FILENO);
+  dup2(saved_stderr_fd_, STDERR_FILENO);
+  close(saved_stdout_fd_);
+  close(saved_stderr_fd_);
+}
+
+} /* End namespace openfpga */
@@ -0,0 +1,70 @@
+#ifndef SHELL_SOCKET_H
+#define SHELL_SOCKET_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+
+/********************************************************************
+ * Function declaration
+ *
+ * These functions implement the communication between the shell in 
+ * server mode and its clients through a local (UNIX domain) socket.
+ *
+ * A session is opened by each connection of a client:
+ * - the client sends a script, i.e., command lines in the same format
+ *   as a script file, and closes its side of the connection for writing
+ * - the server executes the script and sends back its outputs
+ * - the last line sent by the server is the tag SHELL_SESSION_EXIT_CODE_TAG
+ *   followed by the exit code of the session, 0 if no command failed
+ *******************************************************************/
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+constexpr char SHELL_SESSION_EXIT_CODE_TAG[] = "OpenFPGA session exit code: ";
+
+/* Create a socket listening at the given file. Return -1 if failed
+ * A socket left at the file by a previous server is replaced,
+ * while any other kind of existing file is an error.
+ * Only the owner of the server can connect to the socket
+ */
+int open_server_socket(const char* socket_file_name);
+
+/* Close the socket of the server and remove its file */
+void close_server_socket(const int& server_fd, const char* socket_file_name);
+
+/* Wait for the connection of the next client, and return its file descriptor
+ * Return -1 when the server is requested to stop, i.e., by a SIGINT or SIGTERM signal
+ */
+int accept_server_client(const int& server_fd);
+
+/* Close the connection of a client */
+void close_server_client(const int& client_fd);
+
+/* Read the request of a client until the client stops writing */
+bool read_client_request(const int& client_fd, std::string& request);
+
+/* Connect to a shell in server mode, send the script and print the outputs of the session.
+ * Return the exit code of the session, or 1 if the communication failed
+ */
+int run_shell_client(const char* socket_file_name, const char* script_file_name);
+
+/********************************************************************
+ * Redirect the standard output and error of the process to a client 
+ * during the lifetime of the object, so that the client receives the
+ * logs of the commands it requests
+ *******************************************************************/
+class ScopedOutputRedirect {
+  public: /* Constructor and destructor */
+    explicit ScopedOutputRedirect(const int& client_fd);
+    ~ScopedOutputRedirect();
+  private: /* Internal data */
+    int saved_stdout_fd_;
+    int saved_stderr_fd_;
+};
+
+} /* End namespace openfpga */
+
+#endif
@@ -0,0 +1,165 @@
+/********************************************************************
+ * Test the server mode of the shell:
+ * - a client connects, executes a script and receives the exit code
+ * - the socket is only accessible by its owner
+ * - an existing file which is not a socket is never removed
+ * Return 0 if all the checks pass
+ *******************************************************************/
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "vtr_log.h"
+#include "shell.h"
+#include "shell_socket.h"
+
+using namespace openfpga;
+
+class ShellContext {
+  public:
+    int a = 0;
+};
+
+static
+int shell_execute_set(ShellContext& context,
+                      const Command& cmd, const CommandContext& cmd_context) {
+  CommandOptionId opt_id = cmd.option("value");
+  context.a = std::atoi(cmd_context.option_value(cmd, opt_id).c_str());
+
+  return CMD_EXEC_SUCCESS;
+}
+
+static
+int shell_execute_check(ShellContext& context) {
+  /* Fail if 'set' was not executed in the same server */
+  return (42 == context.a) ? CMD_EXEC_SUCCESS : CMD_EXEC_FATAL_ERROR;
+}
+
+static
+void write_test_file(const std::string& fname, const std::string& contents) {
+  std::ofstream fp(fname);
+  fp << contents;
+}
+
+/* Return true when a client can connect to the socket, i.e., the server listens */
+static
+bool probe_server_socket(const std::string& socket_fname) {
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  std::strncpy(address.sun_path, socket_fname.c_str(), sizeof(address.sun_path) - 1);
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  bool connected = (0 == connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)));
+  /* The server runs an empty session for the probe */
+  close(fd);
+  return connected;
+}
+
+static
+bool check(const bool& condition, const char* message) {
+  if (false == condition) {
+    VTR_LOG_ERROR("Check failed: %s\n", message);
+  }
+  return condition;
+}
+
+int main() {
+  Shell<ShellContext> shell("test_shell_socket");
+
+  ShellCommandClassId cmd_class = shell.add_command_class("Basic");
+
+  Command shell_cmd_set("set");
+  CommandOptionId set_opt_value = shell_cmd_set.add_option("value", true, "value of variable");
+  shell_cmd_set.set_option_require_value(set_opt_value, OPT_STRING);
+  ShellCommandId shell_cmd_set_id = shell.add_command(shell_cmd_set, "Set a value to internal variable 'a'");
+  shell.set_command_class(shell_cmd_set_id, cmd_class);
+  shell.set_command_execute_function(shell_cmd_set_id, shell_execute_set);
+
+  Command shell_cmd_check("check");
+  ShellCommandId shell_cmd_check_id = shell.add_command(shell_cmd_check, "Check that internal variable 'a' is 42");
+  shell.set_command_class(shell_cmd_check_id, cmd_class);
+  shell.set_command_execute_function(shell_cmd_check_id, shell_execute_check);
+
+  Command shell_cmd_exit("exit");
+  ShellCommandId shell_cmd_exit_id = shell.add_command(shell_cmd_exit, "Exit the shell");
+  shell.set_command_class(shell_cmd_exit_id, cmd_class);
+  shell.set_command_execute_function(shell_cmd_exit_id, [shell](){shell.exit();});
+
+  std::string test_dir = std::string("test_shell_socket.") + std::to_string(getpid());
+  mkdir(test_dir.c_str(), S_IRWXU);
+  std::string socket_fname = test_dir + "/shell.sock";
+  std::string regular_fname = test_dir + "/regular.txt";
+  std::string pass_script_fname = test_dir + "/pass.openfpga";
+  std::string fail_script_fname = test_dir + "/fail.openfpga";
+
+  write_test_file(regular_fname, "not a socket\n");
+  write_test_file(pass_script_fname, "set --value 42\ncheck\nexit\n");
+  write_test_file(fail_script_fname, "set --value 1\ncheck\n");
+
+  bool pass = true;
+
+  /* An existing file which is not a socket must be kept */
+  pass &= check(-1 == open_server_socket(regular_fname.c_str()),
+                "server socket is opened over a regular file");
+  struct stat file_status;
+  pass &= check( (0 == lstat(regular_fname.c_str(), &file_status)) && S_ISREG(file_status.st_mode),
+                "regular file is removed");
+
+  /* Run the server in a child process, which is stopped by SIGTERM */
+  pid_t server_pid = fork();
+  if (0 == server_pid) {
+    ShellContext shell_context;
+    shell.run_server_mode(socket_fname.c_str(), shell_context);
+    _exit(0);
+  }
+
+  /* Wait for the server to listen */
+  bool listening = false;
+  for (int itry = 0; (false == listening) && (itry < 100); ++itry) {
+    listening = probe_server_socket(socket_fname);
+    if (false == listening) {
+      usleep(50000);
+    }
+  }
+  pass &= check(listening, "server does not listen");
+  pass &= check( (0 == lstat(socket_fname.c_str(), &file_status)) && S_ISSOCK(file_status.st_mode),
+                "server socket is not created");
+  pass &= check(0 == (file_status.st_mode & (S_IRWXG | S_IRWXO)),
+                "server socket is accessible by other users");
+
+  /* Each session returns its own exit code */
+  pass &= check(0 == run_shell_client(socket_fname.c_str(), pass_script_fname.c_str()),
+                "successful session returns a non-zero exit code");
+  pass &= check(0 != run_shell_client(socket_fname.c_str(), fail_script_fname.c_str()),
+                "failed session returns a zero exit code");
+
+  kill(server_pid, SIGTERM);
+  int server_status = 0;
+  waitpid(server_pid, &server_status, 0);
+  pass &= check(WIFEXITED(server_status) && (0 == WEXITSTATUS(server_status)),
+                "server does not stop cleanly");
+  pass &= check(0 != lstat(socket_fname.c_str(), &file_status),
+                "server socket is not removed");
+
+  unlink(regular_fname.c_str());
+  unlink(pass_script_fname.c_str());
+  unlink(fail_script_fname.c_str());
+  rmdir(test_dir.c_str());
+
+  if (true == pass) {
+    VTR_LOG("All the server mode checks passed\n");
+    return 0;
+  }
+  return 1;
+}
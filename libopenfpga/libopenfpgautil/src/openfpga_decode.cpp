@@ -2,6 +2,8 @@
  * This file includes functions that are used to decode integer to binary vectors
  * or the reverse operation
  ***************************************************************************************/
+#include <algorithm>
+#include <array>
 #include <cmath>
 
 /* Headers from vtrutil library */
@@ -128,4 +130,45 @@ size_t bintoi_charvec(const std::vector<char>& bin) {
   return ret;
 }
 
+/******************************************************************** 
+ * Append the binary format of an integer to a string buffer
+ * in the same order as itobin_charvec(), i.e., the least significant bit first
+ * For example: 
+ *   Input integer: 4
+ *   Binary length : 3
+ *   Appended characters: "001"
+ *
+ * There is no memory allocation other than growing the buffer,
+ * and each byte is converted through a look-up table.
+ * This is designed for writers which output a large number of addresses
+ ********************************************************************/
+static 
+std::array<std::array<char, 8>, 256> build_byte_to_bin_chars_table() {
+  std::array<std::array<char, 8>, 256> table;
+  for (size_t byte = 0; byte < 256; ++byte) {
+    for (size_t ibit = 0; ibit < 8; ++ibit) {
+      table[byte][ibit] = (1 == ((byte >> ibit) & 1)) ? '1' : '0';
+    }
+  }
+  return table;
+}
+
+void append_itobin_chars(std::string& buffer,
+                         const size_t& in_int,
+                         const size_t& bin_len) {
+  static const std::array<std::array<char, 8>, 256> byte_to_bin_chars = build_byte_to_bin_chars_table();
+
+  /* Make sure we do not have any overflow! */
+  VTR_ASSERT ( (bin_len >= 8 * sizeof(size_t)) || (in_int < (size_t(1) << bin_len)) );
+
+  size_t temp = in_int;
+  size_t num_remaining_bits = bin_len;
+  while (0 < num_remaining_bits) {
+    size_t num_byte_bits = std::min(num_remaining_bits, size_t(8));
+    buffer.append(byte_to_bin_chars[temp & 0xff].data(), num_byte_bits);
+    temp >>= 8;
+    num_remaining_bits -= num_byte_bits;
+  }
+}
+
 } /* end namespace openfpga */
@@ -4,6 +4,7 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <string>
 #include <vector>
 
 /********************************************************************
@@ -23,6 +24,10 @@ std::vector<char> itobin_charvec(const size_t& in_int,
 
 size_t bintoi_charvec(const std::vector<char>& bin);
 
+void append_itobin_chars(std::string& buffer,
+                         const size_t& in_int,
+                         const size_t& bin_len);
+
 } /* namespace openfpga ends */
 
 #endif
@@ -3,6 +3,7 @@
  * in OpenFPGA framework
  *******************************************************************/
 #include <sys/stat.h>
+#include <cstdio>
 #include <vector>
 #include <algorithm>
 
@@ -14,6 +15,115 @@
 
 namespace openfpga {
 
+/********************************************************************
+ * The buffer must be installed before the file is opened
+ *******************************************************************/
+BufferedFileStream::BufferedFileStream(const size_t& buffer_size)
+  : buffer_(new char[buffer_size]) {
+  rdbuf()->pubsetbuf(buffer_.get(), buffer_size);
+}
+
+/********************************************************************
+ * Close the file here, so that the pending data is flushed
+ * before the buffer is released
+ *******************************************************************/
+BufferedFileStream::~BufferedFileStream() {
+  if (is_open()) {
+    close();
+  }
+}
+
+IncrementalFileStream::IncrementalFileStream(const bool& incremental,
+                                             const std::string& ignored_line_prefix)
+  : incremental_(incremental),
+    ignored_line_prefix_(ignored_line_prefix),
+    unchanged_(false) {
+}
+
+/********************************************************************
+ * The temporary file must be resolved before the stream is destroyed
+ *******************************************************************/
+IncrementalFileStream::~IncrementalFileStream() {
+  if (is_open()) {
+    close();
+  }
+}
+
+/********************************************************************
+ * Open the temporary file, when incremental writing is enabled
+ *******************************************************************/
+void IncrementalFileStream::open(const std::string& fname, std::ios_base::openmode mode) {
+  fname_ = fname;
+  unchanged_ = false;
+  if (true == incremental_) {
+    std::fstream::open(fname + std::string(INCREMENTAL_FILE_TEMP_POSTFIX), mode);
+  } else {
+    std::fstream::open(fname, mode);
+  }
+}
+
+/********************************************************************
+ * Identify if two files have the same content, 
+ * except the lines starting with the ignored prefix in both files
+ *******************************************************************/
+static 
+bool same_file_contents(const std::string& fname_a,
+                        const std::string& fname_b,
+                        const std::string& ignored_line_prefix) {
+  std::ifstream fp_a(fname_a);
+  std::ifstream fp_b(fname_b);
+  if ( (!fp_a.is_open()) || (!fp_b.is_open()) ) {
+    return false;
+  }
+
+  std::string line_a;
+  std::string line_b;
+  while (true) {
+    bool has_line_a = static_cast<bool>(std::getline(fp_a, line_a));
+    bool has_line_b = static_cast<bool>(std::getline(fp_b, line_b));
+    if (has_line_a != has_line_b) {
+      return false;
+    }
+    if (false == has_line_a) {
+      return true;
+    }
+    if ( (false == ignored_line_prefix.empty())
+      && (0 == line_a.compare(0, ignored_line_prefix.size(), ignored_line_prefix))
+      && (0 == line_b.compare(0, ignored_line_prefix.size(), ignored_line_prefix)) ) {
+      continue;
+    }
+    if (line_a != line_b) {
+      return false;
+    }
+  }
+}
+
+/********************************************************************
+ * Close the file, and replace the existing file by the temporary file
+ * only if their contents are different
+ *******************************************************************/
+void IncrementalFileStream::close() {
+  std::fstream::close();
+  if (false == incremental_) {
+    return;
+  }
+
+  std::string temp_fname = fname_ + std::string(INCREMENTAL_FILE_TEMP_POSTFIX);
+  unchanged_ = same_file_contents(fname_, temp_fname, ignored_line_prefix_);
+  if (true == unchanged_) {
+    std::remove(temp_fname.c_str());
+    return;
+  }
+  if (0 != std::rename(temp_fname.c_str(), fname_.c_str())) {
+    VTR_LOG_ERROR("Unable to replace file '%s' by '%s'!\n",
+                  fname_.c_str(), temp_fname.c_str());
+  }
+}
+
+bool IncrementalFileStream::unchanged() const {
+  return unchanged_;
+}
+
 /********************************************************************
  * A most utilized function to validate the file stream
  * This function will return true or false for a valid/invalid file stream 
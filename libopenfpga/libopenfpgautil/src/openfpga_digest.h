@@ -5,6 +5,8 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <fstream>
+#include <memory>
+#include <string>
 
 /********************************************************************
  * Function declaration
@@ -12,6 +14,56 @@
 /* namespace openfpga begins */
 namespace openfpga {
 
+/********************************************************************
+ * A file stream with a large user-space buffer
+ * It can be used by any writer taking a std::fstream, and it reaches
+ * the operating system in large blocks rather than small tokens.
+ * Note that the writers should use "\n" rather than std::endl,
+ * which forces a flush of the buffer
+ *******************************************************************/
+constexpr size_t DEFAULT_FILE_STREAM_BUFFER_SIZE = 4 << 20;
+
+class BufferedFileStream : public std::fstream {
+  public: /* Public constructor */
+    explicit BufferedFileStream(const size_t& buffer_size = DEFAULT_FILE_STREAM_BUFFER_SIZE);
+    ~BufferedFileStream();
+
+  private: /* Internal data */
+    std::unique_ptr<char[]> buffer_;
+};
+
+/********************************************************************
+ * A buffered file stream which leaves an existing file untouched
+ * when the new content is the same, so that downstream tools,
+ * e.g., simulators and make, do not process an unchanged file again.
+ * When incremental writing is enabled, the content is written to a temporary file,
+ * which is compared to the existing file and replaces it only if they differ.
+ * Lines starting with the ignored prefix, e.g., a time stamp, are not compared.
+ * Otherwise, it is a plain BufferedFileStream
+ *******************************************************************/
+constexpr char* INCREMENTAL_FILE_TEMP_POSTFIX = ".tmp";
+
+class IncrementalFileStream : public BufferedFileStream {
+  public: /* Public constructor */
+    IncrementalFileStream(const bool& incremental,
+                          const std::string& ignored_line_prefix = std::string());
+    ~IncrementalFileStream();
+
+  public: /* Public mutators */
+    void open(const std::string& fname, std::ios_base::openmode mode);
+    void close();
+
+  public: /* Public accessors */
+    /* Identify if the last file closed was kept as it was */
+    bool unchanged() const;
+
+  private: /* Internal data */
+    bool incremental_;
+    std::string ignored_line_prefix_;
+    std::string fname_;
+    bool unchanged_;
+};
+
 bool valid_file_stream(std::fstream& fp);
 
 void check_file_stream(const char* fname, 
@@ -0,0 +1,73 @@
+/************************************************************************
+ * Member functions for InstancePathBuilder class
+ ***********************************************************************/
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+#include "openfpga_instance_path.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/************************************************************************
+ * Constructors
+ ***********************************************************************/
+InstancePathBuilder::InstancePathBuilder(const std::string& delimiter) {
+  delimiter_ = delimiter;
+}
+
+/************************************************************************
+ * Public Accessors
+ ***********************************************************************/
+/* Get the path, where each instance name is followed by the delimiter */
+const std::string& InstancePathBuilder::path() const {
+  return path_;
+}
+
+/* Get the number of instance names in the path */
+size_t InstancePathBuilder::depth() const {
+  return component_offsets_.size();
+}
+
+bool InstancePathBuilder::empty() const {
+  return component_offsets_.empty();
+}
+
+/************************************************************************
+ * Public Mutators
+ ***********************************************************************/
+/* Reserve the buffer, so that paths up to the given size do not reallocate memory */
+void InstancePathBuilder::reserve(const size_t& num_chars) {
+  path_.reserve(num_chars);
+}
+
+/* Go down one level in the hierarchy */
+void InstancePathBuilder::push(const std::string& instance_name) {
+  component_offsets_.push_back(path_.size());
+  path_.append(instance_name);
+  path_.append(delimiter_);
+}
+
+/* Go up one level in the hierarchy */
+void InstancePathBuilder::pop() {
+  VTR_ASSERT(false == component_offsets_.empty());
+  path_.resize(component_offsets_.back());
+  component_offsets_.pop_back();
+}
+
+/* Go up to a given level in the hierarchy */
+void InstancePathBuilder::pop_to_depth(const size_t& depth) {
+  VTR_ASSERT(depth <= component_offsets_.size());
+  if (depth == component_offsets_.size()) {
+    return;
+  }
+  path_.resize(component_offsets_[depth]);
+  component_offsets_.resize(depth);
+}
+
+void InstancePathBuilder::clear() {
+  path_.clear();
+  component_offsets_.clear();
+}
+
+} /* namespace openfpga ends */
@@ -0,0 +1,45 @@
+#ifndef OPENFPGA_INSTANCE_PATH_H
+#define OPENFPGA_INSTANCE_PATH_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <string>
+#include <vector>
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/************************************************************************
+ * This file includes a builder for hierarchical instance paths
+ * e.g., fpga_top/grid_clb_1__2_/logical_tile_clb_mode_clb__0/
+ *
+ * Writers walking through a module hierarchy push the instance name
+ * when going down one level and pop it when coming back,
+ * so that all the paths are built in the same string buffer
+ * without creating a new string for each instance.
+ * Each instance name is followed by the delimiter in the path
+ ***********************************************************************/
+class InstancePathBuilder {
+  public : /* Constructors*/
+    InstancePathBuilder(const std::string& delimiter);
+  public : /* Public Accessors */
+    const std::string& path() const;
+    size_t depth() const;
+    bool empty() const;
+  public : /* Public Mutators */
+    void reserve(const size_t& num_chars);
+    void push(const std::string& instance_name);
+    void pop();
+    void pop_to_depth(const size_t& depth);
+    void clear();
+  private: /* Internal data */
+    std::string delimiter_;
+    std::string path_;
+    /* Size of the path before each instance name is pushed */
+    std::vector<size_t> component_offsets_;
+};
+
+} /* namespace openfpga ends */
+
+#endif
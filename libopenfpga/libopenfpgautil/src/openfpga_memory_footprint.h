@@ -0,0 +1,154 @@
+#ifndef OPENFPGA_MEMORY_FOOTPRINT_H
+#define OPENFPGA_MEMORY_FOOTPRINT_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include "vtr_vector.h"
+#include "vtr_small_vector.h"
+
+/********************************************************************
+ * Function declaration
+ *
+ * These functions estimate the heap memory (in bytes) owned by 
+ * the containers of the standard library, which is used to report
+ * the approximate memory footprint of the data structures.
+ * The size of the container object itself is not included,
+ * as it is counted by the size of its owner.
+ * Nested containers are walked recursively.
+ *
+ * Note: the overhead of the nodes of associative containers
+ * is estimated for the typical implementations, e.g., libstdc++
+ *******************************************************************/
+/* namespace openfpga begins */
+namespace openfpga {
+
+template <class T>
+size_t container_footprint(const T& /*value*/) { return 0; }
+
+size_t container_footprint(const std::string& value);
+
+template <class T, class A>
+size_t container_footprint(const std::vector<T, A>& value);
+
+size_t container_footprint(const std::vector<bool>& value);
+
+template <class T, class S>
+size_t container_footprint(const vtr::small_vector<T, S>& value);
+
+template <class K, class V, class A>
+size_t container_footprint(const vtr::vector<K, V, A>& value);
+
+template <class K, class V>
+size_t container_footprint(const std::map<K, V>& value);
+
+template <class K>
+size_t container_footprint(const std::set<K>& value);
+
+template <class K, class V>
+size_t container_footprint(const std::unordered_map<K, V>& value);
+
+template <class K>
+size_t container_footprint(const std::unordered_set<K>& value);
+
+/* Red-black tree nodes carry a color and 3 pointers */
+constexpr size_t TREE_NODE_OVERHEAD = 4 * sizeof(void*);
+/* Hash nodes carry a pointer to the next node and a cached hash */
+constexpr size_t HASH_NODE_OVERHEAD = 2 * sizeof(void*);
+
+inline 
+size_t container_footprint(const std::string& value) {
+  /* Short strings are stored inside the object */
+  if (value.capacity() < sizeof(std::string)) {
+    return 0;
+  }
+  return value.capacity() + 1;
+}
+
+template <class T, class A>
+size_t container_footprint(const std::vector<T, A>& value) {
+  size_t footprint = value.capacity() * sizeof(T);
+  for (const T& elem : value) {
+    footprint += container_footprint(elem);
+  }
+  return footprint;
+}
+
+/* std::vector<bool> is packed into bits */
+inline 
+size_t container_footprint(const std::vector<bool>& value) {
+  return value.capacity() / 8;
+}
+
+/* Short vectors are stored inside the object */
+template <class T, class S>
+size_t container_footprint(const vtr::small_vector<T, S>& value) {
+  const void* begin = &value;
+  const void* end = &value + 1;
+  size_t footprint = 0;
+  if ((value.data() < begin) || (value.data() >= end)) {
+    footprint += value.capacity() * sizeof(T);
+  }
+  for (const T& elem : value) {
+    footprint += container_footprint(elem);
+  }
+  return footprint;
+}
+
+template <class K, class V, class A>
+size_t container_footprint(const vtr::vector<K, V, A>& value) {
+  size_t footprint = value.capacity() * sizeof(V);
+  for (const V& elem : value) {
+    footprint += container_footprint(elem);
+  }
+  return footprint;
+}
+
+template <class K, class V>
+size_t container_footprint(const std::map<K, V>& value) {
+  size_t footprint = value.size() * (sizeof(std::pair<const K, V>) + TREE_NODE_OVERHEAD);
+  for (const auto& elem : value) {
+    footprint += container_footprint(elem.first) + container_footprint(elem.second);
+  }
+  return footprint;
+}
+
+template <class K>
+size_t container_footprint(const std::set<K>& value) {
+  size_t footprint = value.size() * (sizeof(K) + TREE_NODE_OVERHEAD);
+  for (const K& elem : value) {
+    footprint += container_footprint(elem);
+  }
+  return footprint;
+}
+
+template <class K, class V>
+size_t container_footprint(const std::unordered_map<K, V>& value) {
+  size_t footprint = value.bucket_count() * sizeof(void*)
+                   + value.size() * (sizeof(std::pair<const K, V>) + HASH_NODE_OVERHEAD);
+  for (const auto& elem : value) {
+    footprint += container_footprint(elem.first) + container_footprint(elem.second);
+  }
+  return footprint;
+}
+
+template <class K>
+size_t container_footprint(const std::unordered_set<K>& value) {
+  size_t footprint = value.bucket_count() * sizeof(void*)
+                   + value.size() * (sizeof(K) + HASH_NODE_OVERHEAD);
+  for (const K& elem : value) {
+    footprint += container_footprint(elem);
+  }
+  return footprint;
+}
+
+} /* namespace openfpga ends */
+
+#endif
@@ -32,6 +32,14 @@ class SetupHoldAnalysis : public GraphVisitor {
             setup_visitor_.do_reset_edge(edge_id); 
             hold_visitor_.do_reset_edge(edge_id); 
         }
+        void do_reset_node_required_tags(const NodeId node_id) override { 
+            setup_visitor_.do_reset_node_required_tags(node_id); 
+            hold_visitor_.do_reset_node_required_tags(node_id); 
+        }
+        void do_reset_node_slack_tags(const NodeId node_id) override { 
+            setup_visitor_.do_reset_node_slack_tags(node_id); 
+            hold_visitor_.do_reset_node_slack_tags(node_id); 
+        }
 
         bool do_arrival_pre_traverse_node(const TimingGraph& tg, const TimingConstraints& tc, const NodeId node_id) override { 
             bool setup_unconstrained = setup_visitor_.do_arrival_pre_traverse_node(tg, tc, node_id); 
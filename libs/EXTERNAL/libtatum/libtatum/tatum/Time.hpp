@@ -4,6 +4,15 @@
 #include <array>
 #include <iosfwd>
 
+/*
+ * Each Time holds the values of TIME_VEC_WIDTH timing corners (e.g. PVT corners) in a
+ * contiguous (aligned) array, so that all the corners are analyzed together in a single
+ * traversal of the timing graph, with (compiler vectorized) SIMD operations.
+ *
+ * The first corner is the reference corner: comparisons between Times (and hence the
+ * origin nodes of tags and the reported paths) use its value, while the other corners
+ * are updated element-wise. The worst-corner value is found with min_value()/max_value().
+ */
 #ifndef TIME_VEC_WIDTH
 #define TIME_VEC_WIDTH 1
 #endif
@@ -37,9 +46,21 @@ class Time {
         explicit Time(const double time) { set_value(time); }
 
     public: //Accessors
-        ///The current time value
+        ///The number of timing corners held by a Time
+        static constexpr size_t num_corners() { return TIME_VEC_WIDTH; }
+
+        ///The current time value (of the reference corner)
         scalar_type value() const;
 
+        ///The current time value of the specified corner
+        scalar_type value(size_t corner) const;
+
+        ///The smallest value across corners (e.g. the worst-corner slack)
+        scalar_type min_value() const;
+
+        ///The largest value across corners
+        scalar_type max_value() const;
+
         ///Indicates whether the current time value is valid
         bool valid() const;
 
@@ -52,9 +73,12 @@ class Time {
         operator scalar_type() const { return value(); }
 
     public: //Mutators
-        ///Set the current time value to time
+        ///Set the current time value of all corners to time
         void set_value(scalar_type time);
 
+        ///Set the current time value of the specified corner to time
+        void set_value(size_t corner, scalar_type time);
+
 
         Time& operator+=(const Time& rhs);
         Time& operator-=(const Time& rhs);
@@ -19,17 +19,21 @@ namespace tatum {
         }
     }
 
+    inline void Time::set_value(size_t corner, scalar_type time) {
+        time_[corner] = time;
+    }
+
     inline void Time::max(const Time& other)  {
         for(size_t i = 0; i < time_.size(); i++) {
-            //Use conditional so compiler will vectorize
-            time_[i] = (time_[i] > other.time_[i]) ? time_[i] : other.time_[i];
+            //Use conditional so compiler will vectorize (same NaN handling as std::max)
+            time_[i] = (time_[i] < other.time_[i]) ? other.time_[i] : time_[i];
         }
     }
 
     inline void Time::min(const Time& other)  {
         for(size_t i = 0; i < time_.size(); i++) {
-            //Use conditional so compiler will vectorize
-            time_[i] = (time_[i] < other.time_[i]) ? time_[i] : other.time_[i];
+            //Use conditional so compiler will vectorize (same NaN handling as std::min)
+            time_[i] = (other.time_[i] < time_[i]) ? other.time_[i] : time_[i];
         }
     }
 
@@ -50,6 +54,23 @@ namespace tatum {
     }
 
     inline Time::scalar_type Time::value() const { return time_[0]; }
+    inline Time::scalar_type Time::value(size_t corner) const { return time_[corner]; }
+
+    inline Time::scalar_type Time::min_value() const {
+        scalar_type result = time_[0];
+        for(size_t i = 1; i < time_.size(); i++) {
+            result = (time_[i] < result) ? time_[i] : result;
+        }
+        return result;
+    }
+
+    inline Time::scalar_type Time::max_value() const {
+        scalar_type result = time_[0];
+        for(size_t i = 1; i < time_.size(); i++) {
+            result = (result < time_[i]) ? time_[i] : result;
+        }
+        return result;
+    }
 
     inline bool Time::valid() const {
         //This is a reduction with a function call inside,
@@ -62,7 +83,11 @@ namespace tatum {
     }
 #else //Scalar case (TIME_VEC_WIDTH == 1)
     inline Time::scalar_type Time::value() const { return time_; }
+    inline Time::scalar_type Time::value(size_t /*corner*/) const { return time_; }
+    inline Time::scalar_type Time::min_value() const { return time_; }
+    inline Time::scalar_type Time::max_value() const { return time_; }
     inline void Time::set_value(scalar_type time) { time_ = time; }
+    inline void Time::set_value(size_t /*corner*/, scalar_type time) { time_ = time; }
     inline bool Time::valid() const { return !std::isnan(time_); }
 
     inline void Time::max(const Time& other) { time_ = std::max(time_, other.time_); }
@@ -77,16 +102,26 @@ namespace tatum {
  */
 
 #if TIME_VEC_WIDTH > 1
+//Comparisons are made on the reference corner
+inline bool operator==(const Time lhs, const Time rhs) {
+    return lhs.time_ == rhs.time_;
+}
+
+inline bool operator<(const Time lhs, const Time rhs) {
+    return lhs.value() < rhs.value();
+}
+
+inline bool operator>(const Time lhs, const Time rhs) {
+    return lhs.value() > rhs.value();
+}
+
 inline Time operator-(Time in) {
-    for(size_t i = 0; i < time_.size(); i++) {
+    for(size_t i = 0; i < in.time_.size(); i++) {
         in.time_[i] = -in.time_[i];
     }
     return in;
 }
 inline Time operator+(Time in) {
-    for(size_t i = 0; i < time_.size(); i++) {
-        in.time_[i] = +in.time_[i];
-    }
     return in;
 }
 #else //Scalar case (TIME_VEC_WIDTH == 1)
@@ -94,9 +94,9 @@ void TimingReporter::report_timing_setup(std::string filename,
 void TimingReporter::report_timing_setup(std::ostream& os, 
                                          const SetupTimingAnalyzer& setup_analyzer,
                                          size_t npaths) const {
-    auto paths = path_collector_.collect_worst_setup_timing_paths(timing_graph_, setup_analyzer, npaths);
+    detail::SetupTagRetriever tag_retriever(setup_analyzer);
 
-    report_timing(os, paths);
+    report_timing(os, tag_retriever, npaths);
 }
 
 void TimingReporter::report_timing_hold(std::string filename, 
@@ -109,9 +109,9 @@ void TimingReporter::report_timing_hold(std::string filename,
 void TimingReporter::report_timing_hold(std::ostream& os, 
                                          const HoldTimingAnalyzer& hold_analyzer,
                                          size_t npaths) const {
-    auto paths = path_collector_.collect_worst_hold_timing_paths(timing_graph_, hold_analyzer, npaths);
+    detail::HoldTagRetriever tag_retriever(hold_analyzer);
 
-    report_timing(os, paths);
+    report_timing(os, tag_retriever, npaths);
 }
 
 void TimingReporter::report_skew_setup(std::string filename, 
@@ -195,16 +195,22 @@ void TimingReporter::report_unconstrained_hold(std::ostream& os,
  */
 
 void TimingReporter::report_timing(std::ostream& os,
-                                   const std::vector<TimingPath>& paths) const {
+                                   const detail::TagRetriever& tag_retriever,
+                                   size_t npaths) const {
     tatum::OsFormatGuard flag_guard(os);
 
-    os << "#Timing report of worst " << paths.size() << " path(s)\n";
+    auto endpoints = path_collector_.collect_worst_timing_path_endpoints(timing_graph_, tag_retriever, npaths);
+
+    os << "#Timing report of worst " << endpoints.size() << " path(s)\n";
     os << "# Unit scale: " << std::setprecision(0) << std::scientific << unit_scale_ << " seconds\n";
     os << "# Output precision: " << precision_ << "\n";
     os << "\n";
 
     size_t i = 0;
-    for(const auto& path : paths) {
+    for(const auto& endpoint : endpoints) {
+        //Only the path being reported is kept in memory
+        TimingPath path = path_collector_.trace_timing_path(timing_graph_, tag_retriever, endpoint);
+
         os << "#Path " << ++i << "\n";
         report_timing_path(os, path);
         os << "\n";
@@ -94,7 +94,8 @@ class TimingReporter {
         };
 
     private:
-        void report_timing(std::ostream& os, const std::vector<TimingPath>& paths) const;
+        //Reports the npaths worst paths, tracing and writing them one at a time
+        void report_timing(std::ostream& os, const detail::TagRetriever& tag_retriever, size_t npaths) const;
 
         void report_timing_path(std::ostream& os, const TimingPath& path) const;
 
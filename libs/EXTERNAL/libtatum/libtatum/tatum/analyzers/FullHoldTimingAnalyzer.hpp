@@ -2,6 +2,7 @@
 #include "tatum/graph_walkers/SerialWalker.hpp"
 #include "tatum/HoldAnalysis.hpp"
 #include "tatum/analyzers/HoldTimingAnalyzer.hpp"
+#include "tatum/analyzers/IncrementalUpdater.hpp"
 #include "tatum/base/validate_timing_graph_constraints.hpp"
 
 namespace tatum { namespace detail {
@@ -9,9 +10,10 @@ namespace tatum { namespace detail {
 /**
  * A concrete implementation of a HoldTimingAnalyzer.
  *
- * This is a full (i.e. non-incremental) analyzer, which fully
- * re-analyzes the timing graph whenever update_timing_impl() is 
- * called.
+ * This analyzer fully re-analyzes the timing graph whenever update_timing_impl()
+ * is called, unless edges were invalidated since the last update. In that case
+ * only the parts of the timing graph affected by the invalidated edges are
+ * re-analyzed (if they are small enough).
  */
 template<class GraphWalker=SerialWalker>
 class FullHoldTimingAnalyzer : public HoldTimingAnalyzer {
@@ -28,6 +30,7 @@ class FullHoldTimingAnalyzer : public HoldTimingAnalyzer {
             graph_walker_.set_profiling_data("total_analysis_sec", 0.);
             graph_walker_.set_profiling_data("analysis_sec", 0.);
             graph_walker_.set_profiling_data("num_full_updates", 0.);
+            graph_walker_.set_profiling_data("num_incr_updates", 0.);
         }
 
     protected:
@@ -38,6 +41,12 @@ class FullHoldTimingAnalyzer : public HoldTimingAnalyzer {
         virtual void update_hold_timing_impl() override {
             auto start_time = Clock::now();
 
+            if(analyzed_ && incr_updater_.has_invalidated_edges()
+               && incr_updater_.update(timing_graph_, timing_constraints_, delay_calculator_, hold_visitor_)) {
+                record_profiling_data(start_time, "num_incr_updates");
+                return;
+            }
+
             graph_walker_.do_reset(timing_graph_, hold_visitor_);
 
             graph_walker_.do_arrival_pre_traversal(timing_graph_, timing_constraints_, hold_visitor_);            
@@ -48,15 +57,15 @@ class FullHoldTimingAnalyzer : public HoldTimingAnalyzer {
 
             graph_walker_.do_update_slack(timing_graph_, delay_calculator_, hold_visitor_);
 
-            double analysis_sec = std::chrono::duration_cast<dsec>(Clock::now() - start_time).count();
+            incr_updater_.full_update_done(timing_graph_);
+            analyzed_ = true;
 
-            //Record profiling data
-            double total_analysis_sec = analysis_sec + graph_walker_.get_profiling_data("total_analysis_sec");
-            graph_walker_.set_profiling_data("total_analysis_sec", total_analysis_sec);
-            graph_walker_.set_profiling_data("analysis_sec", analysis_sec);
-            graph_walker_.set_profiling_data("num_full_updates", graph_walker_.get_profiling_data("num_full_updates") + 1);
+            record_profiling_data(start_time, "num_full_updates");
         }
 
+        void invalidate_edge_impl(const EdgeId edge) override { incr_updater_.invalidate_edge(edge); }
+        TimingGraph::node_range modified_nodes_impl() const override { return incr_updater_.modified_nodes(); }
+
         double get_profiling_data_impl(std::string key) const override { return graph_walker_.get_profiling_data(key); }
         size_t num_unconstrained_startpoints_impl() const override { return graph_walker_.num_unconstrained_startpoints(); }
         size_t num_unconstrained_endpoints_impl() const override { return graph_walker_.num_unconstrained_endpoints(); }
@@ -72,9 +81,20 @@ class FullHoldTimingAnalyzer : public HoldTimingAnalyzer {
         const DelayCalculator& delay_calculator_;
         HoldAnalysis hold_visitor_;
         GraphWalker graph_walker_;
+        IncrementalUpdater incr_updater_;
+        bool analyzed_ = false; //True once a full update has been performed
 
         typedef std::chrono::duration<double> dsec;
         typedef std::chrono::high_resolution_clock Clock;
+
+        void record_profiling_data(const Clock::time_point& start_time, const std::string& num_updates_key) {
+            double analysis_sec = std::chrono::duration_cast<dsec>(Clock::now() - start_time).count();
+
+            double total_analysis_sec = analysis_sec + graph_walker_.get_profiling_data("total_analysis_sec");
+            graph_walker_.set_profiling_data("total_analysis_sec", total_analysis_sec);
+            graph_walker_.set_profiling_data("analysis_sec", analysis_sec);
+            graph_walker_.set_profiling_data(num_updates_key, graph_walker_.get_profiling_data(num_updates_key) + 1);
+        }
 };
 
 }} //namepsace
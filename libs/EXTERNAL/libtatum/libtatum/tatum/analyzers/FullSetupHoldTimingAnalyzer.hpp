@@ -2,6 +2,7 @@
 #include "tatum/graph_walkers/SerialWalker.hpp"
 #include "tatum/SetupHoldAnalysis.hpp"
 #include "tatum/analyzers/SetupHoldTimingAnalyzer.hpp"
+#include "tatum/analyzers/IncrementalUpdater.hpp"
 #include "tatum/base/validate_timing_graph_constraints.hpp"
 
 namespace tatum { namespace detail {
@@ -9,9 +10,10 @@ namespace tatum { namespace detail {
 /**
  * A concrete implementation of a SetupHoldTimingAnalyzer.
  *
- * This is a full (i.e. non-incremental) analyzer, which fully
- * re-analyzes the timing graph whenever update_timing_impl() is 
- * called.
+ * This analyzer fully re-analyzes the timing graph whenever update_timing_impl()
+ * is called, unless edges were invalidated since the last update. In that case
+ * only the parts of the timing graph affected by the invalidated edges are
+ * re-analyzed (if they are small enough).
  */
 template<class GraphWalker=SerialWalker>
 class FullSetupHoldTimingAnalyzer : public SetupHoldTimingAnalyzer {
@@ -28,6 +30,7 @@ class FullSetupHoldTimingAnalyzer : public SetupHoldTimingAnalyzer {
             graph_walker_.set_profiling_data("total_analysis_sec", 0.);
             graph_walker_.set_profiling_data("analysis_sec", 0.);
             graph_walker_.set_profiling_data("num_full_updates", 0.);
+            graph_walker_.set_profiling_data("num_incr_updates", 0.);
         }
 
     protected:
@@ -35,6 +38,12 @@ class FullSetupHoldTimingAnalyzer : public SetupHoldTimingAnalyzer {
         virtual void update_timing_impl() override {
             auto start_time = Clock::now();
 
+            if(analyzed_ && incr_updater_.has_invalidated_edges()
+               && incr_updater_.update(timing_graph_, timing_constraints_, delay_calculator_, setup_hold_visitor_)) {
+                record_profiling_data(start_time, "num_incr_updates");
+                return;
+            }
+
             graph_walker_.do_reset(timing_graph_, setup_hold_visitor_);
 
             graph_walker_.do_arrival_pre_traversal(timing_graph_, timing_constraints_, setup_hold_visitor_);            
@@ -45,16 +54,15 @@ class FullSetupHoldTimingAnalyzer : public SetupHoldTimingAnalyzer {
 
             graph_walker_.do_update_slack(timing_graph_, delay_calculator_, setup_hold_visitor_);
 
-            double analysis_sec = std::chrono::duration_cast<dsec>(Clock::now() - start_time).count();
+            incr_updater_.full_update_done(timing_graph_);
+            analyzed_ = true;
 
-            //Record profiling data
-            double total_analysis_sec = analysis_sec + graph_walker_.get_profiling_data("total_analysis_sec");
-            graph_walker_.set_profiling_data("total_analysis_sec", total_analysis_sec);
-            graph_walker_.set_profiling_data("analysis_sec", analysis_sec);
-            graph_walker_.set_profiling_data("num_full_updates", graph_walker_.get_profiling_data("num_full_updates") + 1);
+            record_profiling_data(start_time, "num_full_updates");
         }
 
         //Update only setup timing
+        //
+        //The invalidated edges are kept, since hold timing has not been updated
         virtual void update_setup_timing_impl() override {
             auto& setup_visitor = setup_hold_visitor_.setup_visitor();
             graph_walker_.do_reset(timing_graph_, setup_visitor);
@@ -66,9 +74,13 @@ class FullSetupHoldTimingAnalyzer : public SetupHoldTimingAnalyzer {
             graph_walker_.do_required_traversal(timing_graph_, timing_constraints_, delay_calculator_, setup_visitor);            
 
             graph_walker_.do_update_slack(timing_graph_, delay_calculator_, setup_visitor);
+
+            incr_updater_.all_nodes_modified(timing_graph_);
         }
 
         //Update only hold timing
+        //
+        //The invalidated edges are kept, since setup timing has not been updated
         virtual void update_hold_timing_impl() override {
             auto& hold_visitor = setup_hold_visitor_.hold_visitor();
             graph_walker_.do_reset(timing_graph_, hold_visitor);
@@ -80,8 +92,13 @@ class FullSetupHoldTimingAnalyzer : public SetupHoldTimingAnalyzer {
             graph_walker_.do_required_traversal(timing_graph_, timing_constraints_, delay_calculator_, hold_visitor);            
 
             graph_walker_.do_update_slack(timing_graph_, delay_calculator_, hold_visitor);
+
+            incr_updater_.all_nodes_modified(timing_graph_);
         }
 
+        void invalidate_edge_impl(const EdgeId edge) override { incr_updater_.invalidate_edge(edge); }
+        TimingGraph::node_range modified_nodes_impl() const override { return incr_updater_.modified_nodes(); }
+
         double get_profiling_data_impl(std::string key) const override { return graph_walker_.get_profiling_data(key); }
         size_t num_unconstrained_startpoints_impl() const override { return graph_walker_.num_unconstrained_startpoints(); }
         size_t num_unconstrained_endpoints_impl() const override { return graph_walker_.num_unconstrained_endpoints(); }
@@ -102,9 +119,20 @@ class FullSetupHoldTimingAnalyzer : public SetupHoldTimingAnalyzer {
         const DelayCalculator& delay_calculator_;
         SetupHoldAnalysis setup_hold_visitor_;
         GraphWalker graph_walker_;
+        IncrementalUpdater incr_updater_;
+        bool analyzed_ = false; //True once a full update (of both setup and hold) has been performed
 
         typedef std::chrono::duration<double> dsec;
         typedef std::chrono::high_resolution_clock Clock;
+
+        void record_profiling_data(const Clock::time_point& start_time, const std::string& num_updates_key) {
+            double analysis_sec = std::chrono::duration_cast<dsec>(Clock::now() - start_time).count();
+
+            double total_analysis_sec = analysis_sec + graph_walker_.get_profiling_data("total_analysis_sec");
+            graph_walker_.set_profiling_data("total_analysis_sec", total_analysis_sec);
+            graph_walker_.set_profiling_data("analysis_sec", analysis_sec);
+            graph_walker_.set_profiling_data(num_updates_key, graph_walker_.get_profiling_data(num_updates_key) + 1);
+        }
 };
 
 }} //namepsace
@@ -2,6 +2,7 @@
 #include "tatum/graph_walkers/SerialWalker.hpp"
 #include "tatum/SetupAnalysis.hpp"
 #include "tatum/analyzers/SetupTimingAnalyzer.hpp"
+#include "tatum/analyzers/IncrementalUpdater.hpp"
 #include "tatum/base/validate_timing_graph_constraints.hpp"
 
 namespace tatum { namespace detail {
@@ -9,9 +10,10 @@ namespace tatum { namespace detail {
 /**
  * A concrete implementation of a SetupTimingAnalyzer.
  *
- * This is a full (i.e. non-incremental) analyzer, which fully
- * re-analyzes the timing graph whenever update_timing_impl() is 
- * called.
+ * This analyzer fully re-analyzes the timing graph whenever update_timing_impl()
+ * is called, unless edges were invalidated since the last update. In that case
+ * only the parts of the timing graph affected by the invalidated edges are
+ * re-analyzed (if they are small enough).
  */
 template<class GraphWalker=SerialWalker>
 class FullSetupTimingAnalyzer : public SetupTimingAnalyzer {
@@ -28,6 +30,7 @@ class FullSetupTimingAnalyzer : public SetupTimingAnalyzer {
             graph_walker_.set_profiling_data("total_analysis_sec", 0.);
             graph_walker_.set_profiling_data("analysis_sec", 0.);
             graph_walker_.set_profiling_data("num_full_updates", 0.);
+            graph_walker_.set_profiling_data("num_incr_updates", 0.);
         }
 
     protected:
@@ -38,6 +41,12 @@ class FullSetupTimingAnalyzer : public SetupTimingAnalyzer {
         virtual void update_setup_timing_impl() override {
             auto start_time = Clock::now();
 
+            if(analyzed_ && incr_updater_.has_invalidated_edges()
+               && incr_updater_.update(timing_graph_, timing_constraints_, delay_calculator_, setup_visitor_)) {
+                record_profiling_data(start_time, "num_incr_updates");
+                return;
+            }
+
             graph_walker_.do_reset(timing_graph_, setup_visitor_);
 
             graph_walker_.do_arrival_pre_traversal(timing_graph_, timing_constraints_, setup_visitor_);            
@@ -48,16 +57,15 @@ class FullSetupTimingAnalyzer : public SetupTimingAnalyzer {
 
             graph_walker_.do_update_slack(timing_graph_, delay_calculator_, setup_visitor_);
 
-            double analysis_sec = std::chrono::duration_cast<dsec>(Clock::now() - start_time).count();
+            incr_updater_.full_update_done(timing_graph_);
+            analyzed_ = true;
 
-            //Record profiling data
-            double total_analysis_sec = analysis_sec + graph_walker_.get_profiling_data("total_analysis_sec");
-            graph_walker_.set_profiling_data("total_analysis_sec", total_analysis_sec);
-            graph_walker_.set_profiling_data("analysis_sec", analysis_sec);
-            graph_walker_.set_profiling_data("num_full_updates", graph_walker_.get_profiling_data("num_full_updates") + 1);
+            record_profiling_data(start_time, "num_full_updates");
         }
 
         //TimingAnalyzer
+        void invalidate_edge_impl(const EdgeId edge) override { incr_updater_.invalidate_edge(edge); }
+        TimingGraph::node_range modified_nodes_impl() const override { return incr_updater_.modified_nodes(); }
         double get_profiling_data_impl(std::string key) const override { return graph_walker_.get_profiling_data(key); }
         size_t num_unconstrained_startpoints_impl() const override { return graph_walker_.num_unconstrained_startpoints(); }
         size_t num_unconstrained_endpoints_impl() const override { return graph_walker_.num_unconstrained_endpoints(); }
@@ -75,10 +83,21 @@ class FullSetupTimingAnalyzer : public SetupTimingAnalyzer {
         const DelayCalculator& delay_calculator_;
         SetupAnalysis setup_visitor_;
         GraphWalker graph_walker_;
+        IncrementalUpdater incr_updater_;
+        bool analyzed_ = false; //True once a full update has been performed
 
 
         typedef std::chrono::duration<double> dsec;
         typedef std::chrono::high_resolution_clock Clock;
+
+        void record_profiling_data(const Clock::time_point& start_time, const std::string& num_updates_key) {
+            double analysis_sec = std::chrono::duration_cast<dsec>(Clock::now() - start_time).count();
+
+            double total_analysis_sec = analysis_sec + graph_walker_.get_profiling_data("total_analysis_sec");
+            graph_walker_.set_profiling_data("total_analysis_sec", total_analysis_sec);
+            graph_walker_.set_profiling_data("analysis_sec", analysis_sec);
+            graph_walker_.set_profiling_data(num_updates_key, graph_walker_.get_profiling_data(num_updates_key) + 1);
+        }
 };
 
 }} //namepsace
@@ -0,0 +1,207 @@
+#pragma once
+#include <algorithm>
+#include <vector>
+
+#include "tatum/TimingGraph.hpp"
+#include "tatum/TimingConstraints.hpp"
+#include "tatum/delay_calc/DelayCalculator.hpp"
+#include "tatum/graph_visitors/GraphVisitor.hpp"
+
+namespace tatum { namespace detail {
+
+/**
+ * IncrementalUpdater re-analyzes only the parts of the timing graph affected by
+ * the edges invalidated (i.e. whose delays changed) since the last update.
+ *
+ * Changing the delay of an edge (src -> sink) changes:
+ *   - the arrival times of the fanout cone of sink (including the required times
+ *     of the SINK nodes in it, which are derived from the clock arrival times),
+ *   - the required times of the fanin cone of src and of the nodes above,
+ *   - the slacks of all the nodes above and of their incoming edges.
+ *
+ * The affected nodes are re-analyzed from their (unchanged) neighbours in the same
+ * order as a full analysis, so the results are identical to a full update.
+ *
+ * If too many nodes are affected the update is abandoned, since a full (levelized) update
+ * is then faster.
+ */
+class IncrementalUpdater {
+    public:
+        ///Marks an edge as invalidated
+        void invalidate_edge(const EdgeId edge) {
+            invalidated_edges_.push_back(edge);
+        }
+
+        ///\returns True if edges were invalidated since the last update
+        bool has_invalidated_edges() const { return !invalidated_edges_.empty(); }
+
+        ///Incrementally updates the nodes affected by the invalidated edges.
+        ///\pre A full update has been performed with visitor, and only the invalidated edges changed since
+        ///\returns False if too many nodes are affected. In that case the tags are unchanged, and a full update is required
+        bool update(const TimingGraph& tg, const TimingConstraints& tc, const DelayCalculator& dc, GraphVisitor& visitor) {
+            if(node_levels_.size() != tg.nodes().size()) {
+                init_node_levels(tg);
+            }
+
+            size_t max_affected_nodes = MAX_AFFECTED_NODE_FRACTION * tg.nodes().size();
+
+            //Collect the nodes whose arrival times changed (the fanout cone of the invalidated edges)
+            arrival_nodes_.clear();
+            for(EdgeId edge : invalidated_edges_) {
+                add_arrival_node(tg.edge_sink_node(edge));
+            }
+            for(size_t i = 0; i < arrival_nodes_.size() && arrival_nodes_.size() <= max_affected_nodes; ++i) {
+                for(EdgeId edge : tg.node_out_edges(arrival_nodes_[i])) {
+                    add_arrival_node(tg.edge_sink_node(edge));
+                }
+            }
+
+            //Collect the nodes whose required times changed (the fanin cone of the nodes above
+            //and of the invalidated edges)
+            required_nodes_ = arrival_nodes_;
+            for(NodeId node : arrival_nodes_) {
+                required_marks_[size_t(node)] = true;
+            }
+            for(EdgeId edge : invalidated_edges_) {
+                add_required_node(tg.edge_src_node(edge));
+            }
+            for(size_t i = 0; i < required_nodes_.size() && required_nodes_.size() <= max_affected_nodes; ++i) {
+                NodeId node = required_nodes_[i];
+
+                //Required times are not propagated through the clock network
+                if(tg.node_type(node) == NodeType::CPIN) continue;
+
+                for(EdgeId edge : tg.node_in_edges(node)) {
+                    add_required_node(tg.edge_src_node(edge));
+                }
+            }
+
+            bool updated = false;
+            if(required_nodes_.size() <= max_affected_nodes) {
+                update_nodes(tg, tc, dc, visitor);
+                updated = true;
+            }
+
+            for(NodeId node : arrival_nodes_) {
+                arrival_marks_[size_t(node)] = false;
+            }
+            for(NodeId node : required_nodes_) {
+                required_marks_[size_t(node)] = false;
+            }
+
+            if(updated) {
+                invalidated_edges_.clear();
+
+                //The required nodes include the arrival nodes
+                modified_nodes_ = required_nodes_;
+            }
+            return updated;
+        }
+
+        ///Records that a full update has been performed: all nodes may have been modified
+        void full_update_done(const TimingGraph& tg) {
+            invalidated_edges_.clear();
+            all_nodes_modified(tg);
+        }
+
+        ///Records that all nodes may have been modified (e.g. by a full update of only some of the analyses),
+        ///without clearing the invalidated edges
+        void all_nodes_modified(const TimingGraph& tg) {
+            modified_nodes_.assign(tg.nodes().begin(), tg.nodes().end());
+        }
+
+        ///\returns The nodes modified by the last update
+        TimingGraph::node_range modified_nodes() const {
+            return tatum::util::make_range(modified_nodes_.begin(), modified_nodes_.end());
+        }
+
+    private:
+        void init_node_levels(const TimingGraph& tg) {
+            node_levels_.resize(tg.nodes().size());
+            for(LevelId level : tg.levels()) {
+                for(NodeId node : tg.level_nodes(level)) {
+                    node_levels_[size_t(node)] = size_t(level);
+                }
+            }
+
+            arrival_marks_.assign(tg.nodes().size(), false);
+            required_marks_.assign(tg.nodes().size(), false);
+        }
+
+        void add_arrival_node(const NodeId node) {
+            if(arrival_marks_[size_t(node)]) return;
+
+            arrival_marks_[size_t(node)] = true;
+            arrival_nodes_.push_back(node);
+        }
+
+        void add_required_node(const NodeId node) {
+            if(required_marks_[size_t(node)]) return;
+
+            required_marks_[size_t(node)] = true;
+            required_nodes_.push_back(node);
+        }
+
+        void update_nodes(const TimingGraph& tg, const TimingConstraints& tc, const DelayCalculator& dc, GraphVisitor& visitor) {
+            //Walk the nodes in the same (levelized) order as a full analysis
+            std::sort(arrival_nodes_.begin(), arrival_nodes_.end(),
+                [&](const NodeId lhs, const NodeId rhs) {
+                    return node_levels_[size_t(lhs)] < node_levels_[size_t(rhs)];
+                });
+            std::sort(required_nodes_.begin(), required_nodes_.end(),
+                [&](const NodeId lhs, const NodeId rhs) {
+                    return node_levels_[size_t(lhs)] > node_levels_[size_t(rhs)];
+                });
+
+            //Reset the modified tags
+            for(NodeId node : arrival_nodes_) {
+                visitor.do_reset_node(node);
+            }
+            for(NodeId node : required_nodes_) {
+                if(arrival_marks_[size_t(node)]) continue; //Already reset
+
+                //The required times of sinks are derived from their arrival times, which are unchanged
+                if(tg.node_type(node) != NodeType::SINK) {
+                    visitor.do_reset_node_required_tags(node);
+                }
+                visitor.do_reset_node_slack_tags(node);
+            }
+            for(NodeId node : required_nodes_) {
+                for(EdgeId edge : tg.node_in_edges(node)) {
+                    visitor.do_reset_edge(edge);
+                }
+            }
+
+            //Re-calculate them
+            for(NodeId node : arrival_nodes_) {
+                if(node_levels_[size_t(node)] == 0) {
+                    //Logical inputs (e.g. with disabled input edges) are initialized by the pre-traversal
+                    visitor.do_arrival_pre_traverse_node(tg, tc, node);
+                }
+                visitor.do_arrival_traverse_node(tg, tc, dc, node);
+            }
+            for(NodeId node : required_nodes_) {
+                visitor.do_required_traverse_node(tg, tc, dc, node);
+            }
+            for(NodeId node : required_nodes_) {
+                visitor.do_slack_traverse_node(tg, dc, node);
+            }
+        }
+
+    private:
+        //Above this fraction of affected nodes a full update is performed instead
+        static constexpr float MAX_AFFECTED_NODE_FRACTION = 0.25;
+
+        std::vector<EdgeId> invalidated_edges_;
+
+        std::vector<size_t> node_levels_;
+
+        std::vector<NodeId> arrival_nodes_;
+        std::vector<NodeId> required_nodes_;
+        std::vector<bool> arrival_marks_;
+        std::vector<bool> required_marks_;
+
+        std::vector<NodeId> modified_nodes_;
+};
+
+}} //namespace
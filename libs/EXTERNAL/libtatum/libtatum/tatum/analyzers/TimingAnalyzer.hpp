@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include "tatum/TimingGraph.hpp"
 
 namespace tatum {
 
@@ -8,6 +9,8 @@ namespace tatum {
  * which can be:
  *   - updated (update_timing())
  *   - reset (reset_timing()).
+ *   - incrementally updated, by invalidating the edges whose delays changed
+ *     (invalidate_edge()) before calling update_timing().
  *
  * This is the most abstract interface provided (it does not allow access
  * to any calculated data).  As a result this interface is suitable for
@@ -28,6 +31,16 @@ class TimingAnalyzer {
         ///Perform timing analysis to update timing information (i.e. arrival & required times)
         void update_timing() { update_timing_impl(); }
 
+        ///Marks the delay of an edge as changed since the last update.
+        ///The next update_timing() may then only re-analyze the parts of the timing graph
+        ///affected by the invalidated edges.
+        ///
+        ///Note that if no edges are invalidated the next update_timing() re-analyzes the whole timing graph
+        void invalidate_edge(const EdgeId edge) { invalidate_edge_impl(edge); }
+
+        ///\returns The nodes whose tags (arrival/required times or slacks) may have changed during the last update_timing()
+        TimingGraph::node_range modified_nodes() const { return modified_nodes_impl(); }
+
         double get_profiling_data(std::string key) const { return get_profiling_data_impl(key); }
 
         virtual size_t num_unconstrained_startpoints() const { return num_unconstrained_startpoints_impl(); }
@@ -36,6 +49,10 @@ class TimingAnalyzer {
     protected:
         virtual void update_timing_impl() = 0;
 
+        virtual void invalidate_edge_impl(const EdgeId edge) = 0;
+
+        virtual TimingGraph::node_range modified_nodes_impl() const = 0;
+
         virtual double get_profiling_data_impl(std::string key) const = 0;
 
         virtual size_t num_unconstrained_startpoints_impl() const = 0;
@@ -33,6 +33,8 @@ class CommonAnalysisVisitor : public GraphVisitor {
 
         void do_reset_node(const NodeId node_id) override { ops_.reset_node(node_id); }
         void do_reset_edge(const EdgeId edge_id) override { ops_.reset_edge(edge_id); }
+        void do_reset_node_required_tags(const NodeId node_id) override { ops_.reset_node_required_tags(node_id); }
+        void do_reset_node_slack_tags(const NodeId node_id) override { ops_.reset_node_slack_tags(node_id); }
 
         bool do_arrival_pre_traverse_node(const TimingGraph& tg, const TimingConstraints& tc, const NodeId node_id) override;
 
@@ -11,6 +11,10 @@ class GraphVisitor {
         virtual void do_reset_node(const NodeId node_id) = 0;
         virtual void do_reset_edge(const EdgeId edge_id) = 0;
 
+        //Partial resets of a node, used by incremental updates
+        virtual void do_reset_node_required_tags(const NodeId node_id) = 0;
+        virtual void do_reset_node_slack_tags(const NodeId node_id) = 0;
+
         virtual bool do_arrival_pre_traverse_node(const TimingGraph& tg, const TimingConstraints& tc, const NodeId node_id) = 0;
         virtual bool do_required_pre_traverse_node(const TimingGraph& tg, const TimingConstraints& tc, const NodeId node_id) = 0;
 
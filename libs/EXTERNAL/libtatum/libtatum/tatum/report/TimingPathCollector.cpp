@@ -4,54 +4,66 @@
 #include "tatum/report/TimingReportTagRetriever.hpp"
 #include "tatum/report/timing_path_tracing.hpp"
 #include <map>
+#include <queue>
 
 namespace tatum {
 
 namespace detail {
+std::vector<TimingPathEndpoint> collect_worst_timing_path_endpoints(const TimingGraph& timing_graph, const detail::TagRetriever& tag_retriever, size_t npaths);
 std::vector<TimingPath> collect_worst_timing_paths(const TimingGraph& timing_graph, const detail::TagRetriever& tag_retriever, size_t npaths);
 std::vector<SkewPath> collect_worst_skew_paths(const TimingGraph& timing_graph, const TimingConstraints& timing_constraings,
                                               const detail::TagRetriever& tag_retriever, TimingType timing_type, size_t npaths);
 
-std::vector<TimingPath> collect_worst_timing_paths(const TimingGraph& timing_graph, const detail::TagRetriever& tag_retriever, size_t npaths) {
-    std::vector<TimingPath> paths;
+std::vector<TimingPathEndpoint> collect_worst_timing_path_endpoints(const TimingGraph& timing_graph, const detail::TagRetriever& tag_retriever, size_t npaths) {
+    //At least one path is reported
+    npaths = std::max<size_t>(npaths, 1);
 
     struct TagNode {
-        TagNode(TimingTag t, NodeId n) noexcept
-            : tag(t), node(n) {}
-
-        TimingTag tag;
-        NodeId node;
-
+        TimingPathEndpoint endpoint;
+        size_t index; //Order in which the slacks are found, to break ties deterministically
     };
 
-    std::vector<TagNode> tags_and_sinks;
+    //Ascending slack order so most negative slacks are first
+    auto ascending_slack_order = [](const TagNode& lhs, const TagNode& rhs) {
+        if(lhs.endpoint.tag.time() < rhs.endpoint.tag.time()) return true;
+        if(rhs.endpoint.tag.time() < lhs.endpoint.tag.time()) return false;
+        return lhs.index < rhs.index;
+    };
 
-    //Add the slacks of all sink
+    //Keep the npaths worst end-points, with the best of them at the top of the heap
+    std::priority_queue<TagNode, std::vector<TagNode>, decltype(ascending_slack_order)> worst_tags_and_sinks(ascending_slack_order);
+    size_t index = 0;
     for(NodeId node : timing_graph.logical_outputs()) {
         for(TimingTag tag : tag_retriever.slacks(node)) {
-            tags_and_sinks.emplace_back(tag,node);
+            TagNode tag_node = {{node, tag}, index++};
+
+            if(worst_tags_and_sinks.size() < npaths) {
+                worst_tags_and_sinks.push(tag_node);
+            } else if(ascending_slack_order(tag_node, worst_tags_and_sinks.top())) {
+                worst_tags_and_sinks.pop();
+                worst_tags_and_sinks.push(tag_node);
+            }
         }
     }
 
-    //Sort in ascending slack order so most negative slacks are first
-    auto ascending_slack_order = [](const TagNode& lhs, const TagNode& rhs) {
-        return lhs.tag.time() < rhs.tag.time();
-    };
-    std::sort(tags_and_sinks.begin(), tags_and_sinks.end(), ascending_slack_order);
+    //The heap pops from best to worst slack
+    std::vector<TimingPathEndpoint> endpoints(worst_tags_and_sinks.size());
+    for(auto iter = endpoints.rbegin(); iter != endpoints.rend(); ++iter) {
+        *iter = worst_tags_and_sinks.top().endpoint;
+        worst_tags_and_sinks.pop();
+    }
 
+    return endpoints;
+}
 
-    //Trace the paths for each tag/node pair
-    // The the map will sort the nodes and tags from worst to best slack (i.e. ascending slack order),
-    // so the first pair is the most critical end-point
-    for(const auto& tag_node : tags_and_sinks) {
-        NodeId sink_node = tag_node.node;
-        TimingTag sink_tag = tag_node.tag;
+std::vector<TimingPath> collect_worst_timing_paths(const TimingGraph& timing_graph, const detail::TagRetriever& tag_retriever, size_t npaths) {
+    std::vector<TimingPath> paths;
 
-        TimingPath path = detail::trace_path(timing_graph, tag_retriever, sink_tag.launch_clock_domain(), sink_tag.capture_clock_domain(), sink_node); 
+    //Trace the paths for each end-point, the first one is the most critical
+    for(const auto& endpoint : collect_worst_timing_path_endpoints(timing_graph, tag_retriever, npaths)) {
+        TimingPath path = detail::trace_path(timing_graph, tag_retriever, endpoint.tag.launch_clock_domain(), endpoint.tag.capture_clock_domain(), endpoint.node); 
 
         paths.push_back(path);
-
-        if(paths.size() >= npaths) break;
     }
 
     return paths;
@@ -176,6 +188,14 @@ std::vector<TimingPath> TimingPathCollector::collect_worst_hold_timing_paths(con
     return collect_worst_timing_paths(timing_graph, tag_retriever, npaths);
 }
 
+std::vector<TimingPathEndpoint> TimingPathCollector::collect_worst_timing_path_endpoints(const TimingGraph& timing_graph, const detail::TagRetriever& tag_retriever, size_t npaths) const {
+    return detail::collect_worst_timing_path_endpoints(timing_graph, tag_retriever, npaths);
+}
+
+TimingPath TimingPathCollector::trace_timing_path(const TimingGraph& timing_graph, const detail::TagRetriever& tag_retriever, const TimingPathEndpoint& endpoint) const {
+    return detail::trace_path(timing_graph, tag_retriever, endpoint.tag.launch_clock_domain(), endpoint.tag.capture_clock_domain(), endpoint.node);
+}
+
 std::vector<SkewPath> TimingPathCollector::collect_worst_setup_skew_paths(const TimingGraph& timing_graph, const TimingConstraints& timing_constraints, const tatum::SetupTimingAnalyzer& setup_analyzer, size_t npaths) const {
     detail::SetupTagRetriever tag_retriever(setup_analyzer);
     return collect_worst_skew_paths(timing_graph, timing_constraints, tag_retriever, TimingType::SETUP, npaths);
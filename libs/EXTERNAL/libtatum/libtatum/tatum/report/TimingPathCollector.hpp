@@ -3,14 +3,28 @@
 #include "tatum/timing_analyzers_fwd.hpp"
 #include "TimingPath.hpp"
 #include "SkewPath.hpp"
+#include "TimingReportTagRetriever.hpp"
 
 namespace tatum {
 
+    //The end-point of a timing path: a logical output of the timing graph and one of its slack tags
+    struct TimingPathEndpoint {
+        NodeId node;
+        TimingTag tag;
+    };
+
     class TimingPathCollector {
         public:
             std::vector<TimingPath> collect_worst_setup_timing_paths(const TimingGraph& timing_graph, const tatum::SetupTimingAnalyzer& setup_analyzer, size_t npaths) const;
             std::vector<TimingPath> collect_worst_hold_timing_paths(const TimingGraph& timing_graph, const tatum::HoldTimingAnalyzer& hold_analyzer, size_t npaths) const;
 
+            //Returns the end-points of the npaths worst timing paths, in ascending slack order.
+            //
+            //Only the end-points are kept (in a bounded heap), so their paths can be traced with
+            //trace_timing_path() and reported one at a time, instead of holding all the paths in memory
+            std::vector<TimingPathEndpoint> collect_worst_timing_path_endpoints(const TimingGraph& timing_graph, const detail::TagRetriever& tag_retriever, size_t npaths) const;
+            TimingPath trace_timing_path(const TimingGraph& timing_graph, const detail::TagRetriever& tag_retriever, const TimingPathEndpoint& endpoint) const;
+
             std::vector<SkewPath> collect_worst_setup_skew_paths(const TimingGraph& timing_graph, const TimingConstraints& timing_constraints, const tatum::SetupTimingAnalyzer& setup_analyzer, size_t npaths) const;
             std::vector<SkewPath> collect_worst_hold_skew_paths(const TimingGraph& timing_graph, const TimingConstraints& timing_constraints, const tatum::HoldTimingAnalyzer& hold_analyzer, size_t npaths) const;
     };
@@ -65,7 +65,17 @@ inline void TimingTag::max(const Time& new_time, const NodeId origin, const Timi
         //New value is smaller, or no previous valid value existed
         //Update min
         
+#if TIME_VEC_WIDTH > 1
+        //The other corners keep their larger values
+        Time max_time = new_time;
+        if(time().valid()) max_time.max(time());
+
+        update(max_time, origin, base_tag);
+    } else {
+        time_.max(new_time);
+#else
         update(new_time, origin, base_tag);
+#endif
     }
 }
 
@@ -74,7 +84,17 @@ inline void TimingTag::min(const Time& new_time, const NodeId origin, const Timi
     if(!time().valid() || new_time < time()) {
         //New value is smaller, or no previous valid value existed
         //Update min
+#if TIME_VEC_WIDTH > 1
+        //The other corners keep their smaller values
+        Time min_time = new_time;
+        if(time().valid()) min_time.min(time());
+
+        update(min_time, origin, base_tag);
+    } else {
+        time_.min(new_time);
+#else
         update(new_time, origin, base_tag);
+#endif
     }
 }
 
@@ -91,6 +91,9 @@ class TimingTags {
         ///Clears the tags in the current set
         void clear();
 
+        ///Clears the tags of the specified type in the current set (other tags are unchanged)
+        void clear(TagType type);
+
     public:
 
         //Iterator definition
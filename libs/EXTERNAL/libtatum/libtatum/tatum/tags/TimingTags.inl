@@ -194,6 +194,37 @@ inline void TimingTags::clear() {
     num_data_required_tags_ = 0;
 }
 
+inline void TimingTags::clear(TagType type) {
+    size_t first = begin(type) - begin();
+    size_t last = end(type) - begin();
+    size_t num_cleared = last - first;
+    if(num_cleared == 0) return;
+
+    //Shift the following tags down
+    std::copy(tags_.get() + last, tags_.get() + size_, tags_.get() + first);
+    size_ -= num_cleared;
+
+    switch(type) {
+        case TagType::CLOCK_LAUNCH:
+            num_clock_launch_tags_ = 0;
+            break;
+        case TagType::CLOCK_CAPTURE:
+            num_clock_capture_tags_ = 0;
+            break;
+        case TagType::DATA_ARRIVAL:
+            num_data_arrival_tags_ = 0;
+            break;
+        case TagType::DATA_REQUIRED:
+            num_data_required_tags_ = 0;
+            break;
+        case TagType::SLACK:
+            //Slack tags are the remaining tags
+            break;
+        default:
+            TATUM_ASSERT_MSG(false, "Invalid tag type");
+    }
+}
+
 inline std::pair<bool,TimingTags::iterator> TimingTags::find_matching_tag(const TimingTag& tag, bool arr_must_be_valid) {
     if(arr_must_be_valid) {
         TATUM_ASSERT(tag.type() == TagType::DATA_REQUIRED);
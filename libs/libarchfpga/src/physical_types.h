@@ -796,6 +796,9 @@ struct t_pb_type {
     t_pb_type_power* pb_type_power = nullptr;
 
     t_metadata_dict meta;
+
+    /* Dense index of the pb_type among all the pb_types of the device, assigned by OpenFPGA to store its annotations */
+    int annotation_index = -1;
 };
 
 /** Describes an operational mode of a clustered logic block
@@ -867,6 +870,9 @@ struct t_interconnect {
 
     t_interconnect_power* interconnect_power = nullptr;
     t_metadata_dict meta;
+
+    /* Dense index of the interconnect among all the interconnects of the device, assigned by OpenFPGA to store its annotations */
+    int annotation_index = -1;
 };
 
 /** Describes I/O and clock ports
@@ -904,6 +910,9 @@ struct t_port {
     int absolute_first_pin_index;
 
     t_port_power* port_power;
+
+    /* Dense index of the port among all the ports of the device, assigned by OpenFPGA to store its annotations */
+    int annotation_index;
 };
 
 struct t_pb_type_power {
@@ -1061,6 +1070,9 @@ class t_pb_graph_node {
     t_pb_graph_node_power* pb_node_power;
     t_interconnect_pins** interconnect_pins; /* [0..num_modes-1][0..num_interconnect_in_mode] */
 
+    /* Dense index of the node among all the pb_graph_nodes of the device, assigned by OpenFPGA to store its annotations */
+    int annotation_index;
+
     // Returns true if this pb_graph_node represents a primitive type (primitives have 0 modes)
     bool is_primitive() const { return this->pb_type->num_modes == 0; }
 
@@ -1141,6 +1153,9 @@ class t_pb_graph_pin {
 
     t_pb_graph_pin_power* pin_power = nullptr;
 
+    /* Dense index of the pin among all the pb_graph_pins of the device, assigned by OpenFPGA to store its annotations */
+    int annotation_index = -1;
+
     // class member functions
   public:
     // Returns true if this pin belongs to a primitive block like
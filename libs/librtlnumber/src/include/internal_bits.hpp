@@ -298,6 +298,122 @@ namespace BitSpace {
         }
     }
 
+    /***
+     * 2-state fast path
+     * A bitstring without x or z is processed as 64-bit words, the bit at address i being
+     * the bit (i % 64) of the word (i / 64), so that the arithmetic uses native operations.
+     * The bits of the last word beyond the size of the bitstring are kept cleared.
+     */
+    typedef uint64_t two_state_word_t;
+
+    constexpr size_t two_state_word_size = 64;
+
+    inline static size_t two_state_word_count(size_t bit_size)
+    {
+        return (bit_size + two_state_word_size - 1) / two_state_word_size;
+    }
+
+    /**
+     * pack the low bits of the 2-bit values of a bitfield, i.e. the values of its 2-state bits, into a byte
+     */
+    inline static two_state_word_t pack_two_state_bits(veri_internal_bits_t bits)
+    {
+        static_assert(sizeof(veri_internal_bits_t) == 2, "the 2-state packing expects 8 verilog bits per bitfield");
+
+        two_state_word_t value = static_cast<two_state_word_t>(bits) & 0x5555UL;
+        value = (value | (value >> 1)) & 0x3333UL;
+        value = (value | (value >> 2)) & 0x0F0FUL;
+        value = (value | (value >> 4)) & 0x00FFUL;
+        return value;
+    }
+
+    /**
+     * unpack a byte of 2-state bits into the 2-bit values of a bitfield
+     */
+    inline static veri_internal_bits_t unpack_two_state_bits(two_state_word_t value)
+    {
+        value &= 0x00FFUL;
+        value = (value | (value << 4)) & 0x0F0FUL;
+        value = (value | (value << 2)) & 0x3333UL;
+        value = (value | (value << 1)) & 0x5555UL;
+        return static_cast<veri_internal_bits_t>(value);
+    }
+
+    inline static void mask_two_state_words(std::vector<two_state_word_t>& words, size_t bit_size)
+    {
+        words.resize(two_state_word_count(bit_size), 0);
+
+        size_t last_bits = bit_size % two_state_word_size;
+        if(last_bits)
+            words.back() &= ((static_cast<two_state_word_t>(1) << last_bits) - 1);
+    }
+
+    /**
+     * a += b + carry_in over the words of a, b being padded with zeros
+     * returns the carry out
+     */
+    inline static two_state_word_t add_two_state_words(std::vector<two_state_word_t>& a, const std::vector<two_state_word_t>& b, two_state_word_t carry_in)
+    {
+        two_state_word_t carry = carry_in;
+        for(size_t i=0; i < a.size(); i++)
+        {
+            two_state_word_t addend = (i < b.size())? b[i]: 0;
+            two_state_word_t sum = a[i] + addend;
+            two_state_word_t carry_out = (sum < a[i])? 1: 0;
+            a[i] = sum + carry;
+            carry_out |= (a[i] < sum)? 1: 0;
+            carry = carry_out;
+        }
+        return carry;
+    }
+
+    /**
+     * shift the bits towards the msb, the lowest bits being zeros
+     */
+    inline static std::vector<two_state_word_t> shift_left_two_state_words(const std::vector<two_state_word_t>& words, size_t shift, size_t new_size)
+    {
+        std::vector<two_state_word_t> result(two_state_word_count(new_size), 0);
+        size_t word_shift = shift / two_state_word_size;
+        size_t bit_shift = shift % two_state_word_size;
+
+        for(size_t i=word_shift; i < result.size(); i++)
+        {
+            size_t src = i - word_shift;
+            if(src < words.size())
+                result[i] = words[src] << bit_shift;
+            if(bit_shift && src >= 1 && src - 1 < words.size())
+                result[i] |= words[src - 1] >> (two_state_word_size - bit_shift);
+        }
+
+        mask_two_state_words(result, new_size);
+        return result;
+    }
+
+    /**
+     * shift the bits towards the lsb, the highest bits being filled with the given word (all zeros or all ones)
+     * the bits of the last word beyond the bitstring are expected to be filled the same way,
+     * i.e. the words are expected to hold a multiple of 64 bits
+     */
+    inline static std::vector<two_state_word_t> shift_right_two_state_words(const std::vector<two_state_word_t>& words, size_t shift, size_t new_size, two_state_word_t fill)
+    {
+        std::vector<two_state_word_t> result(two_state_word_count(new_size), 0);
+        size_t word_shift = shift / two_state_word_size;
+        size_t bit_shift = shift % two_state_word_size;
+
+        for(size_t i=0; i < result.size(); i++)
+        {
+            size_t src = i + word_shift;
+            two_state_word_t low = (src < words.size())? words[src]: fill;
+            two_state_word_t high = (src + 1 < words.size())? words[src + 1]: fill;
+            result[i] = low >> bit_shift;
+            if(bit_shift)
+                result[i] |= high << (two_state_word_size - bit_shift);
+        }
+
+        mask_two_state_words(result, new_size);
+        return result;
+    }
+
     template<typename T>
     class BitFields
     {
@@ -335,6 +451,16 @@ namespace BitSpace {
             return static_cast<bit_value_t>(result);
         }
 
+        T get_bits()
+        {
+            return this->bits;
+        }
+
+        void set_bits(T value)
+        {
+            this->bits = value;
+        }
+
         template<typename Addr_t>
         void set_bit(Addr_t address, bit_value_t value)
         {	
@@ -396,6 +522,19 @@ namespace BitSpace {
             return this->bits.size();
         }
 
+        /**
+         * mask of the 2-bit values of a bitfield which are in the bitstring
+         */
+        veri_internal_bits_t get_bitfield_mask(size_t index)
+        {
+            size_t first_address = index * BitFields<veri_internal_bits_t>::size();
+            if(first_address + BitFields<veri_internal_bits_t>::size() <= this->bit_size)
+                return _All_z;
+
+            size_t valid_bits = (first_address < this->bit_size)? (this->bit_size - first_address): 0;
+            return static_cast<veri_internal_bits_t>((1UL << (valid_bits << 1)) - 1);
+        }
+
     public:
 
         VerilogBits()
@@ -417,6 +556,29 @@ namespace BitSpace {
             }
         }
 
+        /**
+         * build a bitstring from 2-state words
+         */
+        VerilogBits(const std::vector<two_state_word_t>& words, size_t data_size)
+        {
+            this->bit_size = data_size;
+            this->bits = std::vector<BitSpace::BitFields<veri_internal_bits_t>>();
+
+            size_t bitfield_count = (this->bit_size / BitFields<veri_internal_bits_t>::size()) +1;
+            this->bits.reserve(bitfield_count);
+
+            for(size_t i=0; i<bitfield_count; i++)
+            {
+                size_t address = i * BitFields<veri_internal_bits_t>::size();
+                size_t word_index = address / two_state_word_size;
+                two_state_word_t value = (word_index < words.size())? (words[word_index] >> (address % two_state_word_size)): 0;
+
+                BitSpace::BitFields<veri_internal_bits_t> field(_0);
+                field.set_bits(unpack_two_state_bits(value));
+                this->bits.push_back(field);
+            }
+        }
+
         VerilogBits(VerilogBits *other)
         {
             this->bit_size = other->size();
@@ -504,11 +666,15 @@ namespace BitSpace {
             return to_return;              
         }
 
+        /**
+         * the bits are checked a bitfield at a time:
+         * x (10) and z (11) have their high bit set, 1 (01) only has its low bit set
+         */
         bool has_unknowns()
         {
-            for(size_t address=0x0; address < this->size(); address++)
+            for(size_t i=0; i < this->list_size(); i++)
             {
-                if(is_unk[this->get_bit(address)])
+                if(this->bits[i].get_bits() & _All_x & this->get_bitfield_mask(i))
                     return true;                
             }
             
@@ -517,9 +683,10 @@ namespace BitSpace {
 
         bool is_only_z()
         {
-            for(size_t address=0x0; address < this->size(); address++)
+            for(size_t i=0; i < this->list_size(); i++)
             {
-                if(! is_z_bit[this->get_bit(address)])
+                veri_internal_bits_t mask = this->get_bitfield_mask(i);
+                if((this->bits[i].get_bits() & mask) != (_All_z & mask))
                     return false;                
             }
             
@@ -528,9 +695,10 @@ namespace BitSpace {
 
         bool is_only_x()
         {
-            for(size_t address=0x0; address < this->size(); address++)
+            for(size_t i=0; i < this->list_size(); i++)
             {
-                if(! is_x_bit[this->get_bit(address)])
+                veri_internal_bits_t mask = this->get_bitfield_mask(i);
+                if((this->bits[i].get_bits() & mask) != (_All_x & mask))
                     return false;               
             }
             
@@ -539,9 +707,10 @@ namespace BitSpace {
 
         bool is_true()
         {
-            for(size_t address=0x0; address < this->size(); address++)
+            for(size_t i=0; i < this->list_size(); i++)
             {
-                if(is_one_bit[this->get_bit(address)])
+                veri_internal_bits_t field_bits = this->bits[i].get_bits();
+                if(field_bits & ~(field_bits >> 1) & _All_1 & this->get_bitfield_mask(i))
                     return true;               
             }
             
@@ -550,15 +719,42 @@ namespace BitSpace {
 
         bool is_false()
         {
-            for(size_t address=0x0; address < this->size(); address++)
+            for(size_t i=0; i < this->list_size(); i++)
             {
-                if(! is_zero_bit[this->get_bit(address)])
+                if(this->bits[i].get_bits() & this->get_bitfield_mask(i))
                     return false;               
             }
             
             return true; 
         }
 
+        /**
+         * get the bits as 2-state words, padded or truncated to new_size bits
+         * the bitstring must not contain x or z, and the pad must be 0 or 1
+         */
+        std::vector<two_state_word_t> to_two_state_words(bit_value_t pad, size_t new_size)
+        {
+            std::vector<two_state_word_t> words(two_state_word_count(new_size), (_1 == pad)? ~static_cast<two_state_word_t>(0): 0);
+
+            for(size_t i=0; i < this->list_size(); i++)
+            {
+                size_t address = i * BitFields<veri_internal_bits_t>::size();
+                if(address >= this->size() || address >= new_size)
+                    break;
+
+                size_t valid_bits = std::min(BitFields<veri_internal_bits_t>::size(), std::min(this->size(), new_size) - address);
+                two_state_word_t valid_mask = (static_cast<two_state_word_t>(1) << valid_bits) - 1;
+                size_t shift = address % two_state_word_size;
+
+                two_state_word_t& word = words[address / two_state_word_size];
+                word &= ~(valid_mask << shift);
+                word |= (pack_two_state_bits(this->bits[i].get_bits()) & valid_mask) << shift;
+            }
+
+            mask_two_state_words(words, new_size);
+            return words;
+        }
+
         /**
          * Unary Reduction operations
          * This is Msb to Lsb on purpose, as per specs
@@ -577,6 +773,16 @@ namespace BitSpace {
 
         VerilogBits invert()
         {
+            if(! this->has_unknowns())
+            {
+                std::vector<two_state_word_t> words = this->to_two_state_words(_0, this->bit_size);
+                for(two_state_word_t& word: words)
+                    word = ~word;
+
+                mask_two_state_words(words, this->bit_size);
+                return VerilogBits(words, this->bit_size);
+            }
+
             VerilogBits other(this->bit_size, _0);
 
             for(size_t i=0; i<this->size(); i++)
@@ -587,6 +793,17 @@ namespace BitSpace {
 
         VerilogBits twos_complement()
         {
+            if(! this->has_unknowns())
+            {
+                std::vector<two_state_word_t> words = this->to_two_state_words(_0, this->bit_size);
+                for(two_state_word_t& word: words)
+                    word = ~word;
+
+                add_two_state_words(words, std::vector<two_state_word_t>(), 1);
+                mask_two_state_words(words, this->bit_size);
+                return VerilogBits(words, this->bit_size);
+            }
+
             BitSpace::bit_value_t previous_carry = BitSpace::_1;
             VerilogBits other(this->bit_size, _0);
 
@@ -638,6 +855,11 @@ namespace BitSpace {
                 new_size = last_bit_id+1;
             }
 
+            if((BitSpace::_0 == pad || BitSpace::_1 == pad) && ! this->has_unknowns())
+            {
+                return VerilogBits(this->to_two_state_words(pad, new_size), new_size);
+            }
+
             VerilogBits other(new_size, BitSpace::_0);
 
             size_t i = 0;
@@ -756,6 +978,13 @@ public:
         this->sign = input_sign;
         this->defined_size = this_defined_size;
     }
+
+    VNumber(const std::vector<BitSpace::two_state_word_t>& words, size_t len, bool input_sign, bool this_defined_size)
+    {
+        this->bitstring = BitSpace::VerilogBits(words, len);
+        this->sign = input_sign;
+        this->defined_size = this_defined_size;
+    }
     
     /***
      * getters to 64 bit int
@@ -779,6 +1008,11 @@ public:
         integer_t result = 0;
         BitSpace::bit_value_t pad = this->get_padding_bit(); // = this->is_negative();
 
+        if(end)
+        {
+            return static_cast<integer_t>(this->bitstring.to_two_state_words(BitSpace::_0, end)[0]);
+        }
+
         for(size_t bit_index = 0; bit_index < end; bit_index++)
         {
             integer_t current_bit = static_cast<integer_t>(pad);
@@ -812,6 +1046,20 @@ public:
         return out;
     }
 
+    /***
+     * get the bits as 2-state words (see BitSpace::two_state_word_t), padded or truncated to new_size bits
+     * the number must not contain x or z
+     */
+    std::vector<BitSpace::two_state_word_t> to_two_state_words(size_t new_size)
+    {
+        return this->bitstring.to_two_state_words(this->get_padding_bit(), new_size);
+    }
+
+    std::vector<BitSpace::two_state_word_t> to_two_state_words(BitSpace::bit_value_t pad, size_t new_size)
+    {
+        return this->bitstring.to_two_state_words(pad, new_size);
+    }
+
     /***
      * setters
      */
@@ -1037,6 +1285,34 @@ public:
         const BitSpace::bit_value_t pad_a = this->get_padding_bit();
         const BitSpace::bit_value_t pad_b = b.get_padding_bit();
 
+        /* 2-state operands: each pair of bit values selects a result of the lut, which are all 0 or 1 */
+        const BitSpace::bit_value_t two_state_lut[4] = { lut[BitSpace::_0][BitSpace::_0], lut[BitSpace::_0][BitSpace::_1], lut[BitSpace::_1][BitSpace::_0], lut[BitSpace::_1][BitSpace::_1] };
+        bool is_two_state_lut = std::all_of(two_state_lut, two_state_lut + 4, 
+            [](BitSpace::bit_value_t bit) { return (BitSpace::_0 == bit || BitSpace::_1 == bit); });
+
+        if(is_two_state_lut && ! this->is_dont_care_string() && ! b.is_dont_care_string())
+        {
+            std::vector<BitSpace::two_state_word_t> words_a = this->to_two_state_words(std_length);
+            std::vector<BitSpace::two_state_word_t> words_b = b.to_two_state_words(std_length);
+
+            BitSpace::two_state_word_t select[4];
+            for(size_t i=0; i < 4; i++)
+                select[i] = (BitSpace::_1 == two_state_lut[i])? ~static_cast<BitSpace::two_state_word_t>(0): 0;
+
+            for(size_t i=0; i < words_a.size(); i++)
+            {
+                BitSpace::two_state_word_t word_a = words_a[i];
+                BitSpace::two_state_word_t word_b = words_b[i];
+                words_a[i] = (select[0] & ~word_a & ~word_b) 
+                           | (select[1] & ~word_a & word_b) 
+                           | (select[2] & word_a & ~word_b) 
+                           | (select[3] & word_a & word_b);
+            }
+
+            BitSpace::mask_two_state_words(words_a, std_length);
+            return VNumber(words_a, std_length, false, this->is_defined_size() && b.is_defined_size());
+        }
+
         VNumber result(std_length, BitSpace::_x, false, this->is_defined_size() && b.is_defined_size() );
 
         for(size_t i=0; i < result.size(); i++)
@@ -84,6 +84,26 @@ static compare_bit eval_op(VNumber& a_in, VNumber& b_in)
 	bit_value_t pad_a = a.get_padding_bit();
 	bit_value_t pad_b = b.get_padding_bit();
 
+	/* 2-state fast path: compare the padded words from the msb */
+	if(!a.is_dont_care_string() && !b.is_dont_care_string())
+	{
+		std::vector<two_state_word_t> words_a = a.to_two_state_words(std_length);
+		std::vector<two_state_word_t> words_b = b.to_two_state_words(std_length);
+
+		for(size_t i=words_a.size()-1; i < words_a.size() ; i--)
+		{
+			if(words_a[i] < words_b[i])
+			{
+				return (!invert_result)? LT_EVAL: GT_EVAL;
+			}
+			else if(words_a[i] > words_b[i])
+			{
+				return (!invert_result)? GT_EVAL: LT_EVAL;
+			}
+		}
+
+		return EQ_EVAL;
+	}
 
 	for(size_t i=std_length-1; i < std_length ; i--)
 	{
@@ -166,6 +186,16 @@ static VNumber sum_op(VNumber& a, VNumber& b, const bit_value_t& initial_carry,
 
 	//("pad_b: '" << (unsigned(pad_b)) << "'");
 
+	/* 2-state fast path: add the padded words with a native carry chain */
+	if((_0 == initial_carry || _1 == initial_carry) && !a.is_dont_care_string() && !b.is_dont_care_string())
+	{
+		std::vector<two_state_word_t> sum = a.to_two_state_words(new_length);
+		add_two_state_words(sum, b.to_two_state_words(new_length), (_1 == initial_carry)? 1: 0);
+		mask_two_state_words(sum, new_length);
+
+		return VNumber(sum, new_length, is_addition_signed_operation, a.is_defined_size() && b.is_defined_size());
+	}
+
 	bit_value_t previous_carry = initial_carry;
 	VNumber result(new_length, _0, is_addition_signed_operation, a.is_defined_size() && b.is_defined_size()); 
 
@@ -206,6 +236,16 @@ static VNumber shift_op(VNumber& a, int64_t b, bool sign_shift)
 	{
 		size_t u_b = static_cast<size_t>(-b);
 		bit_value_t pad = ( sign_shift ) ? a.get_padding_bit(): BitSpace::_0;
+
+		/* 2-state fast path: the words are padded up to a whole word to be filled from the msb */
+		if(!a.is_dont_care_string())
+		{
+			two_state_word_t fill = (_1 == pad)? ~static_cast<two_state_word_t>(0): 0;
+			std::vector<two_state_word_t> words = a.to_two_state_words(pad, two_state_word_count(a.size()) * two_state_word_size);
+
+			return VNumber(shift_right_two_state_words(words, u_b, a.size(), fill), a.size(), sign_shift, a.is_defined_size());
+		}
+
 		to_return = VNumber(a.size(), pad, sign_shift, a.is_defined_size());
 		for(size_t i=0; i < (a.size() - u_b); i++)
 		{
@@ -216,6 +256,15 @@ static VNumber shift_op(VNumber& a, int64_t b, bool sign_shift)
 	{
 		size_t u_b = static_cast<size_t>(b);
 		bit_value_t pad = BitSpace::_0;
+
+		/* 2-state fast path */
+		if(!a.is_dont_care_string())
+		{
+			std::vector<two_state_word_t> words = a.to_two_state_words(a.size());
+
+			return VNumber(shift_left_two_state_words(words, u_b, a.size() + u_b), a.size() + u_b, sign_shift, a.is_defined_size());
+		}
+
 		to_return =VNumber((a.size() + u_b), pad, sign_shift, a.is_defined_size());
 		for(size_t i=0; i < a.size(); i++)
 		{
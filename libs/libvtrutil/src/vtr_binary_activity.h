@@ -0,0 +1,64 @@
+#ifndef VTR_BINARY_ACTIVITY_H
+#define VTR_BINARY_ACTIVITY_H
+/*
+ * The binary format of signal activity files, which is a sibling of the text .act format.
+ * It is written by ace and read by VPR (see read_activity.h) without any parsing.
+ *
+ * File layout (native byte order):
+ *
+ *  +--------------------------------------+  offset 0
+ *  | Header (t_binary_activity_header)    |
+ *  +--------------------------------------+
+ *  | num_nets records                     |
+ *  | (t_binary_activity_record)           |
+ *  +--------------------------------------+
+ *  | Net names (names_size bytes)         |
+ *  +--------------------------------------+
+ *
+ * Net names are concatenated without any terminator, each record pointing to its name.
+ *
+ * The header holds a checksum of the net names in the order of the records.
+ * When it matches the checksum of the net names of a netlist, in the order of its net ids,
+ * the records are in the net id order and can be assigned without looking up the names.
+ */
+#include <cstddef>
+#include <cstdint>
+
+namespace vtr {
+
+constexpr char BINARY_ACTIVITY_MAGIC[8] = {'V', 'T', 'R', 'B', 'A', 'C', 'T', '\0'};
+constexpr uint32_t BINARY_ACTIVITY_VERSION = 1;
+
+struct t_binary_activity_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t num_nets;
+    uint64_t names_size;
+    uint64_t net_names_checksum;
+};
+
+struct t_binary_activity_record {
+    float probability;
+    float density;
+    uint64_t name_offset;
+    uint64_t name_length;
+};
+
+//Initial value of the checksum of net names
+constexpr uint64_t BINARY_ACTIVITY_CHECKSUM_INIT = 14695981039346656037ULL;
+
+//Adds a net name to the checksum of net names (FNV-1a hash).
+//The names are separated by a null character, so that "ab" + "c" and "a" + "bc" are different
+inline uint64_t binary_activity_checksum(uint64_t checksum, const char* name, size_t name_length) {
+    for (size_t i = 0; i < name_length; ++i) {
+        checksum ^= uint64_t(static_cast<unsigned char>(name[i]));
+        checksum *= 1099511628211ULL;
+    }
+    checksum *= 1099511628211ULL;
+    return checksum;
+}
+
+} // namespace vtr
+
+#endif
@@ -1,7 +1,14 @@
 #ifndef VTR_CACHE_H_
 #define VTR_CACHE_H_
 
+#include <cstddef>
+#include <functional>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 
 namespace vtr {
 
@@ -39,6 +46,84 @@ class Cache {
     std::unique_ptr<CacheValue> value_;
 };
 
+//A mutex which does nothing, for the caches which are not shared by threads
+struct NullMutex {
+    void lock() {}
+    void unlock() {}
+};
+
+// Bounded cache of the most recently used values, e.g. of an expensive function
+// which is called repeatedly with a handful of alternating keys.
+//
+// When the cache is full, adding a value evicts the least recently used one.
+// Values are returned by copy, so that a ThreadSafe cache can be shared by threads.
+template<typename Key, typename Value, typename Hash = std::hash<Key>, bool ThreadSafe = false>
+class LruCache {
+  public:
+    explicit LruCache(size_t capacity)
+        : capacity_(capacity) {
+        lookup_.reserve(capacity);
+    }
+
+    size_t capacity() const { return capacity_; }
+
+    size_t size() const {
+        std::lock_guard<mutex_type> lock(mutex_);
+        return entries_.size();
+    }
+
+    void clear() {
+        std::lock_guard<mutex_type> lock(mutex_);
+        entries_.clear();
+        lookup_.clear();
+    }
+
+    // Copies the cached value of key to value, and marks it as the most recently used.
+    //
+    // Returns false if the key is not cached.
+    bool get(const Key& key, Value& value) const {
+        std::lock_guard<mutex_type> lock(mutex_);
+        auto iter = lookup_.find(key);
+        if (iter == lookup_.end()) {
+            return false;
+        }
+        entries_.splice(entries_.begin(), entries_, iter->second);
+        value = iter->second->second;
+        return true;
+    }
+
+    // Caches the value of key, as the most recently used one.
+    void set(const Key& key, const Value& value) {
+        std::lock_guard<mutex_type> lock(mutex_);
+        if (capacity_ == 0) {
+            return;
+        }
+        auto iter = lookup_.find(key);
+        if (iter != lookup_.end()) {
+            iter->second->second = value;
+            entries_.splice(entries_.begin(), entries_, iter->second);
+            return;
+        }
+        if (entries_.size() == capacity_) {
+            lookup_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+        entries_.emplace_front(key, value);
+        lookup_.emplace(key, entries_.begin());
+    }
+
+  private:
+    typedef typename std::conditional<ThreadSafe, std::mutex, NullMutex>::type mutex_type;
+    typedef std::list<std::pair<Key, Value>> entry_list;
+
+    size_t capacity_;
+    // Entries from the most to the least recently used
+    // (mutable, since a look-up marks its entry as the most recently used)
+    mutable entry_list entries_;
+    std::unordered_map<Key, typename entry_list::iterator, Hash> lookup_;
+    mutable mutex_type mutex_;
+};
+
 } // namespace vtr
 
 #endif
@@ -0,0 +1,58 @@
+#include "vtr_crc.h"
+
+#include <array>
+#include <cstring>
+
+#if defined(__SSE4_2__)
+#    include <nmmintrin.h>
+#endif
+
+namespace vtr {
+
+#if !defined(__SSE4_2__)
+namespace {
+
+//Reflected polynomial of CRC-32C
+constexpr uint32_t CRC32C_POLYNOMIAL = 0x82F63B78;
+
+std::array<uint32_t, 256> build_crc32c_table() {
+    std::array<uint32_t, 256> table;
+    for (uint32_t byte = 0; byte < 256; ++byte) {
+        uint32_t crc = byte;
+        for (size_t ibit = 0; ibit < 8; ++ibit) {
+            crc = (crc >> 1) ^ ((crc & 1) ? CRC32C_POLYNOMIAL : 0);
+        }
+        table[byte] = crc;
+    }
+    return table;
+}
+
+} // namespace
+#endif
+
+uint32_t crc32c(const void* data, size_t num_bytes, uint32_t crc) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    crc = ~crc;
+
+#if defined(__SSE4_2__)
+    uint64_t crc64 = crc;
+    for (; num_bytes >= sizeof(uint64_t); num_bytes -= sizeof(uint64_t), bytes += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+    }
+    crc = uint32_t(crc64);
+    for (; num_bytes > 0; --num_bytes, ++bytes) {
+        crc = _mm_crc32_u8(crc, *bytes);
+    }
+#else
+    static const std::array<uint32_t, 256> table = build_crc32c_table();
+    for (; num_bytes > 0; --num_bytes, ++bytes) {
+        crc = (crc >> 8) ^ table[(crc ^ *bytes) & 0xFF];
+    }
+#endif
+
+    return ~crc;
+}
+
+} // namespace vtr
@@ -0,0 +1,21 @@
+#ifndef VTR_CRC_H
+#define VTR_CRC_H
+#include <cstddef>
+#include <cstdint>
+
+namespace vtr {
+
+//Updates a CRC-32C (Castagnoli) checksum with the given bytes
+//
+//The checksum of a sequence of bytes starts from zero, and can be computed
+//incrementally by passing the previous result as crc:
+//
+//      uint32_t crc = vtr::crc32c(first_bytes, num_first_bytes);
+//      crc = vtr::crc32c(next_bytes, num_next_bytes, crc);
+//
+//It uses the SSE4.2 instruction when enabled at compile time, and a table otherwise.
+uint32_t crc32c(const void* data, size_t num_bytes, uint32_t crc = 0);
+
+} // namespace vtr
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef VTR_HASH_H
 #define VTR_HASH_H
 #include <functional>
+#include <cstdint>
+#include <cstring>
 
 namespace vtr {
 
@@ -13,6 +15,23 @@ inline void hash_combine(std::size_t& seed, const T& v) {
     seed ^= hasher(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 }
 
+//Initial value of a checksum (FNV-1a offset basis)
+constexpr uint64_t CHECKSUM_INIT = 14695981039346656037ULL;
+
+//Adds the bytes of v (of a trivially copyable type) to an FNV-1a checksum
+//
+//Unlike std::hash, the checksum does not depend on the standard library
+//implementation, so it can be stored in files to be checked by later runs.
+template<class T>
+inline void checksum_combine(uint64_t& checksum, const T& v) {
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &v, sizeof(T));
+    for (unsigned char byte : bytes) {
+        checksum ^= uint64_t(byte);
+        checksum *= 1099511628211ULL;
+    }
+}
+
 } // namespace vtr
 
 #endif
@@ -0,0 +1,141 @@
+#include "vtr_mapped_storage.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#    define VTR_HAS_MMAP
+#    include <sys/mman.h>
+#    include <unistd.h>
+#endif
+
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+namespace vtr {
+
+namespace detail {
+std::atomic<bool> f_mapped_storage_enabled(false);
+} // namespace detail
+
+namespace {
+
+struct t_mapped_storage {
+    std::mutex mutex;
+    std::string directory;
+    size_t min_bytes = 0;
+    //The size of each mapped memory, so that the deallocations of heap memory are recognized
+    std::unordered_map<void*, size_t> mappings;
+    //The number of mappings, checked without the lock by the deallocations
+    std::atomic<size_t> num_mappings{0};
+};
+
+t_mapped_storage& get_mapped_storage() {
+    static t_mapped_storage storage;
+    return storage;
+}
+
+} // namespace
+
+void enable_mapped_storage(const std::string& directory, size_t min_bytes) {
+    t_mapped_storage& storage = get_mapped_storage();
+    std::lock_guard<std::mutex> lock(storage.mutex);
+
+    storage.directory = directory.empty() ? std::string(".") : directory;
+    storage.min_bytes = min_bytes;
+#ifdef VTR_HAS_MMAP
+    detail::f_mapped_storage_enabled.store(true);
+#else
+    VTR_LOG_WARN("Mapped storage is not supported on this platform, memory is allocated on the heap\n");
+#endif
+}
+
+void disable_mapped_storage() {
+    detail::f_mapped_storage_enabled.store(false);
+}
+
+ScopedMappedStorage::ScopedMappedStorage(const std::string& directory, size_t min_bytes)
+    : enabled_(!directory.empty()) {
+    if (enabled_) {
+        enable_mapped_storage(directory, min_bytes);
+    }
+}
+
+ScopedMappedStorage::~ScopedMappedStorage() {
+    if (enabled_) {
+        disable_mapped_storage();
+    }
+}
+
+namespace detail {
+
+void* mapped_allocate(size_t num_bytes) {
+#ifdef VTR_HAS_MMAP
+    t_mapped_storage& storage = get_mapped_storage();
+    std::lock_guard<std::mutex> lock(storage.mutex);
+
+    if (num_bytes == 0 || num_bytes < storage.min_bytes) {
+        return nullptr;
+    }
+
+    //The file is removed at once, its blocks are freed when it is unmapped
+    std::string file_template = storage.directory + "/vtr_mapped_storage_XXXXXX";
+    std::vector<char> file_name(file_template.begin(), file_template.end());
+    file_name.push_back('\0');
+    int fd = mkstemp(file_name.data());
+    if (fd < 0) {
+        VTR_LOG_WARN("Failed to create a mapped storage file in '%s', memory is allocated on the heap\n", storage.directory.c_str());
+        return nullptr;
+    }
+    unlink(file_name.data());
+
+    void* memory = MAP_FAILED;
+    if (ftruncate(fd, num_bytes) == 0) {
+        memory = mmap(nullptr, num_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    //The mapping keeps a reference to the file
+    close(fd);
+    if (memory == MAP_FAILED) {
+        VTR_LOG_WARN("Failed to map %zu bytes of storage in '%s', memory is allocated on the heap\n", num_bytes, storage.directory.c_str());
+        return nullptr;
+    }
+    madvise(memory, num_bytes, MADV_SEQUENTIAL);
+
+    storage.mappings[memory] = num_bytes;
+    ++storage.num_mappings;
+    return memory;
+#else
+    (void)num_bytes;
+    return nullptr;
+#endif
+}
+
+bool mapped_deallocate(void* memory, size_t num_bytes) {
+#ifdef VTR_HAS_MMAP
+    t_mapped_storage& storage = get_mapped_storage();
+    if (storage.num_mappings.load() == 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(storage.mutex);
+    auto mapping = storage.mappings.find(memory);
+    if (mapping == storage.mappings.end()) {
+        return false;
+    }
+    //The allocator always releases the memory with the size it was allocated with
+    VTR_ASSERT_MSG(mapping->second == num_bytes, "Mapped storage is released with a different size");
+    munmap(memory, mapping->second);
+    storage.mappings.erase(mapping);
+    --storage.num_mappings;
+    return true;
+#else
+    (void)memory;
+    (void)num_bytes;
+    return false;
+#endif
+}
+
+} // namespace detail
+
+} // namespace vtr
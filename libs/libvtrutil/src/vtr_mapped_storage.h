@@ -0,0 +1,111 @@
+#ifndef VTR_MAPPED_STORAGE_H
+#define VTR_MAPPED_STORAGE_H
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+/*
+ * Memory-mapped storage
+ * =====================
+ *
+ * An opt-in backend for the memory of the largest arrays (e.g. the per-bit arrays of
+ * bitstreams), which places them in memory-mapped temporary files rather than on the
+ * heap. The pages of a file are written back to the disk under memory pressure, so a
+ * data structure may exceed the physical memory, at the cost of disk accesses.
+ * Arrays accessed sequentially (which is the case of the bitstream writers) are read
+ * ahead by the operating system.
+ *
+ * The memory of a container is placed by its allocator:
+ *
+ *      std::vector<uint64_t, vtr::MappedAllocator<uint64_t>> words;
+ *      vtr::vector<BitId, char, vtr::MappedAllocator<char>> values;
+ *
+ * Mapped storage is disabled by default, in which case an allocation only checks a
+ * flag. When enabled, only the allocations of at least a minimum size are mapped, so
+ * that small containers stay on the heap. Memory mapped while enabled is correctly
+ * released after it is disabled.
+ *
+ * The temporary files are removed from the directory as soon as they are mapped, so
+ * that they do not outlive the program. On platforms without mmap(), the memory is
+ * always allocated on the heap.
+ */
+
+namespace vtr {
+
+//Enables mapped storage with temporary files in the given directory,
+//for the allocations of at least min_bytes
+void enable_mapped_storage(const std::string& directory, size_t min_bytes = 1 << 20);
+
+//Disables mapped storage, the following allocations are on the heap
+void disable_mapped_storage();
+
+//Enables mapped storage in a directory for the lifetime of the object,
+//or does nothing if the directory is empty
+class ScopedMappedStorage {
+  public:
+    ScopedMappedStorage(const std::string& directory, size_t min_bytes = 1 << 20);
+    ~ScopedMappedStorage();
+
+    ScopedMappedStorage(const ScopedMappedStorage&) = delete;
+    ScopedMappedStorage& operator=(const ScopedMappedStorage&) = delete;
+
+  private:
+    bool enabled_;
+};
+
+namespace detail {
+extern std::atomic<bool> f_mapped_storage_enabled;
+
+//Returns the memory mapped for an allocation, or nullptr if it should be allocated on the heap
+void* mapped_allocate(size_t num_bytes);
+
+//Releases the memory if it was mapped, and returns false if it was allocated on the heap
+bool mapped_deallocate(void* memory, size_t num_bytes);
+} // namespace detail
+
+//Returns true if large allocations are mapped to temporary files
+inline bool mapped_storage_enabled() {
+    return detail::f_mapped_storage_enabled.load(std::memory_order_relaxed);
+}
+
+//A std::allocator which places large allocations in memory-mapped temporary files
+//when mapped storage is enabled
+template<typename T>
+class MappedAllocator : public std::allocator<T> {
+  public:
+    template<typename U>
+    struct rebind {
+        typedef MappedAllocator<U> other;
+    };
+
+    MappedAllocator() noexcept = default;
+    template<typename U>
+    MappedAllocator(const MappedAllocator<U>&) noexcept {}
+
+    T* allocate(size_t num_values) {
+        if (mapped_storage_enabled()) {
+            void* memory = detail::mapped_allocate(num_values * sizeof(T));
+            if (memory) {
+                return static_cast<T*>(memory);
+            }
+        }
+        return std::allocator<T>::allocate(num_values);
+    }
+
+    void deallocate(T* values, size_t num_values) {
+        if (!detail::mapped_deallocate(values, num_values * sizeof(T))) {
+            std::allocator<T>::deallocate(values, num_values);
+        }
+    }
+};
+
+template<typename T, typename U>
+bool operator==(const MappedAllocator<T>&, const MappedAllocator<U>&) { return true; }
+
+template<typename T, typename U>
+bool operator!=(const MappedAllocator<T>&, const MappedAllocator<U>&) { return false; }
+
+} // namespace vtr
+
+#endif
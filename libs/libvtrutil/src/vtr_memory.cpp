@@ -4,6 +4,7 @@
 #include "vtr_assert.h"
 #include "vtr_list.h"
 #include "vtr_memory.h"
+#include "vtr_memory_stats.h"
 #include "vtr_error.h"
 #include "vtr_util.h"
 
@@ -15,6 +16,14 @@
 
 namespace vtr {
 
+//Attributes a block allocated by chunk_malloc() to the owner of the chunks, if any
+static void attribute_chunk_memory(size_t size, t_chunk* chunk_info) {
+    if (chunk_info->owner && memory_stats_enabled()) {
+        chunk_info->owner->allocate(size);
+        chunk_info->owner_bytes += size;
+    }
+}
+
 #ifndef __GLIBC__
 int malloc_trim(size_t /*pad*/) {
     return 0;
@@ -112,6 +121,7 @@ void* chunk_malloc(size_t size, t_chunk* chunk_info) {
 
             VTR_ASSERT(chunk_info != nullptr);
             chunk_info->chunk_ptr_head = insert_in_vptr_list(chunk_info->chunk_ptr_head, tmp_ptr);
+            attribute_chunk_memory(size, chunk_info);
             return (tmp_ptr);
         }
 
@@ -120,6 +130,7 @@ void* chunk_malloc(size_t size, t_chunk* chunk_info) {
             chunk_info->mem_avail = CHUNK_SIZE;
             VTR_ASSERT(chunk_info != nullptr);
             chunk_info->chunk_ptr_head = insert_in_vptr_list(chunk_info->chunk_ptr_head, chunk_info->next_mem_loc_ptr);
+            attribute_chunk_memory(CHUNK_SIZE, chunk_info);
         }
 
         /* Execute else clause only when the chunk we want is pretty big,  *
@@ -130,6 +141,7 @@ void* chunk_malloc(size_t size, t_chunk* chunk_info) {
             tmp_ptr = (char*)vtr::malloc(size);
             VTR_ASSERT(chunk_info != nullptr);
             chunk_info->chunk_ptr_head = insert_in_vptr_list(chunk_info->chunk_ptr_head, tmp_ptr);
+            attribute_chunk_memory(size, chunk_info);
             return (tmp_ptr);
         }
     }
@@ -165,6 +177,11 @@ void free_chunk_memory(t_chunk* chunk_info) {
     chunk_info->chunk_ptr_head = nullptr;
     chunk_info->mem_avail = 0;
     chunk_info->next_mem_loc_ptr = nullptr;
+
+    if (chunk_info->owner) {
+        chunk_info->owner->deallocate(chunk_info->owner_bytes);
+    }
+    chunk_info->owner_bytes = 0;
 }
 
 } // namespace vtr
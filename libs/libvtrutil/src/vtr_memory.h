@@ -4,6 +4,7 @@
 
 namespace vtr {
 struct t_linked_vptr; //Forward declaration
+class MemoryOwner;    //Forward declaration (see vtr_memory_stats.h)
 
 /* This structure is to keep track of chunks of memory that is being	*
  * allocated to save overhead when allocating very small memory pieces. *
@@ -16,6 +17,9 @@ struct t_chunk {
     int mem_avail = 0;                /* number of bytes left in the current chunk */
     char* next_mem_loc_ptr = nullptr; /* pointer to the first available (free) *
                                        * byte in the current chunk		*/
+    MemoryOwner* owner = nullptr;     /* owner to which the chunks are attributed *
+                                       * when memory accounting is enabled         */
+    size_t owner_bytes = 0;           /* number of bytes attributed to the owner  */
 };
 
 void* free(void* some);
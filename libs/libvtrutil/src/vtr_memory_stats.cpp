@@ -0,0 +1,88 @@
+#include "vtr_memory_stats.h"
+
+#include <mutex>
+
+namespace vtr {
+
+namespace detail {
+std::atomic<bool> f_memory_stats_enabled(false);
+} // namespace detail
+
+namespace {
+
+//The owners live until the end of the program, so that the allocators can keep references to them
+struct t_memory_owners {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<MemoryOwner>> owners;
+};
+
+t_memory_owners& get_memory_owners() {
+    static t_memory_owners owners;
+    return owners;
+}
+
+} // namespace
+
+void enable_memory_stats() {
+    detail::f_memory_stats_enabled.store(true);
+}
+
+MemoryOwner::MemoryOwner(const std::string& name)
+    : name_(name)
+    , current_bytes_(0)
+    , peak_bytes_(0) {
+}
+
+void MemoryOwner::allocate(size_t num_bytes) {
+    size_t bytes = current_bytes_.fetch_add(num_bytes, std::memory_order_relaxed) + num_bytes;
+
+    size_t peak = peak_bytes_.load(std::memory_order_relaxed);
+    while (peak < bytes && !peak_bytes_.compare_exchange_weak(peak, bytes, std::memory_order_relaxed)) {
+    }
+}
+
+void MemoryOwner::deallocate(size_t num_bytes) {
+    //Memory allocated before the accounting was enabled is not attributed, so the count saturates at zero
+    size_t bytes = current_bytes_.load(std::memory_order_relaxed);
+    while (!current_bytes_.compare_exchange_weak(bytes, bytes > num_bytes ? bytes - num_bytes : 0, std::memory_order_relaxed)) {
+    }
+}
+
+void MemoryOwner::reset_peak() {
+    peak_bytes_.store(current_bytes(), std::memory_order_relaxed);
+}
+
+MemoryOwner& memory_owner(const std::string& name) {
+    t_memory_owners& memory_owners = get_memory_owners();
+    std::lock_guard<std::mutex> lock(memory_owners.mutex);
+
+    for (const std::unique_ptr<MemoryOwner>& owner : memory_owners.owners) {
+        if (owner->name() == name) {
+            return *owner;
+        }
+    }
+    memory_owners.owners.emplace_back(new MemoryOwner(name));
+    return *memory_owners.owners.back();
+}
+
+std::vector<const MemoryOwner*> memory_owners() {
+    t_memory_owners& memory_owners = get_memory_owners();
+    std::lock_guard<std::mutex> lock(memory_owners.mutex);
+
+    std::vector<const MemoryOwner*> owners;
+    for (const std::unique_ptr<MemoryOwner>& owner : memory_owners.owners) {
+        owners.push_back(owner.get());
+    }
+    return owners;
+}
+
+void reset_memory_peaks() {
+    t_memory_owners& memory_owners = get_memory_owners();
+    std::lock_guard<std::mutex> lock(memory_owners.mutex);
+
+    for (const std::unique_ptr<MemoryOwner>& owner : memory_owners.owners) {
+        owner->reset_peak();
+    }
+}
+
+} // namespace vtr
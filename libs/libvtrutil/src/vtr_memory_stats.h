@@ -0,0 +1,125 @@
+#ifndef VTR_MEMORY_STATS_H
+#define VTR_MEMORY_STATS_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * Memory accounting
+ * =================
+ *
+ * An opt-in record of the heap memory of the large data structures, attributed to
+ * named owners (e.g. "ModuleManager nets" or "Route traces"), with the current and
+ * the peak number of bytes of each owner.
+ *
+ * The memory of a container is attributed to an owner by its allocator:
+ *
+ *      struct t_my_edges_memory_tag {
+ *          static const char* name() { return "My edges"; }
+ *      };
+ *
+ *      std::vector<Edge, vtr::TaggedAllocator<Edge, t_my_edges_memory_tag>> edges;
+ *      vtr::vector<EdgeId, Edge, vtr::TaggedAllocator<Edge, t_my_edges_memory_tag>> edges;
+ *
+ * The memory itself is allocated by the Base allocator of the TaggedAllocator (e.g.
+ * vtr::MappedAllocator<Edge> to place it in mapped storage).
+ *
+ * and the memory of a chunk allocator (see vtr::chunk_malloc()) by its t_chunk::owner.
+ *
+ * Accounting is disabled by default, in which case an allocation only checks a flag.
+ * It should be enabled (with enable_memory_stats()) before the data structures are
+ * built, since memory allocated while it was disabled is never attributed.
+ */
+
+namespace vtr {
+
+//Enables memory accounting
+void enable_memory_stats();
+
+namespace detail {
+extern std::atomic<bool> f_memory_stats_enabled;
+} // namespace detail
+
+//Returns true if allocations are attributed to their owners
+inline bool memory_stats_enabled() {
+    return detail::f_memory_stats_enabled.load(std::memory_order_relaxed);
+}
+
+//The heap memory attributed to a named owner
+//Allocations may be attributed concurrently from several threads
+class MemoryOwner {
+  public:
+    MemoryOwner(const std::string& name);
+
+    const std::string& name() const { return name_; }
+    size_t current_bytes() const { return current_bytes_.load(std::memory_order_relaxed); }
+    size_t peak_bytes() const { return peak_bytes_.load(std::memory_order_relaxed); }
+
+    void allocate(size_t num_bytes);
+    void deallocate(size_t num_bytes);
+
+    //Restarts the peak from the current number of bytes
+    void reset_peak();
+
+  private:
+    std::string name_;
+    std::atomic<size_t> current_bytes_;
+    std::atomic<size_t> peak_bytes_;
+};
+
+//Returns the owner of the given name, which is created at the first call
+MemoryOwner& memory_owner(const std::string& name);
+
+//Returns all the owners, in the order of their creation
+std::vector<const MemoryOwner*> memory_owners();
+
+//Restarts the peaks of all the owners, e.g. at the start of a command
+void reset_memory_peaks();
+
+//An allocator which attributes the memory of its Base allocator to the owner named by Tag::name()
+template<typename T, typename Tag, typename Base = std::allocator<T>>
+class TaggedAllocator : public Base {
+  public:
+    template<typename U>
+    struct rebind {
+        typedef TaggedAllocator<U, Tag, typename std::allocator_traits<Base>::template rebind_alloc<U>> other;
+    };
+
+    TaggedAllocator() noexcept = default;
+    template<typename U, typename BaseU>
+    TaggedAllocator(const TaggedAllocator<U, Tag, BaseU>&) noexcept {}
+
+    T* allocate(size_t num_values) {
+        T* values = Base::allocate(num_values);
+        if (memory_stats_enabled()) {
+            owner().allocate(num_values * sizeof(T));
+        }
+        return values;
+    }
+
+    void deallocate(T* values, size_t num_values) {
+        if (memory_stats_enabled()) {
+            owner().deallocate(num_values * sizeof(T));
+        }
+        Base::deallocate(values, num_values);
+    }
+
+  private:
+    static MemoryOwner& owner() {
+        static MemoryOwner& tag_owner = memory_owner(Tag::name());
+        return tag_owner;
+    }
+};
+
+template<typename T, typename U, typename Tag, typename BaseT, typename BaseU>
+bool operator==(const TaggedAllocator<T, Tag, BaseT>&, const TaggedAllocator<U, Tag, BaseU>&) { return true; }
+
+template<typename T, typename U, typename Tag, typename BaseT, typename BaseU>
+bool operator!=(const TaggedAllocator<T, Tag, BaseT>&, const TaggedAllocator<U, Tag, BaseU>&) { return false; }
+
+} // namespace vtr
+
+#endif
@@ -0,0 +1,35 @@
+#include "vtr_parallel.h"
+
+namespace vtr {
+
+namespace {
+std::atomic<size_t> f_num_workers(1);
+thread_local bool f_in_parallel_region = false;
+} // namespace
+
+void set_num_workers(size_t num_workers) {
+    f_num_workers.store(std::max<size_t>(num_workers, 1));
+}
+
+size_t num_workers() {
+    return f_num_workers.load();
+}
+
+bool in_parallel_region() {
+    return f_in_parallel_region;
+}
+
+namespace detail {
+
+ParallelRegion::ParallelRegion()
+    : was_in_parallel_region_(f_in_parallel_region) {
+    f_in_parallel_region = true;
+}
+
+ParallelRegion::~ParallelRegion() {
+    f_in_parallel_region = was_in_parallel_region_;
+}
+
+} // namespace detail
+
+} // namespace vtr
@@ -0,0 +1,104 @@
+#ifndef VTR_PARALLEL_H
+#define VTR_PARALLEL_H
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/*
+ * Parallel loops
+ * ==============
+ *
+ * A common substrate for the loops over independent items (e.g. blocks, nets or files)
+ * which may be run by several threads:
+ *
+ *      vtr::parallel_for(items.size(), num_threads, [&](size_t item) {
+ *          results[item] = process(items[item]);
+ *      });
+ *
+ * The items are dispatched on demand to the workers, as the cost of items usually varies,
+ * and the caller thread is always one of the workers. The results are deterministic
+ * (i.e. independent of the number of threads) as long as each item only writes its own results,
+ * which are then merged by the caller in the order of the items.
+ *
+ * A parallel loop run by a worker of another parallel loop is run serially by that worker,
+ * so that nested loops never oversubscribe the host.
+ *
+ * The default number of threads is set once by the tool (see set_num_workers()), e.g. from
+ * --num_workers in VPR or --threads in the OpenFPGA shell.
+ */
+
+namespace vtr {
+
+//Sets the default number of threads of the parallel loops (at least 1)
+void set_num_workers(size_t num_workers);
+
+//Returns the default number of threads of the parallel loops (1 unless set)
+size_t num_workers();
+
+//Returns true if the calling thread is running an item of a parallel loop
+bool in_parallel_region();
+
+namespace detail {
+//Marks the calling thread as running a parallel loop during its lifetime
+class ParallelRegion {
+  public:
+    ParallelRegion();
+    ~ParallelRegion();
+
+    ParallelRegion(const ParallelRegion&) = delete;
+    ParallelRegion& operator=(const ParallelRegion&) = delete;
+
+  private:
+    bool was_in_parallel_region_;
+};
+} // namespace detail
+
+//Runs func(item, worker) for each item in [0, num_items) with up to num_threads workers,
+//where worker in [0, num_threads) identifies the thread, e.g. to index per-thread scratch data
+template<typename Func>
+void parallel_for_workers(size_t num_items, size_t num_threads, const Func& func) {
+    num_threads = std::min(num_threads, num_items);
+    if (num_threads <= 1 || in_parallel_region()) {
+        for (size_t item = 0; item < num_items; ++item) {
+            func(item, size_t(0));
+        }
+        return;
+    }
+
+    std::atomic<size_t> next_item(0);
+    auto run_items = [&](size_t worker) {
+        detail::ParallelRegion region;
+        for (size_t item = next_item++; item < num_items; item = next_item++) {
+            func(item, worker);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t worker = 1; worker < num_threads; ++worker) {
+        workers.emplace_back(run_items, worker);
+    }
+    run_items(0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+//Runs func(item) for each item in [0, num_items) with up to num_threads workers
+template<typename Func>
+void parallel_for(size_t num_items, size_t num_threads, const Func& func) {
+    parallel_for_workers(num_items, num_threads, [&](size_t item, size_t /*worker*/) {
+        func(item);
+    });
+}
+
+//Runs func(item) for each item in [0, num_items) with the default number of workers
+template<typename Func>
+void parallel_for(size_t num_items, const Func& func) {
+    parallel_for(num_items, num_workers(), func);
+}
+
+} // namespace vtr
+
+#endif
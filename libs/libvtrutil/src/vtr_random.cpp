@@ -52,14 +52,14 @@ int irand(int imax) {
     return irand(imax, random_state);
 }
 
-float frand() {
+float frand(RandState& state) {
     /* Creates a random float between 0 and 1.  i.e. [0..1).        */
 
     float fval;
     int ival;
 
-    random_state = random_state * IA + IC; /* Use overflow to wrap */
-    ival = random_state & (IM - 1);        /* Modulus */
+    state = state * IA + IC; /* Use overflow to wrap */
+    ival = state & (IM - 1); /* Modulus */
     fval = (float)ival / (float)IM;
 
 #ifdef CHECK_RAND
@@ -71,4 +71,8 @@ float frand() {
     return (fval);
 }
 
+float frand() {
+    return frand(random_state);
+}
+
 } // namespace vtr
@@ -11,6 +11,7 @@ RandState get_random_state();
 int irand(int imax);
 int irand(int imax, RandState& rand_state);
 float frand();
+float frand(RandState& rand_state);
 
 //Portable/invariant version of std::shuffle
 //
@@ -3,6 +3,11 @@
 #ifdef __unix__
 #    include <sys/time.h>
 #    include <sys/resource.h>
+#    include <unistd.h>
+#endif
+
+#ifdef __linux__
+#    include <cstdio>
 #endif
 
 namespace vtr {
@@ -26,4 +31,45 @@ size_t get_max_rss() {
     return max_rss;
 }
 
+size_t get_current_rss() {
+    size_t rss = 0;
+
+#ifdef __linux__
+    //The second field of statm is the number of resident pages
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (statm) {
+        unsigned long num_pages = 0;
+        unsigned long num_resident_pages = 0;
+        if (std::fscanf(statm, "%lu %lu", &num_pages, &num_resident_pages) == 2) {
+            rss = num_resident_pages * sysconf(_SC_PAGESIZE);
+        }
+        std::fclose(statm);
+    }
+#else
+    //Do nothing, other platform specific code could be added here
+    //with appropriate defines
+#endif
+
+    return rss;
+}
+
+double get_cpu_time() {
+    double cpu_time = 0.;
+
+#ifdef __unix__
+    rusage usage;
+    int result = getrusage(RUSAGE_SELF, &usage);
+
+    if (result == 0) { //Success
+        cpu_time = usage.ru_utime.tv_sec + usage.ru_stime.tv_sec
+                   + 1e-6 * (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+    }
+#else
+    //Do nothing, other platform specific code could be added here
+    //with appropriate defines
+#endif
+
+    return cpu_time;
+}
+
 } // namespace vtr
@@ -7,6 +7,14 @@ namespace vtr {
 //Returns the maximum resident set size in bytes,
 //or zero if unable to determine.
 size_t get_max_rss();
+
+//Returns the current resident set size in bytes,
+//or zero if unable to determine.
+size_t get_current_rss();
+
+//Returns the CPU time (user and system, over all threads) used by
+//the process in seconds, or zero if unable to determine.
+double get_cpu_time();
 } // namespace vtr
 
 #endif
@@ -1,5 +1,6 @@
 #ifndef VTR_SMALL_VECTOR
 #define VTR_SMALL_VECTOR
+#include <array>
 #include <memory>
 #include <algorithm>
 #include <limits>
@@ -174,7 +175,7 @@ class small_vector {
 
     const_pointer data() const {
         if (is_short()) {
-            short_.data_;
+            return short_.data_.data();
         }
         return long_.data_;
     }
@@ -416,53 +417,11 @@ class small_vector {
     }
 
     void swap(small_vector<T, S>& other) {
-        swap(*this, other);
+        swap_vectors(*this, other);
     }
 
     friend void swap(small_vector<T, S>& lhs, small_vector<T, S>& rhs) {
-        using std::swap;
-
-        if (lhs.is_short() && rhs.is_short()) {
-            //Both short
-            std::swap(lhs.short_, rhs.short_);
-        } else if (!lhs.is_short() && !rhs.is_short()) {
-            //Both long
-            std::swap(lhs.long_, rhs.long_);
-        } else {
-            //Mixed long/short
-            VTR_ASSERT_SAFE(lhs.is_short() != rhs.is_short());
-
-            auto& long_vec = ((lhs.is_short()) ? rhs : lhs);
-            auto& short_vec = ((lhs.is_short()) ? lhs : rhs);
-
-            //If the two vectors are in different formats we can't just swap them,
-            //since the short format has real values (potentially with destructors),
-            //while the long format has only basic data types.
-            //
-            //Instead we copy the short_vec values into long, destruct the original short_vec
-            //values and then set short_vec to point to long_vec's original buffer (avoids
-            //extra copy of long elements).
-
-            //Save long data
-            pointer long_buf = long_vec.long_.data_;
-            size_type long_size = long_vec.long_size_;
-            size_type long_capacity = long_vec.long_.capacity_;
-
-            //Copy short data into long
-            //
-            //Note that the long format contains only basic data types with no destructors to call,
-            //so we can use uninitialzed copy
-            std::uninitialized_copy(short_vec.short_.begin(), short_vec.short_.end(), long_vec.short_.data_);
-            long_vec.short_.size_ = short_vec.size();
-
-            //Destroy original elements in short
-            short_vec.destruct_elements();
-
-            //Copy long data into short
-            short_vec.long_.data = long_buf;
-            short_vec.long_.capacity_ = long_capacity;
-            short_vec.long_.size_ = long_size;
-        }
+        swap_vectors(lhs, rhs);
     }
 
     void clear() {
@@ -521,39 +480,22 @@ class small_vector {
         }
     }
 
-    small_vector(const small_vector& other) {
-        if (other.is_short()) {
-            ~small_vector(); //Clean-up elements
-
-            //Copy in place
-            short_ = other.short_;
-        } else {
-            if (!is_short() && capacity() >= other.size()) {
-                //Re-use existing buffer, since it has sufficient capacity
-                destruct_elements();
-
-            } else {
-                ~small_vector(); //Clean-up elements, potentially freeing buffer
-
-                //Create new buffer of exact size
-                long_.data_ = alloc(other.size());
-                long_.capacity_ = other.size();
-            }
-
-            set_size(other.size());
-
-            //Copy elements
-            std::uninitialized_copy(other.begin(), other.end(), long_.data_);
+    small_vector(const small_vector& other)
+        : small_vector() {
+        //Elements are stored in place if they fit, otherwise in a growing buffer
+        //(reserving upfront would switch an empty vector to a buffer which it does not use)
+        for (const value_type& value : other) {
+            push_back(value);
         }
     }
 
     small_vector(small_vector&& other)
         : small_vector() {
-        swap(*this, other); //Copy-swap
+        swap_vectors(*this, other); //Copy-swap
     }
 
     small_vector& operator=(small_vector other) {
-        swap(*this, other); //Copy-swap
+        swap_vectors(*this, other); //Copy-swap
         return *this;
     }
 
@@ -578,6 +520,51 @@ class small_vector {
     static constexpr size_t INPLACE_CAPACITY = SHORT_CAPACITY;
 
   private: //Internal methods
+    //Swaps the contents of two vectors, which may be in different formats
+    static void swap_vectors(small_vector<T, S>& lhs, small_vector<T, S>& rhs) {
+        if (lhs.is_short() && rhs.is_short()) {
+            //Both short
+            std::swap(lhs.short_, rhs.short_);
+        } else if (!lhs.is_short() && !rhs.is_short()) {
+            //Both long
+            std::swap(lhs.long_, rhs.long_);
+        } else {
+            //Mixed long/short
+            VTR_ASSERT_SAFE(lhs.is_short() != rhs.is_short());
+
+            auto& long_vec = ((lhs.is_short()) ? rhs : lhs);
+            auto& short_vec = ((lhs.is_short()) ? lhs : rhs);
+
+            //If the two vectors are in different formats we can't just swap them,
+            //since the short format has real values (potentially with destructors),
+            //while the long format has only basic data types.
+            //
+            //Instead we copy the short_vec values into long, destruct the original short_vec
+            //values and then set short_vec to point to long_vec's original buffer (avoids
+            //extra copy of long elements).
+
+            //Save long data
+            pointer long_buf = long_vec.long_.data_;
+            size_type long_size = long_vec.long_.size_;
+            size_type long_capacity = long_vec.long_.capacity_;
+
+            //Copy short data into long
+            //
+            //Note that the long format contains only basic data types with no destructors to call,
+            //so we can use uninitialzed copy
+            std::uninitialized_copy(short_vec.begin(), short_vec.end(), long_vec.short_.data_.data());
+            long_vec.set_size(short_vec.size());
+
+            //Destroy original elements in short
+            short_vec.destruct_elements();
+
+            //Copy long data into short
+            short_vec.long_.data_ = long_buf;
+            short_vec.long_.capacity_ = long_capacity;
+            short_vec.set_size(long_size);
+        }
+    }
+
     //Returns a pointer to the (uninitialized) location for the next element to be added.
     //Automatically grows the storage if needed.
     T* next_back() {
@@ -26,7 +26,8 @@ float Timer::delta_max_rss_mib() const {
 
 ScopedActionTimer::ScopedActionTimer(std::string action_str)
     : action_(action_str)
-    , depth_(f_timer_depth++) {
+    , depth_(f_timer_depth++)
+    , trace_event_(action_.c_str()) {
 }
 
 ScopedActionTimer::~ScopedActionTimer() {
@@ -3,6 +3,8 @@
 #include <chrono>
 #include <string>
 
+#include "vtr_trace.h"
+
 namespace vtr {
 
 //Class for tracking time elapsed since construction
@@ -53,6 +55,7 @@ class ScopedActionTimer : public Timer {
     const std::string action_;
     bool quiet_ = false;
     int depth_;
+    ScopedTraceEvent trace_event_; //Each timed action is also a trace event
 };
 
 //Scoped elapsed time class which prints the time elapsed for
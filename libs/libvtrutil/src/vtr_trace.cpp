@@ -0,0 +1,158 @@
+#include "vtr_trace.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "vtr_log.h"
+
+namespace vtr {
+
+namespace detail {
+std::atomic<bool> f_trace_enabled(false);
+} // namespace detail
+
+namespace {
+
+using clock = std::chrono::steady_clock;
+
+struct t_trace_event {
+    std::string name;
+    std::string detail;
+    int64_t start_us;
+    int64_t duration_us;
+};
+
+//The events recorded by a thread
+struct t_thread_trace {
+    size_t tid;
+    std::vector<t_trace_event> events;
+};
+
+//The traces of all the threads, which live until the end of the program
+//(so that they can be written at exit, after their threads have finished)
+struct t_trace {
+    std::mutex mutex;
+    std::string filename;
+    clock::time_point start = clock::now();
+    std::vector<std::unique_ptr<t_thread_trace>> thread_traces;
+};
+
+t_trace& get_trace() {
+    static t_trace trace;
+    return trace;
+}
+
+thread_local t_thread_trace* f_thread_trace = nullptr;
+
+t_thread_trace& get_thread_trace() {
+    if (!f_thread_trace) {
+        t_trace& trace = get_trace();
+        std::lock_guard<std::mutex> lock(trace.mutex);
+
+        trace.thread_traces.emplace_back(new t_thread_trace);
+        f_thread_trace = trace.thread_traces.back().get();
+        f_thread_trace->tid = trace.thread_traces.size();
+    }
+    return *f_thread_trace;
+}
+
+int64_t now_us() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - get_trace().start).count();
+}
+
+void write_json_string(std::ostream& os, const std::string& str) {
+    os << '"';
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            os << '\\' << c;
+        } else if (c == '\n') {
+            os << "\\n";
+        } else if (c == '\t') {
+            os << "\\t";
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            os << ' ';
+        } else {
+            os << c;
+        }
+    }
+    os << '"';
+}
+
+void write_trace_at_exit() {
+    write_trace();
+}
+
+} // namespace
+
+void enable_trace(const std::string& filename) {
+    t_trace& trace = get_trace();
+    {
+        std::lock_guard<std::mutex> lock(trace.mutex);
+
+        bool first_enable = trace.filename.empty();
+        trace.filename = filename;
+        if (first_enable) {
+            std::atexit(write_trace_at_exit);
+        }
+    }
+    detail::f_trace_enabled = true;
+}
+
+void write_trace() {
+    if (!trace_enabled()) {
+        return;
+    }
+
+    t_trace& trace = get_trace();
+    std::lock_guard<std::mutex> lock(trace.mutex);
+
+    std::ofstream os(trace.filename);
+    if (!os) {
+        VTR_LOG_WARN("Failed to open trace file '%s'\n", trace.filename.c_str());
+        return;
+    }
+
+    size_t num_events = 0;
+    os << "{\"traceEvents\":[\n";
+    for (const auto& thread_trace : trace.thread_traces) {
+        for (const t_trace_event& event : thread_trace->events) {
+            if (num_events++ > 0) {
+                os << ",\n";
+            }
+            os << "{\"name\":";
+            write_json_string(os, event.name);
+            os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread_trace->tid
+               << ",\"ts\":" << event.start_us << ",\"dur\":" << event.duration_us;
+            if (!event.detail.empty()) {
+                os << ",\"args\":{\"detail\":";
+                write_json_string(os, event.detail);
+                os << "}";
+            }
+            os << "}";
+        }
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    VTR_LOG("Wrote %zu trace events to '%s'\n", num_events, trace.filename.c_str());
+}
+
+void ScopedTraceEvent::begin(const char* name, const char* detail) {
+    name_ = name;
+    if (detail) {
+        detail_ = detail;
+    }
+    start_us_ = now_us();
+}
+
+void ScopedTraceEvent::end() {
+    int64_t end_us = now_us();
+
+    //Events are only appended by their own thread: no lock is needed
+    get_thread_trace().events.push_back({name_, std::move(detail_), start_us_, end_us - start_us_});
+}
+
+} // namespace vtr
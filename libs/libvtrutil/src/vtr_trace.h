@@ -0,0 +1,88 @@
+#ifndef VTR_TRACE_H
+#define VTR_TRACE_H
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/*
+ * Trace events
+ * ============
+ *
+ * A low-overhead record of the (nested) phases of a run, written in the Chrome
+ * trace-event JSON format, which can be viewed with chrome://tracing or Perfetto
+ * (https://ui.perfetto.dev).
+ *
+ * A phase is traced by a scoped object, which records a complete event (start time
+ * and duration) on the thread which created it:
+ *
+ *      {
+ *          vtr::ScopedTraceEvent trace_event("my_phase");
+ *
+ *          //Do work, possibly including other (nested) trace events
+ *      }
+ *
+ * Each vtr::ScopedActionTimer (e.g. vtr::ScopedStartFinishTimer) is also a trace event.
+ *
+ * Tracing is disabled by default, in which case a trace event only checks a flag.
+ * When enabled, the events are buffered per thread and written to the trace file at
+ * exit (or when write_trace() is called).
+ */
+
+namespace vtr {
+
+//Enables tracing. The trace is written to filename at program exit
+void enable_trace(const std::string& filename);
+
+//Writes the events recorded so far to the trace file (if tracing is enabled).
+//No other thread should be recording events at the same time
+void write_trace();
+
+namespace detail {
+extern std::atomic<bool> f_trace_enabled;
+} // namespace detail
+
+//Returns true if trace events are recorded
+inline bool trace_enabled() {
+    return detail::f_trace_enabled.load(std::memory_order_relaxed);
+}
+
+//Records a trace event for the duration of its scope.
+//name must outlive the object, detail (optional, e.g. the name of the
+//block being processed) is copied only if tracing is enabled
+class ScopedTraceEvent {
+  public:
+    ScopedTraceEvent(const char* name, const char* detail = nullptr) {
+        if (trace_enabled()) {
+            begin(name, detail);
+        }
+    }
+
+    ScopedTraceEvent(const char* name, const std::string& detail) {
+        if (trace_enabled()) {
+            begin(name, detail.c_str());
+        }
+    }
+
+    ~ScopedTraceEvent() {
+        if (name_) {
+            end();
+        }
+    }
+
+    //No copy
+    ScopedTraceEvent(const ScopedTraceEvent&) = delete;
+    ScopedTraceEvent& operator=(const ScopedTraceEvent&) = delete;
+
+  private:
+    void begin(const char* name, const char* detail);
+    void end();
+
+  private:
+    const char* name_ = nullptr; //Null if the event is not recorded
+    std::string detail_;
+    int64_t start_us_ = 0;
+};
+
+} // namespace vtr
+
+#endif
@@ -1,5 +1,6 @@
 #ifndef VTR_VECTOR
 #define VTR_VECTOR
+#include <memory>
 #include <vector>
 #include <cstddef>
 #include <iterator>
@@ -15,8 +16,11 @@ namespace vtr {
 //
 //If you need more std::map-like (instead of std::vector-like) behaviour see
 //vtr::vector_map.
-template<typename K, typename V>
-class vector : private std::vector<V> {
+//
+//The Allocator is the one of the underlying std::vector (e.g. vtr::TaggedAllocator
+//to attribute the memory of the container, see vtr_memory_stats.h).
+template<typename K, typename V, typename Allocator = std::allocator<V>>
+class vector : private std::vector<V, Allocator> {
   public:
     typedef K key_type;
 
@@ -25,71 +29,71 @@ class vector : private std::vector<V> {
 
   public:
     //Pass through std::vector's types
-    using typename std::vector<V>::value_type;
-    using typename std::vector<V>::allocator_type;
-    using typename std::vector<V>::reference;
-    using typename std::vector<V>::const_reference;
-    using typename std::vector<V>::pointer;
-    using typename std::vector<V>::const_pointer;
-    using typename std::vector<V>::iterator;
-    using typename std::vector<V>::const_iterator;
-    using typename std::vector<V>::reverse_iterator;
-    using typename std::vector<V>::const_reverse_iterator;
-    using typename std::vector<V>::difference_type;
-    using typename std::vector<V>::size_type;
+    using typename std::vector<V, Allocator>::value_type;
+    using typename std::vector<V, Allocator>::allocator_type;
+    using typename std::vector<V, Allocator>::reference;
+    using typename std::vector<V, Allocator>::const_reference;
+    using typename std::vector<V, Allocator>::pointer;
+    using typename std::vector<V, Allocator>::const_pointer;
+    using typename std::vector<V, Allocator>::iterator;
+    using typename std::vector<V, Allocator>::const_iterator;
+    using typename std::vector<V, Allocator>::reverse_iterator;
+    using typename std::vector<V, Allocator>::const_reverse_iterator;
+    using typename std::vector<V, Allocator>::difference_type;
+    using typename std::vector<V, Allocator>::size_type;
 
     //Pass through std::vector's methods
-    using std::vector<V>::vector;
-
-    using std::vector<V>::begin;
-    using std::vector<V>::end;
-    using std::vector<V>::rbegin;
-    using std::vector<V>::rend;
-    using std::vector<V>::cbegin;
-    using std::vector<V>::cend;
-    using std::vector<V>::crbegin;
-    using std::vector<V>::crend;
-
-    using std::vector<V>::size;
-    using std::vector<V>::max_size;
-    using std::vector<V>::resize;
-    using std::vector<V>::capacity;
-    using std::vector<V>::empty;
-    using std::vector<V>::reserve;
-    using std::vector<V>::shrink_to_fit;
-
-    using std::vector<V>::front;
-    using std::vector<V>::back;
-    using std::vector<V>::data;
-
-    using std::vector<V>::assign;
-    using std::vector<V>::push_back;
-    using std::vector<V>::pop_back;
-    using std::vector<V>::insert;
-    using std::vector<V>::erase;
-    using std::vector<V>::swap;
-    using std::vector<V>::clear;
-    using std::vector<V>::emplace;
-    using std::vector<V>::emplace_back;
-    using std::vector<V>::get_allocator;
+    using std::vector<V, Allocator>::vector;
+
+    using std::vector<V, Allocator>::begin;
+    using std::vector<V, Allocator>::end;
+    using std::vector<V, Allocator>::rbegin;
+    using std::vector<V, Allocator>::rend;
+    using std::vector<V, Allocator>::cbegin;
+    using std::vector<V, Allocator>::cend;
+    using std::vector<V, Allocator>::crbegin;
+    using std::vector<V, Allocator>::crend;
+
+    using std::vector<V, Allocator>::size;
+    using std::vector<V, Allocator>::max_size;
+    using std::vector<V, Allocator>::resize;
+    using std::vector<V, Allocator>::capacity;
+    using std::vector<V, Allocator>::empty;
+    using std::vector<V, Allocator>::reserve;
+    using std::vector<V, Allocator>::shrink_to_fit;
+
+    using std::vector<V, Allocator>::front;
+    using std::vector<V, Allocator>::back;
+    using std::vector<V, Allocator>::data;
+
+    using std::vector<V, Allocator>::assign;
+    using std::vector<V, Allocator>::push_back;
+    using std::vector<V, Allocator>::pop_back;
+    using std::vector<V, Allocator>::insert;
+    using std::vector<V, Allocator>::erase;
+    using std::vector<V, Allocator>::swap;
+    using std::vector<V, Allocator>::clear;
+    using std::vector<V, Allocator>::emplace;
+    using std::vector<V, Allocator>::emplace_back;
+    using std::vector<V, Allocator>::get_allocator;
 
     //Don't include operator[] and at() from std::vector,
     //since we redine them to take key_type instead of size_t
     reference operator[](const key_type id) {
         auto i = size_t(id);
-        return std::vector<V>::operator[](i);
+        return std::vector<V, Allocator>::operator[](i);
     }
     const_reference operator[](const key_type id) const {
         auto i = size_t(id);
-        return std::vector<V>::operator[](i);
+        return std::vector<V, Allocator>::operator[](i);
     }
     reference at(const key_type id) {
         auto i = size_t(id);
-        return std::vector<V>::at(i);
+        return std::vector<V, Allocator>::at(i);
     }
     const_reference at(const key_type id) const {
         auto i = size_t(id);
-        return std::vector<V>::at(i);
+        return std::vector<V, Allocator>::at(i);
     }
 
     //Returns a range containing the keys
@@ -0,0 +1,20 @@
+#include <string>
+
+#include "catch.hpp"
+
+#include "vtr_crc.h"
+
+TEST_CASE("CRC32C", "[vtr_crc]") {
+    //Check value of the CRC-32C specification
+    std::string check("123456789");
+    REQUIRE(vtr::crc32c(check.data(), check.size()) == 0xE3069283);
+
+    REQUIRE(vtr::crc32c(nullptr, 0) == 0);
+
+    //Incremental updates give the same checksum
+    std::string text("The quick brown fox jumps over the lazy dog");
+    uint32_t crc = vtr::crc32c(text.data(), 10);
+    crc = vtr::crc32c(text.data() + 10, text.size() - 10, crc);
+    REQUIRE(crc == vtr::crc32c(text.data(), text.size()));
+    REQUIRE(crc == 0x22620404);
+}
@@ -0,0 +1,60 @@
+#include <vector>
+
+#include "catch.hpp"
+
+#include "vtr_mapped_storage.h"
+#include "vtr_memory_stats.h"
+#include "vtr_vector.h"
+
+namespace {
+struct t_test_memory_tag {
+    static const char* name() { return "Mapped storage test"; }
+};
+} // namespace
+
+TEST_CASE("Mapped Storage Disabled", "[vtr_mapped_storage]") {
+    REQUIRE(!vtr::mapped_storage_enabled());
+
+    std::vector<size_t, vtr::MappedAllocator<size_t>> values;
+    for (size_t i = 0; i < 1000; ++i) {
+        values.push_back(i);
+    }
+    for (size_t i = 0; i < values.size(); ++i) {
+        REQUIRE(values[i] == i);
+    }
+}
+
+TEST_CASE("Mapped Storage", "[vtr_mapped_storage]") {
+    std::vector<size_t, vtr::MappedAllocator<size_t>> heap_values(100, 1);
+
+    std::vector<size_t, vtr::MappedAllocator<size_t>> values;
+    vtr::vector<size_t, char, vtr::TaggedAllocator<char, t_test_memory_tag, vtr::MappedAllocator<char>>> chars;
+    {
+        //Map any allocation of at least a page
+        vtr::ScopedMappedStorage mapped_storage("/tmp", 4096);
+        REQUIRE(vtr::mapped_storage_enabled());
+
+        for (size_t i = 0; i < 100000; ++i) {
+            values.push_back(i);
+        }
+        chars.resize(10000, 'a');
+        chars[size_t(9999)] = 'b';
+    }
+    REQUIRE(!vtr::mapped_storage_enabled());
+
+    //The memory mapped while enabled is still valid, and released on the heap after
+    for (size_t i = 0; i < values.size(); ++i) {
+        REQUIRE(values[i] == i);
+    }
+    REQUIRE(chars[size_t(0)] == 'a');
+    REQUIRE(chars[size_t(9999)] == 'b');
+
+    values.resize(200000, 3);
+    REQUIRE(values[99999] == 99999);
+    REQUIRE(values[199999] == 3);
+
+    values.clear();
+    values.shrink_to_fit();
+    heap_values.clear();
+    heap_values.shrink_to_fit();
+}
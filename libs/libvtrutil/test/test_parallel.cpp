@@ -0,0 +1,81 @@
+#include <atomic>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "vtr_parallel.h"
+
+TEST_CASE("Parallel For", "[vtr_parallel]") {
+    for (size_t num_threads : {1, 2, 8}) {
+        std::vector<size_t> squares(1000, 0);
+        vtr::parallel_for(squares.size(), num_threads, [&](size_t item) {
+            squares[item] = item * item;
+        });
+
+        for (size_t item = 0; item < squares.size(); ++item) {
+            REQUIRE(squares[item] == item * item);
+        }
+    }
+}
+
+TEST_CASE("Parallel For Workers", "[vtr_parallel]") {
+    const size_t num_threads = 4;
+    std::vector<size_t> items_per_worker(num_threads, 0);
+    std::atomic<bool> invalid_worker(false);
+
+    vtr::parallel_for_workers(100, num_threads, [&](size_t /*item*/, size_t worker) {
+        if (worker >= num_threads) {
+            invalid_worker = true;
+            return;
+        }
+        //Each worker only updates its own counter
+        ++items_per_worker[worker];
+    });
+
+    REQUIRE(!invalid_worker);
+    size_t num_items = 0;
+    for (size_t worker_items : items_per_worker) {
+        num_items += worker_items;
+    }
+    REQUIRE(num_items == 100);
+}
+
+TEST_CASE("Nested Parallel For", "[vtr_parallel]") {
+    std::vector<std::vector<size_t>> sums(8, std::vector<size_t>(8, 0));
+    std::atomic<size_t> num_outside_parallel(0);
+    std::atomic<size_t> num_nested_parallel(0);
+
+    //Catch assertions are not thread-safe, so the workers only count the failures
+    vtr::parallel_for(sums.size(), 4, [&](size_t i) {
+        if (!vtr::in_parallel_region()) {
+            ++num_outside_parallel;
+        }
+        //Nested loops are run serially by the worker
+        vtr::parallel_for_workers(sums[i].size(), 4, [&](size_t j, size_t worker) {
+            if (worker != 0) {
+                ++num_nested_parallel;
+            }
+            sums[i][j] = i + j;
+        });
+    });
+
+    REQUIRE(!vtr::in_parallel_region());
+    REQUIRE(num_outside_parallel == 0);
+    REQUIRE(num_nested_parallel == 0);
+    for (size_t i = 0; i < sums.size(); ++i) {
+        for (size_t j = 0; j < sums[i].size(); ++j) {
+            REQUIRE(sums[i][j] == i + j);
+        }
+    }
+}
+
+TEST_CASE("Default Number of Workers", "[vtr_parallel]") {
+    REQUIRE(vtr::num_workers() == 1);
+
+    vtr::set_num_workers(3);
+    REQUIRE(vtr::num_workers() == 3);
+
+    //At least one worker
+    vtr::set_num_workers(0);
+    REQUIRE(vtr::num_workers() == 1);
+}
@@ -146,3 +146,27 @@ TEST_CASE("Basic", "[vtr_small_vector]") {
     REQUIRE(ref == vec);
     ++i;
 }
+
+TEST_CASE("Small Vector Copy", "[vtr_small_vector]") {
+    //Both the in-place (short) and the heap-allocated (long) formats
+    for (size_t num_elems : {0, 1, 3, 10, 100}) {
+        vtr::small_vector<int> vec;
+        for (size_t i = 0; i < num_elems; ++i) {
+            vec.push_back(i);
+        }
+
+        REQUIRE(vec.data() == vec.begin());
+
+        vtr::small_vector<int> copy(vec);
+        REQUIRE(copy == vec);
+
+        vtr::small_vector<int> assigned;
+        assigned.push_back(42);
+        assigned = vec;
+        REQUIRE(assigned == vec);
+
+        //The copies are independent
+        vec.push_back(-1);
+        REQUIRE(copy.size() == num_elems);
+    }
+}
@@ -0,0 +1,261 @@
+/********************************************************************
+ * Micro-benchmarks of the core data structures and writers of OpenFPGA
+ *
+ * Each benchmark builds a synthetic database whose size is proportional
+ * to a scale factor, and reports the run-time per item
+ * for scale factors of 1, 2, 4, ..., up to the given maximum.
+ * A run-time per item which grows with the scale factor
+ * indicates a scaling regression, e.g., a quadratic look-up.
+ *
+ * Usage: openfpga_bench [max_scale] [output_directory]
+ *******************************************************************/
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_port.h"
+
+/* Headers from archopenfpga library */
+#include "circuit_library.h"
+
+/* Headers from fpgabitstream library */
+#include "bitstream_manager.h"
+#include "write_xml_arch_bitstream.h"
+#include "write_binary_arch_bitstream.h"
+
+#include "module_manager.h"
+#include "mux_graph.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Run a benchmark which processes a number of items once,
+ * and report its run-time in total and per item
+ *******************************************************************/
+static
+void run_benchmark(const std::string& bench_name,
+                   const size_t& scale,
+                   const size_t& num_items,
+                   const std::function<void()>& bench_func) {
+  vtr::Timer timer;
+  bench_func();
+  float runtime = timer.elapsed_sec();
+
+  VTR_LOG("%-40s scale=%-6lu items=%-10lu %10.6f s %10.2f ns/item\n",
+          bench_name.c_str(), scale, num_items,
+          runtime, 1e9 * runtime / std::max(num_items, size_t(1)));
+}
+
+/********************************************************************
+ * Module graph: a chain of instances of a cell,
+ * where each output pin of an instance drives an input pin of the next one
+ *******************************************************************/
+static
+void bench_module_manager(const size_t& scale) {
+  constexpr size_t CELL_PORT_WIDTH = 16;
+  const size_t num_instances = 256 * scale;
+
+  ModuleManager module_manager;
+  ModuleId cell_module = module_manager.add_module("bench_cell");
+  ModulePortId cell_in = module_manager.add_port(cell_module, BasicPort("in", CELL_PORT_WIDTH), ModuleManager::MODULE_INPUT_PORT);
+  ModulePortId cell_out = module_manager.add_port(cell_module, BasicPort("out", CELL_PORT_WIDTH), ModuleManager::MODULE_OUTPUT_PORT);
+
+  ModuleId top_module = module_manager.add_module("bench_top");
+  for (size_t inst = 0; inst < num_instances; ++inst) {
+    module_manager.add_child_module(top_module, cell_module);
+  }
+
+  const size_t num_nets = (num_instances - 1) * CELL_PORT_WIDTH;
+  run_benchmark("ModuleManager::create_module_net", scale, num_nets, [&]() {
+    for (size_t inst = 1; inst < num_instances; ++inst) {
+      for (size_t pin = 0; pin < CELL_PORT_WIDTH; ++pin) {
+        ModuleNetId net = module_manager.create_module_net(top_module);
+        module_manager.add_module_net_source(top_module, net, cell_module, inst - 1, cell_out, pin);
+        module_manager.add_module_net_sink(top_module, net, cell_module, inst, cell_in, pin);
+      }
+    }
+  });
+
+  run_benchmark("ModuleManager::module_instance_port_net", scale, num_nets, [&]() {
+    for (size_t inst = 1; inst < num_instances; ++inst) {
+      for (size_t pin = 0; pin < CELL_PORT_WIDTH; ++pin) {
+        ModuleNetId net = module_manager.module_instance_port_net(top_module, cell_module, inst, cell_in, pin);
+        VTR_ASSERT(ModuleNetId::INVALID() != net);
+      }
+    }
+  });
+
+  run_benchmark("ModuleManager::freeze_module_nets", scale, num_nets, [&]() {
+    module_manager.freeze_module_nets();
+  });
+
+  run_benchmark("ModuleManager::module_instance_port_net (frozen)", scale, num_nets, [&]() {
+    for (size_t inst = 1; inst < num_instances; ++inst) {
+      for (size_t pin = 0; pin < CELL_PORT_WIDTH; ++pin) {
+        ModuleNetId net = module_manager.module_instance_port_net(top_module, cell_module, inst, cell_in, pin);
+        VTR_ASSERT(ModuleNetId::INVALID() != net);
+      }
+    }
+  });
+}
+
+/********************************************************************
+ * Architecture bitstream: a two-level hierarchy of blocks,
+ * i.e., a number of tiles each of which contains a number of leaf blocks
+ * with a few configuration bits
+ *******************************************************************/
+static
+BitstreamManager build_bench_bitstream(const size_t& num_tiles,
+                                       const size_t& num_leaves_per_tile,
+                                       const size_t& num_bits_per_leaf) {
+  BitstreamManager bitstream_manager;
+  bitstream_manager.reserve_blocks(1 + num_tiles * (1 + num_leaves_per_tile));
+  bitstream_manager.reserve_bits(num_tiles * num_leaves_per_tile * num_bits_per_leaf);
+
+  ConfigBlockId top_block = bitstream_manager.add_block("fpga_top");
+  bitstream_manager.reserve_child_blocks(top_block, num_tiles);
+
+  std::vector<bool> leaf_bits(num_bits_per_leaf);
+  for (size_t tile = 0; tile < num_tiles; ++tile) {
+    ConfigBlockId tile_block = bitstream_manager.add_block("tile_" + std::to_string(tile));
+    bitstream_manager.add_child_block(top_block, tile_block);
+    bitstream_manager.reserve_child_blocks(tile_block, num_leaves_per_tile);
+    for (size_t leaf = 0; leaf < num_leaves_per_tile; ++leaf) {
+      ConfigBlockId leaf_block = bitstream_manager.add_block("mem_" + std::to_string(leaf));
+      bitstream_manager.add_child_block(tile_block, leaf_block);
+      for (size_t ibit = 0; ibit < num_bits_per_leaf; ++ibit) {
+        leaf_bits[ibit] = (0 == (tile + leaf + ibit) % 3);
+      }
+      bitstream_manager.add_block_bits(leaf_block, leaf_bits);
+    }
+  }
+
+  return bitstream_manager;
+}
+
+static
+void bench_bitstream_manager(const size_t& scale,
+                             const std::string& output_dir) {
+  constexpr size_t NUM_LEAVES_PER_TILE = 64;
+  constexpr size_t NUM_BITS_PER_LEAF = 16;
+  const size_t num_tiles = 64 * scale;
+  const size_t num_leaves = num_tiles * NUM_LEAVES_PER_TILE;
+
+  BitstreamManager bitstream_manager;
+  run_benchmark("BitstreamManager::add_block_bits", scale, num_leaves, [&]() {
+    bitstream_manager = build_bench_bitstream(num_tiles, NUM_LEAVES_PER_TILE, NUM_BITS_PER_LEAF);
+  });
+
+  /* Child blocks are searched in the reversed order of their creation */
+  ConfigBlockId top_block = *bitstream_manager.blocks().begin();
+  run_benchmark("BitstreamManager::find_child_block", scale, num_leaves, [&]() {
+    for (const ConfigBlockId& tile_block : bitstream_manager.block_children(top_block)) {
+      for (size_t leaf = NUM_LEAVES_PER_TILE; leaf > 0; --leaf) {
+        ConfigBlockId leaf_block = bitstream_manager.find_child_block(tile_block, "mem_" + std::to_string(leaf - 1));
+        VTR_ASSERT(ConfigBlockId::INVALID() != leaf_block);
+      }
+    }
+  });
+
+  if (true == output_dir.empty()) {
+    return;
+  }
+
+  const size_t num_bits = bitstream_manager.num_bits();
+  run_benchmark("write_xml_architecture_bitstream", scale, num_bits, [&]() {
+    write_xml_architecture_bitstream(bitstream_manager, output_dir + "/bench_arch_bitstream.xml");
+  });
+
+  run_benchmark("write_binary_architecture_bitstream", scale, num_bits, [&]() {
+    write_binary_architecture_bitstream(bitstream_manager, output_dir + "/bench_arch_bitstream.bin");
+  });
+}
+
+/********************************************************************
+ * Multiplexer graphs: build the graphs of multiplexers of increasing sizes
+ * for each structure, and decode the memory bits of every input
+ *******************************************************************/
+static
+void bench_mux_graph(const size_t& scale) {
+  CircuitLibrary circuit_lib;
+
+  CircuitModelId pgl_model = circuit_lib.add_model(CIRCUIT_MODEL_PASSGATE);
+  circuit_lib.set_model_name(pgl_model, "bench_tgate");
+  circuit_lib.set_model_is_default(pgl_model, true);
+  circuit_lib.set_pass_gate_logic_type(pgl_model, CIRCUIT_MODEL_PASS_GATE_TRANSMISSION);
+
+  std::vector<CircuitModelId> mux_models;
+  for (const e_circuit_model_structure& structure : {CIRCUIT_MODEL_STRUCTURE_TREE, CIRCUIT_MODEL_STRUCTURE_ONELEVEL, CIRCUIT_MODEL_STRUCTURE_MULTILEVEL}) {
+    CircuitModelId mux_model = circuit_lib.add_model(CIRCUIT_MODEL_MUX);
+    circuit_lib.set_model_name(mux_model, std::string("bench_mux_") + CIRCUIT_MODEL_STRUCTURE_TYPE_STRING[structure]);
+    circuit_lib.set_model_design_tech_type(mux_model, CIRCUIT_MODEL_DESIGN_CMOS);
+    circuit_lib.set_mux_structure(mux_model, structure);
+    if (CIRCUIT_MODEL_STRUCTURE_MULTILEVEL == structure) {
+      circuit_lib.set_mux_num_levels(mux_model, 2);
+    }
+    circuit_lib.set_model_pass_gate_logic(mux_model, circuit_lib.model_name(pgl_model));
+    mux_models.push_back(mux_model);
+  }
+  circuit_lib.build_model_links();
+
+  const size_t max_mux_size = 16 * scale;
+  for (const CircuitModelId& mux_model : mux_models) {
+    std::vector<MuxGraph> mux_graphs;
+    run_benchmark("MuxGraph::MuxGraph (" + circuit_lib.model_name(mux_model) + ")", scale, max_mux_size - 1, [&]() {
+      for (size_t mux_size = 2; mux_size <= max_mux_size; ++mux_size) {
+        mux_graphs.push_back(MuxGraph(circuit_lib, mux_model, mux_size));
+      }
+    });
+
+    size_t num_decodes = 0;
+    for (const MuxGraph& mux_graph : mux_graphs) {
+      num_decodes += mux_graph.num_inputs() * mux_graph.num_outputs();
+    }
+    run_benchmark("MuxGraph::decode_memory_bits (" + circuit_lib.model_name(mux_model) + ")", scale, num_decodes, [&]() {
+      for (const MuxGraph& mux_graph : mux_graphs) {
+        for (size_t input = 0; input < mux_graph.num_inputs(); ++input) {
+          for (size_t output = 0; output < mux_graph.num_outputs(); ++output) {
+            vtr::vector<MuxMemId, bool> mem_bits = mux_graph.decode_memory_bits(MuxInputId(input), MuxOutputId(output));
+            VTR_ASSERT(mem_bits.size() == mux_graph.num_memory_bits());
+          }
+        }
+      }
+    });
+  }
+}
+
+} /* end namespace openfpga */
+
+int main(int argc, const char** argv) {
+  /* Ensure we have zero to two arguments */
+  VTR_ASSERT((1 <= argc) && (argc <= 3));
+
+  size_t max_scale = 8;
+  if (2 <= argc) {
+    max_scale = std::strtoul(argv[1], nullptr, 10);
+  }
+  VTR_ASSERT(1 <= max_scale);
+
+  /* Writers are only timed when an output directory is given */
+  std::string output_dir;
+  if (3 <= argc) {
+    output_dir = argv[2];
+  }
+
+  for (size_t scale = 1; scale <= max_scale; scale *= 2) {
+    openfpga::bench_module_manager(scale);
+    openfpga::bench_bitstream_manager(scale, output_dir);
+    openfpga::bench_mux_graph(scale);
+  }
+
+  return 0;
+}
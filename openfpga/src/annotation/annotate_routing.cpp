@@ -2,48 +2,94 @@
  * This file includes functions that are used to annotate routing results
  * from VPR to OpenFPGA
  *******************************************************************/
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
+#include "vtr_parallel.h"
 
 #include "annotate_routing.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * Find the nets which are routed by VPR, whose routing results
+ * should be annotated
+ *******************************************************************/
+static 
+std::vector<ClusterNetId> find_routed_nets(const ClusteringContext& clustering_ctx) {
+  std::vector<ClusterNetId> routed_nets;
+  for (auto net_id : clustering_ctx.clb_nlist.nets()) {
+    /* Ignore nets that are not routed */
+    if (true == clustering_ctx.clb_nlist.net_is_ignored(net_id)) {
+      continue;
+    }
+    /* Ignore used in local cluster only, reserved one CLB pin */
+    if (false == clustering_ctx.clb_nlist.net_sinks(net_id).size()) {
+      continue;
+    }
+    routed_nets.push_back(net_id);
+  }
+  return routed_nets;
+}
+
+/********************************************************************
+ * Convert the routing traces of a net, which is a linked list,
+ * to an array of rr_nodes in the same order
+ *******************************************************************/
+static 
+std::vector<RRNodeId> build_net_routing_trace_nodes(const RoutingContext& routing_ctx,
+                                                    const ClusterNetId& net_id) {
+  std::vector<RRNodeId> trace_nodes;
+  t_trace* tptr = routing_ctx.trace[net_id].head;
+  while (tptr != nullptr) {
+    trace_nodes.push_back(tptr->index);
+    tptr = tptr->next;
+  }
+  return trace_nodes;
+}
+
 /********************************************************************
  * Create a mapping between each rr_node and its mapped nets 
  * based on VPR routing results
  * - Unmapped rr_node will use invalid ids 
+ *
+ * The rr_nodes of each net are found by a number of threads,
+ * and then annotated in the order of nets, 
+ * so that the results are the same regardless of the number of threads
  *******************************************************************/
 void annotate_rr_node_nets(const DeviceContext& device_ctx,
                            const ClusteringContext& clustering_ctx,
                            const RoutingContext& routing_ctx,
                            VprRoutingAnnotation& vpr_routing_annotation,
+                           const size_t& num_threads,
                            const bool& verbose) {
   size_t counter = 0;
   VTR_LOG("Annotating rr_node with routed nets...");
   VTR_LOGV(verbose, "\n");
-   
-  for (auto net_id : clustering_ctx.clb_nlist.nets()) {
-    /* Ignore nets that are not routed */
-    if (true == clustering_ctx.clb_nlist.net_is_ignored(net_id)) {
-      continue;
-    }
-    /* Ignore used in local cluster only, reserved one CLB pin */
-    if (false == clustering_ctx.clb_nlist.net_sinks(net_id).size()) {
-      continue;
-    }
-    t_trace* tptr = routing_ctx.trace[net_id].head;
-    while (tptr != nullptr) {
-      RRNodeId rr_node = tptr->index;
+
+  std::vector<ClusterNetId> routed_nets = find_routed_nets(clustering_ctx);
+  std::vector<std::vector<RRNodeId>> net_rr_nodes(routed_nets.size());
+
+  vtr::parallel_for(routed_nets.size(), num_threads,
+                    [&](const size_t& inet) {
+    for (const RRNodeId& rr_node : build_net_routing_trace_nodes(routing_ctx, routed_nets[inet])) {
       /* Ignore source and sink nodes, they are the common node multiple starting and ending points */
       if ( (SOURCE != device_ctx.rr_graph.node_type(rr_node)) 
         && (SINK != device_ctx.rr_graph.node_type(rr_node)) ) {
-        vpr_routing_annotation.set_rr_node_net(rr_node, net_id);
-        counter++;
+        net_rr_nodes[inet].push_back(rr_node);
       }
-      tptr = tptr->next;
+    }
+  });
+   
+  for (size_t inet = 0; inet < routed_nets.size(); ++inet) {
+    for (const RRNodeId& rr_node : net_rr_nodes[inet]) {
+      vpr_routing_annotation.set_rr_node_net(rr_node, routed_nets[inet]);
+      counter++;
     }
   }
 
@@ -57,11 +103,13 @@ void annotate_rr_node_nets(const DeviceContext& device_ctx,
  *
  * It requires a candidate which provided by upstream functions
  * Try to validate a candidate by searching it from driving node list
- * If not validated, try to find a right one in the routing traces
+ * If not validated, try to find a right one in the routing traces,
+ * where the first position of each node in the traces is given
  *******************************************************************/
 static 
 RRNodeId find_previous_node_from_routing_traces(const RRGraph& rr_graph,
-                                                t_trace* routing_trace_head,
+                                                const std::unordered_map<RRNodeId, size_t>& trace_node_positions,
+                                                const std::vector<RRNodeId>& trace_nodes,
                                                 const RRNodeId& prev_node_candidate,
                                                 const RRNodeId& cur_rr_node) {
   RRNodeId prev_node = prev_node_candidate;
@@ -97,27 +145,22 @@ RRNodeId find_previous_node_from_routing_traces(const RRGraph& rr_graph,
      * This search will find the first-fit and finish.
      * This is reasonable because if there is a second-fit, it should be a longer path
      * which should be considered in routing optimization
+     *
+     * The first-fit is the driving node which comes first in the traces,
+     * so that only the driving nodes are visited rather than the whole traces
      */
     if (false == valid_prev_node) {
-      t_trace* tptr = routing_trace_head;
-      while (tptr != nullptr) {
-        RRNodeId cand_prev_node = tptr->index;
-        bool is_good_cand = false;
-        for (const RREdgeId& in_edge : rr_graph.node_in_edges(cur_rr_node)) {
-          if (cand_prev_node == rr_graph.edge_src_node(in_edge)) {
-            is_good_cand = true;
-            break;
-          }
+      size_t first_position = trace_nodes.size();
+      for (const RREdgeId& in_edge : rr_graph.node_in_edges(cur_rr_node)) {
+        auto result = trace_node_positions.find(rr_graph.edge_src_node(in_edge));
+        if (result != trace_node_positions.end()) {
+          first_position = std::min(first_position, result->second);
         }
+      }
   
-        if (true == is_good_cand) {
-          /* Update prev_node */
-          prev_node = cand_prev_node;
-          break;
-        }
-
-        /* Move on to the next */
-        tptr = tptr->next;
+      if (first_position < trace_nodes.size()) {
+        /* Update prev_node */
+        prev_node = trace_nodes[first_position];
       }
     } 
   }
@@ -129,50 +172,63 @@ RRNodeId find_previous_node_from_routing_traces(const RRGraph& rr_graph,
  * Create a mapping between each rr_node and its previous node
  * based on VPR routing results
  * - Unmapped rr_node will have an invalid id of previous rr_node
+ *
+ * The previous nodes of each net are found by a number of threads,
+ * and then annotated in the order of nets, 
+ * so that the results are the same regardless of the number of threads
  *******************************************************************/
 void annotate_rr_node_previous_nodes(const DeviceContext& device_ctx,
                                      const ClusteringContext& clustering_ctx,
                                      const RoutingContext& routing_ctx,
                                      VprRoutingAnnotation& vpr_routing_annotation,
+                                     const size_t& num_threads,
                                      const bool& verbose) {
   size_t counter = 0;
   VTR_LOG("Annotating previous nodes for rr_node...");
   VTR_LOGV(verbose, "\n");
-   
-  for (auto net_id : clustering_ctx.clb_nlist.nets()) {
-    /* Ignore nets that are not routed */
-    if (true == clustering_ctx.clb_nlist.net_is_ignored(net_id)) {
-      continue;
-    }
-    /* Ignore used in local cluster only, reserved one CLB pin */
-    if (false == clustering_ctx.clb_nlist.net_sinks(net_id).size()) {
-      continue;
+
+  std::vector<ClusterNetId> routed_nets = find_routed_nets(clustering_ctx);
+  /* Pairs of a rr_node and its previous node for each net */
+  std::vector<std::vector<std::pair<RRNodeId, RRNodeId>>> net_prev_nodes(routed_nets.size());
+
+  vtr::parallel_for(routed_nets.size(), num_threads,
+                    [&](const size_t& inet) {
+    std::vector<RRNodeId> trace_nodes = build_net_routing_trace_nodes(routing_ctx, routed_nets[inet]);
+
+    /* Find the first position of each node in the traces, 
+     * as branching nodes appear more than once 
+     */
+    std::unordered_map<RRNodeId, size_t> trace_node_positions;
+    trace_node_positions.reserve(trace_nodes.size());
+    for (size_t inode = 0; inode < trace_nodes.size(); ++inode) {
+      trace_node_positions.emplace(trace_nodes[inode], inode);
     }
-    
+
     /* Cache Previous nodes */
     RRNodeId prev_node = RRNodeId::INVALID();
 
-    t_trace* tptr = routing_ctx.trace[net_id].head;
-    while (tptr != nullptr) {
-      RRNodeId rr_node = tptr->index;
-
+    for (const RRNodeId& rr_node : trace_nodes) {
       /* Find the right previous node */
       prev_node = find_previous_node_from_routing_traces(device_ctx.rr_graph,
-                                                         routing_ctx.trace[net_id].head,
+                                                         trace_node_positions,
+                                                         trace_nodes,
                                                          prev_node,
                                                          rr_node);
 
       /* Only update mapped nodes */
       if (prev_node) {
-        vpr_routing_annotation.set_rr_node_prev_node(rr_node, prev_node);
-        counter++;
+        net_prev_nodes[inet].push_back(std::make_pair(rr_node, prev_node));
       }
 
       /* Update prev_node */
       prev_node = rr_node;
+    }
+  });
 
-      /* Move on to the next */
-      tptr = tptr->next;
+  for (size_t inet = 0; inet < routed_nets.size(); ++inet) {
+    for (const std::pair<RRNodeId, RRNodeId>& prev_node : net_prev_nodes[inet]) {
+      vpr_routing_annotation.set_rr_node_prev_node(prev_node.first, prev_node.second);
+      counter++;
     }
   }
 
@@ -180,4 +236,3 @@ void annotate_rr_node_previous_nodes(const DeviceContext& device_ctx,
 }
 
 } /* end namespace openfpga */
-
@@ -19,12 +19,14 @@ void annotate_rr_node_nets(const DeviceContext& device_ctx,
                            const ClusteringContext& clustering_ctx,
                            const RoutingContext& routing_ctx,
                            VprRoutingAnnotation& vpr_routing_annotation,
+                           const size_t& num_threads,
                            const bool& verbose);
 
 void annotate_rr_node_previous_nodes(const DeviceContext& device_ctx,
                                      const ClusteringContext& clustering_ctx,
                                      const RoutingContext& routing_ctx,
                                      VprRoutingAnnotation& vpr_routing_annotation,
+                                     const size_t& num_threads,
                                      const bool& verbose);
 
 } /* end namespace openfpga */
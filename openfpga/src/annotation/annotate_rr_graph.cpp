@@ -2,10 +2,12 @@
  * This file includes functions that are used to annotate device-level
  * information, in particular the routing resource graph
  *******************************************************************/
+
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
+#include "vtr_parallel.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_side_manager.h"
@@ -654,9 +656,128 @@ RRGSB build_rr_gsb(const DeviceContext& vpr_device_ctx,
   }
 }
 
+/********************************************************************
+ * Build a General Switch Block (GSB) from the one found by
+ * the tileable rr_graph builder, which holds the same channel nodes
+ * and pins as build_rr_gsb() would collect.
+ * Only the pins have to be filtered again, because the direct connections and
+ * configurable edges are not known when the tileable builder creates the GSB.
+ * The border sides are cleared in the same way as build_rr_gsb()
+ *******************************************************************/
+static 
+RRGSB build_rr_gsb_from_tileable_gsb(const DeviceContext& vpr_device_ctx, 
+                                     const vtr::Point<size_t>& gsb_range,
+                                     const RRGSB& tileable_gsb) {
+  const RRGraph& rr_graph = vpr_device_ctx.rr_graph;
+
+  /* Create an object to return */
+  RRGSB rr_gsb(false);
+
+  vtr::Point<size_t> gsb_coord = tileable_gsb.get_sb_coordinate();
+  VTR_ASSERT(gsb_coord.x() <= gsb_range.x()); 
+  VTR_ASSERT(gsb_coord.y() <= gsb_range.y()); 
+
+  /* Coordinator initialization */
+  rr_gsb.set_coordinate(gsb_coord.x(), gsb_coord.y());
+
+  /* Basic information*/
+  rr_gsb.init_num_sides(4); /* Fixed number of sides */
+
+  /* Side: TOP => 0, RIGHT => 1, BOTTOM => 2, LEFT => 3 */
+  for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+    SideManager side_manager(side);
+    e_side gsb_side = side_manager.get_side();
+
+    /* For the border, we should take special care */
+    if ( ((TOP == gsb_side) && (gsb_coord.y() == gsb_range.y()))
+      || ((RIGHT == gsb_side) && (gsb_coord.x() == gsb_range.x()))
+      || ((BOTTOM == gsb_side) && (0 == gsb_coord.y()))
+      || ((LEFT == gsb_side) && (0 == gsb_coord.x())) ) {
+      rr_gsb.clear_one_side(gsb_side);
+      continue;
+    }
+
+    /* Routing channels: the segments are taken from the rr_graph,
+     * which have been linked to the rr_nodes after the GSB is created
+     */
+    if (0 < tileable_gsb.get_chan_width(gsb_side)) {
+      RRChan rr_chan;
+      rr_chan.set_type(tileable_gsb.get_chan_type(gsb_side)); 
+      std::vector<enum PORTS> rr_chan_dir;
+      for (size_t itrack = 0; itrack < tileable_gsb.get_chan_width(gsb_side); ++itrack) {
+        const RRNodeId& chan_node = tileable_gsb.get_chan_node(gsb_side, itrack);
+        rr_chan.add_node(rr_graph, chan_node, rr_graph.node_segment(chan_node));
+        rr_chan_dir.push_back(tileable_gsb.get_chan_node_direction(gsb_side, itrack));
+      }
+      rr_gsb.add_chan_node(gsb_side, rr_chan, rr_chan_dir);
+    }
+
+    /* Fill opin_rr_nodes */
+    for (size_t inode = 0; inode < tileable_gsb.get_num_opin_nodes(gsb_side); ++inode) {
+      const RRNodeId& opin_node = tileable_gsb.get_opin_node(gsb_side, inode);
+      /* Skip those has no configurable outgoing, they should NOT appear in the GSB connection
+       * This is for those grid output pins used by direct connections
+       */
+      if (0 == std::distance(rr_graph.node_configurable_out_edges(opin_node).begin(),
+                             rr_graph.node_configurable_out_edges(opin_node).end())) {
+        continue;
+      }
+
+      /* Do not consider OPINs that directly drive an IPIN
+       * they are supposed to be handled by direct connection
+       */
+      if (true == is_opin_direct_connected_ipin(rr_graph, opin_node)) { 
+        continue;
+      }
+
+      rr_gsb.add_opin_node(opin_node, gsb_side);
+    }
+
+    /* Clean ipin_rr_nodes */
+    /* We do not have any IPIN for a Switch Block */
+    rr_gsb.clear_ipin_nodes(gsb_side);
+  }
+
+  /* Fill the ipin nodes of connection blocks */
+  for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+    SideManager side_manager(side);
+    e_side gsb_side = side_manager.get_side();
+
+    /* If there is no channel at this side, we skip ipin_node annotation */
+    e_side chan_side = ((TOP == gsb_side) || (BOTTOM == gsb_side)) ? LEFT : TOP;
+    if (0 == rr_gsb.get_chan_width(chan_side)) {
+      continue;
+    }
+
+    for (size_t inode = 0; inode < tileable_gsb.get_num_ipin_nodes(gsb_side); ++inode) {
+      const RRNodeId& ipin_node = tileable_gsb.get_ipin_node(gsb_side, inode);
+      /* Skip those has no configurable outgoing, they should NOT appear in the GSB connection
+       * This is for those grid output pins used by direct connections
+       */
+      if (0 == std::distance(rr_graph.node_configurable_in_edges(ipin_node).begin(),
+                             rr_graph.node_configurable_in_edges(ipin_node).end())) {
+        continue;
+      }
+
+      /* Do not consider IPINs that are directly connected by an OPIN
+       * they are supposed to be handled by direct connection
+       */
+      if (true == is_ipin_direct_connected_opin(rr_graph, ipin_node)) { 
+        continue;
+      }
+
+      rr_gsb.add_ipin_node(ipin_node, gsb_side);
+    }
+  }
+
+  return rr_gsb;
+}
+
 /********************************************************************
  * Build the annotation for the routing resource graph
  * by collecting the nodes to the General Switch Block context
+ * When the rr_graph is built by the tileable builder, the GSBs it has found
+ * are reused instead of collecting the nodes again
  *******************************************************************/
 void annotate_device_rr_gsb(const DeviceContext& vpr_device_ctx, 
                             DeviceRRGSB& device_rr_gsb,
@@ -673,6 +794,14 @@ void annotate_device_rr_gsb(const DeviceContext& vpr_device_ctx,
            "Start annotation GSB up to [%lu][%lu]\n",
            gsb_range.x(), gsb_range.y());
 
+  /* The GSBs of the tileable builder are only valid for the same device,
+   * and do not include the nodes required by GSB routing
+   */
+  bool reuse_tileable_gsbs = (false == enable_gsb_routing)
+                          && (vpr_device_ctx.rr_gsbs.size() == gsb_range.x() * gsb_range.y());
+  VTR_LOGV(verbose_output && reuse_tileable_gsbs, 
+           "Reuse the GSBs built with the tileable routing resource graph\n");
+
   size_t gsb_cnt = 0;
   /* For each switch block, determine the size of array */
   for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
@@ -680,8 +809,12 @@ void annotate_device_rr_gsb(const DeviceContext& vpr_device_ctx,
       /* Here we give the builder the fringe coordinates so that it can handle the GSBs at the borderside correctly
        * sort drive_rr_nodes should be called if required by users
        */
-      const RRGSB& rr_gsb = build_rr_gsb(vpr_device_ctx, 
-                                         vtr::Point<size_t>(vpr_device_ctx.grid.width() - 2, vpr_device_ctx.grid.height() - 2), /* todo: coordinate may need to be calibrated */
+      vtr::Point<size_t> gsb_fringe(vpr_device_ctx.grid.width() - 2, vpr_device_ctx.grid.height() - 2); /* todo: coordinate may need to be calibrated */
+      const RRGSB& rr_gsb = reuse_tileable_gsbs
+                          ? build_rr_gsb_from_tileable_gsb(vpr_device_ctx, gsb_fringe,
+                                                           vpr_device_ctx.rr_gsbs[ix * gsb_range.y() + iy])
+                          : build_rr_gsb(vpr_device_ctx, 
+                                         gsb_fringe,
                                          vtr::Point<size_t>(ix, iy),
                                          enable_gsb_routing);
       /* Add to device_rr_gsb */
@@ -702,9 +835,12 @@ void annotate_device_rr_gsb(const DeviceContext& vpr_device_ctx,
 /********************************************************************
  * Sort all the incoming edges for each channel node which are
  * output ports of the GSB
+ * The edges of each GSB are sorted with the read-only rr_graph only, 
+ * so that the columns of the GSB array are sorted by independent worker threads
  *******************************************************************/
 void sort_device_rr_gsb_chan_node_in_edges(const RRGraph& rr_graph,
                                            DeviceRRGSB& device_rr_gsb,
+                                           const size_t& num_threads,
                                            const bool& verbose_output) {
   vtr::ScopedStartFinishTimer timer("Sort incoming edges for each routing track output node of General Switch Block(GSB)");
 
@@ -715,23 +851,14 @@ void sort_device_rr_gsb_chan_node_in_edges(const RRGraph& rr_graph,
            "Start sorting edges for GSBs up to [%lu][%lu]\n",
            gsb_range.x(), gsb_range.y());
 
-  size_t gsb_cnt = 0;
-
-  /* For each switch block, determine the size of array */
-  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+  /* Columns are dispatched on demand, as the GSB complexity varies across the device */
+  vtr::parallel_for(gsb_range.x(), num_threads, [&](const size_t& ix) {
     for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
       vtr::Point<size_t> gsb_coordinate(ix, iy);
       RRGSB& rr_gsb = device_rr_gsb.get_mutable_gsb(gsb_coordinate);
       rr_gsb.sort_chan_node_in_edges(rr_graph);
-
-      gsb_cnt++; /* Update counter */
-
-      /* Print info */
-      VTR_LOG("[%lu%] Sorted edges for GSB[%lu][%lu]\r",
-              100 * gsb_cnt / (gsb_range.x() * gsb_range.y()), 
-              ix, iy);
     } 
-  }
+  });
 
   /* Report number of unique mirrors */
   VTR_LOG("Sorted edges for %d General Switch Blocks (GSBs).\n",
@@ -27,6 +27,7 @@ void annotate_device_rr_gsb(const DeviceContext& vpr_device_ctx,
 
 void sort_device_rr_gsb_chan_node_in_edges(const RRGraph& rr_graph,
                                            DeviceRRGSB& device_rr_gsb,
+                                           const size_t& num_threads,
                                            const bool& verbose_output);
 
 void annotate_rr_graph_circuit_models(const DeviceContext& vpr_device_ctx, 
@@ -3,13 +3,19 @@
  * in the users' BLIF netlist that violates the syntax of OpenFPGA
  * fabric generator, i.e., Verilog generator and SPICE generator
  *******************************************************************/
+#include <algorithm>
+#include <array>
+#include <cstdlib>
 #include <string>
 #include <fstream>
+#include <unordered_set>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
+#include "vtr_parallel.h"
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
@@ -20,6 +26,7 @@
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
 
+#include "openfpga_command_threads.h"
 #include "check_netlist_naming_conflict.h"
 
 /* Include global variables of VPR */
@@ -28,17 +35,52 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * A lookup table of the sensitive characters, indexed by the characters
+ * (as unsigned char), which gives the character to fix a sensitive character,
+ * or '\0' for any other character.
+ * This avoids searching the list of sensitive characters for each character of a name
+ *******************************************************************/
+typedef std::array<char, 256> t_sensitive_char_table;
+
+static 
+t_sensitive_char_table build_sensitive_char_table(const std::string& sensitive_chars,
+                                                  const std::string& fix_chars) {
+  VTR_ASSERT(sensitive_chars.length() == fix_chars.length());
+
+  t_sensitive_char_table char_table;
+  char_table.fill('\0');
+  for (size_t ichar = 0; ichar < sensitive_chars.length(); ++ichar) {
+    char_table[static_cast<unsigned char>(sensitive_chars[ichar])] = fix_chars[ichar];
+  }
+
+  return char_table;
+}
+
 /********************************************************************
  * This function aims to check if the name contains any of the 
  * sensitive characters in the list
  * Return a string of sensitive characters which are contained
- * in the name
+ * in the name, in the order of the list
  *******************************************************************/
 static 
 std::string name_contain_sensitive_chars(const std::string& name, 
-                                         const std::string& sensitive_chars) {
+                                         const std::string& sensitive_chars,
+                                         const t_sensitive_char_table& char_table) {
   std::string violation;
 
+  /* Most names are legal, and are scanned only once */
+  bool legal_name = true;
+  for (const char& name_char : name) {
+    if ('\0' != char_table[static_cast<unsigned char>(name_char)]) {
+      legal_name = false;
+      break;
+    }
+  }
+  if (true == legal_name) {
+    return violation;
+  }
+
   for (const char& sensitive_char : sensitive_chars) {
     /* Return true since we find a characters */
     if (std::string::npos != name.find(sensitive_char)) {
@@ -56,24 +98,47 @@ std::string name_contain_sensitive_chars(const std::string& name,
  *******************************************************************/
 static 
 std::string fix_name_contain_sensitive_chars(const std::string& name, 
-                                             const std::string& sensitive_chars,
-                                             const std::string& fix_chars) {
+                                             const t_sensitive_char_table& char_table) {
   std::string fixed_name = name;
 
-  VTR_ASSERT(sensitive_chars.length() == fix_chars.length());
-
-  for (size_t ichar = 0; ichar < sensitive_chars.length(); ++ichar) {
-    /* Keep fixing the characters until we cannot find anymore */
-    std::string::size_type pos = 0u;
-    while (std::string::npos != (pos = fixed_name.find(sensitive_chars[ichar], pos))) {
-      fixed_name.replace(pos, 1, std::string(1, fix_chars[ichar]));
-      pos += 1;
+  for (char& name_char : fixed_name) {
+    const char& fix_char = char_table[static_cast<unsigned char>(name_char)];
+    if ('\0' != fix_char) {
+      name_char = fix_char;
     }
   }
 
   return fixed_name;
 }
 
+/********************************************************************
+ * Find the sensitive characters in a number of names, i.e., those of the
+ * blocks or the nets of a netlist, where name_of(index) gives the i-th name
+ * Names are checked in parallel, and the violations are returned 
+ * in the order of names, so that they are reported in the same order 
+ * regardless of the number of threads
+ *******************************************************************/
+template <class NameFunc>
+static 
+std::vector<std::string> find_names_contain_sensitive_chars(const size_t& num_names,
+                                                            const NameFunc& name_of,
+                                                            const std::string& sensitive_chars,
+                                                            const t_sensitive_char_table& char_table,
+                                                            const size_t& num_threads) {
+  std::vector<std::string> violations(num_names);
+
+  /* Names are short, so each worker checks a chunk of names at a time */
+  constexpr size_t CHUNK_SIZE = 1024;
+  const size_t num_chunks = (num_names + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  vtr::parallel_for(num_chunks, num_threads, [&](const size_t& chunk) {
+    for (size_t iname = chunk * CHUNK_SIZE; iname < std::min(num_names, (chunk + 1) * CHUNK_SIZE); ++iname) {
+      violations[iname] = name_contain_sensitive_chars(name_of(iname), sensitive_chars, char_table);
+    }
+  });
+
+  return violations;
+}
+
 /********************************************************************
  * Detect and report any naming conflict by checking a list of 
  * sensitive characters
@@ -84,27 +149,37 @@ std::string fix_name_contain_sensitive_chars(const std::string& name,
  *******************************************************************/
 static 
 size_t detect_netlist_naming_conflict(const AtomNetlist& atom_netlist,
-                                    const std::string& sensitive_chars) {
+                                      const std::string& sensitive_chars,
+                                      const t_sensitive_char_table& char_table,
+                                      const size_t& num_threads) {
   size_t num_conflicts = 0;
 
   /* Walk through blocks in the netlist */
-  for (const auto& block : atom_netlist.blocks()) {
-    const std::string& block_name = atom_netlist.block_name(block);
-    const std::string& violation = name_contain_sensitive_chars(block_name, sensitive_chars);
-    if (false == violation.empty()) {
+  std::vector<AtomBlockId> blocks(atom_netlist.blocks().begin(), atom_netlist.blocks().end());
+  auto block_name_of = [&](const size_t& iblock) -> const std::string& {
+    return atom_netlist.block_name(blocks[iblock]);
+  };
+  std::vector<std::string> block_violations = find_names_contain_sensitive_chars(blocks.size(), block_name_of,
+                                                                                 sensitive_chars, char_table, num_threads);
+  for (size_t iblock = 0; iblock < blocks.size(); ++iblock) {
+    if (false == block_violations[iblock].empty()) {
       VTR_LOG("Block '%s' contains illegal characters '%s'\n",
-              block_name.c_str(), violation.c_str());
+              block_name_of(iblock).c_str(), block_violations[iblock].c_str());
       num_conflicts++;
     }
   }
 
   /* Walk through nets in the netlist */
-  for (const auto& net : atom_netlist.nets()) {
-    const std::string& net_name = atom_netlist.net_name(net);
-    const std::string& violation = name_contain_sensitive_chars(net_name, sensitive_chars);
-    if (false == violation.empty()) {
+  std::vector<AtomNetId> nets(atom_netlist.nets().begin(), atom_netlist.nets().end());
+  auto net_name_of = [&](const size_t& inet) -> const std::string& {
+    return atom_netlist.net_name(nets[inet]);
+  };
+  std::vector<std::string> net_violations = find_names_contain_sensitive_chars(nets.size(), net_name_of,
+                                                                               sensitive_chars, char_table, num_threads);
+  for (size_t inet = 0; inet < nets.size(); ++inet) {
+    if (false == net_violations[inet].empty()) {
       VTR_LOG("Net '%s' contains illegal characters '%s'\n",
-              net_name.c_str(), violation.c_str());
+              net_name_of(inet).c_str(), net_violations[inet].c_str());
       num_conflicts++;
     }
   }
@@ -112,6 +187,45 @@ size_t detect_netlist_naming_conflict(const AtomNetlist& atom_netlist,
   return num_conflicts;
 } 
 
+/********************************************************************
+ * Report the fixed names which are the same as the name of another 
+ * block (or net), either the original name or the fixed one,
+ * e.g., 'a.b' and 'a_b' are both named 'a_b' after the fix-up
+ * Names are given by name_of(index), and fixed names by fixed_names,
+ * which are empty for the names which are not fixed
+ * Return the number of fixed names that collide
+ *******************************************************************/
+template <class NameFunc>
+static 
+size_t report_fixed_name_collisions(const std::string& name_type,
+                                    const size_t& num_names,
+                                    const NameFunc& name_of,
+                                    const std::vector<std::string>& fixed_names) {
+  size_t num_collisions = 0;
+
+  std::unordered_set<std::string> unique_names;
+  unique_names.reserve(num_names);
+  for (size_t iname = 0; iname < num_names; ++iname) {
+    if (true == fixed_names[iname].empty()) {
+      unique_names.insert(name_of(iname));
+    }
+  }
+
+  for (size_t iname = 0; iname < num_names; ++iname) {
+    if (true == fixed_names[iname].empty()) {
+      continue;
+    }
+    if (false == unique_names.insert(fixed_names[iname]).second) {
+      VTR_LOG_WARN("%s '%s' is renamed to '%s', which is the name of another %s!\n",
+                   name_type.c_str(), name_of(iname).c_str(), fixed_names[iname].c_str(),
+                   name_type.c_str());
+      num_collisions++;
+    }
+  }
+
+  return num_collisions;
+}
+
 /********************************************************************
  * Correct and report any naming conflict by checking a list of 
  * sensitive characters
@@ -119,41 +233,60 @@ size_t detect_netlist_naming_conflict(const AtomNetlist& atom_netlist,
  *   any sensitive character
  * - Iterate over all the nets and correct any net name that contains
  *   any sensitive character
+ * The names are checked in parallel, and then fixed and annotated 
+ * in the order of blocks and nets
  *******************************************************************/
 static 
 void fix_netlist_naming_conflict(const AtomNetlist& atom_netlist,
                                  const std::string& sensitive_chars,
-                                 const std::string& fix_chars,
+                                 const t_sensitive_char_table& char_table,
+                                 const size_t& num_threads,
                                  VprNetlistAnnotation& vpr_netlist_annotation) {
   size_t num_fixes = 0;
+  size_t num_collisions = 0;
 
   /* Walk through blocks in the netlist */
-  for (const auto& block : atom_netlist.blocks()) {
-    const std::string& block_name = atom_netlist.block_name(block);
-    const std::string& violation = name_contain_sensitive_chars(block_name, sensitive_chars);
-
-    if (false == violation.empty()) {
+  std::vector<AtomBlockId> blocks(atom_netlist.blocks().begin(), atom_netlist.blocks().end());
+  auto block_name_of = [&](const size_t& iblock) -> const std::string& {
+    return atom_netlist.block_name(blocks[iblock]);
+  };
+  std::vector<std::string> fixed_block_names = find_names_contain_sensitive_chars(blocks.size(), block_name_of,
+                                                                                  sensitive_chars, char_table, num_threads);
+  for (size_t iblock = 0; iblock < blocks.size(); ++iblock) {
+    if (false == fixed_block_names[iblock].empty()) {
       /* Apply fix-up here */
-      vpr_netlist_annotation.rename_block(block, fix_name_contain_sensitive_chars(block_name, sensitive_chars, fix_chars)); 
+      fixed_block_names[iblock] = fix_name_contain_sensitive_chars(block_name_of(iblock), char_table);
+      vpr_netlist_annotation.rename_block(blocks[iblock], fixed_block_names[iblock]); 
       num_fixes++;
     }
   }
+  num_collisions += report_fixed_name_collisions(std::string("Block"), blocks.size(), block_name_of, fixed_block_names);
 
   /* Walk through nets in the netlist */
-  for (const auto& net : atom_netlist.nets()) {
-    const std::string& net_name = atom_netlist.net_name(net);
-    const std::string& violation = name_contain_sensitive_chars(net_name, sensitive_chars);
-    if (false == violation.empty()) {
+  std::vector<AtomNetId> nets(atom_netlist.nets().begin(), atom_netlist.nets().end());
+  auto net_name_of = [&](const size_t& inet) -> const std::string& {
+    return atom_netlist.net_name(nets[inet]);
+  };
+  std::vector<std::string> fixed_net_names = find_names_contain_sensitive_chars(nets.size(), net_name_of,
+                                                                                sensitive_chars, char_table, num_threads);
+  for (size_t inet = 0; inet < nets.size(); ++inet) {
+    if (false == fixed_net_names[inet].empty()) {
       /* Apply fix-up here */
-      vpr_netlist_annotation.rename_net(net, fix_name_contain_sensitive_chars(net_name, sensitive_chars, fix_chars)); 
+      fixed_net_names[inet] = fix_name_contain_sensitive_chars(net_name_of(inet), char_table);
+      vpr_netlist_annotation.rename_net(nets[inet], fixed_net_names[inet]); 
       num_fixes++;
     }
   }
+  num_collisions += report_fixed_name_collisions(std::string("Net"), nets.size(), net_name_of, fixed_net_names);
 
   if (0 < num_fixes) {
     VTR_LOG("Fixed %ld naming conflicts in the netlist.\n",
             num_fixes);
   }
+  if (0 < num_collisions) {
+    VTR_LOG_WARN("%ld fixed names are not unique in the netlist. Please correct so as to use any fabric generators.\n",
+                 num_collisions);
+  }
 }
 
 /********************************************************************
@@ -165,7 +298,7 @@ void print_netlist_naming_fix_report(const std::string& fname,
                                      const AtomNetlist& atom_netlist,
                                      const VprNetlistAnnotation& vpr_netlist_annotation) {
   /* Create a file handler */
-  std::fstream fp;
+  BufferedFileStream fp;
   /* Open the file stream */
   fp.open(fname, std::fstream::out | std::fstream::trunc);
 
@@ -224,11 +357,19 @@ int check_netlist_naming_conflict(OpenfpgaContext& openfpga_context,
   const std::string& sensitive_chars(".,:;\'\"+-<>()[]{}!@#$%^&*~`?/");
   const std::string&       fix_chars("____________________________");
 
+  const t_sensitive_char_table& char_table = build_sensitive_char_table(sensitive_chars, fix_chars);
+
   CommandOptionId opt_fix = cmd.option("fix");
 
+  int num_threads = get_num_threads(cmd, cmd_context, vtr::num_workers());
+  if (0 == num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Do the main job first: detect any naming in the BLIF netlist that violates the syntax */
   if (false == cmd_context.option_enable(cmd, opt_fix)) {
-    size_t num_conflicts = detect_netlist_naming_conflict(g_vpr_ctx.atom().nlist, sensitive_chars); 
+    size_t num_conflicts = detect_netlist_naming_conflict(g_vpr_ctx.atom().nlist, sensitive_chars,
+                                                          char_table, size_t(num_threads)); 
     VTR_LOGV_ERROR((0 < num_conflicts && (false == cmd_context.option_enable(cmd, opt_fix))),
                   "Found %ld naming conflicts in the netlist. Please correct so as to use any fabric generators.\n",
                   num_conflicts);
@@ -248,7 +389,8 @@ int check_netlist_naming_conflict(OpenfpgaContext& openfpga_context,
   /* If the auto correction is enabled, we apply a fix */
   if (true == cmd_context.option_enable(cmd, opt_fix)) {
     fix_netlist_naming_conflict(g_vpr_ctx.atom().nlist, sensitive_chars,
-                                fix_chars, openfpga_context.mutable_vpr_netlist_annotation());
+                                char_table, size_t(num_threads),
+                                openfpga_context.mutable_vpr_netlist_annotation());
 
     CommandOptionId opt_report = cmd.option("report");
     if (true == cmd_context.option_enable(cmd, opt_report)) {
@@ -1,8 +1,16 @@
 /************************************************************************
  * Member functions for class DeviceRRGSB
  ***********************************************************************/
+#include <array>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+
 #include "vtr_log.h"
 #include "vtr_assert.h"
+#include "vtr_parallel.h"
+#include "openfpga_side_manager.h"
+#include "openfpga_memory_footprint.h"
 #include "device_rr_gsb.h"
 
 /* namespace openfpga begins */
@@ -76,6 +84,48 @@ bool DeviceRRGSB::is_gsb_exist(const vtr::Point<size_t> coord) const {
   return false;
 }
 
+/* Estimate the memory occupied by the GSBs and their unique mirrors
+ * The GSBs are estimated from their channel widths and numbers of pins,
+ * as their internal data are not exposed. 
+ * Frozen GSBs own no data but their shared storage
+ */
+size_t DeviceRRGSB::memory_footprint() const {
+  size_t footprint = sizeof(DeviceRRGSB);
+  if (nullptr != gsb_storage_) {
+    footprint += sizeof(RRGSBStorage);
+    footprint += container_footprint(gsb_storage_->sides);
+    footprint += container_footprint(gsb_storage_->chan_nodes);
+    footprint += container_footprint(gsb_storage_->chan_node_segments);
+    footprint += container_footprint(gsb_storage_->chan_node_directions);
+    footprint += container_footprint(gsb_storage_->pin_nodes);
+    footprint += container_footprint(gsb_storage_->chan_node_in_edges);
+    footprint += container_footprint(gsb_storage_->chan_node_in_edge_offsets);
+  }
+  for (const std::vector<RRGSB>& rr_gsb_column : rr_gsb_) {
+    footprint += rr_gsb_column.capacity() * sizeof(RRGSB);
+    for (const RRGSB& rr_gsb : rr_gsb_column) {
+      if (true == rr_gsb.is_frozen()) {
+        continue;
+      }
+      for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+        SideManager side_manager(side);
+        /* Each track carries a node, a segment, a direction and the offsets of its input edges */
+        footprint += rr_gsb.get_chan_width(side_manager.get_side()) * (sizeof(RRNodeId) + sizeof(RRSegmentId) + sizeof(PORTS) + sizeof(size_t));
+        footprint += (rr_gsb.get_num_ipin_nodes(side_manager.get_side()) + rr_gsb.get_num_opin_nodes(side_manager.get_side())) * sizeof(RRNodeId);
+      }
+    }
+  }
+  footprint += container_footprint(gsb_unique_module_id_);
+  footprint += container_footprint(gsb_unique_module_);
+  footprint += container_footprint(sb_unique_module_id_);
+  footprint += container_footprint(sb_unique_module_);
+  footprint += container_footprint(cbx_unique_module_id_);
+  footprint += container_footprint(cbx_unique_module_);
+  footprint += container_footprint(cby_unique_module_id_);
+  footprint += container_footprint(cby_unique_module_);
+  return footprint;
+}
+
 /* get the number of unique mirrors of switch blocks */
 size_t DeviceRRGSB::get_num_sb_unique_module() const {
   return sb_unique_module_.size();
@@ -136,6 +186,14 @@ const RRGSB& DeviceRRGSB::get_sb_unique_module(const vtr::Point<size_t>& coordin
   return get_sb_unique_module(sb_unique_module_id);
 } 
 
+/* Give a coordinate of a rr switch block, and return the index of its unique mirror */ 
+size_t DeviceRRGSB::get_sb_unique_module_index(const vtr::Point<size_t>& coordinate) const {
+  VTR_ASSERT(validate_coordinate(coordinate));
+  size_t sb_unique_module_id = sb_unique_module_id_[coordinate.x()][coordinate.y()];  
+  VTR_ASSERT(validate_sb_unique_module_index(sb_unique_module_id));
+  return sb_unique_module_id;
+} 
+
 /************************************************************************
  * Public mutators
  ***********************************************************************/
@@ -206,10 +264,19 @@ RRGSB& DeviceRRGSB::get_mutable_gsb(const size_t& x, const size_t& y) {
 }
 
 /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
-void DeviceRRGSB::build_cb_unique_module(const RRGraph& rr_graph, const t_rr_type& cb_type) {
+void DeviceRRGSB::build_cb_unique_module(const RRGraph& rr_graph, const t_rr_type& cb_type,
+                                         const std::vector<std::vector<size_t>>& cb_fingerprints) {
   /* Make sure a clean start */
   clear_cb_unique_module(cb_type);
 
+  /* Unique modules are bucketed by their structural fingerprints.
+   * Mirrors always share a fingerprint, so a CB only needs
+   * to be compared to the unique modules in the same bucket.
+   * Each bucket is sorted by unique module id, so that the first mirror found
+   * is the same as a search over the whole unique module list
+   */
+  std::unordered_map<size_t, std::vector<size_t>> unique_module_buckets;
+
   for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
     for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
       bool is_unique_module = true;
@@ -220,8 +287,10 @@ void DeviceRRGSB::build_cb_unique_module(const RRGraph& rr_graph, const t_rr_typ
         continue;
       }
 
-      /* Traverse the unique_mirror list and check it is an mirror of another */
-      for (size_t id = 0; id < get_num_cb_unique_module(cb_type); ++id) {
+      std::vector<size_t>& candidates = unique_module_buckets[cb_fingerprints[ix][iy]];
+
+      /* Traverse the unique_mirror candidates and check it is an mirror of another */
+      for (const size_t& id : candidates) {
         const RRGSB& unique_module = get_cb_unique_module(cb_type, id);
         if (true == rr_gsb_[ix][iy].is_cb_mirror(rr_graph, unique_module, cb_type)) {
           /* This is a mirror, raise the flag and we finish */
@@ -236,24 +305,33 @@ void DeviceRRGSB::build_cb_unique_module(const RRGraph& rr_graph, const t_rr_typ
         add_cb_unique_module(cb_type, gsb_coordinate);
         /* Record the id of unique mirror */
         set_cb_unique_module_id(cb_type, gsb_coordinate, get_num_cb_unique_module(cb_type) - 1); 
+        candidates.push_back(get_num_cb_unique_module(cb_type) - 1);
       }
     }
   } 
 }
 
 /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
-void DeviceRRGSB::build_sb_unique_module(const RRGraph& rr_graph) {
+void DeviceRRGSB::build_sb_unique_module(const RRGraph& rr_graph,
+                                         const std::vector<std::vector<size_t>>& sb_fingerprints) {
   /* Make sure a clean start */
   clear_sb_unique_module();
 
+  /* Unique modules are bucketed by their structural fingerprints,
+   * see build_cb_unique_module() for details
+   */
+  std::unordered_map<size_t, std::vector<size_t>> unique_module_buckets;
+
   /* Build the unique module */
   for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
     for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
       bool is_unique_module = true;
       vtr::Point<size_t> sb_coordinate(ix, iy);
 
-      /* Traverse the unique_mirror list and check it is an mirror of another */
-      for (size_t id = 0; id < get_num_sb_unique_module(); ++id) {
+      std::vector<size_t>& candidates = unique_module_buckets[sb_fingerprints[ix][iy]];
+
+      /* Traverse the unique_mirror candidates and check it is an mirror of another */
+      for (const size_t& id : candidates) {
         /* Check if the two modules have the same submodules,
          * if so, these two modules are the same, indicating the sb is not unique.
          * else the sb is unique 
@@ -273,6 +351,7 @@ void DeviceRRGSB::build_sb_unique_module(const RRGraph& rr_graph) {
         sb_unique_module_.push_back(sb_coordinate);
         /* Record the id of unique mirror */
         sb_unique_module_id_[ix][iy] = sb_unique_module_.size() - 1; 
+        candidates.push_back(sb_unique_module_.size() - 1);
       }
     }
   } 
@@ -285,46 +364,250 @@ void DeviceRRGSB::build_gsb_unique_module() {
   /* Make sure a clean start */
   clear_gsb_unique_module();
 
+  /* We have alreay built sb and cb unique module list 
+   * Two GSBs are mirrors if the unique module id of SBs, CBX and CBY are the same
+   * So the ids can be directly used as a key to find the unique mirror
+   */
+  std::map<std::array<size_t, 3>, size_t> unique_module_lookup;
+
   for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
     for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
-      bool is_unique_module = true;
       vtr::Point<size_t> gsb_coordinate(ix, iy);
 
-      /* Traverse the unique_mirror list and check it is an mirror of another */
-      for (size_t id = 0; id < get_num_gsb_unique_module(); ++id) {
-        /* We have alreay built sb and cb unique module list 
-         * We just need to check if the unique module id of SBs, CBX and CBY are the same or not 
-         */
-        const vtr::Point<size_t>& gsb_unique_module_coordinate = gsb_unique_module_[id];
-        if ((sb_unique_module_id_[ix][iy] == sb_unique_module_id_[gsb_unique_module_coordinate.x()][gsb_unique_module_coordinate.y()])
-         && (cbx_unique_module_id_[ix][iy] == cbx_unique_module_id_[gsb_unique_module_coordinate.x()][gsb_unique_module_coordinate.y()])
-         && (cby_unique_module_id_[ix][iy] == cby_unique_module_id_[gsb_unique_module_coordinate.x()][gsb_unique_module_coordinate.y()])) {
-          /* This is a mirror, raise the flag and we finish */
-          is_unique_module = false;
-          /* Record the id of unique mirror */
-          gsb_unique_module_id_[ix][iy] = id; 
-          break;
-        }
+      std::array<size_t, 3> unique_module_key = {{sb_unique_module_id_[ix][iy],
+                                                  cbx_unique_module_id_[ix][iy],
+                                                  cby_unique_module_id_[ix][iy]}};
+
+      auto result = unique_module_lookup.find(unique_module_key);
+      if (result != unique_module_lookup.end()) {
+        /* This is a mirror, record the id of unique mirror */
+        gsb_unique_module_id_[ix][iy] = result->second; 
+        continue;
       }
+
       /* Add to list if this is a unique mirror*/
-      if (true == is_unique_module) {
-        add_gsb_unique_module(gsb_coordinate);
-        /* Record the id of unique mirror */
-        gsb_unique_module_id_[ix][iy] = get_num_gsb_unique_module() - 1;
-      }
+      add_gsb_unique_module(gsb_coordinate);
+      /* Record the id of unique mirror */
+      gsb_unique_module_id_[ix][iy] = get_num_gsb_unique_module() - 1;
+      unique_module_lookup[unique_module_key] = gsb_unique_module_id_[ix][iy];
     }
   } 
 }
 
-void DeviceRRGSB::build_unique_module(const RRGraph& rr_graph) {
-  build_sb_unique_module(rr_graph);
+/* Compute the fingerprints of all the SBs, X- and Y-direction CBs 
+ * The fingerprint of each GSB only depends on the GSB itself and the read-only rr_graph,
+ * so that the columns of the GSB array can be hashed by independent worker threads.
+ * Each fingerprint is stored at the coordinate of its GSB,
+ * so the results do not depend on the number of threads
+ */
+void DeviceRRGSB::build_fingerprints(const RRGraph& rr_graph,
+                                     const size_t& num_threads,
+                                     std::vector<std::vector<size_t>>& sb_fingerprints,
+                                     std::vector<std::vector<size_t>>& cbx_fingerprints,
+                                     std::vector<std::vector<size_t>>& cby_fingerprints) const {
+  sb_fingerprints.resize(rr_gsb_.size());
+  cbx_fingerprints.resize(rr_gsb_.size());
+  cby_fingerprints.resize(rr_gsb_.size());
+  for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
+    sb_fingerprints[ix].resize(rr_gsb_[ix].size(), 0);
+    cbx_fingerprints[ix].resize(rr_gsb_[ix].size(), 0);
+    cby_fingerprints[ix].resize(rr_gsb_[ix].size(), 0);
+  }
 
-  build_cb_unique_module(rr_graph, CHANX);
-  build_cb_unique_module(rr_graph, CHANY);
+  /* Columns are dispatched on demand, as the GSB complexity varies across the device */
+  vtr::parallel_for(rr_gsb_.size(), num_threads, [&](const size_t& ix) {
+    for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
+      sb_fingerprints[ix][iy] = rr_gsb_[ix][iy].get_sb_fingerprint(rr_graph);
+      /* Bypass non-exist CB */
+      if (true == rr_gsb_[ix][iy].is_cb_exist(CHANX)) {
+        cbx_fingerprints[ix][iy] = rr_gsb_[ix][iy].get_cb_fingerprint(rr_graph, CHANX);
+      }
+      if (true == rr_gsb_[ix][iy].is_cb_exist(CHANY)) {
+        cby_fingerprints[ix][iy] = rr_gsb_[ix][iy].get_cb_fingerprint(rr_graph, CHANY);
+      }
+    }
+  });
+}
+
+/* Identify the unique SBs, CBs and GSBs
+ * The fingerprints are computed in parallel when more than one thread is requested,
+ * while the unique modules are always merged sequentially in the order of coordinates.
+ * This guarantees that the unique module ids are the same regardless of the number of threads,
+ * which is required as the module names in netlists are derived from these ids
+ */
+void DeviceRRGSB::build_unique_module(const RRGraph& rr_graph, const size_t& num_threads) {
+  std::vector<std::vector<size_t>> sb_fingerprints;
+  std::vector<std::vector<size_t>> cbx_fingerprints;
+  std::vector<std::vector<size_t>> cby_fingerprints;
+  build_fingerprints(rr_graph, num_threads, sb_fingerprints, cbx_fingerprints, cby_fingerprints);
+
+  build_sb_unique_module(rr_graph, sb_fingerprints);
+
+  build_cb_unique_module(rr_graph, CHANX, cbx_fingerprints);
+  build_cb_unique_module(rr_graph, CHANY, cby_fingerprints);
 
   build_gsb_unique_module();
 }
 
+/************************************************************************
+ * Pack the nodes and the sorted edges of all the GSBs into a new shared storage,
+ * which replaces millions of small containers owned by each GSB on large fabrics.
+ * The arrays of routing tracks are pre-allocated from the channel widths of the GSBs.
+ * GSBs which have been frozen before are packed again, and the previous storage is released
+ ***********************************************************************/
+void DeviceRRGSB::freeze() {
+  std::shared_ptr<RRGSBStorage> gsb_storage = std::make_shared<RRGSBStorage>();
+
+  /* The pins are not counted, as the GSBs with routing do not have pins on all the sides */
+  size_t num_sides = 0;
+  size_t num_chan_nodes = 0;
+  for (const std::vector<RRGSB>& rr_gsb_column : rr_gsb_) {
+    for (const RRGSB& rr_gsb : rr_gsb_column) {
+      num_sides += rr_gsb.get_num_sides();
+      for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+        SideManager side_manager(side);
+        num_chan_nodes += rr_gsb.get_chan_width(side_manager.get_side());
+      }
+    }
+  }
+  gsb_storage->sides.reserve(num_sides);
+  gsb_storage->chan_nodes.reserve(num_chan_nodes);
+  gsb_storage->chan_node_segments.reserve(num_chan_nodes);
+  gsb_storage->chan_node_directions.reserve(num_chan_nodes);
+
+  for (std::vector<RRGSB>& rr_gsb_column : rr_gsb_) {
+    for (RRGSB& rr_gsb : rr_gsb_column) {
+      rr_gsb.freeze(*gsb_storage);
+    }
+  }
+  gsb_storage->pin_nodes.shrink_to_fit();
+  gsb_storage->chan_node_in_edges.shrink_to_fit();
+  gsb_storage->chan_node_in_edge_offsets.shrink_to_fit();
+
+  gsb_storage_ = gsb_storage;
+}
+
+/************************************************************************
+ * Write the unique mirrors and the unique module ids of all the GSBs to a binary stream
+ * All the numbers are stored as 64-bit unsigned integers in the native byte order:
+ *  - the range of the GSB array
+ *  - for the SBs, CBXs, CBYs and GSBs in sequence:
+ *    the number of unique mirrors, their coordinates and the unique module id of each GSB
+ ***********************************************************************/
+static 
+void write_unique_module_number(std::ostream& fp, const size_t& number) {
+  uint64_t value = number;
+  fp.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static 
+void write_unique_module_list(std::ostream& fp,
+                              const std::vector<vtr::Point<size_t>>& unique_module,
+                              const std::vector<std::vector<size_t>>& unique_module_id,
+                              const vtr::Point<size_t>& gsb_range) {
+  write_unique_module_number(fp, unique_module.size());
+  for (const vtr::Point<size_t>& coord : unique_module) {
+    write_unique_module_number(fp, coord.x());
+    write_unique_module_number(fp, coord.y());
+  }
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      write_unique_module_number(fp, unique_module_id[ix][iy]);
+    }
+  }
+}
+
+void DeviceRRGSB::write_unique_module(std::ostream& fp) const {
+  vtr::Point<size_t> gsb_range = get_gsb_range();
+  write_unique_module_number(fp, gsb_range.x());
+  write_unique_module_number(fp, gsb_range.y());
+
+  write_unique_module_list(fp, sb_unique_module_, sb_unique_module_id_, gsb_range);
+  write_unique_module_list(fp, cbx_unique_module_, cbx_unique_module_id_, gsb_range);
+  write_unique_module_list(fp, cby_unique_module_, cby_unique_module_id_, gsb_range);
+  write_unique_module_list(fp, gsb_unique_module_, gsb_unique_module_id_, gsb_range);
+}
+
+static 
+bool read_unique_module_number(std::istream& fp, size_t& number) {
+  uint64_t value = 0;
+  if (!fp.read(reinterpret_cast<char*>(&value), sizeof(value))) {
+    return false;
+  }
+  number = value;
+  return true;
+}
+
+static 
+bool read_unique_module_list(std::istream& fp,
+                             std::vector<vtr::Point<size_t>>& unique_module,
+                             std::vector<std::vector<size_t>>& unique_module_id,
+                             const vtr::Point<size_t>& gsb_range) {
+  size_t num_unique_modules = 0;
+  if (false == read_unique_module_number(fp, num_unique_modules)) {
+    return false;
+  }
+  /* Each GSB has at most one unique mirror */
+  if (num_unique_modules > gsb_range.x() * gsb_range.y()) {
+    return false;
+  }
+
+  unique_module.clear();
+  unique_module.reserve(num_unique_modules);
+  for (size_t imodule = 0; imodule < num_unique_modules; ++imodule) {
+    size_t x = 0;
+    size_t y = 0;
+    if ( (false == read_unique_module_number(fp, x))
+      || (false == read_unique_module_number(fp, y)) ) {
+      return false;
+    }
+    if ( (x >= gsb_range.x()) || (y >= gsb_range.y()) ) {
+      return false;
+    }
+    unique_module.push_back(vtr::Point<size_t>(x, y));
+  }
+
+  unique_module_id.resize(gsb_range.x());
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    unique_module_id[ix].resize(gsb_range.y());
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      if (false == read_unique_module_number(fp, unique_module_id[ix][iy])) {
+        return false;
+      }
+      if (unique_module_id[ix][iy] >= num_unique_modules) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool DeviceRRGSB::read_unique_module(std::istream& fp) {
+  vtr::Point<size_t> gsb_range = get_gsb_range();
+  size_t range_x = 0;
+  size_t range_y = 0;
+  if ( (false == read_unique_module_number(fp, range_x))
+    || (false == read_unique_module_number(fp, range_y)) ) {
+    return false;
+  }
+  if ( (range_x != gsb_range.x()) || (range_y != gsb_range.y()) ) {
+    return false;
+  }
+
+  if ( (false == read_unique_module_list(fp, sb_unique_module_, sb_unique_module_id_, gsb_range))
+    || (false == read_unique_module_list(fp, cbx_unique_module_, cbx_unique_module_id_, gsb_range))
+    || (false == read_unique_module_list(fp, cby_unique_module_, cby_unique_module_id_, gsb_range))
+    || (false == read_unique_module_list(fp, gsb_unique_module_, gsb_unique_module_id_, gsb_range)) ) {
+    /* Do not leave a partial result behind */
+    clear_sb_unique_module();
+    clear_cb_unique_module(CHANX);
+    clear_cb_unique_module(CHANY);
+    clear_gsb_unique_module();
+    return false;
+  }
+  return true;
+}
+
 void DeviceRRGSB::add_gsb_unique_module(const vtr::Point<size_t>& coordinate) {
   gsb_unique_module_.push_back(coordinate); 
 }
@@ -388,6 +671,7 @@ void DeviceRRGSB::clear_gsb() {
     rr_gsb_[x].clear(); 
   }
   rr_gsb_.clear();
+  gsb_storage_.reset();
 }
 
 void DeviceRRGSB::clear_gsb_unique_module_id() {
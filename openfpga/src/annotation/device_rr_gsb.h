@@ -5,6 +5,10 @@
  * Include header files required by the data structure definition
  *******************************************************************/
 /* Header files from vtrutil library */
+#include <istream>
+#include <memory>
+#include <ostream>
+
 #include "vtr_geometry.h"
 
 /* Header files from vpr library */
@@ -34,10 +38,12 @@ class DeviceRRGSB {
     size_t get_num_sb_unique_module() const; /* get the number of unique mirrors of switch blocks */
     const RRGSB& get_sb_unique_module(const size_t& index) const; /* Get a rr switch block which a unique mirror */ 
     const RRGSB& get_sb_unique_module(const vtr::Point<size_t>& coordinate) const; /* Get a rr switch block which a unique mirror */ 
+    size_t get_sb_unique_module_index(const vtr::Point<size_t>& coordinate) const; /* Get the index of the unique mirror of a rr switch block */ 
     const RRGSB& get_cb_unique_module(const t_rr_type& cb_type, const size_t& index) const; /* Get a rr switch block which a unique mirror */ 
     const RRGSB& get_cb_unique_module(const t_rr_type& cb_type, const vtr::Point<size_t>& coordinate) const;
     size_t get_num_cb_unique_module(const t_rr_type& cb_type) const; /* get the number of unique mirrors of CBs */
     bool is_gsb_exist(const vtr::Point<size_t> coord) const;
+    size_t memory_footprint() const; /* Estimate the memory (in bytes) occupied by the GSBs and their unique mirrors */
   public: /* Mutators */ 
     void reserve(const vtr::Point<size_t>& coordinate); /* Pre-allocate the rr_switch_block array that the device requires */ 
     void reserve_sb_unique_submodule_id(const vtr::Point<size_t>& coordinate); /* Pre-allocate the rr_sb_unique_module_id matrix that the device requires */ 
@@ -45,7 +51,10 @@ class DeviceRRGSB {
     void add_rr_gsb(const vtr::Point<size_t>& coordinate, const RRGSB& rr_gsb); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
     RRGSB& get_mutable_gsb(const vtr::Point<size_t>& coordinate); /* Get a rr switch block in the array with a coordinate */
     RRGSB& get_mutable_gsb(const size_t& x, const size_t& y); /* Get a rr switch block in the array with a coordinate */
-    void build_unique_module(const RRGraph& rr_graph); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
+    void build_unique_module(const RRGraph& rr_graph, const size_t& num_threads); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
+    void freeze(); /* Pack the nodes and edges of all the GSBs into shared flat arrays, after which the GSBs can no longer be modified */
+    void write_unique_module(std::ostream& fp) const; /* Write the unique mirrors and the ids of all the GSBs to a binary stream */
+    bool read_unique_module(std::istream& fp); /* Read the unique mirrors written by write_unique_module(), return false if they do not fit the GSB array */
     void clear(); /* clean the content */
   private: /* Internal cleaners */
     void clear_gsb(); /* clean the content */
@@ -65,12 +74,22 @@ class DeviceRRGSB {
     void add_gsb_unique_module(const vtr::Point<size_t>& coordinate);
     void add_cb_unique_module(const t_rr_type& cb_type, const vtr::Point<size_t>& coordinate);
     void set_cb_unique_module_id(const t_rr_type& cb_type, const vtr::Point<size_t>& coordinate, size_t id);
-    void build_sb_unique_module(const RRGraph& rr_graph); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
-    void build_cb_unique_module(const RRGraph& rr_graph, const t_rr_type& cb_type); /* Add a switch block to the array, which will automatically identify and update the lists of unique side module */
+    void build_fingerprints(const RRGraph& rr_graph,
+                            const size_t& num_threads,
+                            std::vector<std::vector<size_t>>& sb_fingerprints,
+                            std::vector<std::vector<size_t>>& cbx_fingerprints,
+                            std::vector<std::vector<size_t>>& cby_fingerprints) const; /* Compute the structural fingerprints of all the SBs and CBs, using a number of worker threads */
+    void build_sb_unique_module(const RRGraph& rr_graph, const std::vector<std::vector<size_t>>& sb_fingerprints); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
+    void build_cb_unique_module(const RRGraph& rr_graph, const t_rr_type& cb_type, const std::vector<std::vector<size_t>>& cb_fingerprints); /* Add a switch block to the array, which will automatically identify and update the lists of unique side module */
     void build_gsb_unique_module(); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
   private: /* Internal Data */
     std::vector<std::vector<RRGSB>> rr_gsb_;
 
+    /* Shared storage of the frozen GSBs, which is referred to by each of them. 
+     * It is shared by the copies of the device as well
+     */
+    std::shared_ptr<RRGSBStorage> gsb_storage_;
+
     std::vector<std::vector<size_t>> gsb_unique_module_id_; /* A map from rr_gsb to its unique mirror */
     std::vector<vtr::Point<size_t>> gsb_unique_module_; 
 
@@ -1,6 +1,8 @@
 /************************************************************************
  * Member functions for class VprClusteringAnnotation
  ***********************************************************************/
+#include <utility>
+
 #include "vtr_log.h"
 #include "vtr_assert.h"
 #include "vpr_clustering_annotation.h"
@@ -19,16 +21,17 @@ VprClusteringAnnotation::VprClusteringAnnotation() {
  * Public accessors
  ***********************************************************************/
 bool VprClusteringAnnotation::is_net_renamed(const ClusterBlockId& block_id, const int& pin_index) const {
-  /* Ensure that the block_id is in the list */
-  if (net_names_.end() == net_names_.find(block_id)) {
+  /* Ensure that the block_id and the pin are in the list */
+  if (size_t(block_id) >= net_renamed_.size()) {
     return false;
   }
-  return (net_names_.at(block_id).end() != net_names_.at(block_id).find(pin_index));
+  const std::vector<bool>& pin_renamed = net_renamed_[block_id];
+  return (0 <= pin_index) && ((size_t)pin_index < pin_renamed.size()) && (true == pin_renamed[pin_index]);
 }
 
 ClusterNetId VprClusteringAnnotation::net(const ClusterBlockId& block_id, const int& pin_index) const {
   VTR_ASSERT(true == is_net_renamed(block_id, pin_index));
-  return net_names_.at(block_id).at(pin_index);
+  return net_names_[block_id][pin_index];
 }
 
 bool VprClusteringAnnotation::is_truth_table_adapted(t_pb* pb) const {
@@ -41,12 +44,13 @@ AtomNetlist::TruthTable VprClusteringAnnotation::truth_table(t_pb* pb) const {
   return block_truth_tables_.at(pb);
 }
 
-PhysicalPb VprClusteringAnnotation::physical_pb(const ClusterBlockId& block_id) const {
-  if (physical_pbs_.end() == physical_pbs_.find(block_id)) {
-    return PhysicalPb();
+const PhysicalPb& VprClusteringAnnotation::physical_pb(const ClusterBlockId& block_id) const {
+  if (size_t(block_id) >= physical_pbs_.size()) {
+    static const PhysicalPb empty_physical_pb;
+    return empty_physical_pb;
   }
 
-  return physical_pbs_.at(block_id);
+  return physical_pbs_[block_id];
 }
 
 /************************************************************************
@@ -54,14 +58,25 @@ PhysicalPb VprClusteringAnnotation::physical_pb(const ClusterBlockId& block_id)
  ***********************************************************************/
 void VprClusteringAnnotation::rename_net(const ClusterBlockId& block_id, const int& pin_index,
                                                 const ClusterNetId& net_id) {
+  VTR_ASSERT(0 <= pin_index);
+
   /* Warn any override attempt */
-  if ( (net_names_.end() != net_names_.find(block_id))
-    && (net_names_.at(block_id).end() != net_names_.at(block_id).find(pin_index)) ) {
+  if (true == is_net_renamed(block_id, pin_index)) {
     VTR_LOG_WARN("Override the net '%ld' for block '%ld' pin '%d' with in clustering context annotation!\n",
                  size_t(net_id), size_t(block_id), pin_index);
   }
 
+  if (size_t(block_id) >= net_names_.size()) {
+    net_names_.resize(size_t(block_id) + 1);
+    net_renamed_.resize(size_t(block_id) + 1);
+  }
+  if ((size_t)pin_index >= net_names_[block_id].size()) {
+    net_names_[block_id].resize(pin_index + 1, ClusterNetId::INVALID());
+    net_renamed_[block_id].resize(pin_index + 1, false);
+  }
+
   net_names_[block_id][pin_index] = net_id;
+  net_renamed_[block_id][pin_index] = true;
 }
 
 void VprClusteringAnnotation::adapt_truth_table(t_pb* pb,
@@ -76,20 +91,23 @@ void VprClusteringAnnotation::adapt_truth_table(t_pb* pb,
 }
 
 void VprClusteringAnnotation::add_physical_pb(const ClusterBlockId& block_id,
-                                              const PhysicalPb& physical_pb) {
+                                              PhysicalPb&& physical_pb) {
   /* Warn any override attempt */
-  if (physical_pbs_.end() != physical_pbs_.find(block_id)) {
+  if ((size_t(block_id) < physical_pbs_.size()) && (false == physical_pbs_[block_id].empty())) {
     VTR_LOG_WARN("Override the physical pb for clustered block %lu in clustering context annotation!\n",
                  size_t(block_id));
   }
 
-  physical_pbs_[block_id] = physical_pb;
+  if (size_t(block_id) >= physical_pbs_.size()) {
+    physical_pbs_.resize(size_t(block_id) + 1);
+  }
+  physical_pbs_[block_id] = std::move(physical_pb);
 }
 
 PhysicalPb& VprClusteringAnnotation::mutable_physical_pb(const ClusterBlockId& block_id) {
-  VTR_ASSERT(physical_pbs_.end() != physical_pbs_.find(block_id));
+  VTR_ASSERT(size_t(block_id) < physical_pbs_.size());
 
-  return physical_pbs_.at(block_id);
+  return physical_pbs_[block_id];
 }
 
 } /* End namespace openfpga*/
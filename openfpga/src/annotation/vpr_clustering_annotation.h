@@ -4,7 +4,11 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
-#include <map> 
+#include <unordered_map>
+#include <vector>
+
+/* Header from vtrutil library */
+#include "vtr_vector.h"
 
 /* Header from vpr library */
 #include "clustered_netlist.h"
@@ -35,20 +39,26 @@ class VprClusteringAnnotation {
     ClusterNetId net(const ClusterBlockId& block_id, const int& pin_index) const;
     bool is_truth_table_adapted(t_pb* pb) const;
     AtomNetlist::TruthTable truth_table(t_pb* pb) const;
-    PhysicalPb physical_pb(const ClusterBlockId& block_id) const;
+    const PhysicalPb& physical_pb(const ClusterBlockId& block_id) const;
   public:  /* Public mutators */
     void rename_net(const ClusterBlockId& block_id, const int& pin_index,
                     const ClusterNetId& net_id);
     void adapt_truth_table(t_pb* pb, const AtomNetlist::TruthTable& tt);
-    void add_physical_pb(const ClusterBlockId& block_id, const PhysicalPb& physical_pb);
+    /* The physical pb is moved into the annotation */
+    void add_physical_pb(const ClusterBlockId& block_id, PhysicalPb&& physical_pb);
     PhysicalPb& mutable_physical_pb(const ClusterBlockId& block_id);
   private: /* Internal data */
-    /* Pair a regular pb_type to its physical pb_type */
-    std::map<ClusterBlockId, std::map<int, ClusterNetId>> net_names_;
-    std::map<t_pb*, AtomNetlist::TruthTable> block_truth_tables_;
+    /* Renamed nets of the pins of each clustered block, indexed by pin index
+     * A renamed net may be invalid, so whether a pin is renamed is stored apart
+     */
+    vtr::vector<ClusterBlockId, std::vector<ClusterNetId>> net_names_;
+    vtr::vector<ClusterBlockId, std::vector<bool>> net_renamed_;
+    std::unordered_map<const t_pb*, AtomNetlist::TruthTable> block_truth_tables_;
 
-    /* Link clustered blocks to physical pb (mapping results) */
-    std::map<ClusterBlockId, PhysicalPb> physical_pbs_;
+    /* Link clustered blocks to physical pb (mapping results)
+     * A block without physical pb has an empty one
+     */
+    vtr::vector<ClusterBlockId, PhysicalPb> physical_pbs_;
 };
 
 } /* End namespace openfpga*/
@@ -5,6 +5,7 @@
 
 #include "vtr_log.h"
 #include "vtr_assert.h"
+#include "openfpga_memory_footprint.h"
 #include "vpr_device_annotation.h"
 
 /* namespace openfpga begins */
@@ -22,126 +23,104 @@ VprDeviceAnnotation::VprDeviceAnnotation() {
  ***********************************************************************/
 bool VprDeviceAnnotation::is_physical_pb_type(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, t_pb_type*>::const_iterator it = physical_pb_types_.find(pb_type);
-  if (it == physical_pb_types_.end()) {
+  if (false == valid_pb_type(pb_type)) {
     return false;
   }
   /* A physical pb_type should be mapped to itself! Otherwise, it is an operating pb_type */
-  return pb_type == physical_pb_types_.at(pb_type);
+  return pb_type == physical_pb_types_[pb_type->annotation_index];
 }
 
 t_mode* VprDeviceAnnotation::physical_mode(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, t_mode*>::const_iterator it = physical_pb_modes_.find(pb_type);
-  if (it == physical_pb_modes_.end()) {
+  if (false == valid_pb_type(pb_type)) {
     return nullptr;
   }
-  return physical_pb_modes_.at(pb_type);
+  return physical_pb_modes_[pb_type->annotation_index];
 }
 
 t_pb_type* VprDeviceAnnotation::physical_pb_type(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, t_pb_type*>::const_iterator it = physical_pb_types_.find(pb_type);
-  if (it == physical_pb_types_.end()) {
+  if (false == valid_pb_type(pb_type)) {
     return nullptr;
   }
-  return physical_pb_types_.at(pb_type);
+  return physical_pb_types_[pb_type->annotation_index];
 }
 
 t_port* VprDeviceAnnotation::physical_pb_port(t_port* pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, t_port*>::const_iterator it = physical_pb_ports_.find(pb_port);
-  if (it == physical_pb_ports_.end()) {
+  /* Ensure that the pb_port is in the list */
+  if (false == valid_pb_port(pb_port)) {
     return nullptr;
   }
-  return physical_pb_ports_.at(pb_port);
+  return physical_pb_ports_[pb_port->annotation_index];
 }
 
 BasicPort VprDeviceAnnotation::physical_pb_port_range(t_port* pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, BasicPort>::const_iterator it = physical_pb_port_ranges_.find(pb_port);
-  if (it == physical_pb_port_ranges_.end()) {
+  /* Ensure that the pb_port is in the list */
+  if (false == valid_pb_port(pb_port)) {
     /* Return an invalid port. As such the port width will be 0, which is an invalid value */
     return BasicPort();
   }
-  return physical_pb_port_ranges_.at(pb_port);
+  return physical_pb_port_ranges_[pb_port->annotation_index];
 }
 
 CircuitModelId VprDeviceAnnotation::pb_type_circuit_model(t_pb_type* physical_pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, CircuitModelId>::const_iterator it = pb_type_circuit_models_.find(physical_pb_type);
-  if (it == pb_type_circuit_models_.end()) {
+  if (false == valid_pb_type(physical_pb_type)) {
     /* Return an invalid circuit model id */
     return CircuitModelId::INVALID();
   }
-  return pb_type_circuit_models_.at(physical_pb_type);
+  return pb_type_circuit_models_[physical_pb_type->annotation_index];
 }
 
 CircuitModelId VprDeviceAnnotation::interconnect_circuit_model(t_interconnect* pb_interconnect) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_interconnect*, CircuitModelId>::const_iterator it = interconnect_circuit_models_.find(pb_interconnect);
-  if (it == interconnect_circuit_models_.end()) {
+  /* Ensure that the interconnect is in the list */
+  if (false == valid_interconnect(pb_interconnect)) {
     /* Return an invalid circuit model id */
     return CircuitModelId::INVALID();
   }
-  return interconnect_circuit_models_.at(pb_interconnect);
+  return interconnect_circuit_models_[pb_interconnect->annotation_index];
 }
 
 e_interconnect VprDeviceAnnotation::interconnect_physical_type(t_interconnect* pb_interconnect) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_interconnect*, e_interconnect>::const_iterator it = interconnect_physical_types_.find(pb_interconnect);
-  if (it == interconnect_physical_types_.end()) {
+  /* Ensure that the interconnect is in the list */
+  if (false == valid_interconnect(pb_interconnect)) {
     /* Return an invalid interconnect type */
     return NUM_INTERC_TYPES;
   }
-  return interconnect_physical_types_.at(pb_interconnect);
+  return interconnect_physical_types_[pb_interconnect->annotation_index];
 }
 
 CircuitPortId VprDeviceAnnotation::pb_circuit_port(t_port* pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, CircuitPortId>::const_iterator it = pb_circuit_ports_.find(pb_port);
-  if (it == pb_circuit_ports_.end()) {
+  /* Ensure that the pb_port is in the list */
+  if (false == valid_pb_port(pb_port)) {
     /* Return an invalid circuit port id */
     return CircuitPortId::INVALID();
   }
-  return pb_circuit_ports_.at(pb_port);
+  return pb_circuit_ports_[pb_port->annotation_index];
 }
 
 std::vector<size_t> VprDeviceAnnotation::pb_type_mode_bits(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, std::vector<size_t>>::const_iterator it = pb_type_mode_bits_.find(pb_type);
-  if (it == pb_type_mode_bits_.end()) {
+  if (false == valid_pb_type(pb_type)) {
     /* Return an empty vector */
     return std::vector<size_t>();
   }
-  return pb_type_mode_bits_.at(pb_type);
+  return pb_type_mode_bits_[pb_type->annotation_index];
 }
 
 PbGraphNodeId VprDeviceAnnotation::pb_graph_node_unique_index(t_pb_graph_node* pb_graph_node) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, std::vector<t_pb_graph_node*>>::const_iterator it = pb_graph_node_unique_index_.find(pb_graph_node->pb_type);
-  if (it == pb_graph_node_unique_index_.end()) {
-    /* Invalid pb_type, return a null pointer */
-    return PbGraphNodeId::INVALID();
-  }
-
-  /* Try to find the pb_graph_node in the vector */
-  std::vector<t_pb_graph_node*>::const_iterator it_node = std::find(pb_graph_node_unique_index_.at(pb_graph_node->pb_type).begin(),
-                                                                    pb_graph_node_unique_index_.at(pb_graph_node->pb_type).end(),
-                                                                    pb_graph_node);
-  /* If it exists, return the index
+  /* Ensure that the pb_graph_node is in the list
    * Otherwise, return an invalid id
    */
-  if (it_node == pb_graph_node_unique_index_.at(pb_graph_node->pb_type).end()) {
+  if (false == valid_pb_graph_node(pb_graph_node)) {
     return PbGraphNodeId::INVALID();
   }
-  return PbGraphNodeId(it_node - pb_graph_node_unique_index_.at(pb_graph_node->pb_type).begin());
+  return pb_graph_node_unique_indices_[pb_graph_node->annotation_index];
 }
 
 t_pb_graph_node* VprDeviceAnnotation::pb_graph_node(t_pb_type* pb_type, const PbGraphNodeId& unique_index) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, std::vector<t_pb_graph_node*>>::const_iterator it = pb_graph_node_unique_index_.find(pb_type);
-  if (it == pb_graph_node_unique_index_.end()) {
+  if (false == valid_pb_type(pb_type)) {
     /* Invalid pb_type, return a null pointer */
     return nullptr;
   }
@@ -149,70 +128,64 @@ t_pb_graph_node* VprDeviceAnnotation::pb_graph_node(t_pb_type* pb_type, const Pb
    *  - Out of range: return a null pointer
    *  - In range: return the pointer
    */
-  if ((size_t)unique_index > pb_graph_node_unique_index_.at(pb_type).size() - 1) {
+  const std::vector<t_pb_graph_node*>& pb_graph_nodes = pb_graph_node_unique_index_[pb_type->annotation_index];
+  if ((size_t)unique_index >= pb_graph_nodes.size()) {
     return nullptr;
   }
 
-  return pb_graph_node_unique_index_.at(pb_type)[size_t(unique_index)];
+  return pb_graph_nodes[size_t(unique_index)];
 }
 
 t_pb_graph_node* VprDeviceAnnotation::physical_pb_graph_node(t_pb_graph_node* pb_graph_node) const {
   /* Ensure that the pb_graph_node is in the list */
-  std::map<t_pb_graph_node*, t_pb_graph_node*>::const_iterator it = physical_pb_graph_nodes_.find(pb_graph_node);
-  if (it == physical_pb_graph_nodes_.end()) {
+  if (false == valid_pb_graph_node(pb_graph_node)) {
     return nullptr;
   }
-  return physical_pb_graph_nodes_.at(pb_graph_node);
+  return physical_pb_graph_nodes_[pb_graph_node->annotation_index];
 }
 
 float VprDeviceAnnotation::physical_pb_type_index_factor(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, float>::const_iterator it = physical_pb_type_index_factors_.find(pb_type);
-  if (it == physical_pb_type_index_factors_.end()) {
+  if (false == valid_pb_type(pb_type)) {
     /* Default value is 1 */
     return 1.;
   }
-  return physical_pb_type_index_factors_.at(pb_type);
+  return physical_pb_type_index_factors_[pb_type->annotation_index];
 }
 
 int VprDeviceAnnotation::physical_pb_type_index_offset(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, int>::const_iterator it = physical_pb_type_index_offsets_.find(pb_type);
-  if (it == physical_pb_type_index_offsets_.end()) {
+  if (false == valid_pb_type(pb_type)) {
     /* Default value is 0 */
     return 0;
   }
-  return physical_pb_type_index_offsets_.at(pb_type);
+  return physical_pb_type_index_offsets_[pb_type->annotation_index];
 }
 
 int VprDeviceAnnotation::physical_pb_pin_rotate_offset(t_port* pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, int>::const_iterator it = physical_pb_pin_rotate_offsets_.find(pb_port);
-  if (it == physical_pb_pin_rotate_offsets_.end()) {
+  /* Ensure that the pb_port is in the list */
+  if (false == valid_pb_port(pb_port)) {
     /* Default value is 0 */
     return 0;
   }
-  return physical_pb_pin_rotate_offsets_.at(pb_port);
+  return physical_pb_pin_rotate_offsets_[pb_port->annotation_index];
 }
 
 int VprDeviceAnnotation::physical_pb_pin_offset(t_port* pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, int>::const_iterator it = physical_pb_pin_offsets_.find(pb_port);
-  if (it == physical_pb_pin_offsets_.end()) {
+  /* Ensure that the pb_port is in the list */
+  if (false == valid_pb_port(pb_port)) {
     /* Default value is 0 */
     return 0;
   }
-  return physical_pb_pin_offsets_.at(pb_port);
+  return physical_pb_pin_offsets_[pb_port->annotation_index];
 }
 
-
 t_pb_graph_pin* VprDeviceAnnotation::physical_pb_graph_pin(const t_pb_graph_pin* pb_graph_pin) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<const t_pb_graph_pin*, t_pb_graph_pin*>::const_iterator it = physical_pb_graph_pins_.find(pb_graph_pin);
-  if (it == physical_pb_graph_pins_.end()) {
+  /* Ensure that the pb_graph_pin is in the list */
+  if (false == valid_pb_graph_pin(pb_graph_pin)) {
     return nullptr;
   }
-  return physical_pb_graph_pins_.at(pb_graph_pin);
+  return physical_pb_graph_pins_[pb_graph_pin->annotation_index];
 }
 
 CircuitModelId VprDeviceAnnotation::rr_switch_circuit_model(const RRSwitchId& rr_switch) const {
@@ -241,129 +214,241 @@ ArchDirectId VprDeviceAnnotation::direct_annotation(const size_t& direct) const
   return direct_annotations_.at(direct);
 }
 
-LbRRGraph VprDeviceAnnotation::physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) const {
+const LbRRGraph& VprDeviceAnnotation::physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) const {
   /* Ensure that the rr_switch is in the list */
   if (0 == physical_lb_rr_graphs_.count(pb_graph_head)) {
-    return LbRRGraph();
+    static const LbRRGraph empty_lb_rr_graph;
+    return empty_lb_rr_graph;
   }
   return physical_lb_rr_graphs_.at(pb_graph_head);
 }
 
+const LbRRGraphLookahead& VprDeviceAnnotation::physical_lb_rr_graph_lookahead(t_pb_graph_node* pb_graph_head) const {
+  if (0 == physical_lb_rr_graph_lookaheads_.count(pb_graph_head)) {
+    static const LbRRGraphLookahead empty_lookahead;
+    return empty_lookahead;
+  }
+  return physical_lb_rr_graph_lookaheads_.at(pb_graph_head);
+}
+
+size_t VprDeviceAnnotation::physical_lb_rr_graphs_memory_footprint() const {
+  /* The nodes of the maps are counted here, while the graphs are counted by themselves */
+  size_t footprint = physical_lb_rr_graphs_.size() * TREE_NODE_OVERHEAD
+                   + physical_lb_rr_graph_lookaheads_.size() * TREE_NODE_OVERHEAD;
+  for (const auto& lb_rr_graph : physical_lb_rr_graphs_) {
+    footprint += sizeof(lb_rr_graph.first) + lb_rr_graph.second.memory_footprint();
+  }
+  for (const auto& lookahead : physical_lb_rr_graph_lookaheads_) {
+    footprint += sizeof(lookahead.first) + lookahead.second.memory_footprint();
+  }
+  return footprint;
+}
+
+size_t VprDeviceAnnotation::memory_footprint() const {
+  size_t footprint = sizeof(VprDeviceAnnotation);
+  footprint += container_footprint(pb_types_);
+  footprint += container_footprint(pb_ports_);
+  footprint += container_footprint(pb_interconnects_);
+  footprint += container_footprint(pb_graph_nodes_);
+  footprint += container_footprint(pb_graph_pins_);
+  footprint += container_footprint(physical_pb_types_);
+  footprint += container_footprint(physical_pb_type_index_factors_);
+  footprint += container_footprint(physical_pb_type_index_offsets_);
+  footprint += container_footprint(physical_pb_modes_);
+  footprint += container_footprint(pb_type_circuit_models_);
+  footprint += container_footprint(interconnect_circuit_models_);
+  footprint += container_footprint(interconnect_physical_types_);
+  footprint += container_footprint(pb_type_mode_bits_);
+  footprint += container_footprint(physical_pb_ports_);
+  footprint += container_footprint(physical_pb_pin_rotate_offsets_);
+  footprint += container_footprint(physical_pb_pin_offsets_);
+  footprint += container_footprint(physical_pb_port_ranges_);
+  footprint += container_footprint(pb_circuit_ports_);
+  footprint += container_footprint(pb_graph_node_unique_index_);
+  footprint += container_footprint(pb_graph_node_unique_indices_);
+  footprint += container_footprint(physical_pb_graph_nodes_);
+  footprint += container_footprint(physical_pb_graph_pins_);
+  footprint += container_footprint(rr_switch_circuit_models_);
+  footprint += container_footprint(rr_segment_circuit_models_);
+  footprint += container_footprint(direct_annotations_);
+  return footprint;
+}
+
 /************************************************************************
  * Public mutators
  ***********************************************************************/
+void VprDeviceAnnotation::build_pb_type_indices(const std::vector<t_logical_block_type>& logical_block_types) {
+  pb_types_.clear();
+  pb_ports_.clear();
+  pb_interconnects_.clear();
+  pb_graph_nodes_.clear();
+  pb_graph_pins_.clear();
+
+  for (const t_logical_block_type& lb_type : logical_block_types) {
+    /* By pass nullptr for pb_type head */
+    if (nullptr == lb_type.pb_type) {
+      continue;
+    }
+    index_pb_type(lb_type.pb_type);
+    if (nullptr != lb_type.pb_graph_head) {
+      index_pb_graph_node(lb_type.pb_graph_head);
+    }
+  }
+
+  /* Reset the annotations to their default values */
+  physical_pb_types_.assign(pb_types_.size(), nullptr);
+  physical_pb_type_index_factors_.assign(pb_types_.size(), 1.);
+  physical_pb_type_index_offsets_.assign(pb_types_.size(), 0);
+  physical_pb_modes_.assign(pb_types_.size(), nullptr);
+  pb_type_circuit_models_.assign(pb_types_.size(), CircuitModelId::INVALID());
+  pb_type_mode_bits_.assign(pb_types_.size(), std::vector<size_t>());
+  pb_graph_node_unique_index_.assign(pb_types_.size(), std::vector<t_pb_graph_node*>());
+
+  physical_pb_ports_.assign(pb_ports_.size(), nullptr);
+  physical_pb_pin_rotate_offsets_.assign(pb_ports_.size(), 0);
+  physical_pb_pin_offsets_.assign(pb_ports_.size(), 0);
+  physical_pb_port_ranges_.assign(pb_ports_.size(), BasicPort());
+  pb_circuit_ports_.assign(pb_ports_.size(), CircuitPortId::INVALID());
+
+  interconnect_circuit_models_.assign(pb_interconnects_.size(), CircuitModelId::INVALID());
+  interconnect_physical_types_.assign(pb_interconnects_.size(), NUM_INTERC_TYPES);
+
+  pb_graph_node_unique_indices_.assign(pb_graph_nodes_.size(), PbGraphNodeId::INVALID());
+  physical_pb_graph_nodes_.assign(pb_graph_nodes_.size(), nullptr);
+
+  physical_pb_graph_pins_.assign(pb_graph_pins_.size(), nullptr);
+}
+
 void VprDeviceAnnotation::add_pb_type_physical_mode(t_pb_type* pb_type, t_mode* physical_mode) {
+  VTR_ASSERT(valid_pb_type(pb_type));
+
   /* Warn any override attempt */
-  std::map<t_pb_type*, t_mode*>::const_iterator it = physical_pb_modes_.find(pb_type);
-  if (it != physical_pb_modes_.end()) {
+  if (nullptr != physical_pb_modes_[pb_type->annotation_index]) {
     VTR_LOG_WARN("Override the annotation between pb_type '%s' and it physical mode '%s'!\n",
                  pb_type->name, physical_mode->name);
   }
 
-  physical_pb_modes_[pb_type] = physical_mode;
+  physical_pb_modes_[pb_type->annotation_index] = physical_mode;
 }
 
 void VprDeviceAnnotation::add_physical_pb_type(t_pb_type* operating_pb_type, t_pb_type* physical_pb_type) {
+  VTR_ASSERT(valid_pb_type(operating_pb_type));
+
   /* Warn any override attempt */
-  std::map<t_pb_type*, t_pb_type*>::const_iterator it = physical_pb_types_.find(operating_pb_type);
-  if (it != physical_pb_types_.end()) {
+  if (nullptr != physical_pb_types_[operating_pb_type->annotation_index]) {
     VTR_LOG_WARN("Override the annotation between operating pb_type '%s' and it physical pb_type '%s'!\n",
                  operating_pb_type->name, physical_pb_type->name);
   }
 
-  physical_pb_types_[operating_pb_type] = physical_pb_type;
+  physical_pb_types_[operating_pb_type->annotation_index] = physical_pb_type;
 }
 
 void VprDeviceAnnotation::add_physical_pb_port(t_port* operating_pb_port, t_port* physical_pb_port) {
+  VTR_ASSERT(valid_pb_port(operating_pb_port));
+
   /* Warn any override attempt */
-  std::map<t_port*, t_port*>::const_iterator it = physical_pb_ports_.find(operating_pb_port);
-  if (it != physical_pb_ports_.end()) {
+  if (nullptr != physical_pb_ports_[operating_pb_port->annotation_index]) {
     VTR_LOG_WARN("Override the annotation between operating pb_port '%s' and it physical pb_port '%s'!\n",
                  operating_pb_port->name, physical_pb_port->name);
   }
 
-  physical_pb_ports_[operating_pb_port] = physical_pb_port;
+  physical_pb_ports_[operating_pb_port->annotation_index] = physical_pb_port;
 }
 
 void VprDeviceAnnotation::add_physical_pb_port_range(t_port* operating_pb_port, const BasicPort& port_range) {
+  VTR_ASSERT(valid_pb_port(operating_pb_port));
+
   /* The port range must satify the port width*/
   VTR_ASSERT((size_t)operating_pb_port->num_pins == port_range.get_width());
 
   /* Warn any override attempt */
-  std::map<t_port*, BasicPort>::const_iterator it = physical_pb_port_ranges_.find(operating_pb_port);
-  if (it != physical_pb_port_ranges_.end()) {
+  if (0 < physical_pb_port_ranges_[operating_pb_port->annotation_index].get_width()) {
     VTR_LOG_WARN("Override the annotation between operating pb_port '%s' and it physical pb_port range '[%ld:%ld]'!\n",
                  operating_pb_port->name, port_range.get_lsb(), port_range.get_msb());
   }
 
-  physical_pb_port_ranges_[operating_pb_port] = port_range;
+  physical_pb_port_ranges_[operating_pb_port->annotation_index] = port_range;
 }
 
 void VprDeviceAnnotation::add_pb_type_circuit_model(t_pb_type* physical_pb_type, const CircuitModelId& circuit_model) {
+  VTR_ASSERT(valid_pb_type(physical_pb_type));
+
   /* Warn any override attempt */
-  std::map<t_pb_type*, CircuitModelId>::const_iterator it = pb_type_circuit_models_.find(physical_pb_type);
-  if (it != pb_type_circuit_models_.end()) {
+  if (CircuitModelId::INVALID() != pb_type_circuit_models_[physical_pb_type->annotation_index]) {
     VTR_LOG_WARN("Override the circuit model for physical pb_type '%s'!\n",
                  physical_pb_type->name);
   }
 
-  pb_type_circuit_models_[physical_pb_type] = circuit_model;
+  pb_type_circuit_models_[physical_pb_type->annotation_index] = circuit_model;
 }
 
 void VprDeviceAnnotation::add_interconnect_circuit_model(t_interconnect* pb_interconnect, const CircuitModelId& circuit_model) {
+  VTR_ASSERT(valid_interconnect(pb_interconnect));
+
   /* Warn any override attempt */
-  std::map<t_interconnect*, CircuitModelId>::const_iterator it = interconnect_circuit_models_.find(pb_interconnect);
-  if (it != interconnect_circuit_models_.end()) {
+  if (CircuitModelId::INVALID() != interconnect_circuit_models_[pb_interconnect->annotation_index]) {
     VTR_LOG_WARN("Override the circuit model for interconnect '%s'!\n",
                  pb_interconnect->name);
   }
 
-  interconnect_circuit_models_[pb_interconnect] = circuit_model;
+  interconnect_circuit_models_[pb_interconnect->annotation_index] = circuit_model;
 }
 
 void VprDeviceAnnotation::add_interconnect_physical_type(t_interconnect* pb_interconnect,
                                                          const e_interconnect& physical_type) {
+  VTR_ASSERT(valid_interconnect(pb_interconnect));
+
   /* Warn any override attempt */
-  std::map<t_interconnect*, e_interconnect>::const_iterator it = interconnect_physical_types_.find(pb_interconnect);
-  if (it != interconnect_physical_types_.end()) {
+  if (NUM_INTERC_TYPES != interconnect_physical_types_[pb_interconnect->annotation_index]) {
     VTR_LOG_WARN("Override the physical interconnect for interconnect '%s'!\n",
                  pb_interconnect->name);
   }
 
-  interconnect_physical_types_[pb_interconnect] = physical_type;
+  interconnect_physical_types_[pb_interconnect->annotation_index] = physical_type;
 }
 
 void VprDeviceAnnotation::add_pb_circuit_port(t_port* pb_port, const CircuitPortId& circuit_port) {
+  VTR_ASSERT(valid_pb_port(pb_port));
+
   /* Warn any override attempt */
-  std::map<t_port*, CircuitPortId>::const_iterator it = pb_circuit_ports_.find(pb_port);
-  if (it != pb_circuit_ports_.end()) {
+  if (CircuitPortId::INVALID() != pb_circuit_ports_[pb_port->annotation_index]) {
     VTR_LOG_WARN("Override the circuit port mapping for pb_type port '%s'!\n",
                  pb_port->name);
   }
 
-  pb_circuit_ports_[pb_port] = circuit_port;
+  pb_circuit_ports_[pb_port->annotation_index] = circuit_port;
 }
 
 void VprDeviceAnnotation::add_pb_type_mode_bits(t_pb_type* pb_type, const std::vector<size_t>& mode_bits) {
+  VTR_ASSERT(valid_pb_type(pb_type));
+
   /* Warn any override attempt */
-  std::map<t_pb_type*, std::vector<size_t>>::const_iterator it = pb_type_mode_bits_.find(pb_type);
-  if (it != pb_type_mode_bits_.end()) {
+  if (false == pb_type_mode_bits_[pb_type->annotation_index].empty()) {
     VTR_LOG_WARN("Override the mode bits mapping for pb_type '%s'!\n",
                  pb_type->name);
   }
 
-  pb_type_mode_bits_[pb_type] = mode_bits;
+  pb_type_mode_bits_[pb_type->annotation_index] = mode_bits;
 }
 
 void VprDeviceAnnotation::add_pb_graph_node_unique_index(t_pb_graph_node* pb_graph_node) {
-  pb_graph_node_unique_index_[pb_graph_node->pb_type].push_back(pb_graph_node);
+  VTR_ASSERT(valid_pb_graph_node(pb_graph_node));
+  VTR_ASSERT(valid_pb_type(pb_graph_node->pb_type));
+
+  std::vector<t_pb_graph_node*>& pb_graph_nodes = pb_graph_node_unique_index_[pb_graph_node->pb_type->annotation_index];
+  /* The unique index of a node is the first one it is given */
+  if (PbGraphNodeId::INVALID() == pb_graph_node_unique_indices_[pb_graph_node->annotation_index]) {
+    pb_graph_node_unique_indices_[pb_graph_node->annotation_index] = PbGraphNodeId(pb_graph_nodes.size());
+  }
+  pb_graph_nodes.push_back(pb_graph_node);
 }
 
 void VprDeviceAnnotation::add_physical_pb_graph_node(t_pb_graph_node* operating_pb_graph_node, 
                                                      t_pb_graph_node* physical_pb_graph_node) {
+  VTR_ASSERT(valid_pb_graph_node(operating_pb_graph_node));
+
   /* Warn any override attempt */
-  std::map<t_pb_graph_node*, t_pb_graph_node*>::const_iterator it = physical_pb_graph_nodes_.find(operating_pb_graph_node);
-  if (it != physical_pb_graph_nodes_.end()) {
+  if (nullptr != physical_pb_graph_nodes_[operating_pb_graph_node->annotation_index]) {
     VTR_LOG_WARN("Override the annotation between operating pb_graph_node '%s[%d]' and it physical pb_graph_node '%s[%d]'!\n",
                  operating_pb_graph_node->pb_type->name, 
                  operating_pb_graph_node->placement_index,
@@ -371,54 +456,58 @@ void VprDeviceAnnotation::add_physical_pb_graph_node(t_pb_graph_node* operating_
                  physical_pb_graph_node->placement_index);
   }
 
-  physical_pb_graph_nodes_[operating_pb_graph_node] = physical_pb_graph_node;
+  physical_pb_graph_nodes_[operating_pb_graph_node->annotation_index] = physical_pb_graph_node;
 }
 
 void VprDeviceAnnotation::add_physical_pb_type_index_factor(t_pb_type* pb_type, const float& factor) {
+  VTR_ASSERT(valid_pb_type(pb_type));
+
   /* Warn any override attempt */
-  std::map<t_pb_type*, float>::const_iterator it = physical_pb_type_index_factors_.find(pb_type);
-  if (it != physical_pb_type_index_factors_.end()) {
+  if (1. != physical_pb_type_index_factors_[pb_type->annotation_index]) {
     VTR_LOG_WARN("Override the annotation between operating pb_type '%s' and it physical pb_type index factor '%f'!\n",
                  pb_type->name, factor);
   }
 
-  physical_pb_type_index_factors_[pb_type] = factor;
+  physical_pb_type_index_factors_[pb_type->annotation_index] = factor;
 }
 
 void VprDeviceAnnotation::add_physical_pb_type_index_offset(t_pb_type* pb_type, const int& offset) {
+  VTR_ASSERT(valid_pb_type(pb_type));
+
   /* Warn any override attempt */
-  std::map<t_pb_type*, int>::const_iterator it = physical_pb_type_index_offsets_.find(pb_type);
-  if (it != physical_pb_type_index_offsets_.end()) {
+  if (0 != physical_pb_type_index_offsets_[pb_type->annotation_index]) {
     VTR_LOG_WARN("Override the annotation between operating pb_type '%s' and it physical pb_type index offset '%d'!\n",
                  pb_type->name, offset);
   }
 
-  physical_pb_type_index_offsets_[pb_type] = offset;
+  physical_pb_type_index_offsets_[pb_type->annotation_index] = offset;
 }
 
 void VprDeviceAnnotation::add_physical_pb_pin_rotate_offset(t_port* pb_port, const int& offset) {
+  VTR_ASSERT(valid_pb_port(pb_port));
+
   /* Warn any override attempt */
-  std::map<t_port*, int>::const_iterator it = physical_pb_pin_rotate_offsets_.find(pb_port);
-  if (it != physical_pb_pin_rotate_offsets_.end()) {
+  if (0 != physical_pb_pin_rotate_offsets_[pb_port->annotation_index]) {
     VTR_LOG_WARN("Override the annotation between operating pb_port '%s' and it physical pb_port pin rotate offset '%d'!\n",
                  pb_port->name, offset);
   }
 
-  physical_pb_pin_rotate_offsets_[pb_port] = offset;
+  physical_pb_pin_rotate_offsets_[pb_port->annotation_index] = offset;
   /* We initialize the accumulated offset to 0 */
-  physical_pb_pin_offsets_[pb_port] = 0;
+  physical_pb_pin_offsets_[pb_port->annotation_index] = 0;
 }
 
 void VprDeviceAnnotation::add_physical_pb_graph_pin(const t_pb_graph_pin* operating_pb_graph_pin, 
                                                     t_pb_graph_pin* physical_pb_graph_pin) {
+  VTR_ASSERT(valid_pb_graph_pin(operating_pb_graph_pin));
+
   /* Warn any override attempt */
-  std::map<const t_pb_graph_pin*, t_pb_graph_pin*>::const_iterator it = physical_pb_graph_pins_.find(operating_pb_graph_pin);
-  if (it != physical_pb_graph_pins_.end()) {
+  if (nullptr != physical_pb_graph_pins_[operating_pb_graph_pin->annotation_index]) {
     VTR_LOG_WARN("Override the annotation between operating pb_graph_pin '%s' and it physical pb_graph_pin '%s'!\n",
                  operating_pb_graph_pin->port->name, physical_pb_graph_pin->port->name);
   }
 
-  physical_pb_graph_pins_[operating_pb_graph_pin] = physical_pb_graph_pin;
+  physical_pb_graph_pins_[operating_pb_graph_pin->annotation_index] = physical_pb_graph_pin;
 
   /* Update the accumulated offsets for the operating port 
    * Each time we pair two pins, we update the offset by the pin rotate offset
@@ -436,13 +525,14 @@ void VprDeviceAnnotation::add_physical_pb_graph_pin(const t_pb_graph_pin* operat
     return;
   }
 
-  physical_pb_pin_offsets_[operating_pb_graph_pin->port] += physical_pb_pin_rotate_offset(operating_pb_graph_pin->port);
+  int& pin_offset = physical_pb_pin_offsets_[operating_pb_graph_pin->port->annotation_index];
+  pin_offset += physical_pb_pin_rotate_offset(operating_pb_graph_pin->port);
 
   if ((size_t)physical_pb_port(operating_pb_graph_pin->port)->num_pins - 1 
     < operating_pb_graph_pin->pin_number
     + physical_pb_port_range(operating_pb_graph_pin->port).get_lsb() 
-    + physical_pb_pin_offsets_[operating_pb_graph_pin->port]) {
-    physical_pb_pin_offsets_[operating_pb_graph_pin->port] = 0;
+    + pin_offset) {
+    pin_offset = 0;
   }
 }
 
@@ -488,4 +578,116 @@ void VprDeviceAnnotation::add_physical_lb_rr_graph(t_pb_graph_node* pb_graph_hea
   physical_lb_rr_graphs_[pb_graph_head] = lb_rr_graph;
 }
 
+void VprDeviceAnnotation::add_physical_lb_rr_graph_lookahead(t_pb_graph_node* pb_graph_head, const LbRRGraphLookahead& lookahead) {
+  /* Warn any override attempt */
+  if (0 < physical_lb_rr_graph_lookaheads_.count(pb_graph_head)) {
+    VTR_LOG_WARN("Override the physical lb_rr_graph lookahead for pb_graph_head '%s'!\n",
+                 pb_graph_head->pb_type->name);
+  }
+
+  physical_lb_rr_graph_lookaheads_[pb_graph_head] = lookahead;
+}
+
+void VprDeviceAnnotation::clear_physical_lb_rr_graphs() {
+  physical_lb_rr_graphs_.clear();
+  physical_lb_rr_graph_lookaheads_.clear();
+}
+
+/************************************************************************
+ * Internal validators
+ ***********************************************************************/
+bool VprDeviceAnnotation::valid_pb_type(const t_pb_type* pb_type) const {
+  return (nullptr != pb_type)
+      && (0 <= pb_type->annotation_index)
+      && ((size_t)pb_type->annotation_index < pb_types_.size())
+      && (pb_type == pb_types_[pb_type->annotation_index]);
+}
+
+bool VprDeviceAnnotation::valid_pb_port(const t_port* pb_port) const {
+  return (nullptr != pb_port)
+      && (0 <= pb_port->annotation_index)
+      && ((size_t)pb_port->annotation_index < pb_ports_.size())
+      && (pb_port == pb_ports_[pb_port->annotation_index]);
+}
+
+bool VprDeviceAnnotation::valid_interconnect(const t_interconnect* pb_interconnect) const {
+  return (nullptr != pb_interconnect)
+      && (0 <= pb_interconnect->annotation_index)
+      && ((size_t)pb_interconnect->annotation_index < pb_interconnects_.size())
+      && (pb_interconnect == pb_interconnects_[pb_interconnect->annotation_index]);
+}
+
+bool VprDeviceAnnotation::valid_pb_graph_node(const t_pb_graph_node* pb_graph_node) const {
+  return (nullptr != pb_graph_node)
+      && (0 <= pb_graph_node->annotation_index)
+      && ((size_t)pb_graph_node->annotation_index < pb_graph_nodes_.size())
+      && (pb_graph_node == pb_graph_nodes_[pb_graph_node->annotation_index]);
+}
+
+bool VprDeviceAnnotation::valid_pb_graph_pin(const t_pb_graph_pin* pb_graph_pin) const {
+  return (nullptr != pb_graph_pin)
+      && (0 <= pb_graph_pin->annotation_index)
+      && ((size_t)pb_graph_pin->annotation_index < pb_graph_pins_.size())
+      && (pb_graph_pin == pb_graph_pins_[pb_graph_pin->annotation_index]);
+}
+
+/************************************************************************
+ * Internal mutators
+ ***********************************************************************/
+/* Index a pb_type, its ports and the interconnects of its modes, and then its child pb_types */
+void VprDeviceAnnotation::index_pb_type(t_pb_type* pb_type) {
+  pb_type->annotation_index = pb_types_.size();
+  pb_types_.push_back(pb_type);
+
+  for (int iport = 0; iport < pb_type->num_ports; ++iport) {
+    pb_type->ports[iport].annotation_index = pb_ports_.size();
+    pb_ports_.push_back(&(pb_type->ports[iport]));
+  }
+
+  for (int imode = 0; imode < pb_type->num_modes; ++imode) {
+    t_mode& mode = pb_type->modes[imode];
+    for (int iinterc = 0; iinterc < mode.num_interconnect; ++iinterc) {
+      mode.interconnect[iinterc].annotation_index = pb_interconnects_.size();
+      pb_interconnects_.push_back(&(mode.interconnect[iinterc]));
+    }
+    for (int ichild = 0; ichild < mode.num_pb_type_children; ++ichild) {
+      index_pb_type(&(mode.pb_type_children[ichild]));
+    }
+  }
+}
+
+/* Index a pb_graph_node and its pins, and then its child pb_graph_nodes */
+void VprDeviceAnnotation::index_pb_graph_node(t_pb_graph_node* pb_graph_node) {
+  pb_graph_node->annotation_index = pb_graph_nodes_.size();
+  pb_graph_nodes_.push_back(pb_graph_node);
+
+  for (int iport = 0; iport < pb_graph_node->num_input_ports; ++iport) {
+    for (int ipin = 0; ipin < pb_graph_node->num_input_pins[iport]; ++ipin) {
+      pb_graph_node->input_pins[iport][ipin].annotation_index = pb_graph_pins_.size();
+      pb_graph_pins_.push_back(&(pb_graph_node->input_pins[iport][ipin]));
+    }
+  }
+  for (int iport = 0; iport < pb_graph_node->num_output_ports; ++iport) {
+    for (int ipin = 0; ipin < pb_graph_node->num_output_pins[iport]; ++ipin) {
+      pb_graph_node->output_pins[iport][ipin].annotation_index = pb_graph_pins_.size();
+      pb_graph_pins_.push_back(&(pb_graph_node->output_pins[iport][ipin]));
+    }
+  }
+  for (int iport = 0; iport < pb_graph_node->num_clock_ports; ++iport) {
+    for (int ipin = 0; ipin < pb_graph_node->num_clock_pins[iport]; ++ipin) {
+      pb_graph_node->clock_pins[iport][ipin].annotation_index = pb_graph_pins_.size();
+      pb_graph_pins_.push_back(&(pb_graph_node->clock_pins[iport][ipin]));
+    }
+  }
+
+  t_pb_type* pb_type = pb_graph_node->pb_type;
+  for (int imode = 0; imode < pb_type->num_modes; ++imode) {
+    for (int ichild = 0; ichild < pb_type->modes[imode].num_pb_type_children; ++ichild) {
+      for (int ipb = 0; ipb < pb_type->modes[imode].pb_type_children[ichild].num_pb; ++ipb) {
+        index_pb_graph_node(&(pb_graph_node->child_pb_graph_nodes[imode][ichild][ipb]));
+      }
+    }
+  }
+}
+
 } /* End namespace openfpga*/
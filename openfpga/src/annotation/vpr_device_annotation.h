@@ -5,6 +5,7 @@
  * Include header files required by the data structure definition
  *******************************************************************/
 #include <map> 
+#include <vector>
 
 /* Header from vtrutil library */
 #include "vtr_strong_id.h"
@@ -20,6 +21,7 @@
 #include "circuit_library.h"
 #include "arch_direct.h"
 #include "lb_rr_graph.h"
+#include "lb_rr_graph_lookahead.h"
 
 /* Begin namespace openfpga */
 namespace openfpga {
@@ -74,8 +76,18 @@ class VprDeviceAnnotation {
     CircuitModelId rr_switch_circuit_model(const RRSwitchId& rr_switch) const;
     CircuitModelId rr_segment_circuit_model(const RRSegmentId& rr_segment) const;
     ArchDirectId direct_annotation(const size_t& direct) const;
-    LbRRGraph physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) const;
+    const LbRRGraph& physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) const;
+    const LbRRGraphLookahead& physical_lb_rr_graph_lookahead(t_pb_graph_node* pb_graph_head) const;
+    /* Estimate the memory (in bytes) occupied by the physical lb_rr_graphs and their lookaheads */
+    size_t physical_lb_rr_graphs_memory_footprint() const;
+    /* Estimate the memory (in bytes) occupied by the annotation, excluding the physical lb_rr_graphs */
+    size_t memory_footprint() const;
   public:  /* Public mutators */
+    /* Give a dense index to each pb_type, port, interconnect, pb_graph_node and pb_graph_pin
+     * of the logical block types, by which their annotations are stored.
+     * This must be done before annotating them, and clears their existing annotations
+     */
+    void build_pb_type_indices(const std::vector<t_logical_block_type>& logical_block_types);
     void add_pb_type_physical_mode(t_pb_type* pb_type, t_mode* physical_mode);
     void add_physical_pb_type(t_pb_type* operating_pb_type, t_pb_type* physical_pb_type);
     void add_physical_pb_port(t_port* operating_pb_port, t_port* physical_pb_port);
@@ -96,36 +108,59 @@ class VprDeviceAnnotation {
     void add_rr_segment_circuit_model(const RRSegmentId& rr_segment, const CircuitModelId& circuit_model);
     void add_direct_annotation(const size_t& direct, const ArchDirectId& arch_direct_id);
     void add_physical_lb_rr_graph(t_pb_graph_node* pb_graph_head, const LbRRGraph& lb_rr_graph);
+    void add_physical_lb_rr_graph_lookahead(t_pb_graph_node* pb_graph_head, const LbRRGraphLookahead& lookahead);
+    /* Release the physical lb_rr_graphs and their lookaheads, which are only used by repack */
+    void clear_physical_lb_rr_graphs();
+  private: /* Internal validators */
+    bool valid_pb_type(const t_pb_type* pb_type) const;
+    bool valid_pb_port(const t_port* pb_port) const;
+    bool valid_interconnect(const t_interconnect* pb_interconnect) const;
+    bool valid_pb_graph_node(const t_pb_graph_node* pb_graph_node) const;
+    bool valid_pb_graph_pin(const t_pb_graph_pin* pb_graph_pin) const;
+  private: /* Internal mutators */
+    void index_pb_type(t_pb_type* pb_type);
+    void index_pb_graph_node(t_pb_graph_node* pb_graph_node);
   private: /* Internal data */
+    /* The pb_types, ports, interconnects, pb_graph_nodes and pb_graph_pins of the device,
+     * in the order of their dense indices (see build_pb_type_indices()).
+     * The annotations below are indexed in the same way, and hold their default values
+     * for the objects which are not annotated
+     */
+    std::vector<t_pb_type*> pb_types_;
+    std::vector<t_port*> pb_ports_;
+    std::vector<t_interconnect*> pb_interconnects_;
+    std::vector<t_pb_graph_node*> pb_graph_nodes_;
+    std::vector<const t_pb_graph_pin*> pb_graph_pins_;
+
     /* Pair a regular pb_type to its physical pb_type */
-    std::map<t_pb_type*, t_pb_type*> physical_pb_types_;
-    std::map<t_pb_type*, float> physical_pb_type_index_factors_;
-    std::map<t_pb_type*, int> physical_pb_type_index_offsets_;
+    std::vector<t_pb_type*> physical_pb_types_;
+    std::vector<float> physical_pb_type_index_factors_;
+    std::vector<int> physical_pb_type_index_offsets_;
 
     /* Pair a physical mode for a pb_type
      * Note:
      * - the physical mode MUST be a child mode of the pb_type
      * - the pb_type MUST be a physical pb_type itself
      */
-    std::map<t_pb_type*, t_mode*> physical_pb_modes_;
+    std::vector<t_mode*> physical_pb_modes_;
 
     /* Pair a physical pb_type to its circuit model
      * Note:
      * - the pb_type MUST be a physical pb_type itself
      */
-    std::map<t_pb_type*, CircuitModelId> pb_type_circuit_models_;
+    std::vector<CircuitModelId> pb_type_circuit_models_;
 
     /* Pair a interconnect of a physical pb_type to its circuit model
      * Note:
      * - the pb_type MUST be a physical pb_type itself
      */
-    std::map<t_interconnect*, CircuitModelId> interconnect_circuit_models_;
+    std::vector<CircuitModelId> interconnect_circuit_models_;
 
     /* Physical type of interconnect 
      * Note:
      * - only applicable to an interconnect belongs to physical mode
      */
-    std::map<t_interconnect*, e_interconnect> interconnect_physical_types_;
+    std::vector<e_interconnect> interconnect_physical_types_;
 
     /* Pair a pb_type to its mode selection bits
      * - if the pb_type is a physical pb_type, the mode bits are the default mode 
@@ -133,43 +168,44 @@ class VprDeviceAnnotation {
      * - if the pb_type is an operating pb_type, the mode bits will be applied
      *   when the operating pb_type is used by packer
      */
-    std::map<t_pb_type*, std::vector<size_t>> pb_type_mode_bits_;
+    std::vector<std::vector<size_t>> pb_type_mode_bits_;
 
     /* Pair a pb_port to its physical pb_port 
      * Note:
      * - the parent of physical pb_port MUST be a physical pb_type
      */
-    std::map<t_port*, t_port*> physical_pb_ports_;
-    std::map<t_port*, int> physical_pb_pin_rotate_offsets_;
+    std::vector<t_port*> physical_pb_ports_;
+    std::vector<int> physical_pb_pin_rotate_offsets_;
 
     /* Accumulated offsets for a physical pb_type port, just for internal usage */
-    std::map<t_port*, int> physical_pb_pin_offsets_;
+    std::vector<int> physical_pb_pin_offsets_;
 
     /* Pair a pb_port to its LSB and MSB of a physical pb_port 
      * Note:
      * - the LSB and MSB MUST be in range of the physical pb_port
      */
-    std::map<t_port*, BasicPort> physical_pb_port_ranges_;
+    std::vector<BasicPort> physical_pb_port_ranges_;
 
     /* Pair a pb_port to a circuit port in circuit model
      * Note:
      * - the parent of physical pb_port MUST be a physical pb_type
      */
-    std::map<t_port*, CircuitPortId> pb_circuit_ports_;
+    std::vector<CircuitPortId> pb_circuit_ports_;
 
     /* Pair each pb_graph_node to an unique index in the graph
-     * The unique index if the index in the array of t_pb_graph_node*
+     * The unique index if the index in the array of t_pb_graph_node* of its pb_type
      */ 
-    std::map<t_pb_type*, std::vector<t_pb_graph_node*>> pb_graph_node_unique_index_;
+    std::vector<std::vector<t_pb_graph_node*>> pb_graph_node_unique_index_;
+    std::vector<PbGraphNodeId> pb_graph_node_unique_indices_;
 
     /* Pair a pb_graph_node to a physical pb_graph_node
      * Note:
      * - the pb_type of physical pb_graph_node must be a physical pb_type
      */
-    std::map<t_pb_graph_node*, t_pb_graph_node*> physical_pb_graph_nodes_;
+    std::vector<t_pb_graph_node*> physical_pb_graph_nodes_;
 
     /* Pair a pb_graph_pin to a physical pb_graph_pin */
-    std::map<const t_pb_graph_pin*, t_pb_graph_pin*> physical_pb_graph_pins_;
+    std::vector<t_pb_graph_pin*> physical_pb_graph_pins_;
 
     /* Pair a Routing Resource Switch (rr_switch) to a circuit model */
     std::map<RRSwitchId, CircuitModelId> rr_switch_circuit_models_;
@@ -182,6 +218,9 @@ class VprDeviceAnnotation {
 
     /* Logical type routing resource graphs built from physical modes */
     std::map<t_pb_graph_node*, LbRRGraph> physical_lb_rr_graphs_;
+
+    /* Lookahead of the logical type routing resource graphs, used by the A* router */
+    std::map<t_pb_graph_node*, LbRRGraphLookahead> physical_lb_rr_graph_lookaheads_;
 };
 
 } /* End namespace openfpga*/
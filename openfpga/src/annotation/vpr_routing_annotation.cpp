@@ -3,6 +3,7 @@
  ***********************************************************************/
 #include "vtr_log.h"
 #include "vtr_assert.h"
+#include "openfpga_memory_footprint.h"
 #include "vpr_routing_annotation.h"
 
 /* namespace openfpga begins */
@@ -30,6 +31,12 @@ RRNodeId VprRoutingAnnotation::rr_node_prev_node(const RRNodeId& rr_node) const
   return rr_node_prev_nodes_[rr_node];
 }
 
+size_t VprRoutingAnnotation::memory_footprint() const {
+  return sizeof(VprRoutingAnnotation)
+       + container_footprint(rr_node_nets_)
+       + container_footprint(rr_node_prev_nodes_);
+}
+
 /************************************************************************
  * Public mutators
  ***********************************************************************/
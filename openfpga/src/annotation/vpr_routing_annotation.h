@@ -27,6 +27,8 @@ class VprRoutingAnnotation {
   public:  /* Public accessors */
     ClusterNetId rr_node_net(const RRNodeId& rr_node) const;
     RRNodeId rr_node_prev_node(const RRNodeId& rr_node) const;
+    /* Estimate the memory (in bytes) occupied by the annotation */
+    size_t memory_footprint() const;
   public:  /* Public mutators */
     void init(const RRGraph& rr_graph);
     void set_rr_node_net(const RRNodeId& rr_node,
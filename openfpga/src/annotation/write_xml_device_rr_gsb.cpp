@@ -37,7 +37,7 @@ void write_rr_switch_block_to_xml(const std::string fname_prefix,
            fname.c_str());
 
   /* Create a file handler*/
-  std::fstream fp;
+  BufferedFileStream fp;
   /* Open a file */
   fp.open(fname, std::fstream::out | std::fstream::trunc);
 
@@ -46,7 +46,7 @@ void write_rr_switch_block_to_xml(const std::string fname_prefix,
 
   /* Output location of the Switch Block */
   fp << "<rr_gsb x=\"" << rr_gsb.get_x() << "\" y=\"" << rr_gsb.get_y() << "\""
-     << " num_sides=\"" << rr_gsb.get_num_sides() << "\">" << std::endl;
+     << " num_sides=\"" << rr_gsb.get_num_sides() << "\">" << "\n";
 
   /* Output each side */ 
   for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
@@ -62,7 +62,7 @@ void write_rr_switch_block_to_xml(const std::string fname_prefix,
          << "\" index=\"" << inode 
          << "\" mux_size=\"" << get_rr_graph_configurable_driver_nodes(rr_graph, cur_rr_node).size()
          << "\">" 
-         << std::endl; 
+         << "\n"; 
       /* General information of each driving nodes */
       for (const RRNodeId& driver_node : get_rr_graph_configurable_driver_nodes(rr_graph, cur_rr_node)) {
         /* Skip OPINs: they should be in direct connections */
@@ -88,11 +88,11 @@ void write_rr_switch_block_to_xml(const std::string fname_prefix,
            << "\" index=\"" << driver_node_index 
            << "\" segment_id=\"" << size_t(des_segment_id)
            << "\"/>" 
-           << std::endl; 
+           << "\n"; 
       }
       fp << "\t</" << rr_node_typename[rr_graph.node_type(cur_rr_node)] 
          << ">" 
-         << std::endl; 
+         << "\n"; 
     }
 
     /* Output chan nodes */
@@ -103,7 +103,8 @@ void write_rr_switch_block_to_xml(const std::string fname_prefix,
       }
       /* Output drivers */
       const RRNodeId& cur_rr_node = rr_gsb.get_chan_node(gsb_side, inode);
-      std::vector<RREdgeId> driver_rr_edges = rr_gsb.get_chan_node_in_edges(rr_graph, gsb_side, inode);
+      RRGraph::edge_range in_edges = rr_gsb.get_chan_node_in_edges(rr_graph, gsb_side, inode);
+      std::vector<RREdgeId> driver_rr_edges(in_edges.begin(), in_edges.end());
 
       /* Output node information: location, index, side */
       const RRSegmentId& src_segment_id = rr_gsb.get_chan_node_segment(gsb_side, inode);
@@ -119,7 +120,7 @@ void write_rr_switch_block_to_xml(const std::string fname_prefix,
          << "\" segment_id=\"" << size_t(src_segment_id)
          << "\" mux_size=\"" << driver_rr_edges.size()
          << "\">" 
-         << std::endl; 
+         << "\n"; 
 
       /* Direct connection: output the node on the opposite side */
       if (0 == driver_rr_edges.size()) {
@@ -129,7 +130,7 @@ void write_rr_switch_block_to_xml(const std::string fname_prefix,
            << "\" index=\"" << rr_gsb.get_node_index(rr_graph, cur_rr_node, oppo_side.get_side(), IN_PORT) 
            << "\" segment_id=\"" << size_t(src_segment_id)
            << "\"/>" 
-           << std::endl; 
+           << "\n"; 
       } else {
         for (const RREdgeId& driver_rr_edge : driver_rr_edges) {
           const RRNodeId& driver_rr_node = rr_graph.edge_src_node(driver_rr_edge);
@@ -146,7 +147,7 @@ void write_rr_switch_block_to_xml(const std::string fname_prefix,
                << "\" index=\"" << driver_node_index  
                << "\" grid_side=\"" <<  grid_side.to_string() 
                <<"\"/>" 
-               << std::endl; 
+               << "\n"; 
           } else {
             const RRSegmentId& des_segment_id = rr_gsb.get_chan_node_segment(driver_node_side, driver_node_index);
             fp << "\t\t<driver_node type=\"" << rr_node_typename[rr_graph.node_type(driver_rr_node)]
@@ -154,18 +155,59 @@ void write_rr_switch_block_to_xml(const std::string fname_prefix,
                << "\" index=\"" << driver_node_index 
                << "\" segment_id=\"" << size_t(des_segment_id)
                << "\"/>" 
-               << std::endl; 
+               << "\n"; 
           }
         }  
       }
       fp << "\t</" << rr_node_typename[rr_graph.node_type(cur_rr_node)]
          << ">" 
-         << std::endl; 
+         << "\n"; 
     }
   }
 
   fp << "</rr_gsb>" 
-     << std::endl;
+     << "\n";
+
+  /* close a file */
+  fp.close();
+}
+
+/***************************************************************************************
+ * Output the index of the unique switch blocks to an XML file,
+ * i.e., the unique mirror of the switch block of each RRGSB
+ * e.g.,
+ *   <unique_sb_index num_sbs="4" num_unique_sbs="2">
+ *     <sb x="0" y="0" unique_sb="sb_0__0_"/>
+ *     ...
+ *   </unique_sb_index>
+ * where the names of unique switch blocks are the names of their XML files
+ ***************************************************************************************/
+static 
+void write_unique_sb_index_to_xml(const std::string& fname,
+                                  const DeviceRRGSB& device_rr_gsb) {
+  vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
+
+  /* Create a file handler*/
+  BufferedFileStream fp;
+  /* Open a file */
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+
+  /* Validate the file stream */
+  check_file_stream(fname.c_str(), fp);
+
+  fp << "<unique_sb_index num_sbs=\"" << sb_range.x() * sb_range.y() << "\""
+     << " num_unique_sbs=\"" << device_rr_gsb.get_num_sb_unique_module() << "\">" << "\n";
+
+  for (size_t ix = 0; ix < sb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < sb_range.y(); ++iy) {
+      const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(vtr::Point<size_t>(ix, iy));
+      vtr::Point<size_t> unique_sb_coordinate(unique_mirror.get_sb_x(), unique_mirror.get_sb_y());
+      fp << "\t<sb x=\"" << ix << "\" y=\"" << iy << "\""
+         << " unique_sb=\"" << generate_switch_block_module_name(unique_sb_coordinate) << "\"/>" << "\n";
+    }
+  }
+
+  fp << "</unique_sb_index>" << "\n";
 
   /* close a file */
   fp.close();
@@ -174,10 +216,13 @@ void write_rr_switch_block_to_xml(const std::string fname_prefix,
 /***************************************************************************************
  * Output internal structure (only the switch block part) of all the RRGSBs
  * in a DeviceRRGSB  to XML format 
+ * When only the unique switch blocks are required, the unique mirrors are outputted,
+ * as well as an index file on the unique mirror of each switch block
  ***************************************************************************************/
 void write_device_rr_gsb_to_xml(const char* sb_xml_dir, 
                                 const RRGraph& rr_graph,
                                 const DeviceRRGSB& device_rr_gsb,
+                                const bool& unique,
                                 const bool& verbose) {
   std::string xml_dir_name = format_dir_path(std::string(sb_xml_dir));
 
@@ -188,6 +233,23 @@ void write_device_rr_gsb_to_xml(const char* sb_xml_dir,
 
   size_t gsb_counter = 0;
 
+  if (true == unique) {
+    /* For each unique switch block, an XML file will be outputted */
+    for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
+      write_rr_switch_block_to_xml(xml_dir_name, rr_graph, device_rr_gsb.get_sb_unique_module(isb), verbose);
+      gsb_counter++;
+    }
+
+    std::string index_fname = xml_dir_name + std::string(UNIQUE_SB_INDEX_FILE_NAME);
+    write_unique_sb_index_to_xml(index_fname, device_rr_gsb);
+
+    VTR_LOG("Output %lu XML files of unique switch blocks and the index '%s' to directory '%s'\n",
+            gsb_counter,
+            UNIQUE_SB_INDEX_FILE_NAME,
+            xml_dir_name.c_str());
+    return;
+  }
+
   /* For each switch block, an XML file will be outputted */
   for (size_t ix = 0; ix < sb_range.x(); ++ix) {
     for (size_t iy = 0; iy < sb_range.y(); ++iy) {
@@ -15,9 +15,13 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Name of the file on the unique mirror of each switch block, in the output directory */
+constexpr char UNIQUE_SB_INDEX_FILE_NAME[] = "unique_sb_index.xml";
+
 void write_device_rr_gsb_to_xml(const char* sb_xml_dir,
                                 const RRGraph& rr_graph,
                                 const DeviceRRGSB& device_rr_gsb,
+                                const bool& unique,
                                 const bool& verbose);
 
 } /* end namespace openfpga */
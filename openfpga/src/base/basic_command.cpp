@@ -15,7 +15,8 @@ void add_basic_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   Command shell_cmd_exit("exit");
   ShellCommandId shell_cmd_exit_id = shell.add_command(shell_cmd_exit, "Exit the shell");
   shell.set_command_class(shell_cmd_exit_id, basic_cmd_class);
-  shell.set_command_execute_function(shell_cmd_exit_id, [shell](){shell.exit();});
+  /* Note: exit refers to the shell itself (not a snapshot) to report the status and the profile of the executed commands */
+  shell.set_command_execute_function(shell_cmd_exit_id, [&shell](){shell.exit();});
 
   /* Note: help must be the last to add because the linking to execute function will do a snapshot on the shell */
   Command shell_cmd_help("help");
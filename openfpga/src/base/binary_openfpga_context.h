@@ -0,0 +1,93 @@
+/******************************************************************************
+ * This file introduces the binary file format of a checkpoint of the OpenFPGA context,
+ * which stores the results of the expensive commands, i.e., the fabric graph
+ * built by 'build_fabric' and the bitstreams built by 'build_architecture_bitstream'
+ * and 'build_fabric_bitstream', so that a later run can skip them.
+ *
+ * The other data of the context are not stored, as they are rebuilt in a short time
+ * by the commands which the checkpoint depends on:
+ *  - VPR contexts are restored by 'vpr' from the packing, placement and routing results
+ *  - the annotations, the device RR GSBs, the multiplexer library and the tile directs
+ *    are rebuilt by 'link_openfpga_arch' from the same architectures and VPR results
+ *
+ * File layout
+ * -----------
+ * All the fields are stored in the native byte order (little-endian on all the hosts we support)
+ *
+ *  +-------------------------------------------------------------+  offset 0
+ *  | Header (BinaryOpenfpgaContextHeader)                        |
+ *  +-------------------------------------------------------------+
+ *  | Fabric graph (see binary_fabric_graph.h)                    |  optional
+ *  +-------------------------------------------------------------+
+ *  | Architecture bitstream (see binary_arch_bitstream.h)        |  optional
+ *  +-------------------------------------------------------------+
+ *  | Fabric bitstream                                            |  optional
+ *  +-------------------------------------------------------------+
+ *
+ * The sections in the file are flagged in the header.
+ * The header also stores the secure digests of the architectures and of the design,
+ * i.e., the netlist, the placement and the routing, which the context is built for,
+ * so that a checkpoint is never restored for different inputs.
+ * The fabric bitstream is stored as
+ *  - a section header (BinaryOpenfpgaContextFabricBitstreamHeader)
+ *  - the number of bits of each configuration region (64-bit)
+ *  - the configuration bit of each fabric bit (64-bit), which is the index of the bit
+ *    in the architecture bitstream section, i.e., in the Depth-First Search order of the blocks
+ *  - when addresses are used, the address (64-bit) and the data input (8-bit) of each bit
+ *  - when WL addresses are used, the WL address (64-bit) of each bit
+ ******************************************************************************/
+#ifndef BINARY_OPENFPGA_CONTEXT_H
+#define BINARY_OPENFPGA_CONTEXT_H
+
+#include <cstddef>
+#include <cstdint>
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+constexpr char BINARY_OPENFPGA_CONTEXT_MAGIC[8] = {'O', 'F', 'P', 'G', 'A', 'C', 'T', 'X'};
+constexpr uint32_t BINARY_OPENFPGA_CONTEXT_VERSION = 2;
+/* Size of a digest field, which fits a secure digest string, e.g., 'SHA256:<64 hex digits>' */
+constexpr size_t BINARY_OPENFPGA_CONTEXT_DIGEST_LENGTH = 80;
+
+/* Flags of the sections stored in the file */
+enum e_binary_openfpga_context_section {
+  BINARY_OPENFPGA_CONTEXT_FABRIC_GRAPH = 0x1,
+  BINARY_OPENFPGA_CONTEXT_ARCH_BITSTREAM = 0x2,
+  BINARY_OPENFPGA_CONTEXT_FABRIC_BITSTREAM = 0x4
+};
+
+struct BinaryOpenfpgaContextHeader {
+  char magic[8];
+  uint32_t version;
+  /* Flags of e_binary_openfpga_context_section */
+  uint32_t sections;
+  /* Size of the device grid which the context is built for */
+  uint64_t grid_width;
+  uint64_t grid_height;
+  /* Value of e_config_protocol_type */
+  uint32_t config_protocol_type;
+  /* 1 if the routing hierarchy is compressed by 'build_fabric --compress_routing' */
+  uint32_t compress_routing;
+  /* Secure digests (NUL-padded) of the VPR and OpenFPGA architectures */
+  char arch_digest[BINARY_OPENFPGA_CONTEXT_DIGEST_LENGTH];
+  /* Secure digest (NUL-padded) of the atom netlist, the placement and the routing */
+  char design_digest[BINARY_OPENFPGA_CONTEXT_DIGEST_LENGTH];
+};
+
+struct BinaryOpenfpgaContextFabricBitstreamHeader {
+  uint64_t num_bits;
+  uint64_t num_regions;
+  uint8_t use_address;
+  uint8_t use_wl_address;
+  /* 1 if a data word is written at each WL address, whose width is word_din_length */
+  uint8_t use_word_din;
+  uint8_t reserved;
+  uint32_t word_din_length;
+  uint64_t address_length;
+  uint64_t wl_address_length;
+};
+
+} /* end namespace openfpga */
+
+#endif
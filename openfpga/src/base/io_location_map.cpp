@@ -1,6 +1,8 @@
 /******************************************************************************
  * Memember functions for data structure IoLocationMap
  ******************************************************************************/
+#include <algorithm>
+
 #include "vtr_assert.h"
 
 #include "io_location_map.h"
@@ -8,39 +10,72 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/**************************************************
+ * Public Constructor
+ *************************************************/
+IoLocationMap::IoLocationMap() {
+  width_ = 0;
+  height_ = 0;
+  depth_ = 0;
+}
+
 /**************************************************
  * Public Accessors 
  *************************************************/
 size_t IoLocationMap::io_index(const size_t& x, const size_t& y, const size_t& z) const {
-  if (x >= io_indices_.size()) {
+  if ( (x >= width_)
+    || (y >= height_)
+    || (z >= depth_) ) {
     return size_t(-1);
   }
 
-  if (y >= io_indices_[x].size()) {
-    return size_t(-1);
-  }
-
-  if (z >= io_indices_[x][y].size()) {
-    return size_t(-1);
-  }
+  return io_indices_[(x * height_ + y) * depth_ + z];
+}
 
-  return io_indices_[x][y][z];
+/**************************************************
+ * Public Mutators
+ *************************************************/
+void IoLocationMap::reserve(const size_t& width, const size_t& height, const size_t& depth) {
+  resize(std::max(width, width_), std::max(height, height_), std::max(depth, depth_));
 }
 
 void IoLocationMap::set_io_index(const size_t& x, const size_t& y, const size_t& z, const size_t& io_index) {
-  if (x >= io_indices_.size()) {
-    io_indices_.resize(x + 1);
+  /* The look-up grows geometrically, so that it is reorganized only a few times */
+  if ( (x >= width_)
+    || (y >= height_)
+    || (z >= depth_) ) {
+    resize((x < width_) ? width_ : std::max(x + 1, 2 * width_),
+           (y < height_) ? height_ : std::max(y + 1, 2 * height_),
+           (z < depth_) ? depth_ : std::max(z + 1, 2 * depth_));
   }
 
-  if (y >= io_indices_[x].size()) {
-    io_indices_[x].resize(y + 1);
+  io_indices_[(x * height_ + y) * depth_ + z] = io_index;
+}
+
+/**************************************************
+ * Private Mutators
+ *************************************************/
+void IoLocationMap::resize(const size_t& width, const size_t& height, const size_t& depth) {
+  if ( (width == width_)
+    && (height == height_)
+    && (depth == depth_) ) {
+    return;
   }
 
-  if (z >= io_indices_[x][y].size()) {
-    io_indices_[x][y].resize(z + 1);
+  VTR_ASSERT( (width >= width_) && (height >= height_) && (depth >= depth_) );
+  std::vector<size_t> io_indices(width * height * depth, size_t(-1));
+  for (size_t x = 0; x < width_; ++x) {
+    for (size_t y = 0; y < height_; ++y) {
+      std::copy(io_indices_.begin() + (x * height_ + y) * depth_,
+                io_indices_.begin() + (x * height_ + y + 1) * depth_,
+                io_indices.begin() + (x * height + y) * depth);
+    }
   }
 
-  io_indices_[x][y][z] = io_index;
+  io_indices_.swap(io_indices);
+  width_ = width;
+  height_ = height;
+  depth_ = depth;
 }
 
 } /* end namespace openfpga */
@@ -25,13 +25,28 @@ namespace openfpga {
  *
  *******************************************************************/
 class IoLocationMap {
+  public: /* Public constructor */
+    IoLocationMap();
   public: /* Public aggregators */
+    /* Return size_t(-1) if there is no I/O at the location */
     size_t io_index(const size_t& x, const size_t& y, const size_t& z) const;
   public: /* Public mutators */
+    /* Allocate the look-up for all the locations of a grid, where each location has up to depth I/Os
+     * This avoids the look-up to be reorganized when I/O indices are added
+     */
+    void reserve(const size_t& width, const size_t& height, const size_t& depth);
     void set_io_index(const size_t& x, const size_t& y, const size_t& z, const size_t& io_index);
   private: /* Internal Data */
-    /* I/O index fast lookup by [x][y][z] location */
-    std::vector<std::vector<std::vector<size_t>>> io_indices_;
+    /* Reorganize the look-up to the given size, while keeping the I/O indices */
+    void resize(const size_t& width, const size_t& height, const size_t& depth);
+
+    /* I/O index fast lookup by [x][y][z] location,
+     * which is stored as a dense array, i.e., [(x * height + y) * depth + z]
+     */
+    size_t width_;
+    size_t height_;
+    size_t depth_;
+    std::vector<size_t> io_indices_;
 };
 
 } /* End namespace openfpga*/
@@ -1,24 +1,42 @@
 /********************************************************************
  * This file includes functions to build bitstream database
  *******************************************************************/
+#include <stdexcept>
+#include <string>
+
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_log.h"
+#include "vtr_error.h"
+#include "vtr_parallel.h"
+#include "vtr_mapped_storage.h"
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_tokenizer.h"
 
 /* Headers from fpgabitstream library */
 #include "read_xml_arch_bitstream.h"
 #include "write_xml_arch_bitstream.h"
+#include "read_binary_arch_bitstream.h"
+#include "write_binary_arch_bitstream.h"
+#include "compare_arch_bitstream.h"
+#include "merge_arch_bitstream.h"
+
+#include "openfpga_naming.h"
+#include "device_shard_utils.h"
 
 #include "build_device_bitstream.h"
 #include "write_text_fabric_bitstream.h"
 #include "write_xml_fabric_bitstream.h"
+#include "write_binary_fabric_bitstream.h"
+#include "send_fabric_bitstream.h"
 #include "build_fabric_bitstream.h"
+#include "build_partial_fabric_bitstream.h"
+#include "openfpga_command_threads.h"
 #include "openfpga_bitstream.h"
 
 /* Include global variables of VPR */
@@ -27,6 +45,87 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * Read an architecture bitstream file in the given format
+ * Errors in the file are reported instead of aborting the shell
+ *******************************************************************/
+static 
+int read_architecture_bitstream_file(BitstreamManager& bitstream_manager,
+                                     const std::string& fname,
+                                     const std::string& file_format) {
+  try {
+    if (std::string("binary") == file_format) {
+      bitstream_manager = read_binary_architecture_bitstream(fname.c_str());
+    } else {
+      bitstream_manager = read_xml_architecture_bitstream(fname.c_str());
+    }
+  } catch (const vtr::VtrError& error) {
+    VTR_LOG_ERROR("%s\n", error.what());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Merge the bitstream databases of the shards of a device,
+ * which should cover all the configurable blocks of the fabric
+ *******************************************************************/
+static 
+int merge_fpga_bitstream_shards(OpenfpgaContext& openfpga_ctx,
+                                const std::string& shard_file_list,
+                                const std::string& file_format,
+                                const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Merge bitstream databases of shards");
+
+  BitstreamManager bitstream_manager;
+
+  StringToken shard_file_tokenizer(shard_file_list);
+  std::vector<std::string> shard_fnames = shard_file_tokenizer.split(',');
+  for (const std::string& shard_fname : shard_fnames) {
+    VTR_LOGV(verbose, "Merging bitstream database '%s'\n", shard_fname.c_str());
+    /* Each shard is released once merged, to limit the memory footprint */
+    BitstreamManager shard_bitstream_manager;
+    if (CMD_EXEC_SUCCESS != read_architecture_bitstream_file(shard_bitstream_manager, shard_fname, file_format)) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    if (0 != merge_architecture_bitstream(bitstream_manager, shard_bitstream_manager, shard_fname)) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  if (0 == bitstream_manager.num_blocks()) {
+    VTR_LOG_ERROR("No bitstream database of shards is given to merge!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Each configurable child of the top-level module should be built by one of the shards */
+  const ModuleManager& module_manager = openfpga_ctx.module_graph();
+  ModuleId top_module = module_manager.find_module(generate_fpga_top_module_name());
+  VTR_ASSERT(true == module_manager.valid_module_id(top_module));
+  const ConfigBlockId top_block = ConfigBlockId(0);
+  size_t num_missing_blocks = 0;
+  for (size_t ichild = 0; ichild < module_manager.configurable_children(top_module).size(); ++ichild) {
+    std::string instance_name = module_manager.instance_name(top_module,
+                                                             module_manager.configurable_children(top_module)[ichild],
+                                                             module_manager.configurable_child_instances(top_module)[ichild]);
+    if (false == bitstream_manager.valid_block_id(bitstream_manager.find_child_block(top_block, instance_name))) {
+      VTR_LOG_ERROR("Block '%s' is not built by any of the shards!\n",
+                    instance_name.c_str());
+      num_missing_blocks++;
+    }
+  }
+  if (0 < num_missing_blocks) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  VTR_LOG("Merged %lu shards into %lu blocks and %lu configuration bits\n",
+          shard_fnames.size(), bitstream_manager.num_blocks(), bitstream_manager.num_bits());
+
+  openfpga_ctx.mutable_bitstream_manager() = std::move(bitstream_manager);
+
+  return CMD_EXEC_SUCCESS;
+}
+
 /********************************************************************
  * A wrapper function to call the build_device_bitstream() in FPGA bitstream
  *******************************************************************/
@@ -36,12 +135,77 @@ int fpga_bitstream(OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_verbose = cmd.option("verbose");
   CommandOptionId opt_write_file = cmd.option("write_file");
   CommandOptionId opt_read_file = cmd.option("read_file");
+  CommandOptionId opt_file_format = cmd.option("format");
+  CommandOptionId opt_mapped_storage = cmd.option("mapped_storage");
+  CommandOptionId opt_shard_region = cmd.option("shard_region");
+  CommandOptionId opt_merge_files = cmd.option("merge_files");
+
+  /* Check file format requirements */
+  std::string file_format("xml");
+  if (true == cmd_context.option_enable(cmd, opt_file_format)) {
+    file_format = cmd_context.option_value(cmd, opt_file_format);
+  }
+  if ( (std::string("xml") != file_format)
+    && (std::string("binary") != file_format) ) {
+    VTR_LOG_ERROR("Invalid file format '%s' which should be [xml|binary]!\n",
+                  file_format.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  int num_threads = get_num_threads(cmd, cmd_context, vtr::num_workers());
+  if (0 == num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* A database is either read, merged from shards or built */
+  if ( (true == cmd_context.option_enable(cmd, opt_merge_files))
+    && (true == cmd_context.option_enable(cmd, opt_read_file)) ) {
+    VTR_LOG_ERROR("Option '--merge_files' cannot be used with '--read_file'!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  if ( (true == cmd_context.option_enable(cmd, opt_shard_region))
+    && ( (true == cmd_context.option_enable(cmd, opt_read_file))
+      || (true == cmd_context.option_enable(cmd, opt_merge_files)) ) ) {
+    VTR_LOG_ERROR("Option '--shard_region' can only be used when the bitstream database is built!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Only the blocks in a window of the device are built, if specified */
+  vtr::Rect<size_t> shard_region = find_device_full_shard_region(g_vpr_ctx.device().grid);
+  if ( (true == cmd_context.option_enable(cmd, opt_shard_region))
+    && (false == parse_device_shard_region(cmd_context.option_value(cmd, opt_shard_region), shard_region)) ) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* The bitstream database is built in memory-mapped temporary files, if specified */
+  std::string mapped_storage_dir;
+  if (true == cmd_context.option_enable(cmd, opt_mapped_storage)) {
+    mapped_storage_dir = cmd_context.option_value(cmd, opt_mapped_storage);
+    create_directory(mapped_storage_dir);
+  }
+  vtr::ScopedMappedStorage mapped_storage(mapped_storage_dir);
 
   if (true == cmd_context.option_enable(cmd, opt_read_file)) {
-    openfpga_ctx.mutable_bitstream_manager() = read_xml_architecture_bitstream(cmd_context.option_value(cmd, opt_read_file).c_str());
+    int status = read_architecture_bitstream_file(openfpga_ctx.mutable_bitstream_manager(),
+                                                  cmd_context.option_value(cmd, opt_read_file),
+                                                  file_format);
+    if (CMD_EXEC_SUCCESS != status) {
+      return status;
+    }
+  } else if (true == cmd_context.option_enable(cmd, opt_merge_files)) {
+    int status = merge_fpga_bitstream_shards(openfpga_ctx,
+                                             cmd_context.option_value(cmd, opt_merge_files),
+                                             file_format,
+                                             cmd_context.option_enable(cmd, opt_verbose));
+    if (CMD_EXEC_SUCCESS != status) {
+      return status;
+    }
   } else {
     openfpga_ctx.mutable_bitstream_manager() = build_device_bitstream(g_vpr_ctx,
                                                                       openfpga_ctx,
+                                                                      cmd_context.option_enable(cmd, opt_write_file),
+                                                                      shard_region,
+                                                                      size_t(num_threads),
                                                                       cmd_context.option_enable(cmd, opt_verbose));
   }
 
@@ -51,14 +215,174 @@ int fpga_bitstream(OpenfpgaContext& openfpga_ctx,
     /* Create directories */
     create_directory(src_dir_path);
 
-    write_xml_architecture_bitstream(openfpga_ctx.bitstream_manager(),
-                                     cmd_context.option_value(cmd, opt_write_file));
+    if (std::string("binary") == file_format) {
+      write_binary_architecture_bitstream(openfpga_ctx.bitstream_manager(),
+                                          cmd_context.option_value(cmd, opt_write_file));
+    } else {
+      write_xml_architecture_bitstream(openfpga_ctx.bitstream_manager(),
+                                       cmd_context.option_value(cmd, opt_write_file));
+    }
   }
 
   /* TODO: should identify the error code from internal function execution */
   return CMD_EXEC_SUCCESS;
 }
 
+/********************************************************************
+ * Parse a list of coordinates in the format of 'x0,y0;x1,y1;...'
+ * Return false if the list is not valid
+ *******************************************************************/
+static 
+bool parse_bitstream_coordinates(const std::string& coord_list,
+                                 std::vector<vtr::Point<size_t>>& coordinates) {
+  StringToken coord_list_tokenizer(coord_list);
+  for (const std::string& coord : coord_list_tokenizer.split(';')) {
+    StringToken coord_tokenizer(coord);
+    std::vector<std::string> xy = coord_tokenizer.split(',');
+    if ( (2 != xy.size())
+      || (true == xy[0].empty())
+      || (true == xy[1].empty())
+      || (std::string::npos != xy[0].find_first_not_of("0123456789"))
+      || (std::string::npos != xy[1].find_first_not_of("0123456789")) ) {
+      VTR_LOG_ERROR("Invalid coordinate '%s' which should be in the format of 'x,y'!\n",
+                    coord.c_str());
+      return false;
+    }
+    /* Digits only, so the conversion can only fail on a too large number */
+    try {
+      coordinates.push_back(vtr::Point<size_t>(std::stoul(xy[0]), std::stoul(xy[1])));
+    } catch (const std::out_of_range&) {
+      VTR_LOG_ERROR("Invalid coordinate '%s' which should be in the format of 'x,y'!\n",
+                    coord.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+/********************************************************************
+ * A wrapper function to call the update_device_bitstream() in FPGA bitstream
+ * The fabric-dependent bitstream is also updated if it has been built
+ *******************************************************************/
+int update_fpga_bitstream(OpenfpgaContext& openfpga_ctx,
+                          const Command& cmd, const CommandContext& cmd_context) {
+
+  CommandOptionId opt_verbose = cmd.option("verbose");
+  CommandOptionId opt_grids = cmd.option("grids");
+  CommandOptionId opt_gsbs = cmd.option("gsbs");
+
+  std::vector<vtr::Point<size_t>> grid_coordinates;
+  if ( (true == cmd_context.option_enable(cmd, opt_grids))
+    && (false == parse_bitstream_coordinates(cmd_context.option_value(cmd, opt_grids), grid_coordinates)) ) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  for (const vtr::Point<size_t>& coord : grid_coordinates) {
+    if ( (coord.x() >= g_vpr_ctx.device().grid.width())
+      || (coord.y() >= g_vpr_ctx.device().grid.height()) ) {
+      VTR_LOG_ERROR("Grid coordinate (%lu, %lu) is out of the device!\n",
+                    coord.x(), coord.y());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  std::vector<vtr::Point<size_t>> gsb_coordinates;
+  if ( (true == cmd_context.option_enable(cmd, opt_gsbs))
+    && (false == parse_bitstream_coordinates(cmd_context.option_value(cmd, opt_gsbs), gsb_coordinates)) ) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  vtr::Point<size_t> gsb_range = openfpga_ctx.device_rr_gsb().get_gsb_range();
+  for (const vtr::Point<size_t>& coord : gsb_coordinates) {
+    if ( (coord.x() >= gsb_range.x())
+      || (coord.y() >= gsb_range.y()) ) {
+      VTR_LOG_ERROR("GSB coordinate (%lu, %lu) is out of the device!\n",
+                    coord.x(), coord.y());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  size_t num_changed_bits = update_device_bitstream(openfpga_ctx.mutable_bitstream_manager(),
+                                                    g_vpr_ctx,
+                                                    openfpga_ctx,
+                                                    grid_coordinates,
+                                                    gsb_coordinates,
+                                                    cmd_context.option_enable(cmd, opt_verbose));
+
+  /* Patch the fabric-dependent bitstream, whose bits refer to the same configuration bits */
+  if ( (0 < num_changed_bits)
+    && (0 < openfpga_ctx.fabric_bitstream().num_bits()) ) {
+    update_fabric_dependent_bitstream(openfpga_ctx.mutable_fabric_bitstream(),
+                                      openfpga_ctx.bitstream_manager());
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * A wrapper function to call the compare_architecture_bitstreams() in FPGA bitstream
+ * Return a minor error when the bitstream databases differ
+ *******************************************************************/
+int compare_fpga_bitstream(const OpenfpgaContext& openfpga_ctx,
+                           const Command& cmd, const CommandContext& cmd_context) {
+  vtr::ScopedStartFinishTimer timer("Compare bitstream databases");
+
+  CommandOptionId opt_verbose = cmd.option("verbose");
+  CommandOptionId opt_ref = cmd.option("ref");
+  CommandOptionId opt_file_format = cmd.option("format");
+  CommandOptionId opt_max_differences = cmd.option("max_differences");
+
+  /* Check file format requirements */
+  std::string file_format("xml");
+  if (true == cmd_context.option_enable(cmd, opt_file_format)) {
+    file_format = cmd_context.option_value(cmd, opt_file_format);
+  }
+  if ( (std::string("xml") != file_format)
+    && (std::string("binary") != file_format) ) {
+    VTR_LOG_ERROR("Invalid file format '%s' which should be [xml|binary]!\n",
+                  file_format.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  int max_differences = 100;
+  if (true == cmd_context.option_enable(cmd, opt_max_differences)) {
+    max_differences = std::atoi(cmd_context.option_value(cmd, opt_max_differences).c_str());
+    if (1 > max_differences) {
+      VTR_LOG_ERROR("Invalid maximum number of differences '%d' which should be a positive number!\n",
+                    max_differences);
+      return CMD_EXEC_FATAL_ERROR; 
+    }
+  }
+
+  std::string ref_fname = cmd_context.option_value(cmd, opt_ref);
+  BitstreamManager ref_bitstream_manager;
+  if (CMD_EXEC_SUCCESS != read_architecture_bitstream_file(ref_bitstream_manager, ref_fname, file_format)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  std::vector<BitstreamDifference> differences = compare_architecture_bitstreams(openfpga_ctx.bitstream_manager(),
+                                                                                 ref_bitstream_manager,
+                                                                                 size_t(max_differences));
+  if (true == differences.empty()) {
+    VTR_LOG("Bitstream database is the same as the reference '%s'\n",
+            ref_fname.c_str());
+    return CMD_EXEC_SUCCESS;
+  }
+
+  for (const BitstreamDifference& difference : differences) {
+    VTR_LOG("Block '%s' differs: %s\n",
+            difference.block_path.c_str(), difference.reason.c_str());
+  }
+  VTR_LOG_WARN("Bitstream database differs from the reference '%s' in %s%lu blocks\n",
+               ref_fname.c_str(),
+               differences.size() >= size_t(max_differences) ? "at least " : "",
+               differences.size());
+  VTR_LOGV(cmd_context.option_enable(cmd, opt_verbose),
+           "Compared %lu blocks to %lu reference blocks\n",
+           openfpga_ctx.bitstream_manager().num_blocks(),
+           ref_bitstream_manager.num_blocks());
+
+  return CMD_EXEC_MINOR_ERROR;
+}
+
 /********************************************************************
  * A wrapper function to call the build_fabric_bitstream() in FPGA bitstream
  *******************************************************************/
@@ -66,13 +390,83 @@ int build_fabric_bitstream(OpenfpgaContext& openfpga_ctx,
                            const Command& cmd, const CommandContext& cmd_context) {
 
   CommandOptionId opt_verbose = cmd.option("verbose");
+  CommandOptionId opt_write_file = cmd.option("write_file");
+  CommandOptionId opt_mapped_storage = cmd.option("mapped_storage");
+  CommandOptionId opt_checksum = cmd.option("checksum");
+  CommandOptionId opt_checksum_segment_size = cmd.option("checksum_segment_size");
+
+  const ConfigProtocol& config_protocol = openfpga_ctx.arch().config_protocol;
+
+  /* A segment size implies the checksums, a single checksum per region by default */
+  bool build_checksums = cmd_context.option_enable(cmd, opt_checksum);
+  int checksum_segment_size = 0;
+  if (true == cmd_context.option_enable(cmd, opt_checksum_segment_size)) {
+    build_checksums = true;
+    checksum_segment_size = std::atoi(cmd_context.option_value(cmd, opt_checksum_segment_size).c_str());
+    if (1 > checksum_segment_size) {
+      VTR_LOG_ERROR("Invalid checksum segment size '%d' which should be a positive number!\n",
+                    checksum_segment_size);
+      return CMD_EXEC_FATAL_ERROR; 
+    }
+  }
+
+  /* The fabric bitstream is built in memory-mapped temporary files, if specified */
+  std::string mapped_storage_dir;
+  if (true == cmd_context.option_enable(cmd, opt_mapped_storage)) {
+    mapped_storage_dir = cmd_context.option_value(cmd, opt_mapped_storage);
+    create_directory(mapped_storage_dir);
+  }
+  vtr::ScopedMappedStorage mapped_storage(mapped_storage_dir);
+
+  if (true == cmd_context.option_enable(cmd, opt_write_file)) {
+    std::string src_dir_path = find_path_dir_name(cmd_context.option_value(cmd, opt_write_file));
+
+    /* Create directories */
+    create_directory(src_dir_path);
+
+    /* For a single configuration chain, the bits are written on the fly without being stored,
+     * unless checksums are required, which are stored in the fabric bitstream
+     */
+    if ( (false == build_checksums)
+      && ( (CONFIG_MEM_STANDALONE == config_protocol.type())
+        || ( (CONFIG_MEM_SCAN_CHAIN == config_protocol.type())
+          && (1 == config_protocol.num_regions()) ) ) ) {
+      /* Release the fabric bitstream of a previous run, which is outdated */
+      openfpga_ctx.mutable_fabric_bitstream() = FabricBitstream();
+      if (0 != write_fabric_dependent_chain_bitstream_to_text_file(openfpga_ctx.bitstream_manager(),
+                                                                   openfpga_ctx.module_graph(),
+                                                                   config_protocol,
+                                                                   cmd_context.option_value(cmd, opt_write_file),
+                                                                   cmd_context.option_enable(cmd, opt_verbose))) {
+        return CMD_EXEC_FATAL_ERROR;
+      }
+      return CMD_EXEC_SUCCESS;
+    }
+  }
 
   /* Build fabric bitstream here */
   openfpga_ctx.mutable_fabric_bitstream() = build_fabric_dependent_bitstream(openfpga_ctx.bitstream_manager(),
                                                                              openfpga_ctx.module_graph(),
-                                                                             openfpga_ctx.arch().config_protocol,
+                                                                             config_protocol,
                                                                              cmd_context.option_enable(cmd, opt_verbose));
 
+  if (true == build_checksums) {
+    build_fabric_bitstream_checksums(openfpga_ctx.mutable_fabric_bitstream(),
+                                     openfpga_ctx.bitstream_manager(),
+                                     size_t(checksum_segment_size),
+                                     cmd_context.option_enable(cmd, opt_verbose));
+  }
+
+  if (true == cmd_context.option_enable(cmd, opt_write_file)) {
+    if (0 != write_fabric_bitstream_to_text_file(openfpga_ctx.bitstream_manager(),
+                                                 openfpga_ctx.fabric_bitstream(),
+                                                 config_protocol,
+                                                 cmd_context.option_value(cmd, opt_write_file),
+                                                 cmd_context.option_enable(cmd, opt_verbose))) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
   /* TODO: should identify the error code from internal function execution */
   return CMD_EXEC_SUCCESS;
 }
@@ -86,6 +480,8 @@ int write_fabric_bitstream(const OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_verbose = cmd.option("verbose");
   CommandOptionId opt_file = cmd.option("file");
   CommandOptionId opt_file_format = cmd.option("format");
+  CommandOptionId opt_partial = cmd.option("partial");
+  CommandOptionId opt_baseline = cmd.option("baseline");
 
   /* Write fabric bitstream if required */
   int status = CMD_EXEC_SUCCESS;
@@ -103,16 +499,54 @@ int write_fabric_bitstream(const OpenfpgaContext& openfpga_ctx,
     file_format = cmd_context.option_value(cmd, opt_file_format);
   }
 
+  if ( (true == cmd_context.option_enable(cmd, opt_baseline))
+    && (false == cmd_context.option_enable(cmd, opt_partial)) ) {
+    VTR_LOG_ERROR("Option '--baseline' is only valid with '--partial'!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Build the partial bitstream if required, which is then written as a regular fabric bitstream */
+  FabricBitstream partial_fabric_bitstream;
+  if (true == cmd_context.option_enable(cmd, opt_partial)) {
+    std::string baseline_fname;
+    if (true == cmd_context.option_enable(cmd, opt_baseline)) {
+      baseline_fname = cmd_context.option_value(cmd, opt_baseline);
+    }
+    if (0 != build_partial_fabric_bitstream(partial_fabric_bitstream,
+                                            openfpga_ctx.bitstream_manager(),
+                                            openfpga_ctx.fabric_bitstream(),
+                                            openfpga_ctx.arch().config_protocol,
+                                            baseline_fname,
+                                            cmd_context.option_enable(cmd, opt_verbose))) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+  const FabricBitstream& fabric_bitstream = (true == cmd_context.option_enable(cmd, opt_partial))
+                                          ? partial_fabric_bitstream
+                                          : openfpga_ctx.fabric_bitstream();
+
   if (std::string("xml") == file_format) {
     status = write_fabric_bitstream_to_xml_file(openfpga_ctx.bitstream_manager(),
-                                                openfpga_ctx.fabric_bitstream(),
+                                                fabric_bitstream,
                                                 openfpga_ctx.arch().config_protocol,
                                                 cmd_context.option_value(cmd, opt_file),
                                                 cmd_context.option_enable(cmd, opt_verbose));
+  } else if (std::string("binary") == file_format) {
+    status = write_fabric_bitstream_to_binary_file(openfpga_ctx.bitstream_manager(),
+                                                   fabric_bitstream,
+                                                   openfpga_ctx.arch().config_protocol,
+                                                   cmd_context.option_value(cmd, opt_file),
+                                                   cmd_context.option_enable(cmd, opt_verbose));
+  } else if (std::string("compressed") == file_format) {
+    status = write_fabric_bitstream_to_compressed_file(openfpga_ctx.bitstream_manager(),
+                                                       fabric_bitstream,
+                                                       openfpga_ctx.arch().config_protocol,
+                                                       cmd_context.option_value(cmd, opt_file),
+                                                       cmd_context.option_enable(cmd, opt_verbose));
   } else {
     /* By default, output in plain text format */
     status = write_fabric_bitstream_to_text_file(openfpga_ctx.bitstream_manager(),
-                                                 openfpga_ctx.fabric_bitstream(),
+                                                 fabric_bitstream,
                                                  openfpga_ctx.arch().config_protocol,
                                                  cmd_context.option_value(cmd, opt_file),
                                                  cmd_context.option_enable(cmd, opt_verbose));
@@ -121,4 +555,56 @@ int write_fabric_bitstream(const OpenfpgaContext& openfpga_ctx,
   return status;
 } 
 
+/********************************************************************
+ * A wrapper function to hand over the fabric bitstream to a programmer
+ * in the binary format, without writing any file
+ * Nothing else is printed when the bitstream is sent to the standard output,
+ * so that the programmer only receives the bytes of the bitstream
+ *******************************************************************/
+int send_fabric_bitstream(const OpenfpgaContext& openfpga_ctx,
+                          const Command& cmd, const CommandContext& cmd_context) {
+
+  CommandOptionId opt_verbose = cmd.option("verbose");
+  CommandOptionId opt_socket = cmd.option("socket");
+
+  bool use_socket = cmd_context.option_enable(cmd, opt_socket);
+
+  std::string buffer;
+  if (false == use_socket) {
+    if (0 != build_fabric_bitstream_binary_buffer(openfpga_ctx.bitstream_manager(),
+                                                  openfpga_ctx.fabric_bitstream(),
+                                                  openfpga_ctx.arch().config_protocol,
+                                                  buffer)) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    if (0 != send_fabric_bitstream_to_stdout(buffer)) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    return CMD_EXEC_SUCCESS;
+  }
+
+  std::string socket_file_name = cmd_context.option_value(cmd, opt_socket);
+
+  std::string timer_message = std::string("Send ") + std::to_string(openfpga_ctx.fabric_bitstream().num_bits()) + std::string(" fabric bitstream to socket '") + socket_file_name + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  if (0 != build_fabric_bitstream_binary_buffer(openfpga_ctx.bitstream_manager(),
+                                                openfpga_ctx.fabric_bitstream(),
+                                                openfpga_ctx.arch().config_protocol,
+                                                buffer)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  if (0 != send_fabric_bitstream_to_socket(buffer, socket_file_name)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  VTR_LOGV(cmd_context.option_enable(cmd, opt_verbose),
+           "Sent %lu configuration bits in %lu bytes to socket: %s\n",
+           openfpga_ctx.fabric_bitstream().bits().size(),
+           buffer.size(),
+           socket_file_name.c_str());
+
+  return CMD_EXEC_SUCCESS;
+} 
+
 } /* end namespace openfpga */
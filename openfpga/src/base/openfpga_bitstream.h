@@ -18,12 +18,21 @@ namespace openfpga {
 int fpga_bitstream(OpenfpgaContext& openfpga_ctx,
                    const Command& cmd, const CommandContext& cmd_context); 
 
+int update_fpga_bitstream(OpenfpgaContext& openfpga_ctx,
+                          const Command& cmd, const CommandContext& cmd_context); 
+
+int compare_fpga_bitstream(const OpenfpgaContext& openfpga_ctx,
+                           const Command& cmd, const CommandContext& cmd_context); 
+
 int build_fabric_bitstream(OpenfpgaContext& openfpga_ctx,
                            const Command& cmd, const CommandContext& cmd_context);
 
 int write_fabric_bitstream(const OpenfpgaContext& openfpga_ctx,
                            const Command& cmd, const CommandContext& cmd_context);
 
+int send_fabric_bitstream(const OpenfpgaContext& openfpga_ctx,
+                          const Command& cmd, const CommandContext& cmd_context);
+
 } /* end namespace openfpga */
 
 #endif
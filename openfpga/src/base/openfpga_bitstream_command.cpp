@@ -21,6 +21,13 @@ ShellCommandId add_openfpga_repack_command(openfpga::Shell<OpenfpgaContext>& she
                                            const ShellCommandClassId& cmd_class_id,
                                            const std::vector<ShellCommandId>& dependent_cmds) {
   Command shell_cmd("repack");
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Specify the number of threads used to repack clustered blocks");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
+  /* Add an option '--astar' */
+  shell_cmd.add_option("astar", false, "Use the A* search with lookahead when routing the logical tiles");
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
   
@@ -54,6 +61,25 @@ ShellCommandId add_openfpga_build_arch_bitstream_command(openfpga::Shell<Openfpg
   CommandOptionId opt_read_file = shell_cmd.add_option("read_file", false, "file path to read the bitstream database");
   shell_cmd.set_option_require_value(opt_read_file, openfpga::OPT_STRING);
 
+  /* Add an option '--format' */
+  CommandOptionId opt_file_format = shell_cmd.add_option("format", false, "file format of the bitstream database to write or read [xml|binary]. Default: xml");
+  shell_cmd.set_option_require_value(opt_file_format, openfpga::OPT_STRING);
+
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Specify the number of threads used to build the bitstream database");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
+  /* Add an option '--mapped_storage' */
+  CommandOptionId opt_mapped_storage = shell_cmd.add_option("mapped_storage", false, "directory of the temporary files where the bitstream database is stored out of the memory");
+  shell_cmd.set_option_require_value(opt_mapped_storage, openfpga::OPT_STRING);
+
+  /* Add an option '--shard_region' */
+  CommandOptionId opt_shard_region = shell_cmd.add_option("shard_region", false, "only build the grids and routing blocks in a window of the device, in the format of 'xlow,ylow,xhigh,yhigh'");
+  shell_cmd.set_option_require_value(opt_shard_region, openfpga::OPT_STRING);
+
+  /* Add an option '--merge_files' */
+  CommandOptionId opt_merge_files = shell_cmd.add_option("merge_files", false, "file paths to the bitstream databases of shards to be merged, in the format of 'file0,file1,...'");
+  shell_cmd.set_option_require_value(opt_merge_files, openfpga::OPT_STRING);
 
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
@@ -69,6 +95,76 @@ ShellCommandId add_openfpga_build_arch_bitstream_command(openfpga::Shell<Openfpg
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: compare_bitstream
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_compare_bitstream_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                      const ShellCommandClassId& cmd_class_id,
+                                                      const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("compare_bitstream");
+
+  /* Add an option '--ref' */
+  CommandOptionId opt_ref = shell_cmd.add_option("ref", true, "file path to the reference bitstream database");
+  shell_cmd.set_option_require_value(opt_ref, openfpga::OPT_STRING);
+
+  /* Add an option '--format' */
+  CommandOptionId opt_file_format = shell_cmd.add_option("format", false, "file format of the reference bitstream database [xml|binary]. Default: xml");
+  shell_cmd.set_option_require_value(opt_file_format, openfpga::OPT_STRING);
+
+  /* Add an option '--max_differences' */
+  CommandOptionId opt_max_differences = shell_cmd.add_option("max_differences", false, "Specify the maximum number of differing blocks to report. Default: 100");
+  shell_cmd.set_option_require_value(opt_max_differences, openfpga::OPT_INT);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+  
+  /* Add command 'compare_bitstream' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Compare the fabric-independent bitstream database to a reference");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(shell_cmd_id, compare_fpga_bitstream);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: update_architecture_bitstream
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_update_arch_bitstream_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                          const ShellCommandClassId& cmd_class_id,
+                                                          const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("update_architecture_bitstream");
+
+  /* Add an option '--grids' */
+  CommandOptionId opt_grids = shell_cmd.add_option("grids", false, "coordinates of grids to be updated, in the format of 'x0,y0;x1,y1;...'");
+  shell_cmd.set_option_require_value(opt_grids, openfpga::OPT_STRING);
+
+  /* Add an option '--gsbs' */
+  CommandOptionId opt_gsbs = shell_cmd.add_option("gsbs", false, "coordinates of General Switch Blocks (GSBs) to be updated, in the format of 'x0,y0;x1,y1;...'");
+  shell_cmd.set_option_require_value(opt_gsbs, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+  
+  /* Add command 'update_architecture_bitstream' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Update the fabric-independent bitstream database for a few grids and routing blocks");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, update_fpga_bitstream);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 /********************************************************************
  * - Add a command to Shell environment: build_fabric_bitstream
  * - Add associated options 
@@ -80,6 +176,21 @@ ShellCommandId add_openfpga_build_fabric_bitstream_command(openfpga::Shell<Openf
                                                            const std::vector<ShellCommandId>& dependent_cmds) {
   Command shell_cmd("build_fabric_bitstream");
 
+  /* Add an option '--write_file' */
+  CommandOptionId opt_write_file = shell_cmd.add_option("write_file", false, "file path to output the fabric bitstream in plain text while it is built");
+  shell_cmd.set_option_require_value(opt_write_file, openfpga::OPT_STRING);
+
+  /* Add an option '--mapped_storage' */
+  CommandOptionId opt_mapped_storage = shell_cmd.add_option("mapped_storage", false, "directory of the temporary files where the fabric bitstream is stored out of the memory");
+  shell_cmd.set_option_require_value(opt_mapped_storage, openfpga::OPT_STRING);
+
+  /* Add an option '--checksum' */
+  shell_cmd.add_option("checksum", false, "Build a CRC-32C checksum for each configuration region, to verify the readback of the fabric");
+
+  /* Add an option '--checksum_segment_size' */
+  CommandOptionId opt_checksum_segment_size = shell_cmd.add_option("checksum_segment_size", false, "Specify the number of bits covered by each checksum, e.g., the size of a frame. Default: a configuration region");
+  shell_cmd.set_option_require_value(opt_checksum_segment_size, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -111,16 +222,52 @@ ShellCommandId add_openfpga_write_fabric_bitstream_command(openfpga::Shell<Openf
   shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
 
   /* Add an option '--file_format'*/
-  CommandOptionId opt_file_format = shell_cmd.add_option("format", false, "file format of fabric bitstream [plain_text|xml]. Default: plain_text");
+  CommandOptionId opt_file_format = shell_cmd.add_option("format", false, "file format of fabric bitstream [plain_text|xml|binary|compressed]. Default: plain_text");
   shell_cmd.set_option_require_value(opt_file_format, openfpga::OPT_STRING);
 
+  /* Add an option '--partial'*/
+  shell_cmd.add_option("partial", false, "Only output the frames which are different from the baseline");
+
+  /* Add an option '--baseline'*/
+  CommandOptionId opt_baseline = shell_cmd.add_option("baseline", false, "file path to the baseline bitstream in binary format. Default: the reset state of the fabric");
+  shell_cmd.set_option_require_value(opt_baseline, openfpga::OPT_STRING);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
   /* Add command 'fabric_bitstream' to the Shell */
   ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Write the fabric-dependent bitstream to a file");
   shell.set_command_class(shell_cmd_id, cmd_class_id);
-  shell.set_command_execute_function(shell_cmd_id, write_fabric_bitstream);
+  shell.set_command_const_execute_function(shell_cmd_id, write_fabric_bitstream);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: send_fabric_bitstream
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_send_fabric_bitstream_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                          const ShellCommandClassId& cmd_class_id,
+                                                          const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("send_fabric_bitstream");
+
+  /* Add an option '--socket'*/
+  CommandOptionId opt_socket = shell_cmd.add_option("socket", false, "file path to the local socket of the programmer. Default: the bitstream is written to the standard output");
+  shell_cmd.set_option_require_value(opt_socket, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+
+  /* Add command 'send_fabric_bitstream' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Send the fabric-dependent bitstream in binary format to a programmer without writing any file");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(shell_cmd_id, send_fabric_bitstream);
 
   /* Add command dependency to the Shell */
   shell.set_command_dependency(shell_cmd_id, dependent_cmds);
@@ -154,6 +301,22 @@ void add_openfpga_bitstream_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   cmd_dependency_build_arch_bitstream.push_back(shell_cmd_repack_id);
   ShellCommandId shell_cmd_build_arch_bitstream_id = add_openfpga_build_arch_bitstream_command(shell, openfpga_bitstream_cmd_class, cmd_dependency_build_arch_bitstream);
 
+  /******************************** 
+   * Command 'update_architecture_bitstream' 
+   */
+  /* The 'update_architecture_bitstream' command should NOT be executed before 'build_architecture_bitstream' */
+  std::vector<ShellCommandId> cmd_dependency_update_arch_bitstream;
+  cmd_dependency_update_arch_bitstream.push_back(shell_cmd_build_arch_bitstream_id);
+  add_openfpga_update_arch_bitstream_command(shell, openfpga_bitstream_cmd_class, cmd_dependency_update_arch_bitstream);
+
+  /******************************** 
+   * Command 'compare_bitstream' 
+   */
+  /* The 'compare_bitstream' command should NOT be executed before 'build_architecture_bitstream' */
+  std::vector<ShellCommandId> cmd_dependency_compare_bitstream;
+  cmd_dependency_compare_bitstream.push_back(shell_cmd_build_arch_bitstream_id);
+  add_openfpga_compare_bitstream_command(shell, openfpga_bitstream_cmd_class, cmd_dependency_compare_bitstream);
+
   /******************************** 
    * Command 'build_fabric_bitstream' 
    */
@@ -169,6 +332,14 @@ void add_openfpga_bitstream_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   std::vector<ShellCommandId> cmd_dependency_write_fabric_bitstream;
   cmd_dependency_write_fabric_bitstream.push_back(shell_cmd_build_fabric_bitstream_id);
   add_openfpga_write_fabric_bitstream_command(shell, openfpga_bitstream_cmd_class, cmd_dependency_write_fabric_bitstream);
+
+  /******************************** 
+   * Command 'send_fabric_bitstream' 
+   */
+  /* The 'send_fabric_bitstream' command should NOT be executed before 'build_fabric_bitstream' */
+  std::vector<ShellCommandId> cmd_dependency_send_fabric_bitstream;
+  cmd_dependency_send_fabric_bitstream.push_back(shell_cmd_build_fabric_bitstream_id);
+  add_openfpga_send_fabric_bitstream_command(shell, openfpga_bitstream_cmd_class, cmd_dependency_send_fabric_bitstream);
 } 
 
 } /* end namespace openfpga */
@@ -1,9 +1,18 @@
 /********************************************************************
  * This file includes functions to compress the hierachy of routing architecture
  *******************************************************************/
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_log.h"
+#include "vtr_parallel.h"
+#include "vtr_digest.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
@@ -16,6 +25,9 @@
 #include "build_device_module.h"
 #include "fabric_hierarchy_writer.h"
 #include "fabric_key_writer.h"
+#include "read_binary_fabric_graph.h"
+#include "write_binary_fabric_graph.h"
+#include "openfpga_command_threads.h"
 #include "openfpga_build_fabric.h"
 
 /* Include global variables of VPR */
@@ -24,17 +36,128 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * Find the file in the cache directory which stores the unique GSBs
+ * of the current device.
+ * The unique GSBs are fully determined by the inputs of 'link_openfpga_arch',
+ * i.e., the VPR and OpenFPGA architectures, the device grid, the routing
+ * resource graph and the options to build the GSBs.
+ * The file name is the secure digest of all these inputs, so that
+ * a file is never reused for a different device
+ *******************************************************************/
+static 
+std::string find_unique_gsb_cache_file(const OpenfpgaContext& openfpga_ctx,
+                                       const DeviceContext& device_ctx,
+                                       const std::string& cache_dir) {
+  std::stringstream cache_key;
+  cache_key << "vpr_arch=" << device_ctx.arch->architecture_id << "\n";
+  cache_key << "openfpga_arch=" << openfpga_ctx.arch().arch_id << "\n";
+  cache_key << "grid=" << device_ctx.grid.width() << "x" << device_ctx.grid.height() << "\n";
+  /* A routing resource graph read from a file may differ from the one VPR generates */
+  if (false == device_ctx.read_rr_graph_filename.empty()) {
+    cache_key << "rr_graph=" << vtr::secure_digest_file(device_ctx.read_rr_graph_filename) << "\n";
+  } else {
+    cache_key << "chan_width=" << device_ctx.chan_width.max
+              << "," << device_ctx.chan_width.x_max
+              << "," << device_ctx.chan_width.y_max << "\n";
+  }
+  cache_key << "rr_nodes=" << device_ctx.rr_graph.nodes().size() << "\n";
+  cache_key << "rr_edges=" << device_ctx.rr_graph.edges().size() << "\n";
+  cache_key << "gsb_routing=" << openfpga_ctx.flow_manager().gsb_routing() << "\n";
+  cache_key << "sort_gsb_chan_node_in_edges=" << openfpga_ctx.flow_manager().sort_gsb_chan_node_in_edges() << "\n";
+
+  std::string digest = vtr::secure_digest_stream(cache_key);
+  /* Strip the name of the hash function, e.g., 'SHA256:', which is not friendly to file systems */
+  size_t delim = digest.find(':');
+  if (std::string::npos != delim) {
+    digest = digest.substr(delim + 1);
+  }
+
+  return format_dir_path(cache_dir) + std::string("unique_gsb_") + digest + std::string(".bin");
+}
+
+/********************************************************************
+ * Load the unique GSBs from the cache directory
+ * Return true only if a valid cache file is found
+ *******************************************************************/
+static 
+bool read_unique_gsb_cache(OpenfpgaContext& openfpga_ctx,
+                           const std::string& cache_fname) {
+  std::ifstream fp(cache_fname, std::ifstream::in | std::ifstream::binary);
+  if (!fp.is_open()) {
+    return false;
+  }
+
+  if (false == openfpga_ctx.mutable_device_rr_gsb().read_unique_module(fp)) {
+    VTR_LOG_WARN("Ignore invalid unique GSB cache file '%s'\n",
+                 cache_fname.c_str());
+    return false;
+  }
+
+  VTR_LOG("Read unique GSBs from cache file '%s'\n",
+          cache_fname.c_str());
+  return true;
+}
+
+/********************************************************************
+ * Store the unique GSBs to the cache directory
+ * The file is written under a temporary name and then renamed,
+ * so that concurrent runs never see a partial file
+ *******************************************************************/
+static 
+void write_unique_gsb_cache(const OpenfpgaContext& openfpga_ctx,
+                            const std::string& cache_dir,
+                            const std::string& cache_fname) {
+  create_directory(format_dir_path(cache_dir));
+
+  std::string tmp_fname = cache_fname + std::string(".tmp");
+  std::ofstream fp(tmp_fname, std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
+  if (!fp.is_open()) {
+    VTR_LOG_WARN("Unable to create unique GSB cache file '%s'\n",
+                 tmp_fname.c_str());
+    return;
+  }
+
+  openfpga_ctx.device_rr_gsb().write_unique_module(fp);
+  fp.close();
+
+  if ( (!fp) || (0 != std::rename(tmp_fname.c_str(), cache_fname.c_str())) ) {
+    VTR_LOG_WARN("Unable to write unique GSB cache file '%s'\n",
+                 cache_fname.c_str());
+    std::remove(tmp_fname.c_str());
+    return;
+  }
+
+  VTR_LOG("Wrote unique GSBs to cache file '%s'\n",
+          cache_fname.c_str());
+}
+
 /********************************************************************
  * Identify the unique GSBs from the Device RR GSB arrays
  * This function should only be called after the GSB builder is done
+ * When a cache directory is given, the unique GSBs are loaded from 
+ * the cache if a previous run has identified them on the same device
  *******************************************************************/
 static 
 void compress_routing_hierarchy(OpenfpgaContext& openfpga_ctx,
+                                const size_t& num_threads,
+                                const std::string& cache_dir,
                                 const bool& verbose_output) {
   vtr::ScopedStartFinishTimer timer("Identify unique General Switch Blocks (GSBs)");
 
+  std::string cache_fname;
+  if (false == cache_dir.empty()) {
+    cache_fname = find_unique_gsb_cache_file(openfpga_ctx, g_vpr_ctx.device(), cache_dir);
+  }
+
   /* Build unique module lists */
-  openfpga_ctx.mutable_device_rr_gsb().build_unique_module(g_vpr_ctx.device().rr_graph);
+  if ( (true == cache_fname.empty())
+    || (false == read_unique_gsb_cache(openfpga_ctx, cache_fname)) ) {
+    openfpga_ctx.mutable_device_rr_gsb().build_unique_module(g_vpr_ctx.device().rr_graph, num_threads);
+    if (false == cache_fname.empty()) {
+      write_unique_gsb_cache(openfpga_ctx, cache_dir, cache_fname);
+    }
+  }
 
   /* Report the stats */
   VTR_LOGV(verbose_output, 
@@ -71,12 +194,38 @@ int build_fabric(OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_compress_routing = cmd.option("compress_routing");
   CommandOptionId opt_duplicate_grid_pin = cmd.option("duplicate_grid_pin");
   CommandOptionId opt_gen_random_fabric_key = cmd.option("generate_random_fabric_key");
+  CommandOptionId opt_optimize_config_order = cmd.option("optimize_config_order");
   CommandOptionId opt_write_fabric_key = cmd.option("write_fabric_key");
   CommandOptionId opt_load_fabric_key = cmd.option("load_fabric_key");
+  CommandOptionId opt_read_fabric_graph = cmd.option("read_fabric_graph");
+  CommandOptionId opt_unique_gsb_cache = cmd.option("unique_gsb_cache");
+  CommandOptionId opt_decoder_predecode_size = cmd.option("decoder_predecode_size");
   CommandOptionId opt_verbose = cmd.option("verbose");
+
+  int num_threads = get_num_threads(cmd, cmd_context, vtr::num_workers());
+  if (0 == num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  
+  /* Default is no predecoding, i.e., single-level decoders */
+  int decoder_predecode_size = 0;
+  if (true == cmd_context.option_enable(cmd, opt_decoder_predecode_size)) {
+    decoder_predecode_size = std::atoi(cmd_context.option_value(cmd, opt_decoder_predecode_size).c_str());
+    if ( (1 > decoder_predecode_size) || (255 < decoder_predecode_size) ) {
+      VTR_LOG_ERROR("Invalid decoder predecode size '%d' which should be in the range of [1, 255]!\n",
+                    decoder_predecode_size);
+      return CMD_EXEC_FATAL_ERROR; 
+    }
+  }
+
+  std::string unique_gsb_cache_dir;
+  if (true == cmd_context.option_enable(cmd, opt_unique_gsb_cache)) {
+    unique_gsb_cache_dir = cmd_context.option_value(cmd, opt_unique_gsb_cache);
+    VTR_ASSERT(false == unique_gsb_cache_dir.empty());
+  }
   
   if (true == cmd_context.option_enable(cmd, opt_compress_routing)) {
-    compress_routing_hierarchy(openfpga_ctx, cmd_context.option_enable(cmd, opt_verbose));
+    compress_routing_hierarchy(openfpga_ctx, size_t(num_threads), unique_gsb_cache_dir, cmd_context.option_enable(cmd, opt_verbose));
     /* Update flow manager to enable compress routing */
     openfpga_ctx.mutable_flow_manager().set_compress_routing(true);
   }
@@ -99,23 +248,76 @@ int build_fabric(OpenfpgaContext& openfpga_ctx,
 
   VTR_LOG("\n");
 
-  curr_status = build_device_module_graph(openfpga_ctx.mutable_module_graph(),
-                                          openfpga_ctx.mutable_io_location_map(),
-                                          openfpga_ctx.mutable_decoder_lib(),
-                                          const_cast<const OpenfpgaContext&>(openfpga_ctx),
-                                          g_vpr_ctx.device(),
-                                          cmd_context.option_enable(cmd, opt_frame_view),
-                                          cmd_context.option_enable(cmd, opt_compress_routing),
-                                          cmd_context.option_enable(cmd, opt_duplicate_grid_pin),
-                                          predefined_fabric_key,
-                                          cmd_context.option_enable(cmd, opt_gen_random_fabric_key),
-                                          cmd_context.option_enable(cmd, opt_verbose));
+  /* The fabric graph built for a previous design (e.g., in batch mode) is reused 
+   * as long as the device is the same, since it does not depend on the design 
+   */
+  const DeviceGrid& grids = g_vpr_ctx.device().grid;
+  bool reuse_fabric_graph = false;
+  if (0 < openfpga_ctx.module_graph().num_modules()) {
+    if ( (grids.width() == openfpga_ctx.flow_manager().fabric_grid_width())
+      && (grids.height() == openfpga_ctx.flow_manager().fabric_grid_height()) ) {
+      reuse_fabric_graph = true;
+    } else {
+      /* The device is changed, start from an empty fabric graph */
+      openfpga_ctx.mutable_module_graph() = ModuleManager();
+      openfpga_ctx.mutable_decoder_lib() = DecoderLibrary();
+      openfpga_ctx.mutable_io_location_map() = IoLocationMap();
+    }
+  }
+
+  if (true == reuse_fabric_graph) {
+    VTR_LOG("Reuse the fabric graph built for the device grid of %lu x %lu\n",
+            grids.width(), grids.height());
+  } else if (true == cmd_context.option_enable(cmd, opt_read_fabric_graph)) {
+    /* Load the fabric graph written by a previous run instead of building it */
+    std::string fgraph_fname = cmd_context.option_value(cmd, opt_read_fabric_graph);
+    VTR_ASSERT(false == fgraph_fname.empty());
+    if (0 != read_binary_fabric_graph(openfpga_ctx.mutable_module_graph(),
+                                      openfpga_ctx.mutable_decoder_lib(),
+                                      openfpga_ctx.mutable_io_location_map(),
+                                      g_vpr_ctx.device().grid,
+                                      fgraph_fname,
+                                      cmd_context.option_enable(cmd, opt_verbose))) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  } else {
+    curr_status = build_device_module_graph(openfpga_ctx.mutable_module_graph(),
+                                            openfpga_ctx.mutable_io_location_map(),
+                                            openfpga_ctx.mutable_decoder_lib(),
+                                            const_cast<const OpenfpgaContext&>(openfpga_ctx),
+                                            g_vpr_ctx.device(),
+                                            cmd_context.option_enable(cmd, opt_frame_view),
+                                            cmd_context.option_enable(cmd, opt_compress_routing),
+                                            cmd_context.option_enable(cmd, opt_duplicate_grid_pin),
+                                            predefined_fabric_key,
+                                            cmd_context.option_enable(cmd, opt_gen_random_fabric_key),
+                                            cmd_context.option_enable(cmd, opt_optimize_config_order),
+                                            size_t(num_threads),
+                                            cmd_context.option_enable(cmd, opt_verbose));
+
+    /* Predecoding only changes how the decoders are implemented in netlists, 
+     * so the address of each configurable child remains the same 
+     * Decoders with a data input are always built in a single level
+     */
+    for (const DecoderId& decoder : openfpga_ctx.decoder_lib().decoders()) {
+      if (false == openfpga_ctx.decoder_lib().use_data_in(decoder)) {
+        openfpga_ctx.mutable_decoder_lib().set_predecode_size(decoder, size_t(decoder_predecode_size));
+      }
+    }
+  }
 
   /* If there is any error, final status cannot be overwritten by a success flag */
   if (CMD_EXEC_SUCCESS != curr_status) {
     final_status = curr_status;
   }
 
+  /* The module graph is complete, compact the nets for the downstream writers */
+  if (false == reuse_fabric_graph) {
+    openfpga_ctx.mutable_module_graph().freeze_module_nets();
+    openfpga_ctx.mutable_module_graph().compress();
+    openfpga_ctx.mutable_flow_manager().set_fabric_grid_size(grids.width(), grids.height());
+  }
+
   /* Output fabric key if user requested */
   if (true == cmd_context.option_enable(cmd, opt_write_fabric_key)) {
     std::string fkey_fname = cmd_context.option_value(cmd, opt_write_fabric_key);
@@ -139,6 +341,7 @@ int build_fabric(OpenfpgaContext& openfpga_ctx,
 int write_fabric_hierarchy(const OpenfpgaContext& openfpga_ctx,
                            const Command& cmd, const CommandContext& cmd_context) { 
 
+  CommandOptionId opt_fold = cmd.option("fold_unique_modules");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
   /* Check the option '--file' is enabled or not 
@@ -168,7 +371,40 @@ int write_fabric_hierarchy(const OpenfpgaContext& openfpga_ctx,
   return write_fabric_hierarchy_to_text_file(openfpga_ctx.module_graph(),
                                              hie_file_name,
                                              size_t(depth),
+                                             cmd_context.option_enable(cmd, opt_fold),
                                              cmd_context.option_enable(cmd, opt_verbose));
 }
 
+/********************************************************************
+ * Write the module graph, decoder library and I/O location map 
+ * of the FPGA fabric to a binary file, which can be loaded by 
+ * 'build_fabric --read_fabric_graph' in later runs
+ *******************************************************************/
+int write_fabric_graph(const OpenfpgaContext& openfpga_ctx,
+                       const Command& cmd, const CommandContext& cmd_context) { 
+
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  /* Check the option '--file' is enabled or not 
+   * Actually, it must be enabled as the shell interface will check 
+   * before reaching this fuction
+   */
+  CommandOptionId opt_file = cmd.option("file");
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
+  VTR_ASSERT(false == cmd_context.option_value(cmd, opt_file).empty());
+
+  std::string fgraph_fname = cmd_context.option_value(cmd, opt_file);
+
+  if (0 != write_binary_fabric_graph(openfpga_ctx.module_graph(),
+                                     openfpga_ctx.decoder_lib(),
+                                     openfpga_ctx.io_location_map(),
+                                     g_vpr_ctx.device().grid,
+                                     fgraph_fname,
+                                     cmd_context.option_enable(cmd, opt_verbose))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
 } /* end namespace openfpga */
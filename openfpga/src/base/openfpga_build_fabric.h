@@ -21,6 +21,9 @@ int build_fabric(OpenfpgaContext& openfpga_ctx,
 int write_fabric_hierarchy(const OpenfpgaContext& openfpga_ctx,
                            const Command& cmd, const CommandContext& cmd_context); 
 
+int write_fabric_graph(const OpenfpgaContext& openfpga_ctx,
+                       const Command& cmd, const CommandContext& cmd_context); 
+
 } /* end namespace openfpga */
 
 #endif
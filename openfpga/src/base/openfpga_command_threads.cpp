@@ -0,0 +1,58 @@
+/********************************************************************
+ * This file includes functions to find the number of threads
+ * used by the commands which support parallel execution
+ *******************************************************************/
+#include <cstdlib>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+#include "openfpga_command_threads.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Find the number of threads of a command, given by its option '--threads'.
+ * The option '--jobs', which was used by the commands writing files in parallel,
+ * is still accepted as an alias.
+ * When none of them is enabled, the default is used, 
+ * i.e., the global number of threads of the shell (see vtr::num_workers())
+ *
+ * Return:
+ *  - the number of threads if succeed
+ *  - 0 if the number is invalid, which is a critical error
+ *******************************************************************/
+int get_num_threads(const Command& cmd,
+                    const CommandContext& cmd_context,
+                    const int& default_num_threads) {
+  CommandOptionId opt_threads = cmd.option("threads");
+  CommandOptionId opt_jobs = cmd.option("jobs");
+
+  CommandOptionId opt_enabled = CommandOptionId::INVALID();
+  if ( (true == cmd.valid_option_id(opt_threads))
+    && (true == cmd_context.option_enable(cmd, opt_threads)) ) {
+    opt_enabled = opt_threads;
+  } else if ( (true == cmd.valid_option_id(opt_jobs))
+           && (true == cmd_context.option_enable(cmd, opt_jobs)) ) {
+    VTR_LOG_WARN("Option '--jobs' of command '%s' is deprecated! Use '--threads' instead\n",
+                 cmd.name().c_str());
+    opt_enabled = opt_jobs;
+  }
+
+  if (false == cmd.valid_option_id(opt_enabled)) {
+    return default_num_threads;
+  }
+
+  int num_threads = std::atoi(cmd_context.option_value(cmd, opt_enabled).c_str());
+  /* Error out if we have an invalid number of threads */
+  if (1 > num_threads) {
+    VTR_LOG_ERROR("Invalid number of threads '%d' which should be a positive number!\n",
+                  num_threads);
+    return 0;
+  }
+
+  return num_threads;
+}
+
+} /* end namespace openfpga */
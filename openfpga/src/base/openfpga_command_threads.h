@@ -0,0 +1,23 @@
+#ifndef OPENFPGA_COMMAND_THREADS_H
+#define OPENFPGA_COMMAND_THREADS_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "command.h"
+#include "command_context.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int get_num_threads(const Command& cmd,
+                    const CommandContext& cmd_context,
+                    const int& default_num_threads);
+
+} /* end namespace openfpga */
+
+#endif
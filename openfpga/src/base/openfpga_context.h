@@ -2,23 +2,10 @@
 #define OPENFPGA_CONTEXT_H
 
 #include <vector>
+#include <memory>
 #include "vpr_context.h"
-#include "openfpga_arch.h"
-#include "vpr_netlist_annotation.h"
-#include "vpr_device_annotation.h"
-#include "vpr_clustering_annotation.h"
-#include "vpr_placement_annotation.h"
-#include "vpr_routing_annotation.h"
-#include "mux_library.h"
-#include "decoder_library.h"
-#include "tile_direct.h"
-#include "module_manager.h"
-#include "netlist_manager.h"
-#include "openfpga_flow_manager.h"
-#include "bitstream_manager.h"
-#include "fabric_bitstream.h"
-#include "device_rr_gsb.h"
-#include "io_location_map.h"
+#include "openfpga_device_context.h"
+#include "openfpga_design_context.h"
 
 /********************************************************************
  * This file includes the declaration of the date structure 
@@ -46,99 +33,86 @@
  *    which does NOT allow users to copy the internal members
  *    This is due to that the data structures in the OpenFPGA context
  *    are typically big in terms of memory
+ * 5. The data are organized in two layers
+ *    - the device layer (OpenfpgaDeviceContext), which only depends on
+ *      the architectures and the device, e.g., the fabric module graph
+ *    - the design layer (OpenfpgaDesignContext), which depends on
+ *      the user's design, e.g., the annotations and the bitstreams
+ *    The device layer can be shared by several contexts through
+ *    share_device_context(), so that the designs can be implemented
+ *    against the same fabric without duplicating it.
+ *    A shared device layer is copied before being mutated (copy-on-write).
+ *    Therefore, when contexts are processed concurrently,
+ *    the device layer should be complete before it is shared
  *******************************************************************/
 class OpenfpgaContext : public Context  {
+  public:  /* Constructors */
+    OpenfpgaContext() : device_ctx_(std::make_shared<OpenfpgaDeviceContext>()) {}
   public:  /* Public accessors */
-    const openfpga::Arch& arch() const { return arch_; }
-    const openfpga::SimulationSetting& simulation_setting() const { return sim_setting_; }
-    const openfpga::VprDeviceAnnotation& vpr_device_annotation() const { return vpr_device_annotation_; }
-    const openfpga::VprNetlistAnnotation& vpr_netlist_annotation() const { return vpr_netlist_annotation_; }
-    const openfpga::VprClusteringAnnotation& vpr_clustering_annotation() const { return vpr_clustering_annotation_; }
-    const openfpga::VprPlacementAnnotation& vpr_placement_annotation() const { return vpr_placement_annotation_; }
-    const openfpga::VprRoutingAnnotation& vpr_routing_annotation() const { return vpr_routing_annotation_; }
-    const openfpga::DeviceRRGSB& device_rr_gsb() const { return device_rr_gsb_; }
-    const openfpga::MuxLibrary& mux_lib() const { return mux_lib_; }
-    const openfpga::DecoderLibrary& decoder_lib() const { return decoder_lib_; }
-    const openfpga::TileDirect& tile_direct() const { return tile_direct_; }
-    const openfpga::ModuleManager& module_graph() const { return module_graph_; }
-    const openfpga::FlowManager& flow_manager() const { return flow_manager_; }
-    const openfpga::BitstreamManager& bitstream_manager() const { return bitstream_manager_; }
-    const openfpga::FabricBitstream& fabric_bitstream() const { return fabric_bitstream_; }
-    const openfpga::IoLocationMap& io_location_map() const { return io_location_map_; }
-    const std::unordered_map<AtomNetId, t_net_power>& net_activity() const { return net_activity_; }
-    const openfpga::NetlistManager& verilog_netlists() const { return verilog_netlists_; }
-    const openfpga::NetlistManager& spice_netlists() const { return spice_netlists_; }
+    const openfpga::Arch& arch() const { return device_ctx_->arch(); }
+    const openfpga::SimulationSetting& simulation_setting() const { return design_ctx_.simulation_setting(); }
+    const openfpga::VprDeviceAnnotation& vpr_device_annotation() const { return device_ctx_->vpr_device_annotation(); }
+    const openfpga::VprNetlistAnnotation& vpr_netlist_annotation() const { return design_ctx_.vpr_netlist_annotation(); }
+    const openfpga::VprClusteringAnnotation& vpr_clustering_annotation() const { return design_ctx_.vpr_clustering_annotation(); }
+    const openfpga::VprPlacementAnnotation& vpr_placement_annotation() const { return design_ctx_.vpr_placement_annotation(); }
+    const openfpga::VprRoutingAnnotation& vpr_routing_annotation() const { return design_ctx_.vpr_routing_annotation(); }
+    const openfpga::DeviceRRGSB& device_rr_gsb() const { return device_ctx_->device_rr_gsb(); }
+    const openfpga::MuxLibrary& mux_lib() const { return device_ctx_->mux_lib(); }
+    const openfpga::DecoderLibrary& decoder_lib() const { return device_ctx_->decoder_lib(); }
+    const openfpga::TileDirect& tile_direct() const { return device_ctx_->tile_direct(); }
+    const openfpga::ModuleManager& module_graph() const { return device_ctx_->module_graph(); }
+    const openfpga::FlowManager& flow_manager() const { return device_ctx_->flow_manager(); }
+    const openfpga::BitstreamManager& bitstream_manager() const { return design_ctx_.bitstream_manager(); }
+    const openfpga::FabricBitstream& fabric_bitstream() const { return design_ctx_.fabric_bitstream(); }
+    const openfpga::IoLocationMap& io_location_map() const { return device_ctx_->io_location_map(); }
+    const std::unordered_map<AtomNetId, t_net_power>& net_activity() const { return design_ctx_.net_activity(); }
+    const openfpga::NetlistManager& verilog_netlists() const { return design_ctx_.verilog_netlists(); }
+    const openfpga::NetlistManager& spice_netlists() const { return design_ctx_.spice_netlists(); }
+  public:  /* Public accessors to the layers */
+    const OpenfpgaDeviceContext& device_context() const { return *device_ctx_; }
+    const OpenfpgaDesignContext& design_context() const { return design_ctx_; }
+    /* Return true if the device layer is shared with other contexts */
+    bool device_context_shared() const { return 1 < device_ctx_.use_count(); }
   public:  /* Public mutators */
-    openfpga::Arch& mutable_arch() { return arch_; }
-    openfpga::SimulationSetting& mutable_simulation_setting() { return sim_setting_; }
-    openfpga::VprDeviceAnnotation& mutable_vpr_device_annotation() { return vpr_device_annotation_; }
-    openfpga::VprNetlistAnnotation& mutable_vpr_netlist_annotation() { return vpr_netlist_annotation_; }
-    openfpga::VprClusteringAnnotation& mutable_vpr_clustering_annotation() { return vpr_clustering_annotation_; }
-    openfpga::VprPlacementAnnotation& mutable_vpr_placement_annotation() { return vpr_placement_annotation_; }
-    openfpga::VprRoutingAnnotation& mutable_vpr_routing_annotation() { return vpr_routing_annotation_; }
-    openfpga::DeviceRRGSB& mutable_device_rr_gsb() { return device_rr_gsb_; }
-    openfpga::MuxLibrary& mutable_mux_lib() { return mux_lib_; }
-    openfpga::DecoderLibrary& mutable_decoder_lib() { return decoder_lib_; }
-    openfpga::TileDirect& mutable_tile_direct() { return tile_direct_; }
-    openfpga::ModuleManager& mutable_module_graph() { return module_graph_; }
-    openfpga::FlowManager& mutable_flow_manager() { return flow_manager_; }
-    openfpga::BitstreamManager& mutable_bitstream_manager() { return bitstream_manager_; }
-    openfpga::FabricBitstream& mutable_fabric_bitstream() { return fabric_bitstream_; }
-    openfpga::IoLocationMap& mutable_io_location_map() { return io_location_map_; }
-    std::unordered_map<AtomNetId, t_net_power>& mutable_net_activity() { return net_activity_; }
-    openfpga::NetlistManager& mutable_verilog_netlists() { return verilog_netlists_; }
-    openfpga::NetlistManager& mutable_spice_netlists() { return spice_netlists_; }
-  private: /* Internal data */
-    /* Data structure to store information from read_openfpga_arch library */
-    openfpga::Arch arch_;
-    openfpga::SimulationSetting sim_setting_;
-
-    /* Annotation to pb_type of VPR */
-    openfpga::VprDeviceAnnotation vpr_device_annotation_;
-
-    /* Naming fix to netlist */
-    openfpga::VprNetlistAnnotation vpr_netlist_annotation_;
-
-    /* Pin net fix to cluster results */
-    openfpga::VprClusteringAnnotation vpr_clustering_annotation_;
-
-    /* Placement results */
-    openfpga::VprPlacementAnnotation vpr_placement_annotation_;
-
-    /* Routing results annotation */ 
-    openfpga::VprRoutingAnnotation vpr_routing_annotation_;
-
-    /* Device-level annotation */
-    openfpga::DeviceRRGSB device_rr_gsb_;
-    
-    /* Library of physical implmentation of routing multiplexers */
-    openfpga::MuxLibrary mux_lib_;
-
-    /* Library of physical implmentation of decoders */
-    openfpga::DecoderLibrary decoder_lib_;
-
-    /* Inner/inter-column/row tile direct connections */
-    openfpga::TileDirect tile_direct_;
-
-    /* Fabric module graph */
-    openfpga::ModuleManager module_graph_;
-    openfpga::IoLocationMap io_location_map_;
-
-    /* Bitstream database */
-    openfpga::BitstreamManager bitstream_manager_;
-    openfpga::FabricBitstream fabric_bitstream_;
-
-    /* Netlist database 
-     * TODO: Each format should have an independent entry
+    openfpga::Arch& mutable_arch() { return mutable_device_context().mutable_arch(); }
+    openfpga::SimulationSetting& mutable_simulation_setting() { return design_ctx_.mutable_simulation_setting(); }
+    openfpga::VprDeviceAnnotation& mutable_vpr_device_annotation() { return mutable_device_context().mutable_vpr_device_annotation(); }
+    openfpga::VprNetlistAnnotation& mutable_vpr_netlist_annotation() { return design_ctx_.mutable_vpr_netlist_annotation(); }
+    openfpga::VprClusteringAnnotation& mutable_vpr_clustering_annotation() { return design_ctx_.mutable_vpr_clustering_annotation(); }
+    openfpga::VprPlacementAnnotation& mutable_vpr_placement_annotation() { return design_ctx_.mutable_vpr_placement_annotation(); }
+    openfpga::VprRoutingAnnotation& mutable_vpr_routing_annotation() { return design_ctx_.mutable_vpr_routing_annotation(); }
+    openfpga::DeviceRRGSB& mutable_device_rr_gsb() { return mutable_device_context().mutable_device_rr_gsb(); }
+    openfpga::MuxLibrary& mutable_mux_lib() { return mutable_device_context().mutable_mux_lib(); }
+    openfpga::DecoderLibrary& mutable_decoder_lib() { return mutable_device_context().mutable_decoder_lib(); }
+    openfpga::TileDirect& mutable_tile_direct() { return mutable_device_context().mutable_tile_direct(); }
+    openfpga::ModuleManager& mutable_module_graph() { return mutable_device_context().mutable_module_graph(); }
+    openfpga::FlowManager& mutable_flow_manager() { return mutable_device_context().mutable_flow_manager(); }
+    openfpga::BitstreamManager& mutable_bitstream_manager() { return design_ctx_.mutable_bitstream_manager(); }
+    openfpga::FabricBitstream& mutable_fabric_bitstream() { return design_ctx_.mutable_fabric_bitstream(); }
+    openfpga::IoLocationMap& mutable_io_location_map() { return mutable_device_context().mutable_io_location_map(); }
+    std::unordered_map<AtomNetId, t_net_power>& mutable_net_activity() { return design_ctx_.mutable_net_activity(); }
+    openfpga::NetlistManager& mutable_verilog_netlists() { return design_ctx_.mutable_verilog_netlists(); }
+    openfpga::NetlistManager& mutable_spice_netlists() { return design_ctx_.mutable_spice_netlists(); }
+  public:  /* Public mutators to the layers */
+    /* Share the device layer of another context,
+     * so that both contexts refer to the same fabric
      */
-    openfpga::NetlistManager verilog_netlists_;
-    openfpga::NetlistManager spice_netlists_;
+    void share_device_context(const OpenfpgaContext& other) { device_ctx_ = other.device_ctx_; }
+    /* Reset the design layer, e.g., to implement another design on the same fabric */
+    void reset_design_context() { design_ctx_ = OpenfpgaDesignContext(); }
+    /* Mutate the device layer. It is copied first if it is shared with other contexts */
+    OpenfpgaDeviceContext& mutable_device_context() {
+      if (true == device_context_shared()) {
+        device_ctx_ = std::make_shared<OpenfpgaDeviceContext>(*device_ctx_);
+      }
+      return *device_ctx_;
+    }
+  private: /* Internal data */
+    /* Data depending on the architectures and the device, which can be shared */
+    std::shared_ptr<OpenfpgaDeviceContext> device_ctx_;
 
-    /* Net activities of users' implementation */
-    std::unordered_map<AtomNetId, t_net_power> net_activity_; 
- 
-    /* Flow status */
-    openfpga::FlowManager flow_manager_;
+    /* Data depending on the user's design */
+    OpenfpgaDesignContext design_ctx_;
 };
 
 #endif
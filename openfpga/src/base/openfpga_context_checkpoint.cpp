@@ -0,0 +1,534 @@
+/********************************************************************
+ * This file includes functions to save a checkpoint of the OpenFPGA context
+ * to a binary file and to load it in later runs, so that the fabric graph
+ * and the bitstreams do not have to be built again
+ * See binary_openfpga_context.h for the details of the file layout
+ *******************************************************************/
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_digest.h"
+#include "vtr_log.h"
+#include "vtr_error.h"
+#include "vtr_parallel.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+/* Headers from fpgabitstream library */
+#include "bitstream_manager_utils.h"
+#include "read_binary_arch_bitstream.h"
+#include "write_binary_arch_bitstream.h"
+
+#include "read_binary_fabric_graph.h"
+#include "write_binary_fabric_graph.h"
+#include "binary_openfpga_context.h"
+#include "openfpga_command_threads.h"
+#include "openfpga_context_checkpoint.h"
+
+/* Include global variables of VPR */
+#include "globals.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Write a fixed-size record or an array of records to a binary file
+ *******************************************************************/
+template<class T>
+static
+void write_binary_openfpga_context_record(std::ostream& fp, const T& record) {
+  fp.write(reinterpret_cast<const char*>(&record), sizeof(record));
+}
+
+template<class T>
+static
+void write_binary_openfpga_context_array(std::ostream& fp, const std::vector<T>& records) {
+  fp.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(T));
+}
+
+/********************************************************************
+ * Read a fixed-size record or an array of records from a binary file
+ * Return false if the file is truncated
+ * The number of records of an array comes from the file, so it is checked
+ * against the size of the remaining file before any memory is allocated
+ *******************************************************************/
+template<class T>
+static
+bool read_binary_openfpga_context_record(std::istream& fp, T& record) {
+  fp.read(reinterpret_cast<char*>(&record), sizeof(record));
+  return size_t(fp.gcount()) == sizeof(record);
+}
+
+template<class T>
+static
+bool read_binary_openfpga_context_array(std::istream& fp, std::vector<T>& records, const size_t& num_records) {
+  std::streampos cur_pos = fp.tellg();
+  fp.seekg(0, std::ios::end);
+  std::streampos end_pos = fp.tellg();
+  fp.seekg(cur_pos);
+  if ( (!fp) || (end_pos < cur_pos)
+    || (num_records > size_t(end_pos - cur_pos) / sizeof(T)) ) {
+    return false;
+  }
+
+  records.resize(num_records);
+  fp.read(reinterpret_cast<char*>(records.data()), num_records * sizeof(T));
+  return size_t(fp.gcount()) == num_records * sizeof(T);
+}
+
+/********************************************************************
+ * Copy a secure digest to a NUL-padded field of the file header
+ *******************************************************************/
+static
+void set_binary_openfpga_context_digest(char* field, const std::string& digest) {
+  VTR_ASSERT(digest.size() < BINARY_OPENFPGA_CONTEXT_DIGEST_LENGTH);
+  std::memset(field, 0, BINARY_OPENFPGA_CONTEXT_DIGEST_LENGTH);
+  std::memcpy(field, digest.data(), digest.size());
+}
+
+/********************************************************************
+ * Find the secure digest of the VPR and OpenFPGA architectures
+ * which are loaded in the current run
+ *******************************************************************/
+static
+std::string find_openfpga_context_arch_digest(const OpenfpgaContext& openfpga_ctx) {
+  const char* vpr_arch_id = g_vpr_ctx.device().arch->architecture_id;
+
+  std::stringstream digest_data;
+  digest_data << "vpr_arch=" << ((nullptr == vpr_arch_id) ? "" : vpr_arch_id) << "\n";
+  digest_data << "openfpga_arch=" << openfpga_ctx.arch().arch_id << "\n";
+
+  return vtr::secure_digest_stream(digest_data);
+}
+
+/********************************************************************
+ * Find the secure digest of the design implemented in the current run,
+ * i.e., the atom netlist, the placement and the routing, which the bitstreams depend on
+ * The identifiers of VPR are used, which are the digests of the netlist,
+ * the placement and the routing files. They are kept when the routing traces
+ * are released by 'free_routing_traces'
+ *******************************************************************/
+static
+std::string find_openfpga_context_design_digest() {
+  std::stringstream digest_data;
+  digest_data << "netlist=" << g_vpr_ctx.atom().nlist.netlist_id() << "\n";
+  digest_data << "placement=" << g_vpr_ctx.placement().placement_id << "\n";
+  digest_data << "routing=" << g_vpr_ctx.routing().routing_id << "\n";
+
+  return vtr::secure_digest_stream(digest_data);
+}
+
+/********************************************************************
+ * Find the index of each configuration bit in the architecture bitstream section,
+ * where blocks are stored in the Depth-First Search order from the top block
+ *******************************************************************/
+static
+void rec_find_binary_arch_bitstream_bit_indices(const BitstreamManager& bitstream_manager,
+                                                const ConfigBlockId& block,
+                                                vtr::vector<ConfigBitId, uint64_t>& bit_indices,
+                                                uint64_t& num_bits) {
+  for (const ConfigBitId& bit : bitstream_manager.block_bits(block)) {
+    bit_indices[bit] = num_bits++;
+  }
+
+  for (const ConfigBlockId& child_block : bitstream_manager.block_children(block)) {
+    rec_find_binary_arch_bitstream_bit_indices(bitstream_manager, child_block,
+                                               bit_indices, num_bits);
+  }
+}
+
+/********************************************************************
+ * Write the fabric bitstream section to a binary file
+ * Return false if the fabric bitstream contains invalid bits
+ *******************************************************************/
+static
+bool write_binary_openfpga_context_fabric_bitstream(std::ostream& fp,
+                                                    const BitstreamManager& bitstream_manager,
+                                                    const FabricBitstream& fabric_bitstream) {
+  /* Configuration bits are indexed as in the architecture bitstream section */
+  std::vector<ConfigBlockId> top_block = find_bitstream_manager_top_blocks(bitstream_manager);
+  VTR_ASSERT(1 == top_block.size());
+  vtr::vector<ConfigBitId, uint64_t> bit_indices(bitstream_manager.num_bits(), 0);
+  uint64_t num_arch_bits = 0;
+  rec_find_binary_arch_bitstream_bit_indices(bitstream_manager, top_block[0],
+                                             bit_indices, num_arch_bits);
+
+  BinaryOpenfpgaContextFabricBitstreamHeader header;
+  std::memset(&header, 0, sizeof(header));
+  header.num_bits = fabric_bitstream.num_bits();
+  header.num_regions = fabric_bitstream.num_regions();
+  header.use_address = fabric_bitstream.use_address() ? 1 : 0;
+  header.use_wl_address = fabric_bitstream.use_wl_address() ? 1 : 0;
+  header.address_length = fabric_bitstream.address_length();
+  header.wl_address_length = fabric_bitstream.wl_address_length();
+  header.use_word_din = fabric_bitstream.use_word_din() ? 1 : 0;
+  header.word_din_length = uint32_t(fabric_bitstream.word_din_length());
+
+  std::vector<uint64_t> region_num_bits;
+  for (size_t region = 0; region < fabric_bitstream.num_regions(); ++region) {
+    region_num_bits.push_back(fabric_bitstream.region_num_bits(region));
+  }
+
+  std::vector<uint64_t> config_bits;
+  std::vector<uint64_t> addresses;
+  std::vector<uint8_t> dins;
+  std::vector<uint64_t> wl_addresses;
+  config_bits.reserve(header.num_bits);
+  for (const FabricBitId& bit : fabric_bitstream.bits()) {
+    /* Bits are indexed by their ids in the file */
+    if (false == fabric_bitstream.valid_bit_id(bit)) {
+      VTR_LOG_ERROR("Bit ids of fabric bitstream are not contiguous!\n");
+      return false;
+    }
+    config_bits.push_back(bit_indices[fabric_bitstream.config_bit(bit)]);
+    if (true == fabric_bitstream.use_address()) {
+      addresses.push_back(fabric_bitstream.bit_address_value(bit));
+      dins.push_back(uint8_t(fabric_bitstream.bit_din(bit)));
+      if (true == fabric_bitstream.use_wl_address()) {
+        wl_addresses.push_back(fabric_bitstream.bit_wl_address_value(bit));
+      }
+    }
+  }
+
+  write_binary_openfpga_context_record(fp, header);
+  write_binary_openfpga_context_array(fp, region_num_bits);
+  write_binary_openfpga_context_array(fp, config_bits);
+  write_binary_openfpga_context_array(fp, addresses);
+  write_binary_openfpga_context_array(fp, dins);
+  write_binary_openfpga_context_array(fp, wl_addresses);
+
+  return true;
+}
+
+/********************************************************************
+ * Read the fabric bitstream section from a binary file
+ * Return false if the file is truncated or invalid
+ *******************************************************************/
+static
+bool read_binary_openfpga_context_fabric_bitstream(std::istream& fp,
+                                                   const BitstreamManager& bitstream_manager,
+                                                   FabricBitstream& fabric_bitstream) {
+  BinaryOpenfpgaContextFabricBitstreamHeader header;
+  if ( (false == read_binary_openfpga_context_record(fp, header))
+    || (0 == header.num_regions) ) {
+    return false;
+  }
+
+  /* Each region should contain at least one bit, unless the bitstream is a single empty region */
+  std::vector<uint64_t> region_num_bits;
+  if (false == read_binary_openfpga_context_array(fp, region_num_bits, header.num_regions)) {
+    return false;
+  }
+  uint64_t num_region_bits = 0;
+  for (const uint64_t& num_bits : region_num_bits) {
+    if ( (1 < header.num_regions) && (0 == num_bits) ) {
+      return false;
+    }
+    num_region_bits += num_bits;
+  }
+  if (num_region_bits != header.num_bits) {
+    return false;
+  }
+
+  std::vector<uint64_t> config_bits;
+  std::vector<uint64_t> addresses;
+  std::vector<uint8_t> dins;
+  std::vector<uint64_t> wl_addresses;
+  if (false == read_binary_openfpga_context_array(fp, config_bits, header.num_bits)) {
+    return false;
+  }
+  if (1 == header.use_address) {
+    if ( (false == read_binary_openfpga_context_array(fp, addresses, header.num_bits))
+      || (false == read_binary_openfpga_context_array(fp, dins, header.num_bits)) ) {
+      return false;
+    }
+    if ( (1 == header.use_wl_address)
+      && (false == read_binary_openfpga_context_array(fp, wl_addresses, header.num_bits)) ) {
+      return false;
+    }
+  }
+
+  /* Address data should be enabled before any bits are added */
+  fabric_bitstream = FabricBitstream();
+  fabric_bitstream.set_use_address(1 == header.use_address);
+  fabric_bitstream.set_use_wl_address(1 == header.use_wl_address);
+  fabric_bitstream.set_address_length(header.address_length);
+  fabric_bitstream.set_wl_address_length(header.wl_address_length);
+  fabric_bitstream.set_use_word_din(1 == header.use_word_din);
+  fabric_bitstream.set_word_din_length(header.word_din_length);
+  fabric_bitstream.reserve_bits(header.num_bits);
+
+  size_t ibit = 0;
+  for (size_t region = 0; region < header.num_regions; ++region) {
+    if (0 < region) {
+      fabric_bitstream.add_region();
+    }
+    for (uint64_t iregion_bit = 0; iregion_bit < region_num_bits[region]; ++iregion_bit) {
+      if (bitstream_manager.num_bits() <= config_bits[ibit]) {
+        return false;
+      }
+      FabricBitId bit = fabric_bitstream.add_bit(ConfigBitId(config_bits[ibit]));
+      if (1 == header.use_address) {
+        fabric_bitstream.set_bit_address_value(bit, addresses[ibit]);
+        fabric_bitstream.set_bit_din(bit, char(dins[ibit]));
+        if (1 == header.use_wl_address) {
+          fabric_bitstream.set_bit_wl_address_value(bit, wl_addresses[ibit]);
+        }
+      }
+      ibit++;
+    }
+  }
+
+  return true;
+}
+
+/********************************************************************
+ * Save the fabric graph and the bitstreams of the OpenFPGA context
+ * to a binary file, which can be loaded by 'load_context' in later runs
+ *******************************************************************/
+int save_context(const OpenfpgaContext& openfpga_ctx,
+                 const Command& cmd, const CommandContext& cmd_context) {
+
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  /* Check the option '--file' is enabled or not
+   * Actually, it must be enabled as the shell interface will check
+   * before reaching this fuction
+   */
+  CommandOptionId opt_file = cmd.option("file");
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
+  VTR_ASSERT(false == cmd_context.option_value(cmd, opt_file).empty());
+
+  std::string fname = cmd_context.option_value(cmd, opt_file);
+  bool verbose = cmd_context.option_enable(cmd, opt_verbose);
+
+  std::string timer_message = std::string("Save OpenFPGA context to binary file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  const DeviceGrid& grids = g_vpr_ctx.device().grid;
+
+  BinaryOpenfpgaContextHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, BINARY_OPENFPGA_CONTEXT_MAGIC, sizeof(BINARY_OPENFPGA_CONTEXT_MAGIC));
+  header.version = BINARY_OPENFPGA_CONTEXT_VERSION;
+  header.sections = 0;
+  header.grid_width = grids.width();
+  header.grid_height = grids.height();
+  header.config_protocol_type = uint32_t(openfpga_ctx.arch().config_protocol.type());
+  header.compress_routing = openfpga_ctx.flow_manager().compress_routing() ? 1 : 0;
+  set_binary_openfpga_context_digest(header.arch_digest, find_openfpga_context_arch_digest(openfpga_ctx));
+  set_binary_openfpga_context_digest(header.design_digest, find_openfpga_context_design_digest());
+
+  /* Only the data which have been built are stored */
+  if (0 < openfpga_ctx.module_graph().num_modules()) {
+    header.sections |= BINARY_OPENFPGA_CONTEXT_FABRIC_GRAPH;
+  }
+  if (0 < openfpga_ctx.bitstream_manager().num_blocks()) {
+    header.sections |= BINARY_OPENFPGA_CONTEXT_ARCH_BITSTREAM;
+    /* The fabric bitstream refers to the bits of the architecture bitstream */
+    if (0 < openfpga_ctx.fabric_bitstream().num_bits()) {
+      header.sections |= BINARY_OPENFPGA_CONTEXT_FABRIC_BITSTREAM;
+    }
+  }
+
+  /* Create directories */
+  create_directory(format_dir_path(find_path_dir_name(fname)));
+
+  /* Create the file stream */
+  BufferedFileStream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+
+  check_file_stream(fname.c_str(), fp);
+
+  write_binary_openfpga_context_record(fp, header);
+
+  if (header.sections & BINARY_OPENFPGA_CONTEXT_FABRIC_GRAPH) {
+    if (0 != write_binary_fabric_graph_to_stream(fp,
+                                                 openfpga_ctx.module_graph(),
+                                                 openfpga_ctx.decoder_lib(),
+                                                 openfpga_ctx.io_location_map(),
+                                                 grids,
+                                                 verbose)) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  if (header.sections & BINARY_OPENFPGA_CONTEXT_ARCH_BITSTREAM) {
+    write_binary_architecture_bitstream_to_stream(fp, openfpga_ctx.bitstream_manager());
+  }
+
+  if (header.sections & BINARY_OPENFPGA_CONTEXT_FABRIC_BITSTREAM) {
+    if (false == write_binary_openfpga_context_fabric_bitstream(fp,
+                                                                openfpga_ctx.bitstream_manager(),
+                                                                openfpga_ctx.fabric_bitstream())) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  VTR_LOGV(verbose,
+           "Saved fabric graph: %s, architecture bitstream: %s, fabric bitstream: %s\n",
+           (header.sections & BINARY_OPENFPGA_CONTEXT_FABRIC_GRAPH) ? "yes" : "no",
+           (header.sections & BINARY_OPENFPGA_CONTEXT_ARCH_BITSTREAM) ? "yes" : "no",
+           (header.sections & BINARY_OPENFPGA_CONTEXT_FABRIC_BITSTREAM) ? "yes" : "no");
+
+  /* Close file handler */
+  fp.close();
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Load the fabric graph and the bitstreams of the OpenFPGA context
+ * from a binary file written by 'save_context'
+ * The file must be saved for the same architectures and VPR results,
+ * which should be loaded/linked before this command
+ *******************************************************************/
+int load_context(OpenfpgaContext& openfpga_ctx,
+                 const Command& cmd, const CommandContext& cmd_context) {
+
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  /* Check the option '--file' is enabled or not
+   * Actually, it must be enabled as the shell interface will check
+   * before reaching this fuction
+   */
+  CommandOptionId opt_file = cmd.option("file");
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
+  VTR_ASSERT(false == cmd_context.option_value(cmd, opt_file).empty());
+
+  int num_threads = get_num_threads(cmd, cmd_context, vtr::num_workers());
+  if (0 == num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  std::string fname = cmd_context.option_value(cmd, opt_file);
+  bool verbose = cmd_context.option_enable(cmd, opt_verbose);
+
+  std::string timer_message = std::string("Load OpenFPGA context from binary file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  std::ifstream fp(fname, std::ios::in | std::ios::binary);
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Unable to open OpenFPGA context file '%s'!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  BinaryOpenfpgaContextHeader header;
+  std::memset(&header, 0, sizeof(header));
+  if ( (false == read_binary_openfpga_context_record(fp, header))
+    || (0 != std::memcmp(header.magic, BINARY_OPENFPGA_CONTEXT_MAGIC, sizeof(BINARY_OPENFPGA_CONTEXT_MAGIC)))
+    || (BINARY_OPENFPGA_CONTEXT_VERSION != header.version) ) {
+    VTR_LOG_ERROR("File '%s' is not a binary OpenFPGA context of version %u!\n",
+                  fname.c_str(), BINARY_OPENFPGA_CONTEXT_VERSION);
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* The context must be saved for the same device and configuration protocol */
+  const DeviceGrid& grids = g_vpr_ctx.device().grid;
+  if ( (header.grid_width != grids.width())
+    || (header.grid_height != grids.height()) ) {
+    VTR_LOG_ERROR("OpenFPGA context in file '%s' is saved for a device grid of %lu x %lu, while the current device grid is %lu x %lu!\n",
+                  fname.c_str(), header.grid_width, header.grid_height, grids.width(), grids.height());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  if (header.config_protocol_type != uint32_t(openfpga_ctx.arch().config_protocol.type())) {
+    VTR_LOG_ERROR("OpenFPGA context in file '%s' is saved for a different configuration protocol!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* The context must be saved for the same architectures and design */
+  char digest[BINARY_OPENFPGA_CONTEXT_DIGEST_LENGTH];
+  set_binary_openfpga_context_digest(digest, find_openfpga_context_arch_digest(openfpga_ctx));
+  if (0 != std::memcmp(digest, header.arch_digest, BINARY_OPENFPGA_CONTEXT_DIGEST_LENGTH)) {
+    VTR_LOG_ERROR("OpenFPGA context in file '%s' is saved for a different VPR or OpenFPGA architecture!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  set_binary_openfpga_context_digest(digest, find_openfpga_context_design_digest());
+  if (0 != std::memcmp(digest, header.design_digest, BINARY_OPENFPGA_CONTEXT_DIGEST_LENGTH)) {
+    VTR_LOG_ERROR("OpenFPGA context in file '%s' is saved for a different netlist, placement or routing!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  if ( (header.sections & BINARY_OPENFPGA_CONTEXT_FABRIC_BITSTREAM)
+    && (!(header.sections & BINARY_OPENFPGA_CONTEXT_ARCH_BITSTREAM)) ) {
+    VTR_LOG_ERROR("OpenFPGA context in file '%s' contains a fabric bitstream without any architecture bitstream!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  if (header.sections & BINARY_OPENFPGA_CONTEXT_FABRIC_GRAPH) {
+    if (0 < openfpga_ctx.module_graph().num_modules()) {
+      VTR_LOG_ERROR("Fabric graph has already been built! Command 'load_context' should not be executed after 'build_fabric'\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+
+    if (0 != read_binary_fabric_graph_from_stream(fp,
+                                                  openfpga_ctx.mutable_module_graph(),
+                                                  openfpga_ctx.mutable_decoder_lib(),
+                                                  openfpga_ctx.mutable_io_location_map(),
+                                                  grids,
+                                                  fname,
+                                                  verbose)) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+
+    /* The module graph is complete, compact the nets for the downstream writers as 'build_fabric' does */
+    openfpga_ctx.mutable_module_graph().freeze_module_nets();
+    openfpga_ctx.mutable_module_graph().compress();
+    openfpga_ctx.mutable_flow_manager().set_fabric_grid_size(grids.width(), grids.height());
+
+    /* The unique GSBs are not stored, as they are identified in a short time from the device RR GSBs */
+    if (1 == header.compress_routing) {
+      openfpga_ctx.mutable_device_rr_gsb().build_unique_module(g_vpr_ctx.device().rr_graph, size_t(num_threads));
+      openfpga_ctx.mutable_flow_manager().set_compress_routing(true);
+    }
+  }
+
+  if (header.sections & BINARY_OPENFPGA_CONTEXT_ARCH_BITSTREAM) {
+    try {
+      openfpga_ctx.mutable_bitstream_manager() = read_binary_architecture_bitstream_from_stream(fp, fname.c_str());
+    } catch (const vtr::VtrError& error) {
+      VTR_LOG_ERROR("%s\n", error.what());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  if (header.sections & BINARY_OPENFPGA_CONTEXT_FABRIC_BITSTREAM) {
+    if (false == read_binary_openfpga_context_fabric_bitstream(fp,
+                                                               openfpga_ctx.bitstream_manager(),
+                                                               openfpga_ctx.mutable_fabric_bitstream())) {
+      VTR_LOG_ERROR("Invalid fabric bitstream in binary OpenFPGA context file '%s'!\n",
+                    fname.c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  if (std::ifstream::traits_type::eof() != fp.peek()) {
+    VTR_LOG_ERROR("Size of binary OpenFPGA context file '%s' does not match its header!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  VTR_LOGV(verbose,
+           "Loaded fabric graph: %s, architecture bitstream: %s, fabric bitstream: %s\n",
+           (header.sections & BINARY_OPENFPGA_CONTEXT_FABRIC_GRAPH) ? "yes" : "no",
+           (header.sections & BINARY_OPENFPGA_CONTEXT_ARCH_BITSTREAM) ? "yes" : "no",
+           (header.sections & BINARY_OPENFPGA_CONTEXT_FABRIC_BITSTREAM) ? "yes" : "no");
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,272 @@
+/********************************************************************
+ * Add commands to the OpenFPGA shell interface,
+ * in purpose of saving the OpenFPGA context to a file,
+ * restoring it in later runs and managing its memory, including:
+ * - save_context : write a checkpoint of the context to a binary file
+ * - load_context : read a checkpoint of the context from a binary file
+ * - report_memory : report the memory footprint of the context
+ * - free_routing_traces : release the routing traces of VPR
+ * - free_lb_rr_graphs : release the physical lb_rr_graphs used by repack
+ * - free_bitstream : release the architecture and fabric bitstreams
+ *******************************************************************/
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+#include "openfpga_context_checkpoint.h"
+#include "openfpga_memory.h"
+#include "openfpga_context_command.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * - Add a command to Shell environment: save_context
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+static
+ShellCommandId add_openfpga_save_context_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                 const ShellCommandClassId& cmd_class_id,
+                                                 const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("save_context");
+
+  /* Add an option '--file' */
+  CommandOptionId opt_file = shell_cmd.add_option("file", true, "Specify the binary file name to save the context to");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Show verbose outputs");
+
+  /* Add command 'save_context' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Save the fabric graph and the bitstreams of the OpenFPGA context to a binary file, which can be loaded by load_context");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(shell_cmd_id, save_context);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: load_context
+ * - Add associated options
+ * - Add command dependency
+ *
+ * Once the context is loaded, the commands whose results are restored
+ * are considered as executed, so that the downstream commands can be executed
+ *******************************************************************/
+static
+ShellCommandId add_openfpga_load_context_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                 const ShellCommandClassId& cmd_class_id,
+                                                 const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("load_context");
+
+  /* Add an option '--file' */
+  CommandOptionId opt_file = shell_cmd.add_option("file", true, "Specify the binary file name to load the context from");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Specify the number of threads used to identify unique routing modules");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Show verbose outputs");
+
+  /* Add command 'load_context' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Load the fabric graph and the bitstreams of the OpenFPGA context from a binary file written by save_context");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+
+  /* Note: load_context refers to the shell itself to mark the commands whose results are restored */
+  const ShellCommandId& build_fabric_cmd_id = shell.command(std::string("build_fabric"));
+  const ShellCommandId& build_arch_bitstream_cmd_id = shell.command(std::string("build_architecture_bitstream"));
+  const ShellCommandId& build_fabric_bitstream_cmd_id = shell.command(std::string("build_fabric_bitstream"));
+  shell.set_command_execute_function(shell_cmd_id,
+                                     [&shell, build_fabric_cmd_id, build_arch_bitstream_cmd_id, build_fabric_bitstream_cmd_id](OpenfpgaContext& openfpga_ctx,
+                                                                                                                               const Command& cmd,
+                                                                                                                               const CommandContext& cmd_context) {
+    int status = load_context(openfpga_ctx, cmd, cmd_context);
+    if (CMD_EXEC_SUCCESS != status) {
+      return status;
+    }
+    if (0 < openfpga_ctx.module_graph().num_modules()) {
+      shell.mark_command_executed(build_fabric_cmd_id);
+    }
+    if (0 < openfpga_ctx.bitstream_manager().num_blocks()) {
+      shell.mark_command_executed(build_arch_bitstream_cmd_id);
+    }
+    if (0 < openfpga_ctx.fabric_bitstream().num_bits()) {
+      shell.mark_command_executed(build_fabric_bitstream_cmd_id);
+    }
+    return status;
+  });
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: report_memory
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+static
+ShellCommandId add_openfpga_report_memory_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                  const ShellCommandClassId& cmd_class_id) {
+  Command shell_cmd("report_memory");
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Show the sizes of the data structures");
+
+  /* Add command 'report_memory' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Report the approximate memory footprint of the data structures of OpenFPGA and VPR");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(shell_cmd_id, report_memory);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: free_routing_traces
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+static
+ShellCommandId add_openfpga_free_routing_traces_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                        const ShellCommandClassId& cmd_class_id,
+                                                        const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("free_routing_traces");
+
+  /* Add command 'free_routing_traces' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Release the routing traces of VPR, which are no longer used once the routing results are annotated");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, free_routing_traces);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: free_lb_rr_graphs
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+static
+ShellCommandId add_openfpga_free_lb_rr_graphs_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                      const ShellCommandClassId& cmd_class_id,
+                                                      const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("free_lb_rr_graphs");
+
+  /* Add command 'free_lb_rr_graphs' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Release the physical lb_rr_graphs, which are only used by repack");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, free_lb_rr_graphs);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: free_bitstream
+ * - Add associated options
+ * - Add command dependency
+ *
+ * Once the bitstreams are released, the commands building them
+ * are considered as never executed, so that the downstream commands
+ * are not executed on empty bitstreams
+ *******************************************************************/
+static
+ShellCommandId add_openfpga_free_bitstream_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                   const ShellCommandClassId& cmd_class_id,
+                                                   const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("free_bitstream");
+
+  /* Add command 'free_bitstream' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Release the architecture bitstream and the fabric bitstream, once the bitstream files are written");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+
+  /* Note: free_bitstream refers to the shell itself to mark the commands whose results are released */
+  const ShellCommandId& build_arch_bitstream_cmd_id = shell.command(std::string("build_architecture_bitstream"));
+  const ShellCommandId& build_fabric_bitstream_cmd_id = shell.command(std::string("build_fabric_bitstream"));
+  shell.set_command_execute_function(shell_cmd_id,
+                                     [&shell, build_arch_bitstream_cmd_id, build_fabric_bitstream_cmd_id](OpenfpgaContext& openfpga_ctx,
+                                                                                                          const Command& cmd,
+                                                                                                          const CommandContext& cmd_context) {
+    int status = free_bitstream(openfpga_ctx, cmd, cmd_context);
+    if (CMD_EXEC_SUCCESS != status) {
+      return status;
+    }
+    shell.mark_command_unexecuted(build_arch_bitstream_cmd_id);
+    shell.mark_command_unexecuted(build_fabric_bitstream_cmd_id);
+    return status;
+  });
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+void add_openfpga_context_commands(openfpga::Shell<OpenfpgaContext>& shell) {
+  /* Get the unique id of 'link_openfpga_arch' and 'build_fabric' commands which are to be used in creating the dependency graph */
+  const ShellCommandId& link_arch_cmd_id = shell.command(std::string("link_openfpga_arch"));
+  const ShellCommandId& build_fabric_cmd_id = shell.command(std::string("build_fabric"));
+
+  /* Add a new class of commands */
+  ShellCommandClassId openfpga_context_cmd_class = shell.add_command_class("OpenFPGA context");
+
+  /********************************
+   * Command 'save_context'
+   */
+  /* The 'save_context' command should NOT be executed before 'build_fabric' */
+  std::vector<ShellCommandId> cmd_dependency_save_context;
+  cmd_dependency_save_context.push_back(build_fabric_cmd_id);
+  add_openfpga_save_context_command(shell, openfpga_context_cmd_class, cmd_dependency_save_context);
+
+  /********************************
+   * Command 'load_context'
+   */
+  /* The 'load_context' command should NOT be executed before 'link_openfpga_arch' */
+  std::vector<ShellCommandId> cmd_dependency_load_context;
+  cmd_dependency_load_context.push_back(link_arch_cmd_id);
+  add_openfpga_load_context_command(shell, openfpga_context_cmd_class, cmd_dependency_load_context);
+
+  /********************************
+   * Command 'report_memory'
+   */
+  add_openfpga_report_memory_command(shell, openfpga_context_cmd_class);
+
+  /********************************
+   * Command 'free_routing_traces'
+   */
+  /* The 'free_routing_traces' command should NOT be executed before 'link_openfpga_arch' */
+  std::vector<ShellCommandId> cmd_dependency_free_routing_traces;
+  cmd_dependency_free_routing_traces.push_back(link_arch_cmd_id);
+  add_openfpga_free_routing_traces_command(shell, openfpga_context_cmd_class, cmd_dependency_free_routing_traces);
+
+  /********************************
+   * Command 'free_lb_rr_graphs'
+   */
+  /* The 'free_lb_rr_graphs' command should NOT be executed before 'repack' */
+  std::vector<ShellCommandId> cmd_dependency_free_lb_rr_graphs;
+  cmd_dependency_free_lb_rr_graphs.push_back(shell.command(std::string("repack")));
+  add_openfpga_free_lb_rr_graphs_command(shell, openfpga_context_cmd_class, cmd_dependency_free_lb_rr_graphs);
+
+  /********************************
+   * Command 'free_bitstream'
+   */
+  /* The 'free_bitstream' command should NOT be executed before 'build_architecture_bitstream' */
+  std::vector<ShellCommandId> cmd_dependency_free_bitstream;
+  cmd_dependency_free_bitstream.push_back(shell.command(std::string("build_architecture_bitstream")));
+  add_openfpga_free_bitstream_command(shell, openfpga_context_cmd_class, cmd_dependency_free_bitstream);
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,21 @@
+#ifndef OPENFPGA_CONTEXT_COMMAND_H
+#define OPENFPGA_CONTEXT_COMMAND_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "shell.h"
+#include "openfpga_context.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+void add_openfpga_context_commands(openfpga::Shell<OpenfpgaContext>& shell); 
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef OPENFPGA_DESIGN_CONTEXT_H
+#define OPENFPGA_DESIGN_CONTEXT_H
+
+#include <unordered_map>
+#include "vpr_context.h"
+#include "openfpga_arch.h"
+#include "vpr_netlist_annotation.h"
+#include "vpr_clustering_annotation.h"
+#include "vpr_placement_annotation.h"
+#include "vpr_routing_annotation.h"
+#include "netlist_manager.h"
+#include "bitstream_manager.h"
+#include "fabric_bitstream.h"
+
+/********************************************************************
+ * This file includes the declaration of the date structure 
+ * OpenfpgaDesignContext, which is the design layer of OpenfpgaContext
+ *
+ * It contains the data which depend on the user's design 
+ * implemented on the fabric, e.g., the annotations to the 
+ * packing, placement and routing results, the bitstreams and the netlists.
+ * Each context owns its design layer, which is never shared.
+ *******************************************************************/
+class OpenfpgaDesignContext {
+  public:  /* Public accessors */
+    const openfpga::SimulationSetting& simulation_setting() const { return sim_setting_; }
+    const openfpga::VprNetlistAnnotation& vpr_netlist_annotation() const { return vpr_netlist_annotation_; }
+    const openfpga::VprClusteringAnnotation& vpr_clustering_annotation() const { return vpr_clustering_annotation_; }
+    const openfpga::VprPlacementAnnotation& vpr_placement_annotation() const { return vpr_placement_annotation_; }
+    const openfpga::VprRoutingAnnotation& vpr_routing_annotation() const { return vpr_routing_annotation_; }
+    const openfpga::BitstreamManager& bitstream_manager() const { return bitstream_manager_; }
+    const openfpga::FabricBitstream& fabric_bitstream() const { return fabric_bitstream_; }
+    const std::unordered_map<AtomNetId, t_net_power>& net_activity() const { return net_activity_; }
+    const openfpga::NetlistManager& verilog_netlists() const { return verilog_netlists_; }
+    const openfpga::NetlistManager& spice_netlists() const { return spice_netlists_; }
+  public:  /* Public mutators */
+    openfpga::SimulationSetting& mutable_simulation_setting() { return sim_setting_; }
+    openfpga::VprNetlistAnnotation& mutable_vpr_netlist_annotation() { return vpr_netlist_annotation_; }
+    openfpga::VprClusteringAnnotation& mutable_vpr_clustering_annotation() { return vpr_clustering_annotation_; }
+    openfpga::VprPlacementAnnotation& mutable_vpr_placement_annotation() { return vpr_placement_annotation_; }
+    openfpga::VprRoutingAnnotation& mutable_vpr_routing_annotation() { return vpr_routing_annotation_; }
+    openfpga::BitstreamManager& mutable_bitstream_manager() { return bitstream_manager_; }
+    openfpga::FabricBitstream& mutable_fabric_bitstream() { return fabric_bitstream_; }
+    std::unordered_map<AtomNetId, t_net_power>& mutable_net_activity() { return net_activity_; }
+    openfpga::NetlistManager& mutable_verilog_netlists() { return verilog_netlists_; }
+    openfpga::NetlistManager& mutable_spice_netlists() { return spice_netlists_; }
+  private: /* Internal data */
+    /* Simulation settings of users' implementation */
+    openfpga::SimulationSetting sim_setting_;
+
+    /* Naming fix to netlist */
+    openfpga::VprNetlistAnnotation vpr_netlist_annotation_;
+
+    /* Pin net fix to cluster results */
+    openfpga::VprClusteringAnnotation vpr_clustering_annotation_;
+
+    /* Placement results */
+    openfpga::VprPlacementAnnotation vpr_placement_annotation_;
+
+    /* Routing results annotation */ 
+    openfpga::VprRoutingAnnotation vpr_routing_annotation_;
+
+    /* Bitstream database */
+    openfpga::BitstreamManager bitstream_manager_;
+    openfpga::FabricBitstream fabric_bitstream_;
+
+    /* Netlist database 
+     * TODO: Each format should have an independent entry
+     */
+    openfpga::NetlistManager verilog_netlists_;
+    openfpga::NetlistManager spice_netlists_;
+
+    /* Net activities of users' implementation */
+    std::unordered_map<AtomNetId, t_net_power> net_activity_; 
+};
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef OPENFPGA_DEVICE_CONTEXT_H
+#define OPENFPGA_DEVICE_CONTEXT_H
+
+#include "openfpga_arch.h"
+#include "vpr_device_annotation.h"
+#include "mux_library.h"
+#include "decoder_library.h"
+#include "tile_direct.h"
+#include "module_manager.h"
+#include "openfpga_flow_manager.h"
+#include "device_rr_gsb.h"
+#include "io_location_map.h"
+
+/********************************************************************
+ * This file includes the declaration of the date structure 
+ * OpenfpgaDeviceContext, which is the device layer of OpenfpgaContext
+ *
+ * It contains the data which only depend on the architectures and the device,
+ * i.e., the fabric, and are the same for any user's design implemented on it.
+ *
+ * Note:
+ * - Unlike OpenfpgaContext, this data structure can be copied.
+ *   It is held by a shared pointer in OpenfpgaContext, so that
+ *   several contexts can share the same fabric without duplicating it.
+ *   A copy is made only when a shared device layer is mutated (copy-on-write)
+ *******************************************************************/
+class OpenfpgaDeviceContext {
+  public:  /* Public accessors */
+    const openfpga::Arch& arch() const { return arch_; }
+    const openfpga::VprDeviceAnnotation& vpr_device_annotation() const { return vpr_device_annotation_; }
+    const openfpga::DeviceRRGSB& device_rr_gsb() const { return device_rr_gsb_; }
+    const openfpga::MuxLibrary& mux_lib() const { return mux_lib_; }
+    const openfpga::DecoderLibrary& decoder_lib() const { return decoder_lib_; }
+    const openfpga::TileDirect& tile_direct() const { return tile_direct_; }
+    const openfpga::ModuleManager& module_graph() const { return module_graph_; }
+    const openfpga::IoLocationMap& io_location_map() const { return io_location_map_; }
+    const openfpga::FlowManager& flow_manager() const { return flow_manager_; }
+  public:  /* Public mutators */
+    openfpga::Arch& mutable_arch() { return arch_; }
+    openfpga::VprDeviceAnnotation& mutable_vpr_device_annotation() { return vpr_device_annotation_; }
+    openfpga::DeviceRRGSB& mutable_device_rr_gsb() { return device_rr_gsb_; }
+    openfpga::MuxLibrary& mutable_mux_lib() { return mux_lib_; }
+    openfpga::DecoderLibrary& mutable_decoder_lib() { return decoder_lib_; }
+    openfpga::TileDirect& mutable_tile_direct() { return tile_direct_; }
+    openfpga::ModuleManager& mutable_module_graph() { return module_graph_; }
+    openfpga::IoLocationMap& mutable_io_location_map() { return io_location_map_; }
+    openfpga::FlowManager& mutable_flow_manager() { return flow_manager_; }
+  private: /* Internal data */
+    /* Data structure to store information from read_openfpga_arch library */
+    openfpga::Arch arch_;
+
+    /* Annotation to pb_type of VPR */
+    openfpga::VprDeviceAnnotation vpr_device_annotation_;
+
+    /* Device-level annotation */
+    openfpga::DeviceRRGSB device_rr_gsb_;
+    
+    /* Library of physical implmentation of routing multiplexers */
+    openfpga::MuxLibrary mux_lib_;
+
+    /* Library of physical implmentation of decoders */
+    openfpga::DecoderLibrary decoder_lib_;
+
+    /* Inner/inter-column/row tile direct connections */
+    openfpga::TileDirect tile_direct_;
+
+    /* Fabric module graph */
+    openfpga::ModuleManager module_graph_;
+    openfpga::IoLocationMap io_location_map_;
+
+    /* Flow status */
+    openfpga::FlowManager flow_manager_;
+};
+
+#endif
@@ -14,6 +14,12 @@ namespace openfpga {
 FlowManager::FlowManager() {
   /* Turn off compress_routing as default */
   compress_routing_ = false;
+  fabric_grid_width_ = 0;
+  fabric_grid_height_ = 0;
+  gsb_routing_ = false;
+  sort_gsb_chan_node_in_edges_ = false;
+  packed_verilog_ports_ = false;
+  compact_verilog_top_module_ = false;
 }
 
 /**************************************************
@@ -23,6 +29,30 @@ bool FlowManager::compress_routing() const {
   return compress_routing_;
 }
 
+size_t FlowManager::fabric_grid_width() const {
+  return fabric_grid_width_;
+}
+
+size_t FlowManager::fabric_grid_height() const {
+  return fabric_grid_height_;
+}
+
+bool FlowManager::gsb_routing() const {
+  return gsb_routing_;
+}
+
+bool FlowManager::sort_gsb_chan_node_in_edges() const {
+  return sort_gsb_chan_node_in_edges_;
+}
+
+bool FlowManager::packed_verilog_ports() const {
+  return packed_verilog_ports_;
+}
+
+bool FlowManager::compact_verilog_top_module() const {
+  return compact_verilog_top_module_;
+}
+
 /******************************************************************************
  * Private Mutators
  ******************************************************************************/
@@ -30,5 +60,23 @@ void FlowManager::set_compress_routing(const bool& enabled) {
   compress_routing_ = enabled;
 }
 
+void FlowManager::set_fabric_grid_size(const size_t& width, const size_t& height) {
+  fabric_grid_width_ = width;
+  fabric_grid_height_ = height;
+}
+
+void FlowManager::set_gsb_link_options(const bool& gsb_routing, const bool& sort_gsb_chan_node_in_edges) {
+  gsb_routing_ = gsb_routing;
+  sort_gsb_chan_node_in_edges_ = sort_gsb_chan_node_in_edges;
+}
+
+void FlowManager::set_packed_verilog_ports(const bool& enabled) {
+  packed_verilog_ports_ = enabled;
+}
+
+void FlowManager::set_compact_verilog_top_module(const bool& enabled) {
+  compact_verilog_top_module_ = enabled;
+}
+
 
 } /* end namespace openfpga */
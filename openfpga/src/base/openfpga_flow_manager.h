@@ -4,6 +4,8 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
+#include <cstddef>
+
 /* Begin namespace openfpga */
 namespace openfpga {
 
@@ -19,10 +21,31 @@ class FlowManager {
     FlowManager();
   public: /* Public accessors */
     bool compress_routing() const;
+    /* Size of the device grid which the fabric graph is built for, 0 if not built yet */
+    size_t fabric_grid_width() const;
+    size_t fabric_grid_height() const;
+    /* Options of 'link_openfpga_arch' which the device RR GSBs are built with */
+    bool gsb_routing() const;
+    bool sort_gsb_chan_node_in_edges() const;
+    /* If the fabric Verilog netlists are written with packed ports, which the testbenches have to follow */
+    bool packed_verilog_ports() const;
+    /* If the top-level module of the fabric Verilog netlists is written with instance arrays,
+     * whose instance names differ from the module graph */
+    bool compact_verilog_top_module() const;
   public: /* Public mutators */
     void set_compress_routing(const bool& enabled);
+    void set_fabric_grid_size(const size_t& width, const size_t& height);
+    void set_gsb_link_options(const bool& gsb_routing, const bool& sort_gsb_chan_node_in_edges);
+    void set_packed_verilog_ports(const bool& enabled);
+    void set_compact_verilog_top_module(const bool& enabled);
   private: /* Internal Data */
     bool compress_routing_;
+    size_t fabric_grid_width_;
+    size_t fabric_grid_height_;
+    bool gsb_routing_;
+    bool sort_gsb_chan_node_in_edges_;
+    bool packed_verilog_ports_;
+    bool compact_verilog_top_module_;
 };
 
 } /* End namespace openfpga*/
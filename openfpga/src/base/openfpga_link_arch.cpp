@@ -2,11 +2,13 @@
  * This file includes functions to read an OpenFPGA architecture file
  * which are built on the libarchopenfpga library
  *******************************************************************/
+#include <cstdlib>
 
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
+#include "vtr_parallel.h"
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
@@ -24,6 +26,7 @@
 #include "mux_library_builder.h"
 #include "build_tile_direct.h"
 #include "annotate_placement.h"
+#include "openfpga_command_threads.h"
 #include "openfpga_link_arch.h"
 
 /* Include global variables of VPR */
@@ -72,6 +75,16 @@ int link_arch(OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_sort_edge = cmd.option("sort_gsb_chan_node_in_edges");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  int num_threads = get_num_threads(cmd, cmd_context, vtr::num_workers());
+  if (0 == num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Give dense indices to the pb_types, ports, interconnects, 
+   * pb_graph_nodes and pb_graph_pins, by which they are annotated
+   */
+  openfpga_ctx.mutable_vpr_device_annotation().build_pb_type_indices(g_vpr_ctx.device().logical_block_types);
+
   /* Annotate pb_type graphs
    * - physical pb_type
    * - mode selection bits for pb_type and pb interconnect
@@ -104,10 +117,12 @@ int link_arch(OpenfpgaContext& openfpga_ctx,
 
   annotate_rr_node_nets(g_vpr_ctx.device(), g_vpr_ctx.clustering(), g_vpr_ctx.routing(), 
                         openfpga_ctx.mutable_vpr_routing_annotation(),
+                        size_t(num_threads),
                         cmd_context.option_enable(cmd, opt_verbose));
 
   annotate_rr_node_previous_nodes(g_vpr_ctx.device(), g_vpr_ctx.clustering(), g_vpr_ctx.routing(), 
                                   openfpga_ctx.mutable_vpr_routing_annotation(),
+                                  size_t(num_threads),
                                   cmd_context.option_enable(cmd, opt_verbose));
 
 
@@ -128,12 +143,20 @@ int link_arch(OpenfpgaContext& openfpga_ctx,
     /* shen: modified to support gsb routing */
     sort_device_rr_gsb_chan_node_in_edges(g_vpr_ctx.device().rr_graph,
                                           openfpga_ctx.mutable_device_rr_gsb(),
+                                          size_t(num_threads),
                                           cmd_context.option_enable(cmd, opt_verbose));
   } 
 
+  /* The GSBs are complete, pack them into flat arrays for the downstream builders */
+  openfpga_ctx.mutable_device_rr_gsb().freeze();
+
+  openfpga_ctx.mutable_flow_manager().set_gsb_link_options(cmd_context.option_enable(cmd, opt_enable_gsb_routing),
+                                                           cmd_context.option_enable(cmd, opt_sort_edge));
+
   /* Build multiplexer library */
   openfpga_ctx.mutable_mux_lib() = build_device_mux_library(g_vpr_ctx.device(),
-                                                            const_cast<const OpenfpgaContext&>(openfpga_ctx)); 
+                                                            const_cast<const OpenfpgaContext&>(openfpga_ctx),
+                                                            num_threads); 
 
   /* Build tile direct annotation */
   openfpga_ctx.mutable_tile_direct() = build_device_tile_direct(g_vpr_ctx.device(),
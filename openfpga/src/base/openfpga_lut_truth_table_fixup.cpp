@@ -92,6 +92,9 @@ void fix_up_lut_atom_block_truth_table(const AtomContext& atom_ctx,
     vpr_clustering_annotation.adapt_truth_table(pb, adapt_tt);
 
     /* Print info is in the verbose mode */
+    if (false == verbose) {
+      continue;
+    }
     VTR_LOGV(verbose, "Original truth table\n");
     VTR_LOGV(verbose, "Index: ");
     for (size_t i = 0; i < rotated_pin_map.size(); ++i) {
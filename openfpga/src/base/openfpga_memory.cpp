@@ -0,0 +1,184 @@
+/********************************************************************
+ * This file includes functions to report the memory footprint of
+ * the OpenFPGA and VPR contexts, and to release the data which are
+ * no longer needed by the rest of a script, so that the peak memory
+ * of a run can be kept low on large fabrics
+ *******************************************************************/
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+#include "vtr_memory.h"
+#include "vtr_rusage.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_memory_footprint.h"
+
+#include "openfpga_memory.h"
+
+/* Include global variables of VPR */
+#include "globals.h"
+#include "route_common.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Convert a number of bytes to MiB */
+static 
+float to_mib(const size_t& num_bytes) {
+  return float(num_bytes) / (1024. * 1024.);
+}
+
+/********************************************************************
+ * Estimate the memory occupied by the routing traces of VPR,
+ * including the node sets of each net
+ *******************************************************************/
+static 
+size_t routing_traces_memory_footprint(const RoutingContext& routing_ctx) {
+  size_t footprint = container_footprint(routing_ctx.trace_nodes);
+  for (const t_traceback& traceback : routing_ctx.trace) {
+    for (t_trace* tptr = traceback.head; tptr != nullptr; tptr = tptr->next) {
+      footprint += sizeof(t_trace);
+    }
+  }
+  return footprint + routing_ctx.trace.capacity() * sizeof(t_traceback);
+}
+
+/* Log a structure and its footprint */
+static 
+void report_memory_footprint(const char* name, const size_t& footprint) {
+  VTR_LOG("  %-40s %12.1f MiB\n", name, to_mib(footprint));
+}
+
+/* Log the memory footprint released by a free command */
+static 
+void report_released_memory(const char* name, const size_t& footprint) {
+  /* Return the freed memory to the operating system, so that it is visible in the RSS */
+  vtr::malloc_trim(0);
+  VTR_LOG("Released about %.1f MiB of %s (current RSS %.1f MiB)\n",
+          to_mib(footprint), name, to_mib(vtr::get_current_rss()));
+}
+
+/********************************************************************
+ * Top-level function to report the approximate memory footprint of
+ * the large data structures of the OpenFPGA and VPR contexts,
+ * as well as the current and peak memory of the process
+ *
+ * The footprints are estimated from the sizes of the containers,
+ * so they do not account for the fragmentation of the heap
+ *******************************************************************/
+int report_memory(const OpenfpgaContext& openfpga_ctx,
+                  const Command& cmd, const CommandContext& cmd_context) {
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  VTR_LOG("Memory footprint (approximate):\n");
+
+  VTR_LOG("OpenFPGA context\n");
+  size_t openfpga_footprint = 0;
+  std::vector<std::pair<const char*, size_t>> openfpga_footprints;
+  openfpga_footprints.push_back(std::make_pair("Fabric module graph", openfpga_ctx.module_graph().memory_footprint()));
+  openfpga_footprints.push_back(std::make_pair("Device RR GSBs", openfpga_ctx.device_rr_gsb().memory_footprint()));
+  openfpga_footprints.push_back(std::make_pair("Device annotation", openfpga_ctx.vpr_device_annotation().memory_footprint()));
+  openfpga_footprints.push_back(std::make_pair("Physical lb_rr_graphs", openfpga_ctx.vpr_device_annotation().physical_lb_rr_graphs_memory_footprint()));
+  openfpga_footprints.push_back(std::make_pair("Routing annotation", openfpga_ctx.vpr_routing_annotation().memory_footprint()));
+  openfpga_footprints.push_back(std::make_pair("Architecture bitstream", openfpga_ctx.bitstream_manager().memory_footprint()));
+  openfpga_footprints.push_back(std::make_pair("Fabric bitstream", openfpga_ctx.fabric_bitstream().memory_footprint()));
+  for (const auto& footprint : openfpga_footprints) {
+    report_memory_footprint(footprint.first, footprint.second);
+    openfpga_footprint += footprint.second;
+  }
+
+  VTR_LOG("VPR context\n");
+  size_t vpr_footprint = 0;
+  std::vector<std::pair<const char*, size_t>> vpr_footprints;
+  vpr_footprints.push_back(std::make_pair("Routing resource graph", g_vpr_ctx.device().rr_graph.memory_footprint()));
+  vpr_footprints.push_back(std::make_pair("Routing traces", routing_traces_memory_footprint(g_vpr_ctx.routing())));
+  vpr_footprints.push_back(std::make_pair("Router node data", g_vpr_ctx.routing().rr_node_route_inf.capacity() * sizeof(t_rr_node_route_inf)));
+  for (const auto& footprint : vpr_footprints) {
+    report_memory_footprint(footprint.first, footprint.second);
+    vpr_footprint += footprint.second;
+  }
+
+  VTR_LOG("Total of the structures above: %.1f MiB\n", to_mib(openfpga_footprint + vpr_footprint));
+  VTR_LOG("Current RSS: %.1f MiB\n", to_mib(vtr::get_current_rss()));
+  VTR_LOG("Peak RSS: %.1f MiB\n", to_mib(vtr::get_max_rss()));
+
+  if (true == cmd_context.option_enable(cmd, opt_verbose)) {
+    VTR_LOG("Number of modules in the fabric graph: %lu\n", openfpga_ctx.module_graph().num_modules());
+    VTR_LOG("Number of nodes in the routing resource graph: %lu\n", g_vpr_ctx.device().rr_graph.nodes().size());
+    VTR_LOG("Number of bits in the architecture bitstream: %lu\n", openfpga_ctx.bitstream_manager().num_bits());
+  }
+
+  return CMD_EXEC_SUCCESS;
+} 
+
+/********************************************************************
+ * Top-level function to release the routing traces of VPR and 
+ * the data used by the router on each routing resource node.
+ * Once 'link_openfpga_arch' has annotated the routing results,
+ * OpenFPGA only refers to the routing annotation, 
+ * which is ensured by the dependency of the command.
+ * Both are rebuilt by VPR when it routes a design again
+ *******************************************************************/
+int free_routing_traces(OpenfpgaContext& openfpga_ctx,
+                        const Command& cmd, const CommandContext& cmd_context) {
+  (void)openfpga_ctx;
+  (void)cmd;
+  (void)cmd_context;
+
+  RoutingContext& routing_ctx = g_vpr_ctx.mutable_routing();
+  size_t footprint = routing_traces_memory_footprint(routing_ctx)
+                   + routing_ctx.rr_node_route_inf.capacity() * sizeof(t_rr_node_route_inf);
+
+  free_trace_structs();
+  free_chunk_memory_trace();
+  routing_ctx.trace = vtr::vector<ClusterNetId, t_traceback>();
+  routing_ctx.trace_nodes = vtr::vector<ClusterNetId, std::unordered_set<RRNodeId>>();
+  routing_ctx.rr_node_route_inf = vtr::vector<RRNodeId, t_rr_node_route_inf>();
+
+  report_released_memory("routing traces", footprint);
+
+  return CMD_EXEC_SUCCESS;
+} 
+
+/********************************************************************
+ * Top-level function to release the physical lb_rr_graphs and their
+ * lookaheads, which are only used by 'repack'.
+ * They are rebuilt when 'repack' is executed again
+ *******************************************************************/
+int free_lb_rr_graphs(OpenfpgaContext& openfpga_ctx,
+                      const Command& cmd, const CommandContext& cmd_context) {
+  (void)cmd;
+  (void)cmd_context;
+
+  size_t footprint = openfpga_ctx.vpr_device_annotation().physical_lb_rr_graphs_memory_footprint();
+  openfpga_ctx.mutable_vpr_device_annotation().clear_physical_lb_rr_graphs();
+
+  report_released_memory("physical lb_rr_graphs", footprint);
+
+  return CMD_EXEC_SUCCESS;
+} 
+
+/********************************************************************
+ * Top-level function to release the architecture bitstream and the 
+ * fabric bitstream, once all the bitstream files have been written.
+ * Note that the fabric bitstream refers to the values of the bits 
+ * of the architecture bitstream, so they are released together
+ *******************************************************************/
+int free_bitstream(OpenfpgaContext& openfpga_ctx,
+                   const Command& cmd, const CommandContext& cmd_context) {
+  (void)cmd;
+  (void)cmd_context;
+
+  size_t footprint = openfpga_ctx.bitstream_manager().memory_footprint()
+                   + openfpga_ctx.fabric_bitstream().memory_footprint();
+  openfpga_ctx.mutable_bitstream_manager() = BitstreamManager();
+  openfpga_ctx.mutable_fabric_bitstream() = FabricBitstream();
+
+  report_released_memory("bitstreams", footprint);
+
+  return CMD_EXEC_SUCCESS;
+} 
+
+} /* end namespace openfpga */
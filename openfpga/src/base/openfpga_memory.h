@@ -0,0 +1,32 @@
+#ifndef OPENFPGA_MEMORY_H
+#define OPENFPGA_MEMORY_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "command.h"
+#include "command_context.h"
+#include "openfpga_context.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int report_memory(const OpenfpgaContext& openfpga_ctx,
+                  const Command& cmd, const CommandContext& cmd_context); 
+
+int free_routing_traces(OpenfpgaContext& openfpga_ctx,
+                        const Command& cmd, const CommandContext& cmd_context); 
+
+int free_lb_rr_graphs(OpenfpgaContext& openfpga_ctx,
+                      const Command& cmd, const CommandContext& cmd_context); 
+
+int free_bitstream(OpenfpgaContext& openfpga_ctx,
+                   const Command& cmd, const CommandContext& cmd_context); 
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,73 @@
+/********************************************************************
+ * A registry of interned names, which stores each name generated
+ * from a key (e.g., the coordinate of a routing block) once
+ * and returns the same string for the next requests of the key.
+ *
+ * The names are never removed, so that the references returned
+ * remain valid until the end of the program.
+ * The registry can be shared by the threads building modules in parallel.
+ *******************************************************************/
+#ifndef OPENFPGA_NAME_REGISTRY_H
+#define OPENFPGA_NAME_REGISTRY_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Hash of a tuple of keys, each of which has a std::hash */
+struct NameKeyHash {
+  template<typename... Keys>
+  size_t operator()(const std::tuple<Keys...>& key) const {
+    return hash_elements<0>(key, 0);
+  }
+
+ private:
+  template<size_t I, typename... Keys>
+  static typename std::enable_if<I == sizeof...(Keys), size_t>::type
+  hash_elements(const std::tuple<Keys...>&, size_t seed) {
+    return seed;
+  }
+
+  template<size_t I, typename... Keys>
+  static typename std::enable_if<I < sizeof...(Keys), size_t>::type
+  hash_elements(const std::tuple<Keys...>& key, size_t seed) {
+    typedef typename std::tuple_element<I, std::tuple<Keys...>>::type element_type;
+    seed ^= std::hash<element_type>()(std::get<I>(key)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return hash_elements<I + 1>(key, seed);
+  }
+};
+
+template<typename... Keys>
+class NameRegistry {
+ public: /* Types */
+  typedef std::tuple<Keys...> key_type;
+
+ public: /* Public accessors */
+  /* Return the name of a key, which is generated by the function at the first request */
+  template<typename NameGenerator>
+  const std::string& find_or_add(const key_type& key, const NameGenerator& generate_name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto result = names_.find(key);
+    if (result == names_.end()) {
+      result = names_.emplace(key, generate_name()).first;
+    }
+    return result->second;
+  }
+
+ private: /* Internal data */
+  std::mutex mutex_;
+  std::unordered_map<key_type, std::string, NameKeyHash> names_;
+};
+
+} /* end namespace openfpga */
+
+#endif
@@ -12,6 +12,7 @@
 #include "pb_type_utils.h"
 #include "circuit_library_utils.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_name_registry.h"
 #include "openfpga_naming.h"
 
 /* begin namespace openfpga */
@@ -128,6 +129,16 @@ std::string generate_mux_branch_subckt_name(const CircuitLibrary& circuit_lib,
   return generate_mux_subckt_name(circuit_lib, circuit_model, mux_size, branch_postfix);
 }
 
+/************************************************
+ * Generate the module name of a parameterized
+ * multiplexer, which is shared by all the sizes
+ * of a multiplexer circuit model
+ ***********************************************/
+std::string generate_mux_parameterized_subckt_name(const CircuitLibrary& circuit_lib, 
+                                                   const CircuitModelId& circuit_model) {
+  return circuit_lib.model_name(circuit_model) + std::string("_param");
+}
+
 /************************************************
  * Generate the module name of a local decoder
  * for multiplexer
@@ -460,16 +471,25 @@ std::string generate_routing_track_middle_output_port_name(const t_rr_type& chan
 
 /*********************************************************************
  * Generate the module name for a switch block with a given coordinate
+ * The names are interned, as they are requested for each coordinate
+ * by the fabric builder, the bitstream builder and all the writers
  *********************************************************************/
-std::string generate_switch_block_module_name(const vtr::Point<size_t>& coordinate) {
-  return std::string( "sb_" + std::to_string(coordinate.x()) + std::string("__") + std::to_string(coordinate.y()) + std::string("_") );
+const std::string& generate_switch_block_module_name(const vtr::Point<size_t>& coordinate) {
+  static NameRegistry<size_t, size_t> sb_module_names;
+
+  return sb_module_names.find_or_add(std::make_tuple(coordinate.x(), coordinate.y()), [&]() {
+    return std::string( "sb_" + std::to_string(coordinate.x()) + std::string("__") + std::to_string(coordinate.y()) + std::string("_") );
+  });
 }
 
 /*********************************************************************
  * Generate the module name for a connection block with a given coordinate
+ * The names are interned, like the names of switch blocks
  *********************************************************************/
-std::string generate_connection_block_module_name(const t_rr_type& cb_type, 
-                                                  const vtr::Point<size_t>& coordinate) {
+const std::string& generate_connection_block_module_name(const t_rr_type& cb_type, 
+                                                         const vtr::Point<size_t>& coordinate) {
+  static NameRegistry<int, size_t, size_t> cb_module_names;
+
   std::string prefix("cb");
   switch (cb_type) {
   case CHANX:
@@ -483,7 +503,9 @@ std::string generate_connection_block_module_name(const t_rr_type& cb_type,
     exit(1);
   }
 
-  return std::string( prefix + std::to_string(coordinate.x()) + std::string("__") + std::to_string(coordinate.y()) + std::string("_") );
+  return cb_module_names.find_or_add(std::make_tuple(int(cb_type), coordinate.x(), coordinate.y()), [&]() {
+    return std::string( prefix + std::to_string(coordinate.x()) + std::string("__") + std::to_string(coordinate.y()) + std::string("_") );
+  });
 }
 
 /*********************************************************************
@@ -758,9 +780,16 @@ std::string generate_local_config_bus_port_name() {
  * port list of a module
  * The port name is named after the cell name of SRAM in circuit library
  *********************************************************************/
-std::string generate_sram_port_name(const e_config_protocol_type& sram_orgz_type,
-                                    const e_circuit_model_port_type& port_type) {
-  std::string port_name;
+const std::string& generate_sram_port_name(const e_config_protocol_type& sram_orgz_type,
+                                           const e_circuit_model_port_type& port_type) {
+  /* The port names are constant, so they are created once */
+  static const std::string ccff_head_port_name("ccff_head");
+  static const std::string ccff_tail_port_name("ccff_tail");
+  static const std::string bl_port_name(MEMORY_BL_PORT_NAME);
+  static const std::string wl_port_name(MEMORY_WL_PORT_NAME);
+  static const std::string decoder_address_port_name(DECODER_ADDRESS_PORT_NAME);
+
+  const std::string* port_name = nullptr;
 
   switch (sram_orgz_type) {
   case CONFIG_MEM_SCAN_CHAIN:
@@ -772,10 +801,10 @@ std::string generate_sram_port_name(const e_config_protocol_type& sram_orgz_type
      *           +------+    +------+    +------+
      */
     if (CIRCUIT_MODEL_PORT_INPUT == port_type) {
-      port_name = std::string("ccff_head"); 
+      port_name = &ccff_head_port_name;
     } else {
       VTR_ASSERT( CIRCUIT_MODEL_PORT_OUTPUT == port_type );
-      port_name = std::string("ccff_tail"); 
+      port_name = &ccff_tail_port_name;
     }
     break;
   case CONFIG_MEM_STANDALONE:
@@ -793,10 +822,10 @@ std::string generate_sram_port_name(const e_config_protocol_type& sram_orgz_type
      *           +----------+     +----------+     +----------+
      */
     if (CIRCUIT_MODEL_PORT_BL == port_type) {
-      port_name = std::string(MEMORY_BL_PORT_NAME); 
+      port_name = &bl_port_name;
     } else {
       VTR_ASSERT( CIRCUIT_MODEL_PORT_WL == port_type );
-      port_name = std::string(MEMORY_WL_PORT_NAME); 
+      port_name = &wl_port_name;
     }
     break;
   case CONFIG_MEM_FRAME_BASED:
@@ -811,7 +840,7 @@ std::string generate_sram_port_name(const e_config_protocol_type& sram_orgz_type
      *
      */
     VTR_ASSERT(port_type == CIRCUIT_MODEL_PORT_INPUT);
-    port_name = std::string(DECODER_ADDRESS_PORT_NAME); 
+    port_name = &decoder_address_port_name;
     break;
   default:
     VTR_LOGF_ERROR(__FILE__, __LINE__,
@@ -819,7 +848,7 @@ std::string generate_sram_port_name(const e_config_protocol_type& sram_orgz_type
     exit(1);
   }
 
-  return port_name;
+  return *port_name;
 }
 
 /*********************************************************************
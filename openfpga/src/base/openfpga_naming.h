@@ -47,6 +47,9 @@ std::string generate_mux_branch_subckt_name(const CircuitLibrary& circuit_lib,
                                             const size_t& branch_mux_size, 
                                             const std::string& posfix);
 
+std::string generate_mux_parameterized_subckt_name(const CircuitLibrary& circuit_lib, 
+                                                   const CircuitModelId& circuit_model);
+
 std::string generate_mux_local_decoder_subckt_name(const size_t& addr_size, 
                                                    const size_t& data_size); 
 
@@ -101,10 +104,10 @@ std::string generate_routing_track_middle_output_port_name(const t_rr_type& chan
                                                            const vtr::Point<size_t>& coordinate,
                                                            const size_t& track_id);
 
-std::string generate_switch_block_module_name(const vtr::Point<size_t>& coordinate);
+const std::string& generate_switch_block_module_name(const vtr::Point<size_t>& coordinate);
 
-std::string generate_connection_block_module_name(const t_rr_type& cb_type, 
-                                                  const vtr::Point<size_t>& coordinate);
+const std::string& generate_connection_block_module_name(const t_rr_type& cb_type, 
+                                                         const vtr::Point<size_t>& coordinate);
 
 std::string generate_sb_mux_instance_name(const std::string& prefix,
                                           const e_side& sb_side, 
@@ -182,8 +185,8 @@ std::string generate_mux_local_decoder_data_inv_port_name();
 
 std::string generate_local_config_bus_port_name();
 
-std::string generate_sram_port_name(const e_config_protocol_type& sram_orgz_type,
-                                    const e_circuit_model_port_type& port_type);
+const std::string& generate_sram_port_name(const e_config_protocol_type& sram_orgz_type,
+                                           const e_circuit_model_port_type& port_type);
 
 std::string generate_sram_local_port_name(const CircuitLibrary& circuit_lib,
                                           const CircuitModelId& sram_model,
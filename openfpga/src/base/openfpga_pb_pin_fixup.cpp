@@ -2,10 +2,17 @@
  * This file includes functions to fix up the pb pin mapping results 
  * after routing optimization
  *******************************************************************/
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <vector>
+
 /* Headers from vtrutil library */
+#include "vtr_ndmatrix.h"
 #include "vtr_time.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
+#include "vtr_parallel.h"
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
@@ -17,6 +24,7 @@
 #include "openfpga_side_manager.h"
 
 #include "pb_type_utils.h"
+#include "openfpga_command_threads.h"
 #include "openfpga_pb_pin_fixup.h"
 
 /* Include global variables of VPR */
@@ -48,26 +56,92 @@ std::vector<e_side> find_logic_tile_pin_side(t_physical_tile_type_ptr physical_t
 }
 
 /********************************************************************
- * Fix up the pb pin mapping results for a given clustered block
+ * Build a fast look-up for the routing resource nodes of grid pins,
+ * which are indexed by the coordinate, the physical pin index and the side
+ * This replaces the queries to the RRGraph for each pin of each clustered block
+ * and can be read by a number of threads at the same time
+ *******************************************************************/
+static 
+vtr::Matrix<std::vector<std::array<RRNodeId, NUM_SIDES>>> build_grid_pin_rr_node_lookup(const DeviceContext& device_ctx) {
+  const RRGraph& rr_graph = device_ctx.rr_graph;
+
+  vtr::Matrix<std::vector<std::array<RRNodeId, NUM_SIDES>>> grid_pin_rr_nodes({device_ctx.grid.width(), device_ctx.grid.height()});
+
+  for (const RRNodeId& node : rr_graph.nodes()) {
+    if ( (OPIN != rr_graph.node_type(node))
+      && (IPIN != rr_graph.node_type(node)) ) {
+      continue;
+    }
+    size_t ptc = rr_graph.node_pin_num(node);
+    size_t side = rr_graph.node_side(node);
+    VTR_ASSERT(NUM_SIDES > side);
+    /* Pins are registered at all the coordinates they span, as the RRGraph look-up does */
+    for (size_t x = rr_graph.node_xlow(node); x <= size_t(rr_graph.node_xhigh(node)); ++x) {
+      for (size_t y = rr_graph.node_ylow(node); y <= size_t(rr_graph.node_yhigh(node)); ++y) {
+        if ( (x >= grid_pin_rr_nodes.dim_size(0))
+          || (y >= grid_pin_rr_nodes.dim_size(1)) ) {
+          continue;
+        }
+        std::vector<std::array<RRNodeId, NUM_SIDES>>& pin_rr_nodes = grid_pin_rr_nodes[x][y];
+        if (ptc >= pin_rr_nodes.size()) {
+          std::array<RRNodeId, NUM_SIDES> invalid_nodes;
+          invalid_nodes.fill(RRNodeId::INVALID());
+          pin_rr_nodes.resize(ptc + 1, invalid_nodes);
+        }
+        /* Keep the first node found, as the RRGraph look-up does */
+        if (RRNodeId::INVALID() == pin_rr_nodes[ptc][side]) {
+          pin_rr_nodes[ptc][side] = node;
+        }
+      }
+    }
+  }
+
+  return grid_pin_rr_nodes;
+}
+
+/********************************************************************
+ * A net mapping mismatch found on a pin of a clustered block
+ *******************************************************************/
+struct t_pb_pin_fixup {
+  int pin;
+  int physical_pin;
+  ClusterNetId routing_net;
+  ClusterNetId cluster_net;
+};
+
+/********************************************************************
+ * A clustered block to be fixed up and the grid where it is placed
+ *******************************************************************/
+struct t_pb_pin_fixup_block {
+  vtr::Point<size_t> grid_coord;
+  ClusterBlockId blk_id;
+  e_side border_side;
+};
+
+/********************************************************************
+ * Find the pb pin mapping mismatches for a given clustered block
  * 1. For each input/output pin of a clustered pb, 
  *    - find a corresponding node in RRGraph object
  *    - find the net id for the node in routing context
  *    - find the net id for the node in clustering context
- *    - if the net id does not match, we update the clustering context
+ *    - if the net id does not match, we record a fix-up for the clustering context
+ * Only shared data are read here, so that clustered blocks can be handled in parallel
  *******************************************************************/
 static 
-void update_cluster_pin_with_post_routing_results(const DeviceContext& device_ctx,
-                                                  const ClusteringContext& clustering_ctx,
-                                                  const VprRoutingAnnotation& vpr_routing_annotation,
-                                                  VprClusteringAnnotation& vpr_clustering_annotation,
-                                                  const vtr::Point<size_t>& grid_coord,
-                                                  const ClusterBlockId& blk_id,
-                                                  const e_side& border_side,
-                                                  const size_t& z,
-                                                  const bool& verbose) {
+std::vector<t_pb_pin_fixup> find_cluster_pin_post_routing_fixups(const DeviceContext& device_ctx,
+                                                                 const ClusteringContext& clustering_ctx,
+                                                                 const VprRoutingAnnotation& vpr_routing_annotation,
+                                                                 const vtr::Matrix<std::vector<std::array<RRNodeId, NUM_SIDES>>>& grid_pin_rr_nodes,
+                                                                 const vtr::Point<size_t>& grid_coord,
+                                                                 const ClusterBlockId& blk_id,
+                                                                 const e_side& border_side,
+                                                                 const size_t& z) {
+  std::vector<t_pb_pin_fixup> fixups;
+
   /* Handle each pin */
   auto logical_block = clustering_ctx.clb_nlist.block_type(blk_id);
   auto physical_tile = device_ctx.grid[grid_coord.x()][grid_coord.y()].type;
+  const std::vector<std::array<RRNodeId, NUM_SIDES>>& pin_rr_nodes = grid_pin_rr_nodes[grid_coord.x()][grid_coord.y()];
 
   for (int j = 0; j < logical_block->pb_type->num_pins; j++) {
     /* Get the ptc num for the pin in rr_graph, we need t consider the z offset here
@@ -107,8 +181,12 @@ void update_cluster_pin_with_post_routing_results(const DeviceContext& device_ct
     }
 
     /* Find the net mapped to this pin in routing results */
-    const RRNodeId& rr_node = device_ctx.rr_graph.find_node(grid_coord.x(), grid_coord.y(), rr_node_type, physical_pin, pin_side); 
-    if (false == device_ctx.rr_graph.valid_node_id(rr_node)) {
+    if (size_t(physical_pin) >= pin_rr_nodes.size()) {
+      continue;
+    }
+    const RRNodeId& rr_node = pin_rr_nodes[physical_pin][pin_side]; 
+    if ( (false == device_ctx.rr_graph.valid_node_id(rr_node))
+      || (rr_node_type != device_ctx.rr_graph.node_type(rr_node)) ) {
       continue;
     }
     /* Get the cluster net id which has been mapped to this net */
@@ -134,16 +212,34 @@ void update_cluster_pin_with_post_routing_results(const DeviceContext& device_ct
       continue;
     }
     /* Add to net modification */
-    vpr_clustering_annotation.rename_net(blk_id, j, routing_net_id);
+    fixups.push_back({j, physical_pin, routing_net_id, cluster_net_id});
+  }
+
+  return fixups;
+}
+
+/********************************************************************
+ * Fix up the pb pin mapping results for a given clustered block
+ * with the mismatches found
+ *******************************************************************/
+static 
+void update_cluster_pin_with_post_routing_fixups(const ClusteringContext& clustering_ctx,
+                                                 VprClusteringAnnotation& vpr_clustering_annotation,
+                                                 const vtr::Point<size_t>& grid_coord,
+                                                 const ClusterBlockId& blk_id,
+                                                 const std::vector<t_pb_pin_fixup>& fixups,
+                                                 const bool& verbose) {
+  for (const t_pb_pin_fixup& fixup : fixups) {
+    vpr_clustering_annotation.rename_net(blk_id, fixup.pin, fixup.routing_net);
  
     std::string routing_net_name("unmapped");
-    if (ClusterNetId::INVALID() != routing_net_id) {
-      routing_net_name = clustering_ctx.clb_nlist.net_name(routing_net_id);
+    if (ClusterNetId::INVALID() != fixup.routing_net) {
+      routing_net_name = clustering_ctx.clb_nlist.net_name(fixup.routing_net);
     }
 
     std::string cluster_net_name("unmapped");
-    if (ClusterNetId::INVALID() != cluster_net_id) {
-      cluster_net_name = clustering_ctx.clb_nlist.net_name(cluster_net_id);
+    if (ClusterNetId::INVALID() != fixup.cluster_net) {
+      cluster_net_name = clustering_ctx.clb_nlist.net_name(fixup.cluster_net);
     }
 
     VTR_LOGV(verbose,
@@ -152,8 +248,8 @@ void update_cluster_pin_with_post_routing_results(const DeviceContext& device_ct
              clustering_ctx.clb_nlist.block_pb(blk_id)->name,
              grid_coord.x(), grid_coord.y(),
              clustering_ctx.clb_nlist.block_pb(blk_id)->pb_graph_node->pb_type->name,
-             get_pb_graph_node_pin_from_block_pin(blk_id, physical_pin)->port->name,
-             get_pb_graph_node_pin_from_block_pin(blk_id, physical_pin)->pin_number,
+             get_pb_graph_node_pin_from_block_pin(blk_id, fixup.physical_pin)->port->name,
+             get_pb_graph_node_pin_from_block_pin(blk_id, fixup.physical_pin)->pin_number,
              cluster_net_name.c_str()
              );
   }
@@ -162,6 +258,9 @@ void update_cluster_pin_with_post_routing_results(const DeviceContext& device_ct
 /********************************************************************
  * Main function to fix up the pb pin mapping results 
  * This function will walk through each grid
+ * The mismatches of clustered blocks are found by a number of threads,
+ * and then fixed up in the order of grids, 
+ * so that the results are the same regardless of the number of threads
  *******************************************************************/
 static 
 void update_pb_pin_with_post_routing_results(const DeviceContext& device_ctx,
@@ -169,7 +268,10 @@ void update_pb_pin_with_post_routing_results(const DeviceContext& device_ctx,
                                              const PlacementContext& placement_ctx,
                                              const VprRoutingAnnotation& vpr_routing_annotation,
                                              VprClusteringAnnotation& vpr_clustering_annotation,
+                                             const size_t& num_threads,
                                              const bool& verbose) {
+  std::vector<t_pb_pin_fixup_block> fixup_blocks;
+
   /* Update the core logic (center blocks of the FPGA) */
   for (size_t x = 1; x < device_ctx.grid.width() - 1; ++x) {
     for (size_t y = 1; y < device_ctx.grid.height() - 1; ++y) {
@@ -186,13 +288,7 @@ void update_pb_pin_with_post_routing_results(const DeviceContext& device_ctx,
           continue;
         }
         /* We know the entrance to grid info and mapping results, do the fix-up for this block */
-        vtr::Point<size_t> grid_coord(x, y);
-        update_cluster_pin_with_post_routing_results(device_ctx, clustering_ctx, 
-                                                     vpr_routing_annotation,
-                                                     vpr_clustering_annotation,
-                                                     grid_coord, cluster_blk_id, NUM_SIDES,
-                                                     placement_ctx.block_locs[cluster_blk_id].loc.z,
-                                                     verbose);
+        fixup_blocks.push_back({vtr::Point<size_t>(x, y), cluster_blk_id, NUM_SIDES});
       } 
     }
   }
@@ -235,15 +331,30 @@ void update_pb_pin_with_post_routing_results(const DeviceContext& device_ctx,
           continue;
         }
         /* Update on I/O grid */
-        update_cluster_pin_with_post_routing_results(device_ctx, clustering_ctx, 
-                                                     vpr_routing_annotation,
-                                                     vpr_clustering_annotation,
-                                                     io_coord, cluster_blk_id, io_side,
-                                                     placement_ctx.block_locs[cluster_blk_id].loc.z,
-                                                     verbose);
+        fixup_blocks.push_back({io_coord, cluster_blk_id, io_side});
       }
     }
   }
+
+  /* Look up the routing resource nodes of all the grid pins at once */
+  vtr::Matrix<std::vector<std::array<RRNodeId, NUM_SIDES>>> grid_pin_rr_nodes = build_grid_pin_rr_node_lookup(device_ctx);
+
+  /* Blocks are dispatched on demand, each of which only writes its own fix-ups */
+  std::vector<std::vector<t_pb_pin_fixup>> block_fixups(fixup_blocks.size());
+  vtr::parallel_for(fixup_blocks.size(), num_threads, [&](const size_t& iblk) {
+    const t_pb_pin_fixup_block& fixup_block = fixup_blocks[iblk];
+    block_fixups[iblk] = find_cluster_pin_post_routing_fixups(device_ctx, clustering_ctx, 
+                                                              vpr_routing_annotation,
+                                                              grid_pin_rr_nodes,
+                                                              fixup_block.grid_coord, fixup_block.blk_id, fixup_block.border_side,
+                                                              placement_ctx.block_locs[fixup_block.blk_id].loc.z);
+  });
+
+  for (size_t iblk = 0; iblk < fixup_blocks.size(); ++iblk) {
+    update_cluster_pin_with_post_routing_fixups(clustering_ctx, vpr_clustering_annotation,
+                                                fixup_blocks[iblk].grid_coord, fixup_blocks[iblk].blk_id,
+                                                block_fixups[iblk], verbose);
+  }
 }
 
 /********************************************************************
@@ -264,12 +375,18 @@ int pb_pin_fixup(OpenfpgaContext& openfpga_context,
 
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  int num_threads = get_num_threads(cmd, cmd_context, vtr::num_workers());
+  if (0 == num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Apply fix-up to each grid */
   update_pb_pin_with_post_routing_results(g_vpr_ctx.device(),
                                           g_vpr_ctx.clustering(),
                                           g_vpr_ctx.placement(), 
                                           openfpga_context.vpr_routing_annotation(),
                                           openfpga_context.mutable_vpr_clustering_annotation(),
+                                          size_t(num_threads),
                                           cmd_context.option_enable(cmd, opt_verbose));
 
   /* TODO: should identify the error code from internal function execution */
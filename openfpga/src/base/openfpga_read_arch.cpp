@@ -4,6 +4,7 @@
  *******************************************************************/
 /* Headers from vtrutil library */
 #include "vtr_log.h"
+#include "vtr_digest.h"
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
@@ -38,6 +39,17 @@ int read_arch(OpenfpgaContext& openfpga_context,
 
   std::string arch_file_name = cmd_context.option_value(cmd, opt_file);
 
+  /* An architecture read from the same content (e.g., by a previous request in server mode)
+   * has been parsed and checked already, there is no need to read it again
+   */
+  std::string arch_id = vtr::secure_digest_file(arch_file_name);
+  if ( (false == openfpga_context.arch().arch_id.empty())
+    && (arch_id == openfpga_context.arch().arch_id) ) {
+    VTR_LOG("Reuse the XML architecture already read from identical file '%s' (%s)\n",
+            arch_file_name.c_str(), arch_id.c_str());
+    return CMD_EXEC_SUCCESS;
+  }
+
   VTR_LOG("Reading XML architecture '%s'...\n",
           arch_file_name.c_str());
   openfpga_context.mutable_arch() = read_xml_openfpga_arch(arch_file_name.c_str());
@@ -57,6 +69,9 @@ int read_arch(OpenfpgaContext& openfpga_context,
     return CMD_EXEC_FATAL_ERROR;
   }
 
+  /* Mark the architecture as valid only when all the checks pass */
+  openfpga_context.mutable_arch().arch_id = arch_id;
+
   return CMD_EXEC_SUCCESS;
 } 
 
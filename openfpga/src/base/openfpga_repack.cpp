@@ -4,12 +4,14 @@
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_log.h"
+#include "vtr_parallel.h"
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
 
 #include "build_physical_truth_table.h"
 #include "repack.h"
+#include "openfpga_command_threads.h"
 #include "openfpga_repack.h"
 
 /* Include global variables of VPR */
@@ -24,13 +26,21 @@ namespace openfpga {
 int repack(OpenfpgaContext& openfpga_ctx,
            const Command& cmd, const CommandContext& cmd_context) {
 
+  CommandOptionId opt_astar = cmd.option("astar");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  int num_threads = get_num_threads(cmd, cmd_context, vtr::num_workers());
+  if (0 == num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   pack_physical_pbs(g_vpr_ctx.device(),
                     g_vpr_ctx.atom(),
                     g_vpr_ctx.clustering(),
                     openfpga_ctx.mutable_vpr_device_annotation(),
                     openfpga_ctx.mutable_vpr_clustering_annotation(),
+                    size_t(num_threads),
+                    cmd_context.option_enable(cmd, opt_astar),
                     cmd_context.option_enable(cmd, opt_verbose));
 
   build_physical_lut_truth_tables(openfpga_ctx.mutable_vpr_clustering_annotation(),
@@ -0,0 +1,38 @@
+/********************************************************************
+ * This file includes functions to reset the data of the OpenFPGA context
+ * which depend on the user's design, so that another design can be
+ * implemented on the same fabric, e.g., in the batch mode of the shell
+ *******************************************************************/
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+#include "openfpga_reset_design.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Reset the design-dependent data of the OpenFPGA context
+ *
+ * The fabric graph, i.e., the module graph, the decoder library and 
+ * the I/O location map, is kept, so that 'build_fabric' can reuse it
+ * for the new design when the device is the same.
+ * The design layer of the context is reset, except the simulation settings.
+ * The annotations of the device layer refer to the VPR data structures, which are rebuilt 
+ * by 'vpr' for each design, so they are reset and rebuilt by 'link_openfpga_arch'.
+ *******************************************************************/
+void reset_design_dependent_context(OpenfpgaContext& openfpga_ctx) {
+  VTR_LOG("Reset design-dependent data of OpenFPGA context\n");
+
+  SimulationSetting sim_setting = openfpga_ctx.simulation_setting();
+  openfpga_ctx.reset_design_context();
+  openfpga_ctx.mutable_simulation_setting() = sim_setting;
+
+  OpenfpgaDeviceContext& device_ctx = openfpga_ctx.mutable_device_context();
+  device_ctx.mutable_vpr_device_annotation() = VprDeviceAnnotation();
+  device_ctx.mutable_device_rr_gsb() = DeviceRRGSB();
+  device_ctx.mutable_mux_lib() = MuxLibrary();
+  device_ctx.mutable_tile_direct() = TileDirect();
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,20 @@
+#ifndef OPENFPGA_RESET_DESIGN_H
+#define OPENFPGA_RESET_DESIGN_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "openfpga_context.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+void reset_design_dependent_context(OpenfpgaContext& openfpga_ctx);
+
+} /* end namespace openfpga */
+
+#endif
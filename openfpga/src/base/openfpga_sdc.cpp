@@ -3,6 +3,7 @@
  *******************************************************************/
 /* Headers from vtrutil library */
 #include "vtr_time.h"
+#include "vtr_parallel.h"
 #include "vtr_log.h"
 
 /* Headers from openfpgashell library */
@@ -17,6 +18,7 @@
 #include "analysis_sdc_writer.h"
 #include "configuration_chain_sdc_writer.h"
 #include "configure_port_sdc_writer.h"
+#include "openfpga_command_threads.h"
 #include "openfpga_sdc.h"
 
 /* Include global variables of VPR */
@@ -45,6 +47,13 @@ int write_pnr_sdc(const OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_constrain_routing_multiplexer_outputs = cmd.option("constrain_routing_multiplexer_outputs");
   CommandOptionId opt_constrain_switch_block_outputs = cmd.option("constrain_switch_block_outputs");
   CommandOptionId opt_constrain_zero_delay_paths = cmd.option("constrain_zero_delay_paths");
+  CommandOptionId opt_unique_module_only = cmd.option("unique_module_only");
+  CommandOptionId opt_merge_mux_paths = cmd.option("merge_mux_paths");
+
+  int num_jobs = get_num_threads(cmd, cmd_context, vtr::num_workers());
+  if (0 == num_jobs) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
 
   /* This is an intermediate data structure which is designed to modularize the FPGA-SDC
    * Keep it independent from any other outside data structures
@@ -74,6 +83,9 @@ int write_pnr_sdc(const OpenfpgaContext& openfpga_ctx,
   options.set_constrain_routing_multiplexer_outputs(cmd_context.option_enable(cmd, opt_constrain_routing_multiplexer_outputs));
   options.set_constrain_switch_block_outputs(cmd_context.option_enable(cmd, opt_constrain_switch_block_outputs));
   options.set_constrain_zero_delay_paths(cmd_context.option_enable(cmd, opt_constrain_zero_delay_paths));
+  options.set_unique_module_only(cmd_context.option_enable(cmd, opt_unique_module_only));
+  options.set_merge_mux_paths(cmd_context.option_enable(cmd, opt_merge_mux_paths));
+  options.set_num_jobs(size_t(num_jobs));
 
   /* We first turn on default sdc option and then disable part of them by following users' options */
   if (false == options.generate_sdc_pnr()) {
@@ -176,6 +188,8 @@ int write_analysis_sdc(const OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_output_dir = cmd.option("file");
   CommandOptionId opt_flatten_names = cmd.option("flatten_names");
   CommandOptionId opt_time_unit = cmd.option("time_unit");
+  CommandOptionId opt_compact_disable_timing = cmd.option("compact_disable_timing");
+  CommandOptionId opt_incremental = cmd.option("incremental");
 
   /* This is an intermediate data structure which is designed to modularize the FPGA-SDC
    * Keep it independent from any other outside data structures
@@ -188,6 +202,8 @@ int write_analysis_sdc(const OpenfpgaContext& openfpga_ctx,
   AnalysisSdcOption options(sdc_dir_path);
   options.set_generate_sdc_analysis(true);
   options.set_flatten_names(cmd_context.option_enable(cmd, opt_flatten_names));
+  options.set_compact_disable_timing(cmd_context.option_enable(cmd, opt_compact_disable_timing));
+  options.set_incremental(cmd_context.option_enable(cmd, opt_incremental));
 
   if (true == cmd_context.option_enable(cmd, opt_time_unit)) {
     options.set_time_unit(string_to_time_unit(cmd_context.option_value(cmd, opt_time_unit)));
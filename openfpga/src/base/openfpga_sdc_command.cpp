@@ -66,6 +66,20 @@ ShellCommandId add_openfpga_write_pnr_sdc_command(openfpga::Shell<OpenfpgaContex
   /* Add an option '--constrain_zero_delay_paths' */
   shell_cmd.add_option("constrain_zero_delay_paths", false, "Constrain zero-delay paths in FPGA fabric");
 
+  /* Add an option '--unique_module_only' */
+  shell_cmd.add_option("unique_module_only", false, "Constrain only the unique modules of switch blocks and connection blocks, and output the binding of their instances to a plain text file");
+
+  /* Add an option '--merge_mux_paths' */
+  shell_cmd.add_option("merge_mux_paths", false, "Constrain the paths of a routing multiplexer with the same delay by a single command");
+
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Specify the number of SDC files of grids, switch blocks and connection blocks to be written in parallel");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
+  /* Add an option '--jobs', which is a deprecated alias of '--threads' */
+  CommandOptionId opt_jobs = shell_cmd.add_option("jobs", false, "Deprecated alias of '--threads'");
+  shell_cmd.set_option_require_value(opt_jobs, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
   
@@ -178,6 +192,12 @@ ShellCommandId add_openfpga_write_analysis_sdc_command(openfpga::Shell<OpenfpgaC
   CommandOptionId time_unit_opt = shell_cmd.add_option("time_unit", false, "Specify the time unit in SDC files. Acceptable is [a|f|p|n|u|m|kM]s");
   shell_cmd.set_option_require_value(time_unit_opt, openfpga::OPT_STRING);
 
+  /* Add an option '--compact_disable_timing' */
+  shell_cmd.add_option("compact_disable_timing", false, "Merge the unused pins into bus ranges and disable fully unused instances by wildcards in SDC files");
+
+  /* Add an option '--incremental' */
+  shell_cmd.add_option("incremental", false, "Write the constraints of unused resources in one SDC file per tile, and only rewrite the files of the tiles changed since the previous run");
+
   /* Add command 'write_fabric_verilog' to the Shell */
   ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "generate SDC files for timing analysis a PnRed FPGA fabric mapped by a benchmark");
   shell.set_command_class(shell_cmd_id, cmd_class_id);
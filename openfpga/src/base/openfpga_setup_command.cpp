@@ -134,6 +134,10 @@ ShellCommandId add_openfpga_link_arch_command(openfpga::Shell<OpenfpgaContext>&
   /* Add an option '--sort_gsb_chan_node_in_edges'*/
   shell_cmd.add_option("sort_gsb_chan_node_in_edges", false, "Sort all the incoming edges for each routing track output node in General Switch Blocks (GSBs)");
 
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Specify the number of threads used to annotate the routing results and to sort the incoming edges of GSBs");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
   
@@ -163,6 +167,9 @@ ShellCommandId add_openfpga_write_gsb_command(openfpga::Shell<OpenfpgaContext>&
   shell_cmd.set_option_short_name(opt_file, "f");
   shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
 
+  /* Add an option '--unique' */
+  shell_cmd.add_option("unique", false, "Only output the unique switch blocks and an index of the unique switch block of each GSB");
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -196,6 +203,10 @@ ShellCommandId add_openfpga_check_netlist_naming_conflict_command(openfpga::Shel
   CommandOptionId opt_rpt = shell_cmd.add_option("report", false, "Output a report file about what any correction applied");
   shell_cmd.set_option_require_value(opt_rpt, openfpga::OPT_STRING);
 
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Specify the number of threads used to check the names of blocks and nets");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add command 'check_netlist_naming_conflict' to the Shell */
   ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Check any block/net naming in users' BLIF netlist violates the syntax of fabric generator");
   shell.set_command_class(shell_cmd_id, cmd_class_id);
@@ -219,6 +230,10 @@ ShellCommandId add_openfpga_pb_pin_fixup_command(openfpga::Shell<OpenfpgaContext
 
   Command shell_cmd("pb_pin_fixup");
 
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Specify the number of threads used to fix up the clustered blocks");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -283,6 +298,14 @@ ShellCommandId add_openfpga_build_fabric_command(openfpga::Shell<OpenfpgaContext
   CommandOptionId opt_load_fkey = shell_cmd.add_option("load_fabric_key", false, "load the fabric key from the given file");
   shell_cmd.set_option_require_value(opt_load_fkey, openfpga::OPT_STRING);
 
+  /* Add an option '--read_fabric_graph' */
+  CommandOptionId opt_read_fgraph = shell_cmd.add_option("read_fabric_graph", false, "load the fabric graph from a binary file written by write_fabric_graph instead of building it");
+  shell_cmd.set_option_require_value(opt_read_fgraph, openfpga::OPT_STRING);
+
+  /* Add an option '--unique_gsb_cache' */
+  CommandOptionId opt_gsb_cache = shell_cmd.add_option("unique_gsb_cache", false, "Specify a directory to cache the unique GSBs identified by '--compress_routing', which are reused by later runs on the same device");
+  shell_cmd.set_option_require_value(opt_gsb_cache, openfpga::OPT_STRING);
+
   /* Add an option '--write_fabric_key' */
   CommandOptionId opt_write_fkey = shell_cmd.add_option("write_fabric_key", false, "output current fabric key to a file");
   shell_cmd.set_option_require_value(opt_write_fkey, openfpga::OPT_STRING);
@@ -290,6 +313,17 @@ ShellCommandId add_openfpga_build_fabric_command(openfpga::Shell<OpenfpgaContext
   /* Add an option '--generate_random_fabric_key' */
   shell_cmd.add_option("generate_random_fabric_key", false, "Create a random fabric key which will shuffle the memory address for encryption purpose");
 
+  /* Add an option '--decoder_predecode_size' */
+  CommandOptionId opt_predecode = shell_cmd.add_option("decoder_predecode_size", false, "Specify the maximum number of address bits in each predecode group of the configuration decoders, which are then built in two levels");
+  shell_cmd.set_option_require_value(opt_predecode, openfpga::OPT_INT);
+
+  /* Add an option '--optimize_config_order' */
+  shell_cmd.add_option("optimize_config_order", false, "Reorder the tiles in the configuration chain of the top module to shorten the configuration wires between them");
+
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Specify the number of threads used to identify unique routing modules and to build grid and routing modules");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -325,6 +359,9 @@ ShellCommandId add_openfpga_write_fabric_hierarchy_command(openfpga::Shell<Openf
   CommandOptionId opt_depth = shell_cmd.add_option("depth", false, "Specify the depth of hierarchy to which the writer should stop");
   shell_cmd.set_option_require_value(opt_depth, openfpga::OPT_INT);
 
+  /* Add an option '--fold_unique_modules' */
+  shell_cmd.add_option("fold_unique_modules", false, "Output the hierarchy of each unique module only once, and refer to it elsewhere");
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -339,6 +376,37 @@ ShellCommandId add_openfpga_write_fabric_hierarchy_command(openfpga::Shell<Openf
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: write_fabric_graph
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_write_fabric_graph_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                       const ShellCommandClassId& cmd_class_id,
+                                                       const std::vector<ShellCommandId>& dependent_cmds) {
+
+  Command shell_cmd("write_fabric_graph");
+
+  /* Add an option '--file' */
+  CommandOptionId opt_file = shell_cmd.add_option("file", true, "Specify the binary file name to write the fabric graph to");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Show verbose outputs");
+
+  /* Add command 'write_fabric_graph' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Write the FPGA fabric graph to a binary file, which can be loaded by build_fabric --read_fabric_graph");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(shell_cmd_id, write_fabric_graph);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 void add_openfpga_setup_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   /* Get the unique id of 'vpr' command which is to be used in creating the dependency graph */
   const ShellCommandId& vpr_cmd_id = shell.command(std::string("vpr"));
@@ -450,6 +518,16 @@ void add_openfpga_setup_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   add_openfpga_write_fabric_hierarchy_command(shell,
                                               openfpga_setup_cmd_class,
                                               write_fabric_hie_dependent_cmds);
+
+  /******************************** 
+   * Command 'write_fabric_graph' 
+   */
+  /* The 'write_fabric_graph' command should NOT be executed before 'build_fabric' */
+  std::vector<ShellCommandId> write_fabric_graph_dependent_cmds;
+  write_fabric_graph_dependent_cmds.push_back(build_fabric_cmd_id);
+  add_openfpga_write_fabric_graph_command(shell,
+                                          openfpga_setup_cmd_class,
+                                          write_fabric_graph_dependent_cmds);
 } 
 
 } /* end namespace openfpga */
@@ -1,14 +1,18 @@
 /********************************************************************
  * This file includes functions to compress the hierachy of routing architecture
  *******************************************************************/
+#include <cstdlib>
+
 /* Headers from vtrutil library */
 #include "vtr_time.h"
+#include "vtr_parallel.h"
 #include "vtr_log.h"
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
 
 #include "spice_api.h"
+#include "openfpga_command_threads.h"
 #include "openfpga_spice.h"
 
 /* Include global variables of VPR */
@@ -40,9 +44,45 @@ int write_fabric_spice(OpenfpgaContext& openfpga_ctx,
   status = fpga_fabric_spice(openfpga_ctx.module_graph(),
                              openfpga_ctx.mutable_spice_netlists(),
                              openfpga_ctx.arch(),
+                             g_vpr_ctx.device(),
+                             openfpga_ctx.vpr_device_annotation(),
+                             openfpga_ctx.device_rr_gsb(),
                              options);
 
   return status;
 } 
 
+/********************************************************************
+ * A wrapper function to call the component testbench generator of FPGA-SPICE
+ *******************************************************************/
+int write_spice_component_testbench(OpenfpgaContext& openfpga_ctx,
+                                    const Command& cmd, const CommandContext& cmd_context) {
+
+  CommandOptionId opt_output_dir = cmd.option("file");
+  CommandOptionId opt_cache = cmd.option("cache");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  int num_jobs = get_num_threads(cmd, cmd_context, vtr::num_workers());
+  if (0 == num_jobs) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  SpiceTestbenchOption options;
+  options.set_output_directory(cmd_context.option_value(cmd, opt_output_dir));
+  options.set_compress_routing(openfpga_ctx.flow_manager().compress_routing());
+  options.set_num_jobs(size_t(num_jobs));
+  if (true == cmd_context.option_enable(cmd, opt_cache)) {
+    options.set_cache_file(cmd_context.option_value(cmd, opt_cache));
+  }
+  options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
+
+  return fpga_spice_component_testbench(openfpga_ctx.module_graph(),
+                                        openfpga_ctx.mutable_spice_netlists(),
+                                        openfpga_ctx.arch(),
+                                        openfpga_ctx.simulation_setting(),
+                                        g_vpr_ctx.device(),
+                                        openfpga_ctx.device_rr_gsb(),
+                                        options);
+} 
+
 } /* end namespace openfpga */
@@ -52,6 +52,48 @@ ShellCommandId add_openfpga_write_fabric_spice_command(openfpga::Shell<OpenfpgaC
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: generate SPICE testbenches for components
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_write_spice_component_testbench_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                                    const ShellCommandClassId& cmd_class_id,
+                                                                    const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("write_spice_component_testbench");
+
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId output_opt = shell_cmd.add_option("file", true, "Specify the output directory for SPICE testbenches");
+  shell_cmd.set_option_short_name(output_opt, "f");
+  shell_cmd.set_option_require_value(output_opt, openfpga::OPT_STRING);
+
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Specify the number of testbenches to be written in parallel");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
+  /* Add an option '--jobs', which is a deprecated alias of '--threads' */
+  CommandOptionId opt_jobs = shell_cmd.add_option("jobs", false, "Deprecated alias of '--threads'");
+  shell_cmd.set_option_require_value(opt_jobs, openfpga::OPT_INT);
+
+  /* Add an option '--cache' */
+  CommandOptionId opt_cache = shell_cmd.add_option("cache", false, "Specify the file to cache the SPICE characterizations across runs, so that only the modules which have not been characterized are written");
+  shell_cmd.set_option_require_value(opt_cache, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+  
+  /* Add command 'write_spice_component_testbench' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "generate SPICE testbenches to characterize the unique routing modules of FPGA fabric");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, write_spice_component_testbench);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 void add_openfpga_spice_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   /* Get the unique id of 'build_fabric' command which is to be used in creating the dependency graph */
   const ShellCommandId& build_fabric_cmd_id = shell.command(std::string("build_fabric"));
@@ -65,9 +107,19 @@ void add_openfpga_spice_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   /* The 'write_fabric_spice' command should NOT be executed before 'build_fabric' */
   std::vector<ShellCommandId> fabric_spice_dependent_cmds;
   fabric_spice_dependent_cmds.push_back(build_fabric_cmd_id);
-  add_openfpga_write_fabric_spice_command(shell,
-                                          openfpga_spice_cmd_class,
-                                          fabric_spice_dependent_cmds);
+  ShellCommandId fabric_spice_cmd_id = add_openfpga_write_fabric_spice_command(shell,
+                                                                              openfpga_spice_cmd_class,
+                                                                              fabric_spice_dependent_cmds);
+
+  /******************************** 
+   * Command 'write_spice_component_testbench' 
+   */
+  /* The command 'write_spice_component_testbench' should NOT be executed before 'write_fabric_spice' */
+  std::vector<ShellCommandId> component_testbench_dependent_cmds;
+  component_testbench_dependent_cmds.push_back(fabric_spice_cmd_id);
+  add_openfpga_write_spice_component_testbench_command(shell,
+                                                       openfpga_spice_cmd_class,
+                                                       component_testbench_dependent_cmds);
 
   /******************************** 
    * TODO: Command 'write_spice_top_testbench' 
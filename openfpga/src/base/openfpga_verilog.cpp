@@ -3,12 +3,15 @@
  *******************************************************************/
 /* Headers from vtrutil library */
 #include "vtr_time.h"
+#include "vtr_parallel.h"
 #include "vtr_log.h"
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
 
+#include "device_shard_utils.h"
 #include "verilog_api.h"
+#include "openfpga_command_threads.h"
 #include "openfpga_verilog.h"
 
 /* Include global variables of VPR */
@@ -26,11 +29,34 @@ int write_fabric_verilog(OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_output_dir = cmd.option("file");
   CommandOptionId opt_explicit_port_mapping = cmd.option("explicit_port_mapping");
   CommandOptionId opt_include_timing = cmd.option("include_timing");
+  CommandOptionId opt_sdf_timing = cmd.option("sdf_timing");
   CommandOptionId opt_include_signal_init = cmd.option("include_signal_init");
   CommandOptionId opt_support_icarus_simulator = cmd.option("support_icarus_simulator");
   CommandOptionId opt_print_user_defined_template = cmd.option("print_user_defined_template");
+  CommandOptionId opt_parameterized_mux = cmd.option("parameterized_mux");
+  CommandOptionId opt_compact_top_module = cmd.option("compact_top_module");
+  CommandOptionId opt_packed_ports = cmd.option("packed_ports");
+  CommandOptionId opt_target = cmd.option("target");
+  CommandOptionId opt_incremental = cmd.option("incremental");
+  CommandOptionId opt_shard_region = cmd.option("shard_region");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  int num_jobs = get_num_threads(cmd, cmd_context, vtr::num_workers());
+  if (0 == num_jobs) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Only Verilator is supported as a target simulator now */
+  bool verilator_target = false;
+  if (true == cmd_context.option_enable(cmd, opt_target)) {
+    if (std::string("verilator") != cmd_context.option_value(cmd, opt_target)) {
+      VTR_LOG_ERROR("Invalid target simulator '%s'! Expect [verilator]\n",
+                    cmd_context.option_value(cmd, opt_target).c_str());
+      return CMD_EXEC_FATAL_ERROR; 
+    }
+    verilator_target = true;
+  }
+
   /* This is an intermediate data structure which is designed to modularize the FPGA-Verilog
    * Keep it independent from any other outside data structures
    */
@@ -38,11 +64,52 @@ int write_fabric_verilog(OpenfpgaContext& openfpga_ctx,
   options.set_output_directory(cmd_context.option_value(cmd, opt_output_dir));
   options.set_explicit_port_mapping(cmd_context.option_enable(cmd, opt_explicit_port_mapping));
   options.set_include_timing(cmd_context.option_enable(cmd, opt_include_timing));
+  options.set_sdf_timing(cmd_context.option_enable(cmd, opt_sdf_timing));
   options.set_include_signal_init(cmd_context.option_enable(cmd, opt_include_signal_init));
   options.set_support_icarus_simulator(cmd_context.option_enable(cmd, opt_support_icarus_simulator));
   options.set_print_user_defined_template(cmd_context.option_enable(cmd, opt_print_user_defined_template));
+  options.set_parameterized_mux(cmd_context.option_enable(cmd, opt_parameterized_mux));
+  options.set_compact_top_module(cmd_context.option_enable(cmd, opt_compact_top_module));
+  options.set_packed_ports(cmd_context.option_enable(cmd, opt_packed_ports));
+  /* The instance arrays of a compact top-level module are written pin by pin */
+  if ( (true == options.compact_top_module())
+    && (true == options.packed_ports()) ) {
+    VTR_LOG_WARN("Option '--compact_top_module' is ignored when '--packed_ports' is enabled\n");
+    options.set_compact_top_module(false);
+  }
+  options.set_verilator_target(verilator_target);
+  /* Verilator only accepts synthesizable constructs:
+   * timing annotation, signal initialization and Icarus-specific codes are disabled
+   */
+  if (true == verilator_target) {
+    if ( (true == options.include_timing())
+      || (true == options.include_signal_init())
+      || (true == options.support_icarus_simulator()) ) {
+      VTR_LOG_WARN("Options '--include_timing', '--include_signal_init' and '--support_icarus_simulator' are ignored for target simulator verilator\n");
+    }
+    options.set_include_timing(false);
+    options.set_include_signal_init(false);
+    options.set_support_icarus_simulator(false);
+  }
+  /* The SDF file only carries the delays of the timing annotation */
+  if ( (true == options.sdf_timing())
+    && (false == options.include_timing()) ) {
+    VTR_LOG_WARN("Option '--sdf_timing' is ignored as the timing annotation is disabled\n");
+    options.set_sdf_timing(false);
+  }
+  options.set_incremental(cmd_context.option_enable(cmd, opt_incremental));
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
   options.set_compress_routing(openfpga_ctx.flow_manager().compress_routing());
+  options.set_num_jobs(size_t(num_jobs));
+
+  /* Only the routing netlists in a window of the device are written, if specified */
+  if (true == cmd_context.option_enable(cmd, opt_shard_region)) {
+    vtr::Rect<size_t> shard_region;
+    if (false == parse_device_shard_region(cmd_context.option_value(cmd, opt_shard_region), shard_region)) {
+      return CMD_EXEC_FATAL_ERROR; 
+    }
+    options.set_shard_region(shard_region);
+  }
   
   fpga_fabric_verilog(openfpga_ctx.mutable_module_graph(),
                       openfpga_ctx.mutable_verilog_netlists(),
@@ -54,6 +121,11 @@ int write_fabric_verilog(OpenfpgaContext& openfpga_ctx,
                       openfpga_ctx.device_rr_gsb(),
                       options);
 
+  /* The pruned formal verification top netlist copies the top-level module, which must follow the fabric netlists */
+  openfpga_ctx.mutable_flow_manager().set_packed_verilog_ports(options.packed_ports());
+  /* The pre-configured top-level module refers to the instance names of the top-level module */
+  openfpga_ctx.mutable_flow_manager().set_compact_verilog_top_module(options.compact_top_module());
+
   /* TODO: should identify the error code from internal function execution */
   return CMD_EXEC_SUCCESS;
 } 
@@ -61,13 +133,19 @@ int write_fabric_verilog(OpenfpgaContext& openfpga_ctx,
 /********************************************************************
  * A wrapper function to call the Verilog testbench generator of FPGA-Verilog 
  *******************************************************************/
-int write_verilog_testbench(OpenfpgaContext& openfpga_ctx,
+int write_verilog_testbench(const OpenfpgaContext& openfpga_ctx,
                             const Command& cmd, const CommandContext& cmd_context) {
 
   CommandOptionId opt_output_dir = cmd.option("file");
   CommandOptionId opt_reference_benchmark = cmd.option("reference_benchmark_file_path");
   CommandOptionId opt_print_top_testbench = cmd.option("print_top_testbench");
   CommandOptionId opt_fast_configuration = cmd.option("fast_configuration");
+  CommandOptionId opt_compress_bitstream = cmd.option("compress_bitstream");
+  CommandOptionId opt_readmem_bitstream = cmd.option("readmem_bitstream");
+  CommandOptionId opt_defparam_bitstream = cmd.option("defparam_bitstream");
+  CommandOptionId opt_prune_formal_verification_top_netlist = cmd.option("prune_formal_verification_top_netlist");
+  CommandOptionId opt_batch_check = cmd.option("batch_check");
+  CommandOptionId opt_print_fabric_testbench = cmd.option("print_fabric_testbench");
   CommandOptionId opt_print_formal_verification_top_netlist = cmd.option("print_formal_verification_top_netlist");
   CommandOptionId opt_print_preconfig_top_testbench = cmd.option("print_preconfig_top_testbench");
   CommandOptionId opt_print_simulation_ini = cmd.option("print_simulation_ini");
@@ -83,16 +161,35 @@ int write_verilog_testbench(OpenfpgaContext& openfpga_ctx,
   options.set_print_formal_verification_top_netlist(cmd_context.option_enable(cmd, opt_print_formal_verification_top_netlist));
   options.set_print_preconfig_top_testbench(cmd_context.option_enable(cmd, opt_print_preconfig_top_testbench));
   options.set_fast_configuration(cmd_context.option_enable(cmd, opt_fast_configuration));
+  options.set_compress_bitstream(cmd_context.option_enable(cmd, opt_compress_bitstream));
+  options.set_readmem_bitstream(cmd_context.option_enable(cmd, opt_readmem_bitstream));
+  options.set_defparam_bitstream(cmd_context.option_enable(cmd, opt_defparam_bitstream));
+  options.set_prune_formal_verification_top_netlist(cmd_context.option_enable(cmd, opt_prune_formal_verification_top_netlist));
+  options.set_packed_ports(openfpga_ctx.flow_manager().packed_verilog_ports());
+  options.set_batch_check(cmd_context.option_enable(cmd, opt_batch_check));
   options.set_print_top_testbench(cmd_context.option_enable(cmd, opt_print_top_testbench));
+  options.set_print_fabric_testbench(cmd_context.option_enable(cmd, opt_print_fabric_testbench));
   options.set_print_simulation_ini(cmd_context.option_value(cmd, opt_print_simulation_ini));
   options.set_explicit_port_mapping(cmd_context.option_enable(cmd, opt_explicit_port_mapping));
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
+
+  /* The instances in the arrays of a compact top-level module are named after their generate blocks,
+   * which the hierarchical paths of the pre-configured top-level module cannot refer to
+   */
+  if ( (true == openfpga_ctx.flow_manager().compact_verilog_top_module())
+    && (true == options.print_formal_verification_top_netlist()) ) {
+    VTR_LOG_ERROR("Pre-configured top-level netlist and testbench are not applicable when the fabric netlists are written with '--compact_top_module'!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
   
   fpga_verilog_testbench(openfpga_ctx.module_graph(),
                          openfpga_ctx.bitstream_manager(),
                          openfpga_ctx.fabric_bitstream(),
                          g_vpr_ctx.atom(),
                          g_vpr_ctx.placement(),
+                         g_vpr_ctx.device().grid,
+                         openfpga_ctx.device_rr_gsb(),
+                         openfpga_ctx.vpr_routing_annotation(),
                          openfpga_ctx.io_location_map(),
                          openfpga_ctx.vpr_netlist_annotation(),
                          openfpga_ctx.arch().circuit_lib,
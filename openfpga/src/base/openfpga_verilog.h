@@ -18,7 +18,7 @@ namespace openfpga {
 int write_fabric_verilog(OpenfpgaContext& openfpga_ctx,
                          const Command& cmd, const CommandContext& cmd_context); 
 
-int write_verilog_testbench(OpenfpgaContext& openfpga_ctx,
+int write_verilog_testbench(const OpenfpgaContext& openfpga_ctx,
                             const Command& cmd, const CommandContext& cmd_context); 
 
 } /* end namespace openfpga */
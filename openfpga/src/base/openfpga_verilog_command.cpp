@@ -33,6 +33,9 @@ ShellCommandId add_openfpga_write_fabric_verilog_command(openfpga::Shell<Openfpg
   /* Add an option '--include_timing' */
   shell_cmd.add_option("include_timing", false, "Enable timing annotation in Verilog netlists");
 
+  /* Add an option '--sdf_timing' */
+  shell_cmd.add_option("sdf_timing", false, "Write the delays of the timing annotation into an SDF file, instead of the specify blocks of Verilog netlists");
+
   /* Add an option '--include_signal_init' */
   shell_cmd.add_option("include_signal_init", false, "Initialize all the signals in Verilog netlists");
 
@@ -42,6 +45,34 @@ ShellCommandId add_openfpga_write_fabric_verilog_command(openfpga::Shell<Openfpg
   /* Add an option '--print_user_defined_template' */
   shell_cmd.add_option("print_user_defined_template", false, "Generate a template Verilog files for user-defined circuit models");
 
+  /* Add an option '--parameterized_mux' */
+  shell_cmd.add_option("parameterized_mux", false, "Write the multiplexers of each circuit model with a parameterized Verilog module");
+
+  /* Add an option '--compact_top_module' */
+  shell_cmd.add_option("compact_top_module", false, "Write the instances of the top-level module which are connected in a regular way in generate loops");
+
+  /* Add an option '--packed_ports' */
+  shell_cmd.add_option("packed_ports", false, "Pack the single-pin ports of grids and routing blocks into Verilog vectors, so that their connections are written as ranges");
+
+  /* Add an option '--target' */
+  CommandOptionId opt_target = shell_cmd.add_option("target", false, "Fine-tune Verilog netlists for a simulator. Can be [verilator]");
+  shell_cmd.set_option_require_value(opt_target, openfpga::OPT_STRING);
+
+  /* Add an option '--incremental' */
+  shell_cmd.add_option("incremental", false, "Keep the existing Verilog netlists whose contents are not changed");
+
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Specify the number of netlists to be written in parallel");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
+  /* Add an option '--jobs', which is a deprecated alias of '--threads' */
+  CommandOptionId opt_jobs = shell_cmd.add_option("jobs", false, "Deprecated alias of '--threads'");
+  shell_cmd.set_option_require_value(opt_jobs, openfpga::OPT_INT);
+
+  /* Add an option '--shard_region' */
+  CommandOptionId opt_shard_region = shell_cmd.add_option("shard_region", false, "Only write the netlists of the routing blocks in a window of the device, in the format of 'xlow,ylow,xhigh,yhigh'");
+  shell_cmd.set_option_require_value(opt_shard_region, openfpga::OPT_STRING);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
   
@@ -80,7 +111,25 @@ ShellCommandId add_openfpga_write_verilog_testbench_command(openfpga::Shell<Open
   shell_cmd.add_option("print_top_testbench", false, "Generate a full testbench for top-level fabric module with autocheck capability");
 
   /* Add an option '--fast_configuration' */
-  shell_cmd.add_option("fast_configuration", false, "Reduce the period of configuration by skip zero data points");
+  shell_cmd.add_option("fast_configuration", false, "Reduce the period of configuration by skipping the data points which equal the reset value of memories");
+
+  /* Add an option '--compress_bitstream' */
+  shell_cmd.add_option("compress_bitstream", false, "Load the bitstream through a run-length decompressor in the top-level testbench (configuration chain only)");
+
+  /* Add an option '--readmem_bitstream' */
+  shell_cmd.add_option("readmem_bitstream", false, "Load the bitstream from a memory file with $readmemb/$readmemh in the top-level testbench");
+
+  /* Add an option '--defparam_bitstream' */
+  shell_cmd.add_option("defparam_bitstream", false, "Load the bitstream by setting parameters of configuration memories with defparam in the pre-configured top-level module");
+
+  /* Add an option '--prune_formal_verification_top_netlist' */
+  shell_cmd.add_option("prune_formal_verification_top_netlist", false, "Only keep the tiles, switch blocks and connection blocks used by the implemented benchmark in the pre-configured top-level module, with their unused inputs tied to logic '0'");
+
+  /* Add an option '--batch_check' */
+  shell_cmd.add_option("batch_check", false, "Load input vectors from a memory file with $readmemh and check the output vectors in batch in the random testbench of the pre-configured top-level module");
+
+  /* Add an option '--print_fabric_testbench' */
+  shell_cmd.add_option("print_fabric_testbench", false, "Generate a testbench for the FPGA fabric which loads the bitstream and vectors at runtime, as well as the data files of the benchmark");
 
   /* Add an option '--print_formal_verification_top_netlist' */
   shell_cmd.add_option("print_formal_verification_top_netlist", false, "Generate a top-level module which can be used in formal verification");
@@ -101,7 +150,7 @@ ShellCommandId add_openfpga_write_verilog_testbench_command(openfpga::Shell<Open
   /* Add command to the Shell */
   ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "generate Verilog testbenches for full FPGA fabric");
   shell.set_command_class(shell_cmd_id, cmd_class_id);
-  shell.set_command_execute_function(shell_cmd_id, write_verilog_testbench);
+  shell.set_command_const_execute_function(shell_cmd_id, write_verilog_testbench);
 
   /* Add command dependency to the Shell */
   shell.set_command_dependency(shell_cmd_id, dependent_cmds);
@@ -33,13 +33,22 @@ int write_gsb(const OpenfpgaContext& openfpga_ctx,
   VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
   VTR_ASSERT(false == cmd_context.option_value(cmd, opt_file).empty());
 
+  CommandOptionId opt_unique = cmd.option("unique");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Unique switch blocks are only identified when the routing hierarchy is compressed */
+  if ( (true == cmd_context.option_enable(cmd, opt_unique))
+    && (0 == openfpga_ctx.device_rr_gsb().get_num_sb_unique_module()) ) {
+    VTR_LOG_ERROR("No unique switch blocks are found! Please run 'build_fabric --compress_routing' before outputting unique switch blocks.\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   std::string sb_file_name = cmd_context.option_value(cmd, opt_file);
 
   write_device_rr_gsb_to_xml(sb_file_name.c_str(),
                              g_vpr_ctx.device().rr_graph,
                              openfpga_ctx.device_rr_gsb(),
+                             cmd_context.option_enable(cmd, opt_unique),
                              cmd_context.option_enable(cmd, opt_verbose));
 
   /* TODO: should identify the error code from internal function execution */
@@ -0,0 +1,136 @@
+/******************************************************************************
+ * This file introduces the binary file format of the fabric graph,
+ * which includes the module graph, the decoder library and the I/O location map
+ * built by the command 'build_fabric'.
+ * The file can be loaded without rebuilding the fabric, as long as the 
+ * architectures and the device are the same.
+ *
+ * File layout
+ * -----------
+ * All the fields are stored in the native byte order (little-endian on all the hosts we support)
+ *
+ *  +------------------------------------------+  offset 0
+ *  | Header (BinaryFabricGraphHeader)         |
+ *  +------------------------------------------+
+ *  | Decoders (BinaryFabricGraphDecoder)      |
+ *  +------------------------------------------+
+ *  | I/O indices (BinaryFabricGraphIoIndex)   |
+ *  +------------------------------------------+
+ *  | Module 0 ... N-1: name and ports         |
+ *  +------------------------------------------+
+ *  | Module 0 ... N-1: children and nets      |
+ *  +------------------------------------------+
+ *
+ * Modules are stored in the order of their ids, so that the ids remain the same
+ * once the file is loaded. Since a module may instanciate any other module,
+ * the children and nets of modules are stored after all the modules are declared.
+ *
+ * Each module declaration is stored as
+ *  - a module header (BinaryFabricGraphModuleHeader) and the name of the module
+ *  - the ports in the order of their ids, each of which is a port header 
+ *    (BinaryFabricGraphPortHeader) followed by the name and the pre-processing flag
+ *
+ * The body of each module is stored as
+ *  - a body header (BinaryFabricGraphModuleBodyHeader)
+ *  - the child modules, each of which is a child header (BinaryFabricGraphChildHeader)
+ *    followed by the instance names, i.e., a 32-bit length and the characters of each name
+ *  - the configurable children (BinaryFabricGraphConfigurableChild)
+ *  - the first configurable child of each configuration region (64-bit)
+ *  - the nets, each of which is a net header (BinaryFabricGraphNetHeader) followed by
+ *    the name, the sources and the sinks (BinaryFabricGraphNetTerminal)
+ *
+ * Strings are stored without any terminator
+ ******************************************************************************/
+#ifndef BINARY_FABRIC_GRAPH_H
+#define BINARY_FABRIC_GRAPH_H
+
+#include <cstdint>
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+constexpr char BINARY_FABRIC_GRAPH_MAGIC[8] = {'O', 'F', 'P', 'G', 'A', 'F', 'A', 'B'};
+constexpr uint32_t BINARY_FABRIC_GRAPH_VERSION = 1;
+
+struct BinaryFabricGraphHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  /* Size of the device grid which the fabric is built for */
+  uint64_t grid_width;
+  uint64_t grid_height;
+  uint64_t num_decoders;
+  uint64_t num_io_indices;
+  uint64_t num_modules;
+};
+
+struct BinaryFabricGraphDecoder {
+  uint64_t addr_size;
+  uint64_t data_size;
+  uint8_t use_enable;
+  uint8_t use_data_in;
+  uint8_t use_data_inv_port;
+  /* Maximum number of address bits in a predecode group, 0 for no predecoding */
+  uint8_t predecode_size;
+  uint8_t reserved[4];
+};
+
+struct BinaryFabricGraphIoIndex {
+  uint64_t x;
+  uint64_t y;
+  uint64_t z;
+  uint64_t io_index;
+};
+
+struct BinaryFabricGraphModuleHeader {
+  uint32_t name_length;
+  uint32_t usage;
+  uint64_t num_ports;
+};
+
+struct BinaryFabricGraphPortHeader {
+  uint32_t name_length;
+  uint32_t port_type;
+  uint64_t lsb;
+  uint64_t msb;
+  uint8_t is_wire;
+  uint8_t is_register;
+  uint8_t reserved[2];
+  uint32_t preproc_flag_length;
+};
+
+struct BinaryFabricGraphModuleBodyHeader {
+  uint64_t num_children;
+  uint64_t num_configurable_children;
+  /* 0 if all the configurable children belong to a single region */
+  uint64_t num_config_regions;
+  uint64_t num_nets;
+};
+
+struct BinaryFabricGraphChildHeader {
+  uint64_t child_module;
+  uint64_t num_instances;
+};
+
+struct BinaryFabricGraphConfigurableChild {
+  uint64_t child_module;
+  uint64_t child_instance;
+};
+
+struct BinaryFabricGraphNetHeader {
+  uint32_t name_length;
+  uint32_t reserved;
+  uint64_t num_sources;
+  uint64_t num_sinks;
+};
+
+struct BinaryFabricGraphNetTerminal {
+  uint64_t module;
+  uint64_t instance;
+  uint64_t port;
+  uint64_t pin;
+};
+
+} /* end namespace openfpga */
+
+#endif
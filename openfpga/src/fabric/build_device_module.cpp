@@ -39,6 +39,8 @@ int build_device_module_graph(ModuleManager& module_manager,
                               const bool& duplicate_grid_pin,
                               const FabricKey& fabric_key,
                               const bool& generate_random_fabric_key,
+                              const bool& optimize_config_order,
+                              const size_t& num_threads,
                               const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Build fabric module graph");
 
@@ -87,7 +89,7 @@ int build_device_module_graph(ModuleManager& module_manager,
                      openfpga_ctx.arch().circuit_lib,
                      openfpga_ctx.mux_lib(),
                      openfpga_ctx.arch().config_protocol.type(),
-                     sram_model, duplicate_grid_pin, verbose);
+                     sram_model, duplicate_grid_pin, num_threads, verbose);
 
   if (true == compress_routing) {
     build_unique_routing_modules(module_manager,
@@ -97,7 +99,7 @@ int build_device_module_graph(ModuleManager& module_manager,
                                  openfpga_ctx.device_rr_gsb(),
                                  openfpga_ctx.arch().circuit_lib,
                                  openfpga_ctx.arch().config_protocol.type(),
-                                 sram_model, verbose);
+                                 sram_model, num_threads, verbose);
   } else {
     VTR_ASSERT_SAFE(false == compress_routing);
     build_flatten_routing_modules(module_manager,
@@ -107,7 +109,7 @@ int build_device_module_graph(ModuleManager& module_manager,
                                   openfpga_ctx.device_rr_gsb(),
                                   openfpga_ctx.arch().circuit_lib,
                                   openfpga_ctx.arch().config_protocol.type(),
-                                  sram_model, verbose);
+                                  sram_model, num_threads, verbose);
   }
 
   /* Build FPGA fabric top-level module */
@@ -122,8 +124,11 @@ int build_device_module_graph(ModuleManager& module_manager,
                             openfpga_ctx.arch().arch_direct, 
                             openfpga_ctx.arch().config_protocol.type(),
                             sram_model,
+                            openfpga_ctx.arch().config_protocol.num_regions(),
+                            openfpga_ctx.arch().config_protocol.word_write(),
                             frame_view, compress_routing, duplicate_grid_pin,
-                            fabric_key, generate_random_fabric_key);
+                            fabric_key, generate_random_fabric_key,
+                            optimize_config_order);
 
   if (CMD_EXEC_FATAL_ERROR == status) {
     return status;
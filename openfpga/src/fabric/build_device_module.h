@@ -25,6 +25,8 @@ int build_device_module_graph(ModuleManager& module_manager,
                               const bool& duplicate_grid_pin,
                               const FabricKey& fabric_key,
                               const bool& generate_random_fabric_key,
+                              const bool& optimize_config_order,
+                              const size_t& num_threads,
                               const bool& verbose);
 
 } /* end namespace openfpga */
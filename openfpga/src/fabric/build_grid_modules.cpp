@@ -3,6 +3,7 @@
  * (CLBs, I/Os, heterogeneous blocks etc.) 
  *******************************************************************/
 #include <ctime>
+#include <utility>
 #include <vector>
 
 /* Headers from vtrutil library */
@@ -10,6 +11,7 @@
 #include "vtr_log.h"
 #include "vtr_assert.h"
 #include "vtr_time.h"
+#include "vtr_trace.h"
 
 /* Headers from vpr library */
 #include "vpr_utils.h"
@@ -25,6 +27,7 @@
 
 #include "build_grid_module_utils.h"
 #include "build_grid_module_duplicated_pins.h"
+#include "build_parallel_modules.h"
 #include "build_grid_modules.h"
 
 /* begin namespace openfpga */
@@ -992,6 +995,7 @@ void build_physical_tile_module(ModuleManager& module_manager,
 
   ModuleId grid_module = module_manager.add_module(grid_module_name); 
   VTR_ASSERT(true == module_manager.valid_module_id(grid_module));
+  module_manager.set_module_usage(grid_module, ModuleManager::MODULE_GRID);
 
   /* Now each physical tile may have a number of logical blocks
    * OpenFPGA only considers the physical implementation of the tiles.
@@ -1126,6 +1130,10 @@ void build_physical_tile_module(ModuleManager& module_manager,
  *   - Only one module for each I/O on each border side (IO_TYPE)
  *   - Only one module for each CLB (FILL_TYPE)
  *   - Only one module for each heterogeneous block
+ *
+ * The modules of different logical tiles (and of different physical tiles)
+ * are independent from each other, so they can be built by a number of threads.
+ * See build_modules_in_parallel() for how the module ids are kept deterministic
  ****************************************************************************/
 void build_grid_modules(ModuleManager& module_manager,
                         DecoderLibrary& decoder_lib,
@@ -1136,6 +1144,7 @@ void build_grid_modules(ModuleManager& module_manager,
                         const e_config_protocol_type& sram_orgz_type,
                         const CircuitModelId& sram_model,
                         const bool& duplicate_grid_pin,
+                        const size_t& num_threads,
                         const bool& verbose) {
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Build grid modules");
@@ -1150,18 +1159,27 @@ void build_grid_modules(ModuleManager& module_manager,
   /* Build modules starting from the top-level pb_type/pb_graph_node, and traverse the graph in a recursive way */
   VTR_LOG("Building logical tiles...");
   VTR_LOGV(verbose, "\n");
+  std::vector<const t_logical_block_type*> logical_tiles;
   for (const t_logical_block_type& logical_tile : device_ctx.logical_block_types) {
     /* Bypass empty pb_graph */
     if (nullptr == logical_tile.pb_graph_head) {
       continue;
     }
-    rec_build_logical_tile_modules(module_manager, decoder_lib,
+    logical_tiles.push_back(&logical_tile);
+  }
+  build_modules_in_parallel(module_manager, decoder_lib,
+                            logical_tiles.size(), num_threads,
+                            [&](ModuleManager& tile_module_manager,
+                                DecoderLibrary& tile_decoder_lib,
+                                const size_t& itile) {
+    vtr::ScopedTraceEvent trace_event("Build logical tile module", logical_tiles[itile]->name);
+    rec_build_logical_tile_modules(tile_module_manager, tile_decoder_lib,
                                    device_annotation,
                                    circuit_lib, mux_lib,
                                    sram_orgz_type, sram_model, 
-                                   logical_tile.pb_graph_head,
+                                   logical_tiles[itile]->pb_graph_head,
                                    verbose);
-  }
+  });
   VTR_LOG("Done\n");
 
   /* Enumerate the types of physical tiles
@@ -1169,11 +1187,14 @@ void build_grid_modules(ModuleManager& module_manager,
    */
   VTR_LOG("Building physical tiles...");
   VTR_LOGV(verbose, "\n");
+  /* Each physical tile module is defined by the type and the border side of the tile */
+  std::vector<std::pair<const t_physical_tile_type*, e_side>> physical_tiles;
   for (const t_physical_tile_type& physical_tile : device_ctx.physical_tile_types) {
     /* Bypass empty type or nullptr */
     if (true == is_empty_type(&physical_tile)) {
       continue;
-    } else if (true == is_io_type(&physical_tile)) {
+    }
+    if (true == is_io_type(&physical_tile)) {
       /* Special for I/O block:
        * We will search the grids and see where the I/O blocks are located:
        * - If a I/O block locates on border sides of FPGA fabric:
@@ -1185,25 +1206,27 @@ void build_grid_modules(ModuleManager& module_manager,
       std::set<e_side> io_type_sides = find_physical_io_tile_located_sides(device_ctx.grid,
                                                                            &physical_tile);
       for (const e_side& io_type_side : io_type_sides) {
-        build_physical_tile_module(module_manager, decoder_lib,
-                                   circuit_lib,
-                                   sram_orgz_type, sram_model,
-                                   &physical_tile,
-                                   io_type_side,
-                                   duplicate_grid_pin,
-                                   verbose);
+        physical_tiles.push_back(std::make_pair(&physical_tile, io_type_side));
       } 
     } else {
       /* For CLB and heterogenenous blocks */
-      build_physical_tile_module(module_manager, decoder_lib,
-                                 circuit_lib, 
-                                 sram_orgz_type, sram_model,
-                                 &physical_tile,
-                                 NUM_SIDES,
-                                 duplicate_grid_pin,
-                                 verbose);
+      physical_tiles.push_back(std::make_pair(&physical_tile, NUM_SIDES));
     }
   }
+  build_modules_in_parallel(module_manager, decoder_lib,
+                            physical_tiles.size(), num_threads,
+                            [&](ModuleManager& tile_module_manager,
+                                DecoderLibrary& tile_decoder_lib,
+                                const size_t& itile) {
+    vtr::ScopedTraceEvent trace_event("Build physical tile module", physical_tiles[itile].first->name);
+    build_physical_tile_module(tile_module_manager, tile_decoder_lib,
+                               circuit_lib,
+                               sram_orgz_type, sram_model,
+                               physical_tiles[itile].first,
+                               physical_tiles[itile].second,
+                               duplicate_grid_pin,
+                               verbose);
+  });
   VTR_LOG("Done\n");
 }
 
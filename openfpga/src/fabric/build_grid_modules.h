@@ -26,6 +26,7 @@ void build_grid_modules(ModuleManager& module_manager,
                         const e_config_protocol_type& sram_orgz_type,
                         const CircuitModelId& sram_model,
                         const bool& duplicate_grid_pin,
+                        const size_t& num_threads,
                         const bool& verbose);
 
 } /* end namespace openfpga */
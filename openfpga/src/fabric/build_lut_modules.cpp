@@ -156,9 +156,9 @@ void build_lut_module(ModuleManager& module_manager,
   /* Get the tri-state port map for the input ports*/
   std::string tri_state_map = circuit_lib.port_tri_state_map(lut_input_ports[0]);
   size_t mode_select_port_lsb = 0;
+  ModulePortId lut_module_input_port_id = module_manager.find_module_port(lut_module, circuit_lib.port_prefix(lut_input_ports[0]));
+  VTR_ASSERT(true == module_manager.valid_module_port_id(lut_module, lut_module_input_port_id));
   for (const auto& pin : circuit_lib.pins(lut_input_ports[0])) {
-    ModulePortId lut_module_input_port_id = module_manager.find_module_port(lut_module, circuit_lib.port_prefix(lut_input_ports[0]));
-    VTR_ASSERT(true == module_manager.valid_module_port_id(lut_module, lut_module_input_port_id));
 
     /* Create a module net for the connection */
     ModuleNetId net = module_manager.create_module_net(lut_module);
@@ -363,12 +363,10 @@ void build_lut_module(ModuleManager& module_manager,
   ModulePortId lut_mux_input_port_id = module_manager.find_module_port(lut_mux_module, circuit_lib.port_prefix(lut_input_ports[0]));
   BasicPort lut_mux_input_port = module_manager.module_port(lut_mux_module, lut_mux_input_port_id);
   VTR_ASSERT(lut_mux_input_port.get_width() == lut_sram_port.get_width());
-  /* Wire the port to lut_mux_sram_net */
-  for (size_t pin_id = 0; pin_id < lut_mux_input_port.pins().size(); ++pin_id) {
-    ModuleNetId net = module_manager.create_module_net(lut_module);
-    module_manager.add_module_net_source(lut_module, net, lut_module, 0, lut_sram_port_id, lut_sram_port.pins()[pin_id]);
-    module_manager.add_module_net_sink(lut_module, net, lut_mux_module, lut_mux_instance, lut_mux_input_port_id, lut_mux_input_port.pins()[pin_id]);
-  } 
+  /* Wire the port to lut_mux_sram_net, i.e., a net per pin (up to 64 for a 6-input LUT) */
+  module_manager.add_module_port_nets(lut_module,
+                                      lut_module, 0, lut_sram_port_id, lut_sram_port.pins(),
+                                      lut_mux_module, lut_mux_instance, lut_mux_input_port_id, lut_mux_input_port.pins());
 
   for (const auto& port : lut_output_ports) {
     ModulePortId lut_output_port_id = module_manager.find_module_port(lut_module, circuit_lib.port_prefix(port));
@@ -377,11 +375,9 @@ void build_lut_module(ModuleManager& module_manager,
     BasicPort lut_mux_output_port = module_manager.module_port(lut_mux_module, lut_mux_output_port_id);
     VTR_ASSERT(lut_mux_output_port.get_width() == lut_output_port.get_width());
     /* Wire the port to lut_mux_sram_net */
-    for (size_t pin_id = 0; pin_id < lut_output_port.pins().size(); ++pin_id) {
-      ModuleNetId net = module_manager.create_module_net(lut_module);
-      module_manager.add_module_net_source(lut_module, net, lut_mux_module, lut_mux_instance, lut_mux_output_port_id, lut_mux_output_port.pins()[pin_id]);
-      module_manager.add_module_net_sink(lut_module, net, lut_module, 0, lut_output_port_id, lut_output_port.pins()[pin_id]);
-    } 
+    module_manager.add_module_port_nets(lut_module,
+                                        lut_mux_module, lut_mux_instance, lut_mux_output_port_id, lut_mux_output_port.pins(),
+                                        lut_module, 0, lut_output_port_id, lut_output_port.pins());
   }
 
   /* Add global ports to the pb_module:
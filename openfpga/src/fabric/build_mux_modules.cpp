@@ -7,6 +7,7 @@
  **********************************************/
 #include <string>
 #include <algorithm>
+#include <map>
 
 /* Headers from vtrutil library */
 #include "vtr_log.h"
@@ -529,6 +530,43 @@ void build_cmos_mux_module_mux2_multiplexing_structure(ModuleManager& module_man
   }
 }
 
+/********************************************************************
+ * The ports of a branch module of a tgate-based multiplexing structure
+ *******************************************************************/
+struct t_mux_branch_module_ports {
+  ModuleId module;
+  ModulePortId input_port_id;
+  BasicPort input_port;
+  ModulePortId output_port_id;
+  BasicPort output_port;
+  ModulePortId mem_port_id;
+  BasicPort mem_port;
+  ModulePortId mem_inv_port_id;
+  BasicPort mem_inv_port;
+};
+
+static 
+t_mux_branch_module_ports find_mux_branch_module_ports(const ModuleManager& module_manager,
+                                                       const std::string& branch_module_name) {
+  t_mux_branch_module_ports branch_module_ports;
+
+  /* Get the moduleId for the submodule */
+  branch_module_ports.module = module_manager.find_module(branch_module_name);
+  /* We must have one */
+  VTR_ASSERT(ModuleId::INVALID() != branch_module_ports.module);
+
+  branch_module_ports.input_port_id = module_manager.find_module_port(branch_module_ports.module, std::string("in")); 
+  branch_module_ports.input_port = module_manager.module_port(branch_module_ports.module, branch_module_ports.input_port_id);
+  branch_module_ports.output_port_id = module_manager.find_module_port(branch_module_ports.module, std::string("out")); 
+  branch_module_ports.output_port = module_manager.module_port(branch_module_ports.module, branch_module_ports.output_port_id);
+  branch_module_ports.mem_port_id = module_manager.find_module_port(branch_module_ports.module, std::string("mem")); 
+  branch_module_ports.mem_port = module_manager.module_port(branch_module_ports.module, branch_module_ports.mem_port_id);
+  branch_module_ports.mem_inv_port_id = module_manager.find_module_port(branch_module_ports.module, std::string("mem_inv")); 
+  branch_module_ports.mem_inv_port = module_manager.module_port(branch_module_ports.module, branch_module_ports.mem_inv_port_id);
+
+  return branch_module_ports;
+}
+
 /********************************************************************
  * Generate the pass-transistor/transmission-gate -based internal logic 
  * (multiplexing structure) for a multiplexer or LUT in Verilog codes 
@@ -564,6 +602,14 @@ void build_cmos_mux_module_tgate_multiplexing_structure(ModuleManager& module_ma
 
   /* Build the location map of intermediate buffers */
   std::vector<bool> inter_buffer_location_map = build_mux_intermediate_buffer_location_map(circuit_lib, circuit_model, mux_graph.num_node_levels());
+
+  /* A multiplexer only uses a few sizes of branch modules, e.g., 2:1 for a tree-like structure,
+   * so the branch module and its ports are found once per size rather than once per node
+   */
+  std::map<size_t, t_mux_branch_module_ports> branch_modules;
+
+  /* Each non-input node drives a net, in addition to the nets of intermediate buffers */
+  module_manager.reserve_module_nets(mux_module, module_manager.num_nets(mux_module) + 2 * mux_graph.nodes().size());
  
   /* Add all the branch modules and intermediate buffers */
   for (const auto& node : mux_graph.non_input_nodes()) {
@@ -574,11 +620,14 @@ void build_cmos_mux_module_tgate_multiplexing_structure(ModuleManager& module_ma
 
     /* Instanciate the branch module which is a tgate-based module  
      */
-    std::string branch_module_name= generate_mux_branch_subckt_name(circuit_lib, circuit_model, mux_size, branch_size, MUX_BASIS_MODULE_POSTFIX);
+    auto branch_module_result = branch_modules.find(branch_size);
+    if (branch_modules.end() == branch_module_result) {
+      std::string branch_module_name= generate_mux_branch_subckt_name(circuit_lib, circuit_model, mux_size, branch_size, MUX_BASIS_MODULE_POSTFIX);
+      branch_module_result = branch_modules.emplace(branch_size, find_mux_branch_module_ports(module_manager, branch_module_name)).first;
+    }
+    const t_mux_branch_module_ports& branch_module_ports = branch_module_result->second;
     /* Get the moduleId for the submodule */
-    ModuleId branch_module_id = module_manager.find_module(branch_module_name);
-    /* We must have one */
-    VTR_ASSERT(ModuleId::INVALID() != branch_module_id);
+    const ModuleId& branch_module_id = branch_module_ports.module;
 
     /* Find the instance id */
     size_t branch_instance_id = module_manager.num_instance(mux_module, branch_module_id);
@@ -593,8 +642,8 @@ void build_cmos_mux_module_tgate_multiplexing_structure(ModuleManager& module_ma
     module_manager.set_child_instance_name(mux_module, branch_module_id, branch_instance_id, branch_instance_name);
 
     /* Get the output port id of branch module */
-    ModulePortId branch_module_output_port_id = module_manager.find_module_port(branch_module_id, std::string("out")); 
-    BasicPort branch_module_output_port = module_manager.module_port(branch_module_id, branch_module_output_port_id);
+    const ModulePortId& branch_module_output_port_id = branch_module_ports.output_port_id; 
+    const BasicPort& branch_module_output_port = branch_module_ports.output_port;
 
     /* Add module nets to wire to next stage modules */
     ModuleNetId branch_net; 
@@ -624,10 +673,10 @@ void build_cmos_mux_module_tgate_multiplexing_structure(ModuleManager& module_ma
     }
 
     /* Get mem/mem_inv ports of branch module */
-    ModulePortId branch_module_mem_port_id = module_manager.find_module_port(branch_module_id, std::string("mem")); 
-    BasicPort branch_module_mem_port = module_manager.module_port(branch_module_id, branch_module_mem_port_id);
-    ModulePortId branch_module_mem_inv_port_id = module_manager.find_module_port(branch_module_id, std::string("mem_inv")); 
-    BasicPort branch_module_mem_inv_port = module_manager.module_port(branch_module_id, branch_module_mem_inv_port_id);
+    const ModulePortId& branch_module_mem_port_id = branch_module_ports.mem_port_id; 
+    const BasicPort& branch_module_mem_port = branch_module_ports.mem_port;
+    const ModulePortId& branch_module_mem_inv_port_id = branch_module_ports.mem_inv_port_id; 
+    const BasicPort& branch_module_mem_inv_port = branch_module_ports.mem_inv_port;
 
     /* Note that we do NOT care inverted edge-to-mem connection. 
      * It is handled in branch module generation!!!
@@ -640,8 +689,8 @@ void build_cmos_mux_module_tgate_multiplexing_structure(ModuleManager& module_ma
 
     /* Wire the branch module inputs to the nets in previous stage */
     /* Get the input port id of branch module */
-    ModulePortId branch_module_input_port_id = module_manager.find_module_port(branch_module_id, std::string("in")); 
-    BasicPort branch_module_input_port = module_manager.module_port(branch_module_id, branch_module_input_port_id);
+    const ModulePortId& branch_module_input_port_id = branch_module_ports.input_port_id; 
+    const BasicPort& branch_module_input_port = branch_module_ports.input_port;
 
     /* Get the nodes which drive the root_node */
     std::vector<MuxNodeId> input_nodes; 
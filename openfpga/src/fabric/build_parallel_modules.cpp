@@ -0,0 +1,198 @@
+/********************************************************************
+ * This file includes functions that add the modules built
+ * in a staging area to a module manager
+ *******************************************************************/
+#include <string>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_vector.h"
+
+#include "build_parallel_modules.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Add the decoders which are created in a staging decoder library
+ * and are not yet in the decoder library
+ *******************************************************************/
+static
+void add_staging_decoders(DecoderLibrary& decoder_lib,
+                          const DecoderLibrary& staging_decoder_lib,
+                          const size_t& num_base_decoders) {
+  for (const DecoderId& decoder : staging_decoder_lib.decoders()) {
+    /* Bypass the decoders copied from the decoder library */
+    if (size_t(decoder) < num_base_decoders) {
+      continue;
+    }
+    if (DecoderId::INVALID() != decoder_lib.find_decoder(staging_decoder_lib.addr_size(decoder),
+                                                         staging_decoder_lib.data_size(decoder),
+                                                         staging_decoder_lib.use_enable(decoder),
+                                                         staging_decoder_lib.use_data_in(decoder),
+                                                         staging_decoder_lib.use_data_inv_port(decoder))) {
+      continue;
+    }
+    decoder_lib.add_decoder(staging_decoder_lib.addr_size(decoder),
+                            staging_decoder_lib.data_size(decoder),
+                            staging_decoder_lib.use_enable(decoder),
+                            staging_decoder_lib.use_data_in(decoder),
+                            staging_decoder_lib.use_data_inv_port(decoder));
+  }
+}
+
+/********************************************************************
+ * Add the name, usage and ports of a staging module to a module manager
+ * The ports keep their ids, as they are added in the same order
+ *******************************************************************/
+static
+ModuleId add_staging_module_declaration(ModuleManager& module_manager,
+                                        const ModuleManager& staging_module_manager,
+                                        const ModuleId& staging_module) {
+  ModuleId module = module_manager.add_module(staging_module_manager.module_name(staging_module));
+  VTR_ASSERT(true == module_manager.valid_module_id(module));
+
+  /* Usage may not be defined for some modules */
+  if (ModuleManager::NUM_MODULE_USAGE_TYPES != staging_module_manager.module_usage(staging_module)) {
+    module_manager.set_module_usage(module, staging_module_manager.module_usage(staging_module));
+  }
+
+  /* Port types are only available by port groups */
+  vtr::vector<ModulePortId, ModuleManager::e_module_port_type> port_types(staging_module_manager.module_ports(staging_module).size(), ModuleManager::NUM_MODULE_PORT_TYPES);
+  for (size_t port_type = 0; port_type < ModuleManager::NUM_MODULE_PORT_TYPES; ++port_type) {
+    for (const ModulePortId& port : staging_module_manager.module_port_ids_by_type(staging_module, ModuleManager::e_module_port_type(port_type))) {
+      port_types[port] = ModuleManager::e_module_port_type(port_type);
+    }
+  }
+
+  for (const ModulePortId& staging_port : staging_module_manager.module_ports(staging_module)) {
+    BasicPort port_info = staging_module_manager.module_port(staging_module, staging_port);
+    ModulePortId port = module_manager.add_port(module, port_info, port_types[staging_port]);
+    VTR_ASSERT(port == staging_port);
+    if (true == staging_module_manager.port_is_wire(staging_module, staging_port)) {
+      module_manager.set_port_is_wire(module, port_info.get_name(), true);
+    }
+    if (true == staging_module_manager.port_is_register(staging_module, staging_port)) {
+      module_manager.set_port_is_register(module, port_info.get_name(), true);
+    }
+    std::string preproc_flag = staging_module_manager.port_preproc_flag(staging_module, staging_port);
+    if (false == preproc_flag.empty()) {
+      module_manager.set_port_preproc_flag(module, port, preproc_flag);
+    }
+  }
+
+  return module;
+}
+
+/********************************************************************
+ * Add the child modules, configurable children and nets of a staging module
+ * to a module manager, where the ids of modules are translated by the module map
+ *******************************************************************/
+static
+void add_staging_module_body(ModuleManager& module_manager,
+                             const ModuleManager& staging_module_manager,
+                             const vtr::vector<ModuleId, ModuleId>& module_map,
+                             const ModuleId& staging_module) {
+  ModuleId module = module_map[staging_module];
+
+  for (const ModuleId& staging_child : staging_module_manager.child_modules(staging_module)) {
+    ModuleId child = module_map[staging_child];
+    for (size_t inst = 0; inst < staging_module_manager.num_instance(staging_module, staging_child); ++inst) {
+      module_manager.add_child_module(module, child);
+      std::string instance_name = staging_module_manager.instance_name(staging_module, staging_child, inst);
+      if (false == instance_name.empty()) {
+        module_manager.set_child_instance_name(module, child, inst, instance_name);
+      }
+    }
+  }
+
+  std::vector<ModuleId> configurable_children = staging_module_manager.configurable_children(staging_module);
+  std::vector<size_t> configurable_child_instances = staging_module_manager.configurable_child_instances(staging_module);
+  module_manager.reserve_configurable_child(module, configurable_children.size());
+  for (size_t ichild = 0; ichild < configurable_children.size(); ++ichild) {
+    module_manager.add_configurable_child(module, module_map[configurable_children[ichild]], configurable_child_instances[ichild]);
+  }
+
+  if (1 < staging_module_manager.num_config_regions(staging_module)) {
+    std::vector<size_t> region_first_children;
+    for (size_t region = 0; region < staging_module_manager.num_config_regions(staging_module); ++region) {
+      region_first_children.push_back(staging_module_manager.region_configurable_children(staging_module, region).front());
+    }
+    module_manager.set_config_regions(module, region_first_children);
+  }
+
+  /* Nets are added in the order of their ids, so the ids remain the same */
+  module_manager.reserve_module_nets(module, staging_module_manager.num_nets(staging_module));
+  for (const ModuleNetId& staging_net : staging_module_manager.module_nets(staging_module)) {
+    ModuleNetId net = module_manager.create_module_net(module);
+    std::string net_name = staging_module_manager.net_name(staging_module, staging_net);
+    if (false == net_name.empty()) {
+      module_manager.set_net_name(module, net, net_name);
+    }
+
+    module_manager.reserve_module_net_sources(module, net, staging_module_manager.module_net_sources(staging_module, staging_net).size());
+    for (const ModuleNetSrcId& src : staging_module_manager.module_net_sources(staging_module, staging_net)) {
+      module_manager.add_module_net_source(module, net,
+                                           module_map[staging_module_manager.net_source_module(staging_module, staging_net, src)],
+                                           staging_module_manager.net_source_instance(staging_module, staging_net, src),
+                                           staging_module_manager.net_source_port(staging_module, staging_net, src),
+                                           staging_module_manager.net_source_pin(staging_module, staging_net, src));
+    }
+    module_manager.reserve_module_net_sinks(module, net, staging_module_manager.module_net_sinks(staging_module, staging_net).size());
+    for (const ModuleNetSinkId& sink : staging_module_manager.module_net_sinks(staging_module, staging_net)) {
+      module_manager.add_module_net_sink(module, net,
+                                         module_map[staging_module_manager.net_sink_module(staging_module, staging_net, sink)],
+                                         staging_module_manager.net_sink_instance(staging_module, staging_net, sink),
+                                         staging_module_manager.net_sink_port(staging_module, staging_net, sink),
+                                         staging_module_manager.net_sink_pin(staging_module, staging_net, sink));
+    }
+  }
+}
+
+/********************************************************************
+ * Add the modules and decoders which are built in a staging area
+ * to a module manager and a decoder library
+ * The staging area is a copy of the module manager and the decoder library,
+ * when they have the given number of modules and decoders,
+ * so that only the modules and decoders beyond these numbers are new.
+ *
+ * A new module whose name is already in the module manager,
+ * e.g., a decoder which is also built by another staging area,
+ * is not added again; its instances refer to the existing module instead.
+ * This is what the builders do when they find a module by its name.
+ * As a result, adding the staging areas in a fixed order creates
+ * the same module ids as building their modules one after another
+ *******************************************************************/
+void add_staging_modules(ModuleManager& module_manager,
+                         DecoderLibrary& decoder_lib,
+                         const ModuleManager& staging_module_manager,
+                         const DecoderLibrary& staging_decoder_lib,
+                         const size_t& num_base_modules,
+                         const size_t& num_base_decoders) {
+  add_staging_decoders(decoder_lib, staging_decoder_lib, num_base_decoders);
+
+  vtr::vector<ModuleId, ModuleId> module_map(staging_module_manager.num_modules(), ModuleId::INVALID());
+  std::vector<ModuleId> new_staging_modules;
+  for (const ModuleId& staging_module : staging_module_manager.modules()) {
+    /* The modules copied from the module manager keep their ids */
+    if (size_t(staging_module) < num_base_modules) {
+      module_map[staging_module] = staging_module;
+      continue;
+    }
+    ModuleId existing_module = module_manager.find_module(staging_module_manager.module_name(staging_module));
+    if (true == module_manager.valid_module_id(existing_module)) {
+      module_map[staging_module] = existing_module;
+      continue;
+    }
+    module_map[staging_module] = add_staging_module_declaration(module_manager, staging_module_manager, staging_module);
+    new_staging_modules.push_back(staging_module);
+  }
+
+  /* Bodies are added once all the modules are declared, as they may instanciate each other */
+  for (const ModuleId& staging_module : new_staging_modules) {
+    add_staging_module_body(module_manager, staging_module_manager, module_map, staging_module);
+  }
+}
+
+} /* end namespace openfpga */
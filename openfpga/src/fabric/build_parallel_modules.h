@@ -0,0 +1,104 @@
+/********************************************************************
+ * A template to build a number of modules which are independent
+ * from each other, e.g., the modules of different tile types
+ *******************************************************************/
+#ifndef BUILD_PARALLEL_MODULES_H
+#define BUILD_PARALLEL_MODULES_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <algorithm>
+#include <vector>
+
+#include "vtr_parallel.h"
+
+#include "module_manager.h"
+#include "decoder_library.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+void add_staging_modules(ModuleManager& module_manager,
+                         DecoderLibrary& decoder_lib,
+                         const ModuleManager& staging_module_manager,
+                         const DecoderLibrary& staging_decoder_lib,
+                         const size_t& num_base_modules,
+                         const size_t& num_base_decoders);
+
+/********************************************************************
+ * Build a number of groups of modules, each of which is built by
+ *   build_item(module_manager, decoder_lib, item_index)
+ * which should only read shared data, apart from the module manager
+ * and the decoder library.
+ *
+ * With a single thread, the modules are built directly in the module manager.
+ * Otherwise, the groups are split into chunks of consecutive groups,
+ * which are built in rounds of at most one chunk per thread.
+ * Each chunk of a round is built by a worker in a staging area,
+ * i.e., a copy of the module manager and the decoder library,
+ * and at the end of the round the new modules are added to the module manager
+ * in the order of the chunks, and the staging areas are released.
+ * Therefore, there are never more staging areas than threads.
+ * Modules which are shared by groups, e.g., decoders, are added only once,
+ * so that the module graph is the same regardless of the number of threads
+ *******************************************************************/
+template<class BuildItemFunc>
+void build_modules_in_parallel(ModuleManager& module_manager,
+                               DecoderLibrary& decoder_lib,
+                               const size_t& num_items,
+                               const size_t& num_threads,
+                               const BuildItemFunc& build_item) {
+  if ( (1 >= num_threads)
+    || (1 >= num_items) ) {
+    for (size_t item = 0; item < num_items; ++item) {
+      build_item(module_manager, decoder_lib, item);
+    }
+    return;
+  }
+
+  /* There are a few chunks per thread, which are enough to balance the workload
+   * (the sizes of groups vary a lot, e.g., an I/O against a DSP)
+   */
+  const size_t chunk_size = (num_items + 4 * num_threads - 1) / (4 * num_threads);
+  const size_t num_chunks = (num_items + chunk_size - 1) / chunk_size;
+
+  /* Each staging area is a copy of the module manager, so they are bounded by the number of threads */
+  std::vector<ModuleManager> staging_module_managers(num_threads);
+  std::vector<DecoderLibrary> staging_decoder_libs(num_threads);
+
+  for (size_t first_chunk = 0; first_chunk < num_chunks; first_chunk += num_threads) {
+    const size_t num_round_chunks = std::min(num_threads, num_chunks - first_chunk);
+
+    /* The staging areas include the modules added by the previous rounds */
+    const size_t num_base_modules = module_manager.num_modules();
+    const size_t num_base_decoders = decoder_lib.decoders().size();
+
+    vtr::parallel_for(num_round_chunks, num_threads, [&](const size_t& ichunk) {
+      /* Workers only copy the shared module manager, which is not modified until they all finish */
+      staging_module_managers[ichunk] = module_manager;
+      staging_decoder_libs[ichunk] = decoder_lib;
+      const size_t chunk = first_chunk + ichunk;
+      for (size_t item = chunk * chunk_size; item < std::min(num_items, (chunk + 1) * chunk_size); ++item) {
+        build_item(staging_module_managers[ichunk], staging_decoder_libs[ichunk], item);
+      }
+    });
+
+    for (size_t ichunk = 0; ichunk < num_round_chunks; ++ichunk) {
+      add_staging_modules(module_manager, decoder_lib,
+                          staging_module_managers[ichunk], staging_decoder_libs[ichunk],
+                          num_base_modules, num_base_decoders);
+      /* Release the memory as soon as possible */
+      staging_module_managers[ichunk] = ModuleManager();
+      staging_decoder_libs[ichunk] = DecoderLibrary();
+    }
+  }
+}
+
+} /* end namespace openfpga */
+
+#endif
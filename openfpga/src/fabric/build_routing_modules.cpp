@@ -5,6 +5,7 @@
  * 1. Connection blocks
  * 2. Switch blocks
  *******************************************************************/
+#include <utility>
 #include <vector>
 
 /* Headers from vtrutil library */
@@ -24,6 +25,7 @@
 #include "module_manager_utils.h"
 #include "build_module_graph_utils.h"
 #include "build_routing_module_utils.h"
+#include "build_parallel_modules.h"
 
 #include "build_routing_modules.h"
 
@@ -884,43 +886,54 @@ void build_connection_block_module(ModuleManager& module_manager,
 
 
 /********************************************************************
- * Iterate over all the connection blocks in a device
- * and build a module for each of them 
+ * A routing module to be built: the GSB and the type of the routing block,
+ * i.e., CHANX or CHANY for a connection block, and NUM_RR_TYPES for a switch block
+ *******************************************************************/
+typedef std::pair<const RRGSB*, t_rr_type> t_routing_module_item;
+
+/********************************************************************
+ * Build the modules of a list of routing blocks
+ * The routing blocks are independent from each other,
+ * so they can be built by a number of threads.
+ * See build_modules_in_parallel() for how the module ids are kept deterministic
  *******************************************************************/
 static 
-void build_flatten_connection_block_modules(ModuleManager& module_manager, 
-                                            DecoderLibrary& decoder_lib,
-                                            const DeviceContext& device_ctx,
-                                            const VprDeviceAnnotation& device_annotation,
-                                            const DeviceRRGSB& device_rr_gsb,
-                                            const CircuitLibrary& circuit_lib,
-                                            const e_config_protocol_type& sram_orgz_type,
-                                            const CircuitModelId& sram_model,
-                                            const t_rr_type& cb_type,
-                                            const bool& verbose) {
-  /* Build unique X-direction connection block modules */
-  vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
-
-  for (size_t ix = 0; ix < cb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < cb_range.y(); ++iy) {
-      /* Check if the connection block exists in the device!
-       * Some of them do NOT exist due to heterogeneous blocks (height > 1) 
-       * We will skip those modules
-       */
-      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
-      if (false == rr_gsb.is_cb_exist(cb_type)) {
-        continue;
-      }
-      build_connection_block_module(module_manager, 
-                                    decoder_lib,
+void build_routing_module_items(ModuleManager& module_manager,
+                                DecoderLibrary& decoder_lib,
+                                const DeviceContext& device_ctx,
+                                const VprDeviceAnnotation& device_annotation,
+                                const CircuitLibrary& circuit_lib,
+                                const e_config_protocol_type& sram_orgz_type,
+                                const CircuitModelId& sram_model,
+                                const std::vector<t_routing_module_item>& routing_modules,
+                                const size_t& num_threads,
+                                const bool& verbose) {
+  build_modules_in_parallel(module_manager, decoder_lib,
+                            routing_modules.size(), num_threads,
+                            [&](ModuleManager& block_module_manager,
+                                DecoderLibrary& block_decoder_lib,
+                                const size_t& iblock) {
+    const RRGSB& rr_gsb = *(routing_modules[iblock].first);
+    if (NUM_RR_TYPES == routing_modules[iblock].second) {
+      build_switch_block_module(block_module_manager,
+                                block_decoder_lib,
+                                device_annotation,
+                                device_ctx.rr_graph,
+                                circuit_lib, 
+                                sram_orgz_type, sram_model, 
+                                rr_gsb,
+                                verbose);
+    } else {
+      build_connection_block_module(block_module_manager, 
+                                    block_decoder_lib,
                                     device_annotation,
                                     device_ctx.rr_graph,
                                     circuit_lib, 
                                     sram_orgz_type, sram_model, 
-                                    rr_gsb, cb_type,
+                                    rr_gsb, routing_modules[iblock].second,
                                     verbose);
     }
-  }
+  });
 }
 
 /********************************************************************
@@ -940,49 +953,47 @@ void build_flatten_routing_modules(ModuleManager& module_manager,
                                    const CircuitLibrary& circuit_lib,
                                    const e_config_protocol_type& sram_orgz_type,
                                    const CircuitModelId& sram_model,
+                                   const size_t& num_threads,
                                    const bool& verbose) {
 
   vtr::ScopedStartFinishTimer timer("Build routing modules...");
 
-  vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+
+  std::vector<t_routing_module_item> routing_modules;
 
-  /* Build unique switch block modules */
-  for (size_t ix = 0; ix < sb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < sb_range.y(); ++iy) {
+  /* Switch block modules */
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
       const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
       if (false == rr_gsb.is_sb_exist()) {
         continue;
       }
-      build_switch_block_module(module_manager,
-                                decoder_lib,
-                                device_annotation,
-                                device_ctx.rr_graph,
-                                circuit_lib, 
-                                sram_orgz_type, sram_model, 
-                                rr_gsb,
-                                verbose);
+      routing_modules.push_back(std::make_pair(&rr_gsb, NUM_RR_TYPES));
     }
   }
 
-  build_flatten_connection_block_modules(module_manager,
-                                         decoder_lib,
-                                         device_ctx, 
-                                         device_annotation, 
-                                         device_rr_gsb, 
-                                         circuit_lib, 
-                                         sram_orgz_type, sram_model, 
-                                         CHANX,
-                                         verbose);
-
-  build_flatten_connection_block_modules(module_manager,
-                                         decoder_lib,
-                                         device_ctx, 
-                                         device_annotation, 
-                                         device_rr_gsb, 
-                                         circuit_lib,
-                                         sram_orgz_type, sram_model, 
-                                         CHANY,
-                                         verbose);
+  /* X-direction and then Y-direction connection block modules */
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+      for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+        /* Check if the connection block exists in the device!
+         * Some of them do NOT exist due to heterogeneous blocks (height > 1) 
+         * We will skip those modules
+         */
+        const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+        if (false == rr_gsb.is_cb_exist(cb_type)) {
+          continue;
+        }
+        routing_modules.push_back(std::make_pair(&rr_gsb, cb_type));
+      }
+    }
+  }
+
+  build_routing_module_items(module_manager, decoder_lib,
+                             device_ctx, device_annotation,
+                             circuit_lib, sram_orgz_type, sram_model,
+                             routing_modules, num_threads, verbose);
 }
 
 /********************************************************************
@@ -1004,50 +1015,30 @@ void build_unique_routing_modules(ModuleManager& module_manager,
                                   const CircuitLibrary& circuit_lib,
                                   const e_config_protocol_type& sram_orgz_type,
                                   const CircuitModelId& sram_model,
+                                  const size_t& num_threads,
                                   const bool& verbose) {
 
   vtr::ScopedStartFinishTimer timer("Build unique routing modules...");
 
-  /* Build unique switch block modules */
+  /* The modules are built in the order of the unique ids */
+  std::vector<t_routing_module_item> routing_modules;
+
+  /* Unique switch block modules */
   for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(isb);
-    build_switch_block_module(module_manager,
-                              decoder_lib,
-                              device_annotation,
-                              device_ctx.rr_graph,
-                              circuit_lib, 
-                              sram_orgz_type, sram_model, 
-                              unique_mirror,
-                              verbose);
+    routing_modules.push_back(std::make_pair(&device_rr_gsb.get_sb_unique_module(isb), NUM_RR_TYPES));
   }
 
-  /* Build unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, icb);
-
-    build_connection_block_module(module_manager, 
-                                  decoder_lib,
-                                  device_annotation,
-                                  device_ctx.rr_graph,
-                                  circuit_lib,  
-                                  sram_orgz_type, sram_model, 
-                                  unique_mirror, CHANX,
-                                  verbose);
+  /* Unique X-direction and then Y-direction connection block modules */
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(cb_type); ++icb) {
+      routing_modules.push_back(std::make_pair(&device_rr_gsb.get_cb_unique_module(cb_type, icb), cb_type));
+    }
   }
 
-  /* Build unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANY); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, icb);
-
-    build_connection_block_module(module_manager, 
-                                  decoder_lib,
-                                  device_annotation,
-                                  device_ctx.rr_graph,
-                                  circuit_lib, 
-                                  sram_orgz_type, sram_model, 
-                                  unique_mirror, CHANY,
-                                  verbose);
-  }
+  build_routing_module_items(module_manager, decoder_lib,
+                             device_ctx, device_annotation,
+                             circuit_lib, sram_orgz_type, sram_model,
+                             routing_modules, num_threads, verbose);
 }
 
 } /* end namespace openfpga */
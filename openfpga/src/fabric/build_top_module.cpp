@@ -155,6 +155,18 @@ vtr::Matrix<size_t> add_top_module_grid_instances(ModuleManager& module_manager,
     io_coordinates[LEFT].push_back(vtr::Point<size_t>(0, iy));
   }
 
+  /* Allocate the I/O location map for all the I/O locations at once */
+  size_t max_io_capacity = 0;
+  for (const e_side& io_side : io_sides) {
+    for (const vtr::Point<size_t>& io_coordinate : io_coordinates[io_side]) {
+      if (true == is_empty_type(grids[io_coordinate.x()][io_coordinate.y()].type)) {
+        continue;
+      }
+      max_io_capacity = std::max(max_io_capacity, size_t(grids[io_coordinate.x()][io_coordinate.y()].type->capacity));
+    }
+  }
+  io_location_map.reserve(grids.width(), grids.height(), max_io_capacity);
+
   /* Add instances of I/O grids to top_module */
   size_t io_counter = 0;
   for (const e_side& io_side : io_sides) {
@@ -332,11 +344,14 @@ int build_top_module(ModuleManager& module_manager,
                      const ArchDirect& arch_direct,
                      const e_config_protocol_type& sram_orgz_type,
                      const CircuitModelId& sram_model,
+                     const size_t& num_config_regions,
+                     const bool& config_word_write,
                      const bool& frame_view,
                      const bool& compact_routing_hierarchy,
                      const bool& duplicate_grid_pin,
                      const FabricKey& fabric_key,
-                     const bool& generate_random_fabric_key) {
+                     const bool& generate_random_fabric_key,
+                     const bool& optimize_config_order) {
 
   vtr::ScopedStartFinishTimer timer("Build FPGA fabric module");
 
@@ -399,7 +414,7 @@ int build_top_module(ModuleManager& module_manager,
                                        circuit_lib, sram_orgz_type, sram_model,
                                        grids, grid_instance_ids, 
                                        device_rr_gsb, sb_instance_ids, cb_instance_ids,
-                                       compact_routing_hierarchy);
+                                       compact_routing_hierarchy, optimize_config_order);
   } else {
     VTR_ASSERT_SAFE(false == fabric_key.empty());
     status = load_top_module_memory_modules_from_fabric_key(module_manager, top_module,
@@ -414,6 +429,15 @@ int build_top_module(ModuleManager& module_manager,
     shuffle_top_module_configurable_children(module_manager, top_module);
   }
 
+  /* Split the configurable children into regions, which are programmed in parallel */
+  if (1 < num_config_regions) {
+    status = split_top_module_configurable_children_into_regions(module_manager, top_module,
+                                                                 num_config_regions);
+    if (CMD_EXEC_FATAL_ERROR == status) {
+      return status;
+    }
+  }
+
   /* Add shared SRAM ports from the sub-modules under this Verilog module
    * This is a much easier job after adding sub modules (instances), 
    * we just need to find all the I/O ports from the child modules and build a list of it
@@ -431,7 +455,8 @@ int build_top_module(ModuleManager& module_manager,
   if (0 < module_num_config_bits) {
     add_top_module_sram_ports(module_manager, top_module,
                               circuit_lib, sram_model,
-                              sram_orgz_type, module_num_config_bits);
+                              sram_orgz_type, config_word_write,
+                              module_num_config_bits);
   }
 
   /* Add module nets to connect memory cells inside
@@ -440,7 +465,8 @@ int build_top_module(ModuleManager& module_manager,
   if (0 < module_manager.configurable_children(top_module).size()) {
     add_top_module_nets_memory_config_bus(module_manager, decoder_lib,
                                           top_module, 
-                                          sram_orgz_type, circuit_lib.design_tech_type(sram_model),
+                                          sram_orgz_type, config_word_write,
+                                          circuit_lib.design_tech_type(sram_model),
                                           module_num_config_bits);
   }
 
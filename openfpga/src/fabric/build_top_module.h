@@ -36,11 +36,14 @@ int build_top_module(ModuleManager& module_manager,
                      const ArchDirect& arch_direct,
                      const e_config_protocol_type& sram_orgz_type,
                      const CircuitModelId& sram_model,
+                     const size_t& num_config_regions,
+                     const bool& config_word_write,
                      const bool& frame_view,
                      const bool& compact_routing_hierarchy,
                      const bool& duplicate_grid_pin,
                      const FabricKey& fabric_key,
-                     const bool& generate_random_fabric_key);
+                     const bool& generate_random_fabric_key,
+                     const bool& optimize_config_order);
 
 } /* end namespace openfpga */
 
@@ -129,11 +129,9 @@ void add_top_module_nets_connect_grids_and_sb(ModuleManager& module_manager,
       VTR_ASSERT(src_grid_port.get_width() == sink_sb_port.get_width());
       
       /* Create a net for each pin */
-      for (size_t pin_id = 0; pin_id < src_grid_port.pins().size(); ++pin_id) {
-        ModuleNetId net = create_module_source_pin_net(module_manager, top_module, src_grid_module, src_grid_instance, src_grid_port_id, src_grid_port.pins()[pin_id]);
-        /* Configure the net sink */
-        module_manager.add_module_net_sink(top_module, net, sink_sb_module, sink_sb_instance, sink_sb_port_id, sink_sb_port.pins()[pin_id]);
-      }
+      module_manager.add_module_port_nets(top_module,
+                                          src_grid_module, src_grid_instance, src_grid_port_id, src_grid_port.pins(),
+                                          sink_sb_module, sink_sb_instance, sink_sb_port_id, sink_sb_port.pins());
     } 
   }
 }
@@ -272,11 +270,9 @@ void add_top_module_nets_connect_grids_and_sb_with_duplicated_pins(ModuleManager
       VTR_ASSERT(src_grid_port.get_width() == sink_sb_port.get_width());
       
       /* Create a net for each pin */
-      for (size_t pin_id = 0; pin_id < src_grid_port.pins().size(); ++pin_id) {
-        ModuleNetId net = create_module_source_pin_net(module_manager, top_module, src_grid_module, src_grid_instance, src_grid_port_id, src_grid_port.pins()[pin_id]);
-        /* Configure the net sink */
-        module_manager.add_module_net_sink(top_module, net, sink_sb_module, sink_sb_instance, sink_sb_port_id, sink_sb_port.pins()[pin_id]);
-      }
+      module_manager.add_module_port_nets(top_module,
+                                          src_grid_module, src_grid_instance, src_grid_port_id, src_grid_port.pins(),
+                                          sink_sb_module, sink_sb_instance, sink_sb_port_id, sink_sb_port.pins());
     } 
   }
 }
@@ -420,11 +416,9 @@ void add_top_module_nets_connect_grids_and_cb(ModuleManager& module_manager,
       VTR_ASSERT(src_cb_port.get_width() == sink_grid_port.get_width());
       
       /* Create a net for each pin */
-      for (size_t pin_id = 0; pin_id < src_cb_port.pins().size(); ++pin_id) {
-        ModuleNetId net = create_module_source_pin_net(module_manager, top_module, src_cb_module, src_cb_instance, src_cb_port_id, src_cb_port.pins()[pin_id]);
-        /* Configure the net sink */
-        module_manager.add_module_net_sink(top_module, net, sink_grid_module, sink_grid_instance, sink_grid_port_id, sink_grid_port.pins()[pin_id]);
-      }
+      module_manager.add_module_port_nets(top_module,
+                                          src_cb_module, src_cb_instance, src_cb_port_id, src_cb_port.pins(),
+                                          sink_grid_module, sink_grid_instance, sink_grid_port_id, sink_grid_port.pins());
     }
   }
 }
@@ -2,7 +2,13 @@
  * This file includes functions that are used to organize memories 
  * in the top module of FPGA fabric
  *******************************************************************/
+#include <algorithm>
 #include <cmath>
+#include <iterator>
+#include <map>
+#include <numeric>
+#include <string>
+#include <unordered_map>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -176,6 +182,180 @@ void organize_top_module_tile_memory_modules(ModuleManager& module_manager,
   }
 }
 
+/********************************************************************
+ * Manhattan distance between two tiles, which is the length 
+ * of the configuration wires between them
+ *******************************************************************/
+static 
+size_t tile_manhattan_distance(const vtr::Point<size_t>& a, const vtr::Point<size_t>& b) {
+  return std::max(a.x(), b.x()) - std::min(a.x(), b.x())
+       + std::max(a.y(), b.y()) - std::min(a.y(), b.y());
+}
+
+/********************************************************************
+ * Total length of the configuration wires along a sequence of tiles
+ *******************************************************************/
+static 
+size_t tile_order_wirelength(const std::vector<vtr::Point<size_t>>& tile_coords,
+                             const std::vector<size_t>& tile_order) {
+  size_t wirelength = 0;
+  for (size_t itile = 1; itile < tile_order.size(); ++itile) {
+    wirelength += tile_manhattan_distance(tile_coords[tile_order[itile - 1]], tile_coords[tile_order[itile]]);
+  }
+  return wirelength;
+}
+
+/********************************************************************
+ * Find a sequence of tiles with a short configuration wirelength
+ * The first tile, i.e., the head of the configuration chain, is kept.
+ *  - A nearest-neighbor chain is built first, where the unvisited tiles
+ *    are indexed by rows to find the nearest one quickly
+ *  - The chain is then improved by reversing its segments (2-opt),
+ *    which removes most of the crossings. Only short segments are considered
+ *    so that the runtime remains linear in the number of tiles
+ *******************************************************************/
+static 
+std::vector<size_t> find_short_tile_order(const std::vector<vtr::Point<size_t>>& tile_coords) {
+  std::vector<size_t> tile_order;
+  tile_order.reserve(tile_coords.size());
+  if (tile_coords.empty()) {
+    return tile_order;
+  }
+
+  /* Unvisited tiles in each row, sorted by their x coordinates */
+  size_t num_rows = 0;
+  for (const vtr::Point<size_t>& coord : tile_coords) {
+    num_rows = std::max(num_rows, coord.y() + 1);
+  }
+  std::vector<std::map<size_t, size_t>> unvisited_rows(num_rows);
+  for (size_t itile = 1; itile < tile_coords.size(); ++itile) {
+    unvisited_rows[tile_coords[itile].y()].emplace(tile_coords[itile].x(), itile);
+  }
+
+  tile_order.push_back(0);
+  for (size_t istep = 1; istep < tile_coords.size(); ++istep) {
+    const vtr::Point<size_t>& curr = tile_coords[tile_order.back()];
+    size_t best_tile = size_t(-1);
+    size_t best_distance = size_t(-1);
+    /* Search the rows from the closest ones, until they are farther than the best tile */
+    for (size_t dy = 0; dy < num_rows && dy < best_distance; ++dy) {
+      for (const int& dir : {-1, 1}) {
+        if ( (0 == dy) && (1 == dir) ) {
+          continue;
+        }
+        if ( (-1 == dir) && (dy > curr.y()) ) {
+          continue;
+        }
+        size_t row = (-1 == dir) ? curr.y() - dy : curr.y() + dy;
+        if (row >= num_rows) {
+          continue;
+        }
+        const std::map<size_t, size_t>& unvisited = unvisited_rows[row];
+        auto right = unvisited.lower_bound(curr.x());
+        if (right != unvisited.end()) {
+          size_t distance = dy + right->first - curr.x();
+          if (distance < best_distance) {
+            best_distance = distance;
+            best_tile = right->second;
+          }
+        }
+        if (right != unvisited.begin()) {
+          auto left = std::prev(right);
+          size_t distance = dy + curr.x() - left->first;
+          if (distance < best_distance) {
+            best_distance = distance;
+            best_tile = left->second;
+          }
+        }
+      }
+    }
+    VTR_ASSERT(size_t(-1) != best_tile);
+    unvisited_rows[tile_coords[best_tile].y()].erase(tile_coords[best_tile].x());
+    tile_order.push_back(best_tile);
+  }
+
+  /* Reverse a segment [i + 1, j] when it shortens the chain.
+   * The chain is open at its tail, so the last tile can be freely reversed
+   */
+  constexpr size_t MAX_SEGMENT_LENGTH = 64;
+  constexpr size_t MAX_NUM_PASSES = 8;
+  for (size_t ipass = 0; ipass < MAX_NUM_PASSES; ++ipass) {
+    bool improved = false;
+    for (size_t i = 0; i + 2 < tile_order.size(); ++i) {
+      for (size_t j = i + 2; j < std::min(tile_order.size(), i + 2 + MAX_SEGMENT_LENGTH); ++j) {
+        const vtr::Point<size_t>& a = tile_coords[tile_order[i]];
+        const vtr::Point<size_t>& b = tile_coords[tile_order[i + 1]];
+        const vtr::Point<size_t>& c = tile_coords[tile_order[j]];
+        size_t curr_length = tile_manhattan_distance(a, b);
+        size_t new_length = tile_manhattan_distance(a, c);
+        if (j + 1 < tile_order.size()) {
+          const vtr::Point<size_t>& d = tile_coords[tile_order[j + 1]];
+          curr_length += tile_manhattan_distance(c, d);
+          new_length += tile_manhattan_distance(b, d);
+        }
+        if (new_length < curr_length) {
+          std::reverse(tile_order.begin() + i + 1, tile_order.begin() + j + 1);
+          improved = true;
+        }
+      }
+    }
+    if (false == improved) {
+      break;
+    }
+  }
+
+  return tile_order;
+}
+
+/********************************************************************
+ * Reorder the tiles in the chain of configurable children of the top module,
+ * so that the configuration wires between consecutive tiles are short.
+ * The configurable children of a tile are kept together and in the same sequence,
+ * i.e., SB, CBX, CBY and then the grid, as organized by the routine.
+ * The order is changed only when it is shorter than the routine one.
+ *
+ * Note:
+ *   - tile_first_children[i] is the index of the first configurable child of the i-th tile
+ *******************************************************************/
+static 
+void optimize_top_module_tile_configuration_order(ModuleManager& module_manager,
+                                                  const ModuleId& top_module,
+                                                  const std::vector<vtr::Point<size_t>>& tile_coords,
+                                                  const std::vector<size_t>& tile_first_children) {
+  std::vector<size_t> routine_order(tile_coords.size());
+  std::iota(routine_order.begin(), routine_order.end(), 0);
+  size_t routine_wirelength = tile_order_wirelength(tile_coords, routine_order);
+
+  std::vector<size_t> tile_order = find_short_tile_order(tile_coords);
+  size_t wirelength = tile_order_wirelength(tile_coords, tile_order);
+
+  if (wirelength >= routine_wirelength) {
+    VTR_LOG("Keep the routine configuration order of %lu tiles (wirelength: %lu)\n",
+            tile_coords.size(), routine_wirelength);
+    return;
+  }
+
+  VTR_LOG("Optimized the configuration order of %lu tiles (wirelength: %lu -> %lu)\n",
+          tile_coords.size(), routine_wirelength, wirelength);
+
+  /* Cache the configurable children and their instances */
+  std::vector<ModuleId> orig_configurable_children = module_manager.configurable_children(top_module);
+  std::vector<size_t> orig_configurable_child_instances = module_manager.configurable_child_instances(top_module);
+
+  /* Reorganize the configurable children */
+  module_manager.clear_configurable_children(top_module);
+  module_manager.reserve_configurable_child(top_module, orig_configurable_children.size());
+
+  for (const size_t& itile : tile_order) {
+    size_t last_child = (itile + 1 < tile_first_children.size()) ? tile_first_children[itile + 1] : orig_configurable_children.size();
+    for (size_t ichild = tile_first_children[itile]; ichild < last_child; ++ichild) {
+      module_manager.add_configurable_child(top_module,
+                                            orig_configurable_children[ichild],
+                                            orig_configurable_child_instances[ichild]);
+    }
+  }
+}
+
 /********************************************************************
  * Organize the list of memory modules and instances
  * This function will record all the sub modules of the top-level module
@@ -256,6 +436,10 @@ void organize_top_module_tile_memory_modules(ModuleManager& module_manager,
  *     In such case, the sequence will be respected.
  *     The missing block will just be skipped when organizing the configuration memories.
  *
+ * When optimize_config_order is enabled, the tiles are then reordered
+ * (starting from the same head) to shorten the configuration wires between them,
+ * with the memories inside each tile still in the sequence above
+ *
  *       Tile
  *     +---------------+----------+
  *   <-+---------------+ +        |
@@ -280,11 +464,29 @@ void organize_top_module_memory_modules(ModuleManager& module_manager,
                                         const DeviceRRGSB& device_rr_gsb,
                                         const vtr::Matrix<size_t>& sb_instance_ids,
                                         const std::map<t_rr_type, vtr::Matrix<size_t>>& cb_instance_ids,
-                                        const bool& compact_routing_hierarchy) {
+                                        const bool& compact_routing_hierarchy,
+                                        const bool& optimize_config_order) {
 
   /* Ensure clean vectors to return */
   VTR_ASSERT(true == module_manager.configurable_children(top_module).empty());
 
+  /* Tiles which have configurable children, and the first child of each tile */
+  std::vector<vtr::Point<size_t>> tile_coords;
+  std::vector<size_t> tile_first_children;
+  auto add_tile = [&](const vtr::Point<size_t>& tile_coord, const e_side& tile_border_side) {
+    size_t first_child = module_manager.configurable_children(top_module).size();
+    organize_top_module_tile_memory_modules(module_manager, top_module, 
+                                            circuit_lib, sram_orgz_type, sram_model,
+                                            grids, grid_instance_ids,
+                                            device_rr_gsb, sb_instance_ids, cb_instance_ids,
+                                            compact_routing_hierarchy,
+                                            tile_coord, tile_border_side);
+    if (first_child < module_manager.configurable_children(top_module).size()) {
+      tile_coords.push_back(tile_coord);
+      tile_first_children.push_back(first_child);
+    }
+  };
+
   /* First, organize the I/O tiles on the border */
   /* Special for the I/O tileas on RIGHT and BOTTOM,
    * which are only I/O blocks, which do NOT contain CBs and SBs 
@@ -331,12 +533,7 @@ void organize_top_module_memory_modules(ModuleManager& module_manager,
   for (const e_side& io_side : io_sides) {
     for (const vtr::Point<size_t>& io_coord : io_coords[io_side]) {
       /* Identify the GSB that surrounds the grid */
-      organize_top_module_tile_memory_modules(module_manager, top_module, 
-                                              circuit_lib, sram_orgz_type, sram_model,
-                                              grids, grid_instance_ids,
-                                              device_rr_gsb, sb_instance_ids, cb_instance_ids,
-                                              compact_routing_hierarchy,
-                                              io_coord, io_side);
+      add_tile(io_coord, io_side);
     }
   }
 
@@ -361,12 +558,12 @@ void organize_top_module_memory_modules(ModuleManager& module_manager,
   }
 
   for (const vtr::Point<size_t>& core_coord : core_coords) {
-    organize_top_module_tile_memory_modules(module_manager, top_module,  
-                                            circuit_lib, sram_orgz_type, sram_model, 
-                                            grids, grid_instance_ids,
-                                            device_rr_gsb, sb_instance_ids, cb_instance_ids,
-                                            compact_routing_hierarchy,
-                                            core_coord, NUM_SIDES);
+    add_tile(core_coord, NUM_SIDES);
+  }
+
+  if (true == optimize_config_order) {
+    optimize_top_module_tile_configuration_order(module_manager, top_module,
+                                                 tile_coords, tile_first_children);
   }
 }
 
@@ -405,6 +602,28 @@ void shuffle_top_module_configurable_children(ModuleManager& module_manager,
   }
 }
 
+/********************************************************************
+ * Build a fast look-up from the instance names of the child modules
+ * under a parent module to the child modules and their instance ids
+ * When an instance name is used more than once, the first instance is kept,
+ * which is the one found by searching the child modules in order
+ ********************************************************************/
+static 
+std::unordered_map<std::string, std::pair<ModuleId, size_t>> build_module_instance_name_lookup(const ModuleManager& module_manager,
+                                                                                               const ModuleId& parent) {
+  std::unordered_map<std::string, std::pair<ModuleId, size_t>> instance_lookup;
+  for (const ModuleId& child : module_manager.child_modules(parent)) {
+    for (const size_t& child_instance : module_manager.child_module_instances(parent, child)) {
+      const std::string& instance_name = module_manager.instance_name(parent, child, child_instance);
+      if (true == instance_name.empty()) {
+        continue;
+      }
+      instance_lookup.emplace(instance_name, std::make_pair(child, child_instance));
+    }
+  }
+  return instance_lookup;
+}
+
 /********************************************************************
  * Load configurable children from a fabric key to top-level module
  *
@@ -421,6 +640,11 @@ int load_top_module_memory_modules_from_fabric_key(ModuleManager& module_manager
   /* Ensure a clean start */
   module_manager.clear_configurable_children(top_module);
 
+  module_manager.reserve_configurable_child(top_module, fabric_key.keys().size());
+
+  /* Aliases are resolved by a one-time look-up, instead of searching the instances for each key */
+  std::unordered_map<std::string, std::pair<ModuleId, size_t>> instance_lookup = build_module_instance_name_lookup(module_manager, top_module);
+
   for (const FabricKeyId& key : fabric_key.keys()) {
     /* Find if instance id is valid */
     std::pair<ModuleId, size_t> instance_info(ModuleId::INVALID(), 0);
@@ -429,11 +653,18 @@ int load_top_module_memory_modules_from_fabric_key(ModuleManager& module_manager
       /* If we have the key, we can quickly spot instance id.
        * Otherwise, we have to exhaustively find the module id and instance id
        */
+      auto result = instance_lookup.find(fabric_key.key_alias(key));
       if (!fabric_key.key_name(key).empty()) {
         instance_info.first = module_manager.find_module(fabric_key.key_name(key));
-        instance_info.second = module_manager.instance_id(top_module, instance_info.first, fabric_key.key_alias(key));
-      } else {
-        instance_info = find_module_manager_instance_module_info(module_manager, top_module, fabric_key.key_alias(key)); 
+        if ( (result != instance_lookup.end())
+          && (result->second.first == instance_info.first) ) {
+          instance_info.second = result->second.second;
+        } else if (true == module_manager.valid_module_id(instance_info.first)) {
+          /* The alias may be used by an instance of another module first */
+          instance_info.second = module_manager.instance_id(top_module, instance_info.first, fabric_key.key_alias(key));
+        }
+      } else if (result != instance_lookup.end()) {
+        instance_info = result->second;
       }
     } else { 
       /* If we do not have an alias, we use the name and value to build the info deck */
@@ -472,6 +703,81 @@ int load_top_module_memory_modules_from_fabric_key(ModuleManager& module_manager
   return CMD_EXEC_SUCCESS;
 } 
 
+/********************************************************************
+ * Count the number of configurable memories under a module,
+ * i.e., the leaf modules in the hierarchy of configurable children
+ * The counters of modules are cached, as most modules are used many times
+ *******************************************************************/
+static 
+size_t rec_count_module_configurable_memories(const ModuleManager& module_manager,
+                                              const ModuleId& module,
+                                              std::map<ModuleId, size_t>& num_memories_cache) {
+  std::map<ModuleId, size_t>::const_iterator it = num_memories_cache.find(module);
+  if (it != num_memories_cache.end()) {
+    return it->second;
+  }
+
+  std::vector<ModuleId> configurable_children = module_manager.configurable_children(module);
+  size_t num_memories = configurable_children.empty() ? 1 : 0;
+  for (const ModuleId& child : configurable_children) {
+    num_memories += rec_count_module_configurable_memories(module_manager, child, num_memories_cache);
+  }
+
+  num_memories_cache[module] = num_memories;
+  return num_memories;
+}
+
+/********************************************************************
+ * Split the configurable children of the top module into a number of
+ * configuration regions, which are programmed in parallel
+ * The sequence of configurable children is kept, and each region is 
+ * a range of children with a similar number of configurable memories,
+ * so that the configuration chains of the regions have similar lengths
+ *
+ * Note: 
+ *   - This function should be called after the configurable children
+ *     are organized, i.e., by routine, fabric key or shuffling
+ ********************************************************************/
+int split_top_module_configurable_children_into_regions(ModuleManager& module_manager,
+                                                        const ModuleId& top_module,
+                                                        const size_t& num_regions) {
+  size_t num_children = module_manager.configurable_children(top_module).size();
+  if (num_regions > num_children) {
+    VTR_LOG_ERROR("Unable to split %lu configurable children of top module into %lu configuration regions!\n",
+                  num_children, num_regions);
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  std::map<ModuleId, size_t> num_memories_cache;
+  std::vector<size_t> child_num_memories;
+  size_t total_num_memories = 0;
+  for (const ModuleId& child : module_manager.configurable_children(top_module)) {
+    child_num_memories.push_back(rec_count_module_configurable_memories(module_manager, child, num_memories_cache));
+    total_num_memories += child_num_memories.back();
+  }
+
+  /* A new region starts when the current one reaches its share of memories,
+   * as long as there are enough children for the rest of regions
+   */
+  std::vector<size_t> region_first_children(1, 0);
+  size_t num_memories = 0;
+  for (size_t ichild = 0; ichild < num_children; ++ichild) {
+    size_t num_remaining_regions = num_regions - region_first_children.size();
+    if ( (0 < num_remaining_regions)
+      && (ichild > region_first_children.back()) 
+      && ( (num_memories * num_regions >= total_num_memories * region_first_children.size())
+        || (num_children - ichild == num_remaining_regions) ) ) {
+      region_first_children.push_back(ichild);
+    }
+    num_memories += child_num_memories[ichild];
+  }
+  VTR_ASSERT(num_regions == region_first_children.size());
+
+  module_manager.set_config_regions(top_module, region_first_children);
+
+  return CMD_EXEC_SUCCESS;
+}
+
 /********************************************************************
  * Add a list of ports that are used for SRAM configuration to the FPGA 
  * top-level module
@@ -482,13 +788,15 @@ int load_top_module_memory_modules_from_fabric_key(ModuleManager& module_manager
  * 2. Scan-chain Flip-flops:
  *    two ports will be added, which are the head of scan-chain 
  *    and the tail of scan-chain
- *    IMPORTANT: the port size will be forced to 1 in this case 
- *               because the head and tail are both 1-bit ports!!!
+ *    IMPORTANT: the port size will be forced to the number of configuration regions
+ *               because the head and tail are both 1-bit ports in each region!!!
  * 3. Memory decoders:
  *    - An enable signal
  *    - A BL address port
  *    - A WL address port
  *    - A data-in port for the BL decoder
+ *    When each WL address writes a word (word_write), the BL address port 
+ *    is not added and the data-in port is as wide as the number of BLs
  * 4. Frame-based memory:
  *    - An Enable signal
  *    - An address port, whose size depends on the number of config bits 
@@ -500,6 +808,7 @@ void add_top_module_sram_ports(ModuleManager& module_manager,
                                const CircuitLibrary& circuit_lib,
                                const CircuitModelId& sram_model,
                                const e_config_protocol_type sram_orgz_type,
+                               const bool& word_write,
                                const size_t& num_config_bits) {
   std::vector<std::string> sram_port_names = generate_sram_port_names(circuit_lib, sram_model, sram_orgz_type);
   size_t sram_port_size = generate_sram_port_size(sram_orgz_type, num_config_bits); 
@@ -518,15 +827,22 @@ void add_top_module_sram_ports(ModuleManager& module_manager,
     BasicPort en_port(std::string(DECODER_ENABLE_PORT_NAME), 1);
     module_manager.add_port(module_id, en_port, ModuleManager::MODULE_INPUT_PORT);
 
-    size_t bl_addr_size = find_memory_decoder_addr_size(num_config_bits);
-    BasicPort bl_addr_port(std::string(DECODER_BL_ADDRESS_PORT_NAME), bl_addr_size);
-    module_manager.add_port(module_id, bl_addr_port, ModuleManager::MODULE_INPUT_PORT);
+    if (false == word_write) {
+      size_t bl_addr_size = find_memory_decoder_addr_size(num_config_bits);
+      BasicPort bl_addr_port(std::string(DECODER_BL_ADDRESS_PORT_NAME), bl_addr_size);
+      module_manager.add_port(module_id, bl_addr_port, ModuleManager::MODULE_INPUT_PORT);
+    }
 
     size_t wl_addr_size = find_memory_decoder_addr_size(num_config_bits);
     BasicPort wl_addr_port(std::string(DECODER_WL_ADDRESS_PORT_NAME), wl_addr_size);
     module_manager.add_port(module_id, wl_addr_port, ModuleManager::MODULE_INPUT_PORT);
 
-    BasicPort din_port(std::string(DECODER_DATA_IN_PORT_NAME), 1);
+    /* A word of BLs is loaded at once, which drives the BLs directly */
+    size_t din_size = 1;
+    if (true == word_write) {
+      din_size = find_memory_decoder_data_size(num_config_bits);
+    }
+    BasicPort din_port(std::string(DECODER_DATA_IN_PORT_NAME), din_size);
     module_manager.add_port(module_id, din_port, ModuleManager::MODULE_INPUT_PORT);
 
     break;
@@ -539,8 +855,10 @@ void add_top_module_sram_ports(ModuleManager& module_manager,
     VTR_ASSERT(2 == sram_port_names.size());
     size_t port_counter = 0;
     for (const std::string& sram_port_name : sram_port_names) {
-      /* Add generated ports to the ModuleManager */
-      BasicPort sram_port(sram_port_name, sram_port_size);
+      /* Add generated ports to the ModuleManager
+       * Each configuration region has its own head and tail
+       */
+      BasicPort sram_port(sram_port_name, sram_port_size * module_manager.num_config_regions(module_id));
       if (0 == port_counter) { 
         module_manager.add_port(module_id, sram_port, ModuleManager::MODULE_INPUT_PORT);
       } else {
@@ -614,11 +932,17 @@ void add_top_module_sram_ports(ModuleManager& module_manager,
  *  data_in ---->|         |  WL[0]          WL[1]              WL[i]
  *               +---------+
  *
+ * When a word is written at each WL address (word_write), 
+ * there is no BL decoder and no BL address port.
+ * Instead, the data-in port is as wide as the number of BLs, 
+ * and its bit i drives BL[i] directly
+ *
  **********************************************************************/
 static 
 void add_top_module_nets_cmos_memory_bank_config_bus(ModuleManager& module_manager,
                                                      DecoderLibrary& decoder_lib,
                                                      const ModuleId& top_module,
+                                                     const bool& word_write,
                                                      const size_t& num_config_bits) {
   /* Find Enable port from the top-level module */ 
   ModulePortId en_port = module_manager.find_module_port(top_module, std::string(DECODER_ENABLE_PORT_NAME));
@@ -628,45 +952,82 @@ void add_top_module_nets_cmos_memory_bank_config_bus(ModuleManager& module_manag
   ModulePortId din_port = module_manager.find_module_port(top_module, std::string(DECODER_DATA_IN_PORT_NAME));
   BasicPort din_port_info = module_manager.module_port(top_module, din_port);
 
-  /* Find BL and WL address port from the top-level module */ 
-  ModulePortId bl_addr_port = module_manager.find_module_port(top_module, std::string(DECODER_BL_ADDRESS_PORT_NAME));
-  BasicPort bl_addr_port_info = module_manager.module_port(top_module, bl_addr_port);
-
+  /* Find WL address port from the top-level module */ 
   ModulePortId wl_addr_port = module_manager.find_module_port(top_module, std::string(DECODER_WL_ADDRESS_PORT_NAME));
   BasicPort wl_addr_port_info = module_manager.module_port(top_module, wl_addr_port);
 
   /* Find the number of BLs and WLs required to access each memory bit */
-  size_t bl_addr_size = bl_addr_port_info.get_width();
   size_t wl_addr_size = wl_addr_port_info.get_width();
   size_t num_bls = find_memory_decoder_data_size(num_config_bits);
   size_t num_wls = find_memory_decoder_data_size(num_config_bits);
-  
-  /* Add the BL decoder module 
-   * Search the decoder library
-   * If we find one, we use the module.
-   * Otherwise, we create one and add it to the decoder library
-   */
-  DecoderId bl_decoder_id = decoder_lib.find_decoder(bl_addr_size, num_bls,
-                                                     true, true, false);
-  if (DecoderId::INVALID() == bl_decoder_id) {
-    bl_decoder_id = decoder_lib.add_decoder(bl_addr_size, num_bls, true, true, false);
-  }
-  VTR_ASSERT(DecoderId::INVALID() != bl_decoder_id);
 
-  /* Create a module if not existed yet */
-  std::string bl_decoder_module_name = generate_memory_decoder_with_data_in_subckt_name(bl_addr_size, num_bls);
-  ModuleId bl_decoder_module = module_manager.find_module(bl_decoder_module_name);
-  if (ModuleId::INVALID() == bl_decoder_module) {
-    /* BL decoder has the same ports as the frame-based decoders
-     * We reuse it here
+  /* The BLs are driven by the BL decoder, 
+   * or directly by the data-in port when a word is written at each WL address
+   */
+  ModuleId bl_src_module = top_module;
+  ModulePortId bl_src_port = din_port;
+  VTR_ASSERT( (false == word_write) || (num_bls == din_port_info.get_width()) );
+
+  ModuleId bl_decoder_module = ModuleId::INVALID();
+  if (false == word_write) {
+    /* Find BL address port from the top-level module */ 
+    ModulePortId bl_addr_port = module_manager.find_module_port(top_module, std::string(DECODER_BL_ADDRESS_PORT_NAME));
+    BasicPort bl_addr_port_info = module_manager.module_port(top_module, bl_addr_port);
+    size_t bl_addr_size = bl_addr_port_info.get_width();
+
+    /* Add the BL decoder module 
+     * Search the decoder library
+     * If we find one, we use the module.
+     * Otherwise, we create one and add it to the decoder library
      */
-    bl_decoder_module = build_bl_memory_decoder_module(module_manager,
-                                                       decoder_lib,
-                                                       bl_decoder_id);
+    DecoderId bl_decoder_id = decoder_lib.find_decoder(bl_addr_size, num_bls,
+                                                       true, true, false);
+    if (DecoderId::INVALID() == bl_decoder_id) {
+      bl_decoder_id = decoder_lib.add_decoder(bl_addr_size, num_bls, true, true, false);
+    }
+    VTR_ASSERT(DecoderId::INVALID() != bl_decoder_id);
+
+    /* Create a module if not existed yet */
+    std::string bl_decoder_module_name = generate_memory_decoder_with_data_in_subckt_name(bl_addr_size, num_bls);
+    bl_decoder_module = module_manager.find_module(bl_decoder_module_name);
+    if (ModuleId::INVALID() == bl_decoder_module) {
+      /* BL decoder has the same ports as the frame-based decoders
+       * We reuse it here
+       */
+      bl_decoder_module = build_bl_memory_decoder_module(module_manager,
+                                                         decoder_lib,
+                                                         bl_decoder_id);
+    }
+    VTR_ASSERT(ModuleId::INVALID() != bl_decoder_module);
+    VTR_ASSERT(0 == module_manager.num_instance(top_module, bl_decoder_module));
+    module_manager.add_child_module(top_module, bl_decoder_module);
+
+    /* Add module nets from the top module to BL decoder's inputs */
+    ModulePortId bl_decoder_en_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_ENABLE_PORT_NAME));
+    ModulePortId bl_decoder_addr_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
+    ModulePortId bl_decoder_din_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_DATA_IN_PORT_NAME));
+
+    /* Top module Enable port -> BL Decoder Enable port */
+    add_module_bus_nets(module_manager,
+                        top_module,
+                        top_module, 0, en_port,
+                        bl_decoder_module, 0, bl_decoder_en_port);
+
+    /* Top module Address port -> BL Decoder Address port */
+    add_module_bus_nets(module_manager,
+                        top_module,
+                        top_module, 0, bl_addr_port,
+                        bl_decoder_module, 0, bl_decoder_addr_port);
+
+    /* Top module data_in port -> BL Decoder data_in port */
+    add_module_bus_nets(module_manager,
+                        top_module,
+                        top_module, 0, din_port,
+                        bl_decoder_module, 0, bl_decoder_din_port);
+
+    bl_src_module = bl_decoder_module;
+    bl_src_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
   }
-  VTR_ASSERT(ModuleId::INVALID() != bl_decoder_module);
-  VTR_ASSERT(0 == module_manager.num_instance(top_module, bl_decoder_module));
-  module_manager.add_child_module(top_module, bl_decoder_module);
 
   /* Add the WL decoder module 
    * Search the decoder library
@@ -695,40 +1056,9 @@ void add_top_module_nets_cmos_memory_bank_config_bus(ModuleManager& module_manag
   VTR_ASSERT(0 == module_manager.num_instance(top_module, wl_decoder_module));
   module_manager.add_child_module(top_module, wl_decoder_module);
 
-  /* Add module nets from the top module to BL decoder's inputs */
-  ModulePortId bl_decoder_en_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_ENABLE_PORT_NAME));
-  BasicPort bl_decoder_en_port_info = module_manager.module_port(bl_decoder_module, bl_decoder_en_port);
-
-  ModulePortId bl_decoder_addr_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
-  BasicPort bl_decoder_addr_port_info = module_manager.module_port(bl_decoder_module, bl_decoder_addr_port);
-
-  ModulePortId bl_decoder_din_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_DATA_IN_PORT_NAME));
-  BasicPort bl_decoder_din_port_info = module_manager.module_port(bl_decoder_module, bl_decoder_din_port);
-
-  /* Top module Enable port -> BL Decoder Enable port */
-  add_module_bus_nets(module_manager,
-                      top_module,
-                      top_module, 0, en_port,
-                      bl_decoder_module, 0, bl_decoder_en_port);
-
-  /* Top module Address port -> BL Decoder Address port */
-  add_module_bus_nets(module_manager,
-                      top_module,
-                      top_module, 0, bl_addr_port,
-                      bl_decoder_module, 0, bl_decoder_addr_port);
-
-  /* Top module data_in port -> BL Decoder data_in port */
-  add_module_bus_nets(module_manager,
-                      top_module,
-                      top_module, 0, din_port,
-                      bl_decoder_module, 0, bl_decoder_din_port);
-
   /* Add module nets from the top module to WL decoder's inputs */
   ModulePortId wl_decoder_en_port = module_manager.find_module_port(wl_decoder_module, std::string(DECODER_ENABLE_PORT_NAME));
-  BasicPort wl_decoder_en_port_info = module_manager.module_port(wl_decoder_module, wl_decoder_en_port);
-
   ModulePortId wl_decoder_addr_port = module_manager.find_module_port(wl_decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
-  BasicPort wl_decoder_addr_port_info = module_manager.module_port(wl_decoder_module, bl_decoder_addr_port);
 
   /* Top module Enable port -> WL Decoder Enable port */
   add_module_bus_nets(module_manager,
@@ -745,8 +1075,7 @@ void add_top_module_nets_cmos_memory_bank_config_bus(ModuleManager& module_manag
   /* Add nets from BL data out to each configurable child */
   size_t cur_bl_index = 0;
 
-  ModulePortId bl_decoder_dout_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
-  BasicPort bl_decoder_dout_port_info = module_manager.module_port(bl_decoder_module, bl_decoder_dout_port);
+  BasicPort bl_src_port_info = module_manager.module_port(bl_src_module, bl_src_port);
 
   for (size_t child_id = 0; child_id < module_manager.configurable_children(top_module).size(); ++child_id) {
     ModuleId child_module = module_manager.configurable_children(top_module)[child_id];
@@ -764,9 +1093,9 @@ void add_top_module_nets_cmos_memory_bank_config_bus(ModuleManager& module_manag
 
       /* Create net */
       ModuleNetId net = create_module_source_pin_net(module_manager, top_module,
-                                                     bl_decoder_module, 0,
-                                                     bl_decoder_dout_port,
-                                                     bl_decoder_dout_port_info.pins()[bl_pin_id]);
+                                                     bl_src_module, 0,
+                                                     bl_src_port,
+                                                     bl_src_port_info.pins()[bl_pin_id]);
       VTR_ASSERT(ModuleNetId::INVALID() != net);
 
       /* Add net sink */
@@ -817,7 +1146,9 @@ void add_top_module_nets_cmos_memory_bank_config_bus(ModuleManager& module_manag
   /* Add the BL and WL decoders to the end of configurable children list
    * Note: this MUST be done after adding all the module nets to other regular configurable children
    */
-  module_manager.add_configurable_child(top_module, bl_decoder_module, 0);
+  if (ModuleId::INVALID() != bl_decoder_module) {
+    module_manager.add_configurable_child(top_module, bl_decoder_module, 0);
+  }
   module_manager.add_configurable_child(top_module, wl_decoder_module, 0);
 }
 
@@ -870,6 +1201,7 @@ void add_top_module_nets_cmos_memory_config_bus(ModuleManager& module_manager,
                                                 DecoderLibrary& decoder_lib,
                                                 const ModuleId& parent_module,
                                                 const e_config_protocol_type& sram_orgz_type,
+                                                const bool& word_write,
                                                 const size_t& num_config_bits) {
   switch (sram_orgz_type) {
   case CONFIG_MEM_STANDALONE:
@@ -883,7 +1215,7 @@ void add_top_module_nets_cmos_memory_config_bus(ModuleManager& module_manager,
     break;
   }
   case CONFIG_MEM_MEMORY_BANK:
-    add_top_module_nets_cmos_memory_bank_config_bus(module_manager, decoder_lib, parent_module, num_config_bits);
+    add_top_module_nets_cmos_memory_bank_config_bus(module_manager, decoder_lib, parent_module, word_write, num_config_bits);
     break;
   case CONFIG_MEM_FRAME_BASED:
     add_module_nets_cmos_memory_frame_config_bus(module_manager, decoder_lib, parent_module);
@@ -931,6 +1263,7 @@ void add_top_module_nets_memory_config_bus(ModuleManager& module_manager,
                                            DecoderLibrary& decoder_lib,
                                            const ModuleId& parent_module,
                                            const e_config_protocol_type& sram_orgz_type, 
+                                           const bool& word_write,
                                            const e_circuit_model_design_tech& mem_tech,
                                            const size_t& num_config_bits) {
 
@@ -941,6 +1274,7 @@ void add_top_module_nets_memory_config_bus(ModuleManager& module_manager,
     add_top_module_nets_cmos_memory_config_bus(module_manager, decoder_lib,
                                                parent_module, 
                                                sram_orgz_type,
+                                               word_write,
                                                num_config_bits);
     break;
   case CIRCUIT_MODEL_DESIGN_RRAM:
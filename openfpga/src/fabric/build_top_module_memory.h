@@ -33,7 +33,8 @@ void organize_top_module_memory_modules(ModuleManager& module_manager,
                                         const DeviceRRGSB& device_rr_gsb,
                                         const vtr::Matrix<size_t>& sb_instance_ids,
                                         const std::map<t_rr_type, vtr::Matrix<size_t>>& cb_instance_ids,
-                                        const bool& compact_routing_hierarchy);
+                                        const bool& compact_routing_hierarchy,
+                                        const bool& optimize_config_order);
 
 void shuffle_top_module_configurable_children(ModuleManager& module_manager, 
                                               const ModuleId& top_module);
@@ -42,17 +43,23 @@ int load_top_module_memory_modules_from_fabric_key(ModuleManager& module_manager
                                                    const ModuleId& top_module,
                                                    const FabricKey& fabric_key); 
 
+int split_top_module_configurable_children_into_regions(ModuleManager& module_manager,
+                                                        const ModuleId& top_module,
+                                                        const size_t& num_regions);
+
 void add_top_module_sram_ports(ModuleManager& module_manager, 
                                const ModuleId& module_id,
                                const CircuitLibrary& circuit_lib,
                                const CircuitModelId& sram_model,
                                const e_config_protocol_type sram_orgz_type,
+                               const bool& word_write,
                                const size_t& num_config_bits);
 
 void add_top_module_nets_memory_config_bus(ModuleManager& module_manager,
                                            DecoderLibrary& decoder_lib,
                                            const ModuleId& parent_module,
                                            const e_config_protocol_type& sram_orgz_type, 
+                                           const bool& word_write,
                                            const e_circuit_model_design_tech& mem_tech,
                                            const size_t& num_config_bits);
 
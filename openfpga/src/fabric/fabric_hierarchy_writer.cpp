@@ -5,6 +5,7 @@
 #include "vtr_log.h"
 #include "vtr_assert.h"
 #include "vtr_time.h"
+#include "vtr_vector.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
@@ -21,6 +22,17 @@ namespace openfpga {
  * We use Depth-First Search (DFS) here so that we can output a tree down to leaf first
  * Add space (indent) based on the depth in hierarchy
  * e.g. depth = 1 means a space as indent
+ *
+ * When unique modules are folded, the subtree of a module is output only once,
+ * with the module name as a YAML anchor, and is referred to by a YAML alias
+ * at the other places where the module is found, e.g.,
+ *   - grid_clb: &grid_clb
+ *     - logical_tile_clb_mode_clb_:
+ *     ...
+ *   - grid_clb: *grid_clb
+ * as long as the output subtree is as deep as the one to be output here.
+ * folded_levels[module] is the number of levels of the subtree output for a module,
+ * or 0 if it has not been output yet
  ***************************************************************************************/
 static 
 int rec_output_module_hierarchy_to_text_file(std::fstream& fp,
@@ -28,6 +40,8 @@ int rec_output_module_hierarchy_to_text_file(std::fstream& fp,
                                              const size_t& current_hie_depth,
                                              const ModuleManager& module_manager,  
                                              const ModuleId& parent_module,
+                                             const bool& fold_unique_modules,
+                                             vtr::vector<ModuleId, size_t>& folded_levels,
                                              const bool& verbose) {
   /* Stop if hierarchy depth is beyond the stop line */
   if (hie_depth_to_stop < current_hie_depth) {
@@ -57,9 +71,22 @@ int rec_output_module_hierarchy_to_text_file(std::fstream& fp,
     /* If this is the leaf node, we leave a new line 
      * Otherwise, we will leave a ':' to be compatible to YAML file format 
      */
-    if ( (0 != module_manager.child_modules(child_module).size())
-      && (hie_depth_to_stop >= current_hie_depth + 1) ) {
-      fp << ":";
+    if ( (0 == module_manager.child_modules(child_module).size())
+      || (hie_depth_to_stop < current_hie_depth + 1) ) {
+      fp << "\n";
+      continue;
+    }
+    fp << ":";
+
+    if (true == fold_unique_modules) {
+      /* Number of levels to output below the child module */
+      size_t num_levels = hie_depth_to_stop - current_hie_depth;
+      if (folded_levels[child_module] >= num_levels) {
+        fp << " *" << module_manager.module_name(child_module) << "\n";
+        continue;
+      }
+      fp << " &" << module_manager.module_name(child_module);
+      folded_levels[child_module] = num_levels;
     }
     fp << "\n";
 
@@ -69,6 +96,8 @@ int rec_output_module_hierarchy_to_text_file(std::fstream& fp,
                                                           current_hie_depth + 1, /* Increment the depth for the next level */
                                                           module_manager,
                                                           child_module,
+                                                          fold_unique_modules,
+                                                          folded_levels,
                                                           verbose);
     if (0 != status) {
       return status;
@@ -85,6 +114,8 @@ int rec_output_module_hierarchy_to_text_file(std::fstream& fp,
  *      <child_module_name>
  *        ...
  * This file is mainly used by hierarchical P&R flow 
+ * The subtrees of modules can be folded so that
+ * the size of the file does not grow with the number of instances
  *
  * Return 0 if successful
  * Return 1 if there are more serious bugs in the architecture 
@@ -93,6 +124,7 @@ int rec_output_module_hierarchy_to_text_file(std::fstream& fp,
 int write_fabric_hierarchy_to_text_file(const ModuleManager& module_manager,
                                         const std::string& fname,
                                         const size_t& hie_depth_to_stop,
+                                        const bool& fold_unique_modules,
                                         const bool& verbose) {
   std::string timer_message = std::string("Write fabric hierarchy to plain-text file '") + fname + std::string("'");
 
@@ -108,7 +140,7 @@ int write_fabric_hierarchy_to_text_file(const ModuleManager& module_manager,
   VTR_ASSERT(true != fname.empty());
 
   /* Create a file handler*/
-  std::fstream fp;
+  BufferedFileStream fp;
   /* Open a file */
   fp.open(fname, std::fstream::out | std::fstream::trunc);
 
@@ -135,11 +167,14 @@ int write_fabric_hierarchy_to_text_file(const ModuleManager& module_manager,
   fp << top_module_name << ":" << "\n";
 
   /* Visit child module recursively and output the hierarchy */
+  vtr::vector<ModuleId, size_t> folded_levels(module_manager.num_modules(), 0);
   int err_code = rec_output_module_hierarchy_to_text_file(fp,
                                                           hie_depth_to_stop,
                                                           hie_depth + 1, /* Start with level 1 */
                                                           module_manager,  
                                                           top_module,
+                                                          fold_unique_modules,
+                                                          folded_levels,
                                                           verbose);
 
   /* close a file */
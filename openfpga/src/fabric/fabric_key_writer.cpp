@@ -13,6 +13,7 @@
 #include "write_xml_fabric_key.h"
 
 #include "openfpga_naming.h"
+#include "module_manager_utils.h"
 
 #include "fabric_key_writer.h"
 
@@ -60,7 +61,7 @@ int write_fabric_key_to_xml_file(const ModuleManager& module_manager,
 
   /* Exclude configuration-related modules in the keys */
   if (CONFIG_MEM_MEMORY_BANK == config_protocol_type) {
-    num_keys -= 2;
+    num_keys -= find_top_module_num_memory_bank_decoders(module_manager, top_module);
   } else if (CONFIG_MEM_FRAME_BASED == config_protocol_type) {
     num_keys -= 1;
   }
@@ -6,6 +6,8 @@
 #include <algorithm>
 #include "vtr_assert.h"
 
+#include "openfpga_memory_footprint.h"
+
 #include "circuit_library.h"
 #include "module_manager.h"
 
@@ -83,18 +85,52 @@ std::vector<size_t> ModuleManager::configurable_child_instances(const ModuleId&
   return configurable_child_instances_[parent_module];
 }
 
+/* Find the number of configuration regions of a parent module */
+size_t ModuleManager::num_config_regions(const ModuleId& parent_module) const {
+  /* Validate the module_id */
+  VTR_ASSERT(valid_module_id(parent_module));
+
+  return std::max(size_t(1), config_region_first_children_[parent_module].size());
+}
+
+/* Find the indices of configurable children in a configuration region of a parent module */
+std::vector<size_t> ModuleManager::region_configurable_children(const ModuleId& parent_module,
+                                                                const size_t& region) const {
+  /* Validate the module_id and region */
+  VTR_ASSERT(valid_module_id(parent_module));
+  VTR_ASSERT(region < num_config_regions(parent_module));
+
+  const std::vector<size_t>& region_first_children = config_region_first_children_[parent_module];
+
+  size_t first_child = 0;
+  size_t last_child = configurable_children_[parent_module].size();
+  if (false == region_first_children.empty()) {
+    first_child = region_first_children[region];
+    if (region + 1 < region_first_children.size()) {
+      last_child = region_first_children[region + 1];
+    }
+  }
+
+  std::vector<size_t> region_children(last_child - first_child);
+  std::iota(region_children.begin(), region_children.end(), first_child);
+
+  return region_children;
+}
+
 /* Find the source ids of modules */
 ModuleManager::module_net_src_range ModuleManager::module_net_sources(const ModuleId& module, const ModuleNetId& net) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_net_id(module, net));
-  return vtr::make_range(net_src_ids_[module][net].begin(), net_src_ids_[module][net].end());
+  return vtr::make_range(net_src_id_sequence_.begin(), 
+                         net_src_id_sequence_.begin() + num_net_sources(module, net));
 }
 
 /* Find the sink ids of modules */
 ModuleManager::module_net_sink_range ModuleManager::module_net_sinks(const ModuleId& module, const ModuleNetId& net) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_net_id(module, net));
-  return vtr::make_range(net_sink_ids_[module][net].begin(), net_sink_ids_[module][net].end());
+  return vtr::make_range(net_sink_id_sequence_.begin(),
+                         net_sink_id_sequence_.begin() + num_net_sinks(module, net));
 }
 
 /******************************************************************************
@@ -171,15 +207,29 @@ ModulePortId ModuleManager::find_module_port(const ModuleId& module_id, const st
   /* Validate the module id */
   VTR_ASSERT(valid_module_id(module_id));
 
-  /* Iterate over the ports of the module */
-  for (const auto& port : port_ids_[module_id]) {
-    if (0 == port_name.compare(ports_[module_id][port].get_name())) {
-      /* Find it, return the id */
-      return port; 
-    }
+  return find_module_port(module_id, find_port_name_id(port_name));
+}
+
+/* Find the interned id of a port name, return invalid if no port has this name */
+ModulePortNameId ModuleManager::find_port_name_id(const std::string& port_name) const {
+  auto result = port_name_ids_.find(port_name);
+  if (result == port_name_ids_.end()) {
+    return ModulePortNameId::INVALID();
   }
-  /* Not found, return an invalid id */
-  return ModulePortId::INVALID();
+  return result->second;
+}
+
+/* Find a port of a module by the interned id of its name, return invalid if not found */
+ModulePortId ModuleManager::find_module_port(const ModuleId& module_id, const ModulePortNameId& port_name_id) const {
+  /* Validate the module id */
+  VTR_ASSERT(valid_module_id(module_id));
+
+  auto result = port_name_lookup_[module_id].find(port_name_id);
+  if (result == port_name_lookup_[module_id].end()) {
+    /* Not found, return an invalid id */
+    return ModulePortId::INVALID();
+  }
+  return result->second;
 }
 
 /* Find the Port information with a given port id */
@@ -293,6 +343,10 @@ ModuleNetId ModuleManager::module_instance_port_net(const ModuleId& parent_modul
   /* Validate child_pin */
   VTR_ASSERT(child_pin < module_port(child_module, child_port).get_width());
   
+  if (true == net_frozen_[parent_module]) {
+    return frozen_module_instance_port_net(parent_module, child_module, child_instance, child_port, child_pin);
+  }
+
   return net_lookup_[parent_module][child_module][child_instance][child_port][child_pin];
 }
 
@@ -310,9 +364,9 @@ vtr::vector<ModuleNetSrcId, ModuleId> ModuleManager::net_source_modules(const Mo
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSrcId, ModuleId> src_modules;
-  src_modules.reserve(net_src_terminal_ids_[module][net].size());
-  for (const size_t& id : net_src_terminal_ids_[module][net]) {
-    src_modules.push_back(net_terminal_storage_[id].first);
+  src_modules.reserve(num_net_sources(module, net));
+  for (const ModuleNetSrcId& net_src : module_net_sources(module, net)) {
+    src_modules.push_back(net_terminal_storage_[net_source_terminal(module, net, net_src).terminal_id].first);
   }
 
   return src_modules;
@@ -323,7 +377,13 @@ vtr::vector<ModuleNetSrcId, size_t> ModuleManager::net_source_instances(const Mo
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  return net_src_instance_ids_[module][net];
+  vtr::vector<ModuleNetSrcId, size_t> src_instances;
+  src_instances.reserve(num_net_sources(module, net));
+  for (const ModuleNetSrcId& net_src : module_net_sources(module, net)) {
+    src_instances.push_back(net_source_terminal(module, net, net_src).instance_id);
+  }
+
+  return src_instances;
 }
 
 /* Find the source ports of a net */
@@ -332,9 +392,9 @@ vtr::vector<ModuleNetSrcId, ModulePortId> ModuleManager::net_source_ports(const
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSrcId, ModulePortId> src_ports;
-  src_ports.reserve(net_src_terminal_ids_[module][net].size());
-  for (const size_t& id : net_src_terminal_ids_[module][net]) {
-    src_ports.push_back(net_terminal_storage_[id].second);
+  src_ports.reserve(num_net_sources(module, net));
+  for (const ModuleNetSrcId& net_src : module_net_sources(module, net)) {
+    src_ports.push_back(net_terminal_storage_[net_source_terminal(module, net, net_src).terminal_id].second);
   }
 
   return src_ports;
@@ -345,7 +405,13 @@ vtr::vector<ModuleNetSrcId, size_t> ModuleManager::net_source_pins(const ModuleI
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  return net_src_pin_ids_[module][net];
+  vtr::vector<ModuleNetSrcId, size_t> src_pins;
+  src_pins.reserve(num_net_sources(module, net));
+  for (const ModuleNetSrcId& net_src : module_net_sources(module, net)) {
+    src_pins.push_back(net_source_terminal(module, net, net_src).pin_id);
+  }
+
+  return src_pins;
 }
 
 /* Identify if a pin of a port in a module already exists in the net source list*/
@@ -360,10 +426,11 @@ bool ModuleManager::net_source_exist(const ModuleId& module, const ModuleNetId&
    * we can say that the source has already been added to this net!
    */
   for (const ModuleNetSrcId& net_src : module_net_sources(module, net)) {
-    if ( (src_module == net_terminal_storage_[net_src_terminal_ids_[module][net][net_src]].first) 
-      && (instance_id == net_source_instances(module, net)[net_src])   
-      && (src_port == net_terminal_storage_[net_src_terminal_ids_[module][net][net_src]].second) 
-      && (src_pin == net_source_pins(module, net)[net_src]) ) {
+    const ModuleNetTerminal& terminal = net_source_terminal(module, net, net_src);
+    if ( (src_module == net_terminal_storage_[terminal.terminal_id].first) 
+      && (instance_id == terminal.instance_id)   
+      && (src_port == net_terminal_storage_[terminal.terminal_id].second) 
+      && (src_pin == terminal.pin_id) ) {
       return true;
     }
   }
@@ -372,15 +439,35 @@ bool ModuleManager::net_source_exist(const ModuleId& module, const ModuleNetId&
   return false;
 }
 
+/* Find the source module of a given source of a net */
+ModuleId ModuleManager::net_source_module(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const {
+  return net_terminal_storage_[net_source_terminal(module, net, net_src).terminal_id].first;
+}
+
+/* Find the id of the source instance of a given source of a net */
+size_t ModuleManager::net_source_instance(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const {
+  return net_source_terminal(module, net, net_src).instance_id;
+}
+
+/* Find the source port of a given source of a net */
+ModulePortId ModuleManager::net_source_port(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const {
+  return net_terminal_storage_[net_source_terminal(module, net, net_src).terminal_id].second;
+}
+
+/* Find the source pin index of a given source of a net */
+size_t ModuleManager::net_source_pin(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const {
+  return net_source_terminal(module, net, net_src).pin_id;
+}
+
 /* Find the sink modules of a net */
 vtr::vector<ModuleNetSinkId, ModuleId> ModuleManager::net_sink_modules(const ModuleId& module, const ModuleNetId& net) const {
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSinkId, ModuleId> sink_modules;
-  sink_modules.reserve(net_sink_terminal_ids_[module][net].size());
-  for (const size_t& id : net_sink_terminal_ids_[module][net]) {
-    sink_modules.push_back(net_terminal_storage_[id].first);
+  sink_modules.reserve(num_net_sinks(module, net));
+  for (const ModuleNetSinkId& net_sink : module_net_sinks(module, net)) {
+    sink_modules.push_back(net_terminal_storage_[net_sink_terminal(module, net, net_sink).terminal_id].first);
   }
 
   return sink_modules;
@@ -391,7 +478,13 @@ vtr::vector<ModuleNetSinkId, size_t> ModuleManager::net_sink_instances(const Mod
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  return net_sink_instance_ids_[module][net];
+  vtr::vector<ModuleNetSinkId, size_t> sink_instances;
+  sink_instances.reserve(num_net_sinks(module, net));
+  for (const ModuleNetSinkId& net_sink : module_net_sinks(module, net)) {
+    sink_instances.push_back(net_sink_terminal(module, net, net_sink).instance_id);
+  }
+
+  return sink_instances;
 }
 
 /* Find the sink ports of a net */
@@ -400,9 +493,9 @@ vtr::vector<ModuleNetSinkId, ModulePortId> ModuleManager::net_sink_ports(const M
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSinkId, ModulePortId> sink_ports;
-  sink_ports.reserve(net_sink_terminal_ids_[module][net].size());
-  for (const size_t& id : net_sink_terminal_ids_[module][net]) {
-    sink_ports.push_back(net_terminal_storage_[id].second);
+  sink_ports.reserve(num_net_sinks(module, net));
+  for (const ModuleNetSinkId& net_sink : module_net_sinks(module, net)) {
+    sink_ports.push_back(net_terminal_storage_[net_sink_terminal(module, net, net_sink).terminal_id].second);
   }
 
   return sink_ports;
@@ -413,7 +506,13 @@ vtr::vector<ModuleNetSinkId, size_t> ModuleManager::net_sink_pins(const ModuleId
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  return net_sink_pin_ids_[module][net];
+  vtr::vector<ModuleNetSinkId, size_t> sink_pins;
+  sink_pins.reserve(num_net_sinks(module, net));
+  for (const ModuleNetSinkId& net_sink : module_net_sinks(module, net)) {
+    sink_pins.push_back(net_sink_terminal(module, net, net_sink).pin_id);
+  }
+
+  return sink_pins;
 }
 
 /* Identify if a pin of a port in a module already exists in the net sink list*/
@@ -428,10 +527,11 @@ bool ModuleManager::net_sink_exist(const ModuleId& module, const ModuleNetId& ne
    * we can say that the sink has already been added to this net!
    */
   for (const ModuleNetSinkId& net_sink : module_net_sinks(module, net)) {
-    if ( (sink_module == net_terminal_storage_[net_sink_terminal_ids_[module][net][net_sink]].first) 
-      && (instance_id == net_sink_instances(module, net)[net_sink])   
-      && (sink_port == net_terminal_storage_[net_sink_terminal_ids_[module][net][net_sink]].second) 
-      && (sink_pin == net_sink_pins(module, net)[net_sink]) ) {
+    const ModuleNetTerminal& terminal = net_sink_terminal(module, net, net_sink);
+    if ( (sink_module == net_terminal_storage_[terminal.terminal_id].first) 
+      && (instance_id == terminal.instance_id)   
+      && (sink_port == net_terminal_storage_[terminal.terminal_id].second) 
+      && (sink_pin == terminal.pin_id) ) {
       return true;
     }
   }
@@ -440,6 +540,78 @@ bool ModuleManager::net_sink_exist(const ModuleId& module, const ModuleNetId& ne
   return false;
 }
 
+/* Find the sink module of a given sink of a net */
+ModuleId ModuleManager::net_sink_module(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const {
+  return net_terminal_storage_[net_sink_terminal(module, net, net_sink).terminal_id].first;
+}
+
+/* Find the id of the sink instance of a given sink of a net */
+size_t ModuleManager::net_sink_instance(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const {
+  return net_sink_terminal(module, net, net_sink).instance_id;
+}
+
+/* Find the sink port of a given sink of a net */
+ModulePortId ModuleManager::net_sink_port(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const {
+  return net_terminal_storage_[net_sink_terminal(module, net, net_sink).terminal_id].second;
+}
+
+/* Find the sink pin index of a given sink of a net */
+size_t ModuleManager::net_sink_pin(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const {
+  return net_sink_terminal(module, net, net_sink).pin_id;
+}
+
+/* Identify if the nets of a module have been frozen */
+bool ModuleManager::module_nets_frozen(const ModuleId& module) const {
+  /* Validate the module_id */
+  VTR_ASSERT(valid_module_id(module));
+  return net_frozen_[module];
+}
+
+/* Estimate the memory occupied by the module graph, including the fast look-ups */
+size_t ModuleManager::memory_footprint() const {
+  size_t footprint = sizeof(ModuleManager);
+  footprint += container_footprint(ids_);
+  footprint += container_footprint(names_);
+  footprint += container_footprint(usages_);
+  footprint += container_footprint(parents_);
+  footprint += container_footprint(children_);
+  footprint += container_footprint(num_child_instances_);
+  footprint += container_footprint(child_instance_names_);
+  footprint += container_footprint(configurable_children_);
+  footprint += container_footprint(configurable_child_instances_);
+  footprint += container_footprint(config_region_first_children_);
+  footprint += container_footprint(port_ids_);
+  footprint += container_footprint(ports_);
+  footprint += container_footprint(port_types_);
+  footprint += container_footprint(port_is_wire_);
+  footprint += container_footprint(port_is_register_);
+  footprint += container_footprint(port_preproc_flags_);
+  footprint += container_footprint(port_pin_offsets_);
+  footprint += container_footprint(num_pins_);
+  footprint += container_footprint(num_nets_);
+  footprint += container_footprint(invalid_net_ids_);
+  footprint += container_footprint(net_names_);
+  footprint += container_footprint(net_srcs_);
+  footprint += container_footprint(net_sinks_);
+  footprint += container_footprint(net_frozen_);
+  footprint += container_footprint(frozen_net_src_offsets_);
+  footprint += container_footprint(frozen_net_srcs_);
+  footprint += container_footprint(frozen_net_sink_offsets_);
+  footprint += container_footprint(frozen_net_sinks_);
+  footprint += container_footprint(net_src_id_sequence_);
+  footprint += container_footprint(net_sink_id_sequence_);
+  footprint += container_footprint(name_id_map_);
+  footprint += container_footprint(port_name_ids_);
+  footprint += container_footprint(port_name_lookup_);
+  footprint += container_footprint(port_lookup_);
+  footprint += container_footprint(net_lookup_);
+  footprint += container_footprint(frozen_net_lookup_children_);
+  footprint += container_footprint(frozen_net_lookup_);
+  footprint += container_footprint(net_terminal_storage_);
+  footprint += container_footprint(net_terminal_ids_);
+  return footprint;
+}
+
 /******************************************************************************
  * Private Accessors
  ******************************************************************************/
@@ -458,6 +630,79 @@ size_t ModuleManager::find_child_module_index_in_parent_module(const ModuleId& p
   return size_t(-1);
 }
 
+/* Return the number of sources of a net */
+size_t ModuleManager::num_net_sources(const ModuleId& module, const ModuleNetId& net) const {
+  if (true == net_frozen_[module]) {
+    return frozen_net_src_offsets_[module][size_t(net) + 1] - frozen_net_src_offsets_[module][size_t(net)];
+  }
+  return net_srcs_[module][net].size();
+}
+
+/* Return the number of sinks of a net */
+size_t ModuleManager::num_net_sinks(const ModuleId& module, const ModuleNetId& net) const {
+  if (true == net_frozen_[module]) {
+    return frozen_net_sink_offsets_[module][size_t(net) + 1] - frozen_net_sink_offsets_[module][size_t(net)];
+  }
+  return net_sinks_[module][net].size();
+}
+
+/* Find a net from an instance of a frozen module through the dense look-up */
+ModuleNetId ModuleManager::frozen_module_instance_port_net(const ModuleId& parent_module, 
+                                                           const ModuleId& child_module, const size_t& child_instance,
+                                                           const ModulePortId& child_port, const size_t& child_pin) const {
+  const std::vector<ChildNetLookupRange>& children = frozen_net_lookup_children_[parent_module];
+  std::vector<ChildNetLookupRange>::const_iterator it = std::lower_bound(children.begin(), children.end(), child_module,
+                                                                         [](const ChildNetLookupRange& range, const ModuleId& id) {
+                                                                           return range.child_module < id;
+                                                                         });
+  if ( (it == children.end()) || (child_module != it->child_module) ) {
+    return ModuleNetId::INVALID();
+  }
+
+  /* Instances added after the parent is frozen have no nets */
+  if (child_instance >= it->num_instances) {
+    return ModuleNetId::INVALID();
+  }
+
+  /* Ports added to the child module after the parent is frozen have no nets */
+  size_t pin_offset = port_pin_offsets_[child_module][child_port] + child_pin;
+  if (pin_offset >= it->num_pins) {
+    return ModuleNetId::INVALID();
+  }
+
+  return frozen_net_lookup_[parent_module][it->base + child_instance * it->num_pins + pin_offset];
+}
+
+/* Return the terminal of a given source of a net, 
+ * depending on if the module is frozen or not 
+ */
+const ModuleManager::ModuleNetTerminal& ModuleManager::net_source_terminal(const ModuleId& module, const ModuleNetId& net,
+                                                                           const ModuleNetSrcId& net_src) const {
+  /* Validate module net */
+  VTR_ASSERT_SAFE(valid_module_net_id(module, net));
+  VTR_ASSERT_SAFE(size_t(net_src) < num_net_sources(module, net));
+
+  if (true == net_frozen_[module]) {
+    return frozen_net_srcs_[module][frozen_net_src_offsets_[module][size_t(net)] + size_t(net_src)];
+  }
+  return net_srcs_[module][net][size_t(net_src)];
+}
+
+/* Return the terminal of a given sink of a net, 
+ * depending on if the module is frozen or not 
+ */
+const ModuleManager::ModuleNetTerminal& ModuleManager::net_sink_terminal(const ModuleId& module, const ModuleNetId& net,
+                                                                         const ModuleNetSinkId& net_sink) const {
+  /* Validate module net */
+  VTR_ASSERT_SAFE(valid_module_net_id(module, net));
+  VTR_ASSERT_SAFE(size_t(net_sink) < num_net_sinks(module, net));
+
+  if (true == net_frozen_[module]) {
+    return frozen_net_sinks_[module][frozen_net_sink_offsets_[module][size_t(net)] + size_t(net_sink)];
+  }
+  return net_sinks_[module][net][size_t(net_sink)];
+}
+
 /******************************************************************************
  * Public Mutators
  ******************************************************************************/
@@ -482,26 +727,31 @@ ModuleId ModuleManager::add_module(const std::string& name) {
   child_instance_names_.emplace_back();
   configurable_children_.emplace_back();
   configurable_child_instances_.emplace_back();
+  config_region_first_children_.emplace_back();
 
   port_ids_.emplace_back();
   ports_.emplace_back();
+  port_name_lookup_.emplace_back();
   port_types_.emplace_back();
   port_is_wire_.emplace_back();
   port_is_register_.emplace_back();
   port_preproc_flags_.emplace_back();
+  port_pin_offsets_.emplace_back();
+  num_pins_.push_back(0);
 
   num_nets_.emplace_back(0);
   invalid_net_ids_.emplace_back();
   net_names_.emplace_back();
-  net_src_ids_.emplace_back();
-  net_src_terminal_ids_.emplace_back();
-  net_src_instance_ids_.emplace_back();
-  net_src_pin_ids_.emplace_back();
+  net_srcs_.emplace_back();
+  net_sinks_.emplace_back();
 
-  net_sink_ids_.emplace_back();
-  net_sink_terminal_ids_.emplace_back();
-  net_sink_instance_ids_.emplace_back();
-  net_sink_pin_ids_.emplace_back();
+  net_frozen_.push_back(false);
+  frozen_net_src_offsets_.emplace_back();
+  frozen_net_srcs_.emplace_back();
+  frozen_net_sink_offsets_.emplace_back();
+  frozen_net_sinks_.emplace_back();
+  frozen_net_lookup_children_.emplace_back();
+  frozen_net_lookup_.emplace_back();
 
   /* Register in the name-to-id map */
   name_id_map_[name] = module;
@@ -533,11 +783,17 @@ ModulePortId ModuleManager::add_port(const ModuleId& module,
   port_is_wire_[module].push_back(false);
   port_is_register_[module].push_back(false);
   port_preproc_flags_[module].emplace_back(); /* Create an empty string for the pre-processing flags */
+  port_pin_offsets_[module].push_back(num_pins_[module]);
+  num_pins_[module] += port_info.get_width();
 
   /* Update fast look-up for port */
   port_lookup_[module][port_type].push_back(port);
+  register_port_name(module, port);
 
-  /* Update fast look-up for nets */
+  /* Update fast look-up for nets, which is not needed for a frozen module */
+  if (true == net_frozen_[module]) {
+    return port;
+  }
   VTR_ASSERT_SAFE(1 == net_lookup_[module][module].size());
   net_lookup_[module][module][0][port].resize(port_info.get_width(), ModuleNetId::INVALID());
 
@@ -549,14 +805,73 @@ void ModuleManager::set_module_port_name(const ModuleId& module, const ModulePor
                                          const std::string& port_name) {
   /* Validate the id of module port */
   VTR_ASSERT( valid_module_port_id(module, module_port) );
+
+  /* Remove the old name from the fast look-up */
+  std::string old_port_name = ports_[module][module_port].get_name();
+  auto result = port_name_lookup_[module].find(find_port_name_id(old_port_name));
+  bool old_name_registered = (result != port_name_lookup_[module].end()) && (result->second == module_port);
+  if (true == old_name_registered) {
+    port_name_lookup_[module].erase(result);
+  }
   
   ports_[module][module_port].set_name(port_name);
+  register_port_name(module, module_port);
+
+  /* Another port with the old name, if any, is now the first port with the name */
+  if (true == old_name_registered) {
+    for (const ModulePortId& port : port_ids_[module]) {
+      if (old_port_name == ports_[module][port].get_name()) {
+        register_port_name(module, port);
+        break;
+      }
+    }
+  }
+}
+
+/* Register a port under its name in the fast look-up
+ * Port names are interned once and shared by all the modules.
+ * When ports have the same name, the first one is kept as a linear search would find it
+ */
+void ModuleManager::register_port_name(const ModuleId& module, const ModulePortId& port) {
+  const std::string& port_name = ports_[module][port].get_name();
+  auto result = port_name_ids_.find(port_name);
+  ModulePortNameId port_name_id;
+  if (result == port_name_ids_.end()) {
+    port_name_id = ModulePortNameId(port_name_ids_.size());
+    port_name_ids_[port_name] = port_name_id;
+  } else {
+    port_name_id = result->second;
+  }
+  auto inserted = port_name_lookup_[module].emplace(port_name_id, port);
+  if ( (false == inserted.second) && (size_t(port) < size_t(inserted.first->second)) ) {
+    inserted.first->second = port;
+  }
+}
+
+/* Find the index of a pair of module and port in the terminal storage
+ * If not found, add the pair
+ */
+size_t ModuleManager::find_or_add_net_terminal(const ModuleId& module, const ModulePortId& port) {
+  std::pair<ModuleId, ModulePortId> terminal(module, port);
+  auto inserted = net_terminal_ids_.emplace(terminal, net_terminal_storage_.size());
+  if (true == inserted.second) {
+    net_terminal_storage_.push_back(terminal);
+  }
+  return inserted.first->second;
 }
 
 /* Set a name for a module */
 void ModuleManager::set_module_name(const ModuleId& module, const std::string& name) {
   /* Validate the id of module */
   VTR_ASSERT( valid_module_id(module) );
+
+  /* Keep the name-to-id map in sync */
+  auto result = name_id_map_.find(names_[module]);
+  if ( (result != name_id_map_.end()) && (result->second == module) ) {
+    name_id_map_.erase(result);
+  }
+  name_id_map_[name] = module;
+
   names_[module] = name;
 }
 
@@ -618,7 +933,12 @@ void ModuleManager::add_child_module(const ModuleId& parent_module, const Module
     child_instance_names_[parent_module][child_it - children_[parent_module].begin()].emplace_back();
   }
 
-  /* Update fast look-up for nets */
+  /* Update fast look-up for nets 
+   * A frozen module can not have any new net, so the instance is left out of the dense look-up
+   */
+  if (true == net_frozen_[parent_module]) {
+    return;
+  }
   size_t instance_id = net_lookup_[parent_module][child_module].size();
   net_lookup_[parent_module][child_module].emplace_back();
   /* Find the ports for the child module and update the fast look-up */
@@ -675,21 +995,30 @@ void ModuleManager::reserve_configurable_child(const ModuleId& parent_module,
   }
 }
 
+void ModuleManager::set_config_regions(const ModuleId& module,
+                                       const std::vector<size_t>& region_first_children) {
+  VTR_ASSERT ( valid_module_id(module) );
+  /* Regions should start from the first configurable child and not be empty */
+  VTR_ASSERT ( (false == region_first_children.empty()) && (0 == region_first_children[0]) );
+  for (size_t region = 1; region < region_first_children.size(); ++region) {
+    VTR_ASSERT ( region_first_children[region - 1] < region_first_children[region] );
+  }
+  VTR_ASSERT ( region_first_children.back() < configurable_children_[module].size() );
+
+  config_region_first_children_[module] = region_first_children;
+}
+
 void ModuleManager::reserve_module_nets(const ModuleId& module,
                                         const size_t& num_nets) {
   /* Validate the module id */
   VTR_ASSERT ( valid_module_id(module) );
 
-  net_names_[module].reserve(num_nets);
-  net_src_ids_[module].reserve(num_nets);
-  net_src_terminal_ids_[module].reserve(num_nets);
-  net_src_instance_ids_[module].reserve(num_nets);
-  net_src_pin_ids_[module].reserve(num_nets);
+  /* Nets of a frozen module can not be changed */
+  VTR_ASSERT(false == net_frozen_[module]);
 
-  net_sink_ids_[module].reserve(num_nets);
-  net_sink_terminal_ids_[module].reserve(num_nets);
-  net_sink_instance_ids_[module].reserve(num_nets);
-  net_sink_pin_ids_[module].reserve(num_nets);
+  net_names_[module].reserve(num_nets);
+  net_srcs_[module].reserve(num_nets);
+  net_sinks_[module].reserve(num_nets);
 }
 
 /* Add a net to the connection graph of the module */ 
@@ -697,24 +1026,21 @@ ModuleNetId ModuleManager::create_module_net(const ModuleId& module) {
   /* Validate the module id */
   VTR_ASSERT ( valid_module_id(module) );
 
+  /* Nets of a frozen module can not be changed */
+  VTR_ASSERT(false == net_frozen_[module]);
+
   /* Create an new id */
   ModuleNetId net = ModuleNetId(num_nets_[module]);
   num_nets_[module]++;
   
   /* Allocate net-related data structures */
   net_names_[module].emplace_back();
-  net_src_ids_[module].emplace_back();
-  net_src_terminal_ids_[module].emplace_back();
-  net_src_instance_ids_[module].emplace_back();
-  net_src_pin_ids_[module].emplace_back();
+  net_srcs_[module].emplace_back();
 
   /* Reserve a source */
   reserve_module_net_sources(module, net, 1);
 
-  net_sink_ids_[module].emplace_back();
-  net_sink_terminal_ids_[module].emplace_back();
-  net_sink_instance_ids_[module].emplace_back();
-  net_sink_pin_ids_[module].emplace_back();
+  net_sinks_[module].emplace_back();
 
   /* Reserve a source */
   reserve_module_net_sinks(module, net, 1);
@@ -735,11 +1061,9 @@ void ModuleManager::reserve_module_net_sources(const ModuleId& module, const Mod
                                                const size_t& num_sources) {
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
+  VTR_ASSERT(false == net_frozen_[module]);
 
-  net_src_ids_[module][net].reserve(num_sources);
-  net_src_terminal_ids_[module][net].reserve(num_sources);
-  net_src_instance_ids_[module][net].reserve(num_sources);
-  net_src_pin_ids_[module][net].reserve(num_sources);
+  net_srcs_[module][net].reserve(num_sources);
 }
 
 /* Add a source to a net in the connection graph */
@@ -749,9 +1073,16 @@ ModuleNetSrcId ModuleManager::add_module_net_source(const ModuleId& module, cons
   /* Validate the module and net id */
   VTR_ASSERT(valid_module_net_id(module, net));
 
+  /* Nets of a frozen module can not be changed */
+  VTR_ASSERT(false == net_frozen_[module]);
+
   /* Create a new id for src node */
-  ModuleNetSrcId net_src = ModuleNetSrcId(net_src_ids_[module][net].size());
-  net_src_ids_[module][net].push_back(net_src);
+  ModuleNetSrcId net_src = ModuleNetSrcId(net_srcs_[module][net].size());
+
+  /* Extend the shared id sequence if this net has more sources than any other */
+  if (size_t(net_src) == net_src_id_sequence_.size()) {
+    net_src_id_sequence_.push_back(net_src);
+  }
 
   /* Validate the source module */
   VTR_ASSERT(valid_module_id(src_module));
@@ -759,36 +1090,29 @@ ModuleNetSrcId ModuleManager::add_module_net_source(const ModuleId& module, cons
   /* Validate the port exists in the src module */
   VTR_ASSERT(valid_module_port_id(src_module, src_port));
 
+  ModuleNetTerminal net_terminal;
+
   /* Create pair of module and port
    * Search in the storage. If found, use the existing pair
    * Otherwise, add the pair
    */
-  std::pair<ModuleId, ModulePortId> terminal(src_module, src_port);
-  std::vector<std::pair<ModuleId, ModulePortId>>::iterator it = std::find(net_terminal_storage_.begin(),
-                                                                          net_terminal_storage_.end(),
-                                                                          terminal);
-  if (it == net_terminal_storage_.end()) {
-    net_src_terminal_ids_[module][net].push_back(net_terminal_storage_.size());
-    net_terminal_storage_.push_back(terminal);
-  } else {
-   VTR_ASSERT_SAFE(it != net_terminal_storage_.end());
-   net_src_terminal_ids_[module][net].push_back(std::distance(net_terminal_storage_.begin(), it));
-  }
+  net_terminal.terminal_id = find_or_add_net_terminal(src_module, src_port);
 
   /* if it has the same id as module, our instance id will be by default 0 */
   size_t src_instance_id = instance_id;
   if (src_module == module) {
     src_instance_id = 0;
-    net_src_instance_ids_[module][net].push_back(src_instance_id);
   } else {
     /* Check the instance id of the src module */
     VTR_ASSERT (src_instance_id < num_instance(module, src_module));
-    net_src_instance_ids_[module][net].push_back(src_instance_id);
   } 
+  net_terminal.instance_id = src_instance_id;
 
   /* Validate the pin id is in the range of the port width */
   VTR_ASSERT(src_pin < module_port(src_module, src_port).get_width());
-  net_src_pin_ids_[module][net].push_back(src_pin);
+  net_terminal.pin_id = src_pin;
+
+  net_srcs_[module][net].push_back(net_terminal);
 
   /* Update fast look-up for nets */
   net_lookup_[module][src_module][src_instance_id][src_port][src_pin] = net;
@@ -800,11 +1124,9 @@ void ModuleManager::reserve_module_net_sinks(const ModuleId& module, const Modul
                                              const size_t& num_sinks) {
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
+  VTR_ASSERT(false == net_frozen_[module]);
 
-  net_sink_ids_[module][net].reserve(num_sinks);
-  net_sink_terminal_ids_[module][net].reserve(num_sinks);
-  net_sink_instance_ids_[module][net].reserve(num_sinks);
-  net_sink_pin_ids_[module][net].reserve(num_sinks);
+  net_sinks_[module][net].reserve(num_sinks);
 }
 
 /* Add a sink to a net in the connection graph */
@@ -814,9 +1136,16 @@ ModuleNetSinkId ModuleManager::add_module_net_sink(const ModuleId& module, const
   /* Validate the module and net id */
   VTR_ASSERT(valid_module_net_id(module, net));
 
+  /* Nets of a frozen module can not be changed */
+  VTR_ASSERT(false == net_frozen_[module]);
+
   /* Create a new id for sink node */
-  ModuleNetSinkId net_sink = ModuleNetSinkId(net_sink_ids_[module][net].size());
-  net_sink_ids_[module][net].push_back(net_sink);
+  ModuleNetSinkId net_sink = ModuleNetSinkId(net_sinks_[module][net].size());
+
+  /* Extend the shared id sequence if this net has more sinks than any other */
+  if (size_t(net_sink) == net_sink_id_sequence_.size()) {
+    net_sink_id_sequence_.push_back(net_sink);
+  }
 
   /* Validate the source module */
   VTR_ASSERT(valid_module_id(sink_module));
@@ -824,36 +1153,29 @@ ModuleNetSinkId ModuleManager::add_module_net_sink(const ModuleId& module, const
   /* Validate the port exists in the sink module */
   VTR_ASSERT(valid_module_port_id(sink_module, sink_port));
 
+  ModuleNetTerminal net_terminal;
+
   /* Create pair of module and port
    * Search in the storage. If found, use the existing pair
    * Otherwise, add the pair
    */
-  std::pair<ModuleId, ModulePortId> terminal(sink_module, sink_port);
-  std::vector<std::pair<ModuleId, ModulePortId>>::iterator it = std::find(net_terminal_storage_.begin(),
-                                                                          net_terminal_storage_.end(),
-                                                                          terminal);
-  if (it == net_terminal_storage_.end()) {
-    net_sink_terminal_ids_[module][net].push_back(net_terminal_storage_.size());
-    net_terminal_storage_.push_back(terminal);
-  } else {
-   VTR_ASSERT_SAFE(it != net_terminal_storage_.end());
-   net_sink_terminal_ids_[module][net].push_back(std::distance(net_terminal_storage_.begin(), it));
-  }
+  net_terminal.terminal_id = find_or_add_net_terminal(sink_module, sink_port);
 
   /* if it has the same id as module, our instance id will be by default 0 */
   size_t sink_instance_id = instance_id;
   if (sink_module == module) {
     sink_instance_id = 0;
-    net_sink_instance_ids_[module][net].push_back(sink_instance_id);
   } else {
     /* Check the instance id of the src module */
     VTR_ASSERT (sink_instance_id < num_instance(module, sink_module));
-    net_sink_instance_ids_[module][net].push_back(sink_instance_id);
   } 
+  net_terminal.instance_id = sink_instance_id;
 
   /* Validate the pin id is in the range of the port width */
   VTR_ASSERT(sink_pin < module_port(sink_module, sink_port).get_width());
-  net_sink_pin_ids_[module][net].push_back(sink_pin);
+  net_terminal.pin_id = sink_pin;
+
+  net_sinks_[module][net].push_back(net_terminal);
 
   /* Update fast look-up for nets */
   net_lookup_[module][sink_module][sink_instance_id][sink_port][sink_pin] = net;
@@ -861,6 +1183,260 @@ ModuleNetSinkId ModuleManager::add_module_net_sink(const ModuleId& module, const
   return net_sink;
 }
 
+void ModuleManager::add_module_port_nets(const ModuleId& module,
+                                         const ModuleId& src_module, const size_t& src_instance,
+                                         const ModulePortId& src_port, const std::vector<size_t>& src_pins,
+                                         const ModuleId& sink_module, const size_t& sink_instance,
+                                         const ModulePortId& sink_port, const std::vector<size_t>& sink_pins) {
+  /* Validate the module and ports */
+  VTR_ASSERT(valid_module_id(module));
+  VTR_ASSERT(valid_module_port_id(src_module, src_port));
+  VTR_ASSERT(valid_module_port_id(sink_module, sink_port));
+  VTR_ASSERT(src_pins.size() == sink_pins.size());
+
+  /* Nets of a frozen module can not be changed */
+  VTR_ASSERT(false == net_frozen_[module]);
+
+  /* if it has the same id as module, our instance id will be by default 0 */
+  size_t src_instance_id = src_instance;
+  if (src_module == module) {
+    src_instance_id = 0;
+  } else {
+    VTR_ASSERT (src_instance_id < num_instance(module, src_module));
+  } 
+  size_t sink_instance_id = sink_instance;
+  if (sink_module == module) {
+    sink_instance_id = 0;
+  } else {
+    VTR_ASSERT (sink_instance_id < num_instance(module, sink_module));
+  } 
+
+  ModuleNetTerminal src_terminal;
+  src_terminal.terminal_id = find_or_add_net_terminal(src_module, src_port);
+  src_terminal.instance_id = src_instance_id;
+  ModuleNetTerminal sink_terminal;
+  sink_terminal.terminal_id = find_or_add_net_terminal(sink_module, sink_port);
+  sink_terminal.instance_id = sink_instance_id;
+
+  /* Fast look-up for the nets of the pins */
+  std::vector<ModuleNetId>& src_pin_nets = net_lookup_[module][src_module][src_instance_id][src_port];
+  std::vector<ModuleNetId>& sink_pin_nets = net_lookup_[module][sink_module][sink_instance_id][sink_port];
+  VTR_ASSERT(src_pin_nets.size() == module_port(src_module, src_port).get_width());
+  VTR_ASSERT(sink_pin_nets.size() == module_port(sink_module, sink_port).get_width());
+
+  /* Each net has at least a source and a sink */
+  if (net_src_id_sequence_.empty()) {
+    net_src_id_sequence_.push_back(ModuleNetSrcId(0));
+  }
+  if (net_sink_id_sequence_.empty()) {
+    net_sink_id_sequence_.push_back(ModuleNetSinkId(0));
+  }
+
+  reserve_module_nets(module, num_nets_[module] + src_pins.size());
+
+  for (size_t ipin = 0; ipin < src_pins.size(); ++ipin) {
+    VTR_ASSERT(src_pins[ipin] < src_pin_nets.size());
+    VTR_ASSERT(sink_pins[ipin] < sink_pin_nets.size());
+
+    ModuleNetId net = src_pin_nets[src_pins[ipin]];
+    if (ModuleNetId::INVALID() == net) {
+      net = ModuleNetId(num_nets_[module]);
+      num_nets_[module]++;
+      net_names_[module].emplace_back();
+      src_terminal.pin_id = src_pins[ipin];
+      net_srcs_[module].emplace_back(1, src_terminal);
+      net_sinks_[module].emplace_back();
+      src_pin_nets[src_pins[ipin]] = net;
+    }
+
+    /* Extend the shared id sequence if this net has more sinks than any other */
+    if (net_sinks_[module][net].size() == net_sink_id_sequence_.size()) {
+      net_sink_id_sequence_.push_back(ModuleNetSinkId(net_sinks_[module][net].size()));
+    }
+    sink_terminal.pin_id = sink_pins[ipin];
+    net_sinks_[module][net].push_back(sink_terminal);
+    sink_pin_nets[sink_pins[ipin]] = net;
+  }
+}
+
+/* Compact the net sources and sinks of each module into flat arrays.
+ * The nested per-net storage is released once a module is frozen
+ */
+void ModuleManager::freeze_module_nets() {
+  for (const ModuleId& module : modules()) {
+    if (true == net_frozen_[module]) {
+      continue;
+    }
+
+    /* Count the terminals so that the flat arrays are allocated only once */
+    size_t num_srcs = 0;
+    size_t num_sinks = 0;
+    for (size_t inet = 0; inet < num_nets_[module]; ++inet) {
+      num_srcs += net_srcs_[module][ModuleNetId(inet)].size();
+      num_sinks += net_sinks_[module][ModuleNetId(inet)].size();
+    }
+
+    frozen_net_src_offsets_[module].reserve(num_nets_[module] + 1);
+    frozen_net_srcs_[module].reserve(num_srcs);
+    frozen_net_sink_offsets_[module].reserve(num_nets_[module] + 1);
+    frozen_net_sinks_[module].reserve(num_sinks);
+
+    for (size_t inet = 0; inet < num_nets_[module]; ++inet) {
+      const ModuleNetId net = ModuleNetId(inet);
+
+      frozen_net_src_offsets_[module].push_back(frozen_net_srcs_[module].size());
+      frozen_net_srcs_[module].insert(frozen_net_srcs_[module].end(),
+                                      net_srcs_[module][net].begin(), net_srcs_[module][net].end());
+
+      frozen_net_sink_offsets_[module].push_back(frozen_net_sinks_[module].size());
+      frozen_net_sinks_[module].insert(frozen_net_sinks_[module].end(),
+                                       net_sinks_[module][net].begin(), net_sinks_[module][net].end());
+    }
+    frozen_net_src_offsets_[module].push_back(frozen_net_srcs_[module].size());
+    frozen_net_sink_offsets_[module].push_back(frozen_net_sinks_[module].size());
+
+    /* Release the nested storage */
+    net_srcs_[module].clear();
+    net_srcs_[module].shrink_to_fit();
+    net_sinks_[module].clear();
+    net_sinks_[module].shrink_to_fit();
+
+    build_frozen_net_lookup(module);
+
+    net_frozen_[module] = true;
+  }
+}
+
+/* Remove the invalid nets of each module */
+void ModuleManager::compress() {
+  for (const ModuleId& module : modules()) {
+    /* Nothing to do when all the nets are valid */
+    if (true == invalid_net_ids_[module].empty()) {
+      continue;
+    }
+
+    /* Build the mapping from old net ids to new net ids */
+    vtr::vector<ModuleNetId, ModuleNetId> net_id_map(num_nets_[module], ModuleNetId::INVALID());
+    size_t num_valid_nets = 0;
+    for (size_t inet = 0; inet < num_nets_[module]; ++inet) {
+      if (0 == invalid_net_ids_[module].count(ModuleNetId(inet))) {
+        net_id_map[ModuleNetId(inet)] = ModuleNetId(num_valid_nets);
+        num_valid_nets++;
+      }
+    }
+
+    /* Move the net names */
+    for (size_t inet = 0; inet < num_nets_[module]; ++inet) {
+      const ModuleNetId& new_net = net_id_map[ModuleNetId(inet)];
+      if (ModuleNetId::INVALID() != new_net) {
+        net_names_[module][new_net] = net_names_[module][ModuleNetId(inet)];
+      }
+    }
+    net_names_[module].resize(num_valid_nets);
+
+    if (true == net_frozen_[module]) {
+      /* Rebuild the flat arrays of terminals without the invalid nets */
+      std::vector<size_t> src_offsets;
+      ModuleNetTerminals srcs;
+      std::vector<size_t> sink_offsets;
+      ModuleNetTerminals sinks;
+      src_offsets.reserve(num_valid_nets + 1);
+      sink_offsets.reserve(num_valid_nets + 1);
+      for (size_t inet = 0; inet < num_nets_[module]; ++inet) {
+        if (ModuleNetId::INVALID() == net_id_map[ModuleNetId(inet)]) {
+          continue;
+        }
+        src_offsets.push_back(srcs.size());
+        srcs.insert(srcs.end(),
+                    frozen_net_srcs_[module].begin() + frozen_net_src_offsets_[module][inet],
+                    frozen_net_srcs_[module].begin() + frozen_net_src_offsets_[module][inet + 1]);
+        sink_offsets.push_back(sinks.size());
+        sinks.insert(sinks.end(),
+                     frozen_net_sinks_[module].begin() + frozen_net_sink_offsets_[module][inet],
+                     frozen_net_sinks_[module].begin() + frozen_net_sink_offsets_[module][inet + 1]);
+      }
+      src_offsets.push_back(srcs.size());
+      sink_offsets.push_back(sinks.size());
+      frozen_net_src_offsets_[module].swap(src_offsets);
+      frozen_net_srcs_[module].swap(srcs);
+      frozen_net_sink_offsets_[module].swap(sink_offsets);
+      frozen_net_sinks_[module].swap(sinks);
+
+      /* Update the dense net look-up */
+      for (ModuleNetId& net : frozen_net_lookup_[module]) {
+        if (ModuleNetId::INVALID() != net) {
+          net = net_id_map[net];
+        }
+      }
+    } else {
+      for (size_t inet = 0; inet < num_nets_[module]; ++inet) {
+        const ModuleNetId& new_net = net_id_map[ModuleNetId(inet)];
+        if (ModuleNetId::INVALID() != new_net) {
+          net_srcs_[module][new_net] = std::move(net_srcs_[module][ModuleNetId(inet)]);
+          net_sinks_[module][new_net] = std::move(net_sinks_[module][ModuleNetId(inet)]);
+        }
+      }
+      net_srcs_[module].resize(num_valid_nets);
+      net_sinks_[module].resize(num_valid_nets);
+
+      /* Update the net look-up */
+      for (auto& child : net_lookup_[module]) {
+        for (auto& instance : child.second) {
+          for (auto& port : instance) {
+            for (ModuleNetId& net : port.second) {
+              if (ModuleNetId::INVALID() != net) {
+                net = net_id_map[net];
+              }
+            }
+          }
+        }
+      }
+    }
+
+    num_nets_[module] = num_valid_nets;
+    invalid_net_ids_[module].clear();
+  }
+}
+
+/* Flatten the net look-up of a module into a dense array
+ * The nested look-up is released afterwards
+ */
+void ModuleManager::build_frozen_net_lookup(const ModuleId& module) {
+  std::vector<ChildNetLookupRange>& children = frozen_net_lookup_children_[module];
+  children.clear();
+
+  /* The module itself is considered as the instance 0 */
+  size_t num_entries = 0;
+  for (const auto& child : net_lookup_[module]) {
+    ChildNetLookupRange child_range;
+    child_range.child_module = child.first;
+    child_range.base = num_entries;
+    child_range.num_pins = num_pins_[child.first];
+    child_range.num_instances = child.second.size();
+    children.push_back(child_range);
+    num_entries += child_range.num_pins * child.second.size();
+  }
+  /* std::map is sorted by keys, so is the range list, which allows binary search */
+
+  frozen_net_lookup_[module].assign(num_entries, ModuleNetId::INVALID());
+
+  for (const ChildNetLookupRange& child_range : children) {
+    const ModuleId& child_module = child_range.child_module;
+    const std::vector<std::map<ModulePortId, std::vector<ModuleNetId>>>& instances = net_lookup_[module][child_module];
+    for (size_t inst = 0; inst < instances.size(); ++inst) {
+      for (const auto& port : instances[inst]) {
+        size_t offset = child_range.base + inst * child_range.num_pins + port_pin_offsets_[child_module][port.first];
+        for (size_t pin = 0; pin < port.second.size(); ++pin) {
+          frozen_net_lookup_[module][offset + pin] = port.second[pin];
+        }
+      }
+    }
+  }
+
+  /* Release the nested look-up */
+  net_lookup_[module].clear();
+}
+
 /******************************************************************************
  * Public Deconstructor
  ******************************************************************************/
@@ -869,6 +1445,7 @@ void ModuleManager::clear_configurable_children(const ModuleId& parent_module) {
 
   configurable_children_[parent_module].clear();
   configurable_child_instances_[parent_module].clear();
+  config_region_first_children_[parent_module].clear();
 }
 
 /******************************************************************************
@@ -8,6 +8,7 @@
 #include <unordered_map>
 
 #include "vtr_vector.h"
+#include "vtr_memory_stats.h"
 #include "module_manager_fwd.h"
 #include "openfpga_port.h"
 
@@ -78,6 +79,9 @@ class ModuleManager {
      * It is used to lazily create an iteration range (e.g. as returned by RRGraph::edges() RRGraph::nodes())
      * just based on the count of allocated elements (i.e. RRGraph::num_nodes_ or RRGraph::num_edges_),
      * and the set of any invalid IDs (i.e. RRGraph::invalid_node_ids_, RRGraph::invalid_edge_ids_).
+     *
+     * When the invalid ID set is empty at the time the iterator is created, 
+     * the range is a plain contiguous ID range and dereferencing skips the look-up on the set.
      */
     template<class ID>
     class lazy_id_iterator : public std::iterator<std::bidirectional_iterator_tag, ID> {
@@ -89,7 +93,8 @@ class ModuleManager {
 
         lazy_id_iterator(value_type init, const std::unordered_set<ID>& invalid_ids)
             : value_(init)
-            , invalid_ids_(invalid_ids) {}
+            , invalid_ids_(invalid_ids)
+            , is_compact_(invalid_ids.empty()) {}
 
         //Advance to the next ID value
         iterator operator++() {
@@ -104,7 +109,7 @@ class ModuleManager {
         }
 
         //Dereference the iterator
-        value_type operator*() const { return (invalid_ids_.count(value_)) ? ID::INVALID() : value_; }
+        value_type operator*() const { return (!is_compact_ && invalid_ids_.count(value_)) ? ID::INVALID() : value_; }
 
         friend bool operator==(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return lhs.value_ == rhs.value_; }
         friend bool operator!=(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return !(lhs == rhs); }
@@ -112,6 +117,7 @@ class ModuleManager {
       private:
         value_type value_;
         const std::unordered_set<ID>& invalid_ids_;
+        bool is_compact_;
     };
 
   public: /* Types and ranges */
@@ -146,6 +152,12 @@ class ModuleManager {
     std::vector<ModuleId> configurable_children(const ModuleId& parent_module) const;
     /* Find all the instances of configurable child modules under a parent module */
     std::vector<size_t> configurable_child_instances(const ModuleId& parent_module) const;
+    /* Find the number of configuration regions of a parent module */
+    size_t num_config_regions(const ModuleId& parent_module) const;
+    /* Find the indices of configurable children in a configuration region of a parent module
+     * The indices are the positions in the list of configurable_children()
+     */
+    std::vector<size_t> region_configurable_children(const ModuleId& parent_module, const size_t& region) const;
     /* Find the source ids of modules */
     module_net_src_range module_net_sources(const ModuleId& module, const ModuleNetId& net) const;
     /* Find the sink ids of modules */
@@ -161,6 +173,12 @@ class ModuleManager {
     std::vector<ModulePortId> module_port_ids_by_type(const ModuleId& module_id, const enum e_module_port_type& port_type) const;
     /* Find a port of a module by a given name */
     ModulePortId find_module_port(const ModuleId& module_id, const std::string& port_name) const;
+    /* Find the interned id of a port name, which is invalid if no port has the name.
+     * Hot loops can find the id once and then search the ports of many modules with it
+     */
+    ModulePortNameId find_port_name_id(const std::string& port_name) const;
+    /* Find a port of a module by the interned id of its name */
+    ModulePortId find_module_port(const ModuleId& module_id, const ModulePortNameId& port_name_id) const;
     /* Find the Port information with a given port id */
     BasicPort module_port(const ModuleId& module_id, const ModulePortId& port_id) const;
     /* Find a module by a given name */
@@ -197,6 +215,14 @@ class ModuleManager {
     bool net_source_exist(const ModuleId& module, const ModuleNetId& net,
                           const ModuleId& src_module, const size_t& instance_id,
                           const ModulePortId& src_port, const size_t& src_pin);
+    /* Find the source module of a given source of a net */
+    ModuleId net_source_module(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const;
+    /* Find the id of the source instance of a given source of a net */
+    size_t net_source_instance(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const;
+    /* Find the source port of a given source of a net */
+    ModulePortId net_source_port(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const;
+    /* Find the source pin index of a given source of a net */
+    size_t net_source_pin(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const;
 
     /* Find the sink modules of a net */
     vtr::vector<ModuleNetSinkId, ModuleId> net_sink_modules(const ModuleId& module, const ModuleNetId& net) const;
@@ -210,9 +236,60 @@ class ModuleManager {
     bool net_sink_exist(const ModuleId& module, const ModuleNetId& net,
                         const ModuleId& sink_module, const size_t& instance_id,
                         const ModulePortId& sink_port, const size_t& sink_pin);
+    /* Find the sink module of a given sink of a net */
+    ModuleId net_sink_module(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const;
+    /* Find the id of the sink instance of a given sink of a net */
+    size_t net_sink_instance(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const;
+    /* Find the sink port of a given sink of a net */
+    ModulePortId net_sink_port(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const;
+    /* Find the sink pin index of a given sink of a net */
+    size_t net_sink_pin(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const;
+    /* Identify if the nets of a module have been frozen */
+    bool module_nets_frozen(const ModuleId& module) const;
+    /* Estimate the memory (in bytes) occupied by the module graph */
+    size_t memory_footprint() const;
+
+  private: /* Private data structures */
+    /* A terminal of a net, i.e., a pin of a port of a module instance
+     * The pair of module and port is shared through the net terminal storage
+     */
+    struct ModuleNetTerminal {
+      size_t terminal_id; /* Index in the net terminal storage */
+      size_t instance_id;
+      size_t pin_id;
+    };
 
+    /* Owner of the memory of the net terminals, when memory accounting is enabled (see vtr_memory_stats.h) */
+    struct ModuleNetMemoryTag {
+      static const char* name() { return "ModuleManager nets"; }
+    };
+    typedef std::vector<ModuleNetTerminal, vtr::TaggedAllocator<ModuleNetTerminal, ModuleNetMemoryTag>> ModuleNetTerminals;
+
+    /* The range of a child module in the dense net look-up of a frozen parent module 
+     * The net of pin <pin> of port <port> of instance <inst> is located at 
+     *   base + inst * num_pins + port_pin_offsets_[child][port] + pin
+     */
+    struct ChildNetLookupRange {
+      ModuleId child_module;
+      size_t base;
+      size_t num_pins; /* Number of pins of the child module when the parent is frozen */
+      size_t num_instances; /* Number of instances of the child module when the parent is frozen */
+    };
   private: /* Private accessors */
     size_t find_child_module_index_in_parent_module(const ModuleId& parent_module, const ModuleId& child_module) const;
+    size_t num_net_sources(const ModuleId& module, const ModuleNetId& net) const;
+    size_t num_net_sinks(const ModuleId& module, const ModuleNetId& net) const;
+    const ModuleNetTerminal& net_source_terminal(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const;
+    const ModuleNetTerminal& net_sink_terminal(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const;
+    ModuleNetId frozen_module_instance_port_net(const ModuleId& parent_module, 
+                                                const ModuleId& child_module, const size_t& child_instance,
+                                                const ModulePortId& child_port, const size_t& child_pin) const;
+  private: /* Private mutators */
+    void build_frozen_net_lookup(const ModuleId& module);
+    /* Register a port under its name in the fast look-up, the first port with a name wins */
+    void register_port_name(const ModuleId& module, const ModulePortId& port);
+    /* Find the index of a pair of module and port in the terminal storage, add the pair if not found */
+    size_t find_or_add_net_terminal(const ModuleId& module, const ModulePortId& port);
   public: /* Public mutators */
     /* Add a module */
     ModuleId add_module(const std::string& name);
@@ -241,6 +318,11 @@ class ModuleManager {
      * for memory efficiency
      */
     void reserve_configurable_child(const ModuleId& module, const size_t& num_children);
+    /* Split the configurable children of a module into configuration regions,
+     * where each region starts from a configurable child in the list
+     * The first region must start from the first configurable child
+     */
+    void set_config_regions(const ModuleId& module, const std::vector<size_t>& region_first_children);
 
     /* Reserved a number of module nets for a given module
      * for memory efficiency
@@ -274,6 +356,36 @@ class ModuleManager {
     ModuleNetSinkId add_module_net_sink(const ModuleId& module, const ModuleNetId& net,
                                         const ModuleId& sink_module, const size_t& instance_id,
                                         const ModulePortId& sink_port, const size_t& sink_pin);
+
+    /* Connect the pins of a source port to the pins of a sink port in pairs,
+     * i.e., the i-th source pin drives the i-th sink pin.
+     * A source pin which already drives a net adds the sink pin to that net,
+     * otherwise a net is created for the source pin.
+     * This is the same as calling create_module_net(), add_module_net_source() 
+     * and add_module_net_sink() for each pin, but the storage of nets is reserved 
+     * and the ports are validated and looked up only once
+     */
+    void add_module_port_nets(const ModuleId& module,
+                              const ModuleId& src_module, const size_t& src_instance,
+                              const ModulePortId& src_port, const std::vector<size_t>& src_pins,
+                              const ModuleId& sink_module, const size_t& sink_instance,
+                              const ModulePortId& sink_port, const std::vector<size_t>& sink_pins);
+
+    /* Compact the sources and sinks of nets of all the modules 
+     * into flat arrays, which is much more memory efficient and cache friendly 
+     * for the netlist writers.
+     * The fast look-up on nets of module instances is also flattened into a dense array.
+     * It should be called once the module graph is built.
+     * Nets of a frozen module can no longer be created or modified.
+     * Modules added afterwards are not affected until this function is called again
+     */
+    void freeze_module_nets();
+
+    /* Remove the invalid nets of all the modules and renumber the remaining ones
+     * so that the ranges of nets become contiguous.
+     * Note that any net id obtained before this call may be outdated
+     */
+    void compress();
   public: /* Public deconstructors */
     /* This is a strong function which will remove all the configurable children 
      * under a given parent module
@@ -310,6 +422,11 @@ class ModuleManager {
      */
     vtr::vector<ModuleId, std::vector<ModuleId>> configurable_children_;                /* Child modules with configurable memory bits that this module contain */
     vtr::vector<ModuleId, std::vector<size_t>> configurable_child_instances_;           /* Instances of child modules with configurable memory bits that this module contain */
+    /* Configuration regions split the configurable children into groups, which are programmed in parallel
+     * Each region is a range of configurable children, starting from the child at the index stored here
+     * An empty list means that all the configurable children belong to a single region
+     */
+    vtr::vector<ModuleId, std::vector<size_t>> config_region_first_children_;
 
     /* Port-level data */
     vtr::vector<ModuleId, vtr::vector<ModulePortId, ModulePortId>> port_ids_;    /* List of ports for each Module */ 
@@ -318,6 +435,8 @@ class ModuleManager {
     vtr::vector<ModuleId, vtr::vector<ModulePortId, bool>> port_is_wire_; /* If the port is a wire, use for Verilog port definition. If enabled: <port_type> reg <port_name>  */ 
     vtr::vector<ModuleId, vtr::vector<ModulePortId, bool>> port_is_register_; /* If the port is a register, use for Verilog port definition. If enabled: <port_type> reg <port_name>  */ 
     vtr::vector<ModuleId, vtr::vector<ModulePortId, std::string>> port_preproc_flags_; /* If a port is available only when a pre-processing flag is enabled. This is to record the pre-processing flags */ 
+    vtr::vector<ModuleId, vtr::vector<ModulePortId, size_t>> port_pin_offsets_; /* Index of the first pin of each port when all the pins of a module are flattened */ 
+    vtr::vector<ModuleId, size_t> num_pins_; /* Total number of pins of each module */ 
 
     /* Graph-level data: 
      * We use nets to model the connection between pins of modules and instances.  
@@ -328,19 +447,34 @@ class ModuleManager {
     vtr::vector<ModuleId, std::unordered_set<ModuleNetId>> invalid_net_ids_;   /* Invalid net ids */
     vtr::vector<ModuleId, vtr::vector<ModuleNetId, std::string>> net_names_;    /* Name of net */ 
 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSrcId, ModuleNetSrcId>>> net_src_ids_;  /* Unique id of the source that drive the net */ 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSrcId, size_t>>> net_src_terminal_ids_;  /* Pin ids that drive the net */ 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSrcId, size_t>>> net_src_instance_ids_;  /* Pin ids that drive the net */ 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSrcId, size_t>>> net_src_pin_ids_;  /* Pin ids that drive the net */ 
-
+    /* Sources and sinks of each net when the module graph is under construction */
+    vtr::vector<ModuleId, vtr::vector<ModuleNetId, ModuleNetTerminals>> net_srcs_;
+    vtr::vector<ModuleId, vtr::vector<ModuleNetId, ModuleNetTerminals>> net_sinks_;
 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSinkId, ModuleNetSinkId>>> net_sink_ids_;  /* Unique ids of the sink that the net drives */ 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSinkId, size_t>>> net_sink_terminal_ids_;  /* Pin ids that the net drives */ 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSinkId, size_t>>> net_sink_instance_ids_;  /* Pin ids that drive the net */ 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSinkId, size_t>>> net_sink_pin_ids_;  /* Pin ids that drive the net */ 
+    /* Sources and sinks of each net once the module is frozen
+     * All the terminals of a module are stored in a flat array, 
+     * where the terminals of a net are in the range of [offsets[net], offsets[net + 1])
+     */
+    vtr::vector<ModuleId, bool> net_frozen_;
+    vtr::vector<ModuleId, std::vector<size_t>> frozen_net_src_offsets_;
+    vtr::vector<ModuleId, ModuleNetTerminals> frozen_net_srcs_;
+    vtr::vector<ModuleId, std::vector<size_t>> frozen_net_sink_offsets_;
+    vtr::vector<ModuleId, ModuleNetTerminals> frozen_net_sinks_;
+
+    /* Sequences of source and sink ids shared by all the nets: [0, 1, 2, ..., max_num_terminals - 1]
+     * The range of terminal ids of a net is a prefix of the sequence
+     */
+    vtr::vector<ModuleNetSrcId, ModuleNetSrcId> net_src_id_sequence_;
+    vtr::vector<ModuleNetSinkId, ModuleNetSinkId> net_sink_id_sequence_;
 
     /* fast look-up for module */
     std::map<std::string, ModuleId> name_id_map_;
+    /* fast look-up for ports by name: 
+     * port names are interned as they are shared by many modules, 
+     * and each module maps the interned names to its ports
+     */
+    std::unordered_map<std::string, ModulePortNameId> port_name_ids_;
+    vtr::vector<ModuleId, std::unordered_map<ModulePortNameId, ModulePortId>> port_name_lookup_; /* [module_ids][port_name_ids] */
     /* fast look-up for ports */
     typedef vtr::vector<ModuleId, std::vector<std::vector<ModulePortId>>> PortLookup;
     mutable PortLookup port_lookup_; /* [module_ids][port_types][port_ids] */ 
@@ -349,10 +483,18 @@ class ModuleManager {
     typedef vtr::vector<ModuleId, std::map<ModuleId, std::vector<std::map<ModulePortId, std::vector<ModuleNetId>>>>> NetLookup;
     mutable NetLookup net_lookup_; /* [module_ids][module_ids][instance_ids][port_ids][pin_ids] */ 
 
+    /* Dense fast look-up for nets of frozen modules, which replaces the net_lookup_ 
+     * The child modules are sorted by their ids, which includes the module itself as instance 0
+     */
+    vtr::vector<ModuleId, std::vector<ChildNetLookupRange>> frozen_net_lookup_children_;
+    vtr::vector<ModuleId, std::vector<ModuleNetId>> frozen_net_lookup_; /* [module_ids][flattened pin index] */ 
+
     /* Store pairs of a module and a port, which are frequently used in net terminals
      * (either source or sink)
      */
     std::vector<std::pair<ModuleId, ModulePortId>> net_terminal_storage_;
+    /* Fast look-up for the index of a pair in the terminal storage */
+    std::map<std::pair<ModuleId, ModulePortId>, size_t> net_terminal_ids_;
 };
 
 } /* end namespace openfpga */
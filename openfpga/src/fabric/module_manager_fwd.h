@@ -15,6 +15,7 @@ namespace openfpga {
 struct module_id_tag;
 struct instance_id_tag; /* TODO: use instance id in module_manager */
 struct module_port_id_tag;
+struct module_port_name_id_tag;
 struct module_pin_id_tag;
 struct module_net_id_tag;
 struct module_net_src_id_tag;
@@ -23,6 +24,7 @@ struct module_net_sink_id_tag;
 typedef vtr::StrongId<module_id_tag> ModuleId;
 typedef vtr::StrongId<instance_id_tag> InstanceId;
 typedef vtr::StrongId<module_port_id_tag> ModulePortId;
+typedef vtr::StrongId<module_port_name_id_tag> ModulePortNameId;
 typedef vtr::StrongId<module_pin_id_tag> ModulePinId;
 typedef vtr::StrongId<module_net_id_tag> ModuleNetId;
 typedef vtr::StrongId<module_net_src_id_tag> ModuleNetSrcId;
@@ -0,0 +1,367 @@
+/********************************************************************
+ * This file includes functions that load the fabric graph,
+ * i.e., the module graph, the decoder library and the I/O location map,
+ * from a file in binary format
+ * See binary_fabric_graph.h for the details of the file layout
+ *******************************************************************/
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+#include "binary_fabric_graph.h"
+#include "read_binary_fabric_graph.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Read a number of bytes from the file 
+ * Return false if the file is truncated
+ *******************************************************************/
+static
+bool read_binary_fabric_graph_bytes(std::istream& fp,
+                                    char* data,
+                                    const size_t& num_bytes) {
+  fp.read(data, num_bytes);
+  return size_t(fp.gcount()) == num_bytes;
+}
+
+template<class T>
+static
+bool read_binary_fabric_graph_record(std::istream& fp, T& record) {
+  return read_binary_fabric_graph_bytes(fp, reinterpret_cast<char*>(&record), sizeof(record));
+}
+
+static
+bool read_binary_fabric_graph_string(std::istream& fp, std::string& str, const size_t& length) {
+  str.resize(length);
+  return read_binary_fabric_graph_bytes(fp, &str[0], length);
+}
+
+/********************************************************************
+ * Read the name and ports of a module and add it to the module graph
+ * Return false if the file is truncated or invalid
+ *******************************************************************/
+static 
+bool read_binary_fabric_graph_module_declaration(std::istream& fp,
+                                                 ModuleManager& module_manager,
+                                                 const size_t& module_index) {
+  BinaryFabricGraphModuleHeader module_header;
+  std::string module_name;
+  if ( (false == read_binary_fabric_graph_record(fp, module_header))
+    || (false == read_binary_fabric_graph_string(fp, module_name, module_header.name_length))
+    || (ModuleManager::NUM_MODULE_USAGE_TYPES < module_header.usage)) {
+    return false;
+  }
+
+  ModuleId module = module_manager.add_module(module_name);
+  if (size_t(module) != module_index) {
+    VTR_LOG_ERROR("Module '%s' is defined more than once!\n",
+                  module_name.c_str());
+    return false;
+  }
+  /* Usage may not be defined for some modules */
+  if (ModuleManager::NUM_MODULE_USAGE_TYPES != module_header.usage) {
+    module_manager.set_module_usage(module, ModuleManager::e_module_usage_type(module_header.usage));
+  }
+
+  std::string port_name;
+  std::string preproc_flag;
+  for (uint64_t iport = 0; iport < module_header.num_ports; ++iport) {
+    BinaryFabricGraphPortHeader port_header;
+    if ( (false == read_binary_fabric_graph_record(fp, port_header))
+      || (false == read_binary_fabric_graph_string(fp, port_name, port_header.name_length))
+      || (false == read_binary_fabric_graph_string(fp, preproc_flag, port_header.preproc_flag_length))
+      || (ModuleManager::NUM_MODULE_PORT_TYPES <= port_header.port_type)) {
+      return false;
+    }
+
+    ModulePortId port = module_manager.add_port(module,
+                                                BasicPort(port_name, port_header.lsb, port_header.msb),
+                                                ModuleManager::e_module_port_type(port_header.port_type));
+    VTR_ASSERT(size_t(port) == iport);
+    if (1 == port_header.is_wire) {
+      module_manager.set_port_is_wire(module, port_name, true);
+    }
+    if (1 == port_header.is_register) {
+      module_manager.set_port_is_register(module, port_name, true);
+    }
+    if (false == preproc_flag.empty()) {
+      module_manager.set_port_preproc_flag(module, port, preproc_flag);
+    }
+  }
+
+  return true;
+}
+
+/********************************************************************
+ * Read a terminal of a net and check that it refers to a valid pin
+ * Return false if the file is truncated or invalid
+ *******************************************************************/
+static 
+bool read_binary_fabric_graph_net_terminal(std::istream& fp,
+                                           const ModuleManager& module_manager,
+                                           const ModuleId& parent_module,
+                                           ModuleId& terminal_module,
+                                           BinaryFabricGraphNetTerminal& terminal) {
+  if (false == read_binary_fabric_graph_record(fp, terminal)) {
+    return false;
+  }
+  terminal_module = ModuleId(terminal.module);
+  if (false == module_manager.valid_module_id(terminal_module)) {
+    return false;
+  }
+  /* The parent module itself is instance 0 of its own */
+  if ( (terminal_module == parent_module) 
+     ? (0 != terminal.instance)
+     : (false == module_manager.valid_module_instance_id(parent_module, terminal_module, terminal.instance)) ) {
+    return false;
+  }
+  ModulePortId port = ModulePortId(terminal.port);
+  if (false == module_manager.valid_module_port_id(terminal_module, port)) {
+    return false;
+  }
+  return terminal.pin < module_manager.module_port(terminal_module, port).get_width();
+}
+
+/********************************************************************
+ * Read the child modules, configurable children and nets of a module 
+ * Return false if the file is truncated or invalid
+ *******************************************************************/
+static 
+bool read_binary_fabric_graph_module_body(std::istream& fp,
+                                          ModuleManager& module_manager,
+                                          const ModuleId& module) {
+  BinaryFabricGraphModuleBodyHeader body_header;
+  if (false == read_binary_fabric_graph_record(fp, body_header)) {
+    return false;
+  }
+
+  std::string instance_name;
+  for (uint64_t ichild = 0; ichild < body_header.num_children; ++ichild) {
+    BinaryFabricGraphChildHeader child_header;
+    if (false == read_binary_fabric_graph_record(fp, child_header)) {
+      return false;
+    }
+    ModuleId child = ModuleId(child_header.child_module);
+    if (false == module_manager.valid_module_id(child)) {
+      return false;
+    }
+    for (uint64_t inst = 0; inst < child_header.num_instances; ++inst) {
+      uint32_t name_length;
+      if ( (false == read_binary_fabric_graph_record(fp, name_length))
+        || (false == read_binary_fabric_graph_string(fp, instance_name, name_length)) ) {
+        return false;
+      }
+      module_manager.add_child_module(module, child);
+      if (false == instance_name.empty()) {
+        module_manager.set_child_instance_name(module, child, inst, instance_name);
+      }
+    }
+  }
+
+  module_manager.reserve_configurable_child(module, body_header.num_configurable_children);
+  for (uint64_t ichild = 0; ichild < body_header.num_configurable_children; ++ichild) {
+    BinaryFabricGraphConfigurableChild configurable_child;
+    if (false == read_binary_fabric_graph_record(fp, configurable_child)) {
+      return false;
+    }
+    ModuleId child = ModuleId(configurable_child.child_module);
+    if ( (false == module_manager.valid_module_id(child))
+      || (false == module_manager.valid_module_instance_id(module, child, configurable_child.child_instance)) ) {
+      return false;
+    }
+    module_manager.add_configurable_child(module, child, configurable_child.child_instance);
+  }
+
+  if (0 < body_header.num_config_regions) {
+    std::vector<size_t> region_first_children(body_header.num_config_regions);
+    for (size_t& first_child : region_first_children) {
+      uint64_t first_child_record;
+      if (false == read_binary_fabric_graph_record(fp, first_child_record)) {
+        return false;
+      }
+      first_child = first_child_record;
+    }
+    /* Regions must be sorted ranges of the configurable children */
+    if ( (0 != region_first_children[0])
+      || (body_header.num_configurable_children <= region_first_children.back()) ) {
+      return false;
+    }
+    for (size_t region = 1; region < region_first_children.size(); ++region) {
+      if (region_first_children[region - 1] >= region_first_children[region]) {
+        return false;
+      }
+    }
+    module_manager.set_config_regions(module, region_first_children);
+  }
+
+  module_manager.reserve_module_nets(module, body_header.num_nets);
+  std::string net_name;
+  for (uint64_t inet = 0; inet < body_header.num_nets; ++inet) {
+    BinaryFabricGraphNetHeader net_header;
+    if ( (false == read_binary_fabric_graph_record(fp, net_header))
+      || (false == read_binary_fabric_graph_string(fp, net_name, net_header.name_length)) ) {
+      return false;
+    }
+
+    ModuleNetId net = module_manager.create_module_net(module);
+    if (false == net_name.empty()) {
+      module_manager.set_net_name(module, net, net_name);
+    }
+
+    ModuleId terminal_module;
+    BinaryFabricGraphNetTerminal terminal;
+    module_manager.reserve_module_net_sources(module, net, net_header.num_sources);
+    for (uint64_t isrc = 0; isrc < net_header.num_sources; ++isrc) {
+      if (false == read_binary_fabric_graph_net_terminal(fp, module_manager, module, terminal_module, terminal)) {
+        return false;
+      }
+      module_manager.add_module_net_source(module, net, terminal_module, terminal.instance,
+                                           ModulePortId(terminal.port), terminal.pin);
+    }
+    module_manager.reserve_module_net_sinks(module, net, net_header.num_sinks);
+    for (uint64_t isink = 0; isink < net_header.num_sinks; ++isink) {
+      if (false == read_binary_fabric_graph_net_terminal(fp, module_manager, module, terminal_module, terminal)) {
+        return false;
+      }
+      module_manager.add_module_net_sink(module, net, terminal_module, terminal.instance,
+                                         ModulePortId(terminal.port), terminal.pin);
+    }
+  }
+
+  return true;
+}
+
+/********************************************************************
+ * Load the fabric graph from a stream in binary format
+ * The fabric graph is read from the current position of the stream,
+ * so that it can be embedded in other binary files, e.g., a context checkpoint.
+ * The file name is only used in error messages
+ * The module graph, the decoder library and the I/O location map
+ * should be empty, as the ids of the file are kept
+ *
+ * Return 0 if successful
+ * Return 1 if the file is invalid or does not match the device
+ *******************************************************************/
+int read_binary_fabric_graph_from_stream(std::istream& fp,
+                                         ModuleManager& module_manager,
+                                         DecoderLibrary& decoder_lib,
+                                         IoLocationMap& io_location_map,
+                                         const DeviceGrid& grids,
+                                         const std::string& fname,
+                                         const bool& verbose) {
+  VTR_ASSERT(0 == module_manager.num_modules());
+  VTR_ASSERT(0 == decoder_lib.decoders().size());
+
+  BinaryFabricGraphHeader header;
+  if ( (false == read_binary_fabric_graph_record(fp, header))
+    || (0 != std::memcmp(header.magic, BINARY_FABRIC_GRAPH_MAGIC, sizeof(BINARY_FABRIC_GRAPH_MAGIC)))
+    || (BINARY_FABRIC_GRAPH_VERSION != header.version) ) {
+    VTR_LOG_ERROR("File '%s' is not a binary fabric graph of version %u!\n",
+                  fname.c_str(), BINARY_FABRIC_GRAPH_VERSION);
+    return 1;
+  }
+
+  /* The fabric graph must be built for the same device */
+  if ( (header.grid_width != grids.width())
+    || (header.grid_height != grids.height()) ) {
+    VTR_LOG_ERROR("Fabric graph in file '%s' is built for a device grid of %lu x %lu, while the current device grid is %lu x %lu!\n",
+                  fname.c_str(), header.grid_width, header.grid_height, grids.width(), grids.height());
+    return 1;
+  }
+
+  for (uint64_t idecoder = 0; idecoder < header.num_decoders; ++idecoder) {
+    BinaryFabricGraphDecoder decoder_record;
+    if (false == read_binary_fabric_graph_record(fp, decoder_record)) {
+      VTR_LOG_ERROR("Binary fabric graph file '%s' is truncated!\n", fname.c_str());
+      return 1;
+    }
+    DecoderId decoder = decoder_lib.add_decoder(decoder_record.addr_size, decoder_record.data_size,
+                                                1 == decoder_record.use_enable,
+                                                1 == decoder_record.use_data_in,
+                                                1 == decoder_record.use_data_inv_port);
+    decoder_lib.set_predecode_size(decoder, decoder_record.predecode_size);
+  }
+
+  for (uint64_t iio = 0; iio < header.num_io_indices; ++iio) {
+    BinaryFabricGraphIoIndex io_index_record;
+    if (false == read_binary_fabric_graph_record(fp, io_index_record)) {
+      VTR_LOG_ERROR("Binary fabric graph file '%s' is truncated!\n", fname.c_str());
+      return 1;
+    }
+    io_location_map.set_io_index(io_index_record.x, io_index_record.y, io_index_record.z,
+                                 io_index_record.io_index);
+  }
+
+  for (uint64_t imodule = 0; imodule < header.num_modules; ++imodule) {
+    if (false == read_binary_fabric_graph_module_declaration(fp, module_manager, imodule)) {
+      VTR_LOG_ERROR("Invalid declaration of module %lu in binary fabric graph file '%s'!\n",
+                    imodule, fname.c_str());
+      return 1;
+    }
+  }
+
+  for (const ModuleId& module : module_manager.modules()) {
+    if (false == read_binary_fabric_graph_module_body(fp, module_manager, module)) {
+      VTR_LOG_ERROR("Invalid module '%s' in binary fabric graph file '%s'!\n",
+                    module_manager.module_name(module).c_str(), fname.c_str());
+      return 1;
+    }
+  }
+
+  VTR_LOGV(verbose,
+           "Read %lu modules, %lu decoders and %lu I/O indices\n",
+           header.num_modules, header.num_decoders, header.num_io_indices);
+
+  return 0;
+}
+
+/********************************************************************
+ * Load the fabric graph from a file in binary format
+ * The module graph, the decoder library and the I/O location map
+ * should be empty, as the ids of the file are kept
+ *
+ * Return 0 if successful
+ * Return 1 if the file is invalid or does not match the device
+ * Return 2 if fail when opening the file
+ *******************************************************************/
+int read_binary_fabric_graph(ModuleManager& module_manager,
+                             DecoderLibrary& decoder_lib,
+                             IoLocationMap& io_location_map,
+                             const DeviceGrid& grids,
+                             const std::string& fname,
+                             const bool& verbose) {
+  std::string timer_message = std::string("Read fabric graph from binary file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  std::ifstream fp(fname, std::ios::in | std::ios::binary);
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Unable to open fabric graph file '%s'!\n",
+                  fname.c_str());
+    return 2;
+  }
+
+  int status = read_binary_fabric_graph_from_stream(fp, module_manager, decoder_lib,
+                                                    io_location_map, grids, fname, verbose);
+  if (0 != status) {
+    return status;
+  }
+
+  if (std::ifstream::traits_type::eof() != fp.peek()) {
+    VTR_LOG_ERROR("Size of binary fabric graph file '%s' does not match its header!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  return 0;
+}
+
+} /* end namespace openfpga */
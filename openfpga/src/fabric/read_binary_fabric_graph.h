@@ -0,0 +1,38 @@
+#ifndef READ_BINARY_FABRIC_GRAPH_H
+#define READ_BINARY_FABRIC_GRAPH_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <istream>
+#include <string>
+#include "device_grid.h"
+#include "module_manager.h"
+#include "decoder_library.h"
+#include "io_location_map.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int read_binary_fabric_graph_from_stream(std::istream& fp,
+                                         ModuleManager& module_manager,
+                                         DecoderLibrary& decoder_lib,
+                                         IoLocationMap& io_location_map,
+                                         const DeviceGrid& grids,
+                                         const std::string& fname,
+                                         const bool& verbose);
+
+int read_binary_fabric_graph(ModuleManager& module_manager,
+                             DecoderLibrary& decoder_lib,
+                             IoLocationMap& io_location_map,
+                             const DeviceGrid& grids,
+                             const std::string& fname,
+                             const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,299 @@
+/********************************************************************
+ * This file includes functions that output the fabric graph,
+ * i.e., the module graph, the decoder library and the I/O location map,
+ * to a file in binary format
+ * See binary_fabric_graph.h for the details of the file layout
+ *******************************************************************/
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "binary_fabric_graph.h"
+#include "write_binary_fabric_graph.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Write a fixed-size record to a binary file
+ *******************************************************************/
+template<class T>
+static 
+void write_binary_fabric_graph_record(std::ostream& fp, const T& record) {
+  fp.write(reinterpret_cast<const char*>(&record), sizeof(record));
+}
+
+/********************************************************************
+ * Write the name and ports of a module to a binary file
+ *******************************************************************/
+static 
+void write_binary_fabric_graph_module_declaration(std::ostream& fp,
+                                                  const ModuleManager& module_manager,
+                                                  const ModuleId& module) {
+  std::string module_name = module_manager.module_name(module);
+
+  BinaryFabricGraphModuleHeader module_header;
+  module_header.name_length = uint32_t(module_name.size());
+  module_header.usage = uint32_t(module_manager.module_usage(module));
+  module_header.num_ports = module_manager.module_ports(module).size();
+  write_binary_fabric_graph_record(fp, module_header);
+  fp.write(module_name.data(), module_name.size());
+
+  /* Port types are only available by port groups */
+  vtr::vector<ModulePortId, ModuleManager::e_module_port_type> port_types(module_header.num_ports, ModuleManager::NUM_MODULE_PORT_TYPES);
+  for (size_t port_type = 0; port_type < ModuleManager::NUM_MODULE_PORT_TYPES; ++port_type) {
+    for (const ModulePortId& port : module_manager.module_port_ids_by_type(module, ModuleManager::e_module_port_type(port_type))) {
+      port_types[port] = ModuleManager::e_module_port_type(port_type);
+    }
+  }
+
+  for (const ModulePortId& port : module_manager.module_ports(module)) {
+    BasicPort port_info = module_manager.module_port(module, port);
+    std::string port_name = port_info.get_name();
+    std::string preproc_flag = module_manager.port_preproc_flag(module, port);
+
+    BinaryFabricGraphPortHeader port_header;
+    std::memset(&port_header, 0, sizeof(port_header));
+    port_header.name_length = uint32_t(port_name.size());
+    port_header.port_type = uint32_t(port_types[port]);
+    port_header.lsb = port_info.get_lsb();
+    port_header.msb = port_info.get_msb();
+    port_header.is_wire = module_manager.port_is_wire(module, port) ? 1 : 0;
+    port_header.is_register = module_manager.port_is_register(module, port) ? 1 : 0;
+    port_header.preproc_flag_length = uint32_t(preproc_flag.size());
+    write_binary_fabric_graph_record(fp, port_header);
+    fp.write(port_name.data(), port_name.size());
+    fp.write(preproc_flag.data(), preproc_flag.size());
+  }
+}
+
+/********************************************************************
+ * Write the terminal of a net to a binary file
+ *******************************************************************/
+static 
+void write_binary_fabric_graph_net_terminal(std::ostream& fp,
+                                            const ModuleId& terminal_module,
+                                            const size_t& terminal_instance,
+                                            const ModulePortId& terminal_port,
+                                            const size_t& terminal_pin) {
+  BinaryFabricGraphNetTerminal terminal;
+  terminal.module = size_t(terminal_module);
+  terminal.instance = terminal_instance;
+  terminal.port = size_t(terminal_port);
+  terminal.pin = terminal_pin;
+  write_binary_fabric_graph_record(fp, terminal);
+}
+
+/********************************************************************
+ * Write the child modules, configurable children and nets of a module 
+ * to a binary file
+ *******************************************************************/
+static 
+void write_binary_fabric_graph_module_body(std::ostream& fp,
+                                           const ModuleManager& module_manager,
+                                           const ModuleId& module) {
+  std::vector<ModuleId> children = module_manager.child_modules(module);
+  std::vector<ModuleId> configurable_children = module_manager.configurable_children(module);
+  std::vector<size_t> configurable_child_instances = module_manager.configurable_child_instances(module);
+
+  /* Nets are written in the order of their ids, so the ids remain the same once loaded */
+  size_t num_nets = 0;
+  for (const ModuleNetId& net : module_manager.module_nets(module)) {
+    VTR_ASSERT(true == module_manager.valid_module_net_id(module, net));
+    num_nets++;
+  }
+
+  BinaryFabricGraphModuleBodyHeader body_header;
+  body_header.num_children = children.size();
+  body_header.num_configurable_children = configurable_children.size();
+  body_header.num_config_regions = 0;
+  if (1 < module_manager.num_config_regions(module)) {
+    body_header.num_config_regions = module_manager.num_config_regions(module);
+  }
+  body_header.num_nets = num_nets;
+  write_binary_fabric_graph_record(fp, body_header);
+
+  for (const ModuleId& child : children) {
+    BinaryFabricGraphChildHeader child_header;
+    child_header.child_module = size_t(child);
+    child_header.num_instances = module_manager.num_instance(module, child);
+    write_binary_fabric_graph_record(fp, child_header);
+    for (size_t inst = 0; inst < child_header.num_instances; ++inst) {
+      std::string instance_name = module_manager.instance_name(module, child, inst);
+      uint32_t name_length = uint32_t(instance_name.size());
+      write_binary_fabric_graph_record(fp, name_length);
+      fp.write(instance_name.data(), instance_name.size());
+    }
+  }
+
+  for (size_t ichild = 0; ichild < configurable_children.size(); ++ichild) {
+    BinaryFabricGraphConfigurableChild configurable_child;
+    configurable_child.child_module = size_t(configurable_children[ichild]);
+    configurable_child.child_instance = configurable_child_instances[ichild];
+    write_binary_fabric_graph_record(fp, configurable_child);
+  }
+
+  for (size_t region = 0; region < body_header.num_config_regions; ++region) {
+    uint64_t first_child = module_manager.region_configurable_children(module, region).front();
+    write_binary_fabric_graph_record(fp, first_child);
+  }
+
+  for (const ModuleNetId& net : module_manager.module_nets(module)) {
+    std::string net_name = module_manager.net_name(module, net);
+
+    BinaryFabricGraphNetHeader net_header;
+    net_header.name_length = uint32_t(net_name.size());
+    net_header.reserved = 0;
+    net_header.num_sources = module_manager.module_net_sources(module, net).size();
+    net_header.num_sinks = module_manager.module_net_sinks(module, net).size();
+    write_binary_fabric_graph_record(fp, net_header);
+    fp.write(net_name.data(), net_name.size());
+
+    for (const ModuleNetSrcId& src : module_manager.module_net_sources(module, net)) {
+      write_binary_fabric_graph_net_terminal(fp,
+                                             module_manager.net_source_module(module, net, src),
+                                             module_manager.net_source_instance(module, net, src),
+                                             module_manager.net_source_port(module, net, src),
+                                             module_manager.net_source_pin(module, net, src));
+    }
+    for (const ModuleNetSinkId& sink : module_manager.module_net_sinks(module, net)) {
+      write_binary_fabric_graph_net_terminal(fp,
+                                             module_manager.net_sink_module(module, net, sink),
+                                             module_manager.net_sink_instance(module, net, sink),
+                                             module_manager.net_sink_port(module, net, sink),
+                                             module_manager.net_sink_pin(module, net, sink));
+    }
+  }
+}
+
+/********************************************************************
+ * Write the fabric graph to a stream in binary format
+ * The fabric graph is written from the current position of the stream,
+ * so that it can be embedded in other binary files, e.g., a context checkpoint
+ *
+ * Return 0 if successful
+ * Return 1 if there are more serious bugs in the fabric graph
+ *******************************************************************/
+int write_binary_fabric_graph_to_stream(std::ostream& fp,
+                                        const ModuleManager& module_manager,
+                                        const DecoderLibrary& decoder_lib,
+                                        const IoLocationMap& io_location_map,
+                                        const DeviceGrid& grids,
+                                        const bool& verbose) {
+  /* Modules are indexed by their ids in the file */
+  size_t num_modules = 0;
+  for (const ModuleId& module : module_manager.modules()) {
+    if (size_t(module) != num_modules) {
+      VTR_LOG_ERROR("Module ids of fabric graph are not contiguous!\n");
+      return 1;
+    }
+    num_modules++;
+  }
+
+  /* I/O indices are visited on each grid location */
+  std::vector<BinaryFabricGraphIoIndex> io_indices;
+  for (size_t ix = 0; ix < grids.width(); ++ix) {
+    for (size_t iy = 0; iy < grids.height(); ++iy) {
+      if (nullptr == grids[ix][iy].type) {
+        continue;
+      }
+      for (int iz = 0; iz < grids[ix][iy].type->capacity; ++iz) {
+        size_t io_index = io_location_map.io_index(ix, iy, iz);
+        if (size_t(-1) == io_index) {
+          continue;
+        }
+        BinaryFabricGraphIoIndex io_index_record;
+        io_index_record.x = ix;
+        io_index_record.y = iy;
+        io_index_record.z = iz;
+        io_index_record.io_index = io_index;
+        io_indices.push_back(io_index_record);
+      }
+    }
+  }
+
+  BinaryFabricGraphHeader header;
+  std::memcpy(header.magic, BINARY_FABRIC_GRAPH_MAGIC, sizeof(BINARY_FABRIC_GRAPH_MAGIC));
+  header.version = BINARY_FABRIC_GRAPH_VERSION;
+  header.reserved = 0;
+  header.grid_width = grids.width();
+  header.grid_height = grids.height();
+  header.num_decoders = decoder_lib.decoders().size();
+  header.num_io_indices = io_indices.size();
+  header.num_modules = num_modules;
+  write_binary_fabric_graph_record(fp, header);
+
+  for (const DecoderId& decoder : decoder_lib.decoders()) {
+    BinaryFabricGraphDecoder decoder_record;
+    std::memset(&decoder_record, 0, sizeof(decoder_record));
+    decoder_record.addr_size = decoder_lib.addr_size(decoder);
+    decoder_record.data_size = decoder_lib.data_size(decoder);
+    decoder_record.use_enable = decoder_lib.use_enable(decoder) ? 1 : 0;
+    decoder_record.use_data_in = decoder_lib.use_data_in(decoder) ? 1 : 0;
+    decoder_record.use_data_inv_port = decoder_lib.use_data_inv_port(decoder) ? 1 : 0;
+    decoder_record.predecode_size = uint8_t(decoder_lib.predecode_size(decoder));
+    write_binary_fabric_graph_record(fp, decoder_record);
+  }
+
+  fp.write(reinterpret_cast<const char*>(io_indices.data()), io_indices.size() * sizeof(BinaryFabricGraphIoIndex));
+
+  for (const ModuleId& module : module_manager.modules()) {
+    write_binary_fabric_graph_module_declaration(fp, module_manager, module);
+  }
+
+  for (const ModuleId& module : module_manager.modules()) {
+    write_binary_fabric_graph_module_body(fp, module_manager, module);
+  }
+
+  VTR_LOGV(verbose,
+           "Wrote %lu modules, %lu decoders and %lu I/O indices\n",
+           num_modules, header.num_decoders, header.num_io_indices);
+
+  return 0;
+}
+
+/********************************************************************
+ * Write the fabric graph to a file in binary format
+ *
+ * Return 0 if successful
+ * Return 1 if there are more serious bugs in the fabric graph
+ *******************************************************************/
+int write_binary_fabric_graph(const ModuleManager& module_manager,
+                              const DecoderLibrary& decoder_lib,
+                              const IoLocationMap& io_location_map,
+                              const DeviceGrid& grids,
+                              const std::string& fname,
+                              const bool& verbose) {
+  std::string timer_message = std::string("Write fabric graph to binary file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  VTR_ASSERT(true != fname.empty());
+
+  /* Create directories */
+  create_directory(format_dir_path(find_path_dir_name(fname)));
+
+  /* Create the file stream */
+  BufferedFileStream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+
+  check_file_stream(fname.c_str(), fp);
+
+  int status = write_binary_fabric_graph_to_stream(fp, module_manager, decoder_lib,
+                                                   io_location_map, grids, verbose);
+
+  /* Close file handler */
+  fp.close();
+
+  return status;
+}
+
+} /* end namespace openfpga */
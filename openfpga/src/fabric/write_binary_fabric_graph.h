@@ -0,0 +1,37 @@
+#ifndef WRITE_BINARY_FABRIC_GRAPH_H
+#define WRITE_BINARY_FABRIC_GRAPH_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <ostream>
+#include <string>
+#include "device_grid.h"
+#include "module_manager.h"
+#include "decoder_library.h"
+#include "io_location_map.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int write_binary_fabric_graph_to_stream(std::ostream& fp,
+                                        const ModuleManager& module_manager,
+                                        const DecoderLibrary& decoder_lib,
+                                        const IoLocationMap& io_location_map,
+                                        const DeviceGrid& grids,
+                                        const bool& verbose);
+
+int write_binary_fabric_graph(const ModuleManager& module_manager,
+                              const DecoderLibrary& decoder_lib,
+                              const IoLocationMap& io_location_map,
+                              const DeviceGrid& grids,
+                              const std::string& fname,
+                              const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
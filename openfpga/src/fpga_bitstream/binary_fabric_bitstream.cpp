@@ -0,0 +1,310 @@
+/******************************************************************************
+ * This file includes member functions for the reader of binary fabric bitstream
+ * and the utilities shared with the writer
+ ******************************************************************************/
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+#include "binary_fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/******************************************************************************
+ * Utilities shared by the reader and the writer
+ ******************************************************************************/
+size_t find_binary_fabric_bitstream_section_num_words(const size_t& num_bits,
+                                                      const size_t& value_length) {
+  return (num_bits * value_length + 63) / 64;
+}
+
+uint64_t update_binary_fabric_bitstream_checksum(const uint64_t& checksum,
+                                                 const uint64_t* words,
+                                                 const size_t& num_words) {
+  uint64_t hash = checksum;
+  for (size_t iword = 0; iword < num_words; ++iword) {
+    hash ^= words[iword];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/******************************************************************************
+ * Run-length tokens of the compressed file
+ * A run token is only used when the run cannot be covered by a literal token
+ ******************************************************************************/
+std::vector<uint16_t> encode_fabric_bitstream_run_length_tokens(const std::vector<bool>& bits) {
+  std::vector<uint16_t> tokens;
+
+  size_t ibit = 0;
+  while (ibit < bits.size()) {
+    size_t run_length = 1;
+    while ( (ibit + run_length < bits.size())
+         && (FABRIC_BITSTREAM_RLE_MAX_RUN_LENGTH > run_length)
+         && (bits[ibit + run_length] == bits[ibit]) ) {
+      run_length++;
+    }
+
+    if (FABRIC_BITSTREAM_RLE_NUM_LITERAL_BITS < run_length) {
+      uint16_t token = FABRIC_BITSTREAM_RLE_RUN_FLAG | uint16_t(run_length - 1);
+      if (true == bits[ibit]) {
+        token |= FABRIC_BITSTREAM_RLE_RUN_VALUE_FLAG;
+      }
+      tokens.push_back(token);
+      ibit += run_length;
+      continue;
+    }
+
+    uint16_t token = 0;
+    for (size_t ilit = 0; (ilit < FABRIC_BITSTREAM_RLE_NUM_LITERAL_BITS) && (ibit < bits.size()); ++ilit, ++ibit) {
+      if (true == bits[ibit]) {
+        token |= uint16_t(1) << ilit;
+      }
+    }
+    tokens.push_back(token);
+  }
+
+  return tokens;
+}
+
+std::vector<bool> decode_fabric_bitstream_run_length_tokens(const std::vector<uint16_t>& tokens,
+                                                            const size_t& num_bits) {
+  std::vector<bool> bits;
+  bits.reserve(num_bits);
+
+  for (const uint16_t& token : tokens) {
+    if (0 != (FABRIC_BITSTREAM_RLE_RUN_FLAG & token)) {
+      size_t run_length = (token & (FABRIC_BITSTREAM_RLE_MAX_RUN_LENGTH - 1)) + 1;
+      bits.insert(bits.end(), std::min(run_length, num_bits - bits.size()),
+                  0 != (FABRIC_BITSTREAM_RLE_RUN_VALUE_FLAG & token));
+      continue;
+    }
+    for (size_t ilit = 0; (ilit < FABRIC_BITSTREAM_RLE_NUM_LITERAL_BITS) && (bits.size() < num_bits); ++ilit) {
+      bits.push_back(1 == ((token >> ilit) & 1));
+    }
+  }
+
+  return bits;
+}
+
+/******************************************************************************
+ * Constructors
+ ******************************************************************************/
+BinaryFabricBitstreamFile::BinaryFabricBitstreamFile()
+  : data_(nullptr)
+  , size_(0)
+  , header_(nullptr)
+  , din_words_(nullptr)
+  , address_words_(nullptr)
+  , wl_address_words_(nullptr)
+  , checksum_words_(nullptr) {
+}
+
+BinaryFabricBitstreamFile::~BinaryFabricBitstreamFile() {
+  close();
+}
+
+/******************************************************************************
+ * Public Mutators
+ ******************************************************************************/
+int BinaryFabricBitstreamFile::open(const std::string& fname, const bool& verify_checksum) {
+  close();
+
+  int fd = ::open(fname.c_str(), O_RDONLY);
+  if (-1 == fd) {
+    VTR_LOG_ERROR("Unable to open binary fabric bitstream file '%s'!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  struct stat file_stat;
+  if ((0 != fstat(fd, &file_stat))
+    || (sizeof(BinaryFabricBitstreamHeader) > size_t(file_stat.st_size))) {
+    VTR_LOG_ERROR("Binary fabric bitstream file '%s' is too small to contain a header!\n",
+                  fname.c_str());
+    ::close(fd);
+    return 1;
+  }
+
+  void* data = mmap(nullptr, size_t(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  /* The mapping remains valid after the file descriptor is closed */
+  ::close(fd);
+  if (MAP_FAILED == data) {
+    VTR_LOG_ERROR("Unable to map binary fabric bitstream file '%s' to memory!\n",
+                  fname.c_str());
+    return 1;
+  }
+  data_ = data;
+  size_ = size_t(file_stat.st_size);
+  header_ = static_cast<const BinaryFabricBitstreamHeader*>(data_);
+
+  /* Validate the header */
+  if ((0 != std::memcmp(header_->magic, BINARY_FABRIC_BITSTREAM_MAGIC, sizeof(BINARY_FABRIC_BITSTREAM_MAGIC)))
+    || (BINARY_FABRIC_BITSTREAM_VERSION != header_->version)) {
+    VTR_LOG_ERROR("File '%s' is not a binary fabric bitstream of version %u!\n",
+                  fname.c_str(), BINARY_FABRIC_BITSTREAM_VERSION);
+    close();
+    return 1;
+  }
+
+  if ((NUM_CONFIG_PROTOCOL_TYPES <= header_->config_protocol_type)
+    || (64 < header_->address_length)
+    || (64 < header_->wl_address_length)) {
+    VTR_LOG_ERROR("Binary fabric bitstream file '%s' has an invalid header!\n",
+                  fname.c_str());
+    close();
+    return 1;
+  }
+
+  /* Each bit takes at least 1 bit of the data input section,
+   * which bounds the sizes of the sections below without any overflow
+   */
+  if ((size_ - sizeof(BinaryFabricBitstreamHeader)) * 8 < header_->num_bits) {
+    VTR_LOG_ERROR("Number of bits (%lu) of binary fabric bitstream file '%s' exceeds its size!\n",
+                  size_t(header_->num_bits), fname.c_str());
+    close();
+    return 1;
+  }
+
+  size_t num_din_words = find_binary_fabric_bitstream_section_num_words(header_->num_bits, 1);
+  size_t num_address_words = find_binary_fabric_bitstream_section_num_words(header_->num_bits, header_->address_length);
+  size_t num_wl_address_words = find_binary_fabric_bitstream_section_num_words(header_->num_bits, header_->wl_address_length);
+  size_t num_payload_words = num_din_words + num_address_words + num_wl_address_words;
+
+  din_words_ = reinterpret_cast<const uint64_t*>(static_cast<const char*>(data_) + sizeof(BinaryFabricBitstreamHeader));
+  address_words_ = din_words_ + num_din_words;
+  wl_address_words_ = address_words_ + num_address_words;
+
+  /* The optional section of segment checksums follows the addresses */
+  size_t payload_size = sizeof(BinaryFabricBitstreamHeader) + num_payload_words * sizeof(uint64_t);
+  if (payload_size + sizeof(uint64_t) <= size_) {
+    checksum_words_ = wl_address_words_ + num_wl_address_words;
+    /* A number of segments larger than the file is reported as a size mismatch below */
+    size_t num_segments = std::min(size_t(checksum_words_[0]), size_ / sizeof(uint64_t));
+    num_payload_words += 1 + num_segments + (num_segments + 1) / 2;
+  }
+
+  if (sizeof(BinaryFabricBitstreamHeader) + num_payload_words * sizeof(uint64_t) != size_) {
+    VTR_LOG_ERROR("Size of binary fabric bitstream file '%s' does not match its header!\n",
+                  fname.c_str());
+    close();
+    return 1;
+  }
+
+  if ((true == verify_checksum)
+    && (header_->checksum != update_binary_fabric_bitstream_checksum(BINARY_FABRIC_BITSTREAM_CHECKSUM_SEED, din_words_, num_payload_words))) {
+    VTR_LOG_ERROR("Checksum mismatch in binary fabric bitstream file '%s'!\n",
+                  fname.c_str());
+    close();
+    return 1;
+  }
+
+  return 0;
+}
+
+void BinaryFabricBitstreamFile::close() {
+  if (nullptr != data_) {
+    munmap(data_, size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  header_ = nullptr;
+  din_words_ = nullptr;
+  address_words_ = nullptr;
+  wl_address_words_ = nullptr;
+  checksum_words_ = nullptr;
+}
+
+/******************************************************************************
+ * Public Accessors
+ ******************************************************************************/
+bool BinaryFabricBitstreamFile::is_open() const {
+  return nullptr != header_;
+}
+
+e_config_protocol_type BinaryFabricBitstreamFile::config_protocol_type() const {
+  VTR_ASSERT(true == is_open());
+  return e_config_protocol_type(header_->config_protocol_type);
+}
+
+size_t BinaryFabricBitstreamFile::num_bits() const {
+  VTR_ASSERT(true == is_open());
+  return header_->num_bits;
+}
+
+size_t BinaryFabricBitstreamFile::address_length() const {
+  VTR_ASSERT(true == is_open());
+  return header_->address_length;
+}
+
+size_t BinaryFabricBitstreamFile::wl_address_length() const {
+  VTR_ASSERT(true == is_open());
+  return header_->wl_address_length;
+}
+
+bool BinaryFabricBitstreamFile::bit_din(const size_t& ibit) const {
+  VTR_ASSERT_SAFE(ibit < num_bits());
+  return 1 == ((din_words_[ibit / 64] >> (ibit % 64)) & 1);
+}
+
+size_t BinaryFabricBitstreamFile::bit_address_value(const size_t& ibit) const {
+  VTR_ASSERT_SAFE(ibit < num_bits());
+  return extract_section_value(address_words_, ibit, header_->address_length);
+}
+
+size_t BinaryFabricBitstreamFile::bit_wl_address_value(const size_t& ibit) const {
+  VTR_ASSERT_SAFE(ibit < num_bits());
+  return extract_section_value(wl_address_words_, ibit, header_->wl_address_length);
+}
+
+size_t BinaryFabricBitstreamFile::num_checksum_segments() const {
+  VTR_ASSERT(true == is_open());
+  return (nullptr == checksum_words_) ? 0 : checksum_words_[0];
+}
+
+size_t BinaryFabricBitstreamFile::checksum_segment_num_bits(const size_t& segment) const {
+  VTR_ASSERT(segment < num_checksum_segments());
+  return checksum_words_[1 + segment];
+}
+
+uint32_t BinaryFabricBitstreamFile::checksum_segment_crc(const size_t& segment) const {
+  VTR_ASSERT(segment < num_checksum_segments());
+  const uint64_t* crc_words = checksum_words_ + 1 + num_checksum_segments();
+  return uint32_t(crc_words[segment / 2] >> (32 * (segment % 2)));
+}
+
+/******************************************************************************
+ * Internal utilities
+ ******************************************************************************/
+size_t BinaryFabricBitstreamFile::extract_section_value(const uint64_t* words,
+                                                        const size_t& ibit,
+                                                        const size_t& value_length) {
+  if (0 == value_length) {
+    return 0;
+  }
+
+  size_t offset = ibit * value_length;
+  size_t word_id = offset / 64;
+  size_t bit_offset = offset % 64;
+
+  uint64_t value = words[word_id] >> bit_offset;
+  /* The value may span over two words */
+  if (64 < bit_offset + value_length) {
+    value |= words[word_id + 1] << (64 - bit_offset);
+  }
+  if (64 > value_length) {
+    value &= (uint64_t(1) << value_length) - 1;
+  }
+  return size_t(value);
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,178 @@
+/******************************************************************************
+ * This file introduces the binary file format of fabric-dependent bitstream
+ * and a reader which maps the file to memory
+ *
+ * File layout
+ * -----------
+ * All the fields are stored in the native byte order (little-endian on all the hosts we support)
+ *
+ *  +--------------------------------------+  offset 0
+ *  | Header (BinaryFabricBitstreamHeader) |
+ *  +--------------------------------------+  offset sizeof(BinaryFabricBitstreamHeader)
+ *  | Data input bits                      |  ceil(num_bits / 64) words
+ *  +--------------------------------------+
+ *  | Addresses (BL address or frame)      |  ceil(num_bits * address_length / 64) words
+ *  +--------------------------------------+
+ *  | WL addresses                         |  ceil(num_bits * wl_address_length / 64) words
+ *  +--------------------------------------+
+ *  | Segment checksums (optional)         |  1 + num_segments + ceil(num_segments / 2) words
+ *  +--------------------------------------+
+ *
+ * Each section is a sequence of 64-bit words where the values of consecutive
+ * configuration bits are packed without any padding:
+ * the value of the i-th bit starts at bit (i * length) of the section
+ * and its least significant bit comes first.
+ * An address value follows the convention of FabricBitstream::bit_address_value(),
+ * i.e., bit j of the value is the j-th character of the address in the plain text file.
+ *
+ * Sections with a zero length (e.g., addresses of a configuration chain) are not stored.
+ * The checksum is computed on all the payload words following the header.
+ *
+ * The segment checksums are only stored when they are built for the fabric bitstream
+ * (see FabricBitstream::num_checksum_segments()). The section starts with the number of segments,
+ * followed by the number of bits of each segment and their CRC-32C, two per word
+ * with the first one in the least significant bits. The CRC-32C of a segment is computed
+ * on the values of its bits packed in bytes, the first bit in the least significant bit,
+ * so that a programmer can verify the readback of each segment.
+ *
+ * Compressed file layout
+ * ----------------------
+ * The compressed file follows the same layout, except that
+ *  - the header is a CompressedFabricBitstreamHeader with a different magic
+ *  - there is no segment checksum
+ *  - the data input bits are encoded as a sequence of 16-bit run-length tokens,
+ *    which are packed into ceil(num_din_tokens / 4) words, the first token in the least significant bits
+ *
+ * A token is decoded as follows:
+ *  - bit 15 is '1': a run of (bits[13:0] + 1) bits whose value is bit 14
+ *  - bit 15 is '0': up to 15 literal bits, the first one in bit 0.
+ *    Only the last token of the stream may hold fewer bits
+ * Most of the configuration bits are zeros (unused multiplexers and default paths),
+ * which are grouped in long runs. The decoder only requires a counter of the remaining bits
+ * so that it can be implemented next to the configuration controller of a chip.
+ ******************************************************************************/
+#ifndef BINARY_FABRIC_BITSTREAM_H
+#define BINARY_FABRIC_BITSTREAM_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "circuit_types.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+constexpr char BINARY_FABRIC_BITSTREAM_MAGIC[8] = {'O', 'F', 'P', 'G', 'A', 'F', 'B', 'S'};
+constexpr uint32_t BINARY_FABRIC_BITSTREAM_VERSION = 1;
+
+struct BinaryFabricBitstreamHeader {
+  char magic[8];
+  uint32_t version;
+  /* Value of e_config_protocol_type */
+  uint32_t config_protocol_type;
+  uint64_t num_bits;
+  /* Length of BL addresses or frame addresses */
+  uint32_t address_length;
+  uint32_t wl_address_length;
+  uint64_t checksum;
+};
+
+/* Find the number of 64-bit words required to pack a section of the binary file */
+size_t find_binary_fabric_bitstream_section_num_words(const size_t& num_bits,
+                                                      const size_t& value_length);
+
+/* Checksum of the payload: FNV-1a hash over the 64-bit payload words */
+constexpr uint64_t BINARY_FABRIC_BITSTREAM_CHECKSUM_SEED = 14695981039346656037ULL;
+
+uint64_t update_binary_fabric_bitstream_checksum(const uint64_t& checksum,
+                                                 const uint64_t* words,
+                                                 const size_t& num_words);
+
+constexpr char COMPRESSED_FABRIC_BITSTREAM_MAGIC[8] = {'O', 'F', 'P', 'G', 'A', 'F', 'B', 'Z'};
+
+struct CompressedFabricBitstreamHeader {
+  /* Same fields as the binary file, except the magic */
+  BinaryFabricBitstreamHeader base;
+  uint64_t num_din_tokens;
+};
+
+/* Fields of a run-length token */
+constexpr uint16_t FABRIC_BITSTREAM_RLE_RUN_FLAG = uint16_t(1) << 15;
+constexpr uint16_t FABRIC_BITSTREAM_RLE_RUN_VALUE_FLAG = uint16_t(1) << 14;
+constexpr size_t FABRIC_BITSTREAM_RLE_MAX_RUN_LENGTH = size_t(1) << 14;
+constexpr size_t FABRIC_BITSTREAM_RLE_NUM_LITERAL_BITS = 15;
+
+/* Encode a sequence of bits into run-length tokens */
+std::vector<uint16_t> encode_fabric_bitstream_run_length_tokens(const std::vector<bool>& bits);
+
+/* Decode run-length tokens into a sequence of bits, which is the reference model of the decompressor */
+std::vector<bool> decode_fabric_bitstream_run_length_tokens(const std::vector<uint16_t>& tokens,
+                                                            const size_t& num_bits);
+
+/******************************************************************************
+ * A read-only view of a binary fabric bitstream file
+ * The file is mapped to memory, so the bits are decoded on demand
+ * without loading or parsing the whole file
+ ******************************************************************************/
+class BinaryFabricBitstreamFile {
+  public: /* Public constructor */
+    BinaryFabricBitstreamFile();
+    ~BinaryFabricBitstreamFile();
+
+    /* The mapping is owned by the object, copy is not allowed */
+    BinaryFabricBitstreamFile(const BinaryFabricBitstreamFile&) = delete;
+    BinaryFabricBitstreamFile& operator=(const BinaryFabricBitstreamFile&) = delete;
+
+  public: /* Public Mutators */
+    /* Map a file to memory and validate its header
+     * When verify_checksum is enabled, the whole payload is scanned once
+     * Return:
+     *  - 0 if succeed
+     *  - 1 if critical errors occured
+     */
+    int open(const std::string& fname, const bool& verify_checksum);
+
+    /* Release the mapping */
+    void close();
+
+  public: /* Public Accessors */
+    bool is_open() const;
+
+    e_config_protocol_type config_protocol_type() const;
+    size_t num_bits() const;
+    size_t address_length() const;
+    size_t wl_address_length() const;
+
+    /* Find the data-in of the i-th bit in the stream */
+    bool bit_din(const size_t& ibit) const;
+
+    /* Find the address of the i-th bit in the stream as a packed integer */
+    size_t bit_address_value(const size_t& ibit) const;
+    size_t bit_wl_address_value(const size_t& ibit) const;
+
+    /* Find the segment checksums, if the file contains them */
+    size_t num_checksum_segments() const;
+    size_t checksum_segment_num_bits(const size_t& segment) const;
+    uint32_t checksum_segment_crc(const size_t& segment) const;
+
+  private: /* Internal utilities */
+    static size_t extract_section_value(const uint64_t* words,
+                                        const size_t& ibit,
+                                        const size_t& value_length);
+
+  private: /* Internal data */
+    void* data_;
+    size_t size_;
+
+    const BinaryFabricBitstreamHeader* header_;
+    const uint64_t* din_words_;
+    const uint64_t* address_words_;
+    const uint64_t* wl_address_words_;
+    /* Optional section of segment checksums, nullptr if the file does not contain them */
+    const uint64_t* checksum_words_;
+};
+
+} /* end namespace openfpga */
+
+#endif
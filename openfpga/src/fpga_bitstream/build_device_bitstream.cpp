@@ -14,6 +14,7 @@
 #include "openfpga_naming.h"
 
 #include "module_manager_utils.h"
+#include "device_shard_utils.h"
 
 #include "build_grid_bitstream.h"
 #include "build_routing_bitstream.h"
@@ -82,12 +83,12 @@ size_t rec_estimate_device_bitstream_num_bits(const ModuleManager& module_manage
   }
 
   /* Memory configuration protocol will have 2 decoders
-   * at the top-level
+   * at the top-level, or only a WL decoder when a word is written at each WL address
    */
   if (CONFIG_MEM_MEMORY_BANK == config_protocol_type) {
     std::string top_block_name = generate_fpga_top_module_name();
     if (top_module == module_manager.find_module(top_block_name)) {
-      num_configurable_children -= 2;
+      num_configurable_children -= find_top_module_num_memory_bank_decoders(module_manager, top_module);
     }
   }
   for (size_t ichild = 0; ichild < num_configurable_children; ++ichild) {
@@ -110,9 +111,22 @@ size_t rec_estimate_device_bitstream_num_bits(const ModuleManager& module_manage
  * Note: this function create a bitstream which is binding to the module graphs
  * of the FPGA fabric that FPGA-X2P generates!
  * But it can be used to output a generic bitstream for VPR mapping FPGA
+ *
+ * The net ids of routing multiplexers are only stored when use_net_ids is enabled,
+ * as they are only required when the bitstream is written to a file
+ *
+ * The grids and routing blocks can be built by a number of threads,
+ * the bitstream is the same regardless of the number of threads
+ *
+ * Only the grids and routing blocks in the shard region are built,
+ * so that the bitstream of a large fabric can be built by several hosts,
+ * each on a shard, and then merged (see merge_architecture_bitstream())
  *******************************************************************/
 BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                                         const OpenfpgaContext& openfpga_ctx,
+                                        const bool& use_net_ids,
+                                        const vtr::Rect<size_t>& shard_region,
+                                        const size_t& num_threads,
                                         const bool& verbose) {
 
   std::string timer_message = std::string("\nBuild fabric-independent bitstream for implementation '") + vpr_ctx.atom().nlist.netlist_name() + std::string("'\n");
@@ -120,6 +134,7 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
 
   /* Bitstream manager to be built */
   BitstreamManager bitstream_manager;
+  bitstream_manager.set_use_net_ids(use_net_ids);
 
   /* Assign the SRAM model applied to the FPGA fabric */
   CircuitModelId sram_model = openfpga_ctx.arch().config_protocol.memory_model();  
@@ -133,18 +148,25 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
   const ModuleId& top_module = openfpga_ctx.module_graph().find_module(top_block_name);
   VTR_ASSERT(true == openfpga_ctx.module_graph().valid_module_id(top_module));
 
+  /* The estimations cover the whole device, which a shard should not reserve */
+  bool full_device = is_device_full_shard_region(vpr_ctx.device().grid, shard_region);
+
   /* Estimate the number of blocks to be added to the database */
   size_t num_blocks_to_reserve = rec_estimate_device_bitstream_num_blocks(openfpga_ctx.module_graph(),
                                                                           top_module);
-  bitstream_manager.reserve_blocks(num_blocks_to_reserve);
-  VTR_LOGV(verbose, "Reserved %lu configurable blocks\n", num_blocks_to_reserve);
+  if (true == full_device) {
+    bitstream_manager.reserve_blocks(num_blocks_to_reserve);
+    VTR_LOGV(verbose, "Reserved %lu configurable blocks\n", num_blocks_to_reserve);
+  }
 
   /* Estimate the number of bits to be added to the database */
   size_t num_bits_to_reserve = rec_estimate_device_bitstream_num_bits(openfpga_ctx.module_graph(),
                                                                       top_module,
                                                                       openfpga_ctx.arch().config_protocol.type());
-  bitstream_manager.reserve_bits(num_bits_to_reserve);
-  VTR_LOGV(verbose, "Reserved %lu configuration bits\n", num_bits_to_reserve);
+  if (true == full_device) {
+    bitstream_manager.reserve_bits(num_bits_to_reserve);
+    VTR_LOGV(verbose, "Reserved %lu configuration bits\n", num_bits_to_reserve);
+  }
 
   /* Reserve child blocks for the top level block */
   bitstream_manager.reserve_child_blocks(top_block,
@@ -161,6 +183,8 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                        openfpga_ctx.vpr_device_annotation(),
                        openfpga_ctx.vpr_clustering_annotation(),
                        openfpga_ctx.vpr_placement_annotation(),
+                       shard_region,
+                       num_threads,
                        verbose);
   VTR_LOGV(verbose, "Done\n");
 
@@ -175,7 +199,9 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                           openfpga_ctx.vpr_routing_annotation(),
                           vpr_ctx.device().rr_graph,
                           openfpga_ctx.device_rr_gsb(),
-                          openfpga_ctx.flow_manager().compress_routing());
+                          openfpga_ctx.flow_manager().compress_routing(),
+                          shard_region,
+                          num_threads);
   VTR_LOGV(verbose, "Done\n");
 
   VTR_LOGV(verbose,
@@ -183,10 +209,84 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
            bitstream_manager.num_bits(),
            bitstream_manager.num_blocks());
 
-  VTR_ASSERT(num_blocks_to_reserve == bitstream_manager.num_blocks());
-  VTR_ASSERT(num_bits_to_reserve == bitstream_manager.num_bits());
+  /* A shard only contains a part of the estimated blocks and bits */
+  if (true == full_device) {
+    VTR_ASSERT(num_blocks_to_reserve == bitstream_manager.num_blocks());
+    VTR_ASSERT(num_bits_to_reserve == bitstream_manager.num_bits());
+  }
+
+  /* Drop any invalid ids so that iterating over blocks and bits is a plain walk */
+  bitstream_manager.compress();
 
   return bitstream_manager;
 }
 
+/********************************************************************
+ * Update the bitstream of a number of grids and GSBs in a device bitstream
+ * which has been built by build_device_bitstream() for the same fabric.
+ * This is much faster than rebuilding the whole device bitstream
+ * when only the placement or routing of a few blocks is changed,
+ * as only the blocks of the given grids and GSBs are visited.
+ * The blocks are updated in place, so that the ids of blocks and bits 
+ * (and therefore the fabric-dependent bitstream) remain valid
+ *
+ * Return the number of bits whose values are changed
+ *******************************************************************/
+size_t update_device_bitstream(BitstreamManager& bitstream_manager,
+                               const VprContext& vpr_ctx,
+                               const OpenfpgaContext& openfpga_ctx,
+                               const std::vector<vtr::Point<size_t>>& grid_coordinates,
+                               const std::vector<vtr::Point<size_t>>& gsb_coordinates,
+                               const bool& verbose) {
+  std::string timer_message = std::string("\nUpdate fabric-independent bitstream for implementation '") + vpr_ctx.atom().nlist.netlist_name() + std::string("'\n");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Find the top-level block, which is the root of the block tree */
+  std::string top_block_name = generate_fpga_top_module_name();
+  ConfigBlockId top_block = ConfigBlockId::INVALID();
+  for (const ConfigBlockId& block : bitstream_manager.blocks()) {
+    if ( (ConfigBlockId::INVALID() == bitstream_manager.block_parent(block))
+      && (top_block_name == bitstream_manager.block_name(block)) ) {
+      top_block = block;
+      break;
+    }
+  }
+  VTR_ASSERT(true == bitstream_manager.valid_block_id(top_block));
+
+  size_t num_changed_bits = 0;
+
+  VTR_LOGV(verbose, "Updating bitstream of %lu grids...\n", grid_coordinates.size());
+  num_changed_bits += update_grid_bitstream(bitstream_manager, top_block,
+                                            openfpga_ctx.module_graph(),
+                                            openfpga_ctx.arch().circuit_lib,
+                                            openfpga_ctx.mux_lib(),
+                                            vpr_ctx.device().grid,
+                                            vpr_ctx.atom(),
+                                            openfpga_ctx.vpr_device_annotation(),
+                                            openfpga_ctx.vpr_clustering_annotation(),
+                                            openfpga_ctx.vpr_placement_annotation(),
+                                            grid_coordinates,
+                                            verbose);
+  VTR_LOGV(verbose, "Done\n");
+
+  VTR_LOGV(verbose, "Updating bitstream of %lu GSBs...\n", gsb_coordinates.size());
+  num_changed_bits += update_routing_bitstream(bitstream_manager, top_block,
+                                               openfpga_ctx.module_graph(),
+                                               openfpga_ctx.arch().circuit_lib,
+                                               openfpga_ctx.mux_lib(),
+                                               vpr_ctx.atom(),
+                                               openfpga_ctx.vpr_device_annotation(),
+                                               openfpga_ctx.vpr_routing_annotation(),
+                                               vpr_ctx.device().rr_graph,
+                                               openfpga_ctx.device_rr_gsb(),
+                                               openfpga_ctx.flow_manager().compress_routing(),
+                                               gsb_coordinates,
+                                               verbose);
+  VTR_LOGV(verbose, "Done\n");
+
+  VTR_LOG("Changed %lu configuration bits\n", num_changed_bits);
+
+  return num_changed_bits;
+}
+
 } /* end namespace openfpga */
@@ -5,6 +5,7 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <vector>
+#include "vtr_geometry.h"
 #include "vpr_context.h"
 #include "openfpga_context.h"
 
@@ -17,8 +18,18 @@ namespace openfpga {
 
 BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                                         const OpenfpgaContext& openfpga_ctx,
+                                        const bool& use_net_ids,
+                                        const vtr::Rect<size_t>& shard_region,
+                                        const size_t& num_threads,
                                         const bool& verbose);
 
+size_t update_device_bitstream(BitstreamManager& bitstream_manager,
+                               const VprContext& vpr_ctx,
+                               const OpenfpgaContext& openfpga_ctx,
+                               const std::vector<vtr::Point<size_t>>& grid_coordinates,
+                               const std::vector<vtr::Point<size_t>>& gsb_coordinates,
+                               const bool& verbose);
+
 } /* end namespace openfpga */
 
 #endif
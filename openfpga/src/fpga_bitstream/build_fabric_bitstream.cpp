@@ -1,6 +1,7 @@
 /********************************************************************
  * This file includes functions to build fabric dependent bitstream
  *******************************************************************/
+#include <fstream>
 #include <string>
 #include <cmath>
 #include <algorithm>
@@ -9,20 +10,28 @@
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
+#include "vtr_crc.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_decode.h"
+#include "openfpga_digest.h"
 
 #include "openfpga_reserved_words.h"
 #include "openfpga_naming.h"
 
 #include "decoder_library_utils.h"
+#include "module_manager_utils.h"
 #include "bitstream_manager_utils.h"
 #include "build_fabric_bitstream.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * Size of the buffer which accumulates the bits before they are written to the file
+ *******************************************************************/
+constexpr size_t FABRIC_BITSTREAM_STREAM_BUFFER_SIZE = 1 << 20;
+
 /********************************************************************
  * This function aims to build a bitstream for configuration chain-like protocol
  * It will walk through all the configurable children under a module
@@ -33,19 +42,28 @@ namespace openfpga {
  * consistent with the block names in bitstream manager
  * We use this link to reorganize the bitstream in the sequence of memories as we stored
  * in the configurable_children() and configurable_child_instances() of each module of module manager 
+ *
+ * Each configuration bit is passed to add_bit(config_bit), so that the bits
+ * can be either stored in a fabric bitstream or written to a file on the fly.
+ * When reverse_order is enabled, the children and the bits are visited backward,
+ * which provides the reversed sequence without storing it first
  *******************************************************************/
+template<class AddBitFunc>
 static 
 void rec_build_module_fabric_dependent_chain_bitstream(const BitstreamManager& bitstream_manager,
                                                        const ConfigBlockId& parent_block,
                                                        const ModuleManager& module_manager,
                                                        const ModuleId& parent_module,
-                                                       FabricBitstream& fabric_bitstream) {
+                                                       const bool& reverse_order,
+                                                       const AddBitFunc& add_bit) {
 
   /* Depth-first search: if we have any children in the parent_block, 
    * we dive to the next level first! 
    */
   if (0 < bitstream_manager.block_children(parent_block).size()) {
-    for (size_t child_id = 0; child_id < module_manager.configurable_children(parent_module).size(); ++child_id) {
+    size_t num_configurable_children = module_manager.configurable_children(parent_module).size();
+    for (size_t ichild = 0; ichild < num_configurable_children; ++ichild) {
+      size_t child_id = (true == reverse_order) ? num_configurable_children - 1 - ichild : ichild;
       ModuleId child_module = module_manager.configurable_children(parent_module)[child_id]; 
       size_t child_instance = module_manager.configurable_child_instances(parent_module)[child_id]; 
       /* Get the instance name and ensure it is not empty */
@@ -60,7 +78,7 @@ void rec_build_module_fabric_dependent_chain_bitstream(const BitstreamManager& b
       /* Go recursively */
       rec_build_module_fabric_dependent_chain_bitstream(bitstream_manager, child_block,
                                                         module_manager, child_module,
-                                                        fabric_bitstream);
+                                                        reverse_order, add_bit);
     }
     /* Ensure that there should be no configuration bits in the parent block */
     VTR_ASSERT(0 == bitstream_manager.block_bits(parent_block).size());
@@ -70,8 +88,12 @@ void rec_build_module_fabric_dependent_chain_bitstream(const BitstreamManager& b
    * We add the configuration bits to the fabric_bitstream,
    * And then, we can return
    */
-  for (const ConfigBitId& config_bit : bitstream_manager.block_bits(parent_block)) {
-    fabric_bitstream.add_bit(config_bit);
+  std::vector<ConfigBitId> block_bits = bitstream_manager.block_bits(parent_block);
+  if (true == reverse_order) {
+    std::reverse(block_bits.begin(), block_bits.end());
+  }
+  for (const ConfigBitId& config_bit : block_bits) {
+    add_bit(config_bit);
   }
 }
 
@@ -89,6 +111,9 @@ void rec_build_module_fabric_dependent_chain_bitstream(const BitstreamManager& b
  * In such configuration organization, each memory cell has an unique index.
  * Using this index, we can infer the address codes for both BL and WL decoders.
  * Note that, we must get the number of BLs and WLs before using this function!
+ * When a word is written at each WL address, the BL address is the position 
+ * of the bit in the data word, i.e., the BL which is driven by the data input.
+ * The decoders at the end of the configurable children of the top module are skipped.
  *******************************************************************/
 static 
 void rec_build_module_fabric_dependent_memory_bank_bitstream(const BitstreamManager& bitstream_manager,
@@ -100,6 +125,7 @@ void rec_build_module_fabric_dependent_memory_bank_bitstream(const BitstreamMana
                                                              const size_t& wl_addr_size,
                                                              const size_t& num_bls,
                                                              const size_t& num_wls, 
+                                                             const size_t& num_top_decoders, 
                                                              size_t& cur_mem_index,
                                                              FabricBitstream& fabric_bitstream) {
 
@@ -107,13 +133,13 @@ void rec_build_module_fabric_dependent_memory_bank_bitstream(const BitstreamMana
    * we dive to the next level first! 
    */
   if (0 < bitstream_manager.block_children(parent_block).size()) {
-    /* For top module, we will skip the two decoders at the end of the configurable children list */
+    /* For top module, we will skip the decoders at the end of the configurable children list */
     std::vector<ModuleId> configurable_children = module_manager.configurable_children(parent_module);
 
     size_t num_configurable_children = configurable_children.size();
     if (parent_module == top_module) {
-      VTR_ASSERT(2 <= configurable_children.size()); 
-      num_configurable_children -= 2;
+      VTR_ASSERT(num_top_decoders <= configurable_children.size()); 
+      num_configurable_children -= num_top_decoders;
     }
 
     /* Early exit if there is no configurable children */
@@ -140,6 +166,7 @@ void rec_build_module_fabric_dependent_memory_bank_bitstream(const BitstreamMana
                                                               module_manager, top_module, child_module,
                                                               bl_addr_size, wl_addr_size,
                                                               num_bls, num_wls,
+                                                              num_top_decoders,
                                                               cur_mem_index,
                                                               fabric_bitstream);
     }
@@ -158,17 +185,17 @@ void rec_build_module_fabric_dependent_memory_bank_bitstream(const BitstreamMana
   
     /* Find BL address */
     size_t cur_bl_index = std::floor(cur_mem_index / num_bls);
-    std::vector<char> bl_addr_bits_vec = itobin_charvec(cur_bl_index, bl_addr_size);
+    VTR_ASSERT_SAFE( (bl_addr_size >= 8 * sizeof(size_t)) || (cur_bl_index < (size_t(1) << bl_addr_size)) );
 
     /* Find WL address */
     size_t cur_wl_index = cur_mem_index % num_wls;
-    std::vector<char> wl_addr_bits_vec = itobin_charvec(cur_wl_index, wl_addr_size);
+    VTR_ASSERT_SAFE( (wl_addr_size >= 8 * sizeof(size_t)) || (cur_wl_index < (size_t(1) << wl_addr_size)) );
 
-    /* Set BL address */
-    fabric_bitstream.set_bit_bl_address(fabric_bit, bl_addr_bits_vec);
+    /* Set BL address, which is stored as the packed integer */
+    fabric_bitstream.set_bit_bl_address_value(fabric_bit, cur_bl_index);
 
     /* Set WL address */
-    fabric_bitstream.set_bit_wl_address(fabric_bit, wl_addr_bits_vec);
+    fabric_bitstream.set_bit_wl_address_value(fabric_bit, cur_wl_index);
     
     /* Set data input */
     fabric_bitstream.set_bit_din(fabric_bit, bitstream_manager.bit_value(config_bit));
@@ -244,9 +271,10 @@ void rec_build_module_fabric_dependent_frame_bitstream(const BitstreamManager& b
       decoder_module = module_manager.configurable_children(parent_module).back();
 
       /* The address code size is the max. of address port of all the configurable children */
+      ModulePortNameId addr_port_name_id = module_manager.find_port_name_id(std::string(DECODER_ADDRESS_PORT_NAME));
       for (size_t child_id = 0; child_id < num_configurable_children; ++child_id) {
         ModuleId child_module = module_manager.configurable_children(parent_module)[child_id]; 
-        const ModulePortId& child_addr_port_id = module_manager.find_module_port(child_module, std::string(DECODER_ADDRESS_PORT_NAME));
+        const ModulePortId& child_addr_port_id = module_manager.find_module_port(child_module, addr_port_name_id);
         const BasicPort& child_addr_port = module_manager.module_port(child_module, child_addr_port_id);
         max_child_addr_code_size = std::max((int)child_addr_port.get_width(), (int)max_child_addr_code_size);
       } 
@@ -384,57 +412,105 @@ void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protoc
 
     rec_build_module_fabric_dependent_chain_bitstream(bitstream_manager, top_block,
                                                       module_manager, top_module, 
-                                                      fabric_bitstream);
+                                                      false,
+                                                      [&](const ConfigBitId& config_bit) {
+                                                        fabric_bitstream.add_bit(config_bit);
+                                                      });
     break;
   }
   case CONFIG_MEM_SCAN_CHAIN: { 
     /* Reserve bits before build-up */
     fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
 
-    rec_build_module_fabric_dependent_chain_bitstream(bitstream_manager, top_block,
-                                                      module_manager, top_module, 
-                                                      fabric_bitstream);
-    fabric_bitstream.reverse();
+    /* The last bit of the chain is loaded first */
+    if (1 == module_manager.num_config_regions(top_module)) {
+      rec_build_module_fabric_dependent_chain_bitstream(bitstream_manager, top_block,
+                                                        module_manager, top_module, 
+                                                        true,
+                                                        [&](const ConfigBitId& config_bit) {
+                                                          fabric_bitstream.add_bit(config_bit);
+                                                        });
+      break;
+    }
+
+    /* Each configuration region is a separated chain, whose bits are stored as a region */
+    for (size_t region = 0; region < module_manager.num_config_regions(top_module); ++region) {
+      if (0 < region) {
+        fabric_bitstream.add_region();
+      }
+      std::vector<size_t> region_children = module_manager.region_configurable_children(top_module, region);
+      for (auto child_it = region_children.rbegin(); child_it != region_children.rend(); ++child_it) {
+        ModuleId child_module = module_manager.configurable_children(top_module)[*child_it]; 
+        size_t child_instance = module_manager.configurable_child_instances(top_module)[*child_it]; 
+        std::string instance_name = module_manager.instance_name(top_module, child_module, child_instance);
+        ConfigBlockId child_block = bitstream_manager.find_child_block(top_block, instance_name); 
+        VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
+
+        rec_build_module_fabric_dependent_chain_bitstream(bitstream_manager, child_block,
+                                                          module_manager, child_module, 
+                                                          true,
+                                                          [&](const ConfigBitId& config_bit) {
+                                                            fabric_bitstream.add_bit(config_bit);
+                                                          });
+      }
+    }
     break;
   }
   case CONFIG_MEM_MEMORY_BANK: { 
 
     size_t cur_mem_index = 0;
-    /* Find BL address port size */
-    ModulePortId bl_addr_port = module_manager.find_module_port(top_module, std::string(DECODER_BL_ADDRESS_PORT_NAME));
-    BasicPort bl_addr_port_info = module_manager.module_port(top_module, bl_addr_port);
 
     /* Find WL address port size */
     ModulePortId wl_addr_port = module_manager.find_module_port(top_module, std::string(DECODER_WL_ADDRESS_PORT_NAME));
     BasicPort wl_addr_port_info = module_manager.module_port(top_module, wl_addr_port);
 
-    /* Find BL and WL decoders which are the last two configurable children*/
+    /* Find BL and WL decoders which are the last configurable children
+     * When a word is written at each WL address, there is only a WL decoder
+     * and the BLs are driven by the data input port of the top module
+     */
+    size_t num_top_decoders = find_top_module_num_memory_bank_decoders(module_manager, top_module);
+    bool word_din = (1 == num_top_decoders);
     std::vector<ModuleId> configurable_children = module_manager.configurable_children(top_module);
-    VTR_ASSERT(2 <= configurable_children.size()); 
-    ModuleId bl_decoder_module = configurable_children[configurable_children.size() - 2];
-    VTR_ASSERT(0 == module_manager.configurable_child_instances(top_module)[configurable_children.size() - 2]);
+    VTR_ASSERT(num_top_decoders <= configurable_children.size()); 
     ModuleId wl_decoder_module = configurable_children[configurable_children.size() - 1];
     VTR_ASSERT(0 == module_manager.configurable_child_instances(top_module)[configurable_children.size() - 1]);
 
-    ModulePortId bl_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
-    BasicPort bl_port_info = module_manager.module_port(bl_decoder_module, bl_port);
-
     ModulePortId wl_port = module_manager.find_module_port(wl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
     BasicPort wl_port_info = module_manager.module_port(wl_decoder_module, wl_port);
 
+    BasicPort bl_port_info;
+    size_t bl_addr_size = 0;
+    if (true == word_din) {
+      ModulePortId din_port = module_manager.find_module_port(top_module, std::string(DECODER_DATA_IN_PORT_NAME));
+      bl_port_info = module_manager.module_port(top_module, din_port);
+      bl_addr_size = find_mux_local_decoder_addr_size(bl_port_info.get_width());
+    } else {
+      /* Find BL address port size */
+      ModulePortId bl_addr_port = module_manager.find_module_port(top_module, std::string(DECODER_BL_ADDRESS_PORT_NAME));
+      bl_addr_size = module_manager.module_port(top_module, bl_addr_port).get_width();
+
+      ModuleId bl_decoder_module = configurable_children[configurable_children.size() - 2];
+      VTR_ASSERT(0 == module_manager.configurable_child_instances(top_module)[configurable_children.size() - 2]);
+      ModulePortId bl_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
+      bl_port_info = module_manager.module_port(bl_decoder_module, bl_port);
+    }
+
     /* Reserve bits before build-up */
     fabric_bitstream.set_use_address(true);
     fabric_bitstream.set_use_wl_address(true);
-    fabric_bitstream.set_bl_address_length(bl_addr_port_info.get_width());
+    fabric_bitstream.set_use_word_din(word_din);
+    fabric_bitstream.set_bl_address_length(bl_addr_size);
     fabric_bitstream.set_wl_address_length(wl_addr_port_info.get_width());
+    fabric_bitstream.set_word_din_length(bl_port_info.get_width());
     fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
 
     rec_build_module_fabric_dependent_memory_bank_bitstream(bitstream_manager, top_block,
                                                             module_manager, top_module, top_module, 
-                                                            bl_addr_port_info.get_width(),
+                                                            bl_addr_size,
                                                             wl_addr_port_info.get_width(),
                                                             bl_port_info.get_width(),
                                                             wl_port_info.get_width(),
+                                                            num_top_decoders,
                                                             cur_mem_index, fabric_bitstream);
     break;
   }
@@ -529,7 +605,201 @@ FabricBitstream build_fabric_dependent_bitstream(const BitstreamManager& bitstre
            "Built %lu configuration bits for fabric\n",
            fabric_bitstream.num_bits());
 
+  /* Drop any invalid ids so that iterating over bits is a plain walk */
+  fabric_bitstream.compress();
+
   return fabric_bitstream;
 }
 
+/********************************************************************
+ * Write the fabric-dependent bitstream of a configuration chain-like protocol
+ * to a plain text file while walking through the fabric,
+ * without storing the sequence of bits in a fabric bitstream.
+ * The peak memory therefore does not depend on the number of configuration bits.
+ * The file is the same as the output of write_fabric_bitstream_to_text_file()
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int write_fabric_dependent_chain_bitstream_to_text_file(const BitstreamManager& bitstream_manager,
+                                                        const ModuleManager& module_manager,
+                                                        const ConfigProtocol& config_protocol,
+                                                        const std::string& fname,
+                                                        const bool& verbose) {
+  if ( (CONFIG_MEM_STANDALONE != config_protocol.type())
+    && (CONFIG_MEM_SCAN_CHAIN != config_protocol.type()) ) {
+    VTR_LOG_ERROR("Streaming fabric bitstream is only supported by standalone and configuration chain protocols!\n");
+    return 1;
+  }
+
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to output bitstream!\n\tPlease specify a valid file name.\n");
+    return 1;
+  }
+
+  std::string timer_message = std::string("Write fabric dependent bitstream into plain text file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Get the top module name in module manager, which is our starting point */
+  std::string top_module_name = generate_fpga_top_module_name();
+  ModuleId top_module = module_manager.find_module(top_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(top_module));
+
+  /* Find the top block in bitstream manager, which has not parents */
+  std::vector<ConfigBlockId> top_block = find_bitstream_manager_top_blocks(bitstream_manager);
+  /* Make sure we have only 1 top block and its name matches the top module */
+  VTR_ASSERT(1 == top_block.size());
+  VTR_ASSERT(0 == top_module_name.compare(bitstream_manager.block_name(top_block[0])));
+
+  /* The bits of multiple configuration regions are interleaved in the file, which requires all the bits */
+  if (1 < module_manager.num_config_regions(top_module)) {
+    VTR_LOG_ERROR("Streaming fabric bitstream is not supported by multiple configuration regions!\n");
+    return 1;
+  }
+
+  /* Create the file stream */
+  BufferedFileStream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+
+  check_file_stream(fname.c_str(), fp);
+
+  /* Bits are formatted into a reusable buffer, which is written to the file when it is full */
+  std::string buffer;
+  buffer.reserve(FABRIC_BITSTREAM_STREAM_BUFFER_SIZE);
+  size_t num_bits = 0;
+
+  rec_build_module_fabric_dependent_chain_bitstream(bitstream_manager, top_block[0],
+                                                    module_manager, top_module,
+                                                    CONFIG_MEM_SCAN_CHAIN == config_protocol.type(),
+                                                    [&](const ConfigBitId& config_bit) {
+                                                      buffer.push_back(bitstream_manager.bit_value(config_bit) ? '1' : '0');
+                                                      num_bits++;
+                                                      if (FABRIC_BITSTREAM_STREAM_BUFFER_SIZE <= buffer.size()) {
+                                                        fp.write(buffer.data(), buffer.size());
+                                                        buffer.clear();
+                                                      }
+                                                    });
+  fp.write(buffer.data(), buffer.size());
+
+  /* Print an end to the file here */
+  fp << "\n";
+
+  /* Close file handler */
+  fp.close();
+
+  VTR_LOGV(verbose,
+           "Outputted %lu configuration bits to plain text file: %s\n",
+           num_bits,
+           fname.c_str());
+
+  return 0;
+}
+
+/********************************************************************
+ * Compute the CRC-32C of the values of a range of fabric bits,
+ * which are packed in bytes where the first bit is the least significant bit.
+ * This is the image of the range read back from the configuration memories
+ *******************************************************************/
+static 
+uint32_t compute_fabric_bitstream_segment_crc(const FabricBitstream& fabric_bitstream,
+                                              const BitstreamManager& bitstream_manager,
+                                              FabricBitstream::fabric_bit_range segment_bits) {
+  uint32_t crc = 0;
+  std::vector<unsigned char> bytes;
+  bytes.reserve(FABRIC_BITSTREAM_STREAM_BUFFER_SIZE);
+
+  size_t num_bits = 0;
+  for (const FabricBitId& fabric_bit : segment_bits) {
+    if (0 == num_bits % 8) {
+      if (FABRIC_BITSTREAM_STREAM_BUFFER_SIZE == bytes.size()) {
+        crc = vtr::crc32c(bytes.data(), bytes.size(), crc);
+        bytes.clear();
+      }
+      bytes.push_back(0);
+    }
+    if (true == bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit))) {
+      bytes.back() |= (unsigned char)(1 << (num_bits % 8));
+    }
+    num_bits++;
+  }
+
+  return vtr::crc32c(bytes.data(), bytes.size(), crc);
+}
+
+/********************************************************************
+ * Split each configuration region of a fabric-dependent bitstream into
+ * checksum segments of a given number of bits, and compute their CRC-32C.
+ * The last segment of a region may be shorter.
+ * When the segment size is 0, each region is covered by a single checksum
+ *
+ * This function should be called after the bits are final,
+ * i.e., after build_fabric_dependent_bitstream()
+ *******************************************************************/
+void build_fabric_bitstream_checksums(FabricBitstream& fabric_bitstream,
+                                      const BitstreamManager& bitstream_manager,
+                                      const size_t& segment_size,
+                                      const bool& verbose) {
+  fabric_bitstream.clear_checksum_segments();
+
+  for (size_t region = 0; region < fabric_bitstream.num_regions(); ++region) {
+    size_t num_region_bits = fabric_bitstream.region_num_bits(region);
+    size_t region_segment_size = (0 == segment_size) ? num_region_bits : segment_size;
+    for (size_t first_bit = 0; first_bit < num_region_bits; first_bit += region_segment_size) {
+      fabric_bitstream.add_checksum_segment(std::min(region_segment_size, num_region_bits - first_bit), 0);
+    }
+  }
+
+  update_fabric_bitstream_checksums(fabric_bitstream, bitstream_manager);
+
+  VTR_LOGV(verbose,
+           "Built %lu checksums for fabric bitstream\n",
+           fabric_bitstream.num_checksum_segments());
+}
+
+/********************************************************************
+ * Recompute the CRC-32C of the checksum segments of a fabric-dependent bitstream
+ * after the values of bits in the bitstream manager are changed
+ *******************************************************************/
+void update_fabric_bitstream_checksums(FabricBitstream& fabric_bitstream,
+                                       const BitstreamManager& bitstream_manager) {
+  for (size_t segment = 0; segment < fabric_bitstream.num_checksum_segments(); ++segment) {
+    fabric_bitstream.set_checksum_segment_crc(segment, 
+                                              compute_fabric_bitstream_segment_crc(fabric_bitstream, bitstream_manager,
+                                                                                   fabric_bitstream.checksum_segment_bits(segment)));
+  }
+}
+
+/********************************************************************
+ * Update the data inputs of a fabric-dependent bitstream
+ * after the values of bits in the bitstream manager are changed,
+ * e.g., by update_device_bitstream().
+ * The addresses only depend on the fabric, so they are not changed.
+ * Note that data inputs are only stored for the configuration protocols using addresses.
+ * Otherwise, the values are always read from the bitstream manager
+ *
+ * Return the number of fabric bits whose data inputs are changed
+ *******************************************************************/
+size_t update_fabric_dependent_bitstream(FabricBitstream& fabric_bitstream,
+                                         const BitstreamManager& bitstream_manager) {
+  /* The checksums cover the values of bits, which may have changed */
+  update_fabric_bitstream_checksums(fabric_bitstream, bitstream_manager);
+
+  if (false == fabric_bitstream.use_address()) {
+    return 0;
+  }
+
+  size_t num_changed_bits = 0;
+  for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
+    char din = bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit));
+    if (din != fabric_bitstream.bit_din(fabric_bit)) {
+      fabric_bitstream.set_bit_din(fabric_bit, din);
+      num_changed_bits++;
+    }
+  }
+
+  return num_changed_bits;
+}
+
 } /* end namespace openfpga */
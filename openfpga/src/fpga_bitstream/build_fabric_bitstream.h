@@ -4,6 +4,7 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <string>
 #include <vector>
 #include "config_protocol.h"
 #include "bitstream_manager.h"
@@ -22,6 +23,23 @@ FabricBitstream build_fabric_dependent_bitstream(const BitstreamManager& bitstre
                                                  const ConfigProtocol& config_protocol,
                                                  const bool& verbose);
 
+int write_fabric_dependent_chain_bitstream_to_text_file(const BitstreamManager& bitstream_manager,
+                                                        const ModuleManager& module_manager,
+                                                        const ConfigProtocol& config_protocol,
+                                                        const std::string& fname,
+                                                        const bool& verbose);
+
+void build_fabric_bitstream_checksums(FabricBitstream& fabric_bitstream,
+                                      const BitstreamManager& bitstream_manager,
+                                      const size_t& segment_size,
+                                      const bool& verbose);
+
+void update_fabric_bitstream_checksums(FabricBitstream& fabric_bitstream,
+                                       const BitstreamManager& bitstream_manager);
+
+size_t update_fabric_dependent_bitstream(FabricBitstream& fabric_bitstream,
+                                         const BitstreamManager& bitstream_manager);
+
 } /* end namespace openfpga */
 
 #endif
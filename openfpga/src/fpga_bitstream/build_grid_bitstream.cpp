@@ -27,6 +27,7 @@
 #include "module_manager_utils.h"
 
 #include "build_mux_bitstream.h"
+#include "build_parallel_bitstream.h"
 #include "build_grid_bitstream.h"
 
 /* begin namespace openfpga */
@@ -215,6 +216,11 @@ void build_physical_block_pin_interc_bitstream(BitstreamManager& bitstream_manag
     /* Record path ids, input and output nets */
     bitstream_manager.add_path_id_to_block(mux_mem_block, mux_input_pin_id);
 
+    /* Net ids are only recorded when requested */
+    if (false == bitstream_manager.use_net_ids()) {
+      break;
+    }
+
     /* Add input nets */
     std::string input_net_ids;
     
@@ -681,6 +687,11 @@ void build_physical_block_bitstream(BitstreamManager& bitstream_manager,
  * Generate bitstreams for all the grids, including 
  * 1. core grids that sit in the center of the fabric
  * 2. side grids (I/O grids) that sit in the borders for the fabric
+ *
+ * The bitstream of each grid only depends on read-only data,
+ * so the grids can be built by a number of threads
+ *
+ * Only the grids in the shard region are built
  *******************************************************************/
 void build_grid_bitstream(BitstreamManager& bitstream_manager,
                           const ConfigBlockId& top_block,
@@ -692,11 +703,15 @@ void build_grid_bitstream(BitstreamManager& bitstream_manager,
                           const VprDeviceAnnotation& device_annotation,
                           const VprClusteringAnnotation& cluster_annotation,
                           const VprPlacementAnnotation& place_annotation,
+                          const vtr::Rect<size_t>& shard_region,
+                          const size_t& num_threads,
                           const bool& verbose) {
 
-  VTR_LOGV(verbose, "Generating bitstream for core grids...");
+  /* Collect the grids and their border sides in the order of blocks to be added */
+  std::vector<vtr::Point<size_t>> grid_coordinates;
+  std::vector<e_side> grid_border_sides;
 
-  /* Generate bitstream for the core logic block one by one */
+  /* Core logic blocks */
   for (size_t ix = 1; ix < grids.width() - 1; ++ix) {
     for (size_t iy = 1; iy < grids.height() - 1; ++iy) {
       /* Bypass EMPTY grid */
@@ -710,19 +725,15 @@ void build_grid_bitstream(BitstreamManager& bitstream_manager,
       }
       /* We should not meet any I/O grid */
       VTR_ASSERT(true != is_io_type(grids[ix][iy].type));
-      /* Add a grid module to top_module*/
-      vtr::Point<size_t> grid_coord(ix, iy);
-      build_physical_block_bitstream(bitstream_manager, top_block, module_manager,
-                                     circuit_lib, mux_lib,
-                                     atom_ctx,
-                                     device_annotation, cluster_annotation,
-                                     place_annotation,
-                                     grids, grid_coord, NUM_SIDES);
+      /* Bypass the grids out of the shard */
+      if (false == shard_region.coincident(vtr::Point<size_t>(ix, iy))) {
+        continue;
+      }
+      grid_coordinates.push_back(vtr::Point<size_t>(ix, iy));
+      grid_border_sides.push_back(NUM_SIDES);
     }
   }
-  VTR_LOGV(verbose, "Done\n");
-
-  VTR_LOGV(verbose, "Generating bitstream for I/O grids...");
+  size_t num_core_grids = grid_coordinates.size();
 
   /* Create the coordinate range for each side of FPGA fabric */
   std::vector<e_side> io_sides{TOP, RIGHT, BOTTOM, LEFT};
@@ -748,7 +759,7 @@ void build_grid_bitstream(BitstreamManager& bitstream_manager,
     io_coordinates[LEFT].push_back(vtr::Point<size_t>(0, iy));
   }
 
-  /* Add instances of I/O grids to top_module */
+  /* I/O grids */
   for (const e_side& io_side : io_sides) {
     for (const vtr::Point<size_t>& io_coordinate : io_coordinates[io_side]) {
       /* Bypass EMPTY grid */
@@ -760,15 +771,91 @@ void build_grid_bitstream(BitstreamManager& bitstream_manager,
         || (0 < grids[io_coordinate.x()][io_coordinate.y()].height_offset) ) {
         continue;
       }
-      build_physical_block_bitstream(bitstream_manager, top_block, module_manager,
-                                     circuit_lib, mux_lib,
-                                     atom_ctx,
-                                     device_annotation, cluster_annotation, 
-                                     place_annotation,
-                                     grids, io_coordinate, io_side);
+      /* Bypass the grids out of the shard */
+      if (false == shard_region.coincident(io_coordinate)) {
+        continue;
+      }
+      grid_coordinates.push_back(io_coordinate);
+      grid_border_sides.push_back(io_side);
     }
   }
+
+  VTR_LOGV(verbose, "Generating bitstream for %lu core grids and %lu I/O grids...",
+           num_core_grids, grid_coordinates.size() - num_core_grids);
+
+  build_child_bitstreams(bitstream_manager, top_block, grid_coordinates.size(), num_threads,
+                         [&](BitstreamManager& grid_bitstream_manager,
+                             const ConfigBlockId& parent_block,
+                             const size_t& igrid,
+                             const size_t& ithread) {
+                           (void)ithread;
+                           build_physical_block_bitstream(grid_bitstream_manager, parent_block, module_manager,
+                                                          circuit_lib, mux_lib,
+                                                          atom_ctx,
+                                                          device_annotation, cluster_annotation,
+                                                          place_annotation,
+                                                          grids, grid_coordinates[igrid], grid_border_sides[igrid]);
+                         });
+
   VTR_LOGV(verbose, "Done\n");
 }
 
+/********************************************************************
+ * Rebuild the bitstreams of a number of grids,
+ * e.g., when the placement of a few blocks is changed.
+ * The blocks of the grids are updated in place in the bitstream manager,
+ * so that the ids of blocks and bits remain the same
+ *
+ * Return the number of bits whose values are changed
+ *******************************************************************/
+size_t update_grid_bitstream(BitstreamManager& bitstream_manager,
+                             const ConfigBlockId& top_block,
+                             const ModuleManager& module_manager,
+                             const CircuitLibrary& circuit_lib,
+                             const MuxLibrary& mux_lib,
+                             const DeviceGrid& grids,
+                             const AtomContext& atom_ctx,
+                             const VprDeviceAnnotation& device_annotation,
+                             const VprClusteringAnnotation& cluster_annotation,
+                             const VprPlacementAnnotation& place_annotation,
+                             const std::vector<vtr::Point<size_t>>& grid_coordinates,
+                             const bool& verbose) {
+  size_t num_changed_bits = 0;
+  vtr::Point<size_t> device_size(grids.width(), grids.height());
+
+  for (const vtr::Point<size_t>& coordinate : grid_coordinates) {
+    VTR_ASSERT( (coordinate.x() < grids.width())
+             && (coordinate.y() < grids.height()) );
+
+    /* The bitstream of a tile (width > 1 or height > 1) is built at its root grid */
+    vtr::Point<size_t> grid_coord(coordinate.x() - grids[coordinate.x()][coordinate.y()].width_offset,
+                                  coordinate.y() - grids[coordinate.x()][coordinate.y()].height_offset);
+
+    /* Bypass EMPTY grid */
+    if (true == is_empty_type(grids[grid_coord.x()][grid_coord.y()].type)) {
+      VTR_LOGV(verbose, "Skip empty grid[%lu][%lu]\n",
+               grid_coord.x(), grid_coord.y());
+      continue;
+    } 
+
+    BitstreamManager grid_bitstream_manager;
+    grid_bitstream_manager.set_use_net_ids(bitstream_manager.use_net_ids());
+    ConfigBlockId grid_top_block = grid_bitstream_manager.add_block(std::string());
+
+    build_physical_block_bitstream(grid_bitstream_manager, grid_top_block, module_manager,
+                                   circuit_lib, mux_lib,
+                                   atom_ctx,
+                                   device_annotation, cluster_annotation,
+                                   place_annotation,
+                                   grids, grid_coord, find_grid_border_side(device_size, grid_coord));
+
+    size_t num_grid_changed_bits = bitstream_manager.update_child_bitstream(top_block, grid_bitstream_manager, grid_top_block);
+    VTR_LOGV(verbose, "Updated %lu configuration bits of grid[%lu][%lu]\n",
+             num_grid_changed_bits, grid_coord.x(), grid_coord.y());
+    num_changed_bits += num_grid_changed_bits;
+  }
+
+  return num_changed_bits;
+}
+
 } /* end namespace openfpga */
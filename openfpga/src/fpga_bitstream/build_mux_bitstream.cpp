@@ -70,7 +70,7 @@ std::vector<bool> build_cmos_mux_bitstream(const CircuitLibrary& circuit_lib,
   size_t implemented_mux_size = find_mux_implementation_num_inputs(circuit_lib, mux_model, mux_size);
   /* Note that the mux graph is indexed using datapath MUX size!!!! */
   MuxId mux_graph_id = mux_lib.mux_graph(mux_model, mux_size);
-  const MuxGraph mux_graph = mux_lib.mux_graph(mux_graph_id);
+  const MuxGraph& mux_graph = mux_lib.mux_graph(mux_graph_id);
 
   size_t datapath_id = path_id;
 
@@ -85,13 +85,10 @@ std::vector<bool> build_cmos_mux_bitstream(const CircuitLibrary& circuit_lib,
   /* We should have only one output for this MUX! */
   VTR_ASSERT(1 == mux_graph.outputs().size());
 
-  /* Generate the memory bits */
+  /* Generate the memory bits, which are looked up from the decode table */
   vtr::vector<MuxMemId, bool> raw_bitstream = mux_graph.decode_memory_bits(MuxInputId(datapath_id), mux_graph.output_id(mux_graph.outputs()[0]));
 
-  std::vector<bool> mux_bitstream;
-  for (const bool& bit : raw_bitstream) {
-    mux_bitstream.push_back(bit);
-  }
+  std::vector<bool> mux_bitstream(raw_bitstream.begin(), raw_bitstream.end());
 
   /* Consider local encoder support, we need further encode the bitstream */
   if (false == circuit_lib.mux_use_local_encoder(mux_model)) {
@@ -170,4 +167,30 @@ std::vector<bool> build_mux_bitstream(const CircuitLibrary& circuit_lib,
   return mux_bitstream;
 }
 
+/********************************************************************
+ * Member functions of MuxBitstreamCache
+ *******************************************************************/
+MuxBitstreamCache::MuxBitstreamCache(const CircuitLibrary& circuit_lib,
+                                     const MuxLibrary& mux_lib)
+  : circuit_lib_(circuit_lib)
+  , mux_lib_(mux_lib) {
+}
+
+bool MuxBitstreamCache::has_mux_bitstream(const CircuitModelId& mux_model,
+                                          const size_t& mux_size,
+                                          const int& path_id) const {
+  return mux_bitstreams_.end() != mux_bitstreams_.find(std::make_tuple(mux_model, mux_size, path_id));
+}
+
+const std::vector<bool>& MuxBitstreamCache::mux_bitstream(const CircuitModelId& mux_model,
+                                                          const size_t& mux_size,
+                                                          const int& path_id) {
+  auto key = std::make_tuple(mux_model, mux_size, path_id);
+  auto result = mux_bitstreams_.find(key);
+  if (mux_bitstreams_.end() == result) {
+    result = mux_bitstreams_.emplace(key, build_mux_bitstream(circuit_lib_, mux_model, mux_lib_, mux_size, path_id)).first;
+  }
+  return result->second;
+}
+
 } /* end namespace openfpga */
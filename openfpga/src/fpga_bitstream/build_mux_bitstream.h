@@ -4,6 +4,8 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <map>
+#include <tuple>
 #include <vector>
 #include "circuit_library.h"
 #include "mux_library.h"
@@ -25,6 +27,33 @@ std::vector<bool> build_mux_bitstream(const CircuitLibrary& circuit_lib,
                                       const size_t& mux_size,
                                       const int& path_id);
 
+/********************************************************************
+ * A cache of the bitstreams of routing multiplexers
+ * The bitstream of a multiplexer only depends on its circuit model,
+ * its datapath size and the selected path. Most multiplexers in a fabric
+ * share a few of such combinations, so the bitstream of each is
+ * decoded only once and then copied to each multiplexer
+ *******************************************************************/
+class MuxBitstreamCache {
+  public: /* Public constructor */
+    MuxBitstreamCache(const CircuitLibrary& circuit_lib,
+                      const MuxLibrary& mux_lib);
+  public: /* Public accessors */
+    /* Check if the bitstream of a multiplexer has already been decoded */
+    bool has_mux_bitstream(const CircuitModelId& mux_model,
+                           const size_t& mux_size,
+                           const int& path_id) const;
+  public: /* Public mutators */
+    /* Find the bitstream of a multiplexer, decode it if not cached yet */
+    const std::vector<bool>& mux_bitstream(const CircuitModelId& mux_model,
+                                           const size_t& mux_size,
+                                           const int& path_id);
+  private: /* Internal data */
+    const CircuitLibrary& circuit_lib_;
+    const MuxLibrary& mux_lib_;
+    std::map<std::tuple<CircuitModelId, size_t, int>, std::vector<bool>> mux_bitstreams_;
+};
+
 } /* end namespace openfpga */
 
 #endif
@@ -0,0 +1,67 @@
+/********************************************************************
+ * A template to build the bitstreams of a number of blocks
+ * which are independent from each other, e.g., grids and routing blocks
+ *******************************************************************/
+#ifndef BUILD_PARALLEL_BITSTREAM_H
+#define BUILD_PARALLEL_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "vtr_parallel.h"
+
+#include "bitstream_manager.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Build the bitstreams of a number of blocks which are added as children of a parent block
+ * The bitstream of each block is built by
+ *   build_child(bitstream_manager, parent_block, child_index, thread_id)
+ * which should only read shared data, apart from the bitstream manager
+ * and the data owned by the thread.
+ *
+ * With a single thread, the bitstream is built directly in the bitstream manager.
+ * Otherwise, each block is built in a separated bitstream manager by a worker,
+ * and then added to the bitstream manager in the order of the blocks,
+ * so that the bitstream is the same regardless of the number of threads
+ *******************************************************************/
+template<class BuildChildFunc>
+void build_child_bitstreams(BitstreamManager& bitstream_manager,
+                            const ConfigBlockId& parent_block,
+                            const size_t& num_children,
+                            const size_t& num_threads,
+                            const BuildChildFunc& build_child) {
+  if ( (1 >= num_threads)
+    || (1 >= num_children) ) {
+    for (size_t ichild = 0; ichild < num_children; ++ichild) {
+      build_child(bitstream_manager, parent_block, ichild, 0);
+    }
+    return;
+  }
+
+  std::vector<BitstreamManager> child_bitstreams(num_children);
+
+  /* Blocks are dispatched on demand, as their sizes vary across the device */
+  vtr::parallel_for_workers(num_children, num_threads, [&](const size_t& ichild, const size_t& ithread) {
+    BitstreamManager& child_bitstream = child_bitstreams[ichild];
+    child_bitstream.set_use_net_ids(bitstream_manager.use_net_ids());
+    ConfigBlockId child_top_block = child_bitstream.add_block(std::string());
+    build_child(child_bitstream, child_top_block, ichild, ithread);
+  });
+
+  for (BitstreamManager& child_bitstream : child_bitstreams) {
+    bitstream_manager.add_child_bitstream(parent_block, child_bitstream, ConfigBlockId(0));
+    /* Release the memory as soon as possible */
+    child_bitstream = BitstreamManager();
+  }
+}
+
+} /* end namespace openfpga */
+
+#endif
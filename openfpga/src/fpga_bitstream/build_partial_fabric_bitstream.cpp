@@ -0,0 +1,156 @@
+/********************************************************************
+ * This file includes functions to build a partial fabric bitstream,
+ * which only contains the frames that are changed w.r.t. a baseline
+ *******************************************************************/
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+#include "binary_fabric_bitstream.h"
+#include "build_partial_fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Check if a baseline bitstream is generated for the same fabric
+ * as a fabric bitstream
+ *******************************************************************/
+static
+bool check_partial_fabric_bitstream_baseline(const BinaryFabricBitstreamFile& baseline,
+                                             const FabricBitstream& fabric_bitstream,
+                                             const ConfigProtocol& config_protocol) {
+  size_t address_length = fabric_bitstream.address_length();
+  size_t wl_address_length = fabric_bitstream.use_wl_address() ? fabric_bitstream.wl_address_length() : 0;
+  return (config_protocol.type() == baseline.config_protocol_type())
+      && (fabric_bitstream.bits().size() == baseline.num_bits())
+      && (address_length == baseline.address_length())
+      && (wl_address_length == baseline.wl_address_length());
+}
+
+/********************************************************************
+ * Build a partial fabric bitstream which only contains the frames
+ * whose contents are different from a baseline, so that a configured
+ * FPGA can be updated by loading much fewer bits than the full bitstream.
+ *
+ * A frame is a group of configuration bits which are consecutive in the
+ * fabric bitstream and belong to the same block, e.g., the memory of a
+ * routing multiplexer or a LUT. A frame is written as a whole when any of its bits
+ * is changed, so that the configuration of each block remains consistent.
+ *
+ * The baseline is a fabric bitstream of the same fabric in binary format,
+ * e.g., the bitstream that is currently loaded to the FPGA.
+ * When there is no baseline, the reset state of the fabric
+ * (all the configuration bits are zero) is considered.
+ *
+ * Only the configuration protocols where each bit is addressable
+ * (frame-based and memory bank) can load a partial bitstream
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int build_partial_fabric_bitstream(FabricBitstream& partial_fabric_bitstream,
+                                   const BitstreamManager& bitstream_manager,
+                                   const FabricBitstream& fabric_bitstream,
+                                   const ConfigProtocol& config_protocol,
+                                   const std::string& baseline_fname,
+                                   const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Build partial fabric bitstream");
+
+  if ( (CONFIG_MEM_FRAME_BASED != config_protocol.type())
+    && (CONFIG_MEM_MEMORY_BANK != config_protocol.type()) ) {
+    VTR_LOG_ERROR("Partial bitstream is only supported by frame-based and memory bank configuration protocols!\n");
+    return 1;
+  }
+  VTR_ASSERT(true == fabric_bitstream.use_address());
+
+  /* Writing a word would overwrite the bits of unchanged frames which share the WL address */
+  if (true == fabric_bitstream.use_word_din()) {
+    VTR_LOG_ERROR("Partial bitstream is not supported by memory banks which write a word at each WL address!\n");
+    return 1;
+  }
+
+  /* Map the baseline to memory, the bits are only decoded when compared */
+  BinaryFabricBitstreamFile baseline;
+  if (false == baseline_fname.empty()) {
+    if (0 != baseline.open(baseline_fname, true)) {
+      return 1;
+    }
+    if (false == check_partial_fabric_bitstream_baseline(baseline, fabric_bitstream, config_protocol)) {
+      VTR_LOG_ERROR("Baseline bitstream '%s' is not generated for the same fabric!\n",
+                    baseline_fname.c_str());
+      return 1;
+    }
+  }
+
+  partial_fabric_bitstream = FabricBitstream();
+  partial_fabric_bitstream.set_use_address(true);
+  partial_fabric_bitstream.set_address_length(fabric_bitstream.address_length());
+  if (true == fabric_bitstream.use_wl_address()) {
+    partial_fabric_bitstream.set_use_wl_address(true);
+    partial_fabric_bitstream.set_wl_address_length(fabric_bitstream.wl_address_length());
+  }
+
+  size_t num_frames = 0;
+  size_t num_changed_frames = 0;
+
+  /* Walk through the frames: [frame_begin, frame_end) are the bits of a frame */
+  std::vector<FabricBitId> fabric_bits(fabric_bitstream.bits().begin(), fabric_bitstream.bits().end());
+  size_t frame_begin = 0;
+  while (frame_begin < fabric_bits.size()) {
+    ConfigBlockId frame_block = bitstream_manager.bit_parent_block(fabric_bitstream.config_bit(fabric_bits[frame_begin]));
+    size_t frame_end = frame_begin;
+    bool frame_changed = false;
+    for (; frame_end < fabric_bits.size(); ++frame_end) {
+      const FabricBitId& fabric_bit = fabric_bits[frame_end];
+      if (frame_block != bitstream_manager.bit_parent_block(fabric_bitstream.config_bit(fabric_bit))) {
+        break;
+      }
+
+      bool baseline_din = false;
+      if (true == baseline.is_open()) {
+        /* The baseline should follow the same sequence of bits */
+        if ( (baseline.bit_address_value(frame_end) != fabric_bitstream.bit_address_value(fabric_bit))
+          || ( (true == fabric_bitstream.use_wl_address())
+            && (baseline.bit_wl_address_value(frame_end) != fabric_bitstream.bit_wl_address_value(fabric_bit)) ) ) {
+          VTR_LOG_ERROR("Address of bit %lu in baseline bitstream '%s' does not match the fabric!\n",
+                        frame_end, baseline_fname.c_str());
+          return 1;
+        }
+        baseline_din = baseline.bit_din(frame_end);
+      }
+      if (baseline_din != bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit))) {
+        frame_changed = true;
+      }
+    }
+    num_frames++;
+
+    /* Output all the bits of a changed frame */
+    if (true == frame_changed) {
+      num_changed_frames++;
+      for (size_t ibit = frame_begin; ibit < frame_end; ++ibit) {
+        const FabricBitId& fabric_bit = fabric_bits[ibit];
+        FabricBitId partial_bit = partial_fabric_bitstream.add_bit(fabric_bitstream.config_bit(fabric_bit));
+        partial_fabric_bitstream.set_bit_address_value(partial_bit, fabric_bitstream.bit_address_value(fabric_bit));
+        if (true == fabric_bitstream.use_wl_address()) {
+          partial_fabric_bitstream.set_bit_wl_address_value(partial_bit, fabric_bitstream.bit_wl_address_value(fabric_bit));
+        }
+        partial_fabric_bitstream.set_bit_din(partial_bit, fabric_bitstream.bit_din(fabric_bit));
+      }
+    }
+
+    frame_begin = frame_end;
+  }
+
+  VTR_LOGV(verbose,
+           "Found %lu changed frames (%lu bits) out of %lu frames (%lu bits) w.r.t. %s\n",
+           num_changed_frames, partial_fabric_bitstream.num_bits(),
+           num_frames, fabric_bits.size(),
+           baseline_fname.empty() ? "the reset state" : baseline_fname.c_str());
+
+  return 0;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,28 @@
+#ifndef BUILD_PARTIAL_FABRIC_BITSTREAM_H
+#define BUILD_PARTIAL_FABRIC_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "config_protocol.h"
+#include "bitstream_manager.h"
+#include "fabric_bitstream.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int build_partial_fabric_bitstream(FabricBitstream& partial_fabric_bitstream,
+                                   const BitstreamManager& bitstream_manager,
+                                   const FabricBitstream& fabric_bitstream,
+                                   const ConfigProtocol& config_protocol,
+                                   const std::string& baseline_fname,
+                                   const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -4,6 +4,7 @@
  * We decode the bitstream from configuration of routing multiplexers 
  * which locate in global routing architecture
  *******************************************************************/
+#include <algorithm>
 #include <vector>
 
 /* Headers from vtrutil library */
@@ -22,6 +23,7 @@
 
 #include "mux_bitstream_constants.h"
 #include "build_mux_bitstream.h"
+#include "build_parallel_bitstream.h"
 #include "build_routing_bitstream.h"
 
 /* begin namespace openfpga */
@@ -38,7 +40,7 @@ void build_switch_block_mux_bitstream(BitstreamManager& bitstream_manager,
                                       const ConfigBlockId& mux_mem_block,
                                       const ModuleManager& module_manager,
                                       const CircuitLibrary& circuit_lib,
-                                      const MuxLibrary& mux_lib,
+                                      MuxBitstreamCache& mux_bitstream_cache,
                                       const RRGraph& rr_graph,
                                       const RRNodeId& cur_rr_node,
                                       const std::vector<RRNodeId>& drive_rr_nodes,
@@ -88,21 +90,35 @@ void build_switch_block_mux_bitstream(BitstreamManager& bitstream_manager,
   VTR_ASSERT(1 == driver_switches.size());
   CircuitModelId mux_model = device_annotation.rr_switch_circuit_model(driver_switches[0]);
 
-  /* Generate bitstream depend on both technology and structure of this MUX */
-  std::vector<bool> mux_bitstream = build_mux_bitstream(circuit_lib, mux_model, mux_lib, datapath_mux_size, path_id); 
+  /* Generate bitstream depend on both technology and structure of this MUX
+   * The bitstream is only decoded for the first MUX of the same kind
+   * and then copied from the cache
+   */
+  bool is_cached = mux_bitstream_cache.has_mux_bitstream(mux_model, datapath_mux_size, path_id);
+  const std::vector<bool>& mux_bitstream = mux_bitstream_cache.mux_bitstream(mux_model, datapath_mux_size, path_id);
 
-  /* Find the module in module manager and ensure the bitstream size matches! */
-  std::string mem_module_name = generate_mux_subckt_name(circuit_lib, mux_model, datapath_mux_size, std::string(MEMORY_MODULE_POSTFIX)); 
-  ModuleId mux_mem_module = module_manager.find_module(mem_module_name); 
-  VTR_ASSERT (true == module_manager.valid_module_id(mux_mem_module));
-  ModulePortId mux_mem_out_port_id = module_manager.find_module_port(mux_mem_module, generate_configurable_memory_data_out_name());
-  VTR_ASSERT(mux_bitstream.size() == module_manager.module_port(mux_mem_module, mux_mem_out_port_id).get_width());
+  /* Find the module in module manager and ensure the bitstream size matches!
+   * The module is the same for all the MUXes of the same kind,
+   * so the check is only done when the bitstream is decoded
+   */
+  if (false == is_cached) {
+    std::string mem_module_name = generate_mux_subckt_name(circuit_lib, mux_model, datapath_mux_size, std::string(MEMORY_MODULE_POSTFIX)); 
+    ModuleId mux_mem_module = module_manager.find_module(mem_module_name); 
+    VTR_ASSERT (true == module_manager.valid_module_id(mux_mem_module));
+    ModulePortId mux_mem_out_port_id = module_manager.find_module_port(mux_mem_module, generate_configurable_memory_data_out_name());
+    VTR_ASSERT(mux_bitstream.size() == module_manager.module_port(mux_mem_module, mux_mem_out_port_id).get_width());
+  }
 
   /* Add the bistream to the bitstream manager */
   bitstream_manager.add_block_bits(mux_mem_block, mux_bitstream);
   /* Record path ids, input and output nets */
   bitstream_manager.add_path_id_to_block(mux_mem_block, path_id);
 
+  /* Net ids are only recorded when requested */
+  if (false == bitstream_manager.use_net_ids()) {
+    return;
+  }
+
   /* Add input nets */
   bool need_splitter = false;
   std::string input_net_ids;
@@ -144,7 +160,7 @@ void build_switch_block_interc_bitstream(BitstreamManager& bitstream_manager,
                                          const ConfigBlockId& sb_configurable_block,
                                          const ModuleManager& module_manager,
                                          const CircuitLibrary& circuit_lib,
-                                         const MuxLibrary& mux_lib,
+                                         MuxBitstreamCache& mux_bitstream_cache,
                                          const RRGraph& rr_graph,
                                          const AtomContext& atom_ctx,
                                          const VprDeviceAnnotation& device_annotation,
@@ -178,7 +194,7 @@ void build_switch_block_interc_bitstream(BitstreamManager& bitstream_manager,
     bitstream_manager.add_child_block(sb_configurable_block, mux_mem_block);
     /* This is a routing multiplexer! Generate bitstream */
     build_switch_block_mux_bitstream(bitstream_manager, mux_mem_block, module_manager,
-                                     circuit_lib, mux_lib, rr_graph, 
+                                     circuit_lib, mux_bitstream_cache, rr_graph, 
                                      cur_rr_node, driver_rr_nodes, 
                                      atom_ctx, device_annotation, routing_annotation);
   } /*Nothing should be done else*/ 
@@ -200,7 +216,7 @@ void build_switch_block_bitstream(BitstreamManager& bitstream_manager,
                                   const ConfigBlockId& sb_config_block,
                                   const ModuleManager& module_manager,
                                   const CircuitLibrary& circuit_lib,
-                                  const MuxLibrary& mux_lib,
+                                  MuxBitstreamCache& mux_bitstream_cache,
                                   const AtomContext& atom_ctx,
                                   const VprDeviceAnnotation& device_annotation,
                                   const VprRoutingAnnotation& routing_annotation,
@@ -219,7 +235,7 @@ void build_switch_block_bitstream(BitstreamManager& bitstream_manager,
       }
       build_switch_block_interc_bitstream(bitstream_manager, sb_config_block, 
                                           module_manager, 
-                                          circuit_lib, mux_lib, rr_graph,
+                                          circuit_lib, mux_bitstream_cache, rr_graph,
                                           atom_ctx, device_annotation, routing_annotation,
                                           rr_gsb, side_manager.get_side(), itrack);
     }
@@ -238,7 +254,7 @@ void build_connection_block_mux_bitstream(BitstreamManager& bitstream_manager,
                                           const ConfigBlockId& mux_mem_block,
                                           const ModuleManager& module_manager,
                                           const CircuitLibrary& circuit_lib,
-                                          const MuxLibrary& mux_lib,
+                                          MuxBitstreamCache& mux_bitstream_cache,
                                           const AtomContext& atom_ctx,
                                           const VprDeviceAnnotation& device_annotation,
                                           const VprRoutingAnnotation& routing_annotation,
@@ -289,21 +305,35 @@ void build_connection_block_mux_bitstream(BitstreamManager& bitstream_manager,
   VTR_ASSERT(1 == driver_switches.size());
   CircuitModelId mux_model = device_annotation.rr_switch_circuit_model(driver_switches[0]);
 
-  /* Generate bitstream depend on both technology and structure of this MUX */
-  std::vector<bool> mux_bitstream = build_mux_bitstream(circuit_lib, mux_model, mux_lib, datapath_mux_size, path_id); 
+  /* Generate bitstream depend on both technology and structure of this MUX
+   * The bitstream is only decoded for the first MUX of the same kind
+   * and then copied from the cache
+   */
+  bool is_cached = mux_bitstream_cache.has_mux_bitstream(mux_model, datapath_mux_size, path_id);
+  const std::vector<bool>& mux_bitstream = mux_bitstream_cache.mux_bitstream(mux_model, datapath_mux_size, path_id);
 
-  /* Find the module in module manager and ensure the bitstream size matches! */
-  std::string mem_module_name = generate_mux_subckt_name(circuit_lib, mux_model, datapath_mux_size, std::string(MEMORY_MODULE_POSTFIX)); 
-  ModuleId mux_mem_module = module_manager.find_module(mem_module_name); 
-  VTR_ASSERT (true == module_manager.valid_module_id(mux_mem_module));
-  ModulePortId mux_mem_out_port_id = module_manager.find_module_port(mux_mem_module, generate_configurable_memory_data_out_name());
-  VTR_ASSERT(mux_bitstream.size() == module_manager.module_port(mux_mem_module, mux_mem_out_port_id).get_width());
+  /* Find the module in module manager and ensure the bitstream size matches!
+   * The module is the same for all the MUXes of the same kind,
+   * so the check is only done when the bitstream is decoded
+   */
+  if (false == is_cached) {
+    std::string mem_module_name = generate_mux_subckt_name(circuit_lib, mux_model, datapath_mux_size, std::string(MEMORY_MODULE_POSTFIX)); 
+    ModuleId mux_mem_module = module_manager.find_module(mem_module_name); 
+    VTR_ASSERT (true == module_manager.valid_module_id(mux_mem_module));
+    ModulePortId mux_mem_out_port_id = module_manager.find_module_port(mux_mem_module, generate_configurable_memory_data_out_name());
+    VTR_ASSERT(mux_bitstream.size() == module_manager.module_port(mux_mem_module, mux_mem_out_port_id).get_width());
+  }
 
   /* Add the bistream to the bitstream manager */
   bitstream_manager.add_block_bits(mux_mem_block, mux_bitstream);
   /* Record path ids, input and output nets */
   bitstream_manager.add_path_id_to_block(mux_mem_block, path_id);
 
+  /* Net ids are only recorded when requested */
+  if (false == bitstream_manager.use_net_ids()) {
+    return;
+  }
+
   /* Add input nets */
   bool need_splitter = false;
   std::string input_net_ids;
@@ -346,7 +376,7 @@ void build_connection_block_interc_bitstream(BitstreamManager& bitstream_manager
                                          const ConfigBlockId& cb_configurable_block,
                                          const ModuleManager& module_manager,
                                          const CircuitLibrary& circuit_lib,
-                                         const MuxLibrary& mux_lib,
+                                         MuxBitstreamCache& mux_bitstream_cache,
                                          const AtomContext& atom_ctx,
                                          const VprDeviceAnnotation& device_annotation,
                                          const VprRoutingAnnotation& routing_annotation,
@@ -369,7 +399,7 @@ void build_connection_block_interc_bitstream(BitstreamManager& bitstream_manager
     bitstream_manager.add_child_block(cb_configurable_block, mux_mem_block);
     /* This is a routing multiplexer! Generate bitstream */
     build_connection_block_mux_bitstream(bitstream_manager, mux_mem_block, 
-                                         module_manager, circuit_lib, mux_lib, 
+                                         module_manager, circuit_lib, mux_bitstream_cache, 
                                          atom_ctx, device_annotation, routing_annotation,
                                          rr_graph, src_rr_node);
   } /*Nothing should be done else*/ 
@@ -391,7 +421,7 @@ void build_connection_block_bitstream(BitstreamManager& bitstream_manager,
                                       const ConfigBlockId& cb_configurable_block,
                                       const ModuleManager& module_manager,
                                       const CircuitLibrary& circuit_lib,
-                                      const MuxLibrary& mux_lib,
+                                      MuxBitstreamCache& mux_bitstream_cache,
                                       const AtomContext& atom_ctx,
                                       const VprDeviceAnnotation& device_annotation,
                                       const VprRoutingAnnotation& routing_annotation,
@@ -407,7 +437,7 @@ void build_connection_block_bitstream(BitstreamManager& bitstream_manager,
     SideManager side_manager(cb_ipin_side);
     for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(cb_ipin_side); ++inode) { 
       build_connection_block_interc_bitstream(bitstream_manager, cb_configurable_block,
-                                              module_manager, circuit_lib, mux_lib, 
+                                              module_manager, circuit_lib, mux_bitstream_cache, 
                                               atom_ctx, device_annotation, routing_annotation,
                                               rr_graph, rr_gsb,
                                               cb_ipin_side, inode);
@@ -415,25 +445,182 @@ void build_connection_block_bitstream(BitstreamManager& bitstream_manager,
   }
 }
 
+/********************************************************************
+ * Create bitstream for the Switch Block of a GSB
+ * and add it as a child of the given parent block
+ *******************************************************************/
+static 
+void build_gsb_switch_block_bitstream(BitstreamManager& bitstream_manager,
+                                      const ConfigBlockId& parent_block,
+                                      const ModuleManager& module_manager,
+                                      const CircuitLibrary& circuit_lib,
+                                      MuxBitstreamCache& mux_bitstream_cache,
+                                      const AtomContext& atom_ctx,
+                                      const VprDeviceAnnotation& device_annotation,
+                                      const VprRoutingAnnotation& routing_annotation,
+                                      const RRGraph& rr_graph,
+                                      const DeviceRRGSB& device_rr_gsb,
+                                      const bool& compact_routing_hierarchy,
+                                      const vtr::Point<size_t>& gsb_coordinate) {
+  const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coordinate);
+
+  vtr::Point<size_t> sb_coord(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+
+  /* Find the sb module so that we can precisely reserve child blocks */
+  std::string sb_module_name = generate_switch_block_module_name(sb_coord);
+  if (true == compact_routing_hierarchy) {
+    vtr::Point<size_t> unique_sb_coord = gsb_coordinate;
+    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(sb_coord);
+    unique_sb_coord.set_x(unique_mirror.get_sb_x()); 
+    unique_sb_coord.set_y(unique_mirror.get_sb_y()); 
+    sb_module_name = generate_switch_block_module_name(unique_sb_coord);
+  } 
+  ModuleId sb_module = module_manager.find_module(sb_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
+
+  /* Create a block for the bitstream which corresponds to the Switch block */
+  ConfigBlockId sb_configurable_block = bitstream_manager.add_block(generate_switch_block_module_name(sb_coord));
+  /* Set switch block as a child of top block */
+  bitstream_manager.add_child_block(parent_block, sb_configurable_block);
+
+  /* Reserve child blocks for new created block */
+  bitstream_manager.reserve_child_blocks(sb_configurable_block,
+                                         count_module_manager_module_configurable_children(module_manager, sb_module)); 
+
+  build_switch_block_bitstream(bitstream_manager, sb_configurable_block, module_manager,  
+                               circuit_lib, mux_bitstream_cache,
+                               atom_ctx, device_annotation, routing_annotation,
+                               rr_graph,
+                               rr_gsb);
+}
+
+/********************************************************************
+ * Create bitstream for the X-direction or Y-direction Connection Block of a GSB
+ * and add it as a child of the given parent block
+ *******************************************************************/
+static 
+void build_gsb_connection_block_bitstream(BitstreamManager& bitstream_manager,
+                                          const ConfigBlockId& parent_block,
+                                          const ModuleManager& module_manager,
+                                          const CircuitLibrary& circuit_lib,
+                                          MuxBitstreamCache& mux_bitstream_cache,
+                                          const AtomContext& atom_ctx,
+                                          const VprDeviceAnnotation& device_annotation,
+                                          const VprRoutingAnnotation& routing_annotation,
+                                          const RRGraph& rr_graph,
+                                          const DeviceRRGSB& device_rr_gsb,
+                                          const bool& compact_routing_hierarchy,
+                                          const t_rr_type& cb_type,
+                                          const vtr::Point<size_t>& gsb_coordinate) {
+  const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coordinate);
+
+  /* Find the cb module so that we can precisely reserve child blocks */
+  vtr::Point<size_t> cb_coord(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
+  std::string cb_module_name = generate_connection_block_module_name(cb_type, cb_coord);
+  if (true == compact_routing_hierarchy) {
+    vtr::Point<size_t> unique_cb_coord = gsb_coordinate;
+    /* Note: use GSB coordinate when inquire for unique modules!!! */
+    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, unique_cb_coord);
+    unique_cb_coord.set_x(unique_mirror.get_cb_x(cb_type)); 
+    unique_cb_coord.set_y(unique_mirror.get_cb_y(cb_type)); 
+    cb_module_name = generate_connection_block_module_name(cb_type, unique_cb_coord);
+  } 
+  ModuleId cb_module = module_manager.find_module(cb_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
+
+  /* Create a block for the bitstream which corresponds to the Switch block */
+  ConfigBlockId cb_configurable_block = bitstream_manager.add_block(generate_connection_block_module_name(cb_type, cb_coord));
+  /* Set switch block as a child of top block */
+  bitstream_manager.add_child_block(parent_block, cb_configurable_block);
+
+  /* Reserve child blocks for new created block */
+  bitstream_manager.reserve_child_blocks(cb_configurable_block,
+                                         count_module_manager_module_configurable_children(module_manager, cb_module)); 
+
+  build_connection_block_bitstream(bitstream_manager, cb_configurable_block, module_manager,  
+                                   circuit_lib, mux_bitstream_cache,
+                                   atom_ctx, device_annotation, routing_annotation,
+                                   rr_graph,
+                                   rr_gsb, cb_type);
+}
+
+/********************************************************************
+ * Create bitstream for all the Switch Blocks
+ * Each Switch Block is built by one of the threads,
+ * which uses its own cache of multiplexer bitstreams
+ *******************************************************************/
+static 
+void build_switch_block_bitstreams(BitstreamManager& bitstream_manager,
+                                   const ConfigBlockId& top_configurable_block,
+                                   const ModuleManager& module_manager,
+                                   const CircuitLibrary& circuit_lib,
+                                   std::vector<MuxBitstreamCache>& mux_bitstream_caches,
+                                   const AtomContext& atom_ctx,
+                                   const VprDeviceAnnotation& device_annotation,
+                                   const VprRoutingAnnotation& routing_annotation,
+                                   const RRGraph& rr_graph,
+                                   const DeviceRRGSB& device_rr_gsb,
+                                   const bool& compact_routing_hierarchy,
+                                   const vtr::Rect<size_t>& shard_region) {
+
+  /* Collect the switch blocks in the order of blocks to be added */
+  std::vector<vtr::Point<size_t>> gsb_coordinates;
+  vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
+  for (size_t ix = 0; ix < sb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < sb_range.y(); ++iy) {
+      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+      /* Check if the switch block exists in the device!
+       * Some of them do NOT exist due to heterogeneous blocks (width > 1) 
+       * We will skip those modules
+       */
+      if (false == rr_gsb.is_sb_exist()) {
+        continue;
+      }
+      /* Bypass the switch blocks out of the shard */
+      if (false == shard_region.coincident(vtr::Point<size_t>(ix, iy))) {
+        continue;
+      }
+      gsb_coordinates.push_back(vtr::Point<size_t>(ix, iy));
+    }
+  }
+
+  build_child_bitstreams(bitstream_manager, top_configurable_block, gsb_coordinates.size(), mux_bitstream_caches.size(),
+                         [&](BitstreamManager& sb_bitstream_manager,
+                             const ConfigBlockId& parent_block,
+                             const size_t& igsb,
+                             const size_t& ithread) {
+                           build_gsb_switch_block_bitstream(sb_bitstream_manager, parent_block, module_manager,
+                                                            circuit_lib, mux_bitstream_caches[ithread],
+                                                            atom_ctx, device_annotation, routing_annotation,
+                                                            rr_graph,
+                                                            device_rr_gsb, compact_routing_hierarchy,
+                                                            gsb_coordinates[igsb]);
+                         });
+}
+
 /********************************************************************
  * Create bitstream for a X-direction or Y-direction Connection Blocks
+ * Each Connection Block is built by one of the threads,
+ * which uses its own cache of multiplexer bitstreams
  *******************************************************************/
 static 
 void build_connection_block_bitstreams(BitstreamManager& bitstream_manager,
                                        const ConfigBlockId& top_configurable_block,
                                        const ModuleManager& module_manager,
                                        const CircuitLibrary& circuit_lib,
-                                       const MuxLibrary& mux_lib,
+                                       std::vector<MuxBitstreamCache>& mux_bitstream_caches,
                                        const AtomContext& atom_ctx,
                                        const VprDeviceAnnotation& device_annotation,
                                        const VprRoutingAnnotation& routing_annotation,
                                        const RRGraph& rr_graph,
                                        const DeviceRRGSB& device_rr_gsb,
                                        const bool& compact_routing_hierarchy,
+                                       const vtr::Rect<size_t>& shard_region,
                                        const t_rr_type& cb_type) {
 
+  /* Collect the connection blocks in the order of blocks to be added */
+  std::vector<vtr::Point<size_t>> gsb_coordinates;
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
-
   for (size_t ix = 0; ix < cb_range.x(); ++ix) {
     for (size_t iy = 0; iy < cb_range.y(); ++iy) {
       const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
@@ -448,37 +635,26 @@ void build_connection_block_bitstreams(BitstreamManager& bitstream_manager,
       if (true == connection_block_contain_only_routing_tracks(rr_gsb, cb_type)) {
         continue;
       }
-
-      /* Find the cb module so that we can precisely reserve child blocks */
-      vtr::Point<size_t> cb_coord(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
-      std::string cb_module_name = generate_connection_block_module_name(cb_type, cb_coord);
-      if (true == compact_routing_hierarchy) {
-        vtr::Point<size_t> unique_cb_coord(ix, iy);
-        /* Note: use GSB coordinate when inquire for unique modules!!! */
-        const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, unique_cb_coord);
-        unique_cb_coord.set_x(unique_mirror.get_cb_x(cb_type)); 
-        unique_cb_coord.set_y(unique_mirror.get_cb_y(cb_type)); 
-        cb_module_name = generate_connection_block_module_name(cb_type, unique_cb_coord);
-      } 
-      ModuleId cb_module = module_manager.find_module(cb_module_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
-
-      /* Create a block for the bitstream which corresponds to the Switch block */
-      ConfigBlockId cb_configurable_block = bitstream_manager.add_block(generate_connection_block_module_name(cb_type, cb_coord));
-      /* Set switch block as a child of top block */
-      bitstream_manager.add_child_block(top_configurable_block, cb_configurable_block);
-
-      /* Reserve child blocks for new created block */
-      bitstream_manager.reserve_child_blocks(cb_configurable_block,
-                                             count_module_manager_module_configurable_children(module_manager, cb_module)); 
-  
-      build_connection_block_bitstream(bitstream_manager, cb_configurable_block, module_manager,  
-                                       circuit_lib, mux_lib,
-                                       atom_ctx, device_annotation, routing_annotation,
-                                       rr_graph,
-                                       rr_gsb, cb_type);
+      /* Bypass the connection blocks out of the shard */
+      if (false == shard_region.coincident(vtr::Point<size_t>(ix, iy))) {
+        continue;
+      }
+      gsb_coordinates.push_back(vtr::Point<size_t>(ix, iy));
     }
   }
+
+  build_child_bitstreams(bitstream_manager, top_configurable_block, gsb_coordinates.size(), mux_bitstream_caches.size(),
+                         [&](BitstreamManager& cb_bitstream_manager,
+                             const ConfigBlockId& parent_block,
+                             const size_t& igsb,
+                             const size_t& ithread) {
+                           build_gsb_connection_block_bitstream(cb_bitstream_manager, parent_block, module_manager,
+                                                                circuit_lib, mux_bitstream_caches[ithread],
+                                                                atom_ctx, device_annotation, routing_annotation,
+                                                                rr_graph,
+                                                                device_rr_gsb, compact_routing_hierarchy,
+                                                                cb_type, gsb_coordinates[igsb]);
+                         });
 }
 
 /********************************************************************
@@ -486,6 +662,11 @@ void build_connection_block_bitstreams(BitstreamManager& bitstream_manager,
  * Two major tasks: 
  * 1. Generate bitstreams for Switch Blocks
  * 2. Generate bitstreams for both X-direction and Y-direction Connection Blocks
+ *
+ * The bitstream of each block only depends on read-only data,
+ * so the blocks can be built by a number of threads
+ *
+ * Only the blocks of the GSBs in the shard region are built
  *******************************************************************/
 void build_routing_bitstream(BitstreamManager& bitstream_manager,
                              const ConfigBlockId& top_configurable_block,
@@ -497,55 +678,29 @@ void build_routing_bitstream(BitstreamManager& bitstream_manager,
                              const VprRoutingAnnotation& routing_annotation,
                              const RRGraph& rr_graph,
                              const DeviceRRGSB& device_rr_gsb,
-                             const bool& compact_routing_hierarchy) {
+                             const bool& compact_routing_hierarchy,
+                             const vtr::Rect<size_t>& shard_region,
+                             const size_t& num_threads) {
+
+  /* Bitstreams of routing multiplexers are shared by all the switch blocks and connection blocks
+   * Each thread owns a cache, so that no lock is required
+   */
+  std::vector<MuxBitstreamCache> mux_bitstream_caches(std::max(num_threads, size_t(1)),
+                                                      MuxBitstreamCache(circuit_lib, mux_lib));
 
   /* Generate bitstream for each switch blocks
    * To organize the bitstream in blocks, we create a block for each switch block 
    * and give names which are same as they are in top-level module managers
    */
   VTR_LOG("Generating bitstream for Switch blocks...");
-  vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
-  for (size_t ix = 0; ix < sb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < sb_range.y(); ++iy) {
-      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
-      /* Check if the switch block exists in the device!
-       * Some of them do NOT exist due to heterogeneous blocks (width > 1) 
-       * We will skip those modules
-       */
-      if (false == rr_gsb.is_sb_exist()) {
-        continue;
-      }
 
-      vtr::Point<size_t> sb_coord(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
-
-      /* Find the sb module so that we can precisely reserve child blocks */
-      std::string sb_module_name = generate_switch_block_module_name(sb_coord);
-      if (true == compact_routing_hierarchy) {
-        vtr::Point<size_t> unique_sb_coord(ix, iy);
-        const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(sb_coord);
-        unique_sb_coord.set_x(unique_mirror.get_sb_x()); 
-        unique_sb_coord.set_y(unique_mirror.get_sb_y()); 
-        sb_module_name = generate_switch_block_module_name(unique_sb_coord);
-      } 
-      ModuleId sb_module = module_manager.find_module(sb_module_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
-
-      /* Create a block for the bitstream which corresponds to the Switch block */
-      ConfigBlockId sb_configurable_block = bitstream_manager.add_block(generate_switch_block_module_name(sb_coord));
-      /* Set switch block as a child of top block */
-      bitstream_manager.add_child_block(top_configurable_block, sb_configurable_block);
-
-      /* Reserve child blocks for new created block */
-      bitstream_manager.reserve_child_blocks(sb_configurable_block,
-                                             count_module_manager_module_configurable_children(module_manager, sb_module)); 
-
-      build_switch_block_bitstream(bitstream_manager, sb_configurable_block, module_manager,  
-                                   circuit_lib, mux_lib,
-                                   atom_ctx, device_annotation, routing_annotation,
-                                   rr_graph,
-                                   rr_gsb);
-    }
-  }
+  build_switch_block_bitstreams(bitstream_manager, top_configurable_block, module_manager,  
+                                circuit_lib, mux_bitstream_caches,
+                                atom_ctx, device_annotation, routing_annotation,
+                                rr_graph,
+                                device_rr_gsb,
+                                compact_routing_hierarchy,
+                                shard_region);
   VTR_LOG("Done\n");
 
   /* Generate bitstream for each connection blocks
@@ -555,25 +710,92 @@ void build_routing_bitstream(BitstreamManager& bitstream_manager,
   VTR_LOG("Generating bitstream for X-direction Connection blocks ...");
 
   build_connection_block_bitstreams(bitstream_manager, top_configurable_block, module_manager,  
-                                    circuit_lib, mux_lib,
+                                    circuit_lib, mux_bitstream_caches,
                                     atom_ctx, device_annotation, routing_annotation,
                                     rr_graph,
                                     device_rr_gsb,
                                     compact_routing_hierarchy,
+                                    shard_region,
                                     CHANX);
   VTR_LOG("Done\n");
 
   VTR_LOG("Generating bitstream for Y-direction Connection blocks ...");
 
   build_connection_block_bitstreams(bitstream_manager, top_configurable_block, module_manager,  
-                                    circuit_lib, mux_lib,
+                                    circuit_lib, mux_bitstream_caches,
                                     atom_ctx, device_annotation, routing_annotation,
                                     rr_graph,
                                     device_rr_gsb,
                                     compact_routing_hierarchy,
+                                    shard_region,
                                     CHANY);
   VTR_LOG("Done\n");
 
 }
 
+/********************************************************************
+ * Rebuild the bitstreams of the Switch Blocks and Connection Blocks of a number of GSBs,
+ * e.g., when the routing of a few nets is changed.
+ * The blocks are updated in place in the bitstream manager,
+ * so that the ids of blocks and bits remain the same
+ *
+ * Return the number of bits whose values are changed
+ *******************************************************************/
+size_t update_routing_bitstream(BitstreamManager& bitstream_manager,
+                                const ConfigBlockId& top_configurable_block,
+                                const ModuleManager& module_manager,
+                                const CircuitLibrary& circuit_lib,
+                                const MuxLibrary& mux_lib,
+                                const AtomContext& atom_ctx,
+                                const VprDeviceAnnotation& device_annotation,
+                                const VprRoutingAnnotation& routing_annotation,
+                                const RRGraph& rr_graph,
+                                const DeviceRRGSB& device_rr_gsb,
+                                const bool& compact_routing_hierarchy,
+                                const std::vector<vtr::Point<size_t>>& gsb_coordinates,
+                                const bool& verbose) {
+  size_t num_changed_bits = 0;
+  MuxBitstreamCache mux_bitstream_cache(circuit_lib, mux_lib);
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+
+  for (const vtr::Point<size_t>& gsb_coordinate : gsb_coordinates) {
+    VTR_ASSERT( (gsb_coordinate.x() < gsb_range.x())
+             && (gsb_coordinate.y() < gsb_range.y()) );
+    const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coordinate);
+
+    BitstreamManager gsb_bitstream_manager;
+    gsb_bitstream_manager.set_use_net_ids(bitstream_manager.use_net_ids());
+    ConfigBlockId gsb_top_block = gsb_bitstream_manager.add_block(std::string());
+
+    if (true == rr_gsb.is_sb_exist()) {
+      build_gsb_switch_block_bitstream(gsb_bitstream_manager, gsb_top_block, module_manager,
+                                       circuit_lib, mux_bitstream_cache,
+                                       atom_ctx, device_annotation, routing_annotation,
+                                       rr_graph,
+                                       device_rr_gsb, compact_routing_hierarchy,
+                                       gsb_coordinate);
+    }
+
+    for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+      if ( (false == rr_gsb.is_cb_exist(cb_type))
+        || (true == connection_block_contain_only_routing_tracks(rr_gsb, cb_type)) ) {
+        continue;
+      }
+      build_gsb_connection_block_bitstream(gsb_bitstream_manager, gsb_top_block, module_manager,
+                                           circuit_lib, mux_bitstream_cache,
+                                           atom_ctx, device_annotation, routing_annotation,
+                                           rr_graph,
+                                           device_rr_gsb, compact_routing_hierarchy,
+                                           cb_type, gsb_coordinate);
+    }
+
+    size_t num_gsb_changed_bits = bitstream_manager.update_child_bitstream(top_configurable_block, gsb_bitstream_manager, gsb_top_block);
+    VTR_LOGV(verbose, "Updated %lu configuration bits of GSB[%lu][%lu]\n",
+             num_gsb_changed_bits, gsb_coordinate.x(), gsb_coordinate.y());
+    num_changed_bits += num_gsb_changed_bits;
+  }
+
+  return num_changed_bits;
+}
+
 } /* end namespace openfpga */
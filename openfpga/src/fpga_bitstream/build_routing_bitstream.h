@@ -8,6 +8,7 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <vector>
+#include "vtr_geometry.h"
 #include "bitstream_manager.h"
 #include "vpr_context.h"
 #include "module_manager.h"
@@ -34,7 +35,23 @@ void build_routing_bitstream(BitstreamManager& bitstream_manager,
                              const VprRoutingAnnotation& routing_annotation,
                              const RRGraph& rr_graph,
                              const DeviceRRGSB& device_rr_gsb,
-                             const bool& compact_routing_hierarchy);
+                             const bool& compact_routing_hierarchy,
+                             const vtr::Rect<size_t>& shard_region,
+                             const size_t& num_threads);
+
+size_t update_routing_bitstream(BitstreamManager& bitstream_manager,
+                                const ConfigBlockId& top_configurable_block,
+                                const ModuleManager& module_manager,
+                                const CircuitLibrary& circuit_lib,
+                                const MuxLibrary& mux_lib,
+                                const AtomContext& atom_ctx,
+                                const VprDeviceAnnotation& device_annotation,
+                                const VprRoutingAnnotation& routing_annotation,
+                                const RRGraph& rr_graph,
+                                const DeviceRRGSB& device_rr_gsb,
+                                const bool& compact_routing_hierarchy,
+                                const std::vector<vtr::Point<size_t>>& gsb_coordinates,
+                                const bool& verbose);
 
 } /* end namespace openfpga */
 
@@ -5,6 +5,7 @@
 
 #include "vtr_assert.h"
 #include "openfpga_decode.h"
+#include "openfpga_memory_footprint.h"
 #include "fabric_bitstream.h"
 
 /* begin namespace openfpga */
@@ -16,8 +17,12 @@ namespace openfpga {
 FabricBitstream::FabricBitstream() {
   num_bits_ = 0;
   invalid_bit_ids_.clear();
+  use_address_ = false;
+  use_wl_address_ = false;
+  use_word_din_ = false;
   address_length_ = 0;
   wl_address_length_ = 0;
+  word_din_length_ = 0;
 }
 
 /**************************************************
@@ -33,6 +38,65 @@ FabricBitstream::fabric_bit_range FabricBitstream::bits() const {
                          fabric_bit_iterator(FabricBitId(num_bits_), invalid_bit_ids_));
 }
 
+size_t FabricBitstream::num_regions() const {
+  return std::max(size_t(1), region_first_bits_.size());
+}
+
+/* Find the configuration bits of a region */
+FabricBitstream::fabric_bit_range FabricBitstream::region_bits(const size_t& region) const {
+  VTR_ASSERT(region < num_regions());
+
+  if (true == region_first_bits_.empty()) {
+    return bits();
+  }
+
+  size_t last_bit = (region + 1 < region_first_bits_.size()) ? region_first_bits_[region + 1] : num_bits_;
+  return vtr::make_range(fabric_bit_iterator(FabricBitId(region_first_bits_[region]), invalid_bit_ids_),
+                         fabric_bit_iterator(FabricBitId(last_bit), invalid_bit_ids_));
+}
+
+size_t FabricBitstream::region_num_bits(const size_t& region) const {
+  VTR_ASSERT(region < num_regions());
+
+  if (true == region_first_bits_.empty()) {
+    return num_bits_ - invalid_bit_ids_.size();
+  }
+
+  size_t first_bit = region_first_bits_[region];
+  size_t last_bit = (region + 1 < region_first_bits_.size()) ? region_first_bits_[region + 1] : num_bits_;
+  size_t num_region_bits = last_bit - first_bit;
+  for (const FabricBitId& invalid_bit : invalid_bit_ids_) {
+    if ( (first_bit <= size_t(invalid_bit))
+      && (size_t(invalid_bit) < last_bit) ) {
+      num_region_bits--;
+    }
+  }
+
+  return num_region_bits;
+}
+
+size_t FabricBitstream::num_checksum_segments() const {
+  return checksum_segment_crcs_.size();
+}
+
+FabricBitstream::fabric_bit_range FabricBitstream::checksum_segment_bits(const size_t& segment) const {
+  VTR_ASSERT(segment < num_checksum_segments());
+
+  size_t last_bit = checksum_segment_first_bits_[segment] + checksum_segment_num_bits_[segment];
+  return vtr::make_range(fabric_bit_iterator(FabricBitId(checksum_segment_first_bits_[segment]), invalid_bit_ids_),
+                         fabric_bit_iterator(FabricBitId(last_bit), invalid_bit_ids_));
+}
+
+size_t FabricBitstream::checksum_segment_num_bits(const size_t& segment) const {
+  VTR_ASSERT(segment < num_checksum_segments());
+  return checksum_segment_num_bits_[segment];
+}
+
+uint32_t FabricBitstream::checksum_segment_crc(const size_t& segment) const {
+  VTR_ASSERT(segment < num_checksum_segments());
+  return checksum_segment_crcs_[segment];
+}
+
 /******************************************************************************
  * Public Accessors
  ******************************************************************************/
@@ -64,6 +128,39 @@ std::vector<char> FabricBitstream::bit_wl_address(const FabricBitId& bit_id) con
   return itobin_charvec(bit_wl_addresses_[bit_id], wl_address_length_);
 }
 
+size_t FabricBitstream::bit_address_value(const FabricBitId& bit_id) const {
+  /* Ensure a valid id */
+  VTR_ASSERT(true == valid_bit_id(bit_id));
+  VTR_ASSERT(true == use_address_);
+
+  return bit_addresses_[bit_id];
+}
+
+size_t FabricBitstream::bit_bl_address_value(const FabricBitId& bit_id) const {
+  return bit_address_value(bit_id);
+}
+
+size_t FabricBitstream::bit_wl_address_value(const FabricBitId& bit_id) const {
+  /* Ensure a valid id */
+  VTR_ASSERT(true == valid_bit_id(bit_id));
+  VTR_ASSERT(true == use_address_);
+  VTR_ASSERT(true == use_wl_address_);
+
+  return bit_wl_addresses_[bit_id];
+}
+
+size_t FabricBitstream::address_length() const {
+  return address_length_;
+}
+
+size_t FabricBitstream::bl_address_length() const {
+  return address_length();
+}
+
+size_t FabricBitstream::wl_address_length() const {
+  return wl_address_length_;
+}
+
 char FabricBitstream::bit_din(const FabricBitId& bit_id) const {
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_bit_id(bit_id));
@@ -80,6 +177,28 @@ bool FabricBitstream::use_wl_address() const {
   return use_wl_address_;
 }
 
+bool FabricBitstream::use_word_din() const {
+  return use_word_din_;
+}
+
+size_t FabricBitstream::word_din_length() const {
+  return word_din_length_;
+}
+
+size_t FabricBitstream::memory_footprint() const {
+  size_t footprint = sizeof(FabricBitstream);
+  footprint += container_footprint(invalid_bit_ids_);
+  footprint += container_footprint(config_bit_ids_);
+  footprint += container_footprint(region_first_bits_);
+  footprint += container_footprint(checksum_segment_first_bits_);
+  footprint += container_footprint(checksum_segment_num_bits_);
+  footprint += container_footprint(checksum_segment_crcs_);
+  footprint += container_footprint(bit_addresses_);
+  footprint += container_footprint(bit_wl_addresses_);
+  footprint += container_footprint(bit_dins_);
+  return footprint;
+}
+
 /******************************************************************************
  * Public Mutators
  ******************************************************************************/
@@ -102,9 +221,47 @@ FabricBitId FabricBitstream::add_bit(const ConfigBitId& config_bit_id) {
   num_bits_++;
   config_bit_ids_.push_back(config_bit_id);
 
+  if (true == use_address_) {
+    bit_addresses_.push_back(0);
+    bit_dins_.push_back(0);
+
+    if (true == use_wl_address_) {
+      bit_wl_addresses_.push_back(0);
+    }
+  }
+
   return bit; 
 }
 
+void FabricBitstream::add_region() {
+  /* The bits added before belong to the first region */
+  if (true == region_first_bits_.empty()) {
+    region_first_bits_.push_back(0);
+  }
+  /* Each region should contain at least one bit */
+  VTR_ASSERT(region_first_bits_.back() < num_bits_);
+  region_first_bits_.push_back(num_bits_);
+}
+
+void FabricBitstream::add_checksum_segment(const size_t& num_bits, const uint32_t& crc) {
+  size_t first_bit = (true == checksum_segment_first_bits_.empty()) ? 0 : checksum_segment_first_bits_.back() + checksum_segment_num_bits_.back();
+  VTR_ASSERT(first_bit + num_bits <= num_bits_);
+  checksum_segment_first_bits_.push_back(first_bit);
+  checksum_segment_num_bits_.push_back(num_bits);
+  checksum_segment_crcs_.push_back(crc);
+}
+
+void FabricBitstream::set_checksum_segment_crc(const size_t& segment, const uint32_t& crc) {
+  VTR_ASSERT(segment < num_checksum_segments());
+  checksum_segment_crcs_[segment] = crc;
+}
+
+void FabricBitstream::clear_checksum_segments() {
+  checksum_segment_first_bits_.clear();
+  checksum_segment_num_bits_.clear();
+  checksum_segment_crcs_.clear();
+}
+
 void FabricBitstream::set_bit_address(const FabricBitId& bit_id,
                                       const std::vector<char>& address) {
   VTR_ASSERT(true == valid_bit_id(bit_id));
@@ -127,6 +284,26 @@ void FabricBitstream::set_bit_wl_address(const FabricBitId& bit_id,
   bit_wl_addresses_[bit_id] = bintoi_charvec(address);
 }
 
+void FabricBitstream::set_bit_address_value(const FabricBitId& bit_id,
+                                            const size_t& address) {
+  VTR_ASSERT(true == valid_bit_id(bit_id));
+  VTR_ASSERT(true == use_address_);
+  bit_addresses_[bit_id] = address;
+}
+
+void FabricBitstream::set_bit_bl_address_value(const FabricBitId& bit_id,
+                                               const size_t& address) {
+  set_bit_address_value(bit_id, address);
+}
+
+void FabricBitstream::set_bit_wl_address_value(const FabricBitId& bit_id,
+                                               const size_t& address) {
+  VTR_ASSERT(true == valid_bit_id(bit_id));
+  VTR_ASSERT(true == use_address_);
+  VTR_ASSERT(true == use_wl_address_);
+  bit_wl_addresses_[bit_id] = address;
+}
+
 void FabricBitstream::set_bit_din(const FabricBitId& bit_id,
                                   const char& din) {
   VTR_ASSERT(true == valid_bit_id(bit_id));
@@ -135,6 +312,10 @@ void FabricBitstream::set_bit_din(const FabricBitId& bit_id,
 }
 
 void FabricBitstream::reverse() {
+  VTR_ASSERT(1 == num_regions());
+
+  clear_checksum_segments();
+
   std::reverse(config_bit_ids_.begin(), config_bit_ids_.end());
 
   if (true == use_address_) {
@@ -147,6 +328,54 @@ void FabricBitstream::reverse() {
   }
 }
 
+void FabricBitstream::compress() {
+  /* Nothing to do when all the ids are valid */
+  if (true == invalid_bit_ids_.empty()) {
+    return;
+  }
+
+  clear_checksum_segments();
+
+  size_t num_valid_bits = 0;
+  size_t next_region = 0;
+  for (size_t ibit = 0; ibit < num_bits_; ++ibit) {
+    /* Regions start from the first valid bit after renumbering */
+    while ( (next_region < region_first_bits_.size())
+         && (region_first_bits_[next_region] == ibit) ) {
+      region_first_bits_[next_region] = num_valid_bits;
+      next_region++;
+    }
+    FabricBitId bit = FabricBitId(ibit);
+    if (0 < invalid_bit_ids_.count(bit)) {
+      continue;
+    }
+    FabricBitId new_bit = FabricBitId(num_valid_bits);
+    config_bit_ids_[new_bit] = config_bit_ids_[bit];
+    if (true == use_address_) {
+      bit_addresses_[new_bit] = bit_addresses_[bit];
+      bit_dins_[new_bit] = bit_dins_[bit];
+
+      if (true == use_wl_address_) {
+        bit_wl_addresses_[new_bit] = bit_wl_addresses_[bit];
+      }
+    }
+    num_valid_bits++;
+  }
+
+  config_bit_ids_.resize(num_valid_bits);
+  if (true == use_address_) {
+    bit_addresses_.resize(num_valid_bits);
+    bit_dins_.resize(num_valid_bits);
+
+    if (true == use_wl_address_) {
+      bit_wl_addresses_.resize(num_valid_bits);
+    }
+  }
+
+  num_bits_ = num_valid_bits;
+  invalid_bit_ids_.clear();
+}
+
 void FabricBitstream::set_use_address(const bool& enable) {
   /* Add a lock, only can be modified when num bits are zero*/
   if (0 == num_bits_) {
@@ -177,6 +406,18 @@ void FabricBitstream::set_wl_address_length(const size_t& length) {
   }
 }
 
+void FabricBitstream::set_use_word_din(const bool& enable) {
+  if (true == use_wl_address_) {
+    use_word_din_ = enable;
+  }
+}
+
+void FabricBitstream::set_word_din_length(const size_t& length) {
+  if (true == use_word_din_) {
+    word_din_length_ = length; 
+  }
+}
+
 /******************************************************************************
  * Public Validators
  ******************************************************************************/
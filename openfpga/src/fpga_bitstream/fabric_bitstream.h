@@ -32,6 +32,7 @@
 #include <unordered_set>
 #include <unordered_map>
 #include "vtr_vector.h"
+#include "vtr_mapped_storage.h"
 
 #include "bitstream_manager_fwd.h"
 #include "fabric_bitstream_fwd.h"
@@ -51,6 +52,9 @@ class FabricBitstream {
      * It is used to lazily create an iteration range (e.g. as returned by RRGraph::edges() RRGraph::nodes())
      * just based on the count of allocated elements (i.e. RRGraph::num_nodes_ or RRGraph::num_edges_),
      * and the set of any invalid IDs (i.e. RRGraph::invalid_node_ids_, RRGraph::invalid_edge_ids_).
+     *
+     * When the invalid ID set is empty at the time the iterator is created, 
+     * the range is a plain contiguous ID range and dereferencing skips the look-up on the set.
      */
     template<class ID>
     class lazy_id_iterator : public std::iterator<std::bidirectional_iterator_tag, ID> {
@@ -62,7 +66,8 @@ class FabricBitstream {
 
         lazy_id_iterator(value_type init, const std::unordered_set<ID>& invalid_ids)
             : value_(init)
-            , invalid_ids_(invalid_ids) {}
+            , invalid_ids_(invalid_ids)
+            , is_compact_(invalid_ids.empty()) {}
 
         //Advance to the next ID value
         iterator operator++() {
@@ -77,7 +82,7 @@ class FabricBitstream {
         }
 
         //Dereference the iterator
-        value_type operator*() const { return (invalid_ids_.count(value_)) ? ID::INVALID() : value_; }
+        value_type operator*() const { return (!is_compact_ && invalid_ids_.count(value_)) ? ID::INVALID() : value_; }
 
         friend bool operator==(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return lhs.value_ == rhs.value_; }
         friend bool operator!=(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return !(lhs == rhs); }
@@ -85,6 +90,7 @@ class FabricBitstream {
       private:
         value_type value_;
         const std::unordered_set<ID>& invalid_ids_;
+        bool is_compact_;
     };
 
   public: /* Types and ranges */
@@ -104,6 +110,23 @@ class FabricBitstream {
     size_t num_bits() const;
     fabric_bit_range bits() const;
 
+    /* Find the configuration regions, which are programmed in parallel
+     * Each region is a range of bits, e.g., the bits of a configuration chain
+     * By default, all the bits belong to a single region
+     */
+    size_t num_regions() const;
+    fabric_bit_range region_bits(const size_t& region) const;
+    size_t region_num_bits(const size_t& region) const;
+
+    /* Find the checksum segments, which are ranges of bits covered by a CRC-32C checksum
+     * so that a programmer can verify the readback of each segment and rewrite only the failing ones
+     * Segments never cross regions. There is no segment unless checksums are built
+     */
+    size_t num_checksum_segments() const;
+    fabric_bit_range checksum_segment_bits(const size_t& segment) const;
+    size_t checksum_segment_num_bits(const size_t& segment) const;
+    uint32_t checksum_segment_crc(const size_t& segment) const;
+
   public:  /* Public Accessors */
     /* Find the configuration bit id in architecture bitstream database */
     ConfigBitId config_bit(const FabricBitId& bit_id) const;
@@ -113,6 +136,19 @@ class FabricBitstream {
     std::vector<char> bit_bl_address(const FabricBitId& bit_id) const;
     std::vector<char> bit_wl_address(const FabricBitId& bit_id) const;
 
+    /* Find the address of bitstream as a packed integer, where bit i of the integer
+     * is the i-th character of the address returned by bit_address()
+     * These accessors do not allocate any memory, which is preferred by writers
+     */
+    size_t bit_address_value(const FabricBitId& bit_id) const;
+    size_t bit_bl_address_value(const FabricBitId& bit_id) const;
+    size_t bit_wl_address_value(const FabricBitId& bit_id) const;
+
+    /* Find the number of bits of addresses */
+    size_t address_length() const;
+    size_t bl_address_length() const;
+    size_t wl_address_length() const;
+
     /* Find the data-in of bitstream */
     char bit_din(const FabricBitId& bit_id) const;
 
@@ -120,6 +156,15 @@ class FabricBitstream {
     bool use_address() const;
     bool use_wl_address() const;
 
+    /* Check if the bits sharing a WL address are written at once as a data word,
+     * where the BL address of each bit is its position in the word
+     */
+    bool use_word_din() const;
+    size_t word_din_length() const;
+
+    /* Estimate the memory (in bytes) occupied by the fabric bitstream */
+    size_t memory_footprint() const;
+
   public:  /* Public Mutators */
     /* Reserve config bits */
     void reserve_bits(const size_t& num_bits);
@@ -127,6 +172,16 @@ class FabricBitstream {
     /* Add a new configuration bit to the bitstream manager */
     FabricBitId add_bit(const ConfigBitId& config_bit_id);
 
+    /* Start a new configuration region, to which the bits added afterwards belong 
+     * The bits added before the first call belong to the first region
+     */
+    void add_region();
+
+    /* Add a checksum segment, which starts from the bit following the previous segment */
+    void add_checksum_segment(const size_t& num_bits, const uint32_t& crc);
+    void set_checksum_segment_crc(const size_t& segment, const uint32_t& crc);
+    void clear_checksum_segments();
+
     void set_bit_address(const FabricBitId& bit_id,
                          const std::vector<char>& address);
 
@@ -136,14 +191,32 @@ class FabricBitstream {
     void set_bit_wl_address(const FabricBitId& bit_id,
                             const std::vector<char>& address);
 
+    /* Set the address of bitstream from its packed integer */
+    void set_bit_address_value(const FabricBitId& bit_id,
+                               const size_t& address);
+
+    void set_bit_bl_address_value(const FabricBitId& bit_id,
+                                  const size_t& address);
+
+    void set_bit_wl_address_value(const FabricBitId& bit_id,
+                                  const size_t& address);
+
     void set_bit_din(const FabricBitId& bit_id,
                      const char& din);
 
     /* Reverse bit sequence of the fabric bitstream
      * This is required by configuration chain protocol 
+     * This function is only applicable to a single region
+     * The checksum segments are cleared, as they should be built after the bits are final
      */
     void reverse();
 
+    /* Remove the invalid bits and renumber the remaining ones
+     * so that the range of bits becomes contiguous
+     * The checksum segments are cleared if any bit is removed
+     */
+    void compress();
+
     /* Enable the use of address-related data 
      * When this is enabled, data allocation will be applied to these data
      * and users can access/modify the data
@@ -161,6 +234,12 @@ class FabricBitstream {
     void set_use_wl_address(const bool& enable);
     void set_wl_address_length(const size_t& length);
 
+    /* Enable the writing of a data word at each WL address
+     * This is only applicable when WL addresses are used
+     */
+    void set_use_word_din(const bool& enable);
+    void set_word_din_length(const size_t& length);
+
   public:  /* Public Validators */
     char valid_bit_id(const FabricBitId& bit_id) const;
 
@@ -168,14 +247,31 @@ class FabricBitstream {
     /* Unique id of a bit in the Bitstream */
     size_t num_bits_; 
     std::unordered_set<FabricBitId> invalid_bit_ids_;
-    vtr::vector<FabricBitId, ConfigBitId> config_bit_ids_; 
+
+    /* The per-bit arrays are placed in mapped storage when it is enabled
+     * (see vtr_mapped_storage.h)
+     */
+    template<typename T>
+    using BitVector = vtr::vector<FabricBitId, T, vtr::MappedAllocator<T>>;
+
+    BitVector<ConfigBitId> config_bit_ids_; 
+
+    /* The first bit of each configuration region, empty for a single region */
+    std::vector<size_t> region_first_bits_;
+
+    /* The first bit, the number of bits and the CRC-32C of each checksum segment */
+    std::vector<size_t> checksum_segment_first_bits_;
+    std::vector<size_t> checksum_segment_num_bits_;
+    std::vector<uint32_t> checksum_segment_crcs_;
 
     /* Flags to indicate if the addresses and din should be enabled */
     bool use_address_;
     bool use_wl_address_;
+    bool use_word_din_;
 
     size_t address_length_;
     size_t wl_address_length_;
+    size_t word_din_length_;
 
     /* Address bits: this is designed for memory decoders
      * Here we store the binary format of the address, which can be loaded
@@ -183,11 +279,11 @@ class FabricBitstream {
      *
      * We use a 2-element array, as we may have a BL address and a WL address
      */
-    vtr::vector<FabricBitId, size_t> bit_addresses_;
-    vtr::vector<FabricBitId, size_t> bit_wl_addresses_;
+    BitVector<size_t> bit_addresses_;
+    BitVector<size_t> bit_wl_addresses_;
 
     /* Data input (Din) bits: this is designed for memory decoders */
-    vtr::vector<FabricBitId, char> bit_dins_;
+    BitVector<char> bit_dins_;
 };
 
 } /* end namespace openfpga */
@@ -0,0 +1,78 @@
+/********************************************************************
+ * This file includes most utilized functions for the FabricBitstream 
+ * data structure in the OpenFPGA framework
+ *******************************************************************/
+#include <algorithm>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+#include "fabric_bitstream_utils.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Find the size of the largest configuration region in a fabric bitstream,
+ * which is the number of cycles to program all the regions in parallel
+ *******************************************************************/
+size_t find_fabric_regional_bitstream_max_size(const FabricBitstream& fabric_bitstream) {
+  size_t max_region_size = 0;
+  for (size_t region = 0; region < fabric_bitstream.num_regions(); ++region) {
+    max_region_size = std::max(max_region_size, fabric_bitstream.region_num_bits(region));
+  }
+  return max_region_size;
+}
+
+/********************************************************************
+ * Find the bit of a configuration region to be loaded at a given cycle,
+ * when all the regions are programmed in parallel in num_cycles cycles
+ * The regions which are shorter than the others are padded at the beginning,
+ * so that all the regions are completely loaded at the last cycle.
+ * An invalid id is returned for a padding cycle
+ *
+ * Note that the fabric bitstream should be compressed, i.e., without any invalid bits
+ *******************************************************************/
+FabricBitId find_fabric_regional_bitstream_cycle_bit(const FabricBitstream& fabric_bitstream,
+                                                     const size_t& region,
+                                                     const size_t& cycle,
+                                                     const size_t& num_cycles) {
+  size_t region_size = fabric_bitstream.region_num_bits(region);
+  VTR_ASSERT(region_size <= num_cycles);
+  VTR_ASSERT(cycle < num_cycles);
+
+  size_t num_padding_cycles = num_cycles - region_size;
+  if (cycle < num_padding_cycles) {
+    return FabricBitId::INVALID();
+  }
+
+  FabricBitId first_bit = *(fabric_bitstream.region_bits(region).begin());
+  return FabricBitId(size_t(first_bit) + cycle - num_padding_cycles);
+}
+
+/********************************************************************
+ * Group the bits of a memory-bank fabric bitstream by their WL addresses,
+ * when a data word is written at each WL address
+ * Each word is indexed by the BL addresses of its bits, i.e., their positions in the word
+ * An invalid id is kept for a position without any memory cell
+ * The words are sorted by their WL addresses
+ *******************************************************************/
+std::map<size_t, std::vector<FabricBitId>> find_fabric_bitstream_memory_bank_words(const FabricBitstream& fabric_bitstream) {
+  VTR_ASSERT(true == fabric_bitstream.use_word_din());
+
+  std::map<size_t, std::vector<FabricBitId>> words;
+  for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
+    std::vector<FabricBitId>& word = words[fabric_bitstream.bit_wl_address_value(bit_id)];
+    if (true == word.empty()) {
+      word.resize(fabric_bitstream.word_din_length(), FabricBitId::INVALID());
+    }
+    size_t bl_index = fabric_bitstream.bit_bl_address_value(bit_id);
+    VTR_ASSERT(bl_index < word.size());
+    VTR_ASSERT(FabricBitId::INVALID() == word[bl_index]);
+    word[bl_index] = bit_id;
+  }
+
+  return words;
+}
+
+} /* end namespace openfpga */
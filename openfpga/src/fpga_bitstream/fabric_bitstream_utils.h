@@ -0,0 +1,29 @@
+#ifndef FABRIC_BITSTREAM_UTILS_H
+#define FABRIC_BITSTREAM_UTILS_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <map>
+#include <vector>
+#include "fabric_bitstream.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+size_t find_fabric_regional_bitstream_max_size(const FabricBitstream& fabric_bitstream);
+
+FabricBitId find_fabric_regional_bitstream_cycle_bit(const FabricBitstream& fabric_bitstream,
+                                                     const size_t& region,
+                                                     const size_t& cycle,
+                                                     const size_t& num_cycles);
+
+std::map<size_t, std::vector<FabricBitId>> find_fabric_bitstream_memory_bank_words(const FabricBitstream& fabric_bitstream);
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,105 @@
+/********************************************************************
+ * This file includes functions that send a fabric bitstream packed
+ * in memory to a programmer, without writing any intermediate file
+ *******************************************************************/
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+#include "send_fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* A programmer closing the connection early should not kill the shell */
+#ifdef MSG_NOSIGNAL
+constexpr int SEND_FABRIC_BITSTREAM_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr int SEND_FABRIC_BITSTREAM_FLAGS = 0;
+#endif
+
+/********************************************************************
+ * Write the packed bitstream to the standard output
+ * Note that the logs of the shell are also printed to the standard output,
+ * so the programmer should run the shell in batch mode with a quiet script
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int send_fabric_bitstream_to_stdout(const std::string& buffer) {
+  /* Logs which are pending must not be mixed with the bitstream */
+  std::fflush(stdout);
+
+  if ( (buffer.size() != std::fwrite(buffer.data(), 1, buffer.size(), stdout))
+    || (0 != std::fflush(stdout)) ) {
+    VTR_LOG_ERROR("Fail to write the fabric bitstream to the standard output: %s\n",
+                  std::strerror(errno));
+    return 1;
+  }
+
+  return 0;
+}
+
+/********************************************************************
+ * Connect to the socket of a programmer and send the packed bitstream
+ * The connection is closed once the bitstream is sent,
+ * so that the programmer can read until the end of the stream
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int send_fabric_bitstream_to_socket(const std::string& buffer,
+                                    const std::string& socket_file_name) {
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (socket_file_name.size() >= sizeof(address.sun_path)) {
+    VTR_LOG_ERROR("Socket file name '%s' is too long (at most %lu characters)!\n",
+                  socket_file_name.c_str(), sizeof(address.sun_path) - 1);
+    return 1;
+  }
+  std::strncpy(address.sun_path, socket_file_name.c_str(), sizeof(address.sun_path) - 1);
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if ( (-1 == fd)
+    || (0 != connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address))) ) {
+    VTR_LOG_ERROR("Fail to connect to the programmer at socket '%s': %s\n",
+                  socket_file_name.c_str(), std::strerror(errno));
+    if (-1 != fd) {
+      close(fd);
+    }
+    return 1;
+  }
+
+  const char* data = buffer.data();
+  size_t size = buffer.size();
+  while (0 < size) {
+    ssize_t num_sent = send(fd, data, size, SEND_FABRIC_BITSTREAM_FLAGS);
+    if (0 > num_sent) {
+      if (EINTR == errno) {
+        continue;
+      }
+      VTR_LOG_ERROR("Fail to send the fabric bitstream to socket '%s': %s\n",
+                    socket_file_name.c_str(), std::strerror(errno));
+      close(fd);
+      return 1;
+    }
+    data += num_sent;
+    size -= size_t(num_sent);
+  }
+
+  close(fd);
+
+  return 0;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,28 @@
+#ifndef SEND_FABRIC_BITSTREAM_H
+#define SEND_FABRIC_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+
+/********************************************************************
+ * Function declaration
+ *
+ * These functions hand over a fabric bitstream packed in memory
+ * (see build_fabric_bitstream_binary_buffer()) to a programmer,
+ * either through the standard output or a local (UNIX domain) socket.
+ * The bytes sent are exactly the contents of a binary bitstream file
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int send_fabric_bitstream_to_stdout(const std::string& buffer);
+
+int send_fabric_bitstream_to_socket(const std::string& buffer,
+                                    const std::string& socket_file_name);
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,380 @@
+/********************************************************************
+ * This file includes functions that output a fabric-dependent
+ * bitstream database to files in binary and compressed binary formats
+ * See binary_fabric_bitstream.h for the details of the file layouts
+ *******************************************************************/
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "binary_fabric_bitstream.h"
+#include "write_binary_fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Number of 64-bit words which are accumulated before written to the file
+ *******************************************************************/
+constexpr size_t BINARY_BITSTREAM_BUFFER_NUM_WORDS = 1 << 16;
+
+/********************************************************************
+ * Flush the packed words to the file and update the checksum
+ *******************************************************************/
+static
+void flush_binary_fabric_bitstream_words(std::ostream& fp,
+                                         std::vector<uint64_t>& words,
+                                         uint64_t& checksum) {
+  checksum = update_binary_fabric_bitstream_checksum(checksum, words.data(), words.size());
+  fp.write(reinterpret_cast<const char*>(words.data()), words.size() * sizeof(uint64_t));
+  words.clear();
+}
+
+/********************************************************************
+ * Pack a value of each configuration bit into a section of the binary file
+ * The values are packed back to back without any padding,
+ * and only the last word of the section is padded with zeros
+ *******************************************************************/
+template<class BitValueFunc>
+static
+void write_binary_fabric_bitstream_section(std::ostream& fp,
+                                           const FabricBitstream& fabric_bitstream,
+                                           const size_t& value_length,
+                                           const BitValueFunc& bit_value,
+                                           std::vector<uint64_t>& words,
+                                           uint64_t& checksum) {
+  VTR_ASSERT(64 >= value_length);
+  if (0 == value_length) {
+    return;
+  }
+  const uint64_t value_mask = (64 == value_length) ? ~uint64_t(0) : (uint64_t(1) << value_length) - 1;
+
+  uint64_t cur_word = 0;
+  size_t cur_offset = 0;
+  for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
+    uint64_t value = bit_value(fabric_bit) & value_mask;
+    cur_word |= value << cur_offset;
+    if (64 > cur_offset + value_length) {
+      cur_offset += value_length;
+      continue;
+    }
+    /* The word is full, keep the remaining part of the value for the next word */
+    words.push_back(cur_word);
+    size_t num_remaining_bits = cur_offset + value_length - 64;
+    cur_word = (0 == num_remaining_bits) ? 0 : value >> (value_length - num_remaining_bits);
+    cur_offset = num_remaining_bits;
+
+    if (BINARY_BITSTREAM_BUFFER_NUM_WORDS <= words.size()) {
+      flush_binary_fabric_bitstream_words(fp, words, checksum);
+    }
+  }
+  if (0 < cur_offset) {
+    words.push_back(cur_word);
+  }
+  flush_binary_fabric_bitstream_words(fp, words, checksum);
+}
+
+/********************************************************************
+ * Fill the header fields which are common to the binary and compressed files
+ * A checksum seed is assigned, which is updated when the payload is written
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+static
+int init_binary_fabric_bitstream_header(BinaryFabricBitstreamHeader& header,
+                                        const char (&magic)[8],
+                                        const FabricBitstream& fabric_bitstream,
+                                        const ConfigProtocol& config_protocol) {
+  /* The file layout does not record the configuration regions */
+  if (1 < fabric_bitstream.num_regions()) {
+    VTR_LOG_ERROR("Binary fabric bitstream does not support multiple configuration regions!\n");
+    return 1;
+  }
+
+  std::memcpy(header.magic, magic, sizeof(magic));
+  header.version = BINARY_FABRIC_BITSTREAM_VERSION;
+  header.config_protocol_type = uint32_t(config_protocol.type());
+  header.num_bits = fabric_bitstream.bits().size();
+  header.address_length = 0;
+  header.wl_address_length = 0;
+  header.checksum = BINARY_FABRIC_BITSTREAM_CHECKSUM_SEED;
+
+  /* Find the address lengths required by the configuration protocol */
+  switch (config_protocol.type()) {
+  case CONFIG_MEM_STANDALONE:
+  case CONFIG_MEM_SCAN_CHAIN:
+    break;
+  case CONFIG_MEM_MEMORY_BANK:
+    header.address_length = fabric_bitstream.bl_address_length();
+    header.wl_address_length = fabric_bitstream.wl_address_length();
+    break;
+  case CONFIG_MEM_FRAME_BASED:
+    header.address_length = fabric_bitstream.address_length();
+    break;
+  default:
+    VTR_LOGF_ERROR(__FILE__, __LINE__,
+                   "Invalid configuration protocol type!\n");
+    return 1;
+  }
+
+  return 0;
+}
+
+/********************************************************************
+ * Pack the BL/frame and WL addresses into the sections of the binary file
+ * Addresses are the same in the binary and compressed files
+ *******************************************************************/
+static
+void write_binary_fabric_bitstream_address_sections(std::ostream& fp,
+                                                    const FabricBitstream& fabric_bitstream,
+                                                    BinaryFabricBitstreamHeader& header,
+                                                    std::vector<uint64_t>& words) {
+  /* BL or frame addresses */
+  write_binary_fabric_bitstream_section(fp, fabric_bitstream, header.address_length,
+                                        [&](const FabricBitId& fabric_bit) {
+                                          return uint64_t(fabric_bitstream.bit_address_value(fabric_bit));
+                                        },
+                                        words, header.checksum);
+
+  /* WL addresses */
+  write_binary_fabric_bitstream_section(fp, fabric_bitstream, header.wl_address_length,
+                                        [&](const FabricBitId& fabric_bit) {
+                                          return uint64_t(fabric_bitstream.bit_wl_address_value(fabric_bit));
+                                        },
+                                        words, header.checksum);
+}
+
+/********************************************************************
+ * Write the checksum segments of the fabric bitstream, if any,
+ * in the optional section at the end of the binary file
+ *******************************************************************/
+static
+void write_binary_fabric_bitstream_checksum_section(std::ostream& fp,
+                                                    const FabricBitstream& fabric_bitstream,
+                                                    std::vector<uint64_t>& words,
+                                                    uint64_t& checksum) {
+  size_t num_segments = fabric_bitstream.num_checksum_segments();
+  if (0 == num_segments) {
+    return;
+  }
+
+  words.push_back(num_segments);
+  for (size_t segment = 0; segment < num_segments; ++segment) {
+    words.push_back(fabric_bitstream.checksum_segment_num_bits(segment));
+  }
+  /* Two checksums per word, the first one in the least significant bits */
+  for (size_t segment = 0; segment < num_segments; segment += 2) {
+    uint64_t word = fabric_bitstream.checksum_segment_crc(segment);
+    if (segment + 1 < num_segments) {
+      word |= uint64_t(fabric_bitstream.checksum_segment_crc(segment + 1)) << 32;
+    }
+    words.push_back(word);
+  }
+  flush_binary_fabric_bitstream_words(fp, words, checksum);
+}
+
+/********************************************************************
+ * Write the header and the payload of a binary fabric bitstream to a stream
+ * The header is written twice: a placeholder first, and the final one
+ * once the checksum of the payload is known. The stream must be seekable
+ *******************************************************************/
+static
+void write_binary_fabric_bitstream_stream(std::ostream& fp,
+                                          const BitstreamManager& bitstream_manager,
+                                          const FabricBitstream& fabric_bitstream,
+                                          BinaryFabricBitstreamHeader& header) {
+  /* Reserve space for the header, which is finalized once the checksum is known */
+  fp.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  std::vector<uint64_t> words;
+  words.reserve(BINARY_BITSTREAM_BUFFER_NUM_WORDS);
+
+  /* Data input bits */
+  write_binary_fabric_bitstream_section(fp, fabric_bitstream, 1,
+                                        [&](const FabricBitId& fabric_bit) {
+                                          return uint64_t(bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit)) ? 1 : 0);
+                                        },
+                                        words, header.checksum);
+
+  write_binary_fabric_bitstream_address_sections(fp, fabric_bitstream, header, words);
+
+  write_binary_fabric_bitstream_checksum_section(fp, fabric_bitstream, words, header.checksum);
+
+  /* Finalize the header */
+  fp.seekp(0);
+  fp.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+/********************************************************************
+ * Write the fabric bitstream to a binary file
+ * Notes:
+ *   - The file contains the same information as the plain text file
+ *     but the bits and addresses are packed
+ *   - The file can be mapped to memory by BinaryFabricBitstreamFile
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int write_fabric_bitstream_to_binary_file(const BitstreamManager& bitstream_manager,
+                                          const FabricBitstream& fabric_bitstream,
+                                          const ConfigProtocol& config_protocol,
+                                          const std::string& fname,
+                                          const bool& verbose) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to output bitstream!\n\tPlease specify a valid file name.\n");
+    return 1;
+  }
+
+  std::string timer_message = std::string("Write ") + std::to_string(fabric_bitstream.num_bits()) + std::string(" fabric bitstream into binary file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  BinaryFabricBitstreamHeader header;
+  if (0 != init_binary_fabric_bitstream_header(header, BINARY_FABRIC_BITSTREAM_MAGIC,
+                                               fabric_bitstream, config_protocol)) {
+    return 1;
+  }
+
+  /* Create the file stream */
+  BufferedFileStream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+
+  check_file_stream(fname.c_str(), fp);
+
+  write_binary_fabric_bitstream_stream(fp, bitstream_manager, fabric_bitstream, header);
+
+  /* Close file handler */
+  fp.close();
+
+  VTR_LOGV(verbose,
+           "Outputted %lu configuration bits to binary file: %s\n",
+           fabric_bitstream.bits().size(),
+           fname.c_str());
+
+  return 0;
+}
+
+/********************************************************************
+ * Pack the fabric bitstream into a buffer in memory,
+ * in the same layout as the binary file, i.e., the header followed by
+ * the data input words and the address words.
+ * The buffer can be handed over to a programmer without any intermediate file,
+ * and decoded in the same way as a binary file mapped to memory
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int build_fabric_bitstream_binary_buffer(const BitstreamManager& bitstream_manager,
+                                         const FabricBitstream& fabric_bitstream,
+                                         const ConfigProtocol& config_protocol,
+                                         std::string& buffer) {
+  BinaryFabricBitstreamHeader header;
+  if (0 != init_binary_fabric_bitstream_header(header, BINARY_FABRIC_BITSTREAM_MAGIC,
+                                               fabric_bitstream, config_protocol)) {
+    return 1;
+  }
+
+  std::ostringstream fp(std::ios_base::out | std::ios_base::binary);
+  write_binary_fabric_bitstream_stream(fp, bitstream_manager, fabric_bitstream, header);
+  buffer = fp.str();
+
+  return 0;
+}
+
+/********************************************************************
+ * Write the fabric bitstream to a compressed binary file
+ * The data input bits are encoded in run-length tokens,
+ * while the addresses are packed in the same way as the binary file
+ * See binary_fabric_bitstream.h for the details of the tokens
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int write_fabric_bitstream_to_compressed_file(const BitstreamManager& bitstream_manager,
+                                              const FabricBitstream& fabric_bitstream,
+                                              const ConfigProtocol& config_protocol,
+                                              const std::string& fname,
+                                              const bool& verbose) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to output bitstream!\n\tPlease specify a valid file name.\n");
+    return 1;
+  }
+
+  std::string timer_message = std::string("Write ") + std::to_string(fabric_bitstream.num_bits()) + std::string(" fabric bitstream into compressed file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  CompressedFabricBitstreamHeader header;
+  if (0 != init_binary_fabric_bitstream_header(header.base, COMPRESSED_FABRIC_BITSTREAM_MAGIC,
+                                               fabric_bitstream, config_protocol)) {
+    return 1;
+  }
+
+  /* Encode the data input bits */
+  std::vector<bool> din_bits;
+  din_bits.reserve(fabric_bitstream.num_bits());
+  for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
+    din_bits.push_back(bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit)));
+  }
+  std::vector<uint16_t> din_tokens = encode_fabric_bitstream_run_length_tokens(din_bits);
+  VTR_ASSERT_SAFE(din_bits == decode_fabric_bitstream_run_length_tokens(din_tokens, din_bits.size()));
+  header.num_din_tokens = din_tokens.size();
+
+  /* Create the file stream */
+  BufferedFileStream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+
+  check_file_stream(fname.c_str(), fp);
+
+  /* Reserve space for the header, which is finalized once the checksum is known */
+  fp.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  std::vector<uint64_t> words;
+  words.reserve(BINARY_BITSTREAM_BUFFER_NUM_WORDS);
+
+  /* Data input tokens, 4 tokens per word */
+  for (size_t itoken = 0; itoken < din_tokens.size(); itoken += 4) {
+    uint64_t cur_word = 0;
+    for (size_t ioffset = 0; (ioffset < 4) && (itoken + ioffset < din_tokens.size()); ++ioffset) {
+      cur_word |= uint64_t(din_tokens[itoken + ioffset]) << (16 * ioffset);
+    }
+    words.push_back(cur_word);
+    if (BINARY_BITSTREAM_BUFFER_NUM_WORDS <= words.size()) {
+      flush_binary_fabric_bitstream_words(fp, words, header.base.checksum);
+    }
+  }
+  flush_binary_fabric_bitstream_words(fp, words, header.base.checksum);
+
+  write_binary_fabric_bitstream_address_sections(fp, fabric_bitstream, header.base, words);
+
+  /* Finalize the header */
+  fp.seekp(0);
+  fp.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  /* Close file handler */
+  fp.close();
+
+  VTR_LOGV(verbose,
+           "Outputted %lu configuration bits in %lu run-length tokens to compressed file: %s\n",
+           fabric_bitstream.bits().size(),
+           din_tokens.size(),
+           fname.c_str());
+
+  return 0;
+}
+
+} /* end namespace openfpga */
@@ -13,17 +13,24 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_decode.h"
 
 #include "openfpga_naming.h"
 
 #include "bitstream_manager_utils.h"
+#include "fabric_bitstream_utils.h"
 #include "write_text_fabric_bitstream.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
 /********************************************************************
- * Write a configuration bit into a plain text file
+ * Size of the buffer which accumulates the text before it is written to the file
+ *******************************************************************/
+constexpr size_t TEXT_BITSTREAM_BUFFER_SIZE = 1 << 20;
+
+/********************************************************************
+ * Write a configuration bit into a plain text buffer
  * The format depends on the type of configuration protocol
  * - Vanilla (standalone): just put down pure 0|1 bitstream
  * - Configuration chain: just put down pure 0|1 bitstream
@@ -35,40 +42,32 @@ namespace openfpga {
  *  - 1 if critical errors occured
  *******************************************************************/
 static 
-int write_fabric_config_bit_to_text_file(std::fstream& fp,
-                                         const BitstreamManager& bitstream_manager,
-                                         const FabricBitstream& fabric_bitstream,
-                                         const FabricBitId& fabric_bit,
-                                         const e_config_protocol_type& config_type) {
-  if (false == valid_file_stream(fp)) {
-    return 1;
-  }
+int write_fabric_config_bit_to_text_buffer(std::string& buffer,
+                                           const BitstreamManager& bitstream_manager,
+                                           const FabricBitstream& fabric_bitstream,
+                                           const FabricBitId& fabric_bit,
+                                           const e_config_protocol_type& config_type) {
+  const char bit_char = bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit)) ? '1' : '0';
 
   switch (config_type) {
   case CONFIG_MEM_STANDALONE: 
   case CONFIG_MEM_SCAN_CHAIN:
-    fp << bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit));
+    buffer.push_back(bit_char);
     break;
   case CONFIG_MEM_MEMORY_BANK: { 
-    for (const char& addr_bit : fabric_bitstream.bit_bl_address(fabric_bit)) {
-      fp << addr_bit;
-    }
-    write_space_to_file(fp, 1);
-    for (const char& addr_bit : fabric_bitstream.bit_wl_address(fabric_bit)) {
-      fp << addr_bit;
-    }
-    write_space_to_file(fp, 1);
-    fp << bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit));
-    fp << "\n";
+    append_itobin_chars(buffer, fabric_bitstream.bit_bl_address_value(fabric_bit), fabric_bitstream.bl_address_length());
+    buffer.push_back(' ');
+    append_itobin_chars(buffer, fabric_bitstream.bit_wl_address_value(fabric_bit), fabric_bitstream.wl_address_length());
+    buffer.push_back(' ');
+    buffer.push_back(bit_char);
+    buffer.push_back('\n');
     break;
   }
   case CONFIG_MEM_FRAME_BASED: {
-    for (const char& addr_bit : fabric_bitstream.bit_address(fabric_bit)) {
-      fp << addr_bit;
-    }
-    write_space_to_file(fp, 1);
-    fp << bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit));
-    fp << "\n";
+    append_itobin_chars(buffer, fabric_bitstream.bit_address_value(fabric_bit), fabric_bitstream.address_length());
+    buffer.push_back(' ');
+    buffer.push_back(bit_char);
+    buffer.push_back('\n');
     break;
   }
   default:
@@ -80,9 +79,41 @@ int write_fabric_config_bit_to_text_file(std::fstream& fp,
   return 0;
 }
 
+/********************************************************************
+ * Write the bits of configuration chains in multiple regions into a plain text buffer
+ * Each line contains the bits to be loaded to all the regions in a clock cycle,
+ * starting from the first region. 
+ * Shorter regions are padded with '0' at the beginning
+ *******************************************************************/
+static 
+void write_fabric_regional_bitstream_to_text_file(BufferedFileStream& fp,
+                                                  std::string& buffer,
+                                                  const BitstreamManager& bitstream_manager,
+                                                  const FabricBitstream& fabric_bitstream) {
+  size_t num_cycles = find_fabric_regional_bitstream_max_size(fabric_bitstream);
+  for (size_t cycle = 0; cycle < num_cycles; ++cycle) {
+    for (size_t region = 0; region < fabric_bitstream.num_regions(); ++region) {
+      FabricBitId fabric_bit = find_fabric_regional_bitstream_cycle_bit(fabric_bitstream, region, cycle, num_cycles);
+      if (FabricBitId::INVALID() == fabric_bit) {
+        buffer.push_back('0');
+        continue;
+      }
+      buffer.push_back(bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit)) ? '1' : '0');
+    }
+    buffer.push_back('\n');
+    if (TEXT_BITSTREAM_BUFFER_SIZE <= buffer.size()) {
+      fp.write(buffer.data(), buffer.size());
+      buffer.clear();
+    }
+  }
+  fp.write(buffer.data(), buffer.size());
+}
+
 /********************************************************************
  * Write the fabric bitstream to a plain text file 
  * Notes: 
+ *   - For configuration chains in multiple regions,
+ *     each line contains the bits of all the regions in a clock cycle
  *   - This is the final bitstream which is loadable to the FPGA fabric
  *     (Verilog netlists etc.)
  *   - Do NOT include any comments or other characters that the 0|1 bitstream content
@@ -106,24 +137,48 @@ int write_fabric_bitstream_to_text_file(const BitstreamManager& bitstream_manage
   vtr::ScopedStartFinishTimer timer(timer_message);
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(fname.c_str(), fp);
 
-  /* Output fabric bitstream to the file */
+  /* Output fabric bitstream to the file 
+   * Bits are formatted into a reusable buffer, which is written to the file when it is full
+   */
+  std::string buffer;
+  buffer.reserve(TEXT_BITSTREAM_BUFFER_SIZE + 2 * 8 * sizeof(size_t) + 4);
+
+  if ( (CONFIG_MEM_SCAN_CHAIN == config_protocol.type())
+    && (1 < fabric_bitstream.num_regions()) ) {
+    write_fabric_regional_bitstream_to_text_file(fp, buffer, bitstream_manager, fabric_bitstream);
+    fp.close();
+
+    VTR_LOGV(verbose,
+             "Outputted %lu configuration bits of %lu regions to plain text file: %s\n",
+             fabric_bitstream.bits().size(),
+             fabric_bitstream.num_regions(),
+             fname.c_str());
+    return 0;
+  }
+
   int status = 0;
   for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
-    status = write_fabric_config_bit_to_text_file(fp, bitstream_manager,
-                                                  fabric_bitstream,
-                                                  fabric_bit,
-                                                  config_protocol.type());
+    status = write_fabric_config_bit_to_text_buffer(buffer, bitstream_manager,
+                                                    fabric_bitstream,
+                                                    fabric_bit,
+                                                    config_protocol.type());
     if (1 == status) {
       break;
     }
+    if (TEXT_BITSTREAM_BUFFER_SIZE <= buffer.size()) {
+      fp.write(buffer.data(), buffer.size());
+      buffer.clear();
+    }
   }
+  fp.write(buffer.data(), buffer.size());
+
   /* Print an end to the file here */
-  fp << std::endl;
+  fp << "\n";
 
   /* Close file handler */
   fp.close();
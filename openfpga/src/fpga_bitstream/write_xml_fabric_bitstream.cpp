@@ -13,6 +13,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_decode.h"
 
 /* Headers from archopenfpga library */
 
@@ -34,13 +35,13 @@ void write_fabric_bitstream_xml_file_head(std::fstream& fp) {
   auto end = std::chrono::system_clock::now(); 
   std::time_t end_time = std::chrono::system_clock::to_time_t(end);
 
-  fp << "<!--" << std::endl;
-  fp << "\t- Fabric bitstream" << std::endl;
-  fp << "\t- Author: Xifan TANG" << std::endl;
-  fp << "\t- Organization: University of Utah" << std::endl;
+  fp << "<!--" << "\n";
+  fp << "\t- Fabric bitstream" << "\n";
+  fp << "\t- Author: Xifan TANG" << "\n";
+  fp << "\t- Organization: University of Utah" << "\n";
   fp << "\t- Date: " << std::ctime(&end_time) ;
-  fp << "-->" << std::endl;
-  fp << std::endl;
+  fp << "-->" << "\n";
+  fp << "\n";
 }
 
 /********************************************************************
@@ -62,12 +63,15 @@ void write_fabric_bitstream_xml_file_head(std::fstream& fp) {
  * - Frame-based configuration protocol :
  *     <frame address="<frame_address_value>"/>
  *
+ * The address buffer is provided by the caller so that it can be reused across bits
+ *
  * Return:
  *  - 0 if succeed
  *  - 1 if critical errors occured
  *******************************************************************/
 static 
 int write_fabric_config_bit_to_xml_file(std::fstream& fp,
+                                        std::string& addr_buffer,
                                         const BitstreamManager& bitstream_manager,
                                         const FabricBitstream& fabric_bitstream,
                                         const FabricBitId& fabric_bit,
@@ -106,25 +110,25 @@ int write_fabric_config_bit_to_xml_file(std::fstream& fp,
     /* Bit line address */
     write_tab_to_file(fp, 2);
     fp << "<bl address=\"";
-    for (const char& addr_bit : fabric_bitstream.bit_bl_address(fabric_bit)) {
-      fp << addr_bit;
-    }
+    addr_buffer.clear();
+    append_itobin_chars(addr_buffer, fabric_bitstream.bit_bl_address_value(fabric_bit), fabric_bitstream.bl_address_length());
+    fp << addr_buffer;
     fp << "\"/>\n";   
  
     write_tab_to_file(fp, 2);
     fp << "<wl address=\"";
-    for (const char& addr_bit : fabric_bitstream.bit_wl_address(fabric_bit)) {
-      fp << addr_bit;
-    }
+    addr_buffer.clear();
+    append_itobin_chars(addr_buffer, fabric_bitstream.bit_wl_address_value(fabric_bit), fabric_bitstream.wl_address_length());
+    fp << addr_buffer;
     fp << "\"/>\n";   
     break;
   }
   case CONFIG_MEM_FRAME_BASED: {
     write_tab_to_file(fp, 2);
     fp << "<frame address=\"";
-    for (const char& addr_bit : fabric_bitstream.bit_address(fabric_bit)) {
-      fp << addr_bit;
-    }
+    addr_buffer.clear();
+    append_itobin_chars(addr_buffer, fabric_bitstream.bit_address_value(fabric_bit), fabric_bitstream.address_length());
+    fp << addr_buffer;
     fp << "\"/>\n";   
     break;
   }
@@ -165,7 +169,7 @@ int write_fabric_bitstream_to_xml_file(const BitstreamManager& bitstream_manager
   vtr::ScopedStartFinishTimer timer(timer_message);
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(fname.c_str(), fp);
@@ -177,8 +181,9 @@ int write_fabric_bitstream_to_xml_file(const BitstreamManager& bitstream_manager
 
   /* Output fabric bitstream to the file */
   int status = 0;
+  std::string addr_buffer;
   for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
-    status = write_fabric_config_bit_to_xml_file(fp, bitstream_manager,
+    status = write_fabric_config_bit_to_xml_file(fp, addr_buffer, bitstream_manager,
                                                  fabric_bitstream,
                                                  fabric_bit,
                                                  config_protocol.type());
@@ -0,0 +1,130 @@
+/********************************************************************
+ * Member functions for the writer of set_disable_timing commands
+ * used by the analysis SDC generator
+ *******************************************************************/
+#include <algorithm>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "sdc_writer_utils.h"
+#include "analysis_sdc_disable_timing.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Public Constructors
+ *******************************************************************/
+AnalysisSdcDisableTimingWriter::AnalysisSdcDisableTimingWriter(std::fstream& fp,
+                                                               const ModuleManager& module_manager,
+                                                               const bool& compact)
+  : fp_(fp),
+    module_manager_(module_manager),
+    compact_(compact) {
+}
+
+/********************************************************************
+ * Public mutators
+ *******************************************************************/
+void AnalysisSdcDisableTimingWriter::disable_port(const std::string& hierarchy,
+                                                  const ModuleId& module,
+                                                  const BasicPort& port) {
+  /* Validate file stream */
+  valid_file_stream(fp_);
+
+  if (false == compact_) {
+    fp_ << "set_disable_timing ";
+    fp_ << hierarchy;
+    fp_ << generate_sdc_port(port);
+    fp_ << "\n";
+    return;
+  }
+
+  auto result = hierarchy_ids_.insert(std::make_pair(hierarchy, hierarchies_.size()));
+  if (true == result.second) {
+    hierarchies_.push_back(hierarchy);
+    hierarchy_modules_.push_back(module);
+    hierarchy_pins_.emplace_back();
+  }
+
+  std::vector<size_t>& pins = hierarchy_pins_[result.first->second][port.get_name()];
+  for (const size_t& pin : port.pins()) {
+    pins.push_back(pin);
+  }
+}
+
+/********************************************************************
+ * Write the pins collected for each instance hierarchy
+ * - Duplicated pins are removed and the rest are sorted, so that
+ *   contiguous pins can be merged into a bus range
+ * - When every pin of every port of the module is disabled,
+ *   a wildcard over the instance is used instead, which is the same
+ *   as what is written for a fully unused pb_graph_node
+ *
+ * Note: wildcards are never applied across instances, even if they
+ * are instanciated from the same unique module.
+ * Some of the instances may be used by the benchmark.
+ *******************************************************************/
+void AnalysisSdcDisableTimingWriter::flush() {
+  /* Validate file stream */
+  valid_file_stream(fp_);
+
+  for (size_t ihier = 0; ihier < hierarchies_.size(); ++ihier) {
+    std::map<std::string, std::vector<size_t>>& port_pins = hierarchy_pins_[ihier];
+    for (auto& pins : port_pins) {
+      std::sort(pins.second.begin(), pins.second.end());
+      pins.second.erase(std::unique(pins.second.begin(), pins.second.end()), pins.second.end());
+    }
+
+    /* Check if all the pins of the instance are disabled */
+    bool fully_disabled = module_manager_.valid_module_id(hierarchy_modules_[ihier]);
+    if (true == fully_disabled) {
+      for (const ModulePortId& module_port : module_manager_.module_ports(hierarchy_modules_[ihier])) {
+        const BasicPort& port = module_manager_.module_port(hierarchy_modules_[ihier], module_port);
+        auto it = port_pins.find(port.get_name());
+        if ( (it == port_pins.end())
+          || (it->second.size() != port.get_width()) ) {
+          fully_disabled = false;
+          break;
+        }
+      }
+    }
+
+    if (true == fully_disabled) {
+      fp_ << "set_disable_timing ";
+      fp_ << hierarchies_[ihier];
+      fp_ << "*";
+      fp_ << "\n";
+      continue;
+    }
+
+    /* Merge the contiguous pins into bus ranges */
+    for (const auto& pins : port_pins) {
+      size_t ipin = 0;
+      while (ipin < pins.second.size()) {
+        size_t jpin = ipin;
+        while ( (jpin + 1 < pins.second.size())
+             && (pins.second[jpin] + 1 == pins.second[jpin + 1]) ) {
+          ++jpin;
+        }
+        BasicPort port_to_disable(pins.first, pins.second[ipin], pins.second[jpin]);
+        fp_ << "set_disable_timing ";
+        fp_ << hierarchies_[ihier];
+        fp_ << generate_sdc_port(port_to_disable);
+        fp_ << "\n";
+        ipin = jpin + 1;
+      }
+    }
+  }
+
+  hierarchies_.clear();
+  hierarchy_ids_.clear();
+  hierarchy_modules_.clear();
+  hierarchy_pins_.clear();
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,55 @@
+#ifndef ANALYSIS_SDC_DISABLE_TIMING_H
+#define ANALYSIS_SDC_DISABLE_TIMING_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include "openfpga_port.h"
+#include "module_manager.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A writer for the set_disable_timing commands of the analysis SDC
+ *
+ * By default, each pin is disabled by a dedicated command as soon as it is
+ * added. In compact mode, pins are collected per instance hierarchy until
+ * flush() is called, and then written as
+ * - a wildcard over the instance, when all the pins of the instance are disabled
+ * - bus ranges merged from the contiguous pins of each port, otherwise
+ *******************************************************************/
+class AnalysisSdcDisableTimingWriter {
+  public: /* Public Constructors */
+    AnalysisSdcDisableTimingWriter(std::fstream& fp,
+                                   const ModuleManager& module_manager,
+                                   const bool& compact);
+  public: /* Public mutators */
+    /* Disable the pins of a port, which belongs to an instance of a module.
+     * The hierarchy is the full path to the instance, ending with a '/'
+     */
+    void disable_port(const std::string& hierarchy,
+                      const ModuleId& module,
+                      const BasicPort& port);
+    /* Write the pins collected in compact mode and clear them */
+    void flush();
+  private: /* Internal data */
+    std::fstream& fp_;
+    const ModuleManager& module_manager_;
+    bool compact_;
+
+    /* Instance hierarchies in the order they are added */
+    std::vector<std::string> hierarchies_;
+    std::map<std::string, size_t> hierarchy_ids_;
+    std::vector<ModuleId> hierarchy_modules_;
+    /* Disabled pins per port name of each instance hierarchy */
+    std::vector<std::map<std::string, std::vector<size_t>>> hierarchy_pins_;
+};
+
+} /* end namespace openfpga */
+
+#endif
@@ -8,6 +8,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_instance_path.h"
 
 /* Headers from vprutil library */
 #include "vpr_utils.h"
@@ -37,7 +38,7 @@ void rec_print_analysis_sdc_disable_unused_pb_graph_nodes(std::fstream& fp,
                                                           const VprDeviceAnnotation& device_annotation,
                                                           const ModuleManager& module_manager,
                                                           const ModuleId& parent_module,
-                                                          const std::string& hierarchy_name,
+                                                          InstancePathBuilder& hierarchy_path,
                                                           t_pb_graph_node* physical_pb_graph_node) {
   t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type;
 
@@ -47,14 +48,14 @@ void rec_print_analysis_sdc_disable_unused_pb_graph_nodes(std::fstream& fp,
   /* Disable all the ports of current module (parent_module)!
    * Hierarchy name already includes the instance name of parent_module 
    */
-  fp << "#######################################" << std::endl; 
-  fp << "# Disable all the ports for pb_graph_node " << physical_pb_graph_node->pb_type->name << "[" << physical_pb_graph_node->placement_index << "]" << std::endl;
-  fp << "#######################################" << std::endl; 
+  fp << "#######################################" << "\n"; 
+  fp << "# Disable all the ports for pb_graph_node " << physical_pb_graph_node->pb_type->name << "[" << physical_pb_graph_node->placement_index << "]" << "\n";
+  fp << "#######################################" << "\n"; 
 
   fp << "set_disable_timing ";
-  fp << hierarchy_name; 
+  fp << hierarchy_path.path(); 
   fp << "*";
-  fp << std::endl;
+  fp << "\n";
 
   /* Return if this is the primitive pb_type */
   if (true == is_primitive_pb_type(physical_pb_type)) {
@@ -78,10 +79,12 @@ void rec_print_analysis_sdc_disable_unused_pb_graph_nodes(std::fstream& fp,
       /* Must have a valid instance name!!! */
       VTR_ASSERT(false == child_instance_name.empty()); 
 
-      std::string updated_hierarchy_name = hierarchy_name + child_instance_name + std::string("/");
+      hierarchy_path.push(child_instance_name);
 
-      rec_print_analysis_sdc_disable_unused_pb_graph_nodes(fp, device_annotation, module_manager, child_module, updated_hierarchy_name, 
+      rec_print_analysis_sdc_disable_unused_pb_graph_nodes(fp, device_annotation, module_manager, child_module, hierarchy_path, 
                                                            &(physical_pb_graph_node->child_pb_graph_nodes[physical_mode->index][ichild][inst])); 
+
+      hierarchy_path.pop();
     }
   }
 }
@@ -90,16 +93,13 @@ void rec_print_analysis_sdc_disable_unused_pb_graph_nodes(std::fstream& fp,
  * Disable an unused pin of a pb_graph_node (parent_module) 
  *******************************************************************/
 static
-void disable_pb_graph_node_unused_pin(std::fstream& fp, 
+void disable_pb_graph_node_unused_pin(AnalysisSdcDisableTimingWriter& disable_timing_writer,
                                       const ModuleManager& module_manager,
                                       const ModuleId& parent_module,
                                       const std::string& hierarchy_name,
                                       const t_pb_graph_pin* pb_graph_pin,
                                       const PhysicalPb& physical_pb,
                                       const PhysicalPbId& pb_id) {
-  /* Validate file stream */
-  valid_file_stream(fp);
-    
   /* Identify if the pb_graph_pin has been used or not
    * TODO: identify if this is a parasitic net
    */ 
@@ -116,10 +116,7 @@ void disable_pb_graph_node_unused_pin(std::fstream& fp,
   BasicPort port_to_disable = module_manager.module_port(parent_module, module_port);
   port_to_disable.set_width(pb_graph_pin->pin_number, pb_graph_pin->pin_number);
 
-  fp << "set_disable_timing ";
-  fp << hierarchy_name; 
-  fp << generate_sdc_port(port_to_disable);
-  fp << std::endl;
+  disable_timing_writer.disable_port(hierarchy_name, parent_module, port_to_disable);
 }
 
 /********************************************************************
@@ -131,6 +128,7 @@ void disable_pb_graph_node_unused_pin(std::fstream& fp,
  *******************************************************************/
 static
 void disable_pb_graph_node_unused_pins(std::fstream& fp, 
+                                       AnalysisSdcDisableTimingWriter& disable_timing_writer,
                                        const ModuleManager& module_manager,
                                        const ModuleId& parent_module,
                                        const std::string& hierarchy_name,
@@ -139,14 +137,14 @@ void disable_pb_graph_node_unused_pins(std::fstream& fp,
   const PhysicalPbId& pb_id = physical_pb.find_pb(physical_pb_graph_node);
   VTR_ASSERT(true == physical_pb.valid_pb_id(pb_id));
 
-  fp << "#######################################" << std::endl; 
-  fp << "# Disable unused pins for pb_graph_node " << physical_pb_graph_node->pb_type->name << "[" << physical_pb_graph_node->placement_index << "]" << std::endl;
-  fp << "#######################################" << std::endl; 
+  fp << "#######################################" << "\n"; 
+  fp << "# Disable unused pins for pb_graph_node " << physical_pb_graph_node->pb_type->name << "[" << physical_pb_graph_node->placement_index << "]" << "\n";
+  fp << "#######################################" << "\n"; 
 
   /* Disable unused input pins */
   for (int iport = 0; iport < physical_pb_graph_node->num_input_ports; ++iport) {
     for (int ipin = 0; ipin < physical_pb_graph_node->num_input_pins[iport]; ++ipin) {
-      disable_pb_graph_node_unused_pin(fp, module_manager, parent_module,
+      disable_pb_graph_node_unused_pin(disable_timing_writer, module_manager, parent_module,
                                        hierarchy_name,
                                        &(physical_pb_graph_node->input_pins[iport][ipin]),
                                        physical_pb, pb_id);
@@ -156,7 +154,7 @@ void disable_pb_graph_node_unused_pins(std::fstream& fp,
   /* Disable unused output pins */
   for (int iport = 0; iport < physical_pb_graph_node->num_output_ports; ++iport) {
     for (int ipin = 0; ipin < physical_pb_graph_node->num_output_pins[iport]; ++ipin) {
-      disable_pb_graph_node_unused_pin(fp, module_manager, parent_module,
+      disable_pb_graph_node_unused_pin(disable_timing_writer, module_manager, parent_module,
                                        hierarchy_name,
                                        &(physical_pb_graph_node->output_pins[iport][ipin]),
                                        physical_pb, pb_id);
@@ -166,7 +164,7 @@ void disable_pb_graph_node_unused_pins(std::fstream& fp,
   /* Disable unused clock pins */
   for (int iport = 0; iport < physical_pb_graph_node->num_clock_ports; ++iport) {
     for (int ipin = 0; ipin < physical_pb_graph_node->num_clock_pins[iport]; ++ipin) {
-      disable_pb_graph_node_unused_pin(fp, module_manager, parent_module,
+      disable_pb_graph_node_unused_pin(disable_timing_writer, module_manager, parent_module,
                                        hierarchy_name,
                                        &(physical_pb_graph_node->clock_pins[iport][ipin]),
                                        physical_pb, pb_id);
@@ -181,6 +179,7 @@ void disable_pb_graph_node_unused_pins(std::fstream& fp,
  *******************************************************************/
 static 
 void disable_pb_graph_node_unused_mux_inputs(std::fstream& fp, 
+                                             AnalysisSdcDisableTimingWriter& disable_timing_writer,
                                              const VprDeviceAnnotation& device_annotation,
                                              const ModuleManager& module_manager,
                                              const ModuleId& parent_module,
@@ -188,9 +187,9 @@ void disable_pb_graph_node_unused_mux_inputs(std::fstream& fp,
                                              t_pb_graph_node* physical_pb_graph_node,
                                              const PhysicalPb& physical_pb) {
 
-  fp << "#######################################" << std::endl; 
-  fp << "# Disable unused mux_inputs for pb_graph_node " << physical_pb_graph_node->pb_type->name << "[" << physical_pb_graph_node->placement_index << "]" << std::endl;
-  fp << "#######################################" << std::endl; 
+  fp << "#######################################" << "\n"; 
+  fp << "# Disable unused mux_inputs for pb_graph_node " << physical_pb_graph_node->pb_type->name << "[" << physical_pb_graph_node->placement_index << "]" << "\n";
+  fp << "#######################################" << "\n"; 
 
   t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type;
 
@@ -260,7 +259,7 @@ void disable_pb_graph_node_unused_mux_inputs(std::fstream& fp,
         continue;
       }
 
-      disable_analysis_module_input_pin_net_sinks(fp, module_manager, parent_module,
+      disable_analysis_module_input_pin_net_sinks(disable_timing_writer, module_manager, parent_module,
                                                   hierarchy_name,
                                                   module_port, ipin,
                                                   mapped_net,
@@ -286,7 +285,7 @@ void disable_pb_graph_node_unused_mux_inputs(std::fstream& fp,
         continue;
       }
 
-      disable_analysis_module_input_pin_net_sinks(fp, module_manager, parent_module,
+      disable_analysis_module_input_pin_net_sinks(disable_timing_writer, module_manager, parent_module,
                                                   hierarchy_name,
                                                   module_port, ipin,
                                                   mapped_net,
@@ -321,7 +320,7 @@ void disable_pb_graph_node_unused_mux_inputs(std::fstream& fp,
             continue;
           }
 
-          disable_analysis_module_output_pin_net_sinks(fp, module_manager, parent_module,
+          disable_analysis_module_output_pin_net_sinks(disable_timing_writer, module_manager, parent_module,
                                                        hierarchy_name,
                                                        child_module, inst, 
                                                        module_port, ipin,
@@ -391,17 +390,18 @@ void disable_pb_graph_node_unused_mux_inputs(std::fstream& fp,
  *******************************************************************/
 static 
 void rec_print_analysis_sdc_disable_pb_graph_node_unused_resources(std::fstream& fp, 
+                                                                   AnalysisSdcDisableTimingWriter& disable_timing_writer,
                                                                    const VprDeviceAnnotation& device_annotation,
                                                                    const ModuleManager& module_manager,
                                                                    const ModuleId& parent_module,
-                                                                   const std::string& hierarchy_name,
+                                                                   InstancePathBuilder& hierarchy_path,
                                                                    t_pb_graph_node* physical_pb_graph_node,
                                                                    const PhysicalPb& physical_pb) {
   t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type;
 
   /* Disable unused input ports and output ports of this pb_graph_node (parent_module) */
-  disable_pb_graph_node_unused_pins(fp, module_manager, parent_module,
-                                    hierarchy_name, physical_pb_graph_node, physical_pb); 
+  disable_pb_graph_node_unused_pins(fp, disable_timing_writer, module_manager, parent_module,
+                                    hierarchy_path.path(), physical_pb_graph_node, physical_pb); 
 
   /* Return if this is the primitive pb_type 
    * Note: this must return before we disable any unused inputs of routing multiplexer!
@@ -412,9 +412,9 @@ void rec_print_analysis_sdc_disable_pb_graph_node_unused_resources(std::fstream&
   }
 
   /* Disable unused inputs of routing multiplexers of this pb_graph_node */
-  disable_pb_graph_node_unused_mux_inputs(fp, device_annotation,
+  disable_pb_graph_node_unused_mux_inputs(fp, disable_timing_writer, device_annotation,
                                           module_manager, parent_module, 
-                                          hierarchy_name, physical_pb_graph_node,
+                                          hierarchy_path.path(), physical_pb_graph_node,
                                           physical_pb);
 
 
@@ -434,12 +434,14 @@ void rec_print_analysis_sdc_disable_pb_graph_node_unused_resources(std::fstream&
       /* Must have a valid instance name!!! */
       VTR_ASSERT(false == child_instance_name.empty()); 
 
-      std::string updated_hierarchy_name = hierarchy_name + child_instance_name + std::string("/");
+      hierarchy_path.push(child_instance_name);
 
-      rec_print_analysis_sdc_disable_pb_graph_node_unused_resources(fp, device_annotation,
-                                                                    module_manager, child_module, updated_hierarchy_name, 
+      rec_print_analysis_sdc_disable_pb_graph_node_unused_resources(fp, disable_timing_writer, device_annotation,
+                                                                    module_manager, child_module, hierarchy_path, 
                                                                     &(physical_pb_graph_node->child_pb_graph_nodes[physical_mode->index][ichild][inst]), 
                                                                     physical_pb); 
+
+      hierarchy_path.pop();
     }
   }
 }
@@ -463,6 +465,7 @@ void rec_print_analysis_sdc_disable_pb_graph_node_unused_resources(std::fstream&
  *******************************************************************/
 static 
 void print_analysis_sdc_disable_pb_block_unused_resources(std::fstream& fp,
+                                                          AnalysisSdcDisableTimingWriter& disable_timing_writer,
                                                           t_physical_tile_type_ptr grid_type,
                                                           const vtr::Point<size_t>& grid_coordinate,
                                                           const VprDeviceAnnotation& device_annotation,
@@ -491,30 +494,34 @@ void print_analysis_sdc_disable_pb_block_unused_resources(std::fstream& fp,
   VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
 
   /* Print comments */
-  fp << "#######################################" << std::endl; 
+  fp << "#######################################" << "\n"; 
  
   if (true == unused_block) {
-    fp << "# Disable Timing for unused grid[" << grid_coordinate.x() << "][" << grid_coordinate.y() << "][" << grid_z << "]" << std::endl;
+    fp << "# Disable Timing for unused grid[" << grid_coordinate.x() << "][" << grid_coordinate.y() << "][" << grid_z << "]" << "\n";
   } else {
     VTR_ASSERT_SAFE(false == unused_block);
-    fp << "# Disable Timing for unused resources in grid[" << grid_coordinate.x() << "][" << grid_coordinate.y() << "][" << grid_z << "]" << std::endl;
+    fp << "# Disable Timing for unused resources in grid[" << grid_coordinate.x() << "][" << grid_coordinate.y() << "][" << grid_z << "]" << "\n";
   }
 
-  fp << "#######################################" << std::endl; 
+  fp << "#######################################" << "\n"; 
 
-  std::string hierarchy_name = grid_instance_name + std::string("/") + pb_instance_name + std::string("/");
+  InstancePathBuilder hierarchy_path(std::string("/"));
+  hierarchy_path.push(grid_instance_name);
+  hierarchy_path.push(pb_instance_name);
 
   /* Go recursively through the pb_graph hierarchy, and disable all the ports level by level */
   if (true == unused_block) {
     rec_print_analysis_sdc_disable_unused_pb_graph_nodes(fp, device_annotation,
-                                                         module_manager, pb_module, hierarchy_name,
+                                                         module_manager, pb_module, hierarchy_path,
                                                          pb_graph_head); 
   } else { 
     VTR_ASSERT_SAFE(false == unused_block);
-    rec_print_analysis_sdc_disable_pb_graph_node_unused_resources(fp, device_annotation,
-                                                                  module_manager, pb_module, hierarchy_name,
+    rec_print_analysis_sdc_disable_pb_graph_node_unused_resources(fp, disable_timing_writer, device_annotation,
+                                                                  module_manager, pb_module, hierarchy_path,
                                                                   pb_graph_head, physical_pb); 
   }
+
+  disable_timing_writer.flush();
 }
 
 /********************************************************************
@@ -522,8 +529,8 @@ void print_analysis_sdc_disable_pb_block_unused_resources(std::fstream& fp,
  * This is very straightforward!
  * Just walk through each pb_type and disable all the ports using wildcards
  *******************************************************************/
-static 
 void print_analysis_sdc_disable_unused_grid(std::fstream& fp, 
+                                            AnalysisSdcDisableTimingWriter& disable_timing_writer,
                                             const vtr::Point<size_t>& grid_coordinate,
                                             const DeviceGrid& grids, 
                                             const VprDeviceAnnotation& device_annotation,
@@ -557,9 +564,9 @@ void print_analysis_sdc_disable_unused_grid(std::fstream& fp,
   VTR_ASSERT(true == module_manager.valid_module_id(grid_module));
 
   /* Print comments */
-  fp << "#######################################" << std::endl; 
-  fp << "# Disable Timing for grid[" << grid_coordinate.x() << "][" << grid_coordinate.y() << "]" << std::endl;
-  fp << "#######################################" << std::endl; 
+  fp << "#######################################" << "\n"; 
+  fp << "# Disable Timing for grid[" << grid_coordinate.x() << "][" << grid_coordinate.y() << "]" << "\n";
+  fp << "#######################################" << "\n"; 
 
   /* For used grid, find the unused rr_node in the local rr_graph 
    * and then disable each port which is not used
@@ -569,14 +576,14 @@ void print_analysis_sdc_disable_unused_grid(std::fstream& fp,
   for (const ClusterBlockId& blk_id : place_annotation.grid_blocks(grid_coordinate)) {
     if (ClusterBlockId::INVALID() != blk_id) { 
       const PhysicalPb& physical_pb = cluster_annotation.physical_pb(blk_id);
-      print_analysis_sdc_disable_pb_block_unused_resources(fp, grid_type, grid_coordinate,
+      print_analysis_sdc_disable_pb_block_unused_resources(fp, disable_timing_writer, grid_type, grid_coordinate,
                                                            device_annotation,
                                                            module_manager, grid_instance_name, grid_z,
                                                            physical_pb, false);
     } else {
       VTR_ASSERT(ClusterBlockId::INVALID() == blk_id);
       /* For unused grid, disable all the pins in the physical_pb_type */
-      print_analysis_sdc_disable_pb_block_unused_resources(fp, grid_type, grid_coordinate,
+      print_analysis_sdc_disable_pb_block_unused_resources(fp, disable_timing_writer, grid_type, grid_coordinate,
                                                            device_annotation, 
                                                            module_manager, grid_instance_name, grid_z,
                                                            PhysicalPb(), true);
@@ -608,6 +615,7 @@ void print_analysis_sdc_disable_unused_grid(std::fstream& fp,
  *
  *******************************************************************/
 void print_analysis_sdc_disable_unused_grids(std::fstream& fp, 
+                                             AnalysisSdcDisableTimingWriter& disable_timing_writer,
                                              const DeviceGrid& grids, 
                                              const VprDeviceAnnotation& device_annotation,
                                              const VprClusteringAnnotation& cluster_annotation,
@@ -620,7 +628,7 @@ void print_analysis_sdc_disable_unused_grids(std::fstream& fp,
       /* We should not meet any I/O grid */
       VTR_ASSERT(false == is_io_type(grids[ix][iy].type));
 
-      print_analysis_sdc_disable_unused_grid(fp, vtr::Point<size_t>(ix, iy),
+      print_analysis_sdc_disable_unused_grid(fp, disable_timing_writer, vtr::Point<size_t>(ix, iy),
                                              grids, device_annotation, cluster_annotation, place_annotation,
                                              module_manager, NUM_SIDES);
     }
@@ -654,7 +662,7 @@ void print_analysis_sdc_disable_unused_grids(std::fstream& fp,
   /* Add instances of I/O grids to top_module */
   for (const e_side& io_side : io_sides) {
     for (const vtr::Point<size_t>& io_coordinate : io_coordinates[io_side]) {
-      print_analysis_sdc_disable_unused_grid(fp, io_coordinate,
+      print_analysis_sdc_disable_unused_grid(fp, disable_timing_writer, io_coordinate,
                                              grids, device_annotation, cluster_annotation, place_annotation,
                                              module_manager, io_side);
     }
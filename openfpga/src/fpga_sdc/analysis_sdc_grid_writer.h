@@ -11,6 +11,7 @@
 #include "vpr_device_annotation.h"
 #include "vpr_clustering_annotation.h"
 #include "vpr_placement_annotation.h"
+#include "analysis_sdc_disable_timing.h"
 
 /********************************************************************
  * Function declaration
@@ -19,7 +20,18 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+void print_analysis_sdc_disable_unused_grid(std::fstream& fp, 
+                                            AnalysisSdcDisableTimingWriter& disable_timing_writer,
+                                            const vtr::Point<size_t>& grid_coordinate,
+                                            const DeviceGrid& grids, 
+                                            const VprDeviceAnnotation& device_annotation,
+                                            const VprClusteringAnnotation& cluster_annotation,
+                                            const VprPlacementAnnotation& place_annotation,
+                                            const ModuleManager& module_manager,
+                                            const e_side& border_side);
+
 void print_analysis_sdc_disable_unused_grids(std::fstream& fp, 
+                                             AnalysisSdcDisableTimingWriter& disable_timing_writer,
                                              const DeviceGrid& grids, 
                                              const VprDeviceAnnotation& device_annotation,
                                              const VprClusteringAnnotation& cluster_annotation,
@@ -14,6 +14,8 @@ AnalysisSdcOption::AnalysisSdcOption(const std::string& sdc_dir) {
   flatten_names_ = false;
   time_unit_ = 1.;
   generate_sdc_analysis_ = false;
+  compact_disable_timing_ = false;
+  incremental_ = false;
 }
 
 /********************************************************************
@@ -35,6 +37,14 @@ bool AnalysisSdcOption::generate_sdc_analysis() const {
   return generate_sdc_analysis_;
 }
 
+bool AnalysisSdcOption::compact_disable_timing() const {
+  return compact_disable_timing_;
+}
+
+bool AnalysisSdcOption::incremental() const {
+  return incremental_;
+}
+
 /********************************************************************
  * Public mutators
  ********************************************************************/
@@ -54,4 +64,12 @@ void AnalysisSdcOption::set_generate_sdc_analysis(const bool& generate_sdc_analy
   generate_sdc_analysis_ = generate_sdc_analysis;
 }
 
+void AnalysisSdcOption::set_compact_disable_timing(const bool& compact_disable_timing) {
+  compact_disable_timing_ = compact_disable_timing;
+}
+
+void AnalysisSdcOption::set_incremental(const bool& incremental) {
+  incremental_ = incremental;
+}
+
 } /* end namespace openfpga */
@@ -19,16 +19,25 @@ class AnalysisSdcOption {
     bool flatten_names() const;
     float time_unit() const;
     bool generate_sdc_analysis() const;
+    bool compact_disable_timing() const;
+    bool incremental() const;
   public: /* Public mutators */
     void set_sdc_dir(const std::string& sdc_dir);
     void set_flatten_names(const bool& flatten_names);
     void set_time_unit(const float& time_unit);
     void set_generate_sdc_analysis(const bool& generate_sdc_analysis);
+    void set_compact_disable_timing(const bool& compact_disable_timing);
+    void set_incremental(const bool& incremental);
   private: /* Internal data */
     std::string sdc_dir_;
     bool generate_sdc_analysis_; 
     bool flatten_names_; 
     float time_unit_;
+    /* Merge the pins to be disabled into bus ranges and wildcards */
+    bool compact_disable_timing_;
+    /* Split the disable-timing constraints into one file per tile,
+     * and only rewrite the files of the tiles which are changed */
+    bool incremental_;
 };
 
 } /* end namespace openfpga */
@@ -0,0 +1,423 @@
+/********************************************************************
+ * This file includes functions that are used to write the SDC commands
+ * disabling the unused resources of a FPGA fabric in one file per tile
+ * (region), so that an ECO of a benchmark only rewrites the files of
+ * the regions which are changed.
+ *
+ * Each region gathers the grid and the General Switch Block (GSB),
+ * i.e., the switch block and the connection blocks, at a coordinate.
+ * The disable-timing constraints of a region only depend on
+ * - the nets mapped to the routing resources of its GSB
+ * - the blocks placed in its grid and the nets mapped to their pins
+ * which are digested, up to a renaming of the nets, and saved in a
+ * manifest. A region is written only if its digest differs from the
+ * one in the manifest of the previous run, or if its file is missing.
+ *******************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_hash.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+/* Headers from vprutil library */
+#include "vpr_utils.h"
+
+#include "openfpga_side_manager.h"
+
+#include "sdc_writer_naming.h"
+#include "sdc_writer_utils.h"
+#include "analysis_sdc_disable_timing.h"
+#include "analysis_sdc_grid_writer.h"
+#include "analysis_sdc_routing_writer.h"
+#include "analysis_sdc_region_writer.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Increase when the contents of the region files are changed,
+ * so that the files written by an older version are all rewritten
+ */
+constexpr size_t ANALYSIS_SDC_REGION_FORMAT_VERSION = 1;
+
+/********************************************************************
+ * Identify if the grid at a coordinate is written in the SDC file,
+ * as in print_analysis_sdc_disable_unused_grids(), and find its border side
+ *  - the corners of the fabric are not written
+ *  - empty grids and grids with an offset are skipped
+ *******************************************************************/
+static
+bool find_analysis_sdc_region_grid(const DeviceGrid& grids,
+                                   const vtr::Point<size_t>& grid_coordinate,
+                                   e_side& border_side) {
+  bool on_x_border = (0 == grid_coordinate.x()) || (grids.width() - 1 == grid_coordinate.x());
+  bool on_y_border = (0 == grid_coordinate.y()) || (grids.height() - 1 == grid_coordinate.y());
+  if ( (true == on_x_border) && (true == on_y_border) ) {
+    return false;
+  }
+
+  const t_grid_tile& grid = grids[grid_coordinate.x()][grid_coordinate.y()];
+  if ( (true == is_empty_type(grid.type))
+    || (0 < grid.width_offset)
+    || (0 < grid.height_offset) ) {
+    return false;
+  }
+
+  if (0 == grid_coordinate.y()) {
+    border_side = BOTTOM;
+  } else if (grids.height() - 1 == grid_coordinate.y()) {
+    border_side = TOP;
+  } else if (0 == grid_coordinate.x()) {
+    border_side = LEFT;
+  } else if (grids.width() - 1 == grid_coordinate.x()) {
+    border_side = RIGHT;
+  } else {
+    border_side = NUM_SIDES;
+  }
+  return true;
+}
+
+/********************************************************************
+ * Add a net to the digest of a region.
+ * The nets are numbered in the order they are met in the region,
+ * so that the digest does not depend on the net ids of the netlist,
+ * which are changed by an ECO
+ *******************************************************************/
+template<class NetId>
+static
+void checksum_combine_region_net(uint64_t& digest,
+                                 std::map<NetId, size_t>& region_nets,
+                                 const NetId& net) {
+  if (NetId::INVALID() == net) {
+    vtr::checksum_combine(digest, size_t(0));
+    return;
+  }
+  auto result = region_nets.insert(std::make_pair(net, region_nets.size() + 1));
+  vtr::checksum_combine(digest, result.first->second);
+}
+
+/********************************************************************
+ * Add the nets mapped to the routing resources of a GSB to the digest
+ *******************************************************************/
+static
+void checksum_combine_region_gsb(uint64_t& digest,
+                                 const VprRoutingAnnotation& routing_annotation,
+                                 const RRGSB& rr_gsb) {
+  std::map<ClusterNetId, size_t> region_nets;
+
+  vtr::checksum_combine(digest, rr_gsb.is_cb_exist(CHANX));
+  vtr::checksum_combine(digest, rr_gsb.is_cb_exist(CHANY));
+  vtr::checksum_combine(digest, rr_gsb.is_sb_exist());
+
+  for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+    SideManager side_manager(side);
+    for (size_t itrack = 0; itrack < rr_gsb.get_chan_width(side_manager.get_side()); ++itrack) {
+      checksum_combine_region_net(digest, region_nets,
+                                  routing_annotation.rr_node_net(rr_gsb.get_chan_node(side_manager.get_side(), itrack)));
+    }
+    for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(side_manager.get_side()); ++inode) {
+      checksum_combine_region_net(digest, region_nets,
+                                  routing_annotation.rr_node_net(rr_gsb.get_ipin_node(side_manager.get_side(), inode)));
+    }
+    for (size_t inode = 0; inode < rr_gsb.get_num_opin_nodes(side_manager.get_side()); ++inode) {
+      checksum_combine_region_net(digest, region_nets,
+                                  routing_annotation.rr_node_net(rr_gsb.get_opin_node(side_manager.get_side(), inode)));
+    }
+  }
+}
+
+/********************************************************************
+ * Add the nets mapped to the pins of a group of ports of a physical pb
+ * to the digest. The pins are identified by their index in the cluster
+ *******************************************************************/
+static
+void checksum_combine_region_pb_pins(uint64_t& digest,
+                                     std::map<AtomNetId, size_t>& region_nets,
+                                     const PhysicalPb& physical_pb,
+                                     const PhysicalPbId& pb,
+                                     t_pb_graph_pin** pins,
+                                     const int& num_ports,
+                                     const int* num_pins) {
+  for (int iport = 0; iport < num_ports; ++iport) {
+    for (int ipin = 0; ipin < num_pins[iport]; ++ipin) {
+      const t_pb_graph_pin* pb_graph_pin = &(pins[iport][ipin]);
+      vtr::checksum_combine(digest, pb_graph_pin->pin_count_in_cluster);
+      checksum_combine_region_net(digest, region_nets,
+                                  physical_pb.pb_graph_pin_atom_net(pb, pb_graph_pin));
+      vtr::checksum_combine(digest, physical_pb.is_wire_lut_output(pb, pb_graph_pin));
+    }
+  }
+}
+
+/********************************************************************
+ * Add the blocks placed in a grid and the nets mapped to their pins
+ * to the digest
+ *******************************************************************/
+static
+void checksum_combine_region_grid(uint64_t& digest,
+                                  const VprClusteringAnnotation& cluster_annotation,
+                                  const VprPlacementAnnotation& place_annotation,
+                                  const DeviceGrid& grids,
+                                  const vtr::Point<size_t>& grid_coordinate,
+                                  const e_side& border_side) {
+  std::map<AtomNetId, size_t> region_nets;
+
+  vtr::checksum_combine(digest, grids[grid_coordinate.x()][grid_coordinate.y()].type->index);
+  vtr::checksum_combine(digest, border_side);
+
+  for (const ClusterBlockId& blk_id : place_annotation.grid_blocks(grid_coordinate)) {
+    vtr::checksum_combine(digest, ClusterBlockId::INVALID() != blk_id);
+    if (ClusterBlockId::INVALID() == blk_id) {
+      continue;
+    }
+    const PhysicalPb& physical_pb = cluster_annotation.physical_pb(blk_id);
+    for (const PhysicalPbId& pb : physical_pb.pbs()) {
+      const t_pb_graph_node* pb_graph_node = physical_pb.pb_graph_node(pb);
+      checksum_combine_region_pb_pins(digest, region_nets, physical_pb, pb,
+                                      pb_graph_node->input_pins, pb_graph_node->num_input_ports, pb_graph_node->num_input_pins);
+      checksum_combine_region_pb_pins(digest, region_nets, physical_pb, pb,
+                                      pb_graph_node->output_pins, pb_graph_node->num_output_ports, pb_graph_node->num_output_pins);
+      checksum_combine_region_pb_pins(digest, region_nets, physical_pb, pb,
+                                      pb_graph_node->clock_pins, pb_graph_node->num_clock_ports, pb_graph_node->num_clock_pins);
+    }
+    /* Mark the end of the block */
+    vtr::checksum_combine(digest, size_t(-1));
+  }
+}
+
+/********************************************************************
+ * The digest shared by all the regions, which covers the options
+ * and the fabric. When it changes, all the regions are rewritten
+ *******************************************************************/
+static
+uint64_t analysis_sdc_regions_global_digest(const AnalysisSdcOption& option,
+                                            const VprContext& vpr_ctx,
+                                            const OpenfpgaContext& openfpga_ctx,
+                                            const bool& compact_routing_hierarchy) {
+  uint64_t digest = vtr::CHECKSUM_INIT;
+  vtr::checksum_combine(digest, ANALYSIS_SDC_REGION_FORMAT_VERSION);
+  vtr::checksum_combine(digest, option.flatten_names());
+  vtr::checksum_combine(digest, option.compact_disable_timing());
+  vtr::checksum_combine(digest, compact_routing_hierarchy);
+  vtr::checksum_combine(digest, vpr_ctx.device().grid.width());
+  vtr::checksum_combine(digest, vpr_ctx.device().grid.height());
+  vtr::checksum_combine(digest, vpr_ctx.device().rr_graph.nodes().size());
+  vtr::checksum_combine(digest, vpr_ctx.device().rr_graph.edges().size());
+  vtr::checksum_combine(digest, openfpga_ctx.module_graph().modules().size());
+  return digest;
+}
+
+/********************************************************************
+ * Read the digests of the regions written by a previous run.
+ * The manifest includes the global digest in its first line,
+ * and then the name and the digest of a region per line.
+ * Return an empty map if the manifest is missing or if its global digest
+ * is different, i.e., all the regions should be written
+ *******************************************************************/
+static
+std::map<std::string, uint64_t> read_analysis_sdc_region_manifest(const std::string& manifest_fname,
+                                                                  const uint64_t& global_digest) {
+  std::map<std::string, uint64_t> region_digests;
+
+  std::ifstream fp(manifest_fname);
+  if (!fp.is_open()) {
+    return region_digests;
+  }
+
+  std::string line;
+  if (!std::getline(fp, line)) {
+    return region_digests;
+  }
+
+  /* A corrupted manifest is ignored */
+  try {
+    if (std::stoull(line, nullptr, 16) != global_digest) {
+      return region_digests;
+    }
+
+    while (std::getline(fp, line)) {
+      std::istringstream line_stream(line);
+      std::string region_name;
+      std::string region_digest;
+      if (line_stream >> region_name >> region_digest) {
+        region_digests[region_name] = std::stoull(region_digest, nullptr, 16);
+      }
+    }
+  } catch (const std::logic_error&) {
+    region_digests.clear();
+  }
+  return region_digests;
+}
+
+/********************************************************************
+ * Write the SDC commands disabling the unused resources of a region
+ *******************************************************************/
+static
+void print_analysis_sdc_disable_unused_region(const std::string& region_fname,
+                                              const AnalysisSdcOption& option,
+                                              const VprContext& vpr_ctx,
+                                              const OpenfpgaContext& openfpga_ctx,
+                                              const vtr::Point<size_t>& coordinate,
+                                              const bool& write_grid,
+                                              const e_side& border_side,
+                                              const bool& compact_routing_hierarchy) {
+  BufferedFileStream fp;
+  fp.open(region_fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(region_fname.c_str(), fp);
+
+  print_sdc_file_header(fp, std::string("Disable timing for the unused resources of tile [") + std::to_string(coordinate.x()) + std::string("][") + std::to_string(coordinate.y()) + std::string("]"));
+
+  AnalysisSdcDisableTimingWriter disable_timing_writer(fp, openfpga_ctx.module_graph(),
+                                                       option.compact_disable_timing());
+
+  const DeviceRRGSB& device_rr_gsb = openfpga_ctx.device_rr_gsb();
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  if ( (coordinate.x() < gsb_range.x()) && (coordinate.y() < gsb_range.y()) ) {
+    const RRGSB& rr_gsb = device_rr_gsb.get_gsb(coordinate);
+    for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+      if (false == rr_gsb.is_cb_exist(cb_type)) {
+        continue;
+      }
+      print_analysis_sdc_disable_cb_unused_resources(fp, disable_timing_writer,
+                                                     vpr_ctx.atom(),
+                                                     openfpga_ctx.module_graph(),
+                                                     vpr_ctx.device().rr_graph,
+                                                     openfpga_ctx.vpr_routing_annotation(),
+                                                     device_rr_gsb,
+                                                     rr_gsb,
+                                                     cb_type,
+                                                     compact_routing_hierarchy);
+    }
+    if (true == rr_gsb.is_sb_exist()) {
+      print_analysis_sdc_disable_sb_unused_resources(fp, disable_timing_writer,
+                                                     vpr_ctx.atom(),
+                                                     openfpga_ctx.module_graph(),
+                                                     vpr_ctx.device().rr_graph,
+                                                     openfpga_ctx.vpr_routing_annotation(),
+                                                     device_rr_gsb,
+                                                     rr_gsb,
+                                                     compact_routing_hierarchy);
+    }
+  }
+
+  if (true == write_grid) {
+    print_analysis_sdc_disable_unused_grid(fp, disable_timing_writer, coordinate,
+                                           vpr_ctx.device().grid,
+                                           openfpga_ctx.vpr_device_annotation(),
+                                           openfpga_ctx.vpr_clustering_annotation(),
+                                           openfpga_ctx.vpr_placement_annotation(),
+                                           openfpga_ctx.module_graph(),
+                                           border_side);
+  }
+
+  disable_timing_writer.flush();
+  fp.close();
+}
+
+/********************************************************************
+ * Disable the timing of the unused resources of the fabric
+ * in one file per region under the SDC directory, which are sourced
+ * by the SDC file of the given stream.
+ * Only the regions which are changed since the previous run are written
+ *******************************************************************/
+void print_analysis_sdc_disable_unused_regions(std::fstream& fp,
+                                               const AnalysisSdcOption& option,
+                                               const VprContext& vpr_ctx,
+                                               const OpenfpgaContext& openfpga_ctx,
+                                               const bool& compact_routing_hierarchy) {
+  /* Validate file stream */
+  valid_file_stream(fp);
+
+  std::string region_dir = option.sdc_dir() + std::string(SDC_ANALYSIS_REGION_DIR_NAME);
+  create_directory(region_dir);
+
+  std::string manifest_fname = region_dir + std::string(SDC_ANALYSIS_REGION_MANIFEST_FILE_NAME);
+  uint64_t global_digest = analysis_sdc_regions_global_digest(option, vpr_ctx, openfpga_ctx, compact_routing_hierarchy);
+  std::map<std::string, uint64_t> prev_region_digests = read_analysis_sdc_region_manifest(manifest_fname, global_digest);
+
+  /* The manifest is written to a temporary file first,
+   * so that an interrupted run does not leave a manifest of regions which are not written
+   */
+  std::string temp_manifest_fname = manifest_fname + std::string(".tmp");
+  std::fstream manifest_fp;
+  manifest_fp.open(temp_manifest_fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(temp_manifest_fname.c_str(), manifest_fp);
+  manifest_fp << std::hex << global_digest << "\n";
+
+  const DeviceGrid& grids = vpr_ctx.device().grid;
+  const DeviceRRGSB& device_rr_gsb = openfpga_ctx.device_rr_gsb();
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+
+  size_t num_regions = 0;
+  size_t num_written_regions = 0;
+
+  for (size_t ix = 0; ix < grids.width(); ++ix) {
+    for (size_t iy = 0; iy < grids.height(); ++iy) {
+      vtr::Point<size_t> coordinate(ix, iy);
+
+      uint64_t region_digest = vtr::CHECKSUM_INIT;
+      bool empty_region = true;
+
+      if ( (ix < gsb_range.x()) && (iy < gsb_range.y()) ) {
+        const RRGSB& rr_gsb = device_rr_gsb.get_gsb(coordinate);
+        if ( (true == rr_gsb.is_cb_exist(CHANX))
+          || (true == rr_gsb.is_cb_exist(CHANY))
+          || (true == rr_gsb.is_sb_exist()) ) {
+          checksum_combine_region_gsb(region_digest, openfpga_ctx.vpr_routing_annotation(), rr_gsb);
+          empty_region = false;
+        }
+      }
+
+      e_side border_side = NUM_SIDES;
+      bool write_grid = find_analysis_sdc_region_grid(grids, coordinate, border_side);
+      if (true == write_grid) {
+        checksum_combine_region_grid(region_digest,
+                                     openfpga_ctx.vpr_clustering_annotation(),
+                                     openfpga_ctx.vpr_placement_annotation(),
+                                     grids, coordinate, border_side);
+        empty_region = false;
+      }
+
+      if (true == empty_region) {
+        continue;
+      }
+      num_regions++;
+
+      std::string region_name = std::string("tile_") + std::to_string(ix) + std::string("__") + std::to_string(iy) + std::string("_");
+      std::string region_fname = region_dir + region_name + std::string(SDC_FILE_NAME_POSTFIX);
+
+      auto prev_region_digest = prev_region_digests.find(region_name);
+      bool region_changed = (prev_region_digests.end() == prev_region_digest)
+                         || (prev_region_digest->second != region_digest)
+                         || (false == std::ifstream(region_fname).good());
+      if (true == region_changed) {
+        print_analysis_sdc_disable_unused_region(region_fname, option, vpr_ctx, openfpga_ctx,
+                                                 coordinate, write_grid, border_side,
+                                                 compact_routing_hierarchy);
+        num_written_regions++;
+      }
+
+      manifest_fp << region_name << " " << region_digest << "\n";
+
+      fp << "source " << region_fname << "\n";
+    }
+  }
+
+  manifest_fp.close();
+  if (0 != std::rename(temp_manifest_fname.c_str(), manifest_fname.c_str())) {
+    VTR_LOG_ERROR("Unable to replace file '%s' by '%s'!\n",
+                  manifest_fname.c_str(), temp_manifest_fname.c_str());
+  }
+
+  VTR_LOG("Wrote %lu of %lu regions of the analysis SDC (the others are unchanged)\n",
+          num_written_regions, num_regions);
+}
+
+} /* end namespace openfpga */
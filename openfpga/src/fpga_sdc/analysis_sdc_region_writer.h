@@ -0,0 +1,27 @@
+#ifndef ANALYSIS_SDC_REGION_WRITER_H
+#define ANALYSIS_SDC_REGION_WRITER_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <fstream>
+#include "vpr_context.h"
+#include "openfpga_context.h"
+#include "analysis_sdc_option.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+void print_analysis_sdc_disable_unused_regions(std::fstream& fp,
+                                               const AnalysisSdcOption& option,
+                                               const VprContext& vpr_ctx,
+                                               const OpenfpgaContext& openfpga_ctx,
+                                               const bool& compact_routing_hierarchy);
+
+} /* end namespace openfpga */
+
+#endif
@@ -29,8 +29,8 @@ namespace openfpga {
  * 2. all the unused inputs (unmapped by a benchmark) of routing multiplexers 
  *    in a connection block
  *******************************************************************/
-static 
 void print_analysis_sdc_disable_cb_unused_resources(std::fstream& fp, 
+                                                    AnalysisSdcDisableTimingWriter& disable_timing_writer,
                                                     const AtomContext& atom_ctx, 
                                                     const ModuleManager& module_manager, 
                                                     const RRGraph& rr_graph, 
@@ -62,9 +62,9 @@ void print_analysis_sdc_disable_cb_unused_resources(std::fstream& fp,
   VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
 
   /* Print comments */
-  fp << "##################################################" << std::endl; 
-  fp << "# Disable timing for Connection block " << cb_module_name << std::endl;
-  fp << "##################################################" << std::endl; 
+  fp << "##################################################" << "\n"; 
+  fp << "# Disable timing for Connection block " << cb_module_name << "\n";
+  fp << "##################################################" << "\n"; 
 
   /* Disable all the input port (routing tracks), which are not used by benchmark */
   for (size_t itrack = 0; itrack < rr_gsb.get_cb_chan_width(cb_type); ++itrack) {
@@ -85,10 +85,8 @@ void print_analysis_sdc_disable_cb_unused_resources(std::fstream& fp,
     BasicPort chan_port(module_manager.module_port(cb_module, module_port).get_name(),
                         itrack / 2, itrack / 2);
 
-    fp << "set_disable_timing ";
-    fp << cb_instance_name << "/";
-    fp << generate_sdc_port(chan_port);
-    fp << std::endl;
+    disable_timing_writer.disable_port(cb_instance_name + std::string("/"),
+                                       cb_module, chan_port);
   }
 
   /* Disable all the output port (routing tracks), which are not used by benchmark */
@@ -110,10 +108,8 @@ void print_analysis_sdc_disable_cb_unused_resources(std::fstream& fp,
     BasicPort chan_port(module_manager.module_port(cb_module, module_port).get_name(),
                         itrack / 2, itrack / 2);
 
-    fp << "set_disable_timing ";
-    fp << cb_instance_name << "/";
-    fp << generate_sdc_port(chan_port);
-    fp << std::endl;
+    disable_timing_writer.disable_port(cb_instance_name + std::string("/"),
+                                       cb_module, chan_port);
   }
 
   /* Build a map between mux_instance name and net_num */
@@ -156,10 +152,8 @@ void print_analysis_sdc_disable_cb_unused_resources(std::fstream& fp,
       ModulePortId module_port = module_manager.find_module_port(cb_module, port_name);
       VTR_ASSERT(true == module_manager.valid_module_port_id(cb_module, module_port));
 
-      fp << "set_disable_timing ";
-      fp << cb_instance_name << "/";
-      fp << generate_sdc_port(module_manager.module_port(cb_module, module_port));
-      fp << std::endl;
+      disable_timing_writer.disable_port(cb_instance_name + std::string("/"),
+                                         cb_module, module_manager.module_port(cb_module, module_port));
     }
   }
 
@@ -194,13 +188,15 @@ void print_analysis_sdc_disable_cb_unused_resources(std::fstream& fp,
 
     AtomNetId mapped_atom_net = atom_ctx.lookup.atom_net(routing_annotation.rr_node_net(chan_node)); 
 
-    disable_analysis_module_input_pin_net_sinks(fp, module_manager, cb_module,
+    disable_analysis_module_input_pin_net_sinks(disable_timing_writer, module_manager, cb_module,
                                                 cb_instance_name,
                                                 module_port, itrack / 2,
                                                 mapped_atom_net,
                                                 mux_instance_to_net_map);
 
   }
+
+  disable_timing_writer.flush();
 }
 
 /********************************************************************
@@ -209,6 +205,7 @@ void print_analysis_sdc_disable_cb_unused_resources(std::fstream& fp,
  *******************************************************************/
 static 
 void print_analysis_sdc_disable_unused_cb_ports(std::fstream& fp,
+                                                AnalysisSdcDisableTimingWriter& disable_timing_writer,
                                                 const AtomContext& atom_ctx, 
                                                 const ModuleManager& module_manager, 
                                                 const RRGraph& rr_graph, 
@@ -230,7 +227,7 @@ void print_analysis_sdc_disable_unused_cb_ports(std::fstream& fp,
         continue;
       }
 
-      print_analysis_sdc_disable_cb_unused_resources(fp, 
+      print_analysis_sdc_disable_cb_unused_resources(fp, disable_timing_writer, 
                                                      atom_ctx, 
                                                      module_manager, 
                                                      rr_graph, 
@@ -248,6 +245,7 @@ void print_analysis_sdc_disable_unused_cb_ports(std::fstream& fp,
  * and disable unused ports for each of them 
  *******************************************************************/
 void print_analysis_sdc_disable_unused_cbs(std::fstream& fp,
+                                           AnalysisSdcDisableTimingWriter& disable_timing_writer,
                                            const AtomContext& atom_ctx, 
                                            const ModuleManager& module_manager, 
                                            const RRGraph& rr_graph, 
@@ -255,14 +253,14 @@ void print_analysis_sdc_disable_unused_cbs(std::fstream& fp,
                                            const DeviceRRGSB& device_rr_gsb,
                                            const bool& compact_routing_hierarchy) {
 
-  print_analysis_sdc_disable_unused_cb_ports(fp, atom_ctx,
+  print_analysis_sdc_disable_unused_cb_ports(fp, disable_timing_writer, atom_ctx,
                                              module_manager, 
                                              rr_graph, 
                                              routing_annotation,
                                              device_rr_gsb,
                                              CHANX, compact_routing_hierarchy);
 
-  print_analysis_sdc_disable_unused_cb_ports(fp, atom_ctx,
+  print_analysis_sdc_disable_unused_cb_ports(fp, disable_timing_writer, atom_ctx,
                                              module_manager, 
                                              rr_graph, 
                                              routing_annotation,
@@ -276,8 +274,8 @@ void print_analysis_sdc_disable_unused_cbs(std::fstream& fp,
  * 2. all the unused inputs (unmapped by a benchmark) of routing multiplexers 
  *    in a switch block
  *******************************************************************/
-static 
 void print_analysis_sdc_disable_sb_unused_resources(std::fstream& fp, 
+                                                    AnalysisSdcDisableTimingWriter& disable_timing_writer,
                                                     const AtomContext& atom_ctx, 
                                                     const ModuleManager& module_manager, 
                                                     const RRGraph& rr_graph, 
@@ -308,9 +306,9 @@ void print_analysis_sdc_disable_sb_unused_resources(std::fstream& fp,
   VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
 
   /* Print comments */
-  fp << "##################################################" << std::endl; 
-  fp << "# Disable timing for Switch block " << sb_module_name << std::endl;
-  fp << "##################################################" << std::endl; 
+  fp << "##################################################" << "\n"; 
+  fp << "# Disable timing for Switch block " << sb_module_name << "\n";
+  fp << "##################################################" << "\n"; 
 
   /* Build a map between mux_instance name and net_num */
   std::map<std::string, AtomNetId> mux_instance_to_net_map;
@@ -354,10 +352,8 @@ void print_analysis_sdc_disable_sb_unused_resources(std::fstream& fp,
       BasicPort sb_port(module_manager.module_port(sb_module, module_port).get_name(),
                         itrack / 2, itrack / 2);
 
-      fp << "set_disable_timing ";
-      fp << sb_instance_name << "/";
-      fp << generate_sdc_port(sb_port);
-      fp << std::endl;
+      disable_timing_writer.disable_port(sb_instance_name + std::string("/"),
+                                         sb_module, sb_port);
     }
   }
 
@@ -393,10 +389,8 @@ void print_analysis_sdc_disable_sb_unused_resources(std::fstream& fp,
         continue;
       }
 
-      fp << "set_disable_timing ";
-      fp << sb_instance_name << "/";
-      fp << generate_sdc_port(module_manager.module_port(sb_module, module_port));
-      fp << std::endl;
+      disable_timing_writer.disable_port(sb_instance_name + std::string("/"),
+                                         sb_module, module_manager.module_port(sb_module, module_port));
     }
   }
 
@@ -452,7 +446,7 @@ void print_analysis_sdc_disable_sb_unused_resources(std::fstream& fp,
 
       AtomNetId mapped_atom_net = atom_ctx.lookup.atom_net(routing_annotation.rr_node_net(opin_node));
 
-      disable_analysis_module_input_port_net_sinks(fp, module_manager,
+      disable_analysis_module_input_port_net_sinks(disable_timing_writer, module_manager,
                                                    sb_module,
                                                    sb_instance_name,
                                                    module_port,
@@ -495,13 +489,15 @@ void print_analysis_sdc_disable_sb_unused_resources(std::fstream& fp,
 
       AtomNetId mapped_atom_net = atom_ctx.lookup.atom_net(routing_annotation.rr_node_net(chan_node));
 
-      disable_analysis_module_input_pin_net_sinks(fp, module_manager, sb_module,
+      disable_analysis_module_input_pin_net_sinks(disable_timing_writer, module_manager, sb_module,
                                                   sb_instance_name,
                                                   module_port, itrack / 2,
                                                   mapped_atom_net,
                                                   mux_instance_to_net_map);
     }
   }
+
+  disable_timing_writer.flush();
 }
 
 
@@ -510,6 +506,7 @@ void print_analysis_sdc_disable_sb_unused_resources(std::fstream& fp,
  * and disable unused ports for each of them 
  *******************************************************************/
 void print_analysis_sdc_disable_unused_sbs(std::fstream& fp,
+                                           AnalysisSdcDisableTimingWriter& disable_timing_writer,
                                            const AtomContext& atom_ctx, 
                                            const ModuleManager& module_manager, 
                                            const RRGraph& rr_graph, 
@@ -531,7 +528,7 @@ void print_analysis_sdc_disable_unused_sbs(std::fstream& fp,
         continue;
       }
 
-      print_analysis_sdc_disable_sb_unused_resources(fp,
+      print_analysis_sdc_disable_sb_unused_resources(fp, disable_timing_writer,
                                                      atom_ctx, 
                                                      module_manager, 
                                                      rr_graph, 
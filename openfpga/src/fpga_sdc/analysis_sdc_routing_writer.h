@@ -10,6 +10,7 @@
 #include "module_manager.h"
 #include "device_rr_gsb.h"
 #include "vpr_routing_annotation.h"
+#include "analysis_sdc_disable_timing.h"
 
 /********************************************************************
  * Function declaration
@@ -18,7 +19,19 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+void print_analysis_sdc_disable_cb_unused_resources(std::fstream& fp, 
+                                                    AnalysisSdcDisableTimingWriter& disable_timing_writer,
+                                                    const AtomContext& atom_ctx, 
+                                                    const ModuleManager& module_manager, 
+                                                    const RRGraph& rr_graph, 
+                                                    const VprRoutingAnnotation& routing_annotation, 
+                                                    const DeviceRRGSB& device_rr_gsb,
+                                                    const RRGSB& rr_gsb, 
+                                                    const t_rr_type& cb_type,
+                                                    const bool& compact_routing_hierarchy);
+
 void print_analysis_sdc_disable_unused_cbs(std::fstream& fp,
+                                           AnalysisSdcDisableTimingWriter& disable_timing_writer,
                                            const AtomContext& atom_ctx, 
                                            const ModuleManager& module_manager, 
                                            const RRGraph& rr_graph, 
@@ -26,7 +39,18 @@ void print_analysis_sdc_disable_unused_cbs(std::fstream& fp,
                                            const DeviceRRGSB& device_rr_gsb,
                                            const bool& compact_routing_hierarchy);
 
+void print_analysis_sdc_disable_sb_unused_resources(std::fstream& fp, 
+                                                    AnalysisSdcDisableTimingWriter& disable_timing_writer,
+                                                    const AtomContext& atom_ctx, 
+                                                    const ModuleManager& module_manager, 
+                                                    const RRGraph& rr_graph, 
+                                                    const VprRoutingAnnotation& routing_annotation, 
+                                                    const DeviceRRGSB& device_rr_gsb,
+                                                    const RRGSB& rr_gsb, 
+                                                    const bool& compact_routing_hierarchy);
+
 void print_analysis_sdc_disable_unused_sbs(std::fstream& fp,
+                                           AnalysisSdcDisableTimingWriter& disable_timing_writer,
                                            const AtomContext& atom_ctx, 
                                            const ModuleManager& module_manager, 
                                            const RRGraph& rr_graph, 
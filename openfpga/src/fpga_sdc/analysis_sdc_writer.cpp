@@ -5,6 +5,7 @@
 #include <ctime>
 #include <fstream>
 #include <iomanip>
+#include <unordered_set>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -23,8 +24,10 @@
 #include "sdc_writer_utils.h"
 #include "sdc_memory_utils.h"
 
+#include "analysis_sdc_disable_timing.h"
 #include "analysis_sdc_grid_writer.h"
 #include "analysis_sdc_routing_writer.h"
+#include "analysis_sdc_region_writer.h"
 #include "analysis_sdc_writer.h"
 
 /* begin namespace openfpga */
@@ -51,9 +54,9 @@ void print_analysis_sdc_io_delays(std::fstream& fp,
   valid_file_stream(fp);
 
   /* Print comments */
-  fp << "##################################################" << std::endl; 
-  fp << "# Create clock                                    " << std::endl;
-  fp << "##################################################" << std::endl; 
+  fp << "##################################################" << "\n"; 
+  fp << "# Create clock                                    " << "\n";
+  fp << "##################################################" << "\n"; 
 
   /* Get clock port from the global port */
   std::vector<BasicPort> operating_clock_ports;
@@ -77,10 +80,10 @@ void print_analysis_sdc_io_delays(std::fstream& fp,
     fp << generate_sdc_port(operating_clock_port);
     fp << " -period " << std::setprecision(10) << critical_path_delay / time_unit;
     fp << " -waveform {0 " << std::setprecision(10) << critical_path_delay / (2 * time_unit) << "}";
-    fp << std::endl;
+    fp << "\n";
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
   }
 
   /* There should be only one operating clock!
@@ -91,17 +94,19 @@ void print_analysis_sdc_io_delays(std::fstream& fp,
   /* In this function, we support only 1 type of I/Os */
   std::vector<BasicPort> module_io_ports = module_manager.module_ports_by_type(top_module, ModuleManager::MODULE_GPIO_PORT);
 
+  /* Find clock ports in benchmark, as well as the GPIO of each benchmark I/O, once for all the ports */
+  std::vector<std::string> benchmark_clock_port_name_list = find_atom_netlist_clock_port_names(atom_ctx.nlist, netlist_annotation);
+  std::unordered_set<std::string> benchmark_clock_port_names(benchmark_clock_port_name_list.begin(), benchmark_clock_port_name_list.end());
+  vtr::vector<AtomBlockId, size_t> atom_io_indices = find_atom_netlist_io_indices(atom_ctx, place_ctx, io_location_map);
+
   for (const BasicPort& module_io_port : module_io_ports) {
     /* Keep tracking which I/Os have been used */
     std::vector<bool> io_used(module_io_port.get_width(), false);
 
-    /* Find clock ports in benchmark */
-    std::vector<std::string> benchmark_clock_port_names = find_atom_netlist_clock_port_names(atom_ctx.nlist, netlist_annotation);
-
     /* Print comments */
-    fp << "##################################################" << std::endl; 
-    fp << "# Create input and output delays for used I/Os    " << std::endl;
-    fp << "##################################################" << std::endl; 
+    fp << "##################################################" << "\n"; 
+    fp << "# Create input and output delays for used I/Os    " << "\n";
+    fp << "##################################################" << "\n"; 
 
     for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
       /* Bypass non-I/O atom blocks ! */
@@ -111,14 +116,12 @@ void print_analysis_sdc_io_delays(std::fstream& fp,
       }
 
       /* clock net or constant generator should be disabled in timing analysis */
-      if (benchmark_clock_port_names.end() != std::find(benchmark_clock_port_names.begin(), benchmark_clock_port_names.end(), atom_ctx.nlist.block_name(atom_blk))) {
+      if (0 < benchmark_clock_port_names.count(atom_ctx.nlist.block_name(atom_blk))) {
         continue;
       }
 
       /* Find the index of the mapped GPIO in top-level FPGA fabric */
-      size_t io_index = io_location_map.io_index(place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.x,
-                                                 place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.y,
-                                                 place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.z);
+      size_t io_index = atom_io_indices[atom_blk];
 
       /* Ensure that IO index is in range */
       BasicPort module_mapped_io_port = module_io_port; 
@@ -143,12 +146,12 @@ void print_analysis_sdc_io_delays(std::fstream& fp,
     }
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
 
     /* Print comments */
-    fp << "##################################################" << std::endl; 
-    fp << "# Disable timing for unused I/Os    " << std::endl;
-    fp << "##################################################" << std::endl; 
+    fp << "##################################################" << "\n"; 
+    fp << "# Disable timing for unused I/Os    " << "\n";
+    fp << "##################################################" << "\n"; 
 
     /* Wire the unused iopads to a constant */
     for (size_t io_index = 0; io_index < io_used.size(); ++io_index) {
@@ -165,7 +168,7 @@ void print_analysis_sdc_io_delays(std::fstream& fp,
     }
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
   }
 }
 
@@ -182,9 +185,9 @@ void print_analysis_sdc_disable_global_ports(std::fstream& fp,
   valid_file_stream(fp);
 
   /* Print comments */
-  fp << "##################################################" << std::endl; 
-  fp << "# Disable timing for global ports                 " << std::endl;
-  fp << "##################################################" << std::endl; 
+  fp << "##################################################" << "\n"; 
+  fp << "# Disable timing for global ports                 " << "\n";
+  fp << "##################################################" << "\n"; 
 
   for (const CircuitPortId& global_port : global_ports) {
     /* Skip operating clock here! */
@@ -238,7 +241,7 @@ void print_analysis_sdc(const AnalysisSdcOption& option,
   vtr::ScopedStartFinishTimer timer(timer_message);
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
 
   /* Validate file stream */
@@ -269,9 +272,24 @@ void print_analysis_sdc(const AnalysisSdcOption& option,
                                                               openfpga_ctx.module_graph(), top_module, 
                                                               format_dir_path(openfpga_ctx.module_graph().module_name(top_module)));
 
+  /* Split the constraints of the unused resources into one file per tile,
+   * and only rewrite the tiles which are changed since the previous run
+   */
+  if (true == option.incremental()) {
+    print_analysis_sdc_disable_unused_regions(fp, option, vpr_ctx, openfpga_ctx,
+                                              compact_routing_hierarchy);
+    fp.close();
+    return;
+  }
+
+  /* All the unused resources are disabled through the same writer,
+   * which compacts the pins if required 
+   */
+  AnalysisSdcDisableTimingWriter disable_timing_writer(fp, openfpga_ctx.module_graph(),
+                                                       option.compact_disable_timing());
 
   /* Disable timing for unused routing resources in connection blocks */
-  print_analysis_sdc_disable_unused_cbs(fp,
+  print_analysis_sdc_disable_unused_cbs(fp, disable_timing_writer,
                                         vpr_ctx.atom(), 
                                         openfpga_ctx.module_graph(),
                                         vpr_ctx.device().rr_graph,
@@ -280,7 +298,7 @@ void print_analysis_sdc(const AnalysisSdcOption& option,
                                         compact_routing_hierarchy);
 
   /* Disable timing for unused routing resources in switch blocks */
-  print_analysis_sdc_disable_unused_sbs(fp,
+  print_analysis_sdc_disable_unused_sbs(fp, disable_timing_writer,
                                         vpr_ctx.atom(), 
                                         openfpga_ctx.module_graph(),
                                         vpr_ctx.device().rr_graph,
@@ -289,7 +307,7 @@ void print_analysis_sdc(const AnalysisSdcOption& option,
                                         compact_routing_hierarchy);
 
   /* Disable timing for unused routing resources in grids (programmable blocks) */
-  print_analysis_sdc_disable_unused_grids(fp,
+  print_analysis_sdc_disable_unused_grids(fp, disable_timing_writer,
                                           vpr_ctx.device().grid,
                                           openfpga_ctx.vpr_device_annotation(),
                                           openfpga_ctx.vpr_clustering_annotation(),
@@ -10,7 +10,6 @@
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
 
-#include "sdc_writer_utils.h"
 #include "analysis_sdc_writer_utils.h"
 
 /* begin namespace openfpga */
@@ -47,7 +46,7 @@ bool is_rr_node_to_be_disable_for_analysis(const VprRoutingAnnotation& routing_a
  *                 |  +------>| sink port (do not disable! net_id = X)
  *
  *******************************************************************/
-void disable_analysis_module_input_pin_net_sinks(std::fstream& fp,
+void disable_analysis_module_input_pin_net_sinks(AnalysisSdcDisableTimingWriter& disable_timing_writer,
                                                  const ModuleManager& module_manager,
                                                  const ModuleId& parent_module,
                                                  const std::string& parent_instance_name,
@@ -55,9 +54,6 @@ void disable_analysis_module_input_pin_net_sinks(std::fstream& fp,
                                                  const size_t& module_input_pin,
                                                  const AtomNetId& mapped_net,
                                                  const std::map<std::string, AtomNetId> mux_instance_to_net_map) {
-  /* Validate file stream */
-  valid_file_stream(fp);
-
   /* Find the module net which sources from this port! */
   ModuleNetId module_net = module_manager.module_instance_port_net(parent_module, parent_module, 0, module_input_port, module_input_pin); 
   if (true != module_manager.valid_module_net_id(parent_module, module_net))
@@ -65,8 +61,8 @@ void disable_analysis_module_input_pin_net_sinks(std::fstream& fp,
 
   /* Touch each sink of the net! */
   for (const ModuleNetSinkId& sink_id : module_manager.module_net_sinks(parent_module, module_net)) {
-    ModuleId sink_module = module_manager.net_sink_modules(parent_module, module_net)[sink_id]; 
-    size_t sink_instance = module_manager.net_sink_instances(parent_module, module_net)[sink_id]; 
+    ModuleId sink_module = module_manager.net_sink_module(parent_module, module_net, sink_id); 
+    size_t sink_instance = module_manager.net_sink_instance(parent_module, module_net, sink_id); 
 
     /* Skip when sink module is the parent module, 
      * the output ports of parent modules have been disabled/enabled already! 
@@ -96,17 +92,14 @@ void disable_analysis_module_input_pin_net_sinks(std::fstream& fp,
       continue;
     }
 
-    BasicPort sink_port = module_manager.module_port(sink_module, module_manager.net_sink_ports(parent_module, module_net)[sink_id]);
-    sink_port.set_width(module_manager.net_sink_pins(parent_module, module_net)[sink_id],
-                        module_manager.net_sink_pins(parent_module, module_net)[sink_id]);
+    BasicPort sink_port = module_manager.module_port(sink_module, module_manager.net_sink_port(parent_module, module_net, sink_id));
+    sink_port.set_width(module_manager.net_sink_pin(parent_module, module_net, sink_id),
+                        module_manager.net_sink_pin(parent_module, module_net, sink_id));
 
     VTR_ASSERT(!sink_instance_name.empty());
     /* Get the input id that is used! Disable the unused inputs! */
-    fp << "set_disable_timing ";
-    fp << parent_instance_name;
-    fp << sink_instance_name << "/";
-    fp << generate_sdc_port(sink_port);
-    fp << std::endl;
+    disable_timing_writer.disable_port(parent_instance_name + sink_instance_name + std::string("/"),
+                                       sink_module, sink_port);
   }
 }
 
@@ -129,19 +122,16 @@ void disable_analysis_module_input_pin_net_sinks(std::fstream& fp,
  *                 |  +------>| sink port (do not disable! net_id = X)
  *
  *******************************************************************/
-void disable_analysis_module_input_port_net_sinks(std::fstream& fp,
+void disable_analysis_module_input_port_net_sinks(AnalysisSdcDisableTimingWriter& disable_timing_writer,
                                                   const ModuleManager& module_manager,
                                                   const ModuleId& parent_module,
                                                   const std::string& parent_instance_name,
                                                   const ModulePortId& module_input_port,
                                                   const AtomNetId& mapped_net,
                                                   const std::map<std::string, AtomNetId> mux_instance_to_net_map) {
-  /* Validate file stream */
-  valid_file_stream(fp);
-
   /* Find the module net which sources from this port! */
   for (const size_t& pin : module_manager.module_port(parent_module, module_input_port).pins()) {
-    disable_analysis_module_input_pin_net_sinks(fp, module_manager, parent_module,
+    disable_analysis_module_input_pin_net_sinks(disable_timing_writer, module_manager, parent_module,
                                                 parent_instance_name,
                                                 module_input_port, pin,
                                                 mapped_net,
@@ -171,7 +161,7 @@ void disable_analysis_module_input_port_net_sinks(std::fstream& fp,
 
  *
  *******************************************************************/
-void disable_analysis_module_output_pin_net_sinks(std::fstream& fp,
+void disable_analysis_module_output_pin_net_sinks(AnalysisSdcDisableTimingWriter& disable_timing_writer,
                                                   const ModuleManager& module_manager,
                                                   const ModuleId& parent_module,
                                                   const std::string& parent_instance_name,
@@ -181,17 +171,14 @@ void disable_analysis_module_output_pin_net_sinks(std::fstream& fp,
                                                   const size_t& child_module_pin,
                                                   const AtomNetId& mapped_net,
                                                   const std::map<std::string, AtomNetId> mux_instance_to_net_map) {
-  /* Validate file stream */
-  valid_file_stream(fp);
-
   /* Find the module net which sources from this port! */
   ModuleNetId module_net = module_manager.module_instance_port_net(parent_module, child_module, child_instance, child_module_port, child_module_pin); 
   VTR_ASSERT(true == module_manager.valid_module_net_id(parent_module, module_net));
 
   /* Touch each sink of the net! */
   for (const ModuleNetSinkId& sink_id : module_manager.module_net_sinks(parent_module, module_net)) {
-    ModuleId sink_module = module_manager.net_sink_modules(parent_module, module_net)[sink_id]; 
-    size_t sink_instance = module_manager.net_sink_instances(parent_module, module_net)[sink_id]; 
+    ModuleId sink_module = module_manager.net_sink_module(parent_module, module_net, sink_id); 
+    size_t sink_instance = module_manager.net_sink_instance(parent_module, module_net, sink_id); 
 
     /* Skip when sink module is the parent module, 
      * the output ports of parent modules have been disabled/enabled already! 
@@ -221,17 +208,14 @@ void disable_analysis_module_output_pin_net_sinks(std::fstream& fp,
       continue;
     }
 
-    BasicPort sink_port = module_manager.module_port(sink_module, module_manager.net_sink_ports(parent_module, module_net)[sink_id]);
-    sink_port.set_width(module_manager.net_sink_pins(parent_module, module_net)[sink_id],
-                        module_manager.net_sink_pins(parent_module, module_net)[sink_id]);
+    BasicPort sink_port = module_manager.module_port(sink_module, module_manager.net_sink_port(parent_module, module_net, sink_id));
+    sink_port.set_width(module_manager.net_sink_pin(parent_module, module_net, sink_id),
+                        module_manager.net_sink_pin(parent_module, module_net, sink_id));
 
     VTR_ASSERT(!sink_instance_name.empty());
     /* Get the input id that is used! Disable the unused inputs! */
-    fp << "set_disable_timing ";
-    fp << parent_instance_name;
-    fp << sink_instance_name << "/";
-    fp << generate_sdc_port(sink_port);
-    fp << std::endl;
+    disable_timing_writer.disable_port(parent_instance_name + sink_instance_name + std::string("/"),
+                                       sink_module, sink_port);
   }
 }
 
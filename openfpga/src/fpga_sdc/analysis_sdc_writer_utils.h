@@ -11,6 +11,7 @@
 #include "rr_graph_obj.h"
 #include "atom_netlist_fwd.h"
 #include "vpr_routing_annotation.h"
+#include "analysis_sdc_disable_timing.h"
 
 /********************************************************************
  * Function declaration
@@ -22,7 +23,7 @@ namespace openfpga {
 bool is_rr_node_to_be_disable_for_analysis(const VprRoutingAnnotation& routing_annotation,
                                            const RRNodeId& cur_rr_node);
 
-void disable_analysis_module_input_pin_net_sinks(std::fstream& fp,
+void disable_analysis_module_input_pin_net_sinks(AnalysisSdcDisableTimingWriter& disable_timing_writer,
                                                  const ModuleManager& module_manager,
                                                  const ModuleId& parent_module,
                                                  const std::string& parent_instance_name,
@@ -31,7 +32,7 @@ void disable_analysis_module_input_pin_net_sinks(std::fstream& fp,
                                                  const AtomNetId& mapped_net,
                                                  const std::map<std::string, AtomNetId> mux_instance_to_net_map);
 
-void disable_analysis_module_input_port_net_sinks(std::fstream& fp,
+void disable_analysis_module_input_port_net_sinks(AnalysisSdcDisableTimingWriter& disable_timing_writer,
                                                   const ModuleManager& module_manager,
                                                   const ModuleId& parent_module,
                                                   const std::string& parent_instance_name,
@@ -39,7 +40,7 @@ void disable_analysis_module_input_port_net_sinks(std::fstream& fp,
                                                   const AtomNetId& mapped_net,
                                                   const std::map<std::string, AtomNetId> mux_instance_to_net_map);
 
-void disable_analysis_module_output_pin_net_sinks(std::fstream& fp,
+void disable_analysis_module_output_pin_net_sinks(AnalysisSdcDisableTimingWriter& disable_timing_writer,
                                                   const ModuleManager& module_manager,
                                                   const ModuleId& parent_module,
                                                   const std::string& parent_instance_name,
@@ -19,6 +19,7 @@
 #include "openfpga_scale.h"
 #include "openfpga_port.h"
 #include "openfpga_digest.h"
+#include "openfpga_instance_path.h"
 
 #include "openfpga_naming.h"
 
@@ -50,13 +51,12 @@ void rec_print_pnr_sdc_constrain_configurable_chain(std::fstream& fp,
                                                     const float& tmin,
                                                     const ModuleManager& module_manager, 
                                                     const ModuleId& parent_module,
-                                                    const std::string& parent_module_path,
+                                                    InstancePathBuilder& module_path,
                                                     std::string& previous_module_path,
                                                     ModuleId& previous_module) {
 
   /* For each configurable child, we will go one level down in priority */
   for (size_t child_index = 0; child_index < module_manager.configurable_children(parent_module).size(); ++child_index) {
-    std::string child_module_path = parent_module_path;
     ModuleId child_module_id = module_manager.configurable_children(parent_module)[child_index];
     size_t child_instance_id = module_manager.configurable_child_instances(parent_module)[child_index];
     std::string child_instance_name;
@@ -66,17 +66,17 @@ void rec_print_pnr_sdc_constrain_configurable_chain(std::fstream& fp,
       child_instance_name = module_manager.instance_name(parent_module, child_module_id, child_instance_id);
     }
 
-    child_module_path += child_instance_name;
-    
-    child_module_path = format_dir_path(child_module_path);
+    module_path.push(child_instance_name);
 
     rec_print_pnr_sdc_constrain_configurable_chain(fp,
                                                    tmax, tmin,
                                                    module_manager, 
                                                    child_module_id, 
-                                                   child_module_path,
+                                                   module_path,
                                                    previous_module_path,
                                                    previous_module);
+
+    module_path.pop();
   }
 
   /* If there is no configurable children any more, this is a leaf module, print a SDC command for disable timing */
@@ -102,14 +102,14 @@ void rec_print_pnr_sdc_constrain_configurable_chain(std::fstream& fp,
         print_pnr_sdc_constrain_max_delay(fp, 
                                           previous_module_path, 
                                           output_port.get_name(),
-                                          parent_module_path, 
+                                          module_path.path(), 
                                           input_port.get_name(),
                                           tmax);
 
         print_pnr_sdc_constrain_min_delay(fp, 
                                           previous_module_path, 
                                           output_port.get_name(),
-                                          parent_module_path, 
+                                          module_path.path(), 
                                           input_port.get_name(),
                                           tmin);
       }
@@ -119,7 +119,7 @@ void rec_print_pnr_sdc_constrain_configurable_chain(std::fstream& fp,
   }
 
   /* Update previous module */
-  previous_module_path = parent_module_path;
+  previous_module_path = module_path.path();
   previous_module = parent_module;
 }
 
@@ -143,7 +143,7 @@ void print_pnr_sdc_constrain_configurable_chain(const std::string& sdc_fname,
   vtr::ScopedStartFinishTimer timer(timer_message);
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(sdc_fname.c_str(), fp);
@@ -161,10 +161,12 @@ void print_pnr_sdc_constrain_configurable_chain(const std::string& sdc_fname,
   /* Go recursively in the module manager, starting from the top-level module: instance id of the top-level module is 0 by default */
   std::string previous_module_path;
   ModuleId previous_module = ModuleId::INVALID();
+  InstancePathBuilder module_path(std::string("/"));
+  module_path.push(module_manager.module_name(top_module));
   rec_print_pnr_sdc_constrain_configurable_chain(fp,
                                                  max_delay, min_delay, 
                                                  module_manager, top_module, 
-                                                 format_dir_path(module_manager.module_name(top_module)),
+                                                 module_path,
                                                  previous_module_path,
                                                  previous_module);
 
@@ -47,7 +47,7 @@ void print_pnr_sdc_clock_port(std::fstream& fp,
   fp << " -period " << std::setprecision(10) << clock_period;
   fp << " -waveform {0 " << std::setprecision(10) << clock_period / 2 << "}";
   fp << " [get_ports {" << generate_sdc_port(port_to_constrain) << "}]";
-  fp << std::endl;
+  fp << "\n";
 }        
 
 /********************************************************************
@@ -78,14 +78,14 @@ void print_pnr_sdc_global_clock_ports(std::fstream& fp,
     if (true == circuit_lib.port_is_prog(clock_port)) {
       clock_period = programming_critical_path_delay;
       /* Print comments */
-      fp << "##################################################" << std::endl; 
-      fp << "# Create programmable clock                       " << std::endl;
-      fp << "##################################################" << std::endl; 
+      fp << "##################################################" << "\n"; 
+      fp << "# Create programmable clock                       " << "\n";
+      fp << "##################################################" << "\n"; 
     } else {
       /* Print comments */
-      fp << "##################################################" << std::endl; 
-      fp << "# Create clock                                    " << std::endl;
-      fp << "##################################################" << std::endl; 
+      fp << "##################################################" << "\n"; 
+      fp << "# Create clock                                    " << "\n";
+      fp << "##################################################" << "\n"; 
     }
 
     for (const size_t& pin : circuit_lib.pins(clock_port)) {
@@ -121,9 +121,9 @@ void print_pnr_sdc_global_non_clock_ports(std::fstream& fp,
     }
 
     /* Print comments */
-    fp << "##################################################" << std::endl; 
-    fp << "# Constrain other global ports                    " << std::endl;
-    fp << "##################################################" << std::endl; 
+    fp << "##################################################" << "\n"; 
+    fp << "# Constrain other global ports                    " << "\n";
+    fp << "##################################################" << "\n"; 
 
     /* Reach here, it means a non-clock global port and we need print constraints */
     float clock_period = operating_critical_path_delay; 
@@ -163,7 +163,7 @@ void print_pnr_sdc_global_ports(const std::string& sdc_dir,
   vtr::ScopedStartFinishTimer timer(timer_message);
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(sdc_fname.c_str(), fp);
@@ -33,6 +33,7 @@
 
 #include "sdc_writer_naming.h"
 #include "sdc_writer_utils.h"
+#include "sdc_parallel_writer.h"
 #include "pnr_sdc_grid_writer.h"
 
 /* begin namespace openfpga */
@@ -265,7 +266,7 @@ void print_pnr_sdc_constrain_pb_graph_node_timing(const std::string& sdc_dir,
   std::string sdc_fname(sdc_dir + pb_module_name + std::string(SDC_FILE_NAME_POSTFIX));
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(sdc_fname.c_str(), fp);
@@ -385,7 +386,7 @@ void print_pnr_sdc_constrain_primitive_pb_graph_node(const std::string& sdc_dir,
   std::string sdc_fname(sdc_dir + pb_module_name + std::string(SDC_FILE_NAME_POSTFIX));
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(sdc_fname.c_str(), fp);
@@ -539,13 +540,15 @@ void print_pnr_sdc_constrain_grid_timing(const std::string& sdc_dir,
                                          const VprDeviceAnnotation& device_annotation,
                                          const ModuleManager& module_manager,
                                          const ModuleId& top_module,
-                                         const bool& constrain_zero_delay_paths) {
+                                         const bool& constrain_zero_delay_paths,
+                                         const size_t& num_jobs) {
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Write SDC for constraining grid timing for P&R flow");
 
   std::string root_path = format_dir_path(module_manager.module_name(top_module));
 
+  std::vector<const t_physical_tile_type*> physical_tiles;
   for (const t_physical_tile_type& physical_tile : device_ctx.physical_tile_types) {
     /* Bypass empty type or nullptr */
     if (true == is_empty_type(&physical_tile)) {
@@ -553,10 +556,20 @@ void print_pnr_sdc_constrain_grid_timing(const std::string& sdc_dir,
     }
 
     VTR_ASSERT(1 == physical_tile.equivalent_sites.size());
-    t_pb_graph_node* pb_graph_head = physical_tile.equivalent_sites[0]->pb_graph_head;
-    if (nullptr == pb_graph_head) {
+    if (nullptr == physical_tile.equivalent_sites[0]->pb_graph_head) {
       continue;
     }
+    physical_tiles.push_back(&physical_tile);
+  }
+
+  /* The pb_types of each physical tile have their own SDC files.
+   * Note that the I/O grid modules on different sides share the same pb_types,
+   * so they are always written by the same job
+   */
+  print_sdc_files_in_parallel(physical_tiles.size(), num_jobs,
+                              [&](const size_t& itile) {
+    const t_physical_tile_type& physical_tile = *(physical_tiles[itile]);
+    t_pb_graph_node* pb_graph_head = physical_tile.equivalent_sites[0]->pb_graph_head;
 
     if (true == is_io_type(&physical_tile)) {
       /* Special for I/O block:
@@ -613,7 +626,7 @@ void print_pnr_sdc_constrain_grid_timing(const std::string& sdc_dir,
                                                   pb_graph_head,
                                                   constrain_zero_delay_paths);
     }
-  }
+  });
 }
 
 } /* end namespace openfpga */
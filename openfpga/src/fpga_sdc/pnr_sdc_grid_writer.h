@@ -24,7 +24,8 @@ void print_pnr_sdc_constrain_grid_timing(const std::string& sdc_dir,
                                          const VprDeviceAnnotation& device_annotation,
                                          const ModuleManager& module_manager,
                                          const ModuleId& top_module,
-                                         const bool& constrain_zero_delay_paths);
+                                         const bool& constrain_zero_delay_paths,
+                                         const size_t& num_jobs);
 
 } /* end namespace openfpga */
 
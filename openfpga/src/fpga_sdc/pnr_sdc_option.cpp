@@ -1,6 +1,9 @@
 /********************************************************************
  * Member functions for a data structure which includes all the options for the SDC generator
  ********************************************************************/
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
 #include "pnr_sdc_option.h"
 
 /* begin namespace openfpga */
@@ -23,6 +26,9 @@ PnrSdcOption::PnrSdcOption(const std::string& sdc_dir) {
   constrain_routing_multiplexer_outputs_ = false;
   constrain_switch_block_outputs_ = false;
   constrain_zero_delay_paths_ = false;
+  num_jobs_ = 1;
+  unique_module_only_ = false;
+  merge_mux_paths_ = false;
 }
 
 /********************************************************************
@@ -94,6 +100,18 @@ bool PnrSdcOption::constrain_zero_delay_paths() const {
   return constrain_zero_delay_paths_;
 }
 
+size_t PnrSdcOption::num_jobs() const {
+  return num_jobs_;
+}
+
+bool PnrSdcOption::unique_module_only() const {
+  return unique_module_only_;
+}
+
+bool PnrSdcOption::merge_mux_paths() const {
+  return merge_mux_paths_;
+}
+
 /********************************************************************
  * Public mutators
  ********************************************************************/
@@ -163,4 +181,17 @@ void PnrSdcOption::set_constrain_zero_delay_paths(const bool& constrain_zero_del
   constrain_zero_delay_paths_ = constrain_zero_delay_paths;
 }
 
+void PnrSdcOption::set_num_jobs(const size_t& num_jobs) {
+  VTR_ASSERT(0 < num_jobs);
+  num_jobs_ = num_jobs;
+}
+
+void PnrSdcOption::set_unique_module_only(const bool& unique_module_only) {
+  unique_module_only_ = unique_module_only;
+}
+
+void PnrSdcOption::set_merge_mux_paths(const bool& merge_mux_paths) {
+  merge_mux_paths_ = merge_mux_paths;
+}
+
 } /* end namespace openfpga */
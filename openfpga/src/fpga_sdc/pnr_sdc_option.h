@@ -6,6 +6,7 @@
  * in purpose of constraining physical design of FPGA fabric in back-end flow
  ********************************************************************/
 
+#include <cstddef>
 #include <string>
 
 /* begin namespace openfpga */
@@ -30,6 +31,9 @@ class PnrSdcOption {
     bool constrain_routing_multiplexer_outputs() const;
     bool constrain_switch_block_outputs() const;
     bool constrain_zero_delay_paths() const;
+    size_t num_jobs() const;
+    bool unique_module_only() const;
+    bool merge_mux_paths() const;
   public: /* Public mutators */
     void set_sdc_dir(const std::string& sdc_dir);
     void set_flatten_names(const bool& flatten_names);
@@ -46,6 +50,9 @@ class PnrSdcOption {
     void set_constrain_routing_multiplexer_outputs(const bool& constrain_routing_mux_outputs);
     void set_constrain_switch_block_outputs(const bool& constrain_sb_outputs);
     void set_constrain_zero_delay_paths(const bool& constrain_zero_delay_paths);
+    void set_num_jobs(const size_t& num_jobs);
+    void set_unique_module_only(const bool& unique_module_only);
+    void set_merge_mux_paths(const bool& merge_mux_paths);
   private: /* Internal data */
     std::string sdc_dir_;
     bool flatten_names_;
@@ -61,6 +68,12 @@ class PnrSdcOption {
     bool constrain_routing_multiplexer_outputs_;
     bool constrain_switch_block_outputs_;
     bool constrain_zero_delay_paths_;
+    /* Number of SDC files to be written in parallel */
+    size_t num_jobs_;
+    /* Constrain unique routing modules only, and bind their instances in a manifest */
+    bool unique_module_only_;
+    /* Constrain the paths of a routing multiplexer with the same delay by a single command */
+    bool merge_mux_paths_;
 };
 
 } /* end namespace openfpga */
@@ -8,6 +8,7 @@
  * engine! These SDCs are designed for PnR to generate FPGA layouts!!!
  *******************************************************************/
 #include <ctime>
+#include <algorithm>
 #include <fstream>
 
 /* Headers from vtrutil library */
@@ -30,6 +31,7 @@
 
 #include "sdc_writer_naming.h"
 #include "sdc_writer_utils.h"
+#include "sdc_parallel_writer.h"
 #include "pnr_sdc_routing_writer.h"
 
 /* begin namespace openfpga */
@@ -44,6 +46,96 @@ float find_pnr_sdc_switch_tmax(const t_rr_switch_inf& switch_inf) {
   return switch_inf.R * switch_inf.Cout + switch_inf.Tdel;
 }
 
+/********************************************************************
+ * Set timing constraints on the paths from the inputs of a routing multiplexer
+ * to its output, each of which is bounded by the delay of its switch
+ *
+ * When paths are merged, the paths with the same delay are constrained 
+ * by a single command, whose start points are listed in the order of the inputs
+ * For example:
+ *   set_max_delay -from {sb/chanx_left_in[0] sb/chany_top_in[2]} -to sb/chanx_right_out[0] 0.5
+ *******************************************************************/
+static 
+void print_pnr_sdc_constrain_routing_mux_paths(std::fstream& fp,
+                                               const float& time_unit,
+                                               const bool& hierarchical,
+                                               const std::string& module_path,
+                                               const std::vector<BasicPort>& input_ports,
+                                               const std::vector<float>& input_delays,
+                                               const BasicPort& output_port,
+                                               const bool& constrain_zero_delay_paths,
+                                               const bool& merge_paths) {
+  VTR_ASSERT(input_ports.size() == input_delays.size());
+
+  /* Module path is not used when constraints are hierarchical */
+  std::string path;
+  if (false == hierarchical) {
+    path = module_path;
+  }
+
+  /* Group the inputs by their delays, in the order of the inputs */
+  std::vector<float> path_delays;
+  std::vector<std::vector<BasicPort>> path_inputs;
+  for (size_t ipath = 0; ipath < input_ports.size(); ++ipath) {
+    /* If we have a zero-delay path to contrain, we will skip unless users want so */
+    if ( (false == constrain_zero_delay_paths)
+      && (0. == input_delays[ipath]) ) {
+      continue;
+    }
+
+    /* Each path is constrained by a command unless paths are merged */
+    if (false == merge_paths) {
+      print_pnr_sdc_constrain_max_delay(fp,
+                                        path,
+                                        generate_sdc_port(input_ports[ipath]),
+                                        path,
+                                        generate_sdc_port(output_port),
+                                        input_delays[ipath] / time_unit);
+      continue;
+    }
+
+    auto it = std::find(path_delays.begin(), path_delays.end(), input_delays[ipath]);
+    if (it == path_delays.end()) {
+      path_delays.push_back(input_delays[ipath]);
+      path_inputs.emplace_back();
+      it = path_delays.end() - 1;
+    }
+    path_inputs[it - path_delays.begin()].push_back(input_ports[ipath]);
+  }
+
+  for (size_t idelay = 0; idelay < path_delays.size(); ++idelay) {
+    /* A single start point does not need a list */
+    if (1 == path_inputs[idelay].size()) {
+      print_pnr_sdc_constrain_max_delay(fp,
+                                        path,
+                                        generate_sdc_port(path_inputs[idelay][0]),
+                                        path,
+                                        generate_sdc_port(output_port),
+                                        path_delays[idelay] / time_unit);
+      continue;
+    }
+
+    std::string src_ports("{");
+    for (const BasicPort& input_port : path_inputs[idelay]) {
+      if (1 < src_ports.length()) {
+        src_ports += std::string(" ");
+      }
+      if (false == path.empty()) {
+        src_ports += format_dir_path(path);
+      }
+      src_ports += generate_sdc_port(input_port);
+    }
+    src_ports += std::string("}");
+
+    print_pnr_sdc_constrain_max_delay(fp,
+                                      std::string(),
+                                      src_ports,
+                                      path,
+                                      generate_sdc_port(output_port),
+                                      path_delays[idelay] / time_unit);
+  }
+}
+
 /********************************************************************
  * Set timing constraints between the inputs and outputs of a routing
  * multiplexer in a Switch Block
@@ -59,7 +151,8 @@ void print_pnr_sdc_constrain_sb_mux_timing(std::fstream& fp,
                                            const RRGSB& rr_gsb,
                                            const e_side& output_node_side,
                                            const RRNodeId& output_rr_node,
-                                           const bool& constrain_zero_delay_paths) {
+                                           const bool& constrain_zero_delay_paths,
+                                           const bool& merge_mux_paths) {
   /* Validate file stream */
   valid_file_stream(fp);
 
@@ -93,40 +186,28 @@ void print_pnr_sdc_constrain_sb_mux_timing(std::fstream& fp,
   }
 
   /* Find the starting points */
+  std::vector<BasicPort> src_ports;
+  std::vector<float> src_delays;
   for (const ModulePinInfo& module_input_port : module_input_ports) {
-    /* If we have a zero-delay path to contrain, we will skip unless users want so */
-    if ( (false == constrain_zero_delay_paths)
-      && (0. == switch_delays[module_input_port]) ) {
-      continue;
-    }
-
-    BasicPort src_port(module_manager.module_port(sb_module, module_input_port.first).get_name(),
-                       module_input_port.second,
-                       module_input_port.second);
-
-    BasicPort sink_port(module_manager.module_port(sb_module, module_output_port.first).get_name(),
-                        module_output_port.second,
-                        module_output_port.second);
+    src_ports.push_back(BasicPort(module_manager.module_port(sb_module, module_input_port.first).get_name(),
+                                  module_input_port.second,
+                                  module_input_port.second));
+    src_delays.push_back(switch_delays[module_input_port]);
+  }
 
-    /* Constrain a path */
-    if (false == hierarchical) {
-      print_pnr_sdc_constrain_max_delay(fp,
-                                        module_path,
-                                        generate_sdc_port(src_port),
-                                        module_path,
-                                        generate_sdc_port(sink_port),
-                                        switch_delays[module_input_port] / time_unit);
+  BasicPort sink_port(module_manager.module_port(sb_module, module_output_port.first).get_name(),
+                      module_output_port.second,
+                      module_output_port.second);
 
-    } else {
-      VTR_ASSERT_SAFE(true == hierarchical);
-      print_pnr_sdc_constrain_max_delay(fp,
-                                        std::string(),
-                                        generate_sdc_port(src_port),
-                                        std::string(),
-                                        generate_sdc_port(sink_port),
-                                        switch_delays[module_input_port] / time_unit);
-    }
-  }
+  /* Constrain the paths */
+  print_pnr_sdc_constrain_routing_mux_paths(fp,
+                                            time_unit,
+                                            hierarchical,
+                                            module_path,
+                                            src_ports, src_delays,
+                                            sink_port,
+                                            constrain_zero_delay_paths,
+                                            merge_mux_paths);
 }
 
 /********************************************************************
@@ -145,14 +226,15 @@ void print_pnr_sdc_constrain_sb_timing(const std::string& sdc_dir,
                                        const ModuleManager& module_manager,
                                        const RRGraph& rr_graph,
                                        const RRGSB& rr_gsb,
-                                       const bool& constrain_zero_delay_paths) {
+                                       const bool& constrain_zero_delay_paths,
+                                       const bool& merge_mux_paths) {
 
   /* Create the file name for Verilog netlist */
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
   std::string sdc_fname(sdc_dir + generate_switch_block_module_name(gsb_coordinate) + std::string(SDC_FILE_NAME_POSTFIX));
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
 
   /* Validate file stream */
@@ -190,7 +272,8 @@ void print_pnr_sdc_constrain_sb_timing(const std::string& sdc_dir,
                                             rr_gsb,
                                             side_manager.get_side(),
                                             chan_rr_node,
-                                            constrain_zero_delay_paths);
+                                            constrain_zero_delay_paths,
+                                            merge_mux_paths);
     }
   }
 
@@ -209,7 +292,9 @@ void print_pnr_sdc_flatten_routing_constrain_sb_timing(const std::string& sdc_di
                                                        const ModuleId& top_module,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths) {
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const bool& merge_mux_paths,
+                                                       const size_t& num_jobs) {
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Write SDC for constrain Switch Block timing for P&R flow");
@@ -218,6 +303,7 @@ void print_pnr_sdc_flatten_routing_constrain_sb_timing(const std::string& sdc_di
 
   /* Get the range of SB array */
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
+  std::vector<const RRGSB*> sb_gsbs;
   /* Go for each SB */
   for (size_t ix = 0; ix < sb_range.x(); ++ix) {
     for (size_t iy = 0; iy < sb_range.y(); ++iy) {
@@ -225,25 +311,33 @@ void print_pnr_sdc_flatten_routing_constrain_sb_timing(const std::string& sdc_di
       if (false == rr_gsb.is_sb_exist()) {
         continue;
       }
+      sb_gsbs.push_back(&rr_gsb);
+    }
+  }
+
+  /* Each SB has its own SDC file */
+  print_sdc_files_in_parallel(sb_gsbs.size(), num_jobs,
+                              [&](const size_t& isb) {
+    const RRGSB& rr_gsb = *(sb_gsbs[isb]);
 
-      vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
-      std::string sb_instance_name = generate_switch_block_module_name(gsb_coordinate); 
+    vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+    std::string sb_instance_name = generate_switch_block_module_name(gsb_coordinate); 
 
-      ModuleId sb_module = module_manager.find_module(sb_instance_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
+    ModuleId sb_module = module_manager.find_module(sb_instance_name);
+    VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
 
-      std::string module_path = format_dir_path(root_path) + sb_instance_name;
+    std::string module_path = format_dir_path(root_path) + sb_instance_name;
 
-      print_pnr_sdc_constrain_sb_timing(sdc_dir,
-                                        time_unit,
-                                        hierarchical,
-                                        module_path,
-                                        module_manager,
-                                        rr_graph,
-                                        rr_gsb,
-                                        constrain_zero_delay_paths);
-    }
-  }
+    print_pnr_sdc_constrain_sb_timing(sdc_dir,
+                                      time_unit,
+                                      hierarchical,
+                                      module_path,
+                                      module_manager,
+                                      rr_graph,
+                                      rr_gsb,
+                                      constrain_zero_delay_paths,
+                                      merge_mux_paths);
+  });
 }
 
 /********************************************************************
@@ -257,17 +351,21 @@ void print_pnr_sdc_compact_routing_constrain_sb_timing(const std::string& sdc_di
                                                        const ModuleId& top_module,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths) {
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const bool& merge_mux_paths,
+                                                       const size_t& num_jobs) {
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Write SDC for constrain Switch Block timing for P&R flow");
 
   std::string root_path = module_manager.module_name(top_module);
 
-  for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
+  /* Each unique SB module has its own SDC file */
+  print_sdc_files_in_parallel(device_rr_gsb.get_num_sb_unique_module(), num_jobs,
+                              [&](const size_t& isb) {
     const RRGSB& rr_gsb = device_rr_gsb.get_sb_unique_module(isb);
     if (false == rr_gsb.is_sb_exist()) {
-      continue;
+      return;
     }
 
     /* Find all the sb instance under this module
@@ -288,8 +386,9 @@ void print_pnr_sdc_compact_routing_constrain_sb_timing(const std::string& sdc_di
                                       module_manager,
                                       rr_graph,
                                       rr_gsb,
-                                      constrain_zero_delay_paths);
-  }
+                                      constrain_zero_delay_paths,
+                                      merge_mux_paths);
+  });
 }
 
 /********************************************************************
@@ -307,7 +406,8 @@ void print_pnr_sdc_constrain_cb_mux_timing(std::fstream& fp,
                                            const RRGSB& rr_gsb,
                                            const t_rr_type& cb_type,
                                            const RRNodeId& output_rr_node,
-                                           const bool& constrain_zero_delay_paths) {
+                                           const bool& constrain_zero_delay_paths,
+                                           const bool& merge_mux_paths) {
   /* Validate file stream */
   valid_file_stream(fp);
 
@@ -361,38 +461,26 @@ void print_pnr_sdc_constrain_cb_mux_timing(std::fstream& fp,
   }
 
   /* Find the starting points */
+  std::vector<BasicPort> input_ports;
+  std::vector<float> input_delays;
   for (const ModulePinInfo& module_input_port : module_input_ports) {
-    /* If we have a zero-delay path to contrain, we will skip unless users want so */
-    if ( (false == constrain_zero_delay_paths)
-      && (0. == switch_delays[module_input_port]) ) {
-      continue;
-    }
-
-    BasicPort input_port(module_manager.module_port(cb_module, module_input_port.first).get_name(),
-                         module_input_port.second,
-                         module_input_port.second);
-    BasicPort output_port = module_manager.module_port(cb_module, module_output_port);
+    input_ports.push_back(BasicPort(module_manager.module_port(cb_module, module_input_port.first).get_name(),
+                                    module_input_port.second,
+                                    module_input_port.second));
+    input_delays.push_back(switch_delays[module_input_port]);
+  }
 
-    /* Constrain a path */
-    if (true == hierarchical) {
-      print_pnr_sdc_constrain_max_delay(fp,
-                                        std::string(),
-                                        generate_sdc_port(input_port),
-                                        std::string(),
-                                        generate_sdc_port(output_port),
-                                        switch_delays[module_input_port] / time_unit);
+  BasicPort output_port = module_manager.module_port(cb_module, module_output_port);
 
-    } else {
-      VTR_ASSERT_SAFE(false == hierarchical);
-      print_pnr_sdc_constrain_max_delay(fp,
-                                        std::string(module_path),
-                                        generate_sdc_port(input_port),
-                                        std::string(module_path),
-                                        generate_sdc_port(output_port),
-                                        switch_delays[module_input_port] / time_unit);
-
-    }
-  }
+  /* Constrain the paths */
+  print_pnr_sdc_constrain_routing_mux_paths(fp,
+                                            time_unit,
+                                            hierarchical,
+                                            module_path,
+                                            input_ports, input_delays,
+                                            output_port,
+                                            constrain_zero_delay_paths,
+                                            merge_mux_paths);
 }
 
 /********************************************************************
@@ -408,7 +496,8 @@ void print_pnr_sdc_constrain_cb_timing(const std::string& sdc_dir,
                                        const RRGraph& rr_graph,
                                        const RRGSB& rr_gsb, 
                                        const t_rr_type& cb_type,
-                                       const bool& constrain_zero_delay_paths) {
+                                       const bool& constrain_zero_delay_paths,
+                                       const bool& merge_mux_paths) {
   /* Create the netlist */
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
 
@@ -416,7 +505,7 @@ void print_pnr_sdc_constrain_cb_timing(const std::string& sdc_dir,
   std::string sdc_fname(sdc_dir + generate_connection_block_module_name(cb_type, gsb_coordinate) + std::string(SDC_FILE_NAME_POSTFIX));
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
 
   /* Validate file stream */
@@ -501,7 +590,8 @@ void print_pnr_sdc_constrain_cb_timing(const std::string& sdc_dir,
                                             module_manager, cb_module, 
                                             rr_graph, rr_gsb, cb_type,
                                             ipin_rr_node,
-                                            constrain_zero_delay_paths);
+                                            constrain_zero_delay_paths,
+                                            merge_mux_paths);
     }
   }
 
@@ -522,11 +612,14 @@ void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_di
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
                                                        const t_rr_type& cb_type,
-                                                       const bool& constrain_zero_delay_paths) {
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const bool& merge_mux_paths,
+                                                       const size_t& num_jobs) {
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
   std::string root_path = module_manager.module_name(top_module);
+  std::vector<const RRGSB*> cb_gsbs;
 
   for (size_t ix = 0; ix < cb_range.x(); ++ix) {
     for (size_t iy = 0; iy < cb_range.y(); ++iy) {
@@ -538,29 +631,36 @@ void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_di
       if (false == rr_gsb.is_cb_exist(cb_type)) {
         continue;
       }
-
-      /* Find all the cb instance under this module
-       * Create a regular expression to include these instance names 
-       */
-      vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
-      std::string cb_instance_name = generate_connection_block_module_name(cb_type, gsb_coordinate); 
-      ModuleId cb_module = module_manager.find_module(cb_instance_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
-
-      std::string module_path = format_dir_path(root_path) + cb_instance_name;
-
-      print_pnr_sdc_constrain_cb_timing(sdc_dir,
-                                        time_unit,
-                                        hierarchical,
-                                        module_path,
-                                        module_manager,
-                                        rr_graph, 
-                                        rr_gsb, 
-                                        cb_type,
-                                        constrain_zero_delay_paths);
-
+      cb_gsbs.push_back(&rr_gsb);
     }
   }
+
+  /* Each CB has its own SDC file */
+  print_sdc_files_in_parallel(cb_gsbs.size(), num_jobs,
+                              [&](const size_t& icb) {
+    const RRGSB& rr_gsb = *(cb_gsbs[icb]);
+
+    /* Find all the cb instance under this module
+     * Create a regular expression to include these instance names 
+     */
+    vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
+    std::string cb_instance_name = generate_connection_block_module_name(cb_type, gsb_coordinate); 
+    ModuleId cb_module = module_manager.find_module(cb_instance_name);
+    VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
+
+    std::string module_path = format_dir_path(root_path) + cb_instance_name;
+
+    print_pnr_sdc_constrain_cb_timing(sdc_dir,
+                                      time_unit,
+                                      hierarchical,
+                                      module_path,
+                                      module_manager,
+                                      rr_graph, 
+                                      rr_gsb, 
+                                      cb_type,
+                                      constrain_zero_delay_paths,
+                                      merge_mux_paths);
+  });
 }
 
 /********************************************************************
@@ -574,7 +674,9 @@ void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_di
                                                        const ModuleId& top_module,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths) {
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const bool& merge_mux_paths,
+                                                       const size_t& num_jobs) {
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Write SDC for constrain Connection Block timing for P&R flow");
@@ -585,7 +687,9 @@ void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_di
                                                     rr_graph,
                                                     device_rr_gsb,
                                                     CHANX,
-                                                    constrain_zero_delay_paths);
+                                                    constrain_zero_delay_paths,
+                                                    merge_mux_paths,
+                                                    num_jobs);
 
   print_pnr_sdc_flatten_routing_constrain_cb_timing(sdc_dir, time_unit,
                                                     hierarchical, 
@@ -593,7 +697,9 @@ void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_di
                                                     rr_graph,
                                                     device_rr_gsb,
                                                     CHANY,
-                                                    constrain_zero_delay_paths);
+                                                    constrain_zero_delay_paths,
+                                                    merge_mux_paths,
+                                                    num_jobs);
 }
 
 /********************************************************************
@@ -607,7 +713,9 @@ void print_pnr_sdc_compact_routing_constrain_cb_timing(const std::string& sdc_di
                                                        const ModuleId& top_module,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths) {
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const bool& merge_mux_paths,
+                                                       const size_t& num_jobs) {
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Write SDC for constrain Connection Block timing for P&R flow");
@@ -615,7 +723,8 @@ void print_pnr_sdc_compact_routing_constrain_cb_timing(const std::string& sdc_di
   std::string root_path = module_manager.module_name(top_module);
 
   /* Print SDC for unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX); ++icb) {
+  print_sdc_files_in_parallel(device_rr_gsb.get_num_cb_unique_module(CHANX), num_jobs,
+                              [&](const size_t& icb) {
     const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, icb);
 
     /* Find all the cb instance under this module
@@ -636,11 +745,13 @@ void print_pnr_sdc_compact_routing_constrain_cb_timing(const std::string& sdc_di
                                       rr_graph, 
                                       unique_mirror, 
                                       CHANX,
-                                      constrain_zero_delay_paths);
-  }
+                                      constrain_zero_delay_paths,
+                                      merge_mux_paths);
+  });
 
   /* Print SDC for unique Y-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANY); ++icb) {
+  print_sdc_files_in_parallel(device_rr_gsb.get_num_cb_unique_module(CHANY), num_jobs,
+                              [&](const size_t& icb) {
     const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, icb);
 
     /* Find all the cb instance under this module
@@ -661,8 +772,9 @@ void print_pnr_sdc_compact_routing_constrain_cb_timing(const std::string& sdc_di
                                       rr_graph, 
                                       unique_mirror, 
                                       CHANY,
-                                      constrain_zero_delay_paths);
-  }
+                                      constrain_zero_delay_paths,
+                                      merge_mux_paths);
+  });
 }
 
 } /* end namespace openfpga */
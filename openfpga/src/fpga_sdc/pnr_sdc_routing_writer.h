@@ -24,7 +24,9 @@ void print_pnr_sdc_flatten_routing_constrain_sb_timing(const std::string& sdc_di
                                                        const ModuleId& top_module,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths);
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const bool& merge_mux_paths,
+                                                       const size_t& num_jobs);
 
 void print_pnr_sdc_compact_routing_constrain_sb_timing(const std::string& sdc_dir,
                                                        const float& time_unit,
@@ -33,7 +35,9 @@ void print_pnr_sdc_compact_routing_constrain_sb_timing(const std::string& sdc_di
                                                        const ModuleId& top_module,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths);
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const bool& merge_mux_paths,
+                                                       const size_t& num_jobs);
 
 void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_dir,
                                                        const float& time_unit,
@@ -42,7 +46,9 @@ void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_di
                                                        const ModuleId& top_module,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths);
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const bool& merge_mux_paths,
+                                                       const size_t& num_jobs);
 
 void print_pnr_sdc_compact_routing_constrain_cb_timing(const std::string& sdc_dir,
                                                        const float& time_unit,
@@ -51,7 +57,9 @@ void print_pnr_sdc_compact_routing_constrain_cb_timing(const std::string& sdc_di
                                                        const ModuleId& top_module,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths);
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const bool& merge_mux_paths,
+                                                       const size_t& num_jobs);
 
 } /* end namespace openfpga */
 
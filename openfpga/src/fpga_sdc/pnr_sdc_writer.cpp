@@ -58,7 +58,7 @@ void print_pnr_sdc_constrain_configurable_memory_outputs(const std::string& sdc_
   vtr::ScopedStartFinishTimer timer(timer_message);
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(sdc_fname.c_str(), fp);
@@ -95,7 +95,7 @@ void print_pnr_sdc_flatten_routing_disable_switch_block_outputs(const std::strin
   vtr::ScopedStartFinishTimer timer(timer_message);
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(sdc_fname.c_str(), fp);
@@ -181,9 +181,9 @@ void print_pnr_sdc_flatten_routing_disable_switch_block_outputs(const std::strin
 
         fp << "set_disable_timing ";
         fp << module_path;
-        fp << port_name << std::endl;
+        fp << port_name << "\n";
 
-        fp << std::endl;
+        fp << "\n";
       }
     }
   }
@@ -212,7 +212,7 @@ void print_pnr_sdc_compact_routing_disable_switch_block_outputs(const std::strin
   vtr::ScopedStartFinishTimer timer(timer_message);
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(sdc_fname.c_str(), fp);
@@ -299,9 +299,9 @@ void print_pnr_sdc_compact_routing_disable_switch_block_outputs(const std::strin
 
         fp << "set_disable_timing ";
         fp << module_path;
-        fp << port_name << std::endl;
+        fp << port_name << "\n";
 
-        fp << std::endl;
+        fp << "\n";
       }
     }
   }
@@ -376,27 +376,51 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
     }
   }
 
+  /* Unique routing modules are identified by build_fabric only when the routing hierarchy is compressed.
+   * Otherwise, identify them on a copy of the GSB array, so that the fabric is not touched
+   */
+  bool unique_routing_module = compact_routing_hierarchy || sdc_options.unique_module_only();
+  bool identify_unique_routing_module = (false == compact_routing_hierarchy)
+                                     && (true == sdc_options.unique_module_only())
+                                     && ( (true == sdc_options.constrain_sb()) || (true == sdc_options.constrain_cb()) );
+  DeviceRRGSB unique_device_rr_gsb;
+  if (true == identify_unique_routing_module) {
+    vtr::ScopedStartFinishTimer timer("Identify unique routing modules for SDC");
+    unique_device_rr_gsb = device_rr_gsb;
+    unique_device_rr_gsb.build_unique_module(device_ctx.rr_graph, sdc_options.num_jobs());
+  }
+  const DeviceRRGSB& routing_device_rr_gsb = (true == identify_unique_routing_module) ? unique_device_rr_gsb : device_rr_gsb;
+
+  /* The constraints of a unique module are applied to all its instances,
+   * so they should not contain the path of any instance
+   */
+  bool hierarchical_routing_module = sdc_options.hierarchical() || sdc_options.unique_module_only();
+
   /* Output routing constraints for Switch Blocks */
   if (true == sdc_options.constrain_sb()) {
-    if (true == compact_routing_hierarchy) {
+    if (true == unique_routing_module) {
       print_pnr_sdc_compact_routing_constrain_sb_timing(sdc_options.sdc_dir(),
                                                         sdc_options.time_unit(),
-                                                        sdc_options.hierarchical(),
+                                                        hierarchical_routing_module,
                                                         module_manager,
                                                         top_module,
                                                         device_ctx.rr_graph,
-                                                        device_rr_gsb,
-                                                        sdc_options.constrain_zero_delay_paths());
+                                                        routing_device_rr_gsb,
+                                                        sdc_options.constrain_zero_delay_paths(),
+                                                        sdc_options.merge_mux_paths(),
+                                                        sdc_options.num_jobs());
     } else {
 	  VTR_ASSERT_SAFE (false == compact_routing_hierarchy);
       print_pnr_sdc_flatten_routing_constrain_sb_timing(sdc_options.sdc_dir(),
                                                         sdc_options.time_unit(),
-                                                        sdc_options.hierarchical(),
+                                                        hierarchical_routing_module,
                                                         module_manager,
                                                         top_module,
                                                         device_ctx.rr_graph,
-                                                        device_rr_gsb,
-                                                        sdc_options.constrain_zero_delay_paths());
+                                                        routing_device_rr_gsb,
+                                                        sdc_options.constrain_zero_delay_paths(),
+                                                        sdc_options.merge_mux_paths(),
+                                                        sdc_options.num_jobs());
     }
   }
 
@@ -412,25 +436,29 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
 
   /* Output routing constraints for Connection Blocks */
   if (true == sdc_options.constrain_cb()) {
-    if (true == compact_routing_hierarchy) {
+    if (true == unique_routing_module) {
       print_pnr_sdc_compact_routing_constrain_cb_timing(sdc_options.sdc_dir(),
                                                         sdc_options.time_unit(),
-                                                        sdc_options.hierarchical(),
+                                                        hierarchical_routing_module,
                                                         module_manager,
                                                         top_module,
                                                         device_ctx.rr_graph,
-                                                        device_rr_gsb,
-                                                        sdc_options.constrain_zero_delay_paths());
+                                                        routing_device_rr_gsb,
+                                                        sdc_options.constrain_zero_delay_paths(),
+                                                        sdc_options.merge_mux_paths(),
+                                                        sdc_options.num_jobs());
     } else {
 	  VTR_ASSERT_SAFE (false == compact_routing_hierarchy);
       print_pnr_sdc_flatten_routing_constrain_cb_timing(sdc_options.sdc_dir(),
                                                         sdc_options.time_unit(),
-                                                        sdc_options.hierarchical(),
+                                                        hierarchical_routing_module,
                                                         module_manager, 
                                                         top_module,
                                                         device_ctx.rr_graph,
-                                                        device_rr_gsb,
-                                                        sdc_options.constrain_zero_delay_paths());
+                                                        routing_device_rr_gsb,
+                                                        sdc_options.constrain_zero_delay_paths(),
+                                                        sdc_options.merge_mux_paths(),
+                                                        sdc_options.num_jobs());
     }
   }
 
@@ -451,6 +479,15 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
                                        device_rr_gsb);
   }
 
+  /* Output the binding between routing block instances and unique modules */
+  if ( (true == sdc_options.unique_module_only())
+    && ( (true == sdc_options.constrain_sb()) || (true == sdc_options.constrain_cb()) ) ) {
+    print_pnr_sdc_routing_unique_module_binding(sdc_options.sdc_dir(),
+                                                module_manager,
+                                                top_module,
+                                                routing_device_rr_gsb);
+  }
+
   /* Output Timing constraints for Programmable blocks */
   if (true == sdc_options.constrain_grid()) {
     print_pnr_sdc_constrain_grid_timing(sdc_options.sdc_dir(),
@@ -460,7 +497,8 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
                                         device_annotation,
                                         module_manager,
                                         top_module,
-                                        sdc_options.constrain_zero_delay_paths());
+                                        sdc_options.constrain_zero_delay_paths(),
+                                        sdc_options.num_jobs());
   }
 
   if ( (true == sdc_options.constrain_grid())
@@ -1,6 +1,8 @@
 /***************************************************************************************
  * Output instance hierarchy in SDC to file formats
  ***************************************************************************************/
+#include <map>
+
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
@@ -54,7 +56,7 @@ void print_pnr_sdc_routing_sb_hierarchy(const std::string& sdc_dir,
   VTR_ASSERT(true != fname.empty());
 
   /* Create a file handler*/
-  std::fstream fp;
+  BufferedFileStream fp;
   /* Open a file */
   fp.open(fname, std::fstream::out | std::fstream::trunc);
 
@@ -135,7 +137,7 @@ void print_pnr_sdc_routing_cb_hierarchy(const std::string& sdc_dir,
   VTR_ASSERT(true != fname.empty());
 
   /* Create a file handler*/
-  std::fstream fp;
+  BufferedFileStream fp;
   /* Open a file */
   fp.open(fname, std::fstream::out | std::fstream::trunc);
 
@@ -173,6 +175,104 @@ void print_pnr_sdc_routing_cb_hierarchy(const std::string& sdc_dir,
   fp.close();
 }
 
+/***************************************************************************************
+ * Write the binding between the routing block instances and the SDC files 
+ * of their unique modules to a plain text file
+ * e.g.,
+ *    - <sdc_file_for_the_unique_module>:
+ *      - <top_module_name>/<instance_name>
+ *        ...
+ * The SDC files of unique modules contain constraints in the hierarchy of the module,
+ * so that a hierarchical P&R flow can apply them to each bound instance
+ ***************************************************************************************/
+void print_pnr_sdc_routing_unique_module_binding(const std::string& sdc_dir,
+                                                 const ModuleManager& module_manager,
+                                                 const ModuleId& top_module,
+                                                 const DeviceRRGSB& device_rr_gsb) {
+
+  std::string fname(sdc_dir + std::string(SDC_ROUTING_UNIQUE_MODULE_BINDING_FILE_NAME));
+
+  std::string timer_message = std::string("Write binding of routing block instances to unique modules to plain-text file '") + fname + std::string("'");
+
+  /* Start time count */
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Create a file handler*/
+  BufferedFileStream fp;
+  /* Open a file */
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+
+  /* Validate the file stream */
+  check_file_stream(fname.c_str(), fp);
+
+  std::string root_path = format_dir_path(module_manager.module_name(top_module));
+
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+
+  /* Switch blocks: group the instances by the name of their unique modules,
+   * which are listed in the order of the unique module indices
+   */
+  std::vector<std::string> unique_module_names;
+  std::map<std::string, std::vector<std::string>> unique_module_instances;
+  for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
+    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(isb);
+    if (false == unique_mirror.is_sb_exist()) {
+      continue;
+    }
+    unique_module_names.push_back(generate_switch_block_module_name(vtr::Point<size_t>(unique_mirror.get_sb_x(), unique_mirror.get_sb_y())));
+  }
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+      if (false == rr_gsb.is_sb_exist()) {
+        continue;
+      }
+      /* Note: use GSB coordinate when inquire for unique modules!!! */
+      const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(vtr::Point<size_t>(ix, iy));
+      std::string unique_module_name = generate_switch_block_module_name(vtr::Point<size_t>(unique_mirror.get_sb_x(), unique_mirror.get_sb_y()));
+      /* Instance names always follow the coordinate of the switch block */
+      unique_module_instances[unique_module_name].push_back(generate_switch_block_module_name(vtr::Point<size_t>(rr_gsb.get_sb_x(), rr_gsb.get_sb_y())));
+    }
+  }
+
+  /* Connection blocks */
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(cb_type); ++icb) {
+      const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, icb);
+      unique_module_names.push_back(generate_connection_block_module_name(cb_type, vtr::Point<size_t>(unique_mirror.get_cb_x(cb_type), unique_mirror.get_cb_y(cb_type))));
+    }
+    for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+      for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+        const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+        if (false == rr_gsb.is_cb_exist(cb_type)) {
+          continue;
+        }
+        /* Note: use GSB coordinate when inquire for unique modules!!! */
+        const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, vtr::Point<size_t>(ix, iy));
+        std::string unique_module_name = generate_connection_block_module_name(cb_type, vtr::Point<size_t>(unique_mirror.get_cb_x(cb_type), unique_mirror.get_cb_y(cb_type)));
+        unique_module_instances[unique_module_name].push_back(generate_connection_block_module_name(cb_type, vtr::Point<size_t>(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type))));
+      }
+    }
+  }
+
+  for (const std::string& unique_module_name : unique_module_names) {
+    /* The unique module must be in the fabric, whose SDC file is named after it */
+    VTR_ASSERT(true == module_manager.valid_module_id(module_manager.find_module(unique_module_name)));
+
+    fp << "- " << unique_module_name << std::string(SDC_FILE_NAME_POSTFIX) << ":" << "\n";
+
+    for (const std::string& instance_name : unique_module_instances[unique_module_name]) {
+      fp << "  ";
+      fp << "- " << root_path << instance_name << "\n";
+    }
+
+    fp << "\n";
+  }
+
+  /* close a file */
+  fp.close();
+}
+
 /********************************************************************
  * Recursively write the hierarchy of pb_type and its instances to a plain text file
  * e.g.,
@@ -280,7 +380,7 @@ void print_pnr_sdc_grid_hierarchy(const std::string& sdc_dir,
   VTR_ASSERT(true != fname.empty());
 
   /* Create a file handler*/
-  std::fstream fp;
+  BufferedFileStream fp;
   /* Open a file */
   fp.open(fname, std::fstream::out | std::fstream::trunc);
 
@@ -0,0 +1,41 @@
+/********************************************************************
+ * A template to write a number of SDC files
+ * which are independent from each other, e.g., the SDC files
+ * of each routing block and programmable block
+ *******************************************************************/
+#ifndef SDC_PARALLEL_WRITER_H
+#define SDC_PARALLEL_WRITER_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <algorithm>
+#include <vector>
+
+#include "vtr_parallel.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Write a number of SDC files, each of which is output by
+ *   write_file(file_index)
+ * which should only read the module graph and device annotations
+ * and write a file that is not touched by any other file index.
+ *
+ * With a single job, the files are written in the order of the indices.
+ * Otherwise, the files are dispatched on demand to worker threads,
+ * as the sizes of the blocks vary across the device
+ *******************************************************************/
+template<class WriteFileFunc>
+void print_sdc_files_in_parallel(const size_t& num_files,
+                                 const size_t& num_jobs,
+                                 const WriteFileFunc& write_file) {
+  vtr::parallel_for(num_files, num_jobs, [&](const size_t& ifile) {
+    write_file(ifile);
+  });
+}
+
+} /* end namespace openfpga */
+
+#endif
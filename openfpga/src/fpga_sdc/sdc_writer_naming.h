@@ -17,8 +17,11 @@ constexpr char* SDC_GRID_HIERARCHY_FILE_NAME = "grid_hierarchy.txt";
 constexpr char* SDC_SB_HIERARCHY_FILE_NAME = "sb_hierarchy.txt";
 constexpr char* SDC_CBX_HIERARCHY_FILE_NAME = "cbx_hierarchy.txt";
 constexpr char* SDC_CBY_HIERARCHY_FILE_NAME = "cby_hierarchy.txt";
+constexpr char* SDC_ROUTING_UNIQUE_MODULE_BINDING_FILE_NAME = "routing_unique_module_binding.txt";
 
 constexpr char* SDC_ANALYSIS_FILE_NAME = "fpga_top_analysis.sdc";
+constexpr char* SDC_ANALYSIS_REGION_DIR_NAME = "analysis_regions/";
+constexpr char* SDC_ANALYSIS_REGION_MANIFEST_FILE_NAME = "regions.manifest";
 
 } /* end namespace openfpga */
 
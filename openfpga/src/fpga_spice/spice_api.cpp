@@ -16,6 +16,10 @@
 
 #include "spice_constants.h"
 #include "spice_submodule.h"
+#include "spice_routing.h"
+#include "spice_grid.h"
+#include "spice_top_module.h"
+#include "spice_component_testbench.h"
 
 /* Header file for this source file */
 #include "spice_api.h"
@@ -40,6 +44,9 @@ namespace openfpga {
 int fpga_fabric_spice(const ModuleManager& module_manager,
                       NetlistManager& netlist_manager,
                       const Arch& openfpga_arch,
+                      const DeviceContext& device_ctx,
+                      const VprDeviceAnnotation& device_annotation,
+                      const DeviceRRGSB& device_rr_gsb,
                       const FabricSpiceOption& options) {
 
   vtr::ScopedStartFinishTimer timer("Write SPICE netlists for FPGA fabric\n");
@@ -79,6 +86,34 @@ int fpga_fabric_spice(const ModuleManager& module_manager,
     return status;
   }
 
+  /* Generate routing modules: 
+   * when the routing is compressed, only one subckt is written for each unique module
+   */
+  if (true == options.compress_routing()) {
+    print_spice_unique_routing_modules(netlist_manager,
+                                       module_manager,
+                                       device_rr_gsb,
+                                       rr_dir_path);
+  } else {
+    VTR_ASSERT(false == options.compress_routing());
+    print_spice_flatten_routing_modules(netlist_manager,
+                                        module_manager,
+                                        device_rr_gsb,
+                                        rr_dir_path);
+  }
+
+  /* Generate grids */
+  print_spice_grids(netlist_manager,
+                    module_manager,
+                    device_ctx, device_annotation,
+                    lb_dir_path,
+                    options.verbose_output());
+
+  /* Generate FPGA fabric */
+  print_spice_top_module(netlist_manager,
+                         module_manager,
+                         src_dir_path);
+
   /* Given a brief stats on how many Spice modules have been written to files */
   VTR_LOGV(options.verbose_output(),
            "Written %lu SPICE modules in total\n",
@@ -87,4 +122,46 @@ int fpga_fabric_spice(const ModuleManager& module_manager,
   return CMD_EXEC_SUCCESS;
 }
 
+/********************************************************************
+ * A top-level function of FPGA-SPICE which focuses on the testbenches
+ * to characterize the components of a FPGA fabric
+ * A testbench is generated for each unique switch block and connection block,
+ * whose SPICE netlists should have been written by fpga_fabric_spice()
+ *
+ * Note:
+ *  - When the routing is not compressed, the unique modules are identified
+ *    only for the testbenches, without touching the fabric
+ ********************************************************************/
+int fpga_spice_component_testbench(const ModuleManager& module_manager,
+                                   NetlistManager& netlist_manager,
+                                   const Arch& openfpga_arch,
+                                   const SimulationSetting& sim_setting,
+                                   const DeviceContext& device_ctx,
+                                   const DeviceRRGSB& device_rr_gsb,
+                                   const SpiceTestbenchOption& options) {
+
+  vtr::ScopedStartFinishTimer timer("Write SPICE testbenches for FPGA components\n");
+
+  std::string testbench_dir_path = format_dir_path(options.output_directory());
+
+  create_directory(testbench_dir_path);
+
+  DeviceRRGSB unique_device_rr_gsb;
+  if (false == options.compress_routing()) {
+    vtr::ScopedStartFinishTimer unique_timer("Identify unique routing modules for SPICE testbenches");
+    unique_device_rr_gsb = device_rr_gsb;
+    unique_device_rr_gsb.build_unique_module(device_ctx.rr_graph, options.num_jobs());
+  }
+  const DeviceRRGSB& routing_device_rr_gsb = (false == options.compress_routing()) ? unique_device_rr_gsb : device_rr_gsb;
+
+  return print_spice_routing_testbenches(netlist_manager,
+                                         module_manager,
+                                         routing_device_rr_gsb,
+                                         openfpga_arch.circuit_lib,
+                                         openfpga_arch.tech_lib,
+                                         sim_setting,
+                                         testbench_dir_path,
+                                         options);
+}
+
 } /* end namespace openfpga */
@@ -10,7 +10,12 @@
 #include "netlist_manager.h"
 #include "module_manager.h"
 #include "openfpga_arch.h"
+#include "vpr_context.h"
+#include "vpr_device_annotation.h"
+#include "device_rr_gsb.h"
+#include "simulation_setting.h"
 #include "fabric_spice_options.h"
+#include "spice_testbench_options.h"
 
 /********************************************************************
  * Function declaration
@@ -22,8 +27,19 @@ namespace openfpga {
 int fpga_fabric_spice(const ModuleManager& module_manager,
                       NetlistManager& netlist_manager,
                       const Arch& openfpga_arch,
+                      const DeviceContext& device_ctx,
+                      const VprDeviceAnnotation& device_annotation,
+                      const DeviceRRGSB& device_rr_gsb,
                       const FabricSpiceOption& options);
 
+int fpga_spice_component_testbench(const ModuleManager& module_manager,
+                                   NetlistManager& netlist_manager,
+                                   const Arch& openfpga_arch,
+                                   const SimulationSetting& sim_setting,
+                                   const DeviceContext& device_ctx,
+                                   const DeviceRRGSB& device_rr_gsb,
+                                   const SpiceTestbenchOption& options);
+
 } /* end namespace openfpga */
 
 #endif
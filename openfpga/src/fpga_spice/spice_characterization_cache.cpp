@@ -0,0 +1,351 @@
+/********************************************************************
+ * This file includes functions to manage the cache of 
+ * SPICE characterizations of FPGA components
+ *
+ * A component is identified by its fingerprint, which covers
+ * - the structure of its module and all the child modules
+ * - the parameters of the circuit models of the primitive modules
+ * - the transistor models of the technology library
+ * - the simulation settings
+ * so that a characterization can be reused by any component with the
+ * same fingerprint, even if the architecture changes elsewhere.
+ *
+ * The cache is a plain text file, where each line is a component:
+ *   <fingerprint> <testbench> [<measurement>=<value> ...]
+ *******************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "spice_constants.h"
+#include "spice_characterization_cache.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Hash a string into a fingerprint
+ * A FNV-1a hash is used rather than std::hash,
+ * as the fingerprints are stored in files and must not change across builds
+ *******************************************************************/
+static 
+std::string generate_spice_fingerprint_string(const std::string& content) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (const char& c : content) {
+    hash ^= uint64_t(static_cast<unsigned char>(c));
+    hash *= 1099511628211ULL;
+  }
+
+  std::ostringstream fingerprint;
+  fingerprint << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return fingerprint.str();
+}
+
+/********************************************************************
+ * Describe the parameters of the circuit model which a primitive module is built from
+ *******************************************************************/
+static 
+void print_spice_circuit_model_fingerprint_content(std::ostream& content,
+                                                   const CircuitLibrary& circuit_lib,
+                                                   const CircuitModelId& circuit_model) {
+  content << "model " << circuit_lib.model_name(circuit_model);
+  content << " " << circuit_lib.model_type(circuit_model);
+  content << " " << circuit_lib.design_tech_type(circuit_model);
+  content << " " << circuit_lib.is_power_gated(circuit_model);
+
+  if (CIRCUIT_MODEL_INVBUF == circuit_lib.model_type(circuit_model)) {
+    content << " " << circuit_lib.buffer_type(circuit_model);
+    content << " " << circuit_lib.buffer_size(circuit_model);
+    content << " " << circuit_lib.buffer_num_levels(circuit_model);
+    content << " " << circuit_lib.buffer_f_per_stage(circuit_model);
+  }
+
+  if (CIRCUIT_MODEL_PASSGATE == circuit_lib.model_type(circuit_model)) {
+    content << " " << circuit_lib.pass_gate_logic_type(circuit_model);
+    content << " " << circuit_lib.pass_gate_logic_pmos_size(circuit_model);
+    content << " " << circuit_lib.pass_gate_logic_nmos_size(circuit_model);
+  }
+
+  if ( (CIRCUIT_MODEL_WIRE == circuit_lib.model_type(circuit_model))
+    || (CIRCUIT_MODEL_CHAN_WIRE == circuit_lib.model_type(circuit_model)) ) {
+    content << " " << circuit_lib.wire_r(circuit_model);
+    content << " " << circuit_lib.wire_c(circuit_model);
+  }
+
+  content << "\n";
+}
+
+/********************************************************************
+ * Find the fingerprint of the structure of a module in a recursive way
+ * The names of non-primitive modules are not part of the fingerprint,
+ * as modules of the same structure may be named after different locations
+ *******************************************************************/
+static 
+std::string rec_generate_spice_module_fingerprint(const ModuleManager& module_manager,
+                                                  const ModuleId& module_id,
+                                                  const CircuitLibrary& circuit_lib,
+                                                  std::map<ModuleId, std::string>& module_fingerprints) {
+  auto result = module_fingerprints.find(module_id);
+  if (result != module_fingerprints.end()) {
+    return result->second;
+  }
+
+  std::ostringstream content;
+  content << std::setprecision(10);
+
+  for (int port_type = ModuleManager::MODULE_GLOBAL_PORT;
+       port_type < ModuleManager::NUM_MODULE_PORT_TYPES;
+       ++port_type) {
+    for (const BasicPort& port : module_manager.module_ports_by_type(module_id, static_cast<ModuleManager::e_module_port_type>(port_type))) {
+      content << "port " << port_type << " " << port.get_name() << " " << port.get_width() << "\n";
+    }
+  }
+
+  /* Primitive modules are characterized by their circuit models */
+  const std::vector<ModuleId>& child_modules = module_manager.child_modules(module_id);
+  if (true == child_modules.empty()) {
+    CircuitModelId circuit_model = circuit_lib.model(module_manager.module_name(module_id));
+    if (true == circuit_lib.valid_model_id(circuit_model)) {
+      print_spice_circuit_model_fingerprint_content(content, circuit_lib, circuit_model);
+    } else {
+      content << "module " << module_manager.module_name(module_id) << "\n";
+    }
+  }
+
+  std::map<ModuleId, size_t> child_indices;
+  for (const ModuleId& child_module : child_modules) {
+    size_t child_index = child_indices.size();
+    child_indices[child_module] = child_index;
+    content << "child " << rec_generate_spice_module_fingerprint(module_manager, child_module, circuit_lib, module_fingerprints);
+    content << " " << module_manager.num_instance(module_id, child_module) << "\n";
+  }
+
+  /* Each terminal of a net is described by its module, 
+   * where the module itself is a special index 
+   */
+  for (const ModuleNetId& module_net : module_manager.module_nets(module_id)) {
+    content << "net";
+    for (ModuleNetSrcId src_id : module_manager.module_net_sources(module_id, module_net)) {
+      ModuleId src_module = module_manager.net_source_module(module_id, module_net, src_id);
+      content << " s" << ((module_id == src_module) ? std::string("p") : std::to_string(child_indices[src_module]));
+      content << "." << module_manager.net_source_instance(module_id, module_net, src_id);
+      content << "." << size_t(module_manager.net_source_port(module_id, module_net, src_id));
+      content << "." << module_manager.net_source_pin(module_id, module_net, src_id);
+    }
+    for (ModuleNetSinkId sink_id : module_manager.module_net_sinks(module_id, module_net)) {
+      ModuleId sink_module = module_manager.net_sink_module(module_id, module_net, sink_id);
+      content << " d" << ((module_id == sink_module) ? std::string("p") : std::to_string(child_indices[sink_module]));
+      content << "." << module_manager.net_sink_instance(module_id, module_net, sink_id);
+      content << "." << size_t(module_manager.net_sink_port(module_id, module_net, sink_id));
+      content << "." << module_manager.net_sink_pin(module_id, module_net, sink_id);
+    }
+    content << "\n";
+  }
+
+  std::string fingerprint = generate_spice_fingerprint_string(content.str());
+  module_fingerprints[module_id] = fingerprint;
+  return fingerprint;
+}
+
+/********************************************************************
+ * Generate the fingerprint of a component to be characterized
+ * The fingerprints of modules are stored in the given map,
+ * so that they can be reused across components
+ *******************************************************************/
+std::string generate_spice_characterization_fingerprint(const ModuleManager& module_manager,
+                                                        const ModuleId& module_id,
+                                                        const CircuitLibrary& circuit_lib,
+                                                        const TechnologyLibrary& tech_lib,
+                                                        const SimulationSetting& sim_setting,
+                                                        std::map<ModuleId, std::string>& module_fingerprints) {
+  std::ostringstream content;
+  content << std::setprecision(10);
+
+  content << "module " << rec_generate_spice_module_fingerprint(module_manager, module_id, circuit_lib, module_fingerprints) << "\n";
+
+  for (const TechnologyModelId& model : tech_lib.models_by_type(TECH_LIB_MODEL_TRANSISTOR)) {
+    content << "tech " << tech_lib.model_name(model);
+    content << " " << tech_lib.model_lib_path(model);
+    content << " " << tech_lib.model_corner(model);
+    content << " " << tech_lib.model_ref(model);
+    content << " " << tech_lib.model_vdd(model);
+    content << " " << tech_lib.model_pn_ratio(model);
+    for (int itype = TECH_LIB_TRANSISTOR_PMOS;
+         itype < NUM_TECH_LIB_TRANSISTOR_TYPES;
+         ++itype) {
+      const e_tech_lib_transistor_type& trans_type = static_cast<e_tech_lib_transistor_type>(itype); 
+      content << " " << tech_lib.transistor_model_name(model, trans_type);
+      content << " " << tech_lib.transistor_model_chan_length(model, trans_type);
+      content << " " << tech_lib.transistor_model_min_width(model, trans_type);
+      content << " " << tech_lib.transistor_model_max_width(model, trans_type);
+    }
+    content << "\n";
+  }
+
+  content << "sim " << sim_setting.operating_clock_frequency();
+  content << " " << sim_setting.num_clock_cycles();
+  content << " " << sim_setting.simulation_temperature();
+  content << " " << sim_setting.simulation_accuracy_type();
+  content << " " << sim_setting.simulation_accuracy();
+  for (int itype = SIM_SIGNAL_RISE; itype < NUM_SIM_SIGNAL_TYPES; ++itype) {
+    const e_sim_signal_type& signal_type = static_cast<e_sim_signal_type>(itype); 
+    content << " " << sim_setting.stimuli_input_slew_type(signal_type);
+    content << " " << sim_setting.stimuli_input_slew(signal_type);
+  }
+  content << "\n";
+
+  return generate_spice_fingerprint_string(content.str());
+}
+
+/********************************************************************
+ * Read the cache of characterizations from a file
+ * A missing file is seen as an empty cache
+ *******************************************************************/
+int read_spice_characterization_cache(const std::string& fname,
+                                      SpiceCharacterizationCache& cache) {
+  std::ifstream fp(fname);
+  if (!fp.is_open()) {
+    return CMD_EXEC_SUCCESS;
+  }
+
+  std::string line;
+  size_t line_num = 0;
+  while (std::getline(fp, line)) {
+    ++line_num;
+    std::istringstream tokens(line);
+    std::string fingerprint;
+    t_spice_characterization_result result;
+    if (!(tokens >> fingerprint >> result.testbench)) {
+      /* Bypass empty lines */
+      if (true == fingerprint.empty()) {
+        continue;
+      }
+      VTR_LOG_ERROR("Invalid line %lu in SPICE characterization cache '%s'!\n",
+                    line_num, fname.c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+
+    std::string measurement;
+    while (tokens >> measurement) {
+      size_t pos = measurement.find('=');
+      if (std::string::npos == pos) {
+        VTR_LOG_ERROR("Invalid measurement '%s' at line %lu in SPICE characterization cache '%s'!\n",
+                      measurement.c_str(), line_num, fname.c_str());
+        return CMD_EXEC_FATAL_ERROR;
+      }
+      result.measurements[measurement.substr(0, pos)] = std::stof(measurement.substr(pos + 1));
+    }
+    cache[fingerprint] = result;
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Write the cache of characterizations to a file
+ *******************************************************************/
+int write_spice_characterization_cache(const std::string& fname,
+                                       const SpiceCharacterizationCache& cache) {
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(fname.c_str(), fp);
+
+  for (const auto& entry : cache) {
+    fp << entry.first << " " << entry.second.testbench;
+    for (const auto& measurement : entry.second.measurements) {
+      fp << " " << measurement.first << "=" << std::setprecision(10) << measurement.second;
+    }
+    fp << "\n";
+  }
+
+  fp.close();
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Load the measurements of the testbenches which have been simulated 
+ * since they were added to the cache
+ * The measurements are read from the file written by HSPICE next to
+ * each testbench, <testbench>.mt0, whose format is
+ *   $DATA1 ...
+ *   .TITLE '...'
+ *   <measurement names> temper alter#
+ *   <measurement values> <temperature> <alter index>
+ * Failed measurements are not loaded so that they are characterized again
+ *
+ * Return the number of characterizations which are loaded
+ *******************************************************************/
+size_t load_spice_characterization_measurements(SpiceCharacterizationCache& cache) {
+  size_t num_loaded = 0;
+  for (auto& entry : cache) {
+    if (false == entry.second.measurements.empty()) {
+      continue;
+    }
+
+    std::string mt0_fname = entry.second.testbench;
+    size_t pos = mt0_fname.rfind(SPICE_NETLIST_FILE_POSTFIX);
+    if (std::string::npos != pos) {
+      mt0_fname = mt0_fname.substr(0, pos);
+    }
+    mt0_fname += std::string(".mt0");
+
+    std::ifstream fp(mt0_fname);
+    if (!fp.is_open()) {
+      continue;
+    }
+
+    std::vector<std::string> tokens;
+    std::string line;
+    while (std::getline(fp, line)) {
+      if ( (0 == line.find('$')) || (0 == line.find(".TITLE")) ) {
+        continue;
+      }
+      std::istringstream line_tokens(line);
+      std::string token;
+      while (line_tokens >> token) {
+        tokens.push_back(token);
+      }
+    }
+
+    /* The names end with the index of alter, which is followed by the same number of values */
+    size_t num_names = 0;
+    while ( (num_names < tokens.size())
+         && (std::string("alter#") != tokens[num_names]) ) {
+      ++num_names;
+    }
+    ++num_names;
+    if (tokens.size() < 2 * num_names) {
+      continue;
+    }
+
+    for (size_t iname = 0; iname < num_names; ++iname) {
+      if ( (std::string("temper") == tokens[iname])
+        || (std::string("alter#") == tokens[iname]) ) {
+        continue;
+      }
+      try {
+        entry.second.measurements[tokens[iname]] = std::stof(tokens[num_names + iname]);
+      } catch (const std::exception&) {
+        /* Bypass failed measurements */
+      }
+    }
+    if (false == entry.second.measurements.empty()) {
+      ++num_loaded;
+    }
+  }
+
+  return num_loaded;
+}
+
+} /* end namespace openfpga */
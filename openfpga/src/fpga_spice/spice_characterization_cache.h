@@ -0,0 +1,52 @@
+#ifndef SPICE_CHARACTERIZATION_CACHE_H
+#define SPICE_CHARACTERIZATION_CACHE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <map>
+#include <string>
+#include "module_manager.h"
+#include "circuit_library.h"
+#include "technology_library.h"
+#include "simulation_setting.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * The characterization of a component, which is stored in the cache
+ * - the testbench which characterizes the component
+ * - the measurements of the testbench, which are empty 
+ *   until the testbench has been simulated
+ *******************************************************************/
+struct t_spice_characterization_result {
+  std::string testbench;
+  std::map<std::string, float> measurements;
+};
+
+/* Characterizations indexed by the fingerprints of components */
+typedef std::map<std::string, t_spice_characterization_result> SpiceCharacterizationCache;
+
+std::string generate_spice_characterization_fingerprint(const ModuleManager& module_manager,
+                                                        const ModuleId& module_id,
+                                                        const CircuitLibrary& circuit_lib,
+                                                        const TechnologyLibrary& tech_lib,
+                                                        const SimulationSetting& sim_setting,
+                                                        std::map<ModuleId, std::string>& module_fingerprints);
+
+int read_spice_characterization_cache(const std::string& fname,
+                                      SpiceCharacterizationCache& cache);
+
+int write_spice_characterization_cache(const std::string& fname,
+                                       const SpiceCharacterizationCache& cache);
+
+size_t load_spice_characterization_measurements(SpiceCharacterizationCache& cache);
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,280 @@
+/********************************************************************
+ * This file includes functions to print SPICE testbenches
+ * for the components of a FPGA fabric, e.g., switch blocks, 
+ * which are used to characterize their power 
+ *
+ * A testbench is written for each unique module,
+ * as all the instances of the module have the same characteristics
+ * When a cache of characterizations is used, the modules which 
+ * have been characterized in previous runs are not written again
+ *******************************************************************/
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_parallel.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "openfpga_naming.h"
+
+#include "spice_constants.h"
+#include "spice_writer_utils.h"
+#include "spice_characterization_cache.h"
+#include "spice_component_testbench.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Convert a time in the simulation settings to an absolute value,
+ * as a fraction is relative to the operating clock period
+ *******************************************************************/
+static 
+float generate_spice_testbench_time(const e_sim_accuracy_type& time_type,
+                                    const float& time,
+                                    const float& clock_period) {
+  if (SIM_ACCURACY_FRAC == time_type) {
+    return time * clock_period;
+  }
+  VTR_ASSERT(SIM_ACCURACY_ABS == time_type);
+  return time;
+}
+
+/********************************************************************
+ * Print a SPICE testbench to characterize a module:
+ * - all the fabric netlists are included
+ * - the inputs of the module are driven by pulses at the operating clock frequency
+ * - the global ports of the module are tied to ground
+ * - the average power of the supply is measured during the transient simulation
+ *
+ * Return the name of the testbench, which should be registered by the caller
+ *******************************************************************/
+static 
+std::string print_spice_component_testbench(const ModuleManager& module_manager,
+                                            const ModuleId& module_id,
+                                            const std::vector<std::string>& netlist_names,
+                                            const float& vdd,
+                                            const SimulationSetting& sim_setting,
+                                            const std::string& testbench_dir) {
+  std::string module_name = module_manager.module_name(module_id);
+  std::string spice_fname(testbench_dir + module_name + std::string(SPICE_COMPONENT_TESTBENCH_POSTFIX) + std::string(SPICE_NETLIST_FILE_POSTFIX));
+
+  /* Create the file stream */
+  BufferedFileStream fp;
+  fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(spice_fname.c_str(), fp);
+
+  print_spice_file_header(fp, std::string("SPICE testbench for " + module_name));
+
+  for (const std::string& netlist_name : netlist_names) {
+    print_spice_include_netlist(fp, netlist_name);
+  }
+  fp << "\n";
+
+  float clock_period = 1. / sim_setting.operating_clock_frequency();
+  float rise_slew = generate_spice_testbench_time(sim_setting.stimuli_input_slew_type(SIM_SIGNAL_RISE),
+                                                  sim_setting.stimuli_input_slew(SIM_SIGNAL_RISE),
+                                                  clock_period);
+  float fall_slew = generate_spice_testbench_time(sim_setting.stimuli_input_slew_type(SIM_SIGNAL_FALL),
+                                                  sim_setting.stimuli_input_slew(SIM_SIGNAL_FALL),
+                                                  clock_period);
+  float time_step = generate_spice_testbench_time(sim_setting.simulation_accuracy_type(),
+                                                  sim_setting.simulation_accuracy(),
+                                                  clock_period);
+  float sim_time = std::max(size_t(1), sim_setting.num_clock_cycles()) * clock_period;
+
+  fp << ".temp " << std::setprecision(10) << sim_setting.simulation_temperature() << "\n";
+  fp << ".global LVDD LGND" << "\n";
+  fp << SPICE_TESTBENCH_SUPPLY_NAME << " LVDD 0 " << std::setprecision(10) << vdd << "\n";
+  fp << "Vgnd LGND 0 0" << "\n";
+  fp << "\n";
+
+  /* Instanciate the module under test, with the ports in the sequence of the subckt definition */
+  std::vector<std::string> nodes;
+  size_t num_stimuli = 0;
+  for (int port_type = ModuleManager::MODULE_GLOBAL_PORT;
+       port_type < ModuleManager::NUM_MODULE_PORT_TYPES;
+       ++port_type) {
+    for (const BasicPort& port : module_manager.module_ports_by_type(module_id, static_cast<ModuleManager::e_module_port_type>(port_type))) {
+      for (const size_t& pin : port.pins()) {
+        std::string node = generate_spice_port(BasicPort(port.get_name(), pin, pin));
+        nodes.push_back(node);
+
+        /* Drive the inputs and tie the global ports */
+        if (ModuleManager::MODULE_GLOBAL_PORT == port_type) {
+          fp << "Vstimuli_" << num_stimuli << " " << node << " 0 0" << "\n";
+        } else if ( (ModuleManager::MODULE_INPUT_PORT == port_type)
+                 || (ModuleManager::MODULE_CLOCK_PORT == port_type) ) {
+          fp << "Vstimuli_" << num_stimuli << " " << node << " 0";
+          fp << " pulse(0 " << std::setprecision(10) << vdd;
+          fp << " 0 " << rise_slew << " " << fall_slew;
+          fp << " " << std::max(float(0.), float(clock_period / 2 - rise_slew));
+          fp << " " << clock_period << ")" << "\n";
+        } else {
+          continue;
+        }
+        ++num_stimuli;
+      }
+    }
+  }
+  fp << "\n";
+
+  fp << "Xdut";
+  size_t node_cnt = 0;
+  for (const std::string& node : nodes) {
+    fp << " " << node;
+    ++node_cnt;
+    /* Currently we limit 10 ports per line to keep a clean netlist */
+    if (0 == node_cnt % 10) {
+      fp << "\n" << "+";
+    }
+  }
+  fp << " " << module_name << "\n";
+  fp << "\n";
+
+  fp << ".tran " << std::setprecision(10) << time_step << " " << sim_time << "\n";
+  fp << ".meas tran avg_power avg p(" << SPICE_TESTBENCH_SUPPLY_NAME << ") from=0 to=" << sim_time << "\n";
+  fp << ".end" << "\n";
+
+  /* Close file handler */
+  fp.close();
+
+  return spice_fname;
+}
+
+/********************************************************************
+ * Print the SPICE testbenches for the unique switch blocks and
+ * connection blocks of a FPGA fabric
+ * The testbenches are independent from each other and only read the module graph,
+ * so they are written by up to the given number of worker threads.
+ * The netlist manager is only updated by the caller thread in the order of the modules,
+ * so that its contents do not depend on the number of jobs
+ *******************************************************************/
+int print_spice_routing_testbenches(NetlistManager& netlist_manager,
+                                    const ModuleManager& module_manager,
+                                    const DeviceRRGSB& device_rr_gsb,
+                                    const CircuitLibrary& circuit_lib,
+                                    const TechnologyLibrary& tech_lib,
+                                    const SimulationSetting& sim_setting,
+                                    const std::string& testbench_dir,
+                                    const SpiceTestbenchOption& options) {
+  /* Supply voltage comes from the transistor model */
+  std::vector<TechnologyModelId> transistor_models = tech_lib.models_by_type(TECH_LIB_MODEL_TRANSISTOR);
+  if (true == transistor_models.empty()) {
+    VTR_LOG_ERROR("No transistor model is defined in technology library to supply SPICE testbenches!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  float vdd = tech_lib.model_vdd(transistor_models[0]);
+
+  /* Testbenches include all the fabric netlists */
+  std::vector<std::string> netlist_names;
+  for (const NetlistId& netlist : netlist_manager.netlists()) {
+    if (NetlistManager::TESTBENCH_NETLIST == netlist_manager.netlist_type(netlist)) {
+      continue;
+    }
+    netlist_names.push_back(netlist_manager.netlist_name(netlist));
+  }
+
+  /* Find the unique modules to characterize */
+  std::vector<ModuleId> modules;
+  for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
+    const RRGSB& rr_gsb = device_rr_gsb.get_sb_unique_module(isb);
+    vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+    modules.push_back(module_manager.find_module(generate_switch_block_module_name(gsb_coordinate)));
+  }
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(cb_type); ++icb) {
+      const RRGSB& rr_gsb = device_rr_gsb.get_cb_unique_module(cb_type, icb);
+      vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
+      modules.push_back(module_manager.find_module(generate_connection_block_module_name(cb_type, gsb_coordinate)));
+    }
+  }
+  for (const ModuleId& module : modules) {
+    VTR_ASSERT(true == module_manager.valid_module_id(module));
+  }
+
+  /* Only the modules which miss the cache are characterized */
+  SpiceCharacterizationCache cache;
+  std::vector<std::string> fingerprints(modules.size());
+  if (false == options.cache_file().empty()) {
+    if (CMD_EXEC_SUCCESS != read_spice_characterization_cache(options.cache_file(), cache)) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    size_t num_loaded = load_spice_characterization_measurements(cache);
+    VTR_LOGV(options.verbose_output(),
+             "Loaded %lu SPICE characterizations from simulation results\n",
+             num_loaded);
+
+    std::map<ModuleId, std::string> module_fingerprints;
+    std::vector<ModuleId> missed_modules;
+    std::vector<std::string> missed_fingerprints;
+    for (const ModuleId& module : modules) {
+      std::string fingerprint = generate_spice_characterization_fingerprint(module_manager, module,
+                                                                            circuit_lib, tech_lib, sim_setting,
+                                                                            module_fingerprints);
+      auto result = cache.find(fingerprint);
+      if ( (result != cache.end())
+        && (false == result->second.measurements.empty()) ) {
+        VTR_LOGV(options.verbose_output(),
+                 "Reuse SPICE characterization of '%s' from '%s'\n",
+                 module_manager.module_name(module).c_str(),
+                 result->second.testbench.c_str());
+        continue;
+      }
+      /* Modules of the same fingerprint are characterized once */
+      if (missed_fingerprints.end() != std::find(missed_fingerprints.begin(), missed_fingerprints.end(), fingerprint)) {
+        continue;
+      }
+      missed_modules.push_back(module);
+      missed_fingerprints.push_back(fingerprint);
+    }
+    VTR_LOG("%lu of %lu routing modules miss the SPICE characterization cache\n",
+            missed_modules.size(), modules.size());
+    modules = missed_modules;
+    fingerprints = missed_fingerprints;
+  }
+
+  std::string timer_message = std::string("Write ") + std::to_string(modules.size()) + std::string(" SPICE testbenches for routing modules");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  std::vector<std::string> testbench_names(modules.size());
+
+  /* Testbenches are dispatched on demand, as the module sizes vary across the device */
+  vtr::parallel_for(modules.size(), options.num_jobs(), [&](const size_t& itb) {
+    testbench_names[itb] = print_spice_component_testbench(module_manager, modules[itb],
+                                                           netlist_names, vdd,
+                                                           sim_setting, testbench_dir);
+  });
+
+  /* Add fname to the netlist name list */
+  for (const std::string& spice_fname : testbench_names) {
+    VTR_LOGV(options.verbose_output(),
+             "Written SPICE testbench '%s'\n",
+             spice_fname.c_str());
+    NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
+    VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+    netlist_manager.set_netlist_type(nlist_id, NetlistManager::TESTBENCH_NETLIST);
+  }
+
+  /* Record the new testbenches, whose measurements are loaded in the next run */
+  if (false == options.cache_file().empty()) {
+    for (size_t itb = 0; itb < testbench_names.size(); ++itb) {
+      cache[fingerprints[itb]].testbench = testbench_names[itb];
+      cache[fingerprints[itb]].measurements.clear();
+    }
+    return write_spice_characterization_cache(options.cache_file(), cache);
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
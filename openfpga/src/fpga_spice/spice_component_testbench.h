@@ -0,0 +1,34 @@
+#ifndef SPICE_COMPONENT_TESTBENCH_H
+#define SPICE_COMPONENT_TESTBENCH_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "module_manager.h"
+#include "netlist_manager.h"
+#include "device_rr_gsb.h"
+#include "circuit_library.h"
+#include "technology_library.h"
+#include "simulation_setting.h"
+#include "spice_testbench_options.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int print_spice_routing_testbenches(NetlistManager& netlist_manager,
+                                    const ModuleManager& module_manager,
+                                    const DeviceRRGSB& device_rr_gsb,
+                                    const CircuitLibrary& circuit_lib,
+                                    const TechnologyLibrary& tech_lib,
+                                    const SimulationSetting& sim_setting,
+                                    const std::string& testbench_dir,
+                                    const SpiceTestbenchOption& options);
+
+} /* end namespace openfpga */
+
+#endif
@@ -10,4 +10,10 @@ constexpr char* TRANSISTOR_WRAPPER_POSTFIX = "_wrapper";
 constexpr char* TRANSISTORS_SPICE_FILE_NAME = "transistor.sp";
 constexpr char* ESSENTIALS_SPICE_FILE_NAME = "inv_buf_passgate.sp";
 
+constexpr char* SB_SPICE_FILE_NAME_PREFIX = "sb_";
+constexpr char* GRID_SPICE_FILE_NAME_PREFIX = "grid_";
+
+constexpr char* SPICE_COMPONENT_TESTBENCH_POSTFIX = "_testbench";
+constexpr char* SPICE_TESTBENCH_SUPPLY_NAME = "Vsupply";
+
 #endif
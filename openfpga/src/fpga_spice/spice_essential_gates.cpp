@@ -78,7 +78,7 @@ int print_spice_transistor_wrapper(NetlistManager& netlist_manager,
                                    const std::string& submodule_dir) {
   std::string spice_fname = submodule_dir + std::string(TRANSISTORS_SPICE_FILE_NAME);
 
-  std::fstream fp;
+  BufferedFileStream fp;
 
   /* Create the file stream */
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
@@ -1002,7 +1002,7 @@ int print_spice_essential_gates(NetlistManager& netlist_manager,
                                 const std::string& submodule_dir) {
   std::string spice_fname = submodule_dir + std::string(ESSENTIALS_SPICE_FILE_NAME);
 
-  std::fstream fp;
+  BufferedFileStream fp;
 
   /* Create the file stream */
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
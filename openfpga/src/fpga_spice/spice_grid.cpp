@@ -0,0 +1,248 @@
+/********************************************************************
+ * This file includes functions to print SPICE modules for a Grid
+ * (CLBs, I/Os, heterogeneous blocks etc.) 
+ *******************************************************************/
+/* System header files */
+#include <set>
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from readarch library */
+#include "physical_types.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+#include "openfpga_side_manager.h"
+
+/* Headers from vpr library */
+#include "vpr_utils.h"
+
+#include "openfpga_reserved_words.h"
+#include "openfpga_naming.h"
+#include "openfpga_physical_tile_utils.h"
+#include "pb_type_utils.h"
+
+#include "spice_constants.h"
+#include "spice_writer_utils.h"
+#include "spice_module_writer.h"
+#include "spice_grid.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Print SPICE subckts of physical blocks inside a logical tile
+ * This function will traverse the graph of complex logic block (t_pb_graph_node)
+ * in a recursive way, using a Depth First Search (DFS) algorithm.
+ * As such, primitive physical blocks (LUTs, FFs, etc.), leaf node of the pb_graph
+ * will be printed out first, while the top-level will be printed out in the last
+ *
+ * Note: a subckt is printed once for each type of t_pb_graph_node, 
+ * i.e., t_pb_type, in the graph, even if its module is instanciated many times
+ *******************************************************************/
+static 
+void rec_print_spice_logical_tile(std::fstream& fp,
+                                  const ModuleManager& module_manager,
+                                  const VprDeviceAnnotation& device_annotation,
+                                  t_pb_graph_node* physical_pb_graph_node,
+                                  std::set<ModuleId>& printed_modules,
+                                  const bool& verbose) {
+  VTR_ASSERT(nullptr != physical_pb_graph_node);
+
+  /* Get the pb_type definition related to the node */
+  t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type; 
+
+  /* For non-leaf node in the pb_type graph: 
+   * Recursively Depth-First Generate all the child pb_type at the level 
+   */
+  if (false == is_primitive_pb_type(physical_pb_type)) { 
+    t_mode* physical_mode = device_annotation.physical_mode(physical_pb_type);
+    for (int ipb = 0; ipb < physical_mode->num_pb_type_children; ++ipb) {
+      rec_print_spice_logical_tile(fp,
+                                   module_manager, device_annotation,
+                                   &(physical_pb_graph_node->child_pb_graph_nodes[physical_mode->index][ipb][0]),
+                                   printed_modules,
+                                   verbose);
+    }
+  }
+
+  ModuleId pb_module = module_manager.find_module(generate_physical_block_module_name(physical_pb_type));
+  VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
+
+  /* Bypass the subckts which have been printed */
+  if (false == printed_modules.insert(pb_module).second) {
+    return;
+  }
+
+  VTR_LOGV(verbose,
+           "Writing SPICE codes of pb_type '%s'...\n",
+           module_manager.module_name(pb_module).c_str());
+
+  write_spice_module_to_file(fp, module_manager, pb_module);
+}
+
+/*****************************************************************************
+ * This function will create a SPICE file and print out a SPICE netlist 
+ * for the logical tile (pb_graph/pb_type) 
+ *****************************************************************************/
+static 
+void print_spice_logical_tile_netlist(NetlistManager& netlist_manager,
+                                      const ModuleManager& module_manager,
+                                      const VprDeviceAnnotation& device_annotation,
+                                      const std::string& subckt_dir,
+                                      t_pb_graph_node* pb_graph_head,
+                                      const bool& verbose) {
+  std::string spice_fname(subckt_dir 
+                        + generate_logical_tile_netlist_name(std::string(), pb_graph_head, std::string(SPICE_NETLIST_FILE_POSTFIX))
+                         );
+
+  VTR_LOG("Writing SPICE netlist '%s' for logical tile '%s' ...",
+          spice_fname.c_str(), pb_graph_head->pb_type->name);
+  VTR_LOGV(verbose, "\n");
+
+  /* Create the file stream */
+  BufferedFileStream fp;
+  fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(spice_fname.c_str(), fp);
+
+  print_spice_file_header(fp, std::string("SPICE modules for logical tile: " + std::string(pb_graph_head->pb_type->name))); 
+
+  std::set<ModuleId> printed_modules;
+  rec_print_spice_logical_tile(fp,
+                               module_manager,
+                               device_annotation, 
+                               pb_graph_head,
+                               printed_modules,
+                               verbose);
+
+  /* Close file handler */
+  fp.close();
+
+  /* Add fname to the netlist name list */
+  NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
+  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+  netlist_manager.set_netlist_type(nlist_id, NetlistManager::LOGIC_BLOCK_NETLIST);
+
+  VTR_LOG("Done\n");
+}
+
+/*****************************************************************************
+ * This function will create a SPICE file and print out a SPICE netlist 
+ * for a type of physical block 
+ *
+ * For IO blocks: 
+ * The param 'border_side' is required, which is specify which side of fabric
+ * the I/O block locates at.
+ *****************************************************************************/
+static 
+void print_spice_physical_tile_netlist(NetlistManager& netlist_manager,
+                                       const ModuleManager& module_manager,
+                                       const std::string& subckt_dir,
+                                       t_physical_tile_type_ptr phy_block_type,
+                                       const e_side& border_side) {
+  /* Check code: if this is an IO block, the border side MUST be valid */
+  if (true == is_io_type(phy_block_type)) {
+    VTR_ASSERT(NUM_SIDES != border_side);
+  }
+  
+  std::string spice_fname(subckt_dir 
+                        + generate_grid_block_netlist_name(std::string(GRID_MODULE_NAME_PREFIX) + std::string(phy_block_type->name), 
+                                                           is_io_type(phy_block_type), 
+                                                           border_side, 
+                                                           std::string(SPICE_NETLIST_FILE_POSTFIX))
+                         );
+
+  /* Echo status */
+  if (true == is_io_type(phy_block_type)) {
+    SideManager side_manager(border_side);
+    VTR_LOG("Writing SPICE Netlist '%s' for physical tile '%s' at %s side ...",
+            spice_fname.c_str(), phy_block_type->name, 
+            side_manager.c_str());
+  } else { 
+    VTR_LOG("Writing SPICE Netlist '%s' for physical_tile '%s'...",
+            spice_fname.c_str(), phy_block_type->name);
+  }
+
+  /* Create the file stream */
+  BufferedFileStream fp;
+  fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(spice_fname.c_str(), fp);
+
+  print_spice_file_header(fp, std::string("SPICE modules for physical tile: " + std::string(phy_block_type->name))); 
+
+  std::string grid_module_name = generate_grid_block_module_name(std::string(GRID_SPICE_FILE_NAME_PREFIX), std::string(phy_block_type->name), is_io_type(phy_block_type), border_side);
+  ModuleId grid_module = module_manager.find_module(grid_module_name); 
+  VTR_ASSERT(true == module_manager.valid_module_id(grid_module));
+
+  write_spice_module_to_file(fp, module_manager, grid_module);
+
+  /* Close file handler */
+  fp.close();
+
+  /* Add fname to the netlist name list */
+  NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
+  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+  netlist_manager.set_netlist_type(nlist_id, NetlistManager::LOGIC_BLOCK_NETLIST);
+
+  VTR_LOG("Done\n");
+}
+
+/*****************************************************************************
+ * Create logic block modules in a compact way:
+ * 1. Only one module for each I/O on each border side (IO_TYPE)
+ * 2. Only one module for each CLB (FILL_TYPE)
+ * 3. Only one module for each heterogeneous block
+ ****************************************************************************/
+void print_spice_grids(NetlistManager& netlist_manager,
+                       const ModuleManager& module_manager,
+                       const DeviceContext& device_ctx,
+                       const VprDeviceAnnotation& device_annotation,
+                       const std::string& subckt_dir,
+                       const bool& verbose) {
+  /* Enumerate the types of logical tiles, and build a module for each */
+  for (const t_logical_block_type& logical_tile : device_ctx.logical_block_types) {
+    /* Bypass empty pb_graph */
+    if (nullptr == logical_tile.pb_graph_head) {
+      continue;
+    }
+    print_spice_logical_tile_netlist(netlist_manager,
+                                     module_manager,
+                                     device_annotation,
+                                     subckt_dir,
+                                     logical_tile.pb_graph_head,
+                                     verbose);
+  }
+
+  /* Enumerate the types of physical tiles */
+  for (const t_physical_tile_type& physical_tile : device_ctx.physical_tile_types) {
+    /* Bypass empty type or nullptr */
+    if (true == is_empty_type(&physical_tile)) {
+      continue;
+    } else if (true == is_io_type(&physical_tile)) {
+      /* Special for I/O block: one module for each side where the I/O blocks locate */
+      std::set<e_side> io_type_sides = find_physical_io_tile_located_sides(device_ctx.grid,
+                                                                           &physical_tile);
+      for (const e_side& io_type_side : io_type_sides) {
+        print_spice_physical_tile_netlist(netlist_manager,
+                                          module_manager,
+                                          subckt_dir, 
+                                          &physical_tile,
+                                          io_type_side);
+      } 
+    } else {
+      /* For CLB and heterogenenous blocks */
+      print_spice_physical_tile_netlist(netlist_manager,
+                                        module_manager,
+                                        subckt_dir, 
+                                        &physical_tile,
+                                        NUM_SIDES);
+    }
+  }
+
+  VTR_LOG("\n");
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,200 @@
+/********************************************************************
+ * This file includes functions to write a SPICE subckt
+ * based on its definition in the module manager
+ *
+ * Note that SPICE netlists are flat lists of nodes:
+ * - each module net is modeled as a node, which is named after
+ *   the port of the parent module it is connected to, if any
+ * - ports of the parent module which are shorted to another port
+ *   are connected by a zero-voltage source
+ *******************************************************************/
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "openfpga_naming.h"
+
+#include "spice_writer_utils.h"
+#include "spice_module_writer.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Name a node for a module net in SPICE
+ * 1. If the net is driven or loaded by a port of the module,
+ *    name it after the port
+ * 2. Otherwise, it is a local node named after its source:
+ *    <src_module_name>_<instance_id>_<src_port_name>[<pin>]
+ *
+ * Restriction: this function requires each net has single driver
+ * which is definitely always true in circuits.
+ *******************************************************************/
+static 
+std::string generate_spice_node_for_module_net(const ModuleManager& module_manager,
+                                               const ModuleId& module_id,
+                                               const ModuleNetId& module_net) {
+  for (ModuleNetSrcId src_id : module_manager.module_net_sources(module_id, module_net)) {
+    if (module_id == module_manager.net_source_module(module_id, module_net, src_id)) {
+      ModulePortId net_src_port = module_manager.net_source_port(module_id, module_net, src_id);
+      size_t src_pin_index = module_manager.net_source_pin(module_id, module_net, src_id);
+      return generate_spice_port(BasicPort(module_manager.module_port(module_id, net_src_port).get_name(), src_pin_index, src_pin_index));
+    }
+  }
+
+  for (ModuleNetSinkId sink_id : module_manager.module_net_sinks(module_id, module_net)) {
+    if (module_id == module_manager.net_sink_module(module_id, module_net, sink_id)) {
+      ModulePortId net_sink_port = module_manager.net_sink_port(module_id, module_net, sink_id);
+      size_t sink_pin_index = module_manager.net_sink_pin(module_id, module_net, sink_id);
+      return generate_spice_port(BasicPort(module_manager.module_port(module_id, net_sink_port).get_name(), sink_pin_index, sink_pin_index));
+    }
+  }
+
+  /* Reach here, this is a local node */
+  VTR_ASSERT(1 == module_manager.module_net_sources(module_id, module_net).size());
+
+  ModuleId net_src_module = module_manager.net_source_module(module_id, module_net, ModuleNetSrcId(0));
+  size_t net_src_instance = module_manager.net_source_instance(module_id, module_net, ModuleNetSrcId(0)); 
+  ModulePortId net_src_port = module_manager.net_source_port(module_id, module_net, ModuleNetSrcId(0)); 
+  size_t net_src_pin = module_manager.net_source_pin(module_id, module_net, ModuleNetSrcId(0)); 
+
+  /* Load user-defined name if we have it */
+  std::string node_name;
+  if (false == module_manager.net_name(module_id, module_net).empty()) {
+    node_name = module_manager.net_name(module_id, module_net);
+  } else {
+    node_name  = module_manager.module_name(net_src_module); 
+    node_name += std::string("_") + std::to_string(net_src_instance) + std::string("_");
+    node_name += module_manager.module_port(net_src_module, net_src_port).get_name();
+  }
+  
+  return generate_spice_port(BasicPort(node_name, net_src_pin, net_src_pin));
+}
+
+/********************************************************************
+ * Print a list of nodes after a head line, 
+ * with 10 nodes per line to keep a clean netlist
+ *******************************************************************/
+static 
+void print_spice_node_list(std::fstream& fp,
+                           const std::string& head_line,
+                           const std::vector<std::string>& nodes) {
+  fp << head_line;
+
+  size_t node_cnt = 0;
+  for (const std::string& node : nodes) {
+    if (0 != node_cnt) {
+      write_space_to_file(fp, 1);
+    }
+    fp << node;
+
+    ++node_cnt;
+    if (10 == node_cnt) {
+      node_cnt = 0;
+      fp << "\n";
+      fp << "+ " << std::string(head_line.length() - 2, ' ');
+    }
+  }
+}
+
+/********************************************************************
+ * Print an instance of a child module in SPICE format:
+ *   X<instance_name> <nodes> <child_module_name>
+ * The nodes follow the port sequence of the subckt definition:
+ * global, inout, input, output and clock ports
+ *******************************************************************/
+static 
+void print_spice_module_instance(std::fstream& fp,
+                                 const ModuleManager& module_manager,
+                                 const ModuleId& parent_module,
+                                 const ModuleId& child_module,
+                                 const size_t& instance_id,
+                                 const std::map<ModuleNetId, std::string>& net_nodes) {
+  std::string instance_name = module_manager.instance_name(parent_module, child_module, instance_id);
+  if (true == instance_name.empty()) {
+    instance_name = generate_instance_name(module_manager.module_name(child_module), instance_id);
+  }
+
+  std::vector<std::string> nodes;
+  for (int port_type = ModuleManager::MODULE_GLOBAL_PORT;
+       port_type < ModuleManager::NUM_MODULE_PORT_TYPES;
+       ++port_type) {
+    for (const BasicPort& port : module_manager.module_ports_by_type(child_module, static_cast<ModuleManager::e_module_port_type>(port_type))) {
+      ModulePortId port_id = module_manager.find_module_port(child_module, port.get_name());
+      VTR_ASSERT(ModulePortId::INVALID() != port_id);
+
+      for (const size_t& pin : port.pins()) {
+        ModuleNetId net = module_manager.module_instance_port_net(parent_module, child_module, instance_id, 
+                                                                  port_id, pin);
+        if (ModuleNetId::INVALID() != net) {
+          nodes.push_back(net_nodes.at(net));
+          continue;
+        }
+        /* An undriven pin is connected to a dedicated node */
+        nodes.push_back(generate_spice_port(BasicPort(instance_name + std::string("_undriven_") + port.get_name(), pin, pin)));
+      }
+    }
+  }
+
+  print_spice_node_list(fp, std::string("X") + instance_name + std::string(" "), nodes);
+  fp << " " << module_manager.module_name(child_module) << "\n";
+}
+
+/********************************************************************
+ * Write a SPICE subckt based on its definition in the module manager
+ * The subckt consists of
+ * 1. the subckt definition
+ * 2. zero-voltage sources to short ports of the subckt
+ * 3. the instances of child modules
+ * 4. the end of the subckt
+ *******************************************************************/
+void write_spice_module_to_file(std::fstream& fp,
+                                const ModuleManager& module_manager,
+                                const ModuleId& module_id) {
+  VTR_ASSERT(true == valid_file_stream(fp));
+  VTR_ASSERT(true == module_manager.valid_module_id(module_id));
+
+  print_spice_subckt_definition(fp, module_manager, module_id);
+
+  /* Name the nodes of all the nets */
+  std::map<ModuleNetId, std::string> net_nodes;
+  for (const ModuleNetId& module_net : module_manager.module_nets(module_id)) {
+    net_nodes[module_net] = generate_spice_node_for_module_net(module_manager, module_id, module_net);
+  }
+
+  /* A port of the subckt which does not name the node of its net is shorted to the node */
+  size_t num_shorts = 0;
+  for (const ModuleNetId& module_net : module_manager.module_nets(module_id)) {
+    for (ModuleNetSinkId sink_id : module_manager.module_net_sinks(module_id, module_net)) {
+      if (module_id != module_manager.net_sink_module(module_id, module_net, sink_id)) {
+        continue;
+      }
+      ModulePortId net_sink_port = module_manager.net_sink_port(module_id, module_net, sink_id);
+      size_t sink_pin_index = module_manager.net_sink_pin(module_id, module_net, sink_id);
+      std::string sink_node = generate_spice_port(BasicPort(module_manager.module_port(module_id, net_sink_port).get_name(), sink_pin_index, sink_pin_index));
+      if (sink_node == net_nodes[module_net]) {
+        continue;
+      }
+      fp << "Vshort_" << num_shorts << " " << net_nodes[module_net] << " " << sink_node << " 0" << "\n";
+      ++num_shorts;
+    }
+  }
+
+  /* Print the instances of child modules */
+  for (const ModuleId& child_module : module_manager.child_modules(module_id)) {
+    for (const size_t& instance_id : module_manager.child_module_instances(module_id, child_module)) {
+      print_spice_module_instance(fp, module_manager, module_id, child_module, instance_id, net_nodes);
+    }
+  }
+
+  print_spice_subckt_end(fp, module_manager.module_name(module_id));
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,158 @@
+/*********************************************************************
+ * This file includes functions that are used for 
+ * SPICE generation of FPGA routing architecture (global routing) 
+ *********************************************************************/
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "openfpga_naming.h"
+
+#include "spice_constants.h"
+#include "spice_writer_utils.h"
+#include "spice_module_writer.h"
+#include "spice_routing.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Write the SPICE netlist of a routing module and register it to the netlist manager
+ *******************************************************************/
+static 
+void print_spice_routing_module_netlist(NetlistManager& netlist_manager,
+                                        const ModuleManager& module_manager, 
+                                        const std::string& spice_fname,
+                                        const std::string& usage,
+                                        const std::string& module_name) {
+  BufferedFileStream fp;
+
+  /* Create the file stream */
+  fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(spice_fname.c_str(), fp);
+
+  print_spice_file_header(fp, usage); 
+
+  ModuleId routing_module = module_manager.find_module(module_name); 
+  VTR_ASSERT(true == module_manager.valid_module_id(routing_module));
+
+  write_spice_module_to_file(fp, module_manager, routing_module);
+
+  /* Close file handler */
+  fp.close();
+
+  /* Add fname to the netlist name list */
+  NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
+  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+  netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+}
+
+/********************************************************************
+ * Print the subckt of a connection Box (Type: [CHANX|CHANY])
+ *******************************************************************/
+static 
+void print_spice_routing_connection_box_unique_module(NetlistManager& netlist_manager,
+                                                      const ModuleManager& module_manager, 
+                                                      const std::string& subckt_dir, 
+                                                      const RRGSB& rr_gsb,
+                                                      const t_rr_type& cb_type) {
+  vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
+  std::string spice_fname(subckt_dir + generate_connection_block_netlist_name(cb_type, gsb_coordinate, std::string(SPICE_NETLIST_FILE_POSTFIX)));
+
+  print_spice_routing_module_netlist(netlist_manager, module_manager, spice_fname,
+                                     std::string("SPICE modules for Unique Connection Blocks[" + std::to_string(rr_gsb.get_cb_x(cb_type)) + "]["+ std::to_string(rr_gsb.get_cb_y(cb_type)) + "]"),
+                                     generate_connection_block_module_name(cb_type, gsb_coordinate));
+}
+
+/********************************************************************
+ * Print the subckt of a Switch Box
+ *******************************************************************/
+static 
+void print_spice_routing_switch_box_unique_module(NetlistManager& netlist_manager,
+                                                  const ModuleManager& module_manager, 
+                                                  const std::string& subckt_dir, 
+                                                  const RRGSB& rr_gsb) {
+  vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+  std::string spice_fname(subckt_dir + generate_routing_block_netlist_name(SB_SPICE_FILE_NAME_PREFIX, gsb_coordinate, std::string(SPICE_NETLIST_FILE_POSTFIX)));
+
+  print_spice_routing_module_netlist(netlist_manager, module_manager, spice_fname,
+                                     std::string("SPICE modules for Unique Switch Blocks[" + std::to_string(rr_gsb.get_sb_x()) + "]["+ std::to_string(rr_gsb.get_sb_y()) + "]"),
+                                     generate_switch_block_module_name(gsb_coordinate));
+}
+
+/********************************************************************
+ * A top-level function of this file
+ * Print all the modules for global routing architecture of a FPGA fabric
+ * in SPICE format in a flatten way:
+ *   Each connection block and switch block will be generated as a unique module
+ *******************************************************************/
+void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
+                                         const ModuleManager& module_manager,
+                                         const DeviceRRGSB& device_rr_gsb,
+                                         const std::string& subckt_dir) {
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+
+  /* Build unique switch block modules */
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+      if (true != rr_gsb.is_sb_exist()) {
+        continue;
+      }
+      print_spice_routing_switch_box_unique_module(netlist_manager, module_manager, subckt_dir, rr_gsb);
+    }
+  }
+
+  /* Build connection block modules
+   * Some of them do NOT exist due to heterogeneous blocks (height > 1) 
+   */
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+      for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+        const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+        if (true != rr_gsb.is_cb_exist(cb_type)) {
+          continue;
+        }
+        print_spice_routing_connection_box_unique_module(netlist_manager, module_manager, subckt_dir, rr_gsb, cb_type);
+      }
+    }
+  }
+
+  VTR_LOG("\n");
+}
+
+/********************************************************************
+ * A top-level function of this file
+ * Print all the unique modules for global routing architecture of a FPGA fabric
+ * in SPICE format, so that the subckt of each unique module is written only once
+ *
+ * Note: this function SHOULD be called only when 
+ * the option compact_routing_hierarchy is turned on!!!
+ *******************************************************************/
+void print_spice_unique_routing_modules(NetlistManager& netlist_manager,
+                                        const ModuleManager& module_manager,
+                                        const DeviceRRGSB& device_rr_gsb,
+                                        const std::string& subckt_dir) {
+  /* Build unique switch block modules */
+  for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
+    print_spice_routing_switch_box_unique_module(netlist_manager, module_manager, subckt_dir,
+                                                 device_rr_gsb.get_sb_unique_module(isb));
+  }
+
+  /* Build unique connection block modules */
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(cb_type); ++icb) {
+      print_spice_routing_connection_box_unique_module(netlist_manager, module_manager, subckt_dir,
+                                                       device_rr_gsb.get_cb_unique_module(cb_type, icb), cb_type);
+    }
+  }
+
+  VTR_LOG("\n");
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,69 @@
+/******************************************************************************
+ * Memember functions for data structure SpiceTestbenchOption
+ ******************************************************************************/
+#include "vtr_assert.h"
+
+#include "spice_testbench_options.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/**************************************************
+ * Public Constructors
+ *************************************************/
+SpiceTestbenchOption::SpiceTestbenchOption() {
+  output_directory_.clear();
+  compress_routing_ = false;
+  num_jobs_ = 1;
+  cache_file_.clear();
+  verbose_output_ = false;
+}
+
+/**************************************************
+ * Public Accessors 
+ *************************************************/
+std::string SpiceTestbenchOption::output_directory() const {
+  return output_directory_;
+}
+
+bool SpiceTestbenchOption::compress_routing() const {
+  return compress_routing_;
+}
+
+size_t SpiceTestbenchOption::num_jobs() const {
+  return num_jobs_;
+}
+
+std::string SpiceTestbenchOption::cache_file() const {
+  return cache_file_;
+}
+
+bool SpiceTestbenchOption::verbose_output() const {
+  return verbose_output_;
+}
+
+/******************************************************************************
+ * Private Mutators
+ ******************************************************************************/
+void SpiceTestbenchOption::set_output_directory(const std::string& output_dir) {
+  output_directory_ = output_dir;
+}
+
+void SpiceTestbenchOption::set_compress_routing(const bool& enabled) {
+  compress_routing_ = enabled;
+}
+
+void SpiceTestbenchOption::set_num_jobs(const size_t& num_jobs) {
+  VTR_ASSERT(0 < num_jobs);
+  num_jobs_ = num_jobs;
+}
+
+void SpiceTestbenchOption::set_cache_file(const std::string& cache_file) {
+  cache_file_ = cache_file;
+}
+
+void SpiceTestbenchOption::set_verbose_output(const bool& enabled) {
+  verbose_output_ = enabled;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,43 @@
+#ifndef SPICE_TESTBENCH_OPTIONS_H
+#define SPICE_TESTBENCH_OPTIONS_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <string>
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Options for SPICE testbench generator
+ *******************************************************************/
+class SpiceTestbenchOption {
+  public: /* Public constructor */
+    /* Set default options */
+    SpiceTestbenchOption();
+  public: /* Public accessors */
+    std::string output_directory() const;
+    bool compress_routing() const;
+    size_t num_jobs() const;
+    std::string cache_file() const;
+    bool verbose_output() const;
+  public: /* Public mutators */
+    void set_output_directory(const std::string& output_dir);
+    void set_compress_routing(const bool& enabled);
+    void set_num_jobs(const size_t& num_jobs);
+    void set_cache_file(const std::string& cache_file);
+    void set_verbose_output(const bool& enabled);
+  private: /* Internal Data */
+    std::string output_directory_;
+    bool compress_routing_;
+    /* Number of testbenches to be written in parallel */
+    size_t num_jobs_;
+    /* File to cache the characterizations across runs, which is disabled when empty */
+    std::string cache_file_;
+    bool verbose_output_;
+};
+
+} /* End namespace openfpga*/
+
+#endif
@@ -0,0 +1,59 @@
+/********************************************************************
+ * This file includes functions that are used to print the top-level
+ * module for the FPGA fabric in SPICE format
+ *******************************************************************/
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "openfpga_naming.h"
+
+#include "spice_constants.h"
+#include "spice_writer_utils.h"
+#include "spice_module_writer.h"
+#include "spice_top_module.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Print the top-level module for the FPGA fabric in SPICE format
+ *******************************************************************/
+void print_spice_top_module(NetlistManager& netlist_manager,
+                            const ModuleManager& module_manager,
+                            const std::string& spice_dir) {
+  std::string top_module_name = generate_fpga_top_module_name();
+  ModuleId top_module = module_manager.find_module(top_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(top_module));
+
+  std::string spice_fname(spice_dir + generate_fpga_top_netlist_name(std::string(SPICE_NETLIST_FILE_POSTFIX)));
+
+  VTR_LOG("Writing SPICE netlist for top-level module of FPGA fabric '%s'...",
+          spice_fname.c_str());
+
+  /* Create the file stream */
+  BufferedFileStream fp;
+  fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(spice_fname.c_str(), fp);
+
+  print_spice_file_header(fp, std::string("Top-level SPICE module for FPGA")); 
+
+  write_spice_module_to_file(fp, module_manager, top_module);
+
+  /* Close file handler */
+  fp.close();
+
+  /* Add fname to the netlist name list */
+  NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
+  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+  netlist_manager.set_netlist_type(nlist_id, NetlistManager::TOP_MODULE_NETLIST);
+
+  VTR_LOG("Done\n");
+}
+
+} /* end namespace openfpga */
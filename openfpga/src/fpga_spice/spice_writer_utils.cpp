@@ -34,14 +34,14 @@ void print_spice_file_header(std::fstream& fp,
   auto end = std::chrono::system_clock::now(); 
   std::time_t end_time = std::chrono::system_clock::to_time_t(end);
 
-  fp << "*********************************************" << std::endl;
-  fp << "*\tFPGA-SPICE Netlist" << std::endl;
-  fp << "*\tDescription: " << usage << std::endl;
-  fp << "*\tAuthor: Xifan TANG" << std::endl;
-  fp << "*\tOrganization: University of Utah" << std::endl;
+  fp << "*********************************************" << "\n";
+  fp << "*\tFPGA-SPICE Netlist" << "\n";
+  fp << "*\tDescription: " << usage << "\n";
+  fp << "*\tAuthor: Xifan TANG" << "\n";
+  fp << "*\tOrganization: University of Utah" << "\n";
   fp << "*\tDate: " << std::ctime(&end_time) ;
-  fp << "*********************************************" << std::endl;
-  fp << std::endl;
+  fp << "*********************************************" << "\n";
+  fp << "\n";
 }
 
 /********************************************************************
@@ -51,7 +51,7 @@ void print_spice_include_netlist(std::fstream& fp,
                                  const std::string& netlist_name) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << ".include \"" << netlist_name << "\"" << std::endl; 
+  fp << ".include \"" << netlist_name << "\"" << "\n"; 
 }
 
 /************************************************
@@ -62,9 +62,9 @@ void print_spice_comment(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   std::string comment_cover(comment.length() + 4, '*');
-  fp << comment_cover << std::endl;
-  fp << "* " << comment << " *" << std::endl;
-  fp << comment_cover << std::endl;
+  fp << comment_cover << "\n";
+  fp << "* " << comment << " *" << "\n";
+  fp << comment_cover << "\n";
 }
 
 
@@ -128,13 +128,13 @@ void print_spice_subckt_definition(std::fstream& fp,
         new_line = false;
         if (10 == pin_cnt) {
           pin_cnt = 0;
-          fp << std::endl;
+          fp << "\n";
           new_line = true;
         }
       }
     }
   }
-  fp << std::endl;
+  fp << "\n";
 }
 
 /************************************************
@@ -144,9 +144,9 @@ void print_spice_subckt_end(std::fstream& fp,
                             const std::string& module_name) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << ".ends" << std::endl;
+  fp << ".ends" << "\n";
   print_spice_comment(fp, std::string("***** END SPICE module for " + module_name + " *****"));
-  fp << std::endl;
+  fp << "\n";
 }
 
 } /* end namespace openfpga */
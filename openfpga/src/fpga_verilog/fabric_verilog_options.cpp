@@ -16,10 +16,18 @@ FabricVerilogOption::FabricVerilogOption() {
   support_icarus_simulator_ = false;
   include_signal_init_ = false;
   include_timing_ = false;
+  sdf_timing_ = false;
   explicit_port_mapping_ = false;
   compress_routing_ = false;
   print_user_defined_template_ = false;
+  parameterized_mux_ = false;
+  compact_top_module_ = false;
+  packed_ports_ = false;
+  verilator_target_ = false;
+  incremental_ = false;
   verbose_output_ = false;
+  num_jobs_ = 1;
+  sharded_ = false;
 }
 
 /**************************************************
@@ -37,6 +45,10 @@ bool FabricVerilogOption::include_timing() const {
   return include_timing_;
 }
 
+bool FabricVerilogOption::sdf_timing() const {
+  return sdf_timing_;
+}
+
 bool FabricVerilogOption::include_signal_init() const {
   return include_signal_init_;
 }
@@ -53,10 +65,42 @@ bool FabricVerilogOption::print_user_defined_template() const {
   return print_user_defined_template_;
 }
 
+bool FabricVerilogOption::parameterized_mux() const {
+  return parameterized_mux_;
+}
+
+bool FabricVerilogOption::compact_top_module() const {
+  return compact_top_module_;
+}
+
+bool FabricVerilogOption::packed_ports() const {
+  return packed_ports_;
+}
+
+bool FabricVerilogOption::verilator_target() const {
+  return verilator_target_;
+}
+
+bool FabricVerilogOption::incremental() const {
+  return incremental_;
+}
+
 bool FabricVerilogOption::verbose_output() const {
   return verbose_output_;
 }
 
+size_t FabricVerilogOption::num_jobs() const {
+  return num_jobs_;
+}
+
+bool FabricVerilogOption::sharded() const {
+  return sharded_;
+}
+
+vtr::Rect<size_t> FabricVerilogOption::shard_region() const {
+  return shard_region_;
+}
+
 /******************************************************************************
  * Private Mutators
  ******************************************************************************/
@@ -72,6 +116,10 @@ void FabricVerilogOption::set_include_timing(const bool& enabled) {
   include_timing_ = enabled;
 }
 
+void FabricVerilogOption::set_sdf_timing(const bool& enabled) {
+  sdf_timing_ = enabled;
+}
+
 void FabricVerilogOption::set_include_signal_init(const bool& enabled) {
   include_signal_init_ = enabled;
 }
@@ -88,8 +136,38 @@ void FabricVerilogOption::set_print_user_defined_template(const bool& enabled) {
   print_user_defined_template_ = enabled;
 }
 
+void FabricVerilogOption::set_parameterized_mux(const bool& enabled) {
+  parameterized_mux_ = enabled;
+}
+
+void FabricVerilogOption::set_compact_top_module(const bool& enabled) {
+  compact_top_module_ = enabled;
+}
+
+void FabricVerilogOption::set_packed_ports(const bool& enabled) {
+  packed_ports_ = enabled;
+}
+
+void FabricVerilogOption::set_verilator_target(const bool& enabled) {
+  verilator_target_ = enabled;
+}
+
+void FabricVerilogOption::set_incremental(const bool& enabled) {
+  incremental_ = enabled;
+}
+
 void FabricVerilogOption::set_verbose_output(const bool& enabled) {
   verbose_output_ = enabled;
 }
 
+void FabricVerilogOption::set_num_jobs(const size_t& num_jobs) {
+  VTR_ASSERT(0 < num_jobs);
+  num_jobs_ = num_jobs;
+}
+
+void FabricVerilogOption::set_shard_region(const vtr::Rect<size_t>& shard_region) {
+  sharded_ = true;
+  shard_region_ = shard_region;
+}
+
 } /* end namespace openfpga */
@@ -5,6 +5,7 @@
  * Include header files required by the data structure definition
  *******************************************************************/
 #include <string>
+#include "vtr_geometry.h"
 
 /* Begin namespace openfpga */
 namespace openfpga {
@@ -20,29 +21,63 @@ class FabricVerilogOption {
     std::string output_directory() const;
     bool support_icarus_simulator() const;
     bool include_timing() const;
+    bool sdf_timing() const;
     bool include_signal_init() const;
     bool explicit_port_mapping() const;
     bool compress_routing() const;
     bool print_user_defined_template() const;
+    bool parameterized_mux() const;
+    bool compact_top_module() const;
+    bool packed_ports() const;
+    bool verilator_target() const;
+    bool incremental() const;
     bool verbose_output() const;
+    size_t num_jobs() const;
+    bool sharded() const;
+    vtr::Rect<size_t> shard_region() const;
   public: /* Public mutators */
     void set_output_directory(const std::string& output_dir);
     void set_support_icarus_simulator(const bool& enabled);
     void set_include_timing(const bool& enabled);
+    void set_sdf_timing(const bool& enabled);
     void set_include_signal_init(const bool& enabled);
     void set_explicit_port_mapping(const bool& enabled);
     void set_compress_routing(const bool& enabled);
     void set_print_user_defined_template(const bool& enabled);
+    void set_parameterized_mux(const bool& enabled);
+    void set_compact_top_module(const bool& enabled);
+    void set_packed_ports(const bool& enabled);
+    void set_verilator_target(const bool& enabled);
+    void set_incremental(const bool& enabled);
     void set_verbose_output(const bool& enabled);
+    void set_num_jobs(const size_t& num_jobs);
+    void set_shard_region(const vtr::Rect<size_t>& shard_region);
   private: /* Internal Data */
     std::string output_directory_;
     bool support_icarus_simulator_;
     bool include_signal_init_;
     bool include_timing_;
+    /* Write the pin-to-pin delays of the timing annotation into an SDF file instead of the specify blocks */
+    bool sdf_timing_;
     bool explicit_port_mapping_;
     bool compress_routing_;
     bool print_user_defined_template_;
+    /* Write the multiplexers of a circuit model with a parameterized module */
+    bool parameterized_mux_;
+    /* Write the regular instances of the top-level module in generate loops */
+    bool compact_top_module_;
+    /* Pack the single-pin ports of grids and routing blocks into Verilog vectors */
+    bool packed_ports_;
+    /* Only use the constructs supported by Verilator, and write a C++ harness for its model */
+    bool verilator_target_;
+    /* Keep the netlists whose contents are not changed */
+    bool incremental_;
     bool verbose_output_;
+    /* Number of netlists which can be written in parallel */
+    size_t num_jobs_;
+    /* Only write the routing netlists of the GSBs in a window of the device */
+    bool sharded_;
+    vtr::Rect<size_t> shard_region_;
 };
 
 } /* End namespace openfpga*/
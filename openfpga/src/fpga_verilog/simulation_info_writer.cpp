@@ -19,6 +19,7 @@
 #include "openfpga_naming.h"
 
 #include "simulation_utils.h"
+#include "openfpga_atom_netlist_utils.h"
 
 #include "verilog_constants.h"
 #include "simulation_info_writer.h"
@@ -108,6 +109,7 @@ void print_verilog_simulation_info(const std::string& ini_fname,
      * TODO: this should be reworked to be consistent with bitstream
      */
     std::string io_direction(total_gpio_width, '1');
+    vtr::vector<AtomBlockId, size_t> atom_io_indices = find_atom_netlist_io_indices(atom_ctx, place_ctx, io_location_map);
     for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
       /* Bypass non-I/O atom blocks ! */
       if ( (AtomBlockType::INPAD != atom_ctx.nlist.block_type(atom_blk))
@@ -116,9 +118,7 @@ void print_verilog_simulation_info(const std::string& ini_fname,
       }
 
       /* Find the index of the mapped GPIO in top-level FPGA fabric */
-      size_t io_index = io_location_map.io_index(place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.x,
-                                                 place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.y,
-                                                 place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.z);
+      size_t io_index = atom_io_indices[atom_blk];
 
       if (AtomBlockType::INPAD == atom_ctx.nlist.block_type(atom_blk)) {
         io_direction[io_index] = '1';
@@ -0,0 +1,272 @@
+/********************************************************************
+ * This file includes functions that are used to generate a C++ harness
+ * for the Verilator model of the FPGA fabric.
+ * The harness loads a binary fabric bitstream to the fabric
+ * through its configuration ports, so that a configured fabric
+ * can be simulated cycle by cycle
+ *******************************************************************/
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "openfpga_naming.h"
+#include "circuit_library_utils.h"
+#include "binary_fabric_bitstream.h"
+#include "verilog_constants.h"
+#include "verilator_harness.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Print a C++ statement which sets all the bits of a global port of the top-level module
+ * The value is inverted when the default value of the global port is 1
+ *******************************************************************/
+static
+void print_verilator_harness_global_port_assignment(std::fstream& fp,
+                                                    const BasicPort& port,
+                                                    const std::string& value,
+                                                    const bool& inverted) {
+  fp << "      dut_->" << port.get_name() << " = (" << value;
+  fp << (inverted ? " == false" : " == true") << ") ? ";
+  if (64 == port.get_width()) {
+    fp << "~uint64_t(0)";
+  } else {
+    fp << "((uint64_t(1) << " << port.get_width() << ") - 1)";
+  }
+  fp << " : 0;" << "\n";
+}
+
+/********************************************************************
+ * Print a C++ method of the harness which sets the global ports selected by a filter
+ *******************************************************************/
+template<class GlobalPortFilter>
+static
+void print_verilator_harness_global_port_method(std::fstream& fp,
+                                                const std::string& method_name,
+                                                const ModuleManager& module_manager,
+                                                const ModuleId& top_module,
+                                                const CircuitLibrary& circuit_lib,
+                                                const std::vector<CircuitPortId>& global_ports,
+                                                const GlobalPortFilter& filter) {
+  fp << "    void " << method_name << "(const bool& value) {" << "\n";
+  for (const CircuitPortId& model_global_port : global_ports) {
+    if (false == filter(model_global_port)) {
+      continue;
+    }
+    ModulePortId module_global_port = module_manager.find_module_port(top_module, circuit_lib.port_prefix(model_global_port));
+    VTR_ASSERT(true == module_manager.valid_module_port_id(top_module, module_global_port));
+    print_verilator_harness_global_port_assignment(fp, module_manager.module_port(top_module, module_global_port),
+                                                   std::string("value"),
+                                                   1 == circuit_lib.port_default_value(model_global_port));
+  }
+  fp << "      (void)value;" << "\n";
+  fp << "    }" << "\n";
+  fp << "\n";
+}
+
+/********************************************************************
+ * Print a C++ header of a harness class for the Verilator model of the FPGA fabric
+ * The harness is a template of the model class, e.g., Vfpga_top,
+ * so that it does not depend on the prefix chosen when verilating the netlists.
+ *
+ * The harness
+ * 1. reads a binary fabric bitstream file, i.e., the output of
+ *    'write_fabric_bitstream' with the binary format,
+ * 2. shifts the bits to the configuration chain, one bit per programming clock cycle,
+ * 3. enables the configuration done signals, if any,
+ *    and then toggles the operating clocks cycle by cycle upon requests
+ *
+ * Only a configuration chain in a single region is supported now,
+ * where the bits can be loaded without any information about the regions.
+ * For other fabrics, the harness is not generated and a warning is printed
+ *******************************************************************/
+void print_verilator_harness(const ModuleManager& module_manager,
+                             const CircuitLibrary& circuit_lib,
+                             const std::string& src_dir) {
+  std::string top_module_name = generate_fpga_top_module_name();
+  std::string harness_fname = src_dir + top_module_name + std::string(VERILATOR_HARNESS_FILE_POSTFIX);
+
+  std::string timer_message = std::string("Write Verilator harness '") + harness_fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  ModuleId top_module = module_manager.find_module(top_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(top_module));
+
+  /* Check if the fabric is supported */
+  ModulePortId ccff_head_port = module_manager.find_module_port(top_module, generate_configuration_chain_head_name());
+  if ( (false == module_manager.valid_module_port_id(top_module, ccff_head_port))
+    || (1 != module_manager.module_port(top_module, ccff_head_port).get_width()) ) {
+    VTR_LOG_WARN("Verilator harness is only available for a configuration chain in a single region! Skip generation.\n");
+    return;
+  }
+
+  std::vector<CircuitPortId> global_ports = find_circuit_library_global_ports(circuit_lib);
+  for (const CircuitPortId& model_global_port : global_ports) {
+    ModulePortId module_global_port = module_manager.find_module_port(top_module, circuit_lib.port_prefix(model_global_port));
+    if ( (true == module_manager.valid_module_port_id(top_module, module_global_port))
+      && (64 < module_manager.module_port(top_module, module_global_port).get_width()) ) {
+      VTR_LOG_WARN("Verilator harness does not support global port '%s' wider than 64 bits! Skip generation.\n",
+                   circuit_lib.port_prefix(model_global_port).c_str());
+      return;
+    }
+  }
+
+  /* Create the file stream */
+  BufferedFileStream fp;
+  fp.open(harness_fname, std::fstream::out | std::fstream::trunc);
+
+  /* Validate the file stream */
+  check_file_stream(harness_fname.c_str(), fp);
+
+  std::string harness_class_name = std::string("FpgaTopVerilatorHarness");
+  std::string guard_name = top_module_name + std::string("_VERILATOR_HARNESS_H");
+  std::transform(guard_name.begin(), guard_name.end(), guard_name.begin(), ::toupper);
+
+  fp << "/********************************************************************" << "\n";
+  fp << " * Harness for the Verilator model of FPGA fabric '" << top_module_name << "'" << "\n";
+  fp << " * Usage:" << "\n";
+  fp << " *   V" << top_module_name << "* dut = new V" << top_module_name << ";" << "\n";
+  fp << " *   " << harness_class_name << "<V" << top_module_name << "> harness(dut);" << "\n";
+  fp << " *   harness.load_bitstream(\"fabric_bitstream.bin\");" << "\n";
+  fp << " *   for (...) {" << "\n";
+  fp << " *     // Drive the I/Os through harness.dut()" << "\n";
+  fp << " *     harness.tick();" << "\n";
+  fp << " *   }" << "\n";
+  fp << " *******************************************************************/" << "\n";
+  fp << "#ifndef " << guard_name << "\n";
+  fp << "#define " << guard_name << "\n";
+  fp << "\n";
+  fp << "#include <cstdint>" << "\n";
+  fp << "#include <cstring>" << "\n";
+  fp << "#include <fstream>" << "\n";
+  fp << "#include <vector>" << "\n";
+  fp << "\n";
+  fp << "template<class VerilatedModel>" << "\n";
+  fp << "class " << harness_class_name << " {" << "\n";
+  fp << "  public:" << "\n";
+  fp << "    explicit " << harness_class_name << "(VerilatedModel* dut) : dut_(dut) {}" << "\n";
+  fp << "\n";
+  fp << "    VerilatedModel* dut() { return dut_; }" << "\n";
+  fp << "\n";
+
+  /* Methods to drive each kind of global ports */
+  print_verilator_harness_global_port_method(fp, std::string("set_prog_clock"),
+                                             module_manager, top_module, circuit_lib, global_ports,
+                                             [&](const CircuitPortId& port) {
+                                               return (CIRCUIT_MODEL_PORT_CLOCK == circuit_lib.port_type(port))
+                                                   && (true == circuit_lib.port_is_prog(port));
+                                             });
+  print_verilator_harness_global_port_method(fp, std::string("set_op_clock"),
+                                             module_manager, top_module, circuit_lib, global_ports,
+                                             [&](const CircuitPortId& port) {
+                                               return (CIRCUIT_MODEL_PORT_CLOCK == circuit_lib.port_type(port))
+                                                   && (false == circuit_lib.port_is_prog(port));
+                                             });
+  print_verilator_harness_global_port_method(fp, std::string("set_config_done"),
+                                             module_manager, top_module, circuit_lib, global_ports,
+                                             [&](const CircuitPortId& port) {
+                                               return (CIRCUIT_MODEL_PORT_CLOCK != circuit_lib.port_type(port))
+                                                   && (true == circuit_lib.port_is_config_enable(port));
+                                             });
+  print_verilator_harness_global_port_method(fp, std::string("set_prog_reset"),
+                                             module_manager, top_module, circuit_lib, global_ports,
+                                             [&](const CircuitPortId& port) {
+                                               return (CIRCUIT_MODEL_PORT_CLOCK != circuit_lib.port_type(port))
+                                                   && (false == circuit_lib.port_is_config_enable(port))
+                                                   && (true == circuit_lib.port_is_prog(port));
+                                             });
+  print_verilator_harness_global_port_method(fp, std::string("set_op_reset"),
+                                             module_manager, top_module, circuit_lib, global_ports,
+                                             [&](const CircuitPortId& port) {
+                                               return (CIRCUIT_MODEL_PORT_CLOCK != circuit_lib.port_type(port))
+                                                   && (false == circuit_lib.port_is_config_enable(port))
+                                                   && (false == circuit_lib.port_is_prog(port));
+                                             });
+
+  /* Bitstream loader, following the layout in binary_fabric_bitstream.h */
+  fp << "    /* Load a binary fabric bitstream file to the configuration chain" << "\n";
+  fp << "     * Return 0 if succeed, 1 if the file is not a valid bitstream of this fabric" << "\n";
+  fp << "     */" << "\n";
+  fp << "    int load_bitstream(const char* fname) {" << "\n";
+  fp << "      std::ifstream fp(fname, std::ios::in | std::ios::binary);" << "\n";
+  fp << "      Header header;" << "\n";
+  fp << "      fp.read(reinterpret_cast<char*>(&header), sizeof(header));" << "\n";
+  fp << "      if ( (size_t(fp.gcount()) != sizeof(header))" << "\n";
+  fp << "        || (0 != std::memcmp(header.magic, \"";
+  fp << std::string(BINARY_FABRIC_BITSTREAM_MAGIC, sizeof(BINARY_FABRIC_BITSTREAM_MAGIC)) << "\", 8))" << "\n";
+  fp << "        || (" << BINARY_FABRIC_BITSTREAM_VERSION << " != header.version)" << "\n";
+  fp << "        || (" << size_t(CONFIG_MEM_SCAN_CHAIN) << " != header.config_protocol_type) ) {" << "\n";
+  fp << "        return 1;" << "\n";
+  fp << "      }" << "\n";
+  fp << "      std::vector<uint64_t> words((header.num_bits + 63) / 64);" << "\n";
+  fp << "      fp.read(reinterpret_cast<char*>(words.data()), words.size() * sizeof(uint64_t));" << "\n";
+  fp << "      if (size_t(fp.gcount()) != words.size() * sizeof(uint64_t)) {" << "\n";
+  fp << "        return 1;" << "\n";
+  fp << "      }" << "\n";
+  fp << "\n";
+  fp << "      /* Reset the configuration memories during the first programming clock cycle */" << "\n";
+  fp << "      set_op_clock(false);" << "\n";
+  fp << "      set_op_reset(false);" << "\n";
+  fp << "      set_config_done(false);" << "\n";
+  fp << "      set_prog_reset(true);" << "\n";
+  fp << "      prog_cycle();" << "\n";
+  fp << "      set_prog_reset(false);" << "\n";
+  fp << "\n";
+  fp << "      /* Shift the bits to the configuration chain, the first bit first */" << "\n";
+  fp << "      for (uint64_t ibit = 0; ibit < header.num_bits; ++ibit) {" << "\n";
+  fp << "        dut_->" << generate_configuration_chain_head_name() << " = (words[ibit / 64] >> (ibit % 64)) & 1;" << "\n";
+  fp << "        prog_cycle();" << "\n";
+  fp << "      }" << "\n";
+  fp << "\n";
+  fp << "      set_config_done(true);" << "\n";
+  fp << "      dut_->eval();" << "\n";
+  fp << "      return 0;" << "\n";
+  fp << "    }" << "\n";
+  fp << "\n";
+  fp << "    /* Run an operating clock cycle */" << "\n";
+  fp << "    void tick() {" << "\n";
+  fp << "      set_op_clock(true);" << "\n";
+  fp << "      dut_->eval();" << "\n";
+  fp << "      set_op_clock(false);" << "\n";
+  fp << "      dut_->eval();" << "\n";
+  fp << "    }" << "\n";
+  fp << "\n";
+  fp << "  private:" << "\n";
+  fp << "    void prog_cycle() {" << "\n";
+  fp << "      dut_->eval();" << "\n";
+  fp << "      set_prog_clock(true);" << "\n";
+  fp << "      dut_->eval();" << "\n";
+  fp << "      set_prog_clock(false);" << "\n";
+  fp << "      dut_->eval();" << "\n";
+  fp << "    }" << "\n";
+  fp << "\n";
+  fp << "    /* Same as BinaryFabricBitstreamHeader of OpenFPGA */" << "\n";
+  fp << "    struct Header {" << "\n";
+  fp << "      char magic[8];" << "\n";
+  fp << "      uint32_t version;" << "\n";
+  fp << "      uint32_t config_protocol_type;" << "\n";
+  fp << "      uint64_t num_bits;" << "\n";
+  fp << "      uint32_t address_length;" << "\n";
+  fp << "      uint32_t wl_address_length;" << "\n";
+  fp << "      uint64_t checksum;" << "\n";
+  fp << "    };" << "\n";
+  fp << "\n";
+  fp << "    VerilatedModel* dut_;" << "\n";
+  fp << "};" << "\n";
+  fp << "\n";
+  fp << "#endif" << "\n";
+
+  /* Close the file stream */
+  fp.close();
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,24 @@
+#ifndef VERILATOR_HARNESS_H
+#define VERILATOR_HARNESS_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "circuit_library.h"
+#include "module_manager.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+void print_verilator_harness(const ModuleManager& module_manager,
+                             const CircuitLibrary& circuit_lib,
+                             const std::string& src_dir);
+
+} /* end namespace openfpga */
+
+#endif 
@@ -8,18 +8,22 @@
 #include "vtr_time.h"
 
 #include "circuit_library_utils.h"
+#include "device_shard_utils.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_naming.h"
 
 #include "device_rr_gsb.h"
 #include "verilog_constants.h"
 #include "verilog_auxiliary_netlists.h"
 #include "verilog_submodule.h"
+#include "verilog_submodule_utils.h"
 #include "verilog_routing.h"
 #include "verilog_grid.h"
 #include "verilog_top_module.h"
+#include "verilator_harness.h"
 
 #include "verilog_preconfig_top_module.h"
 #include "verilog_formal_random_top_testbench.h"
@@ -98,14 +102,35 @@ namespace openfpga
                             submodule_dir_path,
                             options);
 
-    /* Generate routing blocks */
+    /* The delays of the specify blocks are written once for each circuit model in an SDF file */
+    if (true == options.sdf_timing())
+    {
+      VTR_ASSERT(true == options.include_timing());
+      print_verilog_submodule_timing_sdf(circuit_lib,
+                                         src_dir_path + std::string(TIMING_SDF_FILE_NAME),
+                                         options.incremental());
+    }
+
+    /* Generate routing blocks
+     * A shard only writes the routing blocks in its window,
+     * but registers all of them, so that the fabric netlists are the same for all the shards
+     */
+    vtr::Rect<size_t> shard_region = find_device_full_shard_region(device_ctx.grid);
+    if (true == options.sharded())
+    {
+      shard_region = options.shard_region();
+    }
     if (true == options.compress_routing())
     {
       print_verilog_unique_routing_modules(netlist_manager,
                                            const_cast<const ModuleManager &>(module_manager),
                                            device_rr_gsb,
                                            rr_dir_path,
-                                           options.explicit_port_mapping());
+                                           options.explicit_port_mapping(),
+                                           options.packed_ports(),
+                                           options.incremental(),
+                                           shard_region,
+                                           options.num_jobs());
     }
     else
     {
@@ -114,7 +139,11 @@ namespace openfpga
                                             const_cast<const ModuleManager &>(module_manager),
                                             device_rr_gsb,
                                             rr_dir_path,
-                                            options.explicit_port_mapping());
+                                            options.explicit_port_mapping(),
+                                            options.packed_ports(),
+                                            options.incremental(),
+                                            shard_region,
+                                            options.num_jobs());
     }
 
     /* Generate grids */
@@ -123,18 +152,32 @@ namespace openfpga
                         device_ctx, device_annotation,
                         lb_dir_path,
                         options.explicit_port_mapping(),
+                        options.packed_ports(),
+                        options.incremental(),
                         options.verbose_output());
 
     /* Generate FPGA fabric */
     print_verilog_top_module(netlist_manager,
                              const_cast<const ModuleManager &>(module_manager),
                              src_dir_path,
-                             options.explicit_port_mapping());
+                             options.explicit_port_mapping(),
+                             options.compact_top_module(),
+                             options.packed_ports(),
+                             options.incremental());
+
+    /* Generate a C++ harness for the Verilator model of FPGA fabric */
+    if (true == options.verilator_target())
+    {
+      print_verilator_harness(const_cast<const ModuleManager &>(module_manager),
+                              circuit_lib,
+                              src_dir_path);
+    }
 
     /* Generate an netlist including all the fabric-related netlists */
     print_fabric_include_netlist(const_cast<const NetlistManager &>(netlist_manager),
                                  src_dir_path,
-                                 circuit_lib);
+                                 circuit_lib,
+                                 options.incremental());
 
     /* Given a brief stats on how many Verilog modules have been written to files */
     VTR_LOGV(options.verbose_output(),
@@ -156,6 +199,9 @@ namespace openfpga
                               const FabricBitstream &fabric_bitstream,
                               const AtomContext &atom_ctx,
                               const PlacementContext &place_ctx,
+                              const DeviceGrid &grids,
+                              const DeviceRRGSB &device_rr_gsb,
+                              const VprRoutingAnnotation &routing_annotation,
                               const IoLocationMap &io_location_map,
                               const VprNetlistAnnotation &netlist_annotation,
                               const CircuitLibrary &circuit_lib,
@@ -192,18 +238,28 @@ namespace openfpga
                                          netlist_annotation,
                                          netlist_name,
                                          formal_verification_top_netlist_file_path,
-                                         options.explicit_port_mapping());
+                                         options.explicit_port_mapping(),
+                                         options.defparam_bitstream(),
+                                         options.prune_formal_verification_top_netlist(),
+                                         options.packed_ports(),
+                                         grids, device_rr_gsb, routing_annotation);
     }
 
     if (true == options.print_preconfig_top_testbench())
     {
       /* Generate top-level testbench using random vectors */
       std::string random_top_testbench_file_path = src_dir_path + netlist_name + std::string(RANDOM_TOP_TESTBENCH_VERILOG_FILE_POSTFIX);
+      /* The stimuli memory file is only used when enabled */
+      std::string stimuli_memory_file_path;
+      if (true == options.batch_check()) {
+        stimuli_memory_file_path = src_dir_path + netlist_name + std::string(RANDOM_TOP_TESTBENCH_STIMULI_MEMORY_FILE_POSTFIX);
+      }
       print_verilog_random_top_testbench(netlist_name,
                                          random_top_testbench_file_path,
                                          atom_ctx,
                                          netlist_annotation,
                                          simulation_setting,
+                                         stimuli_memory_file_path,
                                          options.explicit_port_mapping());
     }
 
@@ -211,6 +267,11 @@ namespace openfpga
     if (true == options.print_top_testbench())
     {
       std::string top_testbench_file_path = src_dir_path + netlist_name + std::string(AUTOCHECK_TOP_TESTBENCH_VERILOG_FILE_POSTFIX);
+      /* The bitstream memory file is only used when enabled */
+      std::string bitstream_memory_file_path;
+      if (true == options.readmem_bitstream()) {
+        bitstream_memory_file_path = src_dir_path + netlist_name + std::string(AUTOCHECK_TOP_TESTBENCH_BITSTREAM_MEMORY_FILE_POSTFIX);
+      }
       print_verilog_top_testbench(module_manager,
                                   bitstream_manager, fabric_bitstream,
                                   config_protocol_type,
@@ -221,9 +282,38 @@ namespace openfpga
                                   top_testbench_file_path,
                                   simulation_setting,
                                   options.fast_configuration(),
+                                  options.compress_bitstream(),
+                                  bitstream_memory_file_path,
                                   options.explicit_port_mapping());
     }
 
+    /* Generate a testbench for the FPGA fabric, which is independent from the benchmark,
+     * and the files of the benchmark which are given to the testbench at runtime
+     */
+    if (true == options.print_fabric_testbench())
+    {
+      if (CONFIG_MEM_STANDALONE == config_protocol_type) {
+        VTR_LOG_WARN("Fabric testbench is not applicable to standalone memory organization and is ignored!\n");
+      } else {
+        std::string fabric_testbench_file_path = src_dir_path + generate_fpga_top_module_name() + std::string(FABRIC_TESTBENCH_VERILOG_FILE_POSTFIX);
+        print_verilog_fabric_testbench(module_manager,
+                                       config_protocol_type,
+                                       circuit_lib, global_ports,
+                                       fabric_testbench_file_path,
+                                       simulation_setting,
+                                       options.explicit_port_mapping());
+        print_verilog_fabric_testbench_data(module_manager,
+                                            bitstream_manager, fabric_bitstream,
+                                            config_protocol_type,
+                                            atom_ctx, place_ctx, io_location_map,
+                                            netlist_annotation,
+                                            netlist_name,
+                                            src_dir_path,
+                                            simulation_setting,
+                                            options.explicit_port_mapping());
+      }
+    }
+
     /* Generate exchangeable files which contains simulation settings */
     if (true == options.print_simulation_ini())
     {
@@ -20,6 +20,7 @@
 #include "simulation_setting.h"
 #include "io_location_map.h"
 #include "vpr_netlist_annotation.h"
+#include "vpr_routing_annotation.h"
 #include "fabric_verilog_options.h"
 #include "verilog_testbench_options.h"
 
@@ -45,6 +46,9 @@ void fpga_verilog_testbench(const ModuleManager& module_manager,
                             const FabricBitstream& fabric_bitstream, 
                             const AtomContext& atom_ctx, 
                             const PlacementContext& place_ctx, 
+                            const DeviceGrid& grids,
+                            const DeviceRRGSB& device_rr_gsb,
+                            const VprRoutingAnnotation& routing_annotation,
                             const IoLocationMap& io_location_map,
                             const VprNetlistAnnotation& netlist_annotation, 
                             const CircuitLibrary& circuit_lib,
@@ -32,11 +32,12 @@ namespace openfpga {
  *******************************************************************/
 void print_fabric_include_netlist(const NetlistManager& netlist_manager,
                                   const std::string& src_dir,
-                                  const CircuitLibrary& circuit_lib) {
+                                  const CircuitLibrary& circuit_lib,
+                                  const bool& incremental) {
   std::string verilog_fname = src_dir + std::string(FABRIC_INCLUDE_NETLIST_FILE_NAME);
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(incremental, std::string(VERILOG_FILE_HEADER_TIME_STAMP_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   /* Validate the file stream */
@@ -48,7 +49,7 @@ void print_fabric_include_netlist(const NetlistManager& netlist_manager,
   /* Print preprocessing flags */
   print_verilog_comment(fp, std::string("------ Include defines: preproc flags -----"));
   print_verilog_include_netlist(fp, std::string(src_dir + std::string(DEFINES_VERILOG_FILE_NAME)));
-  fp << std::endl;
+  fp << "\n";
 
   /* Include all the user-defined netlists */
   print_verilog_comment(fp, std::string("------ Include user-defined netlists -----"));
@@ -61,28 +62,28 @@ void print_fabric_include_netlist(const NetlistManager& netlist_manager,
   for (const NetlistId& nlist_id : netlist_manager.netlists_by_type(NetlistManager::SUBMODULE_NETLIST)) {
     print_verilog_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
   }
-  fp << std::endl;
+  fp << "\n";
 
   /* Include all the CLB, heterogeneous block modules */
   print_verilog_comment(fp, std::string("------ Include logic block netlists -----"));
   for (const NetlistId& nlist_id : netlist_manager.netlists_by_type(NetlistManager::LOGIC_BLOCK_NETLIST)) {
     print_verilog_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
   }
-  fp << std::endl;
+  fp << "\n";
 
   /* Include all the routing architecture modules */
   print_verilog_comment(fp, std::string("------ Include routing module netlists -----"));
   for (const NetlistId& nlist_id : netlist_manager.netlists_by_type(NetlistManager::ROUTING_MODULE_NETLIST)) {
     print_verilog_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
   }
-  fp << std::endl;
+  fp << "\n";
 
   /* Include FPGA top module */
   print_verilog_comment(fp, std::string("------ Include fabric top-level netlists -----"));
   for (const NetlistId& nlist_id : netlist_manager.netlists_by_type(NetlistManager::TOP_MODULE_NETLIST)) {
     print_verilog_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
   }
-  fp << std::endl;
+  fp << "\n";
 
   /* Close the file stream */
   fp.close();
@@ -100,7 +101,7 @@ void print_include_netlists(const std::string& src_dir,
   std::string verilog_fname = src_dir + circuit_name + std::string(TOP_INCLUDE_NETLIST_FILE_NAME_POSTFIX);
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   /* Validate the file stream */
@@ -112,19 +113,19 @@ void print_include_netlists(const std::string& src_dir,
   /* Print preprocessing flags */
   print_verilog_comment(fp, std::string("------ Include simulation defines -----"));
   print_verilog_include_netlist(fp, src_dir + std::string(DEFINES_VERILOG_SIMULATION_FILE_NAME));
-  fp << std::endl;
+  fp << "\n";
 
   /* Include FPGA top module */
   print_verilog_comment(fp, std::string("------ Include fabric top-level netlists -----"));
   print_verilog_include_netlist(fp, src_dir + std::string(FABRIC_INCLUDE_NETLIST_FILE_NAME));
-  fp << std::endl;
+  fp << "\n";
 
   /* Include reference benchmark netlist only when auto-check flag is enabled */
   print_verilog_preprocessing_flag(fp, std::string(AUTOCHECKED_SIMULATION_FLAG));
   fp << "\t";
   print_verilog_include_netlist(fp, std::string(reference_benchmark_file));
   print_verilog_endif(fp);
-  fp << std::endl;
+  fp << "\n";
 
   /* Include formal verification netlists only when formal verification flag is enable */
   print_verilog_preprocessing_flag(fp, std::string(VERILOG_FORMAL_VERIFICATION_PREPROC_FLAG));
@@ -140,14 +141,14 @@ void print_include_netlists(const std::string& src_dir,
   print_verilog_endif(fp);
   
   print_verilog_endif(fp);
-  fp << std::endl;
+  fp << "\n";
 
   /* Include top-level testbench only when auto-check flag is enabled */
   print_verilog_preprocessing_flag(fp, std::string(AUTOCHECKED_SIMULATION_FLAG));
   fp << "\t";
   print_verilog_include_netlist(fp, src_dir + circuit_name + std::string(AUTOCHECK_TOP_TESTBENCH_VERILOG_FILE_POSTFIX));
   print_verilog_endif(fp);
-  fp << std::endl;
+  fp << "\n";
 
   /* Close the file stream */
   fp.close();
@@ -163,7 +164,7 @@ void print_verilog_preprocessing_flags_netlist(const std::string& src_dir,
   std::string verilog_fname = src_dir + std::string(DEFINES_VERILOG_FILE_NAME);
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(fabric_verilog_opts.incremental(), std::string(VERILOG_FILE_HEADER_TIME_STAMP_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   /* Validate the file stream */
@@ -175,19 +176,19 @@ void print_verilog_preprocessing_flags_netlist(const std::string& src_dir,
   /* To enable timing */
   if (true == fabric_verilog_opts.include_timing()) {
     print_verilog_define_flag(fp, std::string(VERILOG_TIMING_PREPROC_FLAG), 1);
-    fp << std::endl;
+    fp << "\n";
   } 
 
   /* To enable timing */
   if (true == fabric_verilog_opts.include_signal_init()) {
     print_verilog_define_flag(fp, std::string(VERILOG_SIGNAL_INIT_PREPROC_FLAG), 1);
-    fp << std::endl;
+    fp << "\n";
   } 
 
   /* To enable functional verfication with Icarus */
   if (true == fabric_verilog_opts.support_icarus_simulator()) {
     print_verilog_define_flag(fp, std::string(ICARUS_SIMULATOR_FLAG), 1);
-    fp << std::endl;
+    fp << "\n";
   } 
 
   /* Close the file stream */
@@ -203,7 +204,7 @@ void print_verilog_simulation_preprocessing_flags(const std::string& src_dir,
   std::string verilog_fname = src_dir + std::string(DEFINES_VERILOG_SIMULATION_FILE_NAME);
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   /* Validate the file stream */
@@ -215,26 +216,33 @@ void print_verilog_simulation_preprocessing_flags(const std::string& src_dir,
   /* To enable manualy checked simulation */
   if (true == verilog_testbench_opts.print_top_testbench()) {
     print_verilog_define_flag(fp, std::string(INITIAL_SIMULATION_FLAG), 1);
-    fp << std::endl;
+    fp << "\n";
   } 
 
   /* To enable auto-checked simulation */
   if ( (true == verilog_testbench_opts.print_preconfig_top_testbench())
     || (true == verilog_testbench_opts.print_top_testbench()) ) {
     print_verilog_define_flag(fp, std::string(AUTOCHECKED_SIMULATION_FLAG), 1);
-    fp << std::endl;
+    fp << "\n";
   } 
 
   /* To enable pre-configured FPGA simulation */
   if (true == verilog_testbench_opts.print_formal_verification_top_netlist()) {
     print_verilog_define_flag(fp, std::string(VERILOG_FORMAL_VERIFICATION_PREPROC_FLAG), 1);
-    fp << std::endl;
+    fp << "\n";
   } 
 
   /* To enable pre-configured FPGA simulation */
   if (true == verilog_testbench_opts.print_preconfig_top_testbench()) {
     print_verilog_define_flag(fp, std::string(FORMAL_SIMULATION_FLAG), 1);
-    fp << std::endl;
+    fp << "\n";
+  } 
+
+  /* To replace configuration memories by constants, which are set by the pre-configured FPGA fabric */
+  if ( (true == verilog_testbench_opts.print_formal_verification_top_netlist())
+    && (true == verilog_testbench_opts.defparam_bitstream()) ) {
+    print_verilog_define_flag(fp, std::string(PRECONFIG_MEMORY_PARAMETER_FLAG), 1);
+    fp << "\n";
   } 
 
   /* Close the file stream */
@@ -19,7 +19,8 @@ namespace openfpga {
 
 void print_fabric_include_netlist(const NetlistManager& netlist_manager,
                                   const std::string& src_dir,
-                                  const CircuitLibrary& circuit_lib);
+                                  const CircuitLibrary& circuit_lib,
+                                  const bool& incremental);
 
 void print_include_netlists(const std::string& src_dir,
                             const std::string& circuit_name,
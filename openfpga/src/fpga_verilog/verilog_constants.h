@@ -4,6 +4,7 @@
 /* global parameters for dumping synthesizable verilog */
 
 constexpr char* VERILOG_NETLIST_FILE_POSTFIX = ".v";
+constexpr char* VERILOG_FILE_HEADER_TIME_STAMP_PREFIX = "//\tDate: "; // the line of time stamp in the header of Verilog netlists, which is not compared by incremental writing
 constexpr float VERILOG_SIM_TIMESCALE = 1e-9; // Verilog Simulation time scale (minimum time unit) : 1ns
 
 constexpr char* VERILOG_TIMING_PREPROC_FLAG = "ENABLE_TIMING"; // the flag to enable timing definition during compilation
@@ -12,6 +13,8 @@ constexpr char* VERILOG_FORMAL_VERIFICATION_PREPROC_FLAG = "ENABLE_FORMAL_VERIFI
 constexpr char* INITIAL_SIMULATION_FLAG = "INITIAL_SIMULATION"; // the flag to enable initial functional verification
 constexpr char* AUTOCHECKED_SIMULATION_FLAG = "AUTOCHECKED_SIMULATION"; // the flag to enable autochecked functional verification
 constexpr char* FORMAL_SIMULATION_FLAG = "FORMAL_SIMULATION"; // the flag to enable formal functional verification
+constexpr char* PRECONFIG_MEMORY_PARAMETER_FLAG = "PRECONFIGURED_MEMORY_PARAMETERS"; // the flag to replace configuration memories with constants given by parameters
+constexpr char* PRECONFIG_MEMORY_PARAMETER_NAME = "PRECONFIG_BITS"; // the parameter of configuration memories to be set by defparam in pre-configured FPGA fabric
 
 constexpr char* MODELSIM_SIMULATION_TIME_UNIT = "ms";
 
@@ -26,7 +29,18 @@ constexpr char* FORMAL_VERIFICATION_VERILOG_FILE_POSTFIX = "_top_formal_verifica
 constexpr char* TOP_TESTBENCH_VERILOG_FILE_POSTFIX = "_top_tb.v"; /* !!! must be consist with the modelsim_testbench_module_postfix */ 
 constexpr char* AUTOCHECK_TOP_TESTBENCH_VERILOG_FILE_POSTFIX = "_autocheck_top_tb.v"; /* !!! must be consist with the modelsim_autocheck_testbench_module_postfix */ 
 constexpr char* RANDOM_TOP_TESTBENCH_VERILOG_FILE_POSTFIX = "_formal_random_top_tb.v"; 
+constexpr char* RANDOM_TOP_TESTBENCH_STIMULI_MEMORY_FILE_POSTFIX = "_formal_random_top_tb_stimuli.mem"; /* input vectors loaded by $readmemh in the random testbench */ 
+constexpr char* AUTOCHECK_TOP_TESTBENCH_BITSTREAM_MEMORY_FILE_POSTFIX = "_autocheck_top_tb_bitstream.mem"; /* bitstream loaded by $readmemb/$readmemh in the autocheck testbench */ 
+constexpr char* FABRIC_TESTBENCH_VERILOG_FILE_POSTFIX = "_fabric_tb.v"; /* testbench of the FPGA fabric, which loads the bitstream and vectors given at runtime */ 
+constexpr char* FABRIC_TESTBENCH_REFERENCE_VERILOG_FILE_POSTFIX = "_fabric_tb_reference.v"; /* testbench of a benchmark which writes the reference vectors of the fabric testbench */ 
+constexpr char* FABRIC_TESTBENCH_BITSTREAM_FILE_POSTFIX = "_fabric_tb_bitstream.mem"; 
+constexpr char* FABRIC_TESTBENCH_IO_MAP_FILE_POSTFIX = "_fabric_tb_io_map.mem"; 
+constexpr char* FABRIC_TESTBENCH_STIMULI_FILE_POSTFIX = "_fabric_tb_stimuli.mem"; 
+constexpr char* FABRIC_TESTBENCH_REFERENCE_FILE_POSTFIX = "_fabric_tb_reference.mem"; 
+constexpr char* FABRIC_TESTBENCH_PLUSARGS_FILE_POSTFIX = "_fabric_tb_plusargs.f"; /* runtime arguments of the fabric testbench for a benchmark */ 
 constexpr char* DEFINES_VERILOG_FILE_NAME = "fpga_defines.v";
+constexpr char* TIMING_SDF_FILE_NAME = "fpga_timing.sdf"; /* pin-to-pin delays of the circuit models, when not in the specify blocks */
+constexpr char* VERILATOR_HARNESS_FILE_POSTFIX = "_verilator_harness.h"; /* C++ harness for the Verilator model of the fabric */
 constexpr char* DEFINES_VERILOG_SIMULATION_FILE_NAME = "define_simulation.v";
 constexpr char* SUBMODULE_VERILOG_FILE_NAME = "sub_module.v";
 constexpr char* LOGIC_BLOCK_VERILOG_FILE_NAME = "logic_blocks.v";
@@ -51,6 +65,7 @@ constexpr char* GRID_VERILOG_FILE_NAME_PREFIX = "grid_";
 constexpr char* FORMAL_VERIFICATION_TOP_MODULE_POSTFIX = "_top_formal_verification";
 constexpr char* FORMAL_VERIFICATION_TOP_MODULE_PORT_POSTFIX = "_fm";
 constexpr char* FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME = "U0_formal_verification";
+constexpr char* FORMAL_VERIFICATION_PRUNED_FABRIC_MODULE_POSTFIX = "_pruned_fpga_top";
 
 constexpr char* FORMAL_RANDOM_TOP_TESTBENCH_POSTFIX = "_top_formal_verification_random_tb";
 
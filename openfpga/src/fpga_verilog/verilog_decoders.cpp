@@ -111,19 +111,19 @@ void print_verilog_mux_local_decoder_module(std::fstream& fp,
    * The rest of addr codes 3'b110, 3'b111 will be decoded to data=8'b0_0000;
    */
 
-  fp << "\t" << "always@(" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")" << std::endl;
-  fp << "\t" << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")" << std::endl;
+  fp << "\t" << "always@(" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")" << "\n";
+  fp << "\t" << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")" << "\n";
   /* Create a string for addr and data */
   for (size_t i = 0; i < data_size; ++i) {
     fp << "\t\t" << generate_verilog_constant_values(itobin_vec(i, addr_size)); 
     fp << " : ";
     fp << generate_verilog_port_constant_values(data_port, ito1hot_vec(i, data_size)); 
-    fp << ";" << std::endl;
+    fp << ";" << "\n";
   }
   fp << "\t\t" << "default : ";
   fp << generate_verilog_port_constant_values(data_port, ito1hot_vec(data_size - 1, data_size)); 
-  fp << ";" << std::endl;
-  fp << "\t" << "endcase" << std::endl;
+  fp << ";" << "\n";
+  fp << "\t" << "endcase" << "\n";
 
   print_verilog_wire_connection(fp, data_inv_port, data_port, true);
   
@@ -164,11 +164,12 @@ void print_verilog_submodule_mux_local_decoders(const ModuleManager& module_mana
                                                 NetlistManager& netlist_manager,
                                                 const MuxLibrary& mux_lib,
                                                 const CircuitLibrary& circuit_lib,
-                                                const std::string& submodule_dir) {
+                                                const std::string& submodule_dir,
+                                                const bool& incremental) {
   std::string verilog_fname(submodule_dir + std::string(LOCAL_ENCODER_VERILOG_FILE_NAME));
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(incremental, std::string(VERILOG_FILE_HEADER_TIME_STAMP_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
@@ -226,6 +227,91 @@ void print_verilog_submodule_mux_local_decoders(const ModuleManager& module_mana
   VTR_LOG("Done\n");
 }
 
+/***************************************************************************************
+ * Print the internal logic of a decoder which is built in two levels:
+ *  - Each group of address bits is predecoded into one-hot lines,
+ *    where the enable signal is merged into the lines of the first group
+ *  - Each data output is the AND of one line from each group
+ *
+ *   Address: [group 0][group 1] ...
+ *               |        |
+ *               v        v
+ *          +---------+---------+
+ *  Enable->|Predecode|Predecode| ...
+ *          +---------+---------+
+ *               |        |
+ *               v        v
+ *          +-------------------+
+ *          |    AND  plane     |
+ *          +-------------------+
+ *               | | | ... |
+ *                Data output
+ *
+ * The function is the same as a single-level decoder: data[i] is '1' only when 
+ * the address is i, while a 2^N-to-1 AND plane is replaced by much smaller gates
+ ***************************************************************************************/
+static 
+void print_verilog_arch_predecoded_decoder_logic(std::fstream& fp, 
+                                                 const BasicPort& enable_port,
+                                                 const BasicPort& addr_port,
+                                                 const BasicPort& data_port,
+                                                 const std::vector<size_t>& predecode_groups) {
+  std::vector<size_t> addr_pins = addr_port.pins();
+  std::vector<size_t> data_pins = data_port.pins();
+
+  std::vector<BasicPort> predecode_ports;
+  size_t group_lsb = 0;
+  for (size_t igroup = 0; igroup < predecode_groups.size(); ++igroup) {
+    size_t group_size = predecode_groups[igroup];
+    BasicPort predecode_port(std::string("predecode_") + std::to_string(igroup), size_t(1) << group_size);
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, predecode_port) << ";" << "\n";
+
+    for (size_t line = 0; line < predecode_port.get_width(); ++line) {
+      fp << "assign " << predecode_port.get_name() << "[" << predecode_port.pins()[line] << "] = ";
+      if (0 == igroup) {
+        fp << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " & ";
+      }
+      for (size_t ibit = 0; ibit < group_size; ++ibit) {
+        if (0 < ibit) {
+          fp << " & ";
+        }
+        if (0 == ((line >> ibit) & 1)) {
+          fp << "~";
+        }
+        fp << addr_port.get_name() << "[" << addr_pins[group_lsb + ibit] << "]";
+      }
+      fp << ";" << "\n";
+    }
+
+    predecode_ports.push_back(predecode_port);
+    group_lsb += group_size;
+  }
+  VTR_ASSERT(group_lsb == addr_pins.size());
+
+  fp << "always@(";
+  for (size_t igroup = 0; igroup < predecode_ports.size(); ++igroup) {
+    if (0 < igroup) {
+      fp << " or ";
+    }
+    fp << generate_verilog_port(VERILOG_PORT_CONKT, predecode_ports[igroup]);
+  }
+  fp << ") begin" << "\n";
+  for (size_t idata = 0; idata < data_pins.size(); ++idata) {
+    fp << "\t" << data_port.get_name() << "[" << data_pins[idata] << "] = ";
+    group_lsb = 0;
+    for (size_t igroup = 0; igroup < predecode_ports.size(); ++igroup) {
+      if (0 < igroup) {
+        fp << " & ";
+      }
+      size_t line = (idata >> group_lsb) & ((size_t(1) << predecode_groups[igroup]) - 1);
+      fp << predecode_ports[igroup].get_name() << "[" << predecode_ports[igroup].pins()[line] << "]";
+      group_lsb += predecode_groups[igroup];
+    }
+    fp << ";" << "\n";
+  }
+  fp << "end" << "\n";
+}
+
 /***************************************************************************************
  * Create a Verilog module for a decoder used as a configuration protocol 
  * in FPGA architecture
@@ -248,6 +334,9 @@ void print_verilog_submodule_mux_local_decoders(const ModuleManager& module_mana
  *  The decoder has an enable signal which is active at logic '1'. 
  *  When activated, the decoder will output decoding results to the data output port
  *  Otherwise, the data output port will be always all-zero
+ *
+ *  When the decoder has more than one predecode group, the logic is built in two levels,
+ *  see print_verilog_arch_predecoded_decoder_logic()
  ***************************************************************************************/
 static 
 void print_verilog_arch_decoder_module(std::fstream& fp, 
@@ -301,13 +390,13 @@ void print_verilog_arch_decoder_module(std::fstream& fp,
   if (1 == data_size) {
     fp << "always@(" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port);
     fp << " or " << generate_verilog_port(VERILOG_PORT_CONKT, enable_port);
-    fp << ") begin" << std::endl;
-    fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " == 1'b1) begin" << std::endl;
-    fp << "\t\t" << generate_verilog_port_constant_values(data_port, std::vector<size_t>(1, 1)) << ";" << std::endl; 
-    fp << "\t" << "end else begin" << std::endl;
-    fp << "\t\t" << generate_verilog_port_constant_values(data_port, std::vector<size_t>(1, 0)) << ";" << std::endl; 
-    fp << "\t" << "end" << std::endl;
-    fp << "end" << std::endl;
+    fp << ") begin" << "\n";
+    fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " == 1'b1) begin" << "\n";
+    fp << "\t\t" << generate_verilog_port_constant_values(data_port, std::vector<size_t>(1, 1)) << ";" << "\n"; 
+    fp << "\t" << "end else begin" << "\n";
+    fp << "\t\t" << generate_verilog_port_constant_values(data_port, std::vector<size_t>(1, 0)) << ";" << "\n"; 
+    fp << "\t" << "end" << "\n";
+    fp << "end" << "\n";
 
     /* Depend on if the inverted data output port is needed or not */
     if (true == decoder_lib.use_data_inv_port(decoder)) {
@@ -337,35 +426,49 @@ void print_verilog_arch_decoder_module(std::fstream& fp,
    * data=8'b1_0000 will be encoded to addr=3'b110;
    * The rest of addr codes 3'b110, 3'b111 will be decoded to data=8'b0_0000;
    */
+  std::vector<size_t> predecode_groups = decoder_lib.predecode_groups(decoder);
+  if (1 < predecode_groups.size()) {
+    print_verilog_arch_predecoded_decoder_logic(fp, enable_port, addr_port, data_port, predecode_groups);
+
+    if (true == decoder_lib.use_data_inv_port(decoder)) {
+      print_verilog_wire_connection(fp, data_inv_port, data_port, true);
+    }
+
+    print_verilog_comment(fp, std::string("----- END Verilog codes for Decoder convert " + std::to_string(addr_size) + "-bit addr to " + std::to_string(data_size) + "-bit data -----"));
+
+    /* Put an end to the Verilog module */
+    print_verilog_module_end(fp, module_name);
+    return;
+  }
 
   fp << "always@(" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port);
   fp << " or " << generate_verilog_port(VERILOG_PORT_CONKT, enable_port);
-  fp << ") begin" << std::endl;
-  fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " == 1'b1) begin" << std::endl;
-  fp << "\t\t" << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")" << std::endl;
+  fp << ") begin" << "\n";
+  fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " == 1'b1) begin" << "\n";
+  fp << "\t\t" << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")" << "\n";
   /* Create a string for addr and data */
   for (size_t i = 0; i < data_size; ++i) {
     fp << "\t\t\t" << generate_verilog_constant_values(itobin_vec(i, addr_size)); 
     fp << " : ";
     fp << generate_verilog_port_constant_values(data_port, ito1hot_vec(i, data_size)); 
-    fp << ";" << std::endl;
+    fp << ";" << "\n";
   }
   /* Different from MUX decoder, we assign default values which is all zero */
   fp << "\t\t\t" << "default"; 
   fp << " : ";
   fp << generate_verilog_port_constant_values(data_port, ito1hot_vec(data_size, data_size)); 
-  fp << ";" << std::endl;
+  fp << ";" << "\n";
 
-  fp << "\t\t" << "endcase" << std::endl;
-  fp << "\t" << "end" << std::endl;
+  fp << "\t\t" << "endcase" << "\n";
+  fp << "\t" << "end" << "\n";
 
   /* If enable is not active, we should give all zero */
-  fp << "\t" << "else begin" << std::endl;
+  fp << "\t" << "else begin" << "\n";
   fp << "\t\t" << generate_verilog_port_constant_values(data_port, ito1hot_vec(data_size, data_size)); 
-  fp << ";" << std::endl;
-  fp << "\t" << "end" << std::endl;
+  fp << ";" << "\n";
+  fp << "\t" << "end" << "\n";
   
-  fp << "end" << std::endl;
+  fp << "end" << "\n";
 
   if (true == decoder_lib.use_data_inv_port(decoder)) {
     print_verilog_wire_connection(fp, data_inv_port, data_port, true);
@@ -455,13 +558,13 @@ void print_verilog_arch_decoder_with_data_in_module(std::fstream& fp,
   if (1 == data_size) {
     fp << "always@(" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port);
     fp << " or " << generate_verilog_port(VERILOG_PORT_CONKT, enable_port);
-    fp << ") begin" << std::endl;
-    fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " == 1'b1) begin" << std::endl;
-    fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, din_port) << ";" << std::endl; 
-    fp << "\t" << "end else begin" << std::endl;
-    fp << "\t\t" << generate_verilog_port_constant_values(data_port, std::vector<size_t>(1, 0)) << ";" << std::endl; 
-    fp << "\t" << "end" << std::endl;
-    fp << "end" << std::endl;
+    fp << ") begin" << "\n";
+    fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " == 1'b1) begin" << "\n";
+    fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, din_port) << ";" << "\n"; 
+    fp << "\t" << "end else begin" << "\n";
+    fp << "\t\t" << generate_verilog_port_constant_values(data_port, std::vector<size_t>(1, 0)) << ";" << "\n"; 
+    fp << "\t" << "end" << "\n";
+    fp << "end" << "\n";
 
     /* Depend on if the inverted data output port is needed or not */
     if (true == decoder_lib.use_data_inv_port(decoder)) {
@@ -481,15 +584,15 @@ void print_verilog_arch_decoder_with_data_in_module(std::fstream& fp,
   fp << "always@(" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port);
   fp << ", " << generate_verilog_port(VERILOG_PORT_CONKT, enable_port);
   fp << ", " << generate_verilog_port(VERILOG_PORT_CONKT, din_port);
-  fp << ") begin" << std::endl;
+  fp << ") begin" << "\n";
 
-  fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " == 1'b1) begin" << std::endl;
+  fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " == 1'b1) begin" << "\n";
   fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, data_port); 
   fp << " = ";
   std::string high_res_str = "{" + std::to_string(data_port.get_width()) + "{1'bz}}";
   fp << high_res_str;
-  fp << ";" << std::endl;
-  fp << "\t\t" << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")" << std::endl;
+  fp << ";" << "\n";
+  fp << "\t\t" << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")" << "\n";
   /* Create a string for addr and data */
   for (size_t i = 0; i < data_size; ++i) {
     BasicPort cur_data_port(data_port.get_name(), i, i);
@@ -498,7 +601,7 @@ void print_verilog_arch_decoder_with_data_in_module(std::fstream& fp,
     fp << generate_verilog_port(VERILOG_PORT_CONKT, cur_data_port); 
     fp << " = ";
     fp << generate_verilog_port(VERILOG_PORT_CONKT, din_port); 
-    fp << ";" << std::endl;
+    fp << ";" << "\n";
   }
   /* Different from MUX decoder, we assign default values which is all zero */
   fp << "\t\t\t" << "default"; 
@@ -506,20 +609,20 @@ void print_verilog_arch_decoder_with_data_in_module(std::fstream& fp,
   fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, data_port); 
   fp << " = ";
   fp << high_res_str;
-  fp << ";" << std::endl;
+  fp << ";" << "\n";
 
-  fp << "\t\t" << "endcase" << std::endl;
-  fp << "\t" << "end" << std::endl;
+  fp << "\t\t" << "endcase" << "\n";
+  fp << "\t" << "end" << "\n";
 
   /* If enable is not active, we should give all zero */
-  fp << "\t" << "else begin" << std::endl;
+  fp << "\t" << "else begin" << "\n";
   fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, data_port); 
   fp << " = ";
   fp << high_res_str;
-  fp << ";" << std::endl;
-  fp << "\t" << "end" << std::endl;
+  fp << ";" << "\n";
+  fp << "\t" << "end" << "\n";
   
-  fp << "end" << std::endl;
+  fp << "end" << "\n";
 
 
   if (true == decoder_lib.use_data_inv_port(decoder)) {
@@ -545,11 +648,12 @@ void print_verilog_arch_decoder_with_data_in_module(std::fstream& fp,
 void print_verilog_submodule_arch_decoders(const ModuleManager& module_manager,
                                            NetlistManager& netlist_manager,
                                            const DecoderLibrary& decoder_lib,
-                                           const std::string& submodule_dir) {
+                                           const std::string& submodule_dir,
+                                           const bool& incremental) {
   std::string verilog_fname(submodule_dir + std::string(ARCH_ENCODER_VERILOG_FILE_NAME));
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(incremental, std::string(VERILOG_FILE_HEADER_TIME_STAMP_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
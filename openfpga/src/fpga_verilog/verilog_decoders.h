@@ -26,12 +26,14 @@ void print_verilog_submodule_mux_local_decoders(const ModuleManager& module_mana
                                                 NetlistManager& netlist_manager,
                                                 const MuxLibrary& mux_lib,
                                                 const CircuitLibrary& circuit_lib,
-                                                const std::string& submodule_dir);
+                                                const std::string& submodule_dir,
+                                                const bool& incremental);
 
 void print_verilog_submodule_arch_decoders(const ModuleManager& module_manager,
                                            NetlistManager& netlist_manager,
                                            const DecoderLibrary& decoder_lib,
-                                           const std::string& submodule_dir);
+                                           const std::string& submodule_dir,
+                                           const bool& incremental);
 
 
 } /* end namespace openfpga */
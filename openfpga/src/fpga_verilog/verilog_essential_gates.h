@@ -19,7 +19,9 @@ namespace openfpga {
 void print_verilog_submodule_essentials(const ModuleManager& module_manager, 
                                         NetlistManager& netlist_manager,
                                         const std::string& submodule_dir,
-                                        const CircuitLibrary& circuit_lib);
+                                        const CircuitLibrary& circuit_lib,
+                                        const bool& sdf_timing,
+                                        const bool& incremental);
 
 } /* end namespace openfpga */
 
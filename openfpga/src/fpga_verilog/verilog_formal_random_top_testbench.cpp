@@ -7,6 +7,7 @@
 #include <cstring>
 #include <cmath>
 #include <iomanip>
+#include <random>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -39,6 +40,10 @@ constexpr char* BENCHMARK_INSTANCE_NAME = "REF_DUT";
 constexpr char* FPGA_INSTANCE_NAME = "FPGA_DUT";
 constexpr char* ERROR_COUNTER = "nb_error";
 constexpr char* FORMAL_TB_SIM_START_PORT_NAME = "sim_start";
+constexpr char* INPUT_VECTOR_MEMORY_NAME = "input_vectors";
+constexpr char* INPUT_VECTOR_MEMORY_INDEX_NAME = "input_vector_index";
+constexpr char* BENCHMARK_OUTPUT_VECTOR_NAME = "bench_outputs";
+constexpr char* FPGA_OUTPUT_VECTOR_NAME = "fpga_outputs";
 constexpr int MAGIC_NUMBER_FOR_SIMULATION_TIME = 200;
 
 /********************************************************************
@@ -60,17 +65,17 @@ void print_verilog_top_random_testbench_ports(std::fstream& fp,
   valid_file_stream(fp);
  
   /* Print the declaration for the module */
-  fp << "module " << circuit_name << FORMAL_RANDOM_TOP_TESTBENCH_POSTFIX << ";" << std::endl;
+  fp << "module " << circuit_name << FORMAL_RANDOM_TOP_TESTBENCH_POSTFIX << ";" << "\n";
 
   /* Create a clock port if the benchmark does not have one! 
    * The clock is used for counting and synchronizing input stimulus 
    */
   BasicPort clock_port = generate_verilog_testbench_clock_port(clock_port_names, std::string(DEFAULT_CLOCK_NAME));
   print_verilog_comment(fp, std::string("----- Default clock port is added here since benchmark does not contain one -------"));
-  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, clock_port) << ";" << std::endl;
+  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, clock_port) << ";" << "\n";
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   print_verilog_testbench_shared_ports(fp, atom_ctx, netlist_annotation,
                                        clock_port_names,
@@ -83,10 +88,10 @@ void print_verilog_top_random_testbench_ports(std::fstream& fp,
    * and determine if the simulation succeed or failed 
    */
   print_verilog_comment(fp, std::string("----- Error counter -------"));
-  fp << "\tinteger " << ERROR_COUNTER << "= 0;" << std::endl;
+  fp << "\tinteger " << ERROR_COUNTER << "= 0;" << "\n";
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -124,13 +129,13 @@ void print_verilog_top_random_testbench_benchmark_instance(std::fstream& fp,
   print_verilog_comment(fp, std::string("----- End reference Benchmark Instanication -------"));
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Condition ends for the benchmark instanciation */
   print_verilog_endif(fp);
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -160,7 +165,190 @@ void print_verilog_random_testbench_fpga_instance(std::fstream& fp,
   print_verilog_comment(fp, std::string("----- End FPGA Fabric Instanication -------"));
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
+}
+
+/********************************************************************
+ * Find the names of the input (except clocks) and output blocks of a benchmark,
+ * in the order of the atom blocks
+ *******************************************************************/
+static
+void find_random_top_testbench_io_names(const AtomContext& atom_ctx,
+                                        const VprNetlistAnnotation& netlist_annotation,
+                                        const std::vector<std::string>& clock_port_names,
+                                        std::vector<std::string>& input_names,
+                                        std::vector<std::string>& output_names) {
+  for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
+    /* Bypass non-I/O atom blocks ! */
+    if ( (AtomBlockType::INPAD != atom_ctx.nlist.block_type(atom_blk))
+      && (AtomBlockType::OUTPAD != atom_ctx.nlist.block_type(atom_blk)) ) {
+      continue;
+    }
+
+    /* The block may be renamed as it contains special characters which violate Verilog syntax */
+    std::string block_name = atom_ctx.nlist.block_name(atom_blk);
+    if (true == netlist_annotation.is_block_renamed(atom_blk)) {
+      block_name = netlist_annotation.block_name(atom_blk);
+    } 
+
+    if (AtomBlockType::OUTPAD == atom_ctx.nlist.block_type(atom_blk)) {
+      output_names.push_back(block_name);
+      continue;
+    }
+
+    /* Bypass clock ports */
+    if (clock_port_names.end() != std::find(clock_port_names.begin(), clock_port_names.end(), block_name)) {
+      continue;
+    }
+    input_names.push_back(block_name);
+  }
+}
+
+/********************************************************************
+ * Print the concatenation of a list of signals, e.g., {a_bench, b_bench}
+ *******************************************************************/
+static
+std::string generate_random_top_testbench_concatenation(const std::vector<std::string>& names,
+                                                        const std::string& postfix) {
+  std::string concatenation("{");
+  for (size_t iname = 0; iname < names.size(); ++iname) {
+    if (0 < iname) {
+      concatenation += std::string(", ");
+    }
+    concatenation += names[iname] + postfix;
+  }
+  concatenation += std::string("}");
+  return concatenation;
+}
+
+/********************************************************************
+ * Write random input vectors to a memory file, one vector per clock cycle,
+ * and print the stimulus which loads the file with $readmemh
+ * and applies a vector to all the inputs at each falling edge of the clock
+ *
+ * The vectors are generated with a fixed seed, so that
+ * the testbench is the same for each run
+ *******************************************************************/
+static
+void print_verilog_random_top_testbench_vector_stimuli(std::fstream& fp,
+                                                       const std::string& stimuli_memory_fname,
+                                                       const std::vector<std::string>& input_names,
+                                                       const size_t& num_vectors,
+                                                       const BasicPort& clock_port) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  /* Nothing to drive without inputs */
+  if ( (true == input_names.empty())
+    || (0 == num_vectors) ) {
+    return;
+  }
+
+  /* Each line is a vector in hexadecimal, whose last bit is the last input
+   * The unused leading bits of the first digit are always zero
+   */
+  size_t num_hex_digits = (input_names.size() + 3) / 4;
+  size_t first_digit_mask = (0 == input_names.size() % 4) ? 0xf : ((1 << (input_names.size() % 4)) - 1);
+  std::mt19937 random_generator(1);
+  BufferedFileStream mem_fp;
+  mem_fp.open(stimuli_memory_fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(stimuli_memory_fname.c_str(), mem_fp);
+  mem_fp << std::hex;
+  for (size_t ivec = 0; ivec < num_vectors; ++ivec) {
+    mem_fp << (random_generator() & first_digit_mask);
+    for (size_t idigit = 1; idigit < num_hex_digits; ++idigit) {
+      mem_fp << (random_generator() & 0xf);
+    }
+    mem_fp << "\n";
+  }
+  mem_fp.close();
+
+  std::string mem_name(INPUT_VECTOR_MEMORY_NAME);
+  std::string index_name(INPUT_VECTOR_MEMORY_INDEX_NAME);
+  std::string inputs = generate_random_top_testbench_concatenation(input_names, std::string());
+
+  print_verilog_comment(fp, std::string("----- Input vectors: " + std::to_string(num_vectors) + " words loaded from file -------"));
+  fp << "\treg [0:" << input_names.size() - 1 << "] " << mem_name;
+  fp << " [0:" << num_vectors - 1 << "];" << "\n";
+  fp << "\tinteger " << index_name << ";" << "\n";
+  fp << "\n";
+
+  print_verilog_comment(fp, std::string("----- Input Initialization -------"));
+  fp << "\tinitial begin" << "\n";
+  fp << "\t\t$readmemh(\"" << stimuli_memory_fname << "\", " << mem_name << ");" << "\n";
+  fp << "\t\t" << index_name << " = 0;" << "\n";
+  fp << "\t\t" << inputs << " <= {" << input_names.size() << "{1'b0}};" << "\n";
+  fp << "\tend" << "\n";
+  fp << "\n";
+
+  print_verilog_comment(fp, std::string("----- Input Stimulus -------"));
+  fp << "\talways@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, clock_port) << ") begin" << "\n";
+  fp << "\t\t" << inputs << " <= " << mem_name << "[" << index_name << "];" << "\n";
+  fp << "\t\t" << index_name << " = (" << index_name << " + 1) % " << num_vectors << ";" << "\n";
+  fp << "\tend" << "\n";
+
+  /* Add an empty line as splitter */
+  fp << "\n";
+}
+
+/********************************************************************
+ * Print Verilog codes to check the equivalence of output vectors,
+ * where all the outputs of the benchmark and the FPGA fabric are packed
+ * into two vectors, which are compared by a single XOR per clock cycle.
+ * A cycle with any mismatch is counted as one error,
+ * and the mismatched bits are reported all together. 
+ * Unknown values in the outputs are not counted as mismatches
+ *******************************************************************/
+static
+void print_verilog_random_top_testbench_vector_check(std::fstream& fp,
+                                                     const std::vector<std::string>& output_names,
+                                                     const BasicPort& clock_port) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  /* Add output autocheck conditionally: only when a preprocessing flag is enable */
+  print_verilog_preprocessing_flag(fp, std::string(AUTOCHECKED_SIMULATION_FLAG)); 
+
+  print_verilog_comment(fp, std::string("----- Begin checking output vectors -------"));
+
+  BasicPort sim_start_port(FORMAL_TB_SIM_START_PORT_NAME, 1);
+  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, sim_start_port) << ";" << "\n";
+
+  if (false == output_names.empty()) {
+    BasicPort bench_outputs_port(BENCHMARK_OUTPUT_VECTOR_NAME, output_names.size());
+    BasicPort fpga_outputs_port(FPGA_OUTPUT_VECTOR_NAME, output_names.size());
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, bench_outputs_port) << ";" << "\n";
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, fpga_outputs_port) << ";" << "\n";
+    fp << "\tassign " << std::string(BENCHMARK_OUTPUT_VECTOR_NAME) << " = ";
+    fp << generate_random_top_testbench_concatenation(output_names, std::string(BENCHMARK_PORT_POSTFIX)) << ";" << "\n";
+    fp << "\tassign " << std::string(FPGA_OUTPUT_VECTOR_NAME) << " = ";
+    fp << generate_random_top_testbench_concatenation(output_names, std::string(FPGA_PORT_POSTFIX)) << ";" << "\n";
+  }
+  fp << "\n";
+
+  print_verilog_comment(fp, std::string("----- Skip the first falling edge of clock, it is for initialization -------"));
+  fp << "\talways@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, clock_port) << ") begin" << "\n";
+  fp << "\t\tif (1'b1 == " << generate_verilog_port(VERILOG_PORT_CONKT, sim_start_port) << ") begin" << "\n";
+  fp << "\t\t";
+  print_verilog_register_connection(fp, sim_start_port, sim_start_port, true);
+  if (false == output_names.empty()) {
+    std::string mismatch = std::string("(") + std::string(FPGA_OUTPUT_VECTOR_NAME) + std::string(" ^ ") + std::string(BENCHMARK_OUTPUT_VECTOR_NAME) + std::string(")");
+    fp << "\t\tend else if (1'b1 === |" << mismatch << ") begin" << "\n";
+    fp << "\t\t\t" << ERROR_COUNTER << " = " << ERROR_COUNTER << " + 1;" << "\n";
+    fp << "\t\t\t$display(\"Mismatch on outputs " << generate_random_top_testbench_concatenation(output_names, std::string(FPGA_PORT_POSTFIX));
+    fp << " of %b at time = " << std::string("%t") << "\", " << mismatch << ", $realtime);" << "\n";
+  }
+  fp << "\t\tend" << "\n";
+  fp << "\tend" << "\n";
+
+  /* Add an empty line as splitter */
+  fp << "\n";
+
+  /* Condition ends */
+  print_verilog_endif(fp);
+
+  /* Add an empty line as splitter */
+  fp << "\n";
 }
 
 /*********************************************************************
@@ -187,12 +375,17 @@ void print_verilog_random_testbench_fpga_instance(std::fstream& fp,
  * The output vectors of the DUTs are compared to verify if they
  * have the same functionality.
  * A flag will be raised to indicate the result 
+ *
+ * When a stimuli memory file is given, the input vectors are written to the file
+ * and loaded by $readmemh, while the output vectors are checked in batch,
+ * which reduces the overhead of simulators in long regressions
  ********************************************************************/
 void print_verilog_random_top_testbench(const std::string& circuit_name,
                                         const std::string& verilog_fname,
                                         const AtomContext& atom_ctx,
                                         const VprNetlistAnnotation& netlist_annotation,
                                         const SimulationSetting& simulation_parameters,
+                                        const std::string& stimuli_memory_fname,
                                         const bool& explicit_port_mapping) {
   std::string timer_message = std::string("Write configuration-skip testbench for FPGA top-level Verilog netlist implemented by '") + circuit_name.c_str() + std::string("'");
 
@@ -200,7 +393,7 @@ void print_verilog_random_top_testbench(const std::string& circuit_name,
   vtr::ScopedStartFinishTimer timer(timer_message);
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   /* Validate the file stream */
@@ -232,23 +425,37 @@ void print_verilog_random_top_testbench(const std::string& circuit_name,
   /* Add stimuli for reset, set, clock and iopad signals */
   print_verilog_testbench_clock_stimuli(fp, simulation_parameters, 
                                         clock_port);
-  print_verilog_testbench_random_stimuli(fp, atom_ctx,
-                                         netlist_annotation, 
-                                         clock_port_names, 
-                                         std::string(CHECKFLAG_PORT_POSTFIX),
-                                         clock_port);
-
-  print_verilog_testbench_check(fp, 
-                                std::string(AUTOCHECKED_SIMULATION_FLAG),
-                                std::string(FORMAL_TB_SIM_START_PORT_NAME),
-                                std::string(BENCHMARK_PORT_POSTFIX),
-                                std::string(FPGA_PORT_POSTFIX),
-                                std::string(CHECKFLAG_PORT_POSTFIX),
-                                std::string(ERROR_COUNTER),
-                                atom_ctx,
-                                netlist_annotation, 
-                                clock_port_names,
-                                std::string(DEFAULT_CLOCK_NAME));
+  if (false == stimuli_memory_fname.empty()) {
+    std::vector<std::string> input_names;
+    std::vector<std::string> output_names;
+    find_random_top_testbench_io_names(atom_ctx, netlist_annotation, clock_port_names,
+                                       input_names, output_names);
+
+    print_verilog_random_top_testbench_vector_stimuli(fp, stimuli_memory_fname,
+                                                      input_names,
+                                                      simulation_parameters.num_clock_cycles(),
+                                                      clock_port);
+
+    print_verilog_random_top_testbench_vector_check(fp, output_names, clock_port);
+  } else {
+    print_verilog_testbench_random_stimuli(fp, atom_ctx,
+                                           netlist_annotation, 
+                                           clock_port_names, 
+                                           std::string(CHECKFLAG_PORT_POSTFIX),
+                                           clock_port);
+
+    print_verilog_testbench_check(fp, 
+                                  std::string(AUTOCHECKED_SIMULATION_FLAG),
+                                  std::string(FORMAL_TB_SIM_START_PORT_NAME),
+                                  std::string(BENCHMARK_PORT_POSTFIX),
+                                  std::string(FPGA_PORT_POSTFIX),
+                                  std::string(CHECKFLAG_PORT_POSTFIX),
+                                  std::string(ERROR_COUNTER),
+                                  atom_ctx,
+                                  netlist_annotation, 
+                                  clock_port_names,
+                                  std::string(DEFAULT_CLOCK_NAME));
+  }
 
   int simulation_time = find_operating_phase_simulation_time(MAGIC_NUMBER_FOR_SIMULATION_TIME,
                                                              simulation_parameters.num_clock_cycles(),
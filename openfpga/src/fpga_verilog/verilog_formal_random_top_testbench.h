@@ -20,6 +20,7 @@ void print_verilog_random_top_testbench(const std::string& circuit_name,
                                         const AtomContext& atom_ctx,
                                         const VprNetlistAnnotation& netlist_annotation,
                                         const SimulationSetting& simulation_parameters,
+                                        const std::string& stimuli_memory_fname,
                                         const bool& explicit_port_mapping);
 
 } /* end namespace openfpga */
@@ -68,6 +68,8 @@ void print_verilog_primitive_block(NetlistManager& netlist_manager,
                                    const std::string& subckt_dir,
                                    t_pb_graph_node* primitive_pb_graph_node,
                                    const bool& use_explicit_mapping,
+                                   const bool& use_packed_ports,
+                                   const bool& incremental,
                                    const bool& verbose) {
   /* Ensure a valid pb_graph_node */ 
   if (nullptr == primitive_pb_graph_node) {
@@ -87,7 +89,7 @@ void print_verilog_primitive_block(NetlistManager& netlist_manager,
   VTR_LOGV(verbose, "\n");
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(incremental, std::string(VERILOG_FILE_HEADER_TIME_STAMP_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
@@ -107,7 +109,7 @@ void print_verilog_primitive_block(NetlistManager& netlist_manager,
            module_manager.module_name(primitive_module).c_str());
   
   /* Write the verilog module */
-  write_verilog_module_to_file(fp, module_manager, primitive_module, use_explicit_mapping);
+  write_verilog_module_to_file(fp, module_manager, primitive_module, use_explicit_mapping, use_packed_ports);
 
   /* Close file handler */
   fp.close();
@@ -142,6 +144,8 @@ void rec_print_verilog_logical_tile(NetlistManager& netlist_manager,
                                     const std::string& subckt_dir,
                                     t_pb_graph_node* physical_pb_graph_node,
                                     const bool& use_explicit_mapping,
+                                    const bool& use_packed_ports,
+                                    const bool& incremental,
                                     const bool& verbose) {
 
   /* Check cur_pb_graph_node*/
@@ -168,6 +172,8 @@ void rec_print_verilog_logical_tile(NetlistManager& netlist_manager,
                                      subckt_dir, 
                                      &(physical_pb_graph_node->child_pb_graph_nodes[physical_mode->index][ipb][0]),
                                      use_explicit_mapping,
+                                     use_packed_ports,
+                                     incremental,
                                      verbose);
     }
   }
@@ -182,6 +188,8 @@ void rec_print_verilog_logical_tile(NetlistManager& netlist_manager,
                                   subckt_dir,
                                   physical_pb_graph_node, 
                                   true, 
+                                  use_packed_ports,
+                                  incremental,
                                   verbose);
     /* Finish for primitive node, return */
     return;
@@ -198,7 +206,7 @@ void rec_print_verilog_logical_tile(NetlistManager& netlist_manager,
   VTR_LOGV(verbose, "\n");
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(incremental, std::string(VERILOG_FILE_HEADER_TIME_STAMP_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
@@ -220,7 +228,7 @@ void rec_print_verilog_logical_tile(NetlistManager& netlist_manager,
   print_verilog_comment(fp, std::string("----- BEGIN Physical programmable logic block Verilog module: " + std::string(physical_pb_type->name) + " -----"));
 
   /* Write the verilog module */
-  write_verilog_module_to_file(fp, module_manager, pb_module, use_explicit_mapping);
+  write_verilog_module_to_file(fp, module_manager, pb_module, use_explicit_mapping, use_packed_ports);
 
   print_verilog_comment(fp, std::string("----- END Physical programmable logic block Verilog module: " + std::string(physical_pb_type->name) + " -----"));
 
@@ -246,6 +254,8 @@ void print_verilog_logical_tile_netlist(NetlistManager& netlist_manager,
                                         const std::string& subckt_dir,
                                         t_pb_graph_node* pb_graph_head,
                                         const bool& use_explicit_mapping,
+                                        const bool& use_packed_ports,
+                                        const bool& incremental,
                                         const bool& verbose) {
 
   VTR_LOG("Writing Verilog netlists for logic tile '%s' ...",
@@ -265,6 +275,8 @@ void print_verilog_logical_tile_netlist(NetlistManager& netlist_manager,
                                  subckt_dir,
                                  pb_graph_head,
                                  use_explicit_mapping,
+                                 use_packed_ports,
+                                 incremental,
                                  verbose);
 
   VTR_LOG("Done\n");
@@ -285,7 +297,9 @@ void print_verilog_physical_tile_netlist(NetlistManager& netlist_manager,
                                          const std::string& subckt_dir,
                                          t_physical_tile_type_ptr phy_block_type,
                                          const e_side& border_side,
-                                         const bool& use_explicit_mapping) {
+                                         const bool& use_explicit_mapping,
+                                         const bool& use_packed_ports,
+                                         const bool& incremental) {
   /* Check code: if this is an IO block, the border side MUST be valid */
   if (true == is_io_type(phy_block_type)) {
     VTR_ASSERT(NUM_SIDES != border_side);
@@ -312,7 +326,7 @@ void print_verilog_physical_tile_netlist(NetlistManager& netlist_manager,
   }
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(incremental, std::string(VERILOG_FILE_HEADER_TIME_STAMP_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
@@ -326,12 +340,12 @@ void print_verilog_physical_tile_netlist(NetlistManager& netlist_manager,
 
   /* Write the verilog module */
   print_verilog_comment(fp, std::string("----- BEGIN Grid Verilog module: " + module_manager.module_name(grid_module) + " -----"));
-  write_verilog_module_to_file(fp, module_manager, grid_module, use_explicit_mapping);
+  write_verilog_module_to_file(fp, module_manager, grid_module, use_explicit_mapping, use_packed_ports);
 
   print_verilog_comment(fp, std::string("----- END Grid Verilog module: " + module_manager.module_name(grid_module) + " -----"));
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Close file handler */
   fp.close();
@@ -356,6 +370,8 @@ void print_verilog_grids(NetlistManager& netlist_manager,
                          const VprDeviceAnnotation& device_annotation,
                          const std::string& subckt_dir,
                          const bool& use_explicit_mapping,
+                         const bool& use_packed_ports,
+                         const bool& incremental,
                          const bool& verbose) {
   /* Create a vector to contain all the Verilog netlist names that have been generated in this function */
   std::vector<std::string> netlist_names;
@@ -380,6 +396,8 @@ void print_verilog_grids(NetlistManager& netlist_manager,
                                        subckt_dir,
                                        logical_tile.pb_graph_head,
                                        use_explicit_mapping,
+                                       use_packed_ports,
+                                       incremental,
                                        verbose);
   }
   VTR_LOG("Writing logical tiles...");
@@ -413,7 +431,9 @@ void print_verilog_grids(NetlistManager& netlist_manager,
                                             subckt_dir, 
                                             &physical_tile,
                                             io_type_side,
-                                            use_explicit_mapping);
+                                            use_explicit_mapping,
+                                            use_packed_ports,
+                                            incremental);
       } 
       continue;
     } else {
@@ -423,7 +443,9 @@ void print_verilog_grids(NetlistManager& netlist_manager,
                                           subckt_dir, 
                                           &physical_tile,
                                           NUM_SIDES,
-                                          use_explicit_mapping);
+                                          use_explicit_mapping,
+                                          use_packed_ports,
+                                          incremental);
     }
   }
   VTR_LOG("Building physical tiles...");
@@ -23,6 +23,8 @@ void print_verilog_grids(NetlistManager& netlist_manager,
                          const VprDeviceAnnotation& device_annotation,
                          const std::string& subckt_dir,
                          const bool& use_explicit_mapping,
+                         const bool& use_packed_ports,
+                         const bool& incremental,
                          const bool& verbose);
 
 
@@ -33,10 +33,11 @@ void print_verilog_submodule_luts(const ModuleManager& module_manager,
                                   NetlistManager& netlist_manager,
                                   const CircuitLibrary& circuit_lib,
                                   const std::string& submodule_dir,
-                                  const bool& use_explicit_port_map) {
+                                  const bool& use_explicit_port_map,
+                                  const bool& incremental) {
   std::string verilog_fname = submodule_dir + std::string(LUTS_VERILOG_FILE_NAME);
 
-  std::fstream fp;
+  IncrementalFileStream fp(incremental, std::string(VERILOG_FILE_HEADER_TIME_STAMP_PREFIX));
 
   /* Create the file stream */
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
@@ -22,7 +22,8 @@ void print_verilog_submodule_luts(const ModuleManager& module_manager,
                                   NetlistManager& netlist_manager,
                                   const CircuitLibrary& circuit_lib,
                                   const std::string& submodule_dir,
-                                  const bool& use_explicit_port_map);
+                                  const bool& use_explicit_port_map,
+                                  const bool& incremental);
 
 } /* end namespace openfpga */
 
@@ -28,6 +28,54 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/*********************************************************************
+ * Write a memory module to a file, along with an alternative module 
+ * where the data outputs are constants given by a parameter,
+ * which is compiled only when the preprocessing flag for 
+ * pre-configured memories is defined.
+ * The parameter is set to the bitstream by the pre-configured FPGA fabric
+ * through defparam, so that simulators can propagate the constants 
+ * into the configured fabric, instead of forcing the memory outputs.
+ * Configuration ports are not used by the alternative module 
+ ********************************************************************/
+static 
+void write_verilog_memory_module_to_file(std::fstream& fp,
+                                         const ModuleManager& module_manager,
+                                         const ModuleId& mem_module,
+                                         const bool& use_explicit_port_map) {
+  ModulePortId mem_out_port_id = module_manager.find_module_port(mem_module, generate_configurable_memory_data_out_name());
+  if (ModulePortId::INVALID() == mem_out_port_id) {
+    write_verilog_module_to_file(fp, module_manager, mem_module, use_explicit_port_map);
+    return;
+  }
+  BasicPort mem_out_port = module_manager.module_port(mem_module, mem_out_port_id);
+
+  print_verilog_preprocessing_flag(fp, std::string(PRECONFIG_MEMORY_PARAMETER_FLAG));
+
+  print_verilog_module_declaration(fp, module_manager, mem_module);
+  fp << "\n";
+
+  BasicPort param_port(std::string(PRECONFIG_MEMORY_PARAMETER_NAME), mem_out_port.get_lsb(), mem_out_port.get_msb());
+  fp << "parameter [" << param_port.get_lsb() << ":" << param_port.get_msb() << "] " << param_port.get_name() << " = {" << param_port.get_width() << "{1'b0}};" << "\n";
+  fp << "\n";
+
+  fp << "assign " << generate_verilog_port(VERILOG_PORT_CONKT, mem_out_port) << " = " << param_port.get_name() << ";" << "\n";
+  ModulePortId mem_outb_port_id = module_manager.find_module_port(mem_module, generate_configurable_memory_inverted_data_out_name());
+  if (ModulePortId::INVALID() != mem_outb_port_id) {
+    BasicPort mem_outb_port = module_manager.module_port(mem_module, mem_outb_port_id);
+    fp << "assign " << generate_verilog_port(VERILOG_PORT_CONKT, mem_outb_port) << " = ~" << param_port.get_name() << ";" << "\n";
+  }
+  fp << "\n";
+
+  print_verilog_module_end(fp, module_manager.module_name(mem_module));
+
+  fp << "`else" << "\n";
+
+  write_verilog_module_to_file(fp, module_manager, mem_module, use_explicit_port_map);
+
+  print_verilog_endif(fp);
+}
+
 /*********************************************************************
  * Generate Verilog modules for the memories that are used
  * by multiplexers  
@@ -58,11 +106,11 @@ void print_verilog_mux_memory_module(const ModuleManager& module_manager,
     ModuleId mem_module = module_manager.find_module(module_name);
     VTR_ASSERT(true == module_manager.valid_module_id(mem_module));
     /* Write the module content in Verilog format */
-    write_verilog_module_to_file(fp, module_manager, mem_module, 
-                                 use_explicit_port_map || circuit_lib.dump_explicit_port_map(mux_model));
+    write_verilog_memory_module_to_file(fp, module_manager, mem_module, 
+                                        use_explicit_port_map || circuit_lib.dump_explicit_port_map(mux_model));
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
     break;
   }
   case CIRCUIT_MODEL_DESIGN_RRAM:
@@ -101,12 +149,13 @@ void print_verilog_submodule_memories(const ModuleManager& module_manager,
                                       const MuxLibrary& mux_lib,
                                       const CircuitLibrary& circuit_lib,
                                       const std::string& submodule_dir,
-                                      const bool& use_explicit_port_map) {
+                                      const bool& use_explicit_port_map,
+                                      const bool& incremental) {
   /* Plug in with the mux subckt */
   std::string verilog_fname(submodule_dir + std::string(MEMORIES_VERILOG_FILE_NAME));
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(incremental, std::string(VERILOG_FILE_HEADER_TIME_STAMP_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
@@ -173,11 +222,11 @@ void print_verilog_submodule_memories(const ModuleManager& module_manager,
     ModuleId mem_module = module_manager.find_module(module_name);
     VTR_ASSERT(true == module_manager.valid_module_id(mem_module));
     /* Write the module content in Verilog format */
-    write_verilog_module_to_file(fp, module_manager, mem_module, 
-                                 use_explicit_port_map || circuit_lib.dump_explicit_port_map(model));
+    write_verilog_memory_module_to_file(fp, module_manager, mem_module, 
+                                        use_explicit_port_map || circuit_lib.dump_explicit_port_map(model));
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
   }
 
   /* Close the file stream */
@@ -24,7 +24,8 @@ void print_verilog_submodule_memories(const ModuleManager& module_manager,
                                       const MuxLibrary& mux_lib,
                                       const CircuitLibrary& circuit_lib,
                                       const std::string& submodule_dir,
-                                      const bool& use_explicit_port_map);
+                                      const bool& use_explicit_port_map,
+                                      const bool& incremental);
 
 } /* end namespace openfpga */
 
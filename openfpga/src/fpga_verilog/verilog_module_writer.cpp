@@ -8,6 +8,9 @@
  * Please use const keyword to restrict this!
  *******************************************************************/
 #include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -35,7 +38,7 @@ std::string generate_verilog_undriven_local_wire_name(const ModuleManager& modul
                                                       const ModuleId& parent, 
                                                       const ModuleId& child, 
                                                       const size_t& instance_id, 
-                                                      const ModulePortId& child_port_id) {
+                                                      const std::string& child_port_name) {
   std::string wire_name;
   if (!module_manager.instance_name(parent, child, instance_id).empty()) {
     wire_name = module_manager.instance_name(parent, child, instance_id);
@@ -45,11 +48,208 @@ std::string generate_verilog_undriven_local_wire_name(const ModuleManager& modul
   }
   
   wire_name += std::string("_undriven_");
-  wire_name += module_manager.module_port(child, child_port_id).get_name();
+  wire_name += child_port_name;
   
   return wire_name;
 }
 
+/********************************************************************
+ * Find the ports of a child module in the order they are printed in an instance:
+ * global, inout, input, output and clock ports
+ *******************************************************************/
+static 
+std::vector<ModulePortId> find_verilog_instance_ports(const ModuleManager& module_manager,
+                                                      const ModuleId& child_module) {
+  std::vector<ModulePortId> child_ports;
+  for (const ModuleManager::e_module_port_type& port_type : {ModuleManager::MODULE_GLOBAL_PORT,
+                                                            ModuleManager::MODULE_GPIN_PORT,
+                                                            ModuleManager::MODULE_GPOUT_PORT,
+                                                            ModuleManager::MODULE_GPIO_PORT,
+                                                            ModuleManager::MODULE_INOUT_PORT,
+                                                            ModuleManager::MODULE_INPUT_PORT,
+                                                            ModuleManager::MODULE_OUTPUT_PORT,
+                                                            ModuleManager::MODULE_CLOCK_PORT}) {
+    for (const ModulePortId& child_port_id : module_manager.module_port_ids_by_type(child_module, port_type)) {
+      child_ports.push_back(child_port_id);
+    }
+  }
+  return child_ports;
+}
+
+/********************************************************************
+ * The Verilog ports of a module whose single-pin ports are packed:
+ * the single-pin ports named <base>_<index>_, of the same type and 
+ * with consecutive indices, e.g., the pins on a side of a grid, are written 
+ * as a single Verilog port <base>_<lsb>_<msb>_[<lsb>:<msb>],
+ * whose pins are the indices of the packed ports.
+ * This allows the connections to the pins of a side to be written 
+ * as a range of a Verilog port instead of pin by pin.
+ *
+ * The ports with a preprocessing flag, or being wires or registers, are not packed
+ *******************************************************************/
+struct t_verilog_packed_ports {
+  /* The Verilog port name and the offset of pins of each port, indexed by port ids */
+  std::vector<std::string> names;
+  std::vector<int> pin_offsets;
+  /* The Verilog port declared for each port, indexed by port ids,
+   * which is empty for the ports packed into the first of their group
+   * (in the printing order of ports) 
+   */
+  std::vector<BasicPort> verilog_ports;
+  /* The ports packed into each Verilog port in the order of their indices,
+   * indexed by the first of each group
+   */
+  std::map<ModulePortId, std::vector<ModulePortId>> members;
+};
+
+/* A pin of a port of a child module, and its pin in the Verilog port of the child module */
+struct t_verilog_port_pin {
+  ModulePortId port;
+  size_t pin;
+  size_t verilog_pin;
+};
+
+/********************************************************************
+ * Identify if the single-pin ports of a module can be packed,
+ * which is limited to the modules written and instanciated by this writer,
+ * i.e., the modules of grids and routing blocks
+ *******************************************************************/
+static 
+bool is_verilog_packed_port_module(const ModuleManager& module_manager,
+                                   const ModuleId& module_id) {
+  return (ModuleManager::MODULE_GRID == module_manager.module_usage(module_id))
+      || (ModuleManager::MODULE_SB == module_manager.module_usage(module_id))
+      || (ModuleManager::MODULE_CB == module_manager.module_usage(module_id));
+}
+
+/********************************************************************
+ * Split a port name <base>_<index>_ into its base and index
+ * Return false if the port name does not end with an index
+ *******************************************************************/
+static 
+bool parse_verilog_packed_port_name(const std::string& port_name,
+                                    std::string& base,
+                                    size_t& index) {
+  if ( (3 > port_name.length()) || ('_' != port_name.back()) ) {
+    return false;
+  }
+  size_t index_end = port_name.length() - 1;
+  size_t index_begin = index_end;
+  while ( (0 < index_begin) && (0 != std::isdigit(port_name[index_begin - 1])) ) {
+    index_begin--;
+  }
+  if ( (index_begin == index_end) || (1 > index_begin) || ('_' != port_name[index_begin - 1]) ) {
+    return false;
+  }
+  base = port_name.substr(0, index_begin - 1);
+  index = std::stoul(port_name.substr(index_begin, index_end - index_begin));
+  return true;
+}
+
+/********************************************************************
+ * Find the Verilog ports of a module whose single-pin ports are packed
+ *******************************************************************/
+static 
+t_verilog_packed_ports find_verilog_module_packed_ports(const ModuleManager& module_manager,
+                                                        const ModuleId& module_id) {
+  t_verilog_packed_ports packed_ports;
+
+  packed_ports.names.resize(module_manager.module_ports(module_id).size());
+  packed_ports.pin_offsets.assign(module_manager.module_ports(module_id).size(), 0);
+  packed_ports.verilog_ports.resize(module_manager.module_ports(module_id).size());
+
+  /* Collect the candidates by type and by base name, sorted by their indices */
+  std::map<ModulePortId, size_t> port_positions;
+  std::map<std::pair<ModuleManager::e_module_port_type, std::string>, std::map<size_t, ModulePortId>> candidates;
+  for (const ModuleManager::e_module_port_type& port_type : {ModuleManager::MODULE_GLOBAL_PORT,
+                                                            ModuleManager::MODULE_GPIN_PORT,
+                                                            ModuleManager::MODULE_GPOUT_PORT,
+                                                            ModuleManager::MODULE_GPIO_PORT,
+                                                            ModuleManager::MODULE_INOUT_PORT,
+                                                            ModuleManager::MODULE_INPUT_PORT,
+                                                            ModuleManager::MODULE_OUTPUT_PORT,
+                                                            ModuleManager::MODULE_CLOCK_PORT}) {
+    for (const ModulePortId& port_id : module_manager.module_port_ids_by_type(module_id, port_type)) {
+      const BasicPort& port = module_manager.module_port(module_id, port_id);
+      packed_ports.names[size_t(port_id)] = port.get_name();
+      packed_ports.verilog_ports[size_t(port_id)] = port;
+      size_t port_position = port_positions.size();
+      port_positions[port_id] = port_position;
+
+      std::string base;
+      size_t index;
+      if ( (1 != port.get_width())
+        || (false == module_manager.port_preproc_flag(module_id, port_id).empty())
+        || (true == module_manager.port_is_wire(module_id, port_id))
+        || (true == module_manager.port_is_register(module_id, port_id))
+        || (false == parse_verilog_packed_port_name(port.get_name(), base, index)) ) {
+        continue;
+      }
+      candidates[std::make_pair(port_type, base)][index] = port_id;
+    }
+  }
+
+  /* Pack each run of consecutive indices */
+  for (const auto& candidate : candidates) {
+    auto run_begin = candidate.second.begin();
+    while (run_begin != candidate.second.end()) {
+      auto run_end = std::next(run_begin);
+      while ( (run_end != candidate.second.end())
+           && (std::prev(run_end)->first + 1 == run_end->first) ) {
+        ++run_end;
+      }
+      size_t lsb = run_begin->first;
+      size_t msb = std::prev(run_end)->first;
+      std::string packed_name = candidate.first.second + std::string("_") + std::to_string(lsb)
+                              + std::string("_") + std::to_string(msb) + std::string("_");
+      if ( (lsb == msb)
+        || (ModulePortId::INVALID() != module_manager.find_module_port(module_id, packed_name)) ) {
+        run_begin = run_end;
+        continue;
+      }
+
+      std::vector<ModulePortId> members;
+      ModulePortId first_member = run_begin->second;
+      for (auto it = run_begin; it != run_end; ++it) {
+        members.push_back(it->second);
+        if (port_positions.at(it->second) < port_positions.at(first_member)) {
+          first_member = it->second;
+        }
+      }
+      for (auto it = run_begin; it != run_end; ++it) {
+        packed_ports.names[size_t(it->second)] = packed_name;
+        packed_ports.pin_offsets[size_t(it->second)] = int(it->first) - module_manager.module_port(module_id, it->second).get_lsb();
+        packed_ports.verilog_ports[size_t(it->second)] = BasicPort();
+      }
+      packed_ports.verilog_ports[size_t(first_member)] = BasicPort(packed_name, lsb, msb);
+      packed_ports.members[first_member] = members;
+
+      run_begin = run_end;
+    }
+  }
+
+  return packed_ports;
+}
+
+/********************************************************************
+ * Find the Verilog port of a pin of a module port,
+ * which is the port itself unless it is packed
+ *******************************************************************/
+static 
+BasicPort find_verilog_module_port_pin(const ModuleManager& module_manager,
+                                       const std::map<ModuleId, t_verilog_packed_ports>* packed_ports,
+                                       const ModuleId& module_id,
+                                       const ModulePortId& port_id,
+                                       const size_t& pin) {
+  if (nullptr != packed_ports) {
+    auto it = packed_ports->find(module_id);
+    if (packed_ports->end() != it) {
+      size_t verilog_pin = pin + it->second.pin_offsets[size_t(port_id)];
+      return BasicPort(it->second.names[size_t(port_id)], verilog_pin, verilog_pin);
+    }
+  }
+  return BasicPort(module_manager.module_port(module_id, port_id).get_name(), pin, pin);
+}
 
 /********************************************************************
  * Name a net for a local wire for a verilog module 
@@ -60,30 +260,33 @@ std::string generate_verilog_undriven_local_wire_name(const ModuleManager& modul
  *
  * Restriction: this function requires each net has single driver
  * which is definitely always true in circuits.
+ *
+ * When the ports of modules are packed, the ports are named after their Verilog ports
  *******************************************************************/
 static 
 BasicPort generate_verilog_port_for_module_net(const ModuleManager& module_manager,
                                                const ModuleId& module_id,
-                                               const ModuleNetId& module_net) {
+                                               const ModuleNetId& module_net,
+                                               const std::map<ModuleId, t_verilog_packed_ports>* packed_ports) {
   /* Check all the sink modules of the net, 
    * if we have a source module is the current module, this is not local wire 
    */
   for (ModuleNetSrcId src_id : module_manager.module_net_sources(module_id, module_net)) {
-    if (module_id == module_manager.net_source_modules(module_id, module_net)[src_id]) {
+    if (module_id == module_manager.net_source_module(module_id, module_net, src_id)) {
       /* Here, this is not a local wire, return the port name of the src_port */
-      ModulePortId net_src_port = module_manager.net_source_ports(module_id, module_net)[src_id];
-      size_t src_pin_index = module_manager.net_source_pins(module_id, module_net)[src_id];
-      return BasicPort(module_manager.module_port(module_id, net_src_port).get_name(), src_pin_index, src_pin_index);
+      ModulePortId net_src_port = module_manager.net_source_port(module_id, module_net, src_id);
+      size_t src_pin_index = module_manager.net_source_pin(module_id, module_net, src_id);
+      return find_verilog_module_port_pin(module_manager, packed_ports, module_id, net_src_port, src_pin_index);
     }
   }
 
   /* Check all the sink modules of the net */
   for (ModuleNetSinkId sink_id : module_manager.module_net_sinks(module_id, module_net)) {
-    if (module_id == module_manager.net_sink_modules(module_id, module_net)[sink_id]) {
+    if (module_id == module_manager.net_sink_module(module_id, module_net, sink_id)) {
       /* Here, this is not a local wire, return the port name of the sink_port */
-      ModulePortId net_sink_port = module_manager.net_sink_ports(module_id, module_net)[sink_id];
-      size_t sink_pin_index = module_manager.net_sink_pins(module_id, module_net)[sink_id];
-      return BasicPort(module_manager.module_port(module_id, net_sink_port).get_name(), sink_pin_index, sink_pin_index);
+      ModulePortId net_sink_port = module_manager.net_sink_port(module_id, module_net, sink_id);
+      size_t sink_pin_index = module_manager.net_sink_pin(module_id, module_net, sink_id);
+      return find_verilog_module_port_pin(module_manager, packed_ports, module_id, net_sink_port, sink_pin_index);
     }
   }
 
@@ -91,29 +294,226 @@ BasicPort generate_verilog_port_for_module_net(const ModuleManager& module_manag
   std::string net_name;
 
   /* Each net must only one 1 source */ 
-  VTR_ASSERT(1 == module_manager.net_source_modules(module_id, module_net).size());
+  VTR_ASSERT(1 == module_manager.module_net_sources(module_id, module_net).size());
 
   /* Get the source module */
-  ModuleId net_src_module = module_manager.net_source_modules(module_id, module_net)[ModuleNetSrcId(0)];
+  ModuleId net_src_module = module_manager.net_source_module(module_id, module_net, ModuleNetSrcId(0));
   /* Get the instance id */
-  size_t net_src_instance = module_manager.net_source_instances(module_id, module_net)[ModuleNetSrcId(0)]; 
+  size_t net_src_instance = module_manager.net_source_instance(module_id, module_net, ModuleNetSrcId(0)); 
   /* Get the port id */
-  ModulePortId net_src_port = module_manager.net_source_ports(module_id, module_net)[ModuleNetSrcId(0)]; 
+  ModulePortId net_src_port = module_manager.net_source_port(module_id, module_net, ModuleNetSrcId(0)); 
   /* Get the pin id */
-  size_t net_src_pin = module_manager.net_source_pins(module_id, module_net)[ModuleNetSrcId(0)]; 
+  size_t net_src_pin = module_manager.net_source_pin(module_id, module_net, ModuleNetSrcId(0)); 
 
   /* Load user-defined name if we have it */
   if (false == module_manager.net_name(module_id, module_net).empty()) {
     net_name = module_manager.net_name(module_id, module_net);
   } else {
+    BasicPort net_src_verilog_pin = find_verilog_module_port_pin(module_manager, packed_ports, net_src_module, net_src_port, net_src_pin);
     net_name  = module_manager.module_name(net_src_module); 
     net_name += std::string("_") + std::to_string(net_src_instance) + std::string("_");
-    net_name += module_manager.module_port(net_src_module, net_src_port).get_name();
+    net_name += net_src_verilog_pin.get_name();
+    net_src_pin = net_src_verilog_pin.get_lsb();
   }
   
   return BasicPort(net_name, net_src_pin, net_src_pin);
 }
 
+/********************************************************************
+ * Cache of the ports which are built many times when writing a module
+ * - the port or local wire of each net, named by generate_verilog_port_for_module_net(),
+ *   which is shared by the local wire declaration and all the pins driven by the net
+ * - the ports of each child module in the printing order,
+ *   which are shared by all the instances of the child module
+ * Each of them is built only once per module
+ *******************************************************************/
+struct t_verilog_module_writer_cache {
+  /* Indexed by the nets of the module, built on demand */
+  std::vector<BasicPort> net_ports;
+  std::vector<bool> net_port_built;
+  /* The Verilog ports of each child module and their pins,
+   * which are the ports of the child module unless they are packed
+   */
+  std::map<ModuleId, std::vector<ModulePortId>> child_port_ids;
+  std::map<ModuleId, std::vector<BasicPort>> child_ports;
+  std::map<ModuleId, std::vector<std::vector<t_verilog_port_pin>>> child_port_pins;
+  /* Only used when the single-pin ports are packed:
+   * the Verilog ports of the module and its child modules which are packed
+   */
+  bool use_packed_ports = false;
+  std::map<ModuleId, t_verilog_packed_ports> packed_ports;
+  /* Only used when writing a pruned module:
+   * - the instances to be written, for each child module listed
+   *   (the instances of other child modules are all written)
+   * - if each port of each child module (in the printing order) is an output
+   * - the undriven wires of the instance inputs, which are tied to logic '0'
+   */
+  const std::map<ModuleId, std::vector<bool>>* kept_instances = nullptr;
+  std::map<ModuleId, std::vector<bool>> child_port_is_output;
+  std::vector<BasicPort> undriven_input_wires;
+};
+
+static 
+void init_verilog_module_writer_cache(t_verilog_module_writer_cache& cache,
+                                      const ModuleManager& module_manager,
+                                      const ModuleId& module_id,
+                                      const std::map<ModuleId, std::vector<bool>>* kept_instances,
+                                      const bool& use_packed_ports) {
+  cache.net_ports.assign(module_manager.num_nets(module_id), BasicPort());
+  cache.net_port_built.assign(module_manager.num_nets(module_id), false);
+  cache.kept_instances = kept_instances;
+  cache.use_packed_ports = use_packed_ports;
+  if ( (true == use_packed_ports)
+    && (true == is_verilog_packed_port_module(module_manager, module_id)) ) {
+    cache.packed_ports[module_id] = find_verilog_module_packed_ports(module_manager, module_id);
+  }
+  for (const ModuleId& child_module : module_manager.child_modules(module_id)) {
+    std::vector<ModulePortId>& child_port_ids = cache.child_port_ids[child_module];
+    std::vector<BasicPort>& child_ports = cache.child_ports[child_module];
+    std::vector<std::vector<t_verilog_port_pin>>& child_port_pins = cache.child_port_pins[child_module];
+    if ( (true == use_packed_ports)
+      && (true == is_verilog_packed_port_module(module_manager, child_module)) ) {
+      /* Only the first port of each packed group is written, with the pins of all the ports in the group */
+      const t_verilog_packed_ports& child_packed_ports = cache.packed_ports[child_module] = find_verilog_module_packed_ports(module_manager, child_module);
+      for (const ModulePortId& child_port_id : find_verilog_instance_ports(module_manager, child_module)) {
+        const BasicPort& child_port = child_packed_ports.verilog_ports[size_t(child_port_id)];
+        if (true == child_port.get_name().empty()) {
+          continue;
+        }
+        child_port_ids.push_back(child_port_id);
+        child_ports.push_back(child_port);
+        child_port_pins.emplace_back();
+        auto members = child_packed_ports.members.find(child_port_id);
+        if (child_packed_ports.members.end() == members) {
+          for (const size_t& pin : child_port.pins()) {
+            child_port_pins.back().push_back({child_port_id, pin, pin});
+          }
+          continue;
+        }
+        for (const ModulePortId& member : members->second) {
+          for (const size_t& pin : module_manager.module_port(child_module, member).pins()) {
+            child_port_pins.back().push_back({member, pin, pin + child_packed_ports.pin_offsets[size_t(member)]});
+          }
+        }
+      }
+    } else {
+      child_port_ids = find_verilog_instance_ports(module_manager, child_module);
+      child_ports.reserve(child_port_ids.size());
+      child_port_pins.reserve(child_port_ids.size());
+      for (const ModulePortId& child_port_id : child_port_ids) {
+        child_ports.push_back(module_manager.module_port(child_module, child_port_id));
+        child_port_pins.emplace_back();
+        for (const size_t& pin : child_ports.back().pins()) {
+          child_port_pins.back().push_back({child_port_id, pin, pin});
+        }
+      }
+    }
+
+    if (nullptr == kept_instances) {
+      continue;
+    }
+    std::vector<ModulePortId> child_output_port_ids;
+    for (const ModuleManager::e_module_port_type& port_type : {ModuleManager::MODULE_GPOUT_PORT,
+                                                              ModuleManager::MODULE_GPIO_PORT,
+                                                              ModuleManager::MODULE_INOUT_PORT,
+                                                              ModuleManager::MODULE_OUTPUT_PORT}) {
+      for (const ModulePortId& child_port_id : module_manager.module_port_ids_by_type(child_module, port_type)) {
+        child_output_port_ids.push_back(child_port_id);
+      }
+    }
+    std::vector<bool>& child_port_is_output = cache.child_port_is_output[child_module];
+    for (const ModulePortId& child_port_id : child_port_ids) {
+      child_port_is_output.push_back(child_output_port_ids.end() != std::find(child_output_port_ids.begin(), child_output_port_ids.end(), child_port_id));
+    }
+  }
+}
+
+/********************************************************************
+ * The packed Verilog ports of the modules to be used when naming ports,
+ * which are null unless the single-pin ports are packed
+ *******************************************************************/
+static 
+const std::map<ModuleId, t_verilog_packed_ports>* find_verilog_packed_ports(const t_verilog_module_writer_cache& cache) {
+  if (false == cache.use_packed_ports) {
+    return nullptr;
+  }
+  return &cache.packed_ports;
+}
+
+/********************************************************************
+ * Identify if an instance of a child module is written,
+ * which is always true unless a pruned module is being written
+ *******************************************************************/
+static 
+bool is_verilog_instance_kept(const t_verilog_module_writer_cache& cache,
+                              const ModuleId& child_module,
+                              const size_t& instance_id) {
+  if (nullptr == cache.kept_instances) {
+    return true;
+  }
+  auto it = cache.kept_instances->find(child_module);
+  if (cache.kept_instances->end() == it) {
+    return true;
+  }
+  return it->second[instance_id];
+}
+
+/********************************************************************
+ * Identify if a net is driven in the module being written,
+ * i.e., it has a source in the parent module or in an instance which is written.
+ * In a pruned module, the nets driven by removed instances only are left undriven
+ *******************************************************************/
+static 
+bool is_verilog_module_net_driven(const t_verilog_module_writer_cache& cache,
+                                  const ModuleManager& module_manager,
+                                  const ModuleId& module_id,
+                                  const ModuleNetId& module_net) {
+  if (nullptr == cache.kept_instances) {
+    return true;
+  }
+  for (ModuleNetSrcId src_id : module_manager.module_net_sources(module_id, module_net)) {
+    ModuleId src_module = module_manager.net_source_module(module_id, module_net, src_id);
+    if ( (module_id == src_module)
+      || (true == is_verilog_instance_kept(cache, src_module, module_manager.net_source_instance(module_id, module_net, src_id))) ) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/********************************************************************
+ * Find the net linked to a pin of an instance, 
+ * which is invalid if the pin is undriven in the module being written
+ *******************************************************************/
+static 
+ModuleNetId find_verilog_instance_port_net(const t_verilog_module_writer_cache& cache,
+                                           const ModuleManager& module_manager,
+                                           const ModuleId& parent_module,
+                                           const ModuleId& child_module,
+                                           const size_t& instance_id,
+                                           const ModulePortId& child_port_id,
+                                           const size_t& child_pin) {
+  ModuleNetId net = module_manager.module_instance_port_net(parent_module, child_module, instance_id, 
+                                                            child_port_id, child_pin);
+  if ( (ModuleNetId::INVALID() != net)
+    && (false == is_verilog_module_net_driven(cache, module_manager, parent_module, net)) ) {
+    return ModuleNetId::INVALID();
+  }
+  return net;
+}
+
+static 
+const BasicPort& find_cached_verilog_port_for_module_net(t_verilog_module_writer_cache& cache,
+                                                         const ModuleManager& module_manager,
+                                                         const ModuleId& module_id,
+                                                         const ModuleNetId& module_net) {
+  if (false == cache.net_port_built[size_t(module_net)]) {
+    cache.net_ports[size_t(module_net)] = generate_verilog_port_for_module_net(module_manager, module_id, module_net, find_verilog_packed_ports(cache));
+    cache.net_port_built[size_t(module_net)] = true;
+  }
+  return cache.net_ports[size_t(module_net)];
+}
+
 /********************************************************************
  * Find all the nets that are going to be local wires
  * And organize it in a vector of ports
@@ -122,7 +522,8 @@ BasicPort generate_verilog_port_for_module_net(const ModuleManager& module_manag
  *******************************************************************/
 static 
 std::map<std::string, std::vector<BasicPort>> find_verilog_module_local_wires(const ModuleManager& module_manager,
-                                                                              const ModuleId& module_id) {
+                                                                              const ModuleId& module_id,
+                                                                              t_verilog_module_writer_cache& cache) {
   std::map<std::string, std::vector<BasicPort>> local_wires;
 
   /* Local wires come from the child modules */
@@ -143,8 +544,12 @@ std::map<std::string, std::vector<BasicPort>> find_verilog_module_local_wires(co
     if (false == module_net_is_local_wire(module_manager, module_id, module_net)) {
       continue;
     }
+    /* The nets driven by removed instances are replaced by undriven wires */ 
+    if (false == is_verilog_module_net_driven(cache, module_manager, module_id, module_net)) {
+      continue;
+    }
     /* Find the name for this local wire */
-    BasicPort local_wire_candidate = generate_verilog_port_for_module_net(module_manager, module_id, module_net);
+    const BasicPort& local_wire_candidate = find_cached_verilog_port_for_module_net(cache, module_manager, module_id, module_net);
     /* Cache the net name, try to find it in the cache.
      * If you can find one, it means this port may be mergeable, try to do merging. If merge fail, add to the local wire list
      * If you cannot find one, it means that this port is not mergeable, add to the local wire list immediately.
@@ -170,19 +575,38 @@ std::map<std::string, std::vector<BasicPort>> find_verilog_module_local_wires(co
     }
   }
 
+  /* The nets driven by a packed Verilog port of a child module may not cover all its pins,
+   * a single local wire is declared for all the pins of such a port 
+   */
+  if (true == cache.use_packed_ports) {
+    for (std::pair<const std::string, std::vector<BasicPort>>& port_group : local_wires) {
+      BasicPort& local_wire = port_group.second.front();
+      for (const BasicPort& other_wire : port_group.second) {
+        local_wire.set_width(std::min(local_wire.get_lsb(), other_wire.get_lsb()),
+                             std::max(local_wire.get_msb(), other_wire.get_msb()));
+      }
+      port_group.second.resize(1);
+    }
+  }
+
   /* Local wires could also happen for undriven ports of child module */
   for (const ModuleId& child : module_manager.child_modules(module_id)) {
+    const std::vector<BasicPort>& child_ports = cache.child_ports.at(child);
+    const std::vector<std::vector<t_verilog_port_pin>>& child_port_pins = cache.child_port_pins.at(child);
     for (size_t instance : module_manager.child_module_instances(module_id, child)) {
-      for (const ModulePortId& child_port_id : module_manager.module_ports(child)) {
-        BasicPort child_port = module_manager.module_port(child, child_port_id);
+      if (false == is_verilog_instance_kept(cache, child, instance)) {
+        continue;
+      }
+      for (size_t iport = 0; iport < child_ports.size(); ++iport) {
+        const BasicPort& child_port = child_ports[iport];
         std::vector<size_t> undriven_pins;
-        for (size_t child_pin : child_port.pins()) {
+        for (const t_verilog_port_pin& child_pin : child_port_pins[iport]) {
           /* Find the net linked to the pin */
-          ModuleNetId net = module_manager.module_instance_port_net(module_id, child, instance, 
-                                                                    child_port_id, child_pin);
+          ModuleNetId net = find_verilog_instance_port_net(cache, module_manager, module_id, child, instance, 
+                                                           child_pin.port, child_pin.pin);
           /* We only care undriven ports */
           if (ModuleNetId::INVALID() == net) {
-            undriven_pins.push_back(child_pin);
+            undriven_pins.push_back(child_pin.verilog_pin);
           }
         }
         if (true == undriven_pins.empty()) {
@@ -190,12 +614,17 @@ std::map<std::string, std::vector<BasicPort>> find_verilog_module_local_wires(co
         }
         /* Reach here, we need a local wire, we will create a port only for the undriven pins of the port! */
         BasicPort instance_port;
-        instance_port.set_name(generate_verilog_undriven_local_wire_name(module_manager, module_id, child, instance, child_port_id));
+        instance_port.set_name(generate_verilog_undriven_local_wire_name(module_manager, module_id, child, instance, child_port.get_name()));
         /* We give the same port name as child module, this case happens to global ports */
         instance_port.set_width(*std::min_element(undriven_pins.begin(), undriven_pins.end()),
                                 *std::max_element(undriven_pins.begin(), undriven_pins.end())); 
 
         local_wires[instance_port.get_name()].push_back(instance_port);
+
+        if ( (nullptr != cache.kept_instances)
+          && (false == cache.child_port_is_output.at(child)[iport]) ) {
+          cache.undriven_input_wires.push_back(instance_port);
+        }
       }
     }
   }
@@ -213,6 +642,7 @@ std::map<std::string, std::vector<BasicPort>> find_verilog_module_local_wires(co
 static 
 void print_verilog_module_output_short_connection(std::fstream& fp, 
                                                   const ModuleManager& module_manager,
+                                                  const std::map<ModuleId, t_verilog_packed_ports>* packed_ports,
                                                   const ModuleId& module_id,
                                                   const ModuleNetId& module_net) {
   /* Ensure a valid file stream */
@@ -223,15 +653,15 @@ void print_verilog_module_output_short_connection(std::fstream& fp,
 
   /* We have found a module input, now check all the sink modules of the net */
   for (ModuleNetSinkId net_sink : module_manager.module_net_sinks(module_id, module_net)) {
-    ModuleId sink_module = module_manager.net_sink_modules(module_id, module_net)[net_sink];
+    ModuleId sink_module = module_manager.net_sink_module(module_id, module_net, net_sink);
     if (module_id != sink_module) {
       continue;
     }
 
     /* Find the sink port and pin information */
-    ModulePortId sink_port_id = module_manager.net_sink_ports(module_id, module_net)[net_sink];
-    size_t sink_pin = module_manager.net_sink_pins(module_id, module_net)[net_sink];
-    BasicPort sink_port(module_manager.module_port(module_id, sink_port_id).get_name(), sink_pin, sink_pin);
+    ModulePortId sink_port_id = module_manager.net_sink_port(module_id, module_net, net_sink);
+    size_t sink_pin = module_manager.net_sink_pin(module_id, module_net, net_sink);
+    BasicPort sink_port = find_verilog_module_port_pin(module_manager, packed_ports, module_id, sink_port_id, sink_pin);
 
     /* For the first module output, this is the source port, we do nothing and go to the next */
     if (true == first_port) {
@@ -257,34 +687,35 @@ void print_verilog_module_output_short_connection(std::fstream& fp,
 static 
 void print_verilog_module_local_short_connection(std::fstream& fp, 
                                                  const ModuleManager& module_manager,
+                                                 const std::map<ModuleId, t_verilog_packed_ports>* packed_ports,
                                                  const ModuleId& module_id,
                                                  const ModuleNetId& module_net) {
   /* Ensure a valid file stream */
   VTR_ASSERT(true == valid_file_stream(fp));
 
   for (ModuleNetSrcId net_src : module_manager.module_net_sources(module_id, module_net)) {
-    ModuleId src_module = module_manager.net_source_modules(module_id, module_net)[net_src];
+    ModuleId src_module = module_manager.net_source_module(module_id, module_net, net_src);
     if (module_id != src_module) {
       continue;
     }
     /* Find the source port and pin information */
     print_verilog_comment(fp, std::string("----- Net source id " + std::to_string(size_t(net_src)) + " -----"));
-    ModulePortId src_port_id = module_manager.net_source_ports(module_id, module_net)[net_src];
-    size_t src_pin = module_manager.net_source_pins(module_id, module_net)[net_src];
-    BasicPort src_port(module_manager.module_port(module_id, src_port_id).get_name(), src_pin, src_pin);
+    ModulePortId src_port_id = module_manager.net_source_port(module_id, module_net, net_src);
+    size_t src_pin = module_manager.net_source_pin(module_id, module_net, net_src);
+    BasicPort src_port = find_verilog_module_port_pin(module_manager, packed_ports, module_id, src_port_id, src_pin);
 
     /* We have found a module input, now check all the sink modules of the net */
     for (ModuleNetSinkId net_sink : module_manager.module_net_sinks(module_id, module_net)) {
-      ModuleId sink_module = module_manager.net_sink_modules(module_id, module_net)[net_sink];
+      ModuleId sink_module = module_manager.net_sink_module(module_id, module_net, net_sink);
       if (module_id != sink_module) {
         continue;
       }
 
       /* Find the sink port and pin information */
       print_verilog_comment(fp, std::string("----- Net sink id " + std::to_string(size_t(net_sink)) + " -----"));
-      ModulePortId sink_port_id = module_manager.net_sink_ports(module_id, module_net)[net_sink];
-      size_t sink_pin = module_manager.net_sink_pins(module_id, module_net)[net_sink];
-      BasicPort sink_port(module_manager.module_port(module_id, sink_port_id).get_name(), sink_pin, sink_pin);
+      ModulePortId sink_port_id = module_manager.net_sink_port(module_id, module_net, net_sink);
+      size_t sink_pin = module_manager.net_sink_pin(module_id, module_net, net_sink);
+      BasicPort sink_port = find_verilog_module_port_pin(module_manager, packed_ports, module_id, sink_port_id, sink_pin);
 
       /* We need to print a wire connection here */
       print_verilog_wire_connection(fp, sink_port, src_port, false);
@@ -311,6 +742,7 @@ void print_verilog_module_local_short_connection(std::fstream& fp,
 static 
 void print_verilog_module_local_short_connections(std::fstream& fp, 
                                                   const ModuleManager& module_manager,
+                                                  const std::map<ModuleId, t_verilog_packed_ports>* packed_ports,
                                                   const ModuleId& module_id) {
   /* Local wires come from the child modules */
   for (ModuleNetId module_net : module_manager.module_nets(module_id)) {
@@ -319,7 +751,7 @@ void print_verilog_module_local_short_connections(std::fstream& fp,
       continue;
     }
     print_verilog_comment(fp, std::string("----- Local connection due to Wire " + std::to_string(size_t(module_net)) + " -----"));
-    print_verilog_module_local_short_connection(fp, module_manager, module_id, module_net); 
+    print_verilog_module_local_short_connection(fp, module_manager, packed_ports, module_id, module_net); 
   }
 }
 
@@ -342,6 +774,7 @@ void print_verilog_module_local_short_connections(std::fstream& fp,
 static 
 void print_verilog_module_output_short_connections(std::fstream& fp, 
                                                    const ModuleManager& module_manager,
+                                                   const std::map<ModuleId, t_verilog_packed_ports>* packed_ports,
                                                    const ModuleId& module_id) {
   /* Local wires come from the child modules */
   for (ModuleNetId module_net : module_manager.module_nets(module_id)) {
@@ -349,7 +782,7 @@ void print_verilog_module_output_short_connections(std::fstream& fp,
     if (false == module_net_include_output_short_connection(module_manager, module_id, module_net)) {
       continue;
     }
-    print_verilog_module_output_short_connection(fp, module_manager, module_id, module_net); 
+    print_verilog_module_output_short_connection(fp, module_manager, packed_ports, module_id, module_net); 
   }
 }
 
@@ -376,6 +809,7 @@ void write_verilog_instance_to_file(std::fstream& fp,
                                     const ModuleId& parent_module,
                                     const ModuleId& child_module,
                                     const size_t& instance_id,
+                                    t_verilog_module_writer_cache& cache,
                                     const bool& use_explicit_port_map) {
   /* Ensure a valid file stream */
   VTR_ASSERT(true == valid_file_stream(fp));
@@ -387,73 +821,147 @@ void write_verilog_instance_to_file(std::fstream& fp,
    * if not, we use a default name <name>_<num_instance_in_parent_module> 
    */
   if (true == module_manager.instance_name(parent_module, child_module, instance_id).empty()) {
-    fp << generate_instance_name(module_manager.module_name(child_module), instance_id) << " (" << std::endl;
+    fp << generate_instance_name(module_manager.module_name(child_module), instance_id) << " (" << "\n";
   } else {
-    fp << module_manager.instance_name(parent_module, child_module, instance_id) << " (" << std::endl;
-  }
-
-  /* Print each port with/without explicit port map */
-  /* port type2type mapping */
-  std::map<ModuleManager::e_module_port_type, enum e_dump_verilog_port_type> port_type2type_map;
-  port_type2type_map[ModuleManager::MODULE_GLOBAL_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_GPIN_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_GPOUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_GPIO_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_INOUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_INPUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_OUTPUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_CLOCK_PORT] = VERILOG_PORT_CONKT;
-
-  /* Port sequence: global, inout, input, output and clock ports, */
-  size_t port_cnt = 0;
-  for (const auto& kv : port_type2type_map) {
-    for (const ModulePortId& child_port_id : module_manager.module_port_ids_by_type(child_module, kv.first)) {
-      BasicPort child_port = module_manager.module_port(child_module, child_port_id);
-      if (0 != port_cnt) {
-        /* Do not dump a comma for the first port */
-        fp << "," << std::endl; 
-      }
-      /* Print port */
-      fp << "\t\t";
-      /* if explicit port map is required, output the port name */
-      if (true == use_explicit_port_map) {
-        fp << "." << child_port.get_name() << "(";
-      }
+    fp << module_manager.instance_name(parent_module, child_module, instance_id) << " (" << "\n";
+  }
 
-      /* Create the port name and width to be used by the instance */
-      std::vector<BasicPort> instance_ports; 
-      for (size_t child_pin : child_port.pins()) {
-        /* Find the net linked to the pin */
-        ModuleNetId net = module_manager.module_instance_port_net(parent_module, child_module, instance_id, 
-                                                                  child_port_id, child_pin);
-        BasicPort instance_port;
-        if (ModuleNetId::INVALID() == net) {
-          /* We give the same port name as child module, this case happens to global ports */
-          instance_port.set_name(generate_verilog_undriven_local_wire_name(module_manager, parent_module, child_module, instance_id, child_port_id));
-          instance_port.set_width(child_pin, child_pin); 
-        } else {
-          /* Find the name for this child port */
-          instance_port = generate_verilog_port_for_module_net(module_manager, parent_module, net);
+  /* Print each port with/without explicit port map
+   * Port sequence: global, inout, input, output and clock ports
+   */
+  const std::vector<BasicPort>& child_ports = cache.child_ports.at(child_module);
+  const std::vector<std::vector<t_verilog_port_pin>>& child_port_pins = cache.child_port_pins.at(child_module);
+  std::vector<BasicPort> instance_ports; 
+  for (size_t iport = 0; iport < child_ports.size(); ++iport) {
+    const BasicPort& child_port = child_ports[iport];
+    if (0 != iport) {
+      /* Do not dump a comma for the first port */
+      fp << "," << "\n"; 
+    }
+    /* Print port */
+    fp << "\t\t";
+    /* if explicit port map is required, output the port name */
+    if (true == use_explicit_port_map) {
+      fp << "." << child_port.get_name() << "(";
+    }
+
+    /* Create the port name and width to be used by the instance */
+    instance_ports.clear();
+    std::string undriven_wire_name;
+    for (const t_verilog_port_pin& child_pin : child_port_pins[iport]) {
+      /* Find the net linked to the pin */
+      ModuleNetId net = find_verilog_instance_port_net(cache, module_manager, parent_module, child_module, instance_id, 
+                                                       child_pin.port, child_pin.pin);
+      if (ModuleNetId::INVALID() == net) {
+        /* We give the same port name as child module, this case happens to global ports */
+        if (true == undriven_wire_name.empty()) {
+          undriven_wire_name = generate_verilog_undriven_local_wire_name(module_manager, parent_module, child_module, instance_id, child_port.get_name());
         }
-        /* Create the port information for the net */
-        instance_ports.push_back(instance_port);
-      } 
-      /* Try to merge the ports */
-      std::vector<BasicPort> merged_ports = combine_verilog_ports(instance_ports); 
-
-      /* Print a verilog port by combining the instance ports */
-      fp << generate_verilog_ports(merged_ports);
-
-      /* if explicit port map is required, output the pair of branket */
-      if (true == use_explicit_port_map) {
-        fp << ")";
+        instance_ports.push_back(BasicPort(undriven_wire_name, child_pin.verilog_pin, child_pin.verilog_pin));
+      } else {
+        /* Find the name for this child port */
+        instance_ports.push_back(find_cached_verilog_port_for_module_net(cache, module_manager, parent_module, net));
       }
-      port_cnt++;
+    } 
+    /* Try to merge the ports */
+    std::vector<BasicPort> merged_ports = combine_verilog_ports(instance_ports); 
+
+    /* Print a verilog port by combining the instance ports */
+    fp << generate_verilog_ports(merged_ports);
+
+    /* if explicit port map is required, output the pair of branket */
+    if (true == use_explicit_port_map) {
+      fp << ")";
     }
   }
   
   /* Print an end to the instance */
-  fp << ");" << std::endl;
+  fp << ");" << "\n";
+}
+
+/********************************************************************
+ * Write a Verilog module to a file, under the given name,
+ * where only the kept instances are written when a pruned module is requested
+ *******************************************************************/
+static 
+void write_verilog_module_instances_to_file(std::fstream& fp,
+                                            const ModuleManager& module_manager,
+                                            const ModuleId& module_id,
+                                            const std::string& verilog_module_name,
+                                            const std::map<ModuleId, std::vector<bool>>* kept_instances,
+                                            const bool& use_explicit_port_map,
+                                            const bool& use_packed_ports) {
+
+  VTR_ASSERT(true == valid_file_stream(fp));
+
+  /* Ensure we have a valid module_id */
+  VTR_ASSERT(module_manager.valid_module_id(module_id)); 
+
+  /* Net names and child ports are shared by the local wires and instances */
+  t_verilog_module_writer_cache cache;
+  init_verilog_module_writer_cache(cache, module_manager, module_id, kept_instances, use_packed_ports);
+
+  /* Print module declaration, with the packed ports if any */
+  const std::vector<BasicPort>* verilog_ports = nullptr;
+  if (cache.packed_ports.end() != cache.packed_ports.find(module_id)) {
+    verilog_ports = &(cache.packed_ports.at(module_id).verilog_ports);
+  }
+  print_verilog_module_declaration(fp, module_manager, module_id, verilog_module_name, verilog_ports);
+
+  /* Print an empty line as splitter */
+  fp << "\n";
+
+  /* Print internal wires */
+  std::map<std::string, std::vector<BasicPort>> local_wires = find_verilog_module_local_wires(module_manager, module_id, cache);
+  for (const std::pair<const std::string, std::vector<BasicPort>>& port_group : local_wires) {
+    for (const BasicPort& local_wire : port_group.second) {
+      fp << generate_verilog_port(VERILOG_PORT_WIRE, local_wire) << ";" << "\n";
+    }
+  }
+
+  /* Print an empty line as splitter */
+  fp << "\n";
+
+  /* Tie the inputs left undriven by the removed instances to logic '0' */
+  if (false == cache.undriven_input_wires.empty()) {
+    print_verilog_comment(fp, std::string("----- BEGIN Tie-off of the inputs driven by removed instances -----"));
+    for (const BasicPort& undriven_wire : cache.undriven_input_wires) {
+      print_verilog_wire_constant_values(fp, undriven_wire, std::vector<size_t>(undriven_wire.get_width(), 0));
+    }
+    print_verilog_comment(fp, std::string("----- END Tie-off of the inputs driven by removed instances -----"));
+    fp << "\n";
+  }
+
+  /* Print local connection (from module inputs to output! */
+  print_verilog_comment(fp, std::string("----- BEGIN Local short connections -----"));
+  print_verilog_module_local_short_connections(fp, module_manager, find_verilog_packed_ports(cache), module_id);
+  print_verilog_comment(fp, std::string("----- END Local short connections -----"));
+
+  print_verilog_comment(fp, std::string("----- BEGIN Local output short connections -----"));
+  print_verilog_module_output_short_connections(fp, module_manager, find_verilog_packed_ports(cache), module_id);
+ 
+  print_verilog_comment(fp, std::string("----- END Local output short connections -----"));
+  /* Print an empty line as splitter */
+  fp << "\n";
+
+  /* Print instances */
+  for (ModuleId child_module : module_manager.child_modules(module_id)) {
+    for (size_t instance : module_manager.child_module_instances(module_id, child_module)) {
+      if (false == is_verilog_instance_kept(cache, child_module, instance)) {
+        continue;
+      }
+      /* Print an instance */
+      write_verilog_instance_to_file(fp, module_manager, module_id, child_module, instance, cache, use_explicit_port_map); 
+      /* Print an empty line as splitter */
+      fp << "\n";
+    }
+  }
+
+  /* Print an end for the module */
+  print_verilog_module_end(fp, verilog_module_name); 
+
+  /* Print an empty line as splitter */
+  fp << "\n";
 }
 
 /********************************************************************
@@ -464,49 +972,487 @@ void write_verilog_instance_to_file(std::fstream& fp,
 void write_verilog_module_to_file(std::fstream& fp,
                                   const ModuleManager& module_manager,
                                   const ModuleId& module_id,
-                                  const bool& use_explicit_port_map) {
+                                  const bool& use_explicit_port_map,
+                                  const bool& use_packed_ports) {
+  write_verilog_module_instances_to_file(fp, module_manager, module_id,
+                                         module_manager.module_name(module_id),
+                                         nullptr,
+                                         use_explicit_port_map,
+                                         use_packed_ports); 
+}
+
+/********************************************************************
+ * Write a pruned copy of a Verilog module to a file, under another name
+ * The copy has the same ports as the module, but only the instances
+ * marked in kept_instances (indexed by the child modules and their instances).
+ * The instances of the child modules which are not listed are all written.
+ *
+ * The inputs of the written instances which are driven by removed instances
+ * are tied to logic '0', while the outputs of the module driven by removed
+ * instances are left undriven.
+ *******************************************************************/
+void write_verilog_pruned_module_to_file(std::fstream& fp,
+                                         const ModuleManager& module_manager,
+                                         const ModuleId& module_id,
+                                         const std::string& pruned_module_name,
+                                         const std::map<ModuleId, std::vector<bool>>& kept_instances,
+                                         const bool& use_explicit_port_map,
+                                         const bool& use_packed_ports) {
+  write_verilog_module_instances_to_file(fp, module_manager, module_id,
+                                         pruned_module_name,
+                                         &kept_instances,
+                                         use_explicit_port_map,
+                                         use_packed_ports); 
+}
+
+/********************************************************************
+ * The kinds of nets that a pin of an instance is connected to, 
+ * when instances are written in arrays
+ *******************************************************************/
+enum e_verilog_array_net_type {
+  VERILOG_ARRAY_NET_PORT,       /* a port of the parent module, indexed by pin */
+  VERILOG_ARRAY_NET_NAMED_WIRE, /* a local wire with a user-defined name, indexed by pin */
+  VERILOG_ARRAY_NET_WIRE_ARRAY, /* a local wire in the array of a child port, indexed by instance */
+  VERILOG_ARRAY_NET_UNDRIVEN    /* an undriven pin, indexed by pin */
+};
+
+struct t_verilog_array_pin_net {
+  e_verilog_array_net_type type;
+  std::string name;
+  /* The pin of a port or a named wire, or the instance of a wire array */
+  int index;
+  /* The pin of a wire array */
+  size_t pin;
+};
+
+/********************************************************************
+ * Generate the name of the wire array which collects
+ * the local wires driven by a port of all the instances of a child module
+ *******************************************************************/
+static 
+std::string generate_verilog_wire_array_name(const ModuleManager& module_manager, 
+                                             const ModuleId& child_module, 
+                                             const ModulePortId& child_port) {
+  return module_manager.module_name(child_module) + std::string("_") + module_manager.module_port(child_module, child_port).get_name();
+}
+
+/********************************************************************
+ * Find the net connected to a pin of an instance, 
+ * named in the same way as generate_verilog_port_for_module_net()
+ * except that local wires are elements of wire arrays
+ *******************************************************************/
+static 
+t_verilog_array_pin_net find_verilog_array_pin_net(const ModuleManager& module_manager,
+                                                   const ModuleId& module_id,
+                                                   const ModuleId& child_module,
+                                                   const size_t& instance_id,
+                                                   const ModulePortId& child_port_id,
+                                                   const size_t& child_pin) {
+  t_verilog_array_pin_net pin_net;
+  pin_net.pin = 0;
+
+  ModuleNetId net = module_manager.module_instance_port_net(module_id, child_module, instance_id, 
+                                                            child_port_id, child_pin);
+  if (ModuleNetId::INVALID() == net) {
+    pin_net.type = VERILOG_ARRAY_NET_UNDRIVEN;
+    pin_net.name = module_manager.module_port(child_module, child_port_id).get_name();
+    pin_net.index = int(child_pin);
+    return pin_net;
+  }
+
+  for (ModuleNetSrcId src_id : module_manager.module_net_sources(module_id, net)) {
+    if (module_id == module_manager.net_source_module(module_id, net, src_id)) {
+      pin_net.type = VERILOG_ARRAY_NET_PORT;
+      pin_net.name = module_manager.module_port(module_id, module_manager.net_source_port(module_id, net, src_id)).get_name();
+      pin_net.index = int(module_manager.net_source_pin(module_id, net, src_id));
+      return pin_net;
+    }
+  }
+  for (ModuleNetSinkId sink_id : module_manager.module_net_sinks(module_id, net)) {
+    if (module_id == module_manager.net_sink_module(module_id, net, sink_id)) {
+      pin_net.type = VERILOG_ARRAY_NET_PORT;
+      pin_net.name = module_manager.module_port(module_id, module_manager.net_sink_port(module_id, net, sink_id)).get_name();
+      pin_net.index = int(module_manager.net_sink_pin(module_id, net, sink_id));
+      return pin_net;
+    }
+  }
+
+  /* Each net must only one 1 source */ 
+  VTR_ASSERT(1 == module_manager.module_net_sources(module_id, net).size());
+  ModuleId net_src_module = module_manager.net_source_module(module_id, net, ModuleNetSrcId(0));
+  size_t net_src_instance = module_manager.net_source_instance(module_id, net, ModuleNetSrcId(0)); 
+  ModulePortId net_src_port = module_manager.net_source_port(module_id, net, ModuleNetSrcId(0)); 
+  size_t net_src_pin = module_manager.net_source_pin(module_id, net, ModuleNetSrcId(0)); 
+
+  if (false == module_manager.net_name(module_id, net).empty()) {
+    pin_net.type = VERILOG_ARRAY_NET_NAMED_WIRE;
+    pin_net.name = module_manager.net_name(module_id, net);
+    pin_net.index = int(net_src_pin);
+    return pin_net;
+  }
+
+  pin_net.type = VERILOG_ARRAY_NET_WIRE_ARRAY;
+  pin_net.name = generate_verilog_wire_array_name(module_manager, net_src_module, net_src_port);
+  pin_net.index = int(net_src_instance);
+  pin_net.pin = net_src_pin;
+  return pin_net;
+}
+
+/********************************************************************
+ * Find the increments of the pin nets between two instances
+ * Return false if the two instances can not be in the same array, i.e., 
+ * a pin is connected to a different kind of net or to a different wire 
+ *******************************************************************/
+static 
+bool find_verilog_array_pin_net_strides(const std::vector<t_verilog_array_pin_net>& pin_nets,
+                                        const std::vector<t_verilog_array_pin_net>& next_pin_nets,
+                                        std::vector<int>& strides) {
+  VTR_ASSERT(pin_nets.size() == next_pin_nets.size());
+  strides.resize(pin_nets.size());
+  for (size_t ipin = 0; ipin < pin_nets.size(); ++ipin) {
+    if ( (pin_nets[ipin].type != next_pin_nets[ipin].type)
+      || (pin_nets[ipin].name != next_pin_nets[ipin].name)
+      || (pin_nets[ipin].pin != next_pin_nets[ipin].pin) ) {
+      return false;
+    }
+    strides[ipin] = next_pin_nets[ipin].index - pin_nets[ipin].index;
+    /* Undriven pins are local to each instance */
+    if ( (VERILOG_ARRAY_NET_UNDRIVEN == pin_nets[ipin].type)
+      && (0 != strides[ipin]) ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/********************************************************************
+ * Generate the index of a net in an array of instances:
+ *   <index> + <stride> * <genvar>
+ *******************************************************************/
+static 
+std::string generate_verilog_array_index(const int& index,
+                                         const int& stride,
+                                         const std::string& genvar_name) {
+  if (0 == stride) {
+    return std::to_string(index);
+  }
+  std::string index_str = std::string("(") + std::to_string(index);
+  index_str += (0 < stride) ? std::string(" + ") : std::string(" - ");
+  if (1 != std::abs(stride)) {
+    index_str += std::to_string(std::abs(stride)) + std::string(" * ");
+  }
+  index_str += genvar_name + std::string(")");
+  return index_str;
+}
+
+/********************************************************************
+ * Generate the nets connected to the pins of a port of an instance
+ * Consecutive pins are merged into part-selects when possible.
+ * When the genvar name is not empty, the index of each net is 
+ * incremented by the stride of the pin for each instance of an array
+ *******************************************************************/
+static 
+std::string generate_verilog_array_port_nets(const std::vector<t_verilog_array_pin_net>& pin_nets,
+                                             const std::vector<int>& strides,
+                                             const size_t& first_pin,
+                                             const size_t& num_pins,
+                                             const std::string& undriven_wire_name,
+                                             const std::string& genvar_name) {
+  std::vector<std::string> net_strs;
+  size_t ipin = first_pin;
+  while (ipin < first_pin + num_pins) {
+    const t_verilog_array_pin_net& pin_net = pin_nets[ipin];
+    /* Find the pins which can be merged */
+    size_t num_merged = 1;
+    while (ipin + num_merged < first_pin + num_pins) {
+      const t_verilog_array_pin_net& next_pin_net = pin_nets[ipin + num_merged];
+      if ( (next_pin_net.type != pin_net.type)
+        || (next_pin_net.name != pin_net.name)
+        || (strides[ipin + num_merged] != strides[ipin]) ) {
+        break;
+      }
+      if (VERILOG_ARRAY_NET_WIRE_ARRAY == pin_net.type) {
+        if ( (next_pin_net.index != pin_net.index)
+          || (next_pin_net.pin != pin_net.pin + num_merged) ) {
+          break;
+        }
+      } else if (next_pin_net.index != pin_net.index + int(num_merged)) {
+        break;
+      }
+      num_merged++;
+    }
+
+    std::string net_str;
+    if (VERILOG_ARRAY_NET_WIRE_ARRAY == pin_net.type) {
+      net_str = pin_net.name + std::string("[") + generate_verilog_array_index(pin_net.index, strides[ipin], genvar_name) + std::string("]");
+      net_str += std::string("[") + std::to_string(pin_net.pin);
+      if (1 < num_merged) {
+        net_str += std::string(":") + std::to_string(pin_net.pin + num_merged - 1);
+      }
+      net_str += std::string("]");
+    } else {
+      if (VERILOG_ARRAY_NET_UNDRIVEN == pin_net.type) {
+        net_str = undriven_wire_name;
+      } else {
+        net_str = pin_net.name;
+      }
+      if (0 != strides[ipin]) {
+        net_str += std::string("[") + generate_verilog_array_index(pin_net.index, strides[ipin], genvar_name) + std::string(" +: ") + std::to_string(num_merged) + std::string("]");
+      } else if (1 < num_merged) {
+        net_str += std::string("[") + std::to_string(pin_net.index) + std::string(":") + std::to_string(pin_net.index + num_merged - 1) + std::string("]");
+      } else {
+        net_str += std::string("[") + std::to_string(pin_net.index) + std::string("]");
+      }
+    }
+    net_strs.push_back(net_str);
+    ipin += num_merged;
+  }
+
+  if (1 == net_strs.size()) {
+    return net_strs[0];
+  }
+  std::string port_nets_str("{");
+  for (size_t inet = 0; inet < net_strs.size(); ++inet) {
+    if (0 < inet) {
+      port_nets_str += std::string(", ");
+    }
+    port_nets_str += net_strs[inet];
+  }
+  port_nets_str += std::string("}");
+  return port_nets_str;
+}
+
+/********************************************************************
+ * Write an instance, or the instance in the generate loop of an array, 
+ * whose pins are connected to the given nets
+ *******************************************************************/
+static 
+void write_verilog_array_instance_to_file(std::fstream& fp,
+                                          const ModuleManager& module_manager,
+                                          const ModuleId& module_id,
+                                          const ModuleId& child_module,
+                                          const size_t& instance_id,
+                                          const std::vector<ModulePortId>& child_ports,
+                                          const std::vector<t_verilog_array_pin_net>& pin_nets,
+                                          const std::vector<int>& strides,
+                                          const std::string& genvar_name,
+                                          const std::string& indent,
+                                          const bool& use_explicit_port_map) {
+  /* The instance in a generate loop is named after the generate block */
+  std::string instance_name = module_manager.instance_name(module_id, child_module, instance_id);
+  if (false == genvar_name.empty()) {
+    instance_name = module_manager.module_name(child_module);
+  } else if (true == instance_name.empty()) {
+    instance_name = generate_instance_name(module_manager.module_name(child_module), instance_id);
+  }
+  fp << indent << module_manager.module_name(child_module) << " " << instance_name << " (" << "\n";
+
+  size_t first_pin = 0;
+  for (size_t iport = 0; iport < child_ports.size(); ++iport) {
+    BasicPort child_port = module_manager.module_port(child_module, child_ports[iport]);
+    if (0 != iport) {
+      fp << "," << "\n"; 
+    }
+    fp << indent << "\t";
+    if (true == use_explicit_port_map) {
+      fp << "." << child_port.get_name() << "(";
+    }
+    /* Undriven pins are connected to a wire local to the instance */
+    std::string undriven_wire_name = std::string("undriven_") + child_port.get_name();
+    if (true == genvar_name.empty()) {
+      undriven_wire_name = generate_verilog_undriven_local_wire_name(module_manager, module_id, child_module, instance_id, child_port.get_name());
+    }
+    fp << generate_verilog_array_port_nets(pin_nets, strides, first_pin, child_port.get_width(), undriven_wire_name, genvar_name);
+    if (true == use_explicit_port_map) {
+      fp << ")";
+    }
+    first_pin += child_port.get_width();
+  }
+  fp << ");" << "\n";
+}
+
+/********************************************************************
+ * Write a Verilog module to a file, where the instances of each child module
+ * which are connected in a regular way are written in arrays
+ *
+ * The local wires driven by a port of a child module are declared as 
+ * an array, whose elements are the instances of the child module:
+ *   wire [<lsb>:<msb>] <child_module_name>_<port_name> [0:<num_instances> - 1];
+ * A sequence of instances is written as an array by a generate loop, 
+ * if from one instance to the next,
+ * each pin is connected to the same wire array or port, and the indices of 
+ * the net are incremented by the same strides, e.g., 
+ * a row of switch blocks which are connected to the same kind of neighbours.
+ * The other instances, e.g., at the borders of a fabric, are written in full.
+ *
+ * Note that the instances in arrays are named after the generate blocks:
+ *   <child_module_name>_<first_instance_id>_array[<index>].<child_module_name>
+ * instead of the instance names given in the module manager
+ *******************************************************************/
+void write_verilog_module_with_arrays_to_file(std::fstream& fp,
+                                              const ModuleManager& module_manager,
+                                              const ModuleId& module_id,
+                                              const bool& use_explicit_port_map) {
 
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Ensure we have a valid module_id */
   VTR_ASSERT(module_manager.valid_module_id(module_id)); 
 
+  /* Find the nets of all the pins of each instance */
+  std::map<ModuleId, std::vector<ModulePortId>> child_ports;
+  std::map<ModuleId, std::vector<std::vector<t_verilog_array_pin_net>>> instance_pin_nets;
+  for (ModuleId child_module : module_manager.child_modules(module_id)) {
+    child_ports[child_module] = find_verilog_instance_ports(module_manager, child_module);
+    for (size_t instance : module_manager.child_module_instances(module_id, child_module)) {
+      std::vector<t_verilog_array_pin_net> pin_nets;
+      for (const ModulePortId& child_port_id : child_ports[child_module]) {
+        for (const size_t& child_pin : module_manager.module_port(child_module, child_port_id).pins()) {
+          pin_nets.push_back(find_verilog_array_pin_net(module_manager, module_id, child_module, instance, child_port_id, child_pin));
+        }
+      }
+      instance_pin_nets[child_module].push_back(pin_nets);
+    }
+  }
+
   /* Print module declaration */
   print_verilog_module_declaration(fp, module_manager, module_id);
 
   /* Print an empty line as splitter */
-  fp << std::endl;
-   
-  /* Print internal wires */
-  std::map<std::string, std::vector<BasicPort>> local_wires = find_verilog_module_local_wires(module_manager, module_id);
-  for (std::pair<std::string, std::vector<BasicPort>> port_group : local_wires) {
+  fp << "\n";
+
+  /* Print the wire arrays and the local wires with user-defined names */
+  std::map<std::string, std::vector<BasicPort>> named_wires;
+  std::map<ModuleId, std::vector<ModulePortId>> wire_array_ports;
+  for (ModuleNetId module_net : module_manager.module_nets(module_id)) {
+    if (false == module_net_is_local_wire(module_manager, module_id, module_net)) {
+      continue;
+    }
+    if (false == module_manager.net_name(module_id, module_net).empty()) {
+      BasicPort named_wire = generate_verilog_port_for_module_net(module_manager, module_id, module_net, nullptr);
+      bool merged = false;
+      for (BasicPort& local_wire : named_wires[named_wire.get_name()]) {
+        if (true == two_verilog_ports_mergeable(local_wire, named_wire)) {
+          local_wire = merge_two_verilog_ports(local_wire, named_wire);
+          merged = true;
+          break;
+        }
+      }
+      if (false == merged) {
+        named_wires[named_wire.get_name()].push_back(named_wire);
+      }
+      continue;
+    }
+    VTR_ASSERT(1 == module_manager.module_net_sources(module_id, module_net).size());
+    ModuleId net_src_module = module_manager.net_source_module(module_id, module_net, ModuleNetSrcId(0));
+    ModulePortId net_src_port = module_manager.net_source_port(module_id, module_net, ModuleNetSrcId(0)); 
+    std::vector<ModulePortId>& src_ports = wire_array_ports[net_src_module];
+    if (src_ports.end() == std::find(src_ports.begin(), src_ports.end(), net_src_port)) {
+      src_ports.push_back(net_src_port);
+    }
+  }
+  for (const auto& wire_array : wire_array_ports) {
+    for (const ModulePortId& src_port : wire_array.second) {
+      BasicPort wire_port = module_manager.module_port(wire_array.first, src_port);
+      wire_port.set_name(generate_verilog_wire_array_name(module_manager, wire_array.first, src_port));
+      fp << generate_verilog_port(VERILOG_PORT_WIRE, wire_port);
+      fp << " [0:" << module_manager.num_instance(module_id, wire_array.first) - 1 << "];" << "\n";
+    }
+  }
+  for (const auto& port_group : named_wires) {
     for (const BasicPort& local_wire : port_group.second) {
-      fp << generate_verilog_port(VERILOG_PORT_WIRE, local_wire) << ";" << std::endl;
+      fp << generate_verilog_port(VERILOG_PORT_WIRE, local_wire) << ";" << "\n";
     }
   }
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Print local connection (from module inputs to output! */
   print_verilog_comment(fp, std::string("----- BEGIN Local short connections -----"));
-  print_verilog_module_local_short_connections(fp, module_manager, module_id);
+  print_verilog_module_local_short_connections(fp, module_manager, nullptr, module_id);
   print_verilog_comment(fp, std::string("----- END Local short connections -----"));
 
   print_verilog_comment(fp, std::string("----- BEGIN Local output short connections -----"));
-  print_verilog_module_output_short_connections(fp, module_manager, module_id);
+  print_verilog_module_output_short_connections(fp, module_manager, nullptr, module_id);
  
   print_verilog_comment(fp, std::string("----- END Local output short connections -----"));
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
+
+  std::string genvar_name("iinst");
+  bool genvar_declared = false;
 
   /* Print instances */
   for (ModuleId child_module : module_manager.child_modules(module_id)) {
-    for (size_t instance : module_manager.child_module_instances(module_id, child_module)) {
-      /* Print an instance */
-      write_verilog_instance_to_file(fp, module_manager, module_id, child_module, instance, use_explicit_port_map); 
-      /* Print an empty line as splitter */
-      fp << std::endl;
+    const std::vector<std::vector<t_verilog_array_pin_net>>& pin_nets = instance_pin_nets[child_module];
+    std::vector<int> strides;
+    std::vector<int> next_strides;
+    size_t instance = 0;
+    while (instance < pin_nets.size()) {
+      /* Find the longest sequence of instances which are connected in the same way */
+      size_t num_array_insts = 1;
+      if ( (instance + 1 < pin_nets.size())
+        && (true == find_verilog_array_pin_net_strides(pin_nets[instance], pin_nets[instance + 1], strides)) ) {
+        num_array_insts = 2;
+        while ( (instance + num_array_insts < pin_nets.size())
+             && (true == find_verilog_array_pin_net_strides(pin_nets[instance + num_array_insts - 1], pin_nets[instance + num_array_insts], next_strides))
+             && (next_strides == strides) ) {
+          num_array_insts++;
+        }
+      }
+
+      if (1 == num_array_insts) {
+        /* Print the instance in full */
+        std::vector<int> zero_strides(pin_nets[instance].size(), 0);
+        for (const ModulePortId& child_port_id : child_ports[child_module]) {
+          BasicPort child_port = module_manager.module_port(child_module, child_port_id);
+          std::vector<size_t> undriven_pins;
+          for (size_t child_pin : child_port.pins()) {
+            if (ModuleNetId::INVALID() == module_manager.module_instance_port_net(module_id, child_module, instance, child_port_id, child_pin)) {
+              undriven_pins.push_back(child_pin);
+            }
+          }
+          if (false == undriven_pins.empty()) {
+            BasicPort undriven_port(generate_verilog_undriven_local_wire_name(module_manager, module_id, child_module, instance, 
+                                                                              module_manager.module_port(child_module, child_port_id).get_name()),
+                                    *std::min_element(undriven_pins.begin(), undriven_pins.end()),
+                                    *std::max_element(undriven_pins.begin(), undriven_pins.end()));
+            fp << generate_verilog_port(VERILOG_PORT_WIRE, undriven_port) << ";" << "\n";
+          }
+        }
+        write_verilog_array_instance_to_file(fp, module_manager, module_id, child_module, instance,
+                                             child_ports[child_module], pin_nets[instance], zero_strides,
+                                             std::string(), std::string("\t"), use_explicit_port_map); 
+        fp << "\n";
+        instance++;
+        continue;
+      }
+
+      /* Print the instances in a generate loop */
+      if (false == genvar_declared) {
+        fp << "\tgenvar " << genvar_name << ";" << "\n";
+        genvar_declared = true;
+      }
+      fp << "\tgenerate" << "\n";
+      fp << "\tfor (" << genvar_name << " = 0; " << genvar_name << " < " << num_array_insts << "; " << genvar_name << " = " << genvar_name << " + 1) begin : ";
+      fp << generate_instance_name(module_manager.module_name(child_module), instance) << "array" << "\n";
+      for (const ModulePortId& child_port_id : child_ports[child_module]) {
+        BasicPort child_port = module_manager.module_port(child_module, child_port_id);
+        for (size_t child_pin : child_port.pins()) {
+          if (ModuleNetId::INVALID() == module_manager.module_instance_port_net(module_id, child_module, instance, child_port_id, child_pin)) {
+            fp << "\t\t" << generate_verilog_port(VERILOG_PORT_WIRE, BasicPort(std::string("undriven_") + child_port.get_name(), child_port.get_lsb(), child_port.get_msb())) << ";" << "\n";
+            break;
+          }
+        }
+      }
+      write_verilog_array_instance_to_file(fp, module_manager, module_id, child_module, instance,
+                                           child_ports[child_module], pin_nets[instance], strides,
+                                           genvar_name, std::string("\t\t"), use_explicit_port_map); 
+      fp << "\tend" << "\n";
+      fp << "\tendgenerate" << "\n";
+      fp << "\n";
+      instance += num_array_insts;
     }
   }
 
@@ -514,7 +1460,7 @@ void write_verilog_module_to_file(std::fstream& fp,
   print_verilog_module_end(fp, module_manager.module_name(module_id)); 
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 } /* end namespace openfpga */
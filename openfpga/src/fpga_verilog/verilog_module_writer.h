@@ -5,6 +5,9 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <fstream>
+#include <map>
+#include <string>
+#include <vector>
 #include "module_manager.h"
 
 /********************************************************************
@@ -17,7 +20,21 @@ namespace openfpga {
 void write_verilog_module_to_file(std::fstream& fp,
                                   const ModuleManager& module_manager,
                                   const ModuleId& module_id,
-                                  const bool& use_explicit_port_map);
+                                  const bool& use_explicit_port_map,
+                                  const bool& use_packed_ports = false);
+
+void write_verilog_pruned_module_to_file(std::fstream& fp,
+                                         const ModuleManager& module_manager,
+                                         const ModuleId& module_id,
+                                         const std::string& pruned_module_name,
+                                         const std::map<ModuleId, std::vector<bool>>& kept_instances,
+                                         const bool& use_explicit_port_map,
+                                         const bool& use_packed_ports = false);
+
+void write_verilog_module_with_arrays_to_file(std::fstream& fp,
+                                              const ModuleManager& module_manager,
+                                              const ModuleId& module_id,
+                                              const bool& use_explicit_port_map);
 
 } /* end namespace openfpga */
 
@@ -6,6 +6,7 @@
  * and the full multiplexer
  **********************************************/
 #include <string>
+#include <vector>
 #include <algorithm>
 
 /* Headers from vtrutil library */
@@ -57,11 +58,11 @@ void generate_verilog_cmos_mux_branch_body_behavioral(std::fstream& fp,
   /* Add an internal register for the output */
   BasicPort outreg_port("out_reg", mux_graph.num_outputs());
   /* Print the port */
-  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, outreg_port) << ";" << std::endl; 
+  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, outreg_port) << ";" << "\n"; 
 
   /* Generate the case-switch table */
-  fp << "\talways @(" << generate_verilog_port(VERILOG_PORT_CONKT, input_port) << ", " << generate_verilog_port(VERILOG_PORT_CONKT, mem_port) << ")" << std::endl; 
-  fp << "\tcase (" << generate_verilog_port(VERILOG_PORT_CONKT, mem_port) << ")" << std::endl;
+  fp << "\talways @(" << generate_verilog_port(VERILOG_PORT_CONKT, input_port) << ", " << generate_verilog_port(VERILOG_PORT_CONKT, mem_port) << ")" << "\n"; 
+  fp << "\tcase (" << generate_verilog_port(VERILOG_PORT_CONKT, mem_port) << ")" << "\n";
 
   /* Output the netlist following the connections in mux_graph */
   /* Iterate over the inputs */
@@ -92,21 +93,21 @@ void generate_verilog_cmos_mux_branch_body_behavioral(std::fstream& fp,
         case_code[size_t(mux_mem)] = '0';
       }
       fp << case_code << ": " << generate_verilog_port(VERILOG_PORT_CONKT, outreg_port) << " <= ";
-      fp << generate_verilog_port(VERILOG_PORT_CONKT, cur_input_port) << ";" << std::endl;
+      fp << generate_verilog_port(VERILOG_PORT_CONKT, cur_input_port) << ";" << "\n";
     }
   }
 
   /* Default case: outputs are at high-impedance state 'z' */
   std::string default_case(mux_graph.num_outputs(), 'z');
   fp << "\t\tdefault: " << generate_verilog_port(VERILOG_PORT_CONKT, outreg_port) << " <= ";
-  fp << mux_graph.num_outputs() << "'b" << default_case << ";" << std::endl;
+  fp << mux_graph.num_outputs() << "'b" << default_case << ";" << "\n";
 
   /* End the case */
-  fp << "\tendcase" << std::endl;
+  fp << "\tendcase" << "\n";
 
   /* Wire registers to output ports */
   fp << "\tassign " << generate_verilog_port(VERILOG_PORT_CONKT, output_port) << " = ";
-  fp << generate_verilog_port(VERILOG_PORT_CONKT, outreg_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_CONKT, outreg_port) << ";" << "\n";
 }
 
 /*********************************************************************
@@ -409,7 +410,7 @@ void generate_verilog_rram_mux_branch_body_behavioral(std::fstream& fp,
   /* Add an internal register for the output */
   BasicPort outreg_port("out_reg", mux_graph.num_inputs());
   /* Print the port */
-  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, outreg_port) << ";" << std::endl; 
+  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, outreg_port) << ";" << "\n"; 
 
   /* Print the internal logics */
   fp << "\t" << "always @(";
@@ -417,7 +418,7 @@ void generate_verilog_rram_mux_branch_body_behavioral(std::fstream& fp,
   fp << ", ";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, wl_port); 
   fp << ")";
-  fp << " begin" << std::endl;
+  fp << " begin" << "\n";
 
   /* Only when the last bit of wl is enabled, 
    * the propagating path can be changed 
@@ -463,7 +464,7 @@ void generate_verilog_rram_mux_branch_body_behavioral(std::fstream& fp,
   }
 
   /* Finish the if clause */
-  fp << ") begin" << std::endl;
+  fp << ") begin" << "\n";
 
   for (const auto& mux_input : mux_graph.inputs()) {
     /* First if clause need tabs */
@@ -474,26 +475,26 @@ void generate_verilog_rram_mux_branch_body_behavioral(std::fstream& fp,
     /* Create a temp port of a BLB bit */
     BasicPort cur_blb_port(blb_port.get_name(), size_t(mux_graph.input_id(mux_input)), size_t(mux_graph.input_id(mux_input)));
     fp << generate_verilog_port(VERILOG_PORT_CONKT, cur_blb_port); 
-    fp << ") begin" << std::endl;
+    fp << ") begin" << "\n";
     fp << "\t\t\t\t" << "assign ";
   fp << outreg_port.get_name(); 
-    fp << " = " << size_t(mux_graph.input_id(mux_input)) << ";" << std::endl;
+    fp << " = " << size_t(mux_graph.input_id(mux_input)) << ";" << "\n";
     fp << "\t\t\t" << "end else ";
   }
-  fp << "begin" << std::endl;
+  fp << "begin" << "\n";
   fp << "\t\t\t\t" << "assign ";
   fp << outreg_port.get_name(); 
-  fp << " = 0;" << std::endl;
-  fp << "\t\t\t" << "end" << std::endl;
-  fp << "\t\t" << "end" << std::endl;
-  fp << "\t" << "end" << std::endl;
+  fp << " = 0;" << "\n";
+  fp << "\t\t\t" << "end" << "\n";
+  fp << "\t\t" << "end" << "\n";
+  fp << "\t" << "end" << "\n";
  
   fp << "\t" << "assign ";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, output_port);
   fp << " = "; 
   fp << input_port.get_name() << "[";
   fp << outreg_port.get_name(); 
-  fp << "];" << std::endl;
+  fp << "];" << "\n";
 }
 
 /*********************************************************************
@@ -602,7 +603,7 @@ void generate_verilog_mux_branch_module(ModuleManager& module_manager,
       write_verilog_module_to_file(fp, module_manager, mux_module, 
                                    use_explicit_port_map || circuit_lib.dump_explicit_port_map(mux_model));
       /* Add an empty line as a splitter */
-      fp << std::endl;
+      fp << "\n";
     } else {
       /* Behavioral verilog requires customized generation */
       print_verilog_cmos_mux_branch_module_behavioral(module_manager, circuit_lib, fp, mux_model, module_name, mux_graph);
@@ -680,7 +681,7 @@ void generate_verilog_cmos_mux_module_input_buffers(ModuleManager& module_manage
       print_verilog_comment(fp, std::string("---- BEGIN short-wire a multiplexing structure input to a constant value -----"));
       print_verilog_wire_constant_values(fp, instance_output_port, std::vector<size_t>(1, const_value));
       print_verilog_comment(fp, std::string("---- END short-wire a multiplexing structure input to a constant value -----"));
-      fp << std::endl;
+      fp << "\n";
       continue; /* Finish here */
     }
 
@@ -692,7 +693,7 @@ void generate_verilog_cmos_mux_module_input_buffers(ModuleManager& module_manage
       print_verilog_wire_connection(fp, instance_output_port, instance_input_port, false);      
 
       print_verilog_comment(fp, std::string("---- END short-wire a multiplexing structure input to MUX module input -----"));
-      fp << std::endl;
+      fp << "\n";
       continue; /* Finish here */
     }
 
@@ -707,7 +708,7 @@ void generate_verilog_cmos_mux_module_input_buffers(ModuleManager& module_manage
     print_verilog_buffer_instance(fp, module_manager, circuit_lib, module_id, buffer_model, instance_input_port, instance_output_port);
 
     print_verilog_comment(fp, std::string("---- END Instanciation of an input buffer module -----"));
-    fp << std::endl;
+    fp << "\n";
   } 
 }
 
@@ -771,7 +772,7 @@ void generate_verilog_cmos_mux_module_output_buffers(ModuleManager& module_manag
         print_verilog_wire_connection(fp, instance_output_port, instance_input_port, false);      
 
         print_verilog_comment(fp, std::string("---- END short-wire a multiplexing structure output to MUX module output -----"));
-        fp << std::endl;
+        fp << "\n";
         continue; /* Finish here */
       }
 
@@ -786,7 +787,7 @@ void generate_verilog_cmos_mux_module_output_buffers(ModuleManager& module_manag
       print_verilog_buffer_instance(fp, module_manager, circuit_lib, module_id, buffer_model, instance_input_port, instance_output_port);
 
       print_verilog_comment(fp, std::string("---- END Instanciation of an output buffer module -----"));
-      fp << std::endl;
+      fp << "\n";
     }
   }
 }
@@ -829,16 +830,16 @@ void generate_verilog_rram_mux_module_multiplexing_structure(ModuleManager& modu
   for (size_t level = 0; level < mux_graph.num_levels(); ++level) {
     /* Print the internal wires located at this level */
     BasicPort internal_wire_port(generate_mux_node_name(level, false), mux_graph.num_nodes_at_level(level));
-    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, internal_wire_port) << ";" << std::endl;
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, internal_wire_port) << ";" << "\n";
     /* Identify if an intermediate buffer is needed */
     if (false == inter_buffer_location_map[level]) { 
       continue;
     }
     BasicPort internal_wire_buffered_port(generate_mux_node_name(level, true), mux_graph.num_nodes_at_level(level));
-    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, internal_wire_buffered_port) << std::endl;
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, internal_wire_buffered_port) << "\n";
   }
   print_verilog_comment(fp, std::string("---- END Internal wires of a RRAM-based MUX module -----"));
-  fp << std::endl;
+  fp << "\n";
 
   /* Iterate over all the internal nodes and output nodes in the mux graph */
   for (const auto& node : mux_graph.non_input_nodes()) {
@@ -903,7 +904,7 @@ void generate_verilog_rram_mux_module_multiplexing_structure(ModuleManager& modu
      * output a local wire */
     if (1 < combine_verilog_ports(branch_node_input_ports).size()) {
       /* Print a local wire for the merged ports */
-      fp << "\t" << generate_verilog_local_wire(instance_input_port, branch_node_input_ports) << std::endl;
+      fp << "\t" << generate_verilog_local_wire(instance_input_port, branch_node_input_ports) << "\n";
     } else {
       /* Safety check */
       VTR_ASSERT(1 == combine_verilog_ports(branch_node_input_ports).size());
@@ -955,7 +956,7 @@ void generate_verilog_rram_mux_module_multiplexing_structure(ModuleManager& modu
      * output a local wire */
     if (1 < combine_verilog_ports(branch_node_blb_ports).size()) {
       /* Print a local wire for the merged ports */
-      fp << "\t" << generate_verilog_local_wire(instance_blb_port, branch_node_blb_ports) << std::endl;
+      fp << "\t" << generate_verilog_local_wire(instance_blb_port, branch_node_blb_ports) << "\n";
     } else {
       /* Safety check */
       VTR_ASSERT(1 == combine_verilog_ports(branch_node_blb_ports).size());
@@ -996,7 +997,7 @@ void generate_verilog_rram_mux_module_multiplexing_structure(ModuleManager& modu
      * output a local wire */
     if (1 < combine_verilog_ports(branch_node_wl_ports).size()) {
       /* Print a local wire for the merged ports */
-      fp << "\t" << generate_verilog_local_wire(instance_wl_port, branch_node_wl_ports) << std::endl;
+      fp << "\t" << generate_verilog_local_wire(instance_wl_port, branch_node_wl_ports) << "\n";
     } else {
       /* Safety check */
       VTR_ASSERT(1 == combine_verilog_ports(branch_node_wl_ports).size());
@@ -1017,7 +1018,7 @@ void generate_verilog_rram_mux_module_multiplexing_structure(ModuleManager& modu
     module_manager.add_child_module(module_id, branch_module_id);
 
     print_verilog_comment(fp, std::string("---- END Instanciation of a branch RRAM-based MUX module -----"));
-    fp << std::endl;
+    fp << "\n";
 
     if (false == inter_buffer_location_map[output_node_level]) {
       continue; /* No need for intermediate buffers */
@@ -1036,11 +1037,11 @@ void generate_verilog_rram_mux_module_multiplexing_structure(ModuleManager& modu
     print_verilog_buffer_instance(fp, module_manager, circuit_lib, module_id, buffer_model, buffer_instance_input_port, buffer_instance_output_port);
 
     print_verilog_comment(fp, std::string("---- END Instanciation of an intermediate buffer module -----"));
-    fp << std::endl;
+    fp << "\n";
   }
 
   print_verilog_comment(fp, std::string("---- END Internal Logic of a RRAM-based MUX module -----"));
-  fp << std::endl;
+  fp << "\n";
 }
 
 /*********************************************************************
@@ -1203,7 +1204,7 @@ void generate_verilog_mux_module(ModuleManager& module_manager,
                                  || circuit_lib.dump_explicit_port_map(circuit_lib.pass_gate_logic_model(mux_model)) ) 
                                  );
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
     break;
   }
   case CIRCUIT_MODEL_DESIGN_RRAM:
@@ -1219,6 +1220,241 @@ void generate_verilog_mux_module(ModuleManager& module_manager,
 }
 
 
+/***********************************************
+ * Identify if the multiplexers of a circuit model
+ * can be modeled by a parameterized Verilog module
+ * Only the CMOS multiplexers of routing and local 
+ * interconnection with a single output
+ * and without local encoders are supported.
+ * The others are always written in full
+ **********************************************/
+static 
+bool is_verilog_parameterized_mux(const CircuitLibrary& circuit_lib, 
+                                  const CircuitModelId& mux_model) {
+  return (CIRCUIT_MODEL_DESIGN_CMOS == circuit_lib.design_tech_type(mux_model))
+      && (CIRCUIT_MODEL_MUX == circuit_lib.model_type(mux_model))
+      && (false == circuit_lib.mux_use_local_encoder(mux_model));
+}
+
+/***********************************************
+ * Recursively find the edges from each input
+ * to a node of a mux graph, along with the level 
+ * of the node each edge drives
+ **********************************************/
+static 
+void rec_find_mux_graph_input_paths(const MuxGraph& mux_graph, 
+                                    const MuxNodeId& node,
+                                    std::vector<std::pair<size_t, MuxEdgeId>>& path,
+                                    vtr::vector<MuxInputId, std::vector<std::pair<size_t, MuxEdgeId>>>& input_paths) {
+  if (true == mux_graph.is_node_input(node)) {
+    input_paths[mux_graph.input_id(node)] = path;
+    return;
+  }
+
+  for (const MuxEdgeId& edge : mux_graph.node_in_edges(node)) {
+    path.push_back(std::make_pair(mux_graph.node_level(node), edge));
+    for (const MuxNodeId& src_node : mux_graph.edge_src_nodes(edge)) {
+      rec_find_mux_graph_input_paths(mux_graph, src_node, path, input_paths);
+    }
+    path.pop_back();
+  }
+}
+
+/***********************************************
+ * Find the number of bits to index a memory bit
+ * of a parameterized multiplexer
+ **********************************************/
+static 
+size_t find_verilog_parameterized_mux_mem_addr_width(const MuxGraph& mux_graph) {
+  size_t addr_width = 1;
+  while ((size_t(1) << addr_width) < mux_graph.num_memory_bits()) {
+    addr_width++;
+  }
+  return addr_width;
+}
+
+/***********************************************
+ * Generate a parameterized Verilog module for 
+ * all the multiplexers of a circuit model
+ *
+ * The path from each input to the output 
+ * is described by a parameter, which includes
+ * an entry for each level of the multiplexer:
+ *   ENTRY[MEM_ADDR_WIDTH + 1]: the input passes a branch at this level
+ *   ENTRY[MEM_ADDR_WIDTH]: the branch is enabled by an inverted memory bit
+ *   ENTRY[MEM_ADDR_WIDTH - 1:0]: the memory bit enabling the branch
+ * An input is propagated to the output when all the branches 
+ * on its path are enabled, which is expanded by generate loops 
+ * over the inputs and levels.
+ * The module is behavioral: buffers are modeled by inversions 
+ **********************************************/
+static 
+void print_verilog_parameterized_mux_module(const CircuitLibrary& circuit_lib, 
+                                            std::fstream& fp, 
+                                            const CircuitModelId& mux_model) {
+  /* Make sure we have a valid file handler*/
+  VTR_ASSERT(true == valid_file_stream(fp));
+
+  std::vector<CircuitPortId> mux_input_ports = circuit_lib.model_ports_by_type(mux_model, CIRCUIT_MODEL_PORT_INPUT, true);
+  std::vector<CircuitPortId> mux_output_ports = circuit_lib.model_ports_by_type(mux_model, CIRCUIT_MODEL_PORT_OUTPUT, false);
+  std::vector<CircuitPortId> mux_sram_ports = find_circuit_regular_sram_ports(circuit_lib, mux_model);
+  VTR_ASSERT(1 == mux_input_ports.size());
+  VTR_ASSERT(1 == mux_output_ports.size());
+  VTR_ASSERT(1 == mux_sram_ports.size());
+
+  std::string in_name = circuit_lib.port_prefix(mux_input_ports[0]);
+  std::string out_name = circuit_lib.port_prefix(mux_output_ports[0]);
+  std::string sram_name = circuit_lib.port_prefix(mux_sram_ports[0]);
+
+  std::string module_name = generate_mux_parameterized_subckt_name(circuit_lib, mux_model);
+
+  print_verilog_comment(fp, std::string("----- Verilog module for " + module_name + " -----"));
+  fp << "module " << module_name << " #(parameter NUM_INPUTS = 2," << "\n";
+  fp << "\t\tparameter NUM_MEMS = 1," << "\n";
+  fp << "\t\tparameter NUM_LEVELS = 1," << "\n";
+  fp << "\t\tparameter MEM_ADDR_WIDTH = 1," << "\n";
+  fp << "\t\tparameter [NUM_INPUTS * NUM_LEVELS * (MEM_ADDR_WIDTH + 2) - 1:0] PATH_MEMS = 0," << "\n";
+  fp << "\t\tparameter [0:0] INVERT_INPUTS = 1'b0," << "\n";
+  fp << "\t\tparameter [0:0] INVERT_OUTPUT = 1'b0) (" << "\n";
+  fp << "\t\tinput [0:NUM_INPUTS - 1] " << in_name << "," << "\n";
+  fp << "\t\tinput [0:NUM_MEMS - 1] " << sram_name << "," << "\n";
+  fp << "\t\toutput " << out_name << ");" << "\n";
+  fp << "\n";
+
+  fp << "\tlocalparam ENTRY_WIDTH = MEM_ADDR_WIDTH + 2;" << "\n";
+  fp << "\n";
+  fp << "\twire [0:NUM_INPUTS - 1] path_enable;" << "\n";
+  fp << "\n";
+  fp << "\tgenvar iin, ilvl;" << "\n";
+  fp << "\tgenerate" << "\n";
+  fp << "\t\tfor (iin = 0; iin < NUM_INPUTS; iin = iin + 1) begin : input_path" << "\n";
+  fp << "\t\t\twire [0:NUM_LEVELS] level_enable;" << "\n";
+  fp << "\t\t\tassign level_enable[0] = 1'b1;" << "\n";
+  fp << "\t\t\tfor (ilvl = 0; ilvl < NUM_LEVELS; ilvl = ilvl + 1) begin : level" << "\n";
+  fp << "\t\t\t\tlocalparam [ENTRY_WIDTH - 1:0] ENTRY = PATH_MEMS[(iin * NUM_LEVELS + ilvl) * ENTRY_WIDTH +: ENTRY_WIDTH];" << "\n";
+  fp << "\t\t\t\tif (1'b0 == ENTRY[MEM_ADDR_WIDTH + 1]) begin : bypass" << "\n";
+  fp << "\t\t\t\t\tassign level_enable[ilvl + 1] = level_enable[ilvl];" << "\n";
+  fp << "\t\t\t\tend else if (1'b1 == ENTRY[MEM_ADDR_WIDTH]) begin : inv_mem" << "\n";
+  fp << "\t\t\t\t\tassign level_enable[ilvl + 1] = level_enable[ilvl] & ~" << sram_name << "[ENTRY[MEM_ADDR_WIDTH - 1:0]];" << "\n";
+  fp << "\t\t\t\tend else begin : mem" << "\n";
+  fp << "\t\t\t\t\tassign level_enable[ilvl + 1] = level_enable[ilvl] & " << sram_name << "[ENTRY[MEM_ADDR_WIDTH - 1:0]];" << "\n";
+  fp << "\t\t\t\tend" << "\n";
+  fp << "\t\t\tend" << "\n";
+  fp << "\t\t\tassign path_enable[iin] = level_enable[NUM_LEVELS];" << "\n";
+  fp << "\t\tend" << "\n";
+  fp << "\tendgenerate" << "\n";
+  fp << "\n";
+  fp << "\tassign " << out_name << " = INVERT_OUTPUT ^ (|((" << in_name << " ^ {NUM_INPUTS{INVERT_INPUTS}}) & path_enable));" << "\n";
+  fp << "\n";
+
+  print_verilog_module_end(fp, module_name);
+}
+
+/***********************************************
+ * Generate a Verilog module of a multiplexer 
+ * with the given graph-level description,
+ * which instanciates the parameterized module 
+ * of its circuit model
+ * The ports are the same as the module built in module manager,
+ * so that the module can be instanciated by the fabric as is
+ **********************************************/
+static 
+void print_verilog_parameterized_mux_instance_module(const ModuleManager& module_manager,
+                                                     const CircuitLibrary& circuit_lib, 
+                                                     std::fstream& fp, 
+                                                     const CircuitModelId& mux_model, 
+                                                     const MuxGraph& mux_graph) {
+  /* Make sure we have a valid file handler*/
+  VTR_ASSERT(true == valid_file_stream(fp));
+
+  size_t num_inputs = find_mux_num_datapath_inputs(circuit_lib, mux_model, mux_graph.num_inputs());
+  std::string module_name = generate_mux_subckt_name(circuit_lib, mux_model, num_inputs, std::string(""));
+  ModuleId mux_module = module_manager.find_module(module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(mux_module));
+
+  std::vector<CircuitPortId> mux_input_ports = circuit_lib.model_ports_by_type(mux_model, CIRCUIT_MODEL_PORT_INPUT, true);
+  std::vector<CircuitPortId> mux_output_ports = circuit_lib.model_ports_by_type(mux_model, CIRCUIT_MODEL_PORT_OUTPUT, false);
+  std::vector<CircuitPortId> mux_sram_ports = find_circuit_regular_sram_ports(circuit_lib, mux_model);
+  VTR_ASSERT(1 == mux_graph.num_outputs());
+
+  /* Find the path of each input */
+  size_t num_levels = mux_graph.num_node_levels() - 1;
+  size_t mem_addr_width = find_verilog_parameterized_mux_mem_addr_width(mux_graph);
+  size_t entry_width = mem_addr_width + 2;
+
+  vtr::vector<MuxInputId, std::vector<std::pair<size_t, MuxEdgeId>>> input_paths(mux_graph.num_inputs());
+  std::vector<std::pair<size_t, MuxEdgeId>> path;
+  rec_find_mux_graph_input_paths(mux_graph, mux_graph.node_id(MuxOutputId(0)), path, input_paths);
+
+  /* Pack the entries of all the paths, where bit 0 is the LSB of the parameter */
+  std::vector<bool> path_mem_bits(mux_graph.num_inputs() * num_levels * entry_width, false);
+  for (const MuxNodeId& input_node : mux_graph.inputs()) {
+    MuxInputId input_id = mux_graph.input_id(input_node);
+    for (const std::pair<size_t, MuxEdgeId>& level_edge : input_paths[input_id]) {
+      VTR_ASSERT((0 < level_edge.first) && (level_edge.first <= num_levels));
+      size_t entry_lsb = (size_t(input_id) * num_levels + level_edge.first - 1) * entry_width;
+      size_t mem = size_t(mux_graph.find_edge_mem(level_edge.second));
+      for (size_t ibit = 0; ibit < mem_addr_width; ++ibit) {
+        path_mem_bits[entry_lsb + ibit] = (0 != (mem & (size_t(1) << ibit)));
+      }
+      path_mem_bits[entry_lsb + mem_addr_width] = mux_graph.is_edge_use_inv_mem(level_edge.second);
+      path_mem_bits[entry_lsb + mem_addr_width + 1] = true;
+    }
+  }
+
+  /* Print the packed bits in hexadecimal, starting from the MSB */
+  std::string path_mems = std::to_string(path_mem_bits.size()) + std::string("'h");
+  for (size_t inibble = (path_mem_bits.size() + 3) / 4; inibble > 0; --inibble) {
+    size_t nibble = 0;
+    for (size_t ibit = 0; ibit < 4; ++ibit) {
+      size_t bit_index = (inibble - 1) * 4 + ibit;
+      if ((bit_index < path_mem_bits.size()) && (true == path_mem_bits[bit_index])) {
+        nibble |= (size_t(1) << ibit);
+      }
+    }
+    path_mems += "0123456789abcdef"[nibble];
+  }
+
+  /* Buffers are modeled by inversions on the inputs and outputs */
+  bool invert_inputs = (true == circuit_lib.is_input_buffered(mux_model))
+                    && (CIRCUIT_MODEL_BUF_INV == circuit_lib.buffer_type(circuit_lib.input_buffer_model(mux_model)));
+  bool invert_output = (true == circuit_lib.is_output_buffered(mux_model))
+                    && (CIRCUIT_MODEL_BUF_INV == circuit_lib.buffer_type(circuit_lib.output_buffer_model(mux_model)));
+
+  /* The constant input is not buffered, so it is inverted here to cancel the inversion of the inputs */
+  std::string input_conkt = generate_verilog_port(VERILOG_PORT_CONKT, module_manager.module_port(mux_module, module_manager.find_module_port(mux_module, circuit_lib.port_prefix(mux_input_ports[0]))));
+  if (true == circuit_lib.mux_add_const_input(mux_model)) {
+    size_t const_value = circuit_lib.mux_const_input_value(mux_model);
+    VTR_ASSERT( (0 == const_value) || (1 == const_value) ); 
+    input_conkt = std::string("{") + input_conkt + std::string(", 1'b") + std::to_string(const_value ^ size_t(invert_inputs)) + std::string("}");
+  }
+  std::string sram_conkt = generate_verilog_port(VERILOG_PORT_CONKT, module_manager.module_port(mux_module, module_manager.find_module_port(mux_module, circuit_lib.port_prefix(mux_sram_ports[0]))));
+  std::string output_conkt = generate_verilog_port(VERILOG_PORT_CONKT, module_manager.module_port(mux_module, module_manager.find_module_port(mux_module, circuit_lib.port_prefix(mux_output_ports[0]))));
+
+  print_verilog_module_declaration(fp, module_manager, mux_module);
+  fp << "\n";
+
+  std::string param_module_name = generate_mux_parameterized_subckt_name(circuit_lib, mux_model);
+  fp << "\t" << param_module_name << " #(" << "\n";
+  fp << "\t\t.NUM_INPUTS(" << mux_graph.num_inputs() << ")," << "\n";
+  fp << "\t\t.NUM_MEMS(" << mux_graph.num_memory_bits() << ")," << "\n";
+  fp << "\t\t.NUM_LEVELS(" << num_levels << ")," << "\n";
+  fp << "\t\t.MEM_ADDR_WIDTH(" << mem_addr_width << ")," << "\n";
+  fp << "\t\t.PATH_MEMS(" << path_mems << ")," << "\n";
+  fp << "\t\t.INVERT_INPUTS(1'b" << invert_inputs << ")," << "\n";
+  fp << "\t\t.INVERT_OUTPUT(1'b" << invert_output << ")" << "\n";
+  fp << "\t) " << generate_instance_name(param_module_name, 0) << " (" << "\n";
+  fp << "\t\t." << circuit_lib.port_prefix(mux_input_ports[0]) << "(" << input_conkt << ")," << "\n";
+  fp << "\t\t." << circuit_lib.port_prefix(mux_sram_ports[0]) << "(" << sram_conkt << ")," << "\n";
+  fp << "\t\t." << circuit_lib.port_prefix(mux_output_ports[0]) << "(" << output_conkt << "));" << "\n";
+  fp << "\n";
+
+  print_verilog_module_end(fp, module_name);
+
+  /* Add an empty line as a splitter */
+  fp << "\n";
+}
+
 /***********************************************
  * Generate Verilog modules for all the unique
  * multiplexers in the FPGA device
@@ -1228,12 +1464,14 @@ void print_verilog_submodule_muxes(ModuleManager& module_manager,
                                    const MuxLibrary& mux_lib,
                                    const CircuitLibrary& circuit_lib,
                                    const std::string& submodule_dir,
-                                   const bool& use_explicit_port_map) {
+                                   const bool& use_explicit_port_map,
+                                   const bool& parameterized_mux,
+                                   const bool& incremental) {
 
   std::string verilog_fname(submodule_dir + std::string(MUXES_VERILOG_FILE_NAME));
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(incremental, std::string(VERILOG_FILE_HEADER_TIME_STAMP_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
@@ -1248,6 +1486,11 @@ void print_verilog_submodule_muxes(ModuleManager& module_manager,
   for (auto mux : mux_lib.muxes()) {
     const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
     CircuitModelId mux_circuit_model = mux_lib.mux_circuit_model(mux); 
+    /* Branch circuits are not used by parameterized multiplexers */
+    if ( (true == parameterized_mux)
+      && (true == is_verilog_parameterized_mux(circuit_lib, mux_circuit_model)) ) {
+      continue;
+    }
     /* Create a mux graph for the branch circuit */
     std::vector<MuxGraph> branch_mux_graphs = mux_graph.build_mux_branch_graphs();
     /* Create branch circuits, which are N:1 one-level or 2:1 tree-like MUXes */
@@ -1259,9 +1502,20 @@ void print_verilog_submodule_muxes(ModuleManager& module_manager,
   }
 
   /* Generate unique Verilog modules for the multiplexers */
+  std::vector<CircuitModelId> param_mux_models;
   for (auto mux : mux_lib.muxes()) {
     const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
     CircuitModelId mux_circuit_model = mux_lib.mux_circuit_model(mux); 
+    /* Instanciate the parameterized module, which is printed once for each circuit model */
+    if ( (true == parameterized_mux)
+      && (true == is_verilog_parameterized_mux(circuit_lib, mux_circuit_model)) ) {
+      if (param_mux_models.end() == std::find(param_mux_models.begin(), param_mux_models.end(), mux_circuit_model)) {
+        print_verilog_parameterized_mux_module(circuit_lib, fp, mux_circuit_model);
+        param_mux_models.push_back(mux_circuit_model);
+      }
+      print_verilog_parameterized_mux_instance_module(module_manager, circuit_lib, fp, mux_circuit_model, mux_graph);
+      continue;
+    }
     /* Create MUX circuits */
     generate_verilog_mux_module(module_manager, circuit_lib, fp, mux_circuit_model, mux_graph, use_explicit_port_map);
   }
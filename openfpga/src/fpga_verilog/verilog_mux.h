@@ -25,7 +25,9 @@ void print_verilog_submodule_muxes(ModuleManager& module_manager,
                                    const MuxLibrary& mux_lib,
                                    const CircuitLibrary& circuit_lib,
                                    const std::string& submodule_dir,
-                                   const bool& use_explicit_port_map);
+                                   const bool& use_explicit_port_map,
+                                   const bool& parameterized_mux,
+                                   const bool& incremental);
 
 } /* end namespace openfpga */
 
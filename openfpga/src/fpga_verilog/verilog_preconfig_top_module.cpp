@@ -3,6 +3,7 @@
  * a Verilog module of a pre-configured FPGA fabric
  *******************************************************************/
 #include <fstream>
+#include <set>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -12,14 +13,18 @@
 /* Headers from openfpgautil library */
 #include "openfpga_port.h"
 #include "openfpga_digest.h"
+#include "openfpga_instance_path.h"
 
 #include "bitstream_manager_utils.h"
 #include "openfpga_atom_netlist_utils.h"
 
 #include "openfpga_naming.h"
 
+#include "fabric_cone_of_influence_utils.h"
+
 #include "verilog_constants.h"
 #include "verilog_writer_utils.h"
+#include "verilog_module_writer.h"
 #include "verilog_testbench_utils.h"
 #include "verilog_preconfig_top_module.h"
 
@@ -43,7 +48,7 @@ namespace openfpga
 
     /* Module declaration */
     fp << "module " << circuit_name << std::string(FORMAL_VERIFICATION_TOP_MODULE_POSTFIX);
-    fp << " (" << std::endl;
+    fp << " (" << "\n";
 
     /* Add module ports */
     size_t port_counter = 0;
@@ -71,7 +76,7 @@ namespace openfpga
 
       if (0 < port_counter)
       {
-        fp << "," << std::endl;
+        fp << "," << "\n";
       }
       /* Both input and output ports have only size of 1 */
       BasicPort module_port(std::string(block_name + std::string(FORMAL_VERIFICATION_TOP_MODULE_PORT_POSTFIX)), 1);
@@ -81,10 +86,10 @@ namespace openfpga
       port_counter++;
     }
 
-    fp << ");" << std::endl;
+    fp << ");" << "\n";
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
   }
 
   /********************************************************************
@@ -104,10 +109,10 @@ namespace openfpga
     for (const ModulePortId &module_port_id : module_manager.module_ports(top_module))
     {
       BasicPort module_port = module_manager.module_port(top_module, module_port_id);
-      fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";" << std::endl;
+      fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";" << "\n";
     }
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
   }
 
   /********************************************************************
@@ -178,7 +183,55 @@ namespace openfpga
     print_verilog_comment(fp, std::string("----- End Connect Global ports of FPGA top module -----"));
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
+  }
+
+  /********************************************************************
+ * Update the hierarchical path to the configuration memories of a bitstream block
+ * Blocks are visited in the order of their ids, so that consecutive blocks
+ * mostly share the same parent blocks.
+ * Only the blocks which differ from the previous path are popped and pushed,
+ * instead of building the full path from scratch for each block
+ *******************************************************************/
+  static void update_preconfig_bitstream_block_path(InstancePathBuilder &block_path,
+                                                    std::vector<ConfigBlockId> &path_blocks,
+                                                    const BitstreamManager &bitstream_manager,
+                                                    const std::vector<ConfigBlockId> &block_hierarchy)
+  {
+    /* Find the parent blocks shared with the previous path */
+    size_t num_shared_blocks = 0;
+    while ((num_shared_blocks < path_blocks.size())
+        && (num_shared_blocks < block_hierarchy.size())
+        && (path_blocks[num_shared_blocks] == block_hierarchy[num_shared_blocks]))
+    {
+      num_shared_blocks++;
+    }
+
+    /* The first component of the path is the instance name of the top module */
+    block_path.pop_to_depth(num_shared_blocks + 1);
+    path_blocks.resize(num_shared_blocks);
+
+    for (size_t iblock = num_shared_blocks; iblock < block_hierarchy.size(); ++iblock)
+    {
+      block_path.push(bitstream_manager.block_name(block_hierarchy[iblock]));
+      path_blocks.push_back(block_hierarchy[iblock]);
+    }
+  }
+
+  /********************************************************************
+ * Identify if a bitstream block belongs to an instance of the top module
+ * which is removed from the fabric, where the block hierarchy
+ * starts from the child blocks of the top module
+ *******************************************************************/
+  static bool is_preconfig_bitstream_block_pruned(const BitstreamManager &bitstream_manager,
+                                                  const std::vector<ConfigBlockId> &block_hierarchy,
+                                                  const std::set<std::string> &pruned_instance_names)
+  {
+    if ((true == pruned_instance_names.empty()) || (true == block_hierarchy.empty()))
+    {
+      return false;
+    }
+    return pruned_instance_names.end() != pruned_instance_names.find(bitstream_manager.block_name(block_hierarchy[0]));
   }
 
   /********************************************************************
@@ -189,13 +242,18 @@ namespace openfpga
   static void print_verilog_preconfig_top_module_assign_bitstream(std::fstream &fp,
                                                                   const ModuleManager &module_manager,
                                                                   const ModuleId &top_module,
-                                                                  const BitstreamManager &bitstream_manager)
+                                                                  const BitstreamManager &bitstream_manager,
+                                                                  const std::set<std::string> &pruned_instance_names)
   {
     /* Validate the file stream */
     valid_file_stream(fp);
 
     print_verilog_comment(fp, std::string("----- Begin assign bitstream to configuration memories -----"));
 
+    std::vector<ConfigBlockId> path_blocks;
+    InstancePathBuilder block_path(std::string("."));
+    block_path.push(std::string(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME));
+
     for (const ConfigBlockId &config_block_id : bitstream_manager.blocks())
     {
       /* We only cares blocks with configuration bits */
@@ -209,14 +267,14 @@ namespace openfpga
       /* Ensure that this is the module we want to drop! */
       VTR_ASSERT(0 == module_manager.module_name(top_module).compare(bitstream_manager.block_name(block_hierarchy[0])));
       block_hierarchy.erase(block_hierarchy.begin());
-      /* Build the full hierarchy path */
-      std::string bit_hierarchy_path(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
-      for (const ConfigBlockId &temp_block : block_hierarchy)
+      /* Bypass the blocks of the instances removed from the fabric */
+      if (true == is_preconfig_bitstream_block_pruned(bitstream_manager, block_hierarchy, pruned_instance_names))
       {
-        bit_hierarchy_path += std::string(".");
-        bit_hierarchy_path += bitstream_manager.block_name(temp_block);
+        continue;
       }
-      bit_hierarchy_path += std::string(".");
+      /* Build the full hierarchy path */
+      update_preconfig_bitstream_block_path(block_path, path_blocks, bitstream_manager, block_hierarchy);
+      const std::string &bit_hierarchy_path = block_path.path();
 
       /* Find the bit index in the parent block */
       BasicPort config_data_port(bit_hierarchy_path + generate_configurable_memory_data_out_name(),
@@ -231,7 +289,7 @@ namespace openfpga
       print_verilog_wire_constant_values(fp, config_data_port, config_data_values);
     }
 
-    fp << "initial begin" << std::endl;
+    fp << "initial begin" << "\n";
 
     for (const ConfigBlockId &config_block_id : bitstream_manager.blocks())
     {
@@ -246,14 +304,14 @@ namespace openfpga
       /* Ensure that this is the module we want to drop! */
       VTR_ASSERT(0 == module_manager.module_name(top_module).compare(bitstream_manager.block_name(block_hierarchy[0])));
       block_hierarchy.erase(block_hierarchy.begin());
-      /* Build the full hierarchy path */
-      std::string bit_hierarchy_path(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
-      for (const ConfigBlockId &temp_block : block_hierarchy)
+      /* Bypass the blocks of the instances removed from the fabric */
+      if (true == is_preconfig_bitstream_block_pruned(bitstream_manager, block_hierarchy, pruned_instance_names))
       {
-        bit_hierarchy_path += std::string(".");
-        bit_hierarchy_path += bitstream_manager.block_name(temp_block);
+        continue;
       }
-      bit_hierarchy_path += std::string(".");
+      /* Build the full hierarchy path */
+      update_preconfig_bitstream_block_path(block_path, path_blocks, bitstream_manager, block_hierarchy);
+      const std::string &bit_hierarchy_path = block_path.path();
 
       /* Find the bit index in the parent block */
       BasicPort config_datab_port(bit_hierarchy_path + generate_configurable_memory_inverted_data_out_name(),
@@ -267,7 +325,7 @@ namespace openfpga
       print_verilog_force_wire_constant_values(fp, config_datab_port, config_datab_values);
     }
 
-    fp << "end" << std::endl;
+    fp << "end" << "\n";
 
     print_verilog_comment(fp, std::string("----- End assign bitstream to configuration memories -----"));
   }
@@ -279,14 +337,19 @@ namespace openfpga
   static void print_verilog_preconfig_top_module_deposit_bitstream(std::fstream &fp,
                                                                    const ModuleManager &module_manager,
                                                                    const ModuleId &top_module,
-                                                                   const BitstreamManager &bitstream_manager)
+                                                                   const BitstreamManager &bitstream_manager,
+                                                                   const std::set<std::string> &pruned_instance_names)
   {
     /* Validate the file stream */
     valid_file_stream(fp);
 
     print_verilog_comment(fp, std::string("----- Begin deposit bitstream to configuration memories -----"));
 
-    fp << "initial begin" << std::endl;
+    std::vector<ConfigBlockId> path_blocks;
+    InstancePathBuilder block_path(std::string("."));
+    block_path.push(std::string(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME));
+
+    fp << "initial begin" << "\n";
 
     for (const ConfigBlockId &config_block_id : bitstream_manager.blocks())
     {
@@ -301,14 +364,14 @@ namespace openfpga
       /* Ensure that this is the module we want to drop! */
       VTR_ASSERT(0 == module_manager.module_name(top_module).compare(bitstream_manager.block_name(block_hierarchy[0])));
       block_hierarchy.erase(block_hierarchy.begin());
-      /* Build the full hierarchy path */
-      std::string bit_hierarchy_path(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
-      for (const ConfigBlockId &temp_block : block_hierarchy)
+      /* Bypass the blocks of the instances removed from the fabric */
+      if (true == is_preconfig_bitstream_block_pruned(bitstream_manager, block_hierarchy, pruned_instance_names))
       {
-        bit_hierarchy_path += std::string(".");
-        bit_hierarchy_path += bitstream_manager.block_name(temp_block);
+        continue;
       }
-      bit_hierarchy_path += std::string(".");
+      /* Build the full hierarchy path */
+      update_preconfig_bitstream_block_path(block_path, path_blocks, bitstream_manager, block_hierarchy);
+      const std::string &bit_hierarchy_path = block_path.path();
 
       /* Find the bit index in the parent block */
       BasicPort config_data_port(bit_hierarchy_path + generate_configurable_memory_data_out_name(),
@@ -333,13 +396,70 @@ namespace openfpga
       print_verilog_deposit_wire_constant_values(fp, config_datab_port, config_datab_values);
     }
 
-    fp << "end" << std::endl;
+    fp << "end" << "\n";
 
     print_verilog_comment(fp, std::string("----- End deposit bitstream to configuration memories -----"));
   }
 
   /********************************************************************
  * Impose the bitstream on the configuration memories
+ * This function uses 'defparam' syntax to set the parameters of 
+ * the configuration memories, which are replaced by constants 
+ * when the preprocessing flag for pre-configured memories is defined
+ * No value is forced during simulation, and simulators can propagate
+ * the constants into the configured fabric
+ *******************************************************************/
+  static void print_verilog_preconfig_top_module_defparam_bitstream(std::fstream &fp,
+                                                                    const ModuleManager &module_manager,
+                                                                    const ModuleId &top_module,
+                                                                    const BitstreamManager &bitstream_manager,
+                                                                    const std::set<std::string> &pruned_instance_names)
+  {
+    /* Validate the file stream */
+    valid_file_stream(fp);
+
+    print_verilog_comment(fp, std::string("----- Begin defparam bitstream to configuration memories -----"));
+
+    std::vector<ConfigBlockId> path_blocks;
+    InstancePathBuilder block_path(std::string("."));
+    block_path.push(std::string(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME));
+
+    for (const ConfigBlockId &config_block_id : bitstream_manager.blocks())
+    {
+      /* We only cares blocks with configuration bits */
+      if (0 == bitstream_manager.block_bits(config_block_id).size())
+      {
+        continue;
+      }
+      /* Build the hierarchical path of the configuration bit in modules */
+      std::vector<ConfigBlockId> block_hierarchy = find_bitstream_manager_block_hierarchy(bitstream_manager, config_block_id);
+      /* Drop the first block, which is the top module, it should be replaced by the instance name here */
+      /* Ensure that this is the module we want to drop! */
+      VTR_ASSERT(0 == module_manager.module_name(top_module).compare(bitstream_manager.block_name(block_hierarchy[0])));
+      block_hierarchy.erase(block_hierarchy.begin());
+      /* Bypass the blocks of the instances removed from the fabric */
+      if (true == is_preconfig_bitstream_block_pruned(bitstream_manager, block_hierarchy, pruned_instance_names))
+      {
+        continue;
+      }
+      /* Build the full hierarchy path */
+      update_preconfig_bitstream_block_path(block_path, path_blocks, bitstream_manager, block_hierarchy);
+      const std::string &bit_hierarchy_path = block_path.path();
+
+      std::vector<size_t> config_data_values;
+      for (const ConfigBitId config_bit : bitstream_manager.block_bits(config_block_id))
+      {
+        config_data_values.push_back(bitstream_manager.bit_value(config_bit));
+      }
+      fp << "defparam " << bit_hierarchy_path << PRECONFIG_MEMORY_PARAMETER_NAME;
+      fp << " = " << generate_verilog_constant_values(config_data_values) << ";" << "\n";
+    }
+
+    print_verilog_comment(fp, std::string("----- End defparam bitstream to configuration memories -----"));
+  }
+
+  /********************************************************************
+ * Impose the bitstream on the configuration memories
  * We branch here for different simulators:
  * 1. iVerilog Icarus prefers using 'assign' syntax to force the values
  * 2. Mentor Modelsim prefers using '$deposit' syntax to do so
@@ -347,19 +467,22 @@ namespace openfpga
   static void print_verilog_preconfig_top_module_load_bitstream(std::fstream &fp,
                                                                 const ModuleManager &module_manager,
                                                                 const ModuleId &top_module,
-                                                                const BitstreamManager &bitstream_manager)
+                                                                const BitstreamManager &bitstream_manager,
+                                                                const std::set<std::string> &pruned_instance_names)
   {
     print_verilog_comment(fp, std::string("----- Begin load bitstream to configuration memories -----"));
 
     print_verilog_preprocessing_flag(fp, std::string(ICARUS_SIMULATOR_FLAG));
 
     /* Use assign syntax for Icarus simulator */
-    print_verilog_preconfig_top_module_assign_bitstream(fp, module_manager, top_module, bitstream_manager);
+    print_verilog_preconfig_top_module_assign_bitstream(fp, module_manager, top_module, bitstream_manager,
+                                                        pruned_instance_names);
 
-    fp << "`else" << std::endl;
+    fp << "`else" << "\n";
 
     /* Use assign syntax for Icarus simulator */
-    print_verilog_preconfig_top_module_deposit_bitstream(fp, module_manager, top_module, bitstream_manager);
+    print_verilog_preconfig_top_module_deposit_bitstream(fp, module_manager, top_module, bitstream_manager,
+                                                         pruned_instance_names);
 
     print_verilog_endif(fp);
 
@@ -397,6 +520,13 @@ namespace openfpga
  * the port map of input benchmark.
  * It includes wires to force constant values to part of FPGA datapath I/Os
  * All these are hard to implement as a module in module manager
+ *
+ * When the fabric is pruned, the FPGA fabric instanciated is a copy of
+ * the top module written in the same file, which only includes the grids, 
+ * switch blocks and connection blocks in the cone of influence of
+ * the benchmark I/Os, i.e., those used by the placement and routing.
+ * The inputs left undriven by the removed instances are tied to logic '0',
+ * and no bitstream is loaded for the removed instances.
  *******************************************************************/
   void print_verilog_preconfig_top_module(const ModuleManager &module_manager,
                                           const BitstreamManager &bitstream_manager,
@@ -408,7 +538,13 @@ namespace openfpga
                                           const VprNetlistAnnotation &netlist_annotation,
                                           const std::string &circuit_name,
                                           const std::string &verilog_fname,
-                                          const bool &explicit_port_mapping)
+                                          const bool &explicit_port_mapping,
+                                          const bool &defparam_bitstream,
+                                          const bool &prune_fabric,
+                                          const bool &use_packed_ports,
+                                          const DeviceGrid &grids,
+                                          const DeviceRRGSB &device_rr_gsb,
+                                          const VprRoutingAnnotation &routing_annotation)
   {
     std::string timer_message = std::string("Write pre-configured FPGA top-level Verilog netlist for design '") + circuit_name + std::string("'");
 
@@ -416,7 +552,7 @@ namespace openfpga
     vtr::ScopedStartFinishTimer timer(timer_message);
 
     /* Create the file stream */
-    std::fstream fp;
+    BufferedFileStream fp;
     fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
     /* Validate the file stream */
@@ -426,20 +562,47 @@ namespace openfpga
     std::string title = std::string("Verilog netlist for pre-configured FPGA fabric by design: ") + circuit_name;
     print_verilog_file_header(fp, title);
 
-    /* Print module declaration and ports */
-    print_verilog_preconfig_top_module_ports(fp, circuit_name, atom_ctx, netlist_annotation);
-
     /* Find the top_module */
     ModuleId top_module = module_manager.find_module(generate_fpga_top_module_name());
     VTR_ASSERT(true == module_manager.valid_module_id(top_module));
 
+    /* Write the pruned FPGA fabric, and find the instances removed from it */
+    std::string fabric_module_name;
+    std::set<std::string> pruned_instance_names;
+    if (true == prune_fabric)
+    {
+      std::map<ModuleId, std::vector<bool>> kept_instances = find_top_module_cone_of_influence_instances(module_manager, top_module,
+                                                                                                         grids, place_ctx,
+                                                                                                         device_rr_gsb, routing_annotation);
+      for (const auto &kv : kept_instances)
+      {
+        for (size_t instance = 0; instance < kv.second.size(); ++instance)
+        {
+          if (false == kv.second[instance])
+          {
+            pruned_instance_names.insert(module_manager.instance_name(top_module, kv.first, instance));
+          }
+        }
+      }
+
+      fabric_module_name = circuit_name + std::string(FORMAL_VERIFICATION_PRUNED_FABRIC_MODULE_POSTFIX);
+      write_verilog_pruned_module_to_file(fp, module_manager, top_module,
+                                          fabric_module_name, kept_instances,
+                                          explicit_port_mapping,
+                                          use_packed_ports);
+    }
+
+    /* Print module declaration and ports */
+    print_verilog_preconfig_top_module_ports(fp, circuit_name, atom_ctx, netlist_annotation);
+
     /* Print internal wires */
     print_verilog_preconfig_top_module_internal_wires(fp, module_manager, top_module);
 
     /* Instanciate FPGA top-level module */
     print_verilog_testbench_fpga_instance(fp, module_manager, top_module,
                                           std::string(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME),
-                                          explicit_port_mapping);
+                                          explicit_port_mapping,
+                                          fabric_module_name);
 
     /* Find clock ports in benchmark */
     std::vector<std::string> benchmark_clock_port_names = find_atom_netlist_clock_port_names(atom_ctx.nlist, netlist_annotation);
@@ -458,8 +621,16 @@ namespace openfpga
                                              (size_t)VERILOG_DEFAULT_SIGNAL_INIT_VALUE);
 
     /* Assign FPGA internal SRAM/Memory ports to bitstream values */
-    print_verilog_preconfig_top_module_load_bitstream(fp, module_manager, top_module,
-                                                      bitstream_manager);
+    if (true == defparam_bitstream)
+    {
+      print_verilog_preconfig_top_module_defparam_bitstream(fp, module_manager, top_module,
+                                                            bitstream_manager, pruned_instance_names);
+    }
+    else
+    {
+      print_verilog_preconfig_top_module_load_bitstream(fp, module_manager, top_module,
+                                                        bitstream_manager, pruned_instance_names);
+    }
 
     /* Testbench ends*/
     print_verilog_module_end(fp, std::string(circuit_name) + std::string(FORMAL_VERIFICATION_TOP_MODULE_POSTFIX));
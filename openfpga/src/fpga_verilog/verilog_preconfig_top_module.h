@@ -12,6 +12,9 @@
 #include "bitstream_manager.h"
 #include "io_location_map.h"
 #include "vpr_netlist_annotation.h"
+#include "device_grid.h"
+#include "device_rr_gsb.h"
+#include "vpr_routing_annotation.h"
 
 /********************************************************************
  * Function declaration
@@ -30,7 +33,13 @@ void print_verilog_preconfig_top_module(const ModuleManager& module_manager,
                                         const VprNetlistAnnotation& netlist_annotation,
                                         const std::string& circuit_name,
                                         const std::string& verilog_fname,
-                                        const bool& explicit_port_mapping);
+                                        const bool& explicit_port_mapping,
+                                        const bool& defparam_bitstream,
+                                        const bool& prune_fabric,
+                                        const bool& use_packed_ports,
+                                        const DeviceGrid& grids,
+                                        const DeviceRRGSB& device_rr_gsb,
+                                        const VprRoutingAnnotation& routing_annotation);
 
 } /* end namespace openfpga */
 
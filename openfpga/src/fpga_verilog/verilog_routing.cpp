@@ -2,10 +2,13 @@
  * This file includes functions that are used for 
  * Verilog generation of FPGA routing architecture (global routing) 
  *********************************************************************/
+#include <algorithm>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_time.h"
 #include "vtr_log.h"
+#include "vtr_parallel.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
@@ -72,21 +75,29 @@ namespace openfpga {
  *              +--------------------------+
  *
  *  W: routing channel width
- *              
+ *
+ * Return the name of the netlist, which should be registered by the caller
  ********************************************************************/
 static 
-void print_verilog_routing_connection_box_unique_module(NetlistManager& netlist_manager,
-                                                        const ModuleManager& module_manager, 
+std::string print_verilog_routing_connection_box_unique_module(const ModuleManager& module_manager, 
                                                         const std::string& subckt_dir, 
                                                         const RRGSB& rr_gsb,
                                                         const t_rr_type& cb_type,
-                                                        const bool& use_explicit_port_map) {
+                                                        const bool& use_explicit_port_map,
+                                                        const bool& use_packed_ports,
+                                                        const bool& incremental,
+                                                        const vtr::Rect<size_t>& shard_region) {
   /* Create the netlist */
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
   std::string verilog_fname(subckt_dir + generate_connection_block_netlist_name(cb_type, gsb_coordinate, std::string(VERILOG_NETLIST_FILE_POSTFIX)));
 
+  /* The netlist of a GSB out of the shard is only registered, as it is written by another shard */
+  if (false == shard_region.coincident(vtr::Point<size_t>(rr_gsb.get_x(), rr_gsb.get_y()))) {
+    return verilog_fname;
+  }
+
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(incremental, std::string(VERILOG_FILE_HEADER_TIME_STAMP_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
@@ -98,18 +109,15 @@ void print_verilog_routing_connection_box_unique_module(NetlistManager& netlist_
   VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
 
   /* Write the verilog module */
-  write_verilog_module_to_file(fp, module_manager, cb_module, use_explicit_port_map);
+  write_verilog_module_to_file(fp, module_manager, cb_module, use_explicit_port_map, use_packed_ports);
  
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Close file handler */
   fp.close();
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  return verilog_fname;
 }
 
 /*********************************************************************
@@ -173,20 +181,27 @@ void print_verilog_routing_connection_box_unique_module(NetlistManager& netlist_
  *                       Grid[x][y]     ChanY[x][y]      Grid[x+1][y] 
  *                       right_pins    inputs/outputs      left_pins
  *
- *
+ * Return the name of the netlist, which should be registered by the caller
  ********************************************************************/
 static 
-void print_verilog_routing_switch_box_unique_module(NetlistManager& netlist_manager,
-                                                    const ModuleManager& module_manager, 
+std::string print_verilog_routing_switch_box_unique_module(const ModuleManager& module_manager, 
                                                     const std::string& subckt_dir, 
                                                     const RRGSB& rr_gsb,
-                                                    const bool& use_explicit_port_map) {
+                                                    const bool& use_explicit_port_map,
+                                                    const bool& use_packed_ports,
+                                                    const bool& incremental,
+                                                    const vtr::Rect<size_t>& shard_region) {
   /* Create the netlist */
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
   std::string verilog_fname(subckt_dir + generate_routing_block_netlist_name(SB_VERILOG_FILE_NAME_PREFIX, gsb_coordinate, std::string(VERILOG_NETLIST_FILE_POSTFIX)));
 
+  /* The netlist of a GSB out of the shard is only registered, as it is written by another shard */
+  if (false == shard_region.coincident(vtr::Point<size_t>(rr_gsb.get_x(), rr_gsb.get_y()))) {
+    return verilog_fname;
+  }
+
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(incremental, std::string(VERILOG_FILE_HEADER_TIME_STAMP_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
@@ -198,15 +213,41 @@ void print_verilog_routing_switch_box_unique_module(NetlistManager& netlist_mana
   VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
 
   /* Write the verilog module */
-  write_verilog_module_to_file(fp, module_manager, sb_module, use_explicit_port_map);
+  write_verilog_module_to_file(fp, module_manager, sb_module, use_explicit_port_map, use_packed_ports);
  
   /* Close file handler */
   fp.close();
 
+  return verilog_fname;
+}
+
+/********************************************************************
+ * Write a list of routing module netlists and register them to the netlist manager
+ * The netlists are independent from each other and only read the module graph
+ * (the routing modules have been frozen by build_fabric),
+ * so they can be written by worker threads when more than one job is requested.
+ * The netlist manager is only updated by the caller thread in the order of the list,
+ * so that its contents do not depend on the number of jobs
+ *******************************************************************/
+template<class WriteNetlistFunc>
+static
+void print_verilog_routing_netlists(NetlistManager& netlist_manager,
+                                    const size_t& num_netlists,
+                                    const size_t& num_jobs,
+                                    const WriteNetlistFunc& write_netlist) {
+  std::vector<std::string> netlist_names(num_netlists);
+
+  /* Netlists are dispatched on demand, as the module sizes vary across the device */
+  vtr::parallel_for(num_netlists, num_jobs, [&](const size_t& inetlist) {
+    netlist_names[inetlist] = write_netlist(inetlist);
+  });
+
   /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  for (const std::string& verilog_fname : netlist_names) {
+    NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
+    VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+    netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  }
 }
 
 /********************************************************************
@@ -219,9 +260,14 @@ void print_verilog_flatten_connection_block_modules(NetlistManager& netlist_mana
                                                     const DeviceRRGSB& device_rr_gsb,
                                                     const std::string& subckt_dir,
                                                     const t_rr_type& cb_type,
-                                                    const bool& use_explicit_port_map) {
+                                                    const bool& use_explicit_port_map,
+                                                    const bool& use_packed_ports,
+                                                    const bool& incremental,
+                                                    const vtr::Rect<size_t>& shard_region,
+                                                    const size_t& num_jobs) {
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
+  std::vector<const RRGSB*> cb_gsbs;
 
   for (size_t ix = 0; ix < cb_range.x(); ++ix) {
     for (size_t iy = 0; iy < cb_range.y(); ++iy) {
@@ -233,13 +279,20 @@ void print_verilog_flatten_connection_block_modules(NetlistManager& netlist_mana
       if (true != rr_gsb.is_cb_exist(cb_type)) {
         continue;
       }
-      print_verilog_routing_connection_box_unique_module(netlist_manager, 
-                                                         module_manager,
-                                                         subckt_dir, 
-                                                         rr_gsb, cb_type,  
-                                                         use_explicit_port_map);
+      cb_gsbs.push_back(&rr_gsb);
     }
   }
+
+  print_verilog_routing_netlists(netlist_manager, cb_gsbs.size(), num_jobs,
+                                 [&](const size_t& icb) {
+                                   return print_verilog_routing_connection_box_unique_module(module_manager,
+                                                                                             subckt_dir, 
+                                                                                             *(cb_gsbs[icb]), cb_type,  
+                                                                                             use_explicit_port_map,
+                                                                                             use_packed_ports,
+                                                                                             incremental,
+                                                                                             shard_region);
+                                 });
 }
 
 /********************************************************************
@@ -255,30 +308,42 @@ void print_verilog_flatten_routing_modules(NetlistManager& netlist_manager,
                                            const ModuleManager& module_manager,
                                            const DeviceRRGSB& device_rr_gsb,
                                            const std::string& subckt_dir,
-                                           const bool& use_explicit_port_map) {
+                                           const bool& use_explicit_port_map,
+                                           const bool& use_packed_ports,
+                                           const bool& incremental,
+                                           const vtr::Rect<size_t>& shard_region,
+                                           const size_t& num_jobs) {
   /* Create a vector to contain all the Verilog netlist names that have been generated in this function */
   std::vector<std::string> netlist_names;
 
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
 
   /* Build unique switch block modules */
+  std::vector<const RRGSB*> sb_gsbs;
   for (size_t ix = 0; ix < sb_range.x(); ++ix) {
     for (size_t iy = 0; iy < sb_range.y(); ++iy) {
       const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
       if (true != rr_gsb.is_sb_exist()) {
         continue;
       }
-      print_verilog_routing_switch_box_unique_module(netlist_manager,
-                                                     module_manager, 
-                                                     subckt_dir, 
-                                                     rr_gsb, 
-                                                     use_explicit_port_map);
+      sb_gsbs.push_back(&rr_gsb);
     }
   }
 
-  print_verilog_flatten_connection_block_modules(netlist_manager, module_manager, device_rr_gsb, subckt_dir, CHANX, use_explicit_port_map);
+  print_verilog_routing_netlists(netlist_manager, sb_gsbs.size(), num_jobs,
+                                 [&](const size_t& isb) {
+                                   return print_verilog_routing_switch_box_unique_module(module_manager, 
+                                                                                         subckt_dir, 
+                                                                                         *(sb_gsbs[isb]), 
+                                                                                         use_explicit_port_map,
+                                                                                         use_packed_ports,
+                                                                                         incremental,
+                                                                                         shard_region);
+                                 });
+
+  print_verilog_flatten_connection_block_modules(netlist_manager, module_manager, device_rr_gsb, subckt_dir, CHANX, use_explicit_port_map, use_packed_ports, incremental, shard_region, num_jobs);
 
-  print_verilog_flatten_connection_block_modules(netlist_manager, module_manager, device_rr_gsb, subckt_dir, CHANY, use_explicit_port_map);
+  print_verilog_flatten_connection_block_modules(netlist_manager, module_manager, device_rr_gsb, subckt_dir, CHANY, use_explicit_port_map, use_packed_ports, incremental, shard_region, num_jobs);
 
   /*
   VTR_LOG("Writing header file for routing submodules '%s'...",
@@ -306,41 +371,49 @@ void print_verilog_unique_routing_modules(NetlistManager& netlist_manager,
                                           const ModuleManager& module_manager,
                                           const DeviceRRGSB& device_rr_gsb,
                                           const std::string& subckt_dir,
-                                          const bool& use_explicit_port_map) {
+                                          const bool& use_explicit_port_map,
+                                          const bool& use_packed_ports,
+                                          const bool& incremental,
+                                          const vtr::Rect<size_t>& shard_region,
+                                          const size_t& num_jobs) {
   /* Create a vector to contain all the Verilog netlist names that have been generated in this function */
   std::vector<std::string> netlist_names;
 
   /* Build unique switch block modules */
-  for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(isb);
-    print_verilog_routing_switch_box_unique_module(netlist_manager,
-                                                   module_manager,
-                                                   subckt_dir, 
-                                                   unique_mirror, 
-                                                   use_explicit_port_map);
-  }
+  print_verilog_routing_netlists(netlist_manager, device_rr_gsb.get_num_sb_unique_module(), num_jobs,
+                                 [&](const size_t& isb) {
+                                   return print_verilog_routing_switch_box_unique_module(module_manager,
+                                                                                         subckt_dir, 
+                                                                                         device_rr_gsb.get_sb_unique_module(isb), 
+                                                                                         use_explicit_port_map,
+                                                                                         use_packed_ports,
+                                                                                         incremental,
+                                                                                         shard_region);
+                                 });
 
   /* Build unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, icb);
-
-    print_verilog_routing_connection_box_unique_module(netlist_manager,
-                                                       module_manager,
-                                                       subckt_dir, 
-                                                       unique_mirror, CHANX,  
-                                                       use_explicit_port_map);
-  }
+  print_verilog_routing_netlists(netlist_manager, device_rr_gsb.get_num_cb_unique_module(CHANX), num_jobs,
+                                 [&](const size_t& icb) {
+                                   return print_verilog_routing_connection_box_unique_module(module_manager,
+                                                                                             subckt_dir, 
+                                                                                             device_rr_gsb.get_cb_unique_module(CHANX, icb), CHANX,  
+                                                                                             use_explicit_port_map,
+                                                                                             use_packed_ports,
+                                                                                             incremental,
+                                                                                             shard_region);
+                                 });
 
   /* Build unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANY); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, icb);
-
-    print_verilog_routing_connection_box_unique_module(netlist_manager, 
-                                                       module_manager,
-                                                       subckt_dir, 
-                                                       unique_mirror, CHANY,  
-                                                       use_explicit_port_map);
-  }
+  print_verilog_routing_netlists(netlist_manager, device_rr_gsb.get_num_cb_unique_module(CHANY), num_jobs,
+                                 [&](const size_t& icb) {
+                                   return print_verilog_routing_connection_box_unique_module(module_manager,
+                                                                                             subckt_dir, 
+                                                                                             device_rr_gsb.get_cb_unique_module(CHANY, icb), CHANY,  
+                                                                                             use_explicit_port_map,
+                                                                                             use_packed_ports,
+                                                                                             incremental,
+                                                                                             shard_region);
+                                 });
 
   /*
   VTR_LOG("Writing header file for routing submodules '%s'...",
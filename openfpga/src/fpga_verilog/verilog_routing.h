@@ -5,6 +5,7 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 
+#include "vtr_geometry.h"
 #include "mux_library.h"
 #include "module_manager.h"
 #include "netlist_manager.h"
@@ -21,13 +22,21 @@ void print_verilog_flatten_routing_modules(NetlistManager& netlist_manager,
                                            const ModuleManager& module_manager,
                                            const DeviceRRGSB& device_rr_gsb,
                                            const std::string& subckt_dir,
-                                           const bool& use_explicit_port_map);
+                                           const bool& use_explicit_port_map,
+                                           const bool& use_packed_ports,
+                                           const bool& incremental,
+                                           const vtr::Rect<size_t>& shard_region,
+                                           const size_t& num_jobs);
 
 void print_verilog_unique_routing_modules(NetlistManager& netlist_manager,
                                           const ModuleManager& module_manager,
                                           const DeviceRRGSB& device_rr_gsb,
                                           const std::string& subckt_dir,
-                                          const bool& use_explicit_port_map);
+                                          const bool& use_explicit_port_map,
+                                          const bool& use_packed_ports,
+                                          const bool& incremental,
+                                          const vtr::Rect<size_t>& shard_region,
+                                          const size_t& num_jobs);
 
 } /* end namespace openfpga */
 
@@ -6,6 +6,7 @@
 #include <fstream>
 #include <limits>
 #include <iomanip>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -19,6 +20,7 @@
 #include "circuit_types.h"
 
 #include "module_manager_utils.h"
+#include "openfpga_naming.h"
 #include "verilog_constants.h"
 #include "verilog_writer_utils.h"
 #include "verilog_submodule_utils.h"
@@ -35,57 +37,193 @@ namespace openfpga {
 constexpr int FLOAT_PRECISION = 6; 
 
 /************************************************
- * Print a timing matrix defined in theecircuit model
- * into a Verilog format. 
- * This function print all the timing edges available
+ * A pin-to-pin delay of a circuit model,
+ * in the time unit of simulation (VERILOG_SIM_TIMESCALE)
+ ***********************************************/
+struct t_verilog_timing_path {
+  CircuitPortId src_port;
+  size_t src_pin;
+  CircuitPortId sink_port;
+  size_t sink_pin;
+  float rise_delay;
+  float fall_delay;
+};
+
+/************************************************
+ * Find all the timing edges available
  * in the circuit model (any pin-to-pin delay)
+ * Both the specify block of the Verilog module and the cell
+ * of the SDF file are generated from them
  ***********************************************/
-void print_verilog_submodule_timing(std::fstream& fp, 
-                                    const CircuitLibrary& circuit_lib,
-                                    const CircuitModelId& circuit_model) {
+static 
+std::vector<t_verilog_timing_path> find_verilog_submodule_timing_paths(const CircuitLibrary& circuit_lib,
+                                                                       const CircuitModelId& circuit_model) {
+  std::vector<t_verilog_timing_path> timing_paths;
+
   /* return if there is no delay info */
   if ( 0 == circuit_lib.num_delay_info(circuit_model)) {
-    return;
+    return timing_paths;
   }
 
   /* Return if there is no ports */
   if (0 == circuit_lib.num_model_ports(circuit_model)) {
+    return timing_paths;
+  }
+
+  /* Read out pin-to-pin delays by finding out all the edges belonging to a circuit model */
+  for (const auto& timing_edge : circuit_lib.timing_edges_by_model(circuit_model)) {
+    t_verilog_timing_path timing_path;
+    timing_path.src_port = circuit_lib.timing_edge_src_port(timing_edge);
+    timing_path.src_pin = circuit_lib.timing_edge_src_pin(timing_edge);
+    timing_path.sink_port = circuit_lib.timing_edge_sink_port(timing_edge);
+    timing_path.sink_pin = circuit_lib.timing_edge_sink_pin(timing_edge);
+    timing_path.rise_delay = circuit_lib.timing_edge_delay(timing_edge, CIRCUIT_MODEL_DELAY_RISE) / VERILOG_SIM_TIMESCALE;
+    timing_path.fall_delay = circuit_lib.timing_edge_delay(timing_edge, CIRCUIT_MODEL_DELAY_FALL) / VERILOG_SIM_TIMESCALE;
+    timing_paths.push_back(timing_path);
+  }
+
+  return timing_paths;
+}
+
+/************************************************
+ * Print a timing matrix defined in theecircuit model
+ * into a Verilog format. 
+ * This function print all the timing edges available
+ * in the circuit model (any pin-to-pin delay)
+ *
+ * When the delays are annotated by an SDF file, 
+ * only the paths are declared here, with zero delays
+ ***********************************************/
+void print_verilog_submodule_timing(std::fstream& fp, 
+                                    const CircuitLibrary& circuit_lib,
+                                    const CircuitModelId& circuit_model,
+                                    const bool& sdf_timing) {
+  std::vector<t_verilog_timing_path> timing_paths = find_verilog_submodule_timing_paths(circuit_lib, circuit_model);
+  if (true == timing_paths.empty()) {
     return;
   }
 
   /* Ensure a valid file handler*/
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << std::endl;
-  fp << "`ifdef " << VERILOG_TIMING_PREPROC_FLAG << std::endl;
+  fp << "\n";
+  fp << "`ifdef " << VERILOG_TIMING_PREPROC_FLAG << "\n";
   print_verilog_comment(fp, std::string("------ BEGIN Pin-to-pin Timing constraints -----"));
-  fp << "\tspecify" << std::endl;
-
-  /* Read out pin-to-pin delays by finding out all the edges belonging to a circuit model */
-  for (const auto& timing_edge : circuit_lib.timing_edges_by_model(circuit_model)) {
-     CircuitPortId src_port = circuit_lib.timing_edge_src_port(timing_edge);
-     size_t src_pin = circuit_lib.timing_edge_src_pin(timing_edge);
-     BasicPort src_port_info(circuit_lib.port_lib_name(src_port), src_pin, src_pin); 
+  fp << "\tspecify" << "\n";
 
-     CircuitPortId sink_port = circuit_lib.timing_edge_sink_port(timing_edge);
-     size_t sink_pin = circuit_lib.timing_edge_sink_pin(timing_edge);
-     BasicPort sink_port_info(circuit_lib.port_lib_name(sink_port), sink_pin, sink_pin); 
+  for (const t_verilog_timing_path& timing_path : timing_paths) {
+     BasicPort src_port_info(circuit_lib.port_lib_name(timing_path.src_port), timing_path.src_pin, timing_path.src_pin); 
+     BasicPort sink_port_info(circuit_lib.port_lib_name(timing_path.sink_port), timing_path.sink_pin, timing_path.sink_pin); 
    
      fp << "\t\t";
      fp << "(" << generate_verilog_port(VERILOG_PORT_CONKT, src_port_info);
      fp << " => ";
      fp << generate_verilog_port(VERILOG_PORT_CONKT, sink_port_info) << ")";
      fp << " = ";
-     fp << "(" << std::setprecision(FLOAT_PRECISION) << circuit_lib.timing_edge_delay(timing_edge, CIRCUIT_MODEL_DELAY_RISE) / VERILOG_SIM_TIMESCALE;
-     fp << ", ";
-     fp << std::setprecision(FLOAT_PRECISION) << circuit_lib.timing_edge_delay(timing_edge, CIRCUIT_MODEL_DELAY_FALL) / VERILOG_SIM_TIMESCALE << ")";
-     fp << ";" << std::endl;
+     if (true == sdf_timing) {
+       fp << "(0, 0)";
+     } else {
+       fp << "(" << std::setprecision(FLOAT_PRECISION) << timing_path.rise_delay;
+       fp << ", ";
+       fp << std::setprecision(FLOAT_PRECISION) << timing_path.fall_delay << ")";
+     }
+     fp << ";" << "\n";
   }
 
-  fp << "\tendspecify" << std::endl;
+  fp << "\tendspecify" << "\n";
   print_verilog_comment(fp, std::string("------ END Pin-to-pin Timing constraints -----"));
-  fp << "`endif" << std::endl;
+  fp << "`endif" << "\n";
+
+}
 
+/************************************************
+ * Identify if the Verilog module of a circuit model is written
+ * with a specify block, i.e., the essential gates and regular wires 
+ * which are not user-defined
+ ***********************************************/
+static 
+bool is_verilog_submodule_timing_printed(const CircuitLibrary& circuit_lib,
+                                         const CircuitModelId& circuit_model) {
+  if (false == circuit_lib.model_verilog_netlist(circuit_model).empty()) {
+    return false;
+  }
+  return (CIRCUIT_MODEL_INVBUF == circuit_lib.model_type(circuit_model))
+      || (CIRCUIT_MODEL_PASSGATE == circuit_lib.model_type(circuit_model))
+      || (CIRCUIT_MODEL_GATE == circuit_lib.model_type(circuit_model))
+      || (CIRCUIT_MODEL_WIRE == circuit_lib.model_type(circuit_model));
+}
+
+/************************************************
+ * Generate the name of a pin of a circuit model in SDF,
+ * which is a bit of a vector, as the ports are declared in Verilog modules
+ ***********************************************/
+static 
+std::string generate_sdf_port_pin(const CircuitLibrary& circuit_lib,
+                                  const CircuitPortId& port,
+                                  const size_t& pin) {
+  return circuit_lib.port_lib_name(port) + std::string("[") + std::to_string(pin) + std::string("]");
+}
+
+/************************************************
+ * Print the pin-to-pin delays of all the circuit models
+ * whose Verilog modules have a specify block into an SDF file.
+ * Each circuit model is a cell type, whose delays are annotated 
+ * to all its instances (in the fabric and the testbenches)
+ * through a wildcard instance. 
+ * The file can be loaded by the simulators with $sdf_annotate
+ ***********************************************/
+void print_verilog_submodule_timing_sdf(const CircuitLibrary& circuit_lib,
+                                        const std::string& sdf_fname,
+                                        const bool& incremental) {
+  /* Create the file stream */
+  IncrementalFileStream fp(incremental, std::string(VERILOG_FILE_HEADER_TIME_STAMP_PREFIX));
+  fp.open(sdf_fname, std::fstream::out | std::fstream::trunc);
+
+  check_file_stream(sdf_fname.c_str(), fp);
+
+  VTR_LOG("Writing SDF file for pin-to-pin timing of circuit models '%s'...",
+          sdf_fname.c_str()); 
+
+  /* The delays are in the time unit of simulation: 1ns */
+  fp << "(DELAYFILE" << "\n";
+  fp << "  (SDFVERSION \"3.0\")" << "\n";
+  fp << "  (DESIGN \"" << generate_fpga_top_module_name() << "\")" << "\n";
+  fp << "  (PROGRAM \"OpenFPGA\")" << "\n";
+  fp << "  (DIVIDER /)" << "\n";
+  fp << "  (TIMESCALE 1ns)" << "\n";
+
+  for (const auto& circuit_model : circuit_lib.models()) {
+    if (false == is_verilog_submodule_timing_printed(circuit_lib, circuit_model)) {
+      continue;
+    }
+    std::vector<t_verilog_timing_path> timing_paths = find_verilog_submodule_timing_paths(circuit_lib, circuit_model);
+    if (true == timing_paths.empty()) {
+      continue;
+    }
+
+    fp << "  (CELL" << "\n";
+    fp << "    (CELLTYPE \"" << circuit_lib.model_name(circuit_model) << "\")" << "\n";
+    fp << "    (INSTANCE *)" << "\n";
+    fp << "    (DELAY" << "\n";
+    fp << "      (ABSOLUTE" << "\n";
+    for (const t_verilog_timing_path& timing_path : timing_paths) {
+      fp << "        (IOPATH ";
+      fp << generate_sdf_port_pin(circuit_lib, timing_path.src_port, timing_path.src_pin) << " ";
+      fp << generate_sdf_port_pin(circuit_lib, timing_path.sink_port, timing_path.sink_pin) << " ";
+      fp << "(" << std::setprecision(FLOAT_PRECISION) << timing_path.rise_delay << ") ";
+      fp << "(" << std::setprecision(FLOAT_PRECISION) << timing_path.fall_delay << "))" << "\n";
+    }
+    fp << "      )" << "\n";
+    fp << "    )" << "\n";
+    fp << "  )" << "\n";
+  }
+
+  fp << ")" << "\n";
+
+  /* close file stream */
+  fp.close();
+
+  VTR_LOG("Done\n");
 }
 
 void print_verilog_submodule_signal_init(std::fstream& fp, 
@@ -94,11 +232,11 @@ void print_verilog_submodule_signal_init(std::fstream& fp,
   /* Ensure a valid file handler*/
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << std::endl;
-  fp << "`ifdef " << VERILOG_SIGNAL_INIT_PREPROC_FLAG << std::endl;
+  fp << "\n";
+  fp << "`ifdef " << VERILOG_SIGNAL_INIT_PREPROC_FLAG << "\n";
   print_verilog_comment(fp, std::string("------ BEGIN driver initialization -----"));
-  fp << "\tinitial begin" << std::endl;
-  fp << "\t`ifdef " << VERILOG_FORMAL_VERIFICATION_PREPROC_FLAG << std::endl;
+  fp << "\tinitial begin" << "\n";
+  fp << "\t`ifdef " << VERILOG_FORMAL_VERIFICATION_PREPROC_FLAG << "\n";
 
   /* Only for formal verification: deposite a zero signal values */
   /* Initialize each input port */
@@ -107,22 +245,22 @@ void print_verilog_submodule_signal_init(std::fstream& fp,
     fp << "\t\t$deposit(";
     fp << generate_verilog_port(VERILOG_PORT_CONKT, input_port_info);
     fp << ", " <<  circuit_lib.port_size(input_port) << "'b" << std::string(circuit_lib.port_size(input_port), '0');
-    fp << ");" << std::endl;
+    fp << ");" << "\n";
   }
-  fp << "\t`else" << std::endl;
+  fp << "\t`else" << "\n";
 
   /* Regular case: deposite initial signal values: a random value */
   for (const auto& input_port : circuit_lib.model_input_ports(circuit_model)) {
     BasicPort input_port_info(circuit_lib.port_lib_name(input_port), circuit_lib.port_size(input_port));
     fp << "\t\t$deposit(";
     fp << generate_verilog_port(VERILOG_PORT_CONKT, input_port_info);
-    fp << ", $random);" << std::endl;
+    fp << ", $random);" << "\n";
   }
 
-  fp << "\t`endif\n" << std::endl;
-  fp << "\tend" << std::endl;
+  fp << "\t`endif\n" << "\n";
+  fp << "\tend" << "\n";
   print_verilog_comment(fp, std::string("------ END driver initialization -----"));
-  fp << "`endif" << std::endl;
+  fp << "`endif" << "\n";
 }
 
 /*********************************************************************
@@ -187,7 +325,7 @@ void print_one_verilog_template_module(const ModuleManager& module_manager,
   print_verilog_comment(fp, std::string("----- Internal logic should start here -----"));
 
   /* Add some empty lines as placeholders for the internal logic*/
-  fp << std::endl << std::endl;
+  fp << "\n" << "\n";
  
   print_verilog_comment(fp, std::string("----- Internal logic should end here -----"));
 
@@ -195,7 +333,7 @@ void print_one_verilog_template_module(const ModuleManager& module_manager,
   print_verilog_module_end(fp, module_name);
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /*********************************************************************
@@ -207,11 +345,12 @@ void print_one_verilog_template_module(const ModuleManager& module_manager,
  ********************************************************************/
 void print_verilog_submodule_templates(const ModuleManager& module_manager,
                                        const CircuitLibrary& circuit_lib,
-                                       const std::string& submodule_dir) {
+                                       const std::string& submodule_dir,
+                                       const bool& incremental) {
   std::string verilog_fname(submodule_dir + USER_DEFINED_TEMPLATE_VERILOG_FILE_NAME);
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(incremental, std::string(VERILOG_FILE_HEADER_TIME_STAMP_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
@@ -18,7 +18,12 @@ namespace openfpga {
 
 void print_verilog_submodule_timing(std::fstream& fp, 
                                     const CircuitLibrary& circuit_lib,
-                                    const CircuitModelId& circuit_model);
+                                    const CircuitModelId& circuit_model,
+                                    const bool& sdf_timing);
+
+void print_verilog_submodule_timing_sdf(const CircuitLibrary& circuit_lib,
+                                        const std::string& sdf_fname,
+                                        const bool& incremental);
 
 void print_verilog_submodule_signal_init(std::fstream& fp, 
                                          const CircuitLibrary& circuit_lib,
@@ -29,7 +34,8 @@ void add_user_defined_verilog_modules(ModuleManager& module_manager,
 
 void print_verilog_submodule_templates(const ModuleManager& module_manager,
                                        const CircuitLibrary& circuit_lib,
-                                       const std::string& submodule_dir);
+                                       const std::string& submodule_dir,
+                                       const bool& incremental);
 
 } /* end namespace openfpga */
 
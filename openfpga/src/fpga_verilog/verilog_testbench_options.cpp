@@ -18,6 +18,13 @@ VerilogTestbenchOption::VerilogTestbenchOption() {
   print_preconfig_top_testbench_ = false;
   print_formal_verification_top_netlist_ = false;
   print_top_testbench_ = false;
+  print_fabric_testbench_ = false;
+  compress_bitstream_ = false;
+  readmem_bitstream_ = false;
+  defparam_bitstream_ = false;
+  prune_formal_verification_top_netlist_ = false;
+  packed_ports_ = false;
+  batch_check_ = false;
   simulation_ini_path_.clear();
   explicit_port_mapping_ = false;
   verbose_output_ = false;
@@ -46,10 +53,38 @@ bool VerilogTestbenchOption::print_top_testbench() const {
   return print_top_testbench_;
 }
 
+bool VerilogTestbenchOption::print_fabric_testbench() const {
+  return print_fabric_testbench_;
+}
+
 bool VerilogTestbenchOption::fast_configuration() const {
   return fast_configuration_;
 }
 
+bool VerilogTestbenchOption::compress_bitstream() const {
+  return compress_bitstream_;
+}
+
+bool VerilogTestbenchOption::readmem_bitstream() const {
+  return readmem_bitstream_;
+}
+
+bool VerilogTestbenchOption::defparam_bitstream() const {
+  return defparam_bitstream_;
+}
+
+bool VerilogTestbenchOption::prune_formal_verification_top_netlist() const {
+  return prune_formal_verification_top_netlist_;
+}
+
+bool VerilogTestbenchOption::packed_ports() const {
+  return packed_ports_;
+}
+
+bool VerilogTestbenchOption::batch_check() const {
+  return batch_check_;
+}
+
 bool VerilogTestbenchOption::print_simulation_ini() const {
   return !simulation_ini_path_.empty();
 }
@@ -76,10 +111,11 @@ void VerilogTestbenchOption::set_output_directory(const std::string& output_dir)
 void VerilogTestbenchOption::set_reference_benchmark_file_path(const std::string& reference_benchmark_file_path) {
   reference_benchmark_file_path_ = reference_benchmark_file_path;
   /* Chain effect on other options: 
-   * Enable/disable the print_preconfig_top_testbench and print_top_testbench
+   * Enable/disable the print_preconfig_top_testbench, print_top_testbench and print_fabric_testbench
    */
   set_print_preconfig_top_testbench(print_preconfig_top_testbench_); 
   set_print_top_testbench(print_top_testbench_); 
+  set_print_fabric_testbench(print_fabric_testbench_); 
 }
  
 void VerilogTestbenchOption::set_print_formal_verification_top_netlist(const bool& enabled) {
@@ -90,6 +126,30 @@ void VerilogTestbenchOption::set_fast_configuration(const bool& enabled) {
   fast_configuration_ = enabled;
 }
 
+void VerilogTestbenchOption::set_compress_bitstream(const bool& enabled) {
+  compress_bitstream_ = enabled;
+}
+
+void VerilogTestbenchOption::set_readmem_bitstream(const bool& enabled) {
+  readmem_bitstream_ = enabled;
+}
+
+void VerilogTestbenchOption::set_defparam_bitstream(const bool& enabled) {
+  defparam_bitstream_ = enabled;
+}
+
+void VerilogTestbenchOption::set_prune_formal_verification_top_netlist(const bool& enabled) {
+  prune_formal_verification_top_netlist_ = enabled;
+}
+
+void VerilogTestbenchOption::set_packed_ports(const bool& enabled) {
+  packed_ports_ = enabled;
+}
+
+void VerilogTestbenchOption::set_batch_check(const bool& enabled) {
+  batch_check_ = enabled;
+}
+
 void VerilogTestbenchOption::set_print_preconfig_top_testbench(const bool& enabled) {
   print_preconfig_top_testbench_ = enabled
                                  && (!reference_benchmark_file_path_.empty());
@@ -106,6 +166,10 @@ void VerilogTestbenchOption::set_print_top_testbench(const bool& enabled) {
   print_top_testbench_ = enabled && (!reference_benchmark_file_path_.empty());
 }
 
+void VerilogTestbenchOption::set_print_fabric_testbench(const bool& enabled) {
+  print_fabric_testbench_ = enabled && (!reference_benchmark_file_path_.empty());
+}
+
 void VerilogTestbenchOption::set_print_simulation_ini(const std::string& simulation_ini_path) {
   simulation_ini_path_ = simulation_ini_path;
 }
@@ -25,9 +25,16 @@ class VerilogTestbenchOption {
     std::string output_directory() const;
     std::string reference_benchmark_file_path() const;
     bool fast_configuration() const;
+    bool compress_bitstream() const;
+    bool readmem_bitstream() const;
+    bool defparam_bitstream() const;
+    bool batch_check() const;
     bool print_formal_verification_top_netlist() const;
+    bool prune_formal_verification_top_netlist() const;
+    bool packed_ports() const;
     bool print_preconfig_top_testbench() const;
     bool print_top_testbench() const;
+    bool print_fabric_testbench() const;
     bool print_simulation_ini() const;
     std::string simulation_ini_path() const;
     bool explicit_port_mapping() const;
@@ -39,6 +46,7 @@ class VerilogTestbenchOption {
     /* The reference verilog file path is the key parameters that will have an impact on other options:
      *  - print_preconfig_top_testbench
      *  - print_top_testbench
+     *  - print_fabric_testbench
      * If the file path is empty, the above testbench generation will not be enabled 
      */
     void set_reference_benchmark_file_path(const std::string& reference_benchmark_file_path);
@@ -46,7 +54,14 @@ class VerilogTestbenchOption {
     /* The preconfig top testbench generation can be enabled only when formal verification top netlist is enabled */
     void set_print_preconfig_top_testbench(const bool& enabled);
     void set_fast_configuration(const bool& enabled);
+    void set_compress_bitstream(const bool& enabled);
+    void set_readmem_bitstream(const bool& enabled);
+    void set_defparam_bitstream(const bool& enabled);
+    void set_prune_formal_verification_top_netlist(const bool& enabled);
+    void set_packed_ports(const bool& enabled);
+    void set_batch_check(const bool& enabled);
     void set_print_top_testbench(const bool& enabled);
+    void set_print_fabric_testbench(const bool& enabled);
     void set_print_simulation_ini(const std::string& simulation_ini_path);
     void set_explicit_port_mapping(const bool& enabled);
     void set_verbose_output(const bool& enabled);
@@ -54,9 +69,18 @@ class VerilogTestbenchOption {
     std::string output_directory_;
     std::string reference_benchmark_file_path_;
     bool fast_configuration_;
+    bool compress_bitstream_;
+    bool readmem_bitstream_;
+    bool defparam_bitstream_;
+    bool batch_check_;
     bool print_formal_verification_top_netlist_;
+    /* Only the instances in the cone of influence of the benchmark are kept in the formal top */
+    bool prune_formal_verification_top_netlist_;
+    /* The fabric netlists are written with packed ports, which the pruned formal top has to follow */
+    bool packed_ports_;
     bool print_preconfig_top_testbench_;
     bool print_top_testbench_;
+    bool print_fabric_testbench_;
     /* Print simulation ini is enabled only when the path is not empty */
     std::string simulation_ini_path_;
     bool explicit_port_mapping_;
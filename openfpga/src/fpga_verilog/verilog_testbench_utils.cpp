@@ -19,6 +19,7 @@
 
 #include "verilog_constants.h"
 #include "verilog_writer_utils.h"
+#include "openfpga_atom_netlist_utils.h"
 #include "verilog_testbench_utils.h"
 
 /* begin namespace openfpga */
@@ -31,7 +32,8 @@ void print_verilog_testbench_fpga_instance(std::fstream& fp,
                                            const ModuleManager& module_manager,
                                            const ModuleId& top_module,
                                            const std::string& top_instance_name,
-                                           const bool& explicit_port_mapping) {
+                                           const bool& explicit_port_mapping,
+                                           const std::string& top_module_name) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
@@ -45,10 +47,11 @@ void print_verilog_testbench_fpga_instance(std::fstream& fp,
   print_verilog_module_instance(fp, module_manager, top_module, 
                                 top_instance_name, 
                                 port2port_name_map,
-                                explicit_port_mapping); 
+                                explicit_port_mapping,
+                                top_module_name); 
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -67,7 +70,7 @@ void print_verilog_testbench_benchmark_instance(std::fstream& fp,
   /* Validate the file stream */
   valid_file_stream(fp);
 
-  fp << "\t" << module_name << " " << instance_name << "(" << std::endl;
+  fp << "\t" << module_name << " " << instance_name << "(" << "\n";
 
   size_t port_counter = 0;
   for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
@@ -85,7 +88,7 @@ void print_verilog_testbench_benchmark_instance(std::fstream& fp,
 
     /* The first port does not need a comma */
     if(0 < port_counter){
-      fp << "," << std::endl;
+      fp << "," << "\n";
     }
     /* Input port follows the logical block name while output port requires a special postfix */
     if (AtomBlockType::INPAD == atom_ctx.nlist.block_type(atom_blk)) {
@@ -124,7 +127,7 @@ void print_verilog_testbench_benchmark_instance(std::fstream& fp,
     /* Update the counter */
     port_counter++;
   }
-  fp << "\t);" << std::endl;
+  fp << "\t);" << "\n";
 }
 
 /********************************************************************
@@ -150,6 +153,9 @@ void print_verilog_testbench_connect_fpga_ios(std::fstream& fp,
   /* In this function, we support only 1 type of I/Os */
   std::vector<BasicPort> module_io_ports = module_manager.module_ports_by_type(top_module, ModuleManager::MODULE_GPIO_PORT);
 
+  /* Find the GPIO of each benchmark I/O once for all the ports */
+  vtr::vector<AtomBlockId, size_t> atom_io_indices = find_atom_netlist_io_indices(atom_ctx, place_ctx, io_location_map);
+
   /* Keep tracking which I/Os have been used */
   for (const BasicPort& module_io_port : module_io_ports) {
     std::vector<bool> io_used(module_io_port.get_width(), false);
@@ -168,9 +174,7 @@ void print_verilog_testbench_connect_fpga_ios(std::fstream& fp,
       }
 
       /* Find the index of the mapped GPIO in top-level FPGA fabric */
-      size_t io_index = io_location_map.io_index(place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.x,
-                                                 place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.y,
-                                                 place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.z);
+      size_t io_index = atom_io_indices[atom_blk];
 
       /* Ensure that IO index is in range */
       BasicPort module_mapped_io_port = module_io_port; 
@@ -207,7 +211,7 @@ void print_verilog_testbench_connect_fpga_ios(std::fstream& fp,
     }
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
 
     /* Wire the unused iopads to a constant */
     print_verilog_comment(fp, std::string("----- Wire unused FPGA I/Os to constants -----"));
@@ -227,7 +231,7 @@ void print_verilog_testbench_connect_fpga_ios(std::fstream& fp,
     }
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
   }
 }
 
@@ -252,10 +256,10 @@ void print_verilog_timeout_and_vcd(std::fstream& fp,
 
   print_verilog_comment(fp, std::string("----- Begin Icarus requirement -------"));
 
-  fp << "\tinitial begin" << std::endl;
-  fp << "\t\t$dumpfile(\"" << vcd_fname << "\");" << std::endl;
-  fp << "\t\t$dumpvars(1, " << module_name << ");" << std::endl;
-  fp << "\tend" << std::endl;
+  fp << "\tinitial begin" << "\n";
+  fp << "\t\t$dumpfile(\"" << vcd_fname << "\");" << "\n";
+  fp << "\t\t$dumpvars(1, " << module_name << ");" << "\n";
+  fp << "\tend" << "\n";
 
   /* Condition ends for the Icarus requirement */
   print_verilog_endif(fp);
@@ -263,26 +267,26 @@ void print_verilog_timeout_and_vcd(std::fstream& fp,
   print_verilog_comment(fp, std::string("----- END Icarus requirement -------"));
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   BasicPort sim_start_port(simulation_start_counter_name, 1);
 
-  fp << "initial begin" << std::endl;
-  fp << "\t" << generate_verilog_port(VERILOG_PORT_CONKT, sim_start_port) << " <= 1'b1;" << std::endl;
-  fp << "\t$timeformat(-9, 2, \"ns\", 20);" << std::endl;
-  fp << "\t$display(\"Simulation start\");" << std::endl;
+  fp << "initial begin" << "\n";
+  fp << "\t" << generate_verilog_port(VERILOG_PORT_CONKT, sim_start_port) << " <= 1'b1;" << "\n";
+  fp << "\t$timeformat(-9, 2, \"ns\", 20);" << "\n";
+  fp << "\t$display(\"Simulation start\");" << "\n";
   print_verilog_comment(fp, std::string("----- Can be changed by the user for his/her need -------"));
-  fp << "\t#" << simulation_time << std::endl;
-  fp << "\tif(" << error_counter_name << " == 0) begin" << std::endl;
-  fp << "\t\t$display(\"Simulation Succeed\");" << std::endl;
-  fp << "\tend else begin" << std::endl;
-  fp << "\t\t$display(\"Simulation Failed with " << std::string("%d") << " error(s)\", " << error_counter_name << ");" << std::endl;
-  fp << "\tend" << std::endl;
-  fp << "\t$finish;" << std::endl;
-  fp << "end" << std::endl;
+  fp << "\t#" << simulation_time << "\n";
+  fp << "\tif(" << error_counter_name << " == 0) begin" << "\n";
+  fp << "\t\t$display(\"Simulation Succeed\");" << "\n";
+  fp << "\tend else begin" << "\n";
+  fp << "\t\t$display(\"Simulation Failed with " << std::string("%d") << " error(s)\", " << error_counter_name << ");" << "\n";
+  fp << "\tend" << "\n";
+  fp << "\t$finish;" << "\n";
+  fp << "end" << "\n";
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -332,14 +336,14 @@ void print_verilog_testbench_check(std::fstream& fp,
 
   BasicPort sim_start_port(simulation_start_counter_name, 1);
 
-  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, sim_start_port) << ";" << std::endl;
-  fp << std::endl;
+  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, sim_start_port) << ";" << "\n";
+  fp << "\n";
 
-  fp << "\talways@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, clock_port) << ") begin" << std::endl;
-  fp << "\t\tif (1'b1 == " << generate_verilog_port(VERILOG_PORT_CONKT, sim_start_port) << ") begin" << std::endl;
+  fp << "\talways@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, clock_port) << ") begin" << "\n";
+  fp << "\t\tif (1'b1 == " << generate_verilog_port(VERILOG_PORT_CONKT, sim_start_port) << ") begin" << "\n";
   fp << "\t\t";
   print_verilog_register_connection(fp, sim_start_port, sim_start_port, true);
-  fp << "\t\tend else begin" << std::endl;
+  fp << "\t\tend else begin" << "\n";
 
   for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
     /* Bypass non-I/O atom blocks ! */
@@ -358,18 +362,18 @@ void print_verilog_testbench_check(std::fstream& fp,
      fp << "\t\t\tif(!(" << block_name << fpga_port_postfix;
      fp << " === " << block_name << benchmark_port_postfix;
      fp << ") && !(" << block_name << benchmark_port_postfix;
-     fp << " === 1'bx)) begin" << std::endl;
-     fp << "\t\t\t\t" << block_name << check_flag_port_postfix << " <= 1'b1;" << std::endl;
-     fp << "\t\t\tend else begin" << std::endl;
-     fp << "\t\t\t\t" << block_name << check_flag_port_postfix << "<= 1'b0;" << std::endl;
-     fp << "\t\t\tend" << std::endl; 
+     fp << " === 1'bx)) begin" << "\n";
+     fp << "\t\t\t\t" << block_name << check_flag_port_postfix << " <= 1'b1;" << "\n";
+     fp << "\t\t\tend else begin" << "\n";
+     fp << "\t\t\t\t" << block_name << check_flag_port_postfix << "<= 1'b0;" << "\n";
+     fp << "\t\t\tend" << "\n"; 
     }
   } 
-  fp << "\t\tend" << std::endl;
-  fp << "\tend" << std::endl;
+  fp << "\t\tend" << "\n";
+  fp << "\tend" << "\n";
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
     /* Only care about output atom blocks ! */
@@ -383,22 +387,22 @@ void print_verilog_testbench_check(std::fstream& fp,
       block_name = netlist_annotation.block_name(atom_blk);
     } 
 
-    fp << "\talways@(posedge " << block_name << check_flag_port_postfix << ") begin" << std::endl;
-    fp << "\t\tif(" << block_name << check_flag_port_postfix << ") begin" << std::endl;
-    fp << "\t\t\t" << error_counter_name << " = " << error_counter_name << " + 1;" << std::endl;
-    fp << "\t\t\t$display(\"Mismatch on " << block_name << fpga_port_postfix << " at time = " << std::string("%t") << "\", $realtime);" << std::endl;
-    fp << "\t\tend" << std::endl;
-    fp << "\tend" << std::endl;
+    fp << "\talways@(posedge " << block_name << check_flag_port_postfix << ") begin" << "\n";
+    fp << "\t\tif(" << block_name << check_flag_port_postfix << ") begin" << "\n";
+    fp << "\t\t\t" << error_counter_name << " = " << error_counter_name << " + 1;" << "\n";
+    fp << "\t\t\t$display(\"Mismatch on " << block_name << fpga_port_postfix << " at time = " << std::string("%t") << "\", $realtime);" << "\n";
+    fp << "\t\tend" << "\n";
+    fp << "\tend" << "\n";
 
     /* Add an empty line as splitter */
-    fp << std::endl;
+    fp << "\n";
   }
 
   /* Condition ends */
   print_verilog_endif(fp);
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -416,21 +420,21 @@ void print_verilog_testbench_clock_stimuli(std::fstream& fp,
 
   print_verilog_comment(fp, std::string("----- Clock Initialization -------"));
 
-  fp << "\tinitial begin" << std::endl;
+  fp << "\tinitial begin" << "\n";
   /* Create clock stimuli */
-  fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, clock_port) << " <= 1'b0;" << std::endl;
-  fp << "\t\twhile(1) begin" << std::endl;
-  fp << "\t\t\t#" << std::setprecision(10) << ((0.5/simulation_parameters.operating_clock_frequency())/VERILOG_SIM_TIMESCALE) << std::endl;
+  fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, clock_port) << " <= 1'b0;" << "\n";
+  fp << "\t\twhile(1) begin" << "\n";
+  fp << "\t\t\t#" << std::setprecision(10) << ((0.5/simulation_parameters.operating_clock_frequency())/VERILOG_SIM_TIMESCALE) << "\n";
   fp << "\t\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, clock_port);
   fp << " <= !";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, clock_port);
-  fp << ";" << std::endl;
-  fp << "\t\tend" << std::endl;
+  fp << ";" << "\n";
+  fp << "\t\tend" << "\n";
 
-  fp << "\tend" << std::endl;
+  fp << "\tend" << "\n";
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -448,7 +452,7 @@ void print_verilog_testbench_random_stimuli(std::fstream& fp,
 
   print_verilog_comment(fp, std::string("----- Input Initialization -------"));
 
-  fp << "\tinitial begin" << std::endl;
+  fp << "\tinitial begin" << "\n";
 
   for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
     /* Bypass non-I/O atom blocks ! */
@@ -470,12 +474,12 @@ void print_verilog_testbench_random_stimuli(std::fstream& fp,
 
     /* TODO: find the clock inputs will be initialized later */
     if (AtomBlockType::INPAD == atom_ctx.nlist.block_type(atom_blk)) {
-      fp << "\t\t" << block_name << " <= 1'b0;" << std::endl;
+      fp << "\t\t" << block_name << " <= 1'b0;" << "\n";
     }
   }
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
   
   /* Set 0 to registers for checking flags */
   for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
@@ -492,14 +496,14 @@ void print_verilog_testbench_random_stimuli(std::fstream& fp,
 
     /* Each logical block assumes a single-width port */
     BasicPort output_port(std::string(block_name + check_flag_port_postfix), 1); 
-    fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, output_port) << " <= 1'b0;" << std::endl;
+    fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, output_port) << " <= 1'b0;" << "\n";
   }
 
-  fp << "\tend" << std::endl;
+  fp << "\tend" << "\n";
   /* Finish initialization */
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   // Not ready yet to determine if input is reset
 /*
@@ -519,7 +523,7 @@ void print_verilog_testbench_random_stimuli(std::fstream& fp,
 */
 
   print_verilog_comment(fp, std::string("----- Input Stimulus -------"));
-  fp << "\talways@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, clock_port) << ") begin" << std::endl;
+  fp << "\talways@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, clock_port) << ") begin" << "\n";
 
   for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
     /* Bypass non-I/O atom blocks ! */
@@ -541,14 +545,14 @@ void print_verilog_testbench_random_stimuli(std::fstream& fp,
 
     /* TODO: find the clock inputs will be initialized later */
     if (AtomBlockType::INPAD == atom_ctx.nlist.block_type(atom_blk)) {
-      fp << "\t\t" << block_name << " <= $random;" << std::endl;
+      fp << "\t\t" << block_name << " <= $random;" << "\n";
     }
   }
 
-  fp << "\tend" << std::endl;
+  fp << "\tend" << "\n";
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -592,11 +596,11 @@ void print_verilog_testbench_shared_ports(std::fstream& fp,
    
     /* Each logical block assumes a single-width port */
     BasicPort input_port(block_name, 1); 
-    fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, input_port) << ";" << std::endl;
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, input_port) << ";" << "\n";
   }
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Instantiate wires for FPGA fabric outputs */
   print_verilog_comment(fp, std::string("----- FPGA fabric outputs -------"));
@@ -615,17 +619,17 @@ void print_verilog_testbench_shared_ports(std::fstream& fp,
 
     /* Each logical block assumes a single-width port */
     BasicPort output_port(std::string(block_name + fpga_output_port_postfix), 1); 
-    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, output_port) << ";" << std::endl;
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, output_port) << ";" << "\n";
   }
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Benchmark is instanciated conditionally: only when a preprocessing flag is enable */
   print_verilog_preprocessing_flag(fp, std::string(autocheck_preprocessing_flag)); 
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Instantiate wire for benchmark output */
   print_verilog_comment(fp, std::string("----- Benchmark outputs -------"));
@@ -643,11 +647,11 @@ void print_verilog_testbench_shared_ports(std::fstream& fp,
 
     /* Each logical block assumes a single-width port */
     BasicPort output_port(std::string(block_name + benchmark_output_port_postfix), 1); 
-    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, output_port) << ";" << std::endl;
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, output_port) << ";" << "\n";
   }
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Instantiate register for output comparison */
   print_verilog_comment(fp, std::string("----- Output vectors checking flags -------"));
@@ -665,17 +669,17 @@ void print_verilog_testbench_shared_ports(std::fstream& fp,
 
     /* Each logical block assumes a single-width port */
     BasicPort output_port(std::string(block_name + check_flag_port_postfix), 1); 
-    fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, output_port) << ";" << std::endl;
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, output_port) << ";" << "\n";
   }
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Condition ends for the benchmark instanciation */
   print_verilog_endif(fp);
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 } /* end namespace openfpga */
@@ -27,7 +27,8 @@ void print_verilog_testbench_fpga_instance(std::fstream& fp,
                                            const ModuleManager& module_manager,
                                            const ModuleId& top_module,
                                            const std::string& top_instance_name,
-                                           const bool& explicit_port_mapping);
+                                           const bool& explicit_port_mapping,
+                                           const std::string& top_module_name = std::string());
 
 void print_verilog_testbench_benchmark_instance(std::fstream& fp,
                                                 const std::string& module_name,
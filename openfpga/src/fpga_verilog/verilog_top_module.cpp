@@ -37,7 +37,10 @@ namespace openfpga {
 void print_verilog_top_module(NetlistManager& netlist_manager,
                               const ModuleManager& module_manager,
                               const std::string& verilog_dir,
-                              const bool& use_explicit_mapping) {
+                              const bool& use_explicit_mapping,
+                              const bool& compact_top_module,
+                              const bool& use_packed_ports,
+                              const bool& incremental) {
   /* Create a module as the top-level fabric, and add it to the module manager */
   std::string top_module_name = generate_fpga_top_module_name();
   ModuleId top_module = module_manager.find_module(top_module_name);
@@ -51,18 +54,25 @@ void print_verilog_top_module(NetlistManager& netlist_manager,
           verilog_fname.c_str());
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(incremental, std::string(VERILOG_FILE_HEADER_TIME_STAMP_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
 
   print_verilog_file_header(fp, std::string("Top-level Verilog module for FPGA")); 
 
-  /* Write the module content in Verilog format */
-  write_verilog_module_to_file(fp, module_manager, top_module, use_explicit_mapping);
+  /* Write the module content in Verilog format
+   * The instance arrays are not applicable to the packed ports of grids and routing blocks
+   */
+  if (true == compact_top_module) {
+    VTR_ASSERT(false == use_packed_ports);
+    write_verilog_module_with_arrays_to_file(fp, module_manager, top_module, use_explicit_mapping);
+  } else {
+    write_verilog_module_to_file(fp, module_manager, top_module, use_explicit_mapping, use_packed_ports);
+  }
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Close file handler */
   fp.close();
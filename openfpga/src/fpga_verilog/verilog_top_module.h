@@ -18,7 +18,10 @@ namespace openfpga {
 void print_verilog_top_module(NetlistManager& netlist_manager,
                               const ModuleManager& module_manager,
                               const std::string& verilog_dir,
-                              const bool& use_explicit_mapping);
+                              const bool& use_explicit_mapping,
+                              const bool& compact_top_module,
+                              const bool& use_packed_ports,
+                              const bool& incremental);
 
 } /* end namespace openfpga */
 
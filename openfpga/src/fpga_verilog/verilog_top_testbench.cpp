@@ -5,6 +5,7 @@
 #include <fstream>
 #include <iomanip>
 #include <algorithm>
+#include <random>
 
 
 /* Headers from vtrutil library */
@@ -15,8 +16,11 @@
 /* Headers from openfpgautil library */
 #include "openfpga_port.h"
 #include "openfpga_digest.h"
+#include "openfpga_decode.h"
 
 #include "bitstream_manager_utils.h"
+#include "fabric_bitstream_utils.h"
+#include "binary_fabric_bitstream.h"
 
 #include "openfpga_reserved_words.h"
 #include "openfpga_naming.h"
@@ -42,6 +46,11 @@ constexpr char* TOP_TESTBENCH_FPGA_OUTPUT_POSTFIX = "_fpga";
 constexpr char* TOP_TESTBENCH_CHECKFLAG_PORT_POSTFIX = "_flag";
 
 constexpr char* TOP_TESTBENCH_PROG_TASK_NAME = "prog_cycle_task";
+constexpr char* TOP_TESTBENCH_PROG_RLE_TASK_NAME = "prog_rle_task";
+constexpr char* TOP_TESTBENCH_PROG_RLE_COUNTER_NAME = "prog_rle_num_remaining_bits";
+
+constexpr char* TOP_TESTBENCH_BITSTREAM_MEMORY_NAME = "bitstream_mem";
+constexpr char* TOP_TESTBENCH_BITSTREAM_MEMORY_INDEX_NAME = "bitstream_mem_index";
 
 constexpr char* TOP_TESTBENCH_SIM_START_PORT_NAME = "sim_start";
 
@@ -60,6 +69,23 @@ constexpr char* TOP_TB_CLOCK_REG_POSTFIX = "_reg";
 
 constexpr char* AUTOCHECK_TOP_TESTBENCH_VERILOG_MODULE_POSTFIX = "_autocheck_top_tb";
 
+constexpr char* FABRIC_TESTBENCH_VERILOG_MODULE_POSTFIX = "_fabric_tb";
+constexpr char* FABRIC_TESTBENCH_REFERENCE_VERILOG_MODULE_POSTFIX = "_fabric_tb_reference";
+constexpr size_t FABRIC_TESTBENCH_MAX_FILE_NAME_LENGTH = 1024;
+constexpr char* FABRIC_TESTBENCH_BITSTREAM_PLUSARG_NAME = "bitstream";
+constexpr char* FABRIC_TESTBENCH_IO_MAP_PLUSARG_NAME = "io_map";
+constexpr char* FABRIC_TESTBENCH_STIMULI_PLUSARG_NAME = "stimuli";
+constexpr char* FABRIC_TESTBENCH_REFERENCE_PLUSARG_NAME = "reference";
+constexpr char* FABRIC_TESTBENCH_BITSTREAM_WORD_NAME = "bitstream_word";
+constexpr char* FABRIC_TESTBENCH_IO_CLOCK_MASK_NAME = "io_clock_mask";
+constexpr char* FABRIC_TESTBENCH_IO_OUTPUT_MASK_NAME = "io_output_mask";
+constexpr char* FABRIC_TESTBENCH_IO_STIMULI_NAME = "io_stimuli";
+constexpr char* FABRIC_TESTBENCH_IO_REFERENCE_NAME = "io_reference";
+constexpr char* FABRIC_TESTBENCH_IO_OUTPUTS_NAME = "io_outputs";
+constexpr char* FABRIC_TESTBENCH_IO_GENVAR_NAME = "io_index";
+constexpr char* FABRIC_TESTBENCH_VECTOR_INDEX_NAME = "vector_index";
+constexpr char* FABRIC_TESTBENCH_SCAN_STATUS_NAME = "scan_status";
+
 /********************************************************************
  * Print local wires for flatten memory (standalone) configuration protocols
  *******************************************************************/
@@ -74,33 +100,36 @@ void print_verilog_top_testbench_flatten_memory_port(std::fstream& fp,
   print_verilog_comment(fp, std::string("---- Bit Line ports -----"));
   ModulePortId bl_port_id = module_manager.find_module_port(top_module, std::string(MEMORY_BL_PORT_NAME));
   BasicPort bl_port = module_manager.module_port(top_module, bl_port_id);
-  fp << generate_verilog_port(VERILOG_PORT_REG, bl_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, bl_port) << ";" << "\n";
 
   /* Print the port for Word-Line */
   print_verilog_comment(fp, std::string("---- Word Line ports -----"));
   ModulePortId wl_port_id = module_manager.find_module_port(top_module, std::string(MEMORY_WL_PORT_NAME));
   BasicPort wl_port = module_manager.module_port(top_module, wl_port_id);
-  fp << generate_verilog_port(VERILOG_PORT_REG, wl_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, wl_port) << ";" << "\n";
 }
 
 
 /********************************************************************
  * Print local wires for configuration chain protocols
+ * Each configuration region has its own chain, whose head and tail
+ * are a bit of the ports
  *******************************************************************/
 static
-void print_verilog_top_testbench_config_chain_port(std::fstream& fp) {
+void print_verilog_top_testbench_config_chain_port(std::fstream& fp,
+                                                   const size_t& num_regions) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
   /* Print the head of configuraion-chains here */
   print_verilog_comment(fp, std::string("---- Configuration-chain head -----"));
-  BasicPort config_chain_head_port(generate_configuration_chain_head_name(), 1);
-  fp << generate_verilog_port(VERILOG_PORT_REG, config_chain_head_port) << ";" << std::endl;
+  BasicPort config_chain_head_port(generate_configuration_chain_head_name(), num_regions);
+  fp << generate_verilog_port(VERILOG_PORT_REG, config_chain_head_port) << ";" << "\n";
 
   /* Print the tail of configuration-chains here */
   print_verilog_comment(fp, std::string("---- Configuration-chain tail -----"));
-  BasicPort config_chain_tail_port(generate_configuration_chain_tail_name(), 1);
-  fp << generate_verilog_port(VERILOG_PORT_WIRE, config_chain_tail_port) << ";" << std::endl;
+  BasicPort config_chain_tail_port(generate_configuration_chain_tail_name(), num_regions);
+  fp << generate_verilog_port(VERILOG_PORT_WIRE, config_chain_tail_port) << ";" << "\n";
 }
 
 /********************************************************************
@@ -113,13 +142,17 @@ void print_verilog_top_testbench_memory_bank_port(std::fstream& fp,
   /* Validate the file stream */
   valid_file_stream(fp);
 
-  /* Print the address port for the Bit-Line decoder here */
-  print_verilog_comment(fp, std::string("---- Address port for Bit-Line decoder -----"));
+  /* Print the address port for the Bit-Line decoder here 
+   * There is no Bit-Line decoder when a word is written at each Word-Line address
+   */
   ModulePortId bl_addr_port_id = module_manager.find_module_port(top_module,
                                                                  std::string(DECODER_BL_ADDRESS_PORT_NAME));
-  BasicPort bl_addr_port = module_manager.module_port(top_module, bl_addr_port_id);
+  if (true == module_manager.valid_module_port_id(top_module, bl_addr_port_id)) {
+    print_verilog_comment(fp, std::string("---- Address port for Bit-Line decoder -----"));
+    BasicPort bl_addr_port = module_manager.module_port(top_module, bl_addr_port_id);
 
-  fp << generate_verilog_port(VERILOG_PORT_REG, bl_addr_port) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_REG, bl_addr_port) << ";" << "\n";
+  }
 
   /* Print the address port for the Word-Line decoder here */
   print_verilog_comment(fp, std::string("---- Address port for Word-Line decoder -----"));
@@ -127,14 +160,14 @@ void print_verilog_top_testbench_memory_bank_port(std::fstream& fp,
                                                                  std::string(DECODER_WL_ADDRESS_PORT_NAME));
   BasicPort wl_addr_port = module_manager.module_port(top_module, wl_addr_port_id);
 
-  fp << generate_verilog_port(VERILOG_PORT_REG, wl_addr_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, wl_addr_port) << ";" << "\n";
 
   /* Print the data-input port for the frame-based decoder here */
   print_verilog_comment(fp, std::string("---- Data input port for frame-based decoder -----"));
   ModulePortId din_port_id = module_manager.find_module_port(top_module,
                                                              std::string(DECODER_DATA_IN_PORT_NAME));
   BasicPort din_port = module_manager.module_port(top_module, din_port_id);
-  fp << generate_verilog_port(VERILOG_PORT_REG, din_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, din_port) << ";" << "\n";
 
   /* Wire the INVERTED programming clock to the enable signal !!! */
   print_verilog_comment(fp, std::string("---- Wire enable port of frame-based decoder to inverted programming clock -----"));
@@ -143,7 +176,7 @@ void print_verilog_top_testbench_memory_bank_port(std::fstream& fp,
   BasicPort en_port = module_manager.module_port(top_module, en_port_id);
   BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME), 1);
 
-  fp << generate_verilog_port(VERILOG_PORT_WIRE, en_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_WIRE, en_port) << ";" << "\n";
   print_verilog_wire_connection(fp, en_port, prog_clock_port, true);
 }
 
@@ -164,14 +197,14 @@ void print_verilog_top_testbench_frame_decoder_port(std::fstream& fp,
                                                               std::string(DECODER_ADDRESS_PORT_NAME));
   BasicPort addr_port = module_manager.module_port(top_module, addr_port_id);
 
-  fp << generate_verilog_port(VERILOG_PORT_REG, addr_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, addr_port) << ";" << "\n";
 
   /* Print the data-input port for the frame-based decoder here */
   print_verilog_comment(fp, std::string("---- Data input port for frame-based decoder -----"));
   ModulePortId din_port_id = module_manager.find_module_port(top_module,
                                                              std::string(DECODER_DATA_IN_PORT_NAME));
   BasicPort din_port = module_manager.module_port(top_module, din_port_id);
-  fp << generate_verilog_port(VERILOG_PORT_REG, din_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, din_port) << ";" << "\n";
 
   /* Wire the INVERTED programming clock to the enable signal !!! */
   print_verilog_comment(fp, std::string("---- Wire enable port of frame-based decoder to inverted programming clock -----"));
@@ -180,7 +213,7 @@ void print_verilog_top_testbench_frame_decoder_port(std::fstream& fp,
   BasicPort en_port = module_manager.module_port(top_module, en_port_id);
   BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME), 1);
 
-  fp << generate_verilog_port(VERILOG_PORT_WIRE, en_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_WIRE, en_port) << ";" << "\n";
   print_verilog_wire_connection(fp, en_port, prog_clock_port, true);
 }
 
@@ -197,7 +230,7 @@ void print_verilog_top_testbench_config_protocol_port(std::fstream& fp,
     print_verilog_top_testbench_flatten_memory_port(fp, module_manager, top_module);
     break;
   case CONFIG_MEM_SCAN_CHAIN:
-    print_verilog_top_testbench_config_chain_port(fp);
+    print_verilog_top_testbench_config_chain_port(fp, module_manager.num_config_regions(top_module));
     break;
   case CONFIG_MEM_MEMORY_BANK:
     print_verilog_top_testbench_memory_bank_port(fp, module_manager, top_module);
@@ -411,38 +444,19 @@ void print_verilog_top_testbench_global_ports_stimuli(std::fstream& fp,
 }
 
 /********************************************************************
- * This function prints the top testbench module declaration
- * and internal wires/port declaration
- * Ports can be classified in two categories:
- * 1. General-purpose ports, which are datapath I/Os, clock signals
- *    for the FPGA fabric and input benchmark
- * 2. Fabric-featured ports, which are required by configuration
- *    protocols.
- *    Due the difference in configuration protocols, the internal
- *    wires and ports will be different:
- *    (a) configuration-chain: we will have two ports,
- *        a head and a tail for the configuration chain,
- *        in addition to the regular ports.
- *    (b) memory-decoders: we will have a few ports to drive
- *        address lines for decoders and a bit input port to feed
- *        configuration bits
+ * This function prints the internal wires/port declaration of
+ * the top testbench which connect the FPGA fabric,
+ * and which are independent from the benchmark
+ * (see print_verilog_top_testbench_ports() for details)
  *******************************************************************/
 static
-void print_verilog_top_testbench_ports(std::fstream& fp,
-                                       const ModuleManager& module_manager,
-                                       const ModuleId& top_module,
-                                       const AtomContext& atom_ctx,
-                                       const VprNetlistAnnotation& netlist_annotation,
-                                       const std::vector<std::string>& clock_port_names,
-                                       const e_config_protocol_type& sram_orgz_type,
-                                       const std::string& circuit_name){
+void print_verilog_top_testbench_fabric_ports(std::fstream& fp,
+                                              const ModuleManager& module_manager,
+                                              const ModuleId& top_module,
+                                              const e_config_protocol_type& sram_orgz_type) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
-  /* Print module definition */
-  fp << "module " << circuit_name << std::string(AUTOCHECK_TOP_TESTBENCH_VERILOG_MODULE_POSTFIX);
-  fp << ";" << std::endl;
-
   /* Print regular local wires:
    * 1. global ports, i.e., reset, set and clock signals
    * 2. datapath I/O signals
@@ -450,30 +464,30 @@ void print_verilog_top_testbench_ports(std::fstream& fp,
   /* Global ports of top-level module  */
   print_verilog_comment(fp, std::string("----- Local wires for global ports of FPGA fabric -----"));
   for (const BasicPort& module_port : module_manager.module_ports_by_type(top_module, ModuleManager::MODULE_GLOBAL_PORT)) {
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";" << "\n";
   }
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Datapath I/Os of top-level module  */
   print_verilog_comment(fp, std::string("----- Local wires for I/Os of FPGA fabric -----"));
   for (const BasicPort& module_port : module_manager.module_ports_by_type(top_module, ModuleManager::MODULE_GPIO_PORT)) {
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";" << "\n";
   }
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   for (const BasicPort& module_port : module_manager.module_ports_by_type(top_module, ModuleManager::MODULE_GPIN_PORT)) {
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";" << "\n";
   }
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   for (const BasicPort& module_port : module_manager.module_ports_by_type(top_module, ModuleManager::MODULE_GPOUT_PORT)) {
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";" << "\n";
   }
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Add local wires/registers that drive stimulus
    * We create these general purpose ports here,
@@ -481,35 +495,74 @@ void print_verilog_top_testbench_ports(std::fstream& fp,
    */
   /* Configuration done port */
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
-  fp << generate_verilog_port(VERILOG_PORT_REG, config_done_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, config_done_port) << ";" << "\n";
 
   /* Programming clock */
   BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME), 1);
-  fp << generate_verilog_port(VERILOG_PORT_WIRE, prog_clock_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_WIRE, prog_clock_port) << ";" << "\n";
   BasicPort prog_clock_register_port(std::string(std::string(TOP_TB_PROG_CLOCK_PORT_NAME) + std::string(TOP_TB_CLOCK_REG_POSTFIX)), 1);
-  fp << generate_verilog_port(VERILOG_PORT_REG, prog_clock_register_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, prog_clock_register_port) << ";" << "\n";
 
   /* Operating clock */
   BasicPort op_clock_port(std::string(TOP_TB_OP_CLOCK_PORT_NAME), 1);
-  fp << generate_verilog_port(VERILOG_PORT_WIRE, op_clock_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_WIRE, op_clock_port) << ";" << "\n";
   BasicPort op_clock_register_port(std::string(std::string(TOP_TB_OP_CLOCK_PORT_NAME) + std::string(TOP_TB_CLOCK_REG_POSTFIX)), 1);
-  fp << generate_verilog_port(VERILOG_PORT_REG, op_clock_register_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, op_clock_register_port) << ";" << "\n";
 
   /* Programming set and reset */
   BasicPort prog_reset_port(std::string(TOP_TB_PROG_RESET_PORT_NAME), 1);
-  fp << generate_verilog_port(VERILOG_PORT_REG, prog_reset_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, prog_reset_port) << ";" << "\n";
   BasicPort prog_set_port(std::string(TOP_TB_PROG_SET_PORT_NAME), 1);
-  fp << generate_verilog_port(VERILOG_PORT_REG, prog_set_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, prog_set_port) << ";" << "\n";
 
   /* Global set and reset */
   BasicPort reset_port(std::string(TOP_TB_RESET_PORT_NAME), 1);
-  fp << generate_verilog_port(VERILOG_PORT_REG, reset_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, reset_port) << ";" << "\n";
   BasicPort set_port(std::string(TOP_TB_SET_PORT_NAME), 1);
-  fp << generate_verilog_port(VERILOG_PORT_REG, set_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, set_port) << ";" << "\n";
 
   /* Configuration ports depend on the organization of SRAMs */
   print_verilog_top_testbench_config_protocol_port(fp, sram_orgz_type,
                                                    module_manager, top_module);
+}
+
+/********************************************************************
+ * This function prints the top testbench module declaration
+ * and internal wires/port declaration
+ * Ports can be classified in two categories:
+ * 1. General-purpose ports, which are datapath I/Os, clock signals
+ *    for the FPGA fabric and input benchmark
+ * 2. Fabric-featured ports, which are required by configuration
+ *    protocols.
+ *    Due the difference in configuration protocols, the internal
+ *    wires and ports will be different:
+ *    (a) configuration-chain: we will have two ports,
+ *        a head and a tail for the configuration chain,
+ *        in addition to the regular ports.
+ *    (b) memory-decoders: we will have a few ports to drive
+ *        address lines for decoders and a bit input port to feed
+ *        configuration bits
+ *******************************************************************/
+static
+void print_verilog_top_testbench_ports(std::fstream& fp,
+                                       const ModuleManager& module_manager,
+                                       const ModuleId& top_module,
+                                       const AtomContext& atom_ctx,
+                                       const VprNetlistAnnotation& netlist_annotation,
+                                       const std::vector<std::string>& clock_port_names,
+                                       const e_config_protocol_type& sram_orgz_type,
+                                       const std::string& circuit_name){
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  /* Print module definition */
+  fp << "module " << circuit_name << std::string(AUTOCHECK_TOP_TESTBENCH_VERILOG_MODULE_POSTFIX);
+  fp << ";" << "\n";
+
+  /* Local wires and registers of the FPGA fabric */
+  print_verilog_top_testbench_fabric_ports(fp, module_manager, top_module, sram_orgz_type);
+
+  BasicPort op_clock_port(std::string(TOP_TB_OP_CLOCK_PORT_NAME), 1);
 
   /* Create a clock port if the benchmark have one but not in the default name!
    * We will wire the clock directly to the operating clock directly
@@ -532,7 +585,7 @@ void print_verilog_top_testbench_ports(std::fstream& fp,
     /* Print the clock and wire it to op_clock */
     print_verilog_comment(fp, std::string("----- Create a clock for benchmark and wire it to op_clock -------"));
     BasicPort clock_port(clock_port_name, 1);
-    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, clock_port) << ";" << std::endl;
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, clock_port) << ";" << "\n";
     print_verilog_wire_connection(fp, clock_port, op_clock_port, false);
   }
 
@@ -547,7 +600,80 @@ void print_verilog_top_testbench_ports(std::fstream& fp,
    * determine if the simulation succeed or failed
    */
   print_verilog_comment(fp, std::string("----- Error counter -----"));
-  fp << "\tinteger " << TOP_TESTBENCH_ERROR_COUNTER << "= 0;" << std::endl;
+  fp << "\tinteger " << TOP_TESTBENCH_ERROR_COUNTER << "= 0;" << "\n";
+}
+
+/********************************************************************
+ * Find the value of configurable memories after the first programming clock cycle,
+ * where the programming reset signal is enabled.
+ * Fast configuration does not need to load the bits which equal this value.
+ * - A programming reset port initializes the memories to '0'
+ * - Otherwise, a programming set port initializes the memories to '1'
+ *
+ * Return false if the memories are not initialized, 
+ * where all the bits should be loaded
+ *******************************************************************/
+static
+bool find_fast_configuration_bit_value_to_skip(const CircuitLibrary& circuit_lib,
+                                               const std::vector<CircuitPortId>& global_ports,
+                                               bool& bit_value_to_skip) {
+  bool has_prog_set = false;
+  for (const CircuitPortId& model_global_port : global_ports) {
+    if ( (CIRCUIT_MODEL_PORT_CLOCK == circuit_lib.port_type(model_global_port))
+      || (true == circuit_lib.port_is_config_enable(model_global_port))
+      || (false == circuit_lib.port_is_prog(model_global_port)) ) {
+      continue;
+    }
+    if (true == circuit_lib.port_is_reset(model_global_port)) {
+      bit_value_to_skip = false;
+      return true;
+    }
+    if (true == circuit_lib.port_is_set(model_global_port)) {
+      has_prog_set = true;
+    }
+  }
+
+  if (true == has_prog_set) {
+    bit_value_to_skip = true;
+    return true;
+  }
+
+  return false;
+}
+
+/********************************************************************
+ * Check if all the bits of a memory-bank data word equal the reset value,
+ * so that the word can be skipped by fast configuration
+ *******************************************************************/
+static
+bool is_memory_bank_word_reset_value(const FabricBitstream& fabric_bitstream,
+                                     const std::vector<FabricBitId>& word,
+                                     const bool& bit_value_to_skip) {
+  for (const FabricBitId& bit_id : word) {
+    if ( (FabricBitId::INVALID() != bit_id)
+      && (bit_value_to_skip != fabric_bitstream.bit_din(bit_id)) ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/********************************************************************
+ * Append the binary characters of a memory-bank data word to a string,
+ * where the positions without memory cells are given zeros
+ *******************************************************************/
+static
+void append_memory_bank_word_chars(std::string& buffer,
+                                   const FabricBitstream& fabric_bitstream,
+                                   const std::vector<FabricBitId>& word) {
+  for (const FabricBitId& bit_id : word) {
+    if ( (FabricBitId::INVALID() != bit_id)
+      && (true == fabric_bitstream.bit_din(bit_id)) ) {
+      buffer.push_back('1');
+    } else {
+      buffer.push_back('0');
+    }
+  }
 }
 
 /********************************************************************
@@ -557,10 +683,14 @@ void print_verilog_top_testbench_ports(std::fstream& fp,
  * If we consider fast configuration, the number of clock cycles will be
  * the number of non-zero data points in the fabric bitstream
  * Note that this will not applicable to configuration chain!!!
+ * Configuration chains in multiple regions are loaded in parallel,
+ * so the number of clock cycles depends on the largest region
+ * Memory banks which write a word at each WL address require a clock cycle per word
  *******************************************************************/
 static
 size_t calculate_num_config_clock_cycles(const e_config_protocol_type& sram_orgz_type,
                                          const bool& fast_configuration,
+                                         const bool& bit_value_to_skip,
                                          const BitstreamManager& bitstream_manager,
                                          const FabricBitstream& fabric_bitstream) {
   size_t num_config_clock_cycles = 1 + fabric_bitstream.num_bits();
@@ -573,37 +703,73 @@ size_t calculate_num_config_clock_cycles(const e_config_protocol_type& sram_orgz
      */
     num_config_clock_cycles = 2;
     break;
-  case CONFIG_MEM_SCAN_CHAIN:
-    /* For fast configuraiton, the bitstream size counts from the first bit '1' */
+  case CONFIG_MEM_SCAN_CHAIN: {
+    size_t num_cycles = find_fabric_regional_bitstream_max_size(fabric_bitstream);
+    num_config_clock_cycles = 1 + num_cycles;
+    /* For fast configuraiton, the bitstream size counts from the first bit which differs from the reset value */
     if (true == fast_configuration) {
       size_t full_num_config_clock_cycles = num_config_clock_cycles;
-      size_t num_bits_to_skip = 0;
-      for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
-        if (true == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) {
-          break;
+      size_t num_bits_to_skip = num_cycles;
+      for (size_t region = 0; region < fabric_bitstream.num_regions(); ++region) {
+        for (size_t cycle = 0; cycle < num_bits_to_skip; ++cycle) {
+          FabricBitId bit_id = find_fabric_regional_bitstream_cycle_bit(fabric_bitstream, region, cycle, num_cycles);
+          if ( (FabricBitId::INVALID() != bit_id)
+            && (bit_value_to_skip != bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) ) {
+            num_bits_to_skip = cycle;
+            break;
+          }
         }
-        num_bits_to_skip++;
       }
 
       num_config_clock_cycles = full_num_config_clock_cycles - num_bits_to_skip;
 
+      VTR_LOG("Fast configuration skips %lu configuration clock cycles loading the reset value '%d'\n",
+              full_num_config_clock_cycles - num_config_clock_cycles,
+              bit_value_to_skip ? 1 : 0);
       VTR_LOG("Fast configuration reduces number of configuration clock cycles from %lu to %lu (compression_rate = %f%)\n",
               full_num_config_clock_cycles,
               num_config_clock_cycles,
               100. * ((float)num_config_clock_cycles / (float)full_num_config_clock_cycles - 1.));
     }
     break;
+  }
   case CONFIG_MEM_MEMORY_BANK:
   case CONFIG_MEM_FRAME_BASED: {
-    /* For fast configuration, we will skip all the zero data points */
+    if (true == fabric_bitstream.use_word_din()) {
+      std::map<size_t, std::vector<FabricBitId>> words = find_fabric_bitstream_memory_bank_words(fabric_bitstream);
+      num_config_clock_cycles = 1 + words.size();
+      /* For fast configuration, we will skip all the words which equal the reset value */
+      if (true == fast_configuration) {
+        size_t full_num_config_clock_cycles = num_config_clock_cycles;
+        num_config_clock_cycles = 1;
+        for (const auto& word : words) {
+          if (false == is_memory_bank_word_reset_value(fabric_bitstream, word.second, bit_value_to_skip)) {
+            num_config_clock_cycles++;
+          }
+        }
+        VTR_LOG("Fast configuration skips %lu configuration clock cycles loading the reset value '%d'\n",
+                full_num_config_clock_cycles - num_config_clock_cycles,
+                bit_value_to_skip ? 1 : 0);
+        VTR_LOG("Fast configuration reduces number of configuration clock cycles from %lu to %lu (compression_rate = %f%)\n",
+                full_num_config_clock_cycles,
+                num_config_clock_cycles,
+                100. * ((float)num_config_clock_cycles / (float)full_num_config_clock_cycles - 1.));
+      }
+      break;
+    }
+
+    /* For fast configuration, we will skip all the data points which equal the reset value */
     if (true == fast_configuration) {
       size_t full_num_config_clock_cycles = num_config_clock_cycles;
       num_config_clock_cycles = 1;
       for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
-        if (true == fabric_bitstream.bit_din(bit_id)) {
+        if (bit_value_to_skip != fabric_bitstream.bit_din(bit_id)) {
           num_config_clock_cycles++;
         }
       }
+      VTR_LOG("Fast configuration skips %lu configuration clock cycles loading the reset value '%d'\n",
+              full_num_config_clock_cycles - num_config_clock_cycles,
+              bit_value_to_skip ? 1 : 0);
       VTR_LOG("Fast configuration reduces number of configuration clock cycles from %lu to %lu (compression_rate = %f%)\n",
               full_num_config_clock_cycles,
               num_config_clock_cycles,
@@ -658,13 +824,13 @@ void print_verilog_top_testbench_benchmark_instance(std::fstream& fp,
   print_verilog_comment(fp, std::string("----- End reference Benchmark Instanication -------"));
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Condition ends for the benchmark instanciation */
   print_verilog_endif(fp);
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -674,37 +840,77 @@ void print_verilog_top_testbench_benchmark_instance(std::fstream& fp,
  * During each programming cycle, we feed the input of scan chain with a memory bit
  *******************************************************************/
 static
-void print_verilog_top_testbench_load_bitstream_task_configuration_chain(std::fstream& fp) {
+void print_verilog_top_testbench_load_bitstream_task_configuration_chain(std::fstream& fp,
+                                                                         const size_t& num_regions) {
 
   /* Validate the file stream */
   valid_file_stream(fp);
 
   BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME), 1);
-  BasicPort cc_head_port(generate_configuration_chain_head_name(), 1);
-  BasicPort cc_head_value(generate_configuration_chain_head_name() + std::string("_val"), 1);
+  BasicPort cc_head_port(generate_configuration_chain_head_name(), num_regions);
+  BasicPort cc_head_value(generate_configuration_chain_head_name() + std::string("_val"), num_regions);
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Feed the scan-chain input at each falling edge of programming clock
    * It aims at avoid racing the programming clock (scan-chain data changes at the rising edge).
    */
   print_verilog_comment(fp, std::string("----- Task: input values during a programming clock cycle -----"));
-  fp << "task " << std::string(TOP_TESTBENCH_PROG_TASK_NAME) << ";" << std::endl;
-  fp << generate_verilog_port(VERILOG_PORT_INPUT, cc_head_value) << ";" << std::endl;
-  fp << "\tbegin" << std::endl;
-  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");" << std::endl;
+  fp << "task " << std::string(TOP_TESTBENCH_PROG_TASK_NAME) << ";" << "\n";
+  fp << generate_verilog_port(VERILOG_PORT_INPUT, cc_head_value) << ";" << "\n";
+  fp << "\tbegin" << "\n";
+  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");" << "\n";
   fp << "\t\t\t";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, cc_head_port);
   fp << " = ";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, cc_head_value);
-  fp << ";" << std::endl;
+  fp << ";" << "\n";
 
-  fp << "\tend" << std::endl;
-  fp << "endtask" << std::endl;
+  fp << "\tend" << "\n";
+  fp << "endtask" << "\n";
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
+}
+
+/********************************************************************
+ * Print a task in Verilog format, which is a reference model of
+ * the run-length decompressor of the configuration chain bitstream
+ * Each run-length token (see binary_fabric_bitstream.h) is expanded
+ * into configuration bits, which are fed by the programming task one by one.
+ * Similar to a decoder on chip, only a counter of the remaining bits is required
+ * to find the end of the last literal token
+ *******************************************************************/
+static
+void print_verilog_top_testbench_decompress_bitstream_task_configuration_chain(std::fstream& fp) {
+
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  std::string counter_name(TOP_TESTBENCH_PROG_RLE_COUNTER_NAME);
+
+  print_verilog_comment(fp, std::string("----- Task: decompress a run-length token into configuration bits -----"));
+  /* The counter is a plain integer, which is not a port of the fabric */
+  fp << "integer " << counter_name << ";" << "\n";
+  fp << "task " << std::string(TOP_TESTBENCH_PROG_RLE_TASK_NAME) << ";" << "\n";
+  /* Bit i of the token is the bit i of the 16-bit word written by the encoder,
+   * so the token is declared with its msb on the left
+   */
+  fp << "input [15:0] token;" << "\n";
+  fp << "integer ibit;" << "\n";
+  fp << "\tbegin" << "\n";
+  print_verilog_comment(fp, std::string("----- token[15] = 1: a run of (token[13:0] + 1) bits of token[14]; otherwise 15 literal bits, where token[i] is the i-th bit -----"));
+  fp << "\t\tfor (ibit = 0; (ibit < (token[15] ? token[13:0] + 1 : " << FABRIC_BITSTREAM_RLE_NUM_LITERAL_BITS << "))";
+  fp << " && (0 < " << counter_name << "); ibit = ibit + 1) begin" << "\n";
+  fp << "\t\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME) << "(token[15] ? token[14] : token[ibit]);" << "\n";
+  fp << "\t\t\t" << counter_name << " = " << counter_name << " - 1;" << "\n";
+  fp << "\t\tend" << "\n";
+  fp << "\tend" << "\n";
+  fp << "endtask" << "\n";
+
+  /* Add an empty line as splitter */
+  fp << "\n";
 }
 
 /********************************************************************
@@ -715,6 +921,8 @@ void print_verilog_top_testbench_load_bitstream_task_configuration_chain(std::fs
  * - an address to the BL address port of top module
  * - an address to the WL address port of top module
  * - a data input to the din port of top module
+ * When a word is written at each WL address, there is no BL address,
+ * and the data input is a word
  *******************************************************************/
 static
 void print_verilog_top_testbench_load_bitstream_task_memory_bank(std::fstream& fp,
@@ -730,7 +938,11 @@ void print_verilog_top_testbench_load_bitstream_task_memory_bank(std::fstream& f
 
   ModulePortId bl_addr_port_id = module_manager.find_module_port(top_module,
                                                                  std::string(DECODER_BL_ADDRESS_PORT_NAME));
-  BasicPort bl_addr_port = module_manager.module_port(top_module, bl_addr_port_id);
+  bool use_bl_addr = module_manager.valid_module_port_id(top_module, bl_addr_port_id);
+  BasicPort bl_addr_port;
+  if (true == use_bl_addr) {
+    bl_addr_port = module_manager.module_port(top_module, bl_addr_port_id);
+  }
   BasicPort bl_addr_value = bl_addr_port;
   bl_addr_value.set_name(std::string(MEMORY_BL_PORT_NAME) + std::string("_val"));
 
@@ -747,46 +959,50 @@ void print_verilog_top_testbench_load_bitstream_task_memory_bank(std::fstream& f
   din_value.set_name(std::string(DECODER_DATA_IN_PORT_NAME) + std::string("_val"));
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Feed the address and data input at each falling edge of programming clock
    * As the enable signal is wired to the programming clock, we should synchronize
    * address and data with the enable signal
    */
   print_verilog_comment(fp, std::string("----- Task: assign BL and WL address, and data values at rising edge of enable signal -----"));
-  fp << "task " << std::string(TOP_TESTBENCH_PROG_TASK_NAME) << ";" << std::endl;
-  fp << generate_verilog_port(VERILOG_PORT_INPUT, bl_addr_value) << ";" << std::endl;
-  fp << generate_verilog_port(VERILOG_PORT_INPUT, wl_addr_value) << ";" << std::endl;
-  fp << generate_verilog_port(VERILOG_PORT_INPUT, din_value) << ";" << std::endl;
-  fp << "\tbegin" << std::endl;
-  fp << "\t\t@(posedge " << generate_verilog_port(VERILOG_PORT_CONKT, en_port) << ");" << std::endl;
+  fp << "task " << std::string(TOP_TESTBENCH_PROG_TASK_NAME) << ";" << "\n";
+  if (true == use_bl_addr) {
+    fp << generate_verilog_port(VERILOG_PORT_INPUT, bl_addr_value) << ";" << "\n";
+  }
+  fp << generate_verilog_port(VERILOG_PORT_INPUT, wl_addr_value) << ";" << "\n";
+  fp << generate_verilog_port(VERILOG_PORT_INPUT, din_value) << ";" << "\n";
+  fp << "\tbegin" << "\n";
+  fp << "\t\t@(posedge " << generate_verilog_port(VERILOG_PORT_CONKT, en_port) << ");" << "\n";
 
-  fp << "\t\t\t";
-  fp << generate_verilog_port(VERILOG_PORT_CONKT, bl_addr_port);
-  fp << " = ";
-  fp << generate_verilog_port(VERILOG_PORT_CONKT, bl_addr_value);
-  fp << ";" << std::endl;
-  fp << std::endl;
+  if (true == use_bl_addr) {
+    fp << "\t\t\t";
+    fp << generate_verilog_port(VERILOG_PORT_CONKT, bl_addr_port);
+    fp << " = ";
+    fp << generate_verilog_port(VERILOG_PORT_CONKT, bl_addr_value);
+    fp << ";" << "\n";
+    fp << "\n";
+  }
 
   fp << "\t\t\t";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, wl_addr_port);
   fp << " = ";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, wl_addr_value);
-  fp << ";" << std::endl;
-  fp << std::endl;
+  fp << ";" << "\n";
+  fp << "\n";
 
   fp << "\t\t\t";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, din_port);
   fp << " = ";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, din_value);
-  fp << ";" << std::endl;
-  fp << std::endl;
+  fp << ";" << "\n";
+  fp << "\n";
 
-  fp << "\tend" << std::endl;
-  fp << "endtask" << std::endl;
+  fp << "\tend" << "\n";
+  fp << "endtask" << "\n";
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 
@@ -823,38 +1039,38 @@ void print_verilog_top_testbench_load_bitstream_task_frame_decoder(std::fstream&
   din_value.set_name(std::string(DECODER_DATA_IN_PORT_NAME) + std::string("_val"));
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Feed the address and data input at each falling edge of programming clock
    * As the enable signal is wired to the programming clock, we should synchronize
    * address and data with the enable signal
    */
   print_verilog_comment(fp, std::string("----- Task: assign address and data values at rising edge of enable signal -----"));
-  fp << "task " << std::string(TOP_TESTBENCH_PROG_TASK_NAME) << ";" << std::endl;
-  fp << generate_verilog_port(VERILOG_PORT_INPUT, addr_value) << ";" << std::endl;
-  fp << generate_verilog_port(VERILOG_PORT_INPUT, din_value) << ";" << std::endl;
-  fp << "\tbegin" << std::endl;
-  fp << "\t\t@(posedge " << generate_verilog_port(VERILOG_PORT_CONKT, en_port) << ");" << std::endl;
+  fp << "task " << std::string(TOP_TESTBENCH_PROG_TASK_NAME) << ";" << "\n";
+  fp << generate_verilog_port(VERILOG_PORT_INPUT, addr_value) << ";" << "\n";
+  fp << generate_verilog_port(VERILOG_PORT_INPUT, din_value) << ";" << "\n";
+  fp << "\tbegin" << "\n";
+  fp << "\t\t@(posedge " << generate_verilog_port(VERILOG_PORT_CONKT, en_port) << ");" << "\n";
 
   fp << "\t\t\t";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, addr_port);
   fp << " = ";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, addr_value);
-  fp << ";" << std::endl;
-  fp << std::endl;
+  fp << ";" << "\n";
+  fp << "\n";
 
   fp << "\t\t\t";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, din_port);
   fp << " = ";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, din_value);
-  fp << ";" << std::endl;
-  fp << std::endl;
+  fp << ";" << "\n";
+  fp << "\n";
 
-  fp << "\tend" << std::endl;
-  fp << "endtask" << std::endl;
+  fp << "\tend" << "\n";
+  fp << "endtask" << "\n";
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -863,6 +1079,7 @@ void print_verilog_top_testbench_load_bitstream_task_frame_decoder(std::fstream&
 static
 void print_verilog_top_testbench_load_bitstream_task(std::fstream& fp,
                                                      const e_config_protocol_type& sram_orgz_type,
+                                                     const bool& compress_bitstream,
                                                      const ModuleManager& module_manager,
                                                      const ModuleId& top_module) {
   switch (sram_orgz_type) {
@@ -870,7 +1087,10 @@ void print_verilog_top_testbench_load_bitstream_task(std::fstream& fp,
     /* No need to have a specific task. Loading is done in 1 clock cycle */
     break;
   case CONFIG_MEM_SCAN_CHAIN:
-    print_verilog_top_testbench_load_bitstream_task_configuration_chain(fp);
+    print_verilog_top_testbench_load_bitstream_task_configuration_chain(fp, module_manager.num_config_regions(top_module));
+    if (true == compress_bitstream) {
+      print_verilog_top_testbench_decompress_bitstream_task_configuration_chain(fp);
+    }
     break;
   case CONFIG_MEM_MEMORY_BANK:
     print_verilog_top_testbench_load_bitstream_task_memory_bank(fp,
@@ -889,28 +1109,52 @@ void print_verilog_top_testbench_load_bitstream_task(std::fstream& fp,
   }
 }
 
+/********************************************************************
+ * Print the configuration done signal of the top testbench,
+ * which is enabled after a given number of programming clock cycles
+ *******************************************************************/
+static
+void print_verilog_top_testbench_config_done_stimulus(std::fstream& fp,
+                                                      const size_t& num_config_clock_cycles,
+                                                      const float& prog_clock_period,
+                                                      const float& timescale) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  print_verilog_comment(fp, std::string("----- Number of clock cycles in configuration phase: " + std::to_string(num_config_clock_cycles) + " -----"));
+
+  BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
+
+  /* Generate stimuli waveform for configuration done signals */
+  print_verilog_comment(fp, "----- Begin configuration done signal generation -----");
+  print_verilog_pulse_stimuli(fp, config_done_port,
+                              0, /* Initial value */
+                              num_config_clock_cycles * prog_clock_period / timescale, 0);
+  print_verilog_comment(fp, "----- End configuration done signal generation -----");
+  fp << "\n";
+}
+
 /********************************************************************
  * Print generatic input stimuli for the top testbench
  * include:
- * 1. configuration done signal
- * 2. programming clock
- * 3. operating clock
- * 4. programming reset signal
- * 5. programming set signal
- * 6. reset signal
- * 7. set signal
+ * 1. programming clock
+ * 2. operating clock
+ * 3. programming reset signal
+ * 4. programming set signal
+ * 5. reset signal
+ * 6. set signal
+ * The configuration done signal is generated separately,
+ * and the clocks are gated by it
  *******************************************************************/
 static
 void print_verilog_top_testbench_generic_stimulus(std::fstream& fp,
-                                                  const size_t& num_config_clock_cycles,
+                                                  const bool& enable_prog_set,
                                                   const float& prog_clock_period,
                                                   const float& op_clock_period,
                                                   const float& timescale) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
-  print_verilog_comment(fp, std::string("----- Number of clock cycles in configuration phase: " + std::to_string(num_config_clock_cycles) + " -----"));
-
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
 
   BasicPort op_clock_port(std::string(TOP_TB_OP_CLOCK_PORT_NAME), 1);
@@ -925,14 +1169,6 @@ void print_verilog_top_testbench_generic_stimulus(std::fstream& fp,
   BasicPort reset_port(std::string(TOP_TB_RESET_PORT_NAME), 1);
   BasicPort set_port(std::string(TOP_TB_SET_PORT_NAME), 1);
 
-  /* Generate stimuli waveform for configuration done signals */
-  print_verilog_comment(fp, "----- Begin configuration done signal generation -----");
-  print_verilog_pulse_stimuli(fp, config_done_port,
-                              0, /* Initial value */
-                              num_config_clock_cycles * prog_clock_period / timescale, 0);
-  print_verilog_comment(fp, "----- End configuration done signal generation -----");
-  fp << std::endl;
-
   /* Generate stimuli waveform for programming clock signals */
   print_verilog_comment(fp, "----- Begin raw programming clock signal generation -----");
   print_verilog_clock_stimuli(fp, prog_clock_register_port,
@@ -940,7 +1176,7 @@ void print_verilog_top_testbench_generic_stimulus(std::fstream& fp,
                               0.5 * prog_clock_period / timescale,
                               std::string());
   print_verilog_comment(fp, "----- End raw programming clock signal generation -----");
-  fp << std::endl;
+  fp << "\n";
 
   /* Programming clock should be only enabled during programming phase.
    * When configuration is done (config_done is enabled), programming clock should be always zero.
@@ -950,9 +1186,9 @@ void print_verilog_top_testbench_generic_stimulus(std::fstream& fp,
   fp << " = " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_register_port);
   fp << " & (~" << generate_verilog_port(VERILOG_PORT_CONKT, config_done_port) << ")";
   fp << " & (~" << generate_verilog_port(VERILOG_PORT_CONKT, prog_reset_port) << ")";
-  fp << ";" << std::endl;
+  fp << ";" << "\n";
 
-  fp << std::endl;
+  fp << "\n";
 
   /* Generate stimuli waveform for operating clock signals */
   print_verilog_comment(fp, "----- Begin raw operating clock signal generation -----");
@@ -969,9 +1205,9 @@ void print_verilog_top_testbench_generic_stimulus(std::fstream& fp,
   fp << "\tassign " << generate_verilog_port(VERILOG_PORT_CONKT, op_clock_port);
   fp << " = " << generate_verilog_port(VERILOG_PORT_CONKT, op_clock_register_port);
   fp << " & " << generate_verilog_port(VERILOG_PORT_CONKT, config_done_port);
-  fp << ";" << std::endl;
+  fp << ";" << "\n";
 
-  fp << std::endl;
+  fp << "\n";
 
   /* Reset signal for configuration circuit:
    * only enable during the first clock cycle in programming phase
@@ -982,16 +1218,27 @@ void print_verilog_top_testbench_generic_stimulus(std::fstream& fp,
                               prog_clock_period / timescale, 0);
   print_verilog_comment(fp, "----- End programming reset signal generation -----");
 
-  fp << std::endl;
+  fp << "\n";
 
-  /* Programming set signal for configuration circuit : always disabled */
-  print_verilog_comment(fp, "----- Begin programming set signal generation: always disabled -----");
-  print_verilog_pulse_stimuli(fp, prog_set_port,
-                              0, /* Initial value */
-                              prog_clock_period / timescale, 0);
-  print_verilog_comment(fp, "----- End programming set signal generation: always disabled -----");
+  /* Programming set signal for configuration circuit : 
+   * always disabled, unless the configurable memories are initialized by set,
+   * which is then only enabled during the first clock cycle in programming phase
+   */
+  if (true == enable_prog_set) {
+    print_verilog_comment(fp, "----- Begin programming set signal generation -----");
+    print_verilog_pulse_stimuli(fp, prog_set_port,
+                                1, /* Initial value */
+                                prog_clock_period / timescale, 0);
+    print_verilog_comment(fp, "----- End programming set signal generation -----");
+  } else {
+    print_verilog_comment(fp, "----- Begin programming set signal generation: always disabled -----");
+    print_verilog_pulse_stimuli(fp, prog_set_port,
+                                0, /* Initial value */
+                                prog_clock_period / timescale, 0);
+    print_verilog_comment(fp, "----- End programming set signal generation: always disabled -----");
+  }
 
-  fp << std::endl;
+  fp << "\n";
 
   /* Operating reset signals: only enabled during the first clock cycle in operation phase */
   std::vector<float> reset_pulse_widths;
@@ -1018,7 +1265,7 @@ void print_verilog_top_testbench_generic_stimulus(std::fstream& fp,
                               op_clock_period / timescale, 0);
   print_verilog_comment(fp, "----- End operating set signal generation: always disabled -----");
 
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -1054,25 +1301,25 @@ void print_verilog_top_testbench_vanilla_bitstream(std::fstream& fp,
   std::vector<size_t> initial_wl_values(wl_port.get_width(), 0);
 
   print_verilog_comment(fp, "----- Begin bitstream loading during configuration phase -----");
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial" << "\n";
+  fp << "\tbegin" << "\n";
   print_verilog_comment(fp, "----- Configuration chain default input -----");
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(bl_port, initial_bl_values);
-  fp << ";" << std::endl;
+  fp << ";" << "\n";
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(wl_port, initial_wl_values);
-  fp << ";" << std::endl;
+  fp << ";" << "\n";
 
-  fp << std::endl;
+  fp << "\n";
 
-  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ") begin" << std::endl;
+  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ") begin" << "\n";
 
   /* Enable all the WLs */
   std::vector<size_t> enabled_wl_values(wl_port.get_width(), 1);
   fp << "\t\t\t";
   fp << generate_verilog_port_constant_values(wl_port, enabled_wl_values);
-  fp << ";" << std::endl;
+  fp << ";" << "\n";
 
   size_t ibit = 0;
   for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
@@ -1083,22 +1330,22 @@ void print_verilog_top_testbench_vanilla_bitstream(std::fstream& fp,
     fp << generate_verilog_port(VERILOG_PORT_CONKT, cur_bl_port);
     fp << " = ";
     fp << "1'b" << (size_t)bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id));
-    fp << ";" << std::endl;
+    fp << ";" << "\n";
 
     ibit++;
   }
 
-  fp << "\t\tend" << std::endl;
+  fp << "\t\tend" << "\n";
 
   /* Disable all the WLs */
-  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");" << std::endl;
+  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");" << "\n";
 
   fp << "\t\t\t";
   fp << generate_verilog_port_constant_values(wl_port, initial_wl_values);
-  fp << ";" << std::endl;
+  fp << ";" << "\n";
 
   /* Raise the flag of configuration done when bitstream loading is complete */
-  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");" << std::endl;
+  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");" << "\n";
 
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
   fp << "\t\t\t";
@@ -1106,12 +1353,82 @@ void print_verilog_top_testbench_vanilla_bitstream(std::fstream& fp,
   fp << " <= ";
   std::vector<size_t> config_done_enable_values(config_done_port.get_width(), 1);
   fp << generate_verilog_constant_values(config_done_enable_values);
-  fp << ";" << std::endl;
+  fp << ";" << "\n";
 
-  fp << "\tend" << std::endl;
+  fp << "\tend" << "\n";
   print_verilog_comment(fp, "----- End bitstream loading during configuration phase -----");
 }
 
+/********************************************************************
+ * Print the declaration of a memory in Verilog format, which holds
+ * the words of a bitstream memory file, as well as an index to visit the words
+ * Each word is the arguments of a programming cycle
+ *******************************************************************/
+static
+void print_verilog_top_testbench_bitstream_memory_declaration(std::fstream& fp,
+                                                              const size_t& word_width,
+                                                              const size_t& num_words) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  /* An empty bitstream, e.g., all zeros in fast configuration, requires no memory */
+  if (0 == num_words) {
+    return;
+  }
+
+  print_verilog_comment(fp, std::string("----- Bitstream memory: " + std::to_string(num_words) + " words loaded from file -----"));
+  fp << "reg [0:" << word_width - 1 << "] " << std::string(TOP_TESTBENCH_BITSTREAM_MEMORY_NAME);
+  fp << " [0:" << num_words - 1 << "];" << "\n";
+  fp << "integer " << std::string(TOP_TESTBENCH_BITSTREAM_MEMORY_INDEX_NAME) << ";" << "\n";
+  fp << "\n";
+}
+
+/********************************************************************
+ * Print a loop in Verilog format, which reads a bitstream memory file
+ * with $readmemb or $readmemh, and then calls a programming task for each word
+ * The arguments of the task are the fields of a word, from left to right
+ * For example, fields of [4, 4, 1] are printed as 
+ *   task(bitstream_mem[index][0:3], bitstream_mem[index][4:7], bitstream_mem[index][8:8]);
+ *******************************************************************/
+static
+void print_verilog_top_testbench_bitstream_memory_load(std::fstream& fp,
+                                                       const std::string& bitstream_memory_fname,
+                                                       const bool& hex_format,
+                                                       const size_t& num_words,
+                                                       const std::string& task_name,
+                                                       const std::vector<size_t>& field_widths) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  if (0 == num_words) {
+    return;
+  }
+
+  std::string mem_name(TOP_TESTBENCH_BITSTREAM_MEMORY_NAME);
+  std::string index_name(TOP_TESTBENCH_BITSTREAM_MEMORY_INDEX_NAME);
+
+  print_verilog_comment(fp, std::string("----- Load the bitstream from file '" + bitstream_memory_fname + "' -----"));
+  fp << "\t\t$readmem" << (hex_format ? "h" : "b");
+  fp << "(\"" << bitstream_memory_fname << "\", " << mem_name << ");" << "\n";
+  fp << "\t\tfor (" << index_name << " = 0; " << index_name << " < " << num_words << "; ";
+  fp << index_name << " = " << index_name << " + 1) begin" << "\n";
+  fp << "\t\t\t" << task_name << "(";
+  size_t field_lsb = 0;
+  for (size_t ifield = 0; ifield < field_widths.size(); ++ifield) {
+    if (0 < ifield) {
+      fp << ", ";
+    }
+    fp << mem_name << "[" << index_name << "]";
+    /* A single field is the whole word */
+    if (1 < field_widths.size()) {
+      fp << "[" << field_lsb << ":" << field_lsb + field_widths[ifield] - 1 << "]";
+    }
+    field_lsb += field_widths[ifield];
+  }
+  fp << ");" << "\n";
+  fp << "\t\tend" << "\n";
+}
+
 /********************************************************************
  * Print stimulus for a FPGA fabric with a configuration chain protocol
  * where configuration bits are programming in serial (one by one)
@@ -1127,55 +1444,132 @@ void print_verilog_top_testbench_vanilla_bitstream(std::fstream& fp,
 static
 void print_verilog_top_testbench_configuration_chain_bitstream(std::fstream& fp,
                                                                const bool& fast_configuration,
+                                                               const bool& bit_value_to_skip,
+                                                               const bool& compress_bitstream,
+                                                               const std::string& bitstream_memory_fname,
                                                                const BitstreamManager& bitstream_manager,
                                                                const FabricBitstream& fabric_bitstream) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
+  /* Configuration chains in multiple regions are loaded in parallel,
+   * each bit of a word is loaded to a region, starting from the first region
+   */
+  size_t num_regions = fabric_bitstream.num_regions();
+  VTR_ASSERT( (false == compress_bitstream) || (1 == num_regions) );
+  size_t num_cycles = find_fabric_regional_bitstream_max_size(fabric_bitstream);
+
+  /* Attention: when the fast configuration is enabled, we will start from the first bit
+   * which is different from the reset value.
+   * This requires a reset signal (as we forced in the first clock cycle)
+   */
+  bool start_config = false;
+  std::vector<std::string> config_words;
+  for (size_t cycle = 0; cycle < num_cycles; ++cycle) {
+    std::string config_word(num_regions, '0');
+    for (size_t region = 0; region < num_regions; ++region) {
+      FabricBitId bit_id = find_fabric_regional_bitstream_cycle_bit(fabric_bitstream, region, cycle, num_cycles);
+      if (FabricBitId::INVALID() == bit_id) {
+        continue;
+      }
+      bool bit_value = bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id));
+      if (true == bit_value) {
+        config_word[region] = '1';
+      }
+      if (bit_value_to_skip != bit_value) {
+        start_config = true;
+      }
+    }
+
+    /* In fast configuration mode, we do not output anything
+     * until we have to (the first bit different from the reset value detected)
+     */
+    if ( (true == fast_configuration)
+      && (false == start_config)) {
+      continue;
+    }
+
+    config_words.push_back(config_word);
+  }
+
+  std::vector<uint16_t> tokens;
+  if (true == compress_bitstream) {
+    std::vector<bool> config_bits;
+    config_bits.reserve(config_words.size());
+    for (const std::string& config_word : config_words) {
+      config_bits.push_back('1' == config_word[0]);
+    }
+    tokens = encode_fabric_bitstream_run_length_tokens(config_bits);
+  }
+
+  /* Write the bits (or the run-length tokens) to the bitstream memory file, one word per line */
+  bool use_memory_file = !bitstream_memory_fname.empty();
+  size_t num_memory_words = compress_bitstream ? tokens.size() : config_words.size();
+  if (true == use_memory_file) {
+    BufferedFileStream mem_fp;
+    mem_fp.open(bitstream_memory_fname, std::fstream::out | std::fstream::trunc);
+    check_file_stream(bitstream_memory_fname.c_str(), mem_fp);
+    if (true == compress_bitstream) {
+      mem_fp << std::hex << std::setfill('0');
+      for (const uint16_t& token : tokens) {
+        mem_fp << std::setw(4) << token << "\n";
+      }
+    } else {
+      for (const std::string& config_word : config_words) {
+        mem_fp << config_word << "\n";
+      }
+    }
+    mem_fp.close();
+
+    print_verilog_top_testbench_bitstream_memory_declaration(fp,
+                                                             compress_bitstream ? 16 : num_regions,
+                                                             num_memory_words);
+  }
+
   /* Initial value should be the first configuration bits
    * In the rest of programming cycles,
    * configuration bits are fed at the falling edge of programming clock.
    * We do not care the value of scan_chain head during the first programming cycle
    * It is reset anyway
    */
-  BasicPort config_chain_head_port(generate_configuration_chain_head_name(), 1);
+  BasicPort config_chain_head_port(generate_configuration_chain_head_name(), num_regions);
   std::vector<size_t> initial_values(config_chain_head_port.get_width(), 0);
 
   print_verilog_comment(fp, "----- Begin bitstream loading during configuration phase -----");
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial" << "\n";
+  fp << "\tbegin" << "\n";
   print_verilog_comment(fp, "----- Configuration chain default input -----");
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(config_chain_head_port, initial_values);
   fp << ";";
 
-  fp << std::endl;
+  fp << "\n";
 
-  /* Attention: when the fast configuration is enabled, we will start from the first bit '1'
-   * This requires a reset signal (as we forced in the first clock cycle)
-   */
-  bool start_config = false;
-  for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
-    if ( (false == start_config)
-      && (true == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id)))) {
-      start_config = true;
-    } 
+  if (true == compress_bitstream) {
+    /* Feed the run-length tokens to the decompressor, where the counter stops at the last bit */
+    fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_RLE_COUNTER_NAME) << " = " << config_words.size() << ";" << "\n";
+  }
 
-    /* In fast configuration mode, we do not output anything
-     * until we have to (the first bit '1' detected)
-     */
-    if ( (true == fast_configuration)
-      && (false == start_config)) {
-      continue;
+  if (true == use_memory_file) {
+    print_verilog_top_testbench_bitstream_memory_load(fp, bitstream_memory_fname,
+                                                      compress_bitstream, num_memory_words,
+                                                      std::string(compress_bitstream ? TOP_TESTBENCH_PROG_RLE_TASK_NAME : TOP_TESTBENCH_PROG_TASK_NAME),
+                                                      std::vector<size_t>(1, compress_bitstream ? 16 : num_regions));
+  } else if (true == compress_bitstream) {
+    for (const uint16_t& token : tokens) {
+      fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_RLE_TASK_NAME);
+      fp << "(16'h" << std::hex << std::setw(4) << std::setfill('0') << token << std::dec << ");" << "\n";
+    }
+  } else {
+    for (const std::string& config_word : config_words) {
+      fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME);
+      fp << "(" << num_regions << "'b" << config_word << ");" << "\n";
     }
-
-    fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME);
-    fp << "(1'b" << (size_t)bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id)) << ");" << std::endl;
   }
 
   /* Raise the flag of configuration done when bitstream loading is complete */
   BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME), 1);
-  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");" << std::endl;
+  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");" << "\n";
 
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
   fp << "\t\t\t";
@@ -1183,9 +1577,9 @@ void print_verilog_top_testbench_configuration_chain_bitstream(std::fstream& fp,
   fp << " <= ";
   std::vector<size_t> config_done_enable_values(config_done_port.get_width(), 1);
   fp << generate_verilog_constant_values(config_done_enable_values);
-  fp << ";" << std::endl;
+  fp << ";" << "\n";
 
-  fp << "\tend" << std::endl;
+  fp << "\tend" << "\n";
   print_verilog_comment(fp, "----- End bitstream loading during configuration phase -----");
 }
 
@@ -1198,6 +1592,8 @@ void print_verilog_top_testbench_configuration_chain_bitstream(std::fstream& fp,
 static
 void print_verilog_top_testbench_memory_bank_bitstream(std::fstream& fp,
                                                        const bool& fast_configuration,
+                                                       const bool& bit_value_to_skip,
+                                                       const std::string& bitstream_memory_fname,
                                                        const ModuleManager& module_manager,
                                                        const ModuleId& top_module,
                                                        const FabricBitstream& fabric_bitstream) {
@@ -1223,64 +1619,229 @@ void print_verilog_top_testbench_memory_bank_bitstream(std::fstream& fp,
   BasicPort din_port = module_manager.module_port(top_module, din_port_id);
   std::vector<size_t> initial_din_values(din_port.get_width(), 0);
 
+  VTR_ASSERT(bl_addr_port.get_width() == fabric_bitstream.bl_address_length());
+  VTR_ASSERT(wl_addr_port.get_width() == fabric_bitstream.wl_address_length());
+
+  /* Write the BL address, WL address and data input of each bit to the bitstream memory file,
+   * one word per line
+   */
+  bool use_memory_file = !bitstream_memory_fname.empty();
+  size_t num_memory_words = 0;
+  std::string addr_buffer;
+  if (true == use_memory_file) {
+    BufferedFileStream mem_fp;
+    mem_fp.open(bitstream_memory_fname, std::fstream::out | std::fstream::trunc);
+    check_file_stream(bitstream_memory_fname.c_str(), mem_fp);
+    for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
+      /* When fast configuration is enabled, we skip the data_in values which equal the reset value */
+      if ((true == fast_configuration)
+        && (bit_value_to_skip == fabric_bitstream.bit_din(bit_id))) {
+        continue;
+      }
+      addr_buffer.clear();
+      append_itobin_chars(addr_buffer, fabric_bitstream.bit_bl_address_value(bit_id), fabric_bitstream.bl_address_length());
+      append_itobin_chars(addr_buffer, fabric_bitstream.bit_wl_address_value(bit_id), fabric_bitstream.wl_address_length());
+      addr_buffer.push_back(fabric_bitstream.bit_din(bit_id) ? '1' : '0');
+      mem_fp << addr_buffer << "\n";
+      num_memory_words++;
+    }
+    mem_fp.close();
+
+    print_verilog_top_testbench_bitstream_memory_declaration(fp,
+                                                             bl_addr_port.get_width() + wl_addr_port.get_width() + 1,
+                                                             num_memory_words);
+  }
+
   print_verilog_comment(fp, "----- Begin bitstream loading during configuration phase -----");
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial" << "\n";
+  fp << "\tbegin" << "\n";
   print_verilog_comment(fp, "----- Address port default input -----");
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(bl_addr_port, initial_bl_addr_values);
   fp << ";";
-  fp << std::endl;
+  fp << "\n";
 
   fp << generate_verilog_port_constant_values(wl_addr_port, initial_wl_addr_values);
   fp << ";";
-  fp << std::endl;
+  fp << "\n";
 
   print_verilog_comment(fp, "----- Data-input port default input -----");
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(din_port, initial_din_values);
   fp << ";";
 
-  fp << std::endl;
+  fp << "\n";
 
   /* Attention: the configuration chain protcol requires the last configuration bit is fed first
    * We will visit the fabric bitstream in a reverse way
    */
-  for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
-    /* When fast configuration is enabled, we skip zero data_in values */
-    if ((true == fast_configuration)
-      && (false == fabric_bitstream.bit_din(bit_id))) {
-      continue;
+  if (true == use_memory_file) {
+    std::vector<size_t> field_widths;
+    field_widths.push_back(bl_addr_port.get_width());
+    field_widths.push_back(wl_addr_port.get_width());
+    field_widths.push_back(1);
+    print_verilog_top_testbench_bitstream_memory_load(fp, bitstream_memory_fname,
+                                                      false, num_memory_words,
+                                                      std::string(TOP_TESTBENCH_PROG_TASK_NAME),
+                                                      field_widths);
+  } else {
+    for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
+      /* When fast configuration is enabled, we skip the data_in values which equal the reset value */
+      if ((true == fast_configuration)
+        && (bit_value_to_skip == fabric_bitstream.bit_din(bit_id))) {
+        continue;
+      }
+
+      fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME);
+      fp << "(" << bl_addr_port.get_width() << "'b";
+      addr_buffer.clear();
+      append_itobin_chars(addr_buffer, fabric_bitstream.bit_bl_address_value(bit_id), fabric_bitstream.bl_address_length());
+      fp << addr_buffer;
+
+      fp << ", ";
+      fp << wl_addr_port.get_width() << "'b";
+      addr_buffer.clear();
+      append_itobin_chars(addr_buffer, fabric_bitstream.bit_wl_address_value(bit_id), fabric_bitstream.wl_address_length());
+      fp << addr_buffer;
+
+      fp << ", ";
+      fp <<"1'b";
+      if (true == fabric_bitstream.bit_din(bit_id)) {
+        fp << "1";
+      } else {
+        VTR_ASSERT(false == fabric_bitstream.bit_din(bit_id));
+        fp << "0";
+      }
+      fp << ");" << "\n";
     }
+  }
+
+  /* Raise the flag of configuration done when bitstream loading is complete */
+  BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME), 1);
+  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");" << "\n";
+
+  BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
+  fp << "\t\t\t";
+  fp << generate_verilog_port(VERILOG_PORT_CONKT, config_done_port);
+  fp << " <= ";
+  std::vector<size_t> config_done_enable_values(config_done_port.get_width(), 1);
+  fp << generate_verilog_constant_values(config_done_enable_values);
+  fp << ";" << "\n";
+
+  fp << "\tend" << "\n";
+  print_verilog_comment(fp, "----- End bitstream loading during configuration phase -----");
+}
+
+/********************************************************************
+ * Print stimulus for a FPGA fabric with a memory bank configuration protocol
+ * where a data word is written at each WL address
+ * Compared to writing the bits one by one, the number of programming cycles
+ * is divided by the width of the words
+ *
+ * We will use the programming task function created before
+ *******************************************************************/
+static
+void print_verilog_top_testbench_memory_bank_word_bitstream(std::fstream& fp,
+                                                            const bool& fast_configuration,
+                                                            const bool& bit_value_to_skip,
+                                                            const std::string& bitstream_memory_fname,
+                                                            const ModuleManager& module_manager,
+                                                            const ModuleId& top_module,
+                                                            const FabricBitstream& fabric_bitstream) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  /* Feed WL address and data word pair one by one
+   * Note: the first cycle is reserved for programming reset
+   * We should give dummy values
+   */
+  ModulePortId wl_addr_port_id = module_manager.find_module_port(top_module,
+                                                                 std::string(DECODER_WL_ADDRESS_PORT_NAME));
+  BasicPort wl_addr_port = module_manager.module_port(top_module, wl_addr_port_id);
+  std::vector<size_t> initial_wl_addr_values(wl_addr_port.get_width(), 0);
+
+  ModulePortId din_port_id = module_manager.find_module_port(top_module,
+                                                             std::string(DECODER_DATA_IN_PORT_NAME));
+  BasicPort din_port = module_manager.module_port(top_module, din_port_id);
+  std::vector<size_t> initial_din_values(din_port.get_width(), 0);
 
-    fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME);
-    fp << "(" << bl_addr_port.get_width() << "'b";
-    VTR_ASSERT(bl_addr_port.get_width() == fabric_bitstream.bit_bl_address(bit_id).size());
-    for (const char& addr_bit : fabric_bitstream.bit_bl_address(bit_id)) {
-      fp << addr_bit;
+  VTR_ASSERT(wl_addr_port.get_width() == fabric_bitstream.wl_address_length());
+  VTR_ASSERT(din_port.get_width() == fabric_bitstream.word_din_length());
+
+  /* Build the WL address and data word of each programming cycle
+   * When fast configuration is enabled, we skip the words which equal the reset value
+   */
+  std::map<size_t, std::vector<FabricBitId>> words = find_fabric_bitstream_memory_bank_words(fabric_bitstream);
+  std::vector<std::string> word_buffers;
+  word_buffers.reserve(words.size());
+  for (const auto& word : words) {
+    if ( (true == fast_configuration)
+      && (true == is_memory_bank_word_reset_value(fabric_bitstream, word.second, bit_value_to_skip)) ) {
+      continue;
     }
+    std::string word_buffer;
+    append_itobin_chars(word_buffer, word.first, fabric_bitstream.wl_address_length());
+    append_memory_bank_word_chars(word_buffer, fabric_bitstream, word.second);
+    word_buffers.push_back(word_buffer);
+  }
 
-    fp << ", ";
-    fp << wl_addr_port.get_width() << "'b";
-    VTR_ASSERT(wl_addr_port.get_width() == fabric_bitstream.bit_wl_address(bit_id).size());
-    for (const char& addr_bit : fabric_bitstream.bit_wl_address(bit_id)) {
-      fp << addr_bit;
+  /* Write the WL address and data word of each programming cycle to the bitstream memory file,
+   * one word per line
+   */
+  bool use_memory_file = !bitstream_memory_fname.empty();
+  if (true == use_memory_file) {
+    BufferedFileStream mem_fp;
+    mem_fp.open(bitstream_memory_fname, std::fstream::out | std::fstream::trunc);
+    check_file_stream(bitstream_memory_fname.c_str(), mem_fp);
+    for (const std::string& word_buffer : word_buffers) {
+      mem_fp << word_buffer << "\n";
     }
+    mem_fp.close();
 
-    fp << ", ";
-    fp <<"1'b";
-    if (true == fabric_bitstream.bit_din(bit_id)) {
-      fp << "1";
-    } else {
-      VTR_ASSERT(false == fabric_bitstream.bit_din(bit_id));
-      fp << "0";
+    print_verilog_top_testbench_bitstream_memory_declaration(fp,
+                                                             wl_addr_port.get_width() + din_port.get_width(),
+                                                             word_buffers.size());
+  }
+
+  print_verilog_comment(fp, "----- Begin bitstream loading during configuration phase -----");
+  fp << "initial" << "\n";
+  fp << "\tbegin" << "\n";
+  print_verilog_comment(fp, "----- Address port default input -----");
+  fp << "\t\t";
+  fp << generate_verilog_port_constant_values(wl_addr_port, initial_wl_addr_values);
+  fp << ";";
+  fp << "\n";
+
+  print_verilog_comment(fp, "----- Data-input port default input -----");
+  fp << "\t\t";
+  fp << generate_verilog_port_constant_values(din_port, initial_din_values);
+  fp << ";";
+
+  fp << "\n";
+
+  if (true == use_memory_file) {
+    std::vector<size_t> field_widths;
+    field_widths.push_back(wl_addr_port.get_width());
+    field_widths.push_back(din_port.get_width());
+    print_verilog_top_testbench_bitstream_memory_load(fp, bitstream_memory_fname,
+                                                      false, word_buffers.size(),
+                                                      std::string(TOP_TESTBENCH_PROG_TASK_NAME),
+                                                      field_widths);
+  } else {
+    for (const std::string& word_buffer : word_buffers) {
+      fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME);
+      fp << "(" << wl_addr_port.get_width() << "'b";
+      fp << word_buffer.substr(0, wl_addr_port.get_width());
+      fp << ", ";
+      fp << din_port.get_width() << "'b";
+      fp << word_buffer.substr(wl_addr_port.get_width());
+      fp << ");" << "\n";
     }
-    fp << ");" << std::endl;
   }
 
   /* Raise the flag of configuration done when bitstream loading is complete */
   BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME), 1);
-  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");" << std::endl;
+  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");" << "\n";
 
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
   fp << "\t\t\t";
@@ -1288,9 +1849,9 @@ void print_verilog_top_testbench_memory_bank_bitstream(std::fstream& fp,
   fp << " <= ";
   std::vector<size_t> config_done_enable_values(config_done_port.get_width(), 1);
   fp << generate_verilog_constant_values(config_done_enable_values);
-  fp << ";" << std::endl;
+  fp << ";" << "\n";
 
-  fp << "\tend" << std::endl;
+  fp << "\tend" << "\n";
   print_verilog_comment(fp, "----- End bitstream loading during configuration phase -----");
 }
 
@@ -1303,6 +1864,8 @@ void print_verilog_top_testbench_memory_bank_bitstream(std::fstream& fp,
 static
 void print_verilog_top_testbench_frame_decoder_bitstream(std::fstream& fp,
                                                          const bool& fast_configuration,
+                                                         const bool& bit_value_to_skip,
+                                                         const std::string& bitstream_memory_fname,
                                                          const ModuleManager& module_manager,
                                                          const ModuleId& top_module,
                                                          const FabricBitstream& fabric_bitstream) {
@@ -1323,47 +1886,87 @@ void print_verilog_top_testbench_frame_decoder_bitstream(std::fstream& fp,
   BasicPort din_port = module_manager.module_port(top_module, din_port_id);
   std::vector<size_t> initial_din_values(din_port.get_width(), 0);
 
+  VTR_ASSERT(addr_port.get_width() == fabric_bitstream.address_length());
+
+  /* Write the address and data input of each bit to the bitstream memory file,
+   * one word per line
+   */
+  bool use_memory_file = !bitstream_memory_fname.empty();
+  size_t num_memory_words = 0;
+  std::string addr_buffer;
+  if (true == use_memory_file) {
+    BufferedFileStream mem_fp;
+    mem_fp.open(bitstream_memory_fname, std::fstream::out | std::fstream::trunc);
+    check_file_stream(bitstream_memory_fname.c_str(), mem_fp);
+    for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
+      /* When fast configuration is enabled, we skip the data_in values which equal the reset value */
+      if ((true == fast_configuration)
+        && (bit_value_to_skip == fabric_bitstream.bit_din(bit_id))) {
+        continue;
+      }
+      addr_buffer.clear();
+      append_itobin_chars(addr_buffer, fabric_bitstream.bit_address_value(bit_id), fabric_bitstream.address_length());
+      addr_buffer.push_back(fabric_bitstream.bit_din(bit_id) ? '1' : '0');
+      mem_fp << addr_buffer << "\n";
+      num_memory_words++;
+    }
+    mem_fp.close();
+
+    print_verilog_top_testbench_bitstream_memory_declaration(fp,
+                                                             addr_port.get_width() + 1,
+                                                             num_memory_words);
+  }
+
   print_verilog_comment(fp, "----- Begin bitstream loading during configuration phase -----");
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial" << "\n";
+  fp << "\tbegin" << "\n";
   print_verilog_comment(fp, "----- Address port default input -----");
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(addr_port, initial_addr_values);
   fp << ";";
-  fp << std::endl;
+  fp << "\n";
 
   print_verilog_comment(fp, "----- Data-input port default input -----");
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(din_port, initial_din_values);
   fp << ";";
 
-  fp << std::endl;
+  fp << "\n";
 
   /* Attention: the configuration chain protcol requires the last configuration bit is fed first
    * We will visit the fabric bitstream in a reverse way
    */
-  for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
-    /* When fast configuration is enabled, we skip zero data_in values */
-    if ((true == fast_configuration)
-      && (false == fabric_bitstream.bit_din(bit_id))) {
-      continue;
-    }
+  if (true == use_memory_file) {
+    std::vector<size_t> field_widths;
+    field_widths.push_back(addr_port.get_width());
+    field_widths.push_back(1);
+    print_verilog_top_testbench_bitstream_memory_load(fp, bitstream_memory_fname,
+                                                      false, num_memory_words,
+                                                      std::string(TOP_TESTBENCH_PROG_TASK_NAME),
+                                                      field_widths);
+  } else {
+    for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
+      /* When fast configuration is enabled, we skip the data_in values which equal the reset value */
+      if ((true == fast_configuration)
+        && (bit_value_to_skip == fabric_bitstream.bit_din(bit_id))) {
+        continue;
+      }
 
-    fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME);
-    fp << "(" << addr_port.get_width() << "'b";
-    VTR_ASSERT(addr_port.get_width() == fabric_bitstream.bit_address(bit_id).size());
-    for (const char& addr_bit : fabric_bitstream.bit_address(bit_id)) {
-      fp << addr_bit;
-    }
-    fp << ", ";
-    fp <<"1'b";
-    if (true == fabric_bitstream.bit_din(bit_id)) {
-      fp << "1";
-    } else {
-      VTR_ASSERT(false == fabric_bitstream.bit_din(bit_id));
-      fp << "0";
+      fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME);
+      fp << "(" << addr_port.get_width() << "'b";
+      addr_buffer.clear();
+      append_itobin_chars(addr_buffer, fabric_bitstream.bit_address_value(bit_id), fabric_bitstream.address_length());
+      fp << addr_buffer;
+      fp << ", ";
+      fp <<"1'b";
+      if (true == fabric_bitstream.bit_din(bit_id)) {
+        fp << "1";
+      } else {
+        VTR_ASSERT(false == fabric_bitstream.bit_din(bit_id));
+        fp << "0";
+      }
+      fp << ");" << "\n";
     }
-    fp << ");" << std::endl;
   }
 
   /* Disable the address and din */
@@ -1375,11 +1978,11 @@ void print_verilog_top_testbench_frame_decoder_bitstream(std::fstream& fp,
   }
   fp << ", ";
   fp <<"1'b0";
-  fp << ");" << std::endl;
+  fp << ");" << "\n";
 
   /* Raise the flag of configuration done when bitstream loading is complete */
   BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME), 1);
-  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");" << std::endl;
+  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");" << "\n";
 
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
   fp << "\t\t\t";
@@ -1387,9 +1990,9 @@ void print_verilog_top_testbench_frame_decoder_bitstream(std::fstream& fp,
   fp << " <= ";
   std::vector<size_t> config_done_enable_values(config_done_port.get_width(), 1);
   fp << generate_verilog_constant_values(config_done_enable_values);
-  fp << ";" << std::endl;
+  fp << ";" << "\n";
 
-  fp << "\tend" << std::endl;
+  fp << "\tend" << "\n";
   print_verilog_comment(fp, "----- End bitstream loading during configuration phase -----");
 }
 
@@ -1403,6 +2006,9 @@ static
 void print_verilog_top_testbench_bitstream(std::fstream& fp,
                                            const e_config_protocol_type& sram_orgz_type,
                                            const bool& fast_configuration,
+                                           const bool& bit_value_to_skip,
+                                           const bool& compress_bitstream,
+                                           const std::string& bitstream_memory_fname,
                                            const ModuleManager& module_manager,
                                            const ModuleId& top_module,
                                            const BitstreamManager& bitstream_manager,
@@ -1416,15 +2022,30 @@ void print_verilog_top_testbench_bitstream(std::fstream& fp,
     break;
   case CONFIG_MEM_SCAN_CHAIN:
     print_verilog_top_testbench_configuration_chain_bitstream(fp, fast_configuration, 
+                                                              bit_value_to_skip,
+                                                              compress_bitstream,
+                                                              bitstream_memory_fname,
                                                               bitstream_manager, fabric_bitstream);
     break;
   case CONFIG_MEM_MEMORY_BANK:
+    if (true == fabric_bitstream.use_word_din()) {
+      print_verilog_top_testbench_memory_bank_word_bitstream(fp, fast_configuration,
+                                                             bit_value_to_skip,
+                                                             bitstream_memory_fname,
+                                                             module_manager, top_module,
+                                                             fabric_bitstream);
+      break;
+    }
     print_verilog_top_testbench_memory_bank_bitstream(fp, fast_configuration,
+                                                      bit_value_to_skip,
+                                                      bitstream_memory_fname,
                                                       module_manager, top_module,
                                                       fabric_bitstream);
     break;
   case CONFIG_MEM_FRAME_BASED:
     print_verilog_top_testbench_frame_decoder_bitstream(fp, fast_configuration,
+                                                        bit_value_to_skip,
+                                                        bitstream_memory_fname,
                                                         module_manager, top_module,
                                                         fabric_bitstream);
     break;
@@ -1435,6 +2056,29 @@ void print_verilog_top_testbench_bitstream(std::fstream& fp,
   }
 }
 
+/********************************************************************
+ * Print the checksum segments of the fabric bitstream, if built,
+ * as comments, so that the programmer of the fabric can verify 
+ * the readback of each segment without comparing the full image
+ *******************************************************************/
+static
+void print_verilog_top_testbench_bitstream_checksums(std::fstream& fp,
+                                                     const FabricBitstream& fabric_bitstream) {
+  if (0 == fabric_bitstream.num_checksum_segments()) {
+    return;
+  }
+
+  print_verilog_comment(fp, std::string("----- CRC-32C of the bit values of each checksum segment, the first bit in the least significant bit -----"));
+  size_t first_bit = 0;
+  for (size_t segment = 0; segment < fabric_bitstream.num_checksum_segments(); ++segment) {
+    size_t num_bits = fabric_bitstream.checksum_segment_num_bits(segment);
+    fp << "// Segment " << segment << ": bits [" << first_bit << ":" << first_bit + num_bits - 1 << "], CRC-32C ";
+    fp << "32'h" << std::hex << std::setw(8) << std::setfill('0') << fabric_bitstream.checksum_segment_crc(segment) << std::dec << "\n";
+    first_bit += num_bits;
+  }
+  fp << std::endl;
+}
+
 /********************************************************************
  * The top-level function to generate a testbench, in order to verify:
  * 1. Configuration phase of the FPGA fabric, where the bitstream is
@@ -1469,6 +2113,8 @@ void print_verilog_top_testbench(const ModuleManager& module_manager,
                                  const std::string& verilog_fname,
                                  const SimulationSetting& simulation_parameters,
                                  const bool& fast_configuration,
+                                 const bool& compress_bitstream,
+                                 const std::string& bitstream_memory_fname,
                                  const bool& explicit_port_mapping) {
 
   std::string timer_message = std::string("Write autocheck testbench for FPGA top-level Verilog netlist for '") + circuit_name + std::string("'");
@@ -1477,7 +2123,7 @@ void print_verilog_top_testbench(const ModuleManager& module_manager,
   vtr::ScopedStartFinishTimer timer(timer_message);
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   /* Validate the file stream */
@@ -1491,6 +2137,36 @@ void print_verilog_top_testbench(const ModuleManager& module_manager,
   ModuleId top_module = module_manager.find_module(generate_fpga_top_module_name());
   VTR_ASSERT(true == module_manager.valid_module_id(top_module));
 
+  /* Only a configuration chain loads the bitstream through the decompressor */
+  bool use_compressed_bitstream = compress_bitstream;
+  if ( (true == use_compressed_bitstream)
+    && (CONFIG_MEM_SCAN_CHAIN != sram_orgz_type) ) {
+    VTR_LOG_WARN("Bitstream compression is only applicable to configuration chain and is ignored!\n");
+    use_compressed_bitstream = false;
+  }
+  if ( (true == use_compressed_bitstream)
+    && (1 < fabric_bitstream.num_regions()) ) {
+    VTR_LOG_WARN("Bitstream compression is not applicable to multiple configuration regions and is ignored!\n");
+    use_compressed_bitstream = false;
+  }
+
+  /* Fast configuration skips the bits which equal the value of configurable memories after reset */
+  bool use_fast_configuration = fast_configuration;
+  bool bit_value_to_skip = false;
+  if ( (true == use_fast_configuration)
+    && (false == find_fast_configuration_bit_value_to_skip(circuit_lib, global_ports, bit_value_to_skip)) ) {
+    VTR_LOG_WARN("Fast configuration requires a programming reset or set port for configurable memories and is ignored!\n");
+    use_fast_configuration = false;
+  }
+
+  /* The bitstream of a standalone memory organization is loaded in one cycle, no need of memory file */
+  std::string use_bitstream_memory_fname = bitstream_memory_fname;
+  if ( (false == use_bitstream_memory_fname.empty())
+    && (CONFIG_MEM_STANDALONE == sram_orgz_type) ) {
+    VTR_LOG_WARN("Loading bitstream from a memory file is not applicable to standalone memory organization and is ignored!\n");
+    use_bitstream_memory_fname.clear();
+  }
+
   /* Preparation: find all the clock ports */
   std::vector<std::string> clock_port_names = find_atom_netlist_clock_port_names(atom_ctx.nlist, netlist_annotation);
 
@@ -1504,13 +2180,18 @@ void print_verilog_top_testbench(const ModuleManager& module_manager,
   float op_clock_period = (1./simulation_parameters.operating_clock_frequency());
   /* Estimate the number of configuration clock cycles */
   size_t num_config_clock_cycles = calculate_num_config_clock_cycles(sram_orgz_type,
-                                                                     fast_configuration,
+                                                                     use_fast_configuration,
+                                                                     bit_value_to_skip,
                                                                      bitstream_manager,
                                                                      fabric_bitstream);
 
   /* Generate stimuli for general control signals */
+  print_verilog_top_testbench_config_done_stimulus(fp,
+                                                   num_config_clock_cycles,
+                                                   prog_clock_period,
+                                                   VERILOG_SIM_TIMESCALE);
   print_verilog_top_testbench_generic_stimulus(fp,
-                                               num_config_clock_cycles,
+                                               (true == use_fast_configuration) && (true == bit_value_to_skip),
                                                prog_clock_period,
                                                op_clock_period,
                                                VERILOG_SIM_TIMESCALE);
@@ -1543,11 +2224,16 @@ void print_verilog_top_testbench(const ModuleManager& module_manager,
   /* Print tasks used for loading bitstreams */
   print_verilog_top_testbench_load_bitstream_task(fp,
                                                   sram_orgz_type,
+                                                  use_compressed_bitstream,
                                                   module_manager, top_module);
 
   /* load bitstream to FPGA fabric in a configuration phase */
+  print_verilog_top_testbench_bitstream_checksums(fp, fabric_bitstream);
   print_verilog_top_testbench_bitstream(fp, sram_orgz_type,
-                                        fast_configuration,
+                                        use_fast_configuration,
+                                        bit_value_to_skip,
+                                        use_compressed_bitstream,
+                                        use_bitstream_memory_fname,
                                         module_manager, top_module,
                                         bitstream_manager, fabric_bitstream);
 
@@ -1596,4 +2282,711 @@ void print_verilog_top_testbench(const ModuleManager& module_manager,
   fp.close();
 }
 
+/********************************************************************
+ * Find the ports of the FPGA fabric which are fed by the programming task
+ * of a configuration protocol, in the order of the arguments of the task.
+ * A word of the bitstream file of the fabric testbench is the concatenation
+ * of the values of these ports in a programming cycle
+ *******************************************************************/
+static
+std::vector<BasicPort> find_fabric_testbench_bitstream_ports(const e_config_protocol_type& sram_orgz_type,
+                                                             const ModuleManager& module_manager,
+                                                             const ModuleId& top_module) {
+  std::vector<BasicPort> bitstream_ports;
+
+  switch (sram_orgz_type) {
+  case CONFIG_MEM_SCAN_CHAIN:
+    bitstream_ports.push_back(BasicPort(generate_configuration_chain_head_name(), module_manager.num_config_regions(top_module)));
+    break;
+  case CONFIG_MEM_MEMORY_BANK: {
+    /* There is no Bit-Line address when a word is written at each Word-Line address */
+    ModulePortId bl_addr_port_id = module_manager.find_module_port(top_module, std::string(DECODER_BL_ADDRESS_PORT_NAME));
+    if (true == module_manager.valid_module_port_id(top_module, bl_addr_port_id)) {
+      bitstream_ports.push_back(module_manager.module_port(top_module, bl_addr_port_id));
+    }
+    ModulePortId wl_addr_port_id = module_manager.find_module_port(top_module, std::string(DECODER_WL_ADDRESS_PORT_NAME));
+    bitstream_ports.push_back(module_manager.module_port(top_module, wl_addr_port_id));
+    ModulePortId din_port_id = module_manager.find_module_port(top_module, std::string(DECODER_DATA_IN_PORT_NAME));
+    bitstream_ports.push_back(module_manager.module_port(top_module, din_port_id));
+    break;
+  }
+  case CONFIG_MEM_FRAME_BASED: {
+    ModulePortId addr_port_id = module_manager.find_module_port(top_module, std::string(DECODER_ADDRESS_PORT_NAME));
+    bitstream_ports.push_back(module_manager.module_port(top_module, addr_port_id));
+    ModulePortId din_port_id = module_manager.find_module_port(top_module, std::string(DECODER_DATA_IN_PORT_NAME));
+    bitstream_ports.push_back(module_manager.module_port(top_module, din_port_id));
+    break;
+  }
+  default:
+    VTR_LOGF_ERROR(__FILE__, __LINE__,
+                   "Invalid type of SRAM organization for the fabric testbench!\n");
+    exit(1);
+  }
+
+  return bitstream_ports;
+}
+
+/********************************************************************
+ * Print the declaration of a file to be given at runtime by a plusarg
+ * of the fabric testbench, e.g., +bitstream=<file>
+ *******************************************************************/
+static
+void print_verilog_fabric_testbench_file_declaration(std::fstream& fp,
+                                                     const std::string& plusarg_name) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  fp << "reg [8*" << FABRIC_TESTBENCH_MAX_FILE_NAME_LENGTH << ":1] " << plusarg_name << "_fname;" << "\n";
+  fp << "integer " << plusarg_name << "_fd;" << "\n";
+}
+
+/********************************************************************
+ * Print the codes which open a file given at runtime by a plusarg
+ * of the fabric testbench, and finish the simulation if the file is not given
+ *******************************************************************/
+static
+void print_verilog_fabric_testbench_file_open(std::fstream& fp,
+                                              const std::string& plusarg_name) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  fp << "\t\tif (0 == $value$plusargs(\"" << plusarg_name << "=%s\", " << plusarg_name << "_fname)) begin" << "\n";
+  fp << "\t\t\t$display(\"Error: the file should be given by +" << plusarg_name << "=<file>\");" << "\n";
+  fp << "\t\t\t$finish;" << "\n";
+  fp << "\t\tend" << "\n";
+  fp << "\t\t" << plusarg_name << "_fd = $fopen(" << plusarg_name << "_fname, \"r\");" << "\n";
+  fp << "\t\tif (0 == " << plusarg_name << "_fd) begin" << "\n";
+  fp << "\t\t\t$display(\"Error: cannot open the file %0s\", " << plusarg_name << "_fname);" << "\n";
+  fp << "\t\t\t$finish;" << "\n";
+  fp << "\t\tend" << "\n";
+}
+
+/********************************************************************
+ * Print the stimulus of the fabric testbench which loads the bitstream
+ * from the file given at runtime, one word per programming cycle,
+ * and then raises the configuration done signal.
+ * As the number of words is unknown when the testbench is compiled,
+ * the words are read one by one until the end of the file
+ *******************************************************************/
+static
+void print_verilog_fabric_testbench_bitstream(std::fstream& fp,
+                                              const e_config_protocol_type& sram_orgz_type,
+                                              const ModuleManager& module_manager,
+                                              const ModuleId& top_module) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  std::vector<BasicPort> bitstream_ports = find_fabric_testbench_bitstream_ports(sram_orgz_type, module_manager, top_module);
+  size_t word_width = 0;
+  for (const BasicPort& bitstream_port : bitstream_ports) {
+    word_width += bitstream_port.get_width();
+  }
+
+  std::string plusarg_name(FABRIC_TESTBENCH_BITSTREAM_PLUSARG_NAME);
+  BasicPort word_port(std::string(FABRIC_TESTBENCH_BITSTREAM_WORD_NAME), word_width);
+
+  print_verilog_comment(fp, std::string("----- Bitstream words loaded from the file given by +" + plusarg_name + "=<file> -----"));
+  fp << generate_verilog_port(VERILOG_PORT_REG, word_port) << ";" << "\n";
+  print_verilog_fabric_testbench_file_declaration(fp, plusarg_name);
+  fp << "\n";
+
+  BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
+  BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME), 1);
+
+  print_verilog_comment(fp, "----- Begin bitstream loading during configuration phase -----");
+  fp << "initial" << "\n";
+  fp << "\tbegin" << "\n";
+  fp << "\t\t" << generate_verilog_port_constant_values(config_done_port, std::vector<size_t>(1, 0)) << ";" << "\n";
+  for (const BasicPort& bitstream_port : bitstream_ports) {
+    fp << "\t\t" << generate_verilog_port_constant_values(bitstream_port, std::vector<size_t>(bitstream_port.get_width(), 0)) << ";" << "\n";
+  }
+  print_verilog_fabric_testbench_file_open(fp, plusarg_name);
+
+  fp << "\t\twhile (1 == $fscanf(" << plusarg_name << "_fd, \"%b\\n\", " << word_port.get_name() << ")) begin" << "\n";
+  fp << "\t\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME) << "(";
+  size_t field_lsb = 0;
+  for (size_t iport = 0; iport < bitstream_ports.size(); ++iport) {
+    if (0 < iport) {
+      fp << ", ";
+    }
+    fp << word_port.get_name() << "[" << field_lsb << ":" << field_lsb + bitstream_ports[iport].get_width() - 1 << "]";
+    field_lsb += bitstream_ports[iport].get_width();
+  }
+  fp << ");" << "\n";
+  fp << "\t\tend" << "\n";
+  fp << "\t\t$fclose(" << plusarg_name << "_fd);" << "\n";
+
+  /* Disable the address and din of frame-based decoders */
+  if (CONFIG_MEM_FRAME_BASED == sram_orgz_type) {
+    fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME) << "(";
+    for (size_t iport = 0; iport < bitstream_ports.size(); ++iport) {
+      if (0 < iport) {
+        fp << ", ";
+      }
+      fp << generate_verilog_constant_values(std::vector<size_t>(bitstream_ports[iport].get_width(), 0));
+    }
+    fp << ");" << "\n";
+  }
+
+  /* Raise the flag of configuration done when bitstream loading is complete */
+  fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");" << "\n";
+  fp << "\t\t\t";
+  fp << generate_verilog_port(VERILOG_PORT_CONKT, config_done_port);
+  fp << " <= ";
+  fp << generate_verilog_constant_values(std::vector<size_t>(config_done_port.get_width(), 1));
+  fp << ";" << "\n";
+
+  fp << "\tend" << "\n";
+  print_verilog_comment(fp, "----- End bitstream loading during configuration phase -----");
+  fp << "\n";
+}
+
+/********************************************************************
+ * Print the stimulus and the output checking of the fabric testbench,
+ * where the I/O mapping, the input vectors and the reference output vectors
+ * are loaded from the files given at runtime.
+ * All the vectors, as well as the masks of the I/O mapping,
+ * are in the order of the GPIOs of the FPGA fabric:
+ * - A GPIO in the clock mask is driven by the operating clock
+ * - A GPIO in the output mask is not driven, and checked against the reference vectors
+ * - Any other GPIO is driven by the input vectors
+ * A vector is applied at each falling edge of the operating clock,
+ * and the outputs are checked at the next falling edge.
+ * The simulation finishes after the last vector
+ *******************************************************************/
+static
+void print_verilog_fabric_testbench_io_stimuli(std::fstream& fp,
+                                               const ModuleManager& module_manager,
+                                               const ModuleId& top_module) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  std::vector<BasicPort> module_io_ports = module_manager.module_ports_by_type(top_module, ModuleManager::MODULE_GPIO_PORT);
+  size_t num_ios = 0;
+  for (const BasicPort& module_io_port : module_io_ports) {
+    num_ios += module_io_port.get_width();
+  }
+  VTR_ASSERT(0 < num_ios);
+
+  BasicPort clock_mask_port(std::string(FABRIC_TESTBENCH_IO_CLOCK_MASK_NAME), num_ios);
+  BasicPort output_mask_port(std::string(FABRIC_TESTBENCH_IO_OUTPUT_MASK_NAME), num_ios);
+  BasicPort stimuli_port(std::string(FABRIC_TESTBENCH_IO_STIMULI_NAME), num_ios);
+  BasicPort reference_port(std::string(FABRIC_TESTBENCH_IO_REFERENCE_NAME), num_ios);
+  BasicPort outputs_port(std::string(FABRIC_TESTBENCH_IO_OUTPUTS_NAME), num_ios);
+  BasicPort op_clock_port(std::string(TOP_TB_OP_CLOCK_PORT_NAME), 1);
+
+  std::string io_map_plusarg_name(FABRIC_TESTBENCH_IO_MAP_PLUSARG_NAME);
+  std::string stimuli_plusarg_name(FABRIC_TESTBENCH_STIMULI_PLUSARG_NAME);
+  std::string reference_plusarg_name(FABRIC_TESTBENCH_REFERENCE_PLUSARG_NAME);
+  std::string vector_index_name(FABRIC_TESTBENCH_VECTOR_INDEX_NAME);
+  std::string scan_status_name(FABRIC_TESTBENCH_SCAN_STATUS_NAME);
+
+  print_verilog_comment(fp, std::string("----- I/O mapping and vectors loaded from the files given by +" + io_map_plusarg_name + "=<file>, +" + stimuli_plusarg_name + "=<file> and +" + reference_plusarg_name + "=<file> -----"));
+  fp << generate_verilog_port(VERILOG_PORT_REG, clock_mask_port) << ";" << "\n";
+  fp << generate_verilog_port(VERILOG_PORT_REG, output_mask_port) << ";" << "\n";
+  fp << generate_verilog_port(VERILOG_PORT_REG, stimuli_port) << ";" << "\n";
+  fp << generate_verilog_port(VERILOG_PORT_REG, reference_port) << ";" << "\n";
+  fp << generate_verilog_port(VERILOG_PORT_WIRE, outputs_port) << ";" << "\n";
+  print_verilog_fabric_testbench_file_declaration(fp, io_map_plusarg_name);
+  print_verilog_fabric_testbench_file_declaration(fp, stimuli_plusarg_name);
+  print_verilog_fabric_testbench_file_declaration(fp, reference_plusarg_name);
+  fp << "integer " << vector_index_name << ";" << "\n";
+  fp << "integer " << scan_status_name << ";" << "\n";
+  fp << "\n";
+
+  print_verilog_comment(fp, std::string("----- Load the I/O mapping and open the vector files -----"));
+  fp << "initial" << "\n";
+  fp << "\tbegin" << "\n";
+  fp << "\t\t" << generate_verilog_port_constant_values(clock_mask_port, std::vector<size_t>(num_ios, 0)) << ";" << "\n";
+  fp << "\t\t" << generate_verilog_port_constant_values(output_mask_port, std::vector<size_t>(num_ios, 0)) << ";" << "\n";
+  fp << "\t\t" << generate_verilog_port_constant_values(stimuli_port, std::vector<size_t>(num_ios, VERILOG_DEFAULT_SIGNAL_INIT_VALUE)) << ";" << "\n";
+  fp << "\t\t" << generate_verilog_port_constant_values(reference_port, std::vector<size_t>(num_ios, 0)) << ";" << "\n";
+  fp << "\t\t" << vector_index_name << " = 0;" << "\n";
+  print_verilog_fabric_testbench_file_open(fp, io_map_plusarg_name);
+  fp << "\t\t" << scan_status_name << " = $fscanf(" << io_map_plusarg_name << "_fd, \"%b\\n\", " << clock_mask_port.get_name() << ");" << "\n";
+  fp << "\t\t" << scan_status_name << " = $fscanf(" << io_map_plusarg_name << "_fd, \"%b\\n\", " << output_mask_port.get_name() << ");" << "\n";
+  fp << "\t\t$fclose(" << io_map_plusarg_name << "_fd);" << "\n";
+  print_verilog_fabric_testbench_file_open(fp, stimuli_plusarg_name);
+  print_verilog_fabric_testbench_file_open(fp, reference_plusarg_name);
+  fp << "\t\t$timeformat(-9, 2, \"ns\", 20);" << "\n";
+  fp << "\t\t$display(\"Simulation start\");" << "\n";
+  fp << "\tend" << "\n";
+  fp << "\n";
+
+  /* Drive the GPIOs depending on the I/O mapping */
+  print_verilog_comment(fp, std::string("----- Drive the I/Os of FPGA fabric depending on the I/O mapping -----"));
+  fp << "genvar " << FABRIC_TESTBENCH_IO_GENVAR_NAME << ";" << "\n";
+  size_t io_offset = 0;
+  std::string io_outputs;
+  for (const BasicPort& module_io_port : module_io_ports) {
+    std::string io_index(FABRIC_TESTBENCH_IO_GENVAR_NAME);
+    std::string vector_index = std::to_string(io_offset) + " + " + io_index;
+    fp << "generate" << "\n";
+    fp << "\tfor (" << io_index << " = 0; " << io_index << " < " << module_io_port.get_width() << "; ";
+    fp << io_index << " = " << io_index << " + 1) begin: " << module_io_port.get_name() << "_drivers" << "\n";
+    fp << "\t\tassign " << module_io_port.get_name() << "[" << module_io_port.get_lsb() << " + " << io_index << "] = ";
+    fp << clock_mask_port.get_name() << "[" << vector_index << "] ? " << generate_verilog_port(VERILOG_PORT_CONKT, op_clock_port);
+    fp << " : (" << output_mask_port.get_name() << "[" << vector_index << "] ? 1'bz : ";
+    fp << stimuli_port.get_name() << "[" << vector_index << "]);" << "\n";
+    fp << "\tend" << "\n";
+    fp << "endgenerate" << "\n";
+
+    if (false == io_outputs.empty()) {
+      io_outputs += std::string(", ");
+    }
+    io_outputs += generate_verilog_port(VERILOG_PORT_CONKT, module_io_port);
+    io_offset += module_io_port.get_width();
+  }
+  fp << "assign " << outputs_port.get_name() << " = {" << io_outputs << "};" << "\n";
+  fp << "\n";
+
+  /* Check the outputs of the previous vector and apply the next vector */
+  std::string mismatch = std::string("((") + outputs_port.get_name() + std::string(" ^ ") + reference_port.get_name() + std::string(") & ") + output_mask_port.get_name() + std::string(")");
+  print_verilog_comment(fp, std::string("----- Check the output vectors and apply the input vectors -----"));
+  fp << "always@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, op_clock_port) << ") begin" << "\n";
+  fp << "\tif (0 < " << vector_index_name << ") begin" << "\n";
+  fp << "\t\tif (1'b1 === |" << mismatch << ") begin" << "\n";
+  fp << "\t\t\t" << TOP_TESTBENCH_ERROR_COUNTER << " = " << TOP_TESTBENCH_ERROR_COUNTER << " + 1;" << "\n";
+  fp << "\t\t\t$display(\"Mismatch on I/Os of %b at vector %0d, time = %t\", " << mismatch << ", " << vector_index_name << " - 1, $realtime);" << "\n";
+  fp << "\t\tend" << "\n";
+  fp << "\tend" << "\n";
+  fp << "\tif (1 == $fscanf(" << stimuli_plusarg_name << "_fd, \"%b\\n\", " << stimuli_port.get_name() << ")) begin" << "\n";
+  fp << "\t\t" << scan_status_name << " = $fscanf(" << reference_plusarg_name << "_fd, \"%b\\n\", " << reference_port.get_name() << ");" << "\n";
+  fp << "\t\t" << vector_index_name << " = " << vector_index_name << " + 1;" << "\n";
+  fp << "\tend else begin" << "\n";
+  fp << "\t\t$fclose(" << stimuli_plusarg_name << "_fd);" << "\n";
+  fp << "\t\t$fclose(" << reference_plusarg_name << "_fd);" << "\n";
+  fp << "\t\tif (" << TOP_TESTBENCH_ERROR_COUNTER << " == 0) begin" << "\n";
+  fp << "\t\t\t$display(\"Simulation Succeed with %0d vectors\", " << vector_index_name << ");" << "\n";
+  fp << "\t\tend else begin" << "\n";
+  fp << "\t\t\t$display(\"Simulation Failed with %d error(s)\", " << TOP_TESTBENCH_ERROR_COUNTER << ");" << "\n";
+  fp << "\t\tend" << "\n";
+  fp << "\t\t$finish;" << "\n";
+  fp << "\tend" << "\n";
+  fp << "end" << "\n";
+  fp << "\n";
+}
+
+/********************************************************************
+ * The top-level function to generate a testbench for the FPGA fabric,
+ * which is independent from any benchmark:
+ * the bitstream, the I/O mapping, the input vectors and the reference output vectors
+ * of a benchmark are loaded from files given at runtime by plusargs, i.e.,
+ *   +bitstream=<file> +io_map=<file> +stimuli=<file> +reference=<file>
+ * (see print_verilog_fabric_testbench_data())
+ * A simulator can then compile the fabric once and simulate the compiled snapshot
+ * for many benchmarks.
+ *
+ * The configuration and the operating phases are the same as the top testbench
+ * without fast configuration, except that the configuration done signal
+ * is raised after the last word of the bitstream file.
+ * The standalone configuration protocol loads the bitstream in one cycle
+ * without programming task, and is not supported
+ *******************************************************************/
+void print_verilog_fabric_testbench(const ModuleManager& module_manager,
+                                    const e_config_protocol_type& sram_orgz_type,
+                                    const CircuitLibrary& circuit_lib,
+                                    const std::vector<CircuitPortId>& global_ports,
+                                    const std::string& verilog_fname,
+                                    const SimulationSetting& simulation_parameters,
+                                    const bool& explicit_port_mapping) {
+  std::string timer_message = std::string("Write fabric testbench for FPGA top-level Verilog netlist");
+
+  /* Start time count */
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  VTR_ASSERT(CONFIG_MEM_STANDALONE != sram_orgz_type);
+
+  /* Find the top_module */
+  ModuleId top_module = module_manager.find_module(generate_fpga_top_module_name());
+  VTR_ASSERT(true == module_manager.valid_module_id(top_module));
+
+  /* Create the file stream */
+  BufferedFileStream fp;
+  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
+
+  /* Validate the file stream */
+  check_file_stream(verilog_fname.c_str(), fp);
+
+  /* Generate a brief description on the Verilog file*/
+  std::string title = std::string("FPGA Verilog Testbench for Top-level netlist of FPGA fabric");
+  print_verilog_file_header(fp, title);
+
+  std::string module_name = generate_fpga_top_module_name() + std::string(FABRIC_TESTBENCH_VERILOG_MODULE_POSTFIX);
+
+  /* Start of testbench */
+  fp << "module " << module_name << ";" << "\n";
+  print_verilog_top_testbench_fabric_ports(fp, module_manager, top_module, sram_orgz_type);
+  print_verilog_comment(fp, std::string("----- Error counter -----"));
+  fp << "\tinteger " << TOP_TESTBENCH_ERROR_COUNTER << "= 0;" << "\n";
+  fp << "\n";
+
+  /* Generate stimuli for general control signals, where the configuration done signal
+   * is raised by the loading of the bitstream
+   */
+  bool bit_value_to_skip = false;
+  bool enable_prog_set = (true == find_fast_configuration_bit_value_to_skip(circuit_lib, global_ports, bit_value_to_skip))
+                      && (true == bit_value_to_skip);
+  print_verilog_top_testbench_generic_stimulus(fp,
+                                               enable_prog_set,
+                                               1./simulation_parameters.programming_clock_frequency(),
+                                               1./simulation_parameters.operating_clock_frequency(),
+                                               VERILOG_SIM_TIMESCALE);
+
+  /* Generate stimuli for global ports or connect them to existed signals */
+  print_verilog_top_testbench_global_ports_stimuli(fp,
+                                                   module_manager, top_module,
+                                                   circuit_lib, global_ports);
+
+  /* Instanciate FPGA top-level module */
+  print_verilog_testbench_fpga_instance(fp, module_manager, top_module,
+                                        std::string(TOP_TESTBENCH_FPGA_INSTANCE_NAME),
+                                        explicit_port_mapping);
+
+  /* Print tasks used for loading bitstreams */
+  print_verilog_top_testbench_load_bitstream_task(fp,
+                                                  sram_orgz_type,
+                                                  false,
+                                                  module_manager, top_module);
+
+  /* load bitstream to FPGA fabric in a configuration phase */
+  print_verilog_fabric_testbench_bitstream(fp, sram_orgz_type,
+                                           module_manager, top_module);
+
+  /* Drive and check the I/Os in the operating phase */
+  print_verilog_fabric_testbench_io_stimuli(fp, module_manager, top_module);
+
+  /* Testbench ends*/
+  print_verilog_module_end(fp, module_name);
+
+  /* Close the file stream */
+  fp.close();
+}
+
+/********************************************************************
+ * Build the words of the bitstream file of the fabric testbench,
+ * one word per programming cycle, in binary characters
+ * (see find_fabric_testbench_bitstream_ports() for the fields of a word)
+ *******************************************************************/
+static
+std::vector<std::string> build_fabric_testbench_bitstream_words(const e_config_protocol_type& sram_orgz_type,
+                                                                const BitstreamManager& bitstream_manager,
+                                                                const FabricBitstream& fabric_bitstream) {
+  std::vector<std::string> words;
+
+  switch (sram_orgz_type) {
+  case CONFIG_MEM_SCAN_CHAIN: {
+    /* Configuration chains in multiple regions are loaded in parallel,
+     * each bit of a word is loaded to a region, starting from the first region
+     */
+    size_t num_regions = fabric_bitstream.num_regions();
+    size_t num_cycles = find_fabric_regional_bitstream_max_size(fabric_bitstream);
+    words.reserve(num_cycles);
+    for (size_t cycle = 0; cycle < num_cycles; ++cycle) {
+      std::string word(num_regions, '0');
+      for (size_t region = 0; region < num_regions; ++region) {
+        FabricBitId bit_id = find_fabric_regional_bitstream_cycle_bit(fabric_bitstream, region, cycle, num_cycles);
+        if ( (FabricBitId::INVALID() != bit_id)
+          && (true == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) ) {
+          word[region] = '1';
+        }
+      }
+      words.push_back(word);
+    }
+    break;
+  }
+  case CONFIG_MEM_MEMORY_BANK:
+    if (true == fabric_bitstream.use_word_din()) {
+      for (const auto& word : find_fabric_bitstream_memory_bank_words(fabric_bitstream)) {
+        std::string word_buffer;
+        append_itobin_chars(word_buffer, word.first, fabric_bitstream.wl_address_length());
+        append_memory_bank_word_chars(word_buffer, fabric_bitstream, word.second);
+        words.push_back(word_buffer);
+      }
+      break;
+    }
+    words.reserve(fabric_bitstream.num_bits());
+    for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
+      std::string word_buffer;
+      append_itobin_chars(word_buffer, fabric_bitstream.bit_bl_address_value(bit_id), fabric_bitstream.bl_address_length());
+      append_itobin_chars(word_buffer, fabric_bitstream.bit_wl_address_value(bit_id), fabric_bitstream.wl_address_length());
+      word_buffer.push_back(fabric_bitstream.bit_din(bit_id) ? '1' : '0');
+      words.push_back(word_buffer);
+    }
+    break;
+  case CONFIG_MEM_FRAME_BASED:
+    words.reserve(fabric_bitstream.num_bits());
+    for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
+      std::string word_buffer;
+      append_itobin_chars(word_buffer, fabric_bitstream.bit_address_value(bit_id), fabric_bitstream.address_length());
+      word_buffer.push_back(fabric_bitstream.bit_din(bit_id) ? '1' : '0');
+      words.push_back(word_buffer);
+    }
+    break;
+  default:
+    VTR_LOGF_ERROR(__FILE__, __LINE__,
+                   "Invalid type of SRAM organization for the fabric testbench!\n");
+    exit(1);
+  }
+
+  return words;
+}
+
+/********************************************************************
+ * Print a testbench of the benchmark alone, which applies the input vectors
+ * of the fabric testbench to the benchmark and writes its outputs
+ * to the reference vectors of the fabric testbench, in the same timing:
+ * a vector is applied at each falling edge of the clock,
+ * and the outputs are written at the next falling edge.
+ * The benchmark is small compared to the FPGA fabric,
+ * so that it can be compiled and simulated for each benchmark
+ *******************************************************************/
+static
+void print_verilog_fabric_testbench_reference(const std::string& circuit_name,
+                                              const std::string& verilog_fname,
+                                              const std::string& stimuli_fname,
+                                              const std::string& reference_fname,
+                                              const AtomContext& atom_ctx,
+                                              const VprNetlistAnnotation& netlist_annotation,
+                                              const vtr::vector<AtomBlockId, size_t>& atom_io_indices,
+                                              const std::vector<std::string>& clock_port_names,
+                                              const size_t& num_ios,
+                                              const SimulationSetting& simulation_parameters,
+                                              const bool& explicit_port_mapping) {
+  /* Create the file stream */
+  BufferedFileStream fp;
+  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
+
+  /* Validate the file stream */
+  check_file_stream(verilog_fname.c_str(), fp);
+
+  /* Generate a brief description on the Verilog file*/
+  std::string title = std::string("Verilog Testbench writing the reference vectors of the fabric testbench for Design: ") + circuit_name;
+  print_verilog_file_header(fp, title);
+
+  std::string module_name = circuit_name + std::string(FABRIC_TESTBENCH_REFERENCE_VERILOG_MODULE_POSTFIX);
+  BasicPort stimuli_port(std::string(FABRIC_TESTBENCH_IO_STIMULI_NAME), num_ios);
+  BasicPort reference_port(std::string(FABRIC_TESTBENCH_IO_REFERENCE_NAME), num_ios);
+  BasicPort op_clock_port(std::string(TOP_TB_OP_CLOCK_PORT_NAME), 1);
+  std::string vector_index_name(FABRIC_TESTBENCH_VECTOR_INDEX_NAME);
+
+  fp << "module " << module_name << ";" << "\n";
+  fp << generate_verilog_port(VERILOG_PORT_REG, op_clock_port) << ";" << "\n";
+  fp << generate_verilog_port(VERILOG_PORT_REG, stimuli_port) << ";" << "\n";
+  fp << generate_verilog_port(VERILOG_PORT_REG, reference_port) << ";" << "\n";
+  fp << "integer stimuli_fd;" << "\n";
+  fp << "integer reference_fd;" << "\n";
+  fp << "integer " << vector_index_name << ";" << "\n";
+  fp << "\n";
+
+  /* Wire the benchmark I/Os to the bits of the vectors at the index of their GPIOs */
+  print_verilog_comment(fp, std::string("----- Benchmark I/Os wired to the vectors in the order of the I/Os of FPGA fabric -----"));
+  std::vector<std::pair<std::string, size_t>> output_indices;
+  for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
+    if ( (AtomBlockType::INPAD != atom_ctx.nlist.block_type(atom_blk))
+      && (AtomBlockType::OUTPAD != atom_ctx.nlist.block_type(atom_blk)) ) {
+      continue;
+    }
+
+    /* The block may be renamed as it contains special characters which violate Verilog syntax */
+    std::string block_name = atom_ctx.nlist.block_name(atom_blk);
+    if (true == netlist_annotation.is_block_renamed(atom_blk)) {
+      block_name = netlist_annotation.block_name(atom_blk);
+    }
+
+    size_t io_index = atom_io_indices[atom_blk];
+    VTR_ASSERT(io_index < num_ios);
+    if (AtomBlockType::INPAD == atom_ctx.nlist.block_type(atom_blk)) {
+      BasicPort input_port(block_name, 1);
+      fp << generate_verilog_port(VERILOG_PORT_WIRE, input_port) << ";" << "\n";
+      if (clock_port_names.end() != std::find(clock_port_names.begin(), clock_port_names.end(), block_name)) {
+        print_verilog_wire_connection(fp, input_port, op_clock_port, false);
+      } else {
+        print_verilog_wire_connection(fp, input_port, BasicPort(stimuli_port.get_name(), io_index, io_index), false);
+      }
+    } else {
+      VTR_ASSERT(AtomBlockType::OUTPAD == atom_ctx.nlist.block_type(atom_blk));
+      BasicPort output_port(block_name + std::string(TOP_TESTBENCH_REFERENCE_OUTPUT_POSTFIX), 1);
+      fp << generate_verilog_port(VERILOG_PORT_WIRE, output_port) << ";" << "\n";
+      output_indices.push_back(std::make_pair(output_port.get_name(), io_index));
+    }
+  }
+  fp << "\n";
+
+  /* Do NOT use explicit port mapping here:
+   * VPR added a prefix of "out_" to the output ports of input benchmark
+   */
+  std::vector<std::string> prefix_to_remove;
+  prefix_to_remove.push_back(std::string(VPR_BENCHMARK_OUT_PORT_PREFIX));
+  prefix_to_remove.push_back(std::string(OPENFPGA_BENCHMARK_OUT_PORT_PREFIX));
+  print_verilog_testbench_benchmark_instance(fp, circuit_name,
+                                             std::string(TOP_TESTBENCH_REFERENCE_INSTANCE_NAME),
+                                             std::string(),
+                                             std::string(),
+                                             prefix_to_remove,
+                                             std::string(TOP_TESTBENCH_REFERENCE_OUTPUT_POSTFIX),
+                                             atom_ctx, netlist_annotation,
+                                             explicit_port_mapping);
+  fp << "\n";
+
+  print_verilog_comment(fp, "----- Operating clock -----");
+  print_verilog_clock_stimuli(fp, op_clock_port,
+                              0, /* Initial value */
+                              0.5 / simulation_parameters.operating_clock_frequency() / VERILOG_SIM_TIMESCALE,
+                              std::string());
+  fp << "\n";
+
+  fp << "initial" << "\n";
+  fp << "\tbegin" << "\n";
+  fp << "\t\t" << generate_verilog_port_constant_values(stimuli_port, std::vector<size_t>(num_ios, VERILOG_DEFAULT_SIGNAL_INIT_VALUE)) << ";" << "\n";
+  fp << "\t\t" << vector_index_name << " = 0;" << "\n";
+  fp << "\t\tstimuli_fd = $fopen(\"" << stimuli_fname << "\", \"r\");" << "\n";
+  fp << "\t\treference_fd = $fopen(\"" << reference_fname << "\", \"w\");" << "\n";
+  fp << "\tend" << "\n";
+  fp << "\n";
+
+  print_verilog_comment(fp, std::string("----- Write the output vectors and apply the input vectors -----"));
+  fp << "always@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, op_clock_port) << ") begin" << "\n";
+  fp << "\tif (0 < " << vector_index_name << ") begin" << "\n";
+  fp << "\t\t" << generate_verilog_port_constant_values(reference_port, std::vector<size_t>(num_ios, 0)) << ";" << "\n";
+  for (const auto& output_index : output_indices) {
+    fp << "\t\t" << reference_port.get_name() << "[" << output_index.second << "] = " << output_index.first << ";" << "\n";
+  }
+  fp << "\t\t$fdisplay(reference_fd, \"%b\", " << reference_port.get_name() << ");" << "\n";
+  fp << "\tend" << "\n";
+  fp << "\tif (1 == $fscanf(stimuli_fd, \"%b\\n\", " << stimuli_port.get_name() << ")) begin" << "\n";
+  fp << "\t\t" << vector_index_name << " = " << vector_index_name << " + 1;" << "\n";
+  fp << "\tend else begin" << "\n";
+  fp << "\t\t$fclose(stimuli_fd);" << "\n";
+  fp << "\t\t$fclose(reference_fd);" << "\n";
+  fp << "\t\t$display(\"Written %0d reference vectors\", " << vector_index_name << ");" << "\n";
+  fp << "\t\t$finish;" << "\n";
+  fp << "\tend" << "\n";
+  fp << "end" << "\n";
+  fp << "\n";
+
+  print_verilog_module_end(fp, module_name);
+
+  /* Close the file stream */
+  fp.close();
+}
+
+/********************************************************************
+ * Write the files of a benchmark which are given at runtime
+ * to the fabric testbench (see print_verilog_fabric_testbench()):
+ * - the bitstream, one word per programming cycle
+ * - the I/O mapping, i.e., the clock mask and the output mask of the GPIOs
+ * - the input vectors, generated with a fixed seed, one vector per clock cycle
+ * - a testbench of the benchmark, which writes the reference output vectors
+ * - the plusargs of the fabric testbench for these files
+ * All the masks and vectors are in binary characters,
+ * in the order of the GPIOs of the FPGA fabric
+ *******************************************************************/
+void print_verilog_fabric_testbench_data(const ModuleManager& module_manager,
+                                         const BitstreamManager& bitstream_manager,
+                                         const FabricBitstream& fabric_bitstream,
+                                         const e_config_protocol_type& sram_orgz_type,
+                                         const AtomContext& atom_ctx,
+                                         const PlacementContext& place_ctx,
+                                         const IoLocationMap& io_location_map,
+                                         const VprNetlistAnnotation& netlist_annotation,
+                                         const std::string& circuit_name,
+                                         const std::string& src_dir_path,
+                                         const SimulationSetting& simulation_parameters,
+                                         const bool& explicit_port_mapping) {
+  std::string timer_message = std::string("Write data of fabric testbench for '") + circuit_name + std::string("'");
+
+  /* Start time count */
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  VTR_ASSERT(CONFIG_MEM_STANDALONE != sram_orgz_type);
+
+  /* Find the top_module */
+  ModuleId top_module = module_manager.find_module(generate_fpga_top_module_name());
+  VTR_ASSERT(true == module_manager.valid_module_id(top_module));
+
+  std::string bitstream_fname = src_dir_path + circuit_name + std::string(FABRIC_TESTBENCH_BITSTREAM_FILE_POSTFIX);
+  std::string io_map_fname = src_dir_path + circuit_name + std::string(FABRIC_TESTBENCH_IO_MAP_FILE_POSTFIX);
+  std::string stimuli_fname = src_dir_path + circuit_name + std::string(FABRIC_TESTBENCH_STIMULI_FILE_POSTFIX);
+  std::string reference_fname = src_dir_path + circuit_name + std::string(FABRIC_TESTBENCH_REFERENCE_FILE_POSTFIX);
+
+  /* Bitstream */
+  BufferedFileStream mem_fp;
+  mem_fp.open(bitstream_fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(bitstream_fname.c_str(), mem_fp);
+  for (const std::string& word : build_fabric_testbench_bitstream_words(sram_orgz_type, bitstream_manager, fabric_bitstream)) {
+    mem_fp << word << "\n";
+  }
+  mem_fp.close();
+
+  /* I/O mapping */
+  size_t num_ios = 0;
+  for (const BasicPort& module_io_port : module_manager.module_ports_by_type(top_module, ModuleManager::MODULE_GPIO_PORT)) {
+    num_ios += module_io_port.get_width();
+  }
+  vtr::vector<AtomBlockId, size_t> atom_io_indices = find_atom_netlist_io_indices(atom_ctx, place_ctx, io_location_map);
+  std::vector<std::string> clock_port_names = find_atom_netlist_clock_port_names(atom_ctx.nlist, netlist_annotation);
+
+  std::string clock_mask(num_ios, '0');
+  std::string output_mask(num_ios, '0');
+  std::vector<size_t> input_indices;
+  for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
+    if ( (AtomBlockType::INPAD != atom_ctx.nlist.block_type(atom_blk))
+      && (AtomBlockType::OUTPAD != atom_ctx.nlist.block_type(atom_blk)) ) {
+      continue;
+    }
+    std::string block_name = atom_ctx.nlist.block_name(atom_blk);
+    if (true == netlist_annotation.is_block_renamed(atom_blk)) {
+      block_name = netlist_annotation.block_name(atom_blk);
+    }
+    size_t io_index = atom_io_indices[atom_blk];
+    VTR_ASSERT(io_index < num_ios);
+    if (AtomBlockType::OUTPAD == atom_ctx.nlist.block_type(atom_blk)) {
+      output_mask[io_index] = '1';
+    } else if (clock_port_names.end() != std::find(clock_port_names.begin(), clock_port_names.end(), block_name)) {
+      clock_mask[io_index] = '1';
+    } else {
+      input_indices.push_back(io_index);
+    }
+  }
+
+  mem_fp.open(io_map_fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(io_map_fname.c_str(), mem_fp);
+  mem_fp << clock_mask << "\n";
+  mem_fp << output_mask << "\n";
+  mem_fp.close();
+
+  /* Input vectors, generated with a fixed seed so that the data is the same for each run */
+  std::mt19937 random_generator(1);
+  mem_fp.open(stimuli_fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(stimuli_fname.c_str(), mem_fp);
+  std::string io_vector(num_ios, VERILOG_DEFAULT_SIGNAL_INIT_VALUE ? '1' : '0');
+  for (size_t ivec = 0; ivec < simulation_parameters.num_clock_cycles(); ++ivec) {
+    for (const size_t& io_index : input_indices) {
+      io_vector[io_index] = (random_generator() & 1) ? '1' : '0';
+    }
+    mem_fp << io_vector << "\n";
+  }
+  mem_fp.close();
+
+  /* Testbench of the benchmark writing the reference vectors */
+  print_verilog_fabric_testbench_reference(circuit_name,
+                                           src_dir_path + circuit_name + std::string(FABRIC_TESTBENCH_REFERENCE_VERILOG_FILE_POSTFIX),
+                                           stimuli_fname, reference_fname,
+                                           atom_ctx, netlist_annotation,
+                                           atom_io_indices, clock_port_names, num_ios,
+                                           simulation_parameters,
+                                           explicit_port_mapping);
+
+  /* Plusargs of the fabric testbench, e.g., for the -f option of simulators */
+  std::string plusargs_fname = src_dir_path + circuit_name + std::string(FABRIC_TESTBENCH_PLUSARGS_FILE_POSTFIX);
+  mem_fp.open(plusargs_fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(plusargs_fname.c_str(), mem_fp);
+  mem_fp << "+" << FABRIC_TESTBENCH_BITSTREAM_PLUSARG_NAME << "=" << bitstream_fname << "\n";
+  mem_fp << "+" << FABRIC_TESTBENCH_IO_MAP_PLUSARG_NAME << "=" << io_map_fname << "\n";
+  mem_fp << "+" << FABRIC_TESTBENCH_STIMULI_PLUSARG_NAME << "=" << stimuli_fname << "\n";
+  mem_fp << "+" << FABRIC_TESTBENCH_REFERENCE_PLUSARG_NAME << "=" << reference_fname << "\n";
+  mem_fp.close();
+}
+
 } /* end namespace openfpga */
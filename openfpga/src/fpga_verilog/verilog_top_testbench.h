@@ -36,8 +36,31 @@ void print_verilog_top_testbench(const ModuleManager& module_manager,
                                  const std::string& verilog_fname,
                                  const SimulationSetting& simulation_parameters,
                                  const bool& fast_configuration,
+                                 const bool& compress_bitstream,
+                                 const std::string& bitstream_memory_fname,
                                  const bool& explicit_port_mapping);
 
+void print_verilog_fabric_testbench(const ModuleManager& module_manager,
+                                    const e_config_protocol_type& sram_orgz_type,
+                                    const CircuitLibrary& circuit_lib,
+                                    const std::vector<CircuitPortId>& global_ports,
+                                    const std::string& verilog_fname,
+                                    const SimulationSetting& simulation_parameters,
+                                    const bool& explicit_port_mapping);
+
+void print_verilog_fabric_testbench_data(const ModuleManager& module_manager,
+                                         const BitstreamManager& bitstream_manager,
+                                         const FabricBitstream& fabric_bitstream,
+                                         const e_config_protocol_type& sram_orgz_type,
+                                         const AtomContext& atom_ctx,
+                                         const PlacementContext& place_ctx,
+                                         const IoLocationMap& io_location_map,
+                                         const VprNetlistAnnotation& netlist_annotation,
+                                         const std::string& circuit_name,
+                                         const std::string& src_dir_path,
+                                         const SimulationSetting& simulation_parameters,
+                                         const bool& explicit_port_mapping);
+
 } /* end namespace openfpga */
 
 #endif
@@ -38,7 +38,8 @@ static
 void print_verilog_wire_module(const ModuleManager& module_manager, 
                                const CircuitLibrary& circuit_lib,
                                std::fstream& fp,
-                               const CircuitModelId& wire_model) {
+                               const CircuitModelId& wire_model,
+                               const bool& sdf_timing) {
   /* Ensure a valid file handler*/
   VTR_ASSERT(true == valid_file_stream(fp));
 
@@ -73,20 +74,20 @@ void print_verilog_wire_module(const ModuleManager& module_manager,
   BasicPort module_output_port = module_manager.module_port(wire_module, module_output_port_id);
 
   /* Print wire declaration for the inputs and outputs */
-  fp << generate_verilog_port(VERILOG_PORT_WIRE, module_input_port) << ";" << std::endl;
-  fp << generate_verilog_port(VERILOG_PORT_WIRE, module_output_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_WIRE, module_input_port) << ";" << "\n";
+  fp << generate_verilog_port(VERILOG_PORT_WIRE, module_output_port) << ";" << "\n";
 
   /* Direct shortcut */
   print_verilog_wire_connection(fp, module_output_port, module_input_port, false);
   
   /* Print timing info */
-  print_verilog_submodule_timing(fp, circuit_lib, wire_model);
+  print_verilog_submodule_timing(fp, circuit_lib, wire_model, sdf_timing);
    
   /* Put an end to the Verilog module */
   print_verilog_module_end(fp, circuit_lib.model_name(wire_model));
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -95,11 +96,13 @@ void print_verilog_wire_module(const ModuleManager& module_manager,
 void print_verilog_submodule_wires(const ModuleManager& module_manager,
                                    NetlistManager& netlist_manager,
                                    const CircuitLibrary& circuit_lib,
-                                   const std::string& submodule_dir) {
+                                   const std::string& submodule_dir,
+                                   const bool& sdf_timing,
+                                   const bool& incremental) {
   std::string verilog_fname(submodule_dir + std::string(WIRES_VERILOG_FILE_NAME));
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(incremental, std::string(VERILOG_FILE_HEADER_TIME_STAMP_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
@@ -117,7 +120,7 @@ void print_verilog_submodule_wires(const ModuleManager& module_manager,
     if (!circuit_lib.model_verilog_netlist(model).empty()) {
       continue;
     }
-    print_verilog_wire_module(module_manager, circuit_lib, fp, model);
+    print_verilog_wire_module(module_manager, circuit_lib, fp, model, sdf_timing);
   }
   print_verilog_comment(fp, std::string("----- END Verilog modules for regular wires -----"));
 
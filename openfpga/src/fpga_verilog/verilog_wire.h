@@ -21,7 +21,9 @@ namespace openfpga {
 void print_verilog_submodule_wires(const ModuleManager& module_manager,
                                    NetlistManager& netlist_manager,
                                    const CircuitLibrary& circuit_lib,
-                                   const std::string& submodule_dir);
+                                   const std::string& submodule_dir,
+                                   const bool& sdf_timing,
+                                   const bool& incremental);
 
 } /* end namespace openfpga */
 
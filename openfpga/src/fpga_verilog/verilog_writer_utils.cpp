@@ -36,17 +36,20 @@ void print_verilog_file_header(std::fstream& fp,
  
   auto end = std::chrono::system_clock::now(); 
   std::time_t end_time = std::chrono::system_clock::to_time_t(end);
-
-  fp << "//-------------------------------------------" << std::endl;
-  fp << "//\tFPGA Synthesizable Verilog Netlist" << std::endl;
-  fp << "//\tDescription: " << usage << std::endl;
-  fp << "//\tAuthor: Xifan TANG" << std::endl;
-  fp << "//\tOrganization: University of Utah" << std::endl;
-  fp << "//\tDate: " << std::ctime(&end_time) ;
-  fp << "//-------------------------------------------" << std::endl;
-  fp << "//----- Time scale -----" << std::endl;
-  fp << "`timescale 1ns / 1ps" << std::endl;
-  fp << std::endl;
+  /* Use the reentrant version, as netlists may be written by concurrent threads */
+  char end_time_str[26];
+  ctime_r(&end_time, end_time_str);
+
+  fp << "//-------------------------------------------" << "\n";
+  fp << "//\tFPGA Synthesizable Verilog Netlist" << "\n";
+  fp << "//\tDescription: " << usage << "\n";
+  fp << "//\tAuthor: Xifan TANG" << "\n";
+  fp << "//\tOrganization: University of Utah" << "\n";
+  fp << VERILOG_FILE_HEADER_TIME_STAMP_PREFIX << end_time_str;
+  fp << "//-------------------------------------------" << "\n";
+  fp << "//----- Time scale -----" << "\n";
+  fp << "`timescale 1ns / 1ps" << "\n";
+  fp << "\n";
 }
 
 /********************************************************************
@@ -56,7 +59,7 @@ void print_verilog_include_netlist(std::fstream& fp,
                                    const std::string& netlist_name) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`include \"" << netlist_name << "\"" << std::endl; 
+  fp << "`include \"" << netlist_name << "\"" << "\n"; 
 }
 
 /********************************************************************
@@ -67,7 +70,7 @@ void print_verilog_define_flag(std::fstream& fp,
                                const int& flag_value) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`define " << flag_name << " " << flag_value << std::endl; 
+  fp << "`define " << flag_name << " " << flag_value << "\n"; 
 }
 
 /************************************************
@@ -90,7 +93,7 @@ void print_verilog_comment(std::fstream& fp,
                            const std::string& comment) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "// " << comment << std::endl;
+  fp << "// " << comment << "\n";
 }
 
 /************************************************
@@ -100,7 +103,7 @@ void print_verilog_preprocessing_flag(std::fstream& fp,
                                       const std::string& preproc_flag) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`ifdef " << preproc_flag << std::endl;
+  fp << "`ifdef " << preproc_flag << "\n";
 }
 
 /************************************************
@@ -109,21 +112,32 @@ void print_verilog_preprocessing_flag(std::fstream& fp,
 void print_verilog_endif(std::fstream& fp) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`endif" << std::endl;
+  fp << "`endif" << "\n";
 }
 
 /************************************************
  * Print a Verilog module definition
  * We use the following format:
  * module <module_name> (<ports without directions>);
+ * The module name is the one in the module manager
+ * unless another name is provided
+ *
+ * The ports are written as they are in the module manager
+ * unless the Verilog ports are provided (indexed by the module port ids),
+ * where the ports with an empty name are not written,
+ * e.g., the ports packed into another Verilog port
  ***********************************************/
 void print_verilog_module_definition(std::fstream& fp, 
-                                     const ModuleManager& module_manager, const ModuleId& module_id) {
+                                     const ModuleManager& module_manager, const ModuleId& module_id,
+                                     const std::string& module_name,
+                                     const std::vector<BasicPort>* verilog_ports) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  print_verilog_comment(fp, std::string("----- Verilog module for " + module_manager.module_name(module_id) + " -----"));
+  std::string verilog_module_name = module_name.empty() ? module_manager.module_name(module_id) : module_name;
 
-  std::string module_head_line = "module " + module_manager.module_name(module_id) + "(";
+  print_verilog_comment(fp, std::string("----- Verilog module for " + verilog_module_name + " -----"));
+
+  std::string module_head_line = "module " + verilog_module_name + "(";
   fp << module_head_line;
 
   /* port type2type mapping */
@@ -142,9 +156,16 @@ void print_verilog_module_definition(std::fstream& fp,
   bool printed_ifdef = false; /* A flag to tell if an ifdef has been printed for the last port */
   for (const auto& kv : port_type2type_map) {
     for (const auto& port : module_manager.module_ports_by_type(module_id, kv.first)) {
+      ModulePortId port_id = module_manager.find_module_port(module_id, port.get_name());
+      VTR_ASSERT(ModulePortId::INVALID() != port_id);
+      if ( (nullptr != verilog_ports)
+        && (true == (*verilog_ports)[size_t(port_id)].get_name().empty()) ) {
+        continue;
+      }
+
       if (0 != port_cnt) {
         /* Do not dump a comma for the first port */
-        fp << "," << std::endl; 
+        fp << "," << "\n"; 
       }
 
       if (true == printed_ifdef) {
@@ -154,8 +175,6 @@ void print_verilog_module_definition(std::fstream& fp,
         printed_ifdef = false;
       }
 
-      ModulePortId port_id = module_manager.find_module_port(module_id, port.get_name());
-      VTR_ASSERT(ModulePortId::INVALID() != port_id);
       /* Print pre-processing flag for a port, if defined */
       std::string preproc_flag = module_manager.port_preproc_flag(module_id, port_id);
       if (false == preproc_flag.empty()) {
@@ -171,20 +190,27 @@ void print_verilog_module_definition(std::fstream& fp,
         fp << port_whitespace;
       }
       /* Print port: only the port name is enough */
-      fp << port.get_name();
+      if (nullptr != verilog_ports) {
+        fp << (*verilog_ports)[size_t(port_id)].get_name();
+      } else {
+        fp << port.get_name();
+      }
 
       /* Increase the counter */
       port_cnt++;
     }
   }
-  fp << ");" << std::endl;
+  fp << ");" << "\n";
 }
 
 /************************************************
  * Print a Verilog module ports based on the module id 
+ * The Verilog ports, if provided, are used in the same way
+ * as print_verilog_module_definition()
  ***********************************************/
 void print_verilog_module_ports(std::fstream& fp, 
-                                const ModuleManager& module_manager, const ModuleId& module_id) {
+                                const ModuleManager& module_manager, const ModuleId& module_id,
+                                const std::vector<BasicPort>* verilog_ports) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* port type2type mapping */
@@ -203,6 +229,10 @@ void print_verilog_module_ports(std::fstream& fp,
     for (const auto& port : module_manager.module_ports_by_type(module_id, kv.first)) {
       ModulePortId port_id = module_manager.find_module_port(module_id, port.get_name());
       VTR_ASSERT(ModulePortId::INVALID() != port_id);
+      if ( (nullptr != verilog_ports)
+        && (true == (*verilog_ports)[size_t(port_id)].get_name().empty()) ) {
+        continue;
+      }
       /* Print pre-processing flag for a port, if defined */
       std::string preproc_flag = module_manager.port_preproc_flag(module_id, port_id);
       if (false == preproc_flag.empty()) {
@@ -211,9 +241,9 @@ void print_verilog_module_ports(std::fstream& fp,
       }
 
       /* Print port */
-      fp << "//----- " << module_manager.module_port_type_str(kv.first)  << " -----" << std::endl; 
-      fp << generate_verilog_port(kv.second, port);
-      fp << ";" << std::endl;
+      fp << "//----- " << module_manager.module_port_type_str(kv.first)  << " -----" << "\n"; 
+      fp << generate_verilog_port(kv.second, (nullptr != verilog_ports) ? (*verilog_ports)[size_t(port_id)] : port);
+      fp << ";" << "\n";
 
       if (false == preproc_flag.empty()) {
         /* Print an endif to pair the ifdef */
@@ -223,8 +253,8 @@ void print_verilog_module_ports(std::fstream& fp,
   }
 
   /* Output any port that is also wire connection */
-  fp << std::endl;
-  fp << "//----- BEGIN wire-connection ports -----" << std::endl; 
+  fp << "\n";
+  fp << "//----- BEGIN wire-connection ports -----" << "\n"; 
   for (const auto& kv : port_type2type_map) {
     for (const auto& port : module_manager.module_ports_by_type(module_id, kv.first)) {
       /* Skip the ports that are not registered */
@@ -243,7 +273,7 @@ void print_verilog_module_ports(std::fstream& fp,
 
       /* Print port */
       fp << generate_verilog_port(VERILOG_PORT_WIRE, port);
-      fp << ";" << std::endl;
+      fp << ";" << "\n";
 
       if (false == preproc_flag.empty()) {
         /* Print an endif to pair the ifdef */
@@ -251,13 +281,13 @@ void print_verilog_module_ports(std::fstream& fp,
       }
     }
   }
-  fp << "//----- END wire-connection ports -----" << std::endl; 
-  fp << std::endl;
+  fp << "//----- END wire-connection ports -----" << "\n"; 
+  fp << "\n";
 
  
   /* Output any port that is registered */
-  fp << std::endl;
-  fp << "//----- BEGIN Registered ports -----" << std::endl; 
+  fp << "\n";
+  fp << "//----- BEGIN Registered ports -----" << "\n"; 
   for (const auto& kv : port_type2type_map) {
     for (const auto& port : module_manager.module_ports_by_type(module_id, kv.first)) {
       /* Skip the ports that are not registered */
@@ -276,7 +306,7 @@ void print_verilog_module_ports(std::fstream& fp,
 
       /* Print port */
       fp << generate_verilog_port(VERILOG_PORT_REG, port);
-      fp << ";" << std::endl;
+      fp << ";" << "\n";
 
       if (false == preproc_flag.empty()) {
         /* Print an endif to pair the ifdef */
@@ -284,8 +314,8 @@ void print_verilog_module_ports(std::fstream& fp,
       }
     }
   }
-  fp << "//----- END Registered ports -----" << std::endl; 
-  fp << std::endl;
+  fp << "//----- END Registered ports -----" << "\n"; 
+  fp << "\n";
 }
 
 /************************************************
@@ -295,12 +325,14 @@ void print_verilog_module_ports(std::fstream& fp,
  * <tab><port definition with direction> 
  ***********************************************/
 void print_verilog_module_declaration(std::fstream& fp, 
-                                      const ModuleManager& module_manager, const ModuleId& module_id) {
+                                      const ModuleManager& module_manager, const ModuleId& module_id,
+                                      const std::string& module_name,
+                                      const std::vector<BasicPort>* verilog_ports) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  print_verilog_module_definition(fp, module_manager, module_id);
+  print_verilog_module_definition(fp, module_manager, module_id, module_name, verilog_ports);
 
-  print_verilog_module_ports(fp, module_manager, module_id);
+  print_verilog_module_ports(fp, module_manager, module_id, verilog_ports);
 }
 
 
@@ -323,13 +355,18 @@ void print_verilog_module_declaration(std::fstream& fp,
  * covers all the module ports.
  * Any instance/module port which are not specified in the port-to-port 
  * mapping will be output by the module port name.
+ *
+ * The instance is of the module named in the module manager
+ * unless another module name is provided,
+ * e.g., a module written with the same ports under another name
  *******************************************************************/
 void print_verilog_module_instance(std::fstream& fp, 
                                    const ModuleManager& module_manager, 
                                    const ModuleId& module_id,
                                    const std::string& instance_name,
                                    const std::map<std::string, BasicPort>& port2port_name_map,
-                                   const bool& use_explicit_port_map) {
+                                   const bool& use_explicit_port_map,
+                                   const std::string& module_name) {
 
   VTR_ASSERT(true == valid_file_stream(fp));
 
@@ -340,9 +377,9 @@ void print_verilog_module_instance(std::fstream& fp,
   }
 
   /* Print module name */
-  fp << "\t" << module_manager.module_name(module_id) << " ";
+  fp << "\t" << (module_name.empty() ? module_manager.module_name(module_id) : module_name) << " ";
   /* Print instance name */
-  fp << instance_name << " (" << std::endl;
+  fp << instance_name << " (" << "\n";
   
   /* Print each port with/without explicit port map */
   /* port type2type mapping */
@@ -362,7 +399,7 @@ void print_verilog_module_instance(std::fstream& fp,
     for (const auto& port : module_manager.module_ports_by_type(module_id, kv.first)) {
       if (0 != port_cnt) {
         /* Do not dump a comma for the first port */
-        fp << "," << std::endl; 
+        fp << "," << "\n"; 
       }
       /* Print port */
       fp << "\t\t";
@@ -392,7 +429,7 @@ void print_verilog_module_instance(std::fstream& fp,
   }
   
   /* Print an end to the instance */
-  fp << ");" << std::endl;
+  fp << ");" << "\n";
 }
 
 
@@ -426,9 +463,9 @@ void print_verilog_module_end(std::fstream& fp,
                               const std::string& module_name) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "endmodule" << std::endl;
+  fp << "endmodule" << "\n";
   print_verilog_comment(fp, std::string("----- END Verilog module for " + module_name + " -----"));
-  fp << std::endl;
+  fp << "\n";
 }
 
 /************************************************
@@ -709,7 +746,7 @@ void print_verilog_wire_constant_values(std::fstream& fp,
   fp << "\t";
   fp << "assign ";
   fp << generate_verilog_port_constant_values(output_port, const_values);
-  fp << ";" << std::endl;
+  fp << ";" << "\n";
 }
 
 /********************************************************************
@@ -726,7 +763,7 @@ void print_verilog_deposit_wire_constant_values(std::fstream& fp,
   fp << generate_verilog_port(VERILOG_PORT_CONKT, output_port);
   fp << ", ";
   fp << generate_verilog_constant_values(const_values);
-  fp << ");" << std::endl;
+  fp << ");" << "\n";
 }
 
 /********************************************************************
@@ -742,7 +779,7 @@ void print_verilog_force_wire_constant_values(std::fstream& fp,
   fp << "\t";
   fp << "force ";
   fp << generate_verilog_port_constant_values(output_port, const_values);
-  fp << ";" << std::endl;
+  fp << ";" << "\n";
 }
 
 /********************************************************************
@@ -769,7 +806,7 @@ void print_verilog_wire_connection(std::fstream& fp,
   }
 
   fp << generate_verilog_port(VERILOG_PORT_CONKT, input_port);
-  fp << ";" << std::endl;
+  fp << ";" << "\n";
 }
 
 /********************************************************************
@@ -795,7 +832,7 @@ void print_verilog_register_connection(std::fstream& fp,
   }
 
   fp << generate_verilog_port(VERILOG_PORT_CONKT, input_port);
-  fp << ";" << std::endl;
+  fp << ";" << "\n";
 }
 
 
@@ -951,7 +988,7 @@ void print_verilog_local_sram_wires(std::fstream& fp,
     /* Generate the name of local wire for the CCFF inputs, CCFF output and inverted output */
     /* [0] => CCFF input */
     BasicPort ccff_config_bus_port(generate_local_config_bus_port_name(), port_size);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, ccff_config_bus_port) << ";" << std::endl; 
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, ccff_config_bus_port) << ";" << "\n"; 
     /* Connect first CCFF to the head */
     /* Head is always a 1-bit port */
     BasicPort ccff_head_port(generate_sram_port_name(sram_orgz_type, CIRCUIT_MODEL_PORT_INPUT), 1); 
@@ -973,7 +1010,7 @@ void print_verilog_local_sram_wires(std::fstream& fp,
     sram_ports.push_back(BasicPort(generate_sram_local_port_name(circuit_lib, sram_model, sram_orgz_type, CIRCUIT_MODEL_PORT_OUTPUT), port_size));
     /* Print local wire definition */
     for (const auto& sram_port : sram_ports) {
-      fp << generate_verilog_port(VERILOG_PORT_WIRE, sram_port) << ";" << std::endl; 
+      fp << generate_verilog_port(VERILOG_PORT_WIRE, sram_port) << ";" << "\n"; 
     }
 
     break;
@@ -1061,10 +1098,10 @@ void print_verilog_local_config_bus(std::fstream& fp,
      */
     BasicPort config_port(generate_local_sram_port_name(prefix, instance_id, CIRCUIT_MODEL_PORT_INPUT), 
                           num_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, config_port) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, config_port) << ";" << "\n";
     BasicPort inverted_config_port(generate_local_sram_port_name(prefix, instance_id, CIRCUIT_MODEL_PORT_OUTPUT), 
                                    num_conf_bits); 
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, inverted_config_port) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, inverted_config_port) << ";" << "\n";
     break;
   }
   default:
@@ -1132,26 +1169,26 @@ void print_verilog_rram_mux_config_bus(std::fstream& fp,
     /* Print configuration bus to group reserved BL/WLs */
     BasicPort reserved_bl_bus(generate_reserved_sram_port_name(CIRCUIT_MODEL_PORT_BL), 
                               num_reserved_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, reserved_bl_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, reserved_bl_bus) << ";" << "\n";
     BasicPort reserved_wl_bus(generate_reserved_sram_port_name(CIRCUIT_MODEL_PORT_WL), 
                               num_reserved_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, reserved_wl_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, reserved_wl_bus) << ";" << "\n";
 
     /* Print configuration bus to group BL/WLs */
     BasicPort bl_bus(generate_mux_config_bus_port_name(circuit_lib, mux_model, mux_size, 0, false), 
                      num_conf_bits + num_reserved_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, bl_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, bl_bus) << ";" << "\n";
     BasicPort wl_bus(generate_mux_config_bus_port_name(circuit_lib, mux_model, mux_size, 1, false), 
                      num_conf_bits + num_reserved_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, wl_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, wl_bus) << ";" << "\n";
 
     /* Print bus to group SRAM outputs, this is to interface memory cells to routing multiplexers */
     BasicPort sram_output_bus(generate_mux_sram_port_name(circuit_lib, mux_model, mux_size, mux_instance_id, CIRCUIT_MODEL_PORT_INPUT), 
                           num_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, sram_output_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, sram_output_bus) << ";" << "\n";
     BasicPort inverted_sram_output_bus(generate_mux_sram_port_name(circuit_lib, mux_model, mux_size, mux_instance_id, CIRCUIT_MODEL_PORT_OUTPUT), 
                                        num_conf_bits); 
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, inverted_sram_output_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, inverted_sram_output_bus) << ";" << "\n";
 
     /* Get the SRAM model of the mux_model */
     std::vector<CircuitModelId> sram_models = find_circuit_sram_models(circuit_lib, mux_model);
@@ -1271,13 +1308,13 @@ void print_verilog_pulse_stimuli(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Config_done signal: indicate when configuration is finished */
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial" << "\n";
+  fp << "\tbegin" << "\n";
   fp << "\t";
   std::vector<size_t> initial_values(port.get_width(), initial_value);
   fp << "\t";
   fp << generate_verilog_port_constant_values(port, initial_values);
-  fp << ";" << std::endl;
+  fp << ";" << "\n";
   
   /* if flip_value is the same as initial value, we do not need to flip the signal ! */
   if (flip_value != initial_value) {
@@ -1285,13 +1322,13 @@ void print_verilog_pulse_stimuli(std::fstream& fp,
     std::vector<size_t> port_flip_values(port.get_width(), flip_value);
     fp << "\t";
     fp << generate_verilog_port_constant_values(port, port_flip_values);
-    fp << ";" << std::endl;
+    fp << ";" << "\n";
   }
 
-  fp << "\tend" << std::endl;
+  fp << "\tend" << "\n";
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -1315,17 +1352,17 @@ void print_verilog_pulse_stimuli(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Config_done signal: indicate when configuration is finished */
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial" << "\n";
+  fp << "\tbegin" << "\n";
   fp << "\t";
   std::vector<size_t> initial_values(port.get_width(), initial_value);
   fp << "\t";
   fp << generate_verilog_port_constant_values(port, initial_values);
-  fp << ";" << std::endl;
+  fp << ";" << "\n";
 
   /* Set a wait condition if specified */
   if (false == wait_condition.empty()) {
-    fp << "\twait(" << wait_condition << ")" << std::endl;
+    fp << "\twait(" << wait_condition << ")" << "\n";
   }
   
   /* Number of flip conditions and values should match */
@@ -1335,13 +1372,13 @@ void print_verilog_pulse_stimuli(std::fstream& fp,
     std::vector<size_t> port_flip_value(port.get_width(), flip_values[ipulse]);
     fp << "\t";
     fp << generate_verilog_port_constant_values(port, port_flip_value);
-    fp << ";" << std::endl;
+    fp << ";" << "\n";
   }
 
-  fp << "\tend" << std::endl;
+  fp << "\tend" << "\n";
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -1365,25 +1402,25 @@ void print_verilog_clock_stimuli(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Config_done signal: indicate when configuration is finished */
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial" << "\n";
+  fp << "\tbegin" << "\n";
 
   std::vector<size_t> initial_values(port.get_width(), initial_value);
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(port, initial_values);
-  fp << ";" << std::endl;
+  fp << ";" << "\n";
 
-  fp << "\tend" << std::endl;
+  fp << "\tend" << "\n";
   fp << "always";
 
   /* Set a wait condition if specified */
   if (true == wait_condition.empty()) {
-    fp << std::endl;
+    fp << "\n";
   } else {
-    fp << " wait(" << wait_condition << ")" << std::endl;
+    fp << " wait(" << wait_condition << ")" << "\n";
   }
 
-  fp << "\tbegin" << std::endl;
+  fp << "\tbegin" << "\n";
   fp << "\t\t" << "#" << std::setprecision(10) << pulse_width;
 
   fp << "\t";
@@ -1391,12 +1428,12 @@ void print_verilog_clock_stimuli(std::fstream& fp,
   fp << " = ";
   fp << "~";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, port);
-  fp << ";" << std::endl;
+  fp << ";" << "\n";
 
-  fp << "\tend" << std::endl;
+  fp << "\tend" << "\n";
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -1410,7 +1447,7 @@ void print_verilog_netlist_include_header_file(const std::vector<std::string>& n
   std::string verilog_fname(std::string(subckt_dir) + std::string(header_file_name));
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   VTR_ASSERT(true == valid_file_stream(fp));
@@ -1420,7 +1457,7 @@ void print_verilog_netlist_include_header_file(const std::vector<std::string>& n
 
   /* Output file names */
   for (const std::string& netlist_name : netlists_to_be_included) {
-    fp << "`include \"" << netlist_name << "\"" << std::endl;
+    fp << "`include \"" << netlist_name << "\"" << "\n";
   }
 
   /* close file stream */
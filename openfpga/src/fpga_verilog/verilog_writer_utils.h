@@ -53,20 +53,26 @@ void print_verilog_preprocessing_flag(std::fstream& fp,
 void print_verilog_endif(std::fstream& fp);
 
 void print_verilog_module_definition(std::fstream& fp, 
-                                     const ModuleManager& module_manager, const ModuleId& module_id);
+                                     const ModuleManager& module_manager, const ModuleId& module_id,
+                                     const std::string& module_name = std::string(),
+                                     const std::vector<BasicPort>* verilog_ports = nullptr);
 
 void print_verilog_module_ports(std::fstream& fp, 
-                                const ModuleManager& module_manager, const ModuleId& module_id);
+                                const ModuleManager& module_manager, const ModuleId& module_id,
+                                const std::vector<BasicPort>* verilog_ports = nullptr);
 
 void print_verilog_module_declaration(std::fstream& fp, 
-                                      const ModuleManager& module_manager, const ModuleId& module_id);
+                                      const ModuleManager& module_manager, const ModuleId& module_id,
+                                      const std::string& module_name = std::string(),
+                                      const std::vector<BasicPort>* verilog_ports = nullptr);
 
 void print_verilog_module_instance(std::fstream& fp, 
                                    const ModuleManager& module_manager, 
                                    const ModuleId& module_id,
                                    const std::string& instance_name,
                                    const std::map<std::string, BasicPort>& port2port_name_map,
-                                   const bool& use_explicit_port_map);
+                                   const bool& use_explicit_port_map,
+                                   const std::string& module_name = std::string());
 
 void print_verilog_module_instance(std::fstream& fp, 
                                    const ModuleManager& module_manager,
@@ -3,12 +3,16 @@
  *******************************************************************/
 /* Header file from vtrutil library */
 #include "vtr_time.h"
+#include "vtr_trace.h"
+#include "vtr_memory_stats.h"
+#include "vtr_parallel.h"
 #include "vtr_log.h"
 
 /* Header file from libopenfpgashell library */
 #include "command_parser.h"
 #include "command_echo.h"
 #include "shell.h"
+#include "shell_socket.h"
 
 /* Header file from openfpga */
 #include "vpr_command.h"
@@ -17,10 +21,13 @@
 #include "openfpga_bitstream_command.h"
 #include "openfpga_spice_command.h"
 #include "openfpga_sdc_command.h"
+#include "openfpga_context_command.h"
 #include "basic_command.h"
 
 #include "openfpga_title.h"
 #include "openfpga_context.h"
+#include "openfpga_command_threads.h"
+#include "openfpga_reset_design.h"
 
 /********************************************************************
  * Main function to start OpenFPGA shell interface
@@ -40,9 +47,56 @@ int main(int argc, char** argv) {
   start_cmd.set_option_require_value(opt_script_mode, openfpga::OPT_STRING);
   start_cmd.set_option_short_name(opt_script_mode, "f");
 
+  openfpga::CommandOptionId opt_batch = start_cmd.add_option("batch", false, "Execute the script for each design of a file, where each line defines the variables of a design as NAME=VALUE (script mode only)");
+  start_cmd.set_option_require_value(opt_batch, openfpga::OPT_STRING);
+  start_cmd.set_option_short_name(opt_batch, "b");
+
+  openfpga::CommandOptionId opt_parallel = start_cmd.add_option("parallel", false, "Execute the independent output commands of the script concurrently (script mode only)");
+  start_cmd.set_option_short_name(opt_parallel, "p");
+
+  openfpga::CommandOptionId opt_profile = start_cmd.add_option("profile", false, "Write the runtime and memory usage of each command to a file (JSON if it ends with .json, CSV otherwise)");
+  start_cmd.set_option_require_value(opt_profile, openfpga::OPT_STRING);
+
+  openfpga::CommandOptionId opt_profile_memory = start_cmd.add_option("profile_memory", false, "Attribute the memory of the large data structures to their owners, and report the peak of each owner per command in the profile (see --profile)");
+
+  openfpga::CommandOptionId opt_threads = start_cmd.add_option("threads", false, "Specify the default number of threads of the commands which support parallel execution (overridden by their own --threads option)");
+  start_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
+  openfpga::CommandOptionId opt_trace = start_cmd.add_option("trace", false, "Write the nested phases of the commands to a file in the Chrome trace-event JSON format (viewable with chrome://tracing or Perfetto)");
+  start_cmd.set_option_require_value(opt_trace, openfpga::OPT_STRING);
+
+  openfpga::CommandOptionId opt_server = start_cmd.add_option("server", false, "Launch OpenFPGA in server mode, listening at a socket file for the scripts of clients");
+  start_cmd.set_option_require_value(opt_server, openfpga::OPT_STRING);
+
+  openfpga::CommandOptionId opt_client = start_cmd.add_option("client", false, "Send the script to OpenFPGA in server mode at a socket file and print the outputs (script mode only)");
+  start_cmd.set_option_require_value(opt_client, openfpga::OPT_STRING);
+
   openfpga::CommandOptionId opt_help = start_cmd.add_option("help", false, "Help desk"); 
   start_cmd.set_option_short_name(opt_help, "h");
 
+  /* Parse the option, to avoid issues, we use the command name to replace the argv[0] */
+  std::vector<std::string> cmd_opts; 
+  cmd_opts.push_back(start_cmd.name());
+  for (int iarg = 1; iarg < argc; ++iarg) {
+    cmd_opts.push_back(std::string(argv[iarg]));
+  }
+
+  openfpga::CommandContext start_cmd_context(start_cmd);
+  if (false == parse_command(cmd_opts, start_cmd, start_cmd_context)) {
+    /* Parse fail: Echo the command */
+    openfpga::print_command_options(start_cmd);
+    return 0;
+  }
+
+  /* In client mode, the script is executed by a shell in server mode,
+   * so there is no need to build a shell here
+   */
+  if ( (true == start_cmd_context.option_enable(start_cmd, opt_client))
+    && (true == start_cmd_context.option_enable(start_cmd, opt_script_mode)) ) {
+    return openfpga::run_shell_client(start_cmd_context.option_value(start_cmd, opt_client).c_str(),
+                                      start_cmd_context.option_value(start_cmd, opt_script_mode).c_str());
+  }
+
   /* Create a shell object
    * Add two commands, which are
    * 1. exit
@@ -70,42 +124,68 @@ int main(int argc, char** argv) {
   /* Add openfpga sdc commands */
   openfpga::add_openfpga_sdc_commands(shell);
 
+  /* Add openfpga context commands: save_context, load_context */
+  openfpga::add_openfpga_context_commands(shell);
+
   /* Add basic commands: exit, help, etc. 
    * Note:
    * This MUST be the last command group to be added! 
    */
   openfpga::add_basic_commands(shell);
 
+  /* Memory accounting must be enabled before any data structure is built */
+  if (true == start_cmd_context.option_enable(start_cmd, opt_profile_memory)) {
+    vtr::enable_memory_stats();
+  }
+
+  /* The number of threads of the shell is the default of all the commands */
+  int num_threads = openfpga::get_num_threads(start_cmd, start_cmd_context, vtr::num_workers());
+  if (0 == num_threads) {
+    return 1;
+  }
+  vtr::set_num_workers(num_threads);
+
   /* Create the data base for the shell */
   OpenfpgaContext openfpga_context;
 
-  /* Parse the option, to avoid issues, we use the command name to replace the argv[0] */
-  std::vector<std::string> cmd_opts; 
-  cmd_opts.push_back(start_cmd.name());
-  for (int iarg = 1; iarg < argc; ++iarg) {
-    cmd_opts.push_back(std::string(argv[iarg]));
+  /* Start the shell in the selected mode */ 
+  if (true == start_cmd_context.option_enable(start_cmd, opt_trace)) {
+    vtr::enable_trace(start_cmd_context.option_value(start_cmd, opt_trace));
   }
 
-  openfpga::CommandContext start_cmd_context(start_cmd);
-  if (false == parse_command(cmd_opts, start_cmd, start_cmd_context)) {
-    /* Parse fail: Echo the command */
-    openfpga::print_command_options(start_cmd);
-  } else {
-    /* Parse succeed. Start a shell */ 
-    if (true == start_cmd_context.option_enable(start_cmd, opt_interactive)) {
-
-      shell.run_interactive_mode(openfpga_context);
-      return 0;
-    } 
-
-    if (true == start_cmd_context.option_enable(start_cmd, opt_script_mode)) {
-      shell.run_script_mode(start_cmd_context.option_value(start_cmd, opt_script_mode).c_str(),
-                            openfpga_context);
-      return 0;
-    }
-    /* Reach here there is something wrong, show the help desk */
-    openfpga::print_command_options(start_cmd);
+  if (true == start_cmd_context.option_enable(start_cmd, opt_profile)) {
+    shell.set_profile_file(start_cmd_context.option_value(start_cmd, opt_profile));
+  }
+
+  if (true == start_cmd_context.option_enable(start_cmd, opt_interactive)) {
+
+    shell.run_interactive_mode(openfpga_context);
+    return 0;
+  } 
+
+  if (true == start_cmd_context.option_enable(start_cmd, opt_server)) {
+    shell.run_server_mode(start_cmd_context.option_value(start_cmd, opt_server).c_str(),
+                          openfpga_context);
+    return 0;
+  }
+
+  if ( (true == start_cmd_context.option_enable(start_cmd, opt_script_mode))
+    && (true == start_cmd_context.option_enable(start_cmd, opt_batch)) ) {
+    shell.run_batch_mode(start_cmd_context.option_value(start_cmd, opt_script_mode).c_str(),
+                         start_cmd_context.option_value(start_cmd, opt_batch).c_str(),
+                         openfpga_context,
+                         openfpga::reset_design_dependent_context);
+    return 0;
+  }
+
+  if (true == start_cmd_context.option_enable(start_cmd, opt_script_mode)) {
+    shell.run_script_mode(start_cmd_context.option_value(start_cmd, opt_script_mode).c_str(),
+                          openfpga_context,
+                          start_cmd_context.option_enable(start_cmd, opt_parallel));
+    return 0;
   }
+  /* Reach here there is something wrong, show the help desk */
+  openfpga::print_command_options(start_cmd);
 
   return 0;
 }
\ No newline at end of file
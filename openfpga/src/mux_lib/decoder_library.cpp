@@ -47,6 +47,30 @@ bool DecoderLibrary::use_data_inv_port(const DecoderId& decoder) const {
   return use_data_inv_port_[decoder];
 }
 
+/* Get the maximum number of address bits in a predecode group of a decoder */
+size_t DecoderLibrary::predecode_size(const DecoderId& decoder) const {
+  VTR_ASSERT_SAFE(valid_decoder_id(decoder));
+  return predecode_sizes_[decoder];
+}
+
+/* Split the address bits of a decoder into predecode groups, whose sizes differ by 1 at most, e.g.,
+ * 7 address bits with a predecode size of 3 are split into 3 groups: [3, 2, 2]
+ */
+std::vector<size_t> DecoderLibrary::predecode_groups(const DecoderId& decoder) const {
+  VTR_ASSERT_SAFE(valid_decoder_id(decoder));
+  size_t addr_size = addr_sizes_[decoder];
+  size_t num_groups = 1;
+  if ( (0 < predecode_sizes_[decoder]) 
+    && (predecode_sizes_[decoder] < addr_size) ) {
+    num_groups = (addr_size + predecode_sizes_[decoder] - 1) / predecode_sizes_[decoder];
+  }
+  std::vector<size_t> groups(num_groups, addr_size / num_groups);
+  for (size_t igroup = 0; igroup < addr_size % num_groups; ++igroup) {
+    groups[igroup]++;
+  }
+  return groups;
+}
+
 /* Find a decoder to the library, with the specification.
  * If found, return the id of decoder.
  * If not found, return an invalid id of decoder
@@ -102,8 +126,14 @@ DecoderId DecoderLibrary::add_decoder(const size_t& addr_size,
   use_enable_.push_back(use_enable);
   use_data_in_.push_back(use_data_in);
   use_data_inv_port_.push_back(use_data_inv_port);
+  predecode_sizes_.push_back(0);
 
   return decoder;
 }
 
+void DecoderLibrary::set_predecode_size(const DecoderId& decoder, const size_t& predecode_size) {
+  VTR_ASSERT(valid_decoder_id(decoder));
+  predecode_sizes_[decoder] = predecode_size;
+}
+
 } /* End namespace openfpga*/
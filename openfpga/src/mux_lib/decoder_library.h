@@ -22,6 +22,7 @@
 #ifndef DECODER_LIBRARY_H
 #define DECODER_LIBRARY_H
 
+#include <vector>
 #include "vtr_vector.h"
 #include "vtr_range.h"
 #include "decoder_library_fwd.h"
@@ -50,6 +51,13 @@ class DecoderLibrary {
     bool use_data_in(const DecoderId& decoder) const;
     /* Get the flag if a decoder includes a data_inv port which is an inversion of the regular data output port */
     bool use_data_inv_port(const DecoderId& decoder) const;
+    /* Get the maximum number of address bits in a predecode group of a decoder, 0 means no predecoding */
+    size_t predecode_size(const DecoderId& decoder) const;
+    /* Get the number of address bits in each predecode group of a decoder
+     * The address bits are split into balanced groups, starting from the least significant bit.
+     * A single group means that the decoder is built in a single level
+     */
+    std::vector<size_t> predecode_groups(const DecoderId& decoder) const;
     /* Find a decoder to the library, with the specification.
      * If found, return the id of decoder.
      * If not found, return an invalid id of decoder
@@ -77,6 +85,10 @@ class DecoderLibrary {
                           const bool& use_enable, 
                           const bool& use_data_in, 
                           const bool& use_data_inv_port);
+    /* Set the maximum number of address bits in a predecode group of a decoder
+     * It only changes how the decoder is implemented in netlists, not its function
+     */
+    void set_predecode_size(const DecoderId& decoder, const size_t& predecode_size);
     
   private: /* Internal Data */
     vtr::vector<DecoderId, DecoderId> decoder_ids_;
@@ -85,6 +97,7 @@ class DecoderLibrary {
     vtr::vector<DecoderId, bool> use_enable_;
     vtr::vector<DecoderId, bool> use_data_in_;
     vtr::vector<DecoderId, bool> use_data_inv_port_;
+    vtr::vector<DecoderId, size_t> predecode_sizes_;
 };
 
 } /* End namespace openfpga*/
@@ -233,17 +233,17 @@ size_t MuxGraph::node_index_at_level(const MuxNodeId& node) const {
 }
 
 /* Find the  input edges for a node */
-std::vector<MuxEdgeId> MuxGraph::node_in_edges(const MuxNodeId& node) const {
+MuxGraph::node_edge_range MuxGraph::node_in_edges(const MuxNodeId& node) const {
   /* validate the node */
   VTR_ASSERT(valid_node_id(node));
-  return node_in_edges_[node];
+  return vtr::make_range(node_in_edges_[node].begin(), node_in_edges_[node].end());
 }
 
 /* Find the input nodes for a edge */
-std::vector<MuxNodeId> MuxGraph::edge_src_nodes(const MuxEdgeId& edge) const {
+MuxGraph::edge_node_range MuxGraph::edge_src_nodes(const MuxEdgeId& edge) const {
   /* validate the edge */
   VTR_ASSERT(valid_edge_id(edge));
-  return edge_src_nodes_[edge];
+  return vtr::make_range(edge_src_nodes_[edge].begin(), edge_src_nodes_[edge].end());
 }
 
 /* Find the mem that control the edge */
@@ -403,6 +403,7 @@ MuxGraph MuxGraph::subgraph(const MuxNodeId& root_node) const {
   /* Since the graph is finalized, it is time to build the fast look-up */
   mux_graph.build_node_lookup();
   mux_graph.build_mem_lookup();
+  mux_graph.build_decode_table();
 
   return mux_graph; 
 }
@@ -548,73 +549,24 @@ MuxNodeId MuxGraph::node_id(const size_t& node_level, const size_t& node_index_a
 /* Decode memory bits based on an input id and an output id */
 vtr::vector<MuxMemId, bool> MuxGraph::decode_memory_bits(const MuxInputId& input_id,
                                                          const MuxOutputId& output_id) const {
-  /* initialize the memory bits: TODO: support default value */ 
-  vtr::vector<MuxMemId, bool> mem_bits(mem_ids_.size(), false);
-
   /* valid the input and output */
   VTR_ASSERT_SAFE(valid_input_id(input_id));
   VTR_ASSERT_SAFE(valid_output_id(output_id));
 
-  /* Mark all the nodes as not visited */
-  vtr::vector<MuxNodeId, bool> visited(nodes().size(), false); 
-
-  /* Create a queue for Breadth-First Search */ 
-  std::list<MuxNodeId> queue; 
-
-  /* Mark the input node as visited and enqueue it */
-  visited[node_id(input_id)] = true; 
-  queue.push_back(node_id(input_id)); 
-
-  /* Create a flag to indicate if the route is success or not */
-  bool route_success = false;
+  /* The decode table must have been built */
+  VTR_ASSERT(nullptr != decode_table_);
+  size_t route_index = size_t(input_id) * num_outputs() + size_t(output_id);
 
-  while(!queue.empty()) { 
-    /* Dequeue a mux node from queue, 
-     * we will walk through all the fan-in of this node in this loop
-     */
-    MuxNodeId node_to_expand = queue.front(); 
-    queue.pop_front(); 
-                                                                                                               /* Get all fan-in nodes of the dequeued node
-     * If the node has not been visited,  
-     * then mark it visited and enqueue it
-     */
-    VTR_ASSERT_SAFE (1 == node_out_edges_[node_to_expand].size());
-    MuxEdgeId edge = node_out_edges_[node_to_expand][0];
-
-    /* Configure the mem bits: 
-     * if inv_mem is enabled, it means 0 to enable this edge 
-     * otherwise, it is 1 to enable this edge
-     */
-    MuxMemId mem = edge_mem_ids_[edge];
-    VTR_ASSERT_SAFE (valid_mem_id(mem));
-    if (true == edge_inv_mem_[edge]) {
-      mem_bits[mem] = false;
-    } else {
-      mem_bits[mem] = true;
-    }
-
-    /* each edge must have 1 fan-out */
-    VTR_ASSERT_SAFE (1 == edge_sink_nodes_[edge].size());
-
-    /* Get the fan-out node */
-    MuxNodeId next_node = edge_sink_nodes_[edge][0]; 
-
-    /* If next node is the output node we want, we can finish here */
-    if (next_node == node_id(output_id)) {
-      route_success = true;
-      break;
-    }
+  /* Routing must be success! */
+  VTR_ASSERT(true == decode_table_->routable[route_index]);
 
-    /* Add next node to the queue if not visited yet */
-    if (false == visited[next_node]) { 
-       visited[next_node] = true; 
-       queue.push_back(next_node); 
-    }
+  /* Unpack the memory bits: TODO: support default value */ 
+  vtr::vector<MuxMemId, bool> mem_bits(mem_ids_.size(), false);
+  const uint64_t* words = decode_table_->words.data() + route_index * decode_table_->num_words;
+  for (const MuxMemId& mem : memories()) {
+    mem_bits[mem] = (0 != (words[size_t(mem) / 64] & (uint64_t(1) << (size_t(mem) % 64))));
   }
 
-  /* Routing must be success! */
-  VTR_ASSERT(true == route_success);
-
   return mem_bits;
 }
 
@@ -695,6 +647,29 @@ MuxInputId MuxGraph::find_input_node_driven_by_output_node(const std::map<MuxMem
   return des_input_id;
 }
 
+/**************************************************
+ * Public mutators
+ *************************************************/
+/* Share the decode table of another graph if the two tables are the same */
+bool MuxGraph::share_decode_table(const MuxGraph& other) {
+  VTR_ASSERT((nullptr != decode_table_) && (nullptr != other.decode_table_));
+
+  if (decode_table_ == other.decode_table_) {
+    return true;
+  }
+
+  if ( (num_inputs() != other.num_inputs())
+    || (num_outputs() != other.num_outputs())
+    || (decode_table_->num_words != other.decode_table_->num_words)
+    || (decode_table_->routable != other.decode_table_->routable)
+    || (decode_table_->words != other.decode_table_->words) ) {
+    return false;
+  }
+
+  decode_table_ = other.decode_table_;
+  return true;
+}
+
 /**************************************************
  * Private mutators: basic operations 
  *************************************************/
@@ -1107,6 +1082,9 @@ void MuxGraph::build_mux_graph(const CircuitLibrary& circuit_lib,
     && (true == circuit_lib.is_lut_fracturable(circuit_model)) ) {
     add_fracturable_outputs(circuit_lib, circuit_model);
   }
+
+  /* Outputs are finalized, the memory bits of each route can be decoded now */
+  build_decode_table();
 }
 
 /* Build fast node lookup */
@@ -1152,6 +1130,60 @@ void MuxGraph::build_mem_lookup() {
   }
 }
 
+/* Build the decode table for all the pairs of inputs and outputs
+ * Each node has only one fan-out, so the route from an input is a single path,
+ * along which the memory bits to reach each output are recorded
+ */
+void MuxGraph::build_decode_table() {
+  std::shared_ptr<DecodeTable> decode_table = std::make_shared<DecodeTable>();
+
+  size_t num_input_nodes = num_inputs();
+  size_t num_output_nodes = num_outputs();
+  decode_table->num_words = (mem_ids_.size() + 63) / 64;
+  decode_table->words.assign(num_input_nodes * num_output_nodes * decode_table->num_words, 0);
+  decode_table->routable.assign(num_input_nodes * num_output_nodes, false);
+
+  /* Memory bits configured along the path, which are all reset at the end of each path */
+  std::vector<uint64_t> path_words(decode_table->num_words, 0);
+
+  for (size_t input = 0; input < num_input_nodes; ++input) {
+    std::fill(path_words.begin(), path_words.end(), 0);
+
+    MuxNodeId node_to_expand = node_id(MuxInputId(input));
+    while (false == node_out_edges_[node_to_expand].empty()) {
+      VTR_ASSERT_SAFE (1 == node_out_edges_[node_to_expand].size());
+      MuxEdgeId edge = node_out_edges_[node_to_expand][0];
+
+      /* Configure the mem bits: 
+       * if inv_mem is enabled, it means 0 to enable this edge 
+       * otherwise, it is 1 to enable this edge
+       */
+      MuxMemId mem = edge_mem_ids_[edge];
+      VTR_ASSERT_SAFE (valid_mem_id(mem));
+      uint64_t mem_mask = uint64_t(1) << (size_t(mem) % 64);
+      if (true == edge_inv_mem_[edge]) {
+        path_words[size_t(mem) / 64] &= ~mem_mask;
+      } else {
+        path_words[size_t(mem) / 64] |= mem_mask;
+      }
+
+      /* each edge must have 1 fan-out */
+      VTR_ASSERT_SAFE (1 == edge_sink_nodes_[edge].size());
+      node_to_expand = edge_sink_nodes_[edge][0]; 
+
+      /* Record the memory bits when an output is reached */
+      if (true == is_node_output(node_to_expand)) {
+        size_t route_index = input * num_output_nodes + size_t(output_id(node_to_expand));
+        std::copy(path_words.begin(), path_words.end(),
+                  decode_table->words.begin() + route_index * decode_table->num_words);
+        decode_table->routable[route_index] = true;
+      }
+    }
+  }
+
+  decode_table_ = decode_table;
+}
+
 /* Invalidate (empty) the node fast lookup*/
 void MuxGraph::invalidate_node_lookup() {
   node_lookup_.clear();
@@ -4,9 +4,12 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
+#include <cstdint>
 #include <map>
+#include <memory>
 #include "vtr_vector.h"
 #include "vtr_range.h"
+#include "vtr_small_vector.h"
 #include "mux_graph_fwd.h"
 #include "circuit_library.h"
 
@@ -54,6 +57,10 @@ class MuxGraph {
     typedef vtr::Range<node_iterator> node_range;
     typedef vtr::Range<edge_iterator> edge_range;
     typedef vtr::Range<mem_iterator> mem_range;
+
+    /* Ranges of the nodes of an edge and of the edges of a node, which refer to the graph */
+    typedef vtr::Range<const MuxNodeId*> edge_node_range;
+    typedef vtr::Range<const MuxEdgeId*> node_edge_range;
   public: /* Public Constructors */
     /* Create an object based on a Circuit Model which is MUX */
     MuxGraph(const CircuitLibrary& circuit_lib, 
@@ -97,9 +104,9 @@ class MuxGraph {
     /* Find the index of a node at its level */
     size_t node_index_at_level(const MuxNodeId& node) const;
     /* Find the input edges for a node */
-    std::vector<MuxEdgeId> node_in_edges(const MuxNodeId& node) const;
+    node_edge_range node_in_edges(const MuxNodeId& node) const;
     /* Find the input nodes for a edge */
-    std::vector<MuxNodeId> edge_src_nodes(const MuxEdgeId& edge) const;
+    edge_node_range edge_src_nodes(const MuxEdgeId& edge) const;
     /* Find the mem that control the edge */
     MuxMemId find_edge_mem(const MuxEdgeId& edge) const;
     /* Identify if the edge is controlled by the inverted output of a mem */
@@ -126,8 +133,8 @@ class MuxGraph {
     /* Identify if the node is an output of the MUX */
     bool is_node_output(const MuxNodeId& node_id) const;
     /* Decode memory bits based on an input id and an output id 
-     * This function will start from the input node 
-     * and do a forward propagation until reaching the output node  
+     * The memory bits are looked up from the decode table,
+     * which is built when the graph is finalized
      */
     vtr::vector<MuxMemId, bool> decode_memory_bits(const MuxInputId& input_id,
                                                    const MuxOutputId& output_id) const;
@@ -138,6 +145,12 @@ class MuxGraph {
      */
     MuxInputId find_input_node_driven_by_output_node(const std::map<MuxMemId, bool>& memory_bits,
                                                      const MuxOutputId& output_id) const;
+  public: /* Public mutators */
+    /* Share the decode table of another graph if the two tables are the same,
+     * so that graphs of identical structures only keep one copy of the table
+     * Return true if the table is shared
+     */
+    bool share_decode_table(const MuxGraph& other);
   private: /* Private mutators : basic operations */
      /* Add a unconfigured node to the MuxGraph */
      MuxNodeId add_node(const enum e_mux_graph_node_type& node_type);
@@ -167,6 +180,11 @@ class MuxGraph {
     void build_node_lookup();
     /* Build fast mem lookup */
     void build_mem_lookup();
+    /* Build the decode table for all the pairs of inputs and outputs
+     * This function will start from each input node 
+     * and do a forward propagation until reaching the last output node  
+     */
+    void build_decode_table();
   private: /* Private validators */
     /* valid ids */
     bool valid_node_id(const MuxNodeId& node) const;
@@ -188,12 +206,15 @@ class MuxGraph {
     vtr::vector<MuxNodeId, MuxOutputId> node_output_ids_;                 /* Unique ids for each node as an input of the MUX */
     vtr::vector<MuxNodeId, size_t> node_levels_;                       /* at which level, each node belongs to */
     vtr::vector<MuxNodeId, size_t> node_ids_at_level_;                       /* the index at the level that each node belongs to */
-    vtr::vector<MuxNodeId, std::vector<MuxEdgeId>> node_in_edges_;       /* ids of incoming edges to each node */
-    vtr::vector<MuxNodeId, std::vector<MuxEdgeId>> node_out_edges_;      /* ids of outgoing edges from each node */
+    /* Most nodes have a few edges and each edge has a single source and sink,
+     * so the lists are stored in place rather than in separated heap allocations
+     */
+    vtr::vector<MuxNodeId, vtr::small_vector<MuxEdgeId>> node_in_edges_;       /* ids of incoming edges to each node */
+    vtr::vector<MuxNodeId, vtr::small_vector<MuxEdgeId>> node_out_edges_;      /* ids of outgoing edges from each node */
 
     vtr::vector<MuxEdgeId, MuxEdgeId> edge_ids_;                        /* Unique ids for each edge */
-    vtr::vector<MuxEdgeId, std::vector<MuxNodeId>> edge_src_nodes_;     /* source nodes drive this edge */
-    vtr::vector<MuxEdgeId, std::vector<MuxNodeId>> edge_sink_nodes_;    /* sink nodes this edge drives */
+    vtr::vector<MuxEdgeId, vtr::small_vector<MuxNodeId>> edge_src_nodes_;     /* source nodes drive this edge */
+    vtr::vector<MuxEdgeId, vtr::small_vector<MuxNodeId>> edge_sink_nodes_;    /* sink nodes this edge drives */
     vtr::vector<MuxEdgeId, CircuitModelId> edge_models_; /* type of each edge: tgate/pass-gate */
     vtr::vector<MuxEdgeId, MuxMemId> edge_mem_ids_;                   /* ids of memory bit that control the edge */
     vtr::vector<MuxEdgeId, bool> edge_inv_mem_;                       /* if the edge is controlled by an inverted output of a memory bit */
@@ -206,6 +227,16 @@ class MuxGraph {
     mutable NodeLookup node_lookup_; /* [num_levels][num_types][num_nodes_per_level] */ 
     typedef std::vector<std::vector<MuxMemId>> MemLookup;
     mutable MemLookup mem_lookup_; /* [num_levels][num_mems_per_level] */ 
+
+    /* Decode table: memory bits to route each input to each output,
+     * packed in 64-bit words, which may be shared with other graphs
+     */
+    struct DecodeTable {
+      size_t num_words;            /* number of words to pack the memory bits of a route */
+      std::vector<uint64_t> words; /* [num_inputs][num_outputs][num_words] */
+      std::vector<bool> routable;  /* [num_inputs][num_outputs] */
+    };
+    std::shared_ptr<const DecodeTable> decode_table_;
 };
 
 } /* End namespace openfpga*/
@@ -3,7 +3,12 @@
  * data structures in mux_library.h
  *************************************************/
 
+#include <memory>
+#include <set>
+#include <utility>
+
 #include "vtr_assert.h"
+#include "vtr_parallel.h"
 
 #include "mux_library.h"
 
@@ -32,7 +37,8 @@ MuxId MuxLibrary::mux_graph(const CircuitModelId& circuit_model,
   /* Validate circuit model id and mux_size */
   VTR_ASSERT_SAFE(valid_mux_size(circuit_model, mux_size));
 
-  return mux_lookup_[circuit_model][mux_size];
+  /* Use a read-only look-up, so that the library can be shared by threads */
+  return mux_lookup_.at(circuit_model).at(mux_size);
 }
 
 const MuxGraph& MuxLibrary::mux_graph(const MuxId& mux_id) const {
@@ -66,12 +72,49 @@ void MuxLibrary::add_mux(const CircuitLibrary& circuit_lib, const CircuitModelId
     return;
   }
 
+  add_mux_graph(circuit_model, mux_size, MuxGraph(circuit_lib, circuit_model, mux_size));
+} 
+
+void MuxLibrary::add_muxes(const CircuitLibrary& circuit_lib,
+                           const std::vector<std::pair<CircuitModelId, size_t>>& muxes,
+                           const size_t& num_threads) {
+  /* Find the muxes which are not in the library yet, without duplicates */
+  std::vector<std::pair<CircuitModelId, size_t>> new_muxes;
+  std::set<std::pair<CircuitModelId, size_t>> new_mux_set;
+  for (const auto& mux : muxes) {
+    if ( (false == valid_mux_size(mux.first, mux.second))
+      && (true == new_mux_set.insert(mux).second) ) {
+      new_muxes.push_back(mux);
+    }
+  }
+
+  std::vector<std::unique_ptr<MuxGraph>> new_mux_graphs(new_muxes.size());
+  vtr::parallel_for(new_muxes.size(), num_threads, [&](const size_t& imux) {
+    new_mux_graphs[imux].reset(new MuxGraph(circuit_lib, new_muxes[imux].first, new_muxes[imux].second));
+  });
+
+  /* The decode tables are shared in the order of the muxes, as by add_mux() */
+  for (size_t imux = 0; imux < new_muxes.size(); ++imux) {
+    add_mux_graph(new_muxes[imux].first, new_muxes[imux].second, std::move(*new_mux_graphs[imux]));
+  }
+}
+
+void MuxLibrary::add_mux_graph(const CircuitModelId& circuit_model, const size_t& mux_size, MuxGraph&& mux_graph) {
   /* create a new id for the mux */
   MuxId mux = MuxId(mux_ids_.size());
   /* Push to the node list */
   mux_ids_.push_back(mux);
   /* Add a mux graph */
-  mux_graphs_.push_back(MuxGraph(circuit_lib, circuit_model, mux_size));
+  mux_graphs_.push_back(std::move(mux_graph));
+  /* Graphs of the same size usually share the same decode table, e.g., 
+   * same multiplexer structure used by different circuit models 
+   */
+  for (const MuxId& other_mux : mux_ids_) {
+    if ( (other_mux != mux)
+      && (true == mux_graphs_[mux].share_decode_table(mux_graphs_[other_mux])) ) {
+      break;
+    }
+  }
   /* Recorde mux cirucit model id */
   mux_circuit_models_.push_back(circuit_model);
 
@@ -99,8 +142,8 @@ bool MuxLibrary::valid_mux_size(const CircuitModelId& circuit_model, const size_
   if (false == valid_mux_circuit_model_id(circuit_model)) {
     return false;
   }
-  std::map<size_t, MuxId>::iterator it = mux_lookup_[circuit_model].find(mux_size);
-  return (it != mux_lookup_[circuit_model].end());
+  const std::map<size_t, MuxId>& mux_sizes = mux_lookup_.at(circuit_model);
+  return (mux_sizes.find(mux_size) != mux_sizes.end());
 }
 
 /**************************************************
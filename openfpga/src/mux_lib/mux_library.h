@@ -11,6 +11,8 @@
 #define MUX_LIBRARY_H
 
 #include <map>
+#include <utility>
+#include <vector>
 #include "mux_graph.h"
 #include "mux_library_fwd.h"
 
@@ -35,12 +37,20 @@ class MuxLibrary {
   public:  /* Public mutators */
     /* Add a mux to the library */
     void add_mux(const CircuitLibrary& circuit_lib, const CircuitModelId& circuit_model, const size_t& mux_size); 
+    /* Add a list of muxes to the library, in the order of the list.
+     * The graphs of the new muxes are independent, and are built in parallel
+     */
+    void add_muxes(const CircuitLibrary& circuit_lib,
+                   const std::vector<std::pair<CircuitModelId, size_t>>& muxes,
+                   const size_t& num_threads);
   public:  /* Public validators */
     bool valid_mux_id(const MuxId& mux) const;
   private:  /* Private accessors */
     bool valid_mux_lookup() const;
     bool valid_mux_circuit_model_id(const CircuitModelId& circuit_model) const;
     bool valid_mux_size(const CircuitModelId& circuit_model, const size_t& mux_size) const;
+  private:  /* Private mutators */
+    void add_mux_graph(const CircuitModelId& circuit_model, const size_t& mux_size, MuxGraph&& mux_graph);
   private:  /* Private mutators: mux_lookup */
     void build_mux_lookup();
     /* Invalidate (empty) the mux fast lookup*/
@@ -1,12 +1,17 @@
 /********************************************************************
  * This file includes the functions of builders for MuxLibrary.
  *******************************************************************/
+#include <algorithm>
 #include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
+#include "vtr_parallel.h"
 
 /* Headers from readarchopenfpga library */
 #include "circuit_types.h"
@@ -23,53 +28,104 @@
 /* Begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * The routing multiplexers found in a range of rr_nodes
+ * - the position of the first rr_node of each unique multiplexer
+ *   (circuit model and size) in the range
+ * - the first rr_node whose switch has no circuit model, if any
+ *******************************************************************/
+struct t_routing_mux_histogram {
+  std::map<std::pair<CircuitModelId, size_t>, size_t> first_nodes;
+  size_t first_invalid_node = size_t(-1);
+};
+
 /********************************************************************
  * Update MuxLibrary with the unique multiplexer structures
  * found in the global routing architecture
+ *
+ * The rr_nodes are visited in chunks by parallel workers, 
+ * and the unique multiplexers of the chunks are merged in the order
+ * of the rr_nodes, so that the library does not depend on the number of threads
  *******************************************************************/
 static 
 void build_routing_arch_mux_library(const DeviceContext& vpr_device_ctx,
                                     const CircuitLibrary& circuit_lib,
                                     const VprDeviceAnnotation& vpr_device_annotation, 
+                                    const size_t& num_threads,
                                     MuxLibrary& mux_lib) {
   /* The routing path is. 
    * OPIN ----> CHAN ----> ... ----> CHAN ----> IPIN
    * Each edge is a switch, for IPIN, the switch is a connection block,
    * for the rest is a switch box
    */
+  const RRGraph& rr_graph = vpr_device_ctx.rr_graph;
+  std::vector<RRNodeId> nodes(rr_graph.nodes().begin(), rr_graph.nodes().end());
+
   /* Count the sizes of muliplexers in routing architecture */  
-  for (const RRNodeId& node : vpr_device_ctx.rr_graph.nodes()) {
-    switch (vpr_device_ctx.rr_graph.node_type(node)) {
-    case IPIN: 
-    case CHANX:
-    case CHANY: {
-      /* Have to consider the fan_in only, it is a connection block (multiplexer)*/
-      if ( (0 == vpr_device_ctx.rr_graph.node_in_edges(node).size()) 
-        || (1 == vpr_device_ctx.rr_graph.node_in_edges(node).size()) ) { 
-        break; 
+  constexpr size_t CHUNK_SIZE = 65536;
+  const size_t num_chunks = (nodes.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  std::vector<t_routing_mux_histogram> chunk_histograms(num_chunks);
+  vtr::parallel_for(num_chunks, num_threads, [&](const size_t& chunk) {
+    t_routing_mux_histogram& histogram = chunk_histograms[chunk];
+    for (size_t inode = chunk * CHUNK_SIZE; inode < std::min(nodes.size(), (chunk + 1) * CHUNK_SIZE); ++inode) {
+      const RRNodeId& node = nodes[inode];
+      switch (rr_graph.node_type(node)) {
+      case IPIN: 
+      case CHANX:
+      case CHANY: {
+        /* Have to consider the fan_in only, it is a connection block (multiplexer)*/
+        size_t mux_size = rr_graph.node_in_edges(node).size();
+        if ( (0 == mux_size) || (1 == mux_size) ) { 
+          break; 
+        }
+        /* Find the circuit_model for multiplexers in connection blocks */
+        std::vector<RRSwitchId> driver_switches = get_rr_graph_driver_switches(rr_graph, node);
+        VTR_ASSERT(1 == driver_switches.size());
+        const CircuitModelId& rr_switch_circuit_model = vpr_device_annotation.rr_switch_circuit_model(driver_switches[0]);
+        /* we should select a circuit model for the routing resource switch */
+        if (CircuitModelId::INVALID() == rr_switch_circuit_model) {
+          histogram.first_invalid_node = std::min(histogram.first_invalid_node, inode);
+          break;
+        }
+        /* Record the mux, which is added to mux_library later */
+        histogram.first_nodes.insert(std::make_pair(std::make_pair(rr_switch_circuit_model, mux_size), inode));
+        break;
       }
-      /* Find the circuit_model for multiplexers in connection blocks */
-      std::vector<RRSwitchId> driver_switches = get_rr_graph_driver_switches(vpr_device_ctx.rr_graph, node);
-      VTR_ASSERT(1 == driver_switches.size());
-      const CircuitModelId& rr_switch_circuit_model = vpr_device_annotation.rr_switch_circuit_model(driver_switches[0]);
-      /* we should select a circuit model for the routing resource switch */
-      if (CircuitModelId::INVALID() == rr_switch_circuit_model) {
-        VTR_LOG_ERROR("Unable to find the circuit mode for rr_switch '%s'!\n",
-                      vpr_device_ctx.rr_graph.get_switch(driver_switches[0]).name);
-        vpr_device_ctx.rr_graph.print_node(node);
-        exit(1);
+      default:
+        /* We do not care other types of rr_node */
+        break;
       }
-     
-      VTR_ASSERT(CircuitModelId::INVALID() != rr_switch_circuit_model);
-      /* Add the mux to mux_library */
-      mux_lib.add_mux(circuit_lib, rr_switch_circuit_model, vpr_device_ctx.rr_graph.node_in_edges(node).size()); 
-      break;
     }
-    default:
-      /* We do not care other types of rr_node */
-      break;
+  });
+
+  /* Merge the chunks: the chunks are in the order of the rr_nodes, 
+   * so the first chunk containing a multiplexer has its first rr_node
+   */
+  std::map<std::pair<CircuitModelId, size_t>, size_t> first_nodes;
+  for (const t_routing_mux_histogram& histogram : chunk_histograms) {
+    if (size_t(-1) != histogram.first_invalid_node) {
+      const RRNodeId& node = nodes[histogram.first_invalid_node];
+      std::vector<RRSwitchId> driver_switches = get_rr_graph_driver_switches(rr_graph, node);
+      VTR_LOG_ERROR("Unable to find the circuit mode for rr_switch '%s'!\n",
+                    rr_graph.get_switch(driver_switches[0]).name);
+      rr_graph.print_node(node);
+      exit(1);
     }
+    first_nodes.insert(histogram.first_nodes.begin(), histogram.first_nodes.end());
+  }
+
+  /* Add the muxes to mux_library in the order they are found in the rr_nodes */
+  std::vector<std::pair<size_t, std::pair<CircuitModelId, size_t>>> muxes_by_node;
+  for (const auto& mux : first_nodes) {
+    muxes_by_node.push_back(std::make_pair(mux.second, mux.first));
+  }
+  std::sort(muxes_by_node.begin(), muxes_by_node.end());
+
+  std::vector<std::pair<CircuitModelId, size_t>> muxes;
+  for (const auto& mux : muxes_by_node) {
+    muxes.push_back(mux.second);
   }
+  mux_lib.add_muxes(circuit_lib, muxes, num_threads);
 }
 
 
@@ -198,7 +254,8 @@ void build_lut_mux_library(MuxLibrary& mux_lib,
  * All the statistics are stored in a linked list, as a return value
  */
 MuxLibrary build_device_mux_library(const DeviceContext& vpr_device_ctx,
-                                    const OpenfpgaContext& openfpga_ctx) {
+                                    const OpenfpgaContext& openfpga_ctx,
+                                    const size_t& num_threads) {
   vtr::ScopedStartFinishTimer timer("Build a library of physical multiplexers");
 
   /* MuxLibrary to store the information of Multiplexers*/
@@ -207,6 +264,7 @@ MuxLibrary build_device_mux_library(const DeviceContext& vpr_device_ctx,
   /* Step 1: We should check the multiplexer spice models defined in routing architecture.*/
   build_routing_arch_mux_library(vpr_device_ctx, openfpga_ctx.arch().circuit_lib, 
                                  openfpga_ctx.vpr_device_annotation(),
+                                 num_threads,
                                  mux_lib);
 
   /* Step 2: Count the sizes of multiplexers in complex logic blocks */  
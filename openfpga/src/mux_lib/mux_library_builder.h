@@ -16,7 +16,8 @@
 namespace openfpga {
 
 MuxLibrary build_device_mux_library(const DeviceContext& vpr_device_ctx,
-                                    const OpenfpgaContext& openfpga_ctx);
+                                    const OpenfpgaContext& openfpga_ctx,
+                                    const size_t& num_threads);
 
 } /* end namespace openfpga */
 
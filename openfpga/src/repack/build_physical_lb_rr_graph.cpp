@@ -2,11 +2,19 @@
  * This file includes functions that are used to redo packing for physical pbs
  ***************************************************************************************/
 
+#include <algorithm>
+#include <map>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_log.h"
+#include "vtr_parallel.h"
 #include "vtr_assert.h"
 #include "vtr_time.h"
 
+#include "lb_type_rr_graph.h"
+#include "pack_types.h"
+
 #include "pb_type_utils.h"
 
 #include "build_physical_lb_rr_graph.h"
@@ -16,352 +24,173 @@
 namespace openfpga {
 
 /***************************************************************************************
- * Create all the intermediate nodes for lb_rr_graph for each pb_graph_node.
- * Different from the lb_rr_graph builder in VPR packer, this function only consider 
- * the pb_graph_node under physical modes
+ * Identify if a pb_graph_node is part of the physical implementation of its logical tile,
+ * i.e., all its parents are in their physical modes and none of them is a primitive
+ * (a LUT or a memory has CAD-only modes in VPR, which OpenFPGA does not consider)
  ***************************************************************************************/
 static 
-void rec_build_physical_lb_rr_node_for_pb_graph_node(t_pb_graph_node* pb_graph_node,
-                                                     LbRRGraph& lb_rr_graph,
-                                                     const VprDeviceAnnotation& device_annotation) {
-  t_pb_type* pb_type = pb_graph_node->pb_type;
-
-  /* TODO: think if we need to consider wire mode of LUT when creating the lb_rr_graph here! 
-   * Should we create edges through the LUT input and output nodes?
-   */
-
-  /* The only difference between primitive node and intermediate nodes is
-   * the output pins of primitive node will be SINK node
-   * Otherwise it is always INTERMEDIATE node
-   */
-  e_lb_rr_type output_pin_rr_type = LB_INTERMEDIATE;
-  if (true == is_primitive_pb_type(pb_type)) {
-    output_pin_rr_type = LB_SOURCE; 
-  }
-
-  /* alloc and load input pins that connect to sinks */
-  for (int iport = 0; iport < pb_graph_node->num_input_ports; iport++) {
-    for (int ipin = 0; ipin < pb_graph_node->num_input_pins[iport]; ipin++) {
-      /* load intermediate indices */
-      t_pb_graph_pin* pb_pin = &pb_graph_node->input_pins[iport][ipin];
-
-      /* alloc and load rr node info */
-      LbRRNodeId node = lb_rr_graph.create_node(LB_INTERMEDIATE);
-      lb_rr_graph.set_node_capacity(node, 1);
-      lb_rr_graph.set_node_pb_graph_pin(node, pb_pin);
-
-      /* TODO: Double check if this is the case */
-      lb_rr_graph.set_node_intrinsic_cost(node, 1);
-    }
-  }
-
-  /* alloc and load input pins that connect to sinks */
-  for (int iport = 0; iport < pb_graph_node->num_clock_ports; iport++) {
-    for (int ipin = 0; ipin < pb_graph_node->num_clock_pins[iport]; ipin++) {
-      /* load intermediate indices */
-      t_pb_graph_pin* pb_pin = &pb_graph_node->clock_pins[iport][ipin];
-
-      /* alloc and load rr node info */
-      LbRRNodeId node = lb_rr_graph.create_node(LB_INTERMEDIATE);
-      lb_rr_graph.set_node_capacity(node, 1);
-      lb_rr_graph.set_node_pb_graph_pin(node, pb_pin);
-
-      /* TODO: Double check if this is the case */
-      lb_rr_graph.set_node_intrinsic_cost(node, 1);
+bool is_physical_pb_graph_node(const t_pb_graph_node* pb_graph_node,
+                               const VprDeviceAnnotation& device_annotation) {
+  for (const t_pb_graph_node* node = pb_graph_node; false == node->is_root(); node = node->parent_pb_graph_node) {
+    t_pb_type* parent_pb_type = node->parent_pb_graph_node->pb_type;
+    if (true == is_primitive_pb_type(parent_pb_type)) {
+      return false;
     }
-  }
-
-  /* alloc and load output pins that are represented as rr sources */
-  for (int iport = 0; iport < pb_graph_node->num_output_ports; iport++) {
-    for (int ipin = 0; ipin < pb_graph_node->num_output_pins[iport]; ipin++) {
-      /* load intermediate indices */
-      t_pb_graph_pin* pb_pin = &pb_graph_node->output_pins[iport][ipin];
-
-      /* alloc and load rr node info */
-      LbRRNodeId node = lb_rr_graph.create_node(output_pin_rr_type);
-      lb_rr_graph.set_node_capacity(node, 1);
-      lb_rr_graph.set_node_pb_graph_pin(node, pb_pin);
-
-      /* TODO: Double check if this is the case */
-      lb_rr_graph.set_node_intrinsic_cost(node, 1);
-    }
-  }
-
-  if (true == is_primitive_pb_type(pb_type)) {
-    return; 
-  }
-
-  /* For non-primitive node: 
-   * This pb_graph_node is a logic block or subcluster 
-   * Go recusrively 
-   */
-  t_mode* physical_mode = device_annotation.physical_mode(pb_type);
-  for (int ipb_type = 0; ipb_type < physical_mode->num_pb_type_children; ipb_type++) {
-    for (int ipb = 0; ipb < physical_mode->pb_type_children[ipb_type].num_pb; ipb++) {
-      rec_build_physical_lb_rr_node_for_pb_graph_node(&(pb_graph_node->child_pb_graph_nodes[physical_mode->index][ipb_type][ipb]), lb_rr_graph, device_annotation);
+    if (node->pb_type->parent_mode != device_annotation.physical_mode(parent_pb_type)) {
+      return false;
     }
   }
+  return true;
 }
 
 /***************************************************************************************
- * Build the edge for an input/clock pb_graph_pin for a primitive pb_graph node
- * This function will identify if the port equivalence should be considered 
+ * Find the physical mode of the interconnects driven by a pb_graph_pin, i.e., the mode
+ * whose out-going edges of the pin should be kept in the physical lb_rr_graph.
+ * Return nullptr for the output pins of the root pb_graph node, which only drive
+ * the external interconnect
+ * Note: this function is NOT applicable to input pins of a primitive pb_graph node 
  ***************************************************************************************/
 static 
-void build_lb_rr_edge_primitive_pb_graph_input_pin(LbRRGraph& lb_rr_graph,
-                                                   t_pb_graph_pin* pb_pin,
-                                                   LbRRNodeId& sink_node) {
-  /* Find the node that we have already created */
-  LbRRNodeId node = lb_rr_graph.find_node(LB_INTERMEDIATE, pb_pin);
-  VTR_ASSERT(true == lb_rr_graph.valid_node_id(node));
-
-  PortEquivalence port_equivalent = pb_pin->port->equivalent;
-
-  if (port_equivalent == PortEquivalence::NONE || sink_node == LbRRNodeId::INVALID()) {
-    /* Create new sink for input to primitive */
-    LbRRNodeId new_sink = lb_rr_graph.create_node(LB_SINK);
-    if (port_equivalent != PortEquivalence::NONE) {
-      lb_rr_graph.set_node_capacity(new_sink, pb_pin->port->num_pins);
-    } else {
-      lb_rr_graph.set_node_capacity(new_sink, 1);
-    }
-    sink_node = new_sink;
+t_mode* find_pb_graph_pin_physical_mode(const t_pb_graph_pin* pb_pin,
+                                        const VprDeviceAnnotation& device_annotation) {
+  const t_pb_graph_node* pb_graph_node = pb_pin->parent_node;
+  if (OUT_PORT != pb_pin->port->type) {
+    /* Input and clock pins drive the interconnects inside the pb_graph node */
+    VTR_ASSERT(false == is_primitive_pb_type(pb_graph_node->pb_type));
+    return device_annotation.physical_mode(pb_graph_node->pb_type);
   }
-  
-  /* Connect the nodes denoting the input pins to sink, since this is a primtive node, we do not have any mode */ 
-  LbRREdgeId edge = lb_rr_graph.create_edge(node, sink_node, nullptr);
-
-  /* TODO: Double check if this is the case */
-  lb_rr_graph.set_edge_intrinsic_cost(edge, 1.); 
-}
-
-/***************************************************************************************
- * Build the edge for a pb_graph_pin for a non-primitive pb_graph node
- * Note: 
- *   - this function is NOT applicable to 
- *     - any input pin of primitive pb_graph_node 
- *     - any output pin of root pb_graph_node!
- ***************************************************************************************/
-static 
-void build_lb_rr_edge_pb_graph_pin(LbRRGraph& lb_rr_graph,
-                                   t_pb_graph_pin* pb_pin,
-                                   const e_lb_rr_type& pin_rr_type,
-                                   t_mode* physical_mode) {
-  /* Find the node that we have already created */
-  LbRRNodeId from_node = lb_rr_graph.find_node(pin_rr_type, pb_pin);
-  VTR_ASSERT(true == lb_rr_graph.valid_node_id(from_node));
-
-  /* Load edges only for physical mode! */
-  for (int iedge = 0; iedge < pb_pin->num_output_edges; iedge++) {
-    VTR_ASSERT(1 == pb_pin->output_edges[iedge]->num_output_pins);
-    if (physical_mode != pb_pin->output_edges[iedge]->interconnect->parent_mode) {
-      continue;
-    }
-    /* Find the node that we have already created */
-    LbRRNodeId to_node = lb_rr_graph.find_node(LB_INTERMEDIATE, pb_pin->output_edges[iedge]->output_pins[0]);
-    VTR_ASSERT(true == lb_rr_graph.valid_node_id(to_node));
-    LbRREdgeId edge = lb_rr_graph.create_edge(from_node, to_node, physical_mode);
-
-    /* TODO: Double check if this is the case */
-    lb_rr_graph.set_edge_intrinsic_cost(edge, 1.); 
+  if (true == pb_graph_node->is_root()) {
+    return nullptr;
   }
+  /* Output pins drive the interconnects of the parent pb_graph node */
+  return device_annotation.physical_mode(pb_graph_node->parent_pb_graph_node->pb_type);
 }
 
 /***************************************************************************************
- * Build the edge for an output pb_graph_pin for a root pb_graph node
- * These node should be connected to a command external lb_rr_node
+ * This function will create a physical lb_rr_graph for a logical tile considering physical modes only.
+ * Rather than walking through the pb_graph again, the nodes and edges are taken from 
+ * the lb_rr_graph that VPR built for the packer, which covers all the modes:
+ * - the nodes of the pb_graph_pins outside physical modes are skipped 
+ * - the out-going edges of each node are those of the physical mode it is in
+ *   (the physical-mode edge mask), found by the mode index of the packer's graph
+ * The only difference is that OpenFPGA considers a LUT or a memory as a primitive, 
+ * whose inputs are connected to SINK nodes and whose outputs are SOURCE nodes,
+ * while VPR models their CAD-only modes
  ***************************************************************************************/
 static 
-void build_lb_rr_edge_root_pb_graph_pin(LbRRGraph& lb_rr_graph,
-                                        t_pb_graph_pin* pb_pin,
-                                        const e_lb_rr_type& pin_rr_type,
-                                        const LbRRNodeId& ext_rr_index) {
-  /* Find the node that we have already created */
-  LbRRNodeId from_node = lb_rr_graph.find_node(pin_rr_type, pb_pin);
-  VTR_ASSERT(true == lb_rr_graph.valid_node_id(from_node));
-
-  LbRREdgeId edge = lb_rr_graph.create_edge(from_node, ext_rr_index, nullptr);
-
-  /* TODO: Double check if this is the case */
-  lb_rr_graph.set_edge_intrinsic_cost(edge, 1.); 
-}
+LbRRGraph build_lb_type_physical_lb_rr_graph(const t_logical_block_type& lb_type,
+                                             const std::vector<t_lb_type_rr_node>& lb_type_rr_graph,
+                                             const VprDeviceAnnotation& device_annotation,
+                                             const bool& verbose) {
+  LbRRGraph lb_rr_graph;
 
-/***************************************************************************************
- * Create all the edges and special nodes (SOURCE/SINK) for lb_rr_graph for each pb_graph_node.
- * Different from the lb_rr_graph builder in VPR packer, this function only consider 
- * the pb_graph_node under physical modes
- ***************************************************************************************/
-static 
-void rec_build_physical_lb_rr_edge_for_pb_graph_node(t_pb_graph_node* pb_graph_node,
-                                                     LbRRGraph& lb_rr_graph,
-                                                     const LbRRNodeId& ext_rr_index,
-                                                     const VprDeviceAnnotation& device_annotation) {
-  t_pb_type* pb_type = pb_graph_node->pb_type;
-  t_pb_graph_node* parent_node = pb_graph_node->parent_pb_graph_node;
-
-  /* TODO: think if we need to consider wire mode of LUT when creating the lb_rr_graph here! 
-   * Should we create edges through the LUT input and output nodes?
-   */
+  t_pb_graph_node* pb_graph_head = lb_type.pb_graph_head;
+  int ext_source_index = get_lb_type_rr_graph_ext_source_index(&lb_type);
+  int ext_sink_index = get_lb_type_rr_graph_ext_sink_index(&lb_type);
+  /* The external interconnect follows the external sink in the packer's graph */
+  int ext_rr_index = ext_sink_index + 1;
 
-  /* The only difference between primitive node and intermediate nodes is
-   * the output pins of primitive node will be SINK node
-   * Otherwise it is always INTERMEDIATE node
+  /* The node of the physical lb_rr_graph for each node of the packer's graph,
+   * invalid if the node is outside physical modes 
    */
-  /* The input pins should connect to sinks */
-  for (int iport = 0; iport < pb_graph_node->num_input_ports; iport++) {
-    LbRRNodeId sink_node = LbRRNodeId::INVALID();
-    for (int ipin = 0; ipin < pb_graph_node->num_input_pins[iport]; ipin++) {
-      /* load intermediate indices */
-      t_pb_graph_pin* pb_pin = &pb_graph_node->input_pins[iport][ipin];
-      t_mode* physical_mode = device_annotation.physical_mode(pb_type);
-
-      if (true == is_primitive_pb_type(pb_type)) {
-        build_lb_rr_edge_primitive_pb_graph_input_pin(lb_rr_graph, pb_pin, sink_node);
-      } else {
-        VTR_ASSERT(false == is_primitive_pb_type(pb_type));
-        build_lb_rr_edge_pb_graph_pin(lb_rr_graph, pb_pin, LB_INTERMEDIATE, physical_mode);
-      }
-    }
-  }
-  /* The input pins should connect to sinks */
-  for (int iport = 0; iport < pb_graph_node->num_clock_ports; iport++) {
-    LbRRNodeId sink_node = LbRRNodeId::INVALID();
-    for (int ipin = 0; ipin < pb_graph_node->num_clock_pins[iport]; ipin++) {
-      /* load intermediate indices */
-      t_pb_graph_pin* pb_pin = &pb_graph_node->clock_pins[iport][ipin];
-      t_mode* physical_mode = device_annotation.physical_mode(pb_type);
-
-      if (true == is_primitive_pb_type(pb_type)) {
-        build_lb_rr_edge_primitive_pb_graph_input_pin(lb_rr_graph, pb_pin, sink_node);
-      } else {
-        VTR_ASSERT(false == is_primitive_pb_type(pb_type));
-        build_lb_rr_edge_pb_graph_pin(lb_rr_graph, pb_pin, LB_INTERMEDIATE, physical_mode);
-      }
-    }
-  }
+  std::vector<LbRRNodeId> physical_nodes(lb_type_rr_graph.size(), LbRRNodeId::INVALID());
 
-  e_lb_rr_type output_pin_rr_type = LB_INTERMEDIATE;
-  if (true == is_primitive_pb_type(pb_type)) {
-    output_pin_rr_type = LB_SOURCE;
+  /* Define the external source, sink, and external interconnect for the routing resource graph of the logic block type */
+  physical_nodes[ext_source_index] = lb_rr_graph.create_node(LB_SOURCE); 
+  physical_nodes[ext_sink_index] = lb_rr_graph.create_node(LB_SINK); 
+  physical_nodes[ext_rr_index] = lb_rr_graph.create_node(LB_INTERMEDIATE); 
+  for (int inode : {ext_source_index, ext_sink_index, ext_rr_index}) {
+    lb_rr_graph.set_node_capacity(physical_nodes[inode], lb_type_rr_graph[inode].capacity);
   }
 
-  /* The output pins should connect to its fan-outs */
-  for (int iport = 0; iport < pb_graph_node->num_output_ports; iport++) {
-    for (int ipin = 0; ipin < pb_graph_node->num_output_pins[iport]; ipin++) {
-      /* load intermediate indices */
-      t_pb_graph_pin* pb_pin = &pb_graph_node->output_pins[iport][ipin];
-
-      if (true == pb_graph_node->is_root()) {
-        build_lb_rr_edge_root_pb_graph_pin(lb_rr_graph, pb_pin, output_pin_rr_type, ext_rr_index);
-      } else {
-        VTR_ASSERT(false == pb_graph_node->is_root());
-        t_mode* physical_mode = device_annotation.physical_mode(parent_node->pb_type);
-        build_lb_rr_edge_pb_graph_pin(lb_rr_graph, pb_pin, output_pin_rr_type, physical_mode);
-      }
+  /* Build all the regular nodes first, i.e., the pb_graph_pins under physical modes */
+  for (int inode = 0; inode < pb_graph_head->total_pb_pins; ++inode) {
+    t_pb_graph_pin* pb_pin = lb_type_rr_graph[inode].pb_graph_pin;
+    if (false == is_physical_pb_graph_node(pb_pin->parent_node, device_annotation)) {
+      continue;
     }
-  }
-
-  if (true == is_primitive_pb_type(pb_type)) {
-    return; 
-  }
 
-  /* For non-primitive node: 
-   * This pb_graph_node is a logic block or subcluster 
-   * Go recusrively 
-   */
-  t_mode* physical_mode = device_annotation.physical_mode(pb_graph_node->pb_type);
-  for (int ipb_type = 0; ipb_type < physical_mode->num_pb_type_children; ipb_type++) {
-    for (int ipb = 0; ipb < physical_mode->pb_type_children[ipb_type].num_pb; ipb++) {
-      rec_build_physical_lb_rr_edge_for_pb_graph_node(&(pb_graph_node->child_pb_graph_nodes[physical_mode->index][ipb_type][ipb]), lb_rr_graph, ext_rr_index, device_annotation);
+    /* The only difference between primitive node and intermediate nodes is
+     * the output pins of primitive node will be SOURCE node
+     * Otherwise it is always INTERMEDIATE node
+     */
+    e_lb_rr_type pin_rr_type = LB_INTERMEDIATE;
+    if ( (true == is_primitive_pb_type(pb_pin->parent_node->pb_type))
+      && (OUT_PORT == pb_pin->port->type) ) {
+      pin_rr_type = LB_SOURCE;
     }
-  }
-}
 
-/***************************************************************************************
- * This functio will create a physical lb_rr_graph for a pb_graph considering physical modes only
- ***************************************************************************************/
-static 
-LbRRGraph build_lb_type_physical_lb_rr_graph(t_pb_graph_node* pb_graph_head,
-                                             const VprDeviceAnnotation& device_annotation,
-                                             const bool& verbose) {
-  LbRRGraph lb_rr_graph;
+    LbRRNodeId node = lb_rr_graph.create_node(pin_rr_type);
+    lb_rr_graph.set_node_capacity(node, 1);
+    lb_rr_graph.set_node_pb_graph_pin(node, pb_pin);
 
-  /* TODO: ensure we have an empty lb_rr_graph */
+    /* TODO: Double check if this is the case */
+    lb_rr_graph.set_node_intrinsic_cost(node, 1);
 
-  /* Define the external source, sink, and external interconnect for the routing resource graph of the logic block type */
-  LbRRNodeId ext_source_index = lb_rr_graph.create_node(LB_SOURCE); 
-  LbRRNodeId ext_sink_index = lb_rr_graph.create_node(LB_SINK); 
-  LbRRNodeId ext_rr_index = lb_rr_graph.create_node(LB_INTERMEDIATE); 
-
-  /* Build the main body of lb rr_graph by walking through the pb_graph recursively */
-  /* Build all the regular nodes first */
-  rec_build_physical_lb_rr_node_for_pb_graph_node(pb_graph_head, lb_rr_graph, device_annotation);
-  /* Build all the edges and special node (SOURCE/SINK) */
-  rec_build_physical_lb_rr_edge_for_pb_graph_node(pb_graph_head, lb_rr_graph, ext_rr_index, device_annotation);
-
-  /*******************************************************************************
-   * Build logic block source node
-   *******************************************************************************/
-  t_pb_type* pb_type = pb_graph_head->pb_type;
-
-  /* External source node drives all inputs going into logic block type */
-  lb_rr_graph.set_node_capacity(ext_source_index, pb_type->num_input_pins + pb_type->num_clock_pins);
-
-  for (int iport = 0; iport < pb_graph_head->num_input_ports; iport++) {
-    for (int ipin = 0; ipin < pb_graph_head->num_input_pins[iport]; ipin++) {
-      LbRRNodeId to_node = lb_rr_graph.find_node(LB_INTERMEDIATE, &(pb_graph_head->input_pins[iport][ipin]));
-      VTR_ASSERT(true == lb_rr_graph.valid_node_id(to_node));
-      LbRREdgeId edge = lb_rr_graph.create_edge(ext_source_index, to_node, nullptr);
-      lb_rr_graph.set_edge_intrinsic_cost(edge, 1.);
-    }
+    physical_nodes[inode] = node;
   }
 
-  for (int iport = 0; iport < pb_graph_head->num_clock_ports; iport++) {
-    for (int ipin = 0; ipin < pb_graph_head->num_clock_pins[iport]; ipin++) {
-      LbRRNodeId to_node = lb_rr_graph.find_node(LB_INTERMEDIATE, &(pb_graph_head->clock_pins[iport][ipin]));
-      VTR_ASSERT(true == lb_rr_graph.valid_node_id(to_node));
-      LbRREdgeId edge = lb_rr_graph.create_edge(ext_source_index, to_node, nullptr);
-      lb_rr_graph.set_edge_intrinsic_cost(edge, 1.);
+  /* Build all the edges and the SINK nodes of primitive inputs.
+   * The pins of an equivalent port of a primitive share a SINK node
+   */
+  std::map<const t_port*, LbRRNodeId> equivalent_port_sinks;
+  for (int inode = 0; inode < pb_graph_head->total_pb_pins; ++inode) {
+    LbRRNodeId from_node = physical_nodes[inode];
+    if (false == lb_rr_graph.valid_node_id(from_node)) {
+      continue;
     }
-  }
-
-  /*******************************************************************************
-   * Build logic block sink node
-   *******************************************************************************/
-
-  /* External sink node driven by all outputs exiting logic block type */
-  lb_rr_graph.set_node_capacity(ext_sink_index, pb_type->num_output_pins);
-
-  /*******************************************************************************
-   * Build node that approximates external interconnect
-   *******************************************************************************/
-
-  /* External rr node that drives all existing logic block input pins and is driven by all outputs exiting logic block type */
-  lb_rr_graph.set_node_capacity(ext_rr_index, pb_type->num_output_pins);
+    t_pb_graph_pin* pb_pin = lb_type_rr_graph[inode].pb_graph_pin;
+
+    if ( (true == is_primitive_pb_type(pb_pin->parent_node->pb_type))
+      && (OUT_PORT != pb_pin->port->type) ) {
+      PortEquivalence port_equivalent = pb_pin->port->equivalent;
+      LbRRNodeId sink_node = LbRRNodeId::INVALID();
+      if (port_equivalent != PortEquivalence::NONE) {
+        sink_node = equivalent_port_sinks[pb_pin->port];
+      }
+      if (sink_node == LbRRNodeId::INVALID()) {
+        /* Create new sink for input to primitive */
+        sink_node = lb_rr_graph.create_node(LB_SINK);
+        if (port_equivalent != PortEquivalence::NONE) {
+          lb_rr_graph.set_node_capacity(sink_node, pb_pin->port->num_pins);
+          equivalent_port_sinks[pb_pin->port] = sink_node;
+        } else {
+          lb_rr_graph.set_node_capacity(sink_node, 1);
+        }
+      }
 
-  /* Connect opin of logic block to sink */
-  {
-    LbRREdgeId edge = lb_rr_graph.create_edge(ext_rr_index, ext_sink_index, nullptr);
-    lb_rr_graph.set_edge_intrinsic_cost(edge, 1.);
-  }
+      /* Connect the nodes denoting the input pins to sink, since this is a primtive node, we do not have any mode */ 
+      LbRREdgeId edge = lb_rr_graph.create_edge(from_node, sink_node, nullptr);
+      /* TODO: Double check if this is the case */
+      lb_rr_graph.set_edge_intrinsic_cost(edge, 1.); 
+      continue;
+    }
 
-  /* Connect opin of logic block to all input and clock pins of logic block type */
-  for (int iport = 0; iport < pb_graph_head->num_input_ports; iport++) {
-    for (int ipin = 0; ipin < pb_graph_head->num_input_pins[iport]; ipin++) {
-      LbRRNodeId to_node = lb_rr_graph.find_node(LB_INTERMEDIATE, &(pb_graph_head->input_pins[iport][ipin]));
+    /* Load edges only for physical mode! */
+    t_mode* physical_mode = find_pb_graph_pin_physical_mode(pb_pin, device_annotation);
+    int imode = (nullptr == physical_mode) ? 0 : physical_mode->index;
+    const t_lb_type_rr_node& rr_node = lb_type_rr_graph[inode];
+    VTR_ASSERT(imode < rr_node.num_modes);
+    for (int iedge = 0; iedge < rr_node.num_fanout[imode]; ++iedge) {
+      /* Find the node that we have already created */
+      LbRRNodeId to_node = physical_nodes[rr_node.outedges[imode][iedge].node_index];
       VTR_ASSERT(true == lb_rr_graph.valid_node_id(to_node));
-      LbRREdgeId edge = lb_rr_graph.create_edge(ext_rr_index, to_node, nullptr);
-      /* set cost high to avoid using external interconnect unless necessary */
-      lb_rr_graph.set_edge_intrinsic_cost(edge, 1000.);
+      LbRREdgeId edge = lb_rr_graph.create_edge(from_node, to_node, physical_mode);
+      lb_rr_graph.set_edge_intrinsic_cost(edge, rr_node.outedges[imode][iedge].intrinsic_cost);
     }
   }
-  for (int iport = 0; iport < pb_graph_head->num_clock_ports; iport++) {
-    for (int ipin = 0; ipin < pb_graph_head->num_clock_pins[iport]; ipin++) {
-      LbRRNodeId to_node = lb_rr_graph.find_node(LB_INTERMEDIATE, &(pb_graph_head->clock_pins[iport][ipin]));
+
+  /* External source node drives all inputs going into logic block type,
+   * external rr node drives the external sink and all logic block input pins 
+   * (at a high cost to avoid using external interconnect unless necessary)
+   */
+  for (int inode : {ext_source_index, ext_rr_index}) {
+    const t_lb_type_rr_node& rr_node = lb_type_rr_graph[inode];
+    for (int iedge = 0; iedge < rr_node.num_fanout[0]; ++iedge) {
+      LbRRNodeId to_node = physical_nodes[rr_node.outedges[0][iedge].node_index];
       VTR_ASSERT(true == lb_rr_graph.valid_node_id(to_node));
-      LbRREdgeId edge = lb_rr_graph.create_edge(ext_rr_index, to_node, nullptr);
-      /* set cost high to avoid using external interconnect unless necessary */
-      lb_rr_graph.set_edge_intrinsic_cost(edge, 1000.);
+      LbRREdgeId edge = lb_rr_graph.create_edge(physical_nodes[inode], to_node, nullptr);
+      lb_rr_graph.set_edge_intrinsic_cost(edge, rr_node.outedges[0][iedge].intrinsic_cost);
     }
   }
 
@@ -377,36 +206,67 @@ LbRRGraph build_lb_type_physical_lb_rr_graph(t_pb_graph_node* pb_graph_head,
 }
 
 /***************************************************************************************
- * This functio will create physical lb_rr_graph for each pb_graph considering physical modes only
- * the lb_rr_graph willbe added to device annotation
+ * This function will create physical lb_rr_graph for each pb_graph considering physical modes only
+ * the lb_rr_graph willbe added to device annotation, as well as its lookahead
+ * The graphs of different logical tiles are built by a number of threads
  ***************************************************************************************/
 void build_physical_lb_rr_graphs(const DeviceContext& device_ctx,
                                  VprDeviceAnnotation& device_annotation,
+                                 const size_t& num_threads,
                                  const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Build routing resource graph for the physical implementation of logical tile");
 
+  /* The physical graphs are derived from the graphs built by VPR for the packer */
+  VTR_ASSERT(nullptr != device_ctx.lb_type_rr_graphs);
+
+  std::vector<t_pb_graph_node*> pb_graph_heads;
+  std::vector<t_logical_block_type_ptr> lb_types;
   for (const t_logical_block_type& lb_type : device_ctx.logical_block_types) {
     /* By pass nullptr for pb_graph head */
     if (nullptr == lb_type.pb_graph_head) {
       continue;
     }
+    pb_graph_heads.push_back(lb_type.pb_graph_head);
+    lb_types.push_back(&lb_type);
+  }
 
+  /* The graphs of logical tiles are independent from each other and only read the device annotation,
+   * so they are built by a number of threads and then added to device annotation
+   * in the order of logical tiles
+   */
+  std::vector<LbRRGraph> lb_rr_graphs(pb_graph_heads.size());
+  std::vector<LbRRGraphLookahead> lookaheads(pb_graph_heads.size());
+
+  vtr::parallel_for(pb_graph_heads.size(), num_threads, [&](const size_t& igraph) {
     VTR_LOGV(verbose,
-             "Building routing resource graph for logical tile '%s'...",
-             lb_type.pb_graph_head->pb_type->name);
+             "Building routing resource graph for logical tile '%s'...\n",
+             pb_graph_heads[igraph]->pb_type->name);
 
-    const LbRRGraph& lb_rr_graph = build_lb_type_physical_lb_rr_graph(lb_type.pb_graph_head, const_cast<const VprDeviceAnnotation&>(device_annotation), verbose); 
+    lb_rr_graphs[igraph] = build_lb_type_physical_lb_rr_graph(*lb_types[igraph],
+                                                              device_ctx.lb_type_rr_graphs[lb_types[igraph]->index],
+                                                              const_cast<const VprDeviceAnnotation&>(device_annotation),
+                                                              verbose); 
     /* Check the rr_graph */
-    if (false == lb_rr_graph.validate()) {
+    if (false == lb_rr_graphs[igraph].validate()) {
       exit(1);
     }
-    if (false == check_lb_rr_graph(lb_rr_graph)) {
+    if (false == check_lb_rr_graph(lb_rr_graphs[igraph])) {
       exit(1);
     }
     VTR_LOGV(verbose, 
-             "Check routing resource graph for logical tile passed\n");
-
-    device_annotation.add_physical_lb_rr_graph(lb_type.pb_graph_head, lb_rr_graph);
+             "Check routing resource graph for logical tile '%s' passed\n",
+             pb_graph_heads[igraph]->pb_type->name);
+
+    /* Build the lookahead used by the A* router, which only depends on the graph */
+    lookaheads[igraph].build(lb_rr_graphs[igraph]);
+  });
+
+  for (size_t igraph = 0; igraph < pb_graph_heads.size(); ++igraph) {
+    device_annotation.add_physical_lb_rr_graph(pb_graph_heads[igraph], lb_rr_graphs[igraph]);
+    device_annotation.add_physical_lb_rr_graph_lookahead(pb_graph_heads[igraph], lookaheads[igraph]);
+    /* Release the memory as soon as possible */
+    lb_rr_graphs[igraph] = LbRRGraph();
+    lookaheads[igraph] = LbRRGraphLookahead();
   }
 
   VTR_LOGV(verbose, "Done\n");
@@ -16,6 +16,7 @@ namespace openfpga {
 
 void build_physical_lb_rr_graphs(const DeviceContext& device_ctx,
                                  VprDeviceAnnotation& device_annotation,
+                                 const size_t& num_threads,
                                  const bool& verbose);
 
 } /* end namespace openfpga */
@@ -167,8 +167,10 @@ void build_physical_pb_lut_truth_tables(PhysicalPb& physical_pb,
       VTR_LOGV(verbose,
                "Add following truth table to pb_graph_pin '%s[%d]'\n", 
                output_pin->port->name, output_pin->pin_number);
-      for (const std::string& tt_line : truth_table_to_string(frac_lut_tt)) {
-        VTR_LOGV(verbose, "\t%s\n", tt_line.c_str());
+      if (true == verbose) {
+        for (const std::string& tt_line : truth_table_to_string(frac_lut_tt)) {
+          VTR_LOG("\t%s\n", tt_line.c_str());
+        }
       }
       VTR_LOGV(verbose, "\n");
     }
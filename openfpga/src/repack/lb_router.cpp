@@ -1,6 +1,8 @@
 /******************************************************************************
  * Memember functions for data structure LbRouter
  ******************************************************************************/
+#include <limits>
+
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
@@ -15,6 +17,11 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* The lowest fanout factor applied to the cost of nodes in expand_edges(),
+ * which is used to scale the lookahead so that it never overestimates
+ */
+constexpr float LB_ROUTER_MIN_FANOUT_FACTOR = 0.85;
+
 /**************************************************
  * Public Constructors
  *************************************************/
@@ -22,6 +29,7 @@ LbRouter::LbRouter(const LbRRGraph& lb_rr_graph, t_logical_block_type_ptr lb_typ
   routing_status_.resize(lb_rr_graph.nodes().size());
   explored_node_tb_.resize(lb_rr_graph.nodes().size());
   explore_id_index_ = 1;
+  is_node_touched_.resize(lb_rr_graph.nodes().size(), false);
 
   lb_type_ = lb_type;
 
@@ -34,6 +42,11 @@ LbRouter::LbRouter(const LbRRGraph& lb_rr_graph, t_logical_block_type_ptr lb_typ
   is_routed_ = false;
  
   pres_con_fac_ = 1;
+
+  lookahead_ = nullptr;
+  target_node_ = LbRRNodeId::INVALID();
+
+  has_physical_out_edges_ = false;
 }
 
 /**************************************************
@@ -48,6 +61,16 @@ AtomNetId LbRouter::net_atom_net_id(const NetId& net) const {
   return lb_net_atom_net_ids_[net]; 
 }
 
+const std::vector<LbRRNodeId>& LbRouter::net_sources(const NetId& net) const {
+  VTR_ASSERT(true == valid_net_id(net));
+  return lb_net_sources_[net]; 
+}
+
+const std::vector<LbRRNodeId>& LbRouter::net_sinks(const NetId& net) const {
+  VTR_ASSERT(true == valid_net_id(net));
+  return lb_net_sinks_[net]; 
+}
+
 std::vector<LbRRNodeId> LbRouter::find_congested_rr_nodes(const LbRRGraph& lb_rr_graph) const {
   /* Validate if the rr_graph is the one we used to initialize the router */
   VTR_ASSERT(true == matched_lb_rr_graph(lb_rr_graph));
@@ -74,8 +97,8 @@ std::vector<LbRRNodeId> LbRouter::net_routed_nodes(const NetId& net) const {
   std::vector<LbRRNodeId> routed_nodes;
 
   for (size_t isrc = 0; isrc < lb_net_sources_[net].size(); ++isrc) { 
-    t_trace* rt_tree = lb_net_rt_trees_[net][isrc];
-    if (nullptr == rt_tree) {
+    const TraceId& rt_tree = lb_net_rt_trees_[net][isrc];
+    if (TraceId::INVALID() == rt_tree) {
       return routed_nodes;
     }
     /* Walk through the routing tree of the net */
@@ -106,31 +129,30 @@ bool LbRouter::is_route_success(const LbRRGraph& lb_rr_graph) const {
   return true;
 }
 
-LbRouter::t_trace* LbRouter::find_node_in_rt(t_trace* rt, const LbRRNodeId& rt_index) {
-  t_trace* cur;
-  if (rt->current_node == rt_index) {
+LbRouter::TraceId LbRouter::find_node_in_rt(const TraceId& rt, const LbRRNodeId& rt_index) const {
+  if (traces_[rt].current_node == rt_index) {
     return rt;
   } else {
-    for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-      cur = find_node_in_rt(&rt->next_nodes[i], rt_index);
-      if (cur != nullptr) {
+    for (TraceId next = traces_[rt].first_next_node; TraceId::INVALID() != next; next = traces_[next].next_sibling) {
+      TraceId cur = find_node_in_rt(next, rt_index);
+      if (TraceId::INVALID() != cur) {
         return cur;
       }
     }
   }
-  return nullptr;
+  return TraceId::INVALID();
 }
 
-bool LbRouter::route_has_conflict(const LbRRGraph& lb_rr_graph, t_trace* rt) const {
+bool LbRouter::route_has_conflict(const LbRRGraph& lb_rr_graph, const TraceId& rt) const {
   t_mode* cur_mode = nullptr;
-  for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-    std::vector<LbRREdgeId> edges = lb_rr_graph.find_edge(rt->current_node, rt->next_nodes[i].current_node);
+  for (TraceId next = traces_[rt].first_next_node; TraceId::INVALID() != next; next = traces_[next].next_sibling) {
+    std::vector<LbRREdgeId> edges = lb_rr_graph.find_edge(traces_[rt].current_node, traces_[next].current_node);
     VTR_ASSERT(1 == edges.size());
     t_mode* new_mode = lb_rr_graph.edge_mode(edges[0]);
     if (cur_mode != nullptr && cur_mode != new_mode) {
       return true;
     }
-    if (route_has_conflict(lb_rr_graph, &rt->next_nodes[i]) == true) {
+    if (route_has_conflict(lb_rr_graph, next) == true) {
       return true;
     }
     cur_mode = new_mode;
@@ -139,19 +161,62 @@ bool LbRouter::route_has_conflict(const LbRRGraph& lb_rr_graph, t_trace* rt) con
   return false;
 }
 
-void LbRouter::rec_collect_trace_nodes(const t_trace* trace, std::vector<LbRRNodeId>& routed_nodes) const {
-  if (routed_nodes.end() == std::find(routed_nodes.begin(), routed_nodes.end(), trace->current_node)) {
-    routed_nodes.push_back(trace->current_node);
+t_mode* LbRouter::find_node_expand_mode(const LbRRGraph& lb_rr_graph, const LbRRNodeId& node) const {
+  t_mode* mode = routing_status_[node].mode;
+  /* Assume first mode if a mode hasn't been forced. */
+  if (nullptr == mode) {
+    /* If the node is mapped to a nullptr pb_graph_pin, this is a special SINK. Use nullptr mode */
+    if (nullptr == lb_rr_graph.node_pb_graph_pin(node)) {
+      mode = nullptr;
+    } else if (true == is_primitive_pb_type(lb_rr_graph.node_pb_graph_pin(node)->parent_node->pb_type)) {
+    /* For primitive node, we give nullptr as default */
+      mode = nullptr;
+    } else {
+      mode = &(lb_rr_graph.node_pb_graph_pin(node)->parent_node->pb_type->modes[0]);
+    }
   }
+  return mode;
+}
 
-  for (const t_trace& next : trace->next_nodes) {
-    rec_collect_trace_nodes(&next, routed_nodes);
+float LbRouter::estimate_cost_to_target(const LbRRNodeId& node) const {
+  if ( (nullptr == lookahead_)
+    || (false == lookahead_->has_sink(target_node_)) ) {
+    return 0.;
+  }
+  /* Congestion and historical costs only increase the cost of nodes, 
+   * so the intrinsic costs scaled by the lowest fanout factor is a lower bound
+   */
+  return LB_ROUTER_MIN_FANOUT_FACTOR * lookahead_->sink_cost(node, target_node_);
+}
+
+void LbRouter::rec_collect_trace_nodes(const TraceId& trace, std::vector<LbRRNodeId>& routed_nodes) const {
+  if (routed_nodes.end() == std::find(routed_nodes.begin(), routed_nodes.end(), traces_[trace].current_node)) {
+    routed_nodes.push_back(traces_[trace].current_node);
+  }
+
+  for (TraceId next = traces_[trace].first_next_node; TraceId::INVALID() != next; next = traces_[next].next_sibling) {
+    rec_collect_trace_nodes(next, routed_nodes);
   }
 }
 
 /**************************************************
  * Public mutators
  *************************************************/
+void LbRouter::reset() {
+  clear_nets();
+
+  reset_explored_node_tb();
+  reset_routing_status();
+  release_touched_nodes();
+  reset_illegal_modes();
+
+  explore_id_index_ = 1;
+  mode_status_ = t_mode_selection_status();
+  is_routed_ = false;
+  pres_con_fac_ = params_.pres_fac;
+  target_node_ = LbRRNodeId::INVALID();
+}
+
 LbRouter::NetId LbRouter::create_net_to_route(const std::vector<LbRRNodeId>& sources,
                                               const std::vector<LbRRNodeId>& terminals) {
   /* Create an new id */
@@ -165,7 +230,7 @@ LbRouter::NetId LbRouter::create_net_to_route(const std::vector<LbRRNodeId>& sou
   
   lb_net_sources_.push_back(sources);
   lb_net_sinks_.push_back(terminals);
-  lb_net_rt_trees_.push_back(std::vector<t_trace*>(sources.size(), nullptr));
+  lb_net_rt_trees_.push_back(std::vector<TraceId>(sources.size(), TraceId::INVALID()));
 
   return net;
 }
@@ -207,6 +272,17 @@ void LbRouter::set_physical_pb_modes(const LbRRGraph& lb_rr_graph,
       }
     }
   }
+
+  /* The modes will no longer change, cache the edges to expand for each node */
+  physical_out_edges_.resize(lb_rr_graph.nodes().size());
+  for (const LbRRNodeId& node : lb_rr_graph.nodes()) {
+    physical_out_edges_[node] = lb_rr_graph.node_out_edges(node, find_node_expand_mode(lb_rr_graph, node));
+  }
+  has_physical_out_edges_ = true;
+}
+
+void LbRouter::set_lookahead(const LbRRGraphLookahead* lookahead) {
+  lookahead_ = lookahead;
 }
 
 bool LbRouter::try_route_net(const LbRRGraph& lb_rr_graph,
@@ -238,7 +314,7 @@ bool LbRouter::try_route_net(const LbRRGraph& lb_rr_graph,
 
     commit_remove_rt(lb_rr_graph, lb_net_rt_trees_[net_idx][isrc], RT_REMOVE, mode_map);
     free_net_rt(lb_net_rt_trees_[net_idx][isrc]);
-    lb_net_rt_trees_[net_idx][isrc] = nullptr;
+    lb_net_rt_trees_[net_idx][isrc] = TraceId::INVALID();
     add_source_to_rt(net_idx, isrc);
 
     /* Route each sink of net */
@@ -252,6 +328,7 @@ bool LbRouter::try_route_net(const LbRRGraph& lb_rr_graph,
       pq_.clear();
 
       /* Get lowest cost next node, repeat until a path is found or if it is impossible to route */
+      target_node_ = lb_net_sinks_[net_idx][isink];
       expand_rt(net_idx, net_idx, isrc);
 
       /* If we managed to expand the nodes to the sink, routing for this sink is done.
@@ -318,11 +395,7 @@ bool LbRouter::try_route_net(const LbRRGraph& lb_rr_graph,
       } else {
         /* Route failed, reset the explore id index */
         reset_explored_node_tb();
-        for (const LbRRNodeId& id : lb_rr_graph.nodes()) {
-          explored_node_tb_[id].explored_id = OPEN;
-          explored_node_tb_[id].enqueue_id = OPEN;
-          explore_id_index_ = 1;
-        }
+        explore_id_index_ = 1;
       }
     }
 
@@ -394,6 +467,7 @@ bool LbRouter::try_route(const LbRRGraph& lb_rr_graph,
   /* Reset current routing */
   reset_net_rt();
   reset_routing_status();
+  release_touched_nodes();
 
   std::unordered_map<const t_pb_graph_node*, const t_mode*> mode_map;
 
@@ -552,16 +626,16 @@ bool LbRouter::check_edge_for_route_conflicts(std::unordered_map<const t_pb_grap
 }
 
 void LbRouter::commit_remove_rt(const LbRRGraph& lb_rr_graph,
-                                t_trace* rt,
+                                const TraceId& rt,
                                 const e_commit_remove& op,
                                 std::unordered_map<const t_pb_graph_node*, const t_mode*>& mode_map) {
   int incr;
 
-  if (nullptr == rt) {
+  if (TraceId::INVALID() == rt) {
     return;
   }
 
-  LbRRNodeId inode = rt->current_node;
+  LbRRNodeId inode = traces_[rt].current_node;
 
   /* Determine if node is being used or removed */
   if (op == RT_COMMIT) {
@@ -580,12 +654,12 @@ void LbRouter::commit_remove_rt(const LbRRGraph& lb_rr_graph,
   t_pb_graph_pin* driver_pin = lb_rr_graph.node_pb_graph_pin(inode);
 
   /* Recursively update route tree */
-  for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
+  for (TraceId next = traces_[rt].first_next_node; TraceId::INVALID() != next; next = traces_[next].next_sibling) {
     // Check to see if there is no mode conflict between previous nets.
     // A conflict is present if there are differing modes between a pb_graph_node
     // and its children.
     if (op == RT_COMMIT && mode_status_.try_expand_all_modes) {
-      const LbRRNodeId& node = rt->next_nodes[i].current_node;
+      const LbRRNodeId& node = traces_[next].current_node;
       t_pb_graph_pin* pin = lb_rr_graph.node_pb_graph_pin(node);
 
       if (check_edge_for_route_conflicts(mode_map, driver_pin, pin)) {
@@ -593,20 +667,20 @@ void LbRouter::commit_remove_rt(const LbRRGraph& lb_rr_graph,
       }
     }
 
-    commit_remove_rt(lb_rr_graph, &rt->next_nodes[i], op, mode_map);
+    commit_remove_rt(lb_rr_graph, next, op, mode_map);
   }
 }
 
 bool LbRouter::is_skip_route_net(const LbRRGraph& lb_rr_graph,
-                                 t_trace* rt) {
+                                 const TraceId& rt) {
   /* Validate if the rr_graph is the one we used to initialize the router */
   VTR_ASSERT(true == matched_lb_rr_graph(lb_rr_graph));
 
-  if (rt == nullptr) {
+  if (TraceId::INVALID() == rt) {
     return false; /* Net is not routed, therefore must route net */
   }
 
-  LbRRNodeId inode = rt->current_node;
+  LbRRNodeId inode = traces_[rt].current_node;
 
   /* Determine if node is overused */
   if (routing_status_[inode].occ > lb_rr_graph.node_capacity(inode)) {
@@ -615,8 +689,8 @@ bool LbRouter::is_skip_route_net(const LbRRGraph& lb_rr_graph,
   }
 
   /* Recursively check that rest of route tree does not have a conflict */
-  for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-    if (!is_skip_route_net(lb_rr_graph, &rt->next_nodes[i])) {
+  for (TraceId next = traces_[rt].first_next_node; TraceId::INVALID() != next; next = traces_[next].next_sibling) {
+    if (!is_skip_route_net(lb_rr_graph, next)) {
       return false;
     }
   }
@@ -625,10 +699,9 @@ bool LbRouter::is_skip_route_net(const LbRRGraph& lb_rr_graph,
   return true;
 }
 
-bool LbRouter::add_to_rt(t_trace* rt, const LbRRNodeId& node_index, const NetId& irt_net) {
+bool LbRouter::add_to_rt(const TraceId& rt, const LbRRNodeId& node_index, const NetId& irt_net) {
   std::vector<LbRRNodeId> trace_forward;
-  t_trace* link_node;
-  t_trace curr_node;
+  TraceId link_node;
 
   /* Store path all the way back to route tree */
   LbRRNodeId rt_index = node_index;
@@ -640,18 +713,21 @@ bool LbRouter::add_to_rt(t_trace* rt, const LbRRNodeId& node_index, const NetId&
 
   /* Find rt_index on the route tree */
   link_node = find_node_in_rt(rt, rt_index);
-  if (link_node == nullptr) {
+  if (TraceId::INVALID() == link_node) {
     VTR_LOG("Link node is nullptr. Routing impossible");
     return true;
   }
 
-  /* Add path to root tree */
-  LbRRNodeId trace_index;
+  /* Add path to root tree, appending each node to the nodes driven by its previous one */
   while (!trace_forward.empty()) {
-    trace_index = trace_forward.back();
-    curr_node.current_node = trace_index;
-    link_node->next_nodes.push_back(curr_node);
-    link_node = &link_node->next_nodes.back();
+    TraceId curr_node = alloc_trace(trace_forward.back());
+    if (TraceId::INVALID() == traces_[link_node].last_next_node) {
+      traces_[link_node].first_next_node = curr_node;
+    } else {
+      traces_[traces_[link_node].last_next_node].next_sibling = curr_node;
+    }
+    traces_[link_node].last_next_node = curr_node;
+    link_node = curr_node;
     trace_forward.pop_back();
   }
 
@@ -660,12 +736,11 @@ bool LbRouter::add_to_rt(t_trace* rt, const LbRRNodeId& node_index, const NetId&
 
 void LbRouter::add_source_to_rt(const NetId& inet, const size_t& isrc) {
   /* TODO: Validate net id */
-  VTR_ASSERT(nullptr == lb_net_rt_trees_[inet][isrc]);
-  lb_net_rt_trees_[inet][isrc] = new t_trace;
-  lb_net_rt_trees_[inet][isrc]->current_node = lb_net_sources_[inet][isrc];
+  VTR_ASSERT(TraceId::INVALID() == lb_net_rt_trees_[inet][isrc]);
+  lb_net_rt_trees_[inet][isrc] = alloc_trace(lb_net_sources_[inet][isrc]);
 }
 
-void LbRouter::expand_rt_rec(t_trace* rt,
+void LbRouter::expand_rt_rec(const TraceId& rt,
                              const LbRRNodeId& prev_index, 
                              const NetId& irt_net,
                              const int& explore_id_index) {
@@ -673,17 +748,22 @@ void LbRouter::expand_rt_rec(t_trace* rt,
 
   /* Perhaps should use a cost other than zero */
   enode.cost = 0;
-  enode.node_index = rt->current_node;
+  enode.node_index = traces_[rt].current_node;
   enode.prev_index = prev_index;
-  pq_.push(enode);
+  enode.estimated_cost = estimate_cost_to_target(enode.node_index);
+  /* Nodes which cannot reach the target are not worth expanding */
+  if (std::numeric_limits<float>::infinity() != enode.estimated_cost) {
+    pq_.push(enode);
+  }
+  mark_touched_node(enode.node_index);
   explored_node_tb_[enode.node_index].inet = irt_net;
   explored_node_tb_[enode.node_index].explored_id = OPEN;
   explored_node_tb_[enode.node_index].enqueue_id = explore_id_index;
   explored_node_tb_[enode.node_index].enqueue_cost = 0;
   explored_node_tb_[enode.node_index].prev_index = prev_index;
 
-  for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-    expand_rt_rec(&rt->next_nodes[i], rt->current_node, irt_net, explore_id_index);
+  for (TraceId next = traces_[rt].first_next_node; TraceId::INVALID() != next; next = traces_[next].next_sibling) {
+    expand_rt_rec(next, traces_[rt].current_node, irt_net, explore_id_index);
   }
 }
 
@@ -707,7 +787,17 @@ void LbRouter::expand_edges(const LbRRGraph& lb_rr_graph,
   int usage;
   float incr_cost;
 
-  for (const LbRREdgeId& iedge : lb_rr_graph.node_out_edges(cur_inode, mode)) {
+  /* Use the edges cached for the physical mode when possible */
+  std::vector<LbRREdgeId> mode_out_edges;
+  const std::vector<LbRREdgeId>* out_edges = &mode_out_edges;
+  if ( (true == has_physical_out_edges_)
+    && (mode == find_node_expand_mode(lb_rr_graph, cur_inode)) ) {
+    out_edges = &(physical_out_edges_[cur_inode]);
+  } else {
+    mode_out_edges = lb_rr_graph.node_out_edges(cur_inode, mode);
+  }
+
+  for (const LbRREdgeId& iedge : *out_edges) {
     /* Init new expansion node */
     enode.prev_index = cur_inode;
     enode.node_index = lb_rr_graph.edge_sink_node(iedge);
@@ -724,20 +814,13 @@ void LbRouter::expand_edges(const LbRRGraph& lb_rr_graph,
 
     /* Adjust cost so that higher fanout nets prefer higher fanout routing nodes while lower fanout nets prefer lower fanout routing nodes */
     float fanout_factor = 1.0;
-    t_mode* next_mode = routing_status_[enode.node_index].mode;
-    /* Assume first mode if a mode hasn't been forced. */
-    if (nullptr == next_mode) {
-      /* If the node is mapped to a nullptr pb_graph_pin, this is a special SINK. Use nullptr mode */
-      if (nullptr == lb_rr_graph.node_pb_graph_pin(enode.node_index)) {
-        next_mode = nullptr;
-      } else if (true == is_primitive_pb_type(lb_rr_graph.node_pb_graph_pin(enode.node_index)->parent_node->pb_type)) {
-      /* For primitive node, we give nullptr as default */
-        next_mode = nullptr;
-      } else {
-        next_mode = &(lb_rr_graph.node_pb_graph_pin(enode.node_index)->parent_node->pb_type->modes[0]);
-      }
+    size_t next_fanout = 0;
+    if (true == has_physical_out_edges_) {
+      next_fanout = physical_out_edges_[enode.node_index].size();
+    } else {
+      next_fanout = lb_rr_graph.node_out_edges(enode.node_index, find_node_expand_mode(lb_rr_graph, enode.node_index)).size();
     }
-    if (lb_rr_graph.node_out_edges(enode.node_index, next_mode).size() > 1) {
+    if (next_fanout > 1) {
       fanout_factor = 0.85 + (0.25 / net_fanout);
     } else {
       fanout_factor = 1.15 - (0.25 / net_fanout);
@@ -746,6 +829,13 @@ void LbRouter::expand_edges(const LbRRGraph& lb_rr_graph,
     incr_cost *= fanout_factor;
     enode.cost = cur_cost + incr_cost;
 
+    /* Skip the nodes which cannot reach the target, otherwise estimate the cost in the A* mode */
+    float lookahead_cost = estimate_cost_to_target(enode.node_index);
+    if (std::numeric_limits<float>::infinity() == lookahead_cost) {
+      continue;
+    }
+    enode.estimated_cost = enode.cost + lookahead_cost;
+
     /* Add to queue if cost is lower than lowest cost path to this enode */
     if (explored_node_tb_[enode.node_index].enqueue_id == explore_id_index_) {
       if (enode.cost < explored_node_tb_[enode.node_index].enqueue_cost) {
@@ -758,6 +848,7 @@ void LbRouter::expand_edges(const LbRRGraph& lb_rr_graph,
          */
       }
     } else {
+      mark_touched_node(enode.node_index);
       explored_node_tb_[enode.node_index].enqueue_id = explore_id_index_;
       explored_node_tb_[enode.node_index].enqueue_cost = enode.cost;
       pq_.push(enode);
@@ -781,16 +872,7 @@ void LbRouter::expand_node(const LbRRGraph& lb_rr_graph,
 
   LbRRNodeId cur_node = exp_node.node_index;
   float cur_cost = exp_node.cost;
-  t_mode* mode = routing_status_[cur_node].mode;
-  if (nullptr == mode) {
-    if (nullptr == lb_rr_graph.node_pb_graph_pin(cur_node)) {
-      mode = nullptr;
-    } else if (true == is_primitive_pb_type(lb_rr_graph.node_pb_graph_pin(cur_node)->parent_node->pb_type)) {
-      mode = nullptr;
-    } else {
-      mode = &(lb_rr_graph.node_pb_graph_pin(cur_node)->parent_node->pb_type->modes[0]);
-    }
-  }
+  t_mode* mode = find_node_expand_mode(lb_rr_graph, cur_node);
 
   /*
   if (nullptr != mode) {
@@ -981,8 +1063,10 @@ bool LbRouter::check_net(const LbRRGraph& lb_rr_graph,
 /**************************************************
  * Private Initializer and cleaner
  *************************************************/
+/* Only the touched nodes may differ from the initial states */
 void LbRouter::reset_explored_node_tb() {
-  for (t_explored_node_stats& explored_node : explored_node_tb_) {
+  for (const LbRRNodeId& node : touched_nodes_) {
+    t_explored_node_stats& explored_node = explored_node_tb_[node];
     explored_node.prev_index = LbRRNodeId::INVALID();
     explored_node.explored_id = OPEN;
     explored_node.inet = NetId::INVALID();
@@ -991,24 +1075,25 @@ void LbRouter::reset_explored_node_tb() {
   }
 }
 
+/* All the traces are released at once, as the route trees of all the nets are reset */
 void LbRouter::reset_net_rt() {
   for (const NetId& inet : lb_net_ids_) {
     for (size_t isrc = 0; isrc < lb_net_sources_[inet].size(); ++isrc) {
-      free_net_rt(lb_net_rt_trees_[inet][isrc]);
-      lb_net_rt_trees_[inet][isrc] = nullptr;
+      lb_net_rt_trees_[inet][isrc] = TraceId::INVALID();
     }
   }
+  traces_.clear();
+  free_traces_.clear();
 }
 
 void LbRouter::reset_routing_status() {
-  for (t_routing_status& status : routing_status_) {
-    status.historical_usage = 0;
-    status.occ = 0;
+  for (const LbRRNodeId& node : touched_nodes_) {
+    routing_status_[node].historical_usage = 0;
+    routing_status_[node].occ = 0;
   }
 }
 
 void LbRouter::clear_nets() {
-  /* TODO: Trace should no longer use pointers */
   reset_net_rt();
 
   lb_net_ids_.clear();
@@ -1020,23 +1105,46 @@ void LbRouter::clear_nets() {
   lb_net_rt_trees_.clear();
 }
 
-void LbRouter::free_net_rt(t_trace* lb_trace) {
-  if (lb_trace != nullptr) {
-    for (unsigned int i = 0; i < lb_trace->next_nodes.size(); i++) {
-      free_lb_trace(&lb_trace->next_nodes[i]);
-    }
-    lb_trace->next_nodes.clear();
-    delete lb_trace;
+LbRouter::TraceId LbRouter::alloc_trace(const LbRRNodeId& node) {
+  TraceId trace;
+  if (true == free_traces_.empty()) {
+    trace = TraceId(traces_.size());
+    traces_.emplace_back();
+  } else {
+    trace = free_traces_.back();
+    free_traces_.pop_back();
   }
+
+  traces_[trace].current_node = node;
+  traces_[trace].first_next_node = TraceId::INVALID();
+  traces_[trace].last_next_node = TraceId::INVALID();
+  traces_[trace].next_sibling = TraceId::INVALID();
+
+  return trace;
 }
 
-void LbRouter::free_lb_trace(t_trace* lb_trace) {
-  if (lb_trace != nullptr) {
-    for (unsigned int i = 0; i < lb_trace->next_nodes.size(); i++) {
-      free_lb_trace(&lb_trace->next_nodes[i]);
+void LbRouter::free_net_rt(const TraceId& lb_trace) {
+  if (TraceId::INVALID() != lb_trace) {
+    for (TraceId next = traces_[lb_trace].first_next_node; TraceId::INVALID() != next; next = traces_[next].next_sibling) {
+      free_net_rt(next);
     }
-    lb_trace->next_nodes.clear();
+    free_traces_.push_back(lb_trace);
+  }
+}
+
+void LbRouter::mark_touched_node(const LbRRNodeId& node) {
+  if (false == is_node_touched_[node]) {
+    is_node_touched_[node] = true;
+    touched_nodes_.push_back(node);
+  }
+}
+
+/* Called once the states of all the touched nodes are reset */
+void LbRouter::release_touched_nodes() {
+  for (const LbRRNodeId& node : touched_nodes_) {
+    is_node_touched_[node] = false;
   }
+  touched_nodes_.clear();
 }
 
 void LbRouter::reset_illegal_modes() {
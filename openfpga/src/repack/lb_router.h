@@ -17,6 +17,7 @@
 
 #include "vpr_device_annotation.h"
 #include "lb_rr_graph.h"
+#include "lb_rr_graph_lookahead.h"
 
 /********************************************************************
  * Function declaration
@@ -66,6 +67,10 @@ namespace openfpga {
  *  // Here is an example to check which nodes are mapped to the 'net' created before
  *  std::vector<LbRRNodeId> routed_nodes = lb_router.net_routed_nodes(net);
  *
+ *  // Reuse the router for another set of nets on the same lb_rr_graph
+ *  // The modes set before are kept
+ *  lb_router.reset();
+ *
  *******************************************************************/
 
 
@@ -73,6 +78,8 @@ class LbRouter {
   public: /* Strong ids */
     struct net_id_tag;
     typedef vtr::StrongId<net_id_tag> NetId;
+    struct trace_id_tag;
+    typedef vtr::StrongId<trace_id_tag> TraceId;
   public: /* Types and ranges */
     typedef vtr::vector<NetId, NetId>::const_iterator net_iterator;
     typedef vtr::Range<net_iterator> net_range;
@@ -99,10 +106,14 @@ class LbRouter {
      * A net is implemented using routing resource nodes. 
      * The t_lb_trace data structure records one of the nodes used by the net and the connections
      * to other nodes
+     * All the traces are stored in an arena of the router and refer to each other by ids,
+     * where the nodes driven by a trace form a list in the order they are added
      ***************************************************************************/
     struct t_trace {
-      LbRRNodeId current_node;            /* current t_lb_type_rr_node used by net */
-      std::vector<t_trace> next_nodes; /* index of previous edge that drives current node */
+      LbRRNodeId current_node;   /* current t_lb_type_rr_node used by net */
+      TraceId first_next_node;   /* first node driven by current node */
+      TraceId last_next_node;    /* last node driven by current node */
+      TraceId next_sibling;      /* next node driven by the same node as current node */
     };
 
     /**************************************************************************
@@ -122,11 +133,13 @@ class LbRouter {
       LbRRNodeId node_index; /* Index of logic cluster_ctx.blocks rr node this expansion node represents */
       LbRRNodeId prev_index; /* Index of logic cluster_ctx.blocks rr node that drives this expansion node */
       float cost;
+      float estimated_cost; /* cost plus the lookahead to the target, which is the same as cost without A* */
     
       t_expansion_node() {
         node_index = LbRRNodeId::INVALID();
         prev_index = LbRRNodeId::INVALID();
         cost = 0;
+        estimated_cost = 0;
       }
     };
 
@@ -134,7 +147,7 @@ class LbRouter {
       public:
         /* Returns true if t1 is earlier than t2 */
         bool operator()(t_expansion_node& e1, t_expansion_node& e2) {
-          if (e1.cost > e2.cost) {
+          if (e1.estimated_cost > e2.estimated_cost) {
             return true;
           }
           return false;
@@ -216,6 +229,10 @@ class LbRouter {
     /* Return the atom net id for a net to be routed */
     AtomNetId net_atom_net_id(const NetId& net) const;    
 
+    /* Return the source and sink nodes of a net to be routed */
+    const std::vector<LbRRNodeId>& net_sources(const NetId& net) const;
+    const std::vector<LbRRNodeId>& net_sinks(const NetId& net) const;
+
     /**
      * Find all the routing resource nodes that are over-used, which they are used more than their capacity
      * This function is call to collect the nodes and router can reroute these net
@@ -231,6 +248,14 @@ class LbRouter {
     std::vector<LbRRNodeId> net_routed_nodes(const NetId& net) const;
 
   public : /* Public mutators */
+    /**
+     * Remove all the nets and routing results, so that the router can be reused
+     * to route another set of nets on the same lb_rr_graph.
+     * Only the nodes touched by previous routing are cleared
+     * and the (physical) modes of nodes are kept
+     */
+    void reset();
+
     /**
      * Add net to be routed
      */ 
@@ -250,6 +275,12 @@ class LbRouter {
     void set_physical_pb_modes(const LbRRGraph& lb_rr_graph,
                                const VprDeviceAnnotation& device_annotation);
 
+    /* Enable the A* expansion with the lookahead of the lb_rr_graph, or disable it with a nullptr
+     * The lookahead must be built on the same lb_rr_graph as the router, 
+     * and should outlive the router. It is kept when the router is reset
+     */
+    void set_lookahead(const LbRRGraphLookahead* lookahead);
+
     /**
      * Perform routing algorithm on a given logical tile routing resource graph
      * Note: the lb_rr_graph must be the same as you initilized the router!!!
@@ -268,12 +299,22 @@ class LbRouter {
      * Try to find a node in the routing traces recursively
      * If not found, will return an empty pointer
      */
-    t_trace* find_node_in_rt(t_trace* rt, const LbRRNodeId& rt_index);
+    TraceId find_node_in_rt(const TraceId& rt, const LbRRNodeId& rt_index) const;
 
-    bool route_has_conflict(const LbRRGraph& lb_rr_graph, t_trace* rt) const;
+    bool route_has_conflict(const LbRRGraph& lb_rr_graph, const TraceId& rt) const;
+
+    /* Find the mode of a node to expand its outgoing edges, 
+     * which is the mode in routing status or a default mode when not set 
+     */
+    t_mode* find_node_expand_mode(const LbRRGraph& lb_rr_graph, const LbRRNodeId& node) const;
+
+    /* Lower bound of the cost from a node to the current target in the A* mode, 
+     * which is 0 without A*, or infinity when the target can not be reached
+     */
+    float estimate_cost_to_target(const LbRRNodeId& node) const;
 
     /* Recursively find all the nodes in the trace */
-    void rec_collect_trace_nodes(const t_trace* trace, std::vector<LbRRNodeId>& routed_nodes) const;
+    void rec_collect_trace_nodes(const TraceId& trace, std::vector<LbRRNodeId>& routed_nodes) const;
 
   private : /* Private mutators */
     /*It is possible that a net may connect multiple times to a logically equivalent set of primitive pins.
@@ -290,13 +331,13 @@ class LbRouter {
                                         const t_pb_graph_pin* driver_pin,
                                         const t_pb_graph_pin* pin);
     void commit_remove_rt(const LbRRGraph& lb_rr_graph,
-                          t_trace* rt,
+                          const TraceId& rt,
                           const e_commit_remove& op,
                           std::unordered_map<const t_pb_graph_node*, const t_mode*>& mode_map);
-    bool is_skip_route_net(const LbRRGraph& lb_rr_graph, t_trace* rt);
-    bool add_to_rt(t_trace* rt, const LbRRNodeId& node_index, const NetId& irt_net);
+    bool is_skip_route_net(const LbRRGraph& lb_rr_graph, const TraceId& rt);
+    bool add_to_rt(const TraceId& rt, const LbRRNodeId& node_index, const NetId& irt_net);
     void add_source_to_rt(const NetId& inet, const size_t& isrc);
-    void expand_rt_rec(t_trace* rt,
+    void expand_rt_rec(const TraceId& rt,
                        const LbRRNodeId& prev_index, 
                        const NetId& irt_net,
                        const int& explore_id_index);
@@ -353,8 +394,12 @@ class LbRouter {
     void reset_illegal_modes();
 
     void clear_nets();
-    void free_net_rt(t_trace* lb_trace);
-    void free_lb_trace(t_trace* lb_trace);
+
+    /* Allocate a trace from the arena, reusing the freed ones first */
+    TraceId alloc_trace(const LbRRNodeId& node);
+    void free_net_rt(const TraceId& lb_trace);
+    void mark_touched_node(const LbRRNodeId& node);
+    void release_touched_nodes();
 
   private : /* Stores all data needed by intra-logic cluster_ctx.blocks router */
     /* Logical Netlist Info */
@@ -377,7 +422,11 @@ class LbRouter {
     vtr::vector<NetId, std::vector<LbRRNodeId>> lb_net_sinks_;
 
     /* Route tree head for each source of each net */
-    vtr::vector<NetId, std::vector<t_trace*>> lb_net_rt_trees_;
+    vtr::vector<NetId, std::vector<TraceId>> lb_net_rt_trees_;
+
+    /* Arena of the traces of all the route trees, and the traces which are freed */
+    vtr::vector<TraceId, t_trace> traces_;
+    std::vector<TraceId> free_traces_;
 
     /* Logical-to-physical mapping info */
     vtr::vector<LbRRNodeId, t_routing_status> routing_status_; /* [0..lb_type_graph->size()-1] Stats for each logic cluster_ctx.blocks rr node instance */
@@ -387,6 +436,12 @@ class LbRouter {
 
     int explore_id_index_;                 /* used in conjunction with node_traceback to determine whether or not a location has been explored.  By using a unique identifier every route, I don't have to clear the previous route exploration */
 
+    /* Nodes whose routing status or exploration states may have been changed since the last reset,
+     * so that resetting the router does not need visiting all the nodes
+     */
+    std::vector<LbRRNodeId> touched_nodes_;
+    vtr::vector<LbRRNodeId, bool> is_node_touched_;
+
     /* Current type */
     t_logical_block_type_ptr lb_type_;
 
@@ -399,6 +454,13 @@ class LbRouter {
     /* Stores the mode selection status when expanding the edges */
     t_mode_selection_status mode_status_;
 
+    /* Outgoing edges of each node under its physical mode, which are the only edges to expand in repacking
+     * They are built when the physical modes are set,
+     * so that edges are not filtered by modes for each expansion
+     */
+    bool has_physical_out_edges_;
+    vtr::vector<LbRRNodeId, std::vector<LbRREdgeId>> physical_out_edges_;
+
     /* Stores state info of the priority queue in expanding edges during route */
     reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node> pq_;
 
@@ -407,6 +469,12 @@ class LbRouter {
 
     /* current congestion factor */
     float pres_con_fac_;
+
+    /* Lookahead used by A* expansion, nullptr when A* is disabled */
+    const LbRRGraphLookahead* lookahead_;
+
+    /* The sink node that the routing trees are being expanded to */
+    LbRRNodeId target_node_;
 };
 
 } /* end namespace openfpga */
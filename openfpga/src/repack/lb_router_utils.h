@@ -23,6 +23,11 @@ LbRouter::NetId add_lb_router_net_to_route(LbRouter& lb_router,
                                            const AtomContext& atom_ctx,
                                            const AtomNetId& atom_net_id);
 
+void save_lb_net_routed_nodes_to_physical_pb(PhysicalPb& phy_pb,
+                                             const LbRRGraph& lb_rr_graph,
+                                             const std::vector<LbRRNodeId>& routed_nodes,
+                                             const AtomNetId& atom_net);
+
 void save_lb_router_results_to_physical_pb(PhysicalPb& phy_pb,
                                            const LbRouter& lb_router,
                                            const LbRRGraph& lb_rr_graph);
@@ -4,6 +4,7 @@
  ***********************************************************************/
 #include "vtr_assert.h"
 #include "vtr_log.h"
+#include "openfpga_memory_footprint.h"
 #include "lb_rr_graph.h"
 
 /* begin namespace openfpga */
@@ -51,9 +52,9 @@ float LbRRGraph::node_intrinsic_cost(const LbRRNodeId& node) const {
   return node_intrinsic_costs_[node];
 }
 
-std::vector<LbRREdgeId> LbRRGraph::node_in_edges(const LbRRNodeId& node) const {
+LbRRGraph::node_edge_range LbRRGraph::node_in_edges(const LbRRNodeId& node) const {
   VTR_ASSERT(true == valid_node_id(node));
-  return node_in_edges_[node];
+  return vtr::make_range(node_in_edges_[node].begin(), node_in_edges_[node].end());
 }
 
 std::vector<LbRREdgeId> LbRRGraph::node_in_edges(const LbRRNodeId& node, t_mode* mode) const {
@@ -69,9 +70,9 @@ std::vector<LbRREdgeId> LbRRGraph::node_in_edges(const LbRRNodeId& node, t_mode*
   return in_edges;
 }
 
-std::vector<LbRREdgeId> LbRRGraph::node_out_edges(const LbRRNodeId& node) const {
+LbRRGraph::node_edge_range LbRRGraph::node_out_edges(const LbRRNodeId& node) const {
   VTR_ASSERT(true == valid_node_id(node));
-  return node_out_edges_[node];
+  return vtr::make_range(node_out_edges_[node].begin(), node_out_edges_[node].end());
 }
 
 std::vector<LbRREdgeId> LbRRGraph::node_out_edges(const LbRRNodeId& node, t_mode* mode) const {
@@ -92,11 +93,19 @@ LbRRNodeId LbRRGraph::find_node(const e_lb_rr_type& type, const t_pb_graph_pin*
     return LbRRNodeId::INVALID();
   }
 
-  if (0 == node_lookup_[size_t(type)].count(pb_graph_pin)) {
+  if ( (nullptr == pb_graph_pin)
+    || (size_t(pb_graph_pin->pin_count_in_cluster) >= node_lookup_[size_t(type)].size()) ) {
     return LbRRNodeId::INVALID();
   }
   
-  return node_lookup_[size_t(type)].at(pb_graph_pin);
+  /* Pins from another pb_graph may share the same index, which are not in this graph */ 
+  LbRRNodeId node = node_lookup_[size_t(type)][pb_graph_pin->pin_count_in_cluster];
+  if ( (LbRRNodeId::INVALID() == node)
+    || (pb_graph_pin != node_pb_graph_pins_[node]) ) {
+    return LbRRNodeId::INVALID();
+  }
+
+  return node;
 }
 
 LbRRNodeId LbRRGraph::ext_source_node() const {
@@ -137,6 +146,24 @@ t_mode* LbRRGraph::edge_mode(const LbRREdgeId& edge) const {
   return edge_modes_[edge];
 }
 
+size_t LbRRGraph::memory_footprint() const {
+  size_t footprint = sizeof(LbRRGraph);
+  footprint += container_footprint(node_ids_);
+  footprint += container_footprint(node_types_);
+  footprint += container_footprint(node_capacities_);
+  footprint += container_footprint(node_pb_graph_pins_);
+  footprint += container_footprint(node_intrinsic_costs_);
+  footprint += container_footprint(node_in_edges_);
+  footprint += container_footprint(node_out_edges_);
+  footprint += container_footprint(edge_ids_);
+  footprint += container_footprint(edge_src_nodes_);
+  footprint += container_footprint(edge_sink_nodes_);
+  footprint += container_footprint(edge_intrinsic_costs_);
+  footprint += container_footprint(edge_modes_);
+  footprint += container_footprint(node_lookup_);
+  return footprint;
+}
+
 /******************************************************************************
  * Public Mutators
  ******************************************************************************/
@@ -206,17 +233,24 @@ void LbRRGraph::set_node_pb_graph_pin(const LbRRNodeId& node, t_pb_graph_pin* pb
   node_pb_graph_pins_[node] = pb_graph_pin;
 
   /* Register in fast node look-up */
+  if (nullptr == pb_graph_pin) {
+    return;
+  }
   if (node_type(node) >= node_lookup_.size()) {
     node_lookup_.resize(node_type(node) + 1);
   }
+  std::vector<LbRRNodeId>& type_lookup = node_lookup_[node_type(node)];
+  if (size_t(pb_graph_pin->pin_count_in_cluster) >= type_lookup.size()) {
+    type_lookup.resize(pb_graph_pin->pin_count_in_cluster + 1, LbRRNodeId::INVALID());
+  }
 
-  if (0 < node_lookup_[node_type(node)].count(pb_graph_pin)) {
+  if (LbRRNodeId::INVALID() != type_lookup[pb_graph_pin->pin_count_in_cluster]) {
     VTR_LOG_WARN("Detect pb_graph_pin '%s[%lu]' is mapped to LbRRGraph nodes (exist: %lu) and (to be mapped: %lu). Overwrite is done\n",
                  pb_graph_pin->port->name, pb_graph_pin->pin_number,
-                 size_t(node_lookup_[node_type(node)].at(pb_graph_pin)),
+                 size_t(type_lookup[pb_graph_pin->pin_count_in_cluster]),
                  size_t(node));
   }
-  node_lookup_[node_type(node)][pb_graph_pin] = node;
+  type_lookup[pb_graph_pin->pin_count_in_cluster] = node;
 }
 
 void LbRRGraph::set_node_intrinsic_cost(const LbRRNodeId& node, const float& cost) {
@@ -146,6 +146,7 @@
 /* Header from vtrutil library */
 #include "vtr_range.h"
 #include "vtr_vector.h"
+#include "vtr_small_vector.h"
 
 /* Header from readarch library */
 #include "physical_types.h"
@@ -167,6 +168,8 @@ class LbRRGraph {
     /* Ranges used to create range-based loop for nodes/edges/switches/segments */
     typedef vtr::Range<node_iterator> node_range;
     typedef vtr::Range<edge_iterator> edge_range;
+    /* Range of the edges of a node, which are stored in place when there are a few of them */
+    typedef vtr::Range<const LbRREdgeId*> node_edge_range;
 
   public: /* Constructors */
     LbRRGraph();
@@ -198,11 +201,11 @@ class LbRRGraph {
     float node_intrinsic_cost(const LbRRNodeId& node) const;
 
     /* Get a list of edge ids, which are incoming edges to a node */
-    std::vector<LbRREdgeId> node_in_edges(const LbRRNodeId& node) const;
+    node_edge_range node_in_edges(const LbRRNodeId& node) const;
     std::vector<LbRREdgeId> node_in_edges(const LbRRNodeId& node, t_mode* mode) const;
 
     /* Get a list of edge ids, which are outgoing edges from a node */
-    std::vector<LbRREdgeId> node_out_edges(const LbRRNodeId& node) const;
+    node_edge_range node_out_edges(const LbRRNodeId& node) const;
     std::vector<LbRREdgeId> node_out_edges(const LbRRNodeId& node, t_mode* mode) const;
 
     /* General method to look up a node with type and only pb_graph_pin information */
@@ -221,6 +224,9 @@ class LbRRGraph {
     float edge_intrinsic_cost(const LbRREdgeId& edge) const;
     t_mode* edge_mode(const LbRREdgeId& edge) const;
 
+    /* Estimate the memory (in bytes) occupied by the graph */
+    size_t memory_footprint() const;
+
   public: /* Mutators */
     /* Reserve the lists of nodes, edges, switches etc. to be memory efficient. 
      * This function is mainly used to reserve memory space inside RRGraph,
@@ -302,8 +308,8 @@ class LbRRGraph {
     vtr::vector<LbRRNodeId, float> node_intrinsic_costs_;
 
     /* Edges per node is sorted by modes: [<mode_id>][<in_edges...><out_edges>] */
-    vtr::vector<LbRRNodeId, std::vector<LbRREdgeId>> node_in_edges_;
-    vtr::vector<LbRRNodeId, std::vector<LbRREdgeId>> node_out_edges_;
+    vtr::vector<LbRRNodeId, vtr::small_vector<LbRREdgeId>> node_in_edges_;
+    vtr::vector<LbRRNodeId, vtr::small_vector<LbRREdgeId>> node_out_edges_;
 
     /* Edge related data */
     /* Range of edge ids, use the unsigned long as 
@@ -316,9 +322,10 @@ class LbRRGraph {
     vtr::vector<LbRREdgeId, t_mode*> edge_modes_;
 
     /* Fast look-up to search a node by its type, coordinator and ptc_num 
-     * Indexing of fast look-up: [0..NUM_TYPES-1][t_pb_graph_pin*] 
+     * Indexing of fast look-up: [0..NUM_TYPES-1][t_pb_graph_pin->pin_count_in_cluster] 
+     * The pin_count_in_cluster is unique for each pin in the pb_graph of a logical block 
      */
-    typedef std::vector<std::map<const t_pb_graph_pin*, LbRRNodeId>> NodeLookup;
+    typedef std::vector<std::vector<LbRRNodeId>> NodeLookup;
     mutable NodeLookup node_lookup_;
 
     /* Special node look-up */
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Memember functions for data structure LbRRGraphLookahead
+ ******************************************************************************/
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+#include "vtr_assert.h"
+#include "openfpga_memory_footprint.h"
+
+/* Headers from readarch library */
+#include "physical_types.h"
+
+#include "lb_rr_graph_lookahead.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/**************************************************
+ * Public Constructors
+ *************************************************/
+LbRRGraphLookahead::LbRRGraphLookahead() {
+  return;
+}
+
+/**************************************************
+ * Public Accessors 
+ *************************************************/
+bool LbRRGraphLookahead::has_sink(const LbRRNodeId& sink) const {
+  return (size_t(sink) < sink_indices_.size()) && (OPEN != sink_indices_[sink]);
+}
+
+float LbRRGraphLookahead::sink_cost(const LbRRNodeId& node, const LbRRNodeId& sink) const {
+  VTR_ASSERT(true == has_sink(sink));
+  return sink_costs_[sink_indices_[sink]][node];
+}
+
+bool LbRRGraphLookahead::empty() const {
+  return sink_costs_.empty();
+}
+
+size_t LbRRGraphLookahead::memory_footprint() const {
+  return sizeof(LbRRGraphLookahead)
+       + container_footprint(sink_indices_)
+       + container_footprint(sink_costs_);
+}
+
+/**************************************************
+ * Public Mutators
+ *************************************************/
+/* Run a Dijkstra search backward from each sink node through the input edges of nodes */
+void LbRRGraphLookahead::build(const LbRRGraph& lb_rr_graph) {
+  sink_indices_.clear();
+  sink_costs_.clear();
+  sink_indices_.resize(lb_rr_graph.nodes().size(), OPEN);
+
+  typedef std::pair<float, LbRRNodeId> t_cost_node;
+  std::priority_queue<t_cost_node, std::vector<t_cost_node>, std::greater<t_cost_node>> pq;
+
+  for (const LbRRNodeId& sink : lb_rr_graph.nodes()) {
+    if (LB_SINK != lb_rr_graph.node_type(sink)) {
+      continue;
+    }
+    sink_indices_[sink] = sink_costs_.size();
+    sink_costs_.emplace_back(lb_rr_graph.nodes().size(), std::numeric_limits<float>::infinity());
+    vtr::vector<LbRRNodeId, float>& costs = sink_costs_.back();
+
+    costs[sink] = 0.;
+    pq.push(std::make_pair(0., sink));
+    while (false == pq.empty()) {
+      t_cost_node cur = pq.top();
+      pq.pop();
+      /* A node may be pushed several times, only the lowest cost counts */
+      if (cur.first > costs[cur.second]) {
+        continue;
+      }
+      /* Cost to go through the current node */
+      float node_cost = cur.first + lb_rr_graph.node_intrinsic_cost(cur.second);
+      for (const LbRREdgeId& edge : lb_rr_graph.node_in_edges(cur.second)) {
+        LbRRNodeId src_node = lb_rr_graph.edge_src_node(edge);
+        float cost = node_cost + lb_rr_graph.edge_intrinsic_cost(edge);
+        if (cost < costs[src_node]) {
+          costs[src_node] = cost;
+          pq.push(std::make_pair(cost, src_node));
+        }
+      }
+    }
+  }
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,58 @@
+#ifndef LB_RR_GRAPH_LOOKAHEAD_H
+#define LB_RR_GRAPH_LOOKAHEAD_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_vector.h"
+
+#include "lb_rr_graph.h"
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * LbRRGraphLookahead object stores the lowest intrinsic cost 
+ * from each node of a LbRRGraph to each of its sink nodes
+ * The cost of a path is the sum of the intrinsic costs of the edges
+ * and the nodes that the path goes through, excluding the starting node.
+ * The costs are computed regardless of the modes of edges,
+ * so they are lower bounds of the costs for any mode selection 
+ *
+ * It is used by the router (see lb_router.h) as the A* heuristics
+ * when expanding routing trees towards a sink
+ *
+ * Note: 
+ *   - The lookahead does not own the LbRRGraph object
+ *     and should be rebuilt once the LbRRGraph is modified
+ *******************************************************************/
+class LbRRGraphLookahead {
+  public: /* Public constructors */
+    LbRRGraphLookahead();
+  public: /* Public accessors */
+    /* Show if the lookahead is available for a sink node */
+    bool has_sink(const LbRRNodeId& sink) const;
+    /* Return the lowest cost from a node to a sink node,
+     * or infinity if the sink node cannot be reached from the node 
+     * The sink node must have a lookahead
+     */
+    float sink_cost(const LbRRNodeId& node, const LbRRNodeId& sink) const;
+    bool empty() const;
+    /* Estimate the memory (in bytes) occupied by the lookahead */
+    size_t memory_footprint() const;
+  public: /* Public mutators */
+    /* Build the lookahead for all the sink nodes in a LbRRGraph */
+    void build(const LbRRGraph& lb_rr_graph);
+  private: /* Internal data */
+    /* Index of each sink node in the costs, OPEN for non-sink nodes */
+    vtr::vector<LbRRNodeId, int> sink_indices_;
+    /* Lowest cost from each node to each sink node */
+    std::vector<vtr::vector<LbRRNodeId, float>> sink_costs_;
+};
+
+} /* End namespace openfpga*/
+
+#endif
@@ -27,11 +27,6 @@ std::vector<PhysicalPbId> PhysicalPb::primitive_pbs() const {
   return results;
 }
 
-std::string PhysicalPb::name(const PhysicalPbId& pb) const {
-  VTR_ASSERT(true == valid_pb_id(pb));
-  return names_[pb];
-}
-
 const t_pb_graph_node* PhysicalPb::pb_graph_node(const PhysicalPbId& pb) const {
   VTR_ASSERT(true == valid_pb_id(pb));
   return pb_graph_nodes_[pb];
@@ -73,9 +68,9 @@ std::vector<AtomBlockId> PhysicalPb::atom_blocks(const PhysicalPbId& pb) const {
 AtomNetId PhysicalPb::pb_graph_pin_atom_net(const PhysicalPbId& pb,
                                             const t_pb_graph_pin* pb_graph_pin) const {
   VTR_ASSERT(true == valid_pb_id(pb));
-  if (pin_atom_nets_[pb].find(pb_graph_pin) != pin_atom_nets_[pb].end()) {
+  if (size_t(pb_graph_pin->pin_count_in_cluster) < pin_atom_nets_.size()) {
     /* Find it, return the id */
-    return pin_atom_nets_[pb].at(pb_graph_pin); 
+    return pin_atom_nets_[pb_graph_pin->pin_count_in_cluster]; 
   }
   /* Not found, return an invalid id */
   return AtomNetId::INVALID();
@@ -84,9 +79,9 @@ AtomNetId PhysicalPb::pb_graph_pin_atom_net(const PhysicalPbId& pb,
 bool PhysicalPb::is_wire_lut_output(const PhysicalPbId& pb,
                                     const t_pb_graph_pin* pb_graph_pin) const {
   VTR_ASSERT(true == valid_pb_id(pb));
-  if (wire_lut_outputs_[pb].find(pb_graph_pin) != wire_lut_outputs_[pb].end()) {
+  if (size_t(pb_graph_pin->pin_count_in_cluster) < wire_lut_outputs_.size()) {
     /* Find it, return the status */
-    return wire_lut_outputs_[pb].at(pb_graph_pin); 
+    return wire_lut_outputs_[pb_graph_pin->pin_count_in_cluster]; 
   }
   /* Not found, return false */
   return false;
@@ -117,11 +112,8 @@ PhysicalPbId PhysicalPb::create_pb(const t_pb_graph_node* pb_graph_node) {
   pb_ids_.push_back(pb);
 
   /* Allocate other attributes */
-  names_.emplace_back();
   pb_graph_nodes_.push_back(pb_graph_node);
   atom_blocks_.emplace_back();
-  pin_atom_nets_.emplace_back();
-  wire_lut_outputs_.emplace_back();
 
   child_pbs_.emplace_back();
   parent_pbs_.emplace_back();
@@ -184,26 +176,43 @@ void PhysicalPb::set_pb_graph_pin_atom_net(const PhysicalPbId& pb,
                                            const t_pb_graph_pin* pb_graph_pin,
                                            const AtomNetId& atom_net) {
   VTR_ASSERT(true == valid_pb_id(pb)); 
-  if (pin_atom_nets_[pb].end() != pin_atom_nets_[pb].find(pb_graph_pin)) {
+  alloc_pin_lookups(pb_graph_pin);
+  if (AtomNetId::INVALID() != pin_atom_nets_[pb_graph_pin->pin_count_in_cluster]) {
     VTR_LOG_WARN("Overwrite pb_graph_pin '%s[%d]' atom net '%lu' with '%lu'\n",
                  pb_graph_pin->port->name, pb_graph_pin->pin_number,
-                 size_t(pin_atom_nets_[pb][pb_graph_pin]),
+                 size_t(pin_atom_nets_[pb_graph_pin->pin_count_in_cluster]),
                  size_t(atom_net));
   }
 
-  pin_atom_nets_[pb][pb_graph_pin] = atom_net;
+  pin_atom_nets_[pb_graph_pin->pin_count_in_cluster] = atom_net;
 }
 
 void PhysicalPb::set_wire_lut_output(const PhysicalPbId& pb,
                                      const t_pb_graph_pin* pb_graph_pin,
                                      const bool& wire_lut_output) {
   VTR_ASSERT(true == valid_pb_id(pb)); 
-  if (wire_lut_outputs_[pb].end() != wire_lut_outputs_[pb].find(pb_graph_pin)) {
+  alloc_pin_lookups(pb_graph_pin);
+  if (true == wire_lut_outputs_[pb_graph_pin->pin_count_in_cluster]) {
     VTR_LOG_WARN("Overwrite pb_graph_pin '%s[%d]' status on wire LUT output\n",
                  pb_graph_pin->port->name, pb_graph_pin->pin_number);
   }
 
-  wire_lut_outputs_[pb][pb_graph_pin] = wire_lut_output;
+  wire_lut_outputs_[pb_graph_pin->pin_count_in_cluster] = wire_lut_output;
+}
+
+void PhysicalPb::alloc_pin_lookups(const t_pb_graph_pin* pb_graph_pin) {
+  if (false == pin_atom_nets_.empty()) {
+    VTR_ASSERT(size_t(pb_graph_pin->pin_count_in_cluster) < pin_atom_nets_.size());
+    return;
+  }
+
+  /* The total number of pins is stored in the root pb_graph_node */
+  const t_pb_graph_node* root_pb_graph_node = pb_graph_pin->parent_node;
+  while (false == root_pb_graph_node->is_root()) {
+    root_pb_graph_node = root_pb_graph_node->parent_pb_graph_node;
+  }
+  pin_atom_nets_.resize(root_pb_graph_node->total_pb_pins, AtomNetId::INVALID());
+  wire_lut_outputs_.resize(root_pb_graph_node->total_pb_pins, false);
 }
 
 /******************************************************************************
@@ -40,7 +40,6 @@ class PhysicalPb {
   public: /* Public aggregators */
     physical_pb_range pbs() const;
     std::vector<PhysicalPbId> primitive_pbs() const;
-    std::string name(const PhysicalPbId& pb) const;
     const t_pb_graph_node* pb_graph_node(const PhysicalPbId& pb) const;
     PhysicalPbId find_pb(const t_pb_graph_node* name) const;
     PhysicalPbId parent(const PhysicalPbId& pb) const;
@@ -75,13 +74,19 @@ class PhysicalPb {
   public: /* Public validators/invalidators */
     bool valid_pb_id(const PhysicalPbId& pb_id) const;
     bool empty() const;
+  private: /* Private mutators */
+    /* Allocate the pin nets and wire LUT outputs for all the pins of the logical block */
+    void alloc_pin_lookups(const t_pb_graph_pin* pb_graph_pin);
   private: /* Internal Data */
     vtr::vector<PhysicalPbId, PhysicalPbId> pb_ids_;
     vtr::vector<PhysicalPbId, const t_pb_graph_node*> pb_graph_nodes_;
-    vtr::vector<PhysicalPbId, std::string> names_;
     vtr::vector<PhysicalPbId, std::vector<AtomBlockId>> atom_blocks_;
-    vtr::vector<PhysicalPbId, std::map<const t_pb_graph_pin*, AtomNetId>> pin_atom_nets_;
-    vtr::vector<PhysicalPbId, std::map<const t_pb_graph_pin*, bool>> wire_lut_outputs_;
+    /* Nets and wire LUT outputs of pins are indexed by the pin_count_in_cluster of pb_graph_pins,
+     * which is unique for each pin in a logical block
+     * They are allocated upon the first pin is set, with the total number of pins of the logical block
+     */
+    std::vector<AtomNetId> pin_atom_nets_;
+    std::vector<bool> wire_lut_outputs_;
 
     /* Child pbs are organized as [0..num_child_pb_types-1][0..child_pb_type->num_pb-1] */
     vtr::vector<PhysicalPbId, std::map<const t_pb_type*, std::vector<PhysicalPbId>>> child_pbs_;
@@ -1,9 +1,15 @@
 /***************************************************************************************
  * This file includes functions that are used to redo packing for physical pbs
  ***************************************************************************************/
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_log.h"
+#include "vtr_parallel.h"
 #include "vtr_assert.h"
 #include "vtr_time.h"
 
@@ -375,6 +381,144 @@ void add_lb_router_nets(LbRouter& lb_router,
            net_counter);
 }
 
+/***************************************************************************************
+ * Check if a pb_graph_node belongs to the physical pb_graph, 
+ * i.e., if it and all its parents are in the physical modes of their parents
+ ***************************************************************************************/
+static 
+bool is_physical_pb_graph_node(const t_pb_graph_node* pb_graph_node,
+                               const VprDeviceAnnotation& device_annotation) {
+  for (const t_pb_graph_node* node = pb_graph_node; false == node->is_root(); node = node->parent_pb_graph_node) {
+    if (node->pb_type->parent_mode != device_annotation.physical_mode(node->parent_pb_graph_node->pb_type)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/***************************************************************************************
+ * Check if the routing of a clustered block by VPR packer is already legal in the physical modes,
+ * i.e., if each pin it uses is a pin of the physical pb_graph 
+ * (and, for primitives, its physical pin is itself),
+ * and the inputs of the clustered block carry the nets that VPR packer routed from them,
+ * which is not the case when the nets are moved to other inputs during routing.
+ * The interconnects which VPR packer used then exist in the physical lb_rr_graph,
+ * and the routing can be saved to the physical pb without running the router
+ ***************************************************************************************/
+static 
+bool is_pb_route_physical(const AtomContext& atom_ctx,
+                          const ClusteringContext& clustering_ctx,
+                          const VprDeviceAnnotation& device_annotation,
+                          const VprClusteringAnnotation& clustering_annotation,
+                          const ClusterBlockId& block_id) {
+  t_logical_block_type_ptr lb_type = clustering_ctx.clb_nlist.block_type(block_id);
+  const t_pb* pb = clustering_ctx.clb_nlist.block_pb(block_id);
+
+  /* The nets of the inputs of the clustered block should be the nets routed by VPR packer */
+  for (int j = 0; j < lb_type->pb_type->num_pins; j++) {
+    const t_pb_graph_pin* block_pb_pin = get_pb_graph_node_pin_from_block_pin(block_id, j);
+    if (OUT_PORT == block_pb_pin->port->type) {
+      continue;
+    }
+    ClusterNetId cluster_net_id = clustering_ctx.clb_nlist.block_net(block_id, j);
+    if (true == clustering_annotation.is_net_renamed(block_id, j)) {
+      cluster_net_id = clustering_annotation.net(block_id, j);
+    }
+    AtomNetId block_atom_net_id = AtomNetId::INVALID();
+    if (ClusterNetId::INVALID() != cluster_net_id) {
+      block_atom_net_id = atom_ctx.lookup.atom_net(cluster_net_id);
+    }
+    AtomNetId routed_atom_net_id = AtomNetId::INVALID();
+    if (0 < pb->pb_route.count(j)) {
+      routed_atom_net_id = pb->pb_route[j].atom_net_id;
+    }
+    if (block_atom_net_id != routed_atom_net_id) {
+      return false;
+    }
+  }
+
+  /* Each pin used inside the clustered block should be a physical pin */
+  for (const auto& pb_route : pb->pb_route) {
+    if (AtomNetId::INVALID() == pb_route.second.atom_net_id) {
+      continue;
+    }
+    const t_pb_graph_pin* pb_graph_pin = pb_route.second.pb_graph_pin;
+    if (false == is_physical_pb_graph_node(pb_graph_pin->parent_node, device_annotation)) {
+      return false;
+    }
+    if ( (true == is_primitive_pb_type(pb_graph_pin->parent_node->pb_type))
+      && (pb_graph_pin != device_annotation.physical_pb_graph_pin(pb_graph_pin)) ) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/***************************************************************************************
+ * Save the routing of a clustered block by VPR packer to its physical pb,
+ * as the router would do for a routing found by is_pb_route_physical()
+ ***************************************************************************************/
+static 
+void save_pb_route_to_physical_pb(PhysicalPb& phy_pb,
+                                  const t_pb* pb) {
+  for (const auto& pb_route : pb->pb_route) {
+    const AtomNetId& atom_net = pb_route.second.atom_net_id;
+    if (AtomNetId::INVALID() == atom_net) {
+      continue;
+    }
+    const t_pb_graph_pin* pb_graph_pin = pb_route.second.pb_graph_pin;
+    const PhysicalPbId& pb_id = phy_pb.find_pb(pb_graph_pin->parent_node);
+    VTR_ASSERT(true == phy_pb.valid_pb_id(pb_id));
+
+    if (AtomNetId::INVALID() == phy_pb.pb_graph_pin_atom_net(pb_id, pb_graph_pin)) {
+      phy_pb.set_pb_graph_pin_atom_net(pb_id, pb_graph_pin, atom_net);
+    } else {
+      VTR_ASSERT(atom_net == phy_pb.pb_graph_pin_atom_net(pb_id, pb_graph_pin));
+    }
+  }
+}
+
+/***************************************************************************************
+ * Routing results of clustered blocks, shared by all the clustered blocks
+ * which have the same routing problem
+ *
+ * The logical tile router only sees the routing resource graph and
+ * the source and sink nodes of each net, in the order of nets.
+ * Clustered blocks which have the same atoms at the same pb positions and the same pin mapping
+ * therefore lead to the same routing results, regardless of their atom nets.
+ * The signature of a routing problem describes the nets without their identities:
+ *   [num_sources, sources..., num_sinks, sinks...] for each net
+ * and the routed nodes are stored per net, in the same order as the signature
+ * The signatures are keyed by the pb_graph head, which identifies the physical lb_rr_graph
+ * in the device annotation, rather than by the address of the graph
+ *
+ * The cache is shared by all the threads repacking clustered blocks
+ ***************************************************************************************/
+struct t_repack_routing_cache {
+  std::map<std::pair<t_pb_graph_node*, std::vector<size_t>>, std::vector<std::vector<LbRRNodeId>>> routed_nodes;
+  size_t num_hits = 0;
+  /* Number of clustered blocks whose routing by VPR packer is already physical */
+  size_t num_physical_pb_routes = 0;
+  std::mutex mutex;
+};
+
+static 
+std::vector<size_t> build_lb_router_nets_signature(const LbRouter& lb_router) {
+  std::vector<size_t> signature;
+  for (const LbRouter::NetId& net : lb_router.nets()) {
+    signature.push_back(lb_router.net_sources(net).size());
+    for (const LbRRNodeId& node : lb_router.net_sources(net)) {
+      signature.push_back(size_t(node));
+    }
+    signature.push_back(lb_router.net_sinks(net).size());
+    for (const LbRRNodeId& node : lb_router.net_sinks(net)) {
+      signature.push_back(size_t(node));
+    }
+  }
+  return signature;
+}
+
 /***************************************************************************************
  * Repack a clustered block in the physical mode
  * This function will do 
@@ -382,87 +526,235 @@ void add_lb_router_nets(LbRouter& lb_router,
  *   and initilize the logcial tile router 
  * - Create nets to be routed, including the source nodes and terminals
  *   This should consider the net remapping in the clustering_annotation 
- * - Run the router to finish the repacking
- * - Output routing results to data structure PhysicalPb and store it in clustering annotation
+ * - Run the router to finish the repacking, 
+ *   unless the same routing problem has been solved for another clustered block.
+ *   In such case, the cached routing results are applied to the nets of this block
+ * - Output routing results to data structure PhysicalPb
+ *
+ * Only shared data are read here, so that clustered blocks can be repacked in parallel
+ * The routers are owned by the caller, one per logical block type, and reused across blocks
+ * The physical pb is copied from the template of its logical block type,
+ * and stored in clustering annotation by the caller
  ***************************************************************************************/
 static 
 void repack_cluster(const AtomContext& atom_ctx,
                     const ClusteringContext& clustering_ctx,
                     const VprDeviceAnnotation& device_annotation,
-                    VprClusteringAnnotation& clustering_annotation,
+                    const VprClusteringAnnotation& clustering_annotation,
                     const ClusterBlockId& block_id,
+                    std::map<t_logical_block_type_ptr, LbRouter>& lb_routers,
+                    t_repack_routing_cache& routing_cache,
+                    const std::map<t_logical_block_type_ptr, PhysicalPb>& phy_pb_templates,
+                    PhysicalPb& phy_pb,
+                    const bool& use_astar,
                     const bool& verbose) {
   /* Get the pb graph that current clustered block is mapped to */
   t_logical_block_type_ptr lb_type = clustering_ctx.clb_nlist.block_type(block_id);
   t_pb_graph_node* pb_graph_head = lb_type->pb_graph_head;
   VTR_ASSERT(nullptr != pb_graph_head);
 
+  /* The routing by VPR packer is kept when it is already in the physical modes */
+  if (true == is_pb_route_physical(atom_ctx, clustering_ctx, device_annotation, clustering_annotation, block_id)) {
+    phy_pb = phy_pb_templates.at(lb_type);
+    rec_update_physical_pb_from_operating_pb(phy_pb,
+                                             clustering_ctx.clb_nlist.block_pb(block_id),
+                                             clustering_ctx.clb_nlist.block_pb(block_id)->pb_route,
+                                             atom_ctx,
+                                             device_annotation,
+                                             verbose);
+    save_pb_route_to_physical_pb(phy_pb, clustering_ctx.clb_nlist.block_pb(block_id));
+    {
+      std::lock_guard<std::mutex> lock(routing_cache.mutex);
+      routing_cache.num_physical_pb_routes++;
+    }
+    VTR_LOGV(verbose, "Reuse routing results of VPR packer, which are in the physical modes\n");
+    return;
+  }
+
   /* We should get a non-empty graph */
   const LbRRGraph& lb_rr_graph = device_annotation.physical_lb_rr_graph(pb_graph_head);
   VTR_ASSERT(!lb_rr_graph.empty());
 
-  VTR_LOG("Repack clustered block '%s'...",
-          clustering_ctx.clb_nlist.block_name(block_id).c_str());
-  VTR_LOGV(verbose, "\n");
-
-  /* Initialize the router */
-  LbRouter lb_router(lb_rr_graph, lb_type);
+  /* Initialize the router, or reuse the router which has routed a block of the same type */
+  auto router_result = lb_routers.find(lb_type);
+  if (router_result == lb_routers.end()) {
+    router_result = lb_routers.emplace(lb_type, LbRouter(lb_rr_graph, lb_type)).first;
+    /* Initialize the modes to expand routing trees with the physical modes in device annotation
+     * This is a must-do before running the routeri in the purpose of repacking!!!
+     * The modes are kept when the router is reset
+     */
+    router_result->second.set_physical_pb_modes(lb_rr_graph, device_annotation); 
+    if (true == use_astar) {
+      router_result->second.set_lookahead(&device_annotation.physical_lb_rr_graph_lookahead(pb_graph_head));
+    }
+  }
+  LbRouter& lb_router = router_result->second;
+  lb_router.reset();
 
   /* Add nets to be routed with source and terminals */
   add_lb_router_nets(lb_router, lb_type, lb_rr_graph, atom_ctx, device_annotation,
-                     clustering_ctx, const_cast<const VprClusteringAnnotation&>(clustering_annotation),
+                     clustering_ctx, clustering_annotation,
                      block_id, verbose);
 
-  /* Initialize the modes to expand routing trees with the physical modes in device annotation
-   * This is a must-do before running the routeri in the purpose of repacking!!!
-   */
-  lb_router.set_physical_pb_modes(lb_rr_graph, device_annotation); 
+  /* Look up the routing results of the same routing problem */
+  auto cache_key = std::make_pair(pb_graph_head, build_lb_router_nets_signature(lb_router));
+  std::vector<std::vector<LbRRNodeId>> net_routed_nodes;
+  bool cache_hit = false;
+  {
+    std::lock_guard<std::mutex> lock(routing_cache.mutex);
+    auto result = routing_cache.routed_nodes.find(cache_key);
+    if (result != routing_cache.routed_nodes.end()) {
+      net_routed_nodes = result->second;
+      routing_cache.num_hits++;
+      cache_hit = true;
+    }
+  }
+
+  if (false == cache_hit) {
+    /* Run the router */
+    bool route_success = lb_router.try_route(lb_rr_graph, atom_ctx.nlist, verbose);
 
-  /* Run the router */
-  bool route_success = lb_router.try_route(lb_rr_graph, atom_ctx.nlist, verbose);
+    if (false == route_success) {
+      VTR_LOGV(verbose, "Reroute failed\n");
+      exit(1);
+    }
+    VTR_ASSERT(true == route_success);
+    VTR_LOGV(verbose, "Reroute succeed\n");
+
+    for (const LbRouter::NetId& net : lb_router.nets()) {
+      net_routed_nodes.push_back(lb_router.net_routed_nodes(net));
+    }
 
-  if (false == route_success) {
-    VTR_LOGV(verbose, "Reroute failed\n");
-    exit(1);
+    /* Another thread may have solved the same problem in the meantime, 
+     * which leads to the same results
+     */
+    std::lock_guard<std::mutex> lock(routing_cache.mutex);
+    routing_cache.routed_nodes.emplace(std::move(cache_key), net_routed_nodes);
+  } else {
+    VTR_LOGV(verbose, "Reuse routing results of an identical clustered block\n");
   }
-  VTR_ASSERT(true == route_success);
-  VTR_LOGV(verbose, "Reroute succeed\n");
 
   /* Annotate routing results to physical pb */
-  PhysicalPb phy_pb;
-  alloc_physical_pb_from_pb_graph(phy_pb, pb_graph_head, device_annotation);
+  phy_pb = phy_pb_templates.at(lb_type);
   rec_update_physical_pb_from_operating_pb(phy_pb,
                                            clustering_ctx.clb_nlist.block_pb(block_id),
                                            clustering_ctx.clb_nlist.block_pb(block_id)->pb_route,
                                            atom_ctx,
                                            device_annotation,
                                            verbose);
-  /* Save routing results */
-  save_lb_router_results_to_physical_pb(phy_pb, lb_router, lb_rr_graph);
+  /* Save routing results, renaming the nets in the cached results to the nets of this block */
+  VTR_ASSERT(net_routed_nodes.size() == lb_router.nets().size());
+  for (const LbRouter::NetId& net : lb_router.nets()) {
+    save_lb_net_routed_nodes_to_physical_pb(phy_pb, lb_rr_graph,
+                                            net_routed_nodes[size_t(net)],
+                                            lb_router.net_atom_net_id(net));
+  }
   VTR_LOGV(verbose, "Saved results in physical pb\n");
+}
 
-  /* Add the pb to clustering context */
-  clustering_annotation.add_physical_pb(block_id, phy_pb);
+/***************************************************************************************
+ * Repack clustered blocks by a number of threads
+ *
+ * Clustered blocks are independent from each other, so they can be repacked
+ * by a number of threads, each of which owns its routers.
+ * The physical pbs are staged per block and then added to the clustering annotation
+ * in the order of blocks, so that the results are the same regardless of the number of threads
+ ***************************************************************************************/
+static 
+void repack_clusters_parallel(const AtomContext& atom_ctx,
+                              const ClusteringContext& clustering_ctx,
+                              const VprDeviceAnnotation& device_annotation,
+                              VprClusteringAnnotation& clustering_annotation,
+                              t_repack_routing_cache& routing_cache,
+                              const std::map<t_logical_block_type_ptr, PhysicalPb>& phy_pb_templates,
+                              const size_t& num_threads,
+                              const bool& use_astar,
+                              const bool& verbose) {
+  std::vector<ClusterBlockId> blocks;
+  for (auto blk_id : clustering_ctx.clb_nlist.blocks()) {
+    blocks.push_back(blk_id);
+  }
+  std::vector<PhysicalPb> phy_pbs(blocks.size());
 
-  VTR_LOG("Done\n");
+  /* Blocks are dispatched on demand, as their routing efforts vary a lot.
+   * Each worker reuses its own routers across its blocks
+   */
+  std::vector<std::map<t_logical_block_type_ptr, LbRouter>> worker_lb_routers(std::max(num_threads, size_t(1)));
+  vtr::parallel_for_workers(blocks.size(), num_threads, [&](const size_t& iblk, const size_t& worker) {
+    repack_cluster(atom_ctx, clustering_ctx, 
+                   device_annotation, clustering_annotation, 
+                   blocks[iblk], worker_lb_routers[worker], routing_cache, phy_pb_templates, phy_pbs[iblk],
+                   use_astar, verbose);
+  });
+
+  for (size_t iblk = 0; iblk < blocks.size(); ++iblk) {
+    VTR_LOG("Repack clustered block '%s'...Done\n",
+            clustering_ctx.clb_nlist.block_name(blocks[iblk]).c_str());
+    /* The physical pb is moved, which also releases its memory here */
+    clustering_annotation.add_physical_pb(blocks[iblk], std::move(phy_pbs[iblk]));
+  }
 }
 
 /***************************************************************************************
  * Repack each clustered blocks in the clustering context
+ *
+ * Routing results are shared between clustered blocks with the same routing problem
+ * Physical pbs are copied from a template per logical block type
  ***************************************************************************************/
 static 
 void repack_clusters(const AtomContext& atom_ctx,
                      const ClusteringContext& clustering_ctx,
                      const VprDeviceAnnotation& device_annotation,
                      VprClusteringAnnotation& clustering_annotation,
+                     const size_t& num_threads,
+                     const bool& use_astar,
                      const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Repack clustered blocks to physical implementation of logical tile");
 
+  t_repack_routing_cache routing_cache;
+
+  /* The physical pbs of a logical block type share the same hierarchy,
+   * which is allocated once here and copied for each clustered block
+   */
+  std::map<t_logical_block_type_ptr, PhysicalPb> phy_pb_templates;
   for (auto blk_id : clustering_ctx.clb_nlist.blocks()) {
-    repack_cluster(atom_ctx, clustering_ctx, 
-                   device_annotation, clustering_annotation, 
-                   blk_id, verbose);
+    t_logical_block_type_ptr lb_type = clustering_ctx.clb_nlist.block_type(blk_id);
+    if (0 < phy_pb_templates.count(lb_type)) {
+      continue;
+    }
+    VTR_ASSERT(nullptr != lb_type->pb_graph_head);
+    alloc_physical_pb_from_pb_graph(phy_pb_templates[lb_type], lb_type->pb_graph_head, device_annotation);
+  }
+
+  if (1 >= num_threads) {
+    std::map<t_logical_block_type_ptr, LbRouter> lb_routers;
+    for (auto blk_id : clustering_ctx.clb_nlist.blocks()) {
+      VTR_LOG("Repack clustered block '%s'...",
+              clustering_ctx.clb_nlist.block_name(blk_id).c_str());
+      VTR_LOGV(verbose, "\n");
+
+      PhysicalPb phy_pb;
+      repack_cluster(atom_ctx, clustering_ctx, 
+                     device_annotation, clustering_annotation, 
+                     blk_id, lb_routers, routing_cache, phy_pb_templates, phy_pb,
+                     use_astar, verbose);
+
+      /* Add the pb to clustering context */
+      clustering_annotation.add_physical_pb(blk_id, std::move(phy_pb));
+
+      VTR_LOG("Done\n");
+    }
+  } else {
+    repack_clusters_parallel(atom_ctx, clustering_ctx, 
+                             device_annotation, clustering_annotation, 
+                             routing_cache, phy_pb_templates,
+                             num_threads, use_astar, verbose);
   }
+
+  VTR_LOG("Reused routing results for %lu out of %lu clustered blocks\n",
+          routing_cache.num_hits, clustering_ctx.clb_nlist.blocks().size());
+  VTR_LOG("Kept the routing of VPR packer for %lu out of %lu clustered blocks\n",
+          routing_cache.num_physical_pb_routes, clustering_ctx.clb_nlist.blocks().size());
 }
 
 /***************************************************************************************
@@ -472,7 +764,7 @@ void repack_clusters(const AtomContext& atom_ctx,
  *    the lb_rr_graph will be added to device annotation
  *  - annotate nets to be routed for each clustered block from operating modes of pb_graph 
  *    to physical modes of pb_graph
- *  - rerun the routing for each clustered block
+ *  - rerun the routing for each clustered block, using a number of threads
  *  - store the packing results to clustering annotation
  ***************************************************************************************/
 void pack_physical_pbs(const DeviceContext& device_ctx,
@@ -480,17 +772,20 @@ void pack_physical_pbs(const DeviceContext& device_ctx,
                        const ClusteringContext& clustering_ctx,
                        VprDeviceAnnotation& device_annotation,
                        VprClusteringAnnotation& clustering_annotation,
+                       const size_t& num_threads,
+                       const bool& use_astar,
                        const bool& verbose) {
 
   /* build the routing resource graph for each logical tile */
   build_physical_lb_rr_graphs(device_ctx,
                               device_annotation,
+                              num_threads,
                               verbose);
 
   /* Call the LbRouter to re-pack each clustered block to physical implementation */ 
   repack_clusters(atom_ctx, clustering_ctx, 
                   const_cast<const VprDeviceAnnotation&>(device_annotation), clustering_annotation, 
-                  verbose);
+                  num_threads, use_astar, verbose);
 }
 
 } /* end namespace openfpga */
@@ -3,6 +3,8 @@
  * between tiles (programmable blocks) 
  ***************************************************************************************/
 
+#include <algorithm>
+
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
@@ -147,194 +149,186 @@ bool is_grid_coordinate_exist_in_device(const DeviceGrid& device_grid,
 }
 
 /********************************************************************
- * Find the coordinate of a grid in a specific column 
- * with a given type
- * This function will return the coordinate of the grid that satifies
- * the type requirement
+ * Index of the tile types in the core grids, i.e., excluding the blocks
+ * on the border of the fabric, which are not supported by
+ * inter-column/row direct connections
+ *  - column_ys[type][x] are the y coordinates of the grids of a type in column x
+ *  - type_columns[type] are the columns which contain a grid of a type
+ *  - row_xs[type][y] and type_rows[type] are their counterparts for rows
+ * All the coordinates are sorted in ascending order,
+ * so that the nearest grid of a type in a direction is found by binary searches
+ * Types are indexed by t_physical_tile_type::index
  *******************************************************************/
+struct t_core_tile_type_index {
+  std::vector<std::vector<std::vector<size_t>>> column_ys;
+  std::vector<std::vector<size_t>> type_columns;
+  std::vector<std::vector<std::vector<size_t>>> row_xs;
+  std::vector<std::vector<size_t>> type_rows;
+};
+
 static 
-vtr::Point<size_t> find_grid_coordinate_given_type(const DeviceGrid& grids,
-                                                   const std::vector<vtr::Point<size_t>>& candidate_coords, 
-                                                   const std::string& wanted_grid_type_name) {
-  for (vtr::Point<size_t> coord : candidate_coords) {
-    /* If the next column is not longer in device range, we can return */
-    if (false == is_grid_coordinate_exist_in_device(grids, coord)) {
-      continue;
+t_core_tile_type_index build_core_tile_type_index(const DeviceContext& device_ctx) {
+  const DeviceGrid& grids = device_ctx.grid;
+  size_t num_types = device_ctx.physical_tile_types.size();
+
+  t_core_tile_type_index type_index;
+  type_index.column_ys.resize(num_types, std::vector<std::vector<size_t>>(grids.width()));
+  type_index.type_columns.resize(num_types);
+  type_index.row_xs.resize(num_types, std::vector<std::vector<size_t>>(grids.height()));
+  type_index.type_rows.resize(num_types);
+
+  for (size_t ix = 1; ix < grids.width() - 1; ++ix) {
+    for (size_t iy = 1; iy < grids.height() - 1; ++iy) {
+      size_t itype = grids[ix][iy].type->index;
+      type_index.column_ys[itype][ix].push_back(iy);
+      type_index.row_xs[itype][iy].push_back(ix);
     }
-    if (wanted_grid_type_name == std::string(grids[coord.x()][coord.y()].type->name)) {
-      return coord;
+  }
+
+  for (size_t itype = 0; itype < num_types; ++itype) {
+    for (size_t ix = 0; ix < grids.width(); ++ix) {
+      if (false == type_index.column_ys[itype][ix].empty()) {
+        type_index.type_columns[itype].push_back(ix);
+      }
+    }
+    for (size_t iy = 0; iy < grids.height(); ++iy) {
+      if (false == type_index.row_xs[itype][iy].empty()) {
+        type_index.type_rows[itype].push_back(iy);
+      }
     }
   }
-  /* Return an valid coordinate */
-  return vtr::Point<size_t>(grids.width(), grids.height()); 
+
+  return type_index;
+}
+
+/********************************************************************
+ * Find the nearest of the sorted coordinates which is strictly after 
+ * (in positive direction) or before (in negative direction) a given coordinate
+ * Return false if there is no such coordinate
+ *******************************************************************/
+static 
+bool find_next_sorted_coordinate(const std::vector<size_t>& coords,
+                                 const size_t& start,
+                                 const e_direct_direction& direction,
+                                 size_t& next) {
+  if (POSITIVE_DIR == direction) {
+    auto it = std::upper_bound(coords.begin(), coords.end(), start);
+    if (it == coords.end()) {
+      return false;
+    }
+    next = *it;
+    return true;
+  }
+
+  VTR_ASSERT(NEGATIVE_DIR == direction);
+  auto it = std::lower_bound(coords.begin(), coords.end(), start);
+  if (it == coords.begin()) {
+    return false;
+  }
+  next = *(it - 1);
+  return true;
+}
+
+/********************************************************************
+ * Find the coordinate of a core grid with a given type in a column,
+ * which is the bottom-most one, or the top-most one if required
+ * This function will return an invalid coordinate if the column
+ * does not contain such a grid
+ *******************************************************************/
+static 
+vtr::Point<size_t> find_core_grid_coordinate_in_column(const DeviceGrid& grids,
+                                                       const t_core_tile_type_index& type_index,
+                                                       t_physical_tile_type_ptr wanted_type,
+                                                       const size_t& ix,
+                                                       const bool& from_top) {
+  const std::vector<size_t>& ys = type_index.column_ys[wanted_type->index][ix];
+  if (true == ys.empty()) {
+    return vtr::Point<size_t>(grids.width(), grids.height()); 
+  }
+  return vtr::Point<size_t>(ix, true == from_top ? ys.back() : ys.front());
+}
+
+/********************************************************************
+ * Find the coordinate of a core grid with a given type in a row,
+ * which is the left-most one, or the right-most one if required
+ * This function will return an invalid coordinate if the row
+ * does not contain such a grid
+ *******************************************************************/
+static 
+vtr::Point<size_t> find_core_grid_coordinate_in_row(const DeviceGrid& grids,
+                                                    const t_core_tile_type_index& type_index,
+                                                    t_physical_tile_type_ptr wanted_type,
+                                                    const size_t& iy,
+                                                    const bool& from_right) {
+  const std::vector<size_t>& xs = type_index.row_xs[wanted_type->index][iy];
+  if (true == xs.empty()) {
+    return vtr::Point<size_t>(grids.width(), grids.height()); 
+  }
+  return vtr::Point<size_t>(true == from_right ? xs.back() : xs.front(), iy);
 }
 
 /********************************************************************
  * Find the coordinate of the destination clb/heterogeneous block
  * considering intra column/row direct connections in core grids
+ *
+ * Cross column connection:
+ * The next column may NOT have the grid type we want!
+ * Think about heterogeneous architecture!  
+ * The destination is in the nearest column containing the grid type 
+ * in the x-direction of the direct:
+ *
+ *      x      ...      nx 
+ *   +-----+
+ *   |Grid |  ----->
+ *   +-----+
+ *
+ * In this column, the destination is the bottom-most grid of the type,
+ * or the top-most one for positive y-direction:
+ *
+ *  +------+  
+ *  | Grid | ny
+ *  +------+
+ *     |     .
+ *     |     .
+ *     v     .
+ *  +------+
+ *  | Grid | 1
+ *  +------+
+ *
+ * Cross row connection is the counterpart, where the destination is
+ * in the nearest row in the y-direction of the direct,
+ * and is the left-most grid of the type in the row,
+ * or the right-most one for positive x-direction
  *******************************************************************/
 static 
 vtr::Point<size_t> find_inter_direct_destination_coordinate(const DeviceGrid& grids,
+                                                            const t_core_tile_type_index& type_index,
                                                             const vtr::Point<size_t>& src_coord,
-                                                            const std::string des_tile_type_name,
+                                                            t_physical_tile_type_ptr des_tile_type,
                                                             const ArchDirect& arch_direct,
                                                             const ArchDirectId& arch_direct_id) {
   vtr::Point<size_t> des_coord(grids.width(), grids.height());
 
-  std::vector<size_t> first_search_space;
-  std::vector<size_t> second_search_space;
-
-  /* Cross column connection from Bottom to Top on Right 
-   * The next column may NOT have the grid type we want!
-   * Think about heterogeneous architecture!  
-   * Our search space will start from the next column 
-   * and ends at the RIGHT side of fabric 
-   */
   if (INTER_COLUMN == arch_direct.type(arch_direct_id)) {
-    if (POSITIVE_DIR == arch_direct.x_dir(arch_direct_id)) {
-     /* Our first search space will be in x-direction:
-      *
-      *      x      ...      nx 
-      *   +-----+
-      *   |Grid |  ----->
-      *   +-----+
-      */
-      for (size_t ix = src_coord.x() + 1; ix < grids.width() - 1; ++ix) {
-        first_search_space.push_back(ix);
-      }
-    } else { 
-      VTR_ASSERT(NEGATIVE_DIR == arch_direct.x_dir(arch_direct_id));
-     /* Our first search space will be in x-direction:
-      *
-      *    1   ...      x    
-      *              +-----+
-      *     < -------|Grid | 
-      *              +-----+
-      */
-      for (size_t ix = src_coord.x() - 1; ix >= 1; --ix) {
-        first_search_space.push_back(ix);
-      }
-    }
-
-    /* Our second search space will be in y-direction:
-     *
-     *  +------+  
-     *  | Grid | ny
-     *  +------+
-     *     ^     .
-     *     |     .
-     *     |     .
-     *  +------+
-     *  | Grid | 1
-     *  +------+
-     */
-    for (size_t iy = 1 ; iy < grids.height() - 1; ++iy) {
-      second_search_space.push_back(iy);
-    }
-
-    /* For negative direction, our second search space will be in y-direction:
-     *
-     *  +------+  
-     *  | Grid | ny
-     *  +------+
-     *     |     .
-     *     |     .
-     *     v     .
-     *  +------+
-     *  | Grid | 1
-     *  +------+
-     */
-    if (POSITIVE_DIR == arch_direct.y_dir(arch_direct_id)) {
-      std::reverse(second_search_space.begin(), second_search_space.end());
-    }
-  }
-
-
-  /* Cross row connection from Bottom to Top on Right 
-   * The next column may NOT have the grid type we want!
-   * Think about heterogeneous architecture!  
-   * Our search space will start from the next column 
-   * and ends at the RIGHT side of fabric 
-   */
-  if (INTER_ROW == arch_direct.type(arch_direct_id)) {
-    if (POSITIVE_DIR == arch_direct.y_dir(arch_direct_id)) {
-     /* Our first search space will be in y-direction:
-      *
-      *  +------+  
-      *  | Grid | ny
-      *  +------+
-      *     ^     .
-      *     |     .
-      *     |     .
-      *  +------+
-      *  | Grid | y
-      *  +------+
-      */
-      for (size_t iy = src_coord.y() + 1; iy < grids.height() - 1; ++iy) {
-        first_search_space.push_back(iy);
-      }
-    } else { 
-      VTR_ASSERT(NEGATIVE_DIR == arch_direct.y_dir(arch_direct_id));
-      /* For negative y-direction,
-       * Our first search space will be in y-direction:
-       *
-       *  +------+  
-       *  | Grid | ny
-       *  +------+
-       *     |     .
-       *     |     .
-       *     v     .
-       *  +------+
-       *  | Grid | y
-       *  +------+
-       */
-      for (size_t iy = src_coord.y() - 1; iy >= 1; --iy) {
-        first_search_space.push_back(iy);
-      }
-    }
-
-    /* Our second search space will be in x-direction:
-     *
-     *     1      ...     nx
-     *  +------+       +------+
-     *  | Grid |<------| Grid |
-     *  +------+       +------+
-     */
-    for (size_t ix = 1 ; ix < grids.width() - 1; ++ix) {
-      second_search_space.push_back(ix);
-    }
-
-    /* For negative direction,
-     * our second search space will be in x-direction:
-     *
-     *     1      ...     nx
-     *  +------+       +------+
-     *  | Grid |------>| Grid |
-     *  +------+       +------+
-     */
-    if (POSITIVE_DIR == arch_direct.x_dir(arch_direct_id)) {
-      std::reverse(second_search_space.begin(), second_search_space.end());
+    size_t des_x;
+    if (false == find_next_sorted_coordinate(type_index.type_columns[des_tile_type->index],
+                                             src_coord.x(), arch_direct.x_dir(arch_direct_id),
+                                             des_x)) {
+      return des_coord;
     }
+    return find_core_grid_coordinate_in_column(grids, type_index, des_tile_type, des_x,
+                                               POSITIVE_DIR == arch_direct.y_dir(arch_direct_id));
   }
 
-  for (size_t ix : first_search_space) {
-    std::vector<vtr::Point<size_t>> next_col_row_coords;
-    for (size_t iy : second_search_space) {
-      if (INTER_COLUMN == arch_direct.type(arch_direct_id)) {
-        next_col_row_coords.push_back(vtr::Point<size_t>(ix, iy));
-      } else {
-        VTR_ASSERT(INTER_ROW == arch_direct.type(arch_direct_id));
-        /* For cross-row connection, our search space is flipped */
-        next_col_row_coords.push_back(vtr::Point<size_t>(iy, ix));
-      }
-    }
-    vtr::Point<size_t> des_coord_cand = find_grid_coordinate_given_type(grids, next_col_row_coords, des_tile_type_name); 
-    /* For a valid coordinate, we can return */
-    if (true == is_grid_coordinate_exist_in_device(grids, des_coord_cand)) {
-      return des_coord_cand;
-    }
+  VTR_ASSERT(INTER_ROW == arch_direct.type(arch_direct_id));
+  size_t des_y;
+  if (false == find_next_sorted_coordinate(type_index.type_rows[des_tile_type->index],
+                                           src_coord.y(), arch_direct.y_dir(arch_direct_id),
+                                           des_y)) {
+    return des_coord;
   }
-  return des_coord;
+  return find_core_grid_coordinate_in_row(grids, type_index, des_tile_type, des_y,
+                                          POSITIVE_DIR == arch_direct.x_dir(arch_direct_id));
 }
 
 /***************************************************************************************
@@ -522,6 +516,7 @@ static
 void build_inter_column_row_tile_direct(TileDirect& tile_direct,
                                         const t_direct_inf& vpr_direct,
                                         const DeviceContext& device_ctx,
+                                        const t_core_tile_type_index& type_index,
                                         const ArchDirect& arch_direct,
                                         const ArchDirectId& arch_direct_id,
                                         const bool& verbose) {
@@ -541,6 +536,14 @@ void build_inter_column_row_tile_direct(TileDirect& tile_direct,
     && (INTER_ROW != arch_direct.type(arch_direct_id))) {
     return;
   }
+
+  /* Tile names which do not match any tile type cannot be connected */
+  t_physical_tile_type_ptr from_tile_type = find_tile_type_by_name(from_tile_name, device_ctx.physical_tile_types);
+  t_physical_tile_type_ptr to_tile_type = find_tile_type_by_name(to_tile_name, device_ctx.physical_tile_types);
+  if ((nullptr == from_tile_type) || (nullptr == to_tile_type)) {
+    return;
+  }
+
   /* For cross-column connection, we will search the first valid grid in each column 
    * from y = 1 to y = ny
    *
@@ -557,23 +560,14 @@ void build_inter_column_row_tile_direct(TileDirect& tile_direct,
    * 
    */
   if (INTER_COLUMN == arch_direct.type(arch_direct_id)) {
-    for (size_t ix = 1; ix < device_ctx.grid.width() - 1; ++ix) {
-      std::vector<vtr::Point<size_t>> next_col_src_grid_coords;
-      /* For negative y- direction, we should start from y = ny */
-      for (size_t iy = 1; iy < device_ctx.grid.height() - 1; ++iy) {
-        next_col_src_grid_coords.push_back(vtr::Point<size_t>(ix, iy));
-      }
-      /* For positive y- direction, we should start from y = 1 */
-      if (NEGATIVE_DIR == arch_direct.y_dir(arch_direct_id)) {
-        std::reverse(next_col_src_grid_coords.begin(), next_col_src_grid_coords.end());
-      }
-
-      /* Bypass the grid that does not fit the from_tile name */
-      vtr::Point<size_t> from_grid_coord = find_grid_coordinate_given_type(device_ctx.grid, next_col_src_grid_coords, from_tile_name); 
-      /* Skip if we do not have a valid coordinate for source CLB/heterogeneous block */
-      if (false == is_grid_coordinate_exist_in_device(device_ctx.grid, from_grid_coord)) {
-        continue;
-      }
+    /* Bypass the columns that do not contain the from_tile type */
+    for (const size_t& ix : type_index.type_columns[from_tile_type->index]) {
+      /* For negative y- direction, we should start from y = ny
+       * For positive y- direction, we should start from y = 1 
+       */
+      vtr::Point<size_t> from_grid_coord = find_core_grid_coordinate_in_column(device_ctx.grid, type_index, from_tile_type, ix,
+                                                                               NEGATIVE_DIR == arch_direct.y_dir(arch_direct_id)); 
+      VTR_ASSERT(true == is_grid_coordinate_exist_in_device(device_ctx.grid, from_grid_coord));
 
       /* Search all the sides, the from pin may locate any side!
        * Note: the vpr_direct.from_side is NUM_SIDES, which is unintialized
@@ -593,7 +587,7 @@ void build_inter_column_row_tile_direct(TileDirect& tile_direct,
         }
 
         /* For a valid coordinate, we can find the coordinate of the destination clb */
-         vtr::Point<size_t> to_grid_coord = find_inter_direct_destination_coordinate(device_ctx.grid, from_grid_coord, to_tile_name, arch_direct, arch_direct_id);
+         vtr::Point<size_t> to_grid_coord = find_inter_direct_destination_coordinate(device_ctx.grid, type_index, from_grid_coord, to_tile_type, arch_direct, arch_direct_id);
          /* If destination clb is valid, we should add something */
         if (false == is_grid_coordinate_exist_in_device(device_ctx.grid, to_grid_coord)) {
            continue;
@@ -661,22 +655,14 @@ void build_inter_column_row_tile_direct(TileDirect& tile_direct,
    *   +------+               +------+
    * 
    */
-  for (size_t iy = 1; iy < device_ctx.grid.height() - 1; ++iy) {
-    std::vector<vtr::Point<size_t>> next_col_src_grid_coords;
-    /* For negative x- direction, we should start from x = nx */
-    for (size_t ix = 1; ix < device_ctx.grid.width() - 1; ++ix) {
-      next_col_src_grid_coords.push_back(vtr::Point<size_t>(ix, iy));
-    }
-    /* For positive x- direction, we should start from x = 1 */
-    if (POSITIVE_DIR == arch_direct.x_dir(arch_direct_id)) {
-      std::reverse(next_col_src_grid_coords.begin(), next_col_src_grid_coords.end());
-    }
-
-    vtr::Point<size_t> from_grid_coord = find_grid_coordinate_given_type(device_ctx.grid, next_col_src_grid_coords, from_tile_name); 
-    /* Skip if we do not have a valid coordinate for source CLB/heterogeneous block */
-    if (false == is_grid_coordinate_exist_in_device(device_ctx.grid, from_grid_coord)) {
-      continue;
-    }
+  /* Bypass the rows that do not contain the from_tile type */
+  for (const size_t& iy : type_index.type_rows[from_tile_type->index]) {
+    /* For positive x- direction, we should start from x = nx
+     * For negative x- direction, we should start from x = 1 
+     */
+    vtr::Point<size_t> from_grid_coord = find_core_grid_coordinate_in_row(device_ctx.grid, type_index, from_tile_type, iy,
+                                                                          POSITIVE_DIR == arch_direct.x_dir(arch_direct_id)); 
+    VTR_ASSERT(true == is_grid_coordinate_exist_in_device(device_ctx.grid, from_grid_coord));
 
     /* Search all the sides, the from pin may locate any side!
      * Note: the vpr_direct.from_side is NUM_SIDES, which is unintialized
@@ -696,7 +682,7 @@ void build_inter_column_row_tile_direct(TileDirect& tile_direct,
       }
 
       /* For a valid coordinate, we can find the coordinate of the destination clb */
-      vtr::Point<size_t> to_grid_coord = find_inter_direct_destination_coordinate(device_ctx.grid, from_grid_coord, to_tile_name, arch_direct, arch_direct_id);
+      vtr::Point<size_t> to_grid_coord = find_inter_direct_destination_coordinate(device_ctx.grid, type_index, from_grid_coord, to_tile_type, arch_direct, arch_direct_id);
       /* If destination clb is valid, we should add something */
       if (false == is_grid_coordinate_exist_in_device(device_ctx.grid, to_grid_coord)) {
         continue;
@@ -763,6 +749,9 @@ TileDirect build_device_tile_direct(const DeviceContext& device_ctx,
 
   TileDirect tile_direct;
 
+  /* The tile types in the core grids are indexed once for all the inter-column/row directs */
+  t_core_tile_type_index type_index = build_core_tile_type_index(device_ctx);
+
   /* Walk through each direct definition in the VPR arch */
   for (int idirect = 0; idirect < device_ctx.arch->num_directs; ++idirect) {
     ArchDirectId arch_direct_id = arch_direct.direct(std::string(device_ctx.arch->Directs[idirect].name));
@@ -781,6 +770,7 @@ TileDirect build_device_tile_direct(const DeviceContext& device_ctx,
     build_inter_column_row_tile_direct(tile_direct,
                                        device_ctx.arch->Directs[idirect],
                                        device_ctx,
+                                       type_index,
                                        arch_direct,
                                        arch_direct_id,
                                        verbose);
@@ -0,0 +1,71 @@
+/********************************************************************
+ * This file includes most utilized functions for the shards of a device,
+ * i.e., windows of grid coordinates in which a part of the fabric netlists
+ * and bitstream is generated, so that a fabric can be split across hosts.
+ *
+ * A shard region is inclusive on all its sides, and covers
+ *  - the grids whose (x, y) are in the region
+ *  - the General Switch Blocks (GSBs) whose (x, y) are in the region,
+ *    i.e., the switch block and the connection blocks of each GSB
+ *******************************************************************/
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_tokenizer.h"
+
+#include "device_shard_utils.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * The shard region covering the whole device
+ *******************************************************************/
+vtr::Rect<size_t> find_device_full_shard_region(const DeviceGrid& grids) {
+  return vtr::Rect<size_t>(0, 0, grids.width() - 1, grids.height() - 1);
+}
+
+/********************************************************************
+ * Identify if a shard region covers the whole device
+ *******************************************************************/
+bool is_device_full_shard_region(const DeviceGrid& grids,
+                                 const vtr::Rect<size_t>& shard_region) {
+  return (true == shard_region.coincident(vtr::Point<size_t>(0, 0)))
+      && (true == shard_region.coincident(vtr::Point<size_t>(grids.width() - 1, grids.height() - 1)));
+}
+
+/********************************************************************
+ * Parse a shard region in the format of 'xlow,ylow,xhigh,yhigh'
+ * Return false if the region is not valid
+ *******************************************************************/
+bool parse_device_shard_region(const std::string& region_spec,
+                               vtr::Rect<size_t>& shard_region) {
+  StringToken region_tokenizer(region_spec);
+  std::vector<std::string> bounds = region_tokenizer.split(',');
+  bool valid_region = (4 == bounds.size());
+  for (const std::string& bound : bounds) {
+    if ( (true == bound.empty())
+      || (std::string::npos != bound.find_first_not_of("0123456789")) ) {
+      valid_region = false;
+    }
+  }
+  if (false == valid_region) {
+    VTR_LOG_ERROR("Invalid shard region '%s' which should be in the format of 'xlow,ylow,xhigh,yhigh'!\n",
+                  region_spec.c_str());
+    return false;
+  }
+
+  shard_region = vtr::Rect<size_t>(std::stoul(bounds[0]), std::stoul(bounds[1]),
+                                   std::stoul(bounds[2]), std::stoul(bounds[3]));
+  if ( (shard_region.xmin() > shard_region.xmax())
+    || (shard_region.ymin() > shard_region.ymax()) ) {
+    VTR_LOG_ERROR("Invalid shard region '%s' whose lower bounds exceed its upper bounds!\n",
+                  region_spec.c_str());
+    return false;
+  }
+  return true;
+}
+
+} /* end namespace openfpga */
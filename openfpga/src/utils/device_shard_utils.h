@@ -0,0 +1,28 @@
+#ifndef DEVICE_SHARD_UTILS_H
+#define DEVICE_SHARD_UTILS_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "vtr_geometry.h"
+#include "device_grid.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+vtr::Rect<size_t> find_device_full_shard_region(const DeviceGrid& grids);
+
+bool is_device_full_shard_region(const DeviceGrid& grids,
+                                 const vtr::Rect<size_t>& shard_region);
+
+bool parse_device_shard_region(const std::string& region_spec,
+                               vtr::Rect<size_t>& shard_region);
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,177 @@
+/********************************************************************
+ * This file includes functions to find the instances of the top-level
+ * module which are in the cone of influence of an implemented benchmark,
+ * i.e., the tiles, switch blocks and connection blocks it uses
+ *******************************************************************/
+#include <string>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_side_manager.h"
+#include "openfpga_reserved_words.h"
+
+/* Headers from vpr library */
+#include "vpr_utils.h"
+
+#include "openfpga_naming.h"
+
+#include "fabric_cone_of_influence_utils.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Identify if a routing resource node is used by any net
+ *******************************************************************/
+static 
+bool is_rr_node_routed(const VprRoutingAnnotation& routing_annotation,
+                       const RRNodeId& rr_node) {
+  return ClusterNetId::INVALID() != routing_annotation.rr_node_net(rr_node);
+}
+
+/********************************************************************
+ * Identify if a switch block is used, i.e., any routing track
+ * on any of its sides is routed
+ *******************************************************************/
+static 
+bool is_rr_gsb_sb_used(const RRGSB& rr_gsb,
+                       const VprRoutingAnnotation& routing_annotation) {
+  for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+    SideManager side_manager(side);
+    for (size_t itrack = 0; itrack < rr_gsb.get_chan_width(side_manager.get_side()); ++itrack) {
+      if (true == is_rr_node_routed(routing_annotation, rr_gsb.get_chan_node(side_manager.get_side(), itrack))) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/********************************************************************
+ * Identify if a connection block is used, i.e., any of its routing tracks,
+ * which are passed through to the next switch block, or any of its input pins
+ * is routed
+ *******************************************************************/
+static 
+bool is_rr_gsb_cb_used(const RRGSB& rr_gsb,
+                       const t_rr_type& cb_type,
+                       const VprRoutingAnnotation& routing_annotation) {
+  e_side cb_chan_side = rr_gsb.get_cb_chan_side(cb_type);
+  for (size_t itrack = 0; itrack < rr_gsb.get_cb_chan_width(cb_type); ++itrack) {
+    if (true == is_rr_node_routed(routing_annotation, rr_gsb.get_chan_node(cb_chan_side, itrack))) {
+      return true;
+    }
+  }
+  for (const e_side& cb_ipin_side : rr_gsb.get_cb_ipin_sides(cb_type)) {
+    for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(cb_ipin_side); ++inode) {
+      if (true == is_rr_node_routed(routing_annotation, rr_gsb.get_ipin_node(cb_ipin_side, inode))) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/********************************************************************
+ * Find the child module and the instance of the top-level module
+ * with a given instance name, and remove the instance from the cone
+ *******************************************************************/
+static 
+void remove_top_module_instance_from_cone(std::map<ModuleId, std::vector<bool>>& kept_instances,
+                                          const std::map<std::string, std::pair<ModuleId, size_t>>& instance_lookup,
+                                          const std::string& instance_name) {
+  auto it = instance_lookup.find(instance_name);
+  VTR_ASSERT(instance_lookup.end() != it);
+  kept_instances[it->second.first][it->second.second] = false;
+}
+
+/********************************************************************
+ * Find the instances of the top-level module which are in the cone of
+ * influence of the implemented benchmark:
+ * - the grids where clustered blocks are placed
+ * - the switch blocks and connection blocks where any routing resource is used
+ * The other grid, switch block and connection block instances do not
+ * contribute to the benchmark I/Os and can be removed from the fabric
+ * when the fabric is only used for formal verification.
+ * Other instances of the top-level module (e.g., configuration decoders)
+ * are always kept.
+ *
+ * Return the flags of the instances of each child module of the top-level module,
+ * which are true for the instances to be kept
+ *******************************************************************/
+std::map<ModuleId, std::vector<bool>> find_top_module_cone_of_influence_instances(const ModuleManager& module_manager,
+                                                                                  const ModuleId& top_module,
+                                                                                  const DeviceGrid& grids,
+                                                                                  const PlacementContext& place_ctx,
+                                                                                  const DeviceRRGSB& device_rr_gsb,
+                                                                                  const VprRoutingAnnotation& routing_annotation) {
+  std::map<ModuleId, std::vector<bool>> kept_instances;
+  std::map<std::string, std::pair<ModuleId, size_t>> instance_lookup;
+  for (const ModuleId& child_module : module_manager.child_modules(top_module)) {
+    kept_instances[child_module].assign(module_manager.num_instance(top_module, child_module), true);
+    for (const size_t& instance : module_manager.child_module_instances(top_module, child_module)) {
+      instance_lookup[module_manager.instance_name(top_module, child_module, instance)] = std::make_pair(child_module, instance);
+    }
+  }
+
+  size_t num_removed_instances = 0;
+
+  /* Grids: only the roots of the non-empty grids are instanciated */
+  vtr::Point<size_t> device_size(grids.width(), grids.height());
+  for (size_t ix = 0; ix < grids.width(); ++ix) {
+    for (size_t iy = 0; iy < grids.height(); ++iy) {
+      if ( (true == is_empty_type(grids[ix][iy].type))
+        || (0 < grids[ix][iy].width_offset)
+        || (0 < grids[ix][iy].height_offset) ) {
+        continue;
+      }
+      if (0 < place_ctx.grid_blocks[ix][iy].usage) {
+        continue;
+      }
+      vtr::Point<size_t> grid_coord(ix, iy);
+      e_side border_side = NUM_SIDES;
+      if (true == is_io_type(grids[ix][iy].type)) {
+        border_side = find_grid_border_side(device_size, grid_coord);
+      }
+      std::string instance_name = generate_grid_block_instance_name(std::string(GRID_MODULE_NAME_PREFIX),
+                                                                    std::string(grids[ix][iy].type->name),
+                                                                    is_io_type(grids[ix][iy].type),
+                                                                    border_side, grid_coord);
+      remove_top_module_instance_from_cone(kept_instances, instance_lookup, instance_name);
+      num_removed_instances++;
+    }
+  }
+
+  /* Switch blocks and connection blocks */
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+      if ( (true == rr_gsb.is_sb_exist())
+        && (false == is_rr_gsb_sb_used(rr_gsb, routing_annotation)) ) {
+        std::string instance_name = generate_switch_block_module_name(vtr::Point<size_t>(rr_gsb.get_sb_x(), rr_gsb.get_sb_y()));
+        remove_top_module_instance_from_cone(kept_instances, instance_lookup, instance_name);
+        num_removed_instances++;
+      }
+      for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+        if ( (false == rr_gsb.is_cb_exist(cb_type))
+          || (true == is_rr_gsb_cb_used(rr_gsb, cb_type, routing_annotation)) ) {
+          continue;
+        }
+        std::string instance_name = generate_connection_block_module_name(cb_type, vtr::Point<size_t>(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type)));
+        remove_top_module_instance_from_cone(kept_instances, instance_lookup, instance_name);
+        num_removed_instances++;
+      }
+    }
+  }
+
+  VTR_LOG("Removed %lu instances out of the cone of influence of the implemented benchmark\n",
+          num_removed_instances);
+
+  return kept_instances;
+}
+
+} /* end namespace openfpga */
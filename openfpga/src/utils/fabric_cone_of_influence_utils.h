@@ -0,0 +1,31 @@
+#ifndef FABRIC_CONE_OF_INFLUENCE_UTILS_H
+#define FABRIC_CONE_OF_INFLUENCE_UTILS_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <map>
+#include <vector>
+#include "vpr_context.h"
+#include "device_grid.h"
+#include "device_rr_gsb.h"
+#include "vpr_routing_annotation.h"
+#include "module_manager.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+std::map<ModuleId, std::vector<bool>> find_top_module_cone_of_influence_instances(const ModuleManager& module_manager,
+                                                                                  const ModuleId& top_module,
+                                                                                  const DeviceGrid& grids,
+                                                                                  const PlacementContext& place_ctx,
+                                                                                  const DeviceRRGSB& device_rr_gsb,
+                                                                                  const VprRoutingAnnotation& routing_annotation);
+
+} /* end namespace openfpga */
+
+#endif
@@ -2,7 +2,9 @@
  * This file includes most utilized functions to manipulate LUTs, 
  * especially their truth tables, in the OpenFPGA context
  *******************************************************************/
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -53,11 +55,13 @@ namespace openfpga {
 AtomNetlist::TruthTable lut_truth_table_adaption(const AtomNetlist::TruthTable& orig_tt, 
                                                  const std::vector<int>& rotated_pin_map) {
   AtomNetlist::TruthTable tt;
+  tt.reserve(orig_tt.size());
 
-  for (auto row : orig_tt) {
+  for (const std::vector<vtr::LogicValue>& row : orig_tt) {
     VTR_ASSERT(row.size() - 1 <= rotated_pin_map.size());
 
     std::vector<vtr::LogicValue> tt_line;
+    tt_line.reserve(rotated_pin_map.size() + 1);
     /* We do not care about the last digit, which is the output value */
     for (size_t i = 0; i < rotated_pin_map.size(); ++i) {
       if (-1 == rotated_pin_map[i]) {
@@ -71,7 +75,7 @@ AtomNetlist::TruthTable lut_truth_table_adaption(const AtomNetlist::TruthTable&
 
     /* Do not miss the last digit in the final result */
     tt_line.push_back(row.back());
-    tt.push_back(tt_line);
+    tt.push_back(std::move(tt_line));
   }
 
   return tt;
@@ -189,6 +193,13 @@ AtomNetlist::TruthTable adapt_truth_table_for_frac_lut(const size_t& lut_frac_le
   }
 
   AtomNetlist::TruthTable adapt_truth_table;
+  adapt_truth_table.reserve(truth_table.size());
+
+  /* The mask bits only depend on the size of truth table lines,
+   * so they are decoded only when the size changes
+   */
+  size_t mask_lut_size = size_t(-1);
+  std::vector<vtr::LogicValue> mask_logic_vals;
 
   /* Apply modification to the truth table */
   for (const std::vector<vtr::LogicValue>& tt_line : truth_table) {
@@ -205,24 +216,25 @@ AtomNetlist::TruthTable adapt_truth_table_for_frac_lut(const size_t& lut_frac_le
     }
     /* Modify bits starting from lut_frac_level */
     /* Decode the lut_output_mask to LUT input codes */ 
-    int temp = pow(2., num_mask_bits) - 1 - lut_output_mask;
-    VTR_ASSERT(0 <= temp);
-    std::vector<size_t> mask_bits_vec = itobin_vec(temp, num_mask_bits);
-    /* Copy the bits to the truth table line */
-    std::vector<vtr::LogicValue> adapt_tt_line = tt_line;
-    for (size_t itt = lut_frac_level; itt < lut_frac_level + mask_bits_vec.size(); ++itt) { 
-      
-      vtr::LogicValue logic_val = vtr::LogicValue::FALSE;
-      VTR_ASSERT( (1 == mask_bits_vec[itt - lut_frac_level])
-               || (0 == mask_bits_vec[itt - lut_frac_level]) );
-      if (1 == mask_bits_vec[itt - lut_frac_level]) {
-        logic_val = vtr::LogicValue::TRUE;
+    if (lut_size != mask_lut_size) {
+      int temp = pow(2., num_mask_bits) - 1 - lut_output_mask;
+      VTR_ASSERT(0 <= temp);
+      std::vector<size_t> mask_bits_vec = itobin_vec(temp, num_mask_bits);
+      mask_logic_vals.clear();
+      for (const size_t& mask_bit : mask_bits_vec) {
+        VTR_ASSERT( (1 == mask_bit) || (0 == mask_bit) );
+        if (1 == mask_bit) {
+          mask_logic_vals.push_back(vtr::LogicValue::TRUE);
+        } else {
+          mask_logic_vals.push_back(vtr::LogicValue::FALSE);
+        }
       }
-      adapt_tt_line[itt] = logic_val;
+      mask_lut_size = lut_size;
     }
-
-    /* Push to adapted truth table */
-    adapt_truth_table.push_back(adapt_tt_line);
+    /* Copy the bits to the truth table line */
+    adapt_truth_table.push_back(tt_line);
+    std::copy(mask_logic_vals.begin(), mask_logic_vals.end(),
+              adapt_truth_table.back().begin() + lut_frac_level);
   }
 
   return adapt_truth_table;
@@ -264,122 +276,33 @@ bool lut_truth_table_use_on_set(const AtomNetlist::TruthTable& truth_table) {
 }
 
 /********************************************************************
- * Complete a line in truth table with a given lut size
- * Due to the size of truth table may be less than the lut size.
- * i.e. in LUT-6 architecture, there exists LUT1-6 in technology-mapped netlists
- * So, in truth table line, there may be 10- 1
- * In this case, we should complete it by --10- 1
+ * The bits of the SRAM ids where an input of a LUT is '0', 
+ * for the lowest 6 inputs within a 64-bit word of a packed bitstream
+ * We assume the 1-lut pass sram1 when input = 0, 
+ * so the input of index i is '0' for the SRAM ids whose i-th bit is '1'
  *******************************************************************/
-static 
-std::vector<vtr::LogicValue> complete_truth_table_line(const size_t& lut_size,
-                                                       const std::vector<vtr::LogicValue>& tt_line) {
-  std::vector<vtr::LogicValue> ret;
-
-  VTR_ASSERT(0 < tt_line.size());
-
-  /* Complete the truth table line*/
-  size_t cover_len = tt_line.size() - 1; 
-  VTR_ASSERT(cover_len <= lut_size);
-
-  /* Copy the original truth table line */ 
-  ret = tt_line;
-  /* Kick out the last value for now as it is the output value */
-  ret.pop_back();
-
-  /* Add the number of '-' we should add in the back !!! */
-  for (size_t j = cover_len; j < lut_size; ++j) {
-    ret.push_back(vtr::LogicValue::DONT_CARE);
-  }
-
-  /* Copy the original truth table line */ 
-  ret.push_back(tt_line.back());
-
-  /* Check if the size of ret matches our expectation */
-  VTR_ASSERT(lut_size + 1 == ret.size());
-  
-  return ret;
-}
-
-/********************************************************************
- * For each lut_bit_lines, we should recover the truth table,
- * and then set the sram bits to "1" if the truth table defines so.
- * Start_point: the position we start converting don't care sign '-'
- *              to explicit '0' or '1'
- *******************************************************************/
-static 
-void rec_build_lut_bitstream_per_line(std::vector<bool>& lut_bitstream, 
-                                      const size_t& lut_size,
-                                      const std::vector<vtr::LogicValue>& tt_line,
-                                      const size_t& start_point) {
-  std::vector<vtr::LogicValue> temp_line = tt_line;
-
-  /* Check the length of sram bits and truth table line */
-  VTR_ASSERT(lut_size + 1 == tt_line.size()); /* lut_size + '1|0' */
-
-  /* End of truth_table_line should be "space" and "1" */ 
-  VTR_ASSERT( (vtr::LogicValue::TRUE == tt_line.back())
-           || (vtr::LogicValue::FALSE == tt_line.back()) );
-
-  /* Make sure before start point there is no '-' */
-  VTR_ASSERT(start_point < tt_line.size());
-  for (size_t i = 0; i < start_point; ++i) {
-    VTR_ASSERT(vtr::LogicValue::DONT_CARE != tt_line[i]);
-  }
-
-  /* Configure sram bits recursively */
-  for (size_t i = start_point; i < lut_size; ++i) {
-    if (vtr::LogicValue::DONT_CARE == tt_line[i]) {
-      /* if we find a dont_care, we don't do configure now but recursively*/
-      /* '0' branch */
-      temp_line[i] = vtr::LogicValue::FALSE; 
-      rec_build_lut_bitstream_per_line(lut_bitstream, lut_size, temp_line, start_point + 1);
-      /* '1' branch */
-      temp_line[i] = vtr::LogicValue::TRUE; 
-      rec_build_lut_bitstream_per_line(lut_bitstream, lut_size, temp_line, start_point + 1);
-      return; 
-    }
-  }
-
-  /* TODO: Use MuxGraph to decode this!!! */
-  /* Decode bitstream only when there are only 0 or 1 in the truth table */
-  size_t sram_id = 0;
-  for (size_t i = 0; i < lut_size; ++i) {
-    /* Should be either '0' or '1' */
-    switch (tt_line[i]) {
-    case vtr::LogicValue::FALSE :
-      /* We assume the 1-lut pass sram1 when input = 0 */
-      sram_id += (size_t)pow(2., (double)(i));
-      break;
-    case vtr::LogicValue::TRUE :
-      /* We assume the 1-lut pass sram0 when input = 1 */
-      break;
-    case vtr::LogicValue::DONT_CARE :
-    default :
-      VTR_LOGF_ERROR(__FILE__, __LINE__, 
-                     "Invalid truth_table bit '%s', should be [0|1|]!\n",
-                     vtr::LOGIC_VALUE_STRING[size_t(tt_line[i])]); 
-      exit(1);
-    }
-  }
-  /* Set the sram bit to '1'*/
-  VTR_ASSERT(sram_id < lut_bitstream.size());
-  if (vtr::LogicValue::TRUE == tt_line.back()) {
-    lut_bitstream[sram_id] = true; /* on set*/
-  } else if (vtr::LogicValue::FALSE == tt_line.back()) {
-    lut_bitstream[sram_id] = false; /* off set */
-  } else {
-    VTR_LOGF_ERROR(__FILE__, __LINE__, 
-                   "Invalid truth_table_line ending '%s'!\n",
-                   vtr::LOGIC_VALUE_STRING[size_t(tt_line.back())]);
-    exit(1);
-  }
-}
+static constexpr size_t LUT_BITSTREAM_WORD_SIZE = 6;
+static constexpr uint64_t LUT_BITSTREAM_INPUT_FALSE_MASKS[LUT_BITSTREAM_WORD_SIZE] = {
+  0xAAAAAAAAAAAAAAAAULL,
+  0xCCCCCCCCCCCCCCCCULL,
+  0xF0F0F0F0F0F0F0F0ULL,
+  0xFF00FF00FF00FF00ULL,
+  0xFFFF0000FFFF0000ULL,
+  0xFFFFFFFF00000000ULL
+};
 
 /********************************************************************
  * Generate the bitstream for a single-output LUT with a given truth table
  * As truth tables may come from different logic blocks, truth tables could be in on and off sets
  * We first build a base SRAM bits, where different parts are set to tbe on/off sets 
  * Then, we can decode SRAM bits as regular process 
+ *
+ * The bitstream is packed in 64-bit words, so that each truth table line
+ * is applied to 64 SRAM bits at a time without expanding its don't care inputs:
+ *   - the lowest 6 inputs select the bits in a word, 
+ *     whose mask is the intersection of the masks of the inputs
+ *   - the other inputs select the words
+ * Truth table lines which are shorter than the LUT size are completed by don't care inputs
  *******************************************************************/
 static 
 std::vector<bool> build_single_output_lut_bitstream(const AtomNetlist::TruthTable& truth_table,
@@ -387,8 +310,6 @@ std::vector<bool> build_single_output_lut_bitstream(const AtomNetlist::TruthTabl
                                                     const size_t& default_sram_bit_value) {
   size_t lut_size = lut_mux_graph.num_memory_bits();
   size_t bitstream_size = lut_mux_graph.num_inputs();
-  std::vector<bool> lut_bitstream(bitstream_size, false);
-  AtomNetlist::TruthTable completed_truth_table;
   bool on_set = false;
   bool off_set = false;
 
@@ -413,25 +334,90 @@ std::vector<bool> build_single_output_lut_bitstream(const AtomNetlist::TruthTabl
     on_set = lut_truth_table_use_on_set(truth_table);
     off_set = !on_set;
   }
+  VTR_ASSERT(on_set == !off_set);
+
+  /* Initial all the bits in the bitstream 
+   * By default, the lut_bitstream is initialize for on_set
+   * For off set, it should be flipped
+   */
+  std::vector<uint64_t> lut_words((bitstream_size + 63) / 64, 0);
+  if (true == off_set) {
+    std::fill(lut_words.begin(), lut_words.end(), ~uint64_t(0));
+  }
+
+  /* The SRAM ids are encoded by the inputs in 64-bit integers */
+  VTR_ASSERT(lut_size < 64);
 
   /* Read in truth table lines, decode one by one */
   for (const std::vector<vtr::LogicValue>& tt_line : truth_table) {
-    /* Complete the truth table line by line*/
-    completed_truth_table.push_back(complete_truth_table_line(lut_size, tt_line));
-  }
+    VTR_ASSERT(0 < tt_line.size());
+    size_t cover_len = tt_line.size() - 1; 
+    VTR_ASSERT(cover_len <= lut_size);
+
+    /* Find the inputs to be fixed, and the SRAM id bits they are fixed to */
+    uint64_t care_mask = 0;
+    uint64_t care_value = 0;
+    for (size_t i = 0; i < cover_len; ++i) {
+      /* Should be either '0' or '1' or '-' */
+      switch (tt_line[i]) {
+      case vtr::LogicValue::FALSE :
+        /* We assume the 1-lut pass sram1 when input = 0 */
+        care_mask |= uint64_t(1) << i;
+        care_value |= uint64_t(1) << i;
+        break;
+      case vtr::LogicValue::TRUE :
+        /* We assume the 1-lut pass sram0 when input = 1 */
+        care_mask |= uint64_t(1) << i;
+        break;
+      case vtr::LogicValue::DONT_CARE :
+        break;
+      default :
+        VTR_LOGF_ERROR(__FILE__, __LINE__, 
+                       "Invalid truth_table bit '%s', should be [0|1|-]!\n",
+                       vtr::LOGIC_VALUE_STRING[size_t(tt_line[i])]); 
+        exit(1);
+      }
+    }
 
-  /* Initial all the bits in the bitstream */
-  if (true == off_set) {
-    /* By default, the lut_bitstream is initialize for on_set
-     * For off set, it should be flipped
-     */
-    lut_bitstream.clear(); 
-    lut_bitstream.resize(bitstream_size, true);
+    /* The bits in a word selected by the lowest inputs */
+    uint64_t word_mask = ~uint64_t(0);
+    for (size_t i = 0; i < std::min(cover_len, LUT_BITSTREAM_WORD_SIZE); ++i) {
+      if (0 == (care_mask & (uint64_t(1) << i))) {
+        continue;
+      }
+      if (0 == (care_value & (uint64_t(1) << i))) {
+        word_mask &= ~LUT_BITSTREAM_INPUT_FALSE_MASKS[i];
+      } else {
+        word_mask &= LUT_BITSTREAM_INPUT_FALSE_MASKS[i];
+      }
+    }
+
+    /* The words selected by the other inputs */
+    uint64_t word_care_mask = care_mask >> LUT_BITSTREAM_WORD_SIZE;
+    uint64_t word_care_value = care_value >> LUT_BITSTREAM_WORD_SIZE;
+
+    /* Set the sram bits to the output of the line */
+    for (size_t iword = 0; iword < lut_words.size(); ++iword) {
+      if (word_care_value != (iword & word_care_mask)) {
+        continue;
+      }
+      if (vtr::LogicValue::TRUE == tt_line.back()) {
+        lut_words[iword] |= word_mask; /* on set*/
+      } else if (vtr::LogicValue::FALSE == tt_line.back()) {
+        lut_words[iword] &= ~word_mask; /* off set */
+      } else {
+        VTR_LOGF_ERROR(__FILE__, __LINE__, 
+                       "Invalid truth_table_line ending '%s'!\n",
+                       vtr::LOGIC_VALUE_STRING[size_t(tt_line.back())]);
+        exit(1);
+      }
+    }
   }
 
-  for (const std::vector<vtr::LogicValue>& tt_line : completed_truth_table) {
-    /* Update the truth table, sram_bits */
-    rec_build_lut_bitstream_per_line(lut_bitstream, lut_size, tt_line, 0);
+  /* Unpack the bitstream */
+  std::vector<bool> lut_bitstream(bitstream_size, false);
+  for (size_t ibit = 0; ibit < bitstream_size; ++ibit) {
+    lut_bitstream[ibit] = (0 != (lut_words[ibit / 64] & (uint64_t(1) << (ibit % 64))));
   }
 
   return lut_bitstream;
@@ -451,7 +437,7 @@ std::vector<bool> build_frac_lut_bitstream(const CircuitLibrary& circuit_lib,
   /* Initialization */
   std::vector<bool> lut_bitstream(lut_mux_graph.num_inputs(), default_sram_bit_value);
 
-  for (const std::pair<const t_pb_graph_pin*, AtomNetlist::TruthTable>& element : truth_tables) {
+  for (const std::pair<const t_pb_graph_pin* const, AtomNetlist::TruthTable>& element : truth_tables) {
     /* Find the corresponding circuit model output port and assoicated lut_output_mask */
     CircuitPortId lut_model_output_port = device_annotation.pb_circuit_port(element.first->port);
     size_t lut_frac_level = circuit_lib.port_lut_frac_level(lut_model_output_port);
@@ -869,91 +869,128 @@ void add_module_nets_cmos_flatten_memory_config_bus(ModuleManager& module_manage
  *  For the rest of memory modules:
  *    net source is the configuration chain tail of the previous memory module
  *    net sink is the configuration chain head of the next memory module
+ *
+ *  When the configurable children are split into configuration regions,
+ *  a chain is built for each region, which starts from the i-th pin of
+ *  the configuration chain head and ends at the i-th pin of the configuration chain tail
+ *  of the primitive module, where i is the index of the region
+ *
+ *                    +--------+            +--------+
+ *  ccff_head[0] ---->| Memory |--->... --->| Memory |----> ccff_tail[0]
+ *                    +--------+            +--------+
+ *                       ...                   ...
+ *                    +--------+            +--------+
+ *  ccff_head[M-1] -->| Memory |--->... --->| Memory |----> ccff_tail[M-1]
+ *                    +--------+            +--------+
  *********************************************************************/
 void add_module_nets_cmos_memory_chain_config_bus(ModuleManager& module_manager,
                                                   const ModuleId& parent_module,
                                                   const e_config_protocol_type& sram_orgz_type) {
-  for (size_t mem_index = 0; mem_index < module_manager.configurable_children(parent_module).size(); ++mem_index) {
-    ModuleId net_src_module_id;
-    size_t net_src_instance_id;
-    ModulePortId net_src_port_id;
+  size_t num_regions = module_manager.num_config_regions(parent_module);
+  std::vector<ModuleId> configurable_children = module_manager.configurable_children(parent_module);
+  std::vector<size_t> configurable_child_instances = module_manager.configurable_child_instances(parent_module);
 
-    ModuleId net_sink_module_id;
-    size_t net_sink_instance_id;
-    ModulePortId net_sink_port_id;
+  for (size_t region = 0; region < num_regions; ++region) {
+    std::vector<size_t> region_children = module_manager.region_configurable_children(parent_module, region);
 
-    if (0 == mem_index) {
-      /* Find the port name of configuration chain head */
-      std::string src_port_name = generate_sram_port_name(sram_orgz_type, CIRCUIT_MODEL_PORT_INPUT);
-      net_src_module_id = parent_module; 
-      net_src_instance_id = 0;
-      net_src_port_id = module_manager.find_module_port(net_src_module_id, src_port_name); 
+    for (size_t mem_index = 0; mem_index < region_children.size(); ++mem_index) {
+      ModuleId net_src_module_id;
+      size_t net_src_instance_id;
+      ModulePortId net_src_port_id;
 
-      /* Find the port name of next memory module */
-      std::string sink_port_name = generate_configuration_chain_head_name();
-      net_sink_module_id = module_manager.configurable_children(parent_module)[mem_index]; 
-      net_sink_instance_id = module_manager.configurable_child_instances(parent_module)[mem_index];
-      net_sink_port_id = module_manager.find_module_port(net_sink_module_id, sink_port_name); 
-    } else {
-      /* Find the port name of previous memory module */
-      std::string src_port_name = generate_configuration_chain_tail_name();
-      net_src_module_id = module_manager.configurable_children(parent_module)[mem_index - 1]; 
-      net_src_instance_id = module_manager.configurable_child_instances(parent_module)[mem_index - 1];
-      net_src_port_id = module_manager.find_module_port(net_src_module_id, src_port_name); 
+      ModuleId net_sink_module_id;
+      size_t net_sink_instance_id;
+      ModulePortId net_sink_port_id;
+
+      /* Pins of the source port to be connected */
+      std::vector<size_t> net_src_pins;
+
+      if (0 == mem_index) {
+        /* Find the port name of configuration chain head */
+        std::string src_port_name = generate_sram_port_name(sram_orgz_type, CIRCUIT_MODEL_PORT_INPUT);
+        net_src_module_id = parent_module; 
+        net_src_instance_id = 0;
+        net_src_port_id = module_manager.find_module_port(net_src_module_id, src_port_name); 
+      } else {
+        /* Find the port name of previous memory module */
+        std::string src_port_name = generate_configuration_chain_tail_name();
+        net_src_module_id = configurable_children[region_children[mem_index - 1]]; 
+        net_src_instance_id = configurable_child_instances[region_children[mem_index - 1]];
+        net_src_port_id = module_manager.find_module_port(net_src_module_id, src_port_name); 
+      }
 
       /* Find the port name of next memory module */
       std::string sink_port_name = generate_configuration_chain_head_name();
-      net_sink_module_id = module_manager.configurable_children(parent_module)[mem_index]; 
-      net_sink_instance_id = module_manager.configurable_child_instances(parent_module)[mem_index];
+      net_sink_module_id = configurable_children[region_children[mem_index]]; 
+      net_sink_instance_id = configurable_child_instances[region_children[mem_index]];
       net_sink_port_id = module_manager.find_module_port(net_sink_module_id, sink_port_name); 
+
+      /* Get the pin id for source port */
+      BasicPort net_src_port = module_manager.module_port(net_src_module_id, net_src_port_id); 
+      /* Get the pin id for sink port */
+      BasicPort net_sink_port = module_manager.module_port(net_sink_module_id, net_sink_port_id); 
+
+      /* The head of the primitive module has a pin for each region */
+      if ( (0 == mem_index) && (1 < num_regions) ) {
+        VTR_ASSERT(num_regions == net_src_port.get_width());
+        VTR_ASSERT(1 == net_sink_port.get_width());
+        net_src_pins.push_back(net_src_port.pins()[region]);
+      } else {
+        /* Port sizes of source and sink should match */
+        VTR_ASSERT(net_src_port.get_width() == net_sink_port.get_width());
+        net_src_pins = net_src_port.pins();
+      }
+      
+      /* Create a net for each pin */
+      for (size_t pin_id = 0; pin_id < net_src_pins.size(); ++pin_id) {
+        /* Create a net and add source and sink to it */
+        ModuleNetId net = create_module_source_pin_net(module_manager, parent_module, net_src_module_id, net_src_instance_id, net_src_port_id, net_src_pins[pin_id]);
+        /* Add net sink */
+        module_manager.add_module_net_sink(parent_module, net, net_sink_module_id, net_sink_instance_id, net_sink_port_id, net_sink_port.pins()[pin_id]);
+      }
     }
 
+    /* For the last memory module:
+     *    net source is the configuration chain tail of the previous memory module
+     *    net sink is the configuration chain tail of the primitive module
+     */
+    /* Find the port name of previous memory module */
+    std::string src_port_name = generate_configuration_chain_tail_name();
+    ModuleId net_src_module_id = configurable_children[region_children.back()]; 
+    size_t net_src_instance_id = configurable_child_instances[region_children.back()];
+    ModulePortId net_src_port_id = module_manager.find_module_port(net_src_module_id, src_port_name); 
+
+    /* Find the port name of next memory module */
+    std::string sink_port_name = generate_sram_port_name(sram_orgz_type, CIRCUIT_MODEL_PORT_OUTPUT);
+    ModuleId net_sink_module_id = parent_module; 
+    size_t net_sink_instance_id = 0;
+    ModulePortId net_sink_port_id = module_manager.find_module_port(net_sink_module_id, sink_port_name); 
+
     /* Get the pin id for source port */
     BasicPort net_src_port = module_manager.module_port(net_src_module_id, net_src_port_id); 
     /* Get the pin id for sink port */
     BasicPort net_sink_port = module_manager.module_port(net_sink_module_id, net_sink_port_id); 
-    /* Port sizes of source and sink should match */
-    VTR_ASSERT(net_src_port.get_width() == net_sink_port.get_width());
+
+    /* The tail of the primitive module has a pin for each region */
+    std::vector<size_t> net_sink_pins;
+    if (1 < num_regions) {
+      VTR_ASSERT(1 == net_src_port.get_width());
+      VTR_ASSERT(num_regions == net_sink_port.get_width());
+      net_sink_pins.push_back(net_sink_port.pins()[region]);
+    } else {
+      /* Port sizes of source and sink should match */
+      VTR_ASSERT(net_src_port.get_width() == net_sink_port.get_width());
+      net_sink_pins = net_sink_port.pins();
+    }
     
     /* Create a net for each pin */
-    for (size_t pin_id = 0; pin_id < net_src_port.pins().size(); ++pin_id) {
+    for (size_t pin_id = 0; pin_id < net_sink_pins.size(); ++pin_id) {
       /* Create a net and add source and sink to it */
       ModuleNetId net = create_module_source_pin_net(module_manager, parent_module, net_src_module_id, net_src_instance_id, net_src_port_id, net_src_port.pins()[pin_id]);
       /* Add net sink */
-      module_manager.add_module_net_sink(parent_module, net, net_sink_module_id, net_sink_instance_id, net_sink_port_id, net_sink_port.pins()[pin_id]);
+      module_manager.add_module_net_sink(parent_module, net, net_sink_module_id, net_sink_instance_id, net_sink_port_id, net_sink_pins[pin_id]);
     }
   }
-
-  /* For the last memory module:
-   *    net source is the configuration chain tail of the previous memory module
-   *    net sink is the configuration chain tail of the primitive module
-   */
-  /* Find the port name of previous memory module */
-  std::string src_port_name = generate_configuration_chain_tail_name();
-  ModuleId net_src_module_id = module_manager.configurable_children(parent_module).back(); 
-  size_t net_src_instance_id = module_manager.configurable_child_instances(parent_module).back();
-  ModulePortId net_src_port_id = module_manager.find_module_port(net_src_module_id, src_port_name); 
-
-  /* Find the port name of next memory module */
-  std::string sink_port_name = generate_sram_port_name(sram_orgz_type, CIRCUIT_MODEL_PORT_OUTPUT);
-  ModuleId net_sink_module_id = parent_module; 
-  size_t net_sink_instance_id = 0;
-  ModulePortId net_sink_port_id = module_manager.find_module_port(net_sink_module_id, sink_port_name); 
-
-  /* Get the pin id for source port */
-  BasicPort net_src_port = module_manager.module_port(net_src_module_id, net_src_port_id); 
-  /* Get the pin id for sink port */
-  BasicPort net_sink_port = module_manager.module_port(net_sink_module_id, net_sink_port_id); 
-  /* Port sizes of source and sink should match */
-  VTR_ASSERT(net_src_port.get_width() == net_sink_port.get_width());
-  
-  /* Create a net for each pin */
-  for (size_t pin_id = 0; pin_id < net_src_port.pins().size(); ++pin_id) {
-    /* Create a net and add source and sink to it */
-    ModuleNetId net = create_module_source_pin_net(module_manager, parent_module, net_src_module_id, net_src_instance_id, net_src_port_id, net_src_port.pins()[pin_id]);
-    /* Add net sink */
-    module_manager.add_module_net_sink(parent_module, net, net_sink_module_id, net_sink_instance_id, net_sink_port_id, net_sink_port.pins()[pin_id]);
-  }
 }
 
 /********************************************************************
@@ -1126,10 +1163,11 @@ void add_module_nets_cmos_memory_frame_decoder_config_bus(ModuleManager& module_
   /* Connect the address port of the parent module to the address port of configurable children
    * Note that we only connect to the last few bits of address port
    */
+  ModulePortNameId addr_port_name_id = module_manager.find_port_name_id(std::string(DECODER_ADDRESS_PORT_NAME));
   for (size_t mem_index = 0; mem_index < configurable_children.size(); ++mem_index) {
     ModuleId child_module = configurable_children[mem_index]; 
     size_t child_instance = module_manager.configurable_child_instances(parent_module)[mem_index];
-    ModulePortId child_addr_port = module_manager.find_module_port(child_module, std::string(DECODER_ADDRESS_PORT_NAME));
+    ModulePortId child_addr_port = module_manager.find_module_port(child_module, addr_port_name_id);
     BasicPort child_addr_port_info = module_manager.module_port(child_module, child_addr_port);
     for (size_t ipin = 0; ipin < child_addr_port_info.get_width(); ++ipin) {
       ModuleNetId net = module_manager.module_instance_port_net(parent_module,
@@ -1155,11 +1193,12 @@ void add_module_nets_cmos_memory_frame_decoder_config_bus(ModuleManager& module_
   /* Connect the data_in (Din) of parent module to the data_in of the all
    * the memory modules
    */
-  ModulePortId parent_din_port = module_manager.find_module_port(parent_module, std::string(DECODER_DATA_IN_PORT_NAME));
+  ModulePortNameId din_port_name_id = module_manager.find_port_name_id(std::string(DECODER_DATA_IN_PORT_NAME));
+  ModulePortId parent_din_port = module_manager.find_module_port(parent_module, din_port_name_id);
   for (size_t mem_index = 0; mem_index < configurable_children.size(); ++mem_index) {
     ModuleId child_module = configurable_children[mem_index]; 
     size_t child_instance = module_manager.configurable_child_instances(parent_module)[mem_index];
-    ModulePortId child_din_port = module_manager.find_module_port(child_module, std::string(DECODER_DATA_IN_PORT_NAME));
+    ModulePortId child_din_port = module_manager.find_module_port(child_module, din_port_name_id);
     add_module_bus_nets(module_manager, parent_module,
                         parent_module, 0, parent_din_port,
                         child_module, child_instance, child_din_port);
@@ -1171,10 +1210,11 @@ void add_module_nets_cmos_memory_frame_decoder_config_bus(ModuleManager& module_
   ModulePortId decoder_dout_port = module_manager.find_module_port(decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
   BasicPort decoder_dout_port_info = module_manager.module_port(decoder_module, decoder_dout_port);
   VTR_ASSERT(decoder_dout_port_info.get_width() == configurable_children.size());
+  ModulePortNameId en_port_name_id = module_manager.find_port_name_id(std::string(DECODER_ENABLE_PORT_NAME));
   for (size_t mem_index = 0; mem_index < configurable_children.size(); ++mem_index) {
     ModuleId child_module = configurable_children[mem_index]; 
     size_t child_instance = module_manager.configurable_child_instances(parent_module)[mem_index];
-    ModulePortId child_en_port = module_manager.find_module_port(child_module, std::string(DECODER_ENABLE_PORT_NAME));
+    ModulePortId child_en_port = module_manager.find_module_port(child_module, en_port_name_id);
     BasicPort child_en_port_info = module_manager.module_port(child_module, child_en_port);
     for (size_t ipin = 0; ipin < child_en_port_info.get_width(); ++ipin) {
       ModuleNetId net = module_manager.module_instance_port_net(parent_module,
@@ -1759,6 +1799,22 @@ size_t find_module_num_config_bits_from_child_modules(ModuleManager& module_mana
   return num_config_bits;
 }
 
+/********************************************************************
+ * Find the number of decoders which are added to the end of 
+ * the configurable children of the top-level module by the memory bank protocol
+ * - A BL decoder and a WL decoder in general
+ * - Only a WL decoder when a word of BLs is written at each WL address,
+ *   where there is no BL address port
+ *******************************************************************/
+size_t find_top_module_num_memory_bank_decoders(const ModuleManager& module_manager,
+                                                const ModuleId& top_module) {
+  ModulePortId bl_addr_port = module_manager.find_module_port(top_module, std::string(DECODER_BL_ADDRESS_PORT_NAME));
+  if (false == module_manager.valid_module_port_id(top_module, bl_addr_port)) {
+    return 1;
+  }
+  return 2;
+}
+
 /********************************************************************
  * Try to create a net for the source pin
  * This function will try
@@ -1836,15 +1892,9 @@ void add_module_bus_nets(ModuleManager& module_manager,
   }
 
   /* Create a net for each pin */
-  for (size_t pin_id = 0; pin_id < src_port.pins().size(); ++pin_id) {
-    ModuleNetId net = create_module_source_pin_net(module_manager, cur_module_id, 
-                                                   src_module_id, src_instance_id, 
-                                                   src_module_port_id, src_port.pins()[pin_id]);
-    VTR_ASSERT(ModuleNetId::INVALID() != net);
-
-    /* Configure the net sink */
-    module_manager.add_module_net_sink(cur_module_id, net, des_module_id, des_instance_id, des_module_port_id, des_port.pins()[pin_id]);
-  }
+  module_manager.add_module_port_nets(cur_module_id,
+                                      src_module_id, src_instance_id, src_module_port_id, src_port.pins(),
+                                      des_module_id, des_instance_id, des_module_port_id, des_port.pins());
 }
 
 /********************************************************************
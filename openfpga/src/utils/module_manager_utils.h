@@ -151,6 +151,9 @@ size_t find_module_num_config_bits_from_child_modules(ModuleManager& module_mana
                                                       const CircuitModelId& sram_model,
                                                       const e_config_protocol_type& sram_orgz_type);
 
+size_t find_top_module_num_memory_bank_decoders(const ModuleManager& module_manager,
+                                                const ModuleId& top_module);
+
 ModuleNetId create_module_source_pin_net(ModuleManager& module_manager,
                                          const ModuleId& cur_module_id,
                                          const ModuleId& src_module_id,
@@ -38,4 +38,29 @@ std::vector<std::string> find_atom_netlist_clock_port_names(const AtomNetlist& a
   return clock_names;
 }
 
+/***************************************************************************************
+ * Find the index of the GPIO in the top-level FPGA fabric which each I/O atom block is mapped to
+ * The other atom blocks are given an index of size_t(-1)
+ * This look-up is built once by the writers which visit all the I/Os of the netlist,
+ * so that they do not have to find the placement of each I/O block again
+ ***************************************************************************************/
+vtr::vector<AtomBlockId, size_t> find_atom_netlist_io_indices(const AtomContext& atom_ctx,
+                                                               const PlacementContext& place_ctx,
+                                                               const IoLocationMap& io_location_map) {
+  vtr::vector<AtomBlockId, size_t> io_indices(atom_ctx.nlist.blocks().size(), size_t(-1));
+
+  for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
+    /* Bypass non-I/O atom blocks ! */
+    if ( (AtomBlockType::INPAD != atom_ctx.nlist.block_type(atom_blk))
+      && (AtomBlockType::OUTPAD != atom_ctx.nlist.block_type(atom_blk)) ) {
+      continue;
+    }
+
+    const t_pl_loc& loc = place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc;
+    io_indices[atom_blk] = io_location_map.io_index(loc.x, loc.y, loc.z);
+  }
+
+  return io_indices;
+}
+
 } /* end namespace openfpga */
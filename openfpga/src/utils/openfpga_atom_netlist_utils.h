@@ -6,8 +6,11 @@
  *******************************************************************/
 #include <vector>
 #include <string>
+#include "vtr_vector.h"
 #include "atom_netlist.h"
+#include "vpr_context.h"
 #include "vpr_netlist_annotation.h"
+#include "io_location_map.h"
 
 /********************************************************************
  * Function declaration
@@ -19,6 +22,10 @@ namespace openfpga {
 std::vector<std::string> find_atom_netlist_clock_port_names(const AtomNetlist& atom_nlist,
                                                             const VprNetlistAnnotation& netlist_annotation);
 
+vtr::vector<AtomBlockId, size_t> find_atom_netlist_io_indices(const AtomContext& atom_ctx,
+                                                               const PlacementContext& place_ctx,
+                                                               const IoLocationMap& io_location_map);
+
 } /* end namespace openfpga */
 
 #endif
@@ -14,6 +14,7 @@ import time
 from datetime import timedelta
 import shlex
 import glob
+import hashlib
 import argparse
 from configparser import ConfigParser, ExtendedInterpolation
 import logging
@@ -89,8 +90,18 @@ parser.add_argument('--openfpga_sim_setting_file', type=str,
                      help="Openfpga simulation file for shell")
 parser.add_argument('--external_fabric_key_file', type=str,
                     help="Key file for shell")
+parser.add_argument('--openfpga_profile_file', type=str,
+                    help="Write the runtime and memory usage of each " +
+                    "command of the shell to the file")
 parser.add_argument('--yosys_tmpl', type=str,
                     help="Alternate yosys template, generates top_module.blif")
+parser.add_argument('--synthesis_cache', type=str,
+                    help="Directory caching the synthesized and activity " +
+                    "files, which are reused when the benchmark, the yosys " +
+                    "script and the tools are unchanged")
+parser.add_argument('--abc_threads', type=int, default=1,
+                    help="Number of threads used by the cut enumeration of " +
+                    "the LUT mapping, which then runs the bundled ABC")
 parser.add_argument('--disp', action="store_true",
                     help="Open display while running VPR")
 parser.add_argument('--debug', action="store_true",
@@ -247,10 +258,13 @@ def main():
     prepare_run_directory(args.run_dir)
     if (args.fpga_flow == "yosys_vpr"):
         logger.info('Running "yosys_vpr" Flow')
-        run_yosys_with_abc()
-        # TODO Make it optional if activity file is provided
-        run_ace2()
-        run_pro_blif_3arg()
+        write_yosys_script()
+        if not restore_synthesis_cache():
+            run_yosys_with_abc()
+            # TODO Make it optional if activity file is provided
+            run_ace2()
+            run_pro_blif_3arg()
+            save_synthesis_cache()
         if args.power:
             run_rewrite_verilog()
     
@@ -383,6 +397,8 @@ def validate_command_line_arguments():
 
     # Expand run directory to absolute path
     args.run_dir = os.path.abspath(args.run_dir)
+    if args.synthesis_cache:
+        args.synthesis_cache = os.path.abspath(args.synthesis_cache)
     if args.activity_file:
         args.activity_file = os.path.abspath(args.activity_file)
     if args.base_verilog:
@@ -467,9 +483,9 @@ def clean_up_and_exit(msg, clean=False):
     exit(1)
 
 
-def run_yosys_with_abc():
+def write_yosys_script():
     """
-    Execute yosys with ABC and optional blackbox support
+    Writes the yosys script of the benchmark in yosys.ys
     """
     tree = ET.parse(args.arch_file)
     root = tree.getroot()
@@ -483,6 +499,14 @@ def run_yosys_with_abc():
         logger.exception("Failed to extract lut_size from XML file")
         clean_up_and_exit("")
     args.K = lut_size
+    # The bundled ABC maps the LUTs when the cut enumeration is threaded,
+    # with the default LUT mapping script of yosys
+    abc_options = ""
+    if args.abc_threads > 1:
+        abc_script = ["strash", "ifraig", "scorr", "dc2", "dretime", "retime",
+                      "strash", "dch,-f", "if,-P,%d" % args.abc_threads, "mfs2"]
+        abc_options = " -exe %s -script +%s" % (
+            shlex.quote(cad_tools["openfpga_abc_path"]), ";".join(abc_script))
     # Yosys script parameter mapping
     ys_params = {
         "READ_VERILOG_FILE": " \n".join([
@@ -490,6 +514,7 @@ def run_yosys_with_abc():
             for eachfile in args.benchmark_files]),
         "TOP_MODULE": args.top_module,
         "LUT_SIZE": lut_size,
+        "ABC_OPTIONS": abc_options,
         "OUTPUT_BLIF": args.top_module+"_yosys_out.blif",
     }
     yosys_template = os.path.join(
@@ -497,6 +522,12 @@ def run_yosys_with_abc():
     tmpl = Template(open(yosys_template, encoding='utf-8').read())
     with open("yosys.ys", 'w') as archfile:
         archfile.write(tmpl.substitute(ys_params))
+
+
+def run_yosys_with_abc():
+    """
+    Execute yosys with ABC and optional blackbox support
+    """
     try:
         with open('yosys_output.txt', 'w+') as output:
             process = subprocess.run([cad_tools["yosys_path"], 'yosys.ys'],
@@ -527,6 +558,90 @@ def run_abc_for_standarad():
     pass
 
 
+def synthesis_cache_files():
+    """ Returns the files written by the synthesis, ACE2 and blif_3args """
+    files = [args.top_module+"_yosys_out.blif", "yosys_output.txt",
+             args.top_module+"_ace_out.act", args.top_module+"_ace_out.blif",
+             args.top_module+"_ace2_output.txt", args.top_module+".blif",
+             args.top_module+"_blif_3args_output.txt"]
+    if args.black_box_ace:
+        files.append(args.top_module+"_bb.blif")
+    return files
+
+
+def synthesis_cache_key():
+    """
+    Returns the key of the synthesis files in the cache, which is the digest
+    of the benchmark files, the yosys script, the ACE2 options and the tools
+    """
+    digest = hashlib.sha256()
+
+    def add_to_digest(name, data):
+        digest.update(name.encode() + b"\0" + data + b"\0")
+
+    def add_file_to_digest(name, filepath):
+        filepath = filepath if os.path.isfile(filepath) else \
+            (shutil.which(filepath) or "")
+        if not os.path.isfile(filepath):
+            add_to_digest(name, b"missing")
+            return
+        with open(filepath, 'rb') as fp:
+            add_to_digest(name, hashlib.sha256(fp.read()).digest())
+
+    for eachfile in args.benchmark_files:
+        add_file_to_digest(os.path.basename(eachfile), eachfile)
+    add_file_to_digest("yosys.ys", "yosys.ys")
+    add_to_digest("ace_options", repr(
+        [args.ace_d, args.ace_p, args.black_box_ace, args.K]).encode())
+    abc_tool = "openfpga_abc_path" if args.abc_threads > 1 else "abc_path"
+    for eachtool in ["yosys_path", abc_tool, "ace_path", "pro_blif_path"]:
+        add_file_to_digest(eachtool, cad_tools[eachtool])
+    return digest.hexdigest()
+
+
+def restore_synthesis_cache():
+    """
+    Copies the synthesis files from the cache to the run directory
+    Returns True if the cache has them
+    """
+    if not args.synthesis_cache:
+        return False
+    cache_dir = os.path.join(args.synthesis_cache, synthesis_cache_key())
+    files = synthesis_cache_files()
+    if not all([os.path.isfile(os.path.join(cache_dir, eachfile))
+                for eachfile in files]):
+        logger.info("Synthesis files are not in the cache")
+        return False
+    for eachfile in files:
+        shutil.copy(os.path.join(cache_dir, eachfile), eachfile)
+    logger.info("Skipping synthesis, files are copied from cache %s" %
+                cache_dir)
+    return True
+
+
+def save_synthesis_cache():
+    """
+    Copies the synthesis files to the cache.
+    The files are written to a temporary directory, which is renamed,
+    so that the flows running in parallel never read a partial entry
+    """
+    if not args.synthesis_cache:
+        return
+    cache_dir = os.path.join(args.synthesis_cache, synthesis_cache_key())
+    if os.path.isdir(cache_dir):
+        return
+    temp_dir = "%s.%d.tmp" % (cache_dir, os.getpid())
+    try:
+        os.makedirs(temp_dir)
+        for eachfile in synthesis_cache_files():
+            shutil.copy(eachfile, os.path.join(temp_dir, eachfile))
+        os.rename(temp_dir, cache_dir)
+        logger.info("Synthesis files are saved in cache %s" % cache_dir)
+    except OSError:
+        # e.g. another flow saved the same files first
+        shutil.rmtree(temp_dir, ignore_errors=True)
+
+
 def run_ace2():
     if args.black_box_ace:
         with open(args.top_module+'_yosys_out.blif', 'r') as fp:
@@ -721,6 +836,8 @@ def run_openfpga_shell():
         archfile.write(tmpl.substitute(path_variables))
     command = [cad_tools["openfpga_shell_path"], "-f",
                args.top_module+"_run.openfpga"]
+    if args.openfpga_profile_file:
+        command += ["--profile", args.openfpga_profile_file]
     print(command)
     print(os.getcwd())
     run_command("OpenFPGA Shell Run", "openfpgashell.log", command)
@@ -96,6 +96,7 @@ def main():
         if not args.test_run:
             run_actions(job_run_list)
             collect_results(job_run_list)
+            collect_profiles(job_run_list)
         else:
             pprint.pprint(job_run_list)
     logger.info("Task execution completed")
@@ -301,6 +302,9 @@ def generate_each_task_actions(taskname):
                     "bench": bench,
                     "name": "%02d_%s_%s" % (indx, bench["top_module"], lbl),
                     "run_dir": flow_run_dir,
+                    "profile_file": task_conf.get("OpenFPGA_SHELL",
+                                                  "openfpga_profile_file",
+                                                  fallback=None),
                     "commands": command,
                     "finished": False,
                     "status": False})
@@ -452,6 +456,32 @@ def run_actions(job_list):
         eachthread.join()
 
 
+def collect_profiles(job_run_list):
+    # Merge the profiles of OpenFPGA shell commands into a single file,
+    # where each row is a command of a run
+    task_profile = []
+    for run in job_run_list:
+        if not (run["status"] and run.get("profile_file")):
+            continue
+        profile_file = os.path.join(run["run_dir"], run["profile_file"])
+        if not os.path.isfile(profile_file):
+            logger.info("No profile file found for %s" % run["name"])
+            continue
+        with open(profile_file, newline='') as csvfile:
+            for row in csv.DictReader(csvfile):
+                profile = OrderedDict()
+                profile["name"] = run["name"]
+                profile.update(row)
+                task_profile.append(profile)
+    if len(task_profile):
+        with open("task_profile.csv", 'w', newline='') as csvfile:
+            writer = csv.DictWriter(
+                csvfile, fieldnames=list(task_profile[0].keys()))
+            writer.writeheader()
+            for eachProfile in task_profile:
+                writer.writerow(eachProfile)
+
+
 def collect_results(job_run_list):
     task_result = []
     for run in job_run_list:
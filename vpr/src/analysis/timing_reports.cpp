@@ -1,10 +1,18 @@
 #include "timing_reports.h"
 
+#include <fstream>
+#include <memory>
+
+#if defined(VPR_USE_ZLIB)
+#    include <zlib.h>
+#endif
+
 #include "vtr_log.h"
 
 #include "tatum/TimingReporter.hpp"
 
 #include "vpr_types.h"
+#include "vpr_error.h"
 #include "globals.h"
 
 #include "timing_info.h"
@@ -12,6 +20,91 @@
 
 #include "VprTimingGraphResolver.h"
 
+#if defined(VPR_USE_ZLIB)
+//Output stream buffer writing a gzip compressed file
+class GzipStreamBuf : public std::streambuf {
+  public:
+    GzipStreamBuf(const std::string& filename)
+        : file_(gzopen(filename.c_str(), "wb")) {
+        setp(buffer_, buffer_ + sizeof(buffer_));
+    }
+
+    ~GzipStreamBuf() {
+        if (file_) {
+            sync();
+            gzclose(file_);
+        }
+    }
+
+    bool is_open() const { return file_ != nullptr; }
+
+  protected:
+    int overflow(int c) override {
+        if (sync() != 0) {
+            return traits_type::eof();
+        }
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    int sync() override {
+        int num_bytes = pptr() - pbase();
+        if (num_bytes > 0 && (!file_ || gzwrite(file_, pbase(), num_bytes) != num_bytes)) {
+            return -1;
+        }
+        setp(buffer_, buffer_ + sizeof(buffer_));
+        return 0;
+    }
+
+  private:
+    gzFile file_;
+    char buffer_[64 * 1024];
+};
+
+class GzipOstream : public std::ostream {
+  public:
+    GzipOstream(const std::string& filename)
+        : std::ostream(nullptr)
+        , buf_(filename) {
+        rdbuf(&buf_);
+        if (!buf_.is_open()) {
+            setstate(std::ios::failbit);
+        }
+    }
+
+  private:
+    GzipStreamBuf buf_;
+};
+#endif
+
+//Opens a timing report file. The paths are written as they are traced, so (optionally compressed)
+//reports of many paths do not need to be held in memory
+static std::unique_ptr<std::ostream> open_timing_report(const std::string& filename, const t_analysis_opts& analysis_opts) {
+    std::unique_ptr<std::ostream> os;
+    if (analysis_opts.timing_report_compress) {
+#if defined(VPR_USE_ZLIB)
+        os = std::make_unique<GzipOstream>(filename + ".gz");
+#else
+        static bool warned = false;
+        if (!warned) {
+            VTR_LOG_WARN("Timing reports are not compressed: VPR was built without zlib\n");
+            warned = true;
+        }
+#endif
+    }
+    if (!os) {
+        os = std::make_unique<std::ofstream>(filename);
+    }
+
+    if (!*os) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Failed to open timing report '%s' for writing", filename.c_str());
+    }
+    return os;
+}
+
 void generate_setup_timing_stats(const std::string& prefix, const SetupTimingInfo& timing_info, const AnalysisDelayCalculator& delay_calc, const t_analysis_opts& analysis_opts) {
     auto& timing_ctx = g_vpr_ctx.timing();
     auto& atom_ctx = g_vpr_ctx.atom();
@@ -23,13 +116,13 @@ void generate_setup_timing_stats(const std::string& prefix, const SetupTimingInf
 
     tatum::TimingReporter timing_reporter(resolver, *timing_ctx.graph, *timing_ctx.constraints);
 
-    timing_reporter.report_timing_setup(prefix + "report_timing.setup.rpt", *timing_info.setup_analyzer(), analysis_opts.timing_report_npaths);
+    timing_reporter.report_timing_setup(*open_timing_report(prefix + "report_timing.setup.rpt", analysis_opts), *timing_info.setup_analyzer(), analysis_opts.timing_report_npaths);
 
     if (analysis_opts.timing_report_skew) {
-        timing_reporter.report_skew_setup(prefix + "report_skew.setup.rpt", *timing_info.setup_analyzer(), analysis_opts.timing_report_npaths);
+        timing_reporter.report_skew_setup(*open_timing_report(prefix + "report_skew.setup.rpt", analysis_opts), *timing_info.setup_analyzer(), analysis_opts.timing_report_npaths);
     }
 
-    timing_reporter.report_unconstrained_setup(prefix + "report_unconstrained_timing.setup.rpt", *timing_info.setup_analyzer());
+    timing_reporter.report_unconstrained_setup(*open_timing_report(prefix + "report_unconstrained_timing.setup.rpt", analysis_opts), *timing_info.setup_analyzer());
 }
 
 void generate_hold_timing_stats(const std::string& prefix, const HoldTimingInfo& timing_info, const AnalysisDelayCalculator& delay_calc, const t_analysis_opts& analysis_opts) {
@@ -43,11 +136,11 @@ void generate_hold_timing_stats(const std::string& prefix, const HoldTimingInfo&
 
     tatum::TimingReporter timing_reporter(resolver, *timing_ctx.graph, *timing_ctx.constraints);
 
-    timing_reporter.report_timing_hold(prefix + "report_timing.hold.rpt", *timing_info.hold_analyzer(), analysis_opts.timing_report_npaths);
+    timing_reporter.report_timing_hold(*open_timing_report(prefix + "report_timing.hold.rpt", analysis_opts), *timing_info.hold_analyzer(), analysis_opts.timing_report_npaths);
 
     if (analysis_opts.timing_report_skew) {
-        timing_reporter.report_skew_hold(prefix + "report_skew.hold.rpt", *timing_info.hold_analyzer(), analysis_opts.timing_report_npaths);
+        timing_reporter.report_skew_hold(*open_timing_report(prefix + "report_skew.hold.rpt", analysis_opts), *timing_info.hold_analyzer(), analysis_opts.timing_report_npaths);
     }
 
-    timing_reporter.report_unconstrained_hold(prefix + "report_unconstrained_timing.hold.rpt", *timing_info.hold_analyzer());
+    timing_reporter.report_unconstrained_hold(*open_timing_report(prefix + "report_unconstrained_timing.hold.rpt", analysis_opts), *timing_info.hold_analyzer());
 }
@@ -31,6 +31,17 @@ void CheckSetup(const t_packer_opts& PackerOpts,
             "This is allowed, but strange, and circuit speed will suffer.\n");
     }
 
+    if (PlacerOpts.num_seeds < 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "The number of seeds must be at least 1 (was %d).\n", PlacerOpts.num_seeds);
+    }
+
+    if (PlacerOpts.num_seeds > 1
+        && (PlacerOpts.doPlacement != STAGE_DO || RouterOpts.doRouting != STAGE_DO)) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "Multiple seeds require both the placement and the routing to be run.\n");
+    }
+
     if ((false == Timing.timing_analysis_enabled)
         && (PlacerOpts.place_algorithm == PATH_TIMING_DRIVEN_PLACE)) {
         /* May work, not tested */
@@ -90,6 +90,7 @@ void SetupVPR(const t_options* Options,
     FileNameOpts->out_file_prefix = Options->out_file_prefix;
 
     FileNameOpts->verify_file_digests = Options->verify_file_digests;
+    FileNameOpts->net_file_cache = Options->net_file_cache;
 
     SetupNetlistOpts(*Options, *NetlistOpts);
     SetupPlacerOpts(*Options, PlacerOpts);
@@ -166,6 +167,7 @@ void SetupVPR(const t_options* Options,
     SetupTiming(*Options, TimingEnabled, Timing);
     SetupPackerOpts(*Options, PackerOpts);
     RoutingArch->write_rr_graph_filename = Options->write_rr_graph_file;
+    RoutingArch->rr_graph_cache_dir = Options->rr_graph_cache_dir;
     RoutingArch->read_rr_graph_filename = Options->read_rr_graph_file;
 
     //Setup the default flow, if no specific stages specified
@@ -220,6 +222,7 @@ void SetupVPR(const t_options* Options,
         vtr::ScopedStartFinishTimer t("Building complex block graph");
         alloc_and_load_all_pb_graphs(PowerOpts->do_power);
         *PackerRRGraphs = alloc_and_load_all_lb_type_rr_graph();
+        g_vpr_ctx.mutable_device().lb_type_rr_graphs = *PackerRRGraphs;
     }
 
     if ((Options->clock_modeling == ROUTED_CLOCK) || (Options->clock_modeling == DEDICATED_NETWORK)) {
@@ -366,11 +369,20 @@ static void SetupRouterOpts(const t_options& Options, t_router_opts* RouterOpts)
     RouterOpts->routing_failure_predictor = Options.routing_failure_predictor;
     RouterOpts->routing_budgets_algorithm = Options.routing_budgets_algorithm;
     RouterOpts->save_routing_per_iteration = Options.save_routing_per_iteration;
+    RouterOpts->iteration_stats_file = Options.router_iteration_stats_file;
+    RouterOpts->net_stats_file = Options.router_net_stats_file;
+    RouterOpts->congestion_stats_prefix = Options.router_congestion_stats_prefix;
     RouterOpts->congested_routing_iteration_threshold_frac = Options.congested_routing_iteration_threshold_frac;
     RouterOpts->route_bb_update = Options.route_bb_update;
+    RouterOpts->check_route = Options.check_route;
     RouterOpts->clock_modeling = Options.clock_modeling;
     RouterOpts->two_stage_clock_routing = Options.two_stage_clock_routing;
+    RouterOpts->clock_route_templates = Options.clock_route_templates;
     RouterOpts->high_fanout_threshold = Options.router_high_fanout_threshold;
+    RouterOpts->parallel_routing = Options.router_parallel_routing;
+    RouterOpts->warm_start = Options.router_warm_start;
+    RouterOpts->trunk_global_nets = Options.router_trunk_global_nets;
+    RouterOpts->adaptive_pres_fac = Options.router_adaptive_pres_fac;
     RouterOpts->router_debug_net = Options.router_debug_net;
     RouterOpts->router_debug_sink_rr = Options.router_debug_sink_rr;
     RouterOpts->lookahead_type = Options.router_lookahead_type;
@@ -493,6 +505,8 @@ static void SetupPlacerOpts(const t_options& Options, t_placer_opts* PlacerOpts)
 
     /* Depends on PlacerOpts->place_algorithm */
     PlacerOpts->enable_timing_computations = Options.ShowPlaceTiming;
+    PlacerOpts->num_seeds = Options.num_seeds;
+    PlacerOpts->seeds_metric = Options.seeds_metric;
 
     PlacerOpts->delay_offset = Options.place_delay_offset;
     PlacerOpts->delay_ramp_delta_threshold = Options.place_delay_ramp_delta_threshold;
@@ -509,6 +523,10 @@ static void SetupPlacerOpts(const t_options& Options, t_placer_opts* PlacerOpts)
 
     PlacerOpts->rlim_escape_fraction = Options.place_rlim_escape_fraction;
     PlacerOpts->move_stats_file = Options.place_move_stats_file;
+    PlacerOpts->anneal_stats_file = Options.place_anneal_stats_file;
+    PlacerOpts->parallel_placement = Options.place_parallel_placement;
+    PlacerOpts->place_init_type = Options.place_init_type;
+    PlacerOpts->move_generator = Options.place_move_generator;
 
     PlacerOpts->strict_checks = Options.strict_checks;
 
@@ -528,6 +546,7 @@ static void SetupAnalysisOpts(const t_options& Options, t_analysis_opts& analysi
     analysis_opts.timing_report_npaths = Options.timing_report_npaths;
     analysis_opts.timing_report_detail = Options.timing_report_detail;
     analysis_opts.timing_report_skew = Options.timing_report_skew;
+    analysis_opts.timing_report_compress = Options.timing_report_compress;
 }
 
 static void SetupPowerOpts(const t_options& Options, t_power_opts* power_opts, t_arch* Arch) {
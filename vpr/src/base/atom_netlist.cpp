@@ -44,10 +44,10 @@ const t_model* AtomNetlist::block_model(const AtomBlockId id) const {
     return block_models_[id];
 }
 
-const AtomNetlist::TruthTable& AtomNetlist::block_truth_table(const AtomBlockId id) const {
+AtomNetlist::TruthTable AtomNetlist::block_truth_table(const AtomBlockId id) const {
     VTR_ASSERT_SAFE(valid_block_id(id));
 
-    return block_truth_tables_[id];
+    return unpack_truth_table(block_truth_tables_[id]);
 }
 
 /*
@@ -112,7 +112,7 @@ AtomBlockId AtomNetlist::create_block(const std::string name, const t_model* mod
 
     //Initialize the data
     block_models_.push_back(model);
-    block_truth_tables_.push_back(truth_table);
+    block_truth_tables_.push_back(pack_truth_table(truth_table));
 
     //Check post-conditions: size
     VTR_ASSERT(validate_block_sizes());
@@ -228,6 +228,66 @@ void AtomNetlist::rebuild_net_refs_impl(const vtr::vector_map<AtomPinId, AtomPin
  *
  */
 
+//Number of bits used to store a vtr::LogicValue in a packed truth table
+constexpr size_t TRUTH_TABLE_VALUE_BITS = 2;
+constexpr size_t TRUTH_TABLE_VALUES_PER_WORD = 64 / TRUTH_TABLE_VALUE_BITS;
+static_assert(size_t(vtr::LogicValue::NUM_LOGIC_VALUE_TYPES) <= (1 << TRUTH_TABLE_VALUE_BITS),
+              "Logic values must fit in the bits of a packed truth table value");
+
+AtomNetlist::PackedTruthTable AtomNetlist::pack_truth_table(const TruthTable& truth_table) {
+    PackedTruthTable packed_truth_table;
+    packed_truth_table.num_rows = truth_table.size();
+
+    size_t num_values = 0;
+    bool uniform_rows = true;
+    for (const auto& row : truth_table) {
+        num_values += row.size();
+        uniform_rows &= (row.size() == truth_table[0].size());
+    }
+
+    if (!truth_table.empty()) {
+        packed_truth_table.num_cols = truth_table[0].size();
+    }
+    if (!uniform_rows) {
+        for (const auto& row : truth_table) {
+            packed_truth_table.row_sizes.push_back(row.size());
+        }
+    }
+
+    packed_truth_table.bits.resize((num_values + TRUTH_TABLE_VALUES_PER_WORD - 1) / TRUTH_TABLE_VALUES_PER_WORD, 0);
+    size_t ivalue = 0;
+    for (const auto& row : truth_table) {
+        for (vtr::LogicValue value : row) {
+            size_t shift = TRUTH_TABLE_VALUE_BITS * (ivalue % TRUTH_TABLE_VALUES_PER_WORD);
+            packed_truth_table.bits[ivalue / TRUTH_TABLE_VALUES_PER_WORD] |= uint64_t(value) << shift;
+            ++ivalue;
+        }
+    }
+
+    return packed_truth_table;
+}
+
+AtomNetlist::TruthTable AtomNetlist::unpack_truth_table(const PackedTruthTable& packed_truth_table) {
+    constexpr uint64_t VALUE_MASK = (uint64_t(1) << TRUTH_TABLE_VALUE_BITS) - 1;
+
+    TruthTable truth_table(packed_truth_table.num_rows);
+
+    size_t ivalue = 0;
+    for (size_t irow = 0; irow < truth_table.size(); ++irow) {
+        size_t num_cols = packed_truth_table.row_sizes.empty() ? packed_truth_table.num_cols : packed_truth_table.row_sizes[irow];
+
+        truth_table[irow].reserve(num_cols);
+        for (size_t icol = 0; icol < num_cols; ++icol) {
+            size_t shift = TRUTH_TABLE_VALUE_BITS * (ivalue % TRUTH_TABLE_VALUES_PER_WORD);
+            uint64_t value = (packed_truth_table.bits[ivalue / TRUTH_TABLE_VALUES_PER_WORD] >> shift) & VALUE_MASK;
+            truth_table[irow].push_back(vtr::LogicValue(value));
+            ++ivalue;
+        }
+    }
+
+    return truth_table;
+}
+
 void AtomNetlist::clean_blocks_impl(const vtr::vector_map<AtomBlockId, AtomBlockId>& block_id_map) {
     //Update all the block_models and block
     block_models_ = clean_and_reorder_values(block_models_, block_id_map);
@@ -250,6 +310,7 @@ void AtomNetlist::clean_nets_impl(const vtr::vector_map<AtomNetId, AtomNetId>& /
 void AtomNetlist::shrink_to_fit_impl() {
     //Block data
     block_models_.shrink_to_fit();
+    block_truth_tables_.shrink_to_fit();
 
     //Port data
     port_models_.shrink_to_fit();
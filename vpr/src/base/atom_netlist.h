@@ -65,6 +65,7 @@
  * Refer to netlist.h for more information.
  *
  */
+#include <cstdint>
 #include <vector>
 #include <unordered_map>
 
@@ -104,7 +105,10 @@ class AtomNetlist : public Netlist<AtomBlockId, AtomPortId, AtomPinId, AtomNetId
     // logic function.
     //
     // For FF/Latches there is only a single entry representing the initial state
-    const TruthTable& block_truth_table(const AtomBlockId id) const;
+    //
+    // Note that truth tables are stored packed and decoded by this call, so the
+    // truth table is returned by value
+    TruthTable block_truth_table(const AtomBlockId id) const;
 
     /*
      * Ports
@@ -164,6 +168,20 @@ class AtomNetlist : public Netlist<AtomBlockId, AtomPortId, AtomPinId, AtomNetId
     //  sinks   : The net's sink pins
     AtomNetId add_net(const std::string name, AtomPinId driver, std::vector<AtomPinId> sinks);
 
+  private: //Private types
+    //A truth table with 2 bits per value, which are stored row after row.
+    //All the rows of a truth table usually have the same number of values (num_cols), otherwise
+    //the number of values of each row is stored in row_sizes
+    struct PackedTruthTable {
+        uint32_t num_rows = 0;
+        uint32_t num_cols = 0;
+        std::vector<uint32_t> row_sizes;
+        std::vector<uint64_t> bits;
+    };
+
+    static PackedTruthTable pack_truth_table(const TruthTable& truth_table);
+    static TruthTable unpack_truth_table(const PackedTruthTable& packed_truth_table);
+
   private: //Private members
     /*
      * Component removal
@@ -202,7 +220,7 @@ class AtomNetlist : public Netlist<AtomBlockId, AtomPortId, AtomPinId, AtomNetId
   private: //Private data
     //Block data
     vtr::vector_map<AtomBlockId, const t_model*> block_models_;   //Architecture model of each block
-    vtr::vector_map<AtomBlockId, TruthTable> block_truth_tables_; //Truth tables of each block
+    vtr::vector_map<AtomBlockId, PackedTruthTable> block_truth_tables_; //Truth tables of each block
 
     //Port data
     vtr::vector_map<AtomPortId, const t_model_ports*> port_models_; //Architecture port models of each port
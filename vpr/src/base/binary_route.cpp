@@ -0,0 +1,168 @@
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_util.h"
+
+#include "vpr_error.h"
+#include "globals.h"
+#include "route_common.h"
+#include "binary_route.h"
+
+/*************Functions local to this module*************/
+static void read_binary_route_bytes(std::ifstream& fp, char* data, size_t num_bytes, const char* route_file);
+
+/*************Global Functions****************************/
+bool is_binary_route_file(const char* route_file) {
+    return vtr::check_file_name_extension(route_file, ".bin");
+}
+
+void write_binary_route(const char* placement_file, const char* route_file) {
+    auto& place_ctx = g_vpr_ctx.placement();
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& route_ctx = g_vpr_ctx.routing();
+
+    std::ofstream fp(route_file, std::ios::binary);
+    if (!fp.is_open()) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                  "Cannot open %s routing file", route_file);
+    }
+
+    std::string placement_file_name = (placement_file == nullptr) ? "" : placement_file;
+
+    t_binary_route_header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, BINARY_ROUTE_MAGIC, sizeof(BINARY_ROUTE_MAGIC));
+    header.version = BINARY_ROUTE_VERSION;
+    header.placement_file_length = placement_file_name.size();
+    header.placement_id_length = place_ctx.placement_id.size();
+    header.grid_width = device_ctx.grid.width();
+    header.grid_height = device_ctx.grid.height();
+    header.num_rr_nodes = device_ctx.rr_graph.nodes().size();
+    header.num_nets = cluster_ctx.clb_nlist.nets().size();
+
+    fp.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    fp.write(placement_file_name.data(), placement_file_name.size());
+    fp.write(place_ctx.placement_id.data(), place_ctx.placement_id.size());
+
+    std::vector<t_binary_route_trace_element> elements;
+    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
+        elements.clear();
+        if (!route_ctx.trace.empty()) {
+            for (const t_trace* tptr = route_ctx.trace[net_id].head; tptr != nullptr; tptr = tptr->next) {
+                elements.push_back({int32_t(size_t(tptr->index)), int32_t(tptr->iswitch)});
+            }
+        }
+
+        uint32_t num_elements = elements.size();
+        fp.write(reinterpret_cast<const char*>(&num_elements), sizeof(num_elements));
+        fp.write(reinterpret_cast<const char*>(elements.data()), elements.size() * sizeof(t_binary_route_trace_element));
+    }
+
+    if (!fp) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                  "Failed to write %s routing file", route_file);
+    }
+}
+
+void read_binary_route(const char* route_file, bool verify_file_digests) {
+    auto& place_ctx = g_vpr_ctx.placement();
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    std::ifstream fp(route_file, std::ios::binary);
+    if (!fp.is_open()) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                  "Cannot open %s routing file", route_file);
+    }
+
+    t_binary_route_header header;
+    read_binary_route_bytes(fp, reinterpret_cast<char*>(&header), sizeof(header), route_file);
+
+    if (0 != std::memcmp(header.magic, BINARY_ROUTE_MAGIC, sizeof(BINARY_ROUTE_MAGIC))
+        || header.version != BINARY_ROUTE_VERSION) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                  "File %s is not a binary routing file of version %u", route_file, BINARY_ROUTE_VERSION);
+    }
+
+    std::string placement_file(header.placement_file_length, '\0');
+    read_binary_route_bytes(fp, &placement_file[0], placement_file.size(), route_file);
+    std::string placement_id(header.placement_id_length, '\0');
+    read_binary_route_bytes(fp, &placement_id[0], placement_id.size(), route_file);
+
+    if (placement_id != place_ctx.placement_id) {
+        auto msg = vtr::string_fmt(
+            "Placement file %s specified in the routing file"
+            " does not match the loaded placement (ID %s != %s)",
+            placement_file.c_str(), placement_id.c_str(), place_ctx.placement_id.c_str());
+        if (verify_file_digests) {
+            vpr_throw(VPR_ERROR_ROUTE, route_file, 0, msg.c_str());
+        } else {
+            VTR_LOG_WARN("%s\n", msg.c_str());
+        }
+    }
+
+    if (header.grid_width != device_ctx.grid.width() || header.grid_height != device_ctx.grid.height()) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                  "Device dimensions %zux%zu specified in the routing file does not match given %zux%zu",
+                  size_t(header.grid_width), size_t(header.grid_height), device_ctx.grid.width(), device_ctx.grid.height());
+    }
+    if (header.num_rr_nodes != device_ctx.rr_graph.nodes().size()) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                  "Number of RR nodes %zu specified in the routing file does not match the RR graph (%zu)",
+                  size_t(header.num_rr_nodes), device_ctx.rr_graph.nodes().size());
+    }
+    if (header.num_nets != cluster_ctx.clb_nlist.nets().size()) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                  "Number of nets %zu specified in the routing file does not match the netlist (%zu)",
+                  size_t(header.num_nets), cluster_ctx.clb_nlist.nets().size());
+    }
+
+    std::vector<t_binary_route_trace_element> elements;
+    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
+        uint32_t num_elements;
+        read_binary_route_bytes(fp, reinterpret_cast<char*>(&num_elements), sizeof(num_elements), route_file);
+
+        elements.resize(num_elements);
+        read_binary_route_bytes(fp, reinterpret_cast<char*>(elements.data()), elements.size() * sizeof(t_binary_route_trace_element), route_file);
+
+        if (num_elements != 0 && cluster_ctx.clb_nlist.net_is_ignored(net_id)) {
+            VTR_LOG_WARN("Net %lu (%s) is marked as global in the netlist, but is non-global in the .route file\n", size_t(net_id), cluster_ctx.clb_nlist.net_name(net_id).c_str());
+        }
+
+        t_trace* tptr = nullptr;
+        for (const t_binary_route_trace_element& element : elements) {
+            RRNodeId node(element.node);
+            if (element.node < 0 || !device_ctx.rr_graph.valid_node_id(node)) {
+                vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                          "Net %lu has an invalid node %d", size_t(net_id), element.node);
+            }
+
+            t_trace* element_tptr = alloc_trace_data();
+            element_tptr->index = node;
+            element_tptr->iswitch = element.iswitch;
+            element_tptr->next = nullptr;
+            if (tptr == nullptr) {
+                route_ctx.trace[net_id].head = element_tptr;
+            } else {
+                tptr->next = element_tptr;
+            }
+            tptr = element_tptr;
+        }
+        route_ctx.trace[net_id].tail = tptr;
+    }
+}
+
+//Reads a number of bytes from the file and errors out if the file is truncated
+static void read_binary_route_bytes(std::ifstream& fp, char* data, size_t num_bytes, const char* route_file) {
+    fp.read(data, num_bytes);
+    if (size_t(fp.gcount()) != num_bytes) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                  "Binary routing file %s is truncated", route_file);
+    }
+}
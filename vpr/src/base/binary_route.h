@@ -0,0 +1,55 @@
+/*
+ * Binary format of the .route file
+ *
+ * A .route file whose name ends with ".bin" is written and read in this format,
+ * which stores the route traces of the nets with the RR node ids and the switch ids only,
+ * so that an existing routing is loaded without any parsing.
+ *
+ * Unlike the text format, the file is only checked against the device dimensions,
+ * the size of the RR graph, the number of nets and the placement ID,
+ * so it should be read with the same netlist, architecture and RR graph it was written for.
+ *
+ * All the fields are stored in the native byte order:
+ *  - the header (t_binary_route_header)
+ *  - the placement file name and the placement ID (not null-terminated)
+ *  - for each net of the clustered netlist, in the order of the net ids:
+ *      - the number of elements of its route trace (32-bit)
+ *      - the RR node id (32-bit) and the switch id (32-bit) of each element
+ *    where the global nets and the nets without sinks have no elements
+ */
+
+#ifndef BINARY_ROUTE_H
+#define BINARY_ROUTE_H
+
+#include <cstdint>
+
+constexpr char BINARY_ROUTE_MAGIC[8] = {'V', 'P', 'R', 'R', 'O', 'U', 'T', 'E'};
+constexpr uint32_t BINARY_ROUTE_VERSION = 1;
+
+struct t_binary_route_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t placement_file_length;
+    uint32_t placement_id_length;
+    uint32_t reserved;
+    uint64_t grid_width;
+    uint64_t grid_height;
+    uint64_t num_rr_nodes;
+    uint64_t num_nets;
+};
+
+struct t_binary_route_trace_element {
+    int32_t node;
+    int32_t iswitch;
+};
+
+//Returns true if the route file is in the binary format, i.e. if its name ends with ".bin"
+bool is_binary_route_file(const char* route_file);
+
+//Writes the route traces of the routing context
+void write_binary_route(const char* placement_file, const char* route_file);
+
+//Loads the route traces of the routing context, which should be allocated
+void read_binary_route(const char* route_file, bool verify_file_digests);
+
+#endif /* BINARY_ROUTE_H */
@@ -0,0 +1,610 @@
+/*
+ * Memory-mapped BLIF/eBLIF parser (see blif_mmap_parser.h)
+ *
+ * The tokenizer follows the lexer of blifparse (blif_lexer.l):
+ *  - Tokens are separated by white space, and '=' is a token of its own
+ *  - A '#' starting a token comments out the rest of the line
+ *  - A '\' at the end of a line continues it on the next line, unless the next line is blank
+ *  - The directives (.names, .end...) are recognized anywhere on a line
+ *
+ * Each logical line is then matched against the grammar of blifparse (blif_parser.y).
+ * Anything blifparse would interpret differently (or reject) is reported as unsupported, so
+ * that the file is parsed with blifparse instead.
+ */
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(VPR_USE_TBB)
+#    include <tbb/parallel_for.h>
+#endif
+
+#include "vtr_assert.h"
+
+#include "blif_mmap_parser.h"
+
+//Approximate size of the chunks of the file tokenized in parallel
+constexpr size_t CHUNK_SIZE = 4 * 1024 * 1024;
+
+namespace {
+
+//A token of the mapped file (not null-terminated)
+struct t_blif_token {
+    const char* begin;
+    size_t size;
+
+    bool equals(const char* str) const {
+        return std::strlen(str) == size && std::memcmp(begin, str, size) == 0;
+    }
+
+    std::string str() const {
+        return std::string(begin, size);
+    }
+};
+
+enum class e_blif_statement {
+    MODEL,
+    INPUTS,
+    OUTPUTS,
+    NAMES,
+    LATCH,
+    SUBCKT,
+    BLACKBOX,
+    END,
+    CONN,
+    CNAME,
+    ATTR,
+    PARAM
+};
+
+//A statement of the file, holding the arguments of its callback
+struct t_blif_statement {
+    e_blif_statement type;
+
+    //Line number passed to the callback, relative to the start of the chunk
+    size_t lineno = 0;
+
+    //The strings of the statement, in order.
+    //For a .subckt: the model, then the port and net of each connection.
+    //For a .latch: the input, output and control (empty if unspecified)
+    std::vector<t_blif_token> strings;
+
+    //The single-output cover rows of a .names, row after row
+    std::vector<blifparse::LogicValue> so_cover;
+
+    blifparse::LatchType latch_type = blifparse::LatchType::UNSPECIFIED;
+    blifparse::LogicValue latch_init = blifparse::LogicValue::UNKOWN;
+};
+
+struct t_blif_directive {
+    const char* name;
+    e_blif_statement type;
+};
+
+constexpr t_blif_directive BLIF_DIRECTIVES[] = {
+    {".model", e_blif_statement::MODEL},
+    {".inputs", e_blif_statement::INPUTS},
+    {".outputs", e_blif_statement::OUTPUTS},
+    {".names", e_blif_statement::NAMES},
+    {".latch", e_blif_statement::LATCH},
+    {".subckt", e_blif_statement::SUBCKT},
+    {".blackbox", e_blif_statement::BLACKBOX},
+    {".end", e_blif_statement::END},
+    {".conn", e_blif_statement::CONN},
+    {".cname", e_blif_statement::CNAME},
+    {".attr", e_blif_statement::ATTR},
+    {".param", e_blif_statement::PARAM}};
+
+//Returns the directive of a token, or nullptr if it is not a directive
+const t_blif_directive* find_directive(const t_blif_token& token) {
+    if (token.size < 2 || token.begin[0] != '.') {
+        return nullptr;
+    }
+    for (const t_blif_directive& directive : BLIF_DIRECTIVES) {
+        if (token.equals(directive.name)) {
+            return &directive;
+        }
+    }
+    return nullptr;
+}
+
+//Returns true if a token is a keyword of a .latch line (which can not be used as a net name there)
+bool is_latch_keyword(const t_blif_token& token) {
+    for (const char* keyword : {"fe", "re", "ah", "al", "as", "NIL", "0", "1", "2", "3"}) {
+        if (token.equals(keyword)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool is_latch_init(const t_blif_token& token, blifparse::LogicValue& init) {
+    if (token.size != 1) {
+        return false;
+    }
+    switch (token.begin[0]) {
+        case '0':
+            init = blifparse::LogicValue::FALSE;
+            return true;
+        case '1':
+            init = blifparse::LogicValue::TRUE;
+            return true;
+        case '2':
+            init = blifparse::LogicValue::DONT_CARE;
+            return true;
+        case '3':
+            init = blifparse::LogicValue::UNKOWN;
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool is_latch_type(const t_blif_token& token, blifparse::LatchType& type) {
+    if (token.equals("fe")) {
+        type = blifparse::LatchType::FALLING_EDGE;
+    } else if (token.equals("re")) {
+        type = blifparse::LatchType::RISING_EDGE;
+    } else if (token.equals("ah")) {
+        type = blifparse::LatchType::ACTIVE_HIGH;
+    } else if (token.equals("al")) {
+        type = blifparse::LatchType::ACTIVE_LOW;
+    } else if (token.equals("as")) {
+        type = blifparse::LatchType::ASYNCHRONOUS;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+//Tokenizes a chunk of the file, which starts at the beginning of a statement
+class BlifChunkParser {
+  public:
+    BlifChunkParser(const char* begin, const char* end)
+        : p_(begin)
+        , end_(end) {}
+
+    //Tokenizes the chunk into statements.
+    //Returns false if the chunk uses constructs which are not supported
+    bool parse() {
+        //Whether the next lines can be the single-output cover rows of the last .names
+        bool in_so_cover = false;
+
+        while (p_ < end_) {
+            if (!read_line()) {
+                return false;
+            }
+
+            if (line_tokens_.empty()) {
+                //Blank or comment line. It ends the cover of a .names, since blifparse
+                //only accepts cover rows right after the .names line or another row
+                in_so_cover = false;
+                continue;
+            }
+
+            const t_blif_directive* directive = find_directive(line_tokens_[0]);
+            if (!directive) {
+                if (!in_so_cover || !add_so_cover_row(statements_.back())) {
+                    return false;
+                }
+                statements_.back().lineno = num_newlines_;
+                continue;
+            }
+
+            for (size_t itoken = 1; itoken < line_tokens_.size(); ++itoken) {
+                if (find_directive(line_tokens_[itoken])) {
+                    return false;
+                }
+            }
+
+            statements_.emplace_back();
+            t_blif_statement& statement = statements_.back();
+            statement.type = directive->type;
+            statement.lineno = num_newlines_;
+            in_so_cover = false;
+
+            if (!add_statement_arguments(statement)) {
+                return false;
+            }
+
+            if (statement.type == e_blif_statement::NAMES) {
+                //A comment at the end of the .names line keeps the lexer of blifparse
+                //from reading the next lines as cover rows
+                in_so_cover = !line_has_comment_;
+            } else if (statement.type == e_blif_statement::LATCH) {
+                //The line number of a .latch is the one after it in blifparse
+                statement.lineno = num_newlines_ + 1;
+            }
+        }
+        return true;
+    }
+
+    const std::vector<t_blif_statement>& statements() const { return statements_; }
+
+    //Number of lines ended in the chunk
+    size_t num_newlines() const { return num_newlines_; }
+
+  private:
+    //Reads the tokens of the next line, joining continued lines.
+    //Returns false if the line can not be read as blifparse would
+    bool read_line() {
+        line_tokens_.clear();
+        line_has_comment_ = false;
+
+        const char* token_begin = nullptr;
+        while (p_ < end_) {
+            char c = *p_;
+            if (c == ' ' || c == '\t') {
+                if (!end_token(token_begin)) return false;
+                ++p_;
+            } else if (c == '\n' || c == '\r') {
+                if (!end_token(token_begin)) return false;
+                return skip_newline();
+            } else if (c == '=') {
+                if (!end_token(token_begin)) return false;
+                line_tokens_.push_back({p_, 1});
+                ++p_;
+            } else if (c == '#' && !token_begin) {
+                //Comment until the end of the line, which must exist: otherwise blifparse
+                //reads the comment as a string
+                line_has_comment_ = true;
+                const char* newline = static_cast<const char*>(std::memchr(p_, '\n', end_ - p_));
+                if (!newline) {
+                    return false;
+                }
+                p_ = newline;
+                return skip_newline();
+            } else if (c == '\\' && is_newline(p_ + 1)) {
+                //Line continuation
+                if (!end_token(token_begin)) return false;
+                ++p_;
+                if (!skip_newline()) return false;
+
+                //A continuation followed by a blank line ends the line
+                const char* next = p_;
+                while (next < end_ && (*next == ' ' || *next == '\t')) {
+                    ++next;
+                }
+                if (is_newline(next)) {
+                    p_ = next;
+                    return skip_newline();
+                }
+            } else {
+                if (!token_begin) {
+                    token_begin = p_;
+                }
+                ++p_;
+            }
+        }
+        return end_token(token_begin);
+    }
+
+    //Ends the current token (if any) before p_
+    bool end_token(const char*& token_begin) {
+        if (token_begin) {
+            //Strings can not end with a backslash
+            if (p_[-1] == '\\') {
+                return false;
+            }
+            line_tokens_.push_back({token_begin, size_t(p_ - token_begin)});
+            token_begin = nullptr;
+        }
+        return true;
+    }
+
+    bool is_newline(const char* p) const {
+        return p < end_ && (*p == '\n' || (*p == '\r' && p + 1 < end_ && p[1] == '\n'));
+    }
+
+    //Skips the end of a line ("\n", "\n\r" or "\r\n") at p_
+    bool skip_newline() {
+        if (*p_ == '\n') {
+            ++p_;
+            if (p_ < end_ && *p_ == '\r') {
+                ++p_;
+            }
+        } else if (*p_ == '\r' && p_ + 1 < end_ && p_[1] == '\n') {
+            p_ += 2;
+        } else {
+            return false; //Lone carriage return
+        }
+        ++num_newlines_;
+        return true;
+    }
+
+    //Adds the line as a single-output cover row of a .names
+    bool add_so_cover_row(t_blif_statement& names) {
+        VTR_ASSERT(names.type == e_blif_statement::NAMES);
+
+        size_t row_size = 0;
+        for (const t_blif_token& token : line_tokens_) {
+            for (size_t i = 0; i < token.size; ++i) {
+                switch (token.begin[i]) {
+                    case '0':
+                        names.so_cover.push_back(blifparse::LogicValue::FALSE);
+                        break;
+                    case '1':
+                        names.so_cover.push_back(blifparse::LogicValue::TRUE);
+                        break;
+                    case '-':
+                        names.so_cover.push_back(blifparse::LogicValue::DONT_CARE);
+                        break;
+                    default:
+                        return false;
+                }
+                ++row_size;
+            }
+        }
+        //Each row has a value per net
+        return row_size == names.strings.size();
+    }
+
+    //Stores the arguments of the statement from the tokens of the line
+    bool add_statement_arguments(t_blif_statement& statement) {
+        const std::vector<t_blif_token>& tokens = line_tokens_;
+
+        //Only .subckt accepts '='
+        if (statement.type != e_blif_statement::SUBCKT) {
+            for (const t_blif_token& token : tokens) {
+                if (token.equals("=")) {
+                    return false;
+                }
+            }
+        }
+
+        switch (statement.type) {
+            case e_blif_statement::MODEL:
+            case e_blif_statement::CNAME:
+                if (tokens.size() != 2) return false;
+                break;
+            case e_blif_statement::INPUTS:
+            case e_blif_statement::OUTPUTS:
+            case e_blif_statement::NAMES:
+                break;
+            case e_blif_statement::BLACKBOX:
+            case e_blif_statement::END:
+                if (tokens.size() != 1) return false;
+                break;
+            case e_blif_statement::CONN:
+                if (tokens.size() != 3) return false;
+                break;
+            case e_blif_statement::ATTR:
+            case e_blif_statement::PARAM:
+                if (tokens.size() != 2 && tokens.size() != 3) return false;
+                break;
+            case e_blif_statement::SUBCKT:
+                //The model, then 'port = net' connections
+                if (tokens.size() < 2 || (tokens.size() - 2) % 3 != 0 || tokens[1].equals("=")) return false;
+                for (size_t itoken = 2; itoken < tokens.size(); itoken += 3) {
+                    if (tokens[itoken].equals("=") || !tokens[itoken + 1].equals("=") || tokens[itoken + 2].equals("=")) {
+                        return false;
+                    }
+                    statement.strings.push_back(tokens[itoken]);
+                    statement.strings.push_back(tokens[itoken + 2]);
+                }
+                statement.strings.insert(statement.strings.begin(), tokens[1]);
+                return true;
+            case e_blif_statement::LATCH:
+                return add_latch_arguments(statement);
+            default:
+                VTR_ASSERT_MSG(false, "Unknown type of BLIF statement");
+        }
+
+        statement.strings.assign(tokens.begin() + 1, tokens.end());
+        return true;
+    }
+
+    //.latch input output [type control] [init]
+    bool add_latch_arguments(t_blif_statement& statement) {
+        const std::vector<t_blif_token>& tokens = line_tokens_;
+        if (tokens.size() < 3 || is_latch_keyword(tokens[1]) || is_latch_keyword(tokens[2])) {
+            return false;
+        }
+
+        t_blif_token control = {tokens[0].begin, 0};
+        if (tokens.size() == 4) {
+            if (!is_latch_init(tokens[3], statement.latch_init)) return false;
+        } else if (tokens.size() == 5 || tokens.size() == 6) {
+            if (!is_latch_type(tokens[3], statement.latch_type)) return false;
+            if (!tokens[4].equals("NIL")) {
+                if (is_latch_keyword(tokens[4])) return false;
+                control = tokens[4];
+            }
+            if (tokens.size() == 6 && !is_latch_init(tokens[5], statement.latch_init)) return false;
+        } else if (tokens.size() != 3) {
+            return false;
+        }
+
+        statement.strings = {tokens[1], tokens[2], control};
+        return true;
+    }
+
+  private:
+    const char* p_;
+    const char* end_;
+
+    size_t num_newlines_ = 0;
+    std::vector<t_blif_statement> statements_;
+
+    std::vector<t_blif_token> line_tokens_;
+    bool line_has_comment_ = false;
+};
+
+//Splits a file into chunks starting at the beginning of a statement: a line starting
+//with a '.' which does not continue the previous line
+std::vector<const char*> find_chunk_begins(const char* data, size_t size) {
+    const char* end = data + size;
+
+    std::vector<const char*> chunk_begins = {data};
+    for (size_t offset = CHUNK_SIZE; offset < size; offset += CHUNK_SIZE) {
+        const char* p = std::max(data + offset, chunk_begins.back());
+        const char* chunk_begin = nullptr;
+        while (p < end && !chunk_begin) {
+            const char* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            if (!newline) {
+                break;
+            }
+            p = newline + 1;
+
+            const char* line_end = newline;
+            if (line_end > data && line_end[-1] == '\r') {
+                --line_end;
+            }
+            bool is_continued = (line_end > data && line_end[-1] == '\\');
+            if (!is_continued && p < end && *p == '.') {
+                chunk_begin = p;
+            }
+        }
+
+        if (!chunk_begin) {
+            break;
+        }
+        if (chunk_begin > chunk_begins.back()) {
+            chunk_begins.push_back(chunk_begin);
+        }
+    }
+    return chunk_begins;
+}
+
+//Calls the callback for a statement
+void call_statement_callback(const t_blif_statement& statement, blifparse::Callback& callback) {
+    std::vector<std::string> strings;
+    strings.reserve(statement.strings.size());
+    for (const t_blif_token& token : statement.strings) {
+        strings.push_back(token.str());
+    }
+
+    switch (statement.type) {
+        case e_blif_statement::MODEL:
+            callback.begin_model(strings[0]);
+            break;
+        case e_blif_statement::INPUTS:
+            callback.inputs(std::move(strings));
+            break;
+        case e_blif_statement::OUTPUTS:
+            callback.outputs(std::move(strings));
+            break;
+        case e_blif_statement::NAMES: {
+            std::vector<std::vector<blifparse::LogicValue>> so_cover;
+            if (!strings.empty()) {
+                for (auto row_begin = statement.so_cover.begin(); row_begin != statement.so_cover.end(); row_begin += strings.size()) {
+                    so_cover.emplace_back(row_begin, row_begin + strings.size());
+                }
+            }
+            callback.names(std::move(strings), std::move(so_cover));
+            break;
+        }
+        case e_blif_statement::LATCH:
+            callback.latch(strings[0], strings[1], statement.latch_type, strings[2], statement.latch_init);
+            break;
+        case e_blif_statement::SUBCKT: {
+            std::vector<std::string> ports;
+            std::vector<std::string> nets;
+            for (size_t i = 1; i < strings.size(); i += 2) {
+                ports.push_back(std::move(strings[i]));
+                nets.push_back(std::move(strings[i + 1]));
+            }
+            callback.subckt(strings[0], std::move(ports), std::move(nets));
+            break;
+        }
+        case e_blif_statement::BLACKBOX:
+            callback.blackbox();
+            break;
+        case e_blif_statement::END:
+            callback.end_model();
+            break;
+        case e_blif_statement::CONN:
+            callback.conn(strings[0], strings[1]);
+            break;
+        case e_blif_statement::CNAME:
+            callback.cname(strings[0]);
+            break;
+        case e_blif_statement::ATTR:
+            callback.attr(strings[0], strings.size() > 1 ? strings[1] : "");
+            break;
+        case e_blif_statement::PARAM:
+            callback.param(strings[0], strings.size() > 1 ? strings[1] : "");
+            break;
+        default:
+            VTR_ASSERT_MSG(false, "Unknown type of BLIF statement");
+    }
+}
+
+} // namespace
+
+bool blif_mmap_parse_filename(const char* filename, blifparse::Callback& callback) {
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    size_t size = file_stat.st_size;
+    const char* data = nullptr;
+    if (size > 0) {
+        void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+        data = static_cast<const char*>(mapped);
+    }
+    ::close(fd);
+
+    //Tokenize the chunks of the file
+    std::vector<const char*> chunk_begins;
+    if (size > 0) {
+        chunk_begins = find_chunk_begins(data, size);
+    }
+
+    std::vector<BlifChunkParser> chunk_parsers;
+    for (size_t ichunk = 0; ichunk < chunk_begins.size(); ++ichunk) {
+        const char* chunk_end = (ichunk + 1 < chunk_begins.size()) ? chunk_begins[ichunk + 1] : data + size;
+        chunk_parsers.emplace_back(chunk_begins[ichunk], chunk_end);
+    }
+
+    std::vector<char> chunk_parsed(chunk_parsers.size(), false);
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for(size_t(0), chunk_parsers.size(), [&](size_t ichunk) {
+        chunk_parsed[ichunk] = chunk_parsers[ichunk].parse();
+    });
+#else
+    for (size_t ichunk = 0; ichunk < chunk_parsers.size(); ++ichunk) {
+        chunk_parsed[ichunk] = chunk_parsers[ichunk].parse();
+    }
+#endif
+
+    bool supported = std::all_of(chunk_parsed.begin(), chunk_parsed.end(), [](char parsed) { return parsed; });
+    if (supported) {
+        //Build the netlist in file order
+        callback.start_parse();
+        callback.filename(filename);
+
+        size_t num_previous_newlines = 0;
+        for (const BlifChunkParser& chunk_parser : chunk_parsers) {
+            for (const t_blif_statement& statement : chunk_parser.statements()) {
+                callback.lineno(num_previous_newlines + statement.lineno);
+                call_statement_callback(statement, callback);
+            }
+            num_previous_newlines += chunk_parser.num_newlines();
+        }
+
+        callback.finish_parse();
+    }
+
+    if (data) {
+        munmap(const_cast<char*>(data), size);
+    }
+    return supported;
+}
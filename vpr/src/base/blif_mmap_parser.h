@@ -0,0 +1,26 @@
+#ifndef BLIF_MMAP_PARSER_H
+#define BLIF_MMAP_PARSER_H
+/*
+ * Memory-mapped BLIF/eBLIF parser
+ * ===============================
+ *
+ * A faster alternative to blifparse::blif_parse_filename() for large netlists.
+ *
+ * The file is mapped in memory and split into chunks at the start of statements.
+ * The chunks are tokenized in parallel (when built with VPR_USE_TBB), and the
+ * statements are then passed to the callback in file order, with the same
+ * arguments as blifparse. The netlist built by the callback (and therefore its ids)
+ * is identical to the one built from blifparse.
+ *
+ * Only the constructs accepted by blifparse are supported. If the file uses anything
+ * else (e.g. a syntax error, or a comment at a place where blifparse would reject the
+ * next line), false is returned without calling the callback at all, and the file
+ * should be parsed with blifparse, which reports the error.
+ */
+#include "blifparse.hpp"
+
+//Parses the specified BLIF file, calling the callback for each statement.
+//Returns false (without having called the callback) if the file could not be parsed
+bool blif_mmap_parse_filename(const char* filename, blifparse::Callback& callback);
+
+#endif
@@ -0,0 +1,289 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_util.h"
+
+#include "vpr_error.h"
+#include "net_file_cache.h"
+
+/*************Functions local to this module*************/
+static void write_cache_uint32(std::ofstream& fp, uint32_t value);
+static void write_cache_string(std::ofstream& fp, const std::string& value);
+static void write_cache_strings(std::ofstream& fp, const std::vector<std::string>& values);
+static void write_cache_ports(std::ofstream& fp, const std::vector<t_net_file_port>& ports);
+static void write_cache_port_group(std::ofstream& fp, const t_net_file_port_group& group);
+static void write_cache_params(std::ofstream& fp, const std::vector<t_net_file_param>& params);
+static void write_cache_block(std::ofstream& fp, const t_net_file_block& block);
+
+static void read_cache_bytes(std::ifstream& fp, char* data, size_t num_bytes, const std::string& cache_file);
+static uint32_t read_cache_uint32(std::ifstream& fp, const std::string& cache_file);
+static void read_cache_string(std::ifstream& fp, std::string& value, const std::string& cache_file);
+static void read_cache_strings(std::ifstream& fp, std::vector<std::string>& values, const std::string& cache_file);
+static void read_cache_ports(std::ifstream& fp, std::vector<t_net_file_port>& ports, const std::string& cache_file);
+static void read_cache_port_group(std::ifstream& fp, t_net_file_port_group& group, const std::string& cache_file);
+static void read_cache_params(std::ifstream& fp, std::vector<t_net_file_param>& params, const std::string& cache_file);
+static void read_cache_block(std::ifstream& fp, t_net_file_block& block, const std::string& cache_file);
+
+/*************Global Functions****************************/
+std::string net_file_cache_name(const char* net_file) {
+    return std::string(net_file) + ".cache";
+}
+
+NetFileCacheWriter::NetFileCacheWriter(const std::string& cache_file, const std::string& net_file_digest, const t_net_file_top& top)
+    : cache_file_(cache_file)
+    , temp_file_(cache_file + ".tmp" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()))
+    , fp_(temp_file_, std::ios::binary) {
+    if (!fp_.is_open()) {
+        VTR_LOG_WARN("Cannot open %s to cache the packed netlist\n", temp_file_.c_str());
+        return;
+    }
+
+    t_net_file_cache_header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, NET_FILE_CACHE_MAGIC, sizeof(NET_FILE_CACHE_MAGIC));
+    header.version = NET_FILE_CACHE_VERSION;
+    header.digest_length = net_file_digest.size();
+
+    fp_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    fp_.write(net_file_digest.data(), net_file_digest.size());
+
+    write_cache_string(fp_, top.name);
+    write_cache_string(fp_, top.instance);
+    write_cache_uint32(fp_, top.has_architecture_id);
+    write_cache_string(fp_, top.architecture_id);
+    write_cache_uint32(fp_, top.has_atom_netlist_id);
+    write_cache_string(fp_, top.atom_netlist_id);
+    write_cache_uint32(fp_, top.line);
+    write_cache_strings(fp_, top.inputs);
+    write_cache_strings(fp_, top.outputs);
+    write_cache_strings(fp_, top.clocks);
+    write_cache_uint32(fp_, top.num_blocks);
+}
+
+NetFileCacheWriter::~NetFileCacheWriter() {
+    if (!committed_) {
+        fp_.close();
+        std::remove(temp_file_.c_str());
+    }
+}
+
+void NetFileCacheWriter::write_block(const t_net_file_block& block) {
+    if (fp_.is_open()) {
+        write_cache_block(fp_, block);
+    }
+}
+
+bool NetFileCacheWriter::commit() {
+    if (!fp_.is_open()) {
+        return false;
+    }
+
+    fp_.close();
+    if (!fp_ || 0 != std::rename(temp_file_.c_str(), cache_file_.c_str())) {
+        VTR_LOG_WARN("Failed to cache the packed netlist as '%s'\n", cache_file_.c_str());
+        return false;
+    }
+
+    committed_ = true;
+    VTR_LOG("Cached the packed netlist as '%s'\n", cache_file_.c_str());
+    return true;
+}
+
+NetFileCacheReader::NetFileCacheReader(const std::string& cache_file)
+    : cache_file_(cache_file) {
+}
+
+bool NetFileCacheReader::open(const std::string& net_file_digest, t_net_file_top& top) {
+    if (!vtr::file_exists(cache_file_.c_str())) {
+        return false;
+    }
+
+    fp_.open(cache_file_, std::ios::binary);
+    if (!fp_.is_open()) {
+        return false;
+    }
+
+    //A cache of another version, or of an older .net file, is ignored (and will be overwritten)
+    t_net_file_cache_header header;
+    fp_.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (size_t(fp_.gcount()) != sizeof(header)
+        || 0 != std::memcmp(header.magic, NET_FILE_CACHE_MAGIC, sizeof(NET_FILE_CACHE_MAGIC))
+        || header.version != NET_FILE_CACHE_VERSION
+        || header.digest_length != net_file_digest.size()) {
+        VTR_LOG("Ignoring packed netlist cache '%s' of another version\n", cache_file_.c_str());
+        return false;
+    }
+
+    std::string digest(header.digest_length, '\0');
+    fp_.read(&digest[0], digest.size());
+    if (size_t(fp_.gcount()) != digest.size() || digest != net_file_digest) {
+        VTR_LOG("Ignoring packed netlist cache '%s' of another netlist file\n", cache_file_.c_str());
+        return false;
+    }
+
+    read_cache_string(fp_, top.name, cache_file_);
+    read_cache_string(fp_, top.instance, cache_file_);
+    top.has_architecture_id = read_cache_uint32(fp_, cache_file_);
+    read_cache_string(fp_, top.architecture_id, cache_file_);
+    top.has_atom_netlist_id = read_cache_uint32(fp_, cache_file_);
+    read_cache_string(fp_, top.atom_netlist_id, cache_file_);
+    top.line = read_cache_uint32(fp_, cache_file_);
+    read_cache_strings(fp_, top.inputs, cache_file_);
+    read_cache_strings(fp_, top.outputs, cache_file_);
+    read_cache_strings(fp_, top.clocks, cache_file_);
+    top.num_blocks = read_cache_uint32(fp_, cache_file_);
+
+    VTR_LOG("Loading packed netlist from cache '%s'\n", cache_file_.c_str());
+    return true;
+}
+
+void NetFileCacheReader::read_block(t_net_file_block& block) {
+    VTR_ASSERT(fp_.is_open());
+    read_cache_block(fp_, block, cache_file_);
+}
+
+/*************Local Functions****************************/
+static void write_cache_uint32(std::ofstream& fp, uint32_t value) {
+    fp.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static void write_cache_string(std::ofstream& fp, const std::string& value) {
+    write_cache_uint32(fp, value.size());
+    fp.write(value.data(), value.size());
+}
+
+static void write_cache_strings(std::ofstream& fp, const std::vector<std::string>& values) {
+    write_cache_uint32(fp, values.size());
+    for (const std::string& value : values) {
+        write_cache_string(fp, value);
+    }
+}
+
+static void write_cache_ports(std::ofstream& fp, const std::vector<t_net_file_port>& ports) {
+    write_cache_uint32(fp, ports.size());
+    for (const t_net_file_port& port : ports) {
+        write_cache_string(fp, port.name);
+        write_cache_strings(fp, port.pins);
+        write_cache_uint32(fp, port.line);
+    }
+}
+
+static void write_cache_port_group(std::ofstream& fp, const t_net_file_port_group& group) {
+    write_cache_ports(fp, group.ports);
+    write_cache_ports(fp, group.rotation_maps);
+    write_cache_uint32(fp, group.line);
+}
+
+static void write_cache_params(std::ofstream& fp, const std::vector<t_net_file_param>& params) {
+    write_cache_uint32(fp, params.size());
+    for (const t_net_file_param& param : params) {
+        write_cache_string(fp, param.name);
+        write_cache_string(fp, param.value);
+        write_cache_uint32(fp, param.line);
+    }
+}
+
+static void write_cache_block(std::ofstream& fp, const t_net_file_block& block) {
+    write_cache_string(fp, block.name);
+    write_cache_string(fp, block.instance);
+    write_cache_uint32(fp, block.line);
+    write_cache_uint32(fp, block.is_parsed);
+    if (!block.is_parsed) {
+        return;
+    }
+
+    write_cache_string(fp, block.mode);
+    write_cache_port_group(fp, block.inputs);
+    write_cache_port_group(fp, block.outputs);
+    write_cache_port_group(fp, block.clocks);
+    write_cache_uint32(fp, block.attributes_line);
+    write_cache_params(fp, block.attributes);
+    write_cache_uint32(fp, block.parameters_line);
+    write_cache_params(fp, block.parameters);
+
+    write_cache_uint32(fp, block.children.size());
+    for (const t_net_file_block& child : block.children) {
+        write_cache_block(fp, child);
+    }
+}
+
+//Reads a number of bytes from the cache and errors out if the cache is truncated
+static void read_cache_bytes(std::ifstream& fp, char* data, size_t num_bytes, const std::string& cache_file) {
+    fp.read(data, num_bytes);
+    if (size_t(fp.gcount()) != num_bytes) {
+        vpr_throw(VPR_ERROR_NET_F, cache_file.c_str(), 0,
+                  "Packed netlist cache %s is truncated (remove it to load the netlist file)", cache_file.c_str());
+    }
+}
+
+static uint32_t read_cache_uint32(std::ifstream& fp, const std::string& cache_file) {
+    uint32_t value;
+    read_cache_bytes(fp, reinterpret_cast<char*>(&value), sizeof(value), cache_file);
+    return value;
+}
+
+static void read_cache_string(std::ifstream& fp, std::string& value, const std::string& cache_file) {
+    value.resize(read_cache_uint32(fp, cache_file));
+    if (!value.empty()) {
+        read_cache_bytes(fp, &value[0], value.size(), cache_file);
+    }
+}
+
+static void read_cache_strings(std::ifstream& fp, std::vector<std::string>& values, const std::string& cache_file) {
+    values.resize(read_cache_uint32(fp, cache_file));
+    for (std::string& value : values) {
+        read_cache_string(fp, value, cache_file);
+    }
+}
+
+static void read_cache_ports(std::ifstream& fp, std::vector<t_net_file_port>& ports, const std::string& cache_file) {
+    ports.resize(read_cache_uint32(fp, cache_file));
+    for (t_net_file_port& port : ports) {
+        read_cache_string(fp, port.name, cache_file);
+        read_cache_strings(fp, port.pins, cache_file);
+        port.line = read_cache_uint32(fp, cache_file);
+    }
+}
+
+static void read_cache_port_group(std::ifstream& fp, t_net_file_port_group& group, const std::string& cache_file) {
+    read_cache_ports(fp, group.ports, cache_file);
+    read_cache_ports(fp, group.rotation_maps, cache_file);
+    group.line = read_cache_uint32(fp, cache_file);
+}
+
+static void read_cache_params(std::ifstream& fp, std::vector<t_net_file_param>& params, const std::string& cache_file) {
+    params.resize(read_cache_uint32(fp, cache_file));
+    for (t_net_file_param& param : params) {
+        read_cache_string(fp, param.name, cache_file);
+        read_cache_string(fp, param.value, cache_file);
+        param.line = read_cache_uint32(fp, cache_file);
+    }
+}
+
+static void read_cache_block(std::ifstream& fp, t_net_file_block& block, const std::string& cache_file) {
+    read_cache_string(fp, block.name, cache_file);
+    read_cache_string(fp, block.instance, cache_file);
+    block.line = read_cache_uint32(fp, cache_file);
+    block.is_parsed = read_cache_uint32(fp, cache_file);
+    if (!block.is_parsed) {
+        block.children.clear();
+        return;
+    }
+
+    read_cache_string(fp, block.mode, cache_file);
+    read_cache_port_group(fp, block.inputs, cache_file);
+    read_cache_port_group(fp, block.outputs, cache_file);
+    read_cache_port_group(fp, block.clocks, cache_file);
+    block.attributes_line = read_cache_uint32(fp, cache_file);
+    read_cache_params(fp, block.attributes, cache_file);
+    block.parameters_line = read_cache_uint32(fp, cache_file);
+    read_cache_params(fp, block.parameters, cache_file);
+
+    block.children.resize(read_cache_uint32(fp, cache_file));
+    for (t_net_file_block& child : block.children) {
+        read_cache_block(fp, child, cache_file);
+    }
+}
@@ -0,0 +1,140 @@
+/*
+ * Binary cache of the .net file
+ *
+ * The packed netlist (.net) file is loaded in two steps: each clustered block of the XML
+ * is first parsed into a t_net_file_block (the names, modes and the pins of its ports, already
+ * split into tokens), which is then checked against the architecture and the atom netlist
+ * and turned into the t_pb tree of the block.
+ *
+ * With --net_file_cache on, the parsed blocks are also written next to the .net file
+ * (as <net_file>.cache), and are loaded from there, without any XML parsing, as long
+ * as the digest of the .net file matches the one the cache was written for.
+ * Since the cache only holds the contents of the .net file, it does not depend on the
+ * architecture nor on the atom netlist, which are checked again on each load.
+ *
+ * All the fields are stored in the native byte order:
+ *  - the header (t_net_file_cache_header)
+ *  - the digest of the .net file (not null-terminated)
+ *  - the top-level block (t_net_file_top)
+ *  - each clustered block (t_net_file_block), in the order of the .net file
+ * where the strings are stored as their length (32-bit) followed by their characters,
+ * and the lists as their number of elements (32-bit) followed by their elements.
+ */
+
+#ifndef NET_FILE_CACHE_H
+#define NET_FILE_CACHE_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+constexpr char NET_FILE_CACHE_MAGIC[8] = {'V', 'P', 'R', 'N', 'E', 'T', 'F', 'C'};
+constexpr uint32_t NET_FILE_CACHE_VERSION = 1;
+
+struct t_net_file_cache_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t digest_length;
+};
+
+//A port (or a port rotation map) of a block, with the tokens of its pins
+struct t_net_file_port {
+    std::string name;
+    std::vector<std::string> pins;
+    int line = 0;
+};
+
+//The ports of a block in one of its <inputs>, <outputs> or <clocks> tags
+struct t_net_file_port_group {
+    std::vector<t_net_file_port> ports;
+    std::vector<t_net_file_port> rotation_maps;
+    int line = 0;
+};
+
+//An attribute or a parameter of a primitive block
+struct t_net_file_param {
+    std::string name;
+    std::string value;
+    int line = 0;
+};
+
+//A block of the .net file and its children
+//
+//An unused block ('open' name) is only parsed further if it has outputs (i.e. used routing),
+//otherwise is_parsed is false and only its name and instance are set
+struct t_net_file_block {
+    std::string name;
+    std::string instance;
+    std::string mode;
+    int line = 0;
+    bool is_parsed = false;
+
+    t_net_file_port_group inputs;
+    t_net_file_port_group outputs;
+    t_net_file_port_group clocks;
+
+    int attributes_line = 0;
+    int parameters_line = 0;
+    std::vector<t_net_file_param> attributes;
+    std::vector<t_net_file_param> parameters;
+
+    std::vector<t_net_file_block> children;
+};
+
+//The top-level block of the .net file
+struct t_net_file_top {
+    std::string name;
+    std::string instance;
+    bool has_architecture_id = false;
+    std::string architecture_id;
+    bool has_atom_netlist_id = false;
+    std::string atom_netlist_id;
+    int line = 0;
+
+    std::vector<std::string> inputs;
+    std::vector<std::string> outputs;
+    std::vector<std::string> clocks;
+
+    uint32_t num_blocks = 0;
+};
+
+//Returns the name of the cache of a .net file
+std::string net_file_cache_name(const char* net_file);
+
+//Writes the parsed blocks of a .net file to a temporary file, which is renamed to the cache
+//by commit(), and removed if the writer is destroyed before (e.g. if the .net file has errors)
+class NetFileCacheWriter {
+  public:
+    NetFileCacheWriter(const std::string& cache_file, const std::string& net_file_digest, const t_net_file_top& top);
+    ~NetFileCacheWriter();
+
+    void write_block(const t_net_file_block& block);
+
+    //Renames the temporary file to the cache, returns false if it failed
+    bool commit();
+
+  private:
+    std::string cache_file_;
+    std::string temp_file_;
+    std::ofstream fp_;
+    bool committed_ = false;
+};
+
+//Reads the parsed blocks of a .net file from its cache
+class NetFileCacheReader {
+  public:
+    NetFileCacheReader(const std::string& cache_file);
+
+    //Returns true if the cache was written for the .net file of the given digest,
+    //in which case its top-level block is loaded
+    bool open(const std::string& net_file_digest, t_net_file_top& top);
+
+    void read_block(t_net_file_block& block);
+
+  private:
+    std::string cache_file_;
+    std::ifstream fp_;
+};
+
+#endif /* NET_FILE_CACHE_H */
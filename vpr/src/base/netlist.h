@@ -816,6 +816,12 @@ class Netlist {
     //  str: The string whose ID is requested
     StringId create_string(const std::string& str);
 
+    //Re-builds the string look-up with the specified number of slots (a power of 2)
+    void rebuild_string_lookup(size_t num_slots);
+
+    //Adds an existing string to the string look-up
+    void insert_string_lookup(const StringId str_id);
+
     //Updates net cross-references for the specified pin
     //Returns the pin's index within the net
     int associate_pin_with_net(const PinId pin_id, const PinType type, const NetId net_id);
@@ -979,7 +985,12 @@ class Netlist {
   private: //Fast lookups
     vtr::vector_map<StringId, BlockId> block_name_to_block_id_;
     vtr::vector_map<StringId, NetId> net_name_to_net_id_;
-    std::unordered_map<std::string, StringId> string_to_string_id_;
+
+    //Open-addressing hash table (with linear probing) of the string ids, hashed by the
+    //value of their string. Unlike a std::unordered_map<std::string, StringId> it does
+    //not store a second copy of each string, which matters for netlists with millions
+    //of block and net names. Empty slots hold StringId::INVALID()
+    std::vector<StringId> string_lookup_;
 };
 
 #include "netlist.tpp"
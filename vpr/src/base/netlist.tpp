@@ -1393,6 +1393,9 @@ void Netlist<BlockId, PortId, PinId, NetId>::shrink_to_fit() {
     net_ids_.shrink_to_fit();
     net_names_.shrink_to_fit();
     net_pins_.shrink_to_fit();
+    for (auto& pin_collection : net_pins_) {
+        pin_collection.shrink_to_fit();
+    }
     VTR_ASSERT(validate_net_sizes());
 
     //String data
@@ -1803,16 +1806,22 @@ bool Netlist<BlockId, PortId, PinId, NetId>::verify_block_invariants() const {
  */
 template<typename BlockId, typename PortId, typename PinId, typename NetId>
 typename Netlist<BlockId, PortId, PinId, NetId>::StringId Netlist<BlockId, PortId, PinId, NetId>::find_string(const std::string& str) const {
-    auto iter = string_to_string_id_.find(str);
-    if (iter != string_to_string_id_.end()) {
-        StringId str_id = iter->second;
+    if (string_lookup_.empty()) {
+        return StringId::INVALID();
+    }
 
-        VTR_ASSERT_SAFE(str_id);
-        VTR_ASSERT_SAFE(strings_[str_id] == str);
+    //The look-up is never full, so the probing stops at an empty slot if the string does not exist
+    size_t mask = string_lookup_.size() - 1;
+    for (size_t islot = std::hash<std::string>()(str) & mask;; islot = (islot + 1) & mask) {
+        StringId str_id = string_lookup_[islot];
+        if (!str_id) {
+            return StringId::INVALID();
+        }
 
-        return str_id;
-    } else {
-        return StringId::INVALID();
+        VTR_ASSERT_SAFE(valid_string_id(str_id));
+        if (strings_[str_id] == str) {
+            return str_id;
+        }
     }
 }
 
@@ -1950,16 +1959,18 @@ typename Netlist<BlockId, PortId, PinId, NetId>::StringId Netlist<BlockId, PortI
         str_id = StringId(string_ids_.size());
         string_ids_.push_back(str_id);
 
-        //Store the reverse look-up
-        auto key = str;
-        string_to_string_id_[key] = str_id;
-
         //Initialize the data
         strings_.emplace_back(str);
+
+        //Store the reverse look-up, keeping it at most half full
+        if (2 * string_ids_.size() > string_lookup_.size()) {
+            rebuild_string_lookup(std::max<size_t>(2 * string_lookup_.size(), 64));
+        } else {
+            insert_string_lookup(str_id);
+        }
     }
 
     //Check post-conditions: sizes
-    VTR_ASSERT(string_to_string_id_.size() == string_ids_.size());
     VTR_ASSERT(strings_.size() == string_ids_.size());
 
     //Check post-conditions: values
@@ -1969,6 +1980,27 @@ typename Netlist<BlockId, PortId, PinId, NetId>::StringId Netlist<BlockId, PortI
     return str_id;
 }
 
+template<typename BlockId, typename PortId, typename PinId, typename NetId>
+void Netlist<BlockId, PortId, PinId, NetId>::rebuild_string_lookup(size_t num_slots) {
+    VTR_ASSERT((num_slots & (num_slots - 1)) == 0);
+    VTR_ASSERT(num_slots > string_ids_.size());
+
+    string_lookup_.assign(num_slots, StringId::INVALID());
+    for (StringId str_id : string_ids_) {
+        insert_string_lookup(str_id);
+    }
+}
+
+template<typename BlockId, typename PortId, typename PinId, typename NetId>
+void Netlist<BlockId, PortId, PinId, NetId>::insert_string_lookup(const StringId str_id) {
+    size_t mask = string_lookup_.size() - 1;
+    size_t islot = std::hash<std::string>()(strings_[str_id]) & mask;
+    while (string_lookup_[islot]) {
+        islot = (islot + 1) & mask;
+    }
+    string_lookup_[islot] = str_id;
+}
+
 template<typename BlockId, typename PortId, typename PinId, typename NetId>
 NetId Netlist<BlockId, PortId, PinId, NetId>::find_net(const typename Netlist<BlockId, PortId, PinId, NetId>::StringId name_id) const {
     VTR_ASSERT_SAFE(valid_string_id(name_id));
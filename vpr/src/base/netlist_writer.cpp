@@ -10,11 +10,13 @@
 #include <memory>
 #include <unordered_set>
 #include <cmath>
+#include <exception>
 
 #include "vtr_assert.h"
 #include "vtr_util.h"
 #include "vtr_log.h"
 #include "vtr_logic.h"
+#include "vtr_parallel.h"
 #include "vtr_version.h"
 
 #include "vpr_error.h"
@@ -100,17 +102,17 @@
 //
 // File local function declarations
 //
-std::string indent(size_t depth);
+const std::string& indent(size_t depth);
 double get_delay_ps(double delay_sec);
 
 void print_blif_port(std::ostream& os, size_t& unconn_count, const std::string& port_name, const std::vector<std::string>& nets, int depth);
 void print_verilog_port(std::ostream& os, const std::string& port_name, const std::vector<std::string>& nets, PortType type, int depth);
 
 std::string create_unconn_net(size_t& unconn_count);
-std::string escape_verilog_identifier(const std::string id);
-std::string escape_sdf_identifier(const std::string id);
+std::string escape_verilog_identifier(const std::string& id);
+std::string escape_sdf_identifier(const std::string& id);
 bool is_special_sdf_char(char c);
-std::string join_identifier(std::string lhs, std::string rhs);
+std::string join_identifier(const std::string& lhs, const std::string& rhs);
 
 //
 //
@@ -219,10 +221,10 @@ class LutInst : public Instance {
         VTR_ASSERT(port_conns_.count("out"));
         VTR_ASSERT(port_conns_.size() == 2);
 
-        print_verilog_port(os, "in", port_conns_["in"], PortType::INPUT, depth + 1);
+        print_verilog_port(os, "in", port_conns_.at("in"), PortType::INPUT, depth + 1);
         os << ","
            << "\n";
-        print_verilog_port(os, "out", port_conns_["out"], PortType::OUTPUT, depth + 1);
+        print_verilog_port(os, "out", port_conns_.at("out"), PortType::OUTPUT, depth + 1);
         os << "\n";
 
         os << indent(depth) << ");\n\n";
@@ -232,7 +234,7 @@ class LutInst : public Instance {
         os << indent(depth) << ".names ";
 
         //Input nets
-        for (const auto& net : port_conns_["in"]) {
+        for (const auto& net : port_conns_.at("in")) {
             if (net == "") {
                 //Disconnected
                 os << create_unconn_net(unconn_count) << " ";
@@ -241,10 +243,10 @@ class LutInst : public Instance {
             }
         }
 
-        VTR_ASSERT(port_conns_["out"].size() == 1);
+        VTR_ASSERT(port_conns_.at("out").size() == 1);
 
         //Output net
-        auto out_net = port_conns_["out"][0];
+        auto out_net = port_conns_.at("out")[0];
         if (out_net == "") {
             //Disconnected
             os << create_unconn_net(unconn_count) << " ";
@@ -308,7 +310,7 @@ class LutInst : public Instance {
         }
         if (minterms_set == 0 && maxterms_set == 0) {
             //Handle the always true/false case
-            for (size_t i = 0; i < port_conns_["in"].size(); ++i) {
+            for (size_t i = 0; i < port_conns_.at("in").size(); ++i) {
                 os << "-"; //Don't care for all inputs
             }
 
@@ -752,10 +754,10 @@ class Assignment {
         : lval_(lval)
         , rval_(rval) {}
 
-    void print_verilog(std::ostream& os, std::string indent) {
+    void print_verilog(std::ostream& os, const std::string& indent) {
         os << indent << "assign " << escape_verilog_identifier(lval_) << " = " << escape_verilog_identifier(rval_) << ";\n";
     }
-    void print_blif(std::ostream& os, std::string indent) {
+    void print_blif(std::ostream& os, const std::string& indent) {
         os << indent << ".names " << rval_ << " " << lval_ << "\n";
         os << indent << "1 1\n";
     }
@@ -841,14 +843,56 @@ class NetlistWriterVisitor : public NetlistVisitor {
     }
 
     void finish_impl() override {
-        print_verilog();
-        print_blif();
-        print_sdf();
+        //The cell instances are most of the Verilog and the SDF, so they are printed to
+        //strings in parallel chunks, which are then written in order. The BLIF is printed
+        //as a whole by one of the workers, since its unconnected nets are numbered in the
+        //order of the instances.
+        //
+        //The instances are only read by the workers, and the timing graph is only used
+        //for the interconnect delays, which are printed after the workers are done.
+        constexpr size_t INSTANCES_PER_CHUNK = 1024;
+        size_t num_chunks = (cell_instances_.size() + INSTANCES_PER_CHUNK - 1) / INSTANCES_PER_CHUNK;
+
+        std::vector<std::string> verilog_chunks(num_chunks);
+        std::vector<std::string> sdf_chunks(num_chunks);
+        std::vector<std::exception_ptr> errors(1 + 2 * num_chunks);
+        vtr::parallel_for(errors.size(), [&](size_t item) {
+            try {
+                if (item == 0) {
+                    print_blif();
+                    return;
+                }
+
+                size_t ichunk = (item - 1) / 2;
+                bool is_verilog = ((item - 1) % 2 == 0);
+
+                std::ostringstream os;
+                size_t end = std::min((ichunk + 1) * INSTANCES_PER_CHUNK, cell_instances_.size());
+                for (size_t inst = ichunk * INSTANCES_PER_CHUNK; inst < end; ++inst) {
+                    if (is_verilog) {
+                        cell_instances_[inst]->print_verilog(os, 1);
+                    } else {
+                        cell_instances_[inst]->print_sdf(os, 1);
+                    }
+                }
+                (is_verilog ? verilog_chunks : sdf_chunks)[ichunk] = os.str();
+            } catch (...) {
+                errors[item] = std::current_exception();
+            }
+        });
+        for (const std::exception_ptr& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        print_verilog(verilog_chunks);
+        print_sdf(sdf_chunks);
     }
 
   private: //Internal Helper functions
-    //Writes out the verilog netlist
-    void print_verilog(int depth = 0) {
+    //Writes out the verilog netlist, with the cell instances already printed in chunks
+    void print_verilog(const std::vector<std::string>& cell_instance_chunks, int depth = 0) {
         verilog_os_ << indent(depth) << "//Verilog generated by VPR " << vtr::VERSION << " from post-place-and-route implementation\n";
         verilog_os_ << indent(depth) << "module " << top_module_name_ << " (\n";
 
@@ -911,8 +955,9 @@ class NetlistWriterVisitor : public NetlistVisitor {
         //All the cell instances
         verilog_os_ << "\n";
         verilog_os_ << indent(depth + 1) << "//Cell instances\n";
-        for (auto& inst : cell_instances_) {
-            inst->print_verilog(verilog_os_, depth + 1);
+        VTR_ASSERT(depth == 0);
+        for (const std::string& chunk : cell_instance_chunks) {
+            verilog_os_.write(chunk.data(), chunk.size());
         }
 
         verilog_os_ << "\n";
@@ -972,8 +1017,8 @@ class NetlistWriterVisitor : public NetlistVisitor {
         blif_os_ << indent(depth) << ".end\n";
     }
 
-    //Writes out the SDF
-    void print_sdf(int depth = 0) {
+    //Writes out the SDF, with the cell instances already printed in chunks
+    void print_sdf(const std::vector<std::string>& cell_instance_chunks, int depth = 0) {
         sdf_os_ << indent(depth) << "(DELAYFILE\n";
         sdf_os_ << indent(depth + 1) << "(SDFVERSION \"2.1\")\n";
         sdf_os_ << indent(depth + 1) << "(DESIGN \"" << top_module_name_ << "\")\n";
@@ -1016,8 +1061,9 @@ class NetlistWriterVisitor : public NetlistVisitor {
         }
 
         //Cells
-        for (const auto& inst : cell_instances_) {
-            inst->print_sdf(sdf_os_, depth + 1);
+        VTR_ASSERT(depth == 0);
+        for (const std::string& chunk : cell_instance_chunks) {
+            sdf_os_.write(chunk.data(), chunk.size());
         }
 
         sdf_os_ << indent(depth) << ")\n";
@@ -1998,9 +2044,21 @@ void netlist_writer(const std::string basename, std::shared_ptr<const AnalysisDe
     VTR_LOG("Writing Implementation Netlist: %s\n", blif_filename.c_str());
     VTR_LOG("Writing Implementation SDF    : %s\n", sdf_filename.c_str());
 
-    std::ofstream verilog_os(verilog_filename);
-    std::ofstream blif_os(blif_filename);
-    std::ofstream sdf_os(sdf_filename);
+    //The netlists are written in large blocks, since they are often hundreds of megabytes
+    constexpr size_t FILE_BUFFER_SIZE = 1 << 20;
+    std::vector<char> verilog_buffer(FILE_BUFFER_SIZE);
+    std::vector<char> blif_buffer(FILE_BUFFER_SIZE);
+    std::vector<char> sdf_buffer(FILE_BUFFER_SIZE);
+
+    std::ofstream verilog_os;
+    std::ofstream blif_os;
+    std::ofstream sdf_os;
+    verilog_os.rdbuf()->pubsetbuf(verilog_buffer.data(), verilog_buffer.size());
+    blif_os.rdbuf()->pubsetbuf(blif_buffer.data(), blif_buffer.size());
+    sdf_os.rdbuf()->pubsetbuf(sdf_buffer.data(), sdf_buffer.size());
+    verilog_os.open(verilog_filename);
+    blif_os.open(blif_filename);
+    sdf_os.open(sdf_filename);
 
     NetlistWriterVisitor visitor(verilog_os, blif_os, sdf_os, delay_calc);
 
@@ -2014,13 +2072,19 @@ void netlist_writer(const std::string basename, std::shared_ptr<const AnalysisDe
 //
 
 //Returns a blank string for indenting the given depth
-std::string indent(size_t depth) {
-    std::string indent_ = "    ";
-    std::string new_indent;
-    for (size_t i = 0; i < depth; ++i) {
-        new_indent += indent_;
-    }
-    return new_indent;
+//
+//The strings are built once, as indent() is called for nearly every line of the netlists
+const std::string& indent(size_t depth) {
+    constexpr size_t MAX_INDENT_DEPTH = 32;
+    static const std::vector<std::string> indents = []() {
+        std::vector<std::string> depth_indents(MAX_INDENT_DEPTH);
+        for (size_t i = 1; i < MAX_INDENT_DEPTH; ++i) {
+            depth_indents[i] = depth_indents[i - 1] + "    ";
+        }
+        return depth_indents;
+    }();
+    VTR_ASSERT(depth < MAX_INDENT_DEPTH);
+    return indents[depth];
 }
 
 //Returns the delay in pico-seconds from a floating point delay
@@ -2119,7 +2183,7 @@ void print_verilog_port(std::ostream& os, const std::string& port_name, const st
 }
 
 //Escapes the given identifier to be safe for verilog
-std::string escape_verilog_identifier(const std::string identifier) {
+std::string escape_verilog_identifier(const std::string& identifier) {
     //Verilog allows escaped identifiers
     //
     //The escaped identifiers start with a literal back-slash '\'
@@ -2128,9 +2192,11 @@ std::string escape_verilog_identifier(const std::string identifier) {
     //We pre-pend the escape back-slash and append a space to avoid
     //the identifier gobbling up adjacent characters like commas which
     //are not actually part of the identifier
-    std::string prefix = "\\";
-    std::string suffix = " ";
-    std::string escaped_name = prefix + identifier + suffix;
+    std::string escaped_name;
+    escaped_name.reserve(identifier.size() + 2);
+    escaped_name += '\\';
+    escaped_name += identifier;
+    escaped_name += ' ';
 
     return escaped_name;
 }
@@ -2166,12 +2232,13 @@ bool is_special_sdf_char(char c) {
 }
 
 //Escapes the given identifier to be safe for sdf
-std::string escape_sdf_identifier(const std::string identifier) {
+std::string escape_sdf_identifier(const std::string& identifier) {
     //SDF allows escaped characters
     //
     //We look at each character in the string and escape it if it is
     //a special character
     std::string escaped_name;
+    escaped_name.reserve(identifier.size());
 
     for (char c : identifier) {
         if (is_special_sdf_char(c)) {
@@ -2185,6 +2252,11 @@ std::string escape_sdf_identifier(const std::string identifier) {
 }
 
 //Joins two identifier strings
-std::string join_identifier(std::string lhs, std::string rhs) {
-    return lhs + '_' + rhs;
+std::string join_identifier(const std::string& lhs, const std::string& rhs) {
+    std::string name;
+    name.reserve(lhs.size() + 1 + rhs.size());
+    name += lhs;
+    name += '_';
+    name += rhs;
+    return name;
 }
@@ -5,6 +5,7 @@
 #include <climits>
 #include <cstdlib>
 #include <cmath>
+#include <map>
 
 #include "vtr_util.h"
 #include "vtr_memory.h"
@@ -70,6 +71,11 @@ int binary_search_place_and_route(const t_placer_opts& placer_opts_ref,
 
     t_clb_opins_used saved_clb_opins_used_locally;
 
+    //The routing result of each channel width tried so far. The router is deterministic
+    //for a given placement and channel width, so a width is never routed twice
+    std::map<int, bool> route_results;
+    bool reused_result;
+
     int attempt_count;
     int udsd_multiplier;
     int warnings;
@@ -82,6 +88,14 @@ int binary_search_place_and_route(const t_placer_opts& placer_opts_ref,
 
     t_placer_opts placer_opts = placer_opts_ref;
 
+    /* With the adaptive congestion schedule the channel widths of the search are  *
+     * abandoned as soon as the routing predictor finds them unlikely to route,    *
+     * since a channel width found unroutable only costs a slightly wider result.   */
+    t_router_opts search_router_opts = router_opts;
+    if (router_opts.adaptive_pres_fac && router_opts.routing_failure_predictor == SAFE) {
+        search_router_opts.routing_failure_predictor = AGGRESSIVE;
+    }
+
     /* Allocate the major routing structures. */
 
     if (router_opts.route_type == GLOBAL) {
@@ -174,22 +188,29 @@ int binary_search_place_and_route(const t_placer_opts& placer_opts_ref,
             break;
         }
 
-        if (placer_opts.place_freq == PLACE_ALWAYS) {
-            placer_opts.place_chan_width = current;
-            try_place(placer_opts, annealing_sched, router_opts, analysis_opts,
-                      arch->Chans, det_routing_arch, segment_inf,
-                      arch->Directs, arch->num_directs);
+        reused_result = route_results.count(current);
+        if (reused_result) {
+            success = route_results[current];
+            VTR_LOG("Channel width %d was already %s\n", current, success ? "routed" : "found unroutable");
+        } else {
+            if (placer_opts.place_freq == PLACE_ALWAYS) {
+                placer_opts.place_chan_width = current;
+                try_place(placer_opts, annealing_sched, router_opts, analysis_opts,
+                          arch->Chans, det_routing_arch, segment_inf,
+                          arch->Directs, arch->num_directs);
+            }
+            success = try_route(current,
+                                search_router_opts,
+                                analysis_opts,
+                                det_routing_arch, segment_inf,
+                                net_delay,
+                                timing_info,
+                                delay_calc,
+                                arch->Chans,
+                                arch->Directs, arch->num_directs,
+                                (attempt_count == 0) ? ScreenUpdatePriority::MAJOR : ScreenUpdatePriority::MINOR);
+            route_results[current] = success;
         }
-        success = try_route(current,
-                            router_opts,
-                            analysis_opts,
-                            det_routing_arch, segment_inf,
-                            net_delay,
-                            timing_info,
-                            delay_calc,
-                            arch->Chans,
-                            arch->Directs, arch->num_directs,
-                            (attempt_count == 0) ? ScreenUpdatePriority::MAJOR : ScreenUpdatePriority::MINOR);
         attempt_count++;
         fflush(stdout);
 
@@ -207,8 +228,11 @@ int binary_search_place_and_route(const t_placer_opts& placer_opts_ref,
                 VTR_LOG_WARN("Fc_output was too high and was clipped to full (maximum) connectivity.\n");
             }
 
-            /* Save routing in case it is best. */
-            save_routing(best_routing, route_ctx.clb_opins_used_locally, saved_clb_opins_used_locally);
+            /* Save routing in case it is best. A reused result is the current best routing already,
+             * while the routing structures may hold a later (failed) attempt */
+            if (!reused_result) {
+                save_routing(best_routing, route_ctx.clb_opins_used_locally, saved_clb_opins_used_locally);
+            }
 
             //If the user gave us a minW hint (and we routed successfully at that width)
             //make the initial guess closer to the current value instead of the standard guess.
@@ -306,21 +330,30 @@ int binary_search_place_and_route(const t_placer_opts& placer_opts_ref,
             fflush(stdout);
             if (current < 1)
                 break;
-            if (placer_opts.place_freq == PLACE_ALWAYS) {
-                placer_opts.place_chan_width = current;
-                try_place(placer_opts, annealing_sched, router_opts, analysis_opts,
-                          arch->Chans, det_routing_arch, segment_inf,
-                          arch->Directs, arch->num_directs);
+
+            //Widths found unroutable by the binary search (typically its lower bound) are not routed again
+            reused_result = route_results.count(current) && !route_results[current];
+            if (reused_result) {
+                success = false;
+                VTR_LOG("Channel width %d was already found unroutable\n", current);
+            } else {
+                if (placer_opts.place_freq == PLACE_ALWAYS) {
+                    placer_opts.place_chan_width = current;
+                    try_place(placer_opts, annealing_sched, router_opts, analysis_opts,
+                              arch->Chans, det_routing_arch, segment_inf,
+                              arch->Directs, arch->num_directs);
+                }
+                success = try_route(current,
+                                    search_router_opts,
+                                    analysis_opts,
+                                    det_routing_arch,
+                                    segment_inf, net_delay,
+                                    timing_info,
+                                    delay_calc,
+                                    arch->Chans, arch->Directs, arch->num_directs,
+                                    ScreenUpdatePriority::MINOR);
+                route_results[current] = success;
             }
-            success = try_route(current,
-                                router_opts,
-                                analysis_opts,
-                                det_routing_arch,
-                                segment_inf, net_delay,
-                                timing_info,
-                                delay_calc,
-                                arch->Chans, arch->Directs, arch->num_directs,
-                                ScreenUpdatePriority::MINOR);
 
             if (success && Fc_clipped == false) {
                 final = current;
@@ -1,7 +1,11 @@
 #include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
 
 #include "read_activity.h"
 
+#include "vtr_binary_activity.h"
 #include "vtr_log.h"
 #include "vtr_util.h"
 
@@ -10,6 +14,9 @@
 #include "atom_netlist.h"
 
 static bool add_activity_to_net(const AtomNetlist& netlist, std::unordered_map<AtomNetId, t_net_power>& atom_net_power, char* net_name, float probability, float density);
+static void check_activity_of_nets(const AtomNetlist& netlist, std::unordered_map<AtomNetId, t_net_power>& atom_net_power);
+static bool is_binary_activity_file(const char* activity_file);
+static void read_binary_activity(const AtomNetlist& netlist, std::unordered_map<AtomNetId, t_net_power>& atom_net_power, const char* activity_file);
 
 static bool add_activity_to_net(const AtomNetlist& netlist, std::unordered_map<AtomNetId, t_net_power>& atom_net_power, char* net_name, float probability, float density) {
     AtomNetId net_id = netlist.find_net(net_name);
@@ -25,6 +32,91 @@ static bool add_activity_to_net(const AtomNetlist& netlist, std::unordered_map<A
     return true;
 }
 
+static bool is_binary_activity_file(const char* activity_file) {
+    char magic[sizeof(vtr::BINARY_ACTIVITY_MAGIC)];
+
+    std::ifstream fp(activity_file, std::ios::in | std::ios::binary);
+    fp.read(magic, sizeof(magic));
+
+    return size_t(fp.gcount()) == sizeof(magic)
+           && 0 == std::memcmp(magic, vtr::BINARY_ACTIVITY_MAGIC, sizeof(magic));
+}
+
+/*
+ * Loads a binary activity file (see vtr_binary_activity.h) in a single read.
+ * When the checksum of the file matches the net names of the netlist, the records are
+ * in the order of the net ids and are assigned directly. Otherwise, nets are looked up by name
+ */
+static void read_binary_activity(const AtomNetlist& netlist, std::unordered_map<AtomNetId, t_net_power>& atom_net_power, const char* activity_file) {
+    std::ifstream fp(activity_file, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!fp.is_open()) {
+        VPR_FATAL_ERROR(VPR_ERROR_BLIF_F,
+                        "Error: could not open activity file: %s\n", activity_file);
+    }
+
+    std::vector<char> data(size_t(fp.tellg()));
+    fp.seekg(0);
+    fp.read(data.data(), data.size());
+
+    vtr::t_binary_activity_header header;
+    if (data.size() < sizeof(header)) {
+        VPR_FATAL_ERROR(VPR_ERROR_BLIF_F,
+                        "Error: binary activity file %s is truncated\n", activity_file);
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    if (vtr::BINARY_ACTIVITY_VERSION != header.version) {
+        VPR_FATAL_ERROR(VPR_ERROR_BLIF_F,
+                        "Error: binary activity file %s is not of version %u\n",
+                        activity_file, vtr::BINARY_ACTIVITY_VERSION);
+    }
+
+    size_t records_offset = sizeof(header);
+    size_t names_offset = records_offset + header.num_nets * sizeof(vtr::t_binary_activity_record);
+    if (data.size() != names_offset + header.names_size) {
+        VPR_FATAL_ERROR(VPR_ERROR_BLIF_F,
+                        "Error: size of binary activity file %s does not match its header\n", activity_file);
+    }
+
+    const char* names = data.data() + names_offset;
+    std::vector<vtr::t_binary_activity_record> records(header.num_nets);
+    std::memcpy(records.data(), data.data() + records_offset, records.size() * sizeof(vtr::t_binary_activity_record));
+
+    for (const vtr::t_binary_activity_record& record : records) {
+        if (record.name_offset + record.name_length > header.names_size) {
+            VPR_FATAL_ERROR(VPR_ERROR_BLIF_F,
+                            "Error: invalid net name in binary activity file %s\n", activity_file);
+        }
+    }
+
+    /* Records are in the net id order when the net names are the same */
+    bool same_net_order = (header.num_nets == size_t(netlist.nets().size()));
+    if (same_net_order) {
+        uint64_t checksum = vtr::BINARY_ACTIVITY_CHECKSUM_INIT;
+        for (auto net_id : netlist.nets()) {
+            const std::string& net_name = netlist.net_name(net_id);
+            checksum = vtr::binary_activity_checksum(checksum, net_name.data(), net_name.size());
+        }
+        same_net_order = (checksum == header.net_names_checksum);
+    }
+
+    if (same_net_order) {
+        size_t irecord = 0;
+        for (auto net_id : netlist.nets()) {
+            atom_net_power[net_id].probability = records[irecord].probability;
+            atom_net_power[net_id].density = records[irecord].density;
+            ++irecord;
+        }
+        return;
+    }
+
+    std::string net_name;
+    for (const vtr::t_binary_activity_record& record : records) {
+        net_name.assign(names + record.name_offset, record.name_length);
+        add_activity_to_net(netlist, atom_net_power, &net_name[0], record.probability, record.density);
+    }
+}
+
 std::unordered_map<AtomNetId, t_net_power> read_activity(const AtomNetlist& netlist, const char* activity_file) {
     char buf[vtr::bufsize];
     char* ptr;
@@ -41,6 +133,12 @@ std::unordered_map<AtomNetId, t_net_power> read_activity(const AtomNetlist& netl
         atom_net_power[net_id].density = -1.0;
     }
 
+    if (is_binary_activity_file(activity_file)) {
+        read_binary_activity(netlist, atom_net_power, activity_file);
+        check_activity_of_nets(netlist, atom_net_power);
+        return atom_net_power;
+    }
+
     act_file_hdl = vtr::fopen(activity_file, "r");
     if (act_file_hdl == nullptr) {
         VPR_FATAL_ERROR(VPR_ERROR_BLIF_F,
@@ -58,7 +156,12 @@ std::unordered_map<AtomNetId, t_net_power> read_activity(const AtomNetlist& netl
     }
     fclose(act_file_hdl);
 
-    /* Make sure all nets have an activity value */
+    check_activity_of_nets(netlist, atom_net_power);
+    return atom_net_power;
+}
+
+/* Make sure all nets have an activity value */
+static void check_activity_of_nets(const AtomNetlist& netlist, std::unordered_map<AtomNetId, t_net_power>& atom_net_power) {
     for (auto net_id : netlist.nets()) {
         if (atom_net_power[net_id].probability < 0.0
             || atom_net_power[net_id].density < 0.0) {
@@ -67,5 +170,4 @@ std::unordered_map<AtomNetId, t_net_power> read_activity(const AtomNetlist& netl
                             netlist.net_name(net_id).c_str());
         }
     }
-    return atom_net_power;
 }
@@ -5,6 +5,8 @@
 #include "atom_netlist_fwd.h"
 #include "vpr_types.h"
 
+//Reads the activity of all the nets of a netlist from a text (.act) or binary activity file.
+//Binary files (see vtr_binary_activity.h) are detected from their first bytes
 std::unordered_map<AtomNetId, t_net_power> read_activity(const AtomNetlist& netlist, const char* activity_file);
 
 #endif
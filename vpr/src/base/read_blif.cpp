@@ -6,8 +6,9 @@
  * hierarchical) netlist in Berkely Logic Interchange Format (BLIF) file, and
  * builds a netlist data structure (AtomNetlist) from it.
  *
- * BLIF text parsing is handled by the blifparse library, while this file is responsible
- * for creating the netlist data structure.
+ * BLIF text parsing is handled by the memory-mapped parser (blif_mmap_parser.h), which
+ * falls back to the blifparse library for anything it does not support (including errors),
+ * while this file is responsible for creating the netlist data structure.
  *
  * The main object of interest is the BlifAllocCallback struct, which implements the
  * blifparse callback interface.  The callback methods are then called when basic blif
@@ -36,6 +37,7 @@
 #include "vpr_error.h"
 #include "globals.h"
 #include "read_blif.h"
+#include "blif_mmap_parser.h"
 #include "arch_types.h"
 #include "echo_files.h"
 #include "hash.h"
@@ -663,7 +665,9 @@ AtomNetlist read_blif(e_circuit_format circuit_format,
     std::string netlist_id = vtr::secure_digest_file(blif_file);
 
     BlifAllocCallback alloc_callback(circuit_format, netlist, netlist_id, user_models, library_models);
-    blifparse::blif_parse_filename(blif_file, alloc_callback);
+    if (!blif_mmap_parse_filename(blif_file, alloc_callback)) {
+        blifparse::blif_parse_filename(blif_file, alloc_callback);
+    }
 
     return netlist;
 }
@@ -5,10 +5,13 @@
  * Read a circuit netlist in XML format and populate the netlist data structures for VPR
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <ctime>
 #include <map>
+#include <memory>
+#include <unordered_map>
 
 #include "pugixml.hpp"
 #include "pugixml_loc.hpp"
@@ -30,20 +33,49 @@
 #include "atom_netlist.h"
 #include "read_xml_util.h"
 #include "read_netlist.h"
+#include "net_file_cache.h"
 #include "pb_type_graph.h"
 
+typedef std::vector<std::pair<int, t_pb_route>> t_pb_route_entries;
+
+//The tag of the ports of a block in the netlist file
+enum e_net_file_port_kind {
+    NET_FILE_INPUTS,
+    NET_FILE_OUTPUTS,
+    NET_FILE_CLOCKS
+};
+
 static const char* netlist_file_name = nullptr;
 
-static int processPorts(pugi::xml_node Parent, t_pb* pb, t_pb_routes& pb_route, const pugiutil::loc_data& loc_data);
+//The driver pins of the '<pin>-><interconnect>' tokens of the netlist file, for each mode
+//of each pb_graph_node. The same tokens repeat in every clustered block of a type, so they
+//are only resolved against the pb_graph once
+static std::map<std::pair<const t_pb_graph_node*, int>, std::unordered_map<std::string, const t_pb_graph_pin*>> interconnect_driver_pins;
+
+static void parse_net_file_top(pugi::xml_node top, t_net_file_top& net_top, const pugiutil::loc_data& loc_data);
+
+static void parse_net_file_block(pugi::xml_node Parent, t_net_file_block& block, bool is_clb, const pugiutil::loc_data& loc_data);
+
+static void parse_net_file_port_group(pugi::xml_node Parent, t_net_file_port_group& group, const pugiutil::loc_data& loc_data);
+
+static void parse_net_file_params(pugi::xml_node Parent, const char* child_name, std::vector<t_net_file_param>& params, const pugiutil::loc_data& loc_data);
+
+static void check_net_file_top(const t_net_file_top& net_top, const t_arch* arch, bool verify_file_digests);
 
-static void processPb(pugi::xml_node Parent, const ClusterBlockId index, t_pb* pb, t_pb_routes& pb_route, int* num_primitives, const pugiutil::loc_data& loc_data, ClusteredNetlist* clb_nlist);
+static int processPorts(const t_net_file_port_group& group, e_net_file_port_kind port_kind, t_pb* pb, t_pb_route_entries& pb_route);
 
-static void processComplexBlock(pugi::xml_node Parent,
+static void processPb(const t_net_file_block& Parent, const ClusterBlockId index, t_pb* pb, t_pb_route_entries& pb_route, int* num_primitives, ClusteredNetlist* clb_nlist);
+
+static void processComplexBlock(const t_net_file_block& clb_block,
                                 const ClusterBlockId index,
                                 int* num_primitives,
-                                const pugiutil::loc_data& loc_data,
+                                t_pb_route_entries& pb_route,
                                 ClusteredNetlist* clb_nlist);
 
+static const t_pb_graph_pin* find_interconnect_driver_pin(const t_pb_graph_node* pb_graph_node, int mode, int interconnect_line_num, const std::string& pin, int line);
+
+static void parse_pb_instance(const std::string& instance, int line, std::string& pb_type_name, int& pb_index);
+
 static int add_net_to_hash(t_hash** nhash, const char* net_name, int* ncount);
 
 static void load_external_nets_and_cb(ClusteredNetlist& clb_nlist);
@@ -56,7 +88,7 @@ static void mark_constant_generators(const ClusteredNetlist& clb_nlist, int verb
 
 static size_t mark_constant_generators_rec(const t_pb* pb, const t_pb_routes& pb_route, int verbosity);
 
-static t_pb_routes alloc_pb_route(t_pb_graph_node* pb_graph_node);
+static t_pb_routes alloc_pb_route(t_pb_route_entries& pb_route_entries, const ClusteredNetlist& clb_nlist, const ClusterBlockId index);
 
 static void load_atom_pin_mapping(const ClusteredNetlist& clb_nlist);
 static void set_atom_pin_mapping(const ClusteredNetlist& clb_nlist, const AtomBlockId atom_blk, const AtomPortId atom_port, const t_pb_graph_pin* gpin);
@@ -64,13 +96,14 @@ static void set_atom_pin_mapping(const ClusteredNetlist& clb_nlist, const AtomBl
 /**
  * Initializes the clb_nlist with info from a netlist
  * net_file - Name of the netlist file to read
+ * use_net_file_cache - Load the netlist from its binary cache when it is up to date, and write the cache otherwise
  */
 ClusteredNetlist read_netlist(const char* net_file,
                               const t_arch* arch,
                               bool verify_file_digests,
+                              bool use_net_file_cache,
                               int verbosity) {
     clock_t begin = clock();
-    size_t bcount = 0;
     std::vector<std::string> circuit_inputs, circuit_outputs, circuit_clocks;
 
     auto& atom_ctx = g_vpr_ctx.mutable_atom();
@@ -81,97 +114,54 @@ ClusteredNetlist read_netlist(const char* net_file,
     VTR_LOG("Begin loading packed FPGA netlist file.\n");
 
     //Save an identifier for the netlist based on it's contents
-    auto clb_nlist = ClusteredNetlist(net_file, vtr::secure_digest_file(net_file));
+    std::string net_file_digest = vtr::secure_digest_file(net_file);
+    auto clb_nlist = ClusteredNetlist(net_file, net_file_digest);
+
+    /* Save netlist file's name in file-scoped variable */
+    netlist_file_name = net_file;
+    interconnect_driver_pins.clear();
+
+    t_net_file_top net_top;
+    NetFileCacheReader cache_reader(net_file_cache_name(net_file));
+    bool from_cache = use_net_file_cache && cache_reader.open(net_file_digest, net_top);
 
     pugi::xml_document doc;
     pugiutil::loc_data loc_data;
-    try {
-        loc_data = pugiutil::load_xml(doc, net_file);
-    } catch (pugiutil::XmlError& e) {
-        vpr_throw(VPR_ERROR_NET_F, net_file, 0,
-                  "Failed to load netlist file '%s' (%s).\n", net_file, e.what());
+    if (!from_cache) {
+        try {
+            loc_data = pugiutil::load_xml(doc, net_file);
+        } catch (pugiutil::XmlError& e) {
+            vpr_throw(VPR_ERROR_NET_F, net_file, 0,
+                      "Failed to load netlist file '%s' (%s).\n", net_file, e.what());
+        }
     }
 
     try {
-        /* Save netlist file's name in file-scoped variable */
-        netlist_file_name = net_file;
-
-        /* Root node should be block */
-        auto top = doc.child("block");
-        if (!top) {
-            vpr_throw(VPR_ERROR_NET_F, net_file, loc_data.line(top),
-                      "Root element must be 'block'.\n");
-        }
-
-        /* Check top-level netlist attributes */
-        auto top_name = top.attribute("name");
-        if (!top_name) {
-            vpr_throw(VPR_ERROR_NET_F, net_file, loc_data.line(top),
-                      "Root element must have a 'name' attribute.\n");
-        }
-
-        VTR_LOG("Netlist generated from file '%s'.\n", top_name.value());
-
-        //Verify top level attributes
-        auto top_instance = pugiutil::get_attribute(top, "instance", loc_data);
-
-        if (strcmp(top_instance.value(), "FPGA_packed_netlist[0]") != 0) {
-            vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(top),
-                      "Expected top instance to be \"FPGA_packed_netlist[0]\", found \"%s\".",
-                      top_instance.value());
-        }
-
-        auto architecture_id = top.attribute("architecture_id");
-        if (architecture_id) {
-            //Netlist file has an architecture id, make sure it is
-            //consistent with the loaded architecture file.
-            //
-            //Note that we currently don't require that the architecture_id exists,
-            //to remain compatible with old .net files
-            std::string arch_id = architecture_id.value();
-            if (arch_id != arch->architecture_id) {
-                auto msg = vtr::string_fmt(
-                    "Netlist was generated from a different architecture file"
-                    " (loaded architecture ID: %s, netlist file architecture ID: %s)",
-                    arch->architecture_id, arch_id.c_str());
-                if (verify_file_digests) {
-                    vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(top), msg.c_str());
-                } else {
-                    VTR_LOGF_WARN(netlist_file_name, loc_data.line(top), "%s\n", msg.c_str());
-                }
+        pugi::xml_node top;
+        if (!from_cache) {
+            /* Root node should be block */
+            top = doc.child("block");
+            if (!top) {
+                vpr_throw(VPR_ERROR_NET_F, net_file, loc_data.line(top),
+                          "Root element must be 'block'.\n");
             }
+            parse_net_file_top(top, net_top, loc_data);
         }
 
-        auto atom_netlist_id = top.attribute("atom_netlist_id");
-        if (atom_netlist_id) {
-            //Netlist file has an_atom netlist_id, make sure it is
-            //consistent with the loaded atom netlist.
-            //
-            //Note that we currently don't require that the atom_netlist_id exists,
-            //to remain compatible with old .net files
-            std::string atom_nl_id = atom_netlist_id.value();
-            if (atom_nl_id != atom_ctx.nlist.netlist_id()) {
-                auto msg = vtr::string_fmt(
-                    "Netlist was generated from a different atom netlist file"
-                    " (loaded atom netlist ID: %s, packed netlist atom netlist ID: %s)",
-                    atom_nl_id.c_str(), atom_ctx.nlist.netlist_id().c_str());
-                if (verify_file_digests) {
-                    vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(top), msg.c_str());
-                } else {
-                    VTR_LOGF_WARN(netlist_file_name, loc_data.line(top), "%s\n", msg.c_str());
-                }
-            }
+        //The cache is only written once the whole netlist file has been parsed and checked
+        std::unique_ptr<NetFileCacheWriter> cache_writer;
+        if (use_net_file_cache && !from_cache) {
+            cache_writer = std::make_unique<NetFileCacheWriter>(net_file_cache_name(net_file), net_file_digest, net_top);
         }
 
-        //Collect top level I/Os
-        auto top_inputs = pugiutil::get_single_child(top, "inputs", loc_data);
-        circuit_inputs = vtr::split(top_inputs.text().get());
+        VTR_LOG("Netlist generated from file '%s'.\n", net_top.name.c_str());
 
-        auto top_outputs = pugiutil::get_single_child(top, "outputs", loc_data);
-        circuit_outputs = vtr::split(top_outputs.text().get());
+        check_net_file_top(net_top, arch, verify_file_digests);
 
-        auto top_clocks = pugiutil::get_single_child(top, "clocks", loc_data);
-        circuit_clocks = vtr::split(top_clocks.text().get());
+        //Collect top level I/Os
+        circuit_inputs = net_top.inputs;
+        circuit_outputs = net_top.outputs;
+        circuit_clocks = net_top.clocks;
 
         /* Parse all CLB blocks and all nets*/
 
@@ -179,18 +169,31 @@ ClusteredNetlist read_netlist(const char* net_file,
         for (auto blk_id : atom_ctx.nlist.blocks())
             atom_ctx.lookup.set_atom_pb(blk_id, nullptr);
 
-        //Count the number of blocks for allocation
-        bcount = pugiutil::count_children(top, "block", loc_data, pugiutil::ReqOpt::OPTIONAL);
-        if (bcount == 0)
+        if (net_top.num_blocks == 0)
             VTR_LOG_WARN("Packed netlist contains no clustered blocks\n");
 
-        /* Process netlist */
+        /* Process netlist
+         * Each clustered block is parsed and loaded before the next one, so that only
+         * the parsed contents of one block are kept at a time */
+        t_net_file_block clb_block;
+        t_pb_route_entries pb_route;
         unsigned i = 0;
-        for (auto curr_block = top.child("block"); curr_block; curr_block = curr_block.next_sibling("block")) {
-            processComplexBlock(curr_block, ClusterBlockId(i), &num_primitives, loc_data, &clb_nlist);
-            i++;
+        if (from_cache) {
+            for (; i < net_top.num_blocks; i++) {
+                cache_reader.read_block(clb_block);
+                processComplexBlock(clb_block, ClusterBlockId(i), &num_primitives, pb_route, &clb_nlist);
+            }
+        } else {
+            for (auto curr_block = top.child("block"); curr_block; curr_block = curr_block.next_sibling("block")) {
+                parse_net_file_block(curr_block, clb_block, true, loc_data);
+                processComplexBlock(clb_block, ClusterBlockId(i), &num_primitives, pb_route, &clb_nlist);
+                if (cache_writer) {
+                    cache_writer->write_block(clb_block);
+                }
+                i++;
+            }
         }
-        VTR_ASSERT(bcount == i);
+        VTR_ASSERT(net_top.num_blocks == i);
         VTR_ASSERT(clb_nlist.blocks().size() == i);
         VTR_ASSERT(num_primitives >= 0);
         VTR_ASSERT(static_cast<size_t>(num_primitives) == atom_ctx.nlist.blocks().size());
@@ -207,11 +210,17 @@ ClusteredNetlist read_netlist(const char* net_file,
         mark_constant_generators(clb_nlist, verbosity);
 
         load_external_nets_and_cb(clb_nlist);
+
+        if (cache_writer) {
+            cache_writer->commit();
+        }
     } catch (pugiutil::XmlError& e) {
         vpr_throw(VPR_ERROR_NET_F, e.filename_c_str(), e.line(),
                   "Error loading post-pack netlist (%s)", e.what());
     }
 
+    interconnect_driver_pins.clear();
+
     /* TODO: create this function later
      * check_top_IO_matches_IO_blocks(circuit_inputs, circuit_outputs, circuit_clocks, blist, bcount); */
 
@@ -255,151 +264,311 @@ ClusteredNetlist read_netlist(const char* net_file,
 }
 
 /**
- * XML parser to populate CLB info and to update nets with the nets of this CLB
- * Parent - XML tag for this CLB
- * clb - Array of CLBs in the netlist
- * index - index of the CLB to allocate and load information into
+ * XML parser of the top-level block of the netlist file
+ */
+static void parse_net_file_top(pugi::xml_node top, t_net_file_top& net_top, const pugiutil::loc_data& loc_data) {
+    net_top.line = loc_data.line(top);
+
+    /* Check top-level netlist attributes */
+    auto top_name = top.attribute("name");
+    if (!top_name) {
+        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, net_top.line,
+                  "Root element must have a 'name' attribute.\n");
+    }
+    net_top.name = top_name.value();
+
+    net_top.instance = pugiutil::get_attribute(top, "instance", loc_data).value();
+
+    auto architecture_id = top.attribute("architecture_id");
+    net_top.has_architecture_id = bool(architecture_id);
+    net_top.architecture_id = architecture_id.value();
+
+    auto atom_netlist_id = top.attribute("atom_netlist_id");
+    net_top.has_atom_netlist_id = bool(atom_netlist_id);
+    net_top.atom_netlist_id = atom_netlist_id.value();
+
+    auto top_inputs = pugiutil::get_single_child(top, "inputs", loc_data);
+    net_top.inputs = vtr::split(top_inputs.text().get());
+
+    auto top_outputs = pugiutil::get_single_child(top, "outputs", loc_data);
+    net_top.outputs = vtr::split(top_outputs.text().get());
+
+    auto top_clocks = pugiutil::get_single_child(top, "clocks", loc_data);
+    net_top.clocks = vtr::split(top_clocks.text().get());
+
+    //Count the number of blocks for allocation
+    net_top.num_blocks = pugiutil::count_children(top, "block", loc_data, pugiutil::ReqOpt::OPTIONAL);
+}
+
+/**
+ * XML parser of a block and its children
+ * Parent - XML tag for this block
+ * block - parsed block
+ * is_clb - true for a clustered block (i.e. a child of the top-level block)
  * loc_data - xml location info for error reporting
  */
-static void processComplexBlock(pugi::xml_node clb_block,
+static void parse_net_file_block(pugi::xml_node Parent, t_net_file_block& block, bool is_clb, const pugiutil::loc_data& loc_data) {
+    block.name = pugiutil::get_attribute(Parent, "name", loc_data).value();
+    block.instance = pugiutil::get_attribute(Parent, "instance", loc_data).value();
+    block.line = loc_data.line(Parent);
+    block.is_parsed = true;
+
+    if (is_clb) {
+        block.mode = pugiutil::get_attribute(Parent, "mode", loc_data).value();
+    } else if (block.name != "open") {
+        block.mode = Parent.attribute("mode").value();
+    } else {
+        /* physical block has no used primitives but it may have used routing */
+        auto lookahead1 = pugiutil::get_first_child(Parent, "outputs", loc_data, pugiutil::OPTIONAL);
+        if (!lookahead1) {
+            block.is_parsed = false;
+            block.children.clear();
+            return;
+        }
+        pugiutil::get_first_child(lookahead1, "port", loc_data); //Check that port child tag exists
+        block.mode = pugiutil::get_attribute(Parent, "mode", loc_data).value();
+    }
+
+    parse_net_file_port_group(pugiutil::get_single_child(Parent, "inputs", loc_data), block.inputs, loc_data);
+    parse_net_file_port_group(pugiutil::get_single_child(Parent, "outputs", loc_data), block.outputs, loc_data);
+    parse_net_file_port_group(pugiutil::get_single_child(Parent, "clocks", loc_data), block.clocks, loc_data);
+
+    auto attrs = pugiutil::get_single_child(Parent, "attributes", loc_data, pugiutil::OPTIONAL);
+    block.attributes_line = loc_data.line(attrs);
+    parse_net_file_params(attrs, "attribute", block.attributes, loc_data);
+
+    auto params = pugiutil::get_single_child(Parent, "parameters", loc_data, pugiutil::OPTIONAL);
+    block.parameters_line = loc_data.line(params);
+    parse_net_file_params(params, "parameter", block.parameters, loc_data);
+
+    //The children are parsed in place, so that their storage is reused from one clustered block to the next
+    size_t num_children = 0;
+    for (auto child = Parent.child("block"); child; child = child.next_sibling("block")) {
+        if (num_children == block.children.size()) {
+            block.children.emplace_back();
+        }
+        parse_net_file_block(child, block.children[num_children], false, loc_data);
+        ++num_children;
+    }
+    block.children.resize(num_children);
+}
+
+static void parse_net_file_port_group(pugi::xml_node Parent, t_net_file_port_group& group, const pugiutil::loc_data& loc_data) {
+    group.line = loc_data.line(Parent);
+
+    group.ports.clear();
+    for (auto Cur = pugiutil::get_first_child(Parent, "port", loc_data, pugiutil::OPTIONAL); Cur; Cur = Cur.next_sibling("port")) {
+        t_net_file_port port;
+        port.name = pugiutil::get_attribute(Cur, "name", loc_data).value();
+        port.pins = vtr::split(Cur.text().get());
+        port.line = loc_data.line(Cur);
+        group.ports.push_back(std::move(port));
+    }
+
+    group.rotation_maps.clear();
+    for (auto pin_rot_map = pugiutil::get_first_child(Parent, "port_rotation_map", loc_data, pugiutil::OPTIONAL);
+         pin_rot_map;
+         pin_rot_map = pin_rot_map.next_sibling("port_rotation_map")) {
+        t_net_file_port rotation_map;
+        rotation_map.name = pugiutil::get_attribute(pin_rot_map, "name", loc_data).value();
+        rotation_map.pins = vtr::split(pin_rot_map.text().get());
+        rotation_map.line = loc_data.line(pin_rot_map);
+        group.rotation_maps.push_back(std::move(rotation_map));
+    }
+}
+
+/**
+ * This parses a set of key-value pairs in the XML e.g. block attributes or parameters,
+ * which must be of the form <attributes><attribute name="attrName">attrValue</attribute> ... </attributes>
+ */
+static void parse_net_file_params(pugi::xml_node Parent, const char* child_name, std::vector<t_net_file_param>& params, const pugiutil::loc_data& loc_data) {
+    params.clear();
+    if (!Parent) {
+        return;
+    }
+    for (auto Cur = pugiutil::get_first_child(Parent, child_name, loc_data, pugiutil::OPTIONAL); Cur; Cur = Cur.next_sibling(child_name)) {
+        t_net_file_param param;
+        param.name = pugiutil::get_attribute(Cur, "name", loc_data).value();
+        param.value = Cur.text().get();
+        param.line = loc_data.line(Cur);
+        params.push_back(std::move(param));
+    }
+}
+
+/**
+ * Checks the top-level block of the netlist file against the architecture and the atom netlist
+ */
+static void check_net_file_top(const t_net_file_top& net_top, const t_arch* arch, bool verify_file_digests) {
+    auto& atom_ctx = g_vpr_ctx.atom();
+
+    //Verify top level attributes
+    if (net_top.instance != "FPGA_packed_netlist[0]") {
+        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, net_top.line,
+                  "Expected top instance to be \"FPGA_packed_netlist[0]\", found \"%s\".",
+                  net_top.instance.c_str());
+    }
+
+    if (net_top.has_architecture_id) {
+        //Netlist file has an architecture id, make sure it is
+        //consistent with the loaded architecture file.
+        //
+        //Note that we currently don't require that the architecture_id exists,
+        //to remain compatible with old .net files
+        const std::string& arch_id = net_top.architecture_id;
+        if (arch_id != arch->architecture_id) {
+            auto msg = vtr::string_fmt(
+                "Netlist was generated from a different architecture file"
+                " (loaded architecture ID: %s, netlist file architecture ID: %s)",
+                arch->architecture_id, arch_id.c_str());
+            if (verify_file_digests) {
+                vpr_throw(VPR_ERROR_NET_F, netlist_file_name, net_top.line, msg.c_str());
+            } else {
+                VTR_LOGF_WARN(netlist_file_name, net_top.line, "%s\n", msg.c_str());
+            }
+        }
+    }
+
+    if (net_top.has_atom_netlist_id) {
+        //Netlist file has an_atom netlist_id, make sure it is
+        //consistent with the loaded atom netlist.
+        //
+        //Note that we currently don't require that the atom_netlist_id exists,
+        //to remain compatible with old .net files
+        const std::string& atom_nl_id = net_top.atom_netlist_id;
+        if (atom_nl_id != atom_ctx.nlist.netlist_id()) {
+            auto msg = vtr::string_fmt(
+                "Netlist was generated from a different atom netlist file"
+                " (loaded atom netlist ID: %s, packed netlist atom netlist ID: %s)",
+                atom_nl_id.c_str(), atom_ctx.nlist.netlist_id().c_str());
+            if (verify_file_digests) {
+                vpr_throw(VPR_ERROR_NET_F, netlist_file_name, net_top.line, msg.c_str());
+            } else {
+                VTR_LOGF_WARN(netlist_file_name, net_top.line, "%s\n", msg.c_str());
+            }
+        }
+    }
+}
+
+/**
+ * Populates a CLB from its parsed block, and updates the nets with the nets of this CLB
+ * clb_block - parsed block of this CLB
+ * index - index of the CLB to allocate and load information into
+ * pb_route - storage of the intra-block routing, reused from one CLB to the next
+ */
+static void processComplexBlock(const t_net_file_block& clb_block,
                                 const ClusterBlockId index,
                                 int* num_primitives,
-                                const pugiutil::loc_data& loc_data,
+                                t_pb_route_entries& pb_route,
                                 ClusteredNetlist* clb_nlist) {
     bool found;
-    int i, num_tokens = 0;
-    t_token* tokens;
+    int i;
     const t_pb_type* pb_type = nullptr;
 
     auto& device_ctx = g_vpr_ctx.device();
     auto& atom_ctx = g_vpr_ctx.mutable_atom();
 
     //Parse cb attributes
-    auto block_name = pugiutil::get_attribute(clb_block, "name", loc_data);
-    auto block_inst = pugiutil::get_attribute(clb_block, "instance", loc_data);
-    tokens = GetTokensFromString(block_inst.value(), &num_tokens);
-    if (num_tokens != 4 || tokens[0].type != TOKEN_STRING
-        || tokens[1].type != TOKEN_OPEN_SQUARE_BRACKET
-        || tokens[2].type != TOKEN_INT
-        || tokens[3].type != TOKEN_CLOSE_SQUARE_BRACKET) {
-        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(clb_block),
-                  "Unknown syntax for instance %s in %s. Expected pb_type[instance_number].\n",
-                  block_inst.value(), clb_block.name());
-    }
-    VTR_ASSERT(ClusterBlockId(vtr::atoi(tokens[2].data)) == index);
+    std::string type_name;
+    int instance_index;
+    parse_pb_instance(clb_block.instance, clb_block.line, type_name, instance_index);
+    VTR_ASSERT(ClusterBlockId(instance_index) == index);
 
     found = false;
     for (const auto& type : device_ctx.logical_block_types) {
-        if (strcmp(type.name, tokens[0].data) == 0) {
+        if (type_name == type.name) {
             t_pb* pb = new t_pb;
-            pb->name = vtr::strdup(block_name.value());
-            clb_nlist->create_block(block_name.value(), pb, &type);
+            pb->name = vtr::strdup(clb_block.name.c_str());
+            clb_nlist->create_block(clb_block.name.c_str(), pb, &type);
             pb_type = clb_nlist->block_type(index)->pb_type;
             found = true;
             break;
         }
     }
     if (!found) {
-        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(clb_block),
-                  "Unknown cb type %s for cb %s #%lu.\n", block_inst.value(), clb_nlist->block_name(index).c_str(), size_t(index));
+        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, clb_block.line,
+                  "Unknown cb type %s for cb %s #%lu.\n", clb_block.instance.c_str(), clb_nlist->block_name(index).c_str(), size_t(index));
     }
 
     //Parse all pbs and CB internal nets
     atom_ctx.lookup.set_atom_pb(AtomBlockId::INVALID(), clb_nlist->block_pb(index));
 
     clb_nlist->block_pb(index)->pb_graph_node = clb_nlist->block_type(index)->pb_graph_head;
-    clb_nlist->block_pb(index)->pb_route = alloc_pb_route(clb_nlist->block_pb(index)->pb_graph_node);
-
-    auto clb_mode = pugiutil::get_attribute(clb_block, "mode", loc_data);
 
     found = false;
     for (i = 0; i < pb_type->num_modes; i++) {
-        if (strcmp(clb_mode.value(), pb_type->modes[i].name) == 0) {
+        if (clb_block.mode == pb_type->modes[i].name) {
             clb_nlist->block_pb(index)->mode = i;
             found = true;
         }
     }
     if (!found) {
-        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(clb_block),
-                  "Unknown mode %s for cb %s #%d.\n", clb_mode.value(), clb_nlist->block_name(index).c_str(), index);
+        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, clb_block.line,
+                  "Unknown mode %s for cb %s #%d.\n", clb_block.mode.c_str(), clb_nlist->block_name(index).c_str(), index);
     }
 
-    processPb(clb_block, index, clb_nlist->block_pb(index), clb_nlist->block_pb(index)->pb_route, num_primitives, loc_data, clb_nlist);
-    load_internal_to_block_net_nums(clb_nlist->block_type(index), clb_nlist->block_pb(index)->pb_route);
-
-    //clb_nlist->block_pb(index)->pb_route.shrink_to_fit();
+    pb_route.clear();
+    processPb(clb_block, index, clb_nlist->block_pb(index), pb_route, num_primitives, clb_nlist);
 
-    freeTokens(tokens, num_tokens);
+    clb_nlist->block_pb(index)->pb_route = alloc_pb_route(pb_route, *clb_nlist, index);
+    load_internal_to_block_net_nums(clb_nlist->block_type(index), clb_nlist->block_pb(index)->pb_route);
 }
 
 /**
- * This processes a set of key-value pairs in the XML e.g. block attributes or parameters,
- * which must be of the form <attributes><attribute name="attrName">attrValue</attribute> ... </attributes>
+ * This checks a set of key-value pairs of the netlist file e.g. block attributes or parameters
+ * against the ones of the atom netlist
  */
 template<typename T>
-void processAttrsParams(pugi::xml_node Parent, const char* child_name, T& atom_net_range, const pugiutil::loc_data& loc_data) {
+void processAttrsParams(const std::vector<t_net_file_param>& net_params, int parent_line, const char* child_name, T& atom_net_range) {
     std::map<std::string, std::string> kvs;
-    if (Parent) {
-        for (auto Cur = pugiutil::get_first_child(Parent, child_name, loc_data, pugiutil::OPTIONAL); Cur; Cur = Cur.next_sibling(child_name)) {
-            std::string cname = pugiutil::get_attribute(Cur, "name", loc_data).value();
-            std::string cval = Cur.text().get();
-            bool found = false;
-            // Look for corresponding key-value in range from AtomNetlist
-            for (auto bitem : atom_net_range) {
-                if (bitem.first == cname) {
-                    if (bitem.second != cval) {
-                        // Found in AtomNetlist range, but values don't match
-                        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(Cur),
-                                  ".net file and .blif file do not match, %s %s set to \"%s\" in .net file but \"%s\" in .blif file.\n",
-                                  child_name, cname.c_str(), cval.c_str(), bitem.second.c_str());
-                    }
-                    found = true;
-                    break;
+    for (const t_net_file_param& param : net_params) {
+        const std::string& cname = param.name;
+        const std::string& cval = param.value;
+        bool found = false;
+        // Look for corresponding key-value in range from AtomNetlist
+        for (auto bitem : atom_net_range) {
+            if (bitem.first == cname) {
+                if (bitem.second != cval) {
+                    // Found in AtomNetlist range, but values don't match
+                    vpr_throw(VPR_ERROR_NET_F, netlist_file_name, param.line,
+                              ".net file and .blif file do not match, %s %s set to \"%s\" in .net file but \"%s\" in .blif file.\n",
+                              child_name, cname.c_str(), cval.c_str(), bitem.second.c_str());
                 }
+                found = true;
+                break;
             }
-            if (!found) // Not found in AtomNetlist range
-                vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(Cur),
-                          ".net file and .blif file do not match, %s %s missing in .blif file.\n",
-                          child_name, cname.c_str());
-            kvs[cname] = cval;
         }
+        if (!found) // Not found in AtomNetlist range
+            vpr_throw(VPR_ERROR_NET_F, netlist_file_name, param.line,
+                      ".net file and .blif file do not match, %s %s missing in .blif file.\n",
+                      child_name, cname.c_str());
+        kvs[cname] = cval;
     }
     // Check for attrs/params in AtomNetlist but not in .net file
     for (auto bitem : atom_net_range) {
         if (kvs.find(bitem.first) == kvs.end())
-            vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(Parent),
+            vpr_throw(VPR_ERROR_NET_F, netlist_file_name, parent_line,
                       ".net file and .blif file do not match, %s %s missing in .net file.\n",
                       child_name, bitem.first.c_str());
     }
 }
 
 /**
- * XML parser to populate pb info and to update internal nets of the parent CLB
- * Parent - XML tag for this pb_type
+ * Populates pb info from its parsed block and updates internal nets of the parent CLB
+ * Parent - parsed block of this pb_type
  * pb - physical block to use
- * loc_data - xml location info for error reporting
  */
-static void processPb(pugi::xml_node Parent, const ClusterBlockId index, t_pb* pb, t_pb_routes& pb_route, int* num_primitives, const pugiutil::loc_data& loc_data, ClusteredNetlist* clb_nlist) {
+static void processPb(const t_net_file_block& Parent, const ClusterBlockId index, t_pb* pb, t_pb_route_entries& pb_route, int* num_primitives, ClusteredNetlist* clb_nlist) {
     int i, j, pb_index;
     bool found;
     const t_pb_type* pb_type;
 
-    t_token* tokens;
-    int num_tokens;
-
     auto& atom_ctx = g_vpr_ctx.mutable_atom();
 
-    auto inputs = pugiutil::get_single_child(Parent, "inputs", loc_data);
-    int num_in_ports = processPorts(inputs, pb, pb_route, loc_data);
+    int num_in_ports = processPorts(Parent.inputs, NET_FILE_INPUTS, pb, pb_route);
 
-    auto outputs = pugiutil::get_single_child(Parent, "outputs", loc_data);
-    int num_out_ports = processPorts(outputs, pb, pb_route, loc_data);
+    int num_out_ports = processPorts(Parent.outputs, NET_FILE_OUTPUTS, pb, pb_route);
 
-    auto clocks = pugiutil::get_single_child(Parent, "clocks", loc_data);
-    int num_clock_ports = processPorts(clocks, pb, pb_route, loc_data);
-
-    auto attrs = pugiutil::get_single_child(Parent, "attributes", loc_data, pugiutil::OPTIONAL);
-    auto params = pugiutil::get_single_child(Parent, "parameters", loc_data, pugiutil::OPTIONAL);
+    int num_clock_ports = processPorts(Parent.clocks, NET_FILE_CLOCKS, pb, pb_route);
 
     pb_type = pb->pb_graph_node->pb_type;
 
@@ -436,8 +605,8 @@ static void processPb(pugi::xml_node Parent, const ClusterBlockId index, t_pb* p
 
         auto atom_attrs = atom_ctx.nlist.block_attrs(blk_id);
         auto atom_params = atom_ctx.nlist.block_params(blk_id);
-        processAttrsParams(attrs, "attribute", atom_attrs, loc_data);
-        processAttrsParams(params, "parameter", atom_params, loc_data);
+        processAttrsParams(Parent.attributes, Parent.attributes_line, "attribute", atom_attrs);
+        processAttrsParams(Parent.parameters, Parent.parameters_line, "parameter", atom_params);
 
         (*num_primitives)++;
     } else {
@@ -449,34 +618,22 @@ static void processPb(pugi::xml_node Parent, const ClusterBlockId index, t_pb* p
         }
 
         /* Populate info for each physical block */
-        for (auto child = Parent.child("block"); child; child = child.next_sibling("block")) {
-            VTR_ASSERT(strcmp(child.name(), "block") == 0);
-
-            auto instance_type = pugiutil::get_attribute(child, "instance", loc_data);
-            tokens = GetTokensFromString(instance_type.value(), &num_tokens);
-            if (num_tokens != 4 || tokens[0].type != TOKEN_STRING
-                || tokens[1].type != TOKEN_OPEN_SQUARE_BRACKET
-                || tokens[2].type != TOKEN_INT
-                || tokens[3].type != TOKEN_CLOSE_SQUARE_BRACKET) {
-                vpr_throw(VPR_ERROR_NET_F, loc_data.filename_c_str(), loc_data.line(child),
-                          "Unknown syntax for instance %s in %s. Expected pb_type[instance_number].\n",
-                          instance_type.value(), child.name());
-            }
+        std::string child_type_name;
+        for (const t_net_file_block& child : Parent.children) {
+            parse_pb_instance(child.instance, child.line, child_type_name, pb_index);
 
             found = false;
-            pb_index = OPEN;
             for (i = 0; i < pb_type->modes[pb->mode].num_pb_type_children; i++) {
-                if (strcmp(pb_type->modes[pb->mode].pb_type_children[i].name, tokens[0].data) == 0) {
-                    pb_index = vtr::atoi(tokens[2].data);
+                if (child_type_name == pb_type->modes[pb->mode].pb_type_children[i].name) {
                     if (pb_index >= pb_type->modes[pb->mode].pb_type_children[i].num_pb) {
-                        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(child),
+                        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, child.line,
                                   "Instance number exceeds # of pb available for instance %s in %s.\n",
-                                  instance_type.value(), child.name());
+                                  child.instance.c_str(), "block");
                     }
                     if (pb->child_pbs[i][pb_index].pb_graph_node != nullptr) {
-                        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(child),
+                        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, child.line,
                                   "node is used by two different blocks %s and %s.\n",
-                                  instance_type.value(),
+                                  child.instance.c_str(),
                                   pb->child_pbs[i][pb_index].name);
                     }
                     pb->child_pbs[i][pb_index].pb_graph_node = &pb->pb_graph_node->child_pb_graph_nodes[pb->mode][i][pb_index];
@@ -485,66 +642,64 @@ static void processPb(pugi::xml_node Parent, const ClusterBlockId index, t_pb* p
                 }
             }
             if (!found) {
-                vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(child),
-                          "Unknown pb type %s.\n", instance_type.value());
+                vpr_throw(VPR_ERROR_NET_F, netlist_file_name, child.line,
+                          "Unknown pb type %s.\n", child.instance.c_str());
             }
 
-            auto name = pugiutil::get_attribute(child, "name", loc_data);
-            if (0 != strcmp(name.value(), "open")) {
-                pb->child_pbs[i][pb_index].name = vtr::strdup(name.value());
+            t_pb* child_pb = &pb->child_pbs[i][pb_index];
+            if (child.name != "open") {
+                child_pb->name = vtr::strdup(child.name.c_str());
+            } else {
+                /* physical block has no used primitives but it may have used routing */
+                child_pb->name = nullptr;
+            }
 
-                /* Parse all pbs and CB internal nets*/
-                atom_ctx.lookup.set_atom_pb(AtomBlockId::INVALID(), &pb->child_pbs[i][pb_index]);
+            /* Parse all pbs and CB internal nets*/
+            atom_ctx.lookup.set_atom_pb(AtomBlockId::INVALID(), child_pb);
 
-                auto mode = child.attribute("mode");
-                pb->child_pbs[i][pb_index].mode = 0;
-                found = false;
-                for (j = 0; j < pb->child_pbs[i][pb_index].pb_graph_node->pb_type->num_modes; j++) {
-                    if (strcmp(mode.value(), pb->child_pbs[i][pb_index].pb_graph_node->pb_type->modes[j].name) == 0) {
-                        pb->child_pbs[i][pb_index].mode = j;
-                        found = true;
-                    }
-                }
-                if (!found && !pb->child_pbs[i][pb_index].is_primitive()) {
-                    vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(child),
-                              "Unknown mode %s for cb %s #%d.\n", mode.value(),
-                              pb->child_pbs[i][pb_index].name, pb_index);
-                }
-                pb->child_pbs[i][pb_index].parent_pb = pb;
+            if (!child.is_parsed) {
+                continue;
+            }
 
-                processPb(child, index, &pb->child_pbs[i][pb_index], pb_route, num_primitives, loc_data, clb_nlist);
-            } else {
-                /* physical block has no used primitives but it may have used routing */
-                pb->child_pbs[i][pb_index].name = nullptr;
-                atom_ctx.lookup.set_atom_pb(AtomBlockId::INVALID(), &pb->child_pbs[i][pb_index]);
-
-                auto lookahead1 = pugiutil::get_first_child(child, "outputs", loc_data, pugiutil::OPTIONAL);
-                if (lookahead1) {
-                    pugiutil::get_first_child(lookahead1, "port", loc_data); //Check that port child tag exists
-                    auto mode = pugiutil::get_attribute(child, "mode", loc_data);
-
-                    pb->child_pbs[i][pb_index].mode = 0;
-                    found = false;
-                    for (j = 0; j < pb->child_pbs[i][pb_index].pb_graph_node->pb_type->num_modes; j++) {
-                        if (strcmp(mode.value(), pb->child_pbs[i][pb_index].pb_graph_node->pb_type->modes[j].name) == 0) {
-                            pb->child_pbs[i][pb_index].mode = j;
-                            found = true;
-                        }
-                    }
-                    if (!found && !pb->child_pbs[i][pb_index].is_primitive()) {
-                        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(child),
-                                  "Unknown mode %s for cb %s #%d.\n", mode.value(),
-                                  pb->child_pbs[i][pb_index].name, pb_index);
-                    }
-                    pb->child_pbs[i][pb_index].parent_pb = pb;
-                    processPb(child, index, &pb->child_pbs[i][pb_index], pb_route, num_primitives, loc_data, clb_nlist);
+            child_pb->mode = 0;
+            found = false;
+            for (j = 0; j < child_pb->pb_graph_node->pb_type->num_modes; j++) {
+                if (child.mode == child_pb->pb_graph_node->pb_type->modes[j].name) {
+                    child_pb->mode = j;
+                    found = true;
                 }
             }
-            freeTokens(tokens, num_tokens);
+            if (!found && !child_pb->is_primitive()) {
+                vpr_throw(VPR_ERROR_NET_F, netlist_file_name, child.line,
+                          "Unknown mode %s for cb %s #%d.\n", child.mode.c_str(),
+                          child_pb->name, pb_index);
+            }
+            child_pb->parent_pb = pb;
+
+            processPb(child, index, child_pb, pb_route, num_primitives, clb_nlist);
         }
     }
 }
 
+/**
+ * Parses a pb instance of the form pb_type[instance_number]
+ */
+static void parse_pb_instance(const std::string& instance, int line, std::string& pb_type_name, int& pb_index) {
+    int num_tokens = 0;
+    t_token* tokens = GetTokensFromString(instance.c_str(), &num_tokens);
+    if (num_tokens != 4 || tokens[0].type != TOKEN_STRING
+        || tokens[1].type != TOKEN_OPEN_SQUARE_BRACKET
+        || tokens[2].type != TOKEN_INT
+        || tokens[3].type != TOKEN_CLOSE_SQUARE_BRACKET) {
+        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, line,
+                  "Unknown syntax for instance %s in %s. Expected pb_type[instance_number].\n",
+                  instance.c_str(), "block");
+    }
+    pb_type_name = tokens[0].data;
+    pb_index = vtr::atoi(tokens[2].data);
+    freeTokens(tokens, num_tokens);
+}
+
 /**
  * Adds net to hashtable of nets.  If the net is "open", then this is a keyword so do not add it.
  * If the net already exists, increase the count on that net
@@ -564,19 +719,75 @@ static int add_net_to_hash(t_hash** nhash, const char* net_name, int* ncount) {
     return hash_value->index;
 }
 
-static int processPorts(pugi::xml_node Parent, t_pb* pb, t_pb_routes& pb_route, const pugiutil::loc_data& loc_data) {
-    int i, j, num_tokens;
+/**
+ * Returns the pin driving a '<pin>-><interconnect>' token of the netlist file
+ * (e.g. 'memory.addr1[0]->address1') among the pins of a mode of a pb_graph_node,
+ * after checking that it drives the interconnect
+ */
+static const t_pb_graph_pin* find_interconnect_driver_pin(const t_pb_graph_node* pb_graph_node, int mode, int interconnect_line_num, const std::string& pin, int line) {
+    auto& mode_driver_pins = interconnect_driver_pins[std::make_pair(pb_graph_node, mode)];
+    auto result = mode_driver_pins.find(pin);
+    if (result != mode_driver_pins.end()) {
+        return result->second;
+    }
+
+    int j, num_sets;
+    int* num_ptrs;
+
+    //Extract the portion of the pin name after '->'
+    //
+    //e.g. 'memory.addr1[0]->address1' becomes 'address1'
+    size_t loc = pin.find("->");
+    VTR_ASSERT(loc != std::string::npos);
+
+    std::string pin_name = pin.substr(0, loc);
+
+    loc += 2; //Skip over the '->'
+    std::string interconnect_name = pin.substr(loc, std::string::npos);
+
+    t_pb_graph_pin*** pin_node = alloc_and_load_port_pin_ptrs_from_string(
+        interconnect_line_num,
+        pb_graph_node,
+        pb_graph_node->child_pb_graph_nodes[mode],
+        pin_name.c_str(), &num_ptrs, &num_sets, true,
+        true);
+    VTR_ASSERT(num_sets == 1 && num_ptrs[0] == 1);
+
+    const t_pb_graph_pin* driver_pin = pin_node[0][0];
+
+    bool found = false;
+    for (j = 0; j < driver_pin->num_output_edges; j++) {
+        if (0 == strcmp(interconnect_name.c_str(), driver_pin->output_edges[j]->interconnect->name)) {
+            found = true;
+            break;
+        }
+    }
+    for (j = 0; j < num_sets; j++) {
+        free(pin_node[j]);
+    }
+    free(pin_node);
+    free(num_ptrs);
+    if (!found) {
+        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, line,
+                  "Unknown interconnect %s connecting to pin %s.\n",
+                  interconnect_name.c_str(), pin_name.c_str());
+    }
+
+    mode_driver_pins.insert(std::make_pair(pin, driver_pin));
+    return driver_pin;
+}
+
+/**
+ * Processes the ports of a pb in one of its <inputs>, <outputs> or <clocks> tags
+ */
+static int processPorts(const t_net_file_port_group& group, e_net_file_port_kind port_kind, t_pb* pb, t_pb_route_entries& pb_route) {
+    int i, num_tokens;
     int in_port = 0, out_port = 0, clock_port = 0;
-    std::vector<std::string> pins;
-    t_pb_graph_pin*** pin_node;
-    int *num_ptrs, num_sets;
     bool found;
 
     auto& atom_ctx = g_vpr_ctx.atom();
 
-    for (auto Cur = pugiutil::get_first_child(Parent, "port", loc_data, pugiutil::OPTIONAL); Cur; Cur = Cur.next_sibling("port")) {
-        auto port_name = pugiutil::get_attribute(Cur, "name", loc_data);
-
+    for (const t_net_file_port& port : group.ports) {
         //Determine the port index on the pb
         //
         //Traverse all the ports on the pb until we find the matching port name,
@@ -585,7 +796,7 @@ static int processPorts(pugi::xml_node Parent, t_pb* pb, t_pb_routes& pb_route,
         in_port = out_port = clock_port = 0;
         found = false;
         for (i = 0; i < pb->pb_graph_node->pb_type->num_ports; i++) {
-            if (0 == strcmp(pb->pb_graph_node->pb_type->ports[i].name, port_name.value())) {
+            if (port.name == pb->pb_graph_node->pb_type->ports[i].name) {
                 found = true;
                 break;
             }
@@ -601,49 +812,49 @@ static int processPorts(pugi::xml_node Parent, t_pb* pb, t_pb_routes& pb_route,
             }
         }
         if (!found) {
-            vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(Cur),
-                      "Unknown port %s for pb %s[%d].\n", port_name.value(),
+            vpr_throw(VPR_ERROR_NET_F, netlist_file_name, port.line,
+                      "Unknown port %s for pb %s[%d].\n", port.name.c_str(),
                       pb->pb_graph_node->pb_type->name,
                       pb->pb_graph_node->placement_index);
         }
 
         //Extract all the pins for this port
-        pins = vtr::split(Cur.text().get());
+        const std::vector<std::string>& pins = port.pins;
         num_tokens = pins.size();
 
         //Check that the number of pins from the netlist file matches the pb port's number of pins
-        if (0 == strcmp(Parent.name(), "inputs")) {
+        if (port_kind == NET_FILE_INPUTS) {
             if (num_tokens != pb->pb_graph_node->num_input_pins[in_port]) {
-                vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(Cur),
+                vpr_throw(VPR_ERROR_NET_F, netlist_file_name, port.line,
                           "Incorrect # pins %d found (expected %d) for input port %s for pb %s[%d].\n",
-                          num_tokens, pb->pb_graph_node->num_input_pins[in_port], port_name.value(), pb->pb_graph_node->pb_type->name,
+                          num_tokens, pb->pb_graph_node->num_input_pins[in_port], port.name.c_str(), pb->pb_graph_node->pb_type->name,
                           pb->pb_graph_node->placement_index);
             }
-        } else if (0 == strcmp(Parent.name(), "outputs")) {
+        } else if (port_kind == NET_FILE_OUTPUTS) {
             if (num_tokens != pb->pb_graph_node->num_output_pins[out_port]) {
-                vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(Cur),
+                vpr_throw(VPR_ERROR_NET_F, netlist_file_name, port.line,
                           "Incorrect # pins %d found (expected %d) for output port %s for pb %s[%d].\n",
-                          num_tokens, pb->pb_graph_node->num_output_pins[out_port], port_name.value(), pb->pb_graph_node->pb_type->name,
+                          num_tokens, pb->pb_graph_node->num_output_pins[out_port], port.name.c_str(), pb->pb_graph_node->pb_type->name,
                           pb->pb_graph_node->placement_index);
             }
         } else {
-            VTR_ASSERT(0 == strcmp(Parent.name(), "clocks"));
+            VTR_ASSERT(port_kind == NET_FILE_CLOCKS);
             if (num_tokens != pb->pb_graph_node->num_clock_pins[clock_port]) {
-                vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(Cur),
+                vpr_throw(VPR_ERROR_NET_F, netlist_file_name, port.line,
                           "Incorrect # pins %d found for clock port %s for pb %s[%d].\n",
-                          num_tokens, pb->pb_graph_node->num_clock_pins[clock_port], port_name.value(), pb->pb_graph_node->pb_type->name,
+                          num_tokens, pb->pb_graph_node->num_clock_pins[clock_port], port.name.c_str(), pb->pb_graph_node->pb_type->name,
                           pb->pb_graph_node->placement_index);
             }
         }
 
         //Process the input and clock ports
-        if (0 == strcmp(Parent.name(), "inputs") || 0 == strcmp(Parent.name(), "clocks")) {
+        if (port_kind == NET_FILE_INPUTS || port_kind == NET_FILE_CLOCKS) {
             if (pb->is_root()) {
                 //We are processing a top-level pb, so these pins connect to inter-block nets
                 for (i = 0; i < num_tokens; i++) {
                     //Set rr_node_index to the pb_route for the appropriate port
                     const t_pb_graph_pin* pb_gpin = nullptr;
-                    if (0 == strcmp(Parent.name(), "inputs")) {
+                    if (port_kind == NET_FILE_INPUTS) {
                         pb_gpin = &pb->pb_graph_node->input_pins[in_port][i];
                     } else {
                         pb_gpin = &pb->pb_graph_node->clock_pins[clock_port][i];
@@ -652,49 +863,36 @@ static int processPorts(pugi::xml_node Parent, t_pb* pb, t_pb_routes& pb_route,
                     VTR_ASSERT(pb_gpin != nullptr);
                     int rr_node_index = pb_gpin->pin_count_in_cluster;
 
-                    if (strcmp(pins[i].c_str(), "open") != 0) {
+                    if (pins[i] != "open") {
                         //For connected pins look-up the inter-block net index associated with it
-                        AtomNetId net_id = atom_ctx.nlist.find_net(pins[i].c_str());
+                        AtomNetId net_id = atom_ctx.nlist.find_net(pins[i]);
                         if (!net_id) {
                             VPR_FATAL_ERROR(VPR_ERROR_NET_F,
                                             ".blif and .net do not match, unknown net %s found in .net file.\n.",
                                             pins[i].c_str());
                         }
                         //Mark the associated inter-block net
-                        pb_route.insert(std::make_pair(rr_node_index, t_pb_route()));
-                        pb_route[rr_node_index].atom_net_id = net_id;
-                        pb_route[rr_node_index].pb_graph_pin = pb_gpin;
+                        pb_route.emplace_back(rr_node_index, t_pb_route());
+                        pb_route.back().second.atom_net_id = net_id;
+                        pb_route.back().second.pb_graph_pin = pb_gpin;
                     }
                 }
             } else {
                 //We are processing an internal pb
                 for (i = 0; i < num_tokens; i++) {
-                    if (0 == strcmp(pins[i].c_str(), "open")) {
+                    if (pins[i] == "open") {
                         continue;
                     }
 
-                    //Extract the portion of the pin name after '->'
-                    //
-                    //e.g. 'memory.addr1[0]->address1' becomes 'address1'
-                    size_t loc = pins[i].find("->");
-                    VTR_ASSERT(loc != std::string::npos);
-
-                    std::string pin_name = pins[i].substr(0, loc);
-
-                    loc += 2; //Skip over the '->'
-                    std::string interconnect_name = pins[i].substr(loc, std::string::npos);
                     // Interconnect name is the net name
-
-                    pin_node = alloc_and_load_port_pin_ptrs_from_string(
-                        pb->pb_graph_node->pb_type->parent_mode->interconnect[0].line_num,
+                    const t_pb_graph_pin* driver_pin = find_interconnect_driver_pin(
                         pb->pb_graph_node->parent_pb_graph_node,
-                        pb->pb_graph_node->parent_pb_graph_node->child_pb_graph_nodes[pb->parent_pb->mode],
-                        pin_name.c_str(), &num_ptrs, &num_sets, true,
-                        true);
-                    VTR_ASSERT(num_sets == 1 && num_ptrs[0] == 1);
+                        pb->parent_pb->mode,
+                        pb->pb_graph_node->pb_type->parent_mode->interconnect[0].line_num,
+                        pins[i], port.line);
 
                     const t_pb_graph_pin* pb_gpin = nullptr;
-                    if (0 == strcmp(Parent.name(), "inputs")) {
+                    if (port_kind == NET_FILE_INPUTS) {
                         pb_gpin = &pb->pb_graph_node->input_pins[in_port][i];
                     } else {
                         pb_gpin = &pb->pb_graph_node->clock_pins[clock_port][i];
@@ -702,132 +900,82 @@ static int processPorts(pugi::xml_node Parent, t_pb* pb, t_pb_routes& pb_route,
                     VTR_ASSERT(pb_gpin != nullptr);
                     int rr_node_index = pb_gpin->pin_count_in_cluster;
 
-                    pb_route.insert(std::make_pair(rr_node_index, t_pb_route()));
-                    pb_route[rr_node_index].driver_pb_pin_id = pin_node[0][0]->pin_count_in_cluster;
-                    pb_route[rr_node_index].pb_graph_pin = pb_gpin;
-
-                    found = false;
-                    for (j = 0; j < pin_node[0][0]->num_output_edges; j++) {
-                        if (0 == strcmp(interconnect_name.c_str(), pin_node[0][0]->output_edges[j]->interconnect->name)) {
-                            found = true;
-                            break;
-                        }
-                    }
-                    for (j = 0; j < num_sets; j++) {
-                        free(pin_node[j]);
-                    }
-                    free(pin_node);
-                    free(num_ptrs);
-                    if (!found) {
-                        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(Cur),
-                                  "Unknown interconnect %s connecting to pin %s.\n",
-                                  interconnect_name.c_str(), pin_name.c_str());
-                    }
+                    pb_route.emplace_back(rr_node_index, t_pb_route());
+                    pb_route.back().second.driver_pb_pin_id = driver_pin->pin_count_in_cluster;
+                    pb_route.back().second.pb_graph_pin = pb_gpin;
                 }
             }
         }
 
-        if (0 == strcmp(Parent.name(), "outputs")) {
+        if (port_kind == NET_FILE_OUTPUTS) {
             if (pb->pb_graph_node->is_primitive()) {
                 /* primitives are drivers of nets */
                 for (i = 0; i < num_tokens; i++) {
                     const t_pb_graph_pin* pb_gpin = &pb->pb_graph_node->output_pins[out_port][i];
                     int rr_node_index = pb_gpin->pin_count_in_cluster;
-                    if (strcmp(pins[i].c_str(), "open") != 0) {
-                        AtomNetId net_id = atom_ctx.nlist.find_net(pins[i].c_str());
+                    if (pins[i] != "open") {
+                        AtomNetId net_id = atom_ctx.nlist.find_net(pins[i]);
                         if (!net_id) {
                             VPR_FATAL_ERROR(VPR_ERROR_NET_F,
                                             ".blif and .net do not match, unknown net %s found in .net file.\n",
                                             pins[i].c_str());
                         }
-                        pb_route.insert(std::make_pair(rr_node_index, t_pb_route()));
-                        pb_route[rr_node_index].atom_net_id = net_id;
-                        pb_route[rr_node_index].pb_graph_pin = pb_gpin;
+                        pb_route.emplace_back(rr_node_index, t_pb_route());
+                        pb_route.back().second.atom_net_id = net_id;
+                        pb_route.back().second.pb_graph_pin = pb_gpin;
                     }
                 }
             } else {
                 for (i = 0; i < num_tokens; i++) {
-                    if (0 == strcmp(pins[i].c_str(), "open")) {
+                    if (pins[i] == "open") {
                         continue;
                     }
-                    //Extract the portion of the pin name after '->'
-                    //
-                    //e.g. 'memory.addr1[0]->address1' becomes 'address1'
-                    size_t loc = pins[i].find("->");
-                    VTR_ASSERT(loc != std::string::npos);
-
-                    std::string pin_name = pins[i].substr(0, loc);
 
-                    loc += 2; //Skip over the '->'
-                    std::string interconnect_name = pins[i].substr(loc, std::string::npos);
-
-                    pin_node = alloc_and_load_port_pin_ptrs_from_string(
-                        pb->pb_graph_node->pb_type->modes[pb->mode].interconnect->line_num,
+                    const t_pb_graph_pin* driver_pin = find_interconnect_driver_pin(
                         pb->pb_graph_node,
-                        pb->pb_graph_node->child_pb_graph_nodes[pb->mode],
-                        pin_name.c_str(), &num_ptrs, &num_sets, true,
-                        true);
-                    VTR_ASSERT(num_sets == 1 && num_ptrs[0] == 1);
+                        pb->mode,
+                        pb->pb_graph_node->pb_type->modes[pb->mode].interconnect->line_num,
+                        pins[i], port.line);
                     int rr_node_index = pb->pb_graph_node->output_pins[out_port][i].pin_count_in_cluster;
 
                     //Why does this not use the output pin used to deterimine the rr node index?
-                    pb_route.insert(std::make_pair(rr_node_index, t_pb_route()));
-                    pb_route[rr_node_index].driver_pb_pin_id = pin_node[0][0]->pin_count_in_cluster;
-                    pb_route[rr_node_index].pb_graph_pin = pin_node[0][0];
-
-                    found = false;
-                    for (j = 0; j < pin_node[0][0]->num_output_edges; j++) {
-                        if (0 == strcmp(interconnect_name.c_str(), pin_node[0][0]->output_edges[j]->interconnect->name)) {
-                            found = true;
-                            break;
-                        }
-                    }
-                    for (j = 0; j < num_sets; j++) {
-                        free(pin_node[j]);
-                    }
-                    free(pin_node);
-                    free(num_ptrs);
-                    if (!found) {
-                        vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(Cur),
-                                  "Unknown interconnect %s connecting to pin %s.\n",
-                                  interconnect_name.c_str(), pin_name.c_str());
-                    }
+                    pb_route.emplace_back(rr_node_index, t_pb_route());
+                    pb_route.back().second.driver_pb_pin_id = driver_pin->pin_count_in_cluster;
+                    pb_route.back().second.pb_graph_pin = driver_pin;
                 }
             }
         }
     }
 
     //Record any port rotation mappings
-    for (auto pin_rot_map = pugiutil::get_first_child(Parent, "port_rotation_map", loc_data, pugiutil::OPTIONAL);
-         pin_rot_map;
-         pin_rot_map = pin_rot_map.next_sibling("port_rotation_map")) {
-        auto port_name = pugiutil::get_attribute(pin_rot_map, "name", loc_data).value();
+    for (const t_net_file_port& pin_rot_map : group.rotation_maps) {
+        const char* port_name = pin_rot_map.name.c_str();
 
         const t_port* pb_gport = find_pb_graph_port(pb->pb_graph_node, port_name);
 
         if (pb_gport == nullptr) {
-            vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(pin_rot_map),
+            vpr_throw(VPR_ERROR_NET_F, netlist_file_name, pin_rot_map.line,
                       "Failed to find port with name '%s' on pb %s[%d]\n",
                       port_name,
                       pb->pb_graph_node->pb_type->name, pb->pb_graph_node->placement_index);
         }
 
-        auto pin_mapping = vtr::split(pin_rot_map.text().get());
+        const std::vector<std::string>& pin_mapping = pin_rot_map.pins;
 
         if (size_t(pb_gport->num_pins) != pin_mapping.size()) {
-            vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(pin_rot_map),
+            vpr_throw(VPR_ERROR_NET_F, netlist_file_name, pin_rot_map.line,
                       "Incorrect # pins %zu (expected %d) found for port %s rotation map in pb %s[%d].\n",
                       pin_mapping.size(), pb_gport->num_pins, port_name, pb->pb_graph_node->pb_type->name,
                       pb->pb_graph_node->placement_index);
         }
 
-        for (int ipin = 0; ipin < (int)pins.size(); ++ipin) {
+        for (int ipin = 0; ipin < (int)pin_mapping.size(); ++ipin) {
             if (pin_mapping[ipin] == "open") continue; //No mapping for this physical pin to atom pin
 
             int atom_pin_index = vtr::atoi(pin_mapping[ipin]);
 
             if (atom_pin_index < 0) {
-                vpr_throw(VPR_ERROR_NET_F, netlist_file_name, loc_data.line(pin_rot_map),
+                vpr_throw(VPR_ERROR_NET_F, netlist_file_name, pin_rot_map.line,
                           "Invalid pin number %d in port rotation map (must be >= 0)\n", atom_pin_index);
             }
 
@@ -1080,16 +1228,23 @@ static size_t mark_constant_generators_rec(const t_pb* pb, const t_pb_routes& pb
     return const_gen_count;
 }
 
-static t_pb_routes alloc_pb_route(t_pb_graph_node* /*pb_graph_node*/) {
-    t_pb_routes pb_routes;
-    //t_pb_route *pb_route;
-    //int num_pins = pb_graph_node->total_pb_pins;
-
-    //VTR_ASSERT(pb_graph_node->parent_pb_graph_node == nullptr); [> This function only operates on top-level pb_graph_node <]
-
-    //pb_route = new t_pb_route[num_pins];
+//Builds the intra-block routing of a CLB from its routed pins, which are sorted at once
+//rather than inserted one by one in the sorted storage of the routing
+static t_pb_routes alloc_pb_route(t_pb_route_entries& pb_route_entries, const ClusteredNetlist& clb_nlist, const ClusterBlockId index) {
+    std::stable_sort(pb_route_entries.begin(), pb_route_entries.end(),
+                     [](const std::pair<int, t_pb_route>& lhs, const std::pair<int, t_pb_route>& rhs) {
+                         return lhs.first < rhs.first;
+                     });
+    for (size_t ientry = 1; ientry < pb_route_entries.size(); ++ientry) {
+        if (pb_route_entries[ientry].first == pb_route_entries[ientry - 1].first) {
+            VPR_FATAL_ERROR(VPR_ERROR_NET_F,
+                            "Pin %d of cb %s #%lu is connected more than once in .net file.\n",
+                            pb_route_entries[ientry].first, clb_nlist.block_name(index).c_str(), size_t(index));
+        }
+    }
 
-    return pb_routes;
+    //Copy the entries to keep the storage exactly sized, the entries being reused for the next CLB
+    return t_pb_routes(t_pb_route_entries(pb_route_entries.begin(), pb_route_entries.end()));
 }
 
 static void load_internal_to_block_net_nums(const t_logical_block_type_ptr type, t_pb_routes& pb_route) {
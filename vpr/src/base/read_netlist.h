@@ -13,6 +13,7 @@
 ClusteredNetlist read_netlist(const char* net_file,
                               const t_arch* arch,
                               bool verify_file_digests,
+                              bool use_net_file_cache,
                               int verbosity);
 
 #endif
@@ -308,6 +308,41 @@ struct ParsePlaceAlgorithm {
     }
 };
 
+struct ParseSeedsMetric {
+    ConvertedValue<e_seeds_metric> from_str(std::string str) {
+        ConvertedValue<e_seeds_metric> conv_value;
+        if (str == "critical_path")
+            conv_value.set_value(e_seeds_metric::CRITICAL_PATH);
+        else if (str == "wirelength")
+            conv_value.set_value(e_seeds_metric::WIRELENGTH);
+        else if (str == "channel_width")
+            conv_value.set_value(e_seeds_metric::CHANNEL_WIDTH);
+        else {
+            std::stringstream msg;
+            msg << "Invalid conversion from '" << str << "' to e_seeds_metric (expected one of: " << argparse::join(default_choices(), ", ") << ")";
+            conv_value.set_error(msg.str());
+        }
+        return conv_value;
+    }
+
+    ConvertedValue<std::string> to_str(e_seeds_metric val) {
+        ConvertedValue<std::string> conv_value;
+        if (val == e_seeds_metric::CRITICAL_PATH)
+            conv_value.set_value("critical_path");
+        else if (val == e_seeds_metric::WIRELENGTH)
+            conv_value.set_value("wirelength");
+        else {
+            VTR_ASSERT(val == e_seeds_metric::CHANNEL_WIDTH);
+            conv_value.set_value("channel_width");
+        }
+        return conv_value;
+    }
+
+    std::vector<std::string> default_choices() {
+        return {"critical_path", "wirelength", "channel_width"};
+    }
+};
+
 struct ParseClusterSeed {
     ConvertedValue<e_cluster_seed> from_str(std::string str) {
         ConvertedValue<e_cluster_seed> conv_value;
@@ -645,6 +680,44 @@ struct ParseRouteBBUpdate {
     }
 };
 
+struct ParseCheckRoute {
+    ConvertedValue<e_check_route_option> from_str(std::string str) {
+        ConvertedValue<e_check_route_option> conv_value;
+        if (str == "off")
+            conv_value.set_value(e_check_route_option::OFF);
+        else if (str == "quick")
+            conv_value.set_value(e_check_route_option::QUICK);
+        else if (str == "full")
+            conv_value.set_value(e_check_route_option::FULL);
+        else {
+            std::stringstream msg;
+            msg << "Invalid conversion from '"
+                << str
+                << "' to e_check_route_option (expected one of: "
+                << argparse::join(default_choices(), ", ") << ")";
+            conv_value.set_error(msg.str());
+        }
+        return conv_value;
+    }
+
+    ConvertedValue<std::string> to_str(e_check_route_option val) {
+        ConvertedValue<std::string> conv_value;
+        if (val == e_check_route_option::OFF)
+            conv_value.set_value("off");
+        else if (val == e_check_route_option::QUICK)
+            conv_value.set_value("quick");
+        else {
+            VTR_ASSERT(val == e_check_route_option::FULL);
+            conv_value.set_value("full");
+        }
+        return conv_value;
+    }
+
+    std::vector<std::string> default_choices() {
+        return {"off", "quick", "full"};
+    }
+};
+
 struct ParseRouterLookahead {
     ConvertedValue<e_router_lookahead> from_str(std::string str) {
         ConvertedValue<e_router_lookahead> conv_value;
@@ -713,6 +786,76 @@ struct ParsePlaceDelayModel {
     }
 };
 
+struct ParsePlaceInitType {
+    ConvertedValue<e_place_init_type> from_str(std::string str) {
+        ConvertedValue<e_place_init_type> conv_value;
+        if (str == "random")
+            conv_value.set_value(e_place_init_type::RANDOM);
+        else if (str == "analytic")
+            conv_value.set_value(e_place_init_type::ANALYTIC);
+        else {
+            std::stringstream msg;
+            msg << "Invalid conversion from '" << str << "' to e_place_init_type (expected one of: " << argparse::join(default_choices(), ", ") << ")";
+            conv_value.set_error(msg.str());
+        }
+        return conv_value;
+    }
+
+    ConvertedValue<std::string> to_str(e_place_init_type val) {
+        ConvertedValue<std::string> conv_value;
+        if (val == e_place_init_type::RANDOM)
+            conv_value.set_value("random");
+        else {
+            VTR_ASSERT(val == e_place_init_type::ANALYTIC);
+            conv_value.set_value("analytic");
+        }
+        return conv_value;
+    }
+
+    std::vector<std::string> default_choices() {
+        return {"random", "analytic"};
+    }
+};
+
+struct ParsePlaceMoveGenerator {
+    ConvertedValue<e_place_move_generator> from_str(std::string str) {
+        ConvertedValue<e_place_move_generator> conv_value;
+        if (str == "uniform")
+            conv_value.set_value(e_place_move_generator::UNIFORM);
+        else if (str == "median")
+            conv_value.set_value(e_place_move_generator::MEDIAN);
+        else if (str == "critical")
+            conv_value.set_value(e_place_move_generator::CRITICAL);
+        else if (str == "adaptive")
+            conv_value.set_value(e_place_move_generator::ADAPTIVE);
+        else {
+            std::stringstream msg;
+            msg << "Invalid conversion from '" << str << "' to e_place_move_generator (expected one of: " << argparse::join(default_choices(), ", ") << ")";
+            conv_value.set_error(msg.str());
+        }
+        return conv_value;
+    }
+
+    ConvertedValue<std::string> to_str(e_place_move_generator val) {
+        ConvertedValue<std::string> conv_value;
+        if (val == e_place_move_generator::UNIFORM)
+            conv_value.set_value("uniform");
+        else if (val == e_place_move_generator::MEDIAN)
+            conv_value.set_value("median");
+        else if (val == e_place_move_generator::CRITICAL)
+            conv_value.set_value("critical");
+        else {
+            VTR_ASSERT(val == e_place_move_generator::ADAPTIVE);
+            conv_value.set_value("adaptive");
+        }
+        return conv_value;
+    }
+
+    std::vector<std::string> default_choices() {
+        return {"uniform", "median", "critical", "adaptive"};
+    }
+};
+
 struct ParseReducer {
     ConvertedValue<e_reducer> from_str(std::string str) {
         ConvertedValue<e_reducer> conv_value;
@@ -932,11 +1075,28 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .action(argparse::Action::STORE_TRUE)
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    gen_grp.add_argument<bool, ParseOnOff>(args.clock_route_templates, "--clock_route_templates")
+        .help(
+            "With two stage clock routing, connects the sinks of the clock nets along the paths through"
+            " the dedicated clock network computed when building the routing resource graph, rather than"
+            " searching them for each sink. Sinks whose path is already used are routed normally")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     gen_grp.add_argument<bool, ParseOnOff>(args.exit_before_pack, "--exit_before_pack")
         .help("Causes VPR to exit before packing starts (useful for statistics collection)")
         .default_value("off")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    gen_grp.add_argument<bool, ParseOnOff>(args.reuse_device, "--reuse_device")
+        .help(
+            "Reuses the architecture, routing resource graph, router lookahead and placement delay model"
+            " built by a previous invocation in the same process (e.g. the 'vpr' command of a shell),"
+            " when the architecture file, device grid and channel width are unchanged."
+            " Only the design-dependent stages are then run again.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     gen_grp.add_argument<bool, ParseOnOff>(args.strict_checks, "--strict_checks")
         .help(
             "Controls whether VPR enforces some consistency checks strictly (as errors) or treats them as warnings."
@@ -948,6 +1108,14 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("on")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    gen_grp.add_argument(args.trace_file, "--trace_file")
+        .help(
+            "Records the nested phases of the run (e.g. each routing iteration) and writes them to the specified file"
+            " at exit, in the Chrome trace-event JSON format (viewable with chrome://tracing or Perfetto)."
+            " Disabled if empty.")
+        .default_value("")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     gen_grp.add_argument<std::string>(args.disable_errors, "--disable_errors")
         .help(
             "Parses a list of functions for which the errors are going to be treated as warnings.\n"
@@ -999,12 +1167,23 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .help("Path to packed netlist file")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    file_grp.add_argument<bool, ParseOnOff>(args.net_file_cache, "--net_file_cache")
+        .help(
+            "Caches the parsed packed netlist file in a binary file next to it (<net_file>.cache)."
+            " The packed netlist is loaded from the cache, without parsing its XML,"
+            " as long as the netlist file has not changed since the cache was written")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     file_grp.add_argument(args.PlaceFile, "--place_file")
         .help("Path to placement file")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     file_grp.add_argument(args.RouteFile, "--route_file")
-        .help("Path to routing file")
+        .help(
+            "Path to routing file."
+            " Files ending with '.bin' are written and read in a binary format,"
+            " which loads much faster but is only valid for the same netlist and RR graph")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     file_grp.add_argument(args.SDCFile, "--sdc_file")
@@ -1014,18 +1193,31 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
     file_grp.add_argument(args.read_rr_graph_file, "--read_rr_graph")
         .help(
             "The routing resource graph file to load."
-            " The loaded routing resource graph overrides any routing architecture specified in the architecture file.")
+            " The loaded routing resource graph overrides any routing architecture specified in the architecture file."
+            " Files with a .bin extension are loaded in the binary format (requires VTR_ENABLE_CAPNPROTO)")
         .metavar("RR_GRAPH_FILE")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     file_grp.add_argument(args.write_rr_graph_file, "--write_rr_graph")
-        .help("Writes the routing resource graph to the specified file")
+        .help(
+            "Writes the routing resource graph to the specified file."
+            " Files with a .bin extension are written in the binary format (requires VTR_ENABLE_CAPNPROTO)")
         .metavar("RR_GRAPH_FILE")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    file_grp.add_argument(args.rr_graph_cache_dir, "--rr_graph_cache_dir")
+        .help(
+            "Directory to cache the tileable routing resource graphs."
+            " A tileable routing resource graph is loaded from the cache when it has been built"
+            " for the same architecture, device grid and channel width, and is added to the cache otherwise"
+            " (requires VTR_ENABLE_CAPNPROTO)")
+        .metavar("RR_GRAPH_CACHE_DIR")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     file_grp.add_argument(args.read_router_lookahead, "--read_router_lookahead")
         .help(
-            "Reads the lookahead data from the specified file instead of computing it.")
+            "Reads the lookahead data from the specified file instead of computing it."
+            " A map lookahead can only be read for the architecture and channel width it was written for.")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     file_grp.add_argument(args.write_router_lookahead, "--write_router_lookahead")
@@ -1038,7 +1230,10 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     file_grp.add_argument(args.write_placement_delay_lookup, "--write_placement_delay_lookup")
-        .help("Writes the placement delay lookup to the specified file.")
+        .help(
+            "Writes the placement delay lookup to the specified file."
+            " If the file already holds a lookup computed for the same routing resource graph"
+            " and delay model options, it is reused instead of being computed again.")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     file_grp.add_argument(args.out_file_prefix, "--outfile_prefix")
@@ -1248,6 +1443,27 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("1")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_grp.add_argument(args.num_seeds, "--seeds")
+        .help(
+            "Number of placement seeds to try in this process, starting at --seed."
+            " The device, the placement delay model and the router lookahead are built once,"
+            " and the seeds are placed and routed one after the other."
+            " The results of each seed are written to the placement and routing files"
+            " with a '.seed<N>' suffix, and the best result (see --seeds_metric) is kept"
+            " and written to the placement and routing files."
+            " Requires both the placement and the routing to be run")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument<e_seeds_metric, ParseSeedsMetric>(args.seeds_metric, "--seeds_metric")
+        .help(
+            "Metric selecting the best result of the seeds of --seeds:\n"
+            " * critical_path: smallest critical path delay (the wirelength without timing analysis)\n"
+            " * wirelength: smallest routed wirelength\n"
+            " * channel_width: smallest channel width, then smallest routed wirelength\n")
+        .default_value("critical_path")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     place_grp.add_argument<bool, ParseOnOff>(args.ShowPlaceTiming, "--enable_timing_computations")
         .help("Displays delay statistics even if placement is not timing driven")
         .show_in(argparse::ShowIn::HELP_ONLY);
@@ -1310,6 +1526,48 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_grp.add_argument(args.place_anneal_stats_file, "--place_anneal_stats")
+        .help(
+            "CSV file to write the number of accepted, rejected and aborted moves"
+            " of each move type, and the timing update time, per temperature")
+        .default_value("")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument<e_place_init_type, ParsePlaceInitType>(args.place_init_type, "--place_init")
+        .help(
+            "Controls how the initial placement is created:\n"
+            " * random: Blocks are placed at random legal locations\n"
+            " * analytic: The random placement is improved by a quadratic wirelength placement"
+            " (with the IOs, fixed blocks and macros as anchors) legalized at the closest free locations."
+            " The anneal then starts at a much lower temperature, evaluated without disturbing the initial placement\n")
+        .default_value("random")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument<e_place_move_generator, ParsePlaceMoveGenerator>(args.place_move_generator, "--place_move_generator")
+        .help(
+            "Controls how the placer proposes moves:\n"
+            " * uniform: A random block is swapped with a random location within the range limit\n"
+            " * median: A random block is moved to the median of the bounding boxes of its nets\n"
+            " * critical: A block of a critical connection is moved to the (criticality weighted)"
+            " centroid of its critical connections. Requires timing-driven placement\n"
+            " * adaptive: Each move picks one of the above (critical only if timing-driven),"
+            " favouring the move types with the most accepted moves per second of placement\n")
+        .default_value("uniform")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument<bool, ParseOnOff>(args.place_parallel_placement, "--parallel_placement")
+        .help(
+            "Controls whether the placer evaluates moves in parallel (using up to --num_workers threads)."
+            " The inner loop of the anneal is split into batches of moves. For each batch the device is split"
+            " into regions (whose boundaries change from batch to batch), and the blocks whose nets are"
+            " within a single region are swapped within that region, with all the regions in parallel."
+            " The other moves of the batch are made serially, and the timing costs are synchronized after each batch."
+            " Each region uses its own seed (drawn from --seed), so the placement does not depend on the number of threads."
+            " Moves made in parallel are not recorded by --place_move_stats."
+            " Requires VPR to be built with TBB")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     auto& place_timing_grp = parser.add_argument_group("timing-driven placement options");
 
     place_timing_grp.add_argument(args.PlaceTimingTradeoff, "--timing_tradeoff")
@@ -1504,6 +1762,16 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("16")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_grp.add_argument<e_check_route_option, ParseCheckRoute>(args.check_route, "--check_route")
+        .help(
+            "Controls how the final routing is checked.\n"
+            " * off: the routing is not checked\n"
+            " * quick: checks the connectivity of each net\n"
+            " * full: also checks the non-configurable sets and the stubs of each net\n")
+        .default_value("quick")
+        .choices({"off", "quick", "full"})
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     auto& route_timing_grp = parser.add_argument_group("timing-driven routing options");
 
     route_timing_grp.add_argument(args.astar_fac, "--astar_fac")
@@ -1569,6 +1837,30 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("off")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument(args.router_iteration_stats_file, "--router_iteration_stats")
+        .help(
+            "CSV file to write the router statistics of each routing iteration to"
+            " (nets routed, nodes expanded, lookahead evaluations, heap peak size, routing and timing analysis times)")
+        .default_value("")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument(args.router_net_stats_file, "--router_net_stats")
+        .help(
+            "CSV file to write the router statistics of each net routed in each routing iteration to"
+            " (reason of the reroute, nodes expanded, lookahead evaluations, heap peak size)")
+        .default_value("")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument(args.router_congestion_stats_prefix, "--router_congestion_stats")
+        .help(
+            "Prefix of the CSV files to write the routing congestion of each routing iteration to:"
+            " <prefix>.chan.csv (occupancy and capacity of each channel location),"
+            " <prefix>.seg.csv (of each segment type) and"
+            " <prefix>.sb.csv (of the wires driven by each switch block)."
+            " Unlike the graphics, this can be used on headless machines.")
+        .default_value("")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_timing_grp.add_argument<float>(args.congested_routing_iteration_threshold_frac, "--congested_routing_iteration_threshold")
         .help(
             "Controls when the router enters a high effort mode to resolve lingering routing congestion."
@@ -1591,6 +1883,47 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("64")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.router_parallel_routing, "--parallel_routing")
+        .help(
+            "Controls whether the timing-driven router routes nets in parallel (using up to --num_workers threads)."
+            " The device is recursively partitioned and the nets of disjoint partitions are routed at the same time,"
+            " each net being restricted to the smallest partition containing it."
+            " The routing does not depend on the number of threads."
+            " Requires VPR to be built with TBB, and is not supported with pass transistor switches")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.router_warm_start, "--router_warm_start")
+        .help(
+            "Controls whether each routing attempt of the minimum channel width search starts from the routing"
+            " of the previous attempt. The routing of each net is projected onto the new routing resource graph"
+            " by track index, and the nets which remain legal are kept, so that the first routing iteration"
+            " only reroutes the other nets")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.router_trunk_global_nets, "--router_trunk_global_nets")
+        .help(
+            "Controls how high fanout global (e.g. clock) nets are routed when they are not pre-routed to a"
+            " dedicated clock network (see --two_stage_clock_routing)."
+            " If on, their non-critical sinks are routed in order of increasing distance from the driver,"
+            " so that the route tree grows as a trunk from which the farther sinks branch, and each sink only"
+            " considers the nearby route tree (like other high fanout nets)."
+            " If off, each sink considers the whole route tree")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.router_adaptive_pres_fac, "--router_adaptive_pres_fac")
+        .help(
+            "Controls whether the congestion schedule adapts to the trend of the overuse predicted by the routing predictor."
+            " If on, the present overuse penalty grows faster (--pres_fac_mult squared) while the overuse stalls,"
+            " and slower (its square root) while the overuse falls quickly;"
+            " nets which keep being re-routed through congestion have their bounding box expanded to the device;"
+            " and the minimum channel width search aborts unroutable channel widths earlier"
+            " (as with --routing_failure_predictor aggressive).")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_timing_grp.add_argument<e_router_lookahead, ParseRouterLookahead>(args.router_lookahead_type, "--router_lookahead")
         .help(
             "Controls what lookahead the router uses to calculate cost of completing a connection.\n"
@@ -1675,6 +2008,13 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("off")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    analysis_grp.add_argument<bool, ParseOnOff>(args.timing_report_compress, "--timing_report_compress")
+        .help(
+            "Controls whether timing reports are gzip compressed (with a '.gz' extension)."
+            " Useful with large values of --timing_report_npaths\n")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     auto& power_grp = parser.add_argument_group("power analysis options");
 
     power_grp.add_argument<bool, ParseOnOff>(args.do_power, "--power")
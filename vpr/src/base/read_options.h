@@ -12,6 +12,7 @@ struct t_options {
     argparse::ArgValue<std::string> ArchFile;
     argparse::ArgValue<std::string> CircuitName;
     argparse::ArgValue<std::string> NetFile;
+    argparse::ArgValue<bool> net_file_cache;
     argparse::ArgValue<std::string> PlaceFile;
     argparse::ArgValue<std::string> RouteFile;
     argparse::ArgValue<std::string> BlifFile;
@@ -25,6 +26,7 @@ struct t_options {
     argparse::ArgValue<std::string> out_file_prefix;
     argparse::ArgValue<std::string> pad_loc_file;
     argparse::ArgValue<std::string> write_rr_graph_file;
+    argparse::ArgValue<std::string> rr_graph_cache_dir;
     argparse::ArgValue<std::string> read_rr_graph_file;
 
     argparse::ArgValue<std::string> write_placement_delay_lookup;
@@ -57,8 +59,11 @@ struct t_options {
     argparse::ArgValue<e_constant_net_method> constant_net_method;
     argparse::ArgValue<e_clock_modeling> clock_modeling;
     argparse::ArgValue<bool> two_stage_clock_routing;
+    argparse::ArgValue<bool> clock_route_templates;
     argparse::ArgValue<bool> exit_before_pack;
+    argparse::ArgValue<bool> reuse_device;
     argparse::ArgValue<bool> strict_checks;
+    argparse::ArgValue<std::string> trace_file;
     argparse::ArgValue<std::string> disable_errors;
     argparse::ArgValue<std::string> suppress_warnings;
     argparse::ArgValue<bool> allow_dangling_combinational_nodes;
@@ -90,6 +95,8 @@ struct t_options {
 
     /* Placement options */
     argparse::ArgValue<int> Seed;
+    argparse::ArgValue<int> num_seeds;
+    argparse::ArgValue<e_seeds_metric> seeds_metric;
     argparse::ArgValue<bool> ShowPlaceTiming;
     argparse::ArgValue<float> PlaceInnerNum;
     argparse::ArgValue<float> PlaceInitT;
@@ -101,6 +108,10 @@ struct t_options {
     argparse::ArgValue<int> PlaceChanWidth;
     argparse::ArgValue<float> place_rlim_escape_fraction;
     argparse::ArgValue<std::string> place_move_stats_file;
+    argparse::ArgValue<std::string> place_anneal_stats_file;
+    argparse::ArgValue<bool> place_parallel_placement;
+    argparse::ArgValue<e_place_init_type> place_init_type;
+    argparse::ArgValue<e_place_move_generator> place_move_generator;
 
     /* Timing-driven placement options only */
     argparse::ArgValue<float> PlaceTimingTradeoff;
@@ -133,6 +144,7 @@ struct t_options {
     argparse::ArgValue<bool> verify_binary_search;
     argparse::ArgValue<e_router_algorithm> RouterAlgorithm;
     argparse::ArgValue<int> min_incremental_reroute_fanout;
+    argparse::ArgValue<e_check_route_option> check_route;
 
     /* Timing-driven router options only */
     argparse::ArgValue<float> astar_fac;
@@ -143,9 +155,16 @@ struct t_options {
     argparse::ArgValue<e_routing_failure_predictor> routing_failure_predictor;
     argparse::ArgValue<e_routing_budgets_algorithm> routing_budgets_algorithm;
     argparse::ArgValue<bool> save_routing_per_iteration;
+    argparse::ArgValue<std::string> router_iteration_stats_file;
+    argparse::ArgValue<std::string> router_net_stats_file;
+    argparse::ArgValue<std::string> router_congestion_stats_prefix;
     argparse::ArgValue<float> congested_routing_iteration_threshold_frac;
     argparse::ArgValue<e_route_bb_update> route_bb_update;
     argparse::ArgValue<int> router_high_fanout_threshold;
+    argparse::ArgValue<bool> router_parallel_routing;
+    argparse::ArgValue<bool> router_warm_start;
+    argparse::ArgValue<bool> router_trunk_global_nets;
+    argparse::ArgValue<bool> router_adaptive_pres_fac;
     argparse::ArgValue<int> router_debug_net;
     argparse::ArgValue<int> router_debug_sink_rr;
     argparse::ArgValue<e_router_lookahead> router_lookahead_type;
@@ -159,6 +178,7 @@ struct t_options {
     argparse::ArgValue<int> timing_report_npaths;
     argparse::ArgValue<e_timing_report_detail> timing_report_detail;
     argparse::ArgValue<bool> timing_report_skew;
+    argparse::ArgValue<bool> timing_report_compress;
 };
 
 argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& args);
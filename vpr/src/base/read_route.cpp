@@ -7,13 +7,20 @@
  * vtr documentation. For example, the coordinates is assumed to be
  * in (x,y) format. Appropriate error messages are displayed when
  * formats are incorrect or when the routing file does not match
- * other file's information*/
+ * other file's information.
+ *
+ * The file is read at once and split into the sections of the nets,
+ * whose nodes are then parsed and checked in parallel, as they only
+ * read the RR graph, the netlist and the placement. The route traces
+ * are built afterwards in the order of the nets.
+ * A route file in the binary format (see binary_route.h) is loaded without any parsing.*/
 
 #include <iostream>
 #include <fstream>
 #include <cstdio>
 #include <cstring>
 #include <ctime>
+#include <exception>
 #include <sstream>
 #include <string>
 #include <unordered_set>
@@ -23,6 +30,7 @@
 #include "rr_graph.h"
 #include "vtr_assert.h"
 #include "vtr_util.h"
+#include "vtr_parallel.h"
 #include "tatum/echo_writer.hpp"
 #include "vtr_log.h"
 #include "check_route.h"
@@ -39,13 +47,30 @@
 #include "route_export.h"
 #include "echo_files.h"
 #include "route_common.h"
+#include "binary_route.h"
 #include "read_route.h"
 
+//The lines of a net in the routing file, i.e. the lines of its nodes (or blocks for a global net)
+struct t_route_file_net {
+    ClusterNetId inet;
+    bool is_global = false;
+    size_t begin_line = 0; //Index of the first line after the net header
+    size_t end_line = 0;   //Index of the line after the last line of the net
+};
+
+//An element of the route trace of a net, as parsed from the routing file
+struct t_route_file_trace_element {
+    RRNodeId node;
+    short iswitch;
+};
+
 /*************Functions local to this module*************/
-static void process_route(std::ifstream& fp, const char* filename, int& lineno);
-static void process_nodes(std::ifstream& fp, ClusterNetId inet, const char* filename, int& lineno);
-static void process_nets(std::ifstream& fp, ClusterNetId inet, std::string name, std::vector<std::string> input_tokens, const char* filename, int& lineno);
-static void process_global_blocks(std::ifstream& fp, ClusterNetId inet, const char* filename, int& lineno);
+static void read_text_route(const char* route_file, bool verify_file_digests);
+static std::vector<t_route_file_net> process_route(const std::vector<std::string>& lines, const char* filename);
+static void process_nets(t_route_file_net& net, std::string name, const std::vector<std::string>& input_tokens, const char* filename, int lineno);
+static void process_nodes(const std::vector<std::string>& lines, const t_route_file_net& net, std::vector<t_route_file_trace_element>& trace, const char* filename);
+static void process_global_blocks(const std::vector<std::string>& lines, const t_route_file_net& net, const char* filename);
+static bool is_net_line(const std::string& line);
 static void format_coordinates(int& x, int& y, std::string coord, ClusterNetId net, const char* filename, const int lineno);
 static void format_pin_info(std::string& pb_name, std::string& port_name, int& pb_pin_num, std::string input);
 static std::string format_name(std::string name);
@@ -55,103 +80,166 @@ bool read_route(const char* route_file, const t_router_opts& router_opts, bool v
     /* Reads in the routing file to fill in the trace.head and t_clb_opins_used data structure.
      * Perform a series of verification tests to ensure the netlist, placement, and routing
      * files match */
-    auto& device_ctx = g_vpr_ctx.mutable_device();
-    auto& place_ctx = g_vpr_ctx.placement();
     /* Begin parsing the file */
     VTR_LOG("Begin loading FPGA routing file.\n");
 
-    std::string header_str;
+    /*Allocate necessary routing structures*/
+    alloc_and_load_rr_node_route_structs();
+    init_route_structs(router_opts.bb_factor);
+
+    /* Read in every net */
+    if (is_binary_route_file(route_file)) {
+        read_binary_route(route_file, verify_file_digests);
+    } else {
+        read_text_route(route_file, verify_file_digests);
+    }
+
+    /*Correctly set up the clb opins*/
+    recompute_occupancy_from_scratch();
+
+    /* Note: This pres_fac is not necessarily correct since it isn't the first routing iteration*/
+    pathfinder_update_cost(router_opts.initial_pres_fac, router_opts.acc_fac);
+
+    reserve_locally_used_opins(router_opts.initial_pres_fac,
+                               router_opts.acc_fac, true);
+
+    /* Finished loading in the routing, now check it*/
+    recompute_occupancy_from_scratch();
+    bool is_feasible = feasible_routing();
+
+    VTR_LOG("Finished loading route file\n");
+
+    return is_feasible;
+}
+
+static void read_text_route(const char* route_file, bool verify_file_digests) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& place_ctx = g_vpr_ctx.placement();
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
 
     std::ifstream fp;
     fp.open(route_file);
 
-    int lineno = 0;
-
     if (!fp.is_open()) {
-        vpr_throw(VPR_ERROR_ROUTE, route_file, lineno,
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
                   "Cannot open %s routing file", route_file);
     }
 
-    std::getline(fp, header_str);
-    ++lineno;
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(fp, line)) {
+        lines.push_back(line);
+    }
+    fp.close();
+
+    if (lines.size() < 2) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, lines.size(),
+                  "Routing file %s is missing the placement and the array size", route_file);
+    }
 
-    std::vector<std::string> header = vtr::split(header_str);
-    if (header[0] == "Placement_File:" && header[2] == "Placement_ID:" && header[3] != place_ctx.placement_id) {
+    std::vector<std::string> header = vtr::split(lines[0]);
+    if (header.size() > 3 && header[0] == "Placement_File:" && header[2] == "Placement_ID:" && header[3] != place_ctx.placement_id) {
         auto msg = vtr::string_fmt(
             "Placement file %s specified in the routing file"
             " does not match the loaded placement (ID %s != %s)",
             header[1].c_str(), header[3].c_str(), place_ctx.placement_id.c_str());
         if (verify_file_digests) {
-            vpr_throw(VPR_ERROR_ROUTE, route_file, lineno, msg.c_str());
+            vpr_throw(VPR_ERROR_ROUTE, route_file, 1, msg.c_str());
         } else {
-            VTR_LOGF_WARN(route_file, lineno, "%s\n", msg.c_str());
+            VTR_LOGF_WARN(route_file, 1, "%s\n", msg.c_str());
         }
     }
 
-    /*Allocate necessary routing structures*/
-    alloc_and_load_rr_node_route_structs();
-    init_route_structs(router_opts.bb_factor);
-
     /*Check dimensions*/
-    std::getline(fp, header_str);
-    ++lineno;
-    header.clear();
-    header = vtr::split(header_str);
-    if (header[0] == "Array" && header[1] == "size:" && (vtr::atou(header[2].c_str()) != device_ctx.grid.width() || vtr::atou(header[4].c_str()) != device_ctx.grid.height())) {
-        vpr_throw(VPR_ERROR_ROUTE, route_file, lineno,
+    header = vtr::split(lines[1]);
+    if (header.size() > 4 && header[0] == "Array" && header[1] == "size:" && (vtr::atou(header[2].c_str()) != device_ctx.grid.width() || vtr::atou(header[4].c_str()) != device_ctx.grid.height())) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 2,
                   "Device dimensions %sx%s specified in the routing file does not match given %dx%d ",
                   header[2].c_str(), header[4].c_str(), device_ctx.grid.width(), device_ctx.grid.height());
     }
 
-    /* Read in every net */
-    process_route(fp, route_file, lineno);
-
-    fp.close();
-
-    /*Correctly set up the clb opins*/
-    recompute_occupancy_from_scratch();
-
-    /* Note: This pres_fac is not necessarily correct since it isn't the first routing iteration*/
-    pathfinder_update_cost(router_opts.initial_pres_fac, router_opts.acc_fac);
+    std::vector<t_route_file_net> nets = process_route(lines, route_file);
 
-    reserve_locally_used_opins(router_opts.initial_pres_fac,
-                               router_opts.acc_fac, true);
-
-    /* Finished loading in the routing, now check it*/
-    recompute_occupancy_from_scratch();
-    bool is_feasible = feasible_routing();
-
-    VTR_LOG("Finished loading route file\n");
+    /* The nets only read the shared data structures, so they are parsed in parallel.
+     * The first error in the order of the nets is reported, as in a serial parse */
+    std::vector<std::vector<t_route_file_trace_element>> traces(nets.size());
+    std::vector<std::exception_ptr> errors(nets.size());
+    vtr::parallel_for(nets.size(), [&](size_t inet) {
+        try {
+            if (nets[inet].is_global) {
+                process_global_blocks(lines, nets[inet], route_file);
+            } else {
+                process_nodes(lines, nets[inet], traces[inet], route_file);
+            }
+        } catch (...) {
+            errors[inet] = std::current_exception();
+        }
+    });
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
 
-    return is_feasible;
+    /* Allocate and load correct values to trace.head*/
+    for (size_t inet = 0; inet < nets.size(); ++inet) {
+        t_trace* tptr = nullptr;
+        for (const t_route_file_trace_element& element : traces[inet]) {
+            t_trace* element_tptr = alloc_trace_data();
+            element_tptr->index = element.node;
+            element_tptr->iswitch = element.iswitch;
+            element_tptr->next = nullptr;
+            if (tptr == nullptr) {
+                route_ctx.trace[nets[inet].inet].head = element_tptr;
+            } else {
+                tptr->next = element_tptr;
+            }
+            tptr = element_tptr;
+        }
+        if (tptr != nullptr) {
+            route_ctx.trace[nets[inet].inet].tail = tptr;
+        }
+    }
 }
 
-static void process_route(std::ifstream& fp, const char* filename, int& lineno) {
-    /*Walks through every net and add the routing appropriately*/
-    std::string input;
+static std::vector<t_route_file_net> process_route(const std::vector<std::string>& lines, const char* filename) {
+    /*Walks through every net and finds its lines*/
+    std::vector<t_route_file_net> nets;
     std::vector<std::string> tokens;
-    while (std::getline(fp, input)) {
-        ++lineno;
-        tokens.clear();
-        tokens = vtr::split(input);
-        if (tokens.empty()) {
-            continue; //Skip blank lines
-        } else if (tokens[0][0] == '#') {
-            continue; //Skip commented lines
-        } else if (tokens[0] == "Net") {
-            ClusterNetId inet(atoi(tokens[1].c_str()));
-            process_nets(fp, inet, tokens[2], tokens, filename, lineno);
+    for (size_t iline = 2; iline < lines.size(); ++iline) {
+        if (!is_net_line(lines[iline])) {
+            continue;
+        }
+        tokens = vtr::split(lines[iline]);
+        if (tokens.size() < 3) {
+            vpr_throw(VPR_ERROR_ROUTE, filename, iline + 1,
+                      "Net header should contain the net number and name");
         }
-    }
 
-    tokens.clear();
+        if (!nets.empty()) {
+            nets.back().end_line = iline;
+        }
+        t_route_file_net net;
+        net.inet = ClusterNetId(atoi(tokens[1].c_str()));
+        net.begin_line = iline + 1;
+        net.end_line = lines.size();
+        process_nets(net, tokens[2], tokens, filename, iline + 1);
+        nets.push_back(net);
+    }
+    return nets;
 }
 
-static void process_nets(std::ifstream& fp, ClusterNetId inet, std::string name, std::vector<std::string> input_tokens, const char* filename, int& lineno) {
-    /* Check if the net is global or not, and process appropriately */
-    auto& cluster_ctx = g_vpr_ctx.mutable_clustering();
+static void process_nets(t_route_file_net& net, std::string name, const std::vector<std::string>& input_tokens, const char* filename, int lineno) {
+    /* Check if the net is global or not, and check its name */
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    ClusterNetId inet = net.inet;
+
+    if (size_t(inet) >= cluster_ctx.clb_nlist.nets().size()) {
+        vpr_throw(VPR_ERROR_ROUTE, filename, lineno,
+                  "Net %lu specified in the routing file does not exist in the netlist", size_t(inet));
+    }
 
-    if (input_tokens.size() > 3 && input_tokens[3] == "global"
+    if (input_tokens.size() > 5 && input_tokens[3] == "global"
         && input_tokens[4] == "net" && input_tokens[5] == "connecting:") {
         /* Global net.  Never routed. */
         if (!cluster_ctx.clb_nlist.net_is_ignored(inet)) {
@@ -160,72 +248,49 @@ static void process_nets(std::ifstream& fp, ClusterNetId inet, std::string name,
         }
         /*erase an extra colon for global nets*/
         name.erase(name.end() - 1);
-        name = format_name(name);
-
-        if (0 != cluster_ctx.clb_nlist.net_name(inet).compare(name)) {
-            vpr_throw(VPR_ERROR_ROUTE, filename, lineno,
-                      "Net name %s for net number %lu specified in the routing file does not match given %s",
-                      name.c_str(), size_t(inet), cluster_ctx.clb_nlist.net_name(inet).c_str());
-        }
-
-        process_global_blocks(fp, inet, filename, lineno);
+        net.is_global = true;
     } else {
         /* Not a global net */
         if (cluster_ctx.clb_nlist.net_is_ignored(inet)) {
             VTR_LOG_WARN("Net %lu (%s) is marked as global in the netlist, but is non-global in the .route file\n", size_t(inet), cluster_ctx.clb_nlist.net_name(inet).c_str());
         }
+    }
 
-        name = format_name(name);
-
-        if (0 != cluster_ctx.clb_nlist.net_name(inet).compare(name)) {
-            vpr_throw(VPR_ERROR_ROUTE, filename, lineno,
-                      "Net name %s for net number %lu specified in the routing file does not match given %s",
-                      name.c_str(), size_t(inet), cluster_ctx.clb_nlist.net_name(inet).c_str());
-        }
+    name = format_name(name);
 
-        process_nodes(fp, inet, filename, lineno);
+    if (0 != cluster_ctx.clb_nlist.net_name(inet).compare(name)) {
+        vpr_throw(VPR_ERROR_ROUTE, filename, lineno,
+                  "Net name %s for net number %lu specified in the routing file does not match given %s",
+                  name.c_str(), size_t(inet), cluster_ctx.clb_nlist.net_name(inet).c_str());
     }
-    input_tokens.clear();
-    return;
 }
 
-static void process_nodes(std::ifstream& fp, ClusterNetId inet, const char* filename, int& lineno) {
-    /* Not a global net. Goes through every node and add it into trace.head*/
+static void process_nodes(const std::vector<std::string>& lines, const t_route_file_net& net, std::vector<t_route_file_trace_element>& trace, const char* filename) {
+    /* Not a global net. Goes through every node and add it into the trace*/
 
-    auto& cluster_ctx = g_vpr_ctx.mutable_clustering();
-    auto& device_ctx = g_vpr_ctx.mutable_device();
-    auto& route_ctx = g_vpr_ctx.mutable_routing();
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& device_ctx = g_vpr_ctx.device();
     auto& place_ctx = g_vpr_ctx.placement();
 
-    t_trace* tptr = route_ctx.trace[inet].head;
-
-    /*remember the position of the last line in order to go back*/
-    std::streampos oldpos = fp.tellg();
+    ClusterNetId inet = net.inet;
     int inode, x, y, x2, y2, ptc, switch_id, offset;
-    int node_count = 0;
-    std::string input;
     std::vector<std::string> tokens;
 
     /*Walk through every line that begins with Node:*/
-    while (std::getline(fp, input)) {
-        ++lineno;
+    for (size_t iline = net.begin_line; iline < net.end_line; ++iline) {
+        const std::string& input = lines[iline];
+        int lineno = iline + 1;
 
-        tokens.clear();
         tokens = vtr::split(input);
 
         if (tokens.empty()) {
             continue; /*Skip blank lines*/
         } else if (tokens[0][0] == '#') {
             continue; /*Skip commented lines*/
-        } else if (tokens[0] == "Net") {
-            /*End of the nodes list,
-             *  return by moving the position of next char of input stream to be before net*/
-            fp.seekg(oldpos);
-            return;
-        } else if (input == "\n\nUsed in local cluster only, reserved one CLB pin\n\n") {
+        } else if (input == "Used in local cluster only, reserved one CLB pin") {
             if (cluster_ctx.clb_nlist.net_sinks(inet).size() != 0) {
                 vpr_throw(VPR_ERROR_ROUTE, filename, lineno,
-                          "Net %d should be used in local cluster only, reserved one CLB pin");
+                          "Net %lu should be used in local cluster only, reserved one CLB pin", size_t(inet));
             }
             return;
         } else if (tokens[0] == "Node:") {
@@ -233,8 +298,13 @@ static void process_nodes(std::ifstream& fp, ClusterNetId inet, const char* file
             inode = atoi(tokens[1].c_str());
             const RRNodeId& node = RRNodeId(inode);
 
+            if (inode < 0 || !device_ctx.rr_graph.valid_node_id(node)) {
+                vpr_throw(VPR_ERROR_ROUTE, filename, lineno,
+                          "Node %d does not exist in the RR graph", inode);
+            }
+
             /*First node needs to be source. It is isolated to correctly set heap head.*/
-            if (node_count == 0 && tokens[2] != "SOURCE") {
+            if (trace.empty() && tokens[2] != "SOURCE") {
                 vpr_throw(VPR_ERROR_ROUTE, filename, lineno,
                           "First node in routing has to be a source type");
             }
@@ -315,53 +385,34 @@ static void process_nodes(std::ifstream& fp, ClusterNetId inet, const char* file
                 switch_id = atoi(tokens[7 + offset].c_str());
             }
 
-            /* Allocate and load correct values to trace.head*/
-            if (node_count == 0) {
-                route_ctx.trace[inet].head = alloc_trace_data();
-                route_ctx.trace[inet].head->index = node;
-                route_ctx.trace[inet].head->iswitch = switch_id;
-                route_ctx.trace[inet].head->next = nullptr;
-                tptr = route_ctx.trace[inet].head;
-                node_count++;
-            } else {
-                tptr->next = alloc_trace_data();
-                tptr = tptr->next;
-                tptr->index = node;
-                tptr->iswitch = switch_id;
-                tptr->next = nullptr;
-                node_count++;
-            }
+            trace.push_back({node, short(switch_id)});
         }
-        /*stores last line so can easily go back to read*/
-        oldpos = fp.tellg();
     }
 }
 
 /*This function goes through all the blocks in a global net and verify it with the
  * clustered netlist and the placement */
-static void process_global_blocks(std::ifstream& fp, ClusterNetId inet, const char* filename, int& lineno) {
-    auto& cluster_ctx = g_vpr_ctx.mutable_clustering();
+static void process_global_blocks(const std::vector<std::string>& lines, const t_route_file_net& net, const char* filename) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& place_ctx = g_vpr_ctx.placement();
 
-    std::string block, bnum_str;
+    ClusterNetId inet = net.inet;
+    std::string bnum_str;
     int x, y;
     std::vector<std::string> tokens;
     int pin_counter = 0;
 
-    std::streampos oldpos = fp.tellg();
     /*Walk through every block line*/
-    while (std::getline(fp, block)) {
-        ++lineno;
-        tokens.clear();
-        tokens = vtr::split(block);
+    for (size_t iline = net.begin_line; iline < net.end_line; ++iline) {
+        int lineno = iline + 1;
+        tokens = vtr::split(lines[iline]);
 
         if (tokens.empty()) {
             continue; /*Skip blank lines*/
         } else if (tokens[0][0] == '#') {
             continue; /*Skip commented lines*/
         } else if (tokens[0] != "Block") {
-            /*End of blocks, go back to reading nets*/
-            fp.seekg(oldpos);
+            /*End of blocks*/
             return;
         } else {
             format_coordinates(x, y, tokens[4], inet, filename, lineno);
@@ -392,10 +443,17 @@ static void process_global_blocks(std::ifstream& fp, ClusterNetId inet, const ch
             }
             pin_counter++;
         }
-        oldpos = fp.tellg();
     }
 }
 
+/*Returns true if the line is the header of a net, i.e. its first token is Net*/
+static bool is_net_line(const std::string& line) {
+    size_t first = line.find_first_not_of(" \t");
+    return first != std::string::npos
+           && line.compare(first, 3, "Net") == 0
+           && (first + 3 == line.size() || line[first + 3] == ' ' || line[first + 3] == '\t');
+}
+
 static void format_coordinates(int& x, int& y, std::string coord, ClusterNetId net, const char* filename, const int lineno) {
     /*Parse coordinates in the form of (x,y) into correct x and y values*/
     coord = format_name(coord);
@@ -1,12 +1,14 @@
 #include <cstdio>
 #include <cstring>
 #include <cmath>
+#include <exception>
 #include <set>
 
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_math.h"
 #include "vtr_ndmatrix.h"
+#include "vtr_parallel.h"
 
 #include "vpr_types.h"
 #include "vpr_error.h"
@@ -27,13 +29,30 @@
 #include "timing_util.h"
 #include "tatum/TimingReporter.hpp"
 
+/* Statistics of the route traces, which are collected in a single pass over the nets */
+struct t_route_trace_stats {
+    int total_bends = 0;
+    int max_bends = 0;
+    int total_length = 0;
+    int max_length = 0;
+    int total_segments = 0;
+    int max_segments = 0;
+    int num_global_nets = 0;
+    int num_clb_opins_reserved = 0;
+
+    vtr::Matrix<int> chanx_occ; //[0 .. device_ctx.grid.width() - 1][0 .. device_ctx.grid.height() - 2]
+    vtr::Matrix<int> chany_occ; //[0 .. device_ctx.grid.width() - 2][0 .. device_ctx.grid.height() - 1]
+};
+
 /********************** Subroutines local to this module *********************/
 
-static void load_channel_occupancies(vtr::Matrix<int>& chanx_occ, vtr::Matrix<int>& chany_occ);
+static t_route_trace_stats collect_route_trace_stats();
+
+static void load_channel_occupancies(ClusterNetId net_id, vtr::Matrix<int>& chanx_occ, vtr::Matrix<int>& chany_occ);
 
-static void length_and_bends_stats();
+static void length_and_bends_stats(const t_route_trace_stats& stats);
 
-static void get_channel_occupancy_stats();
+static void get_channel_occupancy_stats(const t_route_trace_stats& stats);
 
 /************************* Subroutine definitions ****************************/
 
@@ -48,9 +67,10 @@ void routing_stats(bool full_stats, enum e_route_type route_type, std::vector<t_
 
     int num_rr_switch = device_ctx.rr_switch_inf.size();
 
-    length_and_bends_stats();
+    t_route_trace_stats trace_stats = collect_route_trace_stats();
+    length_and_bends_stats(trace_stats);
     print_channel_stats();
-    get_channel_occupancy_stats();
+    get_channel_occupancy_stats(trace_stats);
 
     VTR_LOG("Logic area (in minimum width transistor areas, excludes I/Os and empty grid tiles)...\n");
 
@@ -96,45 +116,101 @@ void routing_stats(bool full_stats, enum e_route_type route_type, std::vector<t_
         print_wirelen_prob_dist();
 }
 
-/* Figures out maximum, minimum and average number of bends and net length   *
- * in the routing.                                                           */
-void length_and_bends_stats() {
-    int bends, total_bends, max_bends;
-    int length, total_length, max_length;
-    int segments, total_segments, max_segments;
-    float av_bends, av_length, av_segments;
-    int num_global_nets, num_clb_opins_reserved;
-
+/* Walks the route traces of all the nets once, in parallel, to collect the    *
+ * number of bends and the length of the nets and the occupancy of the         *
+ * channels. Each worker accumulates its own statistics, which are merged      *
+ * afterwards, so the results do not depend on the number of workers.          */
+static t_route_trace_stats collect_route_trace_stats() {
+    auto& device_ctx = g_vpr_ctx.device();
     auto& cluster_ctx = g_vpr_ctx.clustering();
 
-    max_bends = 0;
-    total_bends = 0;
-    max_length = 0;
-    total_length = 0;
-    max_segments = 0;
-    total_segments = 0;
-    num_global_nets = 0;
-    num_clb_opins_reserved = 0;
+    size_t num_nets = cluster_ctx.clb_nlist.nets().size();
+    size_t num_threads = std::max<size_t>(1, std::min(vtr::num_workers(), num_nets));
 
-    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
-        if (!cluster_ctx.clb_nlist.net_is_ignored(net_id) && cluster_ctx.clb_nlist.net_sinks(net_id).size() != 0) { /* Globals don't count. */
-            get_num_bends_and_length(net_id, &bends, &length, &segments);
+    std::vector<t_route_trace_stats> worker_stats(num_threads);
+    for (t_route_trace_stats& stats : worker_stats) {
+        stats.chanx_occ = vtr::Matrix<int>({{device_ctx.grid.width(), device_ctx.grid.height() - 1}}, 0);
+        stats.chany_occ = vtr::Matrix<int>({{device_ctx.grid.width() - 1, device_ctx.grid.height()}}, 0);
+    }
 
-            total_bends += bends;
-            max_bends = std::max(bends, max_bends);
+    std::vector<std::exception_ptr> errors(num_nets);
+    vtr::parallel_for_workers(num_nets, num_threads, [&](size_t inet, size_t worker) {
+        ClusterNetId net_id(inet);
+        t_route_trace_stats& stats = worker_stats[worker];
+        try {
+            if (!cluster_ctx.clb_nlist.net_is_ignored(net_id) && cluster_ctx.clb_nlist.net_sinks(net_id).size() != 0) { /* Globals don't count. */
+                int bends, length, segments;
+                get_num_bends_and_length(net_id, &bends, &length, &segments);
+
+                stats.total_bends += bends;
+                stats.max_bends = std::max(bends, stats.max_bends);
+
+                stats.total_length += length;
+                stats.max_length = std::max(length, stats.max_length);
+
+                stats.total_segments += segments;
+                stats.max_segments = std::max(segments, stats.max_segments);
+            } else if (cluster_ctx.clb_nlist.net_is_ignored(net_id)) {
+                stats.num_global_nets++;
+            } else {
+                stats.num_clb_opins_reserved++;
+            }
 
-            total_length += length;
-            max_length = std::max(length, max_length);
+            load_channel_occupancies(net_id, stats.chanx_occ, stats.chany_occ);
+        } catch (...) {
+            errors[inet] = std::current_exception();
+        }
+    });
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
 
-            total_segments += segments;
-            max_segments = std::max(segments, max_segments);
-        } else if (cluster_ctx.clb_nlist.net_is_ignored(net_id)) {
-            num_global_nets++;
-        } else {
-            num_clb_opins_reserved++;
+    /* Merge the statistics of the workers into the first one */
+    t_route_trace_stats& stats = worker_stats[0];
+    for (size_t worker = 1; worker < num_threads; ++worker) {
+        const t_route_trace_stats& other = worker_stats[worker];
+        stats.total_bends += other.total_bends;
+        stats.max_bends = std::max(stats.max_bends, other.max_bends);
+        stats.total_length += other.total_length;
+        stats.max_length = std::max(stats.max_length, other.max_length);
+        stats.total_segments += other.total_segments;
+        stats.max_segments = std::max(stats.max_segments, other.max_segments);
+        stats.num_global_nets += other.num_global_nets;
+        stats.num_clb_opins_reserved += other.num_clb_opins_reserved;
+
+        for (size_t i = 0; i < stats.chanx_occ.dim_size(0); ++i) {
+            for (size_t j = 0; j < stats.chanx_occ.dim_size(1); ++j) {
+                stats.chanx_occ[i][j] += other.chanx_occ[i][j];
+            }
+        }
+        for (size_t i = 0; i < stats.chany_occ.dim_size(0); ++i) {
+            for (size_t j = 0; j < stats.chany_occ.dim_size(1); ++j) {
+                stats.chany_occ[i][j] += other.chany_occ[i][j];
+            }
         }
     }
 
+    return std::move(stats);
+}
+
+/* Figures out maximum, minimum and average number of bends and net length   *
+ * in the routing.                                                           */
+void length_and_bends_stats(const t_route_trace_stats& stats) {
+    float av_bends, av_length, av_segments;
+
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    int total_bends = stats.total_bends;
+    int max_bends = stats.max_bends;
+    int total_length = stats.total_length;
+    int max_length = stats.max_length;
+    int total_segments = stats.total_segments;
+    int max_segments = stats.max_segments;
+    int num_global_nets = stats.num_global_nets;
+    int num_clb_opins_reserved = stats.num_clb_opins_reserved;
+
     av_bends = (float)total_bends / (float)((int)cluster_ctx.clb_nlist.nets().size() - num_global_nets);
     VTR_LOG("\n");
     VTR_LOG("Average number of bends per net: %#g  Maximum # of bends: %d\n", av_bends, max_bends);
@@ -155,22 +231,12 @@ void length_and_bends_stats() {
     VTR_LOG("\tTotal local nets with reserved CLB opins: %d\n", num_clb_opins_reserved);
 }
 
-static void get_channel_occupancy_stats() {
+static void get_channel_occupancy_stats(const t_route_trace_stats& stats) {
     /* Determines how many tracks are used in each channel.                    */
     auto& device_ctx = g_vpr_ctx.device();
 
-    auto chanx_occ = vtr::Matrix<int>({{
-                                          device_ctx.grid.width(),     //[0 .. device_ctx.grid.width() - 1] (length of x channel)
-                                          device_ctx.grid.height() - 1 //[0 .. device_ctx.grid.height() - 2] (# x channels)
-                                      }},
-                                      0);
-
-    auto chany_occ = vtr::Matrix<int>({{
-                                          device_ctx.grid.width() - 1, //[0 .. device_ctx.grid.width() - 2] (# y channels)
-                                          device_ctx.grid.height()     //[0 .. device_ctx.grid.height() - 1] (length of y channel)
-                                      }},
-                                      0);
-    load_channel_occupancies(chanx_occ, chany_occ);
+    const vtr::Matrix<int>& chanx_occ = stats.chanx_occ;
+    const vtr::Matrix<int>& chany_occ = stats.chany_occ;
 
     VTR_LOG("\n");
     VTR_LOG("X - Directed channels:   j max occ ave occ capacity\n");
@@ -212,9 +278,9 @@ static void get_channel_occupancy_stats() {
     VTR_LOG("\n");
 }
 
-/* Loads the two arrays passed in with the total occupancy at each of the  *
- * channel segments in the FPGA.                                           */
-static void load_channel_occupancies(vtr::Matrix<int>& chanx_occ, vtr::Matrix<int>& chany_occ) {
+/* Adds the occupancy of the routing of a net at each of the channel      *
+ * segments in the FPGA to the two arrays passed in.                      */
+static void load_channel_occupancies(ClusterNetId net_id, vtr::Matrix<int>& chanx_occ, vtr::Matrix<int>& chany_occ) {
     int i, j;
     t_trace* tptr;
     t_rr_type rr_type;
@@ -223,41 +289,34 @@ static void load_channel_occupancies(vtr::Matrix<int>& chanx_occ, vtr::Matrix<in
     auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& route_ctx = g_vpr_ctx.routing();
 
-    /* First set the occupancy of everything to zero. */
-    chanx_occ.fill(0);
-    chany_occ.fill(0);
+    /* Skip global and empty nets. */
+    if (cluster_ctx.clb_nlist.net_is_ignored(net_id) && cluster_ctx.clb_nlist.net_sinks(net_id).size() != 0)
+        return;
 
-    /* Now go through each net and count the tracks and pins used everywhere */
-    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
-        /* Skip global and empty nets. */
-        if (cluster_ctx.clb_nlist.net_is_ignored(net_id) && cluster_ctx.clb_nlist.net_sinks(net_id).size() != 0)
-            continue;
-
-        tptr = route_ctx.trace[net_id].head;
-        while (tptr != nullptr) {
-            const RRNodeId& inode = tptr->index;
-            rr_type = device_ctx.rr_graph.node_type(inode);
-
-            if (rr_type == SINK) {
-                tptr = tptr->next; /* Skip next segment. */
-                if (tptr == nullptr)
-                    break;
-            }
+    tptr = route_ctx.trace[net_id].head;
+    while (tptr != nullptr) {
+        const RRNodeId& inode = tptr->index;
+        rr_type = device_ctx.rr_graph.node_type(inode);
 
-            else if (rr_type == CHANX) {
-                j = device_ctx.rr_graph.node_ylow(inode);
-                for (i = device_ctx.rr_graph.node_xlow(inode); i <= device_ctx.rr_graph.node_xhigh(inode); i++)
-                    chanx_occ[i][j]++;
-            }
+        if (rr_type == SINK) {
+            tptr = tptr->next; /* Skip next segment. */
+            if (tptr == nullptr)
+                break;
+        }
 
-            else if (rr_type == CHANY) {
-                i = device_ctx.rr_graph.node_xlow(inode);
-                for (j = device_ctx.rr_graph.node_ylow(inode); j <= device_ctx.rr_graph.node_yhigh(inode); j++)
-                    chany_occ[i][j]++;
-            }
+        else if (rr_type == CHANX) {
+            j = device_ctx.rr_graph.node_ylow(inode);
+            for (i = device_ctx.rr_graph.node_xlow(inode); i <= device_ctx.rr_graph.node_xhigh(inode); i++)
+                chanx_occ[i][j]++;
+        }
 
-            tptr = tptr->next;
+        else if (rr_type == CHANY) {
+            i = device_ctx.rr_graph.node_xlow(inode);
+            for (j = device_ctx.rr_graph.node_ylow(inode); j <= device_ctx.rr_graph.node_yhigh(inode); j++)
+                chany_occ[i][j]++;
         }
+
+        tptr = tptr->next;
     }
 }
 
@@ -13,13 +13,19 @@
 #include <chrono>
 #include <cmath>
 #include <sstream>
+#include <array>
+#include <utility>
 
 #include "vtr_assert.h"
 #include "vtr_math.h"
 #include "vtr_log.h"
 #include "vtr_version.h"
 #include "vtr_time.h"
+#include "vtr_trace.h"
 #include "vtr_path.h"
+#include "vtr_digest.h"
+#include "vtr_parallel.h"
+#include "vtr_random.h"
 
 #include "vpr_types.h"
 #include "vpr_utils.h"
@@ -92,6 +98,9 @@ static void free_complex_block_types();
 static void free_device(const t_det_routing_arch& routing_arch);
 static void free_circuit();
 
+static std::pair<double, double> compute_seed_metric(const t_vpr_setup& vpr_setup, const RouteStatus& route_status);
+static std::string seed_file_name(const std::string& file_name, int seed);
+
 static void get_intercluster_switch_fanin_estimates(const t_vpr_setup& vpr_setup,
                                                     const t_arch& arch,
                                                     const int wire_segment_length,
@@ -210,7 +219,18 @@ void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_a
         VTR_LOG_WARN("VPR was compiled without parallel execution support, ignoring the specified number of workers (%zu)",
                      options->num_workers.value());
     }
+    num_workers = 1;
 #endif
+    //Also used by the parallel loops of vtr::parallel_for(), unless it was set
+    //by the tool embedding VPR (e.g. the --threads of the OpenFPGA shell)
+    if (options->num_workers.provenance() == argparse::Provenance::SPECIFIED
+        || std::getenv("VPR_NUM_WORKERS") != nullptr) {
+        vtr::set_num_workers(num_workers);
+    }
+
+    if (!options->trace_file.value().empty()) {
+        vtr::enable_trace(options->trace_file.value());
+    }
 
     vpr_setup->TimingEnabled = options->timing_analysis;
     vpr_setup->device_layout = options->device_layout;
@@ -218,6 +238,7 @@ void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_a
     vpr_setup->clock_modeling = options->clock_modeling;
     vpr_setup->two_stage_clock_routing = options->two_stage_clock_routing;
     vpr_setup->exit_before_pack = options->exit_before_pack;
+    vpr_setup->reuse_device = options->reuse_device;
 
     VTR_LOG("\n");
     VTR_LOG("Architecture file: %s\n", options->ArchFile.value().c_str());
@@ -256,10 +277,29 @@ void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_a
         add_warnings_to_suppress(func_name);
     }
 
+    /* Reuse the architecture loaded by a previous invocation if the file is unchanged.
+     * The device types, which the architecture refers to, are kept in the device context.
+     * The architecture is not copyable, so its content is moved to the caller's object,
+     * which becomes the architecture of the device from now on
+     */
+    bool read_arch_file = true;
+    if (vpr_setup->reuse_device) {
+        auto& device_ctx = g_vpr_ctx.mutable_device();
+        if (device_ctx.arch != nullptr
+            && device_ctx.arch != arch
+            && device_ctx.arch->architecture_id != nullptr
+            && vtr::secure_digest_file(options->ArchFile.value()) == device_ctx.arch->architecture_id) {
+            VTR_LOG("Reusing architecture '%s' loaded by a previous invocation\n", options->ArchFile.value().c_str());
+            *arch = std::move(*const_cast<t_arch*>(device_ctx.arch));
+            device_ctx.arch = arch;
+            read_arch_file = false;
+        }
+    }
+
     /* Read in arch and circuit */
     SetupVPR(options,
              vpr_setup->TimingEnabled,
-             true,
+             read_arch_file,
              &vpr_setup->FileNameOpts,
              arch,
              &vpr_setup->user_models,
@@ -354,17 +394,21 @@ bool vpr_flow(t_vpr_setup& vpr_setup, t_arch& arch) {
     vpr_create_device(vpr_setup, arch);
 
     vpr_init_graphics(vpr_setup, arch);
-    { //Place
-        bool place_success = vpr_place_flow(vpr_setup, arch);
+    RouteStatus route_status;
+    if (vpr_setup.PlacerOpts.num_seeds > 1) { //Place and route each seed
+        route_status = vpr_multi_seed_flow(vpr_setup, arch);
+    } else {
+        { //Place
+            bool place_success = vpr_place_flow(vpr_setup, arch);
 
-        if (!place_success) {
-            std::cout << "failed placement" << std::endl;
-            return false; //Unimplementable
+            if (!place_success) {
+                std::cout << "failed placement" << std::endl;
+                return false; //Unimplementable
+            }
+        }
+        { //Route
+            route_status = vpr_route_flow(vpr_setup, arch);
         }
-    }
-    RouteStatus route_status;
-    { //Route
-        route_status = vpr_route_flow(vpr_setup, arch);
     }
     { //Analysis
         vpr_analysis_flow(vpr_setup, arch, route_status);
@@ -567,6 +611,7 @@ void vpr_load_packing(t_vpr_setup& vpr_setup, const t_arch& arch) {
     cluster_ctx.clb_nlist = read_netlist(vpr_setup.FileNameOpts.NetFile.c_str(),
                                          &arch,
                                          vpr_setup.FileNameOpts.verify_file_digests,
+                                         vpr_setup.FileNameOpts.net_file_cache,
                                          vpr_setup.PackerOpts.pack_verbosity);
 
     process_constant_nets(cluster_ctx.clb_nlist, vpr_setup.constant_net_method, vpr_setup.PackerOpts.pack_verbosity);
@@ -688,7 +733,7 @@ RouteStatus vpr_route_flow(t_vpr_setup& vpr_setup, const t_arch& arch) {
         std::string graphics_msg;
         if (route_status.success()) {
             //Sanity check the routing
-            check_route(router_opts.route_type);
+            check_route(router_opts.route_type, router_opts.check_route);
             get_serial_num();
 
             //Update status
@@ -817,6 +862,138 @@ RouteStatus vpr_load_routing(t_vpr_setup& vpr_setup,
     return RouteStatus(is_legal, fixed_channel_width);
 }
 
+RouteStatus vpr_multi_seed_flow(t_vpr_setup& vpr_setup, const t_arch& arch) {
+    auto& placer_opts = vpr_setup.PlacerOpts;
+    auto& router_opts = vpr_setup.RouterOpts;
+    auto& filename_opts = vpr_setup.FileNameOpts;
+
+    VTR_ASSERT(placer_opts.doPlacement == STAGE_DO && router_opts.doRouting == STAGE_DO);
+
+    const int first_seed = placer_opts.seed;
+    const std::string place_file = filename_opts.PlaceFile;
+    const std::string route_file = filename_opts.RouteFile;
+
+    //The device (and the placement delay model and router lookahead, which are cached)
+    //are shared by the seeds, while the placement and routing are redone for each seed
+    int best_seed = -1;
+    RouteStatus best_route_status;
+    RouteStatus route_status;
+    std::pair<double, double> best_metric;
+    for (int iseed = 0; iseed < placer_opts.num_seeds; ++iseed) {
+        int seed = first_seed + iseed;
+        VTR_LOG("\n");
+        VTR_LOG("Placing and routing seed %d (%d of %d)\n", seed, iseed + 1, placer_opts.num_seeds);
+
+        placer_opts.seed = seed;
+        vtr::srandom(seed);
+        filename_opts.PlaceFile = seed_file_name(place_file, seed);
+        filename_opts.RouteFile = seed_file_name(route_file, seed);
+
+        vpr_place_flow(vpr_setup, arch);
+        route_status = vpr_route_flow(vpr_setup, arch);
+
+        if (!route_status.success()) {
+            VTR_LOG("Seed %d is unroutable\n", seed);
+            continue;
+        }
+
+        std::pair<double, double> metric = compute_seed_metric(vpr_setup, route_status);
+        VTR_LOG("Seed %d result: channel width %d, metric %g (wirelength %g)\n",
+                seed, route_status.chan_width(), metric.first, metric.second);
+        if (best_seed < 0 || metric < best_metric) {
+            best_seed = seed;
+            best_route_status = route_status;
+            best_metric = metric;
+        }
+    }
+
+    placer_opts.seed = first_seed;
+    filename_opts.PlaceFile = place_file;
+    filename_opts.RouteFile = route_file;
+
+    if (best_seed < 0) {
+        VTR_LOG_WARN("None of the %d seeds is routable\n", placer_opts.num_seeds);
+        return route_status;
+    }
+
+    VTR_LOG("\n");
+    VTR_LOG("Best seed is %d (channel width %d, metric %g)\n", best_seed, best_route_status.chan_width(), best_metric.first);
+
+    //Reload the best placement and routing, and write them to the regular files
+    filename_opts.PlaceFile = seed_file_name(place_file, best_seed);
+    filename_opts.RouteFile = seed_file_name(route_file, best_seed);
+    const int fixed_channel_width = router_opts.fixed_channel_width;
+    router_opts.doRouting = STAGE_LOAD;
+    router_opts.fixed_channel_width = best_route_status.chan_width();
+
+    vpr_load_placement(vpr_setup, arch);
+    sync_grid_to_blocks();
+    post_place_sync();
+
+    vpr_create_rr_graph(vpr_setup, arch, best_route_status.chan_width());
+    route_status = vpr_route_flow(vpr_setup, arch);
+
+    router_opts.doRouting = STAGE_DO;
+    router_opts.fixed_channel_width = fixed_channel_width;
+    filename_opts.PlaceFile = place_file;
+    filename_opts.RouteFile = route_file;
+
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    print_place(filename_opts.NetFile.c_str(), cluster_ctx.clb_nlist.netlist_id().c_str(), place_file.c_str());
+    print_route(place_file.c_str(), route_file.c_str());
+
+    return route_status;
+}
+
+//Returns the metric of the current routing of a seed (the smaller the better),
+//and the routed wirelength to break ties
+static std::pair<double, double> compute_seed_metric(const t_vpr_setup& vpr_setup, const RouteStatus& route_status) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    double wirelength = 0.;
+    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
+        if (!cluster_ctx.clb_nlist.net_is_ignored(net_id)
+            && cluster_ctx.clb_nlist.net_sinks(net_id).size() != 0) {
+            int bends, length, segments;
+            get_num_bends_and_length(net_id, &bends, &length, &segments);
+            wirelength += length;
+        }
+    }
+
+    e_seeds_metric metric = vpr_setup.PlacerOpts.seeds_metric;
+    if (metric == e_seeds_metric::CRITICAL_PATH && !vpr_setup.TimingEnabled) {
+        metric = e_seeds_metric::WIRELENGTH;
+    }
+
+    if (metric == e_seeds_metric::CHANNEL_WIDTH) {
+        return {route_status.chan_width(), wirelength};
+    } else if (metric == e_seeds_metric::WIRELENGTH) {
+        return {wirelength, wirelength};
+    }
+    VTR_ASSERT(metric == e_seeds_metric::CRITICAL_PATH);
+
+    auto& atom_ctx = g_vpr_ctx.atom();
+
+    vtr::t_chunk net_delay_ch;
+    vtr::vector<ClusterNetId, float*> net_delay = alloc_net_delay(&net_delay_ch);
+    load_net_delay_from_routing(net_delay);
+
+    auto analysis_delay_calc = std::make_shared<AnalysisDelayCalculator>(atom_ctx.nlist, atom_ctx.lookup, net_delay);
+    auto timing_info = make_setup_hold_timing_info(analysis_delay_calc);
+    timing_info->update();
+    double critical_path_delay = timing_info->least_slack_critical_path().delay();
+
+    free_net_delay(net_delay, &net_delay_ch);
+
+    return {critical_path_delay, wirelength};
+}
+
+//Returns the name of the file of a seed, e.g. 'top.seed3.place' for 'top.place'
+static std::string seed_file_name(const std::string& file_name, int seed) {
+    std::array<std::string, 2> base_ext = vtr::split_ext(file_name);
+    return base_ext[0] + ".seed" + std::to_string(seed) + base_ext[1];
+}
+
 void vpr_create_rr_graph(t_vpr_setup& vpr_setup, const t_arch& arch, int chan_width_fac) {
     auto& device_ctx = g_vpr_ctx.mutable_device();
     auto det_routing_arch = &vpr_setup.RoutingArch;
@@ -836,6 +1013,21 @@ void vpr_create_rr_graph(t_vpr_setup& vpr_setup, const t_arch& arch, int chan_wi
         }
     }
 
+    //Keep the RR graph built by a previous invocation for the same architecture, device and channel width
+    if (vpr_setup.reuse_device
+        && !device_ctx.rr_graph_architecture_id.empty()
+        && device_ctx.rr_graph_architecture_id == arch.architecture_id
+        && device_ctx.rr_graph_grid_width == device_ctx.grid.width()
+        && device_ctx.rr_graph_grid_height == device_ctx.grid.height()
+        && device_ctx.rr_graph_type == graph_type
+        && device_ctx.read_rr_graph_filename == det_routing_arch->read_rr_graph_filename
+        && channel_widths_unchanged(device_ctx.chan_width, chan_width)) {
+        VTR_LOG("Reusing the RR graph built by a previous invocation\n");
+        det_routing_arch->wire_to_rr_ipin_switch = device_ctx.rr_graph_wire_to_ipin_switch;
+        init_draw_coords(chan_width_fac);
+        return;
+    }
+
     int warnings = 0;
 
     //Clean-up any previous RR graph
@@ -856,6 +1048,14 @@ void vpr_create_rr_graph(t_vpr_setup& vpr_setup, const t_arch& arch, int chan_wi
                     router_opts.clock_modeling,
                     arch.Directs, arch.num_directs,
                     &warnings);
+
+    //Record what the RR graph is built for, so that a later invocation can reuse it
+    device_ctx.rr_graph_architecture_id = arch.architecture_id;
+    device_ctx.rr_graph_grid_width = device_ctx.grid.width();
+    device_ctx.rr_graph_grid_height = device_ctx.grid.height();
+    device_ctx.rr_graph_type = graph_type;
+    device_ctx.rr_graph_wire_to_ipin_switch = det_routing_arch->wire_to_rr_ipin_switch;
+
     //Initialize drawing, now that we have an RR graph
     init_draw_coords(chan_width_fac);
 }
@@ -1030,6 +1230,7 @@ static void free_routing() {
 void vpr_free_vpr_data_structures(t_arch& Arch,
                                   t_vpr_setup& vpr_setup) {
     free_all_lb_type_rr_graph(vpr_setup.PackerRRGraph);
+    g_vpr_ctx.mutable_device().lb_type_rr_graphs = nullptr;
     free_circuit();
     free_arch(&Arch);
     free_device(vpr_setup.RoutingArch);
@@ -61,6 +61,8 @@ void vpr_place(t_vpr_setup& vpr_setup, const t_arch& arch);          //Perform p
 void vpr_load_placement(t_vpr_setup& vpr_setup, const t_arch& arch); //Loads a previous placement
 
 RouteStatus vpr_route_flow(t_vpr_setup& vpr_setup, const t_arch& arch); //Perform, load or skip the routing stage
+
+RouteStatus vpr_multi_seed_flow(t_vpr_setup& vpr_setup, const t_arch& arch); //Place and route each seed, and keep the best result
 RouteStatus vpr_route_fixed_W(t_vpr_setup& vpr_setup,
                               const t_arch& arch,
                               int fixed_channel_width,
@@ -21,8 +21,10 @@
 #include "router_lookahead.h"
 #include "place_macro.h"
 #include "compressed_grid.h"
+#include "place_delay_model.h"
 
 #include "rr_graph_obj.h"
+#include "rr_gsb.h"
 
 //A Context is collection of state relating to a particular part of VPR
 //
@@ -138,6 +140,14 @@ struct DeviceContext : public Context {
      * physical tiles to logical blocks mapping */
     bool has_multiple_equivalent_tiles;
 
+    /* Routing resource graphs of the logic block types (in all their modes),
+     * indexed by logical block type, which are built along the pb_graphs.
+     * The packer routes the clusters on them, and OpenFPGA derives
+     * the graphs of the physical modes from them.
+     * Owned by t_vpr_setup (see PackerRRGraph)
+     */
+    const std::vector<t_lb_type_rr_node>* lb_type_rr_graphs = nullptr;
+
     /*******************************************************************
      * Routing related
      ********************************************************************/
@@ -153,6 +163,13 @@ struct DeviceContext : public Context {
      */
     std::map<RRNodeId, std::vector<size_t>> rr_node_track_ids;
 
+    /* General Switch Blocks (GSBs) found when building the edges of a
+     * tileable routing resource graph, indexed by x * (grid.height() - 1) + y.
+     * OpenFPGA reuses them to annotate the GSBs of the device.
+     * Empty if the rr_graph is not built by the tileable builder
+     */
+    std::vector<openfpga::RRGSB> rr_gsbs;
+
     /* Structures to define the routing architecture of the FPGA.           */
     std::vector<t_rr_node> rr_nodes; /* autogenerated in build_rr_graph */
 
@@ -185,6 +202,13 @@ struct DeviceContext : public Context {
     //      a single value
     RRNodeId virtual_clock_network_root_idx;
 
+    // Paths through the clock networks, from each node connected to virtual_clock_network_root_idx
+    // key:     entry node of the clock networks
+    // value:   for each node reachable from the entry node through the clock networks, the edge
+    //          by which the path from the entry node reaches it
+    // See route_clock_templates.h
+    std::unordered_map<RRNodeId, std::unordered_map<RRNodeId, RREdgeId>> clock_route_templates;
+
     /** Attributes for each rr_node.
      * key:     rr_node index
      * value:   map of <attribute_name, attribute_value>
@@ -222,6 +246,15 @@ struct DeviceContext : public Context {
     // Name of rrgraph file read (if any).
     // Used to determine when reading rrgraph if file is already loaded.
     std::string read_rr_graph_filename;
+
+    // Architecture (SHA256 digest), device grid size, graph type and wire to ipin switch
+    // of the current rr graph.
+    // Used by '--reuse_device' to determine whether a later invocation can keep the rr graph.
+    std::string rr_graph_architecture_id;
+    size_t rr_graph_grid_width = 0;
+    size_t rr_graph_grid_height = 0;
+    int rr_graph_type = -1;
+    int rr_graph_wire_to_ipin_switch = -1;
 };
 
 //State relating to power analysis
@@ -280,6 +313,13 @@ struct PlacementContext : public Context {
 
     //SHA256 digest of the .place file (used for unique identification and consistency checking)
     std::string placement_id;
+
+    // Cache for the placement delay model, so that later placements on the same
+    // rr graph (e.g. another invocation with '--reuse_device on') skip computing it.
+    // The cached model is owned here, the placer only holds a pointer to it.
+    //
+    // Cache key: (checksum of the rr graph and delay model options, read delay model file (if any)).
+    vtr::Cache<std::tuple<uint64_t, std::string>, PlaceDelayModel> cached_place_delay_model_;
 };
 
 //State relating to routing
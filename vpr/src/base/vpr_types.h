@@ -116,6 +116,12 @@ enum class e_route_bb_update {
     DYNAMIC //Rotuer net bounding boxes are updated
 };
 
+enum class e_check_route_option {
+    OFF,   //The routing is not checked
+    QUICK, //The connectivity of each net is checked
+    FULL   //The non-configurable sets and the stubs of each net are checked as well
+};
+
 enum class e_const_gen_inference {
     NONE,    //No constant generator inference
     COMB,    //Only combinational constant generator inference
@@ -658,6 +664,7 @@ struct t_file_name_opts {
     std::string CmosTechFile;
     std::string out_file_prefix;
     bool verify_file_digests;
+    bool net_file_cache;
 };
 
 /* Options for netlist loading */
@@ -757,6 +764,25 @@ enum e_place_algorithm {
     PATH_TIMING_DRIVEN_PLACE
 };
 
+//Metric selecting the best result of the seeds of a multi-seed run
+enum class e_seeds_metric {
+    CRITICAL_PATH, //Smallest critical path delay (the wirelength without timing analysis)
+    WIRELENGTH,    //Smallest routed wirelength
+    CHANNEL_WIDTH  //Smallest channel width, then smallest routed wirelength
+};
+
+enum class e_place_init_type {
+    RANDOM,  //Blocks are placed at random legal locations
+    ANALYTIC //Random placement improved by a (legalized) quadratic wirelength placement
+};
+
+enum class e_place_move_generator {
+    UNIFORM,  //Blocks are moved to random locations within the range limit
+    MEDIAN,   //Blocks are moved to the median of the bounding boxes of their nets
+    CRITICAL, //Blocks of critical connections are moved to the criticality weighted centroid of their connections
+    ADAPTIVE  //The above move generators are picked by their acceptance rate per second of placement
+};
+
 enum class PlaceDelayModelType {
     DELTA,          //Delta x/y based delay model
     DELTA_OVERRIDE, //Delta x/y based delay model with special case delay overrides
@@ -790,10 +816,16 @@ struct t_placer_opts {
     int inner_loop_recompute_divider;
     float td_place_exp_first;
     int seed;
+    int num_seeds;                //Number of seeds placed and routed in this process, starting at seed
+    e_seeds_metric seeds_metric;  //Metric selecting the best result of the seeds
     float td_place_exp_last;
     e_stage_action doPlacement;
     float rlim_escape_fraction;
     std::string move_stats_file;
+    std::string anneal_stats_file; //CSV file of the move outcomes per move type and temperature
+    bool parallel_placement; //Evaluate the moves of disjoint regions of the device in parallel
+    e_place_init_type place_init_type;
+    e_place_move_generator move_generator;
 
     PlaceDelayModelType delay_model_type;
     e_reducer delay_model_reducer;
@@ -938,11 +970,20 @@ struct t_router_opts {
     enum e_routing_failure_predictor routing_failure_predictor;
     enum e_routing_budgets_algorithm routing_budgets_algorithm;
     bool save_routing_per_iteration;
+    std::string iteration_stats_file; //CSV file of the router statistics per routing iteration
+    std::string net_stats_file;       //CSV file of the router statistics per routed net
+    std::string congestion_stats_prefix; //Prefix of the CSV files of the routing congestion per routing iteration
     float congested_routing_iteration_threshold_frac;
     e_route_bb_update route_bb_update;
+    e_check_route_option check_route;
     enum e_clock_modeling clock_modeling; //How clock pins and nets should be handled
     bool two_stage_clock_routing;         //How clock nets on dedicated networks should be routed
+    bool clock_route_templates;           //Connect the clock net sinks along the precomputed clock network paths
     int high_fanout_threshold;
+    bool parallel_routing; //Route nets of disjoint regions of the device in parallel (timing-driven router)
+    bool warm_start;       //Start each routing attempt from the legal nets of the previous attempt (timing-driven router)
+    bool trunk_global_nets; //Route high fanout global nets as a trunk, using the spatial route tree lookup (timing-driven router)
+    bool adaptive_pres_fac; //Adapt the congestion schedule to the predicted overuse trend (timing-driven router)
     int router_debug_net;
     int router_debug_sink_rr;
     e_router_lookahead lookahead_type;
@@ -963,6 +1004,7 @@ struct t_analysis_opts {
     int timing_report_npaths;
     e_timing_report_detail timing_report_detail;
     bool timing_report_skew;
+    bool timing_report_compress;
 };
 
 /* Defines the detailed routing architecture of the FPGA.  Only important   *
@@ -996,6 +1038,8 @@ struct t_analysis_opts {
  * read_rr_graph_filename: File to read the RR graph from (overrides        *
  *                         architecture)                                    *
  * write_rr_graph_filename: File to write the RR graph to after generation  *
+ * rr_graph_cache_dir: Directory to cache the tileable RR graphs which are  *
+ *                     built (empty to disable the cache)                   *
  *                                                                          */
 
 struct t_det_routing_arch {
@@ -1023,6 +1067,7 @@ struct t_det_routing_arch {
 
     std::string read_rr_graph_filename;
     std::string write_rr_graph_filename;
+    std::string rr_graph_cache_dir;
 };
 
 
@@ -1279,6 +1324,7 @@ struct t_vpr_setup {
     e_clock_modeling clock_modeling;           //How clocks should be handled
     bool two_stage_clock_routing;              //How clocks should be routed in the presence of a dedicated clock network
     bool exit_before_pack;                     //Exits early before starting packing (useful for collecting statistics without running/loading any stages)
+    bool reuse_device;                         //Reuses the architecture and rr graph of a previous invocation in the same process if unchanged
 };
 
 class RouteStatus {
@@ -1,142 +1,149 @@
-#include <map>
+#include <algorithm>
+#include <vector>
 
+#if defined(VPR_USE_TBB)
+#    include <tbb/enumerable_thread_specific.h>
+#    include <tbb/parallel_for.h>
+#endif
+
+#include "vtr_assert.h"
 #include "vtr_log.h"
 
 #include "check_rr_graph_obj.h"
 
+/***********************************************************************
+ * The problems found on a node by check_rr_graph_node()
+ **********************************************************************/
+enum e_rr_graph_node_problem : unsigned char {
+    RR_GRAPH_NODE_DUPLICATED_EDGES = 1 << 0,
+    RR_GRAPH_NODE_DANGLING = 1 << 1,
+    RR_GRAPH_NODE_INVALID_SOURCE = 1 << 2,
+    RR_GRAPH_NODE_INVALID_SINK = 1 << 3
+};
+
 /*********************************************************************** 
  * This function aims at checking any duplicated edges (with same EdgeId) 
  * of a given node. 
  * We will walkthrough the input edges of a node and see if there is any duplication
+ * The input edges are sorted in edges (a scratch vector) to find the duplicates
  **********************************************************************/
 static bool check_rr_graph_node_duplicated_edges(const RRGraph& rr_graph,
-                                                 const RRNodeId& node) {
-    bool no_duplication = true;
-
-    /* Create a map for each input edge */
-    std::map<RREdgeId, size_t> edge_counter;
-
-    /* Check each input edges */
+                                                 const RRNodeId& node,
+                                                 std::vector<RREdgeId>& edges) {
+    edges.clear();
     for (const auto edge : rr_graph.node_in_edges(node)) {
-        auto result = edge_counter.insert(std::pair<RREdgeId, size_t>(edge, 1));
-        if (false == result.second) {
-            result.first->second++;
-        }
+        edges.push_back(edge);
     }
+    std::sort(edges.begin(), edges.end());
 
-    for (auto& elem : edge_counter) {
-        if (elem.second > 1) {
-            /* Reach here it means we find some duplicated edges and report errors */
-            /* Print a warning! */
-            VTR_LOG_WARN("Node %d has duplicated input edges (id = %d)!\n",
-                         size_t(node), size_t(elem.first));
-            rr_graph.print_node(node);
-            no_duplication = false;
-        }
-    }
-
-    return no_duplication;
+    return edges.end() == std::adjacent_find(edges.begin(), edges.end());
 }
 
 /*********************************************************************** 
- * Check the whole Routing Resource Graph  
- * identify and report any duplicated edges between two nodes 
+ * Check a node of the Routing Resource Graph, and return its problems
+ * (as a combination of e_rr_graph_node_problem):
+ * - duplicated edges between two nodes 
+ * - dangling node (nodes without any fan-in or fan-out)
+ * - source node with fan-in or without fan-out
+ * - sink node without fan-in or with fan-out
  **********************************************************************/
-static bool check_rr_graph_duplicated_edges(const RRGraph& rr_graph) {
-    bool no_duplication = true;
-    /* For each node:
-     * Search input edges, see there are two edges with same id or address 
-     */
-    for (const auto& node : rr_graph.nodes()) {
-        if (false == check_rr_graph_node_duplicated_edges(rr_graph, node)) {
-            no_duplication = false;
-        }
+static unsigned char check_rr_graph_node(const RRGraph& rr_graph,
+                                         const RRNodeId& node,
+                                         std::vector<RREdgeId>& edges) {
+    unsigned char problems = 0;
+
+    if (false == check_rr_graph_node_duplicated_edges(rr_graph, node, edges)) {
+        problems |= RR_GRAPH_NODE_DUPLICATED_EDGES;
     }
 
-    return no_duplication;
-}
+    if ((0 == rr_graph.node_fan_in(node))
+        && (0 == rr_graph.node_fan_out(node))) {
+        problems |= RR_GRAPH_NODE_DANGLING;
+    }
 
-/*********************************************************************** 
- * Identify and report any dangling node (nodes without any fan-in or fan-out)
- * in the RRGraph
- **********************************************************************/
-static bool check_rr_graph_dangling_nodes(const RRGraph& rr_graph) {
-    bool no_dangling = true;
-    /* For each node: 
-     * check if the number of input edges and output edges are both 0
-     * If so, this is a dangling nodes and report 
-     */
-    for (auto node : rr_graph.nodes()) {
-        if ((0 == rr_graph.node_fan_in(node))
-            && (0 == rr_graph.node_fan_out(node))) {
-            /* Print a warning! */
-            VTR_LOG_WARN("Node %s is dangling (zero fan-in and zero fan-out)!\n",
-                         node);
-            VTR_LOG_WARN("Node details for debugging:\n");
-            rr_graph.print_node(node);
-            no_dangling = false;
-        }
+    if ((SOURCE == rr_graph.node_type(node))
+        && ((0 != rr_graph.node_fan_in(node))
+            || (0 == rr_graph.node_fan_out(node)))) {
+        problems |= RR_GRAPH_NODE_INVALID_SOURCE;
+    }
+
+    if ((SINK == rr_graph.node_type(node))
+        && ((0 == rr_graph.node_fan_in(node))
+            || (0 != rr_graph.node_fan_out(node)))) {
+        problems |= RR_GRAPH_NODE_INVALID_SINK;
     }
 
-    return no_dangling;
+    return problems;
 }
 
 /*********************************************************************** 
- * check if all the source nodes are in the right condition:
- * 1. zero fan-in and non-zero fanout
+ * Check all the nodes of the Routing Resource Graph 
+ * (in parallel with VPR_USE_TBB, each thread using its own scratch vector)
+ * The problems are returned for each of the nodes, so that they can be 
+ * reported in node order
  **********************************************************************/
-static bool check_rr_graph_source_nodes(const RRGraph& rr_graph) {
-    bool invalid_sources = false;
-    /* For each node: 
-     * check if the number of input edges and output edges are both 0
-     * If so, this is a dangling nodes and report 
-     */
-    for (auto node : rr_graph.nodes()) {
-        /* Pass nodes whose types are not SOURCE */
-        if (SOURCE != rr_graph.node_type(node)) {
-            continue;
-        }
-        if ((0 != rr_graph.node_fan_in(node))
-            || (0 == rr_graph.node_fan_out(node))) {
-            /* Print a warning! */
-            VTR_LOG_WARN("Source node %d is invalid (should have zero fan-in and non-zero fan-out)!\n",
-                         size_t(node));
-            VTR_LOG_WARN("Node details for debugging:\n");
-            rr_graph.print_node(node);
-            invalid_sources = true;
-        }
+static std::vector<unsigned char> check_rr_graph_nodes(const RRGraph& rr_graph,
+                                                       const std::vector<RRNodeId>& nodes) {
+    std::vector<unsigned char> node_problems(nodes.size(), 0);
+
+#if defined(VPR_USE_TBB)
+    tbb::enumerable_thread_specific<std::vector<RREdgeId>> thread_edges;
+    tbb::parallel_for(size_t(0), node_problems.size(), [&](size_t inode) {
+        node_problems[inode] = check_rr_graph_node(rr_graph, nodes[inode], thread_edges.local());
+    });
+#else
+    std::vector<RREdgeId> edges;
+    for (size_t inode = 0; inode < node_problems.size(); ++inode) {
+        node_problems[inode] = check_rr_graph_node(rr_graph, nodes[inode], edges);
     }
+#endif
 
-    return !invalid_sources;
+    return node_problems;
 }
 
 /*********************************************************************** 
- * check if all the sink nodes are in the right condition:
- * 1. non-zero fan-in and zero fanout
+ * Report the nodes with the given problem
+ * Return true if no node has the problem
  **********************************************************************/
-static bool check_rr_graph_sink_nodes(const RRGraph& rr_graph) {
-    bool invalid_sinks = false;
-    /* For each node: 
-     * check if the number of input edges and output edges are both 0
-     * If so, this is a dangling nodes and report 
-     */
-    for (auto node : rr_graph.nodes()) {
-        /* Pass nodes whose types are not SINK */
-        if (SINK != rr_graph.node_type(node)) {
+static bool report_rr_graph_node_problem(const RRGraph& rr_graph,
+                                         const std::vector<RRNodeId>& nodes,
+                                         const std::vector<unsigned char>& node_problems,
+                                         const e_rr_graph_node_problem& problem) {
+    bool no_problem = true;
+
+    for (size_t inode = 0; inode < node_problems.size(); ++inode) {
+        if (0 == (node_problems[inode] & problem)) {
             continue;
         }
-        if ((0 == rr_graph.node_fan_in(node))
-            || (0 != rr_graph.node_fan_out(node))) {
-            /* Print a warning! */
-            VTR_LOG_WARN("Sink node %s is invalid (should have non-zero fan-in and zero fan-out)!\n",
-                         node);
-            VTR_LOG_WARN("Node details for debugging:\n");
-            rr_graph.print_node(node);
-            invalid_sinks = true;
+        /* Print a warning! */
+        switch (problem) {
+            case RR_GRAPH_NODE_DUPLICATED_EDGES:
+                VTR_LOG_WARN("Node %lu has duplicated input edges!\n",
+                             size_t(nodes[inode]));
+                break;
+            case RR_GRAPH_NODE_DANGLING:
+                VTR_LOG_WARN("Node %lu is dangling (zero fan-in and zero fan-out)!\n",
+                             size_t(nodes[inode]));
+                VTR_LOG_WARN("Node details for debugging:\n");
+                break;
+            case RR_GRAPH_NODE_INVALID_SOURCE:
+                VTR_LOG_WARN("Source node %lu is invalid (should have zero fan-in and non-zero fan-out)!\n",
+                             size_t(nodes[inode]));
+                VTR_LOG_WARN("Node details for debugging:\n");
+                break;
+            case RR_GRAPH_NODE_INVALID_SINK:
+                VTR_LOG_WARN("Sink node %lu is invalid (should have non-zero fan-in and zero fan-out)!\n",
+                             size_t(nodes[inode]));
+                VTR_LOG_WARN("Node details for debugging:\n");
+                break;
+            default:
+                VTR_ASSERT_MSG(false, "Unknown problem of rr_graph node");
         }
+        rr_graph.print_node(nodes[inode]);
+        no_problem = false;
     }
 
-    return !invalid_sinks;
+    return no_problem;
 }
 
 /*********************************************************************** 
@@ -155,32 +162,25 @@ static bool check_rr_graph_sink_nodes(const RRGraph& rr_graph) {
 bool check_rr_graph(const RRGraph& rr_graph) {
     size_t num_err = 0;
 
-    if (false == check_rr_graph_duplicated_edges(rr_graph)) {
+    std::vector<RRNodeId> nodes(rr_graph.nodes().begin(), rr_graph.nodes().end());
+    std::vector<unsigned char> node_problems = check_rr_graph_nodes(rr_graph, nodes);
+
+    if (false == report_rr_graph_node_problem(rr_graph, nodes, node_problems, RR_GRAPH_NODE_DUPLICATED_EDGES)) {
         VTR_LOG_WARN("Fail in checking duplicated edges !\n");
         num_err++;
     }
 
-    if (false == check_rr_graph_dangling_nodes(rr_graph)) {
+    if (false == report_rr_graph_node_problem(rr_graph, nodes, node_problems, RR_GRAPH_NODE_DANGLING)) {
         VTR_LOG_WARN("Fail in checking dangling nodes !\n");
         num_err++;
     }
 
-    if (false == check_rr_graph_source_nodes(rr_graph)) {
-        VTR_LOG_WARN("Fail in checking source nodes!\n");
-        num_err++;
-    }
-
-    if (false == check_rr_graph_sink_nodes(rr_graph)) {
-        VTR_LOG_WARN("Fail in checking sink nodes!\n");
-        num_err++;
-    }
-
-    if (false == check_rr_graph_source_nodes(rr_graph)) {
+    if (false == report_rr_graph_node_problem(rr_graph, nodes, node_problems, RR_GRAPH_NODE_INVALID_SOURCE)) {
         VTR_LOG_WARN("Fail in checking source nodes!\n");
         num_err++;
     }
 
-    if (false == check_rr_graph_sink_nodes(rr_graph)) {
+    if (false == report_rr_graph_node_problem(rr_graph, nodes, node_problems, RR_GRAPH_NODE_INVALID_SINK)) {
         VTR_LOG_WARN("Fail in checking sink nodes!\n");
         num_err++;
     }
@@ -0,0 +1,349 @@
+/*********************************************************************
+ * This file defines the loading function of rr graph in binary format,
+ * as written by write_binary_rr_graph_obj().
+ * The file is mapped into memory and the lists of nodes and edges are 
+ * read in place, which is much faster than parsing the XML format.
+ * The post-processing follows load_rr_file() in rr_graph_reader.cpp
+ ********************************************************************/
+#include <limits>
+
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+#include "vpr_error.h"
+#include "globals.h"
+#include "rr_node.h"
+#include "rr_graph.h"
+#include "rr_graph_indexed_data.h"
+#include "check_rr_graph.h"
+#include "check_rr_graph_obj.h"
+#include "rr_graph_obj.h"
+#include "read_binary_rr_graph_obj.h"
+
+#ifdef VTR_ENABLE_CAPNPROTO
+#    include "capnp/serialize.h"
+#    include "rr_graph_obj.capnp.h"
+#    include "mmap_file.h"
+#endif /* VTR_ENABLE_CAPNPROTO */
+
+#ifndef VTR_ENABLE_CAPNPROTO
+
+#    define DISABLE_ERROR                               \
+        "is disable because VTR_ENABLE_CAPNPROTO=OFF. " \
+        "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable."
+
+void load_binary_rr_file(const t_graph_type /*graph_type*/,
+                         const DeviceGrid& /*grid*/,
+                         const std::vector<t_segment_inf>& /*segment_inf*/,
+                         const enum e_base_cost_type /*base_cost_type*/,
+                         int* /*wire_to_rr_ipin_switch*/,
+                         const char* /*read_rr_graph_name*/) {
+    VPR_THROW(VPR_ERROR_ROUTE, "Reading the binary rr_graph " DISABLE_ERROR);
+}
+
+#else /* VTR_ENABLE_CAPNPROTO */
+
+/************************ Subroutine definitions ****************************/
+static 
+void read_binary_rr_channels(VprRRChannels::Reader channels,
+                             t_chan_width& chan_width) {
+    chan_width.max = channels.getMax();
+    chan_width.x_max = channels.getXMax();
+    chan_width.y_max = channels.getYMax();
+    chan_width.x_min = channels.getXMin();
+    chan_width.y_min = channels.getYMin();
+
+    auto x_list = channels.getXList();
+    chan_width.x_list.resize(x_list.size());
+    for (size_t i = 0; i < x_list.size(); ++i) {
+        chan_width.x_list[i] = x_list[i];
+    }
+    auto y_list = channels.getYList();
+    chan_width.y_list.resize(y_list.size());
+    for (size_t i = 0; i < y_list.size(); ++i) {
+        chan_width.y_list[i] = y_list[i];
+    }
+}
+
+/* Reads in the switch information and adds it to device_ctx.rr_switch_inf
+ * as well as the local switches of RRGraph */
+static 
+void read_binary_rr_switches(::capnp::List<VprRRSwitch>::Reader switches) {
+    auto& device_ctx = g_vpr_ctx.mutable_device();
+
+    device_ctx.rr_switch_inf.resize(switches.size());
+    for (size_t iswitch = 0; iswitch < switches.size(); ++iswitch) {
+        auto sw = switches[iswitch];
+        auto& rr_switch = device_ctx.rr_switch_inf[iswitch];
+
+        /* Switch names point to the names of architecture switches */
+        const char* name = nullptr;
+        if (sw.hasName()) {
+            std::string switch_name = sw.getName().cStr();
+            for (int i = 0; i < device_ctx.num_arch_switches; ++i) {
+                if (switch_name == device_ctx.arch_switch_inf[i].name) {
+                    name = device_ctx.arch_switch_inf[i].name;
+                    break;
+                }
+            }
+            if (nullptr == name) {
+                VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Switch name '%s' not found in architecture\n", switch_name.c_str());
+            }
+        }
+        rr_switch.name = name;
+
+        if (sw.getType() >= uint8_t(SwitchType::INVALID)) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Invalid type of switch %lu\n", iswitch);
+        }
+        rr_switch.set_type(SwitchType(sw.getType()));
+        rr_switch.R = sw.getR();
+        rr_switch.Cin = sw.getCin();
+        rr_switch.Cout = sw.getCout();
+        rr_switch.Cinternal = sw.getCinternal();
+        rr_switch.Tdel = sw.getTdel();
+        rr_switch.mux_trans_size = sw.getMuxTransSize();
+        rr_switch.buf_size = sw.getBufSize();
+        rr_switch.power_buffer_type = e_power_buffer_type(sw.getPowerBufferType());
+        rr_switch.power_buffer_size = sw.getPowerBufferSize();
+    }
+
+    device_ctx.rr_graph.reserve_switches(device_ctx.rr_switch_inf.size());
+    for (size_t iswitch = 0; iswitch < device_ctx.rr_switch_inf.size(); ++iswitch) {
+        device_ctx.rr_graph.create_switch(device_ctx.rr_switch_inf[iswitch]);
+    }
+}
+
+static 
+void read_binary_rr_nodes(VprRRNodes::Reader nodes,
+                          const std::vector<t_segment_inf>& segment_inf) {
+    auto& device_ctx = g_vpr_ctx.mutable_device();
+    RRGraph& rr_graph = device_ctx.rr_graph;
+
+    auto types = nodes.getTypes();
+    auto directions = nodes.getDirections();
+    auto sides = nodes.getSides();
+    auto xlows = nodes.getXlows();
+    auto ylows = nodes.getYlows();
+    auto xhighs = nodes.getXhighs();
+    auto yhighs = nodes.getYhighs();
+    auto capacities = nodes.getCapacities();
+    auto ptc_nums = nodes.getPtcNums();
+    auto cost_indices = nodes.getCostIndices();
+    auto rs = nodes.getRs();
+    auto cs = nodes.getCs();
+    auto segments = nodes.getSegments();
+
+    size_t num_nodes = types.size();
+    if ((directions.size() != num_nodes) || (sides.size() != num_nodes)
+        || (xlows.size() != num_nodes) || (ylows.size() != num_nodes)
+        || (xhighs.size() != num_nodes) || (yhighs.size() != num_nodes)
+        || (capacities.size() != num_nodes) || (ptc_nums.size() != num_nodes)
+        || (cost_indices.size() != num_nodes) || (rs.size() != num_nodes)
+        || (cs.size() != num_nodes) || (segments.size() != num_nodes)) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Inconsistent sizes of node lists in binary rr_graph\n");
+    }
+
+    /* Routing segments are created in the same order as the architecture */
+    rr_graph.reserve_segments(segment_inf.size());
+    for (const t_segment_inf& segment : segment_inf) {
+        rr_graph.create_segment(segment);
+    }
+
+    rr_graph.reserve_nodes(num_nodes);
+    for (size_t inode = 0; inode < num_nodes; ++inode) {
+        if (types[inode] >= NUM_RR_TYPES) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Invalid type of node %lu\n", inode);
+        }
+        t_rr_type node_type = t_rr_type(types[inode]);
+        const RRNodeId& node = rr_graph.create_node(node_type);
+        VTR_ASSERT(size_t(node) == inode);
+
+        if ((CHANX == node_type) || (CHANY == node_type)) {
+            rr_graph.set_node_direction(node, e_direction(directions[inode]));
+            int segment = segments[inode];
+            if ((0 <= segment) && (size_t(segment) < segment_inf.size())) {
+                rr_graph.set_node_segment(node, RRSegmentId(segment));
+            }
+        }
+        if ((IPIN == node_type) || (OPIN == node_type)) {
+            rr_graph.set_node_side(node, e_side(sides[inode]));
+        }
+        rr_graph.set_node_capacity(node, capacities[inode]);
+        rr_graph.set_node_bounding_box(node, vtr::Rect<short>(xlows[inode], ylows[inode], xhighs[inode], yhighs[inode]));
+        rr_graph.set_node_ptc_num(node, ptc_nums[inode]);
+        rr_graph.set_node_cost_index(node, cost_indices[inode]);
+        rr_graph.set_node_R(node, rs[inode]);
+        rr_graph.set_node_C(node, cs[inode]);
+        rr_graph.set_node_rc_data_index(node, find_create_rr_rc_data(rs[inode], cs[inode]));
+    }
+
+    /* Restore the track ids which vary along routing tracks */
+    for (auto entry : nodes.getTrackIds()) {
+        RRNodeId node = RRNodeId(entry.getNode());
+        if ((false == rr_graph.valid_node_id(node))
+            || ((CHANX != rr_graph.node_type(node)) && (CHANY != rr_graph.node_type(node)))
+            || (entry.getIds().size() != size_t(rr_graph.node_length(node)) + 1)) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Invalid track ids of node %u\n", entry.getNode());
+        }
+        auto ids = entry.getIds();
+        for (size_t offset = 0; offset < ids.size(); ++offset) {
+            vtr::Point<size_t> node_offset(rr_graph.node_xlow(node), rr_graph.node_ylow(node));
+            if (CHANX == rr_graph.node_type(node)) {
+                node_offset.set_x(node_offset.x() + offset);
+            } else {
+                node_offset.set_y(node_offset.y() + offset);
+            }
+            rr_graph.add_node_track_num(node, node_offset, ids[offset]);
+        }
+    }
+}
+
+/* Loads the edges and finds the most frequent switch connecting a wire to an ipin.
+ * Nodes and switches must be loaded before calling this function */
+static 
+void read_binary_rr_edges(VprRREdges::Reader edges,
+                          int* wire_to_rr_ipin_switch) {
+    auto& device_ctx = g_vpr_ctx.mutable_device();
+    RRGraph& rr_graph = device_ctx.rr_graph;
+
+    auto src_nodes = edges.getSrcNodes();
+    auto sink_nodes = edges.getSinkNodes();
+    auto switches = edges.getSwitches();
+
+    size_t num_edges = src_nodes.size();
+    if ((sink_nodes.size() != num_edges) || (switches.size() != num_edges)) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Inconsistent sizes of edge lists in binary rr_graph\n");
+    }
+
+    size_t num_nodes = rr_graph.nodes().size();
+    size_t num_switches = rr_graph.switches().size();
+
+    std::vector<int> count_for_wire_to_ipin_switches(num_switches, 0);
+    //first is index, second is count
+    std::pair<int, int> most_frequent_switch(-1, 0);
+
+    rr_graph.reserve_edges(num_edges);
+    for (size_t iedge = 0; iedge < num_edges; ++iedge) {
+        if ((src_nodes[iedge] >= num_nodes) || (sink_nodes[iedge] >= num_nodes)) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                            "Edge %lu connects nodes out of range (%lu nodes)\n",
+                            iedge, num_nodes);
+        }
+        if (switches[iedge] >= num_switches) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                            "Edge %lu uses switch_id %u larger than num_rr_switches %lu\n",
+                            iedge, switches[iedge], num_switches);
+        }
+        RRNodeId src_node = RRNodeId(src_nodes[iedge]);
+        RRNodeId sink_node = RRNodeId(sink_nodes[iedge]);
+        int switch_id = switches[iedge];
+
+        if (((CHANX == rr_graph.node_type(src_node)) || (CHANY == rr_graph.node_type(src_node)))
+            && (IPIN == rr_graph.node_type(sink_node))) {
+            count_for_wire_to_ipin_switches[switch_id]++;
+            if (count_for_wire_to_ipin_switches[switch_id] > most_frequent_switch.second) {
+                most_frequent_switch.first = switch_id;
+                most_frequent_switch.second = count_for_wire_to_ipin_switches[switch_id];
+            }
+        }
+        rr_graph.create_edge(src_node, sink_node, RRSwitchId(switch_id));
+    }
+    *wire_to_rr_ipin_switch = most_frequent_switch.first;
+}
+
+/************************ Top-level function ****************************/
+/* Loads the given binary RR_graph file into the appropriate data structures
+ * as specified by read_rr_graph_name. Set up correct routing data
+ * structures as well */
+void load_binary_rr_file(const t_graph_type graph_type,
+                         const DeviceGrid& grid,
+                         const std::vector<t_segment_inf>& segment_inf,
+                         const enum e_base_cost_type base_cost_type,
+                         int* wire_to_rr_ipin_switch,
+                         const char* read_rr_graph_name) {
+    vtr::ScopedStartFinishTimer timer("Loading binary routing resource graph");
+
+    auto& device_ctx = g_vpr_ctx.mutable_device();
+
+    // MmapFile object keeps the file mapped while the reader accesses it
+    MmapFile f(read_rr_graph_name);
+    ::capnp::ReaderOptions opts = ::capnp::ReaderOptions();
+    /* The lists of a large rr_graph easily exceed the default limit of traversal */
+    opts.traversalLimitInWords = std::numeric_limits<uint64_t>::max();
+    ::capnp::FlatArrayMessageReader reader(f.getData(), opts);
+
+    auto graph = reader.getRoot<VprRRGraph>();
+
+    //Compare with the architecture file to ensure consistency
+    if ((graph.getGridWidth() != grid.width()) || (graph.getGridHeight() != grid.height())) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                        "Grid size (%u x %u) of binary rr_graph does not match the device grid (%lu x %lu)\n",
+                        graph.getGridWidth(), graph.getGridHeight(), grid.width(), grid.height());
+    }
+    if (graph.getNumSegments() != segment_inf.size()) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                        "Number of segments (%u) of binary rr_graph does not match the architecture (%lu)\n",
+                        graph.getNumSegments(), segment_inf.size());
+    }
+
+    t_chan_width nodes_per_chan;
+    read_binary_rr_channels(graph.getChannels(), nodes_per_chan);
+
+    /* Global routing uses a single longwire track */
+    bool is_global_graph = (GRAPH_GLOBAL == graph_type ? true : false);
+    int max_chan_width = (is_global_graph ? 1 : nodes_per_chan.max);
+    VTR_ASSERT(max_chan_width > 0);
+
+    read_binary_rr_nodes(graph.getNodes(), segment_inf);
+    read_binary_rr_switches(graph.getSwitches());
+    read_binary_rr_edges(graph.getEdges(), wire_to_rr_ipin_switch);
+
+    //Partition the rr graph edges for efficient access to configurable/non-configurable
+    //edge subsets. Must be done after RR switches have been allocated
+    device_ctx.rr_graph.rebuild_node_edges();
+
+    /* Essential check for rr_graph, build look-up */
+    if (false == device_ctx.rr_graph.validate()) {
+        /* Error out if built-in validator of rr_graph fails */
+        vpr_throw(VPR_ERROR_ROUTE,
+                  __FILE__,
+                  __LINE__,
+                  "Fundamental errors occurred when validating rr_graph object!\n");
+    }
+
+    alloc_and_load_rr_indexed_data(segment_inf, device_ctx.rr_graph,
+                                   max_chan_width, *wire_to_rr_ipin_switch, base_cost_type);
+
+    /* Segment ids of the cost indices of routing tracks, -1 for other nodes */
+    for (const RRNodeId& node : device_ctx.rr_graph.nodes()) {
+        /* The cost indices come from the file, so they may not match the indexed data */
+        short cost_index = device_ctx.rr_graph.node_cost_index(node);
+        if ((0 > cost_index) || (size_t(cost_index) >= device_ctx.rr_indexed_data.size())) {
+            vpr_throw(VPR_ERROR_ROUTE, read_rr_graph_name, 0,
+                      "Invalid cost index %d of node %lu in binary rr_graph, which should be in [0, %lu)\n",
+                      cost_index, size_t(node), device_ctx.rr_indexed_data.size());
+        }
+
+        int seg_id = -1;
+        if (true == device_ctx.rr_graph.valid_segment_id(device_ctx.rr_graph.node_segment(node))) {
+            seg_id = size_t(device_ctx.rr_graph.node_segment(node));
+        }
+        device_ctx.rr_indexed_data[cost_index].seg_index = seg_id;
+    }
+
+    device_ctx.chan_width = nodes_per_chan;
+    device_ctx.read_rr_graph_filename = std::string(read_rr_graph_name);
+
+    check_rr_graph(graph_type, grid, device_ctx.physical_tile_types);
+    /* Error out if advanced checker of rr_graph fails */
+    if (false == check_rr_graph(device_ctx.rr_graph)) {
+        vpr_throw(VPR_ERROR_ROUTE,
+                  __FILE__,
+                  __LINE__,
+                  "Advanced checking rr_graph object fails! Routing may still work "
+                  "but not smooth\n");
+    }
+}
+
+#endif /* VTR_ENABLE_CAPNPROTO */
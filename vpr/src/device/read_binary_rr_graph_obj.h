@@ -0,0 +1,21 @@
+/*********************************************************************
+ * This function loads an rr graph written in the binary format 
+ * (see write_binary_rr_graph_obj.h) into vpr
+ ********************************************************************/
+
+#ifndef READ_BINARY_RR_GRAPH_OBJ_H
+#define READ_BINARY_RR_GRAPH_OBJ_H
+
+#include <vector>
+#include "device_grid.h"
+#include "vpr_types.h"
+#include "rr_graph.h"
+
+void load_binary_rr_file(const t_graph_type graph_type,
+                         const DeviceGrid& grid,
+                         const std::vector<t_segment_inf>& segment_inf,
+                         const enum e_base_cost_type base_cost_type,
+                         int* wire_to_rr_ipin_switch,
+                         const char* read_rr_graph_name);
+
+#endif
@@ -4,6 +4,7 @@
  ***********************************************************************/
 #include <cmath>
 #include <algorithm>
+#include <array>
 #include <map>
 #include <limits>
 
@@ -15,6 +16,33 @@
 #include "rr_graph_obj.h"
 #include "rr_graph_obj_utils.h"
 
+/********************************************************************
+ * Type, direction and side of a node are packed in one byte:
+ *
+ *   bit   7   6   5   4   3   2   1   0
+ *       +-----------+-------+-----------+
+ *       |    side   |  dir  |   type    |
+ *       +-----------+-------+-----------+
+ *
+ * which is enough for all the values, including NUM_SIDES as an unset side
+ *******************************************************************/
+constexpr uint8_t NODE_TYPE_MASK = 0x07;
+constexpr uint8_t NODE_DIRECTION_SHIFT = 3;
+constexpr uint8_t NODE_DIRECTION_MASK = 0x03;
+constexpr uint8_t NODE_SIDE_SHIFT = 5;
+constexpr uint8_t NODE_SIDE_MASK = 0x07;
+
+static_assert(NUM_RR_TYPES <= NODE_TYPE_MASK + 1, "Node types do not fit the packed bits");
+static_assert(NUM_DIRECTIONS <= NODE_DIRECTION_MASK + 2, "Node directions do not fit the packed bits");
+static_assert(NUM_SIDES <= NODE_SIDE_MASK, "Node sides do not fit the packed bits");
+
+static 
+uint8_t pack_node_types(const t_rr_type& type, const e_direction& direction, const e_side& side) {
+    return uint8_t(type) 
+         | (uint8_t(direction) << NODE_DIRECTION_SHIFT)
+         | (uint8_t(side) << NODE_SIDE_SHIFT);
+}
+
 /********************************************************************
  * Constructors
  *******************************************************************/
@@ -45,10 +73,53 @@ RRGraph::segment_range RRGraph::segments() const {
     return vtr::make_range(segment_ids_.begin(), segment_ids_.end());
 }
 
+//Returns the heap memory of a vector, without the memory owned by its elements
+template<typename T>
+static size_t vector_footprint(const T& values) {
+    return values.capacity() * sizeof(typename T::value_type);
+}
+
+size_t RRGraph::memory_footprint() const {
+    //Hash nodes carry a pointer to the next node and a cached hash
+    constexpr size_t hash_node_overhead = 2 * sizeof(void*);
+
+    size_t footprint = sizeof(RRGraph);
+    footprint += vector_footprint(node_packed_types_);
+    footprint += vector_footprint(node_bounding_boxes_);
+    footprint += vector_footprint(node_capacities_);
+    footprint += vector_footprint(node_ptc_nums_);
+    footprint += vector_footprint(node_cost_indices_);
+    footprint += vector_footprint(node_Rs_);
+    footprint += vector_footprint(node_Cs_);
+    footprint += vector_footprint(node_rc_data_indices_);
+    footprint += vector_footprint(node_segments_);
+    footprint += vector_footprint(node_num_in_edges_);
+    footprint += vector_footprint(node_num_out_edges_);
+    footprint += vector_footprint(node_num_non_configurable_in_edges_);
+    footprint += vector_footprint(node_num_non_configurable_out_edges_);
+    footprint += vector_footprint(node_edge_offsets_);
+    footprint += vector_footprint(node_edges_);
+    footprint += vector_footprint(edge_src_nodes_);
+    footprint += vector_footprint(edge_sink_nodes_);
+    footprint += vector_footprint(edge_switches_);
+    footprint += vector_footprint(switch_ids_);
+    footprint += vector_footprint(switches_);
+    footprint += vector_footprint(segment_ids_);
+    footprint += vector_footprint(segments_);
+    footprint += vector_footprint(node_lookup_offsets_);
+    footprint += vector_footprint(node_lookup_);
+
+    footprint += (invalid_node_ids_.size() + invalid_edge_ids_.size()) * (sizeof(size_t) + hash_node_overhead);
+    for (const auto& track_ids : node_track_ids_) {
+        footprint += sizeof(track_ids) + hash_node_overhead + vector_footprint(track_ids.second);
+    }
+    return footprint;
+}
+
 //Node attributes
 t_rr_type RRGraph::node_type(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
-    return node_types_[node];
+    return t_rr_type(node_packed_types_[node] & NODE_TYPE_MASK);
 }
 
 size_t RRGraph::node_index(const RRNodeId& node) const {
@@ -145,7 +216,7 @@ short RRGraph::node_capacity(const RRNodeId& node) const {
 
 short RRGraph::node_ptc_num(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
-    return node_ptc_nums_[node][0];
+    return node_ptc_nums_[node];
 }
 
 short RRGraph::node_pin_num(const RRNodeId& node) const {
@@ -169,6 +240,18 @@ std::vector<short> RRGraph::node_track_ids(const RRNodeId& node) const {
     VTR_ASSERT_MSG(node_type(node) == CHANX || node_type(node) == CHANY,
                    "Track number valid only for CHANX/CHANY RR nodes");
     VTR_ASSERT_SAFE(valid_node_id(node));
+    auto result = node_track_ids_.find(node);
+    if (result != node_track_ids_.end()) {
+        return result->second;
+    }
+    return std::vector<short>((size_t)node_length(node) + 1, node_ptc_nums_[node]);
+}
+
+short RRGraph::node_track_id(const RRNodeId& node, const size_t& offset) const {
+    auto result = node_track_ids_.find(node);
+    if (result != node_track_ids_.end()) {
+        return result->second[offset];
+    }
     return node_ptc_nums_[node];
 }
 
@@ -180,13 +263,13 @@ short RRGraph::node_cost_index(const RRNodeId& node) const {
 e_direction RRGraph::node_direction(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
     VTR_ASSERT_MSG(node_type(node) == CHANX || node_type(node) == CHANY, "Direction valid only for CHANX/CHANY RR nodes");
-    return node_directions_[node];
+    return e_direction((node_packed_types_[node] >> NODE_DIRECTION_SHIFT) & NODE_DIRECTION_MASK);
 }
 
 e_side RRGraph::node_side(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
     VTR_ASSERT_MSG(node_type(node) == IPIN || node_type(node) == OPIN, "Side valid only for IPIN/OPIN RR nodes");
-    return node_sides_[node];
+    return e_side((node_packed_types_[node] >> NODE_SIDE_SHIFT) & NODE_SIDE_MASK);
 }
 
 /* Get the resistance of a node */
@@ -215,25 +298,30 @@ RRSegmentId RRGraph::node_segment(const RRNodeId& node) const {
     return node_segments_[node];
 }
 
+/* Get the first of the edges related to a given node in the CSR array of node edges */
+const RREdgeId* RRGraph::node_edge_begin(const RRNodeId& node) const {
+    return node_edges_.data() + node_edge_offsets_[node];
+}
+
 RRGraph::edge_range RRGraph::node_edges(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
 
-    return vtr::make_range(node_edges_[node].get(),
-                           node_edges_[node].get() + node_num_in_edges_[node] + node_num_out_edges_[node]);
+    return vtr::make_range(node_edge_begin(node),
+                           node_edge_begin(node) + node_num_in_edges_[node] + node_num_out_edges_[node]);
 }
 
 RRGraph::edge_range RRGraph::node_in_edges(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
 
-    return vtr::make_range(node_edges_[node].get(),
-                           node_edges_[node].get() + node_num_in_edges_[node]);
+    return vtr::make_range(node_edge_begin(node),
+                           node_edge_begin(node) + node_num_in_edges_[node]);
 }
 
 RRGraph::edge_range RRGraph::node_out_edges(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
 
-    return vtr::make_range((node_edges_[node].get() + node_num_in_edges_[node]),
-                           (node_edges_[node].get() + node_num_in_edges_[node]) + node_num_out_edges_[node]);
+    return vtr::make_range((node_edge_begin(node) + node_num_in_edges_[node]),
+                           (node_edge_begin(node) + node_num_in_edges_[node]) + node_num_out_edges_[node]);
 }
 
 /* Get the list of configurable edges from the input edges of a given node 
@@ -242,8 +330,8 @@ RRGraph::edge_range RRGraph::node_out_edges(const RRNodeId& node) const {
 RRGraph::edge_range RRGraph::node_configurable_in_edges(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
 
-    return vtr::make_range(node_edges_[node].get(),
-                           node_edges_[node].get() + node_num_in_edges_[node] - node_num_non_configurable_in_edges_[node]);
+    return vtr::make_range(node_edge_begin(node),
+                           node_edge_begin(node) + node_num_in_edges_[node] - node_num_non_configurable_in_edges_[node]);
 }
 
 /* Get the list of non configurable edges from the input edges of a given node 
@@ -252,8 +340,8 @@ RRGraph::edge_range RRGraph::node_configurable_in_edges(const RRNodeId& node) co
 RRGraph::edge_range RRGraph::node_non_configurable_in_edges(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
 
-    return vtr::make_range(node_edges_[node].get() + node_num_in_edges_[node] - node_num_non_configurable_in_edges_[node],
-                           node_edges_[node].get() + node_num_in_edges_[node]);
+    return vtr::make_range(node_edge_begin(node) + node_num_in_edges_[node] - node_num_non_configurable_in_edges_[node],
+                           node_edge_begin(node) + node_num_in_edges_[node]);
 }
 
 /* Get the list of configurable edges from the output edges of a given node 
@@ -262,8 +350,8 @@ RRGraph::edge_range RRGraph::node_non_configurable_in_edges(const RRNodeId& node
 RRGraph::edge_range RRGraph::node_configurable_out_edges(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
 
-    return vtr::make_range((node_edges_[node].get() + node_num_in_edges_[node]),
-                           (node_edges_[node].get() + node_num_in_edges_[node]) + node_num_out_edges_[node] - node_num_non_configurable_out_edges_[node]);
+    return vtr::make_range((node_edge_begin(node) + node_num_in_edges_[node]),
+                           (node_edge_begin(node) + node_num_in_edges_[node]) + node_num_out_edges_[node] - node_num_non_configurable_out_edges_[node]);
 }
 
 /* Get the list of non configurable edges from the output edges of a given node 
@@ -272,8 +360,8 @@ RRGraph::edge_range RRGraph::node_configurable_out_edges(const RRNodeId& node) c
 RRGraph::edge_range RRGraph::node_non_configurable_out_edges(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
 
-    return vtr::make_range((node_edges_[node].get() + node_num_in_edges_[node]) + node_num_out_edges_[node] - node_num_non_configurable_out_edges_[node],
-                           (node_edges_[node].get() + node_num_in_edges_[node]) + node_num_out_edges_[node]);
+    return vtr::make_range((node_edge_begin(node) + node_num_in_edges_[node]) + node_num_out_edges_[node] - node_num_non_configurable_out_edges_[node],
+                           (node_edge_begin(node) + node_num_in_edges_[node]) + node_num_out_edges_[node]);
 }
 
 //Edge attributes
@@ -357,53 +445,83 @@ std::vector<RREdgeId> RRGraph::find_edges(const RRNodeId& src_node, const RRNode
     return matching_edges;
 }
 
+/* Number of nodes with the same ptc_num in the fast look-up: 
+ * each side of a IPIN/OPIN (including NUM_SIDES) has a node, while other nodes are not on any side
+ */
+static 
+size_t fast_node_lookup_num_sides(const t_rr_type& type) {
+    if ((IPIN == type) || (OPIN == type)) {
+        return NUM_SIDES + 1;
+    }
+    return 1;
+}
+
+/* Find the index of a side in the fast look-up, 
+ * Return the number of sides of the node type if the side is not available 
+ */
+static 
+size_t fast_node_lookup_side_index(const t_rr_type& type, const e_side& side) {
+    if (1 == fast_node_lookup_num_sides(type)) {
+        /* Non-pin nodes are only found without a side */
+        return (NUM_SIDES == side) ? 0 : 1;
+    }
+    return std::min(size_t(side), size_t(NUM_SIDES + 1));
+}
+
 RRNodeId RRGraph::find_node(const short& x, const short& y, const t_rr_type& type, const int& ptc, const e_side& side) const {
     initialize_fast_node_lookup();
 
-    size_t itype = type;
-    size_t iside = side;
-
-    /* Check if x, y, type and ptc, side is valid */
-    if ((x < 0)                                          /* See if x is smaller than the index of first element */
-        || (size_t(x) > node_lookup_.dim_size(0) - 1) /* See if x is large than the index of last element */
-        || (0 == node_lookup_.dim_size(0))) { /* See if x is large than the index of last element */
-        /* Return a zero range! */
+    /* Check if x, y, type and ptc is valid */
+    if ((x < 0) || (size_t(x) >= node_lookup_size_.x())
+        || (y < 0) || (size_t(y) >= node_lookup_size_.y())
+        || (size_t(type) >= NUM_RR_TYPES)
+        || (ptc < 0)) {
         return RRNodeId::INVALID();
     }
 
-    /* Check if x, y, type and ptc, side is valid */
-    if ((y < 0)                                          /* See if y is smaller than the index of first element */
-        || (size_t(y) > node_lookup_.dim_size(1) - 1)  /* See if y is large than the index of last element */
-        || (0 == node_lookup_.dim_size(1))) { /* See if y is large than the index of last element */
-        /* Return a zero range! */
+    /* Check if side is valid */
+    size_t num_sides = fast_node_lookup_num_sides(type);
+    size_t iside = fast_node_lookup_side_index(type, side);
+    if (iside >= num_sides) {
         return RRNodeId::INVALID();
     }
 
-    /* Check if x, y, type and ptc, side is valid */
-    /* itype is always larger than -1, we can skip checking */
-    if ( (itype > node_lookup_.dim_size(2) - 1)  /* See if type is large than the index of last element */
-      || (0 == node_lookup_.dim_size(2))) { /* See if type is large than the index of last element */
-        /* Return a zero range! */
+    size_t group = fast_node_lookup_group(x, y, type);
+    /* See if ptc is large than the index of last element */
+    size_t index = node_lookup_offsets_[group] + size_t(ptc) * num_sides + iside;
+    if (index >= node_lookup_offsets_[group + 1]) {
         return RRNodeId::INVALID();
     }
 
-    /* Check if x, y, type and ptc, side is valid */
-    if ((ptc < 0)                                                 /* See if ptc is smaller than the index of first element */
-        || (size_t(ptc) > node_lookup_[x][y][type].size() - 1) /* See if ptc is large than the index of last element */
-        || (0 == node_lookup_[x][y][type].size())) { /* See if ptc is large than the index of last element */
-        /* Return a zero range! */
-        return RRNodeId::INVALID();
+    return node_lookup_[index];
+}
+
+std::vector<RRNodeId> RRGraph::find_nodes(const short& x, const short& y, const t_rr_type& type, const e_side& side) const {
+    initialize_fast_node_lookup();
+
+    std::vector<RRNodeId> nodes;
+
+    /* Check if x, y, type and side is valid */
+    if ((x < 0) || (size_t(x) >= node_lookup_size_.x())
+        || (y < 0) || (size_t(y) >= node_lookup_size_.y())
+        || (size_t(type) >= NUM_RR_TYPES)) {
+        return nodes;
+    }
+    size_t num_sides = fast_node_lookup_num_sides(type);
+    size_t iside = fast_node_lookup_side_index(type, side);
+    if (iside >= num_sides) {
+        return nodes;
     }
 
-    /* Check if x, y, type and ptc, side is valid */
-    /* iside is always larger than -1, we can skip checking */
-    if ((iside > node_lookup_[x][y][type][ptc].size() - 1) /* See if side is large than the index of last element */
-       || (0 == node_lookup_[x][y][type][ptc].size()) ) { /* See if side is large than the index of last element */
-        /* Return a zero range! */
-        return RRNodeId::INVALID();
+    size_t group = fast_node_lookup_group(x, y, type);
+    nodes.reserve((node_lookup_offsets_[group + 1] - node_lookup_offsets_[group]) / num_sides);
+    for (size_t index = node_lookup_offsets_[group] + iside; index < node_lookup_offsets_[group + 1]; index += num_sides) {
+        if (RRNodeId::INVALID() != node_lookup_[index]) {
+            nodes.push_back(node_lookup_[index]);
+        }
     }
 
-    return node_lookup_[x][y][itype][ptc][iside];
+    return nodes;
 }
 
 /* Find the channel width (number of tracks) of a channel [x][y] */
@@ -414,28 +532,15 @@ short RRGraph::chan_num_tracks(const short& x, const short& y, const t_rr_type&
     initialize_fast_node_lookup();
 
     /* Check if x, y, type and ptc is valid */
-    if ((x < 0)                                          /* See if x is smaller than the index of first element */
-        || (size_t(x) > node_lookup_.dim_size(0) - 1)) { /* See if x is large than the index of last element */
+    if ((x < 0) || (size_t(x) >= node_lookup_size_.x())
+        || (y < 0) || (size_t(y) >= node_lookup_size_.y())) {
         /* Return a zero range! */
         return 0;
     }
 
-    /* Check if x, y, type and ptc is valid */
-    if ((y < 0)                                          /* See if y is smaller than the index of first element */
-        || (size_t(y) > node_lookup_.dim_size(1) - 1)) { /* See if y is large than the index of last element */
-        /* Return a zero range! */
-        return 0;
-    }
+    size_t group = fast_node_lookup_group(x, y, type);
 
-    /* Check if x, y, type and ptc is valid */
-    if ((size_t(type) > node_lookup_.dim_size(2) - 1)) { /* See if type is large than the index of last element */
-        /* Return a zero range! */
-        return 0;
-    }
-
-    const auto& matching_nodes = node_lookup_[x][y][type];
-
-    return vtr::make_range(matching_nodes.begin(), matching_nodes.end()).size();
+    return node_lookup_offsets_[group + 1] - node_lookup_offsets_[group];
 }
 
 /* This function aims to print basic information about a node */
@@ -775,15 +880,13 @@ void RRGraph::clear_dirty() {
 void RRGraph::reserve_nodes(const unsigned long& num_nodes) {
     /* Reserve the full set of vectors related to nodes */
     /* Basic information */
-    this->node_types_.reserve(num_nodes);
+    this->node_packed_types_.reserve(num_nodes);
 
     this->node_bounding_boxes_.reserve(num_nodes);
 
     this->node_capacities_.reserve(num_nodes);
     this->node_ptc_nums_.reserve(num_nodes);
     this->node_cost_indices_.reserve(num_nodes);
-    this->node_directions_.reserve(num_nodes);
-    this->node_sides_.reserve(num_nodes);
     this->node_Rs_.reserve(num_nodes);
     this->node_Cs_.reserve(num_nodes);
     this->node_rc_data_indices_.reserve(num_nodes);
@@ -794,7 +897,7 @@ void RRGraph::reserve_nodes(const unsigned long& num_nodes) {
     this->node_num_out_edges_.reserve(num_nodes);
     this->node_num_non_configurable_in_edges_.reserve(num_nodes);
     this->node_num_non_configurable_out_edges_.reserve(num_nodes);
-    this->node_edges_.reserve(num_nodes);
+    this->node_edge_offsets_.reserve(num_nodes);
 }
 
 /* Reserve a list of edges */
@@ -825,21 +928,19 @@ RRNodeId RRGraph::create_node(const t_rr_type& type) {
     num_nodes_++;
 
     /* Initialize the attributes */
-    node_types_.push_back(type);
+    node_packed_types_.push_back(pack_node_types(type, NO_DIRECTION, NUM_SIDES));
 
     node_bounding_boxes_.emplace_back(-1, -1, -1, -1);
 
     node_capacities_.push_back(-1);
-    node_ptc_nums_.push_back(std::vector<short>(1, -1));
+    node_ptc_nums_.push_back(-1);
     node_cost_indices_.push_back(-1);
-    node_directions_.push_back(NO_DIRECTION);
-    node_sides_.push_back(NUM_SIDES);
     node_Rs_.push_back(0.);
     node_Cs_.push_back(0.);
     node_rc_data_indices_.push_back(-1);
     node_segments_.push_back(RRSegmentId::INVALID());
 
-    node_edges_.emplace_back(); //Initially empty
+    node_edge_offsets_.emplace_back(0); //Initially empty
 
     node_num_in_edges_.emplace_back(0);
     node_num_out_edges_.emplace_back(0);
@@ -943,14 +1044,14 @@ void RRGraph::remove_edge(const RREdgeId& edge) {
      * TODO: consider making this optional (e.g. if called from remove_node)
      */
     for (size_t i = 0; i < node_num_in_edges_[src_node]; ++i) {
-        if (node_edges_[src_node][i] == edge) {
-            node_edges_[src_node][i] = RREdgeId::INVALID();
+        if (node_edges_[node_edge_offsets_[src_node] + i] == edge) {
+            node_edges_[node_edge_offsets_[src_node] + i] = RREdgeId::INVALID();
             break;
         }
     }
     for (size_t i = node_num_in_edges_[sink_node]; i < node_num_in_edges_[sink_node] + node_num_out_edges_[sink_node]; ++i) {
-        if (node_edges_[sink_node][i] == edge) {
-            node_edges_[sink_node][i] = RREdgeId::INVALID();
+        if (node_edges_[node_edge_offsets_[sink_node] + i] == edge) {
+            node_edges_[node_edge_offsets_[sink_node] + i] = RREdgeId::INVALID();
             break;
         }
     }
@@ -964,7 +1065,7 @@ void RRGraph::remove_edge(const RREdgeId& edge) {
 void RRGraph::set_node_type(const RRNodeId& node, const t_rr_type& type) {
     VTR_ASSERT(valid_node_id(node));
 
-    node_types_[node] = type;
+    node_packed_types_[node] = (node_packed_types_[node] & ~NODE_TYPE_MASK) | uint8_t(type);
 }
 
 void RRGraph::set_node_xlow(const RRNodeId& node, const short& xlow) {
@@ -1006,18 +1107,11 @@ void RRGraph::set_node_capacity(const RRNodeId& node, const short& capacity) {
 void RRGraph::set_node_ptc_num(const RRNodeId& node, const short& ptc) {
     VTR_ASSERT(valid_node_id(node));
 
-    /* For CHANX and CHANY, we will resize the ptc num to length of the node
-     * For other nodes, we will always assign the first element
+    /* For CHANX and CHANY, the ptc num is the same in all the coordinates of the node,
+     * so that the track ids are no longer needed
      */
-    if ((CHANX == node_type(node)) || (CHANY == node_type(node))) {
-        if ((size_t)node_length(node) + 1 != node_ptc_nums_[node].size()) {
-            node_ptc_nums_[node].resize((size_t)node_length(node) + 1);
-        }
-        std::fill(node_ptc_nums_[node].begin(), node_ptc_nums_[node].end(), ptc);
-    } else {
-        VTR_ASSERT(1 == node_ptc_nums_[node].size());
-        node_ptc_nums_[node][0] = ptc;
-    }
+    node_ptc_nums_[node] = ptc;
+    node_track_ids_.erase(node);
 }
 
 void RRGraph::set_node_pin_num(const RRNodeId& node, const short& pin_id) {
@@ -1047,14 +1141,20 @@ void RRGraph::add_node_track_num(const RRNodeId& node,
     VTR_ASSERT(valid_node_id(node));
     VTR_ASSERT_MSG(node_type(node) == CHANX || node_type(node) == CHANY, "Track number valid only for CHANX/CHANY RR nodes");
 
-    if ((size_t)node_length(node) + 1 != node_ptc_nums_[node].size()) {
-        node_ptc_nums_[node].resize((size_t)node_length(node) + 1);
+    /* Track ids are only stored when they vary along the track */
+    std::vector<short>& track_ids = node_track_ids_[node];
+    if ((size_t)node_length(node) + 1 != track_ids.size()) {
+        track_ids.resize((size_t)node_length(node) + 1, node_ptc_nums_[node]);
     }
 
     size_t offset = node_offset.x() - node_xlow(node) + node_offset.y() - node_ylow(node);
-    VTR_ASSERT(offset < node_ptc_nums_[node].size());
+    VTR_ASSERT(offset < track_ids.size());
 
-    node_ptc_nums_[node][offset] = track_id;
+    track_ids[offset] = track_id;
+    /* The ptc number is the track id at (xlow, ylow) */
+    if (0 == offset) {
+        node_ptc_nums_[node] = track_id;
+    }
 }
 
 void RRGraph::set_node_cost_index(const RRNodeId& node, const short& cost_index) {
@@ -1066,14 +1166,16 @@ void RRGraph::set_node_direction(const RRNodeId& node, const e_direction& direct
     VTR_ASSERT(valid_node_id(node));
     VTR_ASSERT_MSG(node_type(node) == CHANX || node_type(node) == CHANY, "Direct can only be specified on CHANX/CNAY rr nodes");
 
-    node_directions_[node] = direction;
+    node_packed_types_[node] = (node_packed_types_[node] & ~(NODE_DIRECTION_MASK << NODE_DIRECTION_SHIFT)) 
+                             | (uint8_t(direction) << NODE_DIRECTION_SHIFT);
 }
 
 void RRGraph::set_node_side(const RRNodeId& node, const e_side& side) {
     VTR_ASSERT(valid_node_id(node));
     VTR_ASSERT_MSG(node_type(node) == IPIN || node_type(node) == OPIN, "Side can only be specified on IPIN/OPIN rr nodes");
 
-    node_sides_[node] = side;
+    node_packed_types_[node] = (node_packed_types_[node] & ~(NODE_SIDE_MASK << NODE_SIDE_SHIFT)) 
+                             | (uint8_t(side) << NODE_SIDE_SHIFT);
 }
 
 void RRGraph::set_node_R(const RRNodeId& node, const float& R) {
@@ -1109,13 +1211,19 @@ void RRGraph::set_node_segment(const RRNodeId& node, const RRSegmentId& segment_
     node_segments_[node] = segment_id;
 }
 void RRGraph::rebuild_node_edges() {
-    node_edges_.resize(nodes().size());
+    node_edge_offsets_.resize(nodes().size(), 0);
     node_num_in_edges_.resize(nodes().size(), 0);
     node_num_out_edges_.resize(nodes().size(), 0);
     node_num_non_configurable_in_edges_.resize(nodes().size(), 0);
     node_num_non_configurable_out_edges_.resize(nodes().size(), 0);
 
-    //Count the number of edges of each type
+    /* Start from scratch, as the counters are updated by each edge */
+    std::fill(node_num_in_edges_.begin(), node_num_in_edges_.end(), 0);
+    std::fill(node_num_out_edges_.begin(), node_num_out_edges_.end(), 0);
+    std::fill(node_num_non_configurable_in_edges_.begin(), node_num_non_configurable_in_edges_.end(), 0);
+    std::fill(node_num_non_configurable_out_edges_.begin(), node_num_non_configurable_out_edges_.end(), 0);
+
+    //Pass 1: Count the number of edges of each type
     for (RREdgeId edge : edges()) {
         if (!edge) continue;
 
@@ -1131,84 +1239,68 @@ void RRGraph::rebuild_node_edges() {
         }
     }
 
-    //Allocate precisely the correct space for each nodes edge list
+    //Allocate precisely the correct space for all the node edge lists in one go
+    size_t num_node_edges = 0;
     for (RRNodeId node : nodes()) {
         if (!node) continue;
 
-        node_edges_[node] = std::make_unique<RREdgeId[]>(node_num_in_edges_[node] + node_num_out_edges_[node]);
+        node_edge_offsets_[node] = num_node_edges;
+        num_node_edges += node_num_in_edges_[node] + node_num_out_edges_[node];
     }
-
-    //Insert the edges into the node lists
+    node_edges_.clear();
+    node_edges_.shrink_to_fit();
+    node_edges_.resize(num_node_edges, RREdgeId::INVALID());
+
+    //Pass 2: Insert each edge directly into the sub-range of its type
+    //
+    //The edges of each node are partitioned first by incoming/outgoing:
+    //
+    // +---------------------------+-----------------------------+
+    // |             in            |           out               |
+    // +---------------------------+-----------------------------+
+    //
+    //and then the two subsets by configurability. So the final ordering is:
+    //
+    // +-----------+---------------+------------+----------------+
+    // | in_config | in_non_config | out_config | out_non_config |
+    // +-----------+---------------+------------+----------------+
+    //
+    //Edges are inserted in the order of their ids, so that the relative order 
+    //is kept in each sub-range, same as a stable partition.
+    //This is mainly for comparing the RRGraph write with rr_node writer 
+    //so that it is easy to check consistency
     {
-        vtr::vector<RRNodeId, int> inserted_edge_cnt(nodes().size(), 0);
+        /* Number of edges inserted to each sub-range of a node: 
+         * [0] in_config, [1] in_non_config, [2] out_config, [3] out_non_config
+         */
+        vtr::vector<RRNodeId, std::array<uint16_t, 4>> inserted_edge_cnt(nodes().size(), {{0, 0, 0, 0}});
         for (RREdgeId edge : edges()) {
+            if (!edge) continue;
+
             RRNodeId src_node = edge_src_node(edge);
             RRNodeId sink_node = edge_sink_node(edge);
-
-            node_edges_[src_node][inserted_edge_cnt[src_node]++] = edge;
-            node_edges_[sink_node][inserted_edge_cnt[sink_node]++] = edge;
+            bool config = edge_is_configurable(edge);
+
+            if (config) {
+                node_edges_[node_edge_offsets_[sink_node] 
+                            + inserted_edge_cnt[sink_node][0]++] = edge;
+                node_edges_[node_edge_offsets_[src_node] + node_num_in_edges_[src_node] 
+                            + inserted_edge_cnt[src_node][2]++] = edge;
+            } else {
+                node_edges_[node_edge_offsets_[sink_node] + node_num_in_edges_[sink_node] - node_num_non_configurable_in_edges_[sink_node] 
+                            + inserted_edge_cnt[sink_node][1]++] = edge;
+                node_edges_[node_edge_offsets_[src_node] + node_num_in_edges_[src_node] + node_num_out_edges_[src_node] - node_num_non_configurable_out_edges_[src_node] 
+                            + inserted_edge_cnt[src_node][3]++] = edge;
+            }
         }
     }
 
 #if 0
-    //TODO: Sanity Check remove!
+    //TODO: Sanity check remove!
     for (RRNodeId node : nodes()) {
-        for (size_t iedge = 0; iedge < node_num_in_edges_[node] + node_num_out_edges_[node]; ++iedge) {
-            RREdgeId edge = node_edges_[node][iedge];
-            VTR_ASSERT(edge_src_node(edge) == node || edge_sink_node(edge) == node);
-        }
-    }
-#endif
-
-    //Partition each node's edge lists according to their type to line up with the counts
-
-    auto is_configurable_edge = [&](const RREdgeId edge) {
-        return edge_is_configurable(edge);
-    };
-
-    for (RRNodeId node : nodes()) {
-        if (!node) continue;
-
-        //We partition the nodes first by incoming/outgoing:
-        //
-        // +---------------------------+-----------------------------+
-        // |             in            |           out               |
-        // +---------------------------+-----------------------------+
-        //
-        //and then the two subsets by configurability. So the final ordering is:
-        //
-        // +-----------+---------------+------------+----------------+
-        // | in_config | in_non_config | out_config | out_non_config |
-        // +-----------+---------------+------------+----------------+
-        //
-
-        //Partition first into incoming/outgoing
-        auto is_incoming_edge = [&](const RREdgeId edge) {
-            return edge_sink_node(edge) == node;
-        };
-        /* Use stable_partition to keep the relative order,
-         * This is mainly for comparing the RRGraph write with rr_node writer 
-         * so that it is easy to check consistency
-         */
-        std::stable_partition(node_edges_[node].get(),
-                              node_edges_[node].get() + node_num_in_edges_[node] + node_num_out_edges_[node],
-                              is_incoming_edge);
-
-        //Partition incoming by configurable/non-configurable
-        std::stable_partition(node_edges_[node].get(),
-                              node_edges_[node].get() + node_num_in_edges_[node],
-                              is_configurable_edge);
-
-        //Partition outgoing by configurable/non-configurable
-        std::stable_partition(node_edges_[node].get() + node_num_in_edges_[node],
-                              node_edges_[node].get() + node_num_in_edges_[node] + node_num_out_edges_[node],
-                              is_configurable_edge);
-
-#if 0
-        //TODO: Sanity check remove!
         size_t nedges = node_num_in_edges_[node] + node_num_out_edges_[node];
         for (size_t iedge = 0; iedge < nedges; ++iedge) {
-            RREdgeId edge = node_edges_[node][iedge];
+            RREdgeId edge = node_edges_[node_edge_offsets_[node] + iedge];
             if (iedge < node_num_in_edges_[node]) { //Incoming
                 VTR_ASSERT(edge_sink_node(edge) == node);
                 if (iedge < node_num_in_edges_[node] - node_num_non_configurable_in_edges_[node]) {
@@ -1225,15 +1317,19 @@ void RRGraph::rebuild_node_edges() {
                 }
             }
         }
-#endif
     }
+#endif
+}
+
+size_t RRGraph::fast_node_lookup_group(const size_t& x, const size_t& y, const t_rr_type& type) const {
+    return (x * node_lookup_size_.y() + y) * NUM_RR_TYPES + size_t(type);
 }
 
 void RRGraph::build_fast_node_lookup() const {
     /* Free the current fast node look-up, we will rebuild a new one here */
     invalidate_fast_node_lookup();
 
-    /* Get the max (x,y) and then we can resize the ndmatrix */
+    /* Get the max (x,y) and then we can allocate the groups */
     vtr::Point<short> max_coord(0, 0);
     for (size_t id = 0; id < num_nodes_; ++id) {
         /* Try to find if this is an invalid id or not */
@@ -1244,71 +1340,83 @@ void RRGraph::build_fast_node_lookup() const {
         max_coord.set_x(std::max(max_coord.x(), std::max(node_bounding_boxes_[RRNodeId(id)].xmax(), node_bounding_boxes_[RRNodeId(id)].xmin())));
         max_coord.set_y(std::max(max_coord.y(), std::max(node_bounding_boxes_[RRNodeId(id)].ymax(), node_bounding_boxes_[RRNodeId(id)].ymin())));
     }
-    node_lookup_.resize({(size_t)max_coord.x() + 1, (size_t)max_coord.y() + 1, NUM_RR_TYPES + 1});
-
-    for (size_t id = 0; id < num_nodes_; ++id) {
-        /* Try to find if this is an invalid id or not */
-        if (!valid_node_id(RRNodeId(id))) {
-            /* Skip this id */
-            continue;
-        }
-        RRNodeId node = RRNodeId(id);
-        /* Special for CHANX and CHANY, we should annotate in the look-up 
-         * for all the (x,y) upto (xhigh, yhigh)
-         */
-        size_t x_start = std::min(node_xlow(node), node_xhigh(node));
-        size_t y_start = std::min(node_ylow(node), node_yhigh(node));
-        std::vector<size_t> node_x(std::abs(node_xlow(node) - node_xhigh(node)) + 1);
-        std::vector<size_t> node_y(std::abs(node_ylow(node) - node_yhigh(node)) + 1);
-        
-        std::iota(node_x.begin(), node_x.end(), x_start);
-        std::iota(node_y.begin(), node_y.end(), y_start);
-        
-        VTR_ASSERT(size_t(std::max(node_xlow(node), node_xhigh(node))) == node_x.back());
-        VTR_ASSERT(size_t(std::max(node_ylow(node), node_yhigh(node))) == node_y.back());
-
-        size_t itype = node_type(node);
-
-        for (const size_t& x : node_x) {
-            for (const size_t& y : node_y) {
-                size_t ptc = node_ptc_num(node);
-                /* Routing channel nodes may have different ptc num 
-                 * Find the track ids using the x/y offset  
-                 */
-                if (CHANX == node_type(node)) {
-                    ptc = node_track_ids(node)[x - node_xlow(node)];
-                } else if (CHANY == node_type(node)) {
-                    ptc = node_track_ids(node)[y - node_ylow(node)];
-                }
-
-                if (ptc >= node_lookup_[x][y][itype].size()) {
-                    node_lookup_[x][y][itype].resize(ptc + 1);
-                }
-
-                size_t iside = -1;
-                if (node_type(node) == OPIN || node_type(node) == IPIN) {
-                    iside = node_side(node);
-                } else {
-                    iside = NUM_SIDES;
-                }
-
-                if (iside >= node_lookup_[x][y][itype][ptc].size()) {
-                    node_lookup_[x][y][itype][ptc].resize(iside + 1);
+    node_lookup_size_ = vtr::Point<size_t>((size_t)max_coord.x() + 1, (size_t)max_coord.y() + 1);
+
+    /* Visit all the (x, y, ptc) that a node is located at */
+    auto for_each_node_location = [&](auto visit_node_location) {
+        for (size_t id = 0; id < num_nodes_; ++id) {
+            /* Try to find if this is an invalid id or not */
+            if (!valid_node_id(RRNodeId(id))) {
+                /* Skip this id */
+                continue;
+            }
+            RRNodeId node = RRNodeId(id);
+            /* Special for CHANX and CHANY, we should annotate in the look-up 
+             * for all the (x,y) upto (xhigh, yhigh)
+             */
+            size_t x_start = std::min(node_xlow(node), node_xhigh(node));
+            size_t y_start = std::min(node_ylow(node), node_yhigh(node));
+            size_t x_end = std::max(node_xlow(node), node_xhigh(node));
+            size_t y_end = std::max(node_ylow(node), node_yhigh(node));
+
+            for (size_t x = x_start; x <= x_end; ++x) {
+                for (size_t y = y_start; y <= y_end; ++y) {
+                    size_t ptc = node_ptc_num(node);
+                    /* Routing channel nodes may have different ptc num 
+                     * Find the track ids using the x/y offset  
+                     */
+                    if (CHANX == node_type(node)) {
+                        ptc = node_track_id(node, x - node_xlow(node));
+                    } else if (CHANY == node_type(node)) {
+                        ptc = node_track_id(node, y - node_ylow(node));
+                    }
+                    visit_node_location(node, x, y, ptc);
                 }
-
-                //Save node in lookup
-                node_lookup_[x][y][itype][ptc][iside] = node;
             }
-       }
+        }
+    };
+
+    /* First pass: find the number of ptc_num in each group */
+    size_t num_groups = node_lookup_size_.x() * node_lookup_size_.y() * NUM_RR_TYPES;
+    std::vector<size_t> num_ptcs(num_groups, 0);
+    for_each_node_location([&](const RRNodeId& node, const size_t& x, const size_t& y, const size_t& ptc) {
+        size_t group = fast_node_lookup_group(x, y, node_type(node));
+        num_ptcs[group] = std::max(num_ptcs[group], ptc + 1);
+    });
+
+    /* Allocate the flat array of nodes in one go */
+    node_lookup_offsets_.resize(num_groups + 1);
+    node_lookup_offsets_[0] = 0;
+    for (size_t group = 0; group < num_groups; ++group) {
+        t_rr_type type = t_rr_type(group % NUM_RR_TYPES);
+        node_lookup_offsets_[group + 1] = node_lookup_offsets_[group] + num_ptcs[group] * fast_node_lookup_num_sides(type);
     }
+    num_ptcs.clear();
+    num_ptcs.shrink_to_fit();
+    node_lookup_.resize(node_lookup_offsets_.back(), RRNodeId::INVALID());
+
+    /* Second pass: save nodes in lookup */
+    for_each_node_location([&](const RRNodeId& node, const size_t& x, const size_t& y, const size_t& ptc) {
+        t_rr_type type = node_type(node);
+        size_t iside = NUM_SIDES;
+        if (type == OPIN || type == IPIN) {
+            iside = node_side(node);
+        }
+        size_t index = node_lookup_offsets_[fast_node_lookup_group(x, y, type)] 
+                     + ptc * fast_node_lookup_num_sides(type) 
+                     + fast_node_lookup_side_index(type, e_side(iside));
+        node_lookup_[index] = node;
+    });
 }
 
 void RRGraph::invalidate_fast_node_lookup() const {
+    node_lookup_size_ = vtr::Point<size_t>(0, 0);
+    node_lookup_offsets_.clear();
     node_lookup_.clear();
 }
 
 bool RRGraph::valid_fast_node_lookup() const {
-    return !node_lookup_.empty();
+    return !node_lookup_offsets_.empty();
 }
 
 void RRGraph::initialize_fast_node_lookup() const {
@@ -1353,19 +1461,17 @@ bool RRGraph::validate_sizes() const {
 }
 
 bool RRGraph::validate_node_sizes() const {
-    return node_types_.size() == num_nodes_
+    return node_packed_types_.size() == num_nodes_
            && node_bounding_boxes_.size() == num_nodes_
            && node_capacities_.size() == num_nodes_
            && node_ptc_nums_.size() == num_nodes_
            && node_cost_indices_.size() == num_nodes_
-           && node_directions_.size() == num_nodes_
-           && node_sides_.size() == num_nodes_
            && node_Rs_.size() == num_nodes_
            && node_Cs_.size() == num_nodes_
            && node_segments_.size() == num_nodes_
            && node_num_non_configurable_in_edges_.size() == num_nodes_
            && node_num_non_configurable_out_edges_.size() == num_nodes_
-           && node_edges_.size() == num_nodes_;
+           && node_edge_offsets_.size() == num_nodes_;
 }
 
 bool RRGraph::validate_edge_sizes() const {
@@ -1438,15 +1544,22 @@ void RRGraph::build_id_maps(vtr::vector<RRNodeId, RRNodeId>& node_id_map,
 void RRGraph::clean_nodes(const vtr::vector<RRNodeId, RRNodeId>& node_id_map) {
     num_nodes_ = node_id_map.size();
 
-    node_types_ = clean_and_reorder_values(node_types_, node_id_map);
+    node_packed_types_ = clean_and_reorder_values(node_packed_types_, node_id_map);
 
     node_bounding_boxes_ = clean_and_reorder_values(node_bounding_boxes_, node_id_map);
 
     node_capacities_ = clean_and_reorder_values(node_capacities_, node_id_map);
     node_ptc_nums_ = clean_and_reorder_values(node_ptc_nums_, node_id_map);
     node_cost_indices_ = clean_and_reorder_values(node_cost_indices_, node_id_map);
-    node_directions_ = clean_and_reorder_values(node_directions_, node_id_map);
-    node_sides_ = clean_and_reorder_values(node_sides_, node_id_map);
+    /* Move the track ids to the new node ids */
+    std::unordered_map<RRNodeId, std::vector<short>> node_track_ids;
+    for (auto& track_ids : node_track_ids_) {
+        RRNodeId new_node = node_id_map[track_ids.first];
+        if (new_node) {
+            node_track_ids[new_node] = std::move(track_ids.second);
+        }
+    }
+    node_track_ids_ = std::move(node_track_ids);
     node_Rs_ = clean_and_reorder_values(node_Rs_, node_id_map);
     node_Cs_ = clean_and_reorder_values(node_Cs_, node_id_map);
 
@@ -1455,7 +1568,8 @@ void RRGraph::clean_nodes(const vtr::vector<RRNodeId, RRNodeId>& node_id_map) {
     node_num_non_configurable_out_edges_ = clean_and_reorder_values(node_num_non_configurable_out_edges_, node_id_map);
     node_num_in_edges_ = clean_and_reorder_values(node_num_in_edges_, node_id_map);
     node_num_out_edges_ = clean_and_reorder_values(node_num_out_edges_, node_id_map);
-    //node_edges_ = clean_and_reorder_values(node_edges_, node_id_map);
+    /* The node edges stay in place in the CSR array, only their offsets are reordered */
+    node_edge_offsets_ = clean_and_reorder_values(node_edge_offsets_, node_id_map);
 
     VTR_ASSERT(validate_node_sizes());
 }
@@ -1479,7 +1593,7 @@ void RRGraph::rebuild_node_refs(const vtr::vector<RREdgeId, RREdgeId>& edge_id_m
         }
         RRNodeId node = RRNodeId(id);
 
-        auto begin = node_edges_[node].get();
+        auto begin = node_edges_.begin() + node_edge_offsets_[node];
         auto end = begin + node_num_in_edges_[node] + node_num_out_edges_[node];
         update_valid_refs(begin, end, edge_id_map);
 
@@ -1490,14 +1604,13 @@ void RRGraph::rebuild_node_refs(const vtr::vector<RREdgeId, RREdgeId>& edge_id_m
 /* Empty all the vectors related to nodes */
 void RRGraph::clear_nodes() {
     num_nodes_ = 0;
-    node_types_.clear();
+    node_packed_types_.clear();
     node_bounding_boxes_.clear();
 
     node_capacities_.clear();
     node_ptc_nums_.clear();
     node_cost_indices_.clear();
-    node_directions_.clear();
-    node_sides_.clear();
+    node_track_ids_.clear();
     node_Rs_.clear();
     node_Cs_.clear();
     node_rc_data_indices_.clear();
@@ -1508,10 +1621,11 @@ void RRGraph::clear_nodes() {
     node_num_non_configurable_in_edges_.clear();
     node_num_non_configurable_out_edges_.clear();
 
+    node_edge_offsets_.clear();
     node_edges_.clear();
 
     /* clean node_look_up */
-    node_lookup_.clear();
+    invalidate_fast_node_lookup();
 }
 
 /* Empty all the vectors related to edges */
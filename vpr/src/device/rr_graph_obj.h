@@ -206,12 +206,18 @@
 #include "vtr_vector.h"
 #include "vtr_range.h"
 #include "vtr_geometry.h"
+#include "vtr_memory_stats.h"
 #include "arch_types.h"
 
 /* VPR header files go third */
 #include "rr_graph_types.h"
 #include "rr_graph_fwd.h"
 
+/* Owner of the memory of the edges, when memory accounting is enabled (see vtr_memory_stats.h) */
+struct t_rr_edge_memory_tag {
+    static const char* name() { return "RRGraph edges"; }
+};
+
 class RRGraph {
   public: /* Types */
     //Lazy iterator utility forward declaration
@@ -228,7 +234,7 @@ class RRGraph {
 
     /* Ranges used to create range-based loop for nodes/edges/switches/segments */
     typedef vtr::Range<node_iterator> node_range;
-    typedef vtr::Range<RREdgeId*> edge_range;
+    typedef vtr::Range<const RREdgeId*> edge_range;
     typedef vtr::Range<switch_iterator> switch_range;
     typedef vtr::Range<segment_iterator> segment_range;
     typedef vtr::Range<lazy_node_iterator> lazy_node_range;
@@ -266,6 +272,9 @@ class RRGraph {
     switch_range switches() const;
     segment_range segments() const;
 
+    /* Estimate the memory (in bytes) occupied by the graph, including its fast look-up */
+    size_t memory_footprint() const;
+
     /* Node-level attributes */
     size_t node_index(const RRNodeId& node) const; /* TODO: deprecate this accessor as outside functions should use RRNodeId */
 
@@ -543,6 +552,12 @@ class RRGraph {
     std::vector<RREdgeId> find_edges(const RRNodeId& src_node, const RRNodeId& sink_node) const;
     /* Find a node with given features from internal fast look-up */
     RRNodeId find_node(const short& x, const short& y, const t_rr_type& type, const int& ptc, const e_side& side = NUM_SIDES) const;
+    /* Find all the nodes with a given type at a coordinator from internal fast look-up, 
+     * e.g., all the tracks of a routing channel
+     * Nodes are returned in the order of their ptc_num
+     * For IPIN and OPIN, only the nodes on the given side are returned
+     */
+    std::vector<RRNodeId> find_nodes(const short& x, const short& y, const t_rr_type& type, const e_side& side = NUM_SIDES) const;
     /* Find the number of routing tracks in a routing channel with a given coordinate */
     short chan_num_tracks(const short& x, const short& y, const t_rr_type& type) const;
 
@@ -810,6 +825,12 @@ class RRGraph {
     void clear_edges();
     void clear_segments();
 
+    /* Get the track id of a routing track at a given offset to (xlow, ylow) */
+    short node_track_id(const RRNodeId& node, const size_t& offset) const;
+
+    /* Get the first of the edges related to a given node in node_edges_ */
+    const RREdgeId* node_edge_begin(const RRNodeId& node) const;
+
   private: /* Graph Compression related */
     void build_id_maps(vtr::vector<RRNodeId, RRNodeId>& node_id_map,
                        vtr::vector<RREdgeId, RREdgeId>& edge_id_map);
@@ -826,6 +847,8 @@ class RRGraph {
     void invalidate_fast_node_lookup() const;
     bool valid_fast_node_lookup() const;
     void initialize_fast_node_lookup() const;
+    /* Index of the (x, y, type) group of nodes in the offsets of fast look-up */
+    size_t fast_node_lookup_group(const size_t& x, const size_t& y, const t_rr_type& type) const;
 
     /* Graph property Validation */
     bool validate_sizes() const;
@@ -867,23 +890,34 @@ class RRGraph {
     size_t num_nodes_;                              /* Range of node ids */
     std::unordered_set<RRNodeId> invalid_node_ids_; /* Invalid edge ids */
 
-    vtr::vector<RRNodeId, t_rr_type> node_types_;
+    /* Type, direction and side of each node are packed in one byte, 
+     * so that routing loops touch less memory per node
+     * See pack_node_types() in rr_graph_obj.cpp for the layout 
+     */
+    vtr::vector<RRNodeId, uint8_t> node_packed_types_;
 
     vtr::vector<RRNodeId, vtr::Rect<short>> node_bounding_boxes_;
 
     vtr::vector<RRNodeId, short> node_capacities_;
 
-    vtr::vector<RRNodeId, std::vector<short>> node_ptc_nums_;
+    /* The ptc number of each node, which is the track id at (xlow, ylow) for routing tracks */
+    vtr::vector<RRNodeId, short> node_ptc_nums_;
+    /* Side table of the track ids for the routing tracks whose track ids vary along the tracks, 
+     * e.g., in tileable routing architecture
+     * The track ids are indexed by the offset to (xlow, ylow)
+     * Other routing tracks have the same track id as their ptc number in all the coordinates
+     */
+    std::unordered_map<RRNodeId, std::vector<short>> node_track_ids_;
     vtr::vector<RRNodeId, short> node_cost_indices_;
-    vtr::vector<RRNodeId, e_direction> node_directions_;
-    vtr::vector<RRNodeId, e_side> node_sides_;
     vtr::vector<RRNodeId, float> node_Rs_;
     vtr::vector<RRNodeId, float> node_Cs_;
     vtr::vector<RRNodeId, short> node_rc_data_indices_;
     vtr::vector<RRNodeId, RRSegmentId> node_segments_; /* Segment ids for each node */
 
     /*
-     * We store the edges assoicated with each node in a single array per node (for memory efficiency).
+     * We store the edges assoicated with all the nodes in a single array (for memory efficiency),
+     * in the compressed sparse row (CSR) format, where the edges of a node 
+     * start from node_edge_offsets_[node] in node_edges_
      *
      * The array of edges is sorted into sub-ranges to allow for easy iteration (with node_in_edges(),
      * node_non_configurable_out_edges() etc.).
@@ -892,7 +926,7 @@ class RRGraph {
      * from which the delimiters for each sub-range can be calculated.
      *
      *
-     *  node_edges_[node]:
+     *  node_edges_[node_edge_offsets_[node]...]:
      *
      *  
      *                   node_num_non_configurable_in_edges_[node]      node_num_non_configurable_out_edges_[node]
@@ -906,15 +940,17 @@ class RRGraph {
      *              node_num_in_edges_[node]                 node_num_out_edges_[node]        
      *
      * All elements of node_edges_ should be initialized after all edges have been created (with create_edge()),
-     * by calling rebuild_node_edges(), which will allocate node_edges_, add the relevant edges and partition
-     * each node's arrays into the appropriate. rebuild_node_edges() also initializes all the node_num_* members
+     * by calling rebuild_node_edges(), which counts the edges of each node in a first pass, 
+     * allocates node_edges_ in one go and then fills each edge directly into the sub-range it belongs to.
+     * rebuild_node_edges() also initializes all the node_num_* members
      * based on the edges (created with create_edge()) in the edge_* members.
      */
     vtr::vector<RRNodeId, uint16_t> node_num_in_edges_;
     vtr::vector<RRNodeId, uint16_t> node_num_out_edges_;
     vtr::vector<RRNodeId, uint16_t> node_num_non_configurable_in_edges_;
     vtr::vector<RRNodeId, uint16_t> node_num_non_configurable_out_edges_;
-    vtr::vector<RRNodeId, std::unique_ptr<RREdgeId[]>> node_edges_;
+    vtr::vector<RRNodeId, size_t> node_edge_offsets_;
+    std::vector<RREdgeId, vtr::TaggedAllocator<RREdgeId, t_rr_edge_memory_tag>> node_edges_;
 
     /* Edge related data */
     /* Range of edge ids, use the unsigned long as 
@@ -922,9 +958,9 @@ class RRGraph {
      */
     unsigned long num_edges_;                         
     std::unordered_set<RREdgeId> invalid_edge_ids_;   /* Invalid edge ids */
-    vtr::vector<RREdgeId, RRNodeId> edge_src_nodes_;
-    vtr::vector<RREdgeId, RRNodeId> edge_sink_nodes_;
-    vtr::vector<RREdgeId, RRSwitchId> edge_switches_;
+    vtr::vector<RREdgeId, RRNodeId, vtr::TaggedAllocator<RRNodeId, t_rr_edge_memory_tag>> edge_src_nodes_;
+    vtr::vector<RREdgeId, RRNodeId, vtr::TaggedAllocator<RRNodeId, t_rr_edge_memory_tag>> edge_sink_nodes_;
+    vtr::vector<RREdgeId, RRSwitchId, vtr::TaggedAllocator<RRSwitchId, t_rr_edge_memory_tag>> edge_switches_;
 
     /* Switch related data
      * Note that so far there has been no need to remove
@@ -947,10 +983,15 @@ class RRGraph {
     bool dirty_ = false;
 
     /* Fast look-up to search a node by its type, coordinator and ptc_num 
-     * Indexing of fast look-up: [0..xmax][0..ymax][0..NUM_TYPES-1][0..ptc_max][0..NUM_SIDES-1] 
-     */
-    typedef vtr::NdMatrix<std::vector<std::vector<RRNodeId>>, 3> NodeLookup;
-    mutable NodeLookup node_lookup_;
+     * All the nodes are stored in a flat array, grouped by (x, y, type) 
+     * The nodes of a group start from node_lookup_offsets_[group]
+     * and are indexed by [0..ptc_max][0..NUM_SIDES] for IPIN/OPIN and by [0..ptc_max] for other types
+     * Groups are indexed by [0..xmax][0..ymax][0..NUM_TYPES-1], 
+     * see fast_node_lookup_group() for details
+     */
+    mutable vtr::Point<size_t> node_lookup_size_;
+    mutable std::vector<size_t> node_lookup_offsets_;
+    mutable std::vector<RRNodeId> node_lookup_;
 };
 
 #endif
@@ -0,0 +1,213 @@
+/*********************************************************************
+ * This file defines the writing rr graph function in binary format.
+ * Nodes and edges are dumped as a structure of arrays indexed by 
+ * their ids, so that the file can be loaded with mmap and without 
+ * any parsing (see read_binary_rr_graph_obj.cpp).
+ *
+ * Note that the metadata of nodes and edges is not included, 
+ * use the XML format when metadata is required
+ ********************************************************************/
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+#include "vpr_error.h"
+#include "globals.h"
+#include "write_binary_rr_graph_obj.h"
+
+#ifdef VTR_ENABLE_CAPNPROTO
+#    include "capnp/serialize.h"
+#    include "rr_graph_obj.capnp.h"
+#    include "serdes_utils.h"
+#endif /* VTR_ENABLE_CAPNPROTO */
+
+#ifndef VTR_ENABLE_CAPNPROTO
+
+#    define DISABLE_ERROR                               \
+        "is disable because VTR_ENABLE_CAPNPROTO=OFF. " \
+        "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable."
+
+void write_binary_rr_graph_obj(const char* /*file_name*/,
+                               const RRGraph& /*rr_graph*/,
+                               const int& /*wire_to_rr_ipin_switch*/) {
+    VPR_THROW(VPR_ERROR_ROUTE, "Writing the binary rr_graph " DISABLE_ERROR);
+}
+
+#else /* VTR_ENABLE_CAPNPROTO */
+
+/************************ Subroutine definitions ****************************/
+static 
+void write_binary_rr_channels(VprRRChannels::Builder channels,
+                              const t_chan_width& chan_width) {
+    channels.setMax(chan_width.max);
+    channels.setXMax(chan_width.x_max);
+    channels.setYMax(chan_width.y_max);
+    channels.setXMin(chan_width.x_min);
+    channels.setYMin(chan_width.y_min);
+
+    auto x_list = channels.initXList(chan_width.x_list.size());
+    for (size_t i = 0; i < chan_width.x_list.size(); ++i) {
+        x_list.set(i, chan_width.x_list[i]);
+    }
+    auto y_list = channels.initYList(chan_width.y_list.size());
+    for (size_t i = 0; i < chan_width.y_list.size(); ++i) {
+        y_list.set(i, chan_width.y_list[i]);
+    }
+}
+
+static 
+void write_binary_rr_switches(::capnp::List<VprRRSwitch>::Builder switches,
+                              const RRGraph& rr_graph) {
+    size_t iswitch = 0;
+    for (const RRSwitchId& switch_id : rr_graph.switches()) {
+        const t_rr_switch_inf& rr_switch = rr_graph.get_switch(switch_id);
+        auto sw = switches[iswitch];
+        if (nullptr != rr_switch.name) {
+            sw.setName(rr_switch.name);
+        }
+        sw.setType(uint8_t(rr_switch.type()));
+        sw.setR(rr_switch.R);
+        sw.setCin(rr_switch.Cin);
+        sw.setCout(rr_switch.Cout);
+        sw.setCinternal(rr_switch.Cinternal);
+        sw.setTdel(rr_switch.Tdel);
+        sw.setMuxTransSize(rr_switch.mux_trans_size);
+        sw.setBufSize(rr_switch.buf_size);
+        sw.setPowerBufferType(uint8_t(rr_switch.power_buffer_type));
+        sw.setPowerBufferSize(rr_switch.power_buffer_size);
+        ++iswitch;
+    }
+}
+
+static 
+void write_binary_rr_nodes(VprRRNodes::Builder nodes,
+                           const RRGraph& rr_graph) {
+    size_t num_nodes = rr_graph.nodes().size();
+
+    auto types = nodes.initTypes(num_nodes);
+    auto directions = nodes.initDirections(num_nodes);
+    auto sides = nodes.initSides(num_nodes);
+    auto xlows = nodes.initXlows(num_nodes);
+    auto ylows = nodes.initYlows(num_nodes);
+    auto xhighs = nodes.initXhighs(num_nodes);
+    auto yhighs = nodes.initYhighs(num_nodes);
+    auto capacities = nodes.initCapacities(num_nodes);
+    auto ptc_nums = nodes.initPtcNums(num_nodes);
+    auto cost_indices = nodes.initCostIndices(num_nodes);
+    auto rs = nodes.initRs(num_nodes);
+    auto cs = nodes.initCs(num_nodes);
+    auto segments = nodes.initSegments(num_nodes);
+
+    /* Routing tracks whose track ids vary along the track */
+    std::vector<RRNodeId> varying_track_nodes;
+
+    for (const RRNodeId& node : rr_graph.nodes()) {
+        size_t inode = size_t(node);
+        t_rr_type node_type = rr_graph.node_type(node);
+
+        types.set(inode, uint8_t(node_type));
+        /* Direction is only valid for routing tracks, while side is only valid for pins */
+        e_direction direction = NO_DIRECTION;
+        if ((CHANX == node_type) || (CHANY == node_type)) {
+            direction = rr_graph.node_direction(node);
+        }
+        directions.set(inode, uint8_t(direction));
+        e_side side = NUM_SIDES;
+        if ((IPIN == node_type) || (OPIN == node_type)) {
+            side = rr_graph.node_side(node);
+        }
+        sides.set(inode, uint8_t(side));
+        xlows.set(inode, rr_graph.node_xlow(node));
+        ylows.set(inode, rr_graph.node_ylow(node));
+        xhighs.set(inode, rr_graph.node_xhigh(node));
+        yhighs.set(inode, rr_graph.node_yhigh(node));
+        capacities.set(inode, rr_graph.node_capacity(node));
+        ptc_nums.set(inode, rr_graph.node_ptc_num(node));
+        cost_indices.set(inode, rr_graph.node_cost_index(node));
+        rs.set(inode, rr_graph.node_R(node));
+        cs.set(inode, rr_graph.node_C(node));
+
+        int segment = -1;
+        if ((CHANX == node_type) || (CHANY == node_type)) {
+            if (true == rr_graph.valid_segment_id(rr_graph.node_segment(node))) {
+                segment = size_t(rr_graph.node_segment(node));
+            }
+            std::vector<short> track_ids = rr_graph.node_track_ids(node);
+            for (const short& track_id : track_ids) {
+                if (track_id != rr_graph.node_ptc_num(node)) {
+                    varying_track_nodes.push_back(node);
+                    break;
+                }
+            }
+        }
+        segments.set(inode, segment);
+    }
+
+    auto track_id_entries = nodes.initTrackIds(varying_track_nodes.size());
+    for (size_t ientry = 0; ientry < varying_track_nodes.size(); ++ientry) {
+        const RRNodeId& node = varying_track_nodes[ientry];
+        std::vector<short> track_ids = rr_graph.node_track_ids(node);
+
+        auto entry = track_id_entries[ientry];
+        entry.setNode(size_t(node));
+        auto ids = entry.initIds(track_ids.size());
+        for (size_t i = 0; i < track_ids.size(); ++i) {
+            ids.set(i, track_ids[i]);
+        }
+    }
+}
+
+static 
+void write_binary_rr_edges(VprRREdges::Builder edges,
+                           const RRGraph& rr_graph) {
+    size_t num_edges = rr_graph.edges().size();
+
+    auto src_nodes = edges.initSrcNodes(num_edges);
+    auto sink_nodes = edges.initSinkNodes(num_edges);
+    auto switches = edges.initSwitches(num_edges);
+
+    /* Edges are written in the order of the outgoing edges of each node,
+     * so that the reader recreates the same node-to-edge lists
+     */
+    size_t iedge = 0;
+    for (const RRNodeId& node : rr_graph.nodes()) {
+        for (const RREdgeId& edge : rr_graph.node_out_edges(node)) {
+            src_nodes.set(iedge, size_t(node));
+            sink_nodes.set(iedge, size_t(rr_graph.edge_sink_node(edge)));
+            switches.set(iedge, size_t(rr_graph.edge_switch(edge)));
+            ++iedge;
+        }
+    }
+    VTR_ASSERT(iedge == num_edges);
+}
+
+/************************ Top-level function ****************************/
+void write_binary_rr_graph_obj(const char* file_name,
+                               const RRGraph& rr_graph,
+                               const int& wire_to_rr_ipin_switch) {
+    vtr::ScopedStartFinishTimer timer("Writing binary routing resource graph");
+
+    /* Node and edge ids are used as the indices of the lists */
+    VTR_ASSERT(false == rr_graph.is_dirty());
+
+    const auto& device_ctx = g_vpr_ctx.device();
+
+    ::capnp::MallocMessageBuilder builder;
+    auto graph = builder.initRoot<VprRRGraph>();
+
+    graph.setGridWidth(device_ctx.grid.width());
+    graph.setGridHeight(device_ctx.grid.height());
+    graph.setNumSegments(rr_graph.segments().size());
+    graph.setWireToRRIpinSwitch(wire_to_rr_ipin_switch);
+
+    write_binary_rr_channels(graph.initChannels(), device_ctx.chan_width);
+    write_binary_rr_switches(graph.initSwitches(rr_graph.switches().size()), rr_graph);
+    write_binary_rr_nodes(graph.initNodes(), rr_graph);
+    write_binary_rr_edges(graph.initEdges(), rr_graph);
+
+    writeMessageToFile(file_name, &builder);
+
+    VTR_LOG("Binary rr_graph is written to file '%s'\n", file_name);
+}
+
+#endif /* VTR_ENABLE_CAPNPROTO */
@@ -0,0 +1,17 @@
+/*********************************************************************
+ * This function writes the RR_graph generated by VPR into a file in 
+ * the binary format defined by libvtrcapnproto/rr_graph_obj.capnp
+ * Information included in the file includes rr nodes, rr switches, 
+ * rr edges, the channel widths and the size of the grid 
+ ********************************************************************/
+
+#ifndef WRITE_BINARY_RR_GRAPH_OBJ_H
+#define WRITE_BINARY_RR_GRAPH_OBJ_H
+
+#include "rr_graph_obj.h"
+
+void write_binary_rr_graph_obj(const char* file_name,
+                               const RRGraph& rr_graph,
+                               const int& wire_to_rr_ipin_switch);
+
+#endif
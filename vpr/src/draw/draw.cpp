@@ -26,6 +26,7 @@
 #include "vtr_log.h"
 #include "vtr_color_map.h"
 #include "vtr_vector.h"
+#include "vtr_geometry.h"
 
 #include "vpr_utils.h"
 #include "vpr_error.h"
@@ -91,6 +92,12 @@ void act_on_mouse_move(ezgl::application* app, GdkEventButton* event, double x,
 static void draw_routed_net(ClusterNetId net, ezgl::renderer* g);
 void draw_partial_route(const std::vector<RRNodeId>& rr_nodes_to_draw, ezgl::renderer* g);
 static void draw_rr(ezgl::renderer* g);
+static void draw_rr_node_and_edges(const RRNodeId& inode, ezgl::renderer* g);
+static void build_draw_rr_index();
+static vtr::Rect<int> get_visible_grid_region(ezgl::renderer* g);
+static bool is_rr_node_in_region(const RRNodeId& inode, const vtr::Rect<int>& region);
+static bool is_rr_zoomed_out(ezgl::renderer* g);
+static void draw_rr_chan_heatmap(const vtr::Rect<int>& region, ezgl::renderer* g);
 static void draw_rr_edges(const RRNodeId& from_node, ezgl::renderer* g);
 static void draw_rr_pin(const RRNodeId& inode, const ezgl::color& color, ezgl::renderer* g);
 static void draw_rr_chan(const RRNodeId& inode, const ezgl::color color, ezgl::renderer* g);
@@ -151,6 +158,10 @@ constexpr float SB_EDGE_TURN_ARROW_POSITION = 0.2;
 constexpr float SB_EDGE_STRAIGHT_ARROW_POSITION = 0.95;
 constexpr float EMPTY_BLOCK_LIGHTEN_FACTOR = 0.10;
 
+//Below this width (in pixels) of a tile on screen, the routing resources are drawn
+//as a heatmap of the occupancy of the channels, instead of wire by wire
+constexpr float MIN_TILE_SCREEN_WIDTH_TO_DRAW_RR = 20.;
+
 //Kelly's maximum contrast colors are selected to be easily distinguishable as described in:
 //  Kenneth Kelly, "Twenty-Two Colors of Maximum Contrast", Color Eng. 3(6), 1943
 //We use these to highlight a relatively small number of things (e.g. stages in a critical path,
@@ -405,6 +416,10 @@ void update_screen(ScreenUpdatePriority priority, const char* msg, enum pic_type
 
     t_draw_state* draw_state = get_draw_state_vars();
 
+    //The routing may have changed since the last update, so the index of the
+    //routing resources is rebuilt at the next drawing
+    draw_state->rr_index.clear();
+
     if (!draw_state->show_graphics)
         ezgl::set_disable_event_loop(true);
     else
@@ -1277,9 +1292,9 @@ static void draw_routing_bb(ezgl::renderer* g) {
 
 void draw_rr(ezgl::renderer* g) {
     /* Draws the routing resources that exist in the FPGA, if the user wants *
-     * them drawn.                                                           */
+     * them drawn. Only the routing resources in the visible region are      *
+     * drawn, and only as a heatmap of the channels when zoomed out.         */
     t_draw_state* draw_state = get_draw_state_vars();
-    auto& device_ctx = g_vpr_ctx.device();
 
     if (draw_state->draw_rr_toggle == DRAW_NO_RR) {
         g->set_line_width(3);
@@ -1290,57 +1305,204 @@ void draw_rr(ezgl::renderer* g) {
 
     g->set_line_dash(ezgl::line_dash::none);
 
-    for (const RRNodeId& inode : device_ctx.rr_graph.nodes()) {
-        if (!draw_state->draw_rr_node[inode].node_highlighted) {
-            /* If not highlighted node, assign color based on type. */
-            switch (device_ctx.rr_graph.node_type(inode)) {
-                case CHANX:
-                case CHANY:
-                    draw_state->draw_rr_node[inode].color = DEFAULT_RR_NODE_COLOR;
-                    break;
-                case OPIN:
-                    draw_state->draw_rr_node[inode].color = ezgl::PINK;
-                    break;
-                case IPIN:
-                    draw_state->draw_rr_node[inode].color = blk_LIGHTSKYBLUE;
-                    break;
-                default:
-                    break;
+    if (draw_state->rr_index.empty()) {
+        build_draw_rr_index();
+    }
+    const t_draw_rr_index& rr_index = draw_state->rr_index;
+
+    vtr::Rect<int> region = get_visible_grid_region(g);
+
+    if (is_rr_zoomed_out(g)) {
+        //The wires can not be told apart, so draw the occupancy of the channels instead
+        draw_rr_chan_heatmap(region, g);
+        drawroute(HIGHLIGHTED, g);
+        return;
+    }
+
+    //Only draw the rr_nodes overlapping the visible region
+    for (int x = std::max(region.xmin() - rr_index.max_span, 0); x <= region.xmax(); ++x) {
+        for (int y = std::max(region.ymin() - rr_index.max_span, 0); y <= region.ymax(); ++y) {
+            for (const RRNodeId& inode : rr_index.bins[x][y]) {
+                if (is_rr_node_in_region(inode, region)) {
+                    draw_rr_node_and_edges(inode, g);
+                }
             }
         }
+    }
 
-        /* Now call drawing routines to draw the node. */
-        switch (device_ctx.rr_graph.node_type(inode)) {
-            case SOURCE:
-            case SINK:
-                break; /* Don't draw. */
+    drawroute(HIGHLIGHTED, g);
+}
 
-            case CHANX:
-                draw_rr_chan(inode, draw_state->draw_rr_node[inode].color, g);
-                draw_rr_edges(inode, g);
-                break;
+static void draw_rr_node_and_edges(const RRNodeId& inode, ezgl::renderer* g) {
+    t_draw_state* draw_state = get_draw_state_vars();
+    auto& device_ctx = g_vpr_ctx.device();
 
+    if (!draw_state->draw_rr_node[inode].node_highlighted) {
+        /* If not highlighted node, assign color based on type. */
+        switch (device_ctx.rr_graph.node_type(inode)) {
+            case CHANX:
             case CHANY:
-                draw_rr_chan(inode, draw_state->draw_rr_node[inode].color, g);
-                draw_rr_edges(inode, g);
+                draw_state->draw_rr_node[inode].color = DEFAULT_RR_NODE_COLOR;
+                break;
+            case OPIN:
+                draw_state->draw_rr_node[inode].color = ezgl::PINK;
                 break;
-
             case IPIN:
-                draw_rr_pin(inode, draw_state->draw_rr_node[inode].color, g);
+                draw_state->draw_rr_node[inode].color = blk_LIGHTSKYBLUE;
                 break;
-
-            case OPIN:
-                draw_rr_pin(inode, draw_state->draw_rr_node[inode].color, g);
-                draw_rr_edges(inode, g);
+            default:
                 break;
+        }
+    }
 
-            default:
-                vpr_throw(VPR_ERROR_OTHER, __FILE__, __LINE__,
-                          "in draw_rr: Unexpected rr_node type: %d.\n", device_ctx.rr_graph.node_type(inode));
+    /* Now call drawing routines to draw the node. */
+    switch (device_ctx.rr_graph.node_type(inode)) {
+        case SOURCE:
+        case SINK:
+            break; /* Don't draw. */
+
+        case CHANX:
+            draw_rr_chan(inode, draw_state->draw_rr_node[inode].color, g);
+            draw_rr_edges(inode, g);
+            break;
+
+        case CHANY:
+            draw_rr_chan(inode, draw_state->draw_rr_node[inode].color, g);
+            draw_rr_edges(inode, g);
+            break;
+
+        case IPIN:
+            draw_rr_pin(inode, draw_state->draw_rr_node[inode].color, g);
+            break;
+
+        case OPIN:
+            draw_rr_pin(inode, draw_state->draw_rr_node[inode].color, g);
+            draw_rr_edges(inode, g);
+            break;
+
+        default:
+            vpr_throw(VPR_ERROR_OTHER, __FILE__, __LINE__,
+                      "in draw_rr: Unexpected rr_node type: %d.\n", device_ctx.rr_graph.node_type(inode));
+    }
+}
+
+static void build_draw_rr_index() {
+    /* Bins the rr_nodes by their low corner, and adds up the occupancy *
+     * and capacity of the wires of each channel segment.               */
+    t_draw_state* draw_state = get_draw_state_vars();
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& route_ctx = g_vpr_ctx.routing();
+    const auto& rr_graph = device_ctx.rr_graph;
+
+    t_draw_rr_index& rr_index = draw_state->rr_index;
+    rr_index.clear();
+
+    size_t width = device_ctx.grid.width();
+    size_t height = device_ctx.grid.height();
+    rr_index.bins.resize({width, height});
+    rr_index.chanx_occ.resize({width, height}, 0);
+    rr_index.chanx_capacity.resize({width, height}, 0);
+    rr_index.chany_occ.resize({width, height}, 0);
+    rr_index.chany_capacity.resize({width, height}, 0);
+
+    //Routing may not have started yet
+    bool has_occ = (route_ctx.rr_node_route_inf.size() == rr_graph.nodes().size());
+
+    for (const RRNodeId& inode : rr_graph.nodes()) {
+        int xlow = rr_graph.node_xlow(inode);
+        int ylow = rr_graph.node_ylow(inode);
+        rr_index.bins[xlow][ylow].push_back(inode);
+        rr_index.max_span = std::max(rr_index.max_span, rr_graph.node_xhigh(inode) - xlow);
+        rr_index.max_span = std::max(rr_index.max_span, rr_graph.node_yhigh(inode) - ylow);
+
+        int occ = has_occ ? route_ctx.rr_node_route_inf[inode].occ() : 0;
+        int capacity = rr_graph.node_capacity(inode);
+        if (rr_graph.node_type(inode) == CHANX) {
+            for (int x = xlow; x <= rr_graph.node_xhigh(inode); ++x) {
+                rr_index.chanx_occ[x][ylow] += occ;
+                rr_index.chanx_capacity[x][ylow] += capacity;
+            }
+        } else if (rr_graph.node_type(inode) == CHANY) {
+            for (int y = ylow; y <= rr_graph.node_yhigh(inode); ++y) {
+                rr_index.chany_occ[xlow][y] += occ;
+                rr_index.chany_capacity[xlow][y] += capacity;
+            }
         }
     }
+}
 
-    drawroute(HIGHLIGHTED, g);
+static vtr::Rect<int> get_visible_grid_region(ezgl::renderer* g) {
+    /* Returns the grid locations which are (partly) visible, with a margin of     *
+     * one location, so that the edges to the nodes just off screen are also drawn. */
+    t_draw_coords* draw_coords = get_draw_coords_vars();
+    auto& device_ctx = g_vpr_ctx.device();
+
+    int width = device_ctx.grid.width();
+    int height = device_ctx.grid.height();
+
+    //The last grid location starting before the given coordinate
+    auto find_grid_location = [](const float* tile_coords, int num_tiles, double coord) {
+        return int(std::upper_bound(tile_coords, tile_coords + num_tiles, coord) - tile_coords) - 1;
+    };
+
+    ezgl::rectangle world = g->get_visible_world();
+    int xmin = find_grid_location(draw_coords->tile_x, width, world.left()) - 1;
+    int xmax = find_grid_location(draw_coords->tile_x, width, world.right()) + 1;
+    int ymin = find_grid_location(draw_coords->tile_y, height, world.bottom()) - 1;
+    int ymax = find_grid_location(draw_coords->tile_y, height, world.top()) + 1;
+
+    return vtr::Rect<int>(std::max(xmin, 0), std::max(ymin, 0),
+                          std::min(xmax, width - 1), std::min(ymax, height - 1));
+}
+
+static bool is_rr_node_in_region(const RRNodeId& inode, const vtr::Rect<int>& region) {
+    auto& rr_graph = g_vpr_ctx.device().rr_graph;
+
+    return rr_graph.node_xhigh(inode) >= region.xmin() && rr_graph.node_xlow(inode) <= region.xmax()
+           && rr_graph.node_yhigh(inode) >= region.ymin() && rr_graph.node_ylow(inode) <= region.ymax();
+}
+
+static bool is_rr_zoomed_out(ezgl::renderer* g) {
+    /* Returns true if the tiles are too small on screen to tell the wires apart */
+    t_draw_coords* draw_coords = get_draw_coords_vars();
+
+    ezgl::rectangle tile_world({draw_coords->tile_x[0], draw_coords->tile_y[0]},
+                               draw_coords->get_tile_width(), draw_coords->get_tile_height());
+    ezgl::rectangle tile_screen = g->world_to_screen(tile_world);
+
+    return std::abs(tile_screen.width()) < MIN_TILE_SCREEN_WIDTH_TO_DRAW_RR;
+}
+
+static void draw_rr_chan_heatmap(const vtr::Rect<int>& region, ezgl::renderer* g) {
+    /* Fills each visible channel segment with the color of the occupancy *
+     * of its wires, i.e. the ratio of the total occupancy to the total   *
+     * capacity of the wires passing through it.                          */
+    t_draw_state* draw_state = get_draw_state_vars();
+    t_draw_coords* draw_coords = get_draw_coords_vars();
+    const t_draw_rr_index& rr_index = draw_state->rr_index;
+
+    vtr::PlasmaColorMap cmap(0., 1.);
+
+    int width = rr_index.bins.dim_size(0);
+    int height = rr_index.bins.dim_size(1);
+    for (int x = region.xmin(); x <= region.xmax(); ++x) {
+        for (int y = region.ymin(); y <= region.ymax(); ++y) {
+            float tile_xmax = draw_coords->tile_x[x] + draw_coords->get_tile_width();
+            float tile_ymax = draw_coords->tile_y[y] + draw_coords->get_tile_height();
+
+            //CHANX segments lie above the tiles, CHANY segments to their right
+            if (rr_index.chanx_capacity[x][y] > 0 && y + 1 < height) {
+                float occ_ratio = std::min(1.f, float(rr_index.chanx_occ[x][y]) / rr_index.chanx_capacity[x][y]);
+                g->set_color(to_ezgl_color(cmap.color(occ_ratio)));
+                g->fill_rectangle({draw_coords->tile_x[x], tile_ymax}, {tile_xmax, draw_coords->tile_y[y + 1]});
+            }
+            if (rr_index.chany_capacity[x][y] > 0 && x + 1 < width) {
+                float occ_ratio = std::min(1.f, float(rr_index.chany_occ[x][y]) / rr_index.chany_capacity[x][y]);
+                g->set_color(to_ezgl_color(cmap.color(occ_ratio)));
+                g->fill_rectangle({tile_xmax, draw_coords->tile_y[y]}, {draw_coords->tile_x[x + 1], tile_ymax});
+            }
+        }
+    }
 }
 
 static void draw_rr_chan(const RRNodeId& inode, const ezgl::color color, ezgl::renderer* g) {
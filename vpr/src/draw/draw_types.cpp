@@ -7,6 +7,18 @@
 #    include "draw.h"
 #    include <utility>
 
+/**********************************************
+ * begin t_draw_rr_index function definitions *
+ **********************************************/
+void t_draw_rr_index::clear() {
+    bins.clear();
+    max_span = 0;
+    chanx_occ.clear();
+    chanx_capacity.clear();
+    chany_occ.clear();
+    chany_capacity.clear();
+}
+
 /*******************************************
  * begin t_draw_state function definitions *
  *******************************************/
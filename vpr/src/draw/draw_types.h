@@ -26,6 +26,7 @@
 #    include "vpr_types.h"
 #    include "vtr_color_map.h"
 #    include "vtr_vector.h"
+#    include "vtr_ndmatrix.h"
 
 #    include "ezgl/point.hpp"
 #    include "ezgl/rectangle.hpp"
@@ -123,6 +124,32 @@ typedef struct {
     bool node_highlighted;
 } t_draw_rr_node;
 
+/* Spatial index of the rr_nodes, so that only the routing resources in the
+ * visible part of the world are drawn. It is built at the first drawing of the
+ * routing resources, and cleared at each screen update (see update_screen()),
+ * as the routing may have changed since.
+ * bins: the rr_nodes whose low corner (xlow, ylow) is at each grid location.
+ *       [0..device_ctx.grid.width()-1][0..device_ctx.grid.height()-1]
+ * max_span: the max. number of grid locations spanned by an rr_node beyond its
+ *           low corner, so that the rr_nodes overlapping a region of the grid
+ *           are in the bins of the region extended by max_span towards the origin
+ * chanx_occ, chanx_capacity: the total occupancy and capacity of the CHANX wires
+ *           passing through each channel segment, which are drawn as a heatmap
+ *           when zoomed out too far to tell the wires apart (likewise for CHANY).
+ *           [0..device_ctx.grid.width()-1][0..device_ctx.grid.height()-1]
+ */
+struct t_draw_rr_index {
+    vtr::Matrix<std::vector<RRNodeId>> bins;
+    int max_span = 0;
+    vtr::Matrix<int> chanx_occ;
+    vtr::Matrix<int> chanx_capacity;
+    vtr::Matrix<int> chany_occ;
+    vtr::Matrix<int> chany_capacity;
+
+    bool empty() const { return bins.empty(); }
+    void clear();
+};
+
 /* Structure used to store state variables that control drawing and
  * highlighting.
  * pic_on_screen: What to draw on the screen (PLACEMENT, ROUTING, or
@@ -151,6 +178,7 @@ typedef struct {
  *				 Used to control drawing each routing resource when
  *				 ROUTING is on screen.
  *				 [0..device_ctx.rr_nodes.size()-1]
+ * rr_index: spatial index of the routing resources to draw
  * save_graphics: Whether to generate an output graphcis file
  */
 struct t_draw_state {
@@ -173,6 +201,7 @@ struct t_draw_state {
     char default_message[vtr::bufsize];
     vtr::vector<ClusterNetId, ezgl::color> net_color;
     vtr::vector<RRNodeId, t_draw_rr_node> draw_rr_node;
+    t_draw_rr_index rr_index;
     std::shared_ptr<const SetupTimingInfo> setup_timing_info;
     const t_arch* arch_info = nullptr;
     std::unique_ptr<const vtr::ColorMap> color_map = nullptr;
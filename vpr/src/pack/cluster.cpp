@@ -151,7 +151,7 @@ static void check_for_duplicate_inputs ();
 static bool is_atom_blk_in_pb(const AtomBlockId blk_id, const t_pb* pb);
 
 static void add_molecule_to_pb_stats_candidates(t_pack_molecule* molecule,
-                                                std::map<AtomBlockId, float>& gain,
+                                                t_atom_block_gains& gain,
                                                 t_pb* pb,
                                                 int max_queue_size);
 
@@ -322,7 +322,7 @@ static std::vector<AtomBlockId> initialize_seed_atoms(const e_cluster_seed seed_
 
 static t_pack_molecule* get_highest_gain_seed_molecule(int* seedindex, const std::multimap<AtomBlockId, t_pack_molecule*>& atom_molecules, const std::vector<AtomBlockId> seed_atoms);
 
-static float get_molecule_gain(t_pack_molecule* molecule, std::map<AtomBlockId, float>& blk_gain);
+static float get_molecule_gain(t_pack_molecule* molecule, t_atom_block_gains& blk_gain);
 static int compare_molecule_gain(const void* a, const void* b);
 int net_sinks_reachable_in_cluster(const t_pb_graph_pin* driver_pb_gpin, const int depth, const AtomNetId net_id);
 
@@ -810,7 +810,7 @@ static bool is_atom_blk_in_pb(const AtomBlockId blk_id, const t_pb* pb) {
 
 /* Add blk to list of feasible blocks sorted according to gain */
 static void add_molecule_to_pb_stats_candidates(t_pack_molecule* molecule,
-                                                std::map<AtomBlockId, float>& gain,
+                                                t_atom_block_gains& gain,
                                                 t_pb* pb,
                                                 int max_queue_size) {
     int i, j;
@@ -821,12 +821,15 @@ static void add_molecule_to_pb_stats_candidates(t_pack_molecule* molecule,
         }
     }
 
+    /* The gain of the molecule does not change during the insertion, only calculate it once */
+    float molecule_gain = get_molecule_gain(molecule, gain);
+
     if (pb->pb_stats->num_feasible_blocks >= max_queue_size - 1) {
         /* maximum size for array, remove smallest gain element and sort */
-        if (get_molecule_gain(molecule, gain) > get_molecule_gain(pb->pb_stats->feasible_blocks[0], gain)) {
+        if (molecule_gain > get_molecule_gain(pb->pb_stats->feasible_blocks[0], gain)) {
             /* single loop insertion sort */
             for (j = 0; j < pb->pb_stats->num_feasible_blocks - 1; j++) {
-                if (get_molecule_gain(molecule, gain) <= get_molecule_gain(pb->pb_stats->feasible_blocks[j + 1], gain)) {
+                if (molecule_gain <= get_molecule_gain(pb->pb_stats->feasible_blocks[j + 1], gain)) {
                     pb->pb_stats->feasible_blocks[j] = molecule;
                     break;
                 } else {
@@ -840,7 +843,7 @@ static void add_molecule_to_pb_stats_candidates(t_pack_molecule* molecule,
     } else {
         /* Expand array and single loop insertion sort */
         for (j = pb->pb_stats->num_feasible_blocks - 1; j >= 0; j--) {
-            if (get_molecule_gain(pb->pb_stats->feasible_blocks[j], gain) > get_molecule_gain(molecule, gain)) {
+            if (get_molecule_gain(pb->pb_stats->feasible_blocks[j], gain) > molecule_gain) {
                 pb->pb_stats->feasible_blocks[j + 1] = pb->pb_stats->feasible_blocks[j];
             } else {
                 pb->pb_stats->feasible_blocks[j + 1] = molecule;
@@ -2742,7 +2745,7 @@ static t_pack_molecule* get_highest_gain_seed_molecule(int* seedindex, const std
  * + molecule_base_gain*some_factor
  * - introduced_input_nets_of_unrelated_blocks_pulled_in_by_molecule*some_other_factor
  */
-static float get_molecule_gain(t_pack_molecule* molecule, std::map<AtomBlockId, float>& blk_gain) {
+static float get_molecule_gain(t_pack_molecule* molecule, t_atom_block_gains& blk_gain) {
     float gain;
     int i;
     int num_introduced_inputs_of_indirectly_related_block;
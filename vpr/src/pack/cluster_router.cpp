@@ -44,6 +44,9 @@
 enum e_commit_remove { RT_COMMIT,
                        RT_REMOVE };
 
+/* Number of unroutable routing problems remembered by each router */
+constexpr size_t MAX_FAILED_ROUTE_SIGNATURES = 512;
+
 // TODO: check if this hacky class memory reserve thing is still necessary, if not, then delete
 /* Packing uses a priority queue that requires a large number of elements.  This backdoor
  * allows me to use a priority queue where I can pre-allocate the # of elements in the underlying container
@@ -107,6 +110,9 @@ static bool is_route_success(t_lb_router_data* router_data);
 static t_lb_trace* find_node_in_rt(t_lb_trace* rt, int rt_index);
 static void reset_explored_node_tb(t_lb_router_data* router_data);
 static void save_and_reset_lb_route(t_lb_router_data* router_data);
+static void load_saved_lb_route(t_lb_router_data* router_data, std::unordered_map<const t_pb_graph_node*, const t_mode*>* mode_map, t_mode_selection_status* mode_status);
+static bool is_rt_in_current_modes(const t_lb_trace* rt, const t_lb_router_data* router_data);
+static std::vector<size_t> get_lb_route_signature(const t_lb_router_data* router_data, const t_mode_selection_status* mode_status);
 static void load_trace_to_pb_route(t_pb_routes& pb_route, const int total_pins, const AtomNetId net_id, const int prev_pin_id, const t_lb_trace* trace);
 
 static std::string describe_lb_type_rr_node(int inode,
@@ -408,6 +414,16 @@ bool try_intra_lb_route(t_lb_router_data* router_data,
     bool is_routed = false;
     bool is_impossible = false;
 
+    /* Reject the routing problems already found to be unroutable */
+    std::vector<size_t> route_signature = get_lb_route_signature(router_data, mode_status);
+    if (router_data->failed_route_signatures.count(route_signature)) {
+        VTR_LOGV(verbosity > 3, "Skipping routing of %s cluster: same routing problem as a previous unroutable attempt\n",
+                 router_data->lb_type->name);
+        mode_status->is_mode_conflict = false;
+        mode_status->try_expand_all_modes = false;
+        return false;
+    }
+
     mode_status->is_mode_conflict = false;
     mode_status->try_expand_all_modes = false;
 
@@ -430,6 +446,11 @@ bool try_intra_lb_route(t_lb_router_data* router_data,
 
     std::unordered_map<const t_pb_graph_node*, const t_mode*> mode_map;
 
+    if (router_data->params.incremental) {
+        /* The nets whose route is still legal are skipped by the router */
+        load_saved_lb_route(router_data, &mode_map, mode_status);
+    }
+
     /*	Iteratively remove congestion until a successful route is found.
      * Cap the total number of iterations tried so that if a solution does not exist, then the router won't run indefinitely */
     router_data->pres_con_fac = router_data->params.pres_fac;
@@ -534,6 +555,14 @@ bool try_intra_lb_route(t_lb_router_data* router_data,
             free_lb_net_rt(lb_nets[inet].rt_tree);
             lb_nets[inet].rt_tree = nullptr;
         }
+
+        //Remember the problem, unless it is re-tried with other modes
+        if (!mode_status->is_mode_issue()) {
+            if (router_data->failed_route_signatures.size() >= MAX_FAILED_ROUTE_SIGNATURES) {
+                router_data->failed_route_signatures.clear();
+            }
+            router_data->failed_route_signatures.insert(std::move(route_signature));
+        }
     }
     return is_routed;
 }
@@ -1356,6 +1385,95 @@ static void save_and_reset_lb_route(t_lb_router_data* router_data) {
     }
 }
 
+/* Load the last successful route of the nets whose terminals did not change since, and commit it */
+static void load_saved_lb_route(t_lb_router_data* router_data, std::unordered_map<const t_pb_graph_node*, const t_mode*>* mode_map, t_mode_selection_status* mode_status) {
+    if (router_data->saved_lb_nets == nullptr) {
+        return;
+    }
+
+    std::vector<t_intra_lb_net>& lb_nets = *router_data->intra_lb_nets;
+    const std::vector<t_intra_lb_net>& saved_lb_nets = *router_data->saved_lb_nets;
+
+    std::unordered_map<AtomNetId, int> saved_net_index;
+    for (int inet = 0; inet < (int)saved_lb_nets.size(); inet++) {
+        saved_net_index[saved_lb_nets[inet].atom_net_id] = inet;
+    }
+
+    for (unsigned int inet = 0; inet < lb_nets.size(); inet++) {
+        VTR_ASSERT(lb_nets[inet].rt_tree == nullptr);
+
+        auto itr = saved_net_index.find(lb_nets[inet].atom_net_id);
+        if (itr == saved_net_index.end()) {
+            continue; /* New net */
+        }
+
+        const t_intra_lb_net& saved_lb_net = saved_lb_nets[itr->second];
+        if (saved_lb_net.rt_tree == nullptr
+            || saved_lb_net.terminals != lb_nets[inet].terminals
+            || !is_rt_in_current_modes(saved_lb_net.rt_tree, router_data)) {
+            continue; /* Modified net, or route no longer available */
+        }
+
+        lb_nets[inet].rt_tree = new t_lb_trace(*saved_lb_net.rt_tree);
+        commit_remove_rt(lb_nets[inet].rt_tree, router_data, RT_COMMIT, mode_map, mode_status);
+    }
+
+    if (mode_status->is_mode_conflict) {
+        /* The saved routes do not fit together anymore, route from scratch */
+        for (unsigned int inet = 0; inet < lb_nets.size(); inet++) {
+            commit_remove_rt(lb_nets[inet].rt_tree, router_data, RT_REMOVE, mode_map, mode_status);
+            free_lb_net_rt(lb_nets[inet].rt_tree);
+            lb_nets[inet].rt_tree = nullptr;
+        }
+        for (unsigned int inode = 0; inode < router_data->lb_type_graph->size(); inode++) {
+            router_data->lb_rr_node_stats[inode].historical_usage = 0;
+        }
+        mode_map->clear();
+        mode_status->is_mode_conflict = false;
+    }
+}
+
+/* Returns true if all edges of a route tree are edges the router can currently expand, i.e. edges of the mode of their driver */
+static bool is_rt_in_current_modes(const t_lb_trace* rt, const t_lb_router_data* router_data) {
+    const std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+    int inode = rt->current_node;
+
+    int mode = router_data->lb_rr_node_stats[inode].mode;
+    if (mode == -1) {
+        mode = 0;
+    }
+
+    for (const t_lb_trace& next_node : rt->next_nodes) {
+        bool found = false;
+        for (int iedge = 0; iedge < lb_type_graph[inode].num_fanout[mode] && !found; iedge++) {
+            found = (lb_type_graph[inode].outedges[mode][iedge].node_index == next_node.current_node);
+        }
+        if (!found || !is_rt_in_current_modes(&next_node, router_data)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Signature of the current routing problem: the atoms added to the router with the primitive
+ * and mode of their pbs (which determine the terminals of the nets and the modes of the rr nodes),
+ * and whether all the modes are expanded */
+static std::vector<size_t> get_lb_route_signature(const t_lb_router_data* router_data, const t_mode_selection_status* mode_status) {
+    auto& atom_ctx = g_vpr_ctx.atom();
+
+    std::vector<size_t> signature;
+    signature.reserve(1 + 3 * router_data->atoms_added->size());
+
+    signature.push_back(mode_status->expand_all_modes);
+    for (const auto& kv : *router_data->atoms_added) {
+        const t_pb* pb = atom_ctx.lookup.atom_pb(kv.first);
+        signature.push_back(size_t(kv.first));
+        signature.push_back(reinterpret_cast<size_t>(pb->pb_graph_node));
+        signature.push_back(pb->mode);
+    }
+    return signature;
+}
+
 static std::vector<int> find_congested_rr_nodes(const std::vector<t_lb_type_rr_node>& lb_type_graph,
                                                 const t_lb_rr_node_stats* lb_rr_node_stats) {
     std::vector<int> congested_rr_nodes;
@@ -6,7 +6,9 @@
  *
  * Defines core data structures used in packing
  */
+#include <algorithm>
 #include <map>
+#include <set>
 #include <unordered_map>
 #include <vector>
 
@@ -24,17 +26,84 @@
  * Packing Algorithm Data Structures
  ***************************************************************************/
 
+/* Map from atom blocks to gains (see t_pb_stats), with the same interface as the
+ * std::map's it replaces.
+ *
+ * The entries are stored in flat arrays with open addressing (linear probing).
+ * A pb only touches a small number of blocks, but looks them up many times, which
+ * is much faster than searching a tree. Clearing keeps the arrays, since they are
+ * re-filled with a similar number of blocks. */
+class t_atom_block_gains {
+  public:
+    /* Returns 1 if blk has a gain, 0 otherwise */
+    size_t count(const AtomBlockId blk) const {
+        if (keys_.empty()) return 0;
+        return keys_[find_slot(blk)] == blk ? 1 : 0;
+    }
+
+    /* Returns the gain of blk, inserting a zero gain if it has none */
+    float& operator[](const AtomBlockId blk) {
+        if (2 * (size_ + 1) > keys_.size()) {
+            grow();
+        }
+
+        size_t slot = find_slot(blk);
+        if (keys_[slot] != blk) {
+            keys_[slot] = blk;
+            values_[slot] = 0.;
+            ++size_;
+        }
+        return values_[slot];
+    }
+
+    void clear() {
+        std::fill(keys_.begin(), keys_.end(), AtomBlockId::INVALID());
+        size_ = 0;
+    }
+
+  private:
+    /* Returns the slot holding blk, or the empty slot where it would be inserted */
+    size_t find_slot(const AtomBlockId blk) const {
+        size_t mask = keys_.size() - 1;
+        size_t slot = (size_t(blk) * 2654435761u) & mask;
+        while (keys_[slot] && keys_[slot] != blk) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    void grow() {
+        std::vector<AtomBlockId> old_keys(std::max<size_t>(16, 2 * keys_.size()), AtomBlockId::INVALID());
+        std::vector<float> old_values(old_keys.size());
+        std::swap(old_keys, keys_);
+        std::swap(old_values, values_);
+
+        for (size_t i = 0; i < old_keys.size(); ++i) {
+            if (old_keys[i]) {
+                size_t slot = find_slot(old_keys[i]);
+                keys_[slot] = old_keys[i];
+                values_[slot] = old_values[i];
+            }
+        }
+    }
+
+  private:
+    std::vector<AtomBlockId> keys_; /* Invalid for empty slots, the size is a power of two */
+    std::vector<float> values_;
+    size_t size_ = 0;
+};
+
 /* Stores statistical information for a physical cluster_ctx.blocks such as costs and usages */
 struct t_pb_stats {
     /* Packing statistics */
-    std::map<AtomBlockId, float> gain; /* Attraction (inverse of cost) function */
+    t_atom_block_gains gain; /* Attraction (inverse of cost) function */
 
-    std::map<AtomBlockId, float> timinggain;     /* The timing criticality score of this atom cluster_ctx.blocks.
-                                                  * Determined by the most critical atom net
-                                                  * between this atom cluster_ctx.blocks and any atom cluster_ctx.blocks in
-                                                  * the current pb */
-    std::map<AtomBlockId, float> connectiongain; /* Weighted sum of connections to attraction function */
-    std::map<AtomBlockId, float> sharinggain;    /* How many nets on an atom cluster_ctx.blocks are already in the pb under consideration */
+    t_atom_block_gains timinggain;     /* The timing criticality score of this atom cluster_ctx.blocks.
+                                        * Determined by the most critical atom net
+                                        * between this atom cluster_ctx.blocks and any atom cluster_ctx.blocks in
+                                        * the current pb */
+    t_atom_block_gains connectiongain; /* Weighted sum of connections to attraction function */
+    t_atom_block_gains sharinggain;    /* How many nets on an atom cluster_ctx.blocks are already in the pb under consideration */
 
     /* This is the gain used for hill-climbing. It stores*
      * the reduction in the number of pins that adding this atom cluster_ctx.blocks to the the*
@@ -42,7 +111,7 @@ struct t_pb_stats {
      * addition of an atom cluster_ctx.blocks to a pb may reduce the number of inputs     *
      * required if it shares inputs with all other BLEs and it's output is  *
      * used by all other child pbs in this parent pb.                               */
-    std::map<AtomBlockId, float> hillgain;
+    t_atom_block_gains hillgain;
 
     std::vector<AtomNetId> marked_nets;     //List of nets with the num_pins_of_net_in_pb and gain entries altered
     std::vector<AtomBlockId> marked_blocks; //List of blocks with the num_pins_of_net_in_pb and gain entries altered
@@ -169,6 +238,7 @@ struct t_lb_router_params {
     float pres_fac;
     float pres_fac_mult;
     float hist_fac;
+    bool incremental; /* Start from the last successful route of the nets whose terminals did not change, and only route the other nets */
 };
 
 /* Node expanded by router */
@@ -242,6 +312,9 @@ struct t_lb_router_data {
     /* current congestion factor */
     float pres_con_fac;
 
+    /* Signatures (see get_lb_route_signature()) of the recent routing problems which were found to be unroutable */
+    std::set<std::vector<size_t>> failed_route_signatures;
+
     t_lb_router_data() {
         lb_type_graph = nullptr;
         lb_rr_node_stats = nullptr;
@@ -257,6 +330,7 @@ struct t_lb_router_data {
         params.pres_fac = 1;
         params.pres_fac_mult = 2;
         params.hist_fac = 0.3;
+        params.incremental = true;
 
         pres_con_fac = 1;
     }
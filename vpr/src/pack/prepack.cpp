@@ -14,6 +14,7 @@
 #include <cstring>
 #include <map>
 #include <queue>
+#include <unordered_map>
 #include <utility>
 
 #include "vtr_util.h"
@@ -60,6 +61,8 @@ static void backward_expand_pack_pattern_from_edge(const t_pb_graph_edge* expans
 
 static int compare_pack_pattern(const t_pack_patterns* pattern_a, const t_pack_patterns* pattern_b);
 
+static const t_pb_type* get_pattern_root_pb_type(const t_pack_patterns* pack_pattern);
+
 static void free_pack_pattern(t_pack_pattern_block* pattern_block, t_pack_pattern_block** pattern_block_list);
 
 static t_pack_molecule* try_create_molecule(t_pack_patterns* list_of_pack_patterns,
@@ -785,6 +788,13 @@ t_pack_molecule* alloc_and_load_pack_molecules(t_pack_patterns* list_of_pack_pat
 
     cur_molecule = list_of_molecules_head = nullptr;
 
+    /* Only the atom blocks of the model of the root of a pattern can be the root of a molecule of this
+     * pattern, so index the atom blocks by model (in id order) to try only those */
+    std::unordered_map<const t_model*, std::vector<AtomBlockId>> blocks_of_model;
+    for (auto blk_id : atom_ctx.nlist.blocks()) {
+        blocks_of_model[atom_ctx.nlist.block_model(blk_id)].push_back(blk_id);
+    }
+
     /* Find forced pack patterns
      * Simplifying assumptions: Each atom can map to at most one molecule,
      *                          use first-fit mapping based on priority of pattern
@@ -809,9 +819,20 @@ t_pack_molecule* alloc_and_load_pack_molecules(t_pack_patterns* list_of_pack_pat
         VTR_ASSERT(is_used[best_pattern] == false); 
         is_used[best_pattern] = true;
 
-        auto blocks = atom_ctx.nlist.blocks();
-        for (auto blk_iter = blocks.begin(); blk_iter != blocks.end(); ++blk_iter) {
-            auto blk_id = *blk_iter;
+        const t_pb_type* root_pb_type = get_pattern_root_pb_type(&list_of_pack_patterns[best_pattern]);
+        if (root_pb_type == nullptr) {
+            continue;
+        }
+        auto blocks_itr = blocks_of_model.find(root_pb_type->model);
+        if (blocks_itr == blocks_of_model.end()) {
+            continue;
+        }
+
+        const std::vector<AtomBlockId>& blocks = blocks_itr->second;
+        size_t iblk = 0;
+        while (iblk < blocks.size()) {
+            auto blk_id = blocks[iblk];
+            bool retry_blk = false;
 
             cur_molecule = try_create_molecule(list_of_pack_patterns, atom_molecules, best_pattern, blk_id);
             if (cur_molecule != nullptr) {
@@ -835,9 +856,13 @@ t_pack_molecule* alloc_and_load_pack_molecules(t_pack_patterns* list_of_pack_pat
                 if (range_empty || !cur_was_last_inserted) {
                     /* molecule did not cover current atom (possibly because molecule created is
                      * part of a long chain that extends past multiple logic blocks), try again */
-                    --blk_iter;
+                    retry_blk = true;
                 }
             }
+
+            if (!retry_blk) {
+                ++iblk;
+            }
         }
     }
     free(is_used);
@@ -931,6 +956,13 @@ static t_pack_molecule* try_create_molecule(t_pack_patterns* list_of_pack_patter
         if (!blk_id) return nullptr;
     }
 
+    // Early rejection of roots which can not start a molecule, before building it
+    // (see the stopping conditions of try_expand_molecule())
+    if (!pack_pattern->is_block_optional[pack_pattern->root_block->block_id]
+        && (atom_molecules.count(blk_id) || !primitive_type_feasible(blk_id, pack_pattern->root_block->pb_type))) {
+        return nullptr;
+    }
+
     molecule = new t_pack_molecule;
     molecule->valid = true;
     molecule->type = MOLECULE_FORCED_PACK;
@@ -1267,6 +1299,21 @@ static int compare_pack_pattern(const t_pack_patterns* pattern_a, const t_pack_p
     return 0;
 }
 
+/* Returns the primitive type an atom block must be feasible for to be the root of a molecule of a pattern,
+ * or nullptr if the pattern can not form any molecule */
+static const t_pb_type* get_pattern_root_pb_type(const t_pack_patterns* pack_pattern) {
+    if (pack_pattern->num_blocks == 0 || pack_pattern->root_block == nullptr) {
+        return nullptr;
+    }
+
+    // The root of a chain molecule is searched for from any atom of the chain
+    // (see find_new_root_atom_for_chain())
+    if (pack_pattern->is_chain && !pack_pattern->chain_root_pins.empty()) {
+        return pack_pattern->chain_root_pins[0][0]->parent_node->pb_type;
+    }
+    return pack_pattern->root_block->pb_type;
+}
+
 /* A chain can extend across multiple atom blocks.  Must segment the chain to fit in an atom
  * block by identifying the actual atom that forms the root of the new chain.
  * Returns AtomBlockId::INVALID() if this block_index doesn't match up with any chain
@@ -1276,7 +1323,6 @@ static int compare_pack_pattern(const t_pack_patterns* pattern_a, const t_pack_p
  * list_of_pack_pattern: ptr to current chain pattern
  */
 static AtomBlockId find_new_root_atom_for_chain(const AtomBlockId blk_id, const t_pack_patterns* list_of_pack_pattern, const std::multimap<AtomBlockId, t_pack_molecule*>& atom_molecules) {
-    AtomBlockId new_root_blk_id;
     t_pb_graph_pin* root_ipin;
     t_pb_graph_node* root_pb_graph_node;
     t_model_ports* model_port;
@@ -1295,30 +1341,35 @@ static AtomBlockId find_new_root_atom_for_chain(const AtomBlockId blk_id, const
     /* Assign driver furthest up the chain that matches the root node and is unassigned to a molecule as the root */
     model_port = root_ipin->port->model_port;
 
-    // find the block id of the atom block driving the input of this block
-    AtomBlockId driver_blk_id = atom_ctx.nlist.find_atom_pin_driver(blk_id, model_port, root_ipin->pin_number);
+    // walk up the chain iteratively, since chains can be long. The number of steps
+    // is bounded by the number of blocks in case the chain is a loop
+    AtomBlockId root_blk_id = blk_id;
+    for (size_t num_steps = 0; num_steps < atom_ctx.nlist.blocks().size(); ++num_steps) {
+        // find the block id of the atom block driving the input of this block
+        AtomBlockId driver_blk_id = atom_ctx.nlist.find_atom_pin_driver(root_blk_id, model_port, root_ipin->pin_number);
 
-    // if there is no driver block for this net
-    // then it is the furthest up the chain
-    if (!driver_blk_id) {
-        return blk_id;
-    }
-    // check if driver atom is already packed
-    auto rng = atom_molecules.equal_range(driver_blk_id);
-    bool rng_empty = (rng.first == rng.second);
-    if (!rng_empty) {
-        /* Driver is used/invalid, so current block is the furthest up the chain, return it */
-        return blk_id;
-    }
+        // if there is no driver block for this net
+        // then it is the furthest up the chain
+        if (!driver_blk_id) {
+            break;
+        }
 
-    // didn't find furthest atom up the chain, keep searching further up the chain
-    new_root_blk_id = find_new_root_atom_for_chain(driver_blk_id, list_of_pack_pattern, atom_molecules);
+        // check if driver atom is already packed
+        if (atom_molecules.count(driver_blk_id)) {
+            /* Driver is used/invalid, so current block is the furthest up the chain */
+            break;
+        }
 
-    if (!new_root_blk_id) {
-        return blk_id;
-    } else {
-        return new_root_blk_id;
+        // the driver can only continue the chain if it matches the root node
+        if (primitive_type_feasible(driver_blk_id, root_pb_graph_node->pb_type) == false) {
+            break;
+        }
+
+        // didn't find furthest atom up the chain, keep searching further up the chain
+        root_blk_id = driver_blk_id;
     }
+
+    return root_blk_id;
 }
 
 /**
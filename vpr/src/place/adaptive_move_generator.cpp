@@ -0,0 +1,58 @@
+#include "adaptive_move_generator.h"
+
+#include <cmath>
+
+#include "vtr_assert.h"
+#include "vtr_random.h"
+
+//Fraction of the moves using a random move generator rather than the best one
+constexpr float ADAPTIVE_MOVE_EXPLORE_PROB = 0.1;
+
+//Decay of the statistics of a move generator at each of its moves (an effective
+//window of about a thousand moves)
+constexpr float ADAPTIVE_MOVE_DECAY = 0.999;
+
+AdaptiveMoveGenerator::AdaptiveMoveGenerator(std::vector<std::unique_ptr<MoveGenerator>> move_generators)
+    : move_generators_(std::move(move_generators))
+    , stats_(move_generators_.size()) {
+    VTR_ASSERT(!move_generators_.empty());
+}
+
+e_create_move AdaptiveMoveGenerator::propose_move(t_pl_blocks_to_be_moved& affected_blocks, float rlim) {
+    if (vtr::frand() < ADAPTIVE_MOVE_EXPLORE_PROB) {
+        last_move_generator_ = vtr::irand(move_generators_.size() - 1);
+    } else {
+        //Move generators without any move yet are tried first
+        float best_rate = -1.;
+        for (size_t igen = 0; igen < move_generators_.size(); ++igen) {
+            float rate = std::numeric_limits<float>::infinity();
+            if (stats_[igen].elapsed_time > 0.) {
+                rate = stats_[igen].num_accepted / stats_[igen].elapsed_time;
+            }
+            if (rate > best_rate) {
+                last_move_generator_ = igen;
+                best_rate = rate;
+            }
+        }
+    }
+
+    return move_generators_[last_move_generator_]->propose_move(affected_blocks, rlim);
+}
+
+e_place_move_generator AdaptiveMoveGenerator::last_move_type() const {
+    return move_generators_[last_move_generator_]->last_move_type();
+}
+
+void AdaptiveMoveGenerator::process_outcome(const MoveOutcomeStats& move_outcome) {
+    move_generators_[last_move_generator_]->process_outcome(move_outcome);
+
+    t_move_generator_stats& stats = stats_[last_move_generator_];
+    stats.num_accepted *= ADAPTIVE_MOVE_DECAY;
+    stats.elapsed_time *= ADAPTIVE_MOVE_DECAY;
+    if (move_outcome.outcome == ACCEPTED) {
+        stats.num_accepted += 1.;
+    }
+    if (!std::isnan(move_outcome.elapsed_time)) {
+        stats.elapsed_time += move_outcome.elapsed_time;
+    }
+}
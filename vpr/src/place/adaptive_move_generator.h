@@ -0,0 +1,38 @@
+#ifndef VPR_ADAPTIVE_MOVE_GEN_H
+#define VPR_ADAPTIVE_MOVE_GEN_H
+#include <memory>
+#include <vector>
+
+#include "move_generator.h"
+
+//Picks one of several move generators for each move, learning during the anneal which
+//of them gives the most accepted moves per second of placement (i.e. the most progress
+//for the time spent proposing and evaluating its moves)
+//
+//The recent acceptance rate of each move generator is tracked with an exponential decay,
+//as the best move type changes with the temperature and the range limit. Most moves use the
+//move generator with the best rate, the remaining ones keep the rates of the others current.
+class AdaptiveMoveGenerator : public MoveGenerator {
+  public:
+    AdaptiveMoveGenerator(std::vector<std::unique_ptr<MoveGenerator>> move_generators);
+
+    e_create_move propose_move(t_pl_blocks_to_be_moved& affected_blocks, float rlim) override;
+
+    void process_outcome(const MoveOutcomeStats& move_outcome) override;
+
+    e_place_move_generator last_move_type() const override;
+
+  private:
+    struct t_move_generator_stats {
+        float num_accepted = 0.; //Decayed number of accepted moves
+        float elapsed_time = 0.; //Decayed time spent in moves (seconds)
+    };
+
+    std::vector<std::unique_ptr<MoveGenerator>> move_generators_;
+    std::vector<t_move_generator_stats> stats_;
+
+    //Move generator of the last proposed move
+    size_t last_move_generator_ = 0;
+};
+
+#endif
@@ -0,0 +1,357 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <tuple>
+
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+#include "vpr_error.h"
+#include "vpr_utils.h"
+#include "globals.h"
+#include "place_macro.h"
+#include "analytic_placement.h"
+
+/* Nets with more pins are ignored by the analytic placement: their clique *
+ * model would be too large, and they pull all their blocks together.     */
+constexpr size_t MAX_ANALYTIC_NET_PINS = 64;
+
+/* Weight of the connection of each moved block to the center of the     *
+ * device, which keeps the system definite for blocks which are not       *
+ * (transitively) connected to any anchor.                                */
+constexpr double CENTER_ANCHOR_WEIGHT = 1e-3;
+
+/* Conjugate Gradient stops once the residual norm is below this fraction *
+ * of the norm of the right hand side, or after MAX_CG_ITERATIONS.        */
+constexpr double CG_TOLERANCE = 1e-6;
+constexpr int MAX_CG_ITERATIONS = 1000;
+
+namespace {
+
+//Symmetric sparse matrix in compressed sparse row format
+struct t_sparse_matrix {
+    std::vector<size_t> row_starts;
+    std::vector<size_t> cols;
+    std::vector<double> values;
+
+    size_t num_rows() const { return row_starts.size() - 1; }
+
+    //y = A*x
+    void multiply(const std::vector<double>& x, std::vector<double>& y) const {
+        for (size_t row = 0; row < num_rows(); ++row) {
+            double sum = 0.;
+            for (size_t i = row_starts[row]; i < row_starts[row + 1]; ++i) {
+                sum += values[i] * x[cols[i]];
+            }
+            y[row] = sum;
+        }
+    }
+};
+
+} // namespace
+
+static t_sparse_matrix build_sparse_matrix(size_t num_rows, std::vector<std::tuple<size_t, size_t, double>>& entries);
+static void solve_conjugate_gradient(const t_sparse_matrix& matrix, const std::vector<double>& rhs, std::vector<double>& x);
+static void legalize_blocks(const std::vector<ClusterBlockId>& blocks, const std::vector<double>& x, const std::vector<double>& y);
+static bool find_closest_free_loc(ClusterBlockId blk, double x, double y, t_pl_loc& to);
+static int closest_compressed_index(const std::vector<int>& coords, double point);
+
+void analytic_placement() {
+    vtr::ScopedStartFinishTimer timer("Analytic Initial Placement");
+
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& place_ctx = g_vpr_ctx.placement();
+
+    //Blocks moved by the analytic placement, all the other blocks are anchors
+    std::vector<ClusterBlockId> moved_blocks;
+    vtr::vector<ClusterBlockId, int> block_vars(cluster_ctx.clb_nlist.blocks().size(), OPEN);
+    for (ClusterBlockId blk_id : cluster_ctx.clb_nlist.blocks()) {
+        if (place_ctx.block_locs[blk_id].is_fixed || is_io_type(physical_tile_type(blk_id))) {
+            continue;
+        }
+
+        int imacro;
+        get_imacro_from_iblk(&imacro, blk_id, place_ctx.pl_macros);
+        if (imacro != OPEN) {
+            continue;
+        }
+
+        block_vars[blk_id] = moved_blocks.size();
+        moved_blocks.push_back(blk_id);
+    }
+
+    if (moved_blocks.empty()) {
+        return;
+    }
+
+    double center_x = 0.5 * (device_ctx.grid.width() - 1);
+    double center_y = 0.5 * (device_ctx.grid.height() - 1);
+
+    //The x and y systems share the same matrix
+    size_t num_vars = moved_blocks.size();
+    std::vector<std::tuple<size_t, size_t, double>> entries;
+    std::vector<double> rhs_x(num_vars, 0.);
+    std::vector<double> rhs_y(num_vars, 0.);
+
+    for (size_t ivar = 0; ivar < num_vars; ++ivar) {
+        entries.emplace_back(ivar, ivar, CENTER_ANCHOR_WEIGHT);
+        rhs_x[ivar] += CENTER_ANCHOR_WEIGHT * center_x;
+        rhs_y[ivar] += CENTER_ANCHOR_WEIGHT * center_y;
+    }
+
+    std::vector<ClusterBlockId> net_blocks;
+    for (ClusterNetId net_id : cluster_ctx.clb_nlist.nets()) {
+        if (cluster_ctx.clb_nlist.net_is_ignored(net_id)) {
+            continue;
+        }
+
+        net_blocks.clear();
+        for (ClusterPinId pin_id : cluster_ctx.clb_nlist.net_pins(net_id)) {
+            net_blocks.push_back(cluster_ctx.clb_nlist.pin_block(pin_id));
+        }
+        std::sort(net_blocks.begin(), net_blocks.end());
+        net_blocks.erase(std::unique(net_blocks.begin(), net_blocks.end()), net_blocks.end());
+
+        if (net_blocks.size() < 2 || net_blocks.size() > MAX_ANALYTIC_NET_PINS) {
+            continue;
+        }
+
+        //Clique model, the weights are normalized so that each net contributes about the same
+        double weight = 1. / (net_blocks.size() - 1);
+        for (size_t i = 0; i < net_blocks.size(); ++i) {
+            for (size_t j = i + 1; j < net_blocks.size(); ++j) {
+                int var_i = block_vars[net_blocks[i]];
+                int var_j = block_vars[net_blocks[j]];
+
+                if (var_i != OPEN && var_j != OPEN) {
+                    entries.emplace_back(var_i, var_i, weight);
+                    entries.emplace_back(var_j, var_j, weight);
+                    entries.emplace_back(var_i, var_j, -weight);
+                    entries.emplace_back(var_j, var_i, -weight);
+                } else if (var_i != OPEN || var_j != OPEN) {
+                    int var = (var_i != OPEN) ? var_i : var_j;
+                    const t_pl_loc& anchor = place_ctx.block_locs[(var_i != OPEN) ? net_blocks[j] : net_blocks[i]].loc;
+
+                    entries.emplace_back(var, var, weight);
+                    rhs_x[var] += weight * anchor.x;
+                    rhs_y[var] += weight * anchor.y;
+                }
+            }
+        }
+    }
+
+    t_sparse_matrix matrix = build_sparse_matrix(num_vars, entries);
+
+    //Start from the current (legal) placement
+    std::vector<double> x(num_vars);
+    std::vector<double> y(num_vars);
+    for (size_t ivar = 0; ivar < num_vars; ++ivar) {
+        x[ivar] = place_ctx.block_locs[moved_blocks[ivar]].loc.x;
+        y[ivar] = place_ctx.block_locs[moved_blocks[ivar]].loc.y;
+    }
+
+    solve_conjugate_gradient(matrix, rhs_x, x);
+    solve_conjugate_gradient(matrix, rhs_y, y);
+
+    legalize_blocks(moved_blocks, x, y);
+
+    VTR_LOG("Analytically placed %zu of %zu blocks\n", moved_blocks.size(), cluster_ctx.clb_nlist.blocks().size());
+}
+
+//Builds a matrix from (row, col, value) entries, summing the values of duplicate entries
+static t_sparse_matrix build_sparse_matrix(size_t num_rows, std::vector<std::tuple<size_t, size_t, double>>& entries) {
+    std::sort(entries.begin(), entries.end(),
+              [](const std::tuple<size_t, size_t, double>& lhs, const std::tuple<size_t, size_t, double>& rhs) {
+                  return std::tie(std::get<0>(lhs), std::get<1>(lhs)) < std::tie(std::get<0>(rhs), std::get<1>(rhs));
+              });
+
+    t_sparse_matrix matrix;
+    matrix.row_starts.assign(num_rows + 1, 0);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        size_t row, col;
+        double value;
+        std::tie(row, col, value) = entries[i];
+
+        if (i > 0 && std::get<0>(entries[i - 1]) == row && std::get<1>(entries[i - 1]) == col) {
+            matrix.values.back() += value;
+            continue;
+        }
+
+        matrix.cols.push_back(col);
+        matrix.values.push_back(value);
+        ++matrix.row_starts[row + 1];
+    }
+    std::partial_sum(matrix.row_starts.begin(), matrix.row_starts.end(), matrix.row_starts.begin());
+
+    return matrix;
+}
+
+//Solves matrix*x = rhs with a Jacobi preconditioned Conjugate Gradient, x is the initial guess
+static void solve_conjugate_gradient(const t_sparse_matrix& matrix, const std::vector<double>& rhs, std::vector<double>& x) {
+    size_t n = matrix.num_rows();
+
+    std::vector<double> inv_diag(n, 1.);
+    for (size_t row = 0; row < n; ++row) {
+        for (size_t i = matrix.row_starts[row]; i < matrix.row_starts[row + 1]; ++i) {
+            if (matrix.cols[i] == row) {
+                VTR_ASSERT(matrix.values[i] > 0.);
+                inv_diag[row] = 1. / matrix.values[i];
+            }
+        }
+    }
+
+    auto dot = [](const std::vector<double>& a, const std::vector<double>& b) {
+        return std::inner_product(a.begin(), a.end(), b.begin(), 0.);
+    };
+
+    std::vector<double> r(n), z(n), p(n), q(n);
+    matrix.multiply(x, q);
+    for (size_t i = 0; i < n; ++i) {
+        r[i] = rhs[i] - q[i];
+        z[i] = inv_diag[i] * r[i];
+    }
+    p = z;
+
+    double rz = dot(r, z);
+    double tolerance = CG_TOLERANCE * std::sqrt(dot(rhs, rhs));
+
+    for (int iter = 0; iter < MAX_CG_ITERATIONS && std::sqrt(dot(r, r)) > tolerance; ++iter) {
+        matrix.multiply(p, q);
+        double alpha = rz / dot(p, q);
+
+        for (size_t i = 0; i < n; ++i) {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * q[i];
+            z[i] = inv_diag[i] * r[i];
+        }
+
+        double prev_rz = rz;
+        rz = dot(r, z);
+        double beta = rz / prev_rz;
+        for (size_t i = 0; i < n; ++i) {
+            p[i] = z[i] + beta * p[i];
+        }
+    }
+}
+
+//Moves the blocks to the closest free locations of their solved positions. The blocks closest
+//to the center of the solved positions are legalized first, so that the (dense) center of the
+//placement spreads outwards
+static void legalize_blocks(const std::vector<ClusterBlockId>& blocks, const std::vector<double>& x, const std::vector<double>& y) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& place_ctx = g_vpr_ctx.mutable_placement();
+
+    //Remove the blocks from their current locations
+    for (ClusterBlockId blk_id : blocks) {
+        t_pl_loc loc = place_ctx.block_locs[blk_id].loc;
+        VTR_ASSERT(place_ctx.grid_blocks[loc.x][loc.y].blocks[loc.z] == blk_id);
+
+        place_ctx.grid_blocks[loc.x][loc.y].blocks[loc.z] = EMPTY_BLOCK_ID;
+        --place_ctx.grid_blocks[loc.x][loc.y].usage;
+    }
+
+    double mean_x = std::accumulate(x.begin(), x.end(), 0.) / x.size();
+    double mean_y = std::accumulate(y.begin(), y.end(), 0.) / y.size();
+
+    std::vector<size_t> order(blocks.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+        return std::hypot(x[lhs] - mean_x, y[lhs] - mean_y) < std::hypot(x[rhs] - mean_x, y[rhs] - mean_y);
+    });
+
+    for (size_t iblk : order) {
+        ClusterBlockId blk_id = blocks[iblk];
+
+        t_pl_loc to;
+        if (!find_closest_free_loc(blk_id, x[iblk], y[iblk], to)) {
+            VPR_FATAL_ERROR(VPR_ERROR_PLACE,
+                            "Analytic initial placement failed.\n"
+                            "Could not legalize block %s (#%zu); no free locations of type %s.\n",
+                            cluster_ctx.clb_nlist.block_name(blk_id).c_str(), size_t(blk_id), cluster_ctx.clb_nlist.block_type(blk_id)->name);
+        }
+
+        place_ctx.grid_blocks[to.x][to.y].blocks[to.z] = blk_id;
+        ++place_ctx.grid_blocks[to.x][to.y].usage;
+        place_ctx.block_locs[blk_id].loc = to;
+    }
+}
+
+//Finds the free location closest to (x, y) which can hold blk, searching rings of
+//increasing (Chebyshev) distance in the compressed grid of the block type
+static bool find_closest_free_loc(ClusterBlockId blk, double x, double y, t_pl_loc& to) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& place_ctx = g_vpr_ctx.placement();
+
+    auto blk_type = cluster_ctx.clb_nlist.block_type(blk);
+    const auto& compressed_block_grid = place_ctx.compressed_block_grids[blk_type->index];
+
+    int num_cx = compressed_block_grid.compressed_to_grid_x.size();
+    int num_cy = compressed_block_grid.compressed_to_grid_y.size();
+    if (num_cx == 0 || num_cy == 0) {
+        return false;
+    }
+
+    int cx_target = closest_compressed_index(compressed_block_grid.compressed_to_grid_x, x);
+    int cy_target = closest_compressed_index(compressed_block_grid.compressed_to_grid_y, y);
+
+    //Returns true (and sets to) if a compressed location has a free slot
+    auto find_free_slot = [&](const t_type_loc& type_loc) {
+        const auto& tile = device_ctx.grid[type_loc.x][type_loc.y];
+        if (!is_tile_compatible(tile.type, blk_type)) {
+            return false;
+        }
+
+        const auto& grid_blocks = place_ctx.grid_blocks[type_loc.x][type_loc.y];
+        for (int z = 0; z < tile.type->capacity; ++z) {
+            if (grid_blocks.blocks[z] == EMPTY_BLOCK_ID) {
+                to = t_pl_loc(type_loc.x, type_loc.y, z);
+                return true;
+            }
+        }
+        return false;
+    };
+
+    int max_radius = std::max(num_cx, num_cy);
+    for (int radius = 0; radius <= max_radius; ++radius) {
+        int min_cx = std::max(0, cx_target - radius);
+        int max_cx = std::min(num_cx - 1, cx_target + radius);
+
+        for (int cx = min_cx; cx <= max_cx; ++cx) {
+            const auto& column = compressed_block_grid.grid[cx];
+
+            if (std::abs(cx - cx_target) == radius) {
+                //Ring edge along y, all the locations within the radius
+                for (auto itr = column.lower_bound(cy_target - radius); itr != column.end() && itr->first <= cy_target + radius; ++itr) {
+                    if (find_free_slot(itr->second)) {
+                        return true;
+                    }
+                }
+            } else {
+                //Inside the ring, only the two locations at the radius
+                for (int cy : {cy_target - radius, cy_target + radius}) {
+                    auto itr = column.find(cy);
+                    if (itr != column.end() && find_free_slot(itr->second)) {
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+//Returns the index of the coordinate closest to point in the sorted coords
+static int closest_compressed_index(const std::vector<int>& coords, double point) {
+    auto itr = std::lower_bound(coords.begin(), coords.end(), point);
+    if (itr == coords.end()) {
+        return coords.size() - 1;
+    }
+    if (itr != coords.begin() && point - *(itr - 1) < *itr - point) {
+        --itr;
+    }
+    return std::distance(coords.begin(), itr);
+}
@@ -0,0 +1,15 @@
+#ifndef VPR_ANALYTIC_PLACEMENT_H
+#define VPR_ANALYTIC_PLACEMENT_H
+
+//Improves a legal (e.g. random) initial placement with an analytic placement.
+//
+//The blocks which are not fixed, not part of a macro and not IOs are moved to the
+//positions minimizing the quadratic wirelength of the nets (clique net model), with
+//the other blocks as anchors. The resulting linear systems are solved with a
+//(Jacobi preconditioned) Conjugate Gradient. The moved blocks are then legalized,
+//one after the other, at the closest free location in their compressed grid.
+//
+//The placement (place_ctx.block_locs and place_ctx.grid_blocks) is legal on return.
+void analytic_placement();
+
+#endif
@@ -0,0 +1,101 @@
+#include "critical_move_generator.h"
+#include "globals.h"
+#include "timing_place.h"
+
+#include <cmath>
+
+//Number of random blocks among which the block with the most critical connection is moved
+constexpr int CRITICAL_MOVE_NUM_CANDIDATES = 4;
+
+//Connections of nets with more pins are ignored, since they are slow to scan and
+//barely depend on the location of any one of their blocks
+constexpr size_t CRITICAL_MOVE_MAX_NET_PINS = 64;
+
+//Calls fn(other_pin, criticality) for each connection of the block (with a pin of another block)
+template<typename ConnFunc>
+static void for_each_block_connection(ClusterBlockId blk, ConnFunc fn) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    for (ClusterPinId pin_id : cluster_ctx.clb_nlist.block_pins(blk)) {
+        ClusterNetId net_id = cluster_ctx.clb_nlist.pin_net(pin_id);
+        if (cluster_ctx.clb_nlist.net_is_ignored(net_id)
+            || cluster_ctx.clb_nlist.net_pins(net_id).size() > CRITICAL_MOVE_MAX_NET_PINS) {
+            continue;
+        }
+
+        if (cluster_ctx.clb_nlist.pin_type(pin_id) == PinType::DRIVER) {
+            for (ClusterPinId sink_pin_id : cluster_ctx.clb_nlist.net_sinks(net_id)) {
+                if (cluster_ctx.clb_nlist.pin_block(sink_pin_id) != blk) {
+                    fn(sink_pin_id, get_timing_place_crit(net_id, cluster_ctx.clb_nlist.pin_net_index(sink_pin_id)));
+                }
+            }
+        } else {
+            ClusterPinId driver_pin_id = cluster_ctx.clb_nlist.net_driver(net_id);
+            if (driver_pin_id && cluster_ctx.clb_nlist.pin_block(driver_pin_id) != blk) {
+                fn(driver_pin_id, get_timing_place_crit(net_id, cluster_ctx.clb_nlist.pin_net_index(pin_id)));
+            }
+        }
+    }
+}
+
+e_create_move CriticalMoveGenerator::propose_move(t_pl_blocks_to_be_moved& blocks_affected, float /*rlim*/) {
+    ClusterBlockId b_from;
+    float b_from_crit = 0.;
+    for (int icandidate = 0; icandidate < CRITICAL_MOVE_NUM_CANDIDATES; ++icandidate) {
+        ClusterBlockId candidate = pick_from_block();
+        if (!candidate) {
+            break;
+        }
+
+        float candidate_crit = 0.;
+        for_each_block_connection(candidate, [&](ClusterPinId /*other_pin*/, float crit) {
+            candidate_crit = std::max(candidate_crit, crit);
+        });
+
+        if (!b_from || candidate_crit > b_from_crit) {
+            b_from = candidate;
+            b_from_crit = candidate_crit;
+        }
+    }
+
+    if (!b_from) {
+        return e_create_move::ABORT; //No movable block found
+    }
+
+    auto& place_ctx = g_vpr_ctx.placement();
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    t_pl_loc from = place_ctx.block_locs[b_from].loc;
+    auto cluster_from_type = cluster_ctx.clb_nlist.block_type(b_from);
+    auto grid_from_type = g_vpr_ctx.device().grid[from.x][from.y].type;
+    VTR_ASSERT(is_tile_compatible(grid_from_type, cluster_from_type));
+
+    //Criticality weighted centroid of the other ends of the connections
+    double weight = 0.;
+    double x_sum = 0.;
+    double y_sum = 0.;
+    for_each_block_connection(b_from, [&](ClusterPinId other_pin, float crit) {
+        int x, y;
+        pin_grid_loc(other_pin, x, y);
+        weight += crit;
+        x_sum += crit * x;
+        y_sum += crit * y;
+    });
+
+    if (weight <= 0.) {
+        log_move_abort("critical move without critical connections");
+        return e_create_move::ABORT;
+    }
+
+    t_bb centroid;
+    centroid.xmin = centroid.xmax = std::lround(x_sum / weight);
+    centroid.ymin = centroid.ymax = std::lround(y_sum / weight);
+
+    t_pl_loc to;
+    if (!find_to_loc_directed(cluster_from_type, from, centroid, to)) {
+        log_move_abort("critical move no to location");
+        return e_create_move::ABORT;
+    }
+
+    return ::create_move(blocks_affected, b_from, to);
+}
@@ -0,0 +1,16 @@
+#ifndef VPR_CRITICAL_MOVE_GEN_H
+#define VPR_CRITICAL_MOVE_GEN_H
+#include "move_generator.h"
+
+//Moves the block with the most critical connection among a few random blocks to the
+//criticality weighted centroid of the other ends of its connections, which shortens
+//its critical connections
+//
+//Requires timing-driven placement (for the timing criticalities)
+class CriticalMoveGenerator : public MoveGenerator {
+    e_create_move propose_move(t_pl_blocks_to_be_moved& affected_blocks, float rlim);
+
+    e_place_move_generator last_move_type() const { return e_place_move_generator::CRITICAL; }
+};
+
+#endif
@@ -0,0 +1,87 @@
+#include "median_move_generator.h"
+#include "globals.h"
+
+#include <algorithm>
+
+//Nets with more pins are not used to find the median region, since they are slow to
+//scan and barely depend on the location of any one of their blocks
+constexpr size_t MEDIAN_MOVE_MAX_NET_PINS = 64;
+
+e_create_move MedianMoveGenerator::propose_move(t_pl_blocks_to_be_moved& blocks_affected, float /*rlim*/) {
+    ClusterBlockId b_from = pick_from_block();
+    if (!b_from) {
+        return e_create_move::ABORT; //No movable block found
+    }
+
+    auto& place_ctx = g_vpr_ctx.placement();
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    t_pl_loc from = place_ctx.block_locs[b_from].loc;
+    auto cluster_from_type = cluster_ctx.clb_nlist.block_type(b_from);
+    auto grid_from_type = g_vpr_ctx.device().grid[from.x][from.y].type;
+    VTR_ASSERT(is_tile_compatible(grid_from_type, cluster_from_type));
+
+    xs_.clear();
+    ys_.clear();
+    for (ClusterPinId pin_id : cluster_ctx.clb_nlist.block_pins(b_from)) {
+        ClusterNetId net_id = cluster_ctx.clb_nlist.pin_net(pin_id);
+        if (cluster_ctx.clb_nlist.net_is_ignored(net_id)
+            || cluster_ctx.clb_nlist.net_pins(net_id).size() > MEDIAN_MOVE_MAX_NET_PINS) {
+            continue;
+        }
+
+        //Bounding box of the net without the block
+        bool found_pin = false;
+        t_bb bb;
+        for (ClusterPinId net_pin_id : cluster_ctx.clb_nlist.net_pins(net_id)) {
+            if (cluster_ctx.clb_nlist.pin_block(net_pin_id) == b_from) {
+                continue;
+            }
+
+            int x, y;
+            pin_grid_loc(net_pin_id, x, y);
+            if (!found_pin) {
+                bb.xmin = bb.xmax = x;
+                bb.ymin = bb.ymax = y;
+                found_pin = true;
+            } else {
+                bb.xmin = std::min(bb.xmin, x);
+                bb.xmax = std::max(bb.xmax, x);
+                bb.ymin = std::min(bb.ymin, y);
+                bb.ymax = std::max(bb.ymax, y);
+            }
+        }
+
+        if (!found_pin) {
+            continue; //Net only connects pins of the block
+        }
+
+        xs_.push_back(bb.xmin);
+        xs_.push_back(bb.xmax);
+        ys_.push_back(bb.ymin);
+        ys_.push_back(bb.ymax);
+    }
+
+    if (xs_.empty()) {
+        log_move_abort("median move without nets");
+        return e_create_move::ABORT;
+    }
+
+    //There is an even number of edges: the median region is between the two middle ones
+    size_t imid = xs_.size() / 2;
+    t_bb median_region;
+    std::nth_element(xs_.begin(), xs_.begin() + imid, xs_.end());
+    median_region.xmax = xs_[imid];
+    median_region.xmin = *std::max_element(xs_.begin(), xs_.begin() + imid);
+    std::nth_element(ys_.begin(), ys_.begin() + imid, ys_.end());
+    median_region.ymax = ys_[imid];
+    median_region.ymin = *std::max_element(ys_.begin(), ys_.begin() + imid);
+
+    t_pl_loc to;
+    if (!find_to_loc_directed(cluster_from_type, from, median_region, to)) {
+        log_move_abort("median move no to location");
+        return e_create_move::ABORT;
+    }
+
+    return ::create_move(blocks_affected, b_from, to);
+}
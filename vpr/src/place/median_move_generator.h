@@ -0,0 +1,20 @@
+#ifndef VPR_MEDIAN_MOVE_GEN_H
+#define VPR_MEDIAN_MOVE_GEN_H
+#include <vector>
+
+#include "move_generator.h"
+
+//Moves a random block to the median region of its nets: the region between the middle
+//edges of the bounding boxes of its nets (computed without the block), which minimizes
+//the total bounding box size of the nets of the block
+class MedianMoveGenerator : public MoveGenerator {
+    e_create_move propose_move(t_pl_blocks_to_be_moved& affected_blocks, float rlim);
+
+    e_place_move_generator last_move_type() const { return e_place_move_generator::MEDIAN; }
+
+    //Edges of the bounding boxes of the nets of the block being moved (kept to avoid re-allocations)
+    std::vector<int> xs_;
+    std::vector<int> ys_;
+};
+
+#endif
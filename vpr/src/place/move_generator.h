@@ -26,6 +26,9 @@ class MoveGenerator {
 
     //Recieves feedback about the outcome of the previously proposed move
     virtual void process_outcome(const MoveOutcomeStats& /*move_outcome*/) {}
+
+    //Returns the type of the previously proposed move (one of the non-adaptive move generators)
+    virtual e_place_move_generator last_move_type() const = 0;
 };
 
 #endif
@@ -3,12 +3,27 @@
 #include "place_util.h"
 #include "globals.h"
 
+#include <algorithm>
+#include <mutex>
+
 #include "vtr_random.h"
 
 //Records counts of reasons for aborted moves
 static std::map<std::string, size_t> f_move_abort_reasons;
 
+//Moves may be proposed by several threads at once (see --parallel_placement)
+static std::mutex f_move_abort_reasons_mutex;
+
+template<typename RandFunc>
+static bool find_to_loc_uniform_in_region(t_logical_block_type_ptr type,
+                                          float rlim,
+                                          const t_pl_loc from,
+                                          t_pl_loc& to,
+                                          const t_bb& region,
+                                          RandFunc irand);
+
 void log_move_abort(std::string reason) {
+    std::lock_guard<std::mutex> lock(f_move_abort_reasons_mutex);
     ++f_move_abort_reasons[reason];
 }
 
@@ -504,6 +519,84 @@ bool find_to_loc_uniform(t_logical_block_type_ptr type,
                          float rlim,
                          const t_pl_loc from,
                          t_pl_loc& to) {
+    auto& grid = g_vpr_ctx.device().grid;
+
+    t_bb device_region;
+    device_region.xmin = 0;
+    device_region.xmax = int(grid.width()) - 1;
+    device_region.ymin = 0;
+    device_region.ymax = int(grid.height()) - 1;
+
+    return find_to_loc_uniform_in_region(type, rlim, from, to, device_region,
+                                         [](int imax) { return vtr::irand(imax); });
+}
+
+bool find_to_loc_uniform(t_logical_block_type_ptr type,
+                         float rlim,
+                         const t_pl_loc from,
+                         t_pl_loc& to,
+                         const t_bb& region,
+                         vtr::RandState& rand_state) {
+    return find_to_loc_uniform_in_region(type, rlim, from, to, region,
+                                         [&](int imax) { return vtr::irand(imax, rand_state); });
+}
+
+void pin_grid_loc(ClusterPinId pin, int& x, int& y) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& place_ctx = g_vpr_ctx.placement();
+
+    ClusterBlockId blk = cluster_ctx.clb_nlist.pin_block(pin);
+    int pnum = tile_pin_index(pin);
+    x = place_ctx.block_locs[blk].loc.x + physical_tile_type(blk)->pin_width_offset[pnum];
+    y = place_ctx.block_locs[blk].loc.y + physical_tile_type(blk)->pin_height_offset[pnum];
+}
+
+bool find_to_loc_directed(t_logical_block_type_ptr type,
+                          const t_pl_loc from,
+                          const t_bb& target,
+                          t_pl_loc& to) {
+    const auto& compressed_block_grid = g_vpr_ctx.placement().compressed_block_grids[type->index];
+    const auto& grid_x = compressed_block_grid.compressed_to_grid_x;
+    const auto& grid_y = compressed_block_grid.compressed_to_grid_y;
+
+    //Compressed grid location ranges covered by the target. If the target falls between two
+    //rows/columns of the type the range is empty (max below min), and swapping the bounds
+    //gives the rows/columns on either side of the target instead
+    int min_cx = std::lower_bound(grid_x.begin(), grid_x.end(), target.xmin) - grid_x.begin();
+    int max_cx = int(std::upper_bound(grid_x.begin(), grid_x.end(), target.xmax) - grid_x.begin()) - 1;
+    int min_cy = std::lower_bound(grid_y.begin(), grid_y.end(), target.ymin) - grid_y.begin();
+    int max_cy = int(std::upper_bound(grid_y.begin(), grid_y.end(), target.ymax) - grid_y.begin()) - 1;
+    if (min_cx > max_cx) {
+        std::swap(min_cx, max_cx);
+    }
+    if (min_cy > max_cy) {
+        std::swap(min_cy, max_cy);
+    }
+    min_cx = std::max(0, std::min<int>(min_cx, grid_x.size() - 1));
+    max_cx = std::max(0, std::min<int>(max_cx, grid_x.size() - 1));
+    min_cy = std::max(0, std::min<int>(min_cy, grid_y.size() - 1));
+    max_cy = std::max(0, std::min<int>(max_cy, grid_y.size() - 1));
+
+    t_bb region;
+    region.xmin = grid_x[min_cx];
+    region.xmax = grid_x[max_cx];
+    region.ymin = grid_y[min_cy];
+    region.ymax = grid_y[max_cy];
+
+    //The whole region is reachable from the from location
+    float rlim = std::max(grid_x.size(), grid_y.size());
+
+    return find_to_loc_uniform_in_region(type, rlim, from, to, region,
+                                         [](int imax) { return vtr::irand(imax); });
+}
+
+template<typename RandFunc>
+static bool find_to_loc_uniform_in_region(t_logical_block_type_ptr type,
+                                          float rlim,
+                                          const t_pl_loc from,
+                                          t_pl_loc& to,
+                                          const t_bb& region,
+                                          RandFunc irand) {
     //Finds a legal swap to location for the given type, starting from 'from.x' and 'from.y'
     //
     //Note that the range limit (rlim) is applied in a logical sense (i.e. 'compressed' grid space consisting
@@ -525,13 +618,21 @@ bool find_to_loc_uniform(t_logical_block_type_ptr type,
     int cx_from = grid_to_compressed(compressed_block_grid.compressed_to_grid_x, from.x);
     int cy_from = grid_to_compressed(compressed_block_grid.compressed_to_grid_y, from.y);
 
+    //Determine the compressed grid location ranges covered by the region
+    const auto& grid_x = compressed_block_grid.compressed_to_grid_x;
+    const auto& grid_y = compressed_block_grid.compressed_to_grid_y;
+    int region_min_cx = std::lower_bound(grid_x.begin(), grid_x.end(), region.xmin) - grid_x.begin();
+    int region_max_cx = int(std::upper_bound(grid_x.begin(), grid_x.end(), region.xmax) - grid_x.begin()) - 1;
+    int region_min_cy = std::lower_bound(grid_y.begin(), grid_y.end(), region.ymin) - grid_y.begin();
+    int region_max_cy = int(std::upper_bound(grid_y.begin(), grid_y.end(), region.ymax) - grid_y.begin()) - 1;
+
     //Determine the valid compressed grid location ranges
-    int min_cx = std::max(0, cx_from - rlim_x);
-    int max_cx = std::min<int>(compressed_block_grid.compressed_to_grid_x.size() - 1, cx_from + rlim_x);
+    int min_cx = std::max(region_min_cx, cx_from - rlim_x);
+    int max_cx = std::min(region_max_cx, cx_from + rlim_x);
     int delta_cx = max_cx - min_cx;
 
-    int min_cy = std::max(0, cy_from - rlim_y);
-    int max_cy = std::min<int>(compressed_block_grid.compressed_to_grid_y.size() - 1, cy_from + rlim_y);
+    int min_cy = std::max(region_min_cy, cy_from - rlim_y);
+    int max_cy = std::min(region_max_cy, cy_from + rlim_y);
 
     int cx_to = OPEN;
     int cy_to = OPEN;
@@ -540,7 +641,7 @@ bool find_to_loc_uniform(t_logical_block_type_ptr type,
     while (!legal && (int)tried_cx_to.size() < delta_cx) { //Until legal or all possibilities exhaused
         //Pick a random x-location within [min_cx, max_cx],
         //until we find a legal swap, or have exhuasted all possiblites
-        cx_to = min_cx + vtr::irand(delta_cx);
+        cx_to = min_cx + irand(delta_cx);
 
         VTR_ASSERT(cx_to >= min_cx);
         VTR_ASSERT(cx_to <= max_cx);
@@ -568,9 +669,12 @@ bool find_to_loc_uniform(t_logical_block_type_ptr type,
         if (y_lower_iter->first > min_cy) {
             //No valid blocks at this x location which are within rlim_y
             //
-            //Fall back to allow the whole y range
-            y_lower_iter = compressed_block_grid.grid[cx_to].begin();
-            y_upper_iter = compressed_block_grid.grid[cx_to].end();
+            //Fall back to allow the whole y range (of the region)
+            y_lower_iter = compressed_block_grid.grid[cx_to].lower_bound(region_min_cy);
+            y_upper_iter = compressed_block_grid.grid[cx_to].upper_bound(region_max_cy);
+            if (y_lower_iter == y_upper_iter) {
+                continue;
+            }
 
             min_cy = y_lower_iter->first;
             max_cy = (y_upper_iter - 1)->first;
@@ -585,7 +689,7 @@ bool find_to_loc_uniform(t_logical_block_type_ptr type,
         std::unordered_set<int> tried_dy;
         while (!legal && (int)tried_dy.size() < y_range) { //Until legal or all possibilities exhausted
             //Randomly pick a y location
-            int dy = vtr::irand(y_range - 1);
+            int dy = irand(y_range - 1);
 
             //Record this y location as tried
             auto res2 = tried_dy.insert(dy);
@@ -625,7 +729,7 @@ bool find_to_loc_uniform(t_logical_block_type_ptr type,
 
     //Each x/y location contains only a single type, so we can pick a random
     //z (capcity) location
-    to.z = vtr::irand(to_type->capacity - 1);
+    to.z = irand(to_type->capacity - 1);
 
     VTR_ASSERT_MSG(is_tile_compatible(to_type, type), "Type must be compatible");
     VTR_ASSERT_MSG(grid[to.x][to.y].width_offset == 0, "Should be at block base location");
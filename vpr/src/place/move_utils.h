@@ -3,6 +3,7 @@
 #include "vpr_types.h"
 #include "move_transactions.h"
 #include "compressed_grid.h"
+#include "vtr_random.h"
 
 /* This is for the placement swap routines. A swap attempt could be       *
  * rejected, accepted or aborted (due to the limitations placed on the    *
@@ -46,8 +47,28 @@ std::set<t_pl_loc> determine_locations_emptied_by_move(t_pl_blocks_to_be_moved&
 
 ClusterBlockId pick_from_block();
 
+//Returns the grid location of a pin (the location of its block plus the offset of the pin within the tile)
+void pin_grid_loc(ClusterPinId pin, int& x, int& y);
+
 bool find_to_loc_uniform(t_logical_block_type_ptr type,
                          float rlim,
                          const t_pl_loc from,
                          t_pl_loc& to);
+
+//Same as above, but the swap to location is restricted to the given region (inclusive
+//grid coordinates) and is picked with the given random number generator state
+bool find_to_loc_uniform(t_logical_block_type_ptr type,
+                         float rlim,
+                         const t_pl_loc from,
+                         t_pl_loc& to,
+                         const t_bb& region,
+                         vtr::RandState& rand_state);
+
+//Finds a legal swap to location for the given type within the target region (inclusive
+//grid coordinates), which is extended to the closest rows/columns of the type when it does
+//not contain any. Used by directed moves, so the range limit is not applied
+bool find_to_loc_directed(t_logical_block_type_ptr type,
+                          const t_pl_loc from,
+                          const t_bb& target,
+                          t_pl_loc& to);
 #endif
@@ -1,13 +1,16 @@
 #include <cstdio>
 #include <cmath>
+#include <chrono>
 #include <memory>
 #include <fstream>
+#include <array>
 
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_util.h"
 #include "vtr_random.h"
 #include "vtr_geometry.h"
+#include "vtr_time.h"
 
 #include "vpr_types.h"
 #include "vpr_error.h"
@@ -28,11 +31,16 @@
 #include "histogram.h"
 #include "place_util.h"
 #include "initial_placement.h"
+#include "analytic_placement.h"
 #include "place_delay_model.h"
 #include "move_transactions.h"
 #include "move_utils.h"
+#include "place_regions.h"
 
 #include "uniform_move_generator.h"
+#include "median_move_generator.h"
+#include "critical_move_generator.h"
+#include "adaptive_move_generator.h"
 
 #include "PlacementDelayCalculator.h"
 #include "VprTimingGraphResolver.h"
@@ -41,6 +49,10 @@
 #include "tatum/echo_writer.hpp"
 #include "tatum/TimingReporter.hpp"
 
+#if defined(VPR_USE_TBB)
+#    include <tbb/parallel_for.h>
+#endif
+
 using std::max;
 using std::min;
 
@@ -96,6 +108,38 @@ struct t_placer_prev_inverse_costs {
     double timing_cost;
 };
 
+/* Number of batches of moves per temperature with --parallel_placement. *
+ * The moves of the regions of a batch are made in parallel, then the    *
+ * timing costs are synchronized before the next batch.                  */
+constexpr int PARALLEL_PLACEMENT_BATCHES = 16;
+
+/* Probability of accepting a move with the average cost increase at  *
+ * the starting temperature of an analytic initial placement.          */
+constexpr double ANALYTIC_INIT_ACCEPTANCE_PROB = 0.3;
+
+/* Moves within a region only swap two single blocks (macros are never   *
+ * moved by a region).                                                    */
+constexpr size_t MAX_REGION_MOVED_BLOCKS = 2;
+
+/* Moves made within a region of PlaceRegions by a single thread, and the *
+ * changes they made to the costs of the placement.                       */
+struct t_region_swaps {
+    t_region_swaps()
+        : blocks_affected(MAX_REGION_MOVED_BLOCKS) {}
+
+    int num_moves = 0;
+    vtr::RandState rand_state = 0;
+
+    t_pl_blocks_to_be_moved blocks_affected;
+    std::vector<ClusterNetId> nets_to_update;
+
+    t_placer_costs delta_costs = {0., 0., 0.};
+    t_placer_statistics stats = {0., 0., 0., 0., 0};
+    int num_accepted = 0;
+    int num_rejected = 0;
+    int num_aborted = 0;
+};
+
 constexpr float INVALID_DELAY = std::numeric_limits<float>::quiet_NaN();
 
 constexpr double MAX_INV_TIMING_COST = 1.e9;
@@ -135,6 +179,12 @@ static vtr::vector<ClusterNetId, double*> temp_point_to_point_timing_cost;
 static vtr::vector<ClusterNetId, float*> point_to_point_delay;
 static vtr::vector<ClusterNetId, float*> temp_point_to_point_delay;
 
+/* [0..cluster_ctx.clb_nlist.nets().size()-1][1..num_pins-1]. The delay of each   */
+/* connection as of the last timing analysis. The connections whose delay changed */
+/* since (i.e. those of the committed moves) are the only ones re-analyzed by the */
+/* next (incremental) timing update.                                              */
+static vtr::vector<ClusterNetId, float*> analyzed_point_to_point_delay;
+
 /* [0..cluster_ctx.clb_nlist.blocks().size()-1][0..pins_per_clb-1]. Indicates which pin on the net */
 /* this block corresponds to, this is only required during timing-driven */
 /* placement. It is used to allow us to update individual connections on */
@@ -147,6 +197,20 @@ static vtr::vector<ClusterBlockId, std::vector<int>> net_pin_indices;
 
 static vtr::vector<ClusterNetId, t_bb> bb_coords, bb_num_on_edges;
 
+/* Structure-of-arrays layout of the pin locations of all the nets, which are *
+ * scanned by the bounding box computations. The pins of a net are stored     *
+ * contiguously (in net pin order, driver first) in [net_starts[net],         *
+ * net_starts[net + 1]). The x and y arrays hold the grid location of each    *
+ * pin (block location plus pin offset), already clipped to the range of the  *
+ * bounding boxes (1..grid.width()-2, 1..grid.height()-2). They follow the    *
+ * block locations, including those of the proposed moves being evaluated.    */
+struct t_net_pin_locs {
+    std::vector<size_t> net_starts; //[0..cluster_ctx.clb_nlist.nets().size()]
+    std::vector<int> x;
+    std::vector<int> y;
+};
+static t_net_pin_locs net_pin_locs;
+
 /* The arrays below are used to precompute the inverse of the average   *
  * number of tracks per channel between [subhigh] and [sublow].  Access *
  * them as chan?_place_cost_fac[subhigh][sublow].  They are used to     *
@@ -185,6 +249,21 @@ static const float cross_count[50] = {/* [0..49] */ 1.0, 1.0, 1.0, 1.0828, 1.153
 
 std::unique_ptr<FILE, decltype(&vtr::fclose)> f_move_stats_file(nullptr, vtr::fclose);
 
+//Per-temperature annealing statistics, written to the --place_anneal_stats file
+struct t_move_type_stats {
+    size_t num_accepted = 0;
+    size_t num_rejected = 0;
+    size_t num_aborted = 0;
+};
+
+//Moves are counted by the non-adaptive generator which proposed them
+constexpr size_t NUM_PLACE_MOVE_TYPES = size_t(e_place_move_generator::ADAPTIVE);
+constexpr std::array<const char*, NUM_PLACE_MOVE_TYPES> PLACE_MOVE_TYPE_NAMES = {{"uniform", "median", "critical"}};
+
+static std::array<t_move_type_stats, NUM_PLACE_MOVE_TYPES> f_move_type_stats;
+static float f_timing_update_sec = 0.;
+static std::unique_ptr<FILE, decltype(&vtr::fclose)> f_anneal_stats_file(nullptr, vtr::fclose);
+
 #ifdef VTR_ENABLE_DEBUG_LOGGING
 
 #    define LOG_MOVE_STATS_HEADER()                               \
@@ -274,14 +353,22 @@ static void alloc_and_load_try_swap_structs();
 
 static void free_placement_structs(const t_placer_opts& placer_opts);
 
+static std::unique_ptr<MoveGenerator> create_move_generator(const t_placer_opts& placer_opts);
+
+static void load_net_pin_locs();
+
+static void update_net_pin_locs(const t_pl_blocks_to_be_moved& blocks_affected);
+
+static void update_block_net_pin_locs(ClusterBlockId blk);
+
 static void alloc_and_load_for_fast_cost_update(float place_cost_exp);
 
 static void free_fast_cost_update();
 
 static double comp_bb_cost(e_cost_methods method);
 
-static void update_move_nets(int num_nets_affected);
-static void reset_move_nets(int num_nets_affected);
+static void update_move_nets(int num_nets_affected, const std::vector<ClusterNetId>& nets_to_update);
+static void reset_move_nets(int num_nets_affected, const std::vector<ClusterNetId>& nets_to_update);
 
 static e_move_result try_swap(float t,
                               t_placer_costs* costs,
@@ -292,7 +379,50 @@ static e_move_result try_swap(float t,
                               const PlaceDelayModel* delay_model,
                               float rlim_escape_fraction,
                               enum e_place_algorithm place_algorithm,
-                              float timing_tradeoff);
+                              float timing_tradeoff,
+                              double* move_delta_c);
+
+static e_move_result evaluate_move(float t,
+                                   const t_placer_prev_inverse_costs* prev_inverse_costs,
+                                   t_pl_blocks_to_be_moved& blocks_affected,
+                                   const PlaceDelayModel* delay_model,
+                                   enum e_place_algorithm place_algorithm,
+                                   float timing_tradeoff,
+                                   std::vector<ClusterNetId>& nets_to_update,
+                                   vtr::RandState* rand_state,
+                                   double& delta_c,
+                                   double& bb_delta_c,
+                                   double& timing_delta_c);
+
+static bool can_place_in_parallel();
+
+static int try_region_swaps_batch(int num_moves,
+                                  float t,
+                                  t_placer_costs* costs,
+                                  const t_placer_prev_inverse_costs* prev_inverse_costs,
+                                  float rlim,
+                                  const PlaceDelayModel* delay_model,
+                                  const t_placer_opts& placer_opts,
+                                  t_placer_statistics* stats);
+
+static void try_region_swaps(const PlaceRegions& place_regions,
+                             size_t iregion,
+                             float t,
+                             const t_placer_costs& costs,
+                             const t_placer_prev_inverse_costs* prev_inverse_costs,
+                             float rlim,
+                             const PlaceDelayModel* delay_model,
+                             const t_placer_opts& placer_opts,
+                             t_region_swaps& region_swaps);
+
+static e_move_result try_region_swap(const PlaceRegions& place_regions,
+                                     size_t iregion,
+                                     float t,
+                                     const t_placer_prev_inverse_costs* prev_inverse_costs,
+                                     float rlim,
+                                     const PlaceDelayModel* delay_model,
+                                     const t_placer_opts& placer_opts,
+                                     t_region_swaps& region_swaps);
 
 static void check_place(const t_placer_costs& costs,
                         const PlaceDelayModel* delay_model,
@@ -315,6 +445,15 @@ static float starting_t(t_placer_costs* costs,
                         t_pl_blocks_to_be_moved& blocks_affected,
                         const t_placer_opts& placer_opts);
 
+static float analytic_starting_t(t_placer_costs* costs,
+                                 t_placer_prev_inverse_costs* prev_inverse_costs,
+                                 int move_lim,
+                                 float rlim,
+                                 const PlaceDelayModel* delay_model,
+                                 MoveGenerator& move_generator,
+                                 t_pl_blocks_to_be_moved& blocks_affected,
+                                 const t_placer_opts& placer_opts);
+
 static void update_t(float* t, float rlim, float success_rat, t_annealing_sched annealing_sched);
 
 static void update_rlim(float* rlim, float success_rat, const DeviceGrid& grid);
@@ -337,7 +476,11 @@ static bool driven_by_moved_block(const ClusterNetId net, const t_pl_blocks_to_b
 
 static void comp_td_costs(const PlaceDelayModel* delay_model, double* timing_cost);
 
-static e_move_result assess_swap(double delta_c, double t);
+static void update_placement_timing(TimingInfo& timing_info, const ClusteredPinAtomPinsLookup& netlist_pin_lookup);
+
+static void save_analyzed_point_to_point_delays();
+
+static e_move_result assess_swap(double delta_c, double t, vtr::RandState* rand_state);
 
 static void get_non_updateable_bb(ClusterNetId net_id, t_bb* bb_coord_new);
 
@@ -346,10 +489,11 @@ static void update_bb(ClusterNetId net_id, t_bb* bb_coord_new, t_bb* bb_edge_new
 static int find_affected_nets_and_update_costs(e_place_algorithm place_algorithm,
                                                const t_pl_blocks_to_be_moved& blocks_affected,
                                                const PlaceDelayModel* delay_model,
+                                               std::vector<ClusterNetId>& nets_to_update,
                                                double& bb_delta_c,
                                                double& timing_delta_c);
 
-static void record_affected_net(const ClusterNetId net, int& num_affected_nets);
+static void record_affected_net(const ClusterNetId net, std::vector<ClusterNetId>& nets_to_update, int& num_affected_nets);
 
 static void update_net_bb(const ClusterNetId net,
                           const t_pl_blocks_to_be_moved& blocks_affected,
@@ -390,7 +534,8 @@ static void placement_inner_loop(float t,
                                  const PlaceDelayModel* delay_model,
                                  MoveGenerator& move_generator,
                                  t_pl_blocks_to_be_moved& blocks_affected,
-                                 SetupTimingInfo& timing_info);
+                                 SetupTimingInfo& timing_info,
+                                 bool parallel_placement);
 
 static void recompute_costs_from_scratch(const t_placer_opts& placer_opts, const PlaceDelayModel* delay_model, t_placer_costs* costs);
 
@@ -415,6 +560,11 @@ static void print_place_status(const float t,
                                size_t tot_moves);
 static void print_resources_utilization();
 
+static void record_move_type_outcome(e_place_move_generator move_type, e_move_result move_outcome);
+static void reset_anneal_stats();
+static void print_anneal_stats_header();
+static void print_anneal_stats(int num_temps, float t, float rlim);
+
 /*****************************************************************************/
 void try_place(const t_placer_opts& placer_opts,
                t_annealing_sched annealing_sched,
@@ -452,7 +602,7 @@ void try_place(const t_placer_opts& placer_opts,
 
     std::shared_ptr<SetupTimingInfo> timing_info;
     std::shared_ptr<PlacementDelayCalculator> placement_delay_calc;
-    std::unique_ptr<PlaceDelayModel> place_delay_model;
+    const PlaceDelayModel* place_delay_model = nullptr;
     std::unique_ptr<MoveGenerator> move_generator;
 
     t_pl_blocks_to_be_moved blocks_affected(cluster_ctx.clb_nlist.blocks().size());
@@ -476,7 +626,9 @@ void try_place(const t_placer_opts& placer_opts,
         }
     }
 
-    move_generator = std::make_unique<UniformMoveGenerator>();
+    move_generator = create_move_generator(placer_opts);
+
+    bool parallel_placement = placer_opts.parallel_placement && can_place_in_parallel();
 
     width_fac = placer_opts.place_chan_width;
 
@@ -487,6 +639,12 @@ void try_place(const t_placer_opts& placer_opts,
 
     initial_placement(placer_opts.pad_loc_type, placer_opts.pad_loc_file.c_str());
 
+    if (placer_opts.place_init_type == e_place_init_type::ANALYTIC) {
+        analytic_placement();
+    }
+
+    load_net_pin_locs();
+
     // Update physical pin values
     for (auto block_id : cluster_ctx.clb_nlist.blocks()) {
         place_sync_external_block_connections(block_id);
@@ -509,7 +667,7 @@ void try_place(const t_placer_opts& placer_opts,
         VTR_LOG("\n");
 
         //Update the point-to-point delays from the initial placement
-        comp_td_point_to_point_delays(place_delay_model.get());
+        comp_td_point_to_point_delays(place_delay_model);
 
         /*
          * Initialize timing analysis
@@ -521,6 +679,7 @@ void try_place(const t_placer_opts& placer_opts,
         timing_info = make_setup_timing_info(placement_delay_calc);
 
         timing_info->update();
+        save_analyzed_point_to_point_delays();
         timing_info->set_warn_unconstrained(false); //Don't warn again about unconstrained nodes again during placement
 
         //Initial slack estimates
@@ -537,7 +696,7 @@ void try_place(const t_placer_opts& placer_opts,
         }
 
         /*now we can properly compute costs  */
-        comp_td_costs(place_delay_model.get(), &costs.timing_cost); /*also updates values in point_to_point_delay */
+        comp_td_costs(place_delay_model, &costs.timing_cost); /*also updates values in point_to_point_delay */
 
         outer_crit_iter_count = 1;
 
@@ -558,7 +717,7 @@ void try_place(const t_placer_opts& placer_opts,
     }
 
     //Sanity check that initial placement is legal
-    check_place(costs, place_delay_model.get(), placer_opts.place_algorithm);
+    check_place(costs, place_delay_model, placer_opts.place_algorithm);
 
     //Initial pacement statistics
     VTR_LOG("Initial placement cost: %g bb_cost: %g td_cost: %g\n",
@@ -613,7 +772,7 @@ void try_place(const t_placer_opts& placer_opts,
 
     t = starting_t(&costs, &prev_inverse_costs,
                    annealing_sched, move_lim, rlim,
-                   place_delay_model.get(),
+                   place_delay_model,
                    *move_generator,
                    blocks_affected,
                    placer_opts);
@@ -623,6 +782,13 @@ void try_place(const t_placer_opts& placer_opts,
         LOG_MOVE_STATS_HEADER();
     }
 
+    //Moves of the starting temperature estimation are not counted
+    reset_anneal_stats();
+    if (!placer_opts.anneal_stats_file.empty()) {
+        f_anneal_stats_file = std::unique_ptr<FILE, decltype(&vtr::fclose)>(vtr::fopen(placer_opts.anneal_stats_file.c_str(), "w"), vtr::fclose);
+        print_anneal_stats_header();
+    }
+
     tot_iter = 0;
     moves_since_cost_recompute = 0;
     int num_temps = 0;
@@ -638,7 +804,7 @@ void try_place(const t_placer_opts& placer_opts,
                                            crit_exponent,
                                            &outer_crit_iter_count,
                                            netlist_pin_lookup,
-                                           place_delay_model.get(),
+                                           place_delay_model,
                                            *timing_info);
 
         placement_inner_loop(t, rlim, placer_opts,
@@ -647,10 +813,11 @@ void try_place(const t_placer_opts& placer_opts,
                              &prev_inverse_costs,
                              &moves_since_cost_recompute,
                              netlist_pin_lookup,
-                             place_delay_model.get(),
+                             place_delay_model,
                              *move_generator,
                              blocks_affected,
-                             *timing_info);
+                             *timing_info,
+                             parallel_placement);
 
         tot_iter += move_lim;
 
@@ -670,6 +837,7 @@ void try_place(const t_placer_opts& placer_opts,
                            stats,
                            critical_path.delay(), sTNS, sWNS,
                            success_rat, std_dev, rlim, crit_exponent, tot_iter);
+        print_anneal_stats(num_temps, oldt, rlim);
 
         sprintf(msg, "Cost: %g  BB Cost %g  TD Cost %g  Temperature: %g",
                 costs.cost, costs.bb_cost, costs.timing_cost, t);
@@ -696,7 +864,7 @@ void try_place(const t_placer_opts& placer_opts,
                                        crit_exponent,
                                        &outer_crit_iter_count,
                                        netlist_pin_lookup,
-                                       place_delay_model.get(),
+                                       place_delay_model,
                                        *timing_info);
 
     t = 0; /* freeze out */
@@ -709,10 +877,11 @@ void try_place(const t_placer_opts& placer_opts,
                          &prev_inverse_costs,
                          &moves_since_cost_recompute,
                          netlist_pin_lookup,
-                         place_delay_model.get(),
+                         place_delay_model,
                          *move_generator,
                          blocks_affected,
-                         *timing_info);
+                         *timing_info,
+                         parallel_placement);
 
     tot_iter += move_lim;
     ++num_temps;
@@ -728,6 +897,8 @@ void try_place(const t_placer_opts& placer_opts,
     print_place_status(t, oldt, stats,
                        critical_path.delay(), sTNS, sWNS,
                        success_rat, std_dev, rlim, crit_exponent, tot_iter);
+    print_anneal_stats(num_temps, t, rlim);
+    f_anneal_stats_file.reset();
 
     // TODO:
     // 1. add some subroutine hierarchy!  Too big!
@@ -738,7 +909,7 @@ void try_place(const t_placer_opts& placer_opts,
     }
 #endif
 
-    check_place(costs, place_delay_model.get(), placer_opts.place_algorithm);
+    check_place(costs, place_delay_model, placer_opts.place_algorithm);
 
     //Some stats
     VTR_LOG("\n");
@@ -752,7 +923,7 @@ void try_place(const t_placer_opts& placer_opts,
             for (size_t ipin = 1; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ipin++)
                 set_timing_place_crit(net_id, ipin, 0); /*dummy crit values */
         }
-        comp_td_costs(place_delay_model.get(), &costs.timing_cost); /*computes point_to_point_delay */
+        comp_td_costs(place_delay_model, &costs.timing_cost); /*computes point_to_point_delay */
     }
 
     if (placer_opts.place_algorithm == PATH_TIMING_DRIVEN_PLACE
@@ -760,7 +931,7 @@ void try_place(const t_placer_opts& placer_opts,
         //Final timing estimate
         VTR_ASSERT(timing_info);
 
-        timing_info->update(); //Tatum
+        update_placement_timing(*timing_info, netlist_pin_lookup); //Tatum
         critical_path = timing_info->least_slack_critical_path();
 
         if (isEchoFileEnabled(E_ECHO_FINAL_PLACEMENT_TIMING_GRAPH)) {
@@ -847,11 +1018,13 @@ static void outer_loop_recompute_criticalities(const t_placer_opts& placer_opts,
         VTR_ASSERT(num_connections > 0);
 
         //Per-temperature timing update
-        timing_info.update();
+        vtr::Timer timing_update_timer;
+        update_placement_timing(timing_info, netlist_pin_lookup);
         load_criticalities(timing_info, crit_exponent, netlist_pin_lookup);
 
         /*recompute costs from scratch, based on new criticalities */
         comp_td_costs(delay_model, &costs->timing_cost);
+        f_timing_update_sec += timing_update_timer.elapsed_sec();
         *outer_crit_iter_count = 0;
     }
     (*outer_crit_iter_count)++;
@@ -878,8 +1051,9 @@ static void placement_inner_loop(float t,
                                  const PlaceDelayModel* delay_model,
                                  MoveGenerator& move_generator,
                                  t_pl_blocks_to_be_moved& blocks_affected,
-                                 SetupTimingInfo& timing_info) {
-    int inner_crit_iter_count, inner_iter;
+                                 SetupTimingInfo& timing_info,
+                                 bool parallel_placement) {
+    int inner_crit_iter_count, inner_iter, num_moves;
 
     stats->av_cost = 0.;
     stats->av_bb_cost = 0.;
@@ -889,28 +1063,47 @@ static void placement_inner_loop(float t,
 
     inner_crit_iter_count = 1;
 
+    /* With parallel placement the moves are made in batches: the moves of the *
+     * regions of a batch are made in parallel, then the remaining moves of    *
+     * the batch are made serially.                                            */
+    int batch_size = std::max(1, move_lim / PARALLEL_PLACEMENT_BATCHES);
+    int serial_moves_left = 0;
+
     /* Inner loop begins */
-    for (inner_iter = 0; inner_iter < move_lim; inner_iter++) {
-        e_move_result swap_result = try_swap(t, costs, prev_inverse_costs, rlim,
-                                             move_generator,
-                                             blocks_affected,
-                                             delay_model,
-                                             placer_opts.rlim_escape_fraction,
-                                             placer_opts.place_algorithm,
-                                             placer_opts.timing_tradeoff);
+    for (inner_iter = 0; inner_iter < move_lim; inner_iter += num_moves) {
+        if (parallel_placement && serial_moves_left == 0) {
+            int num_batch_moves = std::min(batch_size, move_lim - inner_iter);
+            num_moves = try_region_swaps_batch(num_batch_moves, t, costs, prev_inverse_costs, rlim,
+                                               delay_model, placer_opts, stats);
+            serial_moves_left = num_batch_moves - num_moves;
+        } else {
+            e_move_result swap_result = try_swap(t, costs, prev_inverse_costs, rlim,
+                                                 move_generator,
+                                                 blocks_affected,
+                                                 delay_model,
+                                                 placer_opts.rlim_escape_fraction,
+                                                 placer_opts.place_algorithm,
+                                                 placer_opts.timing_tradeoff,
+                                                 nullptr);
+
+            if (swap_result == ACCEPTED) {
+                /* Move was accepted.  Update statistics that are useful for the annealing schedule. */
+                stats->success_sum++;
+                stats->av_cost += costs->cost;
+                stats->av_bb_cost += costs->bb_cost;
+                stats->av_timing_cost += costs->timing_cost;
+                stats->sum_of_squares += (costs->cost) * (costs->cost);
+                num_swap_accepted++;
+            } else if (swap_result == ABORTED) {
+                num_swap_aborted++;
+            } else { // swap_result == REJECTED
+                num_swap_rejected++;
+            }
 
-        if (swap_result == ACCEPTED) {
-            /* Move was accepted.  Update statistics that are useful for the annealing schedule. */
-            stats->success_sum++;
-            stats->av_cost += costs->cost;
-            stats->av_bb_cost += costs->bb_cost;
-            stats->av_timing_cost += costs->timing_cost;
-            stats->sum_of_squares += (costs->cost) * (costs->cost);
-            num_swap_accepted++;
-        } else if (swap_result == ABORTED) {
-            num_swap_aborted++;
-        } else { // swap_result == REJECTED
-            num_swap_rejected++;
+            num_moves = 1;
+            if (serial_moves_left > 0) {
+                --serial_moves_left;
+            }
         }
 
         if (placer_opts.place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
@@ -918,7 +1111,7 @@ static void placement_inner_loop(float t,
              * We do this only once in a while, since it is expensive.
              */
             if (inner_crit_iter_count >= inner_recompute_limit
-                && inner_iter != move_lim - 1) { /*on last iteration don't recompute */
+                && inner_iter + num_moves < move_lim) { /*on last iteration don't recompute */
 
                 inner_crit_iter_count = 0;
 #ifdef VERBOSE
@@ -928,12 +1121,14 @@ static void placement_inner_loop(float t,
                  * criticalities; then update the timing cost since it will change.
                  */
                 //Inner loop timing update
-                timing_info.update();
+                vtr::Timer timing_update_timer;
+                update_placement_timing(timing_info, netlist_pin_lookup);
                 load_criticalities(timing_info, crit_exponent, netlist_pin_lookup);
 
                 comp_td_costs(delay_model, &costs->timing_cost);
+                f_timing_update_sec += timing_update_timer.elapsed_sec();
             }
-            inner_crit_iter_count++;
+            inner_crit_iter_count += num_moves;
         }
 #ifdef VERBOSE
         VTR_LOG("t = %g  cost = %g   bb_cost = %g timing_cost = %g move = %d\n",
@@ -948,7 +1143,7 @@ static void placement_inner_loop(float t,
          * This round-off can lead to  error checks failing because the cost
          * is different from what you get when you recompute from scratch.
          */
-        ++(*moves_since_cost_recompute);
+        *moves_since_cost_recompute += num_moves;
         if (*moves_since_cost_recompute > MAX_MOVES_BEFORE_RECOMPUTE) {
             recompute_costs_from_scratch(placer_opts, delay_model, costs);
             *moves_since_cost_recompute = 0;
@@ -1096,6 +1291,11 @@ static float starting_t(t_placer_costs* costs,
 
     move_lim = min(max_moves, (int)cluster_ctx.clb_nlist.blocks().size());
 
+    if (placer_opts.place_init_type == e_place_init_type::ANALYTIC) {
+        return analytic_starting_t(costs, prev_inverse_costs, move_lim, rlim,
+                                   delay_model, move_generator, blocks_affected, placer_opts);
+    }
+
     num_accepted = 0;
     av = 0.;
     sum_of_squares = 0.;
@@ -1109,7 +1309,8 @@ static float starting_t(t_placer_costs* costs,
                                              delay_model,
                                              placer_opts.rlim_escape_fraction,
                                              placer_opts.place_algorithm,
-                                             placer_opts.timing_tradeoff);
+                                             placer_opts.timing_tradeoff,
+                                             nullptr);
 
         if (swap_result == ACCEPTED) {
             num_accepted++;
@@ -1143,11 +1344,63 @@ static float starting_t(t_placer_costs* costs,
     return (20. * std_dev);
 }
 
-static void update_move_nets(int num_nets_affected) {
+static float analytic_starting_t(t_placer_costs* costs,
+                                 t_placer_prev_inverse_costs* prev_inverse_costs,
+                                 int move_lim,
+                                 float rlim,
+                                 const PlaceDelayModel* delay_model,
+                                 MoveGenerator& move_generator,
+                                 t_pl_blocks_to_be_moved& blocks_affected,
+                                 const t_placer_opts& placer_opts) {
+    /* Finds a (low) starting temperature for an analytic initial placement, *
+     * which would be lost by the (essentially random) moves of starting_t.  *
+     * Moves are made at zero temperature, so only improvements are kept,    *
+     * and the starting temperature accepts the average cost increase of the *
+     * rejected moves with probability ANALYTIC_INIT_ACCEPTANCE_PROB.        */
+    int num_uphill_moves = 0;
+    double sum_uphill_delta_c = 0.;
+
+    for (int i = 0; i < move_lim; i++) {
+        double delta_c = 0.;
+        e_move_result swap_result = try_swap(0., costs, prev_inverse_costs, rlim,
+                                             move_generator,
+                                             blocks_affected,
+                                             delay_model,
+                                             placer_opts.rlim_escape_fraction,
+                                             placer_opts.place_algorithm,
+                                             placer_opts.timing_tradeoff,
+                                             &delta_c);
+
+        if (swap_result == ACCEPTED) {
+            num_swap_accepted++;
+        } else if (swap_result == ABORTED) {
+            num_swap_aborted++;
+        } else {
+            num_swap_rejected++;
+
+            num_uphill_moves++;
+            sum_uphill_delta_c += delta_c;
+        }
+    }
+
+    if (num_uphill_moves == 0) {
+        return 0.;
+    }
+
+    double av_uphill_delta_c = sum_uphill_delta_c / num_uphill_moves;
+
+#ifdef VERBOSE
+    VTR_LOG("average uphill delta cost: %g, starting temp: %g\n", av_uphill_delta_c, -av_uphill_delta_c / std::log(ANALYTIC_INIT_ACCEPTANCE_PROB));
+#endif
+
+    return -av_uphill_delta_c / std::log(ANALYTIC_INIT_ACCEPTANCE_PROB);
+}
+
+static void update_move_nets(int num_nets_affected, const std::vector<ClusterNetId>& nets_to_update) {
     /* update net cost functions and reset flags. */
     auto& cluster_ctx = g_vpr_ctx.clustering();
     for (int inet_affected = 0; inet_affected < num_nets_affected; inet_affected++) {
-        ClusterNetId net_id = ts_nets_to_update[inet_affected];
+        ClusterNetId net_id = nets_to_update[inet_affected];
 
         bb_coords[net_id] = ts_bb_coord_new[net_id];
         if (cluster_ctx.clb_nlist.net_sinks(net_id).size() >= SMALL_NET)
@@ -1161,10 +1414,10 @@ static void update_move_nets(int num_nets_affected) {
     }
 }
 
-static void reset_move_nets(int num_nets_affected) {
+static void reset_move_nets(int num_nets_affected, const std::vector<ClusterNetId>& nets_to_update) {
     /* Reset the net cost function flags first. */
     for (int inet_affected = 0; inet_affected < num_nets_affected; inet_affected++) {
-        ClusterNetId net_id = ts_nets_to_update[inet_affected];
+        ClusterNetId net_id = nets_to_update[inet_affected];
         temp_net_cost[net_id] = -1;
         bb_updated_before[net_id] = NOT_UPDATED_YET;
     }
@@ -1179,15 +1432,19 @@ static e_move_result try_swap(float t,
                               const PlaceDelayModel* delay_model,
                               float rlim_escape_fraction,
                               enum e_place_algorithm place_algorithm,
-                              float timing_tradeoff) {
+                              float timing_tradeoff,
+                              double* move_delta_c) {
     /* Picks some block and moves it to another spot.  If this spot is   *
      * occupied, switch the blocks.  Assess the change in cost function. *
      * rlim is the range limiter.                                        *
      * Returns whether the swap is accepted, rejected or aborted.        *
-     * Passes back the new value of the cost functions.                  */
+     * Passes back the new value of the cost functions, and the change   *
+     * in cost of a (non aborted) move in move_delta_c (if not null).    */
 
     num_ts_called++;
 
+    auto move_start_time = std::chrono::steady_clock::now();
+
     MoveOutcomeStats move_outcome_stats;
 
     /* I'm using negative values of temp_net_cost as a flag, so DO NOT   *
@@ -1223,62 +1480,21 @@ static e_move_result try_swap(float t,
     } else {
         VTR_ASSERT(create_move_outcome == e_create_move::VALID);
 
-        /*
-         * To make evaluating the move simpler (e.g. calculating changed bounding box),
-         * we first move the blocks to thier new locations (apply the move to
-         * place_ctx.block_locs) and then computed the change in cost. If the move is
-         * accepted, the inverse look-up in place_ctx.grid_blocks is updated (committing
-         * the move). If the move is rejected the blocks are returned to their original
-         * positions (reverting place_ctx.block_locs to its original state).
-         *
-         * Note that the inverse look-up place_ctx.grid_blocks is only updated
-         * after move acceptance is determined, and so should not be used when
-         * evaluating a move.
-         */
-
-        //Update the block positions
-        apply_move_blocks(blocks_affected);
-
-        // Find all the nets affected by this swap and update their costs
-        int num_nets_affected = find_affected_nets_and_update_costs(place_algorithm, blocks_affected, delay_model, bb_delta_c, timing_delta_c);
-        if (place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
-            /*in this case we redefine delta_c as a combination of timing and bb.  *
-             *additionally, we normalize all values, therefore delta_c is in       *
-             *relation to 1*/
+        move_outcome = evaluate_move(t, prev_inverse_costs, blocks_affected, delay_model,
+                                     place_algorithm, timing_tradeoff, ts_nets_to_update,
+                                     nullptr, delta_c, bb_delta_c, timing_delta_c);
 
-            delta_c = (1 - timing_tradeoff) * bb_delta_c * prev_inverse_costs->bb_cost
-                      + timing_tradeoff * timing_delta_c * prev_inverse_costs->timing_cost;
-        } else {
-            delta_c = bb_delta_c;
+        if (move_delta_c) {
+            *move_delta_c = delta_c;
         }
 
-        /* 1 -> move accepted, 0 -> rejected. */
-        move_outcome = assess_swap(delta_c, t);
-
         if (move_outcome == ACCEPTED) {
             costs->cost += delta_c;
             costs->bb_cost += bb_delta_c;
 
             if (place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
-                /*update the point_to_point_timing_cost and point_to_point_delay
-                 * values from the temporary values */
                 costs->timing_cost += timing_delta_c;
-
-                update_td_cost(blocks_affected);
             }
-
-            /* update net cost functions and reset flags. */
-            update_move_nets(num_nets_affected);
-
-            /* Update clb data structures since we kept the move. */
-            commit_move_blocks(blocks_affected);
-
-        } else { /* Move was rejected.  */
-                 /* Reset the net cost function flags first. */
-            reset_move_nets(num_nets_affected);
-
-            /* Restore the place_ctx.block_locs data structures to their state before the move. */
-            revert_move_blocks(blocks_affected);
         }
 
         move_outcome_stats.delta_cost_norm = delta_c;
@@ -1293,8 +1509,10 @@ static e_move_result try_swap(float t,
     }
 
     move_outcome_stats.outcome = move_outcome;
+    move_outcome_stats.elapsed_time = std::chrono::duration<float>(std::chrono::steady_clock::now() - move_start_time).count();
 
     move_generator.process_outcome(move_outcome_stats);
+    record_move_type_outcome(move_generator.last_move_type(), move_outcome);
 
     clear_move_blocks(blocks_affected);
 
@@ -1307,6 +1525,289 @@ static e_move_result try_swap(float t,
     return (move_outcome);
 }
 
+//Evaluates the change in cost of a (legal) proposed move, and decides whether it is accepted.
+//An accepted move is committed, while the placement is restored if the move is rejected.
+//
+//The changes in costs are returned in delta_c, bb_delta_c and timing_delta_c, but the costs
+//of the placement are not updated. A null rand_state uses the global random number generator.
+static e_move_result evaluate_move(float t,
+                                   const t_placer_prev_inverse_costs* prev_inverse_costs,
+                                   t_pl_blocks_to_be_moved& blocks_affected,
+                                   const PlaceDelayModel* delay_model,
+                                   enum e_place_algorithm place_algorithm,
+                                   float timing_tradeoff,
+                                   std::vector<ClusterNetId>& nets_to_update,
+                                   vtr::RandState* rand_state,
+                                   double& delta_c,
+                                   double& bb_delta_c,
+                                   double& timing_delta_c) {
+    /*
+     * To make evaluating the move simpler (e.g. calculating changed bounding box),
+     * we first move the blocks to thier new locations (apply the move to
+     * place_ctx.block_locs) and then computed the change in cost. If the move is
+     * accepted, the inverse look-up in place_ctx.grid_blocks is updated (committing
+     * the move). If the move is rejected the blocks are returned to their original
+     * positions (reverting place_ctx.block_locs to its original state).
+     *
+     * Note that the inverse look-up place_ctx.grid_blocks is only updated
+     * after move acceptance is determined, and so should not be used when
+     * evaluating a move.
+     */
+
+    //Update the block positions
+    apply_move_blocks(blocks_affected);
+    update_net_pin_locs(blocks_affected);
+
+    // Find all the nets affected by this swap and update their costs
+    int num_nets_affected = find_affected_nets_and_update_costs(place_algorithm, blocks_affected, delay_model, nets_to_update, bb_delta_c, timing_delta_c);
+    if (place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
+        /*in this case we redefine delta_c as a combination of timing and bb.  *
+         *additionally, we normalize all values, therefore delta_c is in       *
+         *relation to 1*/
+
+        delta_c = (1 - timing_tradeoff) * bb_delta_c * prev_inverse_costs->bb_cost
+                  + timing_tradeoff * timing_delta_c * prev_inverse_costs->timing_cost;
+    } else {
+        delta_c = bb_delta_c;
+    }
+
+    /* 1 -> move accepted, 0 -> rejected. */
+    e_move_result move_outcome = assess_swap(delta_c, t, rand_state);
+
+    if (move_outcome == ACCEPTED) {
+        if (place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
+            /*update the point_to_point_timing_cost and point_to_point_delay
+             * values from the temporary values */
+            update_td_cost(blocks_affected);
+        }
+
+        /* update net cost functions and reset flags. */
+        update_move_nets(num_nets_affected, nets_to_update);
+
+        /* Update clb data structures since we kept the move. */
+        commit_move_blocks(blocks_affected);
+
+    } else { /* Move was rejected.  */
+             /* Reset the net cost function flags first. */
+        reset_move_nets(num_nets_affected, nets_to_update);
+
+        /* Restore the place_ctx.block_locs data structures to their state before the move. */
+        revert_move_blocks(blocks_affected);
+        update_net_pin_locs(blocks_affected);
+    }
+
+    return move_outcome;
+}
+
+//Returns true if the moves of disjoint regions can be evaluated in parallel
+static bool can_place_in_parallel() {
+#if defined(VPR_USE_TBB)
+    if (!PlaceRegions::can_split_device()) {
+        VTR_LOG_WARN("Parallel placement requires a larger device to split in regions, moves will be evaluated serially\n");
+        return false;
+    }
+    return true;
+#else
+    VTR_LOG_WARN("Parallel placement requires VPR to be compiled with TBB, moves will be evaluated serially\n");
+    return false;
+#endif
+}
+
+//Seed of the random number generator of a region. It is drawn from the global generator,
+//so that the moves of each region only depend on the placer seed (and not on the number of threads)
+static vtr::RandState draw_region_seed() {
+    return (vtr::RandState(vtr::irand(0xFFFF)) << 16) | vtr::RandState(vtr::irand(0xFFFF));
+}
+
+//Makes (about) num_moves moves, some of them within disjoint regions of the device in parallel.
+//
+//The regions are redrawn for each batch, with shifted boundaries. The number of moves of each
+//region is proportional to its number of blocks which can be moved within it, so that the blocks
+//are moved about as often as with serial moves. The changes in costs of the regions are then
+//added (in region order) to costs and stats, and the timing cost is recomputed from scratch.
+//
+//Returns the number of moves made, the remaining moves of the batch should be made serially.
+static int try_region_swaps_batch(int num_moves,
+                                  float t,
+                                  t_placer_costs* costs,
+                                  const t_placer_prev_inverse_costs* prev_inverse_costs,
+                                  float rlim,
+                                  const PlaceDelayModel* delay_model,
+                                  const t_placer_opts& placer_opts,
+                                  t_placer_statistics* stats) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    float shift_x = vtr::frand();
+    float shift_y = vtr::frand();
+    PlaceRegions place_regions(shift_x, shift_y);
+
+    if (place_regions.num_region_blocks() == 0) {
+        return 0;
+    }
+
+    int num_region_moves = int(double(num_moves) * place_regions.num_region_blocks() / place_regions.num_movable_blocks());
+
+    std::vector<t_region_swaps> region_swaps(place_regions.num_regions());
+    for (size_t iregion = 0; iregion < region_swaps.size(); ++iregion) {
+        const auto& region_blocks = place_regions.region_blocks(iregion);
+
+        region_swaps[iregion].num_moves = int(double(num_region_moves) * region_blocks.size() / place_regions.num_region_blocks());
+        region_swaps[iregion].rand_state = draw_region_seed();
+
+        //Each affected net is recorded once, and the two swapped blocks belong to the region
+        size_t max_block_pins = 0;
+        for (ClusterBlockId blk_id : region_blocks) {
+            max_block_pins = std::max(max_block_pins, cluster_ctx.clb_nlist.block_pins(blk_id).size());
+        }
+        region_swaps[iregion].nets_to_update.resize(MAX_REGION_MOVED_BLOCKS * max_block_pins, ClusterNetId::INVALID());
+    }
+
+    auto try_swaps = [&](size_t iregion) {
+        try_region_swaps(place_regions, iregion, t, *costs, prev_inverse_costs, rlim,
+                         delay_model, placer_opts, region_swaps[iregion]);
+    };
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for(size_t(0), region_swaps.size(), try_swaps);
+#else
+    for (size_t iregion = 0; iregion < region_swaps.size(); ++iregion) {
+        try_swaps(iregion);
+    }
+#endif
+
+    int num_moves_made = 0;
+    for (const t_region_swaps& swaps : region_swaps) {
+        costs->cost += swaps.delta_costs.cost;
+        costs->bb_cost += swaps.delta_costs.bb_cost;
+        costs->timing_cost += swaps.delta_costs.timing_cost;
+
+        stats->success_sum += swaps.stats.success_sum;
+        stats->av_cost += swaps.stats.av_cost;
+        stats->av_bb_cost += swaps.stats.av_bb_cost;
+        stats->av_timing_cost += swaps.stats.av_timing_cost;
+        stats->sum_of_squares += swaps.stats.sum_of_squares;
+
+        num_swap_accepted += swaps.num_accepted;
+        num_swap_rejected += swaps.num_rejected;
+        num_swap_aborted += swaps.num_aborted;
+        num_moves_made += swaps.num_moves;
+
+        //Region moves pick their target locations as the uniform move generator does
+        t_move_type_stats& uniform_stats = f_move_type_stats[size_t(e_place_move_generator::UNIFORM)];
+        uniform_stats.num_accepted += swaps.num_accepted;
+        uniform_stats.num_rejected += swaps.num_rejected;
+        uniform_stats.num_aborted += swaps.num_aborted;
+    }
+    num_ts_called += num_moves_made;
+
+    if (placer_opts.place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
+        //Synchronize the timing cost, which accumulated the changes of all the regions
+        comp_td_costs(delay_model, &costs->timing_cost);
+    }
+
+    return num_moves_made;
+}
+
+//Makes the moves of a region. The costs of the placement are not updated, instead the changes
+//in costs (and the statistics of the accepted moves) are accumulated in region_swaps.
+//
+//Only the blocks, locations and nets of the region are used (see PlaceRegions), so the
+//regions can be processed in parallel.
+static void try_region_swaps(const PlaceRegions& place_regions,
+                             size_t iregion,
+                             float t,
+                             const t_placer_costs& costs,
+                             const t_placer_prev_inverse_costs* prev_inverse_costs,
+                             float rlim,
+                             const PlaceDelayModel* delay_model,
+                             const t_placer_opts& placer_opts,
+                             t_region_swaps& region_swaps) {
+    for (int imove = 0; imove < region_swaps.num_moves; ++imove) {
+        e_move_result swap_result = try_region_swap(place_regions, iregion, t, prev_inverse_costs, rlim,
+                                                    delay_model, placer_opts, region_swaps);
+
+        if (swap_result == ACCEPTED) {
+            //Costs of the placement as seen by the region
+            double cost = costs.cost + region_swaps.delta_costs.cost;
+            double bb_cost = costs.bb_cost + region_swaps.delta_costs.bb_cost;
+            double timing_cost = costs.timing_cost + region_swaps.delta_costs.timing_cost;
+
+            region_swaps.stats.success_sum++;
+            region_swaps.stats.av_cost += cost;
+            region_swaps.stats.av_bb_cost += bb_cost;
+            region_swaps.stats.av_timing_cost += timing_cost;
+            region_swaps.stats.sum_of_squares += cost * cost;
+            region_swaps.num_accepted++;
+        } else if (swap_result == ABORTED) {
+            region_swaps.num_aborted++;
+        } else { // swap_result == REJECTED
+            region_swaps.num_rejected++;
+        }
+    }
+}
+
+//Same as try_swap(), but the move swaps a block of the region with another block (or an empty
+//location) of the region, using the random number generator of the region
+static e_move_result try_region_swap(const PlaceRegions& place_regions,
+                                     size_t iregion,
+                                     float t,
+                                     const t_placer_prev_inverse_costs* prev_inverse_costs,
+                                     float rlim,
+                                     const PlaceDelayModel* delay_model,
+                                     const t_placer_opts& placer_opts,
+                                     t_region_swaps& region_swaps) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& place_ctx = g_vpr_ctx.placement();
+
+    const auto& region_blocks = place_regions.region_blocks(iregion);
+    t_pl_blocks_to_be_moved& blocks_affected = region_swaps.blocks_affected;
+
+    if (placer_opts.rlim_escape_fraction > 0. && vtr::frand(region_swaps.rand_state) < placer_opts.rlim_escape_fraction) {
+        rlim = std::numeric_limits<float>::infinity();
+    }
+
+    ClusterBlockId b_from = region_blocks[vtr::irand(region_blocks.size() - 1, region_swaps.rand_state)];
+    t_pl_loc from = place_ctx.block_locs[b_from].loc;
+
+    t_pl_loc to;
+    if (!find_to_loc_uniform(cluster_ctx.clb_nlist.block_type(b_from), rlim, from, to,
+                             place_regions.region(iregion), region_swaps.rand_state)) {
+        return ABORTED;
+    }
+
+    //The block at the swap to location (if any) must also be movable within the region
+    ClusterBlockId b_to = place_ctx.grid_blocks[to.x][to.y].blocks[to.z];
+    if (b_to != EMPTY_BLOCK_ID
+        && (b_to == INVALID_BLOCK_ID || place_regions.block_region(b_to) != int(iregion))) {
+        return ABORTED;
+    }
+
+    if (create_move(blocks_affected, b_from, to) == e_create_move::ABORT) {
+        clear_move_blocks(blocks_affected);
+        return ABORTED;
+    }
+
+    double delta_c = 0;
+    double bb_delta_c = 0;
+    double timing_delta_c = 0;
+    e_move_result move_outcome = evaluate_move(t, prev_inverse_costs, blocks_affected, delay_model,
+                                               placer_opts.place_algorithm, placer_opts.timing_tradeoff,
+                                               region_swaps.nets_to_update, &region_swaps.rand_state,
+                                               delta_c, bb_delta_c, timing_delta_c);
+
+    if (move_outcome == ACCEPTED) {
+        region_swaps.delta_costs.cost += delta_c;
+        region_swaps.delta_costs.bb_cost += bb_delta_c;
+
+        if (placer_opts.place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
+            region_swaps.delta_costs.timing_cost += timing_delta_c;
+        }
+    }
+
+    clear_move_blocks(blocks_affected);
+
+    return move_outcome;
+}
+
 //Puts all the nets changed by the current swap into nets_to_update,
 //and updates their bounding box.
 //
@@ -1314,6 +1815,7 @@ static e_move_result try_swap(float t,
 static int find_affected_nets_and_update_costs(e_place_algorithm place_algorithm,
                                                const t_pl_blocks_to_be_moved& blocks_affected,
                                                const PlaceDelayModel* delay_model,
+                                               std::vector<ClusterNetId>& nets_to_update,
                                                double& bb_delta_c,
                                                double& timing_delta_c) {
     VTR_ASSERT_SAFE(bb_delta_c == 0.);
@@ -1335,7 +1837,7 @@ static int find_affected_nets_and_update_costs(e_place_algorithm place_algorithm
                 continue; //TODO: do we require anyting special here for global nets. "Global nets are assumed to span the whole chip, and do not effect costs"
 
             //Record effected nets
-            record_affected_net(net_id, num_affected_nets);
+            record_affected_net(net_id, nets_to_update, num_affected_nets);
 
             //Update the net bounding boxes
             //
@@ -1354,7 +1856,7 @@ static int find_affected_nets_and_update_costs(e_place_algorithm place_algorithm
      * The cost is only updated once per net.
      */
     for (int inet_affected = 0; inet_affected < num_affected_nets; inet_affected++) {
-        ClusterNetId net_id = ts_nets_to_update[inet_affected];
+        ClusterNetId net_id = nets_to_update[inet_affected];
 
         temp_net_cost[net_id] = get_net_cost(net_id, &ts_bb_coord_new[net_id]);
         bb_delta_c += temp_net_cost[net_id] - net_cost[net_id];
@@ -1363,11 +1865,11 @@ static int find_affected_nets_and_update_costs(e_place_algorithm place_algorithm
     return num_affected_nets;
 }
 
-static void record_affected_net(const ClusterNetId net, int& num_affected_nets) {
+static void record_affected_net(const ClusterNetId net, std::vector<ClusterNetId>& nets_to_update, int& num_affected_nets) {
     //Record effected nets
     if (temp_net_cost[net] < 0.) {
         //Net not marked yet.
-        ts_nets_to_update[num_affected_nets] = net;
+        nets_to_update[num_affected_nets] = net;
         num_affected_nets++;
 
         //Flag to say we've marked this net.
@@ -1441,8 +1943,9 @@ static void update_td_delta_costs(const PlaceDelayModel* delay_model, const t_pl
     }
 }
 
-static e_move_result assess_swap(double delta_c, double t) {
-    /* Returns: 1 -> move accepted, 0 -> rejected. */
+static e_move_result assess_swap(double delta_c, double t, vtr::RandState* rand_state) {
+    /* Returns: 1 -> move accepted, 0 -> rejected.                          *
+     * A null rand_state uses the global random number generator.           */
     if (delta_c <= 0) {
         return ACCEPTED;
     }
@@ -1451,7 +1954,7 @@ static e_move_result assess_swap(double delta_c, double t) {
         return REJECTED;
     }
 
-    float fnum = vtr::frand();
+    float fnum = rand_state ? vtr::frand(*rand_state) : vtr::frand();
     float prob_fac = std::exp(-delta_c / t);
     if (prob_fac > fnum) {
         return ACCEPTED;
@@ -1627,6 +2130,39 @@ static void comp_td_costs(const PlaceDelayModel* delay_model, double* timing_cos
     *timing_cost = new_timing_cost;
 }
 
+/* Updates the timing analysis after some moves were committed. Only the timing   *
+ * graph edges of the connections whose delay changed since the last analysis are *
+ * invalidated, so the arrival and required times are only re-propagated through *
+ * the fan-out and fan-in cones of these connections (the timing analyzer falls  *
+ * back to a full analysis if too many of them changed).                          */
+static void update_placement_timing(TimingInfo& timing_info, const ClusteredPinAtomPinsLookup& netlist_pin_lookup) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
+        for (size_t ipin = 1; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ipin++) {
+            if (point_to_point_delay[net_id][ipin] != analyzed_point_to_point_delay[net_id][ipin]) {
+                ClusterPinId pin_id = cluster_ctx.clb_nlist.net_pin(net_id, ipin);
+                invalidate_clb_connection_timing_edges(timing_info, netlist_pin_lookup, pin_id);
+
+                analyzed_point_to_point_delay[net_id][ipin] = point_to_point_delay[net_id][ipin];
+            }
+        }
+    }
+
+    timing_info.update();
+}
+
+/* Records the current delays as those of the last timing analysis */
+static void save_analyzed_point_to_point_delays() {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
+        for (size_t ipin = 1; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ipin++) {
+            analyzed_point_to_point_delay[net_id][ipin] = point_to_point_delay[net_id][ipin];
+        }
+    }
+}
+
 /* Finds the cost from scratch.  Done only when the placement   *
  * has been radically changed (i.e. after initial placement).   *
  * Otherwise find the cost change incrementally.  If method     *
@@ -1665,6 +2201,34 @@ static double comp_bb_cost(e_cost_methods method) {
     return cost;
 }
 
+/* Creates the move generator selected by the placer options. */
+static std::unique_ptr<MoveGenerator> create_move_generator(const t_placer_opts& placer_opts) {
+    bool timing_driven = (placer_opts.place_algorithm == PATH_TIMING_DRIVEN_PLACE);
+
+    switch (placer_opts.move_generator) {
+        case e_place_move_generator::UNIFORM:
+            return std::make_unique<UniformMoveGenerator>();
+        case e_place_move_generator::MEDIAN:
+            return std::make_unique<MedianMoveGenerator>();
+        case e_place_move_generator::CRITICAL:
+            if (!timing_driven) {
+                VPR_FATAL_ERROR(VPR_ERROR_PLACE, "Critical placement moves require timing-driven placement\n");
+            }
+            return std::make_unique<CriticalMoveGenerator>();
+        case e_place_move_generator::ADAPTIVE: {
+            std::vector<std::unique_ptr<MoveGenerator>> move_generators;
+            move_generators.push_back(std::make_unique<UniformMoveGenerator>());
+            move_generators.push_back(std::make_unique<MedianMoveGenerator>());
+            if (timing_driven) {
+                move_generators.push_back(std::make_unique<CriticalMoveGenerator>());
+            }
+            return std::make_unique<AdaptiveMoveGenerator>(std::move(move_generators));
+        }
+        default:
+            VPR_FATAL_ERROR(VPR_ERROR_PLACE, "Unrecognized placement move generator\n");
+    }
+}
+
 /* Frees the major structures needed by the placer (and not needed       *
  * elsewhere).   */
 static void free_placement_structs(const t_placer_opts& placer_opts) {
@@ -1687,16 +2251,22 @@ static void free_placement_structs(const t_placer_opts& placer_opts) {
 
             temp_point_to_point_delay[net_id]++;
             free(temp_point_to_point_delay[net_id]);
+
+            analyzed_point_to_point_delay[net_id]++;
+            free(analyzed_point_to_point_delay[net_id]);
         }
 
         point_to_point_timing_cost.clear();
         point_to_point_delay.clear();
         temp_point_to_point_timing_cost.clear();
         temp_point_to_point_delay.clear();
+        analyzed_point_to_point_delay.clear();
 
         net_pin_indices.clear();
     }
 
+    net_pin_locs = t_net_pin_locs();
+
     free_placement_macros_structs();
 
     /* Frees up all the data structure used in vpr_utils. */
@@ -1731,6 +2301,7 @@ static void alloc_and_load_placement_structs(float place_cost_exp,
         /* [0..cluster_ctx.clb_nlist.nets().size()-1][1..num_pins-1]  */
         point_to_point_delay.resize(num_nets);
         temp_point_to_point_delay.resize(num_nets);
+        analyzed_point_to_point_delay.resize(num_nets);
 
         point_to_point_timing_cost.resize(num_nets);
         temp_point_to_point_timing_cost.resize(num_nets);
@@ -1745,6 +2316,9 @@ static void alloc_and_load_placement_structs(float place_cost_exp,
             temp_point_to_point_delay[net_id] = (float*)vtr::malloc(num_sinks * sizeof(float));
             temp_point_to_point_delay[net_id]--;
 
+            analyzed_point_to_point_delay[net_id] = (float*)vtr::malloc(num_sinks * sizeof(float));
+            analyzed_point_to_point_delay[net_id]--;
+
             point_to_point_timing_cost[net_id] = (double*)vtr::malloc(num_sinks * sizeof(double));
             point_to_point_timing_cost[net_id]--;
 
@@ -1755,6 +2329,7 @@ static void alloc_and_load_placement_structs(float place_cost_exp,
             for (ipin = 1; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ipin++) {
                 point_to_point_delay[net_id][ipin] = 0;
                 temp_point_to_point_delay[net_id][ipin] = 0;
+                analyzed_point_to_point_delay[net_id][ipin] = 0;
             }
         }
     }
@@ -1831,74 +2406,85 @@ static void alloc_and_load_try_swap_structs() {
  * from only the block location information).  It updates both the       *
  * coordinate and number of pins on each edge information.  It           *
  * should only be called when the bounding box information is not valid. */
-static void get_bb_from_scratch(ClusterNetId net_id, t_bb* coords, t_bb* num_on_edges) {
-    int pnum, x, y, xmin, xmax, ymin, ymax;
-    int xmin_edge, xmax_edge, ymin_edge, ymax_edge;
+/* (Re)loads the pin locations of all the nets from the block locations. */
+static void load_net_pin_locs() {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    net_pin_locs.net_starts.resize(cluster_ctx.clb_nlist.nets().size() + 1);
+    size_t num_pins = 0;
+    for (ClusterNetId net_id : cluster_ctx.clb_nlist.nets()) {
+        net_pin_locs.net_starts[size_t(net_id)] = num_pins;
+        num_pins += cluster_ctx.clb_nlist.net_pins(net_id).size();
+    }
+    net_pin_locs.net_starts.back() = num_pins;
+
+    net_pin_locs.x.resize(num_pins);
+    net_pin_locs.y.resize(num_pins);
+    for (ClusterBlockId blk_id : cluster_ctx.clb_nlist.blocks()) {
+        update_block_net_pin_locs(blk_id);
+    }
+}
 
+/* Updates the pin locations of the moved blocks from their current locations. */
+static void update_net_pin_locs(const t_pl_blocks_to_be_moved& blocks_affected) {
+    for (int iblk = 0; iblk < blocks_affected.num_moved_blocks; iblk++) {
+        update_block_net_pin_locs(blocks_affected.moved_blocks[iblk].block_num);
+    }
+}
+
+static void update_block_net_pin_locs(ClusterBlockId blk) {
     auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& place_ctx = g_vpr_ctx.placement();
-    auto& device_ctx = g_vpr_ctx.device();
-    auto& grid = device_ctx.grid;
-
-    ClusterBlockId bnum = cluster_ctx.clb_nlist.net_driver_block(net_id);
-    pnum = net_pin_to_tile_pin_index(net_id, 0);
-    VTR_ASSERT(pnum >= 0);
-    x = place_ctx.block_locs[bnum].loc.x + physical_tile_type(bnum)->pin_width_offset[pnum];
-    y = place_ctx.block_locs[bnum].loc.y + physical_tile_type(bnum)->pin_height_offset[pnum];
-
-    x = max(min<int>(x, grid.width() - 2), 1);
-    y = max(min<int>(y, grid.height() - 2), 1);
-
-    xmin = x;
-    ymin = y;
-    xmax = x;
-    ymax = y;
-    xmin_edge = 1;
-    ymin_edge = 1;
-    xmax_edge = 1;
-    ymax_edge = 1;
-
-    for (auto pin_id : cluster_ctx.clb_nlist.net_sinks(net_id)) {
-        bnum = cluster_ctx.clb_nlist.pin_block(pin_id);
-        pnum = tile_pin_index(pin_id);
-        x = place_ctx.block_locs[bnum].loc.x + physical_tile_type(bnum)->pin_width_offset[pnum];
-        y = place_ctx.block_locs[bnum].loc.y + physical_tile_type(bnum)->pin_height_offset[pnum];
-
-        /* Code below counts IO blocks as being within the 1..grid.width()-2, 1..grid.height()-2 clb array. *
+    auto& grid = g_vpr_ctx.device().grid;
+
+    const t_pl_loc& loc = place_ctx.block_locs[blk].loc;
+    t_physical_tile_type_ptr blk_type = physical_tile_type(blk);
+
+    for (ClusterPinId pin_id : cluster_ctx.clb_nlist.block_pins(blk)) {
+        ClusterNetId net_id = cluster_ctx.clb_nlist.pin_net(pin_id);
+        int pnum = tile_pin_index(pin_id);
+        size_t ipin = net_pin_locs.net_starts[size_t(net_id)] + cluster_ctx.clb_nlist.pin_net_index(pin_id);
+
+        /* IO blocks are counted as being within the 1..grid.width()-2, 1..grid.height()-2 clb array. *
          * This is because channels do not go out of the 0..grid.width()-2, 0..grid.height()-2 range, and   *
          * I always take all channels impinging on the bounding box to be within   *
          * that bounding box.  Hence, this "movement" of IO blocks does not affect *
          * the which channels are included within the bounding box, and it         *
          * simplifies the code a lot.                                              */
+        net_pin_locs.x[ipin] = max(min<int>(loc.x + blk_type->pin_width_offset[pnum], grid.width() - 2), 1);   //-2 for no perim channels
+        net_pin_locs.y[ipin] = max(min<int>(loc.y + blk_type->pin_height_offset[pnum], grid.height() - 2), 1); //-2 for no perim channels
+    }
+}
 
-        x = max(min<int>(x, grid.width() - 2), 1);  //-2 for no perim channels
-        y = max(min<int>(y, grid.height() - 2), 1); //-2 for no perim channels
-
-        if (x == xmin) {
-            xmin_edge++;
-        }
-        if (x == xmax) { /* Recall that xmin could equal xmax -- don't use else */
-            xmax_edge++;
-        } else if (x < xmin) {
-            xmin = x;
-            xmin_edge = 1;
-        } else if (x > xmax) {
-            xmax = x;
-            xmax_edge = 1;
-        }
-
-        if (y == ymin) {
-            ymin_edge++;
-        }
-        if (y == ymax) {
-            ymax_edge++;
-        } else if (y < ymin) {
-            ymin = y;
-            ymin_edge = 1;
-        } else if (y > ymax) {
-            ymax = y;
-            ymax_edge = 1;
-        }
+static void get_bb_from_scratch(ClusterNetId net_id, t_bb* coords, t_bb* num_on_edges) {
+    /* The pin locations of the net are contiguous, so the bounding box and  *
+     * the number of pins on its edges are found by two branch-free passes   *
+     * over them, which the compiler can vectorize (large nets).             */
+    size_t pins_begin = net_pin_locs.net_starts[size_t(net_id)];
+    size_t pins_end = net_pin_locs.net_starts[size_t(net_id) + 1];
+    const int* pin_x = net_pin_locs.x.data();
+    const int* pin_y = net_pin_locs.y.data();
+
+    int xmin = pin_x[pins_begin];
+    int xmax = pin_x[pins_begin];
+    int ymin = pin_y[pins_begin];
+    int ymax = pin_y[pins_begin];
+    for (size_t ipin = pins_begin + 1; ipin < pins_end; ++ipin) {
+        xmin = std::min(xmin, pin_x[ipin]);
+        xmax = std::max(xmax, pin_x[ipin]);
+        ymin = std::min(ymin, pin_y[ipin]);
+        ymax = std::max(ymax, pin_y[ipin]);
+    }
+
+    int xmin_edge = 0;
+    int xmax_edge = 0;
+    int ymin_edge = 0;
+    int ymax_edge = 0;
+    for (size_t ipin = pins_begin; ipin < pins_end; ++ipin) {
+        xmin_edge += (pin_x[ipin] == xmin);
+        xmax_edge += (pin_x[ipin] == xmax);
+        ymin_edge += (pin_y[ipin] == ymin);
+        ymax_edge += (pin_y[ipin] == ymax);
     }
 
     /* Copy the coordinates and number on edges information into the proper   *
@@ -1992,54 +2578,31 @@ static double get_net_cost(ClusterNetId net_id, t_bb* bbptr) {
 static void get_non_updateable_bb(ClusterNetId net_id, t_bb* bb_coord_new) {
     //TODO: account for multiple physical pin instances per logical pin
 
-    int xmax, ymax, xmin, ymin, x, y;
-    int pnum;
-
-    auto& cluster_ctx = g_vpr_ctx.clustering();
-    auto& place_ctx = g_vpr_ctx.placement();
-    auto& device_ctx = g_vpr_ctx.device();
-
-    ClusterBlockId bnum = cluster_ctx.clb_nlist.net_driver_block(net_id);
-    pnum = net_pin_to_tile_pin_index(net_id, 0);
-    x = place_ctx.block_locs[bnum].loc.x + physical_tile_type(bnum)->pin_width_offset[pnum];
-    y = place_ctx.block_locs[bnum].loc.y + physical_tile_type(bnum)->pin_height_offset[pnum];
-
-    xmin = x;
-    ymin = y;
-    xmax = x;
-    ymax = y;
-
-    for (auto pin_id : cluster_ctx.clb_nlist.net_sinks(net_id)) {
-        bnum = cluster_ctx.clb_nlist.pin_block(pin_id);
-        pnum = tile_pin_index(pin_id);
-        x = place_ctx.block_locs[bnum].loc.x + physical_tile_type(bnum)->pin_width_offset[pnum];
-        y = place_ctx.block_locs[bnum].loc.y + physical_tile_type(bnum)->pin_height_offset[pnum];
-
-        if (x < xmin) {
-            xmin = x;
-        } else if (x > xmax) {
-            xmax = x;
-        }
-
-        if (y < ymin) {
-            ymin = y;
-        } else if (y > ymax) {
-            ymax = y;
-        }
-    }
-
-    /* Now I've found the coordinates of the bounding box.  There are no *
-     * channels beyond device_ctx.grid.width()-2 and                     *
-     * device_ctx.grid.height() - 2, so I want to clip to that.  As well,*
-     * since I'll always include the channel immediately below and the   *
-     * channel immediately to the left of the bounding box, I want to    *
-     * clip to 1 in both directions as well (since minimum channel index *
-     * is 0).  See route_common.cpp for a channel diagram.               */
-
-    bb_coord_new->xmin = max(min<int>(xmin, device_ctx.grid.width() - 2), 1);  //-2 for no perim channels
-    bb_coord_new->ymin = max(min<int>(ymin, device_ctx.grid.height() - 2), 1); //-2 for no perim channels
-    bb_coord_new->xmax = max(min<int>(xmax, device_ctx.grid.width() - 2), 1);  //-2 for no perim channels
-    bb_coord_new->ymax = max(min<int>(ymax, device_ctx.grid.height() - 2), 1); //-2 for no perim channels
+    /* The pin locations are already clipped: there are no channels beyond *
+     * device_ctx.grid.width()-2 and device_ctx.grid.height() - 2, and I'll *
+     * always include the channel immediately below and the channel         *
+     * immediately to the left of the bounding box (the minimum channel     *
+     * index is 0).  See route_common.cpp for a channel diagram.            */
+    size_t pins_begin = net_pin_locs.net_starts[size_t(net_id)];
+    size_t pins_end = net_pin_locs.net_starts[size_t(net_id) + 1];
+    const int* pin_x = net_pin_locs.x.data();
+    const int* pin_y = net_pin_locs.y.data();
+
+    int xmin = pin_x[pins_begin];
+    int xmax = pin_x[pins_begin];
+    int ymin = pin_y[pins_begin];
+    int ymax = pin_y[pins_begin];
+    for (size_t ipin = pins_begin + 1; ipin < pins_end; ++ipin) {
+        xmin = std::min(xmin, pin_x[ipin]);
+        xmax = std::max(xmax, pin_x[ipin]);
+        ymin = std::min(ymin, pin_y[ipin]);
+        ymax = std::max(ymax, pin_y[ipin]);
+    }
+
+    bb_coord_new->xmin = xmin;
+    bb_coord_new->ymin = ymin;
+    bb_coord_new->xmax = xmax;
+    bb_coord_new->ymax = ymax;
 }
 
 static void update_bb(ClusterNetId net_id, t_bb* bb_coord_new, t_bb* bb_edge_new, int xold, int yold, int xnew, int ynew) {
@@ -2567,6 +3130,44 @@ static void print_place_status(const float t,
     fflush(stdout);
 }
 
+static void record_move_type_outcome(e_place_move_generator move_type, e_move_result move_outcome) {
+    t_move_type_stats& move_stats = f_move_type_stats[size_t(move_type)];
+    if (move_outcome == ACCEPTED) {
+        move_stats.num_accepted++;
+    } else if (move_outcome == ABORTED) {
+        move_stats.num_aborted++;
+    } else { // move_outcome == REJECTED
+        move_stats.num_rejected++;
+    }
+}
+
+static void reset_anneal_stats() {
+    f_move_type_stats.fill(t_move_type_stats());
+    f_timing_update_sec = 0.;
+}
+
+static void print_anneal_stats_header() {
+    fprintf(f_anneal_stats_file.get(), "temperature_index,t,rlim");
+    for (const char* move_type_name : PLACE_MOVE_TYPE_NAMES) {
+        fprintf(f_anneal_stats_file.get(), ",%s_accepted,%s_rejected,%s_aborted",
+                move_type_name, move_type_name, move_type_name);
+    }
+    fprintf(f_anneal_stats_file.get(), ",timing_update_sec\n");
+}
+
+//Writes the statistics of the moves made at a temperature, and resets them for the next one
+static void print_anneal_stats(int num_temps, float t, float rlim) {
+    if (f_anneal_stats_file) {
+        fprintf(f_anneal_stats_file.get(), "%d,%g,%g", num_temps, t, rlim);
+        for (const t_move_type_stats& move_stats : f_move_type_stats) {
+            fprintf(f_anneal_stats_file.get(), ",%zu,%zu,%zu",
+                    move_stats.num_accepted, move_stats.num_rejected, move_stats.num_aborted);
+        }
+        fprintf(f_anneal_stats_file.get(), ",%g\n", f_timing_update_sec);
+    }
+    reset_anneal_stats();
+}
+
 static void print_resources_utilization() {
     auto& place_ctx = g_vpr_ctx.placement();
     auto& cluster_ctx = g_vpr_ctx.clustering();
@@ -216,6 +216,8 @@ void DeltaDelayModel::read(const std::string& file) {
     // The second argument should be of type Matrix<X>::Reader where X is the
     // capnproto element type.
     ToNdMatrix<2, VprFloatEntry, float>(&delays_, model.getDelays(), ToFloat);
+
+    checksum_ = model.getChecksum();
 }
 
 void DeltaDelayModel::write(const std::string& file) const {
@@ -233,6 +235,8 @@ void DeltaDelayModel::write(const std::string& file) const {
     auto delay_values = model.getDelays();
     FromNdMatrix<2, VprFloatEntry, float>(&delay_values, delays_, FromFloat);
 
+    model.setChecksum(checksum_);
+
     // writeMessageToFile writes message to the specified file.
     writeMessageToFile(file, &builder);
 }
@@ -264,6 +268,8 @@ void OverrideDelayModel::read(const std::string& file) {
     }
 
     delay_overrides_ = vtr::make_flat_map2(std::move(overrides_arr));
+
+    checksum_ = model.getChecksum();
 }
 
 void OverrideDelayModel::write(const std::string& file) const {
@@ -290,6 +296,8 @@ void OverrideDelayModel::write(const std::string& file) const {
         elem.setDelay(src.second);
     }
 
+    model.setChecksum(checksum_);
+
     writeMessageToFile(file, &builder);
 }
 
@@ -1,6 +1,8 @@
 #ifndef PLACE_DELAY_MODEL_H
 #define PLACE_DELAY_MODEL_H
 
+#include <cstdint>
+
 #include "vtr_ndmatrix.h"
 #include "vtr_flat_map.h"
 #include "vpr_types.h"
@@ -35,6 +37,15 @@ class PlaceDelayModel {
     // Read place delay model from specified file.
     // May be unimplemented, in which case method should throw an exception.
     virtual void read(const std::string& file) = 0;
+
+    // Checksum of the inputs the delay model was computed from (rr graph and
+    // delay model options), or 0 if unknown. It is written to and read from
+    // delay model files, so that a file is only reused for the same inputs.
+    uint64_t checksum() const { return checksum_; }
+    void set_checksum(uint64_t checksum) { checksum_ = checksum; }
+
+  protected:
+    uint64_t checksum_ = 0;
 };
 
 //A simple delay model based on the distance (delta) between block locations
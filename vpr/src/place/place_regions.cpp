@@ -0,0 +1,127 @@
+#include <algorithm>
+
+#include "vtr_assert.h"
+
+#include "globals.h"
+#include "place_macro.h"
+#include "place_regions.h"
+
+//Regions are at least this wide (and high), so that they contain enough blocks
+//(and nets) for their moves to be worth evaluating in parallel
+constexpr int MIN_PLACE_REGION_SIZE = 16;
+
+//Maximum number of regions along each dimension of the device
+constexpr int MAX_PLACE_REGIONS_PER_DIM = 8;
+
+//Number of regions along a dimension of size grid_size
+static int num_dimension_regions(int grid_size) {
+    return std::max(1, std::min(grid_size / MIN_PLACE_REGION_SIZE, MAX_PLACE_REGIONS_PER_DIM));
+}
+
+//Returns the region index of each coordinate along a dimension of size grid_size
+static std::vector<int> split_dimension(int grid_size, float shift) {
+    int num_regions = num_dimension_regions(grid_size);
+    VTR_ASSERT(shift >= 0. && shift < 1.);
+
+    //Cutline icut separates regions icut - 1 and icut, and is within half a region of its uniform position
+    std::vector<int> cuts(num_regions + 1);
+    cuts[0] = 0;
+    cuts[num_regions] = grid_size;
+    for (int icut = 1; icut < num_regions; ++icut) {
+        cuts[icut] = int((icut + shift - 0.5) * grid_size / num_regions);
+    }
+
+    std::vector<int> coord_regions(grid_size);
+    for (int iregion = 0; iregion < num_regions; ++iregion) {
+        for (int coord = cuts[iregion]; coord < cuts[iregion + 1]; ++coord) {
+            coord_regions[coord] = iregion;
+        }
+    }
+    return coord_regions;
+}
+
+PlaceRegions::PlaceRegions(float shift_x, float shift_y) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& place_ctx = g_vpr_ctx.placement();
+
+    x_regions_ = split_dimension(device_ctx.grid.width(), shift_x);
+    y_regions_ = split_dimension(device_ctx.grid.height(), shift_y);
+
+    int num_x = x_regions_.back() + 1;
+    int num_y = y_regions_.back() + 1;
+    regions_.resize(num_x * num_y);
+    for (int x = 0; x < int(x_regions_.size()); ++x) {
+        for (int y = 0; y < int(y_regions_.size()); ++y) {
+            t_bb& region = regions_[y_regions_[y] * num_x + x_regions_[x]];
+            if (x == 0 || x_regions_[x - 1] != x_regions_[x]) {
+                region.xmin = x;
+            }
+            region.xmax = x;
+            if (y == 0 || y_regions_[y - 1] != y_regions_[y]) {
+                region.ymin = y;
+            }
+            region.ymax = y;
+        }
+    }
+
+    //A net can only be used by the moves of a region if all its blocks are in that region
+    vtr::vector<ClusterNetId, int> net_regions(cluster_ctx.clb_nlist.nets().size(), OPEN);
+    for (ClusterNetId net_id : cluster_ctx.clb_nlist.nets()) {
+        if (cluster_ctx.clb_nlist.net_is_ignored(net_id)) {
+            continue; //Ignored nets do not affect the costs of a move
+        }
+
+        ClusterBlockId driver = cluster_ctx.clb_nlist.net_driver_block(net_id);
+        int net_region = loc_region(place_ctx.block_locs[driver].loc);
+        for (ClusterPinId pin_id : cluster_ctx.clb_nlist.net_sinks(net_id)) {
+            ClusterBlockId sink = cluster_ctx.clb_nlist.pin_block(pin_id);
+            if (loc_region(place_ctx.block_locs[sink].loc) != net_region) {
+                net_region = OPEN;
+                break;
+            }
+        }
+        net_regions[net_id] = net_region;
+    }
+
+    region_blocks_.resize(regions_.size());
+    block_regions_.resize(cluster_ctx.clb_nlist.blocks().size(), OPEN);
+    for (ClusterBlockId blk_id : cluster_ctx.clb_nlist.blocks()) {
+        if (place_ctx.block_locs[blk_id].is_fixed) {
+            continue;
+        }
+        ++num_movable_blocks_;
+
+        int imacro;
+        get_imacro_from_iblk(&imacro, blk_id, place_ctx.pl_macros);
+        if (imacro != OPEN) {
+            continue; //Macro moves may displace blocks out of the region
+        }
+
+        int blk_region = loc_region(place_ctx.block_locs[blk_id].loc);
+        for (ClusterPinId pin_id : cluster_ctx.clb_nlist.block_pins(blk_id)) {
+            ClusterNetId net_id = cluster_ctx.clb_nlist.pin_net(pin_id);
+            if (!cluster_ctx.clb_nlist.net_is_ignored(net_id) && net_regions[net_id] != blk_region) {
+                blk_region = OPEN;
+                break;
+            }
+        }
+
+        if (blk_region != OPEN) {
+            block_regions_[blk_id] = blk_region;
+            region_blocks_[blk_region].push_back(blk_id);
+            ++num_region_blocks_;
+        }
+    }
+}
+
+bool PlaceRegions::can_split_device() {
+    auto& device_ctx = g_vpr_ctx.device();
+
+    return num_dimension_regions(device_ctx.grid.width()) * num_dimension_regions(device_ctx.grid.height()) > 1;
+}
+
+int PlaceRegions::loc_region(const t_pl_loc& loc) const {
+    int num_x = x_regions_.back() + 1;
+    return y_regions_[loc.y] * num_x + x_regions_[loc.x];
+}
@@ -0,0 +1,60 @@
+#ifndef VPR_PLACE_REGIONS_H
+#define VPR_PLACE_REGIONS_H
+#include <vector>
+
+#include "vpr_types.h"
+#include "clustered_netlist_fwd.h"
+#include "vtr_vector.h"
+
+//Spatially disjoint regions of the device used to evaluate placement moves in parallel
+//
+//The device is split by cutlines into a grid of rectangular regions. A block can be moved
+//within its region if all the nets it is connected to only connect blocks of that region.
+//The moves of different regions then never use the same blocks, locations or nets, and
+//their cost changes can be evaluated (and committed) independently.
+//
+//Blocks which are fixed, part of a macro or connected to a net spanning several regions
+//are not assigned to any region, and can only be moved by serial moves.
+class PlaceRegions {
+  public:
+    //Splits the device into regions. The cutlines are shifted from their uniform position
+    //by shift_x (resp. shift_y) times the region width (resp. height), with shifts in [0, 1),
+    //so that different shifts move the region boundaries
+    PlaceRegions(float shift_x, float shift_y);
+
+    //Returns true if the device is large enough to be split into several regions
+    static bool can_split_device();
+
+    size_t num_regions() const { return regions_.size(); }
+
+    //Region covered by iregion (inclusive grid coordinates)
+    const t_bb& region(size_t iregion) const { return regions_[iregion]; }
+
+    //Blocks which can be moved within iregion, in block id order
+    const std::vector<ClusterBlockId>& region_blocks(size_t iregion) const { return region_blocks_[iregion]; }
+
+    //Region in which blk can be moved, OPEN if it can only be moved by serial moves
+    int block_region(ClusterBlockId blk) const { return block_regions_[blk]; }
+
+    //Total number of blocks which can be moved within their region
+    size_t num_region_blocks() const { return num_region_blocks_; }
+
+    //Total number of blocks which are not fixed
+    size_t num_movable_blocks() const { return num_movable_blocks_; }
+
+  private:
+    int loc_region(const t_pl_loc& loc) const;
+
+  private:
+    std::vector<t_bb> regions_;
+    std::vector<std::vector<ClusterBlockId>> region_blocks_;
+    vtr::vector<ClusterBlockId, int> block_regions_;
+    size_t num_region_blocks_ = 0;
+    size_t num_movable_blocks_ = 0;
+
+    //Region column (resp. row) of each grid x (resp. y) coordinate
+    std::vector<int> x_regions_;
+    std::vector<int> y_regions_;
+};
+
+#endif
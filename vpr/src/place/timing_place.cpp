@@ -77,13 +77,13 @@ void set_timing_place_crit(ClusterNetId net_id, int ipin, float val) {
 }
 
 /**************************************/
-std::unique_ptr<PlaceDelayModel> alloc_lookups_and_criticalities(t_chan_width_dist chan_width_dist,
-                                                                 const t_placer_opts& placer_opts,
-                                                                 const t_router_opts& router_opts,
-                                                                 t_det_routing_arch* det_routing_arch,
-                                                                 std::vector<t_segment_inf>& segment_inf,
-                                                                 const t_direct_inf* directs,
-                                                                 const int num_directs) {
+const PlaceDelayModel* alloc_lookups_and_criticalities(t_chan_width_dist chan_width_dist,
+                                                       const t_placer_opts& placer_opts,
+                                                       const t_router_opts& router_opts,
+                                                       t_det_routing_arch* det_routing_arch,
+                                                       std::vector<t_segment_inf>& segment_inf,
+                                                       const t_direct_inf* directs,
+                                                       const int num_directs) {
     alloc_crit(&f_timing_place_crit_ch);
 
     return compute_place_delay_model(placer_opts, router_opts, det_routing_arch, segment_inf,
@@ -4,6 +4,10 @@
 #include <time.h>
 #include <limits>
 
+#if defined(VPR_USE_TBB)
+#    include <tbb/parallel_for.h>
+#endif
+
 #include "vtr_assert.h"
 #include "vtr_ndmatrix.h"
 #include "vtr_log.h"
@@ -12,6 +16,7 @@
 #include "vtr_memory.h"
 #include "vtr_time.h"
 #include "vtr_geometry.h"
+#include "vtr_hash.h"
 
 #include "arch_util.h"
 
@@ -33,6 +38,7 @@
 #include "route_profiling.h"
 #include "router_delay_profiling.h"
 #include "place_delay_model.h"
+#include "router_lookahead_map.h"
 
 #include "rr_graph_obj_util.h"
 
@@ -127,15 +133,24 @@ static void fix_uninitialized_coordinates(vtr::Matrix<float>& delta_delays);
 
 static float find_neightboring_average(vtr::Matrix<float>& matrix, int x, int y, int max_distance);
 
+static uint64_t compute_place_delay_model_checksum(const t_placer_opts& placer_opts,
+                                                   const t_router_opts& router_opts);
+
+static std::unique_ptr<PlaceDelayModel> alloc_place_delay_model(PlaceDelayModelType delay_model_type);
+
+static std::unique_ptr<PlaceDelayModel> reuse_place_delay_model(PlaceDelayModelType delay_model_type,
+                                                                const std::string& file,
+                                                                uint64_t checksum);
+
 /******* Globally Accessible Functions **********/
 
-std::unique_ptr<PlaceDelayModel> compute_place_delay_model(const t_placer_opts& placer_opts,
-                                                           const t_router_opts& router_opts,
-                                                           t_det_routing_arch* det_routing_arch,
-                                                           std::vector<t_segment_inf>& segment_inf,
-                                                           t_chan_width_dist chan_width_dist,
-                                                           const t_direct_inf* directs,
-                                                           const int num_directs) {
+const PlaceDelayModel* compute_place_delay_model(const t_placer_opts& placer_opts,
+                                                 const t_router_opts& router_opts,
+                                                 t_det_routing_arch* det_routing_arch,
+                                                 std::vector<t_segment_inf>& segment_inf,
+                                                 t_chan_width_dist chan_width_dist,
+                                                 const t_direct_inf* directs,
+                                                 const int num_directs) {
     vtr::ScopedStartFinishTimer timer("Computing placement delta delay look-up");
 
     init_placement_context();
@@ -154,30 +169,44 @@ std::unique_ptr<PlaceDelayModel> compute_place_delay_model(const t_placer_opts&
 
     int longest_length = get_longest_segment_length(segment_inf);
 
+    uint64_t checksum = compute_place_delay_model_checksum(placer_opts, router_opts);
+
+    //A delay model computed by a previous placement on the same rr graph is reused
+    auto cache_key = std::make_tuple(checksum, placer_opts.read_placement_delay_lookup);
+    const PlaceDelayModel* cached_place_delay_model = g_vpr_ctx.placement().cached_place_delay_model_.get(cache_key);
+    if (cached_place_delay_model) {
+        VTR_LOG("Reusing the placement delay model computed for the current rr graph\n");
+        free_routing_structs();
+        return cached_place_delay_model;
+    }
+
     /*now setup and compute the actual arrays */
     std::unique_ptr<PlaceDelayModel> place_delay_model;
-    if (placer_opts.delay_model_type == PlaceDelayModelType::DELTA) {
-        place_delay_model = std::make_unique<DeltaDelayModel>();
-    } else if (placer_opts.delay_model_type == PlaceDelayModelType::DELTA_OVERRIDE) {
-        place_delay_model = std::make_unique<OverrideDelayModel>();
+    if (!placer_opts.read_placement_delay_lookup.empty()) {
+        place_delay_model = alloc_place_delay_model(placer_opts.delay_model_type);
+        place_delay_model->read(placer_opts.read_placement_delay_lookup);
     } else {
-        VTR_ASSERT_MSG(false, "Invalid placer delay model");
-    }
+        //A delay model written by a previous run for the same rr graph and options
+        //is reused instead of being computed again
+        if (!placer_opts.write_placement_delay_lookup.empty()) {
+            place_delay_model = reuse_place_delay_model(placer_opts.delay_model_type, placer_opts.write_placement_delay_lookup, checksum);
+        }
 
-    if (placer_opts.read_placement_delay_lookup.empty()) {
-        place_delay_model->compute(route_profiler, placer_opts, router_opts, longest_length);
-    } else {
-        place_delay_model->read(placer_opts.read_placement_delay_lookup);
-    }
+        if (!place_delay_model) {
+            place_delay_model = alloc_place_delay_model(placer_opts.delay_model_type);
+            place_delay_model->compute(route_profiler, placer_opts, router_opts, longest_length);
+            place_delay_model->set_checksum(checksum);
 
-    if (!placer_opts.write_placement_delay_lookup.empty()) {
-        place_delay_model->write(placer_opts.write_placement_delay_lookup);
+            if (!placer_opts.write_placement_delay_lookup.empty()) {
+                place_delay_model->write(placer_opts.write_placement_delay_lookup);
+            }
+        }
     }
 
     /*free all data structures that are no longer needed */
     free_routing_structs();
 
-    return place_delay_model;
+    return g_vpr_ctx.mutable_placement().cached_place_delay_model_.set(cache_key, std::move(place_delay_model));
 }
 
 void DeltaDelayModel::compute(
@@ -365,20 +394,52 @@ static void generic_compute_matrix(
 
     auto& device_ctx = g_vpr_ctx.device();
 
+    t_physical_tile_type_ptr src_type = device_ctx.grid[source_x][source_y].type;
+    bool is_allowed_type = allowed_types.empty() || allowed_types.find(src_type->name) != allowed_types.end();
+
+    auto is_valid_sink = [&](int x, int y) {
+        t_physical_tile_type_ptr sink_type = device_ctx.grid[x][y].type;
+
+        bool src_or_target_empty = (src_type == device_ctx.EMPTY_PHYSICAL_TILE_TYPE
+                                    || sink_type == device_ctx.EMPTY_PHYSICAL_TILE_TYPE);
+
+        return !src_or_target_empty && is_allowed_type;
+    };
+
+    //The connections to the valid sinks are independent, so they are routed first (in parallel
+    //with VPR_USE_TBB), and their delays are then collected in the same order as serially
+    std::vector<vtr::Point<int>> valid_sinks;
     for (sink_x = start_x; sink_x <= end_x; sink_x++) {
         for (sink_y = start_y; sink_y <= end_y; sink_y++) {
-            delta_x = abs(sink_x - source_x);
-            delta_y = abs(sink_y - source_y);
-
-            t_physical_tile_type_ptr src_type = device_ctx.grid[source_x][source_y].type;
-            t_physical_tile_type_ptr sink_type = device_ctx.grid[sink_x][sink_y].type;
+            if (is_valid_sink(sink_x, sink_y)) {
+                valid_sinks.emplace_back(sink_x, sink_y);
+            }
+        }
+    }
 
-            bool src_or_target_empty = (src_type == device_ctx.EMPTY_PHYSICAL_TILE_TYPE
-                                        || sink_type == device_ctx.EMPTY_PHYSICAL_TILE_TYPE);
+    std::vector<float> sink_delays(valid_sinks.size(), IMPOSSIBLE_DELTA);
+    auto compute_sink_delay = [&](size_t isink) {
+        sink_delays[isink] = route_connection_delay(route_profiler, source_x, source_y,
+                                                    valid_sinks[isink].x(), valid_sinks[isink].y(),
+                                                    router_opts, measure_directconnect);
+    };
+#if defined(VPR_USE_TBB)
+    //The base costs are set before the threads start, so that they only read them
+    update_rr_base_costs(1);
+    tbb::parallel_for(size_t(0), valid_sinks.size(), compute_sink_delay);
+#else
+    for (size_t isink = 0; isink < valid_sinks.size(); isink++) {
+        compute_sink_delay(isink);
+    }
+#endif
 
-            bool is_allowed_type = allowed_types.empty() || allowed_types.find(src_type->name) != allowed_types.end();
+    size_t isink = 0;
+    for (sink_x = start_x; sink_x <= end_x; sink_x++) {
+        for (sink_y = start_y; sink_y <= end_y; sink_y++) {
+            delta_x = abs(sink_x - source_x);
+            delta_y = abs(sink_y - source_y);
 
-            if (src_or_target_empty || !is_allowed_type) {
+            if (!is_valid_sink(sink_x, sink_y)) {
                 if (matrix[delta_x][delta_y].empty()) {
                     //Only set empty target if we don't already have a valid delta delay
                     matrix[delta_x][delta_y].push_back(EMPTY_DELTA);
@@ -392,8 +453,8 @@ static void generic_compute_matrix(
                 }
             } else {
                 //Valid start/end
-
-                float delay = route_connection_delay(route_profiler, source_x, source_y, sink_x, sink_y, router_opts, measure_directconnect);
+                VTR_ASSERT(valid_sinks[isink] == vtr::Point<int>(sink_x, sink_y));
+                float delay = sink_delays[isink++];
 
 #ifdef VERBOSE
                 VTR_LOG("Computed delay: %12g delta: %d,%d (src: %d,%d sink: %d,%d)\n",
@@ -941,6 +1002,65 @@ void OverrideDelayModel::compute_override_delay_model(
     }
 }
 
+//Returns a checksum of everything the delay model is computed from: the rr graph
+//(i.e. the architecture and channel width) and the delay model/router options
+static uint64_t compute_place_delay_model_checksum(const t_placer_opts& placer_opts,
+                                                   const t_router_opts& router_opts) {
+    uint64_t checksum = compute_rr_graph_checksum();
+
+    vtr::checksum_combine(checksum, placer_opts.delay_model_type);
+    vtr::checksum_combine(checksum, placer_opts.delay_model_reducer);
+    for (char c : placer_opts.allowed_tiles_for_delay_model) {
+        vtr::checksum_combine(checksum, c);
+    }
+
+    vtr::checksum_combine(checksum, router_opts.lookahead_type);
+    vtr::checksum_combine(checksum, router_opts.astar_fac);
+    vtr::checksum_combine(checksum, router_opts.bend_cost);
+
+    return checksum;
+}
+
+static std::unique_ptr<PlaceDelayModel> alloc_place_delay_model(PlaceDelayModelType delay_model_type) {
+    std::unique_ptr<PlaceDelayModel> place_delay_model;
+    if (delay_model_type == PlaceDelayModelType::DELTA) {
+        place_delay_model = std::make_unique<DeltaDelayModel>();
+    } else if (delay_model_type == PlaceDelayModelType::DELTA_OVERRIDE) {
+        place_delay_model = std::make_unique<OverrideDelayModel>();
+    } else {
+        VTR_ASSERT_MSG(false, "Invalid placer delay model");
+    }
+    return place_delay_model;
+}
+
+//Reads the delay model from file if the file exists and was written for the
+//given checksum. Returns nullptr if there is no such delay model
+static std::unique_ptr<PlaceDelayModel> reuse_place_delay_model(PlaceDelayModelType delay_model_type,
+                                                                const std::string& file,
+                                                                uint64_t checksum) {
+    if (!vtr::file_exists(file.c_str())) {
+        return nullptr;
+    }
+
+    std::unique_ptr<PlaceDelayModel> place_delay_model = alloc_place_delay_model(delay_model_type);
+    try {
+        place_delay_model->read(file);
+    } catch (...) {
+        //Not a readable delay model (e.g. written for another delay model type),
+        //or reading is disabled: it is computed again
+        return nullptr;
+    }
+
+    if (place_delay_model->checksum() != checksum) {
+        VTR_LOG("Placement delay model '%s' was computed for a different routing resource graph or options, computing it again\n",
+                file.c_str());
+        return nullptr;
+    }
+
+    VTR_LOG("Reusing placement delay model '%s'\n", file.c_str());
+    return place_delay_model;
+}
+
 bool directconnect_exists(RRNodeId src_rr_node, RRNodeId sink_rr_node) {
     //Returns true if there is a directconnect between the two RR nodes
     //
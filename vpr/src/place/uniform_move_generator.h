@@ -4,6 +4,8 @@
 
 class UniformMoveGenerator : public MoveGenerator {
     e_create_move propose_move(t_pl_blocks_to_be_moved& affected_blocks, float rlim);
+
+    e_place_move_generator last_move_type() const { return e_place_move_generator::UNIFORM; }
 };
 
 #endif
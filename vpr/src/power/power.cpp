@@ -27,6 +27,9 @@
 #include <ctime>
 #include <cmath>
 #include <ctype.h>
+#include <map>
+#include <tuple>
+#include <vector>
 
 #include "vtr_util.h"
 #include "vtr_path.h"
@@ -61,6 +64,17 @@ typedef enum {
     POWER_BREAKDOWN_ENTRY_TYPE_BUFS_WIRES
 } e_power_breakdown_entry_type;
 
+/************************* STRUCTS **********************************/
+/* Routing multiplexers and buffers of the same configuration consume the same power.
+ * Most of them are in a few configurations (e.g., all the unused ones of the same size),
+ * so each configuration is only evaluated once when estimating the routing power.
+ * A multiplexer configuration is its number of inputs, its selected input,
+ * and the probabilities and densities of its inputs */
+struct t_power_routing_cache {
+    std::map<std::vector<float>, t_power_usage> mux_usages;
+    std::map<std::tuple<float, float, float, bool>, t_power_usage> buffer_usages;
+};
+
 /************************* File Scope **********************************/
 static vtr::vector<RRNodeId, t_rr_node_power> rr_node_power;
 
@@ -69,6 +83,18 @@ static vtr::vector<RRNodeId, t_rr_node_power> rr_node_power;
 static void power_usage_routing(t_power_usage* power_usage,
                                 const t_det_routing_arch* routing_arch,
                                 const std::vector<t_segment_inf>& segment_inf);
+static void power_usage_routing_mux(t_power_usage* power_usage,
+                                    t_power_routing_cache& cache,
+                                    int num_inputs,
+                                    float* in_prob,
+                                    float* in_dens,
+                                    int selected_input);
+static void power_usage_routing_buffer(t_power_usage* power_usage,
+                                       t_power_routing_cache& cache,
+                                       float size,
+                                       float in_prob,
+                                       float in_dens,
+                                       bool level_restorer);
 
 /* Tiles */
 static void power_usage_blocks(t_power_usage* power_usage);
@@ -777,6 +803,63 @@ static void dealloc_mux_graph_rec(t_mux_node* node) {
 /**
  * Calculates the power of the entire routing fabric (not local routing
  */
+/**
+ * Calculates the power of a routing multiplexer, whose output is level restored.
+ * Each configuration is evaluated once, and then looked up in the cache
+ */
+static void power_usage_routing_mux(t_power_usage* power_usage,
+                                    t_power_routing_cache& cache,
+                                    int num_inputs,
+                                    float* in_prob,
+                                    float* in_dens,
+                                    int selected_input) {
+    auto& power_ctx = g_vpr_ctx.power();
+
+    std::vector<float> config;
+    config.reserve(2 * num_inputs + 2);
+    config.push_back(num_inputs);
+    config.push_back(selected_input);
+    config.insert(config.end(), in_prob, in_prob + num_inputs);
+    config.insert(config.end(), in_dens, in_dens + num_inputs);
+
+    auto result = cache.mux_usages.find(config);
+    if (result != cache.mux_usages.end()) {
+        *power_usage = result->second;
+        return;
+    }
+
+    power_usage_mux_multilevel(power_usage,
+                               power_get_mux_arch(num_inputs, power_ctx.arch->mux_transistor_size),
+                               in_prob, in_dens, selected_input, true,
+                               power_ctx.solution_inf.T_crit);
+    cache.mux_usages[config] = *power_usage;
+}
+
+/**
+ * Calculates the power of a routing buffer.
+ * Each configuration is evaluated once, and then looked up in the cache
+ */
+static void power_usage_routing_buffer(t_power_usage* power_usage,
+                                       t_power_routing_cache& cache,
+                                       float size,
+                                       float in_prob,
+                                       float in_dens,
+                                       bool level_restorer) {
+    auto& power_ctx = g_vpr_ctx.power();
+
+    std::tuple<float, float, float, bool> config(size, in_prob, in_dens, level_restorer);
+
+    auto result = cache.buffer_usages.find(config);
+    if (result != cache.buffer_usages.end()) {
+        *power_usage = result->second;
+        return;
+    }
+
+    power_usage_buffer(power_usage, size, in_prob, in_dens, level_restorer,
+                       power_ctx.solution_inf.T_crit);
+    cache.buffer_usages[config] = *power_usage;
+}
+
 static void power_usage_routing(t_power_usage* power_usage,
                                 const t_det_routing_arch* routing_arch,
                                 const std::vector<t_segment_inf>& segment_inf) {
@@ -856,6 +939,7 @@ static void power_usage_routing(t_power_usage* power_usage,
     }
 
     /* Calculate power of all routing entities */
+    t_power_routing_cache cache;
     for (const RRNodeId& rr_node_idx : device_ctx.rr_graph.nodes()) {
         t_power_usage sub_power_usage;
         const RRGraph& rr_graph = device_ctx.rr_graph;
@@ -883,12 +967,10 @@ static void power_usage_routing(t_power_usage* power_usage,
                     VTR_ASSERT(node_power->in_prob);
 
                     /* Multiplexor */
-                    power_usage_mux_multilevel(&sub_power_usage,
-                                               power_get_mux_arch(rr_graph.node_in_edges(rr_node_idx).size(),
-                                                                  power_ctx.arch->mux_transistor_size),
-                                               node_power->in_prob, node_power->in_dens,
-                                               node_power->selected_input, true,
-                                               power_ctx.solution_inf.T_crit);
+                    power_usage_routing_mux(&sub_power_usage, cache,
+                                            rr_graph.node_in_edges(rr_node_idx).size(),
+                                            node_power->in_prob, node_power->in_dens,
+                                            node_power->selected_input);
                     power_add_usage(power_usage, &sub_power_usage);
                     power_component_add_usage(&sub_power_usage,
                                               POWER_COMPONENT_ROUTE_CB);
@@ -916,11 +998,10 @@ static void power_usage_routing(t_power_usage* power_usage,
                 VTR_ASSERT(node_power->selected_input < rr_graph.node_in_edges(rr_node_idx).size());
 
                 /* Multiplexor */
-                power_usage_mux_multilevel(&sub_power_usage,
-                                           power_get_mux_arch(rr_graph.node_in_edges(rr_node_idx).size(),
-                                                              power_ctx.arch->mux_transistor_size),
-                                           node_power->in_prob, node_power->in_dens,
-                                           node_power->selected_input, true, power_ctx.solution_inf.T_crit);
+                power_usage_routing_mux(&sub_power_usage, cache,
+                                        rr_graph.node_in_edges(rr_node_idx).size(),
+                                        node_power->in_prob, node_power->in_dens,
+                                        node_power->selected_input);
                 power_add_usage(power_usage, &sub_power_usage);
                 power_component_add_usage(&sub_power_usage,
                                           POWER_COMPONENT_ROUTE_SB);
@@ -962,10 +1043,9 @@ static void power_usage_routing(t_power_usage* power_usage,
                  */
 
                 /* Buffer */
-                power_usage_buffer(&sub_power_usage, buffer_size,
-                                   node_power->in_prob[node_power->selected_input],
-                                   node_power->in_dens[node_power->selected_input], true,
-                                   power_ctx.solution_inf.T_crit);
+                power_usage_routing_buffer(&sub_power_usage, cache, buffer_size,
+                                           node_power->in_prob[node_power->selected_input],
+                                           node_power->in_dens[node_power->selected_input], true);
                 power_add_usage(power_usage, &sub_power_usage);
                 power_component_add_usage(&sub_power_usage,
                                           POWER_COMPONENT_ROUTE_SB);
@@ -993,10 +1073,9 @@ static void power_usage_routing(t_power_usage* power_usage,
                 /* Buffer to next Switchbox */
                 if (switchbox_fanout) {
                     buffer_size = power_buffer_size_from_logical_effort(switchbox_fanout * power_ctx.commonly_used->NMOS_1X_C_d);
-                    power_usage_buffer(&sub_power_usage, buffer_size,
-                                       1 - node_power->in_prob[node_power->selected_input],
-                                       node_power->in_dens[node_power->selected_input], false,
-                                       power_ctx.solution_inf.T_crit);
+                    power_usage_routing_buffer(&sub_power_usage, cache, buffer_size,
+                                               1 - node_power->in_prob[node_power->selected_input],
+                                               node_power->in_dens[node_power->selected_input], false);
                     power_add_usage(power_usage, &sub_power_usage);
                     power_component_add_usage(&sub_power_usage,
                                               POWER_COMPONENT_ROUTE_SB);
@@ -1006,10 +1085,9 @@ static void power_usage_routing(t_power_usage* power_usage,
                 if (connectionbox_fanout) {
                     buffer_size = power_buffer_size_from_logical_effort(connectionbox_fanout * power_ctx.commonly_used->NMOS_1X_C_d);
 
-                    power_usage_buffer(&sub_power_usage, buffer_size,
-                                       1 - node_power->in_prob[node_power->selected_input],
-                                       node_power->in_dens[node_power->selected_input],
-                                       false, power_ctx.solution_inf.T_crit);
+                    power_usage_routing_buffer(&sub_power_usage, cache, buffer_size,
+                                               1 - node_power->in_prob[node_power->selected_input],
+                                               node_power->in_dens[node_power->selected_input], false);
                     power_add_usage(power_usage, &sub_power_usage);
                     power_component_add_usage(&sub_power_usage,
                                               POWER_COMPONENT_ROUTE_CB);
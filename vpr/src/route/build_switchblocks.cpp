@@ -129,6 +129,7 @@
 #include <algorithm>
 #include <iterator>
 #include <iostream>
+#include <tuple>
 
 #include "vtr_assert.h"
 #include "vtr_memory.h"
@@ -177,6 +178,14 @@ struct t_wire_switchpoint {
     int switchpoint; //Switchpoint of the wire
 };
 
+/* The results of the formulas of a switchblock. A formula only depends on the sizes of the wire sets
+ * (and on the source wire index), which take few distinct values across the FPGA, so each formula is
+ * parsed once per set of values rather than at every switchblock location.
+ * Formulas are keyed by their address in the t_switchblock_inf, which outlives the cache */
+struct t_sb_formula_cache {
+    std::map<std::tuple<const std::string*, int, int>, int> results;
+};
+
 /************ Typedefs ************/
 /* Used to get info about a given wire type based on the name */
 typedef std::map<std::string, Wire_Info> t_wire_type_sizes;
@@ -211,12 +220,15 @@ static void stampout_switchblocks_from_row(int sb_row_size,
 
 /* Compute the wire(s) that the wire at (x, y, from_side, to_side, from_wire) should connect to.
  * sb_conns is updated with the result */
-static void compute_wire_connections(int x_coord, int y_coord, enum e_side from_side, enum e_side to_side, const t_chan_details& chan_details_x, const t_chan_details& chan_details_y, t_switchblock_inf* sb, const DeviceGrid& grid, t_wire_type_sizes* wire_type_sizes, e_directionality directionality, t_sb_connection_map* sb_conns, vtr::RandState& rand_state);
+static void compute_wire_connections(int x_coord, int y_coord, enum e_side from_side, enum e_side to_side, const t_chan_details& chan_details_x, const t_chan_details& chan_details_y, t_switchblock_inf* sb, const DeviceGrid& grid, t_wire_type_sizes* wire_type_sizes, e_directionality directionality, t_sb_connection_map* sb_conns, vtr::RandState& rand_state, t_sb_formula_cache& formula_cache);
 
 /* ... sb_conn represents the 'coordinates' of the desired switch block connections */
-static void compute_wireconn_connections(const DeviceGrid& grid, e_directionality directionality, const t_chan_details& from_chan_details, const t_chan_details& to_chan_details, Switchblock_Lookup sb_conn, int from_x, int from_y, int to_x, int to_y, t_rr_type from_chan_type, t_rr_type to_chan_type, t_wire_type_sizes* wire_type_sizes, t_switchblock_inf* sb, t_wireconn_inf* wireconn_ptr, t_sb_connection_map* sb_conns, vtr::RandState& rand_state);
+static void compute_wireconn_connections(const DeviceGrid& grid, e_directionality directionality, const t_chan_details& from_chan_details, const t_chan_details& to_chan_details, Switchblock_Lookup sb_conn, int from_x, int from_y, int to_x, int to_y, t_rr_type from_chan_type, t_rr_type to_chan_type, t_wire_type_sizes* wire_type_sizes, t_switchblock_inf* sb, t_wireconn_inf* wireconn_ptr, t_sb_connection_map* sb_conns, vtr::RandState& rand_state, t_sb_formula_cache& formula_cache);
+
+static int evaluate_num_conns_formula(t_sb_formula_cache& formula_cache, const std::string& num_conns_formula, int from_wire_count, int to_wire_count);
 
-static int evaluate_num_conns_formula(std::string num_conns_formula, int from_wire_count, int to_wire_count);
+/* Returns the raw result of a permutation formula for a destination set of dest_W wires and the source wire src_wire_ind */
+static int evaluate_permutation_formula(t_sb_formula_cache& formula_cache, const std::string& permutation_formula, int dest_W, int src_wire_ind);
 
 /* returns the wire indices belonging to the types in 'wire_type_vec' and switchpoints in 'points' at the given channel segment */
 static std::vector<t_wire_switchpoint> get_switchpoint_wires(const DeviceGrid& grid, const t_chan_seg_details* chan_details, t_rr_type chan_type, int x, int y, e_side side, const std::vector<t_wire_switchpoints>& wire_switchpoints_vec, t_wire_type_sizes* wire_type_sizes, bool is_dest, SwitchPointOrder order, vtr::RandState& rand_state);
@@ -297,6 +309,7 @@ t_sb_connection_map* alloc_and_load_switchblock_permutations(const t_chan_detail
     /* iterate over all the switchblocks specified in the architecture */
     for (int i_sb = 0; i_sb < (int)switchblocks.size(); i_sb++) {
         t_switchblock_inf sb = switchblocks[i_sb];
+        t_sb_formula_cache formula_cache;
 
         /* verify that switchblock type matches specified directionality -- currently we have to stay consistent */
         if (directionality != sb.directionality) {
@@ -315,7 +328,7 @@ t_sb_connection_map* alloc_and_load_switchblock_permutations(const t_chan_detail
                          * the current wire will connect to */
                         compute_wire_connections(x_coord, y_coord, from_side, to_side,
                                                  chan_details_x, chan_details_y, &sb, grid,
-                                                 &wire_type_sizes, directionality, sb_conns, rand_state);
+                                                 &wire_type_sizes, directionality, sb_conns, rand_state, formula_cache);
                     }
                 }
             }
@@ -684,7 +697,7 @@ static std::vector<t_wire_switchpoint> get_switchpoint_wires(const DeviceGrid& g
 
 /* Compute the wire(s) that the wire at (x, y, from_side, to_side) should connect to.
  * sb_conns is updated with the result */
-static void compute_wire_connections(int x_coord, int y_coord, enum e_side from_side, enum e_side to_side, const t_chan_details& chan_details_x, const t_chan_details& chan_details_y, t_switchblock_inf* sb, const DeviceGrid& grid, t_wire_type_sizes* wire_type_sizes, e_directionality directionality, t_sb_connection_map* sb_conns, vtr::RandState& rand_state) {
+static void compute_wire_connections(int x_coord, int y_coord, enum e_side from_side, enum e_side to_side, const t_chan_details& chan_details_x, const t_chan_details& chan_details_y, t_switchblock_inf* sb, const DeviceGrid& grid, t_wire_type_sizes* wire_type_sizes, e_directionality directionality, t_sb_connection_map* sb_conns, vtr::RandState& rand_state, t_sb_formula_cache& formula_cache) {
     int from_x, from_y;                     /* index into source channel */
     int to_x, to_y;                         /* index into destination channel */
     t_rr_type from_chan_type, to_chan_type; /* the type of channel - i.e. CHANX or CHANY */
@@ -728,7 +741,7 @@ static void compute_wire_connections(int x_coord, int y_coord, enum e_side from_
          * current wireconn */
         compute_wireconn_connections(grid, directionality, from_chan_details, to_chan_details,
                                      sb_conn, from_x, from_y, to_x, to_y, from_chan_type, to_chan_type, wire_type_sizes,
-                                     sb, wireconn_ptr, sb_conns, rand_state);
+                                     sb, wireconn_ptr, sb_conns, rand_state, formula_cache);
     }
 
     return;
@@ -738,7 +751,7 @@ static void compute_wire_connections(int x_coord, int y_coord, enum e_side from_
  * channel segment with coordinate from_x/from_y) should connect to based on the specified 'wireconn_ptr'.
  * wireconn_ptr defines the source and destination sets of wire segments (based on wire segment type & switchpoint
  * as defined at the top of this file), and the indices of wires to connect to are relative to these sets */
-static void compute_wireconn_connections(const DeviceGrid& grid, e_directionality directionality, const t_chan_details& from_chan_details, const t_chan_details& to_chan_details, Switchblock_Lookup sb_conn, int from_x, int from_y, int to_x, int to_y, t_rr_type from_chan_type, t_rr_type to_chan_type, t_wire_type_sizes* wire_type_sizes, t_switchblock_inf* sb, t_wireconn_inf* wireconn_ptr, t_sb_connection_map* sb_conns, vtr::RandState& rand_state) {
+static void compute_wireconn_connections(const DeviceGrid& grid, e_directionality directionality, const t_chan_details& from_chan_details, const t_chan_details& to_chan_details, Switchblock_Lookup sb_conn, int from_x, int from_y, int to_x, int to_y, t_rr_type from_chan_type, t_rr_type to_chan_type, t_wire_type_sizes* wire_type_sizes, t_switchblock_inf* sb, t_wireconn_inf* wireconn_ptr, t_sb_connection_map* sb_conns, vtr::RandState& rand_state, t_sb_formula_cache& formula_cache) {
     constexpr bool verbose = false;
 
     /* vectors that will contain indices of the wires belonging to the source/dest wire types/points */
@@ -799,7 +812,7 @@ static void compute_wireconn_connections(const DeviceGrid& grid, e_directionalit
     //      * interleave (to ensure good diversity)
 
     //Determine how many connections to make
-    int num_conns = evaluate_num_conns_formula(wireconn_ptr->num_conns_formula, potential_src_wires.size(), potential_dest_wires.size());
+    int num_conns = evaluate_num_conns_formula(formula_cache, wireconn_ptr->num_conns_formula, potential_src_wires.size(), potential_dest_wires.size());
     VTR_ASSERT_MSG(num_conns >= 0, "Number of switchblock connections to create must be non-negative");
 
     VTR_LOGV(verbose, "  num_conns: %zu\n", num_conns);
@@ -833,10 +846,7 @@ static void compute_wireconn_connections(const DeviceGrid& grid, e_directionalit
         std::vector<std::string>& permutations_ref = sb->permutation_map[side_conn];
         for (int iperm = 0; iperm < (int)permutations_ref.size(); iperm++) {
             /* Convert the symbolic permutation formula to a number */
-            t_formula_data formula_data;
-            formula_data.set_var_value("W", dest_W);
-            formula_data.set_var_value("t", src_wire_ind);
-            int raw_dest_wire_ind = get_sb_formula_raw_result(permutations_ref[iperm].c_str(), formula_data);
+            int raw_dest_wire_ind = evaluate_permutation_formula(formula_cache, permutations_ref[iperm], dest_W, src_wire_ind);
             int dest_wire_ind = adjust_formula_result(raw_dest_wire_ind, src_W, dest_W, iconn);
 
             if (dest_wire_ind < 0) {
@@ -871,13 +881,37 @@ static void compute_wireconn_connections(const DeviceGrid& grid, e_directionalit
     }
 }
 
-static int evaluate_num_conns_formula(std::string num_conns_formula, int from_wire_count, int to_wire_count) {
+static int evaluate_num_conns_formula(t_sb_formula_cache& formula_cache, const std::string& num_conns_formula, int from_wire_count, int to_wire_count) {
+    auto key = std::make_tuple(&num_conns_formula, from_wire_count, to_wire_count);
+    auto iter = formula_cache.results.find(key);
+    if (iter != formula_cache.results.end()) {
+        return iter->second;
+    }
+
     t_formula_data vars;
 
     vars.set_var_value("from", from_wire_count);
     vars.set_var_value("to", to_wire_count);
 
-    return parse_formula(num_conns_formula, vars);
+    int result = parse_formula(num_conns_formula, vars);
+    formula_cache.results.emplace(key, result);
+    return result;
+}
+
+static int evaluate_permutation_formula(t_sb_formula_cache& formula_cache, const std::string& permutation_formula, int dest_W, int src_wire_ind) {
+    auto key = std::make_tuple(&permutation_formula, dest_W, src_wire_ind);
+    auto iter = formula_cache.results.find(key);
+    if (iter != formula_cache.results.end()) {
+        return iter->second;
+    }
+
+    t_formula_data formula_data;
+    formula_data.set_var_value("W", dest_W);
+    formula_data.set_var_value("t", src_wire_ind);
+
+    int result = get_sb_formula_raw_result(permutation_formula.c_str(), formula_data);
+    formula_cache.results.emplace(key, result);
+    return result;
 }
 
 /* Here we find the correct channel (x or y), and the coordinates to index into it based on the
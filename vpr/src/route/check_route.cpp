@@ -1,4 +1,12 @@
+#include <algorithm>
 #include <cstdio>
+#include <exception>
+#include <unordered_map>
+
+#if defined(VPR_USE_TBB)
+#    include <tbb/enumerable_thread_specific.h>
+#    include <tbb/parallel_for.h>
+#endif
 
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -16,10 +24,37 @@
 #include "route_tree_type.h"
 #include "route_tree_timing.h"
 
+/******************** Structures local to this module **********************/
+
+//Scratch flags used to check the routing of a net (one per thread)
+struct t_check_route_scratch {
+    t_check_route_scratch(size_t num_rr_nodes)
+        : connected_to_route(num_rr_nodes, false) {}
+
+    vtr::vector<RRNodeId, bool> connected_to_route; /* [0 .. device_ctx.rr_nodes.size()-1] */
+    std::vector<bool> pin_done;                     /* [0 .. num_net_pins-1] */
+};
+
+//The non-configurable sets, indexed by the nodes they contain (node sets) and
+//by the driving nodes of their edges (edge sets), so that the routing of each
+//net is only compared with the sets it may use
+struct t_non_configurable_rr_set_lookup {
+    std::vector<const std::set<RRNodeId>*> node_sets;
+    std::vector<const std::set<t_node_edge>*> edge_sets;
+
+    std::unordered_map<RRNodeId, std::vector<size_t>> node_to_node_sets;
+    std::unordered_map<RRNodeId, std::vector<size_t>> from_node_to_edge_sets;
+};
+
 /******************** Subroutines local to this module **********************/
+static void check_net(ClusterNetId net_id,
+                      enum e_route_type route_type,
+                      e_check_route_option check_route_option,
+                      const t_non_configurable_rr_set_lookup& non_configurable_rr_set_lookup,
+                      t_check_route_scratch& scratch);
 static void check_node_and_range(const RRNodeId& inode, enum e_route_type route_type);
 static void check_source(const RRNodeId& inode, ClusterNetId net_id);
-static void check_sink(const RRNodeId& inode, ClusterNetId net_id, bool* pin_done);
+static void check_sink(const RRNodeId& inode, ClusterNetId net_id, std::vector<bool>& pin_done);
 static void check_switch(t_trace* tptr, int num_switch);
 static bool check_adjacent(const RRNodeId& from_node, const RRNodeId& to_node);
 static int chanx_chany_adjacent(const RRNodeId& chanx_node, const RRNodeId& chany_node);
@@ -27,32 +62,31 @@ static void reset_flags(ClusterNetId inet, vtr::vector<RRNodeId, bool>& connecte
 static void check_locally_used_clb_opins(const t_clb_opins_used& clb_opins_used_locally,
                                          enum e_route_type route_type);
 
-static bool check_non_configurable_edges(ClusterNetId net, const t_non_configurable_rr_sets& non_configurable_rr_sets);
+static t_non_configurable_rr_set_lookup build_non_configurable_rr_set_lookup(const t_non_configurable_rr_sets& non_configurable_rr_sets);
+static bool check_non_configurable_edges(ClusterNetId net, const t_non_configurable_rr_set_lookup& non_configurable_rr_set_lookup);
 static void check_net_for_stubs(ClusterNetId net);
 
 /************************ Subroutine definitions ****************************/
 
-void check_route(enum e_route_type route_type) {
+void check_route(enum e_route_type route_type, e_check_route_option check_route_option) {
     /* This routine checks that a routing:  (1) Describes a properly         *
      * connected path for each net, (2) this path connects all the           *
      * pins spanned by that net, and (3) that no routing resources are       *
      * oversubscribed (the occupancy of everything is recomputed from        *
-     * scratch).                                                             */
-
-    int max_pins;
-    RRNodeId inode, prev_node;
-    unsigned int ipin;
-    bool valid, connects;
-    vtr::vector<RRNodeId, bool> connected_to_route; /* [0 .. device_ctx.rr_nodes.size()-1] */
-    t_trace* tptr;
-    bool* pin_done;
+     * scratch).                                                             *
+     * The nets are checked independently (in parallel with VPR_USE_TBB).    *
+     * With e_check_route_option::FULL, the non-configurable sets and the    *
+     * stubs of each net are checked as well.                                */
+
+    if (check_route_option == e_check_route_option::OFF) {
+        VTR_LOG_WARN("The user disabled the check route step.\n");
+        return;
+    }
 
     auto& device_ctx = g_vpr_ctx.device();
     auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& route_ctx = g_vpr_ctx.routing();
 
-    const int num_switches = device_ctx.rr_switch_inf.size();
-
     VTR_LOG("\n");
     VTR_LOG("Checking to ensure routing is legal...\n");
 
@@ -61,7 +95,7 @@ void check_route(enum e_route_type route_type) {
      * is a successful routing, but I want to double check it here.          */
 
     recompute_occupancy_from_scratch();
-    valid = feasible_routing();
+    bool valid = feasible_routing();
     if (valid == false) {
         VPR_ERROR(VPR_ERROR_ROUTE,
                   "Error in check_route -- routing resources are overused.\n");
@@ -69,111 +103,156 @@ void check_route(enum e_route_type route_type) {
 
     check_locally_used_clb_opins(route_ctx.clb_opins_used_locally, route_type);
 
-    auto non_configurable_rr_sets = identify_non_configurable_rr_sets();
-
-    connected_to_route.resize(device_ctx.rr_graph.nodes().size(), false);
-
-    max_pins = 0;
-    for (auto net_id : cluster_ctx.clb_nlist.nets())
-        max_pins = std::max(max_pins, (int)cluster_ctx.clb_nlist.net_pins(net_id).size());
-
-    pin_done = (bool*)vtr::malloc(max_pins * sizeof(bool));
+    t_non_configurable_rr_sets non_configurable_rr_sets;
+    t_non_configurable_rr_set_lookup non_configurable_rr_set_lookup;
+    if (check_route_option == e_check_route_option::FULL) {
+        non_configurable_rr_sets = identify_non_configurable_rr_sets();
+        non_configurable_rr_set_lookup = build_non_configurable_rr_set_lookup(non_configurable_rr_sets);
+    }
 
-    /* Now check that all nets are indeed connected. */
+    std::vector<ClusterNetId> nets;
     for (auto net_id : cluster_ctx.clb_nlist.nets()) {
         if (cluster_ctx.clb_nlist.net_is_ignored(net_id) || cluster_ctx.clb_nlist.net_sinks(net_id).size() == 0) /* Skip ignored nets. */
             continue;
+        nets.push_back(net_id);
+    }
 
-        for (ipin = 0; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ipin++)
-            pin_done[ipin] = false;
+    /* Now check that all nets are indeed connected. */
+#if defined(VPR_USE_TBB)
+    //Each thread uses its own scratch flags. The error of the first failing net (in net order)
+    //is reported, as in the serial check
+    tbb::enumerable_thread_specific<t_check_route_scratch> thread_scratch([&]() {
+        return t_check_route_scratch(device_ctx.rr_graph.nodes().size());
+    });
+    std::vector<std::exception_ptr> net_errors(nets.size());
+
+    tbb::parallel_for(size_t(0), nets.size(), [&](size_t inet) {
+        t_check_route_scratch& scratch = thread_scratch.local();
+        try {
+            check_net(nets[inet], route_type, check_route_option, non_configurable_rr_set_lookup, scratch);
+        } catch (...) {
+            net_errors[inet] = std::current_exception();
+
+            //The thread goes on with other nets: clear the flags left by the failed check
+            reset_flags(nets[inet], scratch.connected_to_route);
+        }
+    });
 
-        /* Check the SOURCE of the net. */
-        tptr = route_ctx.trace[net_id].head;
-        if (tptr == nullptr) {
-            VPR_ERROR(VPR_ERROR_ROUTE,
-                      "in check_route: net %d has no routing.\n", size_t(net_id));
+    for (const std::exception_ptr& error : net_errors) {
+        if (error) {
+            std::rethrow_exception(error);
         }
+    }
+#else
+    t_check_route_scratch scratch(device_ctx.rr_graph.nodes().size());
+    for (ClusterNetId net_id : nets) {
+        check_net(net_id, route_type, check_route_option, non_configurable_rr_set_lookup, scratch);
+    }
+#endif
 
-        inode = tptr->index;
-        check_node_and_range(inode, route_type);
-        check_switch(tptr, num_switches);
-        connected_to_route[inode] = true; /* Mark as in path. */
+    VTR_LOG("Completed routing consistency check successfully.\n");
+    VTR_LOG("\n");
+}
 
-        check_source(inode, net_id);
-        pin_done[0] = true;
+//Checks the routing of a single net, using the flags of scratch (which are all false
+//before the check, and after it if no error is thrown)
+static void check_net(ClusterNetId net_id,
+                      enum e_route_type route_type,
+                      e_check_route_option check_route_option,
+                      const t_non_configurable_rr_set_lookup& non_configurable_rr_set_lookup,
+                      t_check_route_scratch& scratch) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& route_ctx = g_vpr_ctx.routing();
 
-        prev_node = inode;
-        int prev_switch = tptr->iswitch;
-        tptr = tptr->next;
+    const int num_switches = device_ctx.rr_switch_inf.size();
 
-        /* Check the rest of the net */
-        size_t num_sinks = 0;
-        while (tptr != nullptr) {
-            inode = tptr->index;
-            check_node_and_range(inode, route_type);
-            check_switch(tptr, num_switches);
+    vtr::vector<RRNodeId, bool>& connected_to_route = scratch.connected_to_route;
+    std::vector<bool>& pin_done = scratch.pin_done;
+    pin_done.assign(cluster_ctx.clb_nlist.net_pins(net_id).size(), false);
 
-            if (prev_switch == OPEN) { //Start of a new branch
-                if (connected_to_route[inode] == false) {
-                    VPR_ERROR(VPR_ERROR_ROUTE,
-                              "in check_route: node %d does not link into existing routing for net %d.\n", size_t(inode), size_t(net_id));
-                }
-            } else { //Continuing along existing branch
-                connects = check_adjacent(prev_node, inode);
-                if (!connects) {
-                    VPR_ERROR(VPR_ERROR_ROUTE,
-                              "in check_route: found non-adjacent segments in traceback while checking net %d:\n"
-                              "  %s\n"
-                              "  %s\n",
-                              size_t(net_id),
-                              describe_rr_node(prev_node).c_str(),
-                              describe_rr_node(inode).c_str());
-                }
+    /* Check the SOURCE of the net. */
+    t_trace* tptr = route_ctx.trace[net_id].head;
+    if (tptr == nullptr) {
+        VPR_ERROR(VPR_ERROR_ROUTE,
+                  "in check_route: net %d has no routing.\n", size_t(net_id));
+    }
 
-                connected_to_route[inode] = true; /* Mark as in path. */
+    RRNodeId inode = tptr->index;
+    check_node_and_range(inode, route_type);
+    check_switch(tptr, num_switches);
+    connected_to_route[inode] = true; /* Mark as in path. */
 
-                if (device_ctx.rr_graph.node_type(inode) == SINK) {
-                    check_sink(inode, net_id, pin_done);
-                    num_sinks += 1;
-                }
+    check_source(inode, net_id);
+    pin_done[0] = true;
 
-            } /* End of prev_node type != SINK */
-            prev_node = inode;
-            prev_switch = tptr->iswitch;
-            tptr = tptr->next;
-        } /* End while */
+    RRNodeId prev_node = inode;
+    int prev_switch = tptr->iswitch;
+    tptr = tptr->next;
 
-        if (num_sinks != cluster_ctx.clb_nlist.net_sinks(net_id).size()) {
-            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                            "in check_route: net %zu (%s) has %zu SINKs (expected %zu).\n",
-                            size_t(net_id), cluster_ctx.clb_nlist.net_name(net_id).c_str(),
-                            num_sinks, cluster_ctx.clb_nlist.net_sinks(net_id).size());
-        }
+    /* Check the rest of the net */
+    size_t num_sinks = 0;
+    while (tptr != nullptr) {
+        inode = tptr->index;
+        check_node_and_range(inode, route_type);
+        check_switch(tptr, num_switches);
 
-        for (ipin = 0; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ipin++) {
-            if (pin_done[ipin] == false) {
-                VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                                "in check_route: net %zu does not connect to pin %d.\n", size_t(net_id), ipin);
+        if (prev_switch == OPEN) { //Start of a new branch
+            if (connected_to_route[inode] == false) {
+                VPR_ERROR(VPR_ERROR_ROUTE,
+                          "in check_route: node %d does not link into existing routing for net %d.\n", size_t(inode), size_t(net_id));
+            }
+        } else { //Continuing along existing branch
+            bool connects = check_adjacent(prev_node, inode);
+            if (!connects) {
+                VPR_ERROR(VPR_ERROR_ROUTE,
+                          "in check_route: found non-adjacent segments in traceback while checking net %d:\n"
+                          "  %s\n"
+                          "  %s\n",
+                          size_t(net_id),
+                          describe_rr_node(prev_node).c_str(),
+                          describe_rr_node(inode).c_str());
             }
-        }
 
-        check_non_configurable_edges(net_id, non_configurable_rr_sets);
+            connected_to_route[inode] = true; /* Mark as in path. */
 
-        check_net_for_stubs(net_id);
+            if (device_ctx.rr_graph.node_type(inode) == SINK) {
+                check_sink(inode, net_id, pin_done);
+                num_sinks += 1;
+            }
 
-        reset_flags(net_id, connected_to_route);
+        } /* End of prev_node type != SINK */
+        prev_node = inode;
+        prev_switch = tptr->iswitch;
+        tptr = tptr->next;
+    } /* End while */
 
-    } /* End for each net */
+    if (num_sinks != cluster_ctx.clb_nlist.net_sinks(net_id).size()) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                        "in check_route: net %zu (%s) has %zu SINKs (expected %zu).\n",
+                        size_t(net_id), cluster_ctx.clb_nlist.net_name(net_id).c_str(),
+                        num_sinks, cluster_ctx.clb_nlist.net_sinks(net_id).size());
+    }
 
-    free(pin_done);
-    connected_to_route.clear();
-    VTR_LOG("Completed routing consistency check successfully.\n");
-    VTR_LOG("\n");
+    for (size_t ipin = 0; ipin < pin_done.size(); ipin++) {
+        if (pin_done[ipin] == false) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                            "in check_route: net %zu does not connect to pin %zu.\n", size_t(net_id), ipin);
+        }
+    }
+
+    if (check_route_option == e_check_route_option::FULL) {
+        check_non_configurable_edges(net_id, non_configurable_rr_set_lookup);
+
+        check_net_for_stubs(net_id);
+    }
+
+    reset_flags(net_id, connected_to_route);
 }
 
 /* Checks that this SINK node is one of the terminals of inet, and marks   *
  * the appropriate pin as being reached.                                   */
-static void check_sink(const RRNodeId& inode, ClusterNetId net_id, bool* pin_done) {
+static void check_sink(const RRNodeId& inode, ClusterNetId net_id, std::vector<bool>& pin_done) {
     auto& device_ctx = g_vpr_ctx.device();
     auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& place_ctx = g_vpr_ctx.placement();
@@ -629,11 +708,53 @@ static void check_node_and_range(const RRNodeId& inode, enum e_route_type route_
     check_rr_node(inode, route_type, device_ctx);
 }
 
+static t_non_configurable_rr_set_lookup build_non_configurable_rr_set_lookup(const t_non_configurable_rr_sets& non_configurable_rr_sets) {
+    t_non_configurable_rr_set_lookup lookup;
+
+    for (const auto& rr_nodes : non_configurable_rr_sets.node_sets) {
+        for (RRNodeId inode : rr_nodes) {
+            lookup.node_to_node_sets[inode].push_back(lookup.node_sets.size());
+        }
+        lookup.node_sets.push_back(&rr_nodes);
+    }
+
+    for (const auto& rr_edges : non_configurable_rr_sets.edge_sets) {
+        for (const t_node_edge& edge : rr_edges) {
+            std::vector<size_t>& edge_sets = lookup.from_node_to_edge_sets[edge.from_node];
+            //The edges of a set are sorted, so the edges from the same node are consecutive
+            if (edge_sets.empty() || edge_sets.back() != lookup.edge_sets.size()) {
+                edge_sets.push_back(lookup.edge_sets.size());
+            }
+        }
+        lookup.edge_sets.push_back(&rr_edges);
+    }
+
+    return lookup;
+}
+
+//Returns the (sorted and unique) indices of the sets which are associated with the keys in the lookup
+template<typename Keys>
+static std::vector<size_t> find_non_configurable_sets(const Keys& keys, const std::unordered_map<RRNodeId, std::vector<size_t>>& lookup) {
+    std::vector<size_t> sets;
+    for (RRNodeId inode : keys) {
+        auto itr = lookup.find(inode);
+        if (itr != lookup.end()) {
+            sets.insert(sets.end(), itr->second.begin(), itr->second.end());
+        }
+    }
+    std::sort(sets.begin(), sets.end());
+    sets.erase(std::unique(sets.begin(), sets.end()), sets.end());
+    return sets;
+}
+
 //Checks that the specified routing is legal with respect to non-configurable edges
 //
 //For routing to be legal if *any* non-configurable edge is used, so must *all*
 //other non-configurable edges in the same set
-static bool check_non_configurable_edges(ClusterNetId net, const t_non_configurable_rr_sets& non_configurable_rr_sets) {
+//
+//Only the sets which share a node (or an edge driver) with the routing are checked,
+//in the same order as the sets of t_non_configurable_rr_sets
+static bool check_non_configurable_edges(ClusterNetId net, const t_non_configurable_rr_set_lookup& non_configurable_rr_set_lookup) {
     auto& route_ctx = g_vpr_ctx.routing();
     auto& cluster_ctx = g_vpr_ctx.clustering();
 
@@ -670,7 +791,8 @@ static bool check_non_configurable_edges(ClusterNetId net, const t_non_configura
 
     //Check that all nodes in each non-configurable set are full included if any element
     //within a set is used by the routing
-    for (const auto& rr_nodes : non_configurable_rr_sets.node_sets) {
+    for (size_t iset : find_non_configurable_sets(routing_nodes, non_configurable_rr_set_lookup.node_to_node_sets)) {
+        const auto& rr_nodes = *non_configurable_rr_set_lookup.node_sets[iset];
         //Compute the intersection of the routing and current non-configurable nodes set
         std::vector<RRNodeId> intersection;
         std::set_intersection(routing_nodes.begin(), routing_nodes.end(),
@@ -709,7 +831,12 @@ static bool check_non_configurable_edges(ClusterNetId net, const t_non_configura
 
     //Check that any sets of non-configurable RR graph edges are fully included
     //in the routing, if any of a set's edges are used
-    for (const auto& rr_edges : non_configurable_rr_sets.edge_sets) {
+    std::vector<RRNodeId> routing_edge_drivers;
+    for (const t_node_edge& edge : routing_edges) {
+        routing_edge_drivers.push_back(edge.from_node);
+    }
+    for (size_t iset : find_non_configurable_sets(routing_edge_drivers, non_configurable_rr_set_lookup.from_node_to_edge_sets)) {
+        const auto& rr_edges = *non_configurable_rr_set_lookup.edge_sets[iset];
         //Compute the intersection of the routing and current non-configurable edge set
         std::vector<t_node_edge> intersection;
         std::set_intersection(routing_edges.begin(), routing_edges.end(),
@@ -3,7 +3,7 @@
 #include "physical_types.h"
 #include "route_common.h"
 
-void check_route(enum e_route_type route_type);
+void check_route(enum e_route_type route_type, e_check_route_option check_route_option);
 
 void recompute_occupancy_from_scratch();
 
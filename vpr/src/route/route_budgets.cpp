@@ -18,6 +18,7 @@
  */
 
 #include <algorithm>
+#include <limits>
 #include "vpr_context.h"
 #include <fstream>
 #include "vpr_error.h"
@@ -44,10 +45,12 @@
 
 #include "vtr_assert.h"
 #include "vtr_log.h"
+#include "vtr_parallel.h"
 #include "route_timing.h"
 #include "tatum/report/TimingPathFwd.hpp"
 #include "tatum/base/TimingType.hpp"
 #include "timing_info.h"
+#include "timing_util.h"
 #include "tatum/echo_writer.hpp"
 #include "net_delay.h"
 #include "route_budgets.h"
@@ -73,6 +76,7 @@ void route_budgets::free_budgets() {
         free_net_delay(delay_upper_bound, &upper_bound_delay_ch);
         num_times_congested.clear();
     }
+    budget_sta.clear();
     set = false;
 }
 
@@ -301,10 +305,15 @@ float route_budgets::minimax_PERT(std::shared_ptr<SetupHoldTimingInfo> timing_in
     auto& atom_ctx = g_vpr_ctx.atom();
 
     std::shared_ptr<const tatum::SetupHoldTimingAnalyzer> timing_analyzer = timing_info->setup_hold_analyzer();
-    float total_path_delay = 0;
-    float path_slack;
-    float max_budget_change = 0;
-    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
+
+    /*Each connection only updates its own budget, so the nets are processed in parallel*/
+    std::vector<ClusterNetId> nets(cluster_ctx.clb_nlist.nets().begin(), cluster_ctx.clb_nlist.nets().end());
+    std::vector<float> net_max_budget_change(nets.size(), 0);
+    vtr::parallel_for(nets.size(), [&](size_t inet) {
+        ClusterNetId net_id = nets[inet];
+        float total_path_delay = 0;
+        float path_slack;
+        float& max_budget_change = net_max_budget_change[inet];
         for (auto pin_id : cluster_ctx.clb_nlist.net_sinks(net_id)) {
             int ipin = cluster_ctx.clb_nlist.pin_net_index(pin_id);
             AtomPinId atom_pin;
@@ -339,6 +348,11 @@ float route_budgets::minimax_PERT(std::shared_ptr<SetupHoldTimingInfo> timing_in
                 keep_budget_in_bounds(temp_budgets, net_id, pin_id);
             }
         }
+    });
+
+    float max_budget_change = 0;
+    for (float budget_change : net_max_budget_change) {
+        max_budget_change = std::max(max_budget_change, budget_change);
     }
     return max_budget_change;
 }
@@ -463,8 +477,12 @@ void route_budgets::allocate_slack_using_delays_and_criticalities(vtr::vector<Cl
      * The minimum delay budget is set to 0 to promote finding the fastest path*/
 
     auto& cluster_ctx = g_vpr_ctx.clustering();
-    float pin_criticality;
-    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
+
+    /*Each connection only sets its own budgets, so the nets are processed in parallel*/
+    std::vector<ClusterNetId> nets(cluster_ctx.clb_nlist.nets().begin(), cluster_ctx.clb_nlist.nets().end());
+    vtr::parallel_for(nets.size(), [&](size_t inet) {
+        ClusterNetId net_id = nets[inet];
+        float pin_criticality;
         for (auto pin_id : cluster_ctx.clb_nlist.net_sinks(net_id)) {
             pin_criticality = calculate_clb_net_pin_criticality(*timing_info, netlist_pin_lookup, pin_id);
 
@@ -499,7 +517,7 @@ void route_budgets::allocate_slack_using_delays_and_criticalities(vtr::vector<Cl
              * Tend towards minimum to consider short path timing delay more*/
             delay_target[net_id][ipin] = std::min(0.5 * (delay_min_budget[net_id][ipin] + delay_max_budget[net_id][ipin]), delay_min_budget[net_id][ipin] + 0.1e-9);
         }
-    }
+    });
 }
 
 void route_budgets::check_if_budgets_in_bounds(ClusterNetId net_id, ClusterPinId pin_id) {
@@ -526,15 +544,40 @@ void route_budgets::check_if_budgets_in_bounds() {
 
 std::shared_ptr<SetupHoldTimingInfo> route_budgets::perform_sta(vtr::vector<ClusterNetId, float*>& temp_budgets) {
     auto& atom_ctx = g_vpr_ctx.atom();
-    /*Perform static timing analysis to get the delay and path weights for slack allocation*/
-    std::shared_ptr<RoutingDelayCalculator> routing_delay_calc = std::make_shared<RoutingDelayCalculator>(atom_ctx.nlist, atom_ctx.lookup, temp_budgets);
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    /*Perform static timing analysis to get the delay and path weights for slack allocation.
+     * The analysis of the budgets is kept, so that the next analysis only re-analyzes the
+     * timing graph around the nets whose budgets changed since*/
+    t_budget_sta& sta = budget_sta[&temp_budgets];
+    bool incremental = (sta.timing_info != nullptr);
+    if (!incremental) {
+        std::shared_ptr<RoutingDelayCalculator> routing_delay_calc = std::make_shared<RoutingDelayCalculator>(atom_ctx.nlist, atom_ctx.lookup, temp_budgets);
 
-    std::shared_ptr<SetupHoldTimingInfo> timing_info = make_setup_hold_timing_info(routing_delay_calc);
-    /*Unconstrained nodes should be warned in the main routing function, do not report it here*/
-    timing_info->set_warn_unconstrained(false);
-    timing_info->update();
+        sta.timing_info = make_setup_hold_timing_info(routing_delay_calc);
+        /*Unconstrained nodes should be warned in the main routing function, do not report it here*/
+        sta.timing_info->set_warn_unconstrained(false);
+        sta.analyzed_budgets.resize(cluster_ctx.clb_nlist.nets().size());
+    }
+
+    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
+        std::vector<float>& analyzed_budgets = sta.analyzed_budgets[net_id];
+        analyzed_budgets.resize(cluster_ctx.clb_nlist.net_pins(net_id).size(), std::numeric_limits<float>::quiet_NaN());
+
+        bool budgets_changed = false;
+        for (auto pin_id : cluster_ctx.clb_nlist.net_sinks(net_id)) {
+            int ipin = cluster_ctx.clb_nlist.pin_net_index(pin_id);
+            if (analyzed_budgets[ipin] != temp_budgets[net_id][ipin]) {
+                analyzed_budgets[ipin] = temp_budgets[net_id][ipin];
+                budgets_changed = true;
+            }
+        }
+        if (incremental && budgets_changed) {
+            invalidate_clb_net_timing_edges(*sta.timing_info, net_id);
+        }
+    }
+    sta.timing_info->update();
 
-    return timing_info;
+    return sta.timing_info;
 }
 
 void route_budgets::update_congestion_times(ClusterNetId net_id) {
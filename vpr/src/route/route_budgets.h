@@ -5,9 +5,12 @@
 #define ROUTE_BUDGETS_H
 
 #include <iostream>
+#include <map>
+#include <memory>
 #include <vector>
 #include "vtr_memory.h"
 #include "RoutingDelayCalculator.h"
+#include "timing_info.h"
 
 enum analysis_type {
     SETUP,
@@ -98,6 +101,14 @@ class route_budgets {
     vtr::vector<ClusterNetId, float*> delay_lower_bound; //[0..num_nets][0..clb_net[inet].pins]
     vtr::vector<ClusterNetId, float*> delay_upper_bound; //[0..num_nets][0..clb_net[inet].pins]
 
+    /*The timing analysis of each budget array, kept between the iterations of the slack
+     * allocation so that only the nets whose budgets changed are re-analyzed*/
+    struct t_budget_sta {
+        std::shared_ptr<SetupHoldTimingInfo> timing_info;
+        vtr::vector<ClusterNetId, std::vector<float>> analyzed_budgets; //The budgets of the last analysis
+    };
+    std::map<const vtr::vector<ClusterNetId, float*>*, t_budget_sta> budget_sta;
+
     /*used to keep count the number of continuous time this node was congested*/
     vtr::vector<ClusterNetId, int> num_times_congested; //[0..num_nets]
 
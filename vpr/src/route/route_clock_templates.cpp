@@ -0,0 +1,118 @@
+#include "route_clock_templates.h"
+
+#include <queue>
+
+#include "vtr_log.h"
+
+#include "globals.h"
+#include "route_common.h"
+
+void build_clock_route_templates() {
+    auto& device_ctx = g_vpr_ctx.mutable_device();
+    const RRGraph& rr_graph = device_ctx.rr_graph;
+
+    device_ctx.clock_route_templates.clear();
+
+    const RRNodeId& clock_root = device_ctx.virtual_clock_network_root_idx;
+    if (!rr_graph.valid_node_id(clock_root)) {
+        return;
+    }
+
+    size_t num_template_nodes = 0;
+    for (const RREdgeId& root_edge : rr_graph.node_in_edges(clock_root)) {
+        RRNodeId entry_node = rr_graph.edge_src_node(root_edge);
+        if (device_ctx.clock_route_templates.count(entry_node)) {
+            continue;
+        }
+
+        //Breadth-first search of the clock network from the entry point, so each node is
+        //reached by the path through the fewest switches. The search does not go through
+        //block pins (no route-throughs) nor back to the virtual root.
+        std::unordered_map<RRNodeId, RREdgeId>& prev_edges = device_ctx.clock_route_templates[entry_node];
+        std::queue<RRNodeId> nodes_to_expand;
+        nodes_to_expand.push(entry_node);
+        while (!nodes_to_expand.empty()) {
+            RRNodeId from_node = nodes_to_expand.front();
+            nodes_to_expand.pop();
+
+            for (const RREdgeId& edge : rr_graph.node_out_edges(from_node)) {
+                RRNodeId to_node = rr_graph.edge_sink_node(edge);
+                t_rr_type to_type = rr_graph.node_type(to_node);
+                if (to_node == clock_root || to_node == entry_node || to_type == OPIN || to_type == SOURCE
+                    || prev_edges.count(to_node)) {
+                    continue;
+                }
+
+                prev_edges[to_node] = edge;
+                if (to_type != SINK) {
+                    nodes_to_expand.push(to_node);
+                }
+            }
+        }
+        num_template_nodes += prev_edges.size();
+    }
+
+    VTR_LOG("Built clock network route templates from %zu entry points (%zu nodes)\n",
+            device_ctx.clock_route_templates.size(), num_template_nodes);
+}
+
+t_heap* route_connection_from_clock_template(ClusterNetId net_id, const RRNodeId& sink_node, std::vector<RRNodeId>& modified_rr_node_inf) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& route_ctx = g_vpr_ctx.routing();
+    const RRGraph& rr_graph = device_ctx.rr_graph;
+    auto& rr_node_route_inf = get_thread_rr_node_route_inf();
+
+    const std::unordered_set<RRNodeId>& trace_nodes = route_ctx.trace_nodes[net_id];
+    if (trace_nodes.count(sink_node)) {
+        return nullptr;
+    }
+
+    for (const auto& clock_template : device_ctx.clock_route_templates) {
+        //Only the entry points the net was routed to can be used
+        if (!trace_nodes.count(clock_template.first)) {
+            continue;
+        }
+        const std::unordered_map<RRNodeId, RREdgeId>& prev_edges = clock_template.second;
+        if (!prev_edges.count(sink_node)) {
+            continue;
+        }
+
+        //Walk back from the sink until the template path joins the routing of the net,
+        //which it does at the entry point at the latest
+        std::vector<RREdgeId> path_edges;
+        bool path_available = true;
+        RRNodeId inode = sink_node;
+        while (!trace_nodes.count(inode)) {
+            if (rr_node_route_inf[inode].occ() >= rr_graph.node_capacity(inode)) {
+                path_available = false;
+                break;
+            }
+
+            RREdgeId iedge = prev_edges.at(inode);
+            path_edges.push_back(iedge);
+            inode = rr_graph.edge_src_node(iedge);
+        }
+        if (!path_available) {
+            continue;
+        }
+
+        //The last step (to the sink) is recorded by the caller from the returned heap element
+        for (size_t iedge = 1; iedge < path_edges.size(); ++iedge) {
+            RRNodeId to_node = rr_graph.edge_sink_node(path_edges[iedge]);
+            add_to_mod_list(to_node, modified_rr_node_inf);
+            rr_node_route_inf[to_node].prev_node = rr_graph.edge_src_node(path_edges[iedge]);
+            rr_node_route_inf[to_node].prev_edge = path_edges[iedge];
+        }
+
+        t_heap* cheapest = alloc_heap_data();
+        cheapest->index = sink_node;
+        cheapest->cost = 0.;
+        cheapest->backward_path_cost = 0.;
+        cheapest->R_upstream = 0.;
+        cheapest->u.prev.node = rr_graph.edge_src_node(path_edges.front());
+        cheapest->u.prev.edge = path_edges.front();
+        return cheapest;
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,32 @@
+#ifndef VPR_ROUTE_CLOCK_TEMPLATES_H
+#define VPR_ROUTE_CLOCK_TEMPLATES_H
+#include <vector>
+
+#include "vpr_types.h"
+#include "route_common.h"
+
+//Clock network route templates
+//
+//With a dedicated clock network and two stage clock routing, a clock net is first routed
+//to one of the entry points of the clock networks (the nodes driving the virtual clock
+//network root), and its sinks are then routed through the clock network from it.
+//
+//Since the clock networks do not depend on the placement, the path from each entry point
+//to each node of the clock network is computed once when the RR graph is built (the
+//template), and the sinks of the clock nets are connected along it rather than searched
+//by the router for each sink of each clock net at each routing iteration.
+
+//Computes the templates of the clock networks of the current RR graph
+//(see DeviceContext::clock_route_templates)
+void build_clock_route_templates();
+
+//Records the template path from the routing of net_id to sink_node in the rr_node_route_inf
+//of its nodes (which are added to modified_rr_node_inf), and returns the heap element of
+//sink_node describing its last step (as found by the router).
+//
+//Returns nullptr if the routing of the net does not contain an entry point whose template
+//reaches sink_node, or if a node of the path is already used to its capacity, in which case
+//the connection should be routed by the router.
+t_heap* route_connection_from_clock_template(ClusterNetId net_id, const RRNodeId& sink_node, std::vector<RRNodeId>& modified_rr_node_inf);
+
+#endif
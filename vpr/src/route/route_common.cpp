@@ -4,12 +4,15 @@
 #include <algorithm>
 #include <vector>
 #include <iostream>
+#include <memory>
+#include <mutex>
 
 #include "vtr_assert.h"
 #include "vtr_util.h"
 #include "vtr_log.h"
 #include "vtr_digest.h"
 #include "vtr_memory.h"
+#include "vtr_memory_stats.h"
 
 #include "vpr_types.h"
 #include "vpr_error.h"
@@ -19,9 +22,13 @@
 #include "globals.h"
 #include "route_export.h"
 #include "route_common.h"
+#include "binary_route.h"
+#include "router_heap.h"
 #include "route_tree_timing.h"
 #include "route_timing.h"
 #include "route_breadth_first.h"
+#include "route_warm_start.h"
+#include "net_delay.h"
 #include "place_and_route.h"
 #include "rr_graph.h"
 #include "rr_graph2.h"
@@ -44,23 +51,41 @@ struct t_trace_branch {
 
 /**************** Static variables local to route_common.c ******************/
 
-static t_heap** heap; /* Indexed from [1..heap_size] */
-static int heap_size; /* Number of slots in the heap array */
-static int heap_tail; /* Index of first unused slot in the heap array */
+/* The heap and the free lists are thread local, so that nets can be routed  *
+ * by several threads at once (see --parallel_routing). init_heap() empties  *
+ * the heap of the calling thread and reserves room for a typical routing.   *
+ * The memory of each thread is registered in route_memory_registry, so that *
+ * free_route_structs() and free_chunk_memory_trace() release the chunks of  *
+ * all the threads (including the worker threads which have exited) once    *
+ * the routing is over: the traces built by a worker outlive the worker.    */
+struct t_thread_route_memory {
+    RouterHeap heap;
+
+    /* For managing my own list of currently free heap data structures.     */
+    t_heap* heap_free_head = nullptr;
+    /* For keeping track of the sudo malloc memory for the heap*/
+    vtr::t_chunk heap_ch;
+
+    /* For managing my own list of currently free trace data structures.    */
+    t_trace* trace_free_head = nullptr;
+    /* For keeping track of the sudo malloc memory for the trace*/
+    vtr::t_chunk trace_ch;
+};
+
+static std::mutex route_memory_registry_mutex;
+static std::vector<std::unique_ptr<t_thread_route_memory>> route_memory_registry;
+
+static t_thread_route_memory& register_thread_route_memory();
 
-/* For managing my own list of currently free heap data structures.     */
-static t_heap* heap_free_head = nullptr;
-/* For keeping track of the sudo malloc memory for the heap*/
-static vtr::t_chunk heap_ch;
+static thread_local t_thread_route_memory& route_memory = register_thread_route_memory();
 
-/* For managing my own list of currently free trace data structures.    */
-static t_trace* trace_free_head = nullptr;
-/* For keeping track of the sudo malloc memory for the trace*/
-static vtr::t_chunk trace_ch;
+static thread_local int num_trace_allocated = 0; /* To watch for memory leaks. */
+static thread_local int num_heap_allocated = 0;
+static thread_local int num_linked_f_pointer_allocated = 0;
 
-static int num_trace_allocated = 0; /* To watch for memory leaks. */
-static int num_heap_allocated = 0;
-static int num_linked_f_pointer_allocated = 0;
+/* Routing state of the rr nodes of the calling thread, if it does not route *
+ * on route_ctx.rr_node_route_inf (see set_thread_rr_node_route_inf()).      */
+static thread_local vtr::vector<RRNodeId, t_rr_node_route_inf>* thread_rr_node_route_inf = nullptr;
 
 /*  The numbering relation between the channels and clbs is:				*
  *																	        *
@@ -108,6 +133,14 @@ static float get_single_rr_cong_cost(const RRNodeId& inode);
 
 /************************** Subroutine definitions ***************************/
 
+/* Registers the heap and trace memory of the calling thread, on its first use. *
+ * The registry owns the memory, which outlives the thread.                     */
+static t_thread_route_memory& register_thread_route_memory() {
+    std::lock_guard<std::mutex> lock(route_memory_registry_mutex);
+    route_memory_registry.push_back(std::make_unique<t_thread_route_memory>());
+    return *route_memory_registry.back();
+}
+
 void save_routing(vtr::vector<ClusterNetId, t_trace*>& best_routing,
                   const t_clb_opins_used& clb_opins_used_locally,
                   t_clb_opins_used& saved_clb_opins_used_locally) {
@@ -320,6 +353,13 @@ bool try_route(int width_fac,
         IntraLbPbPinLookup intra_lb_pb_pin_lookup(device_ctx.logical_block_types);
         ClusteredPinAtomPinsLookup netlist_pin_lookup(cluster_ctx.clb_nlist, intra_lb_pb_pin_lookup);
 
+        if (router_opts.warm_start) {
+            //Start from the routing of the previous attempt, so that the nets which are
+            //still legal at this channel width are not rerouted
+            std::vector<ClusterNetId> restored_nets = load_warm_start_routing(router_opts.first_iter_pres_fac);
+            load_net_delay_from_routing(net_delay, restored_nets);
+        }
+
         success = try_timing_driven_route(router_opts,
                                           analysis_opts,
                                           segment_inf,
@@ -330,6 +370,10 @@ bool try_route(int width_fac,
                                           first_iteration_priority);
 
         profiling::time_on_fanout_analysis();
+
+        if (router_opts.warm_start) {
+            save_warm_start_routing();
+        }
     }
 
     return (success);
@@ -474,15 +518,20 @@ void pathfinder_update_cost(float pres_fac, float acc_fac) {
     }
 }
 
-void init_heap(const DeviceGrid& grid) {
-    if (heap != nullptr) {
-        vtr::free(heap + 1);
-        heap = nullptr;
+vtr::vector<RRNodeId, t_rr_node_route_inf>& get_thread_rr_node_route_inf() {
+    if (thread_rr_node_route_inf) {
+        return *thread_rr_node_route_inf;
     }
-    heap_size = (grid.width() - 1) * (grid.height() - 1);
-    heap = (t_heap**)vtr::malloc(heap_size * sizeof(t_heap*));
-    heap--; /* heap stores from [1..heap_size] */
-    heap_tail = 1;
+    return g_vpr_ctx.mutable_routing().rr_node_route_inf;
+}
+
+void set_thread_rr_node_route_inf(vtr::vector<RRNodeId, t_rr_node_route_inf>* rr_node_route_inf) {
+    thread_rr_node_route_inf = rr_node_route_inf;
+}
+
+void init_heap(const DeviceGrid& grid) {
+    empty_heap();
+    route_memory.heap.reserve((grid.width() - 1) * (grid.height() - 1));
 }
 
 /* Call this before you route any nets.  It frees any old traceback and   *
@@ -512,7 +561,7 @@ void init_route_structs(int bb_factor) {
     /* Check that things that should have been emptied after the last routing *
      * really were.                                                           */
 
-    if (heap_tail != 1) {
+    if (!is_empty_heap()) {
         VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
                         "in init_route_structs. Heap is not empty.\n");
     }
@@ -715,13 +764,13 @@ static std::pair<t_trace*, t_trace*> add_trace_non_configurable_recurr(const RRN
 /* The routine sets the path_cost to HUGE_POSITIVE_FLOAT for  *
  * all channel segments touched by previous routing phases.    */
 void reset_path_costs(const std::vector<RRNodeId>& visited_rr_nodes) {
-    auto& route_ctx = g_vpr_ctx.mutable_routing();
+    auto& rr_node_route_inf = get_thread_rr_node_route_inf();
 
     for (auto node : visited_rr_nodes) {
-        route_ctx.rr_node_route_inf[node].path_cost = std::numeric_limits<float>::infinity();
-        route_ctx.rr_node_route_inf[node].backward_path_cost = std::numeric_limits<float>::infinity();
-        route_ctx.rr_node_route_inf[node].prev_node = RRNodeId::INVALID();
-        route_ctx.rr_node_route_inf[node].prev_edge = RREdgeId::INVALID();
+        rr_node_route_inf[node].path_cost = std::numeric_limits<float>::infinity();
+        rr_node_route_inf[node].backward_path_cost = std::numeric_limits<float>::infinity();
+        rr_node_route_inf[node].prev_node = RRNodeId::INVALID();
+        rr_node_route_inf[node].prev_edge = RREdgeId::INVALID();
     }
 }
 
@@ -748,12 +797,12 @@ float get_rr_cong_cost(const RRNodeId& inode) {
  * non-configurable edges */
 static float get_single_rr_cong_cost(const RRNodeId& inode) {
     auto& device_ctx = g_vpr_ctx.device();
-    auto& route_ctx = g_vpr_ctx.routing();
+    const auto& rr_node_route_inf = get_thread_rr_node_route_inf();
 
     auto cost_index = device_ctx.rr_graph.node_cost_index(inode);
     float cost = device_ctx.rr_indexed_data[cost_index].base_cost
-                 * route_ctx.rr_node_route_inf[inode].acc_cost
-                 * route_ctx.rr_node_route_inf[inode].pres_cost;
+                 * rr_node_route_inf[inode].acc_cost
+                 * rr_node_route_inf[inode].pres_cost;
     return cost;
 }
 
@@ -788,9 +837,9 @@ void node_to_heap(const RRNodeId& inode, float total_cost, const RRNodeId& prev_
      * easy.  The backward_path_cost and R_upstream values are used only by the *
      * timing-driven router -- the breadth-first router ignores them.           */
 
-    auto& route_ctx = g_vpr_ctx.routing();
+    const auto& rr_node_route_inf = get_thread_rr_node_route_inf();
 
-    if (total_cost >= route_ctx.rr_node_route_inf[inode].path_cost)
+    if (total_cost >= rr_node_route_inf[inode].path_cost)
         return;
 
     t_heap* hptr = alloc_heap_data();
@@ -959,36 +1008,35 @@ void free_route_structs() {
      * final routing result is not freed.                                */
     auto& route_ctx = g_vpr_ctx.mutable_routing();
 
-    if (heap != nullptr) {
-        //Free the individiaul heap elements (calls destructors)
-        for (int i = 1; i < num_heap_allocated; i++) {
-            VTR_LOG("Freeing %p\n", heap[i]);
-            vtr::chunk_delete(heap[i], &heap_ch);
-        }
-
-        // coverity[offset_free : Intentional]
-        free(heap + 1);
+    //Return the heap elements to the free list, which is freed below.
+    //The worker threads of a parallel routing are over by now, so the
+    //heaps of all the threads are freed here, not only the caller's one.
+    empty_heap();
 
-        heap = nullptr; /* Defensive coding:  crash hard if I use these. */
-    }
+    std::lock_guard<std::mutex> lock(route_memory_registry_mutex);
+    for (const std::unique_ptr<t_thread_route_memory>& memory : route_memory_registry) {
+        for (const RouterHeap::Entry& entry : memory->heap.entries()) {
+            entry.data->u.next = memory->heap_free_head;
+            memory->heap_free_head = entry.data;
+        }
+        memory->heap = RouterHeap();
 
-    if (heap_free_head != nullptr) {
-        t_heap* curr = heap_free_head;
+        t_heap* curr = memory->heap_free_head;
         while (curr) {
             t_heap* tmp = curr;
             curr = curr->u.next;
 
-            vtr::chunk_delete(tmp, &heap_ch);
+            vtr::chunk_delete(tmp, &memory->heap_ch);
         }
+        memory->heap_free_head = nullptr;
 
-        heap_free_head = nullptr;
+        /*free the memory chunks that were used by heap and linked f pointer */
+        free_chunk_memory(&memory->heap_ch);
     }
+
     if (route_ctx.route_bb.size() != 0) {
         route_ctx.route_bb.clear();
     }
-
-    /*free the memory chunks that were used by heap and linked f pointer */
-    free_chunk_memory(&heap_ch);
 }
 
 /* Frees the data structures needed to save a routing.                     */
@@ -1196,75 +1244,21 @@ t_bb load_net_route_bb(ClusterNetId net_id, int bb_factor) {
 }
 
 void add_to_mod_list(const RRNodeId& inode, std::vector<RRNodeId>& modified_rr_node_inf) {
-    auto& route_ctx = g_vpr_ctx.routing();
+    const auto& rr_node_route_inf = get_thread_rr_node_route_inf();
 
-    if (std::isinf(route_ctx.rr_node_route_inf[inode].path_cost)) {
+    if (std::isinf(rr_node_route_inf[inode].path_cost)) {
         modified_rr_node_inf.push_back(inode);
     }
 }
 
 namespace heap_ {
-size_t parent(size_t i);
-size_t left(size_t i);
-size_t right(size_t i);
-size_t size();
-void expand_heap_if_full();
-
-size_t parent(size_t i) { return i >> 1; }
-// child indices of a heap
-size_t left(size_t i) { return i << 1; }
-size_t right(size_t i) { return (i << 1) + 1; }
-size_t size() { return static_cast<size_t>(heap_tail - 1); } // heap[0] is not valid element
-
-// make a heap rooted at index i by **sifting down** in O(lgn) time
-void sift_down(size_t hole) {
-    t_heap* head{heap[hole]};
-    size_t child{left(hole)};
-    while ((int)child < heap_tail) {
-        if ((int)child + 1 < heap_tail && heap[child + 1]->cost < heap[child]->cost)
-            ++child;
-        if (heap[child]->cost < head->cost) {
-            heap[hole] = heap[child];
-            hole = child;
-            child = left(child);
-        } else
-            break;
-    }
-    heap[hole] = head;
-}
-
-// runs in O(n) time by sifting down; the least work is done on the most elements: 1 swap for bottom layer, 2 swap for 2nd, ... lgn swap for top
-// 1*(n/2) + 2*(n/4) + 3*(n/8) + ... + lgn*1 = 2n (sum of i/2^i)
 void build_heap() {
-    // second half of heap are leaves
-    for (size_t i = heap_tail >> 1; i != 0; --i)
-        sift_down(i);
-}
-
-// O(lgn) sifting up to maintain heap property after insertion (should sift down when building heap)
-void sift_up(size_t leaf, t_heap* const node) {
-    while ((leaf > 1) && (node->cost < heap[parent(leaf)]->cost)) {
-        // sift hole up
-        heap[leaf] = heap[parent(leaf)];
-        leaf = parent(leaf);
-    }
-    heap[leaf] = node;
-}
-
-void expand_heap_if_full() {
-    if (heap_tail > heap_size) { /* Heap is full */
-        heap_size *= 2;
-        heap = (t_heap**)vtr::realloc((void*)(heap + 1),
-                                      heap_size * sizeof(t_heap*));
-        heap--; /* heap goes from [1..heap_size] */
-    }
+    route_memory.heap.build_heap();
 }
 
-// adds an element to the back of heap and expand if necessary, but does not maintain heap property
+// adds an element to the back of heap, but does not maintain heap property
 void push_back(t_heap* const hptr) {
-    expand_heap_if_full();
-    heap[heap_tail] = hptr;
-    ++heap_tail;
+    route_memory.heap.push_back(hptr);
 }
 
 void push_back_node(const RRNodeId& inode, float total_cost, const RRNodeId& prev_node, const RREdgeId& prev_edge, float backward_path_cost, float R_upstream) {
@@ -1272,8 +1266,8 @@ void push_back_node(const RRNodeId& inode, float total_cost, const RRNodeId& pre
      * but do not fix heap property yet as that is more efficiently done from
      * bottom up with build_heap    */
 
-    auto& route_ctx = g_vpr_ctx.routing();
-    if (total_cost >= route_ctx.rr_node_route_inf[inode].path_cost)
+    const auto& rr_node_route_inf = get_thread_rr_node_route_inf();
+    if (total_cost >= rr_node_route_inf[inode].path_cost)
         return;
 
     t_heap* hptr = alloc_heap_data();
@@ -1287,11 +1281,7 @@ void push_back_node(const RRNodeId& inode, float total_cost, const RRNodeId& pre
 }
 
 bool is_valid() {
-    for (size_t i = 1; (int)i <= heap_tail >> 1; ++i) {
-        if ((int)left(i) < heap_tail && heap[left(i)]->cost < heap[i]->cost) return false;
-        if ((int)right(i) < heap_tail && heap[right(i)]->cost < heap[i]->cost) return false;
-    }
-    return true;
+    return route_memory.heap.is_valid();
 }
 // extract every element and print it
 void pop_heap() {
@@ -1301,17 +1291,19 @@ void pop_heap() {
 }
 // print every element; not necessarily in order for minheap
 void print_heap() {
-    for (int i = 1; i<heap_tail>> 1; ++i)
-        VTR_LOG("(%e %e %e) ", heap[i]->cost, heap[left(i)]->cost, heap[right(i)]->cost);
+    for (const RouterHeap::Entry& entry : route_memory.heap.entries())
+        VTR_LOG("%e ", entry.cost);
     VTR_LOG("\n");
 }
 // verify correctness of extract top by making a copy, sorting it, and iterating it at the same time as extraction
 void verify_extract_top() {
     constexpr float float_epsilon = 1e-20;
     std::cout << "copying heap\n";
-    std::vector<t_heap*> heap_copy{heap + 1, heap + heap_tail};
+    std::vector<t_heap*> heap_copy;
+    for (const RouterHeap::Entry& entry : route_memory.heap.entries())
+        heap_copy.push_back(entry.data);
     // sort based on cost with cheapest first
-    VTR_ASSERT(heap_copy.size() == size());
+    VTR_ASSERT(heap_copy.size() == route_memory.heap.size());
     std::sort(begin(heap_copy), end(heap_copy),
               [](const t_heap* a, const t_heap* b) {
                   return a->cost < b->cost;
@@ -1334,15 +1326,16 @@ void verify_extract_top() {
 } // namespace heap_
 // adds to heap and maintains heap quality
 void add_to_heap(t_heap* hptr) {
-    heap_::expand_heap_if_full();
-    // start with undefined hole
-    ++heap_tail;
-    heap_::sift_up(heap_tail - 1, hptr);
+    route_memory.heap.push(hptr);
 }
 
 /*WMF: peeking accessor :) */
 bool is_empty_heap() {
-    return (bool)(heap_tail == 1);
+    return route_memory.heap.empty();
+}
+
+size_t heap_size() {
+    return route_memory.heap.size();
 }
 
 t_heap*
@@ -1352,49 +1345,39 @@ get_heap_head() {
      * returned -- they are just skipped over.                                   */
 
     t_heap* cheapest;
-    size_t hole, child;
 
     do {
-        if (heap_tail == 1) { /* Empty heap. */
+        cheapest = route_memory.heap.pop();
+        if (cheapest == nullptr) { /* Empty heap. */
             VTR_LOG_WARN("Empty heap occurred in get_heap_head.\n");
             return (nullptr);
         }
 
-        cheapest = heap[1];
-
-        hole = 1;
-        child = 2;
-        --heap_tail;
-        while ((int)child < heap_tail) {
-            if (heap[child + 1]->cost < heap[child]->cost)
-                ++child; // become right child
-            heap[hole] = heap[child];
-            hole = child;
-            child = heap_::left(child);
+        if (cheapest->index == RRNodeId::INVALID()) {
+            free_heap_data(cheapest);
+            cheapest = nullptr;
         }
-        heap_::sift_up(hole, heap[heap_tail]);
-
-    } while (cheapest->index == RRNodeId::INVALID()); /* Get another one if invalid entry. */
+    } while (cheapest == nullptr); /* Get another one if invalid entry. */
 
     return (cheapest);
 }
 
 void empty_heap() {
-    for (int i = 1; i < heap_tail; i++)
-        free_heap_data(heap[i]);
+    for (const RouterHeap::Entry& entry : route_memory.heap.entries())
+        free_heap_data(entry.data);
 
-    heap_tail = 1;
+    route_memory.heap.clear();
 }
 
 t_heap*
 alloc_heap_data() {
-    if (heap_free_head == nullptr) { /* No elements on the free list */
-        heap_free_head = vtr::chunk_new<t_heap>(&heap_ch);
+    if (route_memory.heap_free_head == nullptr) { /* No elements on the free list */
+        route_memory.heap_free_head = vtr::chunk_new<t_heap>(&route_memory.heap_ch);
     }
 
     //Extract the head
-    t_heap* temp_ptr = heap_free_head;
-    heap_free_head = heap_free_head->u.next;
+    t_heap* temp_ptr = route_memory.heap_free_head;
+    route_memory.heap_free_head = route_memory.heap_free_head->u.next;
 
     num_heap_allocated++;
 
@@ -1410,8 +1393,8 @@ alloc_heap_data() {
 }
 
 void free_heap_data(t_heap* hptr) {
-    hptr->u.next = heap_free_head;
-    heap_free_head = hptr;
+    hptr->u.next = route_memory.heap_free_head;
+    route_memory.heap_free_head = hptr;
     num_heap_allocated--;
 }
 
@@ -1420,10 +1403,10 @@ void invalidate_heap_entries(const RRNodeId& sink_node, const RRNodeId& ipin_nod
      * via ipin_node, as invalid (OPEN).  Used only by the breadth_first router *
      * and even then only in rare circumstances.                                */
 
-    for (int i = 1; i < heap_tail; i++) {
-        if (heap[i]->index == sink_node) {
-            if (heap[i]->u.prev.node == ipin_node) {
-                heap[i]->index = RRNodeId::INVALID(); /* Invalid. */
+    for (const RouterHeap::Entry& entry : route_memory.heap.entries()) {
+        if (entry.data->index == sink_node) {
+            if (entry.data->u.prev.node == ipin_node) {
+                entry.data->index = RRNodeId::INVALID(); /* Invalid. */
                 break;
             }
         }
@@ -1434,12 +1417,15 @@ t_trace*
 alloc_trace_data() {
     t_trace* temp_ptr;
 
-    if (trace_free_head == nullptr) { /* No elements on the free list */
-        trace_free_head = (t_trace*)vtr::chunk_malloc(sizeof(t_trace), &trace_ch);
-        trace_free_head->next = nullptr;
+    if (route_memory.trace_free_head == nullptr) { /* No elements on the free list */
+        if (!route_memory.trace_ch.owner) {
+            route_memory.trace_ch.owner = &vtr::memory_owner("Route traces");
+        }
+        route_memory.trace_free_head = (t_trace*)vtr::chunk_malloc(sizeof(t_trace), &route_memory.trace_ch);
+        route_memory.trace_free_head->next = nullptr;
     }
-    temp_ptr = trace_free_head;
-    trace_free_head = trace_free_head->next;
+    temp_ptr = route_memory.trace_free_head;
+    route_memory.trace_free_head = route_memory.trace_free_head->next;
     num_trace_allocated++;
     return (temp_ptr);
 }
@@ -1447,8 +1433,8 @@ alloc_trace_data() {
 void free_trace_data(t_trace* tptr) {
     /* Puts the traceback structure pointed to by tptr on the free list. */
 
-    tptr->next = trace_free_head;
-    trace_free_head = tptr;
+    tptr->next = route_memory.trace_free_head;
+    route_memory.trace_free_head = tptr;
     num_trace_allocated--;
 }
 
@@ -1582,6 +1568,12 @@ void print_route(FILE* fp, const vtr::vector<ClusterNetId, t_traceback>& traceba
 void print_route(const char* placement_file, const char* route_file) {
     FILE* fp;
 
+    if (is_binary_route_file(route_file)) {
+        write_binary_route(placement_file, route_file);
+        g_vpr_ctx.mutable_routing().routing_id = vtr::secure_digest_file(route_file);
+        return;
+    }
+
     fp = fopen(route_file, "w");
 
     auto& place_ctx = g_vpr_ctx.placement();
@@ -1718,10 +1710,14 @@ static void adjust_one_rr_occ_and_apcost(const RRNodeId& inode, int add_or_sub,
 }
 
 void free_chunk_memory_trace() {
-    if (trace_ch.chunk_ptr_head != nullptr) {
-        free_chunk_memory(&trace_ch);
-        trace_ch.chunk_ptr_head = nullptr;
-        trace_free_head = nullptr;
+    /* The traces routed by a thread may be freed by another one, so the free *
+     * lists mix the chunks of the threads: the chunks are all freed at once. */
+    std::lock_guard<std::mutex> lock(route_memory_registry_mutex);
+    for (const std::unique_ptr<t_thread_route_memory>& memory : route_memory_registry) {
+        if (memory->trace_ch.chunk_ptr_head != nullptr) {
+            free_chunk_memory(&memory->trace_ch);
+        }
+        memory->trace_free_head = nullptr;
     }
 }
 
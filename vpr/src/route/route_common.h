@@ -73,6 +73,15 @@ void pathfinder_update_cost(float pres_fac, float acc_fac);
 
 t_trace* update_traceback(t_heap* hptr, ClusterNetId net_id);
 
+/* Returns the routing state of the rr nodes used by the router of the calling thread:
+ * route_ctx.rr_node_route_inf, unless the thread routes on its own copy (see set_thread_rr_node_route_inf()) */
+vtr::vector<RRNodeId, t_rr_node_route_inf>& get_thread_rr_node_route_inf();
+
+/* Makes the router of the calling thread search paths on rr_node_route_inf, a copy of
+ * route_ctx.rr_node_route_inf, or on route_ctx.rr_node_route_inf again if nullptr.
+ * Used to run path searches which visit the same rr nodes at the same time (see RouterDelayProfiler) */
+void set_thread_rr_node_route_inf(vtr::vector<RRNodeId, t_rr_node_route_inf>* rr_node_route_inf);
+
 void reset_path_costs(const std::vector<RRNodeId>& visited_rr_nodes);
 
 float get_rr_cong_cost(const RRNodeId& inode);
@@ -86,6 +95,8 @@ void node_to_heap(const RRNodeId& inode, float cost, const RRNodeId& prev_node,
 
 bool is_empty_heap();
 
+size_t heap_size();
+
 void free_traceback(ClusterNetId net_id);
 void drop_traceback_tail(ClusterNetId net_id);
 void free_traceback(t_trace* tptr);
@@ -94,8 +105,6 @@ void add_to_mod_list(const RRNodeId& inode, std::vector<RRNodeId>& modified_rr_n
 
 namespace heap_ {
 void build_heap();
-void sift_down(size_t hole);
-void sift_up(size_t tail, t_heap* const hptr);
 void push_back(t_heap* const hptr);
 void push_back_node(const RRNodeId& inode, float total_cost, const RRNodeId& prev_node, const RREdgeId& prev_edge, float backward_path_cost, float R_upstream);
 bool is_valid();
@@ -0,0 +1,134 @@
+#include "route_congestion_stats.h"
+
+#include "vtr_assert.h"
+
+#include "globals.h"
+
+//Returns the location of the switch block driving a uni-directional wire,
+//or false if the wire is not driven by a switch block inside the grid
+static bool find_driving_switch_block(const RRNodeId& inode, int& x, int& y) {
+    auto& device_ctx = g_vpr_ctx.device();
+    const RRGraph& rr_graph = device_ctx.rr_graph;
+
+    e_direction direction = rr_graph.node_direction(inode);
+    if (direction == INC_DIRECTION) {
+        //The switch block is before the first location of the wire
+        x = rr_graph.node_xlow(inode);
+        y = rr_graph.node_ylow(inode);
+        if (rr_graph.node_type(inode) == CHANX) {
+            --x;
+        } else {
+            --y;
+        }
+    } else if (direction == DEC_DIRECTION) {
+        x = rr_graph.node_xhigh(inode);
+        y = rr_graph.node_yhigh(inode);
+    } else {
+        return false;
+    }
+
+    return x >= 0 && y >= 0 && size_t(x) < device_ctx.grid.width() && size_t(y) < device_ctx.grid.height();
+}
+
+RouteCongestionStatsWriter::RouteCongestionStatsWriter(const std::string& prefix, const std::vector<t_segment_inf>& segment_inf)
+    : segment_inf_(segment_inf)
+    , chan_file_(vtr::fopen((prefix + ".chan.csv").c_str(), "w"), vtr::fclose)
+    , seg_file_(vtr::fopen((prefix + ".seg.csv").c_str(), "w"), vtr::fclose)
+    , sb_file_(vtr::fopen((prefix + ".sb.csv").c_str(), "w"), vtr::fclose) {
+    auto& device_ctx = g_vpr_ctx.device();
+    const RRGraph& rr_graph = device_ctx.rr_graph;
+
+    chanx_capacity_.resize({{device_ctx.grid.width(), device_ctx.grid.height()}}, 0);
+    chany_capacity_.resize({{device_ctx.grid.width(), device_ctx.grid.height()}}, 0);
+    sb_capacity_.resize({{device_ctx.grid.width(), device_ctx.grid.height()}}, 0);
+    seg_capacity_.resize(segment_inf_.size(), 0);
+
+    for (const RRNodeId& inode : rr_graph.nodes()) {
+        t_rr_type rr_type = rr_graph.node_type(inode);
+        if (rr_type != CHANX && rr_type != CHANY) {
+            continue;
+        }
+
+        int capacity = rr_graph.node_capacity(inode);
+        vtr::Matrix<int>& chan_capacity = (rr_type == CHANX) ? chanx_capacity_ : chany_capacity_;
+        for (int x = rr_graph.node_xlow(inode); x <= rr_graph.node_xhigh(inode); ++x) {
+            for (int y = rr_graph.node_ylow(inode); y <= rr_graph.node_yhigh(inode); ++y) {
+                chan_capacity[x][y] += capacity;
+            }
+        }
+
+        seg_capacity_[device_ctx.rr_indexed_data[rr_graph.node_cost_index(inode)].seg_index] += capacity;
+
+        int sb_x, sb_y;
+        if (find_driving_switch_block(inode, sb_x, sb_y)) {
+            sb_capacity_[sb_x][sb_y] += capacity;
+        }
+    }
+
+    fprintf(chan_file_.get(), "iteration,type,x,y,occ,capacity\n");
+    fprintf(seg_file_.get(), "iteration,segment,name,occ,capacity\n");
+    fprintf(sb_file_.get(), "iteration,x,y,occ,capacity\n");
+}
+
+void RouteCongestionStatsWriter::write_iteration(int itry) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& route_ctx = g_vpr_ctx.routing();
+    const RRGraph& rr_graph = device_ctx.rr_graph;
+
+    //The occupancy is read from the RR nodes in a single pass,
+    //which is much faster than collecting the nodes from the route traces
+    vtr::Matrix<int> chanx_occ({{device_ctx.grid.width(), device_ctx.grid.height()}}, 0);
+    vtr::Matrix<int> chany_occ({{device_ctx.grid.width(), device_ctx.grid.height()}}, 0);
+    vtr::Matrix<int> sb_occ({{device_ctx.grid.width(), device_ctx.grid.height()}}, 0);
+    std::vector<int> seg_occ(segment_inf_.size(), 0);
+
+    for (const RRNodeId& inode : rr_graph.nodes()) {
+        t_rr_type rr_type = rr_graph.node_type(inode);
+        if (rr_type != CHANX && rr_type != CHANY) {
+            continue;
+        }
+
+        int occ = route_ctx.rr_node_route_inf[inode].occ();
+        if (occ == 0) {
+            continue;
+        }
+
+        vtr::Matrix<int>& chan_occ = (rr_type == CHANX) ? chanx_occ : chany_occ;
+        for (int x = rr_graph.node_xlow(inode); x <= rr_graph.node_xhigh(inode); ++x) {
+            for (int y = rr_graph.node_ylow(inode); y <= rr_graph.node_yhigh(inode); ++y) {
+                chan_occ[x][y] += occ;
+            }
+        }
+
+        seg_occ[device_ctx.rr_indexed_data[rr_graph.node_cost_index(inode)].seg_index] += occ;
+
+        int sb_x, sb_y;
+        if (find_driving_switch_block(inode, sb_x, sb_y)) {
+            sb_occ[sb_x][sb_y] += occ;
+        }
+    }
+
+    //Only the locations with some routing resources are written
+    for (size_t x = 0; x < device_ctx.grid.width(); ++x) {
+        for (size_t y = 0; y < device_ctx.grid.height(); ++y) {
+            if (chanx_capacity_[x][y] > 0) {
+                fprintf(chan_file_.get(), "%d,CHANX,%zu,%zu,%d,%d\n", itry, x, y, chanx_occ[x][y], chanx_capacity_[x][y]);
+            }
+            if (chany_capacity_[x][y] > 0) {
+                fprintf(chan_file_.get(), "%d,CHANY,%zu,%zu,%d,%d\n", itry, x, y, chany_occ[x][y], chany_capacity_[x][y]);
+            }
+            if (sb_capacity_[x][y] > 0) {
+                fprintf(sb_file_.get(), "%d,%zu,%zu,%d,%d\n", itry, x, y, sb_occ[x][y], sb_capacity_[x][y]);
+            }
+        }
+    }
+
+    for (size_t iseg = 0; iseg < segment_inf_.size(); ++iseg) {
+        fprintf(seg_file_.get(), "%d,%zu,%s,%d,%d\n", itry, iseg, segment_inf_[iseg].name.c_str(), seg_occ[iseg], seg_capacity_[iseg]);
+    }
+
+    //Flush, so that the files can be analyzed while the router is still running
+    fflush(chan_file_.get());
+    fflush(seg_file_.get());
+    fflush(sb_file_.get());
+}
@@ -0,0 +1,47 @@
+#ifndef VPR_ROUTE_CONGESTION_STATS_H
+#define VPR_ROUTE_CONGESTION_STATS_H
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "vtr_ndmatrix.h"
+#include "vtr_util.h"
+
+#include "vpr_types.h"
+
+//Writes the routing congestion of each routing iteration to CSV files, for an offline
+//analysis of the congestion (e.g. heatmaps) without the graphics.
+//
+//Three files are written, named after the given prefix:
+//  <prefix>.chan.csv   iteration,type,x,y,occ,capacity        for each CHANX/CHANY channel location
+//  <prefix>.seg.csv    iteration,segment,name,occ,capacity    for each segment type
+//  <prefix>.sb.csv     iteration,x,y,occ,capacity             for the wires driven by each switch block
+//
+//The wires are attributed to the switch block driving their first location,
+//so the bi-directional wires (which have no driving switch block) only appear in the channel
+//and segment statistics.
+class RouteCongestionStatsWriter {
+  public:
+    RouteCongestionStatsWriter(const std::string& prefix, const std::vector<t_segment_inf>& segment_inf);
+
+    //Appends the congestion of the current routing to the files
+    void write_iteration(int itry);
+
+  private:
+    typedef std::unique_ptr<FILE, decltype(&vtr::fclose)> t_file;
+
+    const std::vector<t_segment_inf>& segment_inf_;
+
+    t_file chan_file_;
+    t_file seg_file_;
+    t_file sb_file_;
+
+    //The capacities do not change during the routing, so they are computed once
+    vtr::Matrix<int> chanx_capacity_;
+    vtr::Matrix<int> chany_capacity_;
+    std::vector<int> seg_capacity_;
+    vtr::Matrix<int> sb_capacity_;
+};
+
+#endif
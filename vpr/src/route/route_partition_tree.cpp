@@ -0,0 +1,209 @@
+#include <algorithm>
+
+#include "vtr_assert.h"
+
+#include "globals.h"
+#include "route_partition_tree.h"
+
+//Partitions with fewer nets are not split any further, since routing them
+//in parallel would not pay off the overhead of the tasks
+constexpr size_t MIN_NETS_TO_PARTITION = 64;
+
+static bool bb_contains(const t_bb& outer, const t_bb& inner) {
+    return inner.xmin >= outer.xmin
+           && inner.xmax <= outer.xmax
+           && inner.ymin >= outer.ymin
+           && inner.ymax <= outer.ymax;
+}
+
+static void bb_merge(t_bb& bb, const t_bb& other) {
+    bb.xmin = std::min(bb.xmin, other.xmin);
+    bb.xmax = std::max(bb.xmax, other.xmax);
+    bb.ymin = std::min(bb.ymin, other.ymin);
+    bb.ymax = std::max(bb.ymax, other.ymax);
+}
+
+static t_bb node_span(const RRNodeId& node) {
+    auto& device_ctx = g_vpr_ctx.device();
+
+    t_bb span;
+    span.xmin = device_ctx.rr_graph.node_xlow(node);
+    span.xmax = device_ctx.rr_graph.node_xhigh(node);
+    span.ymin = device_ctx.rr_graph.node_ylow(node);
+    span.ymax = device_ctx.rr_graph.node_yhigh(node);
+    return span;
+}
+
+RoutePartitionTree::RoutePartitionTree(const std::vector<ClusterNetId>& nets, bool two_stage_clock_routing)
+    : nets_(nets) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& route_ctx = g_vpr_ctx.routing();
+
+    t_bb device_region;
+    device_region.xmin = 0;
+    device_region.xmax = int(device_ctx.grid.width()) - 1;
+    device_region.ymin = 0;
+    device_region.ymax = int(device_ctx.grid.height()) - 1;
+
+    //Non-configurable sets are used as a whole, so a node of a set is only
+    //available to a region containing the whole set
+    non_config_node_set_extents_.resize(device_ctx.rr_non_config_node_sets.size());
+    for (size_t iset = 0; iset < device_ctx.rr_non_config_node_sets.size(); ++iset) {
+        const auto& node_set = device_ctx.rr_non_config_node_sets[iset];
+        VTR_ASSERT(!node_set.empty());
+
+        t_bb& set_extent = non_config_node_set_extents_[iset];
+        set_extent = node_span(node_set[0]);
+        for (const RRNodeId& node : node_set) {
+            bb_merge(set_extent, node_span(node));
+        }
+    }
+
+    //The extent of a net covers everything it may use while being routed:
+    //the nodes inside its bounding box, its current routing (which is ripped-up)
+    //and its terminals
+    net_extents_.resize(nets_.size());
+    for (size_t inet = 0; inet < nets_.size(); ++inet) {
+        ClusterNetId net_id = nets_[inet];
+        t_bb& extent = net_extents_[inet];
+
+        if (cluster_ctx.clb_nlist.net_is_ignored(net_id)
+            || (two_stage_clock_routing && cluster_ctx.clb_nlist.net_is_global(net_id))) {
+            //Ignored nets are not routed, and clock nets are routed to the
+            //virtual clock network root which is shared by all of them
+            extent = device_region;
+            continue;
+        }
+
+        extent = route_ctx.route_bb[net_id];
+        for (const RRNodeId& terminal : route_ctx.net_rr_terminals[net_id]) {
+            bb_merge(extent, node_extent(terminal));
+        }
+        for (const t_trace* trace = route_ctx.trace[net_id].head; trace != nullptr; trace = trace->next) {
+            bb_merge(extent, node_extent(trace->index));
+        }
+
+        extent.xmin = std::max(extent.xmin, device_region.xmin);
+        extent.xmax = std::min(extent.xmax, device_region.xmax);
+        extent.ymin = std::max(extent.ymin, device_region.ymin);
+        extent.ymax = std::min(extent.ymax, device_region.ymax);
+    }
+
+    std::vector<size_t> net_indices(nets_.size());
+    for (size_t inet = 0; inet < nets_.size(); ++inet) {
+        net_indices[inet] = inet;
+    }
+    build_partition(device_region, net_indices);
+}
+
+bool RoutePartitionTree::is_node_in_region(const RRNodeId& node, const t_bb& region) const {
+    return bb_contains(region, node_extent(node));
+}
+
+int RoutePartitionTree::build_partition(const t_bb& region, const std::vector<size_t>& net_indices) {
+    int ipartition = nodes_.size();
+    nodes_.emplace_back();
+    nodes_[ipartition].region = region;
+
+    //Look for the cutline minimizing the nets routed before the children plus
+    //the nets of the largest child, i.e. the nets routed one after the other.
+    //Ties are broken by the first cutline found, so the partitions are
+    //deterministic
+    bool found_cut = false;
+    bool cut_along_x = false;
+    int cut = 0;
+    size_t best_score = net_indices.size();
+    if (net_indices.size() >= MIN_NETS_TO_PARTITION) {
+        for (bool along_x : {true, false}) {
+            int low = along_x ? region.xmin : region.ymin;
+            int high = along_x ? region.xmax : region.ymax;
+            if (high <= low) {
+                continue;
+            }
+
+            //Number of nets ending (resp. starting) at each coordinate of the region
+            std::vector<size_t> num_ending(high - low + 1, 0);
+            std::vector<size_t> num_starting(high - low + 1, 0);
+            for (size_t inet : net_indices) {
+                const t_bb& extent = net_extents_[inet];
+                ++num_ending[(along_x ? extent.xmax : extent.ymax) - low];
+                ++num_starting[(along_x ? extent.xmin : extent.ymin) - low];
+            }
+
+            //Nets starting after each coordinate
+            std::vector<size_t> num_starting_after(high - low + 1, 0);
+            for (int coord = high - 1; coord >= low; --coord) {
+                num_starting_after[coord - low] = num_starting_after[coord - low + 1] + num_starting[coord - low + 1];
+            }
+
+            size_t num_left = 0;
+            for (int coord = low; coord < high; ++coord) {
+                //Cutline between coord and coord + 1
+                num_left += num_ending[coord - low];
+                size_t num_right = num_starting_after[coord - low];
+                if (num_left == 0 || num_right == 0) {
+                    continue;
+                }
+
+                size_t num_stay = net_indices.size() - num_left - num_right;
+                size_t score = num_stay + std::max(num_left, num_right);
+                if (score < best_score) {
+                    found_cut = true;
+                    cut_along_x = along_x;
+                    cut = coord;
+                    best_score = score;
+                }
+            }
+        }
+    }
+
+    if (!found_cut) {
+        for (size_t inet : net_indices) {
+            nodes_[ipartition].nets.push_back(nets_[inet]);
+        }
+        return ipartition;
+    }
+
+    t_bb left_region = region;
+    t_bb right_region = region;
+    if (cut_along_x) {
+        left_region.xmax = cut;
+        right_region.xmin = cut + 1;
+    } else {
+        left_region.ymax = cut;
+        right_region.ymin = cut + 1;
+    }
+
+    std::vector<size_t> left_net_indices;
+    std::vector<size_t> right_net_indices;
+    for (size_t inet : net_indices) {
+        if (bb_contains(left_region, net_extents_[inet])) {
+            left_net_indices.push_back(inet);
+        } else if (bb_contains(right_region, net_extents_[inet])) {
+            right_net_indices.push_back(inet);
+        } else {
+            nodes_[ipartition].nets.push_back(nets_[inet]);
+        }
+    }
+
+    //Note that building the children may re-allocate nodes_
+    int left = build_partition(left_region, left_net_indices);
+    int right = build_partition(right_region, right_net_indices);
+    nodes_[ipartition].left = left;
+    nodes_[ipartition].right = right;
+
+    return ipartition;
+}
+
+t_bb RoutePartitionTree::node_extent(const RRNodeId& node) const {
+    auto& device_ctx = g_vpr_ctx.device();
+
+    t_bb extent = node_span(node);
+
+    auto itr = device_ctx.rr_node_to_non_config_node_set.find(node);
+    if (itr != device_ctx.rr_node_to_non_config_node_set.end()) {
+        bb_merge(extent, non_config_node_set_extents_[itr->second]);
+    }
+    return extent;
+}
@@ -0,0 +1,67 @@
+#ifndef VPR_ROUTE_PARTITION_TREE_H
+#define VPR_ROUTE_PARTITION_TREE_H
+#include <vector>
+
+#include "vpr_types.h"
+#include "clustered_netlist_fwd.h"
+#include "rr_graph_obj.h"
+
+//A node of a RoutePartitionTree
+//
+//All the nets of a partition (and of its children) are routed within its region,
+//so that partitions whose regions do not overlap can be routed independently
+struct RoutePartitionNode {
+    //Region covered by the partition (inclusive grid coordinates)
+    t_bb region;
+
+    //Nets which do not fit in any of the children, in routing order
+    std::vector<ClusterNetId> nets;
+
+    //Children of the partition (indices in the tree), OPEN if the partition is a leaf
+    int left = OPEN;
+    int right = OPEN;
+};
+
+//Recursive bisection of the device used to route nets in parallel
+//
+//Each node splits its region with a cutline into two disjoint child regions.
+//A net is assigned to the deepest partition whose region contains its extent:
+//its bounding box, its current routing and its terminals. The nets of a partition
+//are routed first, then its two children can be routed at the same time since they
+//cannot use the same routing resources.
+//
+//The tree only depends on the nets and their current routing, so the nets of each
+//partition (and therefore the routing) do not depend on the number of threads.
+class RoutePartitionTree {
+  public:
+    //Builds the partitions of the nets (given in routing order)
+    RoutePartitionTree(const std::vector<ClusterNetId>& nets, bool two_stage_clock_routing);
+
+    //Index of the partition covering the whole device
+    size_t root() const { return 0; }
+
+    const RoutePartitionNode& node(size_t ipartition) const { return nodes_[ipartition]; }
+
+    size_t num_nodes() const { return nodes_.size(); }
+
+    //Returns true if a rr_node (and its non-configurable set, if any) fits in region,
+    //i.e. if it can be used by a net routed in this region
+    bool is_node_in_region(const RRNodeId& node, const t_bb& region) const;
+
+  private:
+    int build_partition(const t_bb& region, const std::vector<size_t>& net_indices);
+
+    t_bb node_extent(const RRNodeId& node) const;
+
+  private:
+    std::vector<RoutePartitionNode> nodes_;
+
+    //Nets being partitioned and their extent
+    std::vector<ClusterNetId> nets_;
+    std::vector<t_bb> net_extents_;
+
+    //Union of the node spans of each non-configurable set
+    std::vector<t_bb> non_config_node_set_extents_;
+};
+
+#endif
@@ -4,10 +4,18 @@
 #include <vector>
 #include <unordered_map>
 #include <algorithm>
+#include <functional>
+#include <memory>
+
+#if defined(VPR_USE_TBB)
+#    include <tbb/task_group.h>
+#endif
 
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
+#include "vtr_trace.h"
+#include "vtr_util.h"
 
 #include "vpr_utils.h"
 #include "vpr_types.h"
@@ -32,6 +40,9 @@
 #include "timing_info.h"
 #include "timing_util.h"
 #include "route_budgets.h"
+#include "route_congestion_stats.h"
+#include "route_partition_tree.h"
+#include "route_clock_templates.h"
 
 #include "router_lookahead_map.h"
 
@@ -124,22 +135,76 @@ struct RoutingMetrics {
     tatum::TimingPathInfo critical_path;
 };
 
+//Results of routing the nets of a partition (see RoutePartitionTree)
+struct PartitionRoutingResults {
+    RouterStats router_stats;
+    std::vector<ClusterNetId> rerouted_nets;
+    bool is_routable = true;
+};
+
+//Why a net is (re-)routed in a routing iteration
+enum class e_reroute_reason {
+    NONE,               //Current routing is legal, the net is not re-routed
+    UNROUTED,           //Net has no routing yet
+    CONGESTION,         //Routing of the net uses an overused node
+    CRITICAL_CONNECTION //A connection of the net is forcibly re-routed (see forcibly_reroute_connections())
+};
+
+constexpr const char* REROUTE_REASON_NAMES[] = {"none", "unrouted", "congestion", "critical_connection"};
+
+//Statistics of the last routing of a net, written to the --router_net_stats file
+struct t_net_route_stats {
+    e_reroute_reason reason = e_reroute_reason::NONE;
+    RouterStats router_stats;
+};
+
+//Routes a net with the given statistics and per-net scratch arrays (pin_criticality and rt_node_of_sink)
+typedef std::function<bool(ClusterNetId, RouterStats&, float*, t_rt_node**, bool&)> t_partition_net_router;
+
 /*
  * File-scope variables
  */
 
 //Run-time flag to control when router debug information is printed
 //Note only enables debug output if compiled with VTR_ENABLE_DEBUG_LOGGING defined
-bool f_router_debug = false;
+thread_local bool f_router_debug = false;
+
+//When routing nets in parallel, the partition tree and the region to which the
+//net routed by the calling thread is restricted (nullptr when routing serially)
+static thread_local const RoutePartitionTree* f_partition_tree = nullptr;
+static thread_local const t_bb* f_partition_region = nullptr;
+
+//The neighbours of the node being expanded, whose expected costs are evaluated together
+struct t_expansion_candidates {
+    std::vector<t_heap*> heap_items;
+    std::vector<RRNodeId> nodes;
+    std::vector<float> R_upstream;
+    std::vector<float> expected_costs;
+};
+static thread_local t_expansion_candidates f_expansion_candidates;
+
+//Per-net statistics of the current routing iteration, only allocated when the --router_net_stats
+//file is requested. Each net is routed by a single thread, so the nets' entries are written concurrently
+static vtr::vector<ClusterNetId, t_net_route_stats> f_net_route_stats;
 
 /******************** Subroutines local to route_timing.c ********************/
 
+static bool can_route_nets_in_parallel();
+
+static void timing_driven_route_partition(const RoutePartitionTree& partition_tree,
+                                          int ipartition,
+                                          int max_pins_per_net,
+                                          const t_partition_net_router& route_net,
+                                          std::vector<PartitionRoutingResults>& results);
+
 static bool timing_driven_route_sink(ClusterNetId net_id,
                                      unsigned itarget,
                                      int target_pin,
                                      const t_conn_cost_params cost_params,
                                      float pres_fac,
                                      int high_fanout_threshold,
+                                     bool trunk_global_nets,
+                                     bool use_clock_route_template,
                                      t_rt_node* rt_root,
                                      t_rt_node** rt_node_of_sink,
                                      const RouterLookahead& router_lookahead,
@@ -218,41 +283,32 @@ static void timing_driven_expand_neighbours(t_heap* current,
                                             const RRNodeId& target_node,
                                             RouterStats& router_stats);
 
-static void timing_driven_expand_neighbour(t_heap* current,
-                                           const RRNodeId& from_node,
+static bool timing_driven_expand_neighbour(const RRNodeId& from_node,
                                            const RREdgeId& from_edge,
                                            const RRNodeId& to_node,
-                                           const t_conn_cost_params cost_params,
                                            const t_bb bounding_box,
-                                           const RouterLookahead& router_lookahead,
                                            const RRNodeId& target_node,
-                                           const t_bb target_bb,
-                                           RouterStats& router_stats);
+                                           const t_bb target_bb);
 
-static void timing_driven_add_to_heap(const t_conn_cost_params cost_params,
-                                      const RouterLookahead& router_lookahead,
-                                      const t_heap* current,
-                                      const RRNodeId& from_node,
-                                      const RRNodeId& to_node,
-                                      const RREdgeId& iconn,
-                                      const RRNodeId& target_node,
+static void timing_driven_add_to_heap(t_heap* next,
                                       RouterStats& router_stats);
 
 static void timing_driven_expand_node(const t_conn_cost_params cost_params,
-                                      const RouterLookahead& router_lookahead,
                                       t_heap* current,
                                       const RRNodeId& from_node,
                                       const RRNodeId& to_node,
-                                      const RREdgeId& iconn,
-                                      const RRNodeId& target_node);
+                                      const RREdgeId& iconn);
 
 static void evaluate_timing_driven_node_costs(t_heap* to,
                                               const t_conn_cost_params cost_params,
-                                              const RouterLookahead& router_lookahead,
                                               const RRNodeId& from_node,
                                               const RRNodeId& to_node,
-                                              const RREdgeId& iconn,
-                                              const RRNodeId& target_node);
+                                              const RREdgeId& iconn);
+
+static void add_timing_driven_expected_cost(t_heap* to,
+                                            const t_conn_cost_params cost_params,
+                                            const RRNodeId& target_node,
+                                            float expected_cost);
 
 static bool timing_driven_check_net_delays(vtr::vector<ClusterNetId, float*>& net_delay);
 
@@ -262,6 +318,7 @@ void reduce_budgets_if_congested(route_budgets& budgeting_inf,
                                  int itry);
 
 static bool should_route_net(ClusterNetId net_id, CBRR& connections_inf, bool if_force_reroute);
+static e_reroute_reason net_reroute_reason(ClusterNetId net_id, CBRR& connections_inf, bool if_force_reroute);
 static bool early_exit_heuristic(const t_router_opts& router_opts, const WirelengthInfo& wirelength_info);
 
 struct more_sinks_than {
@@ -275,6 +332,11 @@ static size_t calculate_wirelength_available();
 static WirelengthInfo calculate_wirelength_info(size_t available_wirelength);
 static OveruseInfo calculate_overuse_info();
 
+static void print_route_iteration_stats_header(FILE* fp);
+static void print_route_iteration_stats(FILE* fp, int itry, const RouterStats& router_stats, size_t overused_nodes, float route_sec, float sta_sec, float iteration_sec);
+static void print_route_net_stats_header(FILE* fp);
+static void print_route_net_stats(FILE* fp, int itry, const std::vector<ClusterNetId>& rerouted_nets);
+
 static void print_route_status_header();
 static void print_route_status(int itry,
                                double elapsed_sec,
@@ -289,8 +351,12 @@ static void print_route_status(int itry,
 static std::string describe_unrouteable_connection(const RRNodeId& source_node, const RRNodeId& sink_node);
 
 static bool is_high_fanout(int fanout, int fanout_threshold);
+static void trunk_sort_targets(ClusterNetId net_id, std::vector<int>& targets, const float* pin_criticality);
 
 static size_t dynamic_update_bounding_boxes(const std::vector<ClusterNetId>& nets, int high_fanout_threshold);
+static size_t expand_oscillating_net_bounding_boxes(const std::vector<ClusterNetId>& rerouted_nets, vtr::vector<ClusterNetId, int>& net_congested_reroutes, int high_fanout_threshold);
+static bool net_uses_overused_nodes(ClusterNetId net_id);
+static float adapt_pres_fac_mult(float pres_fac_mult, float overuse_rate);
 static t_bb calc_current_bb(const t_trace* head);
 
 static bool is_better_quality_routing(const vtr::vector<ClusterNetId, t_traceback>& best_routing,
@@ -399,6 +465,9 @@ bool try_timing_driven_route(const t_router_opts& router_opts,
     int itry; //Routing iteration number
     int itry_conflicted_mode = 0;
 
+    //Number of consecutive iterations each net was re-routed and still congested (adaptive congestion schedule)
+    vtr::vector<ClusterNetId, int> net_congested_reroutes(cluster_ctx.clb_nlist.nets().size(), 0);
+
     /*
      * Best result so far
      */
@@ -417,11 +486,38 @@ bool try_timing_driven_route(const t_router_opts& router_opts,
     RouterStats router_stats;
     print_route_status_header();
     timing_driven_route_structs route_structs;
+
+    std::unique_ptr<FILE, decltype(&vtr::fclose)> iteration_stats_file(nullptr, vtr::fclose);
+    if (!router_opts.iteration_stats_file.empty()) {
+        iteration_stats_file = std::unique_ptr<FILE, decltype(&vtr::fclose)>(vtr::fopen(router_opts.iteration_stats_file.c_str(), "w"), vtr::fclose);
+        print_route_iteration_stats_header(iteration_stats_file.get());
+    }
+    std::unique_ptr<FILE, decltype(&vtr::fclose)> net_stats_file(nullptr, vtr::fclose);
+    f_net_route_stats.clear();
+    if (!router_opts.net_stats_file.empty()) {
+        net_stats_file = std::unique_ptr<FILE, decltype(&vtr::fclose)>(vtr::fopen(router_opts.net_stats_file.c_str(), "w"), vtr::fclose);
+        print_route_net_stats_header(net_stats_file.get());
+        f_net_route_stats.resize(cluster_ctx.clb_nlist.nets().size());
+    }
+    std::unique_ptr<RouteCongestionStatsWriter> congestion_stats_writer;
+    if (!router_opts.congestion_stats_prefix.empty()) {
+        congestion_stats_writer = std::make_unique<RouteCongestionStatsWriter>(router_opts.congestion_stats_prefix, segment_inf);
+    }
     float prev_iter_cumm_time = 0;
     vtr::Timer iteration_timer;
     int num_net_bounding_boxes_updated = 0;
     int itry_since_last_convergence = -1;
+
+    bool parallel_routing = router_opts.parallel_routing && can_route_nets_in_parallel();
+    int max_pins_per_net = parallel_routing ? get_max_pins_per_net() : 0;
+    if (parallel_routing) {
+        //Without pass transistors the base costs do not depend on the net being routed,
+        //set them once so that the routing threads never modify them
+        update_rr_base_costs(1);
+    }
+
     for (itry = 1; itry <= router_opts.max_router_iterations; ++itry) {
+        vtr::ScopedTraceEvent iteration_trace_event("Routing iteration", vtr::trace_enabled() ? std::to_string(itry) : std::string());
         RouterStats router_iteration_stats;
         std::vector<ClusterNetId> rerouted_nets;
 
@@ -452,31 +548,75 @@ bool try_timing_driven_route(const t_router_opts& router_opts,
         /*
          * Route each net
          */
-        for (auto net_id : sorted_nets) {
-            bool was_rerouted = false;
-            bool is_routable = try_timing_driven_route_net(net_id,
-                                                           itry,
-                                                           pres_fac,
-                                                           router_opts,
-                                                           connections_inf,
-                                                           router_iteration_stats,
-                                                           route_structs.pin_criticality,
-                                                           route_structs.rt_node_of_sink,
-                                                           net_delay,
-                                                           *router_lookahead,
-                                                           netlist_pin_lookup,
-                                                           route_timing_info,
-                                                           budgeting_inf,
-                                                           was_rerouted);
-            if (!is_routable) {
-                return (false); //Impossible to route
+        vtr::Timer route_nets_timer;
+        if (parallel_routing) {
+            //The partitions depend on the current routing, so are rebuilt every iteration
+            RoutePartitionTree partition_tree(sorted_nets, router_opts.two_stage_clock_routing);
+            std::vector<PartitionRoutingResults> partition_results(partition_tree.num_nodes());
+
+            auto route_net = [&](ClusterNetId net_id, RouterStats& net_router_stats, float* pin_criticality, t_rt_node** rt_node_of_sink, bool& was_rerouted) {
+                return try_timing_driven_route_net(net_id,
+                                                   itry,
+                                                   pres_fac,
+                                                   router_opts,
+                                                   connections_inf,
+                                                   net_router_stats,
+                                                   pin_criticality,
+                                                   rt_node_of_sink,
+                                                   net_delay,
+                                                   *router_lookahead,
+                                                   netlist_pin_lookup,
+                                                   route_timing_info,
+                                                   budgeting_inf,
+                                                   was_rerouted);
+            };
+            timing_driven_route_partition(partition_tree, partition_tree.root(), max_pins_per_net, route_net, partition_results);
+
+            //Merge the results in the order of the partitions, independently of the threads which routed them
+            for (const PartitionRoutingResults& partition_result : partition_results) {
+                if (!partition_result.is_routable) {
+                    return (false); //Impossible to route
+                }
+
+                router_iteration_stats.connections_routed += partition_result.router_stats.connections_routed;
+                router_iteration_stats.nets_routed += partition_result.router_stats.nets_routed;
+                router_iteration_stats.heap_pushes += partition_result.router_stats.heap_pushes;
+                router_iteration_stats.heap_pops += partition_result.router_stats.heap_pops;
+                router_iteration_stats.nodes_expanded += partition_result.router_stats.nodes_expanded;
+                router_iteration_stats.lookahead_evaluations += partition_result.router_stats.lookahead_evaluations;
+                router_iteration_stats.heap_peak_size = std::max(router_iteration_stats.heap_peak_size, partition_result.router_stats.heap_peak_size);
+                rerouted_nets.insert(rerouted_nets.end(), partition_result.rerouted_nets.begin(), partition_result.rerouted_nets.end());
             }
+        } else {
+            vtr::ScopedTraceEvent nets_trace_event("Route nets");
+            for (auto net_id : sorted_nets) {
+                bool was_rerouted = false;
+                bool is_routable = try_timing_driven_route_net(net_id,
+                                                               itry,
+                                                               pres_fac,
+                                                               router_opts,
+                                                               connections_inf,
+                                                               router_iteration_stats,
+                                                               route_structs.pin_criticality,
+                                                               route_structs.rt_node_of_sink,
+                                                               net_delay,
+                                                               *router_lookahead,
+                                                               netlist_pin_lookup,
+                                                               route_timing_info,
+                                                               budgeting_inf,
+                                                               was_rerouted);
+                if (!is_routable) {
+                    return (false); //Impossible to route
+                }
 
-            if (was_rerouted) {
-                rerouted_nets.push_back(net_id);
+                if (was_rerouted) {
+                    rerouted_nets.push_back(net_id);
+                }
             }
         }
 
+        float route_nets_sec = route_nets_timer.elapsed_sec();
+
         // Make sure any CLB OPINs used up by subblocks being hooked directly to them are reserved for that purpose
         bool rip_up_local_opins = (itry == 1 ? false : true);
         reserve_locally_used_opins(pres_fac, router_opts.acc_fac, rip_up_local_opins);
@@ -491,10 +631,21 @@ bool try_timing_driven_route(const t_router_opts& router_opts,
         wirelength_info = calculate_wirelength_info(available_wirelength);
         routing_predictor.add_iteration_overuse(itry, overuse_info.overused_nodes());
 
+        float sta_sec = 0.;
         if (timing_info) {
             //Update timing based on the new routing
             //Note that the net delays have already been updated by timing_driven_route_net
+            //
+            //After the first iteration only the delays of the re-routed nets have changed,
+            //so only the timing graph around them needs to be re-analyzed
+            if (itry > 1) {
+                for (ClusterNetId net_id : rerouted_nets) {
+                    invalidate_clb_net_timing_edges(*timing_info, net_id);
+                }
+            }
+            vtr::Timer sta_timer;
             timing_info->update();
+            sta_sec = sta_timer.elapsed_sec();
             timing_info->set_warn_unconstrained(false); //Don't warn again about unconstrained nodes again during routing
 
             critical_path = timing_info->least_slack_critical_path();
@@ -512,6 +663,16 @@ bool try_timing_driven_route(const t_router_opts& router_opts,
         //Output progress
         print_route_status(itry, iter_elapsed_time, pres_fac, num_net_bounding_boxes_updated, router_iteration_stats, overuse_info, wirelength_info, timing_info, est_success_iteration);
 
+        if (iteration_stats_file) {
+            print_route_iteration_stats(iteration_stats_file.get(), itry, router_iteration_stats, overuse_info.overused_nodes(), route_nets_sec, sta_sec, iter_elapsed_time);
+        }
+        if (net_stats_file) {
+            print_route_net_stats(net_stats_file.get(), itry, rerouted_nets);
+        }
+        if (congestion_stats_writer) {
+            congestion_stats_writer->write_iteration(itry);
+        }
+
         prev_iter_cumm_time = iter_cumm_time;
 
         //Update graphics
@@ -531,6 +692,9 @@ bool try_timing_driven_route(const t_router_opts& router_opts,
         router_stats.nets_routed += router_iteration_stats.nets_routed;
         router_stats.heap_pushes += router_iteration_stats.heap_pushes;
         router_stats.heap_pops += router_iteration_stats.heap_pops;
+        router_stats.nodes_expanded += router_iteration_stats.nodes_expanded;
+        router_stats.lookahead_evaluations += router_iteration_stats.lookahead_evaluations;
+        router_stats.heap_peak_size = std::max(router_stats.heap_peak_size, router_iteration_stats.heap_peak_size);
 
         /*
          * Are we finished?
@@ -615,6 +779,13 @@ bool try_timing_driven_route(const t_router_opts& router_opts,
             num_net_bounding_boxes_updated = dynamic_update_bounding_boxes(rerouted_nets, router_opts.high_fanout_threshold);
         }
 
+        if (router_opts.adaptive_pres_fac) {
+            //Nets which keep being re-routed through congestion are oscillating between congested
+            //routes, so they are given the freedom of the whole device to route around it
+            size_t num_oscillating_nets = expand_oscillating_net_bounding_boxes(rerouted_nets, net_congested_reroutes, router_opts.high_fanout_threshold);
+            VTR_LOGV_DEBUG(f_router_debug && num_oscillating_nets > 0, "Expanded the bounding boxes of %zu oscillating nets to the device\n", num_oscillating_nets);
+        }
+
         if (itry >= high_effort_congestion_mode_iteration_threshold) {
             //We are approaching the maximum number of routing iterations,
             //and still do not have a legal routing. Switch to a mode which
@@ -627,7 +798,11 @@ bool try_timing_driven_route(const t_router_opts& router_opts,
             pres_fac = router_opts.initial_pres_fac;
             pathfinder_update_cost(pres_fac, 0.); /* Acc_fac=0 for first iter. */
         } else {
-            pres_fac *= router_opts.pres_fac_mult;
+            float pres_fac_mult = router_opts.pres_fac_mult;
+            if (router_opts.adaptive_pres_fac) {
+                pres_fac_mult = adapt_pres_fac_mult(pres_fac_mult, routing_predictor.estimate_overuse_rate());
+            }
+            pres_fac *= pres_fac_mult;
 
             /* Avoid overflow for high iteration counts, even if acc_cost is big */
             pres_fac = std::min(pres_fac, static_cast<float>(HUGE_POSITIVE_FLOAT / 1e5));
@@ -788,6 +963,7 @@ bool try_timing_driven_route_net(ClusterNetId net_id,
     auto& route_ctx = g_vpr_ctx.mutable_routing();
 
     bool is_routed = false;
+    e_reroute_reason reason = e_reroute_reason::NONE;
 
     connections_inf.prepare_routing_for_net(net_id);
 
@@ -795,12 +971,16 @@ bool try_timing_driven_route_net(ClusterNetId net_id,
         is_routed = true;
     } else if (cluster_ctx.clb_nlist.net_is_ignored(net_id)) { /* Skip ignored nets. */
         is_routed = true;
-    } else if (should_route_net(net_id, connections_inf, true) == false) {
+    } else if ((reason = net_reroute_reason(net_id, connections_inf, true)) == e_reroute_reason::NONE) {
         is_routed = true;
     } else {
         // track time spent vs fanout
         profiling::net_fanout_start();
 
+        //Statistics are accumulated, except the heap peak size which is measured for this net alone
+        RouterStats prev_router_stats = router_stats;
+        router_stats.heap_peak_size = 0;
+
         is_routed = timing_driven_route_net(net_id,
                                             itry,
                                             pres_fac,
@@ -817,6 +997,19 @@ bool try_timing_driven_route_net(ClusterNetId net_id,
 
         profiling::net_fanout_end(cluster_ctx.clb_nlist.net_sinks(net_id).size());
 
+        if (!f_net_route_stats.empty()) {
+            t_net_route_stats& net_stats = f_net_route_stats[net_id];
+            net_stats.reason = reason;
+            net_stats.router_stats.connections_routed = router_stats.connections_routed - prev_router_stats.connections_routed;
+            net_stats.router_stats.nets_routed = router_stats.nets_routed - prev_router_stats.nets_routed;
+            net_stats.router_stats.heap_pushes = router_stats.heap_pushes - prev_router_stats.heap_pushes;
+            net_stats.router_stats.heap_pops = router_stats.heap_pops - prev_router_stats.heap_pops;
+            net_stats.router_stats.nodes_expanded = router_stats.nodes_expanded - prev_router_stats.nodes_expanded;
+            net_stats.router_stats.lookahead_evaluations = router_stats.lookahead_evaluations - prev_router_stats.lookahead_evaluations;
+            net_stats.router_stats.heap_peak_size = router_stats.heap_peak_size;
+        }
+        router_stats.heap_peak_size = std::max(router_stats.heap_peak_size, prev_router_stats.heap_peak_size);
+
         /* Impossible to route? (disconnected rr_graph) */
         if (is_routed) {
             route_ctx.net_status[net_id].is_routed = true;
@@ -829,6 +1022,88 @@ bool try_timing_driven_route_net(ClusterNetId net_id,
     return (is_routed);
 }
 
+//Nets can be routed in parallel if VPR is built with TBB, and if the base costs
+//of the routing resources do not depend on the net being routed (see update_rr_base_costs())
+static bool can_route_nets_in_parallel() {
+#if defined(VPR_USE_TBB)
+    auto& device_ctx = g_vpr_ctx.device();
+
+    for (size_t index = CHANX_COST_INDEX_START; index < device_ctx.rr_indexed_data.size(); index++) {
+        if (device_ctx.rr_indexed_data[index].T_quadratic > 0.) { /* pass transistor */
+            VTR_LOG_WARN("Parallel routing is not supported with pass transistor switches, nets will be routed serially\n");
+            return false;
+        }
+    }
+    return true;
+#else
+    VTR_LOG_WARN("Parallel routing requires VPR to be compiled with TBB, nets will be routed serially\n");
+    return false;
+#endif
+}
+
+//Routes the nets of a partition, then the nets of its children (in parallel).
+//
+//The nets of a partition are routed within its region, so the nets of its two
+//children cannot use the same rr_nodes. The nets of each partition are routed
+//in order by a single thread, so the routing does not depend on the number of threads.
+static void timing_driven_route_partition(const RoutePartitionTree& partition_tree,
+                                          int ipartition,
+                                          int max_pins_per_net,
+                                          const t_partition_net_router& route_net,
+                                          std::vector<PartitionRoutingResults>& results) {
+    const RoutePartitionNode& partition = partition_tree.node(ipartition);
+    PartitionRoutingResults& partition_results = results[ipartition];
+
+    //The heap is local to each thread, the other per-net data to each partition.
+    //Both arrays are indexed by pins [1..max_pins_per_net-1]
+    init_heap(g_vpr_ctx.device().grid);
+    std::vector<float> pin_criticality(std::max(max_pins_per_net, 1));
+    std::vector<t_rt_node*> rt_node_of_sink(std::max(max_pins_per_net, 1), nullptr);
+
+    f_partition_tree = &partition_tree;
+    f_partition_region = &partition.region;
+    {
+        vtr::ScopedTraceEvent trace_event("Route partition nets", vtr::trace_enabled() ? std::to_string(partition.nets.size()) + " nets" : std::string());
+        for (ClusterNetId net_id : partition.nets) {
+            bool was_rerouted = false;
+            if (!route_net(net_id, partition_results.router_stats, pin_criticality.data(), rt_node_of_sink.data(), was_rerouted)) {
+                partition_results.is_routable = false;
+                break;
+            }
+
+            if (was_rerouted) {
+                partition_results.rerouted_nets.push_back(net_id);
+            }
+        }
+    }
+    f_partition_tree = nullptr;
+    f_partition_region = nullptr;
+
+    if (!partition_results.is_routable) {
+        return; //Routing will fail anyway
+    }
+
+#if defined(VPR_USE_TBB)
+    tbb::task_group child_tasks;
+    if (partition.left != OPEN) {
+        child_tasks.run([&]() {
+            timing_driven_route_partition(partition_tree, partition.left, max_pins_per_net, route_net, results);
+        });
+    }
+    if (partition.right != OPEN) {
+        timing_driven_route_partition(partition_tree, partition.right, max_pins_per_net, route_net, results);
+    }
+    child_tasks.wait();
+#else
+    if (partition.left != OPEN) {
+        timing_driven_route_partition(partition_tree, partition.left, max_pins_per_net, route_net, results);
+    }
+    if (partition.right != OPEN) {
+        timing_driven_route_partition(partition_tree, partition.right, max_pins_per_net, route_net, results);
+    }
+#endif
+}
+
 /*
  * NOTE:
  * Suggest using a timing_driven_route_structs struct. Memory is managed for you
@@ -996,6 +1271,12 @@ bool timing_driven_route_net(ClusterNetId net_id,
     // compare the criticality of different sink nodes
     sort(begin(remaining_targets), end(remaining_targets), Criticality_comp{pin_criticality});
 
+    if (high_fanout && router_opts.trunk_global_nets && cluster_ctx.clb_nlist.net_is_global(net_id) && !router_opts.two_stage_clock_routing) {
+        //Route the non-critical sinks of a global net from the nearest to the farthest, so that the
+        //route tree grows as a trunk spanning the net from which the farther sinks branch off
+        trunk_sort_targets(net_id, remaining_targets, pin_criticality);
+    }
+
     /* Update base costs according to fanout and criticality rules */
     update_rr_base_costs(num_sinks);
 
@@ -1006,7 +1287,9 @@ bool timing_driven_route_net(ClusterNetId net_id,
     cost_params.delay_budget = ((budgeting_inf.if_set()) ? &conn_delay_budget : nullptr);
 
     // Pre-route to clock source for clock nets (marked as global nets)
+    bool use_clock_route_template = false;
     if (cluster_ctx.clb_nlist.net_is_global(net_id) && router_opts.two_stage_clock_routing) {
+        use_clock_route_template = router_opts.clock_route_templates;
         VTR_ASSERT(router_opts.clock_modeling == DEDICATED_NETWORK);
         RRNodeId sink_node = RRNodeId(device_ctx.virtual_clock_network_root_idx);
         enable_router_debug(router_opts, net_id, sink_node);
@@ -1050,6 +1333,8 @@ bool timing_driven_route_net(ClusterNetId net_id,
                                       cost_params,
                                       pres_fac,
                                       router_opts.high_fanout_threshold,
+                                      router_opts.trunk_global_nets,
+                                      use_clock_route_template,
                                       rt_root, rt_node_of_sink,
                                       router_lookahead,
                                       spatial_route_tree_lookup,
@@ -1186,6 +1471,8 @@ static bool timing_driven_route_sink(ClusterNetId net_id,
                                      const t_conn_cost_params cost_params,
                                      float pres_fac,
                                      int high_fanout_threshold,
+                                     bool trunk_global_nets,
+                                     bool use_clock_route_template,
                                      t_rt_node* rt_root,
                                      t_rt_node** rt_node_of_sink,
                                      const RouterLookahead& router_lookahead,
@@ -1213,26 +1500,33 @@ static bool timing_driven_route_sink(ClusterNetId net_id,
     constexpr float HIGH_FANOUT_CRITICALITY_THRESHOLD = 0.9;
     bool sink_critical = (cost_params.criticality > HIGH_FANOUT_CRITICALITY_THRESHOLD);
 
-    //We normally route high fanout nets by only adding spatially close-by routing to the heap (reduces run-time).
-    //However, if the current sink is 'critical' from a timing perspective, we put the entire route tree back onto
-    //the heap to ensure it has more flexibility to find the best path.
-    if (high_fanout && !sink_critical && !net_is_global) {
-        cheapest = timing_driven_route_connection_from_route_tree_high_fanout(rt_root,
-                                                                              sink_node,
-                                                                              cost_params,
-                                                                              bounding_box,
-                                                                              router_lookahead,
-                                                                              spatial_rt_lookup,
-                                                                              modified_rr_node_inf,
-                                                                              router_stats);
-    } else {
-        cheapest = timing_driven_route_connection_from_route_tree(rt_root,
-                                                                  sink_node,
-                                                                  cost_params,
-                                                                  bounding_box,
-                                                                  router_lookahead,
-                                                                  modified_rr_node_inf,
-                                                                  router_stats);
+    //Clock net sinks are connected along the path through the clock network computed with the RR graph, if available
+    if (use_clock_route_template) {
+        cheapest = route_connection_from_clock_template(net_id, sink_node, modified_rr_node_inf);
+    }
+
+    if (cheapest == nullptr) {
+        //We normally route high fanout nets by only adding spatially close-by routing to the heap (reduces run-time).
+        //However, if the current sink is 'critical' from a timing perspective, we put the entire route tree back onto
+        //the heap to ensure it has more flexibility to find the best path.
+        if (high_fanout && !sink_critical && (!net_is_global || trunk_global_nets)) {
+            cheapest = timing_driven_route_connection_from_route_tree_high_fanout(rt_root,
+                                                                                  sink_node,
+                                                                                  cost_params,
+                                                                                  bounding_box,
+                                                                                  router_lookahead,
+                                                                                  spatial_rt_lookup,
+                                                                                  modified_rr_node_inf,
+                                                                                  router_stats);
+        } else {
+            cheapest = timing_driven_route_connection_from_route_tree(rt_root,
+                                                                      sink_node,
+                                                                      cost_params,
+                                                                      bounding_box,
+                                                                      router_lookahead,
+                                                                      modified_rr_node_inf,
+                                                                      router_stats);
+        }
     }
 
     if (cheapest == nullptr) {
@@ -1469,6 +1763,8 @@ static t_heap* timing_driven_route_connection_from_heap(const RRNodeId& sink_nod
 
     t_heap* cheapest = nullptr;
     while (!is_empty_heap()) {
+        router_stats.heap_peak_size = std::max(router_stats.heap_peak_size, heap_size());
+
         // cheapest t_heap in current route tree to be expanded on
         cheapest = get_heap_head();
         ++router_stats.heap_pops;
@@ -1548,6 +1844,8 @@ static vtr::vector<RRNodeId, t_heap> timing_driven_find_all_shortest_paths_from_
     }
 
     while (!is_empty_heap()) {
+        router_stats.heap_peak_size = std::max(router_stats.heap_peak_size, heap_size());
+
         // cheapest t_heap in current route tree to be expanded on
         t_heap* cheapest = get_heap_head();
         ++router_stats.heap_pops;
@@ -1591,12 +1889,12 @@ static void timing_driven_expand_cheapest(t_heap* cheapest,
                                           const RouterLookahead& router_lookahead,
                                           std::vector<RRNodeId>& modified_rr_node_inf,
                                           RouterStats& router_stats) {
-    auto& route_ctx = g_vpr_ctx.mutable_routing();
+    auto& rr_node_route_inf = get_thread_rr_node_route_inf();
 
     RRNodeId inode = cheapest->index;
 
-    float best_total_cost = route_ctx.rr_node_route_inf[inode].path_cost;
-    float best_back_cost = route_ctx.rr_node_route_inf[inode].backward_path_cost;
+    float best_total_cost = rr_node_route_inf[inode].path_cost;
+    float best_back_cost = rr_node_route_inf[inode].backward_path_cost;
 
     float new_total_cost = cheapest->cost;
     float new_back_cost = cheapest->backward_path_cost;
@@ -1618,11 +1916,12 @@ static void timing_driven_expand_cheapest(t_heap* cheapest,
         VTR_LOGV_DEBUG(f_router_debug, "      Setting path costs for assicated node %d (from %d edge %d)\n", cheapest->index, cheapest->u.prev.node, cheapest->u.prev.edge);
 
         add_to_mod_list(cheapest->index, modified_rr_node_inf);
+        ++router_stats.nodes_expanded;
 
-        route_ctx.rr_node_route_inf[cheapest->index].prev_node = cheapest->u.prev.node;
-        route_ctx.rr_node_route_inf[cheapest->index].prev_edge = cheapest->u.prev.edge;
-        route_ctx.rr_node_route_inf[cheapest->index].path_cost = new_total_cost;
-        route_ctx.rr_node_route_inf[cheapest->index].backward_path_cost = new_back_cost;
+        rr_node_route_inf[cheapest->index].prev_node = cheapest->u.prev.node;
+        rr_node_route_inf[cheapest->index].prev_edge = cheapest->u.prev.edge;
+        rr_node_route_inf[cheapest->index].path_cost = new_total_cost;
+        rr_node_route_inf[cheapest->index].backward_path_cost = new_back_cost;
 
         timing_driven_expand_neighbours(cheapest, cost_params, bounding_box,
                                         router_lookahead,
@@ -1697,10 +1996,13 @@ static t_rt_node* setup_routing_resources(int itry,
         //Prune the branches of the tree that don't legally lead to sinks
         rt_root = prune_route_tree(rt_root, connections_inf);
 
-        //Now that the tree has been pruned, we can free the old traceback
+        //Now that the tree has been pruned, we can rip-up the pruned connections
+        //and free the old traceback. The legal branches kept by the pruned tree
+        //stay in place, so their congestion is not updated twice.
         // NOTE: this must happen *after* pruning since it changes the
         //       recorded congestion
-        pathfinder_update_path_cost(route_ctx.trace[net_id].head, -1, pres_fac);
+        add_route_tree_to_rr_node_lookup(rt_root);
+        pathfinder_rip_up_pruned_traceback(route_ctx.trace[net_id].head, pres_fac);
         free_traceback(net_id);
 
         if (rt_root) { //Partially pruned
@@ -1716,9 +2018,6 @@ static t_rt_node* setup_routing_resources(int itry,
             //Santiy check that route tree and traceback are equivalent after pruning
             VTR_ASSERT_DEBUG(verify_traceback_route_tree_equivalent(route_ctx.trace[net_id].head, rt_root));
 
-            // put the updated costs of the route tree nodes back into pathfinder
-            pathfinder_update_path_cost(route_ctx.trace[net_id].head, 1, pres_fac);
-
         } else { //Fully destroyed
             profiling::route_tree_pruned();
 
@@ -1936,6 +2235,7 @@ static void add_route_tree_node_to_heap(t_rt_node* rt_node,
     float backward_path_cost = cost_params.criticality * rt_node->Tdel;
 
     float R_upstream = rt_node->R_upstream;
+    ++router_stats.lookahead_evaluations;
     float tot_cost = backward_path_cost
                      + cost_params.astar_fac
                            * router_lookahead.get_expected_cost(inode, target_node, cost_params, R_upstream);
@@ -1979,33 +2279,59 @@ static void timing_driven_expand_neighbours(t_heap* current,
         target_bb.ymax = device_ctx.rr_graph.node_yhigh(target_node);
     }
 
-    //For each node associated with the current heap element, expand all of it's neighbours
+    t_expansion_candidates& candidates = f_expansion_candidates;
+    candidates.heap_items.clear();
+    candidates.nodes.clear();
+    candidates.R_upstream.clear();
+
+    //For each node associated with the current heap element, find the neighbours to expand
+    //and calculate their known (backward) costs
     for (const RREdgeId& edge : device_ctx.rr_graph.node_out_edges(current->index)) {
         const RRNodeId& to_node = device_ctx.rr_graph.edge_sink_node(edge);
-        timing_driven_expand_neighbour(current,
-                                       current->index, edge, to_node,
-                                       cost_params,
-                                       bounding_box,
-                                       router_lookahead,
-                                       target_node,
-                                       target_bb,
-                                       router_stats);
+        if (!timing_driven_expand_neighbour(current->index, edge, to_node,
+                                            bounding_box,
+                                            target_node,
+                                            target_bb)) {
+            continue;
+        }
+
+        t_heap* next = alloc_heap_data();
+        next->index = to_node;
+
+        //Costs initialized to current
+        next->cost = std::numeric_limits<float>::infinity(); //Not used directly
+        next->backward_path_cost = current->backward_path_cost;
+        next->R_upstream = current->R_upstream;
+
+        timing_driven_expand_node(cost_params, next, current->index, to_node, edge);
+
+        candidates.heap_items.push_back(next);
+        candidates.nodes.push_back(to_node);
+        candidates.R_upstream.push_back(next->R_upstream);
+    }
+
+    //The expected costs of all the neighbours are evaluated at once, so that the lookahead
+    //only does the work depending on the target once
+    candidates.expected_costs.resize(candidates.nodes.size());
+    router_lookahead.get_expected_costs(candidates.nodes, target_node, cost_params, candidates.R_upstream, candidates.expected_costs);
+    router_stats.lookahead_evaluations += candidates.nodes.size();
+
+    for (size_t icand = 0; icand < candidates.heap_items.size(); ++icand) {
+        t_heap* next = candidates.heap_items[icand];
+        add_timing_driven_expected_cost(next, cost_params, target_node, candidates.expected_costs[icand]);
+        timing_driven_add_to_heap(next, router_stats);
     }
 }
 
-//Conditionally adds to_node to the router heap (via path from from_node via from_edge).
+//Returns true if to_node should be added to the router heap (via path from from_node via from_edge).
 //RR nodes outside the expanded bounding box specified in bounding_box are not added
 //to the heap.
-static void timing_driven_expand_neighbour(t_heap* current,
-                                           const RRNodeId& from_node,
+static bool timing_driven_expand_neighbour(const RRNodeId& from_node,
                                            const RREdgeId& from_edge,
                                            const RRNodeId& to_node,
-                                           const t_conn_cost_params cost_params,
                                            const t_bb bounding_box,
-                                           const RouterLookahead& router_lookahead,
                                            const RRNodeId& target_node,
-                                           const t_bb target_bb,
-                                           RouterStats& router_stats) {
+                                           const t_bb target_bb) {
     auto& device_ctx = g_vpr_ctx.device();
 
     int to_xlow =  device_ctx.rr_graph.node_xlow(to_node);
@@ -2024,7 +2350,18 @@ static void timing_driven_expand_neighbour(t_heap* current,
                        size_t(from_node), size_t(from_edge), size_t(to_node),
                        to_xlow, to_ylow, to_xhigh, to_yhigh,
                        bounding_box.xmin, bounding_box.ymin, bounding_box.xmax, bounding_box.ymax);
-        return; /* Node is outside (expanded) bounding box. */
+        return false; /* Node is outside (expanded) bounding box. */
+    }
+
+    //When routing nets in parallel, nodes outside of the partition of the net
+    //may be used by other threads
+    if (f_partition_region != nullptr && !f_partition_tree->is_node_in_region(to_node, *f_partition_region)) {
+        VTR_LOGV_DEBUG(f_router_debug,
+                       "      Pruned expansion of node %ld edge %ld -> %ld"
+                       " (outside of routing partition %d,%dx%d,%d)\n",
+                       size_t(from_node), size_t(from_edge), size_t(to_node),
+                       f_partition_region->xmin, f_partition_region->ymin, f_partition_region->xmax, f_partition_region->ymax);
+        return false;
     }
 
     /* Prune away IPINs that lead to blocks other than the target one.  Avoids  *
@@ -2047,7 +2384,7 @@ static void timing_driven_expand_neighbour(t_heap* current,
                                size_t(from_node), size_t(from_edge), size_t(to_node),
                                to_xlow, to_ylow, to_xhigh, to_yhigh,
                                target_bb.xmin, target_bb.ymin, target_bb.xmax, target_bb.ymax);
-                return;
+                return false;
             }
         }
     }
@@ -2055,42 +2392,22 @@ static void timing_driven_expand_neighbour(t_heap* current,
     VTR_LOGV_DEBUG(f_router_debug, "      Expanding node %ld edge %ld -> %ld\n",
                    size_t(from_node), size_t(from_edge), size_t(to_node));
 
-    timing_driven_add_to_heap(cost_params,
-                              router_lookahead,
-                              current, from_node, to_node, from_edge, target_node, router_stats);
+    return true;
 }
 
-//Add to_node to the heap, and also add any nodes which are connected by non-configurable edges
-static void timing_driven_add_to_heap(const t_conn_cost_params cost_params,
-                                      const RouterLookahead& router_lookahead,
-                                      const t_heap* current,
-                                      const RRNodeId& from_node,
-                                      const RRNodeId& to_node,
-                                      const RREdgeId& iconn,
-                                      const RRNodeId& target_node,
+//Adds next (whose costs have been calculated) to the heap, or frees it if the path it
+//describes is not cheaper than the best known path to its node
+static void timing_driven_add_to_heap(t_heap* next,
                                       RouterStats& router_stats) {
-    t_heap* next = alloc_heap_data();
-    next->index = to_node;
-
-    //Costs initialized to current
-    next->cost = std::numeric_limits<float>::infinity(); //Not used directly
-    next->backward_path_cost = current->backward_path_cost;
-    next->R_upstream = current->R_upstream;
-
-    timing_driven_expand_node(cost_params,
-                              router_lookahead,
-                              next, from_node, to_node, iconn, target_node);
-
-    auto& route_ctx = g_vpr_ctx.routing();
+    const RRNodeId& to_node = next->index;
+    const auto& rr_node_route_inf = get_thread_rr_node_route_inf();
 
-    float best_total_cost = route_ctx.rr_node_route_inf[to_node].path_cost;
-    float best_back_cost = route_ctx.rr_node_route_inf[to_node].backward_path_cost;
+    float best_total_cost = rr_node_route_inf[to_node].path_cost;
+    float best_back_cost = rr_node_route_inf[to_node].backward_path_cost;
 
     float new_total_cost = next->cost;
     float new_back_cost = next->backward_path_cost;
 
-    VTR_ASSERT_SAFE(next->index == to_node);
-
     if (new_total_cost < best_total_cost && new_back_cost < best_back_cost) {
         //Add node to the heap only if the cost via the current partial path is less than the
         //best known cost, since there is no reason for the router to expand more expensive paths.
@@ -2104,20 +2421,17 @@ static void timing_driven_add_to_heap(const t_conn_cost_params cost_params,
     }
 }
 
-//Updates current (path step and costs) to account for the step taken to reach to_node
+//Updates current (path step and backward costs) to account for the step taken to reach to_node
 static void timing_driven_expand_node(const t_conn_cost_params cost_params,
-                                      const RouterLookahead& router_lookahead,
                                       t_heap* current,
                                       const RRNodeId& from_node,
                                       const RRNodeId& to_node,
-                                      const RREdgeId& iconn,
-                                      const RRNodeId& target_node) {
+                                      const RREdgeId& iconn) {
     VTR_LOGV_DEBUG(f_router_debug, "      Expanding to node %ld (%s)\n", size_t(to_node), describe_rr_node(to_node).c_str());
 
     evaluate_timing_driven_node_costs(current,
                                       cost_params,
-                                      router_lookahead,
-                                      from_node, to_node, iconn, target_node);
+                                      from_node, to_node, iconn);
 
     //Record how we reached this node
     current->index = to_node;
@@ -2125,21 +2439,20 @@ static void timing_driven_expand_node(const t_conn_cost_params cost_params,
     current->u.prev.node = from_node;
 }
 
-//Calculates the cost of reaching to_node
+//Calculates the known cost of reaching to_node
 static void evaluate_timing_driven_node_costs(t_heap* to,
                                               const t_conn_cost_params cost_params,
-                                              const RouterLookahead& router_lookahead,
                                               const RRNodeId& from_node,
                                               const RRNodeId& to_node,
-                                              const RREdgeId& iconn,
-                                              const RRNodeId& target_node) {
+                                              const RREdgeId& iconn) {
     /* new_costs.backward_cost: is the "known" part of the cost to this node -- the
      * congestion cost of all the routing resources back to the existing route
      * plus the known delay of the total path back to the source.
      *
-     * new_costs.total_cost: is this "known" backward cost + an expected cost to get to the target.
-     *
      * new_costs.R_upstream: is the upstream resistance at the end of this node
+     *
+     * The total cost (the backward cost + an expected cost to get to the target) is
+     * set by add_timing_driven_expected_cost().
      */
     auto& device_ctx = g_vpr_ctx.device();
 
@@ -2229,17 +2542,21 @@ static void evaluate_timing_driven_node_costs(t_heap* to,
         total_cost += std::pow(std::max(0.f, total_cost - delay_budget->max_delay), 2) / 100e-12;
         total_cost += std::pow(std::max(0.f, delay_budget->min_delay - total_cost), 2) / 100e-12;
     }
+}
 
-    //Update total cost
-    float expected_cost = router_lookahead.get_expected_cost(to_node, target_node, cost_params, to->R_upstream);
+//Sets the total cost of to (whose backward cost has been calculated) from its expected cost to reach target_node
+static void add_timing_driven_expected_cost(t_heap* to,
+                                            const t_conn_cost_params cost_params,
+                                            const RRNodeId& target_node,
+                                            float expected_cost) {
+    const RRNodeId& to_node = to->index;
     VTR_LOGV_DEBUG(f_router_debug && !std::isfinite(expected_cost),
                    "        Lookahead from %s (%s) to %s (%s) is non-finite, expected_cost = %f, to->R_upstream = %f\n",
                    rr_node_arch_name(to_node).c_str(), describe_rr_node(to_node).c_str(),
                    rr_node_arch_name(target_node).c_str(), describe_rr_node(target_node).c_str(),
                    expected_cost, to->R_upstream);
-    total_cost = to->backward_path_cost + cost_params.astar_fac * expected_cost;
 
-    to->cost = total_cost;
+    to->cost = to->backward_path_cost + cost_params.astar_fac * expected_cost;
 }
 
 void update_rr_base_costs(int fanout) {
@@ -2254,10 +2571,14 @@ void update_rr_base_costs(int fanout) {
     factor = sqrt(fanout);
 
     for (index = CHANX_COST_INDEX_START; index < device_ctx.rr_indexed_data.size(); index++) {
+        float base_cost = device_ctx.rr_indexed_data[index].saved_base_cost;
         if (device_ctx.rr_indexed_data[index].T_quadratic > 0.) { /* pass transistor */
-            device_ctx.rr_indexed_data[index].base_cost = device_ctx.rr_indexed_data[index].saved_base_cost * factor;
-        } else {
-            device_ctx.rr_indexed_data[index].base_cost = device_ctx.rr_indexed_data[index].saved_base_cost;
+            base_cost *= factor;
+        }
+        //Only write changed costs, since nets routed in parallel call this concurrently
+        //(with unchanged costs, see can_route_nets_in_parallel())
+        if (device_ctx.rr_indexed_data[index].base_cost != base_cost) {
+            device_ctx.rr_indexed_data[index].base_cost = base_cost;
         }
     }
 }
@@ -2304,6 +2625,10 @@ static bool timing_driven_check_net_delays(vtr::vector<ClusterNetId, float*>& ne
 
 /* Detect if net should be routed or not */
 static bool should_route_net(ClusterNetId net_id, CBRR& connections_inf, bool if_force_reroute) {
+    return net_reroute_reason(net_id, connections_inf, if_force_reroute) != e_reroute_reason::NONE;
+}
+
+static e_reroute_reason net_reroute_reason(ClusterNetId net_id, CBRR& connections_inf, bool if_force_reroute) {
     auto& route_ctx = g_vpr_ctx.routing();
     auto& device_ctx = g_vpr_ctx.device();
 
@@ -2311,7 +2636,7 @@ static bool should_route_net(ClusterNetId net_id, CBRR& connections_inf, bool if
 
     if (tptr == nullptr) {
         /* No routing yet. */
-        return true;
+        return e_reroute_reason::UNROUTED;
     }
 
     for (;;) {
@@ -2320,7 +2645,7 @@ static bool should_route_net(ClusterNetId net_id, CBRR& connections_inf, bool if
         int capacity = device_ctx.rr_graph.node_capacity(inode);
 
         if (occ > capacity) {
-            return true; /* overuse detected */
+            return e_reroute_reason::CONGESTION; /* overuse detected */
         }
 
         if (tptr->iswitch == OPEN) { //End of a branch
@@ -2328,7 +2653,7 @@ static bool should_route_net(ClusterNetId net_id, CBRR& connections_inf, bool if
             if (if_force_reroute) {
                 /* Xifan Tang - TODO: should use RRNodeId */ 
                 if (connections_inf.should_force_reroute_connection(size_t(inode))) {
-                    return true;
+                    return e_reroute_reason::CRITICAL_CONNECTION;
                 }
             }
             tptr = tptr->next; /* Skip next segment (duplicate of original branch node). */
@@ -2342,7 +2667,7 @@ static bool should_route_net(ClusterNetId net_id, CBRR& connections_inf, bool if
 
     VTR_ASSERT(connections_inf.get_remaining_targets().empty());
 
-    return false; /* Current route has no overuse */
+    return e_reroute_reason::NONE; /* Current route has no overuse */
 }
 
 static bool early_exit_heuristic(const t_router_opts& router_opts, const WirelengthInfo& wirelength_info) {
@@ -2359,10 +2684,12 @@ static bool early_exit_heuristic(const t_router_opts& router_opts, const Wirelen
 }
 
 // incremental rerouting resources class definitions
+thread_local std::vector<int> Connection_based_routing_resources::remaining_targets;
+thread_local std::vector<t_rt_node*> Connection_based_routing_resources::reached_rt_sinks;
+thread_local ClusterNetId Connection_based_routing_resources::current_inet;
+
 Connection_based_routing_resources::Connection_based_routing_resources()
-    : current_inet(NO_PREVIOUS)
-    , // not routing to a specific net yet (note that NO_PREVIOUS is not unsigned, so will be largest unsigned)
-    last_stable_critical_path_delay{0.0f}
+    : last_stable_critical_path_delay{0.0f}
     , critical_path_growth_tolerance{1.001f}
     , connection_criticality_tolerance{0.9f}
     , connection_delay_optimality_tolerance{1.1f} {
@@ -2376,6 +2703,8 @@ Connection_based_routing_resources::Connection_based_routing_resources()
      * reached_rt_sinks will also reserve enough space, but instead of
      * indices, it will store the pointers to route tree nodes */
 
+    current_inet = ClusterNetId(NO_PREVIOUS); // not routing to a specific net yet (note that NO_PREVIOUS is not unsigned, so will be largest unsigned)
+
     auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& route_ctx = g_vpr_ctx.routing();
 
@@ -2635,6 +2964,39 @@ static WirelengthInfo calculate_wirelength_info(size_t available_wirelength) {
     return WirelengthInfo(available_wirelength, used_wirelength);
 }
 
+static void print_route_iteration_stats_header(FILE* fp) {
+    fprintf(fp, "iteration,nets_routed,connections_routed,heap_pushes,heap_pops,nodes_expanded,lookahead_evaluations,heap_peak_size,overused_nodes,route_sec,sta_sec,iteration_sec\n");
+}
+
+static void print_route_iteration_stats(FILE* fp, int itry, const RouterStats& router_stats, size_t overused_nodes, float route_sec, float sta_sec, float iteration_sec) {
+    fprintf(fp, "%d,%zu,%zu,%zu,%zu,%zu,%zu,%zu,%zu,%g,%g,%g\n",
+            itry,
+            router_stats.nets_routed, router_stats.connections_routed,
+            router_stats.heap_pushes, router_stats.heap_pops,
+            router_stats.nodes_expanded, router_stats.lookahead_evaluations, router_stats.heap_peak_size,
+            overused_nodes, route_sec, sta_sec, iteration_sec);
+}
+
+static void print_route_net_stats_header(FILE* fp) {
+    fprintf(fp, "iteration,net,reason,connections_routed,heap_pushes,heap_pops,nodes_expanded,lookahead_evaluations,heap_peak_size\n");
+}
+
+//Writes the statistics of the nets re-routed in an iteration, in the order they were routed
+static void print_route_net_stats(FILE* fp, int itry, const std::vector<ClusterNetId>& rerouted_nets) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    for (ClusterNetId net_id : rerouted_nets) {
+        const t_net_route_stats& net_stats = f_net_route_stats[net_id];
+        fprintf(fp, "%d,%s,%s,%zu,%zu,%zu,%zu,%zu,%zu\n",
+                itry, cluster_ctx.clb_nlist.net_name(net_id).c_str(),
+                REROUTE_REASON_NAMES[size_t(net_stats.reason)],
+                net_stats.router_stats.connections_routed,
+                net_stats.router_stats.heap_pushes, net_stats.router_stats.heap_pops,
+                net_stats.router_stats.nodes_expanded, net_stats.router_stats.lookahead_evaluations,
+                net_stats.router_stats.heap_peak_size);
+    }
+}
+
 static void print_route_status_header() {
     VTR_LOG("---- ------ ------- ---- ------- ------- ------- ----------------- --------------- -------- ---------- ---------- ---------- ---------- --------\n");
     VTR_LOG("Iter   Time    pres  BBs    Heap  Re-Rtd  Re-Rtd Overused RR Nodes      Wirelength      CPD       sTNS       sWNS       hTNS       hWNS Est Succ\n");
@@ -2754,6 +3116,29 @@ static bool is_high_fanout(int fanout, int fanout_threshold) {
     return true;
 }
 
+//Orders the targets which follow the critical ones by increasing distance from the net source
+static void trunk_sort_targets(ClusterNetId net_id, std::vector<int>& targets, const float* pin_criticality) {
+    auto& route_ctx = g_vpr_ctx.routing();
+    const RRGraph& rr_graph = g_vpr_ctx.device().rr_graph;
+
+    constexpr float HIGH_FANOUT_CRITICALITY_THRESHOLD = 0.9;
+    auto first_non_critical = std::find_if(targets.begin(), targets.end(), [&](int ipin) {
+        return pin_criticality[ipin] <= HIGH_FANOUT_CRITICALITY_THRESHOLD;
+    });
+
+    RRNodeId source_node = route_ctx.net_rr_terminals[net_id][0];
+    int source_x = rr_graph.node_xlow(source_node);
+    int source_y = rr_graph.node_ylow(source_node);
+    auto source_dist = [&](int ipin) {
+        RRNodeId sink_node = route_ctx.net_rr_terminals[net_id][ipin];
+        return std::abs(rr_graph.node_xlow(sink_node) - source_x) + std::abs(rr_graph.node_ylow(sink_node) - source_y);
+    };
+
+    std::stable_sort(first_non_critical, targets.end(), [&](int lhs, int rhs) {
+        return source_dist(lhs) < source_dist(rhs);
+    });
+}
+
 //In heavily congested designs a static bounding box (BB) can
 //become problematic for routability (it effectively enforces a
 //hard blockage restricting where a net can route).
@@ -2858,6 +3243,84 @@ static size_t dynamic_update_bounding_boxes(const std::vector<ClusterNetId>& upd
     return num_bb_updated;
 }
 
+//With many nets competing for the same resources, some nets resolve their congestion
+//by detouring, while others keep moving back and forth between congested routes at each
+//iteration, being unable to route out of the way within their bounding box.
+//
+//This expands (once) the bounding box of a net to the whole device when it has been
+//re-routed through congestion for NET_OSCILLATION_ITERATION_THRESHOLD consecutive iterations.
+//Returns the number of nets whose bounding box was expanded.
+static size_t expand_oscillating_net_bounding_boxes(const std::vector<ClusterNetId>& rerouted_nets, vtr::vector<ClusterNetId, int>& net_congested_reroutes, int high_fanout_threshold) {
+    constexpr int NET_OSCILLATION_ITERATION_THRESHOLD = 4;
+
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+    auto& grid = g_vpr_ctx.device().grid;
+
+    int grid_xmax = grid.width() - 1;
+    int grid_ymax = grid.height() - 1;
+
+    size_t num_bb_updated = 0;
+
+    for (ClusterNetId net : rerouted_nets) {
+        if (!net_uses_overused_nodes(net)) {
+            net_congested_reroutes[net] = 0;
+            continue;
+        }
+
+        if (++net_congested_reroutes[net] < NET_OSCILLATION_ITERATION_THRESHOLD) continue;
+        net_congested_reroutes[net] = 0;
+
+        //High fanout nets use bounding boxes based on the target location (see dynamic_update_bounding_boxes())
+        if (is_high_fanout(cluster_ctx.clb_nlist.net_sinks(net).size(), high_fanout_threshold)) continue;
+
+        t_bb& router_bb = route_ctx.route_bb[net];
+        if (router_bb.xmin == 0 && router_bb.ymin == 0 && router_bb.xmax == grid_xmax && router_bb.ymax == grid_ymax) continue;
+
+        router_bb.xmin = 0;
+        router_bb.ymin = 0;
+        router_bb.xmax = grid_xmax;
+        router_bb.ymax = grid_ymax;
+        ++num_bb_updated;
+    }
+    return num_bb_updated;
+}
+
+//Returns true if the current routing of the net uses an overused RR node
+static bool net_uses_overused_nodes(ClusterNetId net_id) {
+    auto& route_ctx = g_vpr_ctx.routing();
+    const RRGraph& rr_graph = g_vpr_ctx.device().rr_graph;
+
+    for (const RRNodeId& inode : route_ctx.trace_nodes[net_id]) {
+        if (route_ctx.rr_node_route_inf[inode].occ() > rr_graph.node_capacity(inode)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//Returns the factor by which pres_fac grows for the next iteration given the
+//predicted relative change of the overuse per iteration:
+//  * While the overuse stalls (or grows) the congestion is not being resolved at the
+//    current pres_fac, so pres_fac grows faster to force the nets apart.
+//  * While the overuse falls quickly the current pres_fac is sufficient, so pres_fac
+//    grows slower to avoid degrading the delay and wirelength of the nets needlessly.
+static float adapt_pres_fac_mult(float pres_fac_mult, float overuse_rate) {
+    constexpr float STALLED_OVERUSE_RATE = -0.05;
+    constexpr float FAST_OVERUSE_RATE = -0.5;
+
+    if (std::isnan(overuse_rate) || pres_fac_mult <= 1.) {
+        return pres_fac_mult;
+    }
+
+    if (overuse_rate > STALLED_OVERUSE_RATE) {
+        return pres_fac_mult * pres_fac_mult;
+    } else if (overuse_rate < FAST_OVERUSE_RATE) {
+        return std::sqrt(pres_fac_mult);
+    }
+    return pres_fac_mult;
+}
+
 //Returns the bounding box of a net's used routing resources
 static t_bb calc_current_bb(const t_trace* head) {
     auto& device_ctx = g_vpr_ctx.device();
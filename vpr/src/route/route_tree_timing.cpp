@@ -1,5 +1,6 @@
 #include <cstdio>
 #include <cmath>
+#include <memory>
 #include <vector>
 
 #include "vtr_assert.h"
@@ -27,15 +28,93 @@
 /* Array below allows mapping from any rr_node to any rt_node currently in
  * the rt_tree.                                                              */
 
-static vtr::vector<RRNodeId, t_rt_node*> rr_node_to_rt_node; /* [0..device_ctx.rr_graph.nodes().size()-1] */
+static vtr::vector<RRNodeId, t_rt_node*> shared_rr_node_to_rt_node; /* [0..device_ctx.rr_graph.nodes().size()-1] */
 
-/* Frees lists for fast addition and deletion of nodes and edges. */
+/* Lookup of the calling thread, if it does not use the shared one (see set_thread_rr_node_to_rt_node_lookup()) */
+static thread_local vtr::vector<RRNodeId, t_rt_node*>* thread_rr_node_to_rt_node = nullptr;
 
-static t_rt_node* rt_node_free_list = nullptr;
-static t_linked_rt_edge* rt_edge_free_list = nullptr;
+/* Links of the free lists of nodes and edges */
+static t_rt_node*& free_list_next(t_rt_node* rt_node) {
+    return rt_node->u.next;
+}
+
+static t_linked_rt_edge*& free_list_next(t_linked_rt_edge* rt_edge) {
+    return rt_edge->next;
+}
+
+/* Arena of the nodes (or edges) of the route trees built by a thread.
+ * Objects are allocated from contiguous blocks, so that the nodes of a route tree
+ * are close to each other in memory and there is no per-object heap allocation.
+ * Freed objects are reused through a free list. Once all the objects are freed,
+ * i.e., once the route trees of the thread are ripped up, the arena is reset in O(1),
+ * so that the next route trees are allocated contiguously again.
+ * Route trees must be freed by the thread which built them.                 */
+template<typename T>
+class RouteTreeArena {
+  public:
+    T* alloc() {
+        ++num_live_;
+        if (free_list_ != nullptr) {
+            T* obj = free_list_;
+            free_list_ = free_list_next(obj);
+            return obj;
+        }
+        if (next_index_ == BLOCK_SIZE * num_used_blocks_) {
+            if (num_used_blocks_ == blocks_.size()) {
+                blocks_.emplace_back(new T[BLOCK_SIZE]);
+            }
+            ++num_used_blocks_;
+        }
+        T* obj = &blocks_[next_index_ / BLOCK_SIZE][next_index_ % BLOCK_SIZE];
+        ++next_index_;
+        return obj;
+    }
+
+    void free(T* obj) {
+        VTR_ASSERT_SAFE(num_live_ > 0);
+        --num_live_;
+        if (num_live_ == 0) {
+            reset();
+            return;
+        }
+        free_list_next(obj) = free_list_;
+        free_list_ = obj;
+    }
+
+    bool empty() const { return num_live_ == 0; }
+
+    //Releases the memory of the blocks, if no object is in use
+    void clear() {
+        if (num_live_ == 0) {
+            reset();
+            blocks_.clear();
+        }
+    }
+
+  private:
+    void reset() {
+        free_list_ = nullptr;
+        next_index_ = 0;
+        num_used_blocks_ = 0;
+    }
+
+  private:
+    static constexpr size_t BLOCK_SIZE = 1024;
+
+    std::vector<std::unique_ptr<T[]>> blocks_;
+    size_t num_used_blocks_ = 0;
+    size_t next_index_ = 0; //Index of the next object never allocated since the last reset
+    T* free_list_ = nullptr;
+    size_t num_live_ = 0;
+};
+
+static thread_local RouteTreeArena<t_rt_node> rt_node_arena;
+static thread_local RouteTreeArena<t_linked_rt_edge> rt_edge_arena;
 
 /********************** Subroutines local to this module *********************/
 
+static vtr::vector<RRNodeId, t_rt_node*>& rr_node_to_rt_node();
+
 static t_rt_node* alloc_rt_node();
 
 static void free_rt_node(t_rt_node* rt_node);
@@ -73,8 +152,8 @@ bool alloc_route_tree_timing_structs(bool exists_ok) {
 
     auto& device_ctx = g_vpr_ctx.device();
 
-    bool route_tree_structs_are_allocated = (rr_node_to_rt_node.size() == size_t(device_ctx.rr_graph.nodes().size())
-                                             || rt_node_free_list != nullptr);
+    bool route_tree_structs_are_allocated = (shared_rr_node_to_rt_node.size() == size_t(device_ctx.rr_graph.nodes().size())
+                                             || !rt_node_arena.empty());
     if (route_tree_structs_are_allocated) {
         if (exists_ok) {
             return false;
@@ -84,89 +163,55 @@ bool alloc_route_tree_timing_structs(bool exists_ok) {
         }
     }
 
-    rr_node_to_rt_node = vtr::vector<RRNodeId, t_rt_node*>(device_ctx.rr_graph.nodes().size(), nullptr);
+    shared_rr_node_to_rt_node = vtr::vector<RRNodeId, t_rt_node*>(device_ctx.rr_graph.nodes().size(), nullptr);
 
     return true;
 }
 
 void free_route_tree_timing_structs() {
     /* Frees the structures needed to build routing trees, and really frees
-     * (i.e. calls free) all the data on the free lists.                         */
-
-    t_rt_node *rt_node, *next_node;
-    t_linked_rt_edge *rt_edge, *next_edge;
-
-    rr_node_to_rt_node.clear();
-
-    rt_node = rt_node_free_list;
-
-    while (rt_node != nullptr) {
-        next_node = rt_node->u.next;
-        free(rt_node);
-        rt_node = next_node;
-    }
+     * (i.e. calls free) the arenas of the calling thread, once its route trees are freed. */
 
-    rt_node_free_list = nullptr;
+    shared_rr_node_to_rt_node.clear();
 
-    rt_edge = rt_edge_free_list;
-
-    while (rt_edge != nullptr) {
-        next_edge = rt_edge->next;
-        free(rt_edge);
-        rt_edge = next_edge;
-    }
-
-    rt_edge_free_list = nullptr;
+    rt_node_arena.clear();
+    rt_edge_arena.clear();
 }
 
 static t_rt_node*
 alloc_rt_node() {
-    /* Allocates a new rt_node, from the free list if possible, from the free
-     * store otherwise.                                                         */
-
-    t_rt_node* rt_node;
-
-    rt_node = rt_node_free_list;
+    /* Allocates a new rt_node from the arena of the thread. */
 
-    if (rt_node != nullptr) {
-        rt_node_free_list = rt_node->u.next;
-    } else {
-        rt_node = (t_rt_node*)vtr::malloc(sizeof(t_rt_node));
-    }
-
-    return (rt_node);
+    return rt_node_arena.alloc();
 }
 
 static void free_rt_node(t_rt_node* rt_node) {
-    /* Adds rt_node to the proper free list.          */
+    /* Returns rt_node to the arena of the thread. */
 
-    rt_node->u.next = rt_node_free_list;
-    rt_node_free_list = rt_node;
+    rt_node_arena.free(rt_node);
 }
 
 static t_linked_rt_edge*
 alloc_linked_rt_edge() {
-    /* Allocates a new linked_rt_edge, from the free list if possible, from the
-     * free store otherwise.                                                     */
+    /* Allocates a new linked_rt_edge from the arena of the thread. */
 
-    t_linked_rt_edge* linked_rt_edge;
-
-    linked_rt_edge = rt_edge_free_list;
+    return rt_edge_arena.alloc();
+}
 
-    if (linked_rt_edge != nullptr) {
-        rt_edge_free_list = linked_rt_edge->next;
-    } else {
-        linked_rt_edge = (t_linked_rt_edge*)vtr::malloc(sizeof(t_linked_rt_edge));
-    }
+/* Returns the rt_edge to the arena of the thread. */
+static void free_linked_rt_edge(t_linked_rt_edge* rt_edge) {
+    rt_edge_arena.free(rt_edge);
+}
 
-    VTR_ASSERT(linked_rt_edge != nullptr);
-    return (linked_rt_edge);
+void set_thread_rr_node_to_rt_node_lookup(vtr::vector<RRNodeId, t_rt_node*>* lookup) {
+    thread_rr_node_to_rt_node = lookup;
 }
 
-/* Adds the rt_edge to the rt_edge free list.                       */
-static void free_linked_rt_edge(t_linked_rt_edge* rt_edge) {
-    rt_edge->next = rt_edge_free_list;
-    rt_edge_free_list = rt_edge;
+static vtr::vector<RRNodeId, t_rt_node*>& rr_node_to_rt_node() {
+    if (thread_rr_node_to_rt_node) {
+        return *thread_rr_node_to_rt_node;
+    }
+    return shared_rr_node_to_rt_node;
 }
 
 /* Initializes the routing tree to just the net source, and returns the root
@@ -190,7 +235,7 @@ t_rt_node* init_route_tree_to_source(ClusterNetId inet) {
     rt_root->C_downstream = device_ctx.rr_graph.node_C(inode);
     rt_root->R_upstream = device_ctx.rr_graph.node_R(inode);
     rt_root->Tdel = 0.5 * device_ctx.rr_graph.node_R(inode) * device_ctx.rr_graph.node_C(inode);
-    rr_node_to_rt_node[inode] = rt_root;
+    rr_node_to_rt_node()[inode] = rt_root;
 
     return (rt_root);
 }
@@ -239,11 +284,25 @@ t_rt_node* update_route_tree(t_heap* hptr, SpatialRouteTreeLookup* spatial_rt_lo
     return (sink_rt_node);
 }
 
+void pathfinder_rip_up_pruned_traceback(const t_trace* head, float pres_fac) {
+    for (const t_trace* tptr = head; tptr != nullptr; tptr = tptr->next) {
+        if (rr_node_to_rt_node()[tptr->index] == nullptr) {
+            pathfinder_update_single_node_cost(tptr->index, -1, pres_fac);
+        }
+
+        if (tptr->iswitch == OPEN) { //End of branch
+            tptr = tptr->next;       /* Skip next segment (duplicate of the branch point). */
+            if (tptr == nullptr)
+                break;
+        }
+    }
+}
+
 void add_route_tree_to_rr_node_lookup(t_rt_node* node) {
     if (node) {
-        VTR_ASSERT(rr_node_to_rt_node[node->inode] == nullptr || rr_node_to_rt_node[node->inode] == node);
+        VTR_ASSERT(rr_node_to_rt_node()[node->inode] == nullptr || rr_node_to_rt_node()[node->inode] == node);
 
-        rr_node_to_rt_node[node->inode] = node;
+        rr_node_to_rt_node()[node->inode] = node;
 
         for (auto edge = node->u.child_list; edge != nullptr; edge = edge->next) {
             add_route_tree_to_rr_node_lookup(edge->child);
@@ -261,7 +320,7 @@ add_subtree_to_route_tree(t_heap* hptr, t_rt_node** sink_rt_node_ptr) {
     t_linked_rt_edge* linked_rt_edge;
 
     auto& device_ctx = g_vpr_ctx.device();
-    auto& route_ctx = g_vpr_ctx.routing();
+    auto& rr_node_route_inf = get_thread_rr_node_route_inf();
 
     RRNodeId inode = hptr->index;
 
@@ -274,7 +333,7 @@ add_subtree_to_route_tree(t_heap* hptr, t_rt_node** sink_rt_node_ptr) {
     sink_rt_node = alloc_rt_node();
     sink_rt_node->u.child_list = nullptr;
     sink_rt_node->inode = inode;
-    rr_node_to_rt_node[inode] = sink_rt_node;
+    rr_node_to_rt_node()[inode] = sink_rt_node;
 
     /* In the code below I'm marking SINKs and IPINs as not to be re-expanded.
      * It makes the code more efficient (though not vastly) to prune this way
@@ -296,7 +355,7 @@ add_subtree_to_route_tree(t_heap* hptr, t_rt_node** sink_rt_node_ptr) {
     // inode is node index of previous node
     // NO_PREVIOUS tags a previously routed node
 
-    while (rr_node_to_rt_node[inode] == nullptr) { //Not connected to existing routing
+    while (rr_node_to_rt_node()[inode] == nullptr) { //Not connected to existing routing
         main_branch_visited.insert(inode);
         all_visited.insert(inode);
 
@@ -317,7 +376,7 @@ add_subtree_to_route_tree(t_heap* hptr, t_rt_node** sink_rt_node_ptr) {
         rt_node->u.child_list = linked_rt_edge;
         rt_node->inode = inode;
 
-        rr_node_to_rt_node[inode] = rt_node;
+        rr_node_to_rt_node()[inode] = rt_node;
 
         if (device_ctx.rr_graph.node_type(inode) == IPIN) {
             rt_node->re_expand = false;
@@ -326,14 +385,14 @@ add_subtree_to_route_tree(t_heap* hptr, t_rt_node** sink_rt_node_ptr) {
         }
 
         downstream_rt_node = rt_node;
-        iedge = route_ctx.rr_node_route_inf[inode].prev_edge;
-        inode = route_ctx.rr_node_route_inf[inode].prev_node;
+        iedge = rr_node_route_inf[inode].prev_edge;
+        inode = rr_node_route_inf[inode].prev_node;
         iswitch = (short)size_t(device_ctx.rr_graph.edge_switch(iedge));
     }
 
     //Inode is now the branch point to the old routing; do not need
     //to alloc another node since the old routing has done so already
-    rt_node = rr_node_to_rt_node[inode];
+    rt_node = rr_node_to_rt_node()[inode];
     VTR_ASSERT_MSG(rt_node, "Previous routing branch should exist");
 
     linked_rt_edge = alloc_linked_rt_edge();
@@ -363,7 +422,7 @@ static t_rt_node* add_non_configurable_to_route_tree(const RRNodeId& rr_node, co
 
         auto& device_ctx = g_vpr_ctx.device();
 
-        rt_node = rr_node_to_rt_node[rr_node];
+        rt_node = rr_node_to_rt_node()[rr_node];
 
         if (!reached_by_non_configurable_edge) { //An existing main branch node
             VTR_ASSERT(rt_node);
@@ -411,7 +470,7 @@ static t_rt_node* add_non_configurable_to_route_tree(const RRNodeId& rr_node, co
             child_rt_node->parent_node = rt_node;
             child_rt_node->parent_switch = iswitch;
         }
-        rr_node_to_rt_node[rr_node] = rt_node;
+        rr_node_to_rt_node()[rr_node] = rt_node;
     }
 
     return rt_node;
@@ -639,8 +698,8 @@ void free_route_tree(t_rt_node* rt_node) {
         rt_edge = next_edge;
     }
 
-    if (!rr_node_to_rt_node.empty()) {
-        rr_node_to_rt_node.at(rt_node->inode) = nullptr;
+    if (!rr_node_to_rt_node().empty()) {
+        rr_node_to_rt_node().at(rt_node->inode) = nullptr;
     }
 
     free_rt_node(rt_node);
@@ -1432,7 +1491,7 @@ init_route_tree_to_source_no_net(const RRNodeId& inode) {
     rt_root->C_downstream = device_ctx.rr_graph.node_C(inode);
     rt_root->R_upstream = device_ctx.rr_graph.node_R(inode);
     rt_root->Tdel = 0.5 * device_ctx.rr_graph.node_R(inode) * device_ctx.rr_graph.node_C(inode);
-    rr_node_to_rt_node[inode] = rt_root;
+    rr_node_to_rt_node()[inode] = rt_root;
 
     return (rt_root);
 }
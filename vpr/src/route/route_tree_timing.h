@@ -13,6 +13,11 @@ bool alloc_route_tree_timing_structs(bool exists_ok = false);
 
 void free_route_tree_timing_structs();
 
+//Makes the calling thread use its own rr node to rt node lookup (sized to the number of rr nodes)
+//instead of the shared one, or the shared one again if lookup is nullptr.
+//Used to build route trees of overlapping nets at the same time (see RouterDelayProfiler)
+void set_thread_rr_node_to_rt_node_lookup(vtr::vector<RRNodeId, t_rt_node*>* lookup);
+
 t_rt_node* init_route_tree_to_source(ClusterNetId inet);
 
 void free_route_tree(t_rt_node* rt_node);
@@ -71,6 +76,11 @@ t_rt_node* prune_route_tree(t_rt_node* rt_root, CBRR& connections_inf, std::vect
 
 void pathfinder_update_cost_from_route_tree(const t_rt_node* rt_root, int add_or_sub, float pres_fac);
 
+//Rips up the nodes of a traceback which are not in the route tree recorded by
+//add_route_tree_to_rr_node_lookup(), i.e. the nodes pruned from the route tree
+//built from the traceback. The nodes kept by the route tree are left in place.
+void pathfinder_rip_up_pruned_traceback(const t_trace* head, float pres_fac);
+
 bool is_equivalent_route_tree(const t_rt_node* rt_root, const t_rt_node* cloned_rt_root);
 bool is_valid_skeleton_tree(const t_rt_node* rt_root);
 bool is_valid_route_tree(const t_rt_node* rt_root);
@@ -0,0 +1,180 @@
+#include "route_warm_start.h"
+
+#include <algorithm>
+
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+#include "globals.h"
+#include "route_common.h"
+
+//An RR node of a saved routing, identified independently of the RR graph
+struct t_warm_start_node {
+    t_rr_type type;
+    short xlow;
+    short ylow;
+    short xhigh;
+    short yhigh;
+    short ptc;
+    e_side side;           //Only for IPIN/OPIN nodes
+    e_direction direction; //Only for CHANX/CHANY nodes
+    bool end_of_branch;    //True if the node is the last one of a branch of the traceback
+};
+
+//The saved routing of each net, in the order of its traceback
+static vtr::vector<ClusterNetId, std::vector<t_warm_start_node>> f_warm_start_routing;
+
+static RRNodeId find_warm_start_node(const t_warm_start_node& node);
+static bool project_warm_start_net(ClusterNetId net_id, std::vector<RRNodeId>& nodes, std::vector<short>& switches);
+
+void save_warm_start_routing() {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& route_ctx = g_vpr_ctx.routing();
+    const RRGraph& rr_graph = g_vpr_ctx.device().rr_graph;
+
+    f_warm_start_routing.clear();
+    f_warm_start_routing.resize(cluster_ctx.clb_nlist.nets().size());
+
+    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
+        if (cluster_ctx.clb_nlist.net_is_ignored(net_id) || size_t(net_id) >= route_ctx.trace.size()) {
+            continue;
+        }
+
+        std::vector<t_warm_start_node>& saved_nodes = f_warm_start_routing[net_id];
+        for (t_trace* tptr = route_ctx.trace[net_id].head; tptr != nullptr; tptr = tptr->next) {
+            const RRNodeId& inode = tptr->index;
+
+            t_warm_start_node node;
+            node.type = rr_graph.node_type(inode);
+            node.xlow = rr_graph.node_xlow(inode);
+            node.ylow = rr_graph.node_ylow(inode);
+            node.xhigh = rr_graph.node_xhigh(inode);
+            node.yhigh = rr_graph.node_yhigh(inode);
+            node.ptc = rr_graph.node_ptc_num(inode);
+            node.side = (node.type == IPIN || node.type == OPIN) ? rr_graph.node_side(inode) : NUM_SIDES;
+            node.direction = (node.type == CHANX || node.type == CHANY) ? rr_graph.node_direction(inode) : NO_DIRECTION;
+            node.end_of_branch = (tptr->iswitch == OPEN);
+            saved_nodes.push_back(node);
+        }
+    }
+}
+
+std::vector<ClusterNetId> load_warm_start_routing(float pres_fac) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    std::vector<ClusterNetId> restored_nets;
+    if (f_warm_start_routing.size() != cluster_ctx.clb_nlist.nets().size()) {
+        //Nothing saved, or saved for another netlist
+        return restored_nets;
+    }
+
+    size_t num_saved_nets = 0;
+    std::vector<RRNodeId> nodes;
+    std::vector<short> switches;
+    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
+        if (cluster_ctx.clb_nlist.net_is_ignored(net_id) || f_warm_start_routing[net_id].empty()) {
+            continue;
+        }
+        ++num_saved_nets;
+
+        if (!project_warm_start_net(net_id, nodes, switches)) {
+            continue;
+        }
+
+        VTR_ASSERT(route_ctx.trace[net_id].head == nullptr);
+        t_trace* tptr = nullptr;
+        for (size_t inode = 0; inode < nodes.size(); ++inode) {
+            t_trace* node_tptr = alloc_trace_data();
+            node_tptr->index = nodes[inode];
+            node_tptr->iswitch = switches[inode];
+            node_tptr->next = nullptr;
+            if (tptr == nullptr) {
+                route_ctx.trace[net_id].head = node_tptr;
+            } else {
+                tptr->next = node_tptr;
+            }
+            tptr = node_tptr;
+            route_ctx.trace_nodes[net_id].insert(nodes[inode]);
+        }
+        route_ctx.trace[net_id].tail = tptr;
+
+        pathfinder_update_path_cost(route_ctx.trace[net_id].head, 1, pres_fac);
+        restored_nets.push_back(net_id);
+    }
+
+    VTR_LOG("Warm start restored the routing of %zu of %zu nets\n", restored_nets.size(), num_saved_nets);
+
+    return restored_nets;
+}
+
+//Returns the node of the current RR graph matching the saved node, or an invalid id if none does
+static RRNodeId find_warm_start_node(const t_warm_start_node& node) {
+    const RRGraph& rr_graph = g_vpr_ctx.device().rr_graph;
+
+    RRNodeId inode = rr_graph.find_node(node.xlow, node.ylow, node.type, node.ptc, node.side);
+    if (inode == RRNodeId::INVALID()) {
+        return inode;
+    }
+
+    //A track of the same index may be a different wire in the new RR graph
+    if (rr_graph.node_xhigh(inode) != node.xhigh || rr_graph.node_yhigh(inode) != node.yhigh) {
+        return RRNodeId::INVALID();
+    }
+    if ((node.type == CHANX || node.type == CHANY) && rr_graph.node_direction(inode) != node.direction) {
+        return RRNodeId::INVALID();
+    }
+
+    return inode;
+}
+
+//Projects the saved routing of a net onto the current RR graph, and returns false
+//if some of its nodes or switches do not exist, or if it does not route the terminals of the net
+static bool project_warm_start_net(ClusterNetId net_id, std::vector<RRNodeId>& nodes, std::vector<short>& switches) {
+    auto& route_ctx = g_vpr_ctx.routing();
+    const RRGraph& rr_graph = g_vpr_ctx.device().rr_graph;
+
+    const std::vector<t_warm_start_node>& saved_nodes = f_warm_start_routing[net_id];
+    nodes.clear();
+    switches.clear();
+
+    std::vector<RRNodeId> reached_sinks;
+    for (const t_warm_start_node& saved_node : saved_nodes) {
+        RRNodeId inode = find_warm_start_node(saved_node);
+        if (inode == RRNodeId::INVALID()) {
+            return false;
+        }
+        if (saved_node.end_of_branch && saved_node.type == SINK) {
+            reached_sinks.push_back(inode);
+        }
+        nodes.push_back(inode);
+    }
+
+    //The switch of a node drives the next node of its branch
+    for (size_t inode = 0; inode < nodes.size(); ++inode) {
+        if (saved_nodes[inode].end_of_branch) {
+            switches.push_back(OPEN);
+            continue;
+        }
+        if (inode + 1 == nodes.size()) {
+            return false;
+        }
+        std::vector<RREdgeId> edges = rr_graph.find_edges(nodes[inode], nodes[inode + 1]);
+        if (edges.empty()) {
+            return false;
+        }
+        switches.push_back((short)size_t(rr_graph.edge_switch(edges[0])));
+    }
+
+    //The routing must start at the source of the net and reach each of its sinks,
+    //which is not the case if the placement changed
+    const std::vector<RRNodeId>& terminals = route_ctx.net_rr_terminals[net_id];
+    if (nodes.front() != terminals[0]) {
+        return false;
+    }
+    std::vector<RRNodeId> net_sinks(terminals.begin() + 1, terminals.end());
+    std::sort(net_sinks.begin(), net_sinks.end());
+    std::sort(reached_sinks.begin(), reached_sinks.end());
+
+    return net_sinks == reached_sinks;
+}
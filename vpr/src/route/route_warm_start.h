@@ -0,0 +1,28 @@
+#ifndef VPR_ROUTE_WARM_START_H
+#define VPR_ROUTE_WARM_START_H
+#include <vector>
+
+#include "vtr_vector.h"
+
+#include "vpr_types.h"
+
+//Warm start of a routing attempt from the routing of the previous attempt, e.g. at the
+//previous channel width of the minimum channel width search.
+//
+//The routing is saved by the location and track (ptc) of its RR nodes rather than by
+//their ids, so that it can be projected onto a new RR graph. A net is restored only if
+//all its nodes and switches exist in the new RR graph and it still connects its own
+//terminals (i.e. the placement did not change); the other nets are left unrouted.
+//
+//The restored nets occupy their RR nodes, so the first routing iteration only reroutes
+//the unrouted nets and the restored nets going through congested RR nodes.
+
+//Saves the current routing of the nets, replacing any routing saved before
+void save_warm_start_routing();
+
+//Restores the saved routing, which is projected onto the current RR graph, for the
+//nets which are legal in it. The routing structures must be initialized and empty.
+//Returns the restored nets.
+std::vector<ClusterNetId> load_warm_start_routing(float pres_fac);
+
+#endif
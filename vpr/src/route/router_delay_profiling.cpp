@@ -7,11 +7,18 @@
 #include "route_export.h"
 #include "rr_graph.h"
 
+#include <cmath>
+#include <limits>
+
+//Number of the connection delays kept by a RouterDelayProfiler
+constexpr size_t CONNECTION_DELAY_CACHE_SIZE = 4096;
+
 static t_rt_node* setup_routing_resources_no_net(const RRNodeId& source_node);
 
 RouterDelayProfiler::RouterDelayProfiler(
     const RouterLookahead* lookahead)
-    : router_lookahead_(lookahead) {}
+    : router_lookahead_(lookahead)
+    , connection_delays_(CONNECTION_DELAY_CACHE_SIZE) {}
 
 bool RouterDelayProfiler::calculate_delay(const RRNodeId& source_node, const RRNodeId& sink_node, const t_router_opts& router_opts, float* net_delay) const {
     /* Returns true as long as found some way to hook up this net, even if that *
@@ -19,7 +26,26 @@ bool RouterDelayProfiler::calculate_delay(const RRNodeId& source_node, const RRN
      * to route this net, even ignoring congestion, it returns false.  In this  *
      * case the rr_graph is disconnected and you can give up.                   */
     auto& device_ctx = g_vpr_ctx.device();
-    auto& route_ctx = g_vpr_ctx.routing();
+
+    float cached_delay;
+    if (connection_delays_.get(std::make_pair(source_node, sink_node), cached_delay)) {
+        if (std::isnan(cached_delay)) {
+            return false;
+        }
+        *net_delay = cached_delay;
+        return true;
+    }
+
+#if defined(VPR_USE_TBB)
+    t_thread_routing_state& routing_state = thread_routing_states_.local();
+    if (routing_state.rr_node_route_inf.empty()) {
+        routing_state.rr_node_route_inf = g_vpr_ctx.routing().rr_node_route_inf;
+        routing_state.rr_node_to_rt_node = vtr::vector<RRNodeId, t_rt_node*>(device_ctx.rr_graph.nodes().size(), nullptr);
+    }
+    set_thread_rr_node_route_inf(&routing_state.rr_node_route_inf);
+    set_thread_rr_node_to_rt_node_lookup(&routing_state.rr_node_to_rt_node);
+#endif
+    auto& rr_node_route_inf = get_thread_rr_node_route_inf();
 
     t_rt_node* rt_root = setup_routing_resources_no_net(source_node);
     /* TODO: This should be changed to RRNodeId */
@@ -60,7 +86,7 @@ bool RouterDelayProfiler::calculate_delay(const RRNodeId& source_node, const RRN
         //find delay
         *net_delay = rt_node_of_sink->Tdel;
 
-        VTR_ASSERT_MSG(route_ctx.rr_node_route_inf[rt_root->inode].occ() <= device_ctx.rr_graph.node_capacity(rt_root->inode), "SOURCE should never be congested");
+        VTR_ASSERT_MSG(rr_node_route_inf[rt_root->inode].occ() <= device_ctx.rr_graph.node_capacity(rt_root->inode), "SOURCE should never be congested");
         free_route_tree(rt_root);
     }
 
@@ -68,6 +94,14 @@ bool RouterDelayProfiler::calculate_delay(const RRNodeId& source_node, const RRN
     empty_heap();
     reset_path_costs(modified_rr_node_inf);
 
+#if defined(VPR_USE_TBB)
+    set_thread_rr_node_route_inf(nullptr);
+    set_thread_rr_node_to_rt_node_lookup(nullptr);
+#endif
+
+    connection_delays_.set(std::make_pair(source_node, sink_node),
+                           found_path ? *net_delay : std::numeric_limits<float>::quiet_NaN());
+
     return found_path;
 }
 
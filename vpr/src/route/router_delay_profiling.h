@@ -3,16 +3,46 @@
 
 #include "vpr_types.h"
 #include "router_lookahead.h"
+#include "route_tree_type.h"
+#include "vtr_cache.h"
 
+#include <utility>
 #include <vector>
 
+#if defined(VPR_USE_TBB)
+#    include <tbb/enumerable_thread_specific.h>
+#endif
+
 class RouterDelayProfiler {
   public:
     RouterDelayProfiler(const RouterLookahead* lookahead);
+
+    //With VPR_USE_TBB, delays can be calculated by several threads at the same time:
+    //each thread searches paths on its own copy of the routing state of the rr nodes
     bool calculate_delay(const RRNodeId& source_node, const RRNodeId& sink_node, const t_router_opts& router_opts, float* net_delay) const;
 
   private:
+    struct t_connection_hash {
+        size_t operator()(const std::pair<RRNodeId, RRNodeId>& conn) const {
+            return std::hash<RRNodeId>()(conn.first) * 31 + std::hash<RRNodeId>()(conn.second);
+        }
+    };
+
     const RouterLookahead* router_lookahead_;
+
+    //Delays of the recently profiled connections, which the delay model sampling
+    //profiles repeatedly (e.g. the paths between the same pins of two tiles).
+    //NaN marks a connection without a path.
+    mutable vtr::LruCache<std::pair<RRNodeId, RRNodeId>, float, t_connection_hash, true> connection_delays_;
+
+#if defined(VPR_USE_TBB)
+    //Routing state of a thread, copied from the routing context by its first calculate_delay()
+    struct t_thread_routing_state {
+        vtr::vector<RRNodeId, t_rr_node_route_inf> rr_node_route_inf;
+        vtr::vector<RRNodeId, t_rt_node*> rr_node_to_rt_node;
+    };
+    mutable tbb::enumerable_thread_specific<t_thread_routing_state> thread_routing_states_;
+#endif
 };
 
 vtr::vector<RRNodeId, float> calculate_all_path_delays_from_rr_node(const RRNodeId& src_rr_node, const t_router_opts& router_opts);
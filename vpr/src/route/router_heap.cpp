@@ -0,0 +1,97 @@
+#include <algorithm>
+
+#include "router_heap.h"
+
+#include "route_common.h"
+
+constexpr size_t RouterHeap::ARITY;
+
+void RouterHeap::push(t_heap* hptr) {
+    entries_.emplace_back();
+    sift_up(entries_.size() - 1, {hptr->cost, hptr});
+}
+
+void RouterHeap::push_back(t_heap* hptr) {
+    entries_.push_back({hptr->cost, hptr});
+}
+
+void RouterHeap::build_heap() {
+    if (entries_.size() < 2) {
+        return;
+    }
+
+    //Sift down every entry having children, from the last one
+    for (size_t i = (entries_.size() - 2) / ARITY + 1; i-- > 0;) {
+        sift_down(i, entries_[i]);
+    }
+}
+
+t_heap* RouterHeap::pop() {
+    if (entries_.empty()) {
+        return nullptr;
+    }
+
+    t_heap* cheapest = entries_[0].data;
+
+    Entry last = entries_.back();
+    entries_.pop_back();
+    if (!entries_.empty()) {
+        sift_down(0, last);
+    }
+
+    return cheapest;
+}
+
+bool RouterHeap::is_valid() const {
+    for (size_t i = 1; i < entries_.size(); ++i) {
+        if (entries_[i].cost < entries_[(i - 1) / ARITY].cost) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//Moves the hole up until entry can be placed in it
+//
+//entry is taken by value, as it may be one of the entries which are moved
+void RouterHeap::sift_up(size_t hole, Entry entry) {
+    while (hole > 0) {
+        size_t parent = (hole - 1) / ARITY;
+        if (!(entry.cost < entries_[parent].cost)) {
+            break;
+        }
+        entries_[hole] = entries_[parent];
+        hole = parent;
+    }
+    entries_[hole] = entry;
+}
+
+//Moves the hole down until entry can be placed in it
+//
+//entry is taken by value, as it may be one of the entries which are moved
+//(e.g. the entry of the hole itself in build_heap())
+void RouterHeap::sift_down(size_t hole, Entry entry) {
+    const size_t num_entries = entries_.size();
+    while (true) {
+        size_t first_child = ARITY * hole + 1;
+        if (first_child >= num_entries) {
+            break;
+        }
+
+        //Cheapest child
+        size_t last_child = std::min(first_child + ARITY, num_entries);
+        size_t child = first_child;
+        for (size_t ichild = first_child + 1; ichild < last_child; ++ichild) {
+            if (entries_[ichild].cost < entries_[child].cost) {
+                child = ichild;
+            }
+        }
+
+        if (!(entries_[child].cost < entry.cost)) {
+            break;
+        }
+        entries_[hole] = entries_[child];
+        hole = child;
+    }
+    entries_[hole] = entry;
+}
@@ -0,0 +1,61 @@
+#ifndef VPR_ROUTER_HEAP_H
+#define VPR_ROUTER_HEAP_H
+#include <vector>
+
+struct t_heap;
+
+//Min-heap of the partial routes explored by the router, sorted by cost
+//
+//The entries are stored by value with their cost, so that sifting compares costs
+//without dereferencing the t_heap they refer to. The heap is 4-ary: it is shallower
+//than a binary heap, and the children of an entry are contiguous (i.e. in the same
+//cache line), which lowers the cost of the frequent pops.
+//
+//The heap does not own the t_heap it refers to (see alloc_heap_data() and free_heap_data()).
+//A heap is not thread-safe, each routing thread uses its own.
+class RouterHeap {
+  public:
+    struct Entry {
+        float cost;
+        t_heap* data;
+    };
+
+  public:
+    bool empty() const { return entries_.empty(); }
+    size_t size() const { return entries_.size(); }
+
+    //Entries in heap order (not sorted)
+    const std::vector<Entry>& entries() const { return entries_; }
+
+    void reserve(size_t num_entries) { entries_.reserve(num_entries); }
+
+    //Removes all the entries (the t_heap they refer to are not freed)
+    void clear() { entries_.clear(); }
+
+    //Adds hptr to the heap, with its current cost
+    void push(t_heap* hptr);
+
+    //Adds hptr to the heap without maintaining the heap property,
+    //which must be restored by build_heap() before popping
+    void push_back(t_heap* hptr);
+
+    //Restores the heap property after push_back()
+    void build_heap();
+
+    //Removes and returns the cheapest entry, nullptr if the heap is empty
+    t_heap* pop();
+
+    //Returns true if the heap property holds
+    bool is_valid() const;
+
+  private:
+    void sift_up(size_t hole, Entry entry);
+    void sift_down(size_t hole, Entry entry);
+
+  private:
+    static constexpr size_t ARITY = 4;
+
+    std::vector<Entry> entries_;
+};
+
+#endif
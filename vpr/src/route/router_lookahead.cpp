@@ -41,6 +41,15 @@ std::unique_ptr<RouterLookahead> make_router_lookahead(
     return router_lookahead;
 }
 
+void RouterLookahead::get_expected_costs(const std::vector<RRNodeId>& nodes, const RRNodeId& target_node, const t_conn_cost_params& params, const std::vector<float>& R_upstream, std::vector<float>& expected_costs) const {
+    VTR_ASSERT(R_upstream.size() == nodes.size());
+
+    expected_costs.resize(nodes.size());
+    for (size_t inode = 0; inode < nodes.size(); ++inode) {
+        expected_costs[inode] = get_expected_cost(nodes[inode], target_node, params, R_upstream[inode]);
+    }
+}
+
 float ClassicLookahead::get_expected_cost(const RRNodeId& current_node, const RRNodeId& target_node, const t_conn_cost_params& params, float R_upstream) const {
     auto& device_ctx = g_vpr_ctx.device();
 
@@ -101,10 +110,34 @@ float MapLookahead::get_expected_cost(const RRNodeId& current_node, const RRNode
     }
 }
 
+void MapLookahead::get_expected_costs(const std::vector<RRNodeId>& nodes, const RRNodeId& target_node, const t_conn_cost_params& params, const std::vector<float>& /*R_upstream*/, std::vector<float>& expected_costs) const {
+    auto& device_ctx = g_vpr_ctx.device();
+
+    expected_costs.resize(nodes.size());
+    for (size_t inode = 0; inode < nodes.size(); ++inode) {
+        if (device_ctx.rr_graph.node_type(nodes[inode]) == IPIN) { /* Change if you're allowing route-throughs */
+            expected_costs[inode] = device_ctx.rr_indexed_data[SINK_COST_INDEX].base_cost;
+        } else {
+            expected_costs[inode] = 0.;
+        }
+    }
+
+    //The costs of the CHANX/CHANY nodes are looked up together in the map
+    get_lookahead_map_costs(nodes, target_node, params.criticality, expected_costs);
+}
+
 void MapLookahead::compute(const std::vector<t_segment_inf>& segment_inf) {
     compute_router_lookahead(segment_inf.size());
 }
 
+void MapLookahead::read(const std::string& file) {
+    read_router_lookahead(file);
+}
+
+void MapLookahead::write(const std::string& file) const {
+    write_router_lookahead(file);
+}
+
 float NoOpLookahead::get_expected_cost(const RRNodeId& /*current_node*/, const RRNodeId& /*target_node*/, const t_conn_cost_params& /*params*/, float /*R_upstream*/) const {
     return 0.;
 }
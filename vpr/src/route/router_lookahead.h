@@ -1,6 +1,7 @@
 #ifndef VPR_ROUTER_LOOKAHEAD_H
 #define VPR_ROUTER_LOOKAHEAD_H
 #include <memory>
+#include <vector>
 #include "vpr_types.h"
 #include "vpr_error.h"
 
@@ -14,6 +15,14 @@ class RouterLookahead {
     // get_expected_cost.
     virtual float get_expected_cost(const RRNodeId& node, const RRNodeId& target_node, const t_conn_cost_params& params, float R_upstream) const = 0;
 
+    // Get expected costs from each of nodes (with upstream resistance
+    // R_upstream) to target_node, into expected_costs (resized like nodes).
+    //
+    // Equivalent to get_expected_cost for each node, but lets the lookahead
+    // share the work depending on the target between the nodes (e.g. the
+    // fanout of the node being expanded by the router).
+    virtual void get_expected_costs(const std::vector<RRNodeId>& nodes, const RRNodeId& target_node, const t_conn_cost_params& params, const std::vector<float>& R_upstream, std::vector<float>& expected_costs) const;
+
     // Compute router lookahead (if needed).
     virtual void compute(const std::vector<t_segment_inf>& segment_inf) = 0;
 
@@ -71,13 +80,10 @@ class ClassicLookahead : public RouterLookahead {
 class MapLookahead : public RouterLookahead {
   protected:
     float get_expected_cost(const RRNodeId& node, const RRNodeId& target_node, const t_conn_cost_params& params, float R_upstream) const override;
+    void get_expected_costs(const std::vector<RRNodeId>& nodes, const RRNodeId& target_node, const t_conn_cost_params& params, const std::vector<float>& R_upstream, std::vector<float>& expected_costs) const override;
     void compute(const std::vector<t_segment_inf>& segment_inf) override;
-    void read(const std::string& /*file*/) override {
-        VPR_THROW(VPR_ERROR_ROUTE, "MapLookahead::read unimplemented");
-    }
-    void write(const std::string& /*file*/) const override {
-        VPR_THROW(VPR_ERROR_ROUTE, "MapLookahead::write unimplemented");
-    }
+    void read(const std::string& file) override;
+    void write(const std::string& file) const override;
 };
 
 class NoOpLookahead : public RouterLookahead {
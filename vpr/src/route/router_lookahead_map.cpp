@@ -14,6 +14,7 @@
  */
 
 #include <cmath>
+#include <cstdint>
 #include <vector>
 #include <queue>
 #include <ctime>
@@ -25,9 +26,22 @@
 #include "vtr_log.h"
 #include "vtr_assert.h"
 #include "vtr_time.h"
+#include "vtr_hash.h"
 #include "rr_graph_obj_util.h"
 #include "router_lookahead_map.h"
 
+#if defined(VPR_USE_TBB)
+#    include <tbb/parallel_for.h>
+#endif
+
+#ifdef VTR_ENABLE_CAPNPROTO
+#    include "capnp/serialize.h"
+#    include "map_lookahead.capnp.h"
+#    include "ndmatrix_serdes.h"
+#    include "mmap_file.h"
+#    include "serdes_utils.h"
+#endif /* VTR_ENABLE_CAPNPROTO */
+
 /* the cost map is computed by running a Dijkstra search from channel segment rr nodes at the specified reference coordinate */
 #define REF_X 3
 #define REF_Y 3
@@ -206,6 +220,7 @@ static void fill_in_missing_lookahead_entries(int segment_index, e_rr_type chan_
 static Cost_Entry get_nearby_cost_entry(int x, int y, int segment_index, int chan_index);
 /* returns the absolute delta_x and delta_y offset required to reach to_node from from_node */
 static void get_xy_deltas(const RRNodeId& from_node_ind, const RRNodeId& to_node_ind, int* delta_x, int* delta_y);
+static void get_xy_deltas(const RRNodeId& from_node_ind, int to_x, int to_y, int* delta_x, int* delta_y);
 
 static void print_cost_map();
 
@@ -240,6 +255,37 @@ float get_lookahead_map_cost(const RRNodeId& from_node_ind, const RRNodeId& to_n
     return expected_cost;
 }
 
+/* queries the lookahead_map for the expected costs from each of the CHANX/CHANY nodes of from_nodes to the
+ * specified target, into the corresponding entries of expected_costs (the entries of other nodes are unchanged) */
+void get_lookahead_map_costs(const std::vector<RRNodeId>& from_nodes, const RRNodeId& to_node_ind, float criticality_fac, std::vector<float>& expected_costs) {
+    auto& device_ctx = g_vpr_ctx.device();
+    const RRGraph& rr_graph = device_ctx.rr_graph;
+
+    VTR_ASSERT(expected_costs.size() == from_nodes.size());
+
+    /* the target location is shared by all the nodes */
+    int to_x = rr_graph.node_xlow(to_node_ind);
+    int to_y = rr_graph.node_ylow(to_node_ind);
+
+    for (size_t inode = 0; inode < from_nodes.size(); ++inode) {
+        const RRNodeId& from_node_ind = from_nodes[inode];
+        e_rr_type from_type = rr_graph.node_type(from_node_ind);
+        if (from_type != CHANX && from_type != CHANY) {
+            continue;
+        }
+
+        int from_seg_index = device_ctx.rr_indexed_data[rr_graph.node_cost_index(from_node_ind)].seg_index;
+        VTR_ASSERT(from_seg_index >= 0);
+
+        int delta_x, delta_y;
+        get_xy_deltas(from_node_ind, to_x, to_y, &delta_x, &delta_y);
+
+        int from_chan_index = (from_type == CHANY) ? 1 : 0;
+        const Cost_Entry& cost_entry = f_cost_map[from_chan_index][from_seg_index][abs(delta_x)][abs(delta_y)];
+        expected_costs[inode] = criticality_fac * cost_entry.delay + (1.0 - criticality_fac) * cost_entry.congestion;
+    }
+}
+
 /* Computes the lookahead map to be used by the router. If a map was computed prior to this, a new one will not be computed again.
  * The rr graph must have been built before calling this function. */
 void compute_router_lookahead(int num_segments) {
@@ -253,37 +299,49 @@ void compute_router_lookahead(int num_segments) {
     free_cost_map();
     alloc_cost_map(num_segments);
 
-    /* run Dijkstra's algorithm for each segment type & channel type combination */
-    for (int iseg = 0; iseg < num_segments; iseg++) {
-        for (e_rr_type chan_type : {CHANX, CHANY}) {
-            /* allocate the cost map for this iseg/chan_type */
-            t_routing_cost_map routing_cost_map({device_ctx.grid.width(), device_ctx.grid.height()});
-
-            for (int ref_inc = 0; ref_inc < 3; ref_inc++) {
-                for (int track_offset = 0; track_offset < MAX_TRACK_OFFSET; track_offset += 2) {
-                    /* get the rr node index from which to start routing */
-                    RRNodeId start_node_ind = get_start_node_ind(REF_X + ref_inc, REF_Y + ref_inc,
-                                                            device_ctx.grid.width() - 2, device_ctx.grid.height() - 2, //non-corner upper right
-                                                            chan_type, iseg, track_offset);
-
-                    if (start_node_ind == RRNodeId::INVALID()) {
-                        continue;
-                    }
-
-                    /* run Dijkstra's algorithm */
-                    run_dijkstra(start_node_ind, REF_X + ref_inc, REF_Y + ref_inc, routing_cost_map);
+    /* run Dijkstra's algorithm for each segment type & channel type combination.
+     * Each combination only fills in its own [chan_index][iseg] part of the cost map, and runs its Dijkstra
+     * searches in the same order as serially, so the combinations are computed in parallel (with the same result) */
+    auto compute_segment_cost_map = [&](size_t icombination) {
+        int iseg = icombination / 2;
+        e_rr_type chan_type = (icombination % 2 == 0) ? CHANX : CHANY;
+
+        /* allocate the cost map for this iseg/chan_type */
+        t_routing_cost_map routing_cost_map({device_ctx.grid.width(), device_ctx.grid.height()});
+
+        for (int ref_inc = 0; ref_inc < 3; ref_inc++) {
+            for (int track_offset = 0; track_offset < MAX_TRACK_OFFSET; track_offset += 2) {
+                /* get the rr node index from which to start routing */
+                RRNodeId start_node_ind = get_start_node_ind(REF_X + ref_inc, REF_Y + ref_inc,
+                                                        device_ctx.grid.width() - 2, device_ctx.grid.height() - 2, //non-corner upper right
+                                                        chan_type, iseg, track_offset);
+
+                if (start_node_ind == RRNodeId::INVALID()) {
+                    continue;
                 }
+
+                /* run Dijkstra's algorithm */
+                run_dijkstra(start_node_ind, REF_X + ref_inc, REF_Y + ref_inc, routing_cost_map);
             }
+        }
 
-            /* boil down the cost list in routing_cost_map at each coordinate to a representative cost entry and store it in the lookahead
-             * cost map */
-            set_lookahead_map_costs(iseg, chan_type, routing_cost_map);
+        /* boil down the cost list in routing_cost_map at each coordinate to a representative cost entry and store it in the lookahead
+         * cost map */
+        set_lookahead_map_costs(iseg, chan_type, routing_cost_map);
 
-            /* fill in missing entries in the lookahead cost map by copying the closest cost entries (cost map was computed based on
-             * a reference coordinate > (0,0) so some entries that represent a cross-chip distance have not been computed) */
-            fill_in_missing_lookahead_entries(iseg, chan_type);
-        }
+        /* fill in missing entries in the lookahead cost map by copying the closest cost entries (cost map was computed based on
+         * a reference coordinate > (0,0) so some entries that represent a cross-chip distance have not been computed) */
+        fill_in_missing_lookahead_entries(iseg, chan_type);
+    };
+
+    size_t num_combinations = 2 * size_t(num_segments);
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for(size_t(0), num_combinations, compute_segment_cost_map);
+#else
+    for (size_t icombination = 0; icombination < num_combinations; icombination++) {
+        compute_segment_cost_map(icombination);
     }
+#endif
 
     if (false) print_cost_map();
 }
@@ -599,20 +657,26 @@ Cost_Entry Expansion_Cost_Entry::get_median_entry() {
 /* returns the absolute delta_x and delta_y offset required to reach to_node from from_node */
 static void get_xy_deltas(const RRNodeId& from_node_ind, const RRNodeId& to_node_ind, int* delta_x, int* delta_y) {
     auto& device_ctx = g_vpr_ctx.device();
+    get_xy_deltas(from_node_ind, device_ctx.rr_graph.node_xlow(to_node_ind), device_ctx.rr_graph.node_ylow(to_node_ind), delta_x, delta_y);
+}
+
+/* returns the absolute delta_x and delta_y offset required to reach the location (to_x, to_y) from from_node */
+static void get_xy_deltas(const RRNodeId& from_node_ind, int to_x, int to_y, int* delta_x, int* delta_y) {
+    auto& device_ctx = g_vpr_ctx.device();
 
     /* get chan/seg coordinates of the from/to nodes. seg coordinate is along the wire,
      * chan coordinate is orthogonal to the wire */
     int from_seg_low = device_ctx.rr_graph.node_xlow(from_node_ind);
     int from_seg_high = device_ctx.rr_graph.node_xhigh(from_node_ind);
     int from_chan = device_ctx.rr_graph.node_ylow(from_node_ind);
-    int to_seg = device_ctx.rr_graph.node_xlow(to_node_ind);
-    int to_chan = device_ctx.rr_graph.node_ylow(to_node_ind);
+    int to_seg = to_x;
+    int to_chan = to_y;
     if (device_ctx.rr_graph.node_type(from_node_ind) == CHANY) {
         from_seg_low = device_ctx.rr_graph.node_ylow(from_node_ind);
         from_seg_high = device_ctx.rr_graph.node_yhigh(from_node_ind);
         from_chan = device_ctx.rr_graph.node_xlow(from_node_ind);
-        to_seg = device_ctx.rr_graph.node_ylow(to_node_ind);
-        to_chan = device_ctx.rr_graph.node_xlow(to_node_ind);
+        to_seg = to_y;
+        to_chan = to_x;
     }
 
     /* now we want to count the minimum number of *channel segments* between the from and to nodes */
@@ -676,3 +740,126 @@ static void print_cost_map() {
         }
     }
 }
+
+/* returns a checksum of everything the routing delays and costs are computed from: the device grid,
+ * the rr nodes and edges, the switches and the delay/base cost of each rr node cost index. It stands
+ * for the architecture and the channel width (for both the VPR and the tileable rr graphs), so that
+ * data computed from the rr graph and written to a file is only read back for the same rr graph */
+uint64_t compute_rr_graph_checksum() {
+    auto& device_ctx = g_vpr_ctx.device();
+    const RRGraph& rr_graph = device_ctx.rr_graph;
+
+    uint64_t checksum = vtr::CHECKSUM_INIT;
+
+    vtr::checksum_combine(checksum, device_ctx.grid.width());
+    vtr::checksum_combine(checksum, device_ctx.grid.height());
+
+    vtr::checksum_combine(checksum, device_ctx.rr_indexed_data.size());
+    for (const t_rr_indexed_data& indexed_data : device_ctx.rr_indexed_data) {
+        vtr::checksum_combine(checksum, indexed_data.seg_index);
+        vtr::checksum_combine(checksum, indexed_data.base_cost);
+        vtr::checksum_combine(checksum, indexed_data.T_linear);
+    }
+
+    vtr::checksum_combine(checksum, device_ctx.rr_switch_inf.size());
+    for (const t_rr_switch_inf& rr_switch : device_ctx.rr_switch_inf) {
+        vtr::checksum_combine(checksum, rr_switch.R);
+        vtr::checksum_combine(checksum, rr_switch.Cin);
+        vtr::checksum_combine(checksum, rr_switch.Cout);
+        vtr::checksum_combine(checksum, rr_switch.Cinternal);
+        vtr::checksum_combine(checksum, rr_switch.Tdel);
+        vtr::checksum_combine(checksum, rr_switch.type());
+    }
+
+    vtr::checksum_combine(checksum, rr_graph.nodes().size());
+    for (const RRNodeId& node : rr_graph.nodes()) {
+        t_rr_type node_type = rr_graph.node_type(node);
+        vtr::checksum_combine(checksum, node_type);
+        vtr::checksum_combine(checksum, rr_graph.node_xlow(node));
+        vtr::checksum_combine(checksum, rr_graph.node_ylow(node));
+        vtr::checksum_combine(checksum, rr_graph.node_xhigh(node));
+        vtr::checksum_combine(checksum, rr_graph.node_yhigh(node));
+        vtr::checksum_combine(checksum, rr_graph.node_ptc_num(node));
+        vtr::checksum_combine(checksum, rr_graph.node_cost_index(node));
+        vtr::checksum_combine(checksum, rr_graph.node_R(node));
+        vtr::checksum_combine(checksum, rr_graph.node_C(node));
+        if (node_type == CHANX || node_type == CHANY) {
+            vtr::checksum_combine(checksum, rr_graph.node_direction(node));
+        }
+
+        for (const RREdgeId& edge : rr_graph.node_out_edges(node)) {
+            vtr::checksum_combine(checksum, size_t(rr_graph.edge_sink_node(edge)));
+            vtr::checksum_combine(checksum, size_t(rr_graph.edge_switch(edge)));
+        }
+    }
+
+    return checksum;
+}
+
+// When writing capnp targetted serialization, always allow compilation when
+// VTR_ENABLE_CAPNPROTO=OFF.  Generally this means throwing an exception
+// instead.
+//
+#ifndef VTR_ENABLE_CAPNPROTO
+
+#    define DISABLE_ERROR                              \
+        "is disable because VTR_ENABLE_CAPNPROTO=OFF." \
+        "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable."
+
+void read_router_lookahead(const std::string& /*file*/) {
+    VPR_THROW(VPR_ERROR_ROUTE, "MapLookahead::read " DISABLE_ERROR);
+}
+
+void write_router_lookahead(const std::string& /*file*/) {
+    VPR_THROW(VPR_ERROR_ROUTE, "MapLookahead::write " DISABLE_ERROR);
+}
+
+#else /* VTR_ENABLE_CAPNPROTO */
+
+static void ToCostEntry(Cost_Entry* out, const VprMapCostEntry::Reader& in) {
+    out->delay = in.getDelay();
+    out->congestion = in.getCongestion();
+}
+
+static void FromCostEntry(VprMapCostEntry::Builder* out, const Cost_Entry& in) {
+    out->setDelay(in.delay);
+    out->setCongestion(in.congestion);
+}
+
+void read_router_lookahead(const std::string& file) {
+    vtr::ScopedStartFinishTimer timer("Loading router lookahead map");
+
+    auto& device_ctx = g_vpr_ctx.device();
+
+    MmapFile f(file);
+    ::capnp::FlatArrayMessageReader reader(f.getData());
+    auto map = reader.getRoot<VprMapLookahead>();
+
+    if (map.getRrGraphChecksum() != compute_rr_graph_checksum()) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                        "Router lookahead map '%s' was computed for a different routing resource graph"
+                        " (architecture or channel width)\n",
+                        file.c_str());
+    }
+
+    free_cost_map();
+    ToNdMatrix<4, VprMapCostEntry, Cost_Entry>(&f_cost_map, map.getCostMap(), ToCostEntry);
+
+    VTR_ASSERT(f_cost_map.dim_size(0) == 2);
+    VTR_ASSERT(f_cost_map.dim_size(2) == device_ctx.grid.width());
+    VTR_ASSERT(f_cost_map.dim_size(3) == device_ctx.grid.height());
+}
+
+void write_router_lookahead(const std::string& file) {
+    ::capnp::MallocMessageBuilder builder;
+    auto map = builder.initRoot<VprMapLookahead>();
+
+    map.setRrGraphChecksum(compute_rr_graph_checksum());
+
+    auto cost_map = map.getCostMap();
+    FromNdMatrix<4, VprMapCostEntry, Cost_Entry>(&cost_map, f_cost_map, FromCostEntry);
+
+    writeMessageToFile(file, &builder);
+}
+
+#endif
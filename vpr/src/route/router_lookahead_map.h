@@ -1,9 +1,27 @@
 #pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
 
 /* Computes the lookahead map to be used by the router. If a map was computed prior to this, a new one will not be computed again.
  * The rr graph must have been built before calling this function. */
 void compute_router_lookahead(int num_segments);
 
+/* Reads/writes the lookahead map from/to a file, instead of computing it again for each run.
+ * A lookahead map can only be read for the routing resource graph it was computed for,
+ * i.e. for the same architecture and channel width. Requires VTR_ENABLE_CAPNPROTO. */
+void read_router_lookahead(const std::string& file);
+void write_router_lookahead(const std::string& file);
+
+/* Returns a checksum of the routing resource graph (device grid, rr nodes, edges and switches, and
+ * cost indices), identifying the architecture and channel width that data computed from it was
+ * computed for. The rr graph must have been built before calling this function. */
+uint64_t compute_rr_graph_checksum();
+
 /* queries the lookahead_map (should have been computed prior to routing) to get the expected cost
  * from the specified source to the specified target */
 float get_lookahead_map_cost(const RRNodeId& from_node_ind, const RRNodeId& to_node_ind, float criticality_fac);
+
+/* queries the lookahead_map for the expected costs from each of the CHANX/CHANY nodes of from_nodes to the
+ * specified target, into the corresponding entries of expected_costs (the entries of other nodes are unchanged) */
+void get_lookahead_map_costs(const std::vector<RRNodeId>& from_nodes, const RRNodeId& to_node_ind, float criticality_fac, std::vector<float>& expected_costs);
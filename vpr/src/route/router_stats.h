@@ -1,8 +1,13 @@
 #pragma once
 
+#include <cstddef>
+
 struct RouterStats {
     size_t connections_routed = 0;
     size_t nets_routed = 0;
     size_t heap_pushes = 0;
     size_t heap_pops = 0;
+    size_t nodes_expanded = 0;        //Popped nodes whose neighbours were explored
+    size_t lookahead_evaluations = 0; //Calls to the router lookahead
+    size_t heap_peak_size = 0;        //Maximum number of entries in the heap (not accumulated, but maximized)
 };
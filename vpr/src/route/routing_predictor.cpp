@@ -201,6 +201,24 @@ float RoutingPredictor::estimate_overuse_slope() {
     return slope;
 }
 
+float RoutingPredictor::estimate_overuse_rate() {
+    //Uses the same recent window of history as estimate_overuse_slope()
+    constexpr float FIXED_HISTORY_SIZE = 5; //# of previous iterations to consider
+
+    float rate = std::numeric_limits<float>::quiet_NaN();
+
+    if (iterations_.size() >= FIXED_HISTORY_SIZE) {
+        float history_factor = FIXED_HISTORY_SIZE / iterations_.size();
+        auto model = fit_model(iterations_, iteration_overused_rr_node_counts_, history_factor);
+
+        //The model is fit to the log of the overuse, so its slope is the log of the
+        //ratio of the overuse of consecutive iterations
+        rate = std::exp(model.get_slope()) - 1.;
+    }
+
+    return rate;
+}
+
 void RoutingPredictor::add_iteration_overuse(size_t iteration, size_t overused_rr_node_count) {
     iterations_.push_back(iteration);
     iteration_overused_rr_node_counts_.push_back(overused_rr_node_count);
@@ -23,6 +23,11 @@ class RoutingPredictor {
     //Returns the current estimated slope (RR nodes per iteration)
     float estimate_overuse_slope();
 
+    //Returns the current estimated relative change of the overuse per iteration
+    //(e.g. -0.2 if the overuse falls by 20% each iteration), or NaN if there is
+    //not enough history
+    float estimate_overuse_rate();
+
     void add_iteration_overuse(size_t iteration, size_t overused_rr_node_count);
 
     float get_slope();
@@ -11,6 +11,7 @@
 #include "vtr_math.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
+#include "vtr_parallel.h"
 
 #include "vpr_types.h"
 #include "vpr_utils.h"
@@ -38,12 +39,15 @@
 
 #include "create_rr_graph.h"
 #include "write_xml_rr_graph_obj.h"
+#include "write_binary_rr_graph_obj.h"
+#include "read_binary_rr_graph_obj.h"
 #include "rr_graph_obj_util.h"
 #include "check_rr_graph_obj.h"
 
 #include "tileable_rr_graph_builder.h"
 
 #include "clb2clb_directs.h"
+#include "route_clock_templates.h"
 
 //#define VERBOSE
 
@@ -73,8 +77,6 @@ typedef std::vector<std::map<int, int>> t_arch_switch_fanin;
 /********************* Subroutines local to this module. *******************/
 void print_rr_graph_stats();
 
-bool channel_widths_unchanged(const t_chan_width& current, const t_chan_width& proposed);
-
 static vtr::NdMatrix<std::vector<int>, 4> alloc_and_load_pin_to_track_map(const e_pin_type pin_type,
                                                                           const vtr::Matrix<int>& Fc,
                                                                           const t_physical_tile_type_ptr Type,
@@ -92,7 +94,7 @@ static vtr::NdMatrix<int, 5> alloc_and_load_pin_to_seg_type(const e_pin_type pin
 
 static void advance_to_next_block_side(t_physical_tile_type_ptr Type, int& width_offset, int& height_offset, e_side& side);
 
-static vtr::NdMatrix<std::vector<int>, 4> alloc_and_load_track_to_pin_lookup(vtr::NdMatrix<std::vector<int>, 4> pin_to_track_map,
+static vtr::NdMatrix<std::vector<int>, 4> alloc_and_load_track_to_pin_lookup(const vtr::NdMatrix<std::vector<int>, 4>& pin_to_track_map,
                                                                              const vtr::Matrix<int>& Fc,
                                                                              const int width,
                                                                              const int height,
@@ -301,12 +303,22 @@ void create_rr_graph(const t_graph_type graph_type,
         if (device_ctx.read_rr_graph_filename != det_routing_arch->read_rr_graph_filename) {
             free_rr_graph();
 
-            load_rr_file(graph_type,
-                         grid,
-                         segment_inf,
-                         base_cost_type,
-                         &det_routing_arch->wire_to_rr_ipin_switch,
-                         det_routing_arch->read_rr_graph_filename.c_str());
+            /* Files with a .bin extension are in the binary format, otherwise XML */
+            if (vtr::check_file_name_extension(det_routing_arch->read_rr_graph_filename.c_str(), ".bin")) {
+                load_binary_rr_file(graph_type,
+                                    grid,
+                                    segment_inf,
+                                    base_cost_type,
+                                    &det_routing_arch->wire_to_rr_ipin_switch,
+                                    det_routing_arch->read_rr_graph_filename.c_str());
+            } else {
+                load_rr_file(graph_type,
+                             grid,
+                             segment_inf,
+                             base_cost_type,
+                             &det_routing_arch->wire_to_rr_ipin_switch,
+                             det_routing_arch->read_rr_graph_filename.c_str());
+            }
 
             /* Xifan Tang - Create rr_graph object: load rr_nodes to the object */
             //convert_rr_graph(segment_inf);
@@ -368,6 +380,7 @@ void create_rr_graph(const t_graph_type graph_type,
                                                     &det_routing_arch->wire_to_rr_ipin_switch,
                                                     trim_obs_channels, /* Allow/Prohibit through tracks across multi-height and multi-width grids */
                                                     false, /* Do not allow passing tracks to be wired to the same routing channels */
+                                                    det_routing_arch->rr_graph_cache_dir,
                                                     Warnings);
         }
 
@@ -377,10 +390,19 @@ void create_rr_graph(const t_graph_type graph_type,
 
     process_non_config_sets();
 
+    if (clock_modeling == DEDICATED_NETWORK) {
+        build_clock_route_templates();
+    }
+
     print_rr_graph_stats();
 
     //Write out rr graph file if needed
-    if (!det_routing_arch->write_rr_graph_filename.empty()) {
+    if (!det_routing_arch->write_rr_graph_filename.empty()
+        && vtr::check_file_name_extension(det_routing_arch->write_rr_graph_filename.c_str(), ".bin")) {
+        write_binary_rr_graph_obj(det_routing_arch->write_rr_graph_filename.c_str(),
+                                  device_ctx.rr_graph,
+                                  det_routing_arch->wire_to_rr_ipin_switch);
+    } else if (!det_routing_arch->write_rr_graph_filename.empty()) {
         write_rr_graph(det_routing_arch->write_rr_graph_filename.c_str(), segment_inf);
 
         /* Just to test the writer of rr_graph_obj, give a filename in a fixed style*/
@@ -675,14 +697,15 @@ static void build_rr_graph(const t_graph_type graph_type,
     t_pin_to_track_lookup ipin_to_track_map(types.size());   /* [0..device_ctx.physical_tile_types.size()-1][0..num_pins-1][0..width][0..height][0..3][0..Fc-1] */
     t_track_to_pin_lookup track_to_pin_lookup(types.size()); /* [0..device_ctx.physical_tile_types.size()-1][0..max_chan_width-1][0..width][0..height][0..3] */
 
-    for (unsigned int itype = 0; itype < types.size(); ++itype) {
+    //The lookups of each type are independent, so they are built in parallel
+    vtr::parallel_for(types.size(), [&](size_t itype) {
         ipin_to_track_map[itype] = alloc_and_load_pin_to_track_map(RECEIVER,
                                                                    Fc_in[itype], &types[itype], perturb_ipins[itype], directionality,
                                                                    segment_inf.size(), sets_per_seg_type);
 
         track_to_pin_lookup[itype] = alloc_and_load_track_to_pin_lookup(ipin_to_track_map[itype], Fc_in[itype], types[itype].width, types[itype].height,
                                                                         types[itype].num_pins, max_chan_width, segment_inf.size());
-    }
+    });
     /* END IPIN MAP */
 
     /* START OPIN MAP */
@@ -690,13 +713,13 @@ static void build_rr_graph(const t_graph_type graph_type,
     t_pin_to_track_lookup opin_to_track_map(types.size()); /* [0..device_ctx.physical_tile_types.size()-1][0..num_pins-1][0..width][0..height][0..3][0..Fc-1] */
 
     if (BI_DIRECTIONAL == directionality) {
-        for (unsigned int itype = 0; itype < types.size(); ++itype) {
+        vtr::parallel_for(types.size(), [&](size_t itype) {
             auto perturb_opins = alloc_and_load_perturb_opins(&types[itype], Fc_out[itype],
                                                               max_chan_width, segment_inf);
             opin_to_track_map[itype] = alloc_and_load_pin_to_track_map(DRIVER,
                                                                        Fc_out[itype], &types[itype], perturb_opins, directionality,
                                                                        segment_inf.size(), sets_per_seg_type);
-        }
+        });
     }
     /* END OPIN MAP */
 
@@ -1499,13 +1522,21 @@ void free_rr_graph() {
 
     device_ctx.rr_node_metadata.clear();
 
+    device_ctx.clock_route_templates.clear();
+
     device_ctx.rr_edge_metadata.clear();
 
     invalidate_router_lookahead_cache();
 
+    //The placement delay model is computed on the rr graph
+    g_vpr_ctx.mutable_placement().cached_place_delay_model_.clear();
+
+    device_ctx.rr_graph_architecture_id.clear();
+
     /* Xifan Tang - Clear the rr_graph object */
     device_ctx.rr_graph.clear();
     device_ctx.rr_node_track_ids.clear();
+    device_ctx.rr_gsbs.clear();
 }
 
 static void build_rr_sinks_sources(const int i,
@@ -2558,7 +2589,7 @@ static void check_all_tracks_reach_pins(t_logical_block_type_ptr type,
 /* Allocates and loads the track to ipin lookup for each physical grid type. This
  * is the same information as the ipin_to_track map but accessed in a different way. */
 
-static vtr::NdMatrix<std::vector<int>, 4> alloc_and_load_track_to_pin_lookup(vtr::NdMatrix<std::vector<int>, 4> pin_to_track_map,
+static vtr::NdMatrix<std::vector<int>, 4> alloc_and_load_track_to_pin_lookup(const vtr::NdMatrix<std::vector<int>, 4>& pin_to_track_map,
                                                                              const vtr::Matrix<int>& Fc,
                                                                              const int type_width,
                                                                              const int type_height,
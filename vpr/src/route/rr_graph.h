@@ -43,6 +43,9 @@ void create_rr_graph(const t_graph_type graph_type,
 
 void free_rr_graph();
 
+//Returns true if the proposed channel widths are the same as the current ones
+bool channel_widths_unchanged(const t_chan_width& current, const t_chan_width& proposed);
+
 //Returns a brief one-line summary of an RR node
 std::string describe_rr_node(const RRNodeId& inode);
 
@@ -288,6 +288,13 @@ void process_seg_id(pugi::xml_node parent, const pugiutil::loc_data& loc_data) {
 
         segmentSubnode = get_single_child(rr_node, "segment", loc_data, pugiutil::OPTIONAL);
         if (segmentSubnode) {
+            /* The cost index of a track depends on the segment id of the file */
+            short cost_index = device_ctx.rr_graph.node_cost_index(node);
+            if ((0 > cost_index) || (size_t(cost_index) >= device_ctx.rr_indexed_data.size())) {
+                vpr_throw(VPR_ERROR_ROUTE, loc_data.filename_c_str(), loc_data.line(rr_node),
+                          "Invalid cost index %d of node %d, which should be in [0, %lu)\n",
+                          cost_index, id, device_ctx.rr_indexed_data.size());
+            }
             attribute = get_attribute(segmentSubnode, "segment_id", loc_data, pugiutil::OPTIONAL);
             if (attribute) {
                 int seg_id = get_attribute(segmentSubnode, "segment_id", loc_data).as_int(0);
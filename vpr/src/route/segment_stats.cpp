@@ -1,7 +1,10 @@
+#include <algorithm>
 #include <cstdio>
+#include <vector>
 
 #include "vtr_log.h"
 #include "vtr_memory.h"
+#include "vtr_parallel.h"
 
 #include "vpr_types.h"
 #include "globals.h"
@@ -20,7 +23,7 @@ void get_segment_usage_stats(std::vector<t_segment_inf>& segment_inf) {
      * are counted as full-length segments (e.g. length 4 even if the last 2    *
      * units of wire were chopped off by the chip edge).                        */
 
-    int length, max_segment_length, cost_index;
+    int length, max_segment_length;
     int *seg_occ_by_length, *seg_cap_by_length; /* [0..max_segment_length] */
     int *seg_occ_by_type, *seg_cap_by_type;     /* [0..num_segment-1]      */
     float utilization;
@@ -43,20 +46,51 @@ void get_segment_usage_stats(std::vector<t_segment_inf>& segment_inf) {
     seg_occ_by_type = (int*)vtr::calloc(segment_inf.size(), sizeof(int));
     seg_cap_by_type = (int*)vtr::calloc(segment_inf.size(), sizeof(int));
 
-    for (const RRNodeId& inode : device_ctx.rr_graph.nodes()) {
-        if (device_ctx.rr_graph.node_type(inode) == CHANX || device_ctx.rr_graph.node_type(inode) == CHANY) {
-            cost_index = device_ctx.rr_graph.node_cost_index(inode);
-            size_t seg_type = device_ctx.rr_indexed_data[cost_index].seg_index;
-
-            if (!segment_inf[seg_type].longline)
-                length = segment_inf[seg_type].length;
-            else
-                length = LONGLINE;
+    /* The nodes are visited in parallel blocks, each of which accumulates its own *
+     * counts, which are then added up in the order of the blocks.                 */
+    constexpr size_t NODES_PER_BLOCK = 16384;
+    size_t num_nodes = device_ctx.rr_graph.nodes().size();
+    size_t num_blocks = (num_nodes + NODES_PER_BLOCK - 1) / NODES_PER_BLOCK;
+    size_t num_counts = 2 * (max_segment_length + 1) + 2 * segment_inf.size();
+    std::vector<std::vector<int>> block_counts(num_blocks);
+
+    vtr::parallel_for(num_blocks, [&](size_t iblock) {
+        std::vector<int>& counts = block_counts[iblock];
+        counts.resize(num_counts, 0);
+        int* block_occ_by_length = counts.data();
+        int* block_cap_by_length = block_occ_by_length + (max_segment_length + 1);
+        int* block_occ_by_type = block_cap_by_length + (max_segment_length + 1);
+        int* block_cap_by_type = block_occ_by_type + segment_inf.size();
+
+        size_t end = std::min((iblock + 1) * NODES_PER_BLOCK, num_nodes);
+        for (size_t node = iblock * NODES_PER_BLOCK; node < end; ++node) {
+            const RRNodeId inode(node);
+            if (device_ctx.rr_graph.node_type(inode) == CHANX || device_ctx.rr_graph.node_type(inode) == CHANY) {
+                int node_cost_index = device_ctx.rr_graph.node_cost_index(inode);
+                size_t seg_type = device_ctx.rr_indexed_data[node_cost_index].seg_index;
+
+                int node_length;
+                if (!segment_inf[seg_type].longline)
+                    node_length = segment_inf[seg_type].length;
+                else
+                    node_length = LONGLINE;
+
+                block_occ_by_length[node_length] += route_ctx.rr_node_route_inf[inode].occ();
+                block_cap_by_length[node_length] += device_ctx.rr_graph.node_capacity(inode);
+                block_occ_by_type[seg_type] += route_ctx.rr_node_route_inf[inode].occ();
+                block_cap_by_type[seg_type] += device_ctx.rr_graph.node_capacity(inode);
+            }
+        }
+    });
 
-            seg_occ_by_length[length] += route_ctx.rr_node_route_inf[inode].occ();
-            seg_cap_by_length[length] += device_ctx.rr_graph.node_capacity(inode);
-            seg_occ_by_type[seg_type] += route_ctx.rr_node_route_inf[inode].occ();
-            seg_cap_by_type[seg_type] += device_ctx.rr_graph.node_capacity(inode);
+    for (const std::vector<int>& counts : block_counts) {
+        for (length = 0; length <= max_segment_length; ++length) {
+            seg_occ_by_length[length] += counts[length];
+            seg_cap_by_length[length] += counts[(max_segment_length + 1) + length];
+        }
+        for (size_t seg_type = 0; seg_type < segment_inf.size(); ++seg_type) {
+            seg_occ_by_type[seg_type] += counts[2 * (max_segment_length + 1) + seg_type];
+            seg_cap_by_type[seg_type] += counts[2 * (max_segment_length + 1) + segment_inf.size() + seg_type];
         }
     }
 
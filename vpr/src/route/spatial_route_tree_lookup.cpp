@@ -2,6 +2,8 @@
 
 #include "globals.h"
 
+static float typical_wire_length();
+
 SpatialRouteTreeLookup build_route_tree_spatial_lookup(ClusterNetId net, t_rt_node* rt_root) {
     constexpr float BIN_AREA_PER_SINK_FACTOR = 4;
 
@@ -16,7 +18,9 @@ SpatialRouteTreeLookup build_route_tree_spatial_lookup(ClusterNetId net, t_rt_no
     float bb_area_per_sink = bb_area / fanout;
     float bin_area = BIN_AREA_PER_SINK_FACTOR * bb_area_per_sink;
 
-    float bin_dim = std::ceil(std::sqrt(bin_area));
+    //Bins smaller than the wires would mostly hold the wires passing through them, rather than
+    //the routing close to the sinks (e.g. for a global net spanning the whole device)
+    float bin_dim = std::ceil(std::max<float>(std::sqrt(bin_area), typical_wire_length()));
 
     size_t bins_x = std::ceil(device_ctx.grid.width() / bin_dim);
     size_t bins_y = std::ceil(device_ctx.grid.height() / bin_dim);
@@ -37,17 +41,12 @@ void update_route_tree_spatial_lookup_recur(t_rt_node* rt_node, SpatialRouteTree
     int bin_xhigh = grid_to_bin_x(device_ctx.rr_graph.node_xhigh(rt_node->inode), spatial_lookup);
     int bin_yhigh = grid_to_bin_y(device_ctx.rr_graph.node_yhigh(rt_node->inode), spatial_lookup);
 
-    spatial_lookup[bin_xlow][bin_ylow].push_back(rt_node);
-
-    //We current look at the start/end locations of the RR nodes and add the node
-    //to both bins if they are different
-    //
-    //TODO: Depending on bin size, long wires may end up being added only to bins at
-    //      their start/end and may pass through bins along their length to which they
-    //      are not added. If this becomes an issues, reconsider how we add nodes to
-    //      bins
-    if (bin_xhigh != bin_xlow || bin_yhigh != bin_ylow) {
-        spatial_lookup[bin_xhigh][bin_yhigh].push_back(rt_node);
+    //The node is added to all the bins it spans, so that long wires are also found
+    //in the bins they pass through
+    for (int bin_x = bin_xlow; bin_x <= bin_xhigh; ++bin_x) {
+        for (int bin_y = bin_ylow; bin_y <= bin_yhigh; ++bin_y) {
+            spatial_lookup[bin_x][bin_y].push_back(rt_node);
+        }
     }
 
     //Recurse
@@ -84,18 +83,18 @@ bool validate_route_tree_spatial_lookup(t_rt_node* rt_node, const SpatialRouteTr
 
     bool valid = true;
 
-    auto& low_bin_rt_nodes = spatial_lookup[bin_xlow][bin_ylow];
-    if (std::find(low_bin_rt_nodes.begin(), low_bin_rt_nodes.end(), rt_node) == low_bin_rt_nodes.end()) {
-        valid = false;
-        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Failed to find route tree node %ld at (low coord %d,%d) in spatial lookup [bin %d,%d]",
-                        size_t(rt_node->inode), device_ctx.rr_graph.node_xlow(rr_node), device_ctx.rr_graph.node_ylow(rr_node), bin_xlow, bin_ylow);
-    }
-
-    auto& high_bin_rt_nodes = spatial_lookup[bin_xhigh][bin_yhigh];
-    if (std::find(high_bin_rt_nodes.begin(), high_bin_rt_nodes.end(), rt_node) == high_bin_rt_nodes.end()) {
-        valid = false;
-        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Failed to find route tree node %ld at (high coord %d,%d) in spatial lookup [bin %d,%d]",
-                        size_t(rt_node->inode), device_ctx.rr_graph.node_xhigh(rr_node), device_ctx.rr_graph.node_yhigh(rr_node), bin_xhigh, bin_yhigh);
+    for (int bin_x = bin_xlow; bin_x <= bin_xhigh; ++bin_x) {
+        for (int bin_y = bin_ylow; bin_y <= bin_yhigh; ++bin_y) {
+            auto& bin_rt_nodes = spatial_lookup[bin_x][bin_y];
+            if (std::find(bin_rt_nodes.begin(), bin_rt_nodes.end(), rt_node) == bin_rt_nodes.end()) {
+                valid = false;
+                VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Failed to find route tree node %ld spanning (%d,%d) to (%d,%d) in spatial lookup [bin %d,%d]",
+                                size_t(rt_node->inode),
+                                device_ctx.rr_graph.node_xlow(rr_node), device_ctx.rr_graph.node_ylow(rr_node),
+                                device_ctx.rr_graph.node_xhigh(rr_node), device_ctx.rr_graph.node_yhigh(rr_node),
+                                bin_x, bin_y);
+            }
+        }
     }
 
     //Recurse
@@ -105,3 +104,25 @@ bool validate_route_tree_spatial_lookup(t_rt_node* rt_node, const SpatialRouteTr
 
     return valid;
 }
+
+//Returns the length of the routing wires, averaged over the tracks of the channels
+//(long lines count as spanning the device)
+static float typical_wire_length() {
+    auto& device_ctx = g_vpr_ctx.device();
+    if (device_ctx.arch == nullptr) {
+        return 1.;
+    }
+
+    float total_length = 0.;
+    float total_frequency = 0.;
+    for (const t_segment_inf& segment : device_ctx.arch->Segments) {
+        int length = segment.longline ? std::max(device_ctx.grid.width(), device_ctx.grid.height()) : segment.length;
+        total_length += float(segment.frequency) * length;
+        total_frequency += segment.frequency;
+    }
+    if (total_frequency <= 0.) {
+        return 1.;
+    }
+
+    return total_length / total_frequency;
+}
@@ -3,6 +3,7 @@
  ***********************************************************************/
 #include "vtr_log.h"
 #include "vtr_assert.h"
+#include "vtr_hash.h"
 #include "rr_chan.h"
 
 /* namespace openfpga begins */
@@ -105,6 +106,23 @@ bool RRChan::is_mirror(const RRGraph& rr_graph, const RRChan& cand) const {
   return true;
 }
 
+/* Compute a hash value from the same elements as is_mirror() checks
+ * Two RRChan mirrors are guaranteed to have the same fingerprint,
+ * while the reverse is not true: a match must be confirmed by is_mirror()
+ */
+size_t RRChan::get_fingerprint(const RRGraph& rr_graph) const {
+  size_t fingerprint = 0;
+  vtr::hash_combine(fingerprint, size_t(this->get_type()));
+  vtr::hash_combine(fingerprint, this->get_chan_width());
+  for (size_t inode = 0; inode < this->get_chan_width(); ++inode) {
+    vtr::hash_combine(fingerprint, size_t(rr_graph.node_type(this->get_node(inode))));
+    vtr::hash_combine(fingerprint, size_t(rr_graph.node_direction(this->get_node(inode))));
+    vtr::hash_combine(fingerprint, size_t(this->get_node_segment(inode)));
+  }
+
+  return fingerprint;
+}
+
 /* Get a list of segments used in this routing channel */
 std::vector<RRSegmentId> RRChan::get_segment_ids() const { 
   std::vector<RRSegmentId> seg_list;
@@ -53,6 +53,7 @@ class RRChan {
     RRSegmentId get_node_segment(const RRNodeId& node) const;
     RRSegmentId get_node_segment(const size_t& track_num) const;
     bool is_mirror(const RRGraph& rr_graph, const RRChan& cand) const; /* evaluate if two RR_chan is mirror to each other */
+    size_t get_fingerprint(const RRGraph& rr_graph) const; /* get a hash value which is the same for two RR_chan mirrors */
     std::vector<RRSegmentId> get_segment_ids() const; /* Get a list of segments used in this routing channel */
     std::vector<size_t> get_node_ids_by_segment_ids(const RRSegmentId& seg_id) const; /* Get a list of segments used in this routing channel */
   public: /* Mutators */
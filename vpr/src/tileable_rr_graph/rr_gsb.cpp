@@ -1,9 +1,12 @@
 /************************************************************************
  * Member functions for class RRGSB
  ***********************************************************************/
+#include <algorithm>
+
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
+#include "vtr_hash.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_side_manager.h"
@@ -19,13 +22,18 @@ namespace openfpga {
  * Constructors
  ***********************************************************************/
 /* Constructor for an empty object */
-RRGSB::RRGSB(bool enable_gsb_routing) {
+RRGSB::RRGSB(bool enable_gsb_routing): enable_gsb_routing_(enable_gsb_routing) {
   /* Set a clean start! */
   coordinate_.set(0, 0);
 
+  frozen_storage_ = nullptr;
+  frozen_side_begin_ = 0;
+  frozen_num_sides_ = 0;
+
   chan_node_.clear();
   chan_node_direction_.clear();
   chan_node_in_edges_.clear();
+  chan_node_in_edge_offsets_.clear();
 
   ipin_node_.clear();
 
@@ -33,7 +41,7 @@ RRGSB::RRGSB(bool enable_gsb_routing) {
 }
 
 /* Copy constructor */
-RRGSB::RRGSB(const RRGSB& src) {
+RRGSB::RRGSB(const RRGSB& src): enable_gsb_routing_(src.enable_gsb_routing_) {
   /* Copy coordinate */
   this->set(src);
   return;
@@ -45,6 +53,9 @@ RRGSB::RRGSB(const RRGSB& src) {
 /* Get the number of sides of this SB */
 size_t RRGSB::get_num_sides() const {
   VTR_ASSERT (validate_num_sides());
+  if (true == is_frozen()) {
+    return frozen_num_sides_;
+  }
   return chan_node_direction_.size();
 }
 
@@ -52,6 +63,10 @@ size_t RRGSB::get_num_sides() const {
 size_t RRGSB::get_chan_width(const e_side& side) const {
   SideManager side_manager(side);
   VTR_ASSERT(side_manager.validate());
+  if (true == is_frozen()) {
+    const RRGSBStorage::t_side& frozen_side = get_frozen_side(side);
+    return frozen_side.chan_node_end - frozen_side.chan_node_begin;
+  }
   return chan_node_[side_manager.to_size_t()].get_chan_width(); 
 }
 
@@ -59,6 +74,9 @@ size_t RRGSB::get_chan_width(const e_side& side) const {
 t_rr_type RRGSB::get_chan_type(const e_side& side) const {
   SideManager side_manager(side);
   VTR_ASSERT(side_manager.validate());
+  if (true == is_frozen()) {
+    return get_frozen_side(side).chan_type;
+  }
   return chan_node_[side_manager.to_size_t()].get_type(); 
 }
 
@@ -113,7 +131,10 @@ enum PORTS RRGSB::get_chan_node_direction(const e_side& side, const size_t& trac
 
   /* Ensure the track is valid in the context of this switch block at a specific side */ 
   VTR_ASSERT( validate_track_id(side, track_id) );
-  
+
+  if (true == is_frozen()) {
+    return frozen_storage_->chan_node_directions[get_frozen_side(side).chan_node_begin + track_id];
+  }
   return chan_node_direction_[side_manager.to_size_t()][track_id]; 
 }
 
@@ -125,13 +146,35 @@ std::vector<RRSegmentId> RRGSB::get_chan_segment_ids(const e_side& side) const {
   /* Ensure the side is valid in the context of this switch block */ 
   VTR_ASSERT( validate_side(side) );
 
-  return chan_node_[side_manager.to_size_t()].get_segment_ids(); 
+  if (false == is_frozen()) {
+    return chan_node_[side_manager.to_size_t()].get_segment_ids(); 
+  }
+
+  /* Same as RRChan::get_segment_ids(): segments in the order of their first track */
+  std::vector<RRSegmentId> seg_list;
+  for (size_t itrack = 0; itrack < get_chan_width(side); ++itrack) {
+    RRSegmentId seg_id = get_chan_node_segment(side, itrack);
+    if (seg_list.end() == std::find(seg_list.begin(), seg_list.end(), seg_id)) {
+      seg_list.push_back(seg_id);
+    }
+  }
+  return seg_list;
 }
 
 /* Get a list of rr_nodes whose sed_id is specified */
 std::vector<size_t> RRGSB::get_chan_node_ids_by_segment_ids(const e_side& side,
                                                               const RRSegmentId& seg_id) const {
-  return chan_node_[size_t(side)].get_node_ids_by_segment_ids(seg_id);
+  if (false == is_frozen()) {
+    return chan_node_[size_t(side)].get_node_ids_by_segment_ids(seg_id);
+  }
+
+  std::vector<size_t> node_list;
+  for (size_t itrack = 0; itrack < get_chan_width(side); ++itrack) {
+    if (seg_id == get_chan_node_segment(side, itrack)) {
+      node_list.push_back(itrack);
+    }
+  }
+  return node_list;
 } 
 
 /* get a rr_node at a given side and track_id */
@@ -144,13 +187,16 @@ RRNodeId RRGSB::get_chan_node(const e_side& side, const size_t& track_id) const
 
   /* Ensure the track is valid in the context of this switch block at a specific side */ 
   VTR_ASSERT( validate_track_id(side, track_id) );
-  
+
+  if (true == is_frozen()) {
+    return frozen_storage_->chan_nodes[get_frozen_side(side).chan_node_begin + track_id];
+  }
   return chan_node_[side_manager.to_size_t()].get_node(track_id); 
 } 
 
-std::vector<RREdgeId> RRGSB::get_chan_node_in_edges(const RRGraph& rr_graph, 
-                                                    const e_side& side,
-                                                    const size_t& track_id) const {
+RRGraph::edge_range RRGSB::get_chan_node_in_edges(const RRGraph& rr_graph, 
+                                                  const e_side& side,
+                                                  const size_t& track_id) const {
   SideManager side_manager(side);
   VTR_ASSERT(side_manager.validate());
  
@@ -164,18 +210,13 @@ std::vector<RREdgeId> RRGSB::get_chan_node_in_edges(const RRGraph& rr_graph,
   VTR_ASSERT(OUT_PORT == get_chan_node_direction(side, track_id));
 
   /* if sorted, we give sorted edges
-   * if not sorted, we give the empty vector
+   * if not sorted, we give the edges in the rr_graph
    */
-  if (0 == chan_node_in_edges_.size()) {
-    std::vector<RREdgeId> unsorted_edges;
-    for (const RREdgeId& edge : rr_graph.node_in_edges(get_chan_node(side, track_id))) {
-      unsorted_edges.push_back(edge);
-    }
-
-    return unsorted_edges;
+  if (false == is_chan_node_in_edges_sorted()) {
+    return rr_graph.node_in_edges(get_chan_node(side, track_id));
   } 
 
-  return chan_node_in_edges_[side_manager.to_size_t()][track_id];
+  return get_sorted_chan_node_in_edges(side, track_id);
 }
 
 /* get the segment id of a channel rr_node */
@@ -188,7 +229,10 @@ RRSegmentId RRGSB::get_chan_node_segment(const e_side& side, const size_t& track
 
   /* Ensure the track is valid in the context of this switch block at a specific side */ 
   VTR_ASSERT( validate_track_id(side, track_id) );
-  
+
+  if (true == is_frozen()) {
+    return frozen_storage_->chan_node_segments[get_frozen_side(side).chan_node_begin + track_id];
+  }
   return chan_node_[side_manager.to_size_t()].get_node_segment(track_id); 
 } 
 
@@ -196,6 +240,10 @@ RRSegmentId RRGSB::get_chan_node_segment(const e_side& side, const size_t& track
 size_t RRGSB::get_num_ipin_nodes(const e_side& side) const {
   SideManager side_manager(side);
   VTR_ASSERT(side_manager.validate());
+  if (true == is_frozen()) {
+    const RRGSBStorage::t_side& frozen_side = get_frozen_side(side);
+    return frozen_side.ipin_node_end - frozen_side.ipin_node_begin;
+  }
   return ipin_node_[side_manager.to_size_t()].size(); 
 } 
 
@@ -209,7 +257,10 @@ RRNodeId RRGSB::get_ipin_node(const e_side& side, const size_t& node_id) const {
 
   /* Ensure the track is valid in the context of this switch block at a specific side */ 
   VTR_ASSERT( validate_ipin_node_id(side, node_id) );
-  
+
+  if (true == is_frozen()) {
+    return frozen_storage_->pin_nodes[get_frozen_side(side).ipin_node_begin + node_id];
+  }
   return ipin_node_[side_manager.to_size_t()][node_id]; 
 } 
 
@@ -217,6 +268,10 @@ RRNodeId RRGSB::get_ipin_node(const e_side& side, const size_t& node_id) const {
 size_t RRGSB::get_num_opin_nodes(const e_side& side) const {
   SideManager side_manager(side);
   VTR_ASSERT(side_manager.validate());
+  if (true == is_frozen()) {
+    const RRGSBStorage::t_side& frozen_side = get_frozen_side(side);
+    return frozen_side.opin_node_end - frozen_side.opin_node_begin;
+  }
   return opin_node_[side_manager.to_size_t()].size(); 
 } 
 
@@ -230,7 +285,10 @@ RRNodeId RRGSB::get_opin_node(const e_side& side, const size_t& node_id) const {
 
   /* Ensure the track is valid in the context of this switch block at a specific side */ 
   VTR_ASSERT(validate_opin_node_id(side, node_id) );
-  
+
+  if (true == is_frozen()) {
+    return frozen_storage_->pin_nodes[get_frozen_side(side).opin_node_begin + node_id];
+  }
   return opin_node_[side_manager.to_size_t()][node_id]; 
 } 
 
@@ -243,7 +301,22 @@ int RRGSB::get_cb_chan_node_index(const t_rr_type& cb_type, const RRNodeId& node
 /* Get the node index in the array, return -1 if not found */
 int RRGSB::get_chan_node_index(const e_side& node_side, const RRNodeId& node) const {
   VTR_ASSERT (validate_side(node_side));
-  return chan_node_[size_t(node_side)].get_node_track_id(node); 
+  if (false == is_frozen()) {
+    return chan_node_[size_t(node_side)].get_node_track_id(node); 
+  }
+
+  /* Same as RRChan::get_node_track_id() */
+  if (RRNodeId::INVALID() == node) {
+    return -1;
+  }
+  const RRGSBStorage::t_side& frozen_side = get_frozen_side(node_side);
+  const RRNodeId* first_node = frozen_storage_->chan_nodes.data() + frozen_side.chan_node_begin;
+  const RRNodeId* last_node = frozen_storage_->chan_nodes.data() + frozen_side.chan_node_end;
+  const RRNodeId* it = std::find(first_node, last_node, node);
+  if (last_node == it) {
+    return -1;
+  }
+  return it - first_node;
 }
 
 /* Get the node index in the array, return -1 if not found */
@@ -262,9 +335,9 @@ int RRGSB::get_node_index(const RRGraph& rr_graph,
   case CHANX:
   case CHANY:
     for (size_t inode = 0; inode < get_chan_width(node_side); ++inode){
-      if ((node == chan_node_[size_t(node_side)].get_node(inode))
+      if ((node == get_chan_node(node_side, inode))
         /* Check if direction meets specification */
-        &&(node_direction == chan_node_direction_[size_t(node_side)][inode])) {
+        &&(node_direction == get_chan_node_direction(node_side, inode))) {
         cnt++;
         ret = inode;
         break;
@@ -273,7 +346,7 @@ int RRGSB::get_node_index(const RRGraph& rr_graph,
     break;
   case IPIN:
     for (size_t inode = 0; inode < get_num_ipin_nodes(node_side); ++inode) {
-      if (node == ipin_node_[size_t(node_side)][inode]) {
+      if (node == get_ipin_node(node_side, inode)) {
         cnt++;
         ret = inode;
         break;
@@ -282,7 +355,7 @@ int RRGSB::get_node_index(const RRGraph& rr_graph,
     break;
   case OPIN:
     for (size_t inode = 0; inode < get_num_opin_nodes(node_side); ++inode) {
-      if (node == opin_node_[size_t(node_side)][inode]) {
+      if (node == get_opin_node(node_side, inode)) {
         cnt++;
         ret = inode;
         break;
@@ -369,6 +442,11 @@ bool RRGSB::is_sb_node_exist_opposite_side(const RRGraph& rr_graph,
   return (-1 != index);
 }
 
+/* Identify if the GSB reads its nodes and edges from a shared storage */
+bool RRGSB::is_frozen() const {
+  return (nullptr != frozen_storage_);
+}
+
 /* check if the candidate CB is a mirror of the current one */
 bool RRGSB::is_cb_mirror(const RRGraph& rr_graph, const RRGSB& cand, const t_rr_type& cb_type) const { 
   /* Check if channel width is the same */
@@ -379,7 +457,7 @@ bool RRGSB::is_cb_mirror(const RRGraph& rr_graph, const RRGSB& cand, const t_rr_
   enum e_side chan_side = get_cb_chan_side(cb_type);
 
   /* check the numbers/directionality of channel rr_nodes */
-  if ( false == chan_node_[size_t(chan_side)].is_mirror(rr_graph, cand.chan_node_[size_t(chan_side)]) ) {
+  if ( false == is_chan_mirror(rr_graph, cand, chan_side) ) {
      return false;
   }
 
@@ -572,7 +650,7 @@ bool RRGSB::is_sb_side_segment_mirror(const RRGraph& rr_graph, const RRGSB& cand
 bool RRGSB::is_sb_side_mirror(const RRGraph& rr_graph, const RRGSB& cand, const e_side& side) const {
 
   /* get a list of segments */
-  std::vector<RRSegmentId> seg_ids = chan_node_[size_t(side)].get_segment_ids();
+  std::vector<RRSegmentId> seg_ids = get_chan_segment_ids(side);
 
   for (size_t iseg = 0; iseg < seg_ids.size(); ++iseg) {
     if (false == is_sb_side_segment_mirror(rr_graph, cand, side, seg_ids[iseg])) {
@@ -601,6 +679,66 @@ bool RRGSB::is_sb_mirror(const RRGraph& rr_graph, const RRGSB& cand) const {
   return true;
 }
 
+/* Get a structural fingerprint of the SB
+ * The fingerprint covers exactly what is_sb_mirror() compares:
+ * 1. Number of sides
+ * For each side owning routing tracks:
+ * 2. Channel width
+ * 3. Number of opin/ipin rr_nodes 
+ * 4. Directionality of each channel rr_node and the drivers of each output track
+ * Note that the number of opin/ipin rr_nodes on a side without routing tracks 
+ * is not considered by is_sb_mirror(), so it cannot be part of the fingerprint here
+ */
+size_t RRGSB::get_sb_fingerprint(const RRGraph& rr_graph) const {
+  size_t fingerprint = 0;
+  vtr::hash_combine(fingerprint, get_num_sides());
+
+  for (size_t side = 0; side < get_num_sides(); ++side) {
+    SideManager side_manager(side);
+    if (0 == get_chan_width(side_manager.get_side())) {
+      continue;
+    }
+    vtr::hash_combine(fingerprint, side);
+    vtr::hash_combine(fingerprint, get_chan_width(side_manager.get_side()));
+    vtr::hash_combine(fingerprint, get_num_opin_nodes(side_manager.get_side()));
+    vtr::hash_combine(fingerprint, get_num_ipin_nodes(side_manager.get_side()));
+    for (size_t itrack = 0; itrack < get_chan_width(side_manager.get_side()); ++itrack) {
+      vtr::hash_combine(fingerprint, size_t(get_chan_node_direction(side_manager.get_side(), itrack)));
+      /* For OUT_PORT rr_node, we need to consider fan-in */
+      if (OUT_PORT != get_chan_node_direction(side_manager.get_side(), itrack)) {
+        continue;
+      }
+      vtr::hash_combine(fingerprint, get_sb_node_fingerprint(rr_graph, side_manager.get_side(), itrack));
+    }
+  }
+
+  return fingerprint;
+}
+
+/* Get a structural fingerprint of the X/Y-direction CB
+ * The fingerprint covers exactly what is_cb_mirror() compares:
+ * 1. The routing channel of the CB 
+ * 2. Number of ipin rr_nodes on each side of the CB
+ * 3. The drivers of each ipin rr_node
+ */
+size_t RRGSB::get_cb_fingerprint(const RRGraph& rr_graph, const t_rr_type& cb_type) const {
+  size_t fingerprint = 0;
+  vtr::hash_combine(fingerprint, get_cb_chan_width(cb_type));
+
+  enum e_side chan_side = get_cb_chan_side(cb_type);
+  vtr::hash_combine(fingerprint, get_chan_fingerprint(rr_graph, chan_side));
+
+  std::vector<enum e_side> ipin_side = get_cb_ipin_sides(cb_type);
+  for (size_t side = 0; side < ipin_side.size(); ++side) {
+    vtr::hash_combine(fingerprint, get_num_ipin_nodes(ipin_side[side]));
+    for (size_t inode = 0; inode < get_num_ipin_nodes(ipin_side[side]); ++inode) {
+      vtr::hash_combine(fingerprint, get_cb_node_fingerprint(rr_graph, cb_type, ipin_side[side], inode));
+    }
+  }
+
+  return fingerprint;
+}
+
 /* Public Accessors: Cooridinator conversion */
 
 /* get the x coordinate of this GSB */
@@ -745,9 +883,25 @@ vtr::Point<size_t> RRGSB::get_grid_coordinate() const {
  ***********************************************************************/
 /* get a copy from a source */
 void RRGSB::set(const RRGSB& src) { 
+  enable_gsb_routing_ = src.enable_gsb_routing_;
+
   /* Copy coordinate */
   this->set_coordinate(src.get_sb_coordinate().x(), src.get_sb_coordinate().y());
 
+  /* A copy of a frozen GSB shares its storage */
+  this->frozen_storage_ = src.frozen_storage_;
+  this->frozen_side_begin_ = src.frozen_side_begin_;
+  this->frozen_num_sides_ = src.frozen_num_sides_;
+  if (true == src.is_frozen()) {
+    this->chan_node_.clear();
+    this->chan_node_direction_.clear();
+    this->ipin_node_.clear();
+    this->opin_node_.clear();
+    this->chan_node_in_edges_.clear();
+    this->chan_node_in_edge_offsets_.clear();
+    return;
+  }
+
   /* Initialize sides */ 
   this->init_num_sides(src.get_num_sides());
 
@@ -777,6 +931,10 @@ void RRGSB::set(const RRGSB& src) {
       this->ipin_node_[side_manager.get_side()].push_back(src.get_ipin_node(side_manager.get_side(), inode));
     }
   }
+
+  /* Copy sorted edges */
+  this->chan_node_in_edges_ = src.chan_node_in_edges_;
+  this->chan_node_in_edge_offsets_ = src.chan_node_in_edge_offsets_;
 }
 
 /* Set the coordinate (x,y) for the switch block */
@@ -786,6 +944,7 @@ void RRGSB::set_coordinate(const size_t& x, const size_t& y) {
 
 /* Allocate the vectors with the given number of sides */
 void RRGSB::init_num_sides(const size_t& num_sides) {
+  VTR_ASSERT(false == is_frozen());
   /* Initialize the vectors */
   chan_node_.resize(num_sides);
   chan_node_direction_.resize(num_sides);
@@ -804,6 +963,7 @@ void RRGSB::add_chan_node(const e_side& node_side,
                           const RRChan& rr_chan,
                           const std::vector<enum PORTS>& rr_chan_dir) {
   /* Validate: 1. side is valid, the type of node is valid */
+  VTR_ASSERT(false == is_frozen());
   VTR_ASSERT(validate_side(node_side));
 
   /* fill the dedicated element in the vector */
@@ -816,6 +976,7 @@ void RRGSB::add_chan_node(const e_side& node_side,
 
 /* Add a node to the chan_node_ list and also assign its direction in chan_node_direction_ */
 void RRGSB::add_ipin_node(const RRNodeId& node, const e_side& node_side) {
+  VTR_ASSERT(false == is_frozen());
   VTR_ASSERT(validate_side(node_side));
   /* push pack the dedicated element in the vector */
   ipin_node_[size_t(node_side)].push_back(node);
@@ -823,6 +984,7 @@ void RRGSB::add_ipin_node(const RRNodeId& node, const e_side& node_side) {
 
 /* Add a node to the chan_node_ list and also assign its direction in chan_node_direction_ */
 void RRGSB::add_opin_node(const RRNodeId& node, const e_side& node_side) {
+  VTR_ASSERT(false == is_frozen());
   VTR_ASSERT(validate_side(node_side));
   /* push pack the dedicated element in the vector */
   opin_node_[size_t(node_side)].push_back(node);
@@ -830,24 +992,24 @@ void RRGSB::add_opin_node(const RRNodeId& node, const e_side& node_side) {
 
 void RRGSB::sort_chan_node_in_edges(const RRGraph& rr_graph,
                                     const e_side& chan_side,
-                                    const size_t& track_id) {
-  std::map<size_t, std::map<size_t, RREdgeId>> from_grid_edge_map;
-  std::map<size_t, std::map<size_t, RREdgeId>> from_track_edge_map;
-  std::map<size_t, std::map<size_t, RREdgeId>> from_gsb_edge_map;
-
+                                    const size_t& track_id,
+                                    const std::vector<size_t>& side_first_slots,
+                                    std::vector<RREdgeId>& sorted_edge_slots) {
   const RRNodeId& chan_node = chan_node_[size_t(chan_side)].get_node(track_id); 
   
   /* Count the edges and ensure every of them has been sorted */
   size_t edge_counter = 0;
+  size_t first_edge = chan_node_in_edges_.size();
 
   /* For each incoming edge, find the node side and index in this GSB.
-   * and cache these. Then we will use the data to sort the edge in the 
-   * following sequence:
+   * and place the edge in a slot of the following sequence:
    *  0----------------------------------------------------------------> num_in_edges()
    *  |<--TOP side-->|<--RIGHT side-->|<--BOTTOM side-->|<--LEFT side-->|
    *  For each side, the edge will be sorted by the node index starting from 0 
    *  For each side, the edge from grid pins will be the 1st part
    *  while the edge from routing tracks will be the 2nd part
+   * The slots are shared by all the channel nodes of the GSB, 
+   * and are released once the edges are stored
    */
   for (const RREdgeId& edge : rr_graph.node_in_edges(chan_node)) {
     /* We care the source node of this edge, and it should be an input of the GSB!!! */
@@ -869,63 +1031,138 @@ void RRGSB::sort_chan_node_in_edges(const RRGraph& rr_graph,
     VTR_ASSERT(NUM_SIDES != side);
     VTR_ASSERT(OPEN != index);
 
+    /* The OPINs of a side are followed by its routing tracks */
+    size_t slot = side_first_slots[size_t(side)];
     if (OPIN == rr_graph.node_type(src_node)) {
-      from_grid_edge_map[side][index] = edge;
+      slot += size_t(index);
     } else {
       VTR_ASSERT( (CHANX == rr_graph.node_type(src_node))
                || (CHANY == rr_graph.node_type(src_node)) );
-      from_track_edge_map[side][index] = edge;
+      VTR_ASSERT(size_t(index) < chan_node_[size_t(side)].get_chan_width());
+      slot += side_first_slots[size_t(side) + 1] - side_first_slots[size_t(side)] 
+            - chan_node_[size_t(side)].get_chan_width() + size_t(index);
     }
+    VTR_ASSERT(slot < side_first_slots[size_t(side) + 1]);
+    sorted_edge_slots[slot] = edge;
     
     edge_counter++;
   }
 
   /* Store the sorted edge */
-  for (size_t side = 0; side < get_num_sides(); ++side) {
-    /* Edges from grid outputs are the 1st part */
-    for (size_t opin_id = 0; opin_id < opin_node_[side].size(); ++opin_id) {
-      if ( (0 < from_grid_edge_map.count(side))
-        && (0 < from_grid_edge_map.at(side).count(opin_id)) ) {
-        chan_node_in_edges_[size_t(chan_side)][track_id].push_back(from_grid_edge_map[side][opin_id]);
-      }
-    }
- 
-    /* Edges from routing tracks are the 2nd part */
-    for (size_t itrack = 0; itrack < chan_node_[side].get_chan_width(); ++itrack) {
-      if ( (0 < from_track_edge_map.count(side))
-        && (0 < from_track_edge_map.at(side).count(itrack)) ) {
-        chan_node_in_edges_[size_t(chan_side)][track_id].push_back(from_track_edge_map[side][itrack]);
-      }
+  for (RREdgeId& edge : sorted_edge_slots) {
+    if (RREdgeId::INVALID() != edge) {
+      chan_node_in_edges_.push_back(edge);
+      edge = RREdgeId::INVALID();
     }
   }
 
-  VTR_ASSERT(edge_counter == chan_node_in_edges_[size_t(chan_side)][track_id].size());
+  VTR_ASSERT(edge_counter == chan_node_in_edges_.size() - first_edge);
 } 
 
 void RRGSB::sort_chan_node_in_edges(const RRGraph& rr_graph) {
+  VTR_ASSERT(false == is_frozen());
   /* Allocate here, as sort edge is optional, we do not allocate when adding nodes */
-  chan_node_in_edges_.resize(get_num_sides());
+  chan_node_in_edges_.clear();
+  chan_node_in_edge_offsets_.clear();
+  chan_node_in_edge_offsets_.resize(get_num_sides());
+
+  /* Each input node of the GSB, i.e., an OPIN or a routing track, has a slot for its edge */
+  std::vector<size_t> side_first_slots(get_num_sides() + 1, 0);
+  for (size_t side = 0; side < get_num_sides(); ++side) {
+    size_t num_opins = (side < opin_node_.size()) ? opin_node_[side].size() : 0;
+    side_first_slots[side + 1] = side_first_slots[side] + num_opins + chan_node_[side].get_chan_width();
+  }
+  std::vector<RREdgeId> sorted_edge_slots(side_first_slots.back(), RREdgeId::INVALID());
 
   for (size_t side = 0; side < get_num_sides(); ++side) {
     SideManager side_manager(side);
-    chan_node_in_edges_[side].resize(chan_node_[side].get_chan_width());
+    chan_node_in_edge_offsets_[side].resize(chan_node_[side].get_chan_width() + 1);
     for (size_t track_id = 0; track_id < chan_node_[side].get_chan_width(); ++track_id) {
+      chan_node_in_edge_offsets_[side][track_id] = chan_node_in_edges_.size();
       /* Only sort the output nodes and bypass passing wires */
       if (enable_gsb_routing_) {
         if ( (OUT_PORT == chan_node_direction_[side][track_id])
         && (false == is_sb_node_passing_wire(rr_graph, side_manager.get_side(), track_id)) ) {  
-        sort_chan_node_in_edges(rr_graph, side_manager.get_side(), track_id); 
+        sort_chan_node_in_edges(rr_graph, side_manager.get_side(), track_id, side_first_slots, sorted_edge_slots); 
         }
       } else {
         /* shen: imux|omux|gsb maybe IN_PORTS, but we have to consider them*/
         std::string node_seg_name = rr_graph.get_segment(get_chan_node_segment((e_side&)side, track_id)).name;
         if ((OUT_PORT == chan_node_direction_[side][track_id] || IMUX == node_seg_name || OMUX == node_seg_name || GSB == node_seg_name)
         && (false == is_sb_node_passing_wire(rr_graph, side_manager.get_side(), track_id)))
-        sort_chan_node_in_edges(rr_graph, side_manager.get_side(), track_id);
+        sort_chan_node_in_edges(rr_graph, side_manager.get_side(), track_id, side_first_slots, sorted_edge_slots);
       }
       
     }
+    chan_node_in_edge_offsets_[side][chan_node_[side].get_chan_width()] = chan_node_in_edges_.size();
   }
+
+  chan_node_in_edges_.shrink_to_fit();
+}
+
+/* Pack the nodes and the sorted edges of the GSB into a shared storage.
+ * The data are read by the accessors, so that a frozen GSB can be packed again into a new storage
+ */
+void RRGSB::freeze(RRGSBStorage& storage) {
+  size_t side_begin = storage.sides.size();
+  size_t num_sides = get_num_sides();
+  bool edges_sorted = is_chan_node_in_edges_sorted();
+
+  for (size_t side = 0; side < num_sides; ++side) {
+    SideManager side_manager(side);
+    e_side node_side = side_manager.get_side();
+    RRGSBStorage::t_side frozen_side;
+
+    frozen_side.chan_type = get_chan_type(node_side);
+    frozen_side.chan_node_begin = storage.chan_nodes.size();
+    for (size_t itrack = 0; itrack < get_chan_width(node_side); ++itrack) {
+      storage.chan_nodes.push_back(get_chan_node(node_side, itrack));
+      storage.chan_node_segments.push_back(get_chan_node_segment(node_side, itrack));
+      storage.chan_node_directions.push_back(get_chan_node_direction(node_side, itrack));
+    }
+    frozen_side.chan_node_end = storage.chan_nodes.size();
+
+    /* The GSBs with routing only have IPINs and OPINs on a part of the sides */
+    size_t num_ipins = ((true == is_frozen()) || (side < ipin_node_.size())) ? get_num_ipin_nodes(node_side) : 0;
+    frozen_side.ipin_node_begin = storage.pin_nodes.size();
+    for (size_t inode = 0; inode < num_ipins; ++inode) {
+      storage.pin_nodes.push_back(get_ipin_node(node_side, inode));
+    }
+    frozen_side.ipin_node_end = storage.pin_nodes.size();
+
+    size_t num_opins = ((true == is_frozen()) || (side < opin_node_.size())) ? get_num_opin_nodes(node_side) : 0;
+    frozen_side.opin_node_begin = storage.pin_nodes.size();
+    for (size_t inode = 0; inode < num_opins; ++inode) {
+      storage.pin_nodes.push_back(get_opin_node(node_side, inode));
+    }
+    frozen_side.opin_node_end = storage.pin_nodes.size();
+
+    frozen_side.in_edge_offset_begin = RRGSBStorage::NO_SORTED_EDGES;
+    if (true == edges_sorted) {
+      frozen_side.in_edge_offset_begin = storage.chan_node_in_edge_offsets.size();
+      for (size_t itrack = 0; itrack < get_chan_width(node_side); ++itrack) {
+        storage.chan_node_in_edge_offsets.push_back(storage.chan_node_in_edges.size());
+        for (const RREdgeId& edge : get_sorted_chan_node_in_edges(node_side, itrack)) {
+          storage.chan_node_in_edges.push_back(edge);
+        }
+      }
+      storage.chan_node_in_edge_offsets.push_back(storage.chan_node_in_edges.size());
+    }
+
+    storage.sides.push_back(frozen_side);
+  }
+
+  /* Release the containers owned by the GSB */
+  std::vector<RRChan>().swap(chan_node_);
+  std::vector<std::vector<PORTS>>().swap(chan_node_direction_);
+  std::vector<RREdgeId>().swap(chan_node_in_edges_);
+  std::vector<std::vector<size_t>>().swap(chan_node_in_edge_offsets_);
+  std::vector<std::vector<RRNodeId>>().swap(ipin_node_);
+  std::vector<std::vector<RRNodeId>>().swap(opin_node_);
+
+  frozen_storage_ = &storage;
+  frozen_side_begin_ = side_begin;
+  frozen_num_sides_ = num_sides;
 }
 
 /************************************************************************
@@ -933,6 +1170,11 @@ void RRGSB::sort_chan_node_in_edges(const RRGraph& rr_graph) {
  ***********************************************************************/
 /* Reset the RRGSB to pristine state */
 void RRGSB::clear() {
+  /* Detach from the shared storage */
+  frozen_storage_ = nullptr;
+  frozen_side_begin_ = 0;
+  frozen_num_sides_ = 0;
+
   /* Clean all the vectors */
   VTR_ASSERT(validate_num_sides());
   /* Clear the inner vector of each matrix */
@@ -946,10 +1188,13 @@ void RRGSB::clear() {
   chan_node_.clear();
   ipin_node_.clear();
   opin_node_.clear();
+  chan_node_in_edges_.clear();
+  chan_node_in_edge_offsets_.clear();
 }
 
 /* Clean the chan_width of a side */
 void RRGSB::clear_chan_nodes(const e_side& node_side) {
+  VTR_ASSERT(false == is_frozen());
   VTR_ASSERT(validate_side(node_side));
   
   chan_node_[size_t(node_side)].clear();
@@ -958,6 +1203,7 @@ void RRGSB::clear_chan_nodes(const e_side& node_side) {
 
 /* Clean the number of IPINs of a side */
 void RRGSB::clear_ipin_nodes(const e_side& node_side) {
+  VTR_ASSERT(false == is_frozen());
   VTR_ASSERT(validate_side(node_side));
   
   ipin_node_[size_t(node_side)].clear();
@@ -965,6 +1211,7 @@ void RRGSB::clear_ipin_nodes(const e_side& node_side) {
 
 /* Clean the number of OPINs of a side */
 void RRGSB::clear_opin_nodes(const e_side& node_side) {
+  VTR_ASSERT(false == is_frozen());
   VTR_ASSERT(validate_side(node_side));
   
   opin_node_[size_t(node_side)].clear();
@@ -977,6 +1224,90 @@ void RRGSB::clear_one_side(const e_side& node_side) {
   clear_opin_nodes(node_side);
 } 
 
+/************************************************************************
+ * Internal Accessors
+ ***********************************************************************/
+/* Identify if the incoming edges of the channel nodes have been sorted */
+bool RRGSB::is_chan_node_in_edges_sorted() const {
+  if (true == is_frozen()) {
+    /* The edges of all the sides of a GSB are sorted together */
+    return (0 < frozen_num_sides_)
+        && (RRGSBStorage::NO_SORTED_EDGES != frozen_storage_->sides[frozen_side_begin_].in_edge_offset_begin);
+  }
+  return (0 != chan_node_in_edge_offsets_.size());
+}
+
+/* Get the sorted incoming edges of a channel node */
+RRGraph::edge_range RRGSB::get_sorted_chan_node_in_edges(const e_side& side, const size_t& track_id) const {
+  VTR_ASSERT(true == is_chan_node_in_edges_sorted());
+  if (true == is_frozen()) {
+    const std::vector<size_t>& offsets = frozen_storage_->chan_node_in_edge_offsets;
+    size_t offset_id = get_frozen_side(side).in_edge_offset_begin + track_id;
+    return vtr::make_range(frozen_storage_->chan_node_in_edges.data() + offsets[offset_id],
+                           frozen_storage_->chan_node_in_edges.data() + offsets[offset_id + 1]);
+  }
+
+  const std::vector<size_t>& offsets = chan_node_in_edge_offsets_[size_t(side)];
+  return vtr::make_range(chan_node_in_edges_.data() + offsets[track_id],
+                         chan_node_in_edges_.data() + offsets[track_id + 1]);
+}
+
+/* Get the side of a frozen GSB in its storage */
+const RRGSBStorage::t_side& RRGSB::get_frozen_side(const e_side& side) const {
+  VTR_ASSERT(true == is_frozen());
+  VTR_ASSERT(size_t(side) < frozen_num_sides_);
+  return frozen_storage_->sides[frozen_side_begin_ + size_t(side)];
+}
+
+/* Check if the routing channels at a side of two GSBs are mirrors, 
+ * comparing the same elements as RRChan::is_mirror()
+ */
+bool RRGSB::is_chan_mirror(const RRGraph& rr_graph, const RRGSB& cand, const e_side& side) const {
+  if (false == this->is_frozen() && false == cand.is_frozen()) {
+    return chan_node_[size_t(side)].is_mirror(rr_graph, cand.chan_node_[size_t(side)]);
+  }
+
+  /* 1. type  */
+  if (this->get_chan_type(side) != cand.get_chan_type(side)) {
+    return false;
+  }
+  /* 2. track_width  */
+  if (this->get_chan_width(side) != cand.get_chan_width(side)) {
+    return false;
+  }
+  /* 3. for each node */
+  for (size_t itrack = 0; itrack < this->get_chan_width(side); ++itrack) {
+    const RRNodeId& node = this->get_chan_node(side, itrack);
+    const RRNodeId& cand_node = cand.get_chan_node(side, itrack);
+    if ( (rr_graph.node_type(node) != rr_graph.node_type(cand_node))
+      || (rr_graph.node_direction(node) != rr_graph.node_direction(cand_node))
+      || (this->get_chan_node_segment(side, itrack) != cand.get_chan_node_segment(side, itrack)) ) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/* Get the fingerprint of the routing channel at a side, which is the same as RRChan::get_fingerprint() */
+size_t RRGSB::get_chan_fingerprint(const RRGraph& rr_graph, const e_side& side) const {
+  if (false == is_frozen()) {
+    return chan_node_[size_t(side)].get_fingerprint(rr_graph);
+  }
+
+  size_t fingerprint = 0;
+  vtr::hash_combine(fingerprint, size_t(get_chan_type(side)));
+  vtr::hash_combine(fingerprint, get_chan_width(side));
+  for (size_t itrack = 0; itrack < get_chan_width(side); ++itrack) {
+    const RRNodeId& node = get_chan_node(side, itrack);
+    vtr::hash_combine(fingerprint, size_t(rr_graph.node_type(node)));
+    vtr::hash_combine(fingerprint, size_t(rr_graph.node_direction(node)));
+    vtr::hash_combine(fingerprint, size_t(get_chan_node_segment(side, itrack)));
+  }
+
+  return fingerprint;
+}
+
 /************************************************************************
  * Internal Accessors: identify mirrors
  ***********************************************************************/
@@ -1007,8 +1338,8 @@ bool RRGSB::is_sb_node_mirror(const RRGraph& rr_graph,
   }
 
   /* Use unsorted/sorted edges */
-  std::vector<RREdgeId> node_in_edges = get_chan_node_in_edges(rr_graph, node_side, track_id);
-  std::vector<RREdgeId> cand_node_in_edges = cand.get_chan_node_in_edges(rr_graph, node_side, track_id);
+  RRGraph::edge_range node_in_edges = get_chan_node_in_edges(rr_graph, node_side, track_id);
+  RRGraph::edge_range cand_node_in_edges = cand.get_chan_node_in_edges(rr_graph, node_side, track_id);
 
   /* For non-passing wires, check driving rr_nodes */
   if (node_in_edges.size() != cand_node_in_edges.size()) {
@@ -1018,8 +1349,8 @@ bool RRGSB::is_sb_node_mirror(const RRGraph& rr_graph,
   VTR_ASSERT(node_in_edges.size() == cand_node_in_edges.size());
 
   for (size_t iedge = 0; iedge < node_in_edges.size(); ++iedge) {
-    RREdgeId src_edge = node_in_edges[iedge];
-    RREdgeId src_cand_edge = cand_node_in_edges[iedge];
+    RREdgeId src_edge = node_in_edges.begin()[iedge];
+    RREdgeId src_cand_edge = cand_node_in_edges.begin()[iedge];
     RRNodeId src_node = rr_graph.edge_src_node(src_edge);
     RRNodeId src_cand_node = rr_graph.edge_src_node(src_cand_edge);
     /* node type should be the same  */
@@ -1117,6 +1448,74 @@ bool RRGSB::is_cb_node_mirror(const RRGraph& rr_graph,
   return true;
 } 
 
+/* Hash the elements of a channel rr_node that is_sb_node_mirror() compares */
+size_t RRGSB::get_sb_node_fingerprint(const RRGraph& rr_graph,
+                                      const e_side& node_side, 
+                                      const size_t& track_id) const {
+  size_t fingerprint = 0;
+
+  /* Passing wires are equivalent to each other regardless of their drivers */
+  bool is_short_conkt = is_sb_node_passing_wire(rr_graph, node_side, track_id);
+  vtr::hash_combine(fingerprint, is_short_conkt);
+  if (true == is_short_conkt) {
+    return fingerprint;
+  }
+
+  RRGraph::edge_range node_in_edges = get_chan_node_in_edges(rr_graph, node_side, track_id);
+  vtr::hash_combine(fingerprint, node_in_edges.size());
+
+  for (const RREdgeId& src_edge : node_in_edges) {
+    RRNodeId src_node = rr_graph.edge_src_node(src_edge);
+    vtr::hash_combine(fingerprint, size_t(rr_graph.node_type(src_node)));
+    vtr::hash_combine(fingerprint, size_t(rr_graph.edge_switch(src_edge)));
+
+    int src_node_id;
+    enum e_side src_node_side; 
+    get_node_side_and_index(rr_graph, src_node, OUT_PORT, src_node_side, src_node_id);
+    vtr::hash_combine(fingerprint, src_node_id);
+    vtr::hash_combine(fingerprint, size_t(src_node_side));
+  }
+
+  return fingerprint;
+}
+
+/* Hash the elements of an ipin rr_node that is_cb_node_mirror() compares */
+size_t RRGSB::get_cb_node_fingerprint(const RRGraph& rr_graph,
+                                      const t_rr_type& cb_type,
+                                      const e_side& node_side, 
+                                      const size_t& node_id) const {
+  size_t fingerprint = 0;
+
+  RRNodeId node = get_ipin_node(node_side, node_id);
+  vtr::hash_combine(fingerprint, rr_graph.node_in_edges(node).size());
+
+  enum e_side chan_side = get_cb_chan_side(cb_type);
+  for (const RREdgeId& src_edge : rr_graph.node_in_edges(node)) {
+    RRNodeId src_node = rr_graph.edge_src_node(src_edge);
+    vtr::hash_combine(fingerprint, size_t(rr_graph.node_type(src_node)));
+    vtr::hash_combine(fingerprint, size_t(rr_graph.edge_switch(src_edge)));
+
+    int src_node_id = -1;
+    enum e_side src_node_side = NUM_SIDES; 
+    switch (rr_graph.node_type(src_node)) {
+    case CHANX:
+    case CHANY:
+      src_node_id = get_chan_node_index(chan_side, src_node);
+      break;
+    case OPIN:
+      get_node_side_and_index(rr_graph, src_node, OUT_PORT, src_node_side, src_node_id);
+      break;
+    default:
+      /* Invalid drivers will be reported by is_cb_node_mirror() */
+      break;
+    }
+    vtr::hash_combine(fingerprint, src_node_id);
+    vtr::hash_combine(fingerprint, size_t(src_node_side));
+  }
+
+  return fingerprint;
+} 
+
 size_t RRGSB::get_track_id_first_short_connection(const RRGraph& rr_graph, const e_side& node_side) const {
   VTR_ASSERT(validate_side(node_side));
 
@@ -1136,6 +1535,11 @@ size_t RRGSB::get_track_id_first_short_connection(const RRGraph& rr_graph, const
  ***********************************************************************/
 /* Validate if the number of sides are consistent among internal data arrays ! */
 bool RRGSB::validate_num_sides() const {
+  /* The sides of a frozen GSB are consistent by construction */
+  if (true == is_frozen()) {
+    return true;
+  }
+
   size_t num_sides = chan_node_direction_.size();
 
   if ( num_sides != chan_node_.size() ) {
@@ -1163,6 +1567,10 @@ bool RRGSB::validate_track_id(const e_side& side, const size_t& track_id) const
   if (false == validate_side(side)) {
     return false;
   } 
+
+  if (true == is_frozen()) {
+    return (track_id < get_chan_width(side));
+  }
   
   return ( ( track_id < chan_node_[size_t(side)].get_chan_width()) 
         && ( track_id < chan_node_direction_[size_t(side)].size()) );
@@ -1173,7 +1581,7 @@ bool RRGSB::validate_opin_node_id(const e_side& side, const size_t& node_id) con
   if (false == validate_side(side)) {
     return false;
   } 
-  return (node_id < opin_node_[size_t(side)].size());
+  return (node_id < get_num_opin_nodes(side));
 }
 
 /* Check the ipin_node_id is valid for opin_node_ and opin_node_grid_side_ */
@@ -1181,7 +1589,7 @@ bool RRGSB::validate_ipin_node_id(const e_side& side, const size_t& node_id) con
   if (false == validate_side(side)) {
     return false;
   } 
-  return (node_id < ipin_node_[size_t(side)].size());
+  return (node_id < get_num_ipin_nodes(side));
 }
 
 bool RRGSB::validate_cb_type(const t_rr_type& cb_type) const {
@@ -17,6 +17,38 @@
 /* Begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * Shared storage of frozen RRGSBs
+ * The routing tracks, pins and sorted incoming edges of a number of GSBs
+ * are packed GSB by GSB and side by side in flat arrays,
+ * instead of the small containers owned by each GSB.
+ * A frozen RRGSB only keeps the range of its sides in the side table,
+ * while each side refers to its own ranges in the other arrays
+ *******************************************************************/
+struct RRGSBStorage {
+  /* Value of in_edge_offset_begin when the edges of a GSB are not sorted */
+  static constexpr size_t NO_SORTED_EDGES = size_t(-1);
+
+  struct t_side {
+    t_rr_type chan_type;
+    size_t chan_node_begin; /* First track of the side in chan_nodes, chan_node_segments and chan_node_directions */
+    size_t chan_node_end;
+    size_t ipin_node_begin; /* First IPIN of the side in pin_nodes */
+    size_t ipin_node_end;
+    size_t opin_node_begin; /* First OPIN of the side in pin_nodes */
+    size_t opin_node_end;
+    size_t in_edge_offset_begin; /* First track of the side in chan_node_in_edge_offsets, which holds (chan_width + 1) offsets per side */
+  };
+
+  std::vector<t_side> sides;
+  std::vector<RRNodeId> chan_nodes;
+  std::vector<RRSegmentId> chan_node_segments;
+  std::vector<PORTS> chan_node_directions;
+  std::vector<RRNodeId> pin_nodes;
+  std::vector<RREdgeId> chan_node_in_edges;
+  std::vector<size_t> chan_node_in_edge_offsets;
+};
+
 /********************************************************************
  * Object Generic Switch Block 
  * This block contains
@@ -54,13 +86,16 @@ namespace openfpga {
  * opin_rr_node_grid_side: specify the side of the output pins on which side of a GRID  <0..num_sides-1><0..num_opin_rr_nodes-1>
  * num_reserved_conf_bits: number of reserved configuration bits this switch block requires (mainly due to RRAM-based multiplexers)
  * num_conf_bits: number of configuration bits this switch block requires
+ *
+ * Once frozen (see freeze()), the GSB no longer owns the containers above
+ * but reads its nodes and edges from a shared RRGSBStorage.
+ * The accessors are the same for both cases
  *******************************************************************/
 class RRGSB {
   public: /* Contructors */
     /* shen: enable_gsb_routing */
     RRGSB(const RRGSB&);/* Copy constructor */
-    RRGSB(bool enable_gsb_routing): enable_gsb_routing_(enable_gsb_routing) {};
-    //RRGSB();/* Default constructor */
+    RRGSB(bool enable_gsb_routing = false);
   public: /* Accessors */
     /* Get the number of sides of this SB */
     size_t get_num_sides() const; 
@@ -93,8 +128,10 @@ class RRGSB {
     /* get a rr_node at a given side and track_id */
     RRNodeId get_chan_node(const e_side& side, const size_t& track_id) const; 
 
-    /* get all the sorted incoming edges for a rr_node at a given side and track_id */
-    std::vector<RREdgeId> get_chan_node_in_edges(const RRGraph& rr_graph, 
+    /* get all the sorted incoming edges for a rr_node at a given side and track_id
+     * The edges of the rr_graph are given in their original order if the GSB is not sorted
+     */
+    RRGraph::edge_range get_chan_node_in_edges(const RRGraph& rr_graph, 
                                                  const e_side& side,
                                                  const size_t& track_id) const; 
 
@@ -125,6 +162,9 @@ class RRGSB {
 
     /* Check if the node exist in the opposite side of this Switch Block */
     bool is_sb_node_exist_opposite_side(const RRGraph& rr_graph, const RRNodeId& node, const e_side& node_side) const;
+
+    /* Identify if the GSB reads its nodes and edges from a shared storage */
+    bool is_frozen() const;
   public: /* Accessors: to identify mirrors */
     /* check if the candidate SB is a mirror of the current one */
     bool is_cb_mirror(const RRGraph& rr_graph, const RRGSB& cand, const t_rr_type& cb_type) const; 
@@ -174,6 +214,17 @@ class RRGSB {
      */
     bool is_sb_mirror(const RRGraph& rr_graph, const RRGSB& cand) const; 
 
+    /* Get a structural fingerprint of the SB, built from the same elements as is_sb_mirror() checks
+     * Two SB mirrors always have the same fingerprint, 
+     * so that only the SBs with the same fingerprint need a full comparison
+     */
+    size_t get_sb_fingerprint(const RRGraph& rr_graph) const;
+
+    /* Get a structural fingerprint of the X/Y-direction CB, built from the same elements as is_cb_mirror() checks
+     * Two CB mirrors always have the same fingerprint 
+     */
+    size_t get_cb_fingerprint(const RRGraph& rr_graph, const t_rr_type& cb_type) const;
+
   public: /* Cooridinator conversion and output  */
     size_t get_x() const; /* get the x coordinate of this switch block */
     size_t get_y() const; /* get the y coordinate of this switch block */
@@ -218,6 +269,13 @@ class RRGSB {
     /* Sort all the incoming edges for routing channel rr_node */
     void sort_chan_node_in_edges(const RRGraph& rr_graph);
 
+    /* Pack the nodes and the sorted edges of the GSB into a shared storage
+     * and release its own containers.
+     * The GSB and all its copies keep reading from the storage, which must outlive them.
+     * A frozen GSB can no longer be modified, except by clear()
+     */
+    void freeze(RRGSBStorage& storage);
+
   public: /* Mutators: cleaners */
     void clear();
 
@@ -234,12 +292,28 @@ class RRGSB {
     void clear_one_side(const e_side& node_side); 
 
   private: /* Private Mutators: edge sorting */
-    /* Sort all the incoming edges for one channel rr_node */
+    /* Sort all the incoming edges for one channel rr_node and append them to chan_node_in_edges_ */
     void sort_chan_node_in_edges(const RRGraph& rr_graph,
                                  const e_side& chan_side,
-                                 const size_t& track_id);
+                                 const size_t& track_id,
+                                 const std::vector<size_t>& side_first_slots,
+                                 std::vector<RREdgeId>& sorted_edge_slots);
 
   private: /* internal functions */
+    /* Identify if the incoming edges of the channel nodes have been sorted */
+    bool is_chan_node_in_edges_sorted() const;
+
+    /* Get the sorted incoming edges of a channel node, regardless of its direction */
+    RRGraph::edge_range get_sorted_chan_node_in_edges(const e_side& side, const size_t& track_id) const;
+
+    /* Get the side of a frozen GSB in its storage */
+    const RRGSBStorage::t_side& get_frozen_side(const e_side& side) const;
+
+    /* check if the routing channel of a side of candidate GSB is a mirror of the current one */
+    bool is_chan_mirror(const RRGraph& rr_graph, const RRGSB& cand, const e_side& side) const;
+
+    size_t get_chan_fingerprint(const RRGraph& rr_graph, const e_side& side) const;
+
     bool is_sb_node_mirror(const RRGraph& rr_graph,
                            const RRGSB& cand,
                            const e_side& node_side, 
@@ -251,6 +325,15 @@ class RRGSB {
                            const e_side& node_side, 
                            const size_t& node_id) const; 
 
+    size_t get_sb_node_fingerprint(const RRGraph& rr_graph,
+                                   const e_side& node_side, 
+                                   const size_t& track_id) const; 
+
+    size_t get_cb_node_fingerprint(const RRGraph& rr_graph, 
+                                   const t_rr_type& cb_type, 
+                                   const e_side& node_side, 
+                                   const size_t& node_id) const; 
+
     size_t get_track_id_first_short_connection(const RRGraph& rr_graph, const e_side& node_side) const; 
 
   private: /* internal validators */
@@ -284,9 +367,13 @@ class RRGSB {
      * the routing modules. Therefore, edge sorting can be done inside the GSB 
      *
      * Storage organization:
-     *   [chan_side][chan_node][edge_id_in_gsb_context]
+     *   chan_node_in_edges_ holds the sorted edges of all the channel nodes, side by side and track by track
+     *   chan_node_in_edge_offsets_[chan_side][chan_node] is the first edge of a channel node in chan_node_in_edges_,
+     *   and chan_node_in_edge_offsets_[chan_side][chan_node + 1] is its end
+     * Both are empty if the edges are not sorted
      */ 
-    std::vector<std::vector<std::vector<RREdgeId>>> chan_node_in_edges_;
+    std::vector<RREdgeId> chan_node_in_edges_;
+    std::vector<std::vector<size_t>> chan_node_in_edge_offsets_;
 
     /* Logic Block Inputs data */
     std::vector<std::vector<RRNodeId>>  ipin_node_;
@@ -294,6 +381,13 @@ class RRGSB {
     /* Logic Block Outputs data */
     std::vector<std::vector<RRNodeId>>  opin_node_;
 
+    /* Shared storage of a frozen GSB, which replaces all the containers above.
+     * The sides of the GSB are [frozen_side_begin_, frozen_side_begin_ + frozen_num_sides_) in its side table
+     */
+    const RRGSBStorage* frozen_storage_;
+    size_t frozen_side_begin_;
+    size_t frozen_num_sides_;
+
 };
 
 } /* End namespace openfpga*/
@@ -23,6 +23,7 @@
 #include "tileable_chan_details_builder.h"
 #include "tileable_rr_graph_node_builder.h"
 #include "tileable_rr_graph_edge_builder.h"
+#include "tileable_rr_graph_cache.h"
 #include "tileable_rr_graph_builder.h"
 
 #include "globals.h"
@@ -68,6 +69,9 @@ namespace openfpga {
  * 8. Allocate external data structures
  *    a. cost_index
  *    b. RC tree
+ *
+ * When a cache directory is given, the rr_graph is loaded from the cache 
+ * if the same rr_graph has been built before, and is added to the cache otherwise
  ***********************************************************************/
 void build_tileable_unidir_rr_graph(const std::vector<t_physical_tile_type>& types,
                                     const DeviceGrid& grids,
@@ -85,6 +89,7 @@ void build_tileable_unidir_rr_graph(const std::vector<t_physical_tile_type>& typ
                                     int* wire_to_rr_ipin_switch,
                                     const bool& through_channel,
                                     const bool& wire_opposite_side,
+                                    const std::string& cache_dir,
                                     int *Warnings) { 
 
   vtr::ScopedStartFinishTimer timer("Build tileable routing resource graph");
@@ -92,6 +97,24 @@ void build_tileable_unidir_rr_graph(const std::vector<t_physical_tile_type>& typ
   /* Reset warning flag */
   *Warnings = RR_GRAPH_NO_WARN;
 
+  /* Reuse the rr_graph in cache if possible */
+  std::string cache_file;
+  if (!cache_dir.empty()) {
+#ifdef VTR_ENABLE_CAPNPROTO
+    cache_file = find_tileable_rr_graph_cache_file(cache_dir, grids, chan_width,
+                                                   sb_type, Fs, sb_subtype, subFs,
+                                                   segment_inf, base_cost_type,
+                                                   through_channel, wire_opposite_side);
+    if (true == load_tileable_rr_graph_cache(cache_file, grids, segment_inf,
+                                             base_cost_type, wire_to_rr_ipin_switch)) {
+      return;
+    }
+#else
+    VTR_LOG_WARN("Cache of rr_graph is ignored because VTR_ENABLE_CAPNPROTO=OFF. "
+                 "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable.\n");
+#endif /* VTR_ENABLE_CAPNPROTO */
+  }
+
   /* Create a matrix of grid */
   /* Create a vector of channel width, we support X-direction and Y-direction has different W */
   vtr::Point<size_t> device_chan_width(chan_width.x_max, chan_width.y_max);
@@ -236,7 +259,8 @@ void build_tileable_unidir_rr_graph(const std::vector<t_physical_tile_type>& typ
                        segment_inf, 
                        Fc_in, Fc_out,
                        sb_type, Fs, sb_subtype, subFs,
-                       wire_opposite_side);
+                       wire_opposite_side,
+                       device_ctx.rr_gsbs);
 
   /************************************************************************
    * Build direction connection lists
@@ -316,6 +340,11 @@ void build_tileable_unidir_rr_graph(const std::vector<t_physical_tile_type>& typ
               "but not smooth\n");
   }
 
+  /* Add the rr_graph to cache so that next runs can reuse it */
+  if (!cache_file.empty()) {
+    write_tileable_rr_graph_cache(cache_file, *wire_to_rr_ipin_switch);
+  }
+
   /************************************************************************
    * Free all temp stucts 
    ***********************************************************************/
@@ -0,0 +1,159 @@
+/************************************************************************
+ *  This file contains functions to keep the tileable rr_graph in an
+ *  on-disk cache. Regression runs build the same rr_graph again and 
+ *  again for different benchmarks, as long as the architecture, the 
+ *  device grid and the routing channel width are the same.
+ *  The cached rr_graphs are stored in the binary format 
+ *  (see write_binary_rr_graph_obj.h) and named after a digest of all 
+ *  the inputs of the tileable rr_graph builder.
+ ***********************************************************************/
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <limits>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_util.h"
+#include "vtr_digest.h"
+#include "vtr_version.h"
+
+#include "vpr_error.h"
+#include "read_xml_arch_file.h"
+#include "read_binary_rr_graph_obj.h"
+#include "write_binary_rr_graph_obj.h"
+
+#include "tileable_rr_graph_cache.h"
+
+#include "globals.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/************************************************************************
+ * Find the path of the cached rr_graph for the given inputs
+ * of the tileable rr_graph builder.
+ * The physical tile types, switches and direct connections are all 
+ * defined by the architecture file, so its digest stands for them 
+ ***********************************************************************/
+std::string find_tileable_rr_graph_cache_file(const std::string& cache_dir,
+                                              const DeviceGrid& grids,
+                                              const t_chan_width& chan_width,
+                                              const e_switch_block_type& sb_type, const int& Fs, 
+                                              const e_switch_block_type& sb_subtype, const int& subFs, 
+                                              const std::vector<t_segment_inf>& segment_inf,
+                                              const enum e_base_cost_type& base_cost_type, 
+                                              const bool& through_channel,
+                                              const bool& wire_opposite_side) {
+  std::stringstream key;
+  key.precision(std::numeric_limits<float>::max_digits10);
+
+  /* Any change in the tool may change the rr_graph */
+  key << vtr::VERSION << "\n";
+  key << vtr::secure_digest_file(get_arch_file_name()) << "\n";
+
+  key << grids.width() << " " << grids.height() << "\n";
+  for (size_t ix = 0; ix < grids.width(); ++ix) {
+    for (size_t iy = 0; iy < grids.height(); ++iy) {
+      const t_grid_tile& grid_tile = grids[ix][iy];
+      key << (nullptr == grid_tile.type ? "" : grid_tile.type->name)
+          << " " << grid_tile.width_offset << " " << grid_tile.height_offset << "\n";
+    }
+  }
+
+  key << chan_width.max << " " << chan_width.x_max << " " << chan_width.y_max
+      << " " << chan_width.x_min << " " << chan_width.y_min << "\n";
+  for (const int& width : chan_width.x_list) {
+    key << width << " ";
+  }
+  key << "\n";
+  for (const int& width : chan_width.y_list) {
+    key << width << " ";
+  }
+  key << "\n";
+
+  key << sb_type << " " << Fs << " " << sb_subtype << " " << subFs << "\n";
+  key << base_cost_type << " " << through_channel << " " << wire_opposite_side << "\n";
+
+  for (const t_segment_inf& segment : segment_inf) {
+    key << segment.name << " " << segment.frequency << " " << segment.length
+        << " " << segment.arch_wire_switch << " " << segment.arch_opin_switch
+        << " " << segment.frac_cb << " " << segment.frac_sb << " " << segment.longline
+        << " " << segment.Rmetal << " " << segment.Cmetal << " " << segment.directionality << "\n";
+    for (const bool& cb : segment.cb) {
+      key << cb;
+    }
+    key << "\n";
+    for (const bool& sb : segment.sb) {
+      key << sb;
+    }
+    key << "\n";
+  }
+
+  return cache_dir + "/tileable_rr_graph_" + vtr::secure_digest_stream(key) + ".bin";
+}
+
+/************************************************************************
+ * Load the rr_graph from the cache when it exists
+ * Return true if the rr_graph is loaded, otherwise the rr_graph has to
+ * be built 
+ ***********************************************************************/
+bool load_tileable_rr_graph_cache(const std::string& cache_file,
+                                  const DeviceGrid& grids,
+                                  const std::vector<t_segment_inf>& segment_inf,
+                                  const enum e_base_cost_type& base_cost_type, 
+                                  int* wire_to_rr_ipin_switch) {
+  if (false == vtr::file_exists(cache_file.c_str())) {
+    VTR_LOG("No cached rr_graph found in '%s'\n", cache_file.c_str());
+    return false;
+  }
+
+  VTR_LOG("Loading cached rr_graph from '%s'\n", cache_file.c_str());
+
+  load_binary_rr_file(GRAPH_UNIDIR, grids, segment_inf, base_cost_type,
+                      wire_to_rr_ipin_switch, cache_file.c_str());
+
+  DeviceContext& device_ctx = g_vpr_ctx.mutable_device();
+
+  /* The rr_graph is built rather than read from users' file */
+  device_ctx.read_rr_graph_filename.clear();
+
+  /* Restore the track ids for tileable routing resource graph */
+  device_ctx.rr_node_track_ids.clear();
+  for (const RRNodeId& node : device_ctx.rr_graph.nodes()) {
+    if ( (CHANX != device_ctx.rr_graph.node_type(node))
+      && (CHANY != device_ctx.rr_graph.node_type(node)) ) {
+      continue;
+    }
+    std::vector<short> track_ids = device_ctx.rr_graph.node_track_ids(node);
+    device_ctx.rr_node_track_ids[node] = std::vector<size_t>(track_ids.begin(), track_ids.end());
+  }
+
+  return true;
+}
+
+/************************************************************************
+ * Write the rr_graph which is just built to the cache
+ * The file is written under a temporary name and then renamed,
+ * so that concurrent runs never read a partially written file 
+ ***********************************************************************/
+void write_tileable_rr_graph_cache(const std::string& cache_file,
+                                   const int& wire_to_rr_ipin_switch) {
+  const DeviceContext& device_ctx = g_vpr_ctx.device();
+
+  std::string temp_file = cache_file + ".tmp" 
+                        + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+
+  write_binary_rr_graph_obj(temp_file.c_str(), device_ctx.rr_graph, wire_to_rr_ipin_switch);
+
+  if (0 != std::rename(temp_file.c_str(), cache_file.c_str())) {
+    VTR_LOG_WARN("Failed to add rr_graph to the cache as '%s'\n", cache_file.c_str());
+    std::remove(temp_file.c_str());
+    return;
+  }
+
+  VTR_LOG("Added rr_graph to the cache as '%s'\n", cache_file.c_str());
+}
+
+} /* end namespace openfpga */
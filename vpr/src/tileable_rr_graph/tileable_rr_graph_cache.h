@@ -0,0 +1,42 @@
+#ifndef TILEABLE_RR_GRAPH_CACHE_H
+#define TILEABLE_RR_GRAPH_CACHE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include <vector>
+
+#include "physical_types.h"
+#include "device_grid.h"
+#include "vpr_types.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+std::string find_tileable_rr_graph_cache_file(const std::string& cache_dir,
+                                              const DeviceGrid& grids,
+                                              const t_chan_width& chan_width,
+                                              const e_switch_block_type& sb_type, const int& Fs, 
+                                              const e_switch_block_type& sb_subtype, const int& subFs, 
+                                              const std::vector<t_segment_inf>& segment_inf,
+                                              const enum e_base_cost_type& base_cost_type, 
+                                              const bool& through_channel,
+                                              const bool& wire_opposite_side);
+
+bool load_tileable_rr_graph_cache(const std::string& cache_file,
+                                  const DeviceGrid& grids,
+                                  const std::vector<t_segment_inf>& segment_inf,
+                                  const enum e_base_cost_type& base_cost_type, 
+                                  int* wire_to_rr_ipin_switch);
+
+void write_tileable_rr_graph_cache(const std::string& cache_file,
+                                   const int& wire_to_rr_ipin_switch);
+
+} /* end namespace openfpga */
+
+#endif
@@ -3,6 +3,12 @@
  *  between nodes of a tileable routing resource graph
  ***********************************************************************/
 #include <algorithm>
+#include <utility>
+#include <vector>
+
+#if defined(VPR_USE_TBB)
+#    include <tbb/parallel_for.h>
+#endif
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -86,6 +92,8 @@ void build_rr_graph_edges_for_sink_nodes(RRGraph& rr_graph,
  * 1. create edges between CHANX | CHANY and IPINs (connections inside connection blocks)
  * 2. create edges between OPINs, CHANX and CHANY (connections inside switch blocks)
  * 3. create edges between OPINs and IPINs (direct-connections)
+ * The GSBs are kept in rr_gsbs, indexed by x * (gsb_range.y() + 1) + y,
+ * so that OpenFPGA can reuse them without collecting the nodes again
  ***********************************************************************/
 void build_rr_graph_edges(RRGraph& rr_graph, 
                           const vtr::vector<RRNodeId, RRSwitchId>& rr_node_driver_switches,
@@ -96,7 +104,8 @@ void build_rr_graph_edges(RRGraph& rr_graph,
                           const std::vector<vtr::Matrix<int>>& Fc_out,
                           const e_switch_block_type& sb_type, const int& Fs,
                           const e_switch_block_type& sb_subtype, const int& subFs,
-                          const bool& wire_opposite_side) {
+                          const bool& wire_opposite_side,
+                          std::vector<RRGSB>& rr_gsbs) {
 
   /* Create edges for SOURCE and SINK nodes for a tileable rr_graph */
   build_rr_graph_edges_for_source_nodes(rr_graph, rr_node_driver_switches, grids);
@@ -104,37 +113,75 @@ void build_rr_graph_edges(RRGraph& rr_graph,
 
   vtr::Point<size_t> gsb_range(grids.width() - 2, grids.height() - 2);
 
+  /* The edges of each GSB only depend on the grids and the rr_nodes,
+   * so they are found GSB by GSB in parallel, 
+   * and then created in the order of GSBs, so that the edge ids are the same as a serial build
+   * Note that the fast node look-up of the rr_graph has been built 
+   * when creating the edges for SOURCE and SINK nodes, so that it is only read here
+   */
+  size_t num_gsbs = (gsb_range.x() + 1) * (gsb_range.y() + 1);
+  std::vector<std::vector<std::pair<RRNodeId, RRNodeId>>> gsb_edges(num_gsbs);
+  rr_gsbs.assign(num_gsbs, RRGSB(false));
+
+  /* Most of GSBs share the same local context, so do their connection maps */
+  t_gsb_local_map_cache local_map_cache;
+
+  auto find_gsb_edges = [&](const size_t& igsb) {
+    vtr::Point<size_t> gsb_coord(igsb / (gsb_range.y() + 1), igsb % (gsb_range.y() + 1));
+    /* Create a GSB object */
+    rr_gsbs[igsb] = build_one_tileable_rr_gsb(grids, rr_graph,
+                                              device_chan_width, segment_inf,
+                                              gsb_coord);
+    const RRGSB& rr_gsb = rr_gsbs[igsb];
+
+    /* adapt the track_to_ipin_lookup for the GSB nodes */      
+    t_track2pin_map track2ipin_map; /* [0..track_gsb_side][0..num_tracks][ipin_indices] */
+    track2ipin_map = build_gsb_track_to_ipin_map(rr_graph, rr_gsb, grids, segment_inf, Fc_in, &local_map_cache);
+
+    /* adapt the opin_to_track_map for the GSB nodes */      
+    t_pin2track_map opin2track_map; /* [0..gsb_side][0..num_opin_node][track_indices] */
+    opin2track_map = build_gsb_opin_to_track_map(rr_graph, rr_gsb, grids, segment_inf, Fc_out, &local_map_cache);
+
+    /* adapt the switch_block_conn for the GSB nodes */      
+    t_track2track_map sb_conn; /* [0..from_gsb_side][0..chan_width-1][track_indices] */
+    sb_conn = build_gsb_track_to_track_map(rr_graph, rr_gsb, 
+                                           sb_type, Fs, sb_subtype, subFs, wire_opposite_side, 
+                                           segment_inf, &local_map_cache);
+
+    /* Find edges for a GSB */
+    gsb_edges[igsb] = find_edges_for_one_tileable_rr_gsb(rr_gsb,
+                                                         track2ipin_map, opin2track_map, 
+                                                         sb_conn);
+  };
+
   /* Go Switch Block by Switch Block */
-  for (size_t ix = 0; ix <= gsb_range.x(); ++ix) {
-    for (size_t iy = 0; iy <= gsb_range.y(); ++iy) { 
-      //vpr_printf(TIO_MESSAGE_INFO, "Building edges for GSB[%lu][%lu]\n", ix, iy);
-
-      vtr::Point<size_t> gsb_coord(ix, iy);
-      /* Create a GSB object */
-      const RRGSB& rr_gsb = build_one_tileable_rr_gsb(grids, rr_graph,
-                                                      device_chan_width, segment_inf,
-                                                      gsb_coord);
-
-      /* adapt the track_to_ipin_lookup for the GSB nodes */      
-      t_track2pin_map track2ipin_map; /* [0..track_gsb_side][0..num_tracks][ipin_indices] */
-      track2ipin_map = build_gsb_track_to_ipin_map(rr_graph, rr_gsb, grids, segment_inf, Fc_in);
-
-      /* adapt the opin_to_track_map for the GSB nodes */      
-      t_pin2track_map opin2track_map; /* [0..gsb_side][0..num_opin_node][track_indices] */
-      opin2track_map = build_gsb_opin_to_track_map(rr_graph, rr_gsb, grids, segment_inf, Fc_out);
-
-      /* adapt the switch_block_conn for the GSB nodes */      
-      t_track2track_map sb_conn; /* [0..from_gsb_side][0..chan_width-1][track_indices] */
-      sb_conn = build_gsb_track_to_track_map(rr_graph, rr_gsb, 
-                                             sb_type, Fs, sb_subtype, subFs, wire_opposite_side, 
-                                             segment_inf);
-
-      /* Build edges for a GSB */
-      build_edges_for_one_tileable_rr_gsb(rr_graph, rr_gsb,
-                                          track2ipin_map, opin2track_map, 
-                                          sb_conn, rr_node_driver_switches);
-      /* Finish this GSB, go to the next*/
+#if defined(VPR_USE_TBB)
+  tbb::parallel_for(size_t(0), num_gsbs, [&](size_t igsb) {
+    find_gsb_edges(igsb);
+  });
+#else
+  for (size_t igsb = 0; igsb < num_gsbs; ++igsb) {
+    find_gsb_edges(igsb);
+  }
+#endif
+
+  VTR_LOG("Reused connection maps of General Switch Blocks for %lu out of %lu queries\n",
+          local_map_cache.num_hits, local_map_cache.num_queries);
+
+  /* Create the edges GSB by GSB */
+  size_t num_edges = rr_graph.edges().size();
+  for (const std::vector<std::pair<RRNodeId, RRNodeId>>& edges : gsb_edges) {
+    num_edges += edges.size();
+  }
+  rr_graph.reserve_edges(num_edges);
+
+  for (std::vector<std::pair<RRNodeId, RRNodeId>>& edges : gsb_edges) {
+    for (const std::pair<RRNodeId, RRNodeId>& edge : edges) {
+      rr_graph.create_edge(edge.first, edge.second, rr_node_driver_switches[edge.second]);
     }
+    /* Release the memory as soon as possible */
+    edges.clear();
+    edges.shrink_to_fit();
   }
 }
 
@@ -14,6 +14,7 @@
 #include "device_grid.h"
 #include "rr_graph_obj.h"
 #include "clb2clb_directs.h"
+#include "rr_gsb.h"
 
 /********************************************************************
  * Function declaration
@@ -31,7 +32,8 @@ void build_rr_graph_edges(RRGraph& rr_graph,
                           const std::vector<vtr::Matrix<int>>& Fc_out,
                           const e_switch_block_type& sb_type, const int& Fs,
                           const e_switch_block_type& sb_subtype, const int& subFs,
-                          const bool& wire_opposite_side);
+                          const bool& wire_opposite_side,
+                          std::vector<RRGSB>& rr_gsbs);
 
 void build_rr_graph_direct_connections(RRGraph& rr_graph, 
                                        const DeviceGrid& grids, 
@@ -41,6 +41,82 @@ enum e_track_status {
   NUM_TRACK_STATUS /* just a place holder to get the number of status */
 };
 
+/************************************************************************
+ * Find a connection map with a given signature in the cache
+ * Return nullptr if not found
+ * Maps are never modified once added to the cache, 
+ * so the map returned can be read without locking the cache
+ ***********************************************************************/
+static 
+const t_gsb_local_map* find_gsb_local_map(t_gsb_local_map_cache& local_map_cache,
+                                          const std::map<std::vector<int>, t_gsb_local_map>& local_maps,
+                                          const std::vector<int>& signature) {
+  std::lock_guard<std::mutex> lock(local_map_cache.mutex);
+  local_map_cache.num_queries++;
+  auto result = local_maps.find(signature);
+  if (result == local_maps.end()) {
+    return nullptr;
+  }
+  local_map_cache.num_hits++;
+  return &(result->second);
+}
+
+/************************************************************************
+ * Add a connection map with a given signature to the cache
+ * If another thread has added the map in the meantime, the existing map is kept,
+ * which is the same as the given one
+ ***********************************************************************/
+static 
+void add_gsb_local_map(t_gsb_local_map_cache& local_map_cache,
+                       std::map<std::vector<int>, t_gsb_local_map>& local_maps,
+                       const std::vector<int>& signature,
+                       const t_gsb_local_map& local_map) {
+  std::lock_guard<std::mutex> lock(local_map_cache.mutex);
+  local_maps.emplace(signature, local_map);
+}
+
+/************************************************************************
+ * Convert a connection map in the context of a GSB to the rr_nodes of the GSB,
+ * where each node is a routing track at a side of the GSB
+ ***********************************************************************/
+static 
+std::vector<std::vector<std::vector<RRNodeId>>> get_gsb_local_map_chan_nodes(const RRGSB& rr_gsb,
+                                                                              const t_gsb_local_map& local_map) {
+  std::vector<std::vector<std::vector<RRNodeId>>> node_map(local_map.size());
+  for (size_t side = 0; side < local_map.size(); ++side) {
+    node_map[side].resize(local_map[side].size());
+    for (size_t inode = 0; inode < local_map[side].size(); ++inode) {
+      node_map[side][inode].reserve(local_map[side][inode].size());
+      for (const std::pair<size_t, size_t>& local_node : local_map[side][inode]) {
+        SideManager side_manager(local_node.first);
+        node_map[side][inode].push_back(rr_gsb.get_chan_node(side_manager.get_side(), local_node.second));
+      }
+    }
+  }
+  return node_map;
+}
+
+/************************************************************************
+ * Convert a connection map in the context of a GSB to the rr_nodes of the GSB,
+ * where each node is an IPIN at a side of the GSB
+ ***********************************************************************/
+static 
+std::vector<std::vector<std::vector<RRNodeId>>> get_gsb_local_map_ipin_nodes(const RRGSB& rr_gsb,
+                                                                              const t_gsb_local_map& local_map) {
+  std::vector<std::vector<std::vector<RRNodeId>>> node_map(local_map.size());
+  for (size_t side = 0; side < local_map.size(); ++side) {
+    node_map[side].resize(local_map[side].size());
+    for (size_t inode = 0; inode < local_map[side].size(); ++inode) {
+      node_map[side][inode].reserve(local_map[side][inode].size());
+      for (const std::pair<size_t, size_t>& local_node : local_map[side][inode]) {
+        SideManager side_manager(local_node.first);
+        node_map[side][inode].push_back(rr_gsb.get_ipin_node(side_manager.get_side(), local_node.second));
+      }
+    }
+  }
+  return node_map;
+}
+
 /************************************************************************
  * Check if a track starts from this GSB or not 
  * (xlow, ylow) should be same as the GSB side coordinate 
@@ -325,7 +401,7 @@ void build_gsb_one_group_track_to_track_map(const RRGraph& rr_graph,
                                             const bool& wire_opposite_side,
                                             const t_track_group& from_tracks, /* [0..gsb_side][track_indices] */
                                             const t_track_group& to_tracks, /* [0..gsb_side][track_indices] */
-                                            t_track2track_map& track2track_map) {
+                                            t_gsb_local_map& track2track_map) {
   for (size_t side = 0; side < from_tracks.size(); ++side) {
     SideManager side_manager(side);
     e_side from_side = side_manager.get_side();
@@ -381,15 +457,18 @@ void build_gsb_one_group_track_to_track_map(const RRGraph& rr_graph,
           /* to_track should be OUT_PORT */
           VTR_ASSERT(OUT_PORT == rr_gsb.get_chan_node_direction(to_side, to_track_index)); 
 
-          /* Check if the to_track_node is already in the list ! */
-          std::vector<RRNodeId>::iterator it = std::find(track2track_map[from_side_index][from_track_index].begin(),
-                                                         track2track_map[from_side_index][from_track_index].end(),
-                                                         to_track_node);
+          /* Check if the to_track_node is already in the list ! 
+           * Tracks are represented by their sides and indices in the GSB context
+           */
+          std::pair<size_t, size_t> to_track_local_node(to_side_index, to_track_index);
+          std::vector<std::pair<size_t, size_t>>::iterator it = std::find(track2track_map[from_side_index][from_track_index].begin(),
+                                                                          track2track_map[from_side_index][from_track_index].end(),
+                                                                          to_track_local_node);
           if (it != track2track_map[from_side_index][from_track_index].end()) {
              continue; /* the node_id is already in the list, go for the next */
           }
           /* Clear, we should add to the list */
-          track2track_map[from_side_index][from_track_index].push_back(to_track_node);
+          track2track_map[from_side_index][from_track_index].push_back(to_track_local_node);
         }
       }
     }
@@ -439,6 +518,9 @@ void build_gsb_one_group_track_to_track_map(const RRGraph& rr_graph,
  *    a. tracks that will bypass at the TOP side
  *    b. tracks that will bypass at the BOTTOM side
  * 5. Apply switch block patterns to Group 2 (SUBSET, UNIVERSAL, WILTON) 
+ *
+ * The mapping only depends on the channel widths and the groups of tracks in the GSB context.
+ * When a cache is given, the mapping is shared by the GSBs with the same channel widths and groups
  ***********************************************************************/
 t_track2track_map build_gsb_track_to_track_map(const RRGraph& rr_graph,
                                                const RRGSB& rr_gsb,
@@ -447,8 +529,9 @@ t_track2track_map build_gsb_track_to_track_map(const RRGraph& rr_graph,
                                                const e_switch_block_type& sb_subtype, 
                                                const int& subFs,
                                                const bool& wire_opposite_side,
-                                               const std::vector<t_segment_inf>& segment_inf) {
-  t_track2track_map track2track_map; /* [0..gsb_side][0..chan_width][track_indices] */
+                                               const std::vector<t_segment_inf>& segment_inf,
+                                               t_gsb_local_map_cache* local_map_cache) {
+  t_gsb_local_map track2track_map; /* [0..gsb_side][0..chan_width][track_indices] */
 
   /* Categorize tracks into 3 groups: 
    * (1) tracks will start here 
@@ -502,6 +585,25 @@ t_track2track_map build_gsb_track_to_track_map(const RRGraph& rr_graph,
     }
   }
 
+  /* Build the signature of the GSB context which the mapping depends on */
+  std::vector<int> signature{int(sb_type), Fs, int(sb_subtype), subFs, int(wire_opposite_side)};
+  for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+    SideManager side_manager(side);
+    signature.push_back(rr_gsb.get_chan_width(side_manager.get_side()));
+    for (const t_track_group* track_group : {&start_tracks, &end_tracks, &pass_tracks}) {
+      signature.push_back((*track_group)[side].size());
+      signature.insert(signature.end(), (*track_group)[side].begin(), (*track_group)[side].end());
+    }
+  }
+
+  /* Reuse the mapping of a GSB with the same context */
+  if (nullptr != local_map_cache) {
+    const t_gsb_local_map* cached_map = find_gsb_local_map(*local_map_cache, local_map_cache->track2track_maps, signature);
+    if (nullptr != cached_map) {
+      return get_gsb_local_map_chan_nodes(rr_gsb, *cached_map);
+    }
+  }
+
   /* Allocate track2track map */
   track2track_map.resize(rr_gsb.get_num_sides());
   for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
@@ -532,7 +634,11 @@ t_track2track_map build_gsb_track_to_track_map(const RRGraph& rr_graph,
                                          pass_tracks, start_tracks, 
                                          track2track_map);
 
-  return track2track_map;
+  if (nullptr != local_map_cache) {
+    add_gsb_local_map(*local_map_cache, local_map_cache->track2track_maps, signature, track2track_map);
+  }
+
+  return get_gsb_local_map_chan_nodes(rr_gsb, track2track_map);
 }
 
 /* Build a RRChan Object with the given channel type and coorindators */
@@ -897,17 +1003,18 @@ RRGSB build_one_tileable_rr_gsb(const DeviceGrid& grids,
 }
 
 /************************************************************************
- * Create edges for each rr_node of a General Switch Blocks (GSB):
- * 1. create edges between CHANX | CHANY and IPINs (connections inside connection blocks) 
- * 2. create edges between OPINs, CHANX and CHANY (connections inside switch blocks) 
- * 3. create edges between OPINs and IPINs (direct-connections) 
+ * Find the edges for each rr_node of a General Switch Blocks (GSB):
+ * 1. edges between CHANX | CHANY and IPINs (connections inside connection blocks) 
+ * 2. edges between OPINs, CHANX and CHANY (connections inside switch blocks) 
+ * 3. edges between OPINs and IPINs (direct-connections) 
+ * Each edge is a pair of its source and sink nodes
+ * The rr_graph is not modified here, so that GSBs can be handled in parallel
  ***********************************************************************/
-void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph, 
-                                         const RRGSB& rr_gsb,
-                                         const t_track2pin_map& track2ipin_map,
-                                         const t_pin2track_map& opin2track_map,
-                                         const t_track2track_map& track2track_map,
-                                         const vtr::vector<RRNodeId, RRSwitchId>& rr_node_driver_switches) {
+std::vector<std::pair<RRNodeId, RRNodeId>> find_edges_for_one_tileable_rr_gsb(const RRGSB& rr_gsb,
+                                                                              const t_track2pin_map& track2ipin_map,
+                                                                              const t_pin2track_map& opin2track_map,
+                                                                              const t_track2track_map& track2track_map) {
+  std::vector<std::pair<RRNodeId, RRNodeId>> edges;
   
   /* Walk through each sides */ 
   for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
@@ -921,7 +1028,7 @@ void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph,
       /* 1. create edges between OPINs and CHANX|CHANY, using opin2track_map */
       /* add edges to the opin_node */
       for (const RRNodeId& track_node : opin2track_map[gsb_side][inode]) {
-        rr_graph.create_edge(opin_node, track_node, rr_node_driver_switches[track_node]);
+        edges.push_back(std::make_pair(opin_node, track_node));
       }
     }
 
@@ -935,7 +1042,7 @@ void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph,
       for (size_t inode = 0; inode < rr_gsb.get_chan_width(gsb_side); ++inode) {
         const RRNodeId& chan_node = rr_gsb.get_chan_node(gsb_side, inode); 
         for (const RRNodeId& ipin_node : track2ipin_map[gsb_side][inode]) {
-          rr_graph.create_edge(chan_node, ipin_node, rr_node_driver_switches[ipin_node]);
+          edges.push_back(std::make_pair(chan_node, ipin_node));
         }
       }
     }
@@ -944,10 +1051,29 @@ void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph,
     for (size_t inode = 0; inode < rr_gsb.get_chan_width(gsb_side); ++inode) {
       const RRNodeId& chan_node = rr_gsb.get_chan_node(gsb_side, inode); 
       for (const RRNodeId& track_node : track2track_map[gsb_side][inode]) {
-        rr_graph.create_edge(chan_node, track_node, rr_node_driver_switches[track_node]);
+        edges.push_back(std::make_pair(chan_node, track_node));
       }
     }
   }
+
+  return edges;
+}
+
+/************************************************************************
+ * Create edges for each rr_node of a General Switch Blocks (GSB):
+ * 1. create edges between CHANX | CHANY and IPINs (connections inside connection blocks) 
+ * 2. create edges between OPINs, CHANX and CHANY (connections inside switch blocks) 
+ * 3. create edges between OPINs and IPINs (direct-connections) 
+ ***********************************************************************/
+void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph, 
+                                         const RRGSB& rr_gsb,
+                                         const t_track2pin_map& track2ipin_map,
+                                         const t_pin2track_map& opin2track_map,
+                                         const t_track2track_map& track2track_map,
+                                         const vtr::vector<RRNodeId, RRSwitchId>& rr_node_driver_switches) {
+  for (const std::pair<RRNodeId, RRNodeId>& edge : find_edges_for_one_tileable_rr_gsb(rr_gsb, track2ipin_map, opin2track_map, track2track_map)) {
+    rr_graph.create_edge(edge.first, edge.second, rr_node_driver_switches[edge.second]);
+  }
 }
 
 /************************************************************************
@@ -969,14 +1095,15 @@ void build_gsb_one_ipin_track2pin_map(const RRGraph& rr_graph,
                                       const std::vector<int>& Fc, 
                                       const size_t& offset, 
                                       const std::vector<t_segment_inf>& segment_inf, 
-                                      t_track2pin_map& track2ipin_map) {
+                                      t_gsb_local_map& track2ipin_map) {
   /* Get a list of segment_ids*/
   enum e_side chan_side = rr_gsb.get_cb_chan_side(ipin_side);
   SideManager chan_side_manager(chan_side);
   std::vector<RRSegmentId> seg_list = rr_gsb.get_chan_segment_ids(chan_side);
   size_t chan_width = rr_gsb.get_chan_width(chan_side);
   SideManager ipin_side_manager(ipin_side);
-  const RRNodeId& ipin_node = rr_gsb.get_ipin_node(ipin_side, ipin_node_id);
+  /* The IPIN is represented by its side and index in the GSB context */
+  std::pair<size_t, size_t> ipin_node(ipin_side_manager.to_size_t(), ipin_node_id);
 
   for (size_t iseg = 0; iseg < seg_list.size(); ++iseg) {
     /* Get a list of node that have the segment id */
@@ -1063,7 +1190,7 @@ void build_gsb_one_opin_pin2track_map(const RRGraph& rr_graph,
                                       const std::vector<int>& Fc,
                                       const size_t& offset, 
                                       const std::vector<t_segment_inf>& segment_inf, 
-                                      t_pin2track_map& opin2track_map) {
+                                      t_gsb_local_map& opin2track_map) {
   /* Get a list of segment_ids*/
   std::vector<RRSegmentId> seg_list = rr_gsb.get_chan_segment_ids(opin_side);
   enum e_side chan_side = opin_side;
@@ -1122,8 +1249,8 @@ void build_gsb_one_opin_pin2track_map(const RRGraph& rr_graph,
       /* itrack may exceed the size of actual_track_list, adapt it */
       size_t actual_itrack = itrack % actual_track_list.size();
       size_t track_index = actual_track_list[actual_itrack];
-      const RRNodeId& track_rr_node_index = rr_gsb.get_chan_node(chan_side, track_index);
-      opin2track_map[opin_side_index][opin_node_id].push_back(track_rr_node_index);
+      /* The track is represented by its side and index in the GSB context */
+      opin2track_map[opin_side_index][opin_node_id].push_back(std::make_pair(size_t(opin_side_manager.to_size_t()), track_index));
       /* update track counter */
       track_cnt++;
       /* Stop when we have enough Fc: this may lead to some tracks have zero drivers. 
@@ -1147,6 +1274,44 @@ void build_gsb_one_opin_pin2track_map(const RRGraph& rr_graph,
 }
 
 
+/************************************************************************
+ * Find the Fc of a pin to the routing tracks of each segment
+ * Return an empty list if the pin should not be connected to any routing track, i.e., 
+ * the pin is in an EMPTY grid or its Fc is 0 or unintialized (those pins are in the <directlist>)
+ ***********************************************************************/
+static 
+std::vector<int> get_gsb_pin_Fc(const RRGraph& rr_graph,
+                                const DeviceGrid& grids, 
+                                const RRNodeId& pin_node,
+                                const std::vector<t_segment_inf>& segment_inf, 
+                                const std::vector<vtr::Matrix<int>>& Fc) {
+  std::vector<int> pin_Fc;
+
+  /* Skip EMPTY type */
+  if (true == is_empty_type(grids[rr_graph.node_xlow(pin_node)][rr_graph.node_ylow(pin_node)].type)) {
+    return pin_Fc;
+  }
+
+  int grid_type_index = grids[rr_graph.node_xlow(pin_node)][rr_graph.node_ylow(pin_node)].type->index; 
+  /* Get Fc of the pin */
+  /* skip Fc = 0 or unintialized, those pins are in the <directlist> */
+  bool skip_conn2track = true; 
+  for (size_t iseg = 0; iseg < segment_inf.size(); ++iseg) {
+    int seg_Fc = Fc[grid_type_index][rr_graph.node_pin_num(pin_node)][iseg];
+    pin_Fc.push_back(seg_Fc);
+    if (0 != seg_Fc) { 
+      skip_conn2track = false;
+      break;
+    }
+  }
+
+  if (true == skip_conn2track) {
+    pin_Fc.clear();
+  }
+
+  return pin_Fc;
+}
+
 /************************************************************************
  * Build the track_to_ipin_map[gsb_side][0..chan_width-1][ipin_indices] 
  * based on the existing routing resources in the General Switch Block (GSB)
@@ -1156,13 +1321,58 @@ void build_gsb_one_opin_pin2track_map(const RRGraph& rr_graph,
  *    For each IPIN, we ensure at least one connection to the tracks.
  *    Then, we assign IPINs to tracks evenly while satisfying the actual_Fc 
  * 2. Convert the ipin_to_track_map to track_to_ipin_map
+ *
+ * The mapping only depends on the Fc of each IPIN, the segments of each track 
+ * and whether each track has a connection block in the GSB.
+ * When a cache is given, the mapping is shared by the GSBs with the same context
  ***********************************************************************/
 t_track2pin_map build_gsb_track_to_ipin_map(const RRGraph& rr_graph,
                                             const RRGSB& rr_gsb, 
                                             const DeviceGrid& grids, 
                                             const std::vector<t_segment_inf>& segment_inf, 
-                                            const std::vector<vtr::Matrix<int>>& Fc_in) {
-  t_track2pin_map track2ipin_map;
+                                            const std::vector<vtr::Matrix<int>>& Fc_in,
+                                            t_gsb_local_map_cache* local_map_cache) {
+  /* Find the Fc of each IPIN and build the signature of the GSB context which the mapping depends on */
+  std::vector<std::vector<std::vector<int>>> ipin_Fcs(rr_gsb.get_num_sides());
+  std::vector<int> signature;
+  for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+    SideManager side_manager(side);
+    enum e_side ipin_side = side_manager.get_side();
+    enum e_side chan_side = rr_gsb.get_cb_chan_side(ipin_side);
+    size_t chan_width = rr_gsb.get_chan_width(chan_side);
+    signature.push_back(size_t(chan_side));
+    signature.push_back(chan_width);
+
+    bool has_conn2track = false;
+    signature.push_back(rr_gsb.get_num_ipin_nodes(ipin_side));
+    for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(ipin_side); ++inode) {
+      ipin_Fcs[side].push_back(get_gsb_pin_Fc(rr_graph, grids, rr_gsb.get_ipin_node(ipin_side, inode), segment_inf, Fc_in));
+      signature.push_back(ipin_Fcs[side].back().size());
+      signature.insert(signature.end(), ipin_Fcs[side].back().begin(), ipin_Fcs[side].back().end());
+      if (false == ipin_Fcs[side].back().empty()) {
+        has_conn2track = true;
+      }
+    }
+
+    /* The connection block population is only checked for the tracks to be connected */
+    if (false == has_conn2track) {
+      continue;
+    }
+    for (size_t itrack = 0; itrack < chan_width; ++itrack) {
+      signature.push_back(size_t(rr_gsb.get_chan_node_segment(chan_side, itrack)));
+      signature.push_back(is_gsb_in_track_cb_population(rr_graph, rr_gsb, chan_side, itrack, segment_inf));
+    }
+  }
+
+  /* Reuse the mapping of a GSB with the same context */
+  if (nullptr != local_map_cache) {
+    const t_gsb_local_map* cached_map = find_gsb_local_map(*local_map_cache, local_map_cache->track2ipin_maps, signature);
+    if (nullptr != cached_map) {
+      return get_gsb_local_map_ipin_nodes(rr_gsb, *cached_map);
+    }
+  }
+
+  t_gsb_local_map track2ipin_map;
   /* Resize the matrix */ 
   track2ipin_map.resize(rr_gsb.get_num_sides());
   
@@ -1195,27 +1405,9 @@ t_track2pin_map build_gsb_track_to_ipin_map(const RRGraph& rr_graph,
     track2ipin_map[chan_side_manager.to_size_t()].resize(chan_width); 
     /* Find the ipin/opin nodes */
     for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(ipin_side); ++inode) {
-      const RRNodeId& ipin_node = rr_gsb.get_ipin_node(ipin_side, inode);
-      /* Skip EMPTY type */
-      if (true == is_empty_type(grids[rr_graph.node_xlow(ipin_node)][rr_graph.node_ylow(ipin_node)].type)) {
-        continue;
-      }
-
-      int grid_type_index = grids[rr_graph.node_xlow(ipin_node)][rr_graph.node_ylow(ipin_node)].type->index; 
-      /* Get Fc of the ipin */
-      /* skip Fc = 0 or unintialized, those pins are in the <directlist> */
-      bool skip_conn2track = true; 
-      std::vector<int> ipin_Fc_out;
-      for (size_t iseg = 0; iseg < segment_inf.size(); ++iseg) {
-        int ipin_Fc = Fc_in[grid_type_index][rr_graph.node_pin_num(ipin_node)][iseg];
-        ipin_Fc_out.push_back(ipin_Fc);
-        if (0 != ipin_Fc) { 
-          skip_conn2track = false;
-          break;
-        }
-      }
-
-      if (true == skip_conn2track) {
+      /* Skip EMPTY type and the IPINs without any connection to tracks */
+      const std::vector<int>& ipin_Fc_out = ipin_Fcs[side][inode];
+      if (true == ipin_Fc_out.empty()) {
         continue;
       }
 
@@ -1232,7 +1424,11 @@ t_track2pin_map build_gsb_track_to_ipin_map(const RRGraph& rr_graph,
     }
   }
 
-  return track2ipin_map;
+  if (nullptr != local_map_cache) {
+    add_gsb_local_map(*local_map_cache, local_map_cache->track2ipin_maps, signature, track2ipin_map);
+  }
+
+  return get_gsb_local_map_ipin_nodes(rr_gsb, track2ipin_map);
 }
 
 /************************************************************************
@@ -1246,13 +1442,57 @@ t_track2pin_map build_gsb_track_to_ipin_map(const RRGraph& rr_graph,
  *    the connections between OPINs and different types of routing tracks.
  * 3. Scale the Fc of each pin to the actual number of routing tracks
  *    actual_Fc = (int) Fc * num_tracks / chan_width
+ *
+ * The mapping only depends on the Fc of each OPIN, the segments of each track 
+ * and whether each track starts in the GSB with a switch block.
+ * When a cache is given, the mapping is shared by the GSBs with the same context
  ***********************************************************************/
 t_pin2track_map build_gsb_opin_to_track_map(const RRGraph& rr_graph,
                                             const RRGSB& rr_gsb, 
                                             const DeviceGrid& grids, 
                                             const std::vector<t_segment_inf>& segment_inf, 
-                                            const std::vector<vtr::Matrix<int>>& Fc_out) {
-  t_pin2track_map opin2track_map;
+                                            const std::vector<vtr::Matrix<int>>& Fc_out,
+                                            t_gsb_local_map_cache* local_map_cache) {
+  /* Find the Fc of each OPIN and build the signature of the GSB context which the mapping depends on */
+  std::vector<std::vector<std::vector<int>>> opin_Fcs(rr_gsb.get_num_sides());
+  std::vector<int> signature;
+  for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+    SideManager side_manager(side);
+    enum e_side opin_side = side_manager.get_side();
+    size_t chan_width = rr_gsb.get_chan_width(opin_side);
+    signature.push_back(chan_width);
+
+    bool has_conn2track = false;
+    signature.push_back(rr_gsb.get_num_opin_nodes(opin_side));
+    for (size_t inode = 0; inode < rr_gsb.get_num_opin_nodes(opin_side); ++inode) {
+      opin_Fcs[side].push_back(get_gsb_pin_Fc(rr_graph, grids, rr_gsb.get_opin_node(opin_side, inode), segment_inf, Fc_out));
+      signature.push_back(opin_Fcs[side].back().size());
+      signature.insert(signature.end(), opin_Fcs[side].back().begin(), opin_Fcs[side].back().end());
+      if (false == opin_Fcs[side].back().empty()) {
+        has_conn2track = true;
+      }
+    }
+
+    /* The switch block population is only checked for the tracks to be connected */
+    if (false == has_conn2track) {
+      continue;
+    }
+    for (size_t itrack = 0; itrack < chan_width; ++itrack) {
+      signature.push_back(size_t(rr_gsb.get_chan_node_segment(opin_side, itrack)));
+      signature.push_back( (true == is_gsb_in_track_sb_population(rr_graph, rr_gsb, opin_side, itrack, segment_inf))
+                        && (TRACK_START == determine_track_status_of_gsb(rr_graph, rr_gsb, opin_side, itrack)) );
+    }
+  }
+
+  /* Reuse the mapping of a GSB with the same context */
+  if (nullptr != local_map_cache) {
+    const t_gsb_local_map* cached_map = find_gsb_local_map(*local_map_cache, local_map_cache->opin2track_maps, signature);
+    if (nullptr != cached_map) {
+      return get_gsb_local_map_chan_nodes(rr_gsb, *cached_map);
+    }
+  }
+
+  t_gsb_local_map opin2track_map;
   /* Resize the matrix */ 
   opin2track_map.resize(rr_gsb.get_num_sides());
   
@@ -1274,27 +1514,9 @@ t_pin2track_map build_gsb_opin_to_track_map(const RRGraph& rr_graph,
     opin2track_map[side].resize(num_opin_nodes); 
     /* Find the ipin/opin nodes */
     for (size_t inode = 0; inode < num_opin_nodes; ++inode) {
-      const RRNodeId& opin_node = rr_gsb.get_opin_node(opin_side, inode);
-      /* Skip EMPTY type */
-      if (true == is_empty_type(grids[rr_graph.node_xlow(opin_node)][rr_graph.node_ylow(opin_node)].type)) {
-        continue;
-      }
-      int grid_type_index = grids[rr_graph.node_xlow(opin_node)][rr_graph.node_ylow(opin_node)].type->index; 
-
-      /* Get Fc of the ipin */
-      /* skip Fc = 0 or unintialized, those pins are in the <directlist> */
-      bool skip_conn2track = true; 
-      std::vector<int> opin_Fc_out;
-      for (size_t iseg = 0; iseg < segment_inf.size(); ++iseg) {
-        int opin_Fc = Fc_out[grid_type_index][rr_graph.node_pin_num(opin_node)][iseg];
-        opin_Fc_out.push_back(opin_Fc);
-        if (0 != opin_Fc) { 
-          skip_conn2track = false;
-          break;
-        }
-      }
-
-      if (true == skip_conn2track) {
+      /* Skip EMPTY type and the OPINs without any connection to tracks */
+      const std::vector<int>& opin_Fc_out = opin_Fcs[side][inode];
+      if (true == opin_Fc_out.empty()) {
         continue;
       }
       VTR_ASSERT(opin_Fc_out.size() == segment_inf.size());
@@ -1313,7 +1535,11 @@ t_pin2track_map build_gsb_opin_to_track_map(const RRGraph& rr_graph,
      * 2. We want to ensure that each track will be driven by at least 1 OPIN */
   }
 
-  return opin2track_map;
+  if (nullptr != local_map_cache) {
+    add_gsb_local_map(*local_map_cache, local_map_cache->opin2track_maps, signature, opin2track_map);
+  }
+
+  return get_gsb_local_map_chan_nodes(rr_gsb, opin2track_map);
 }
 
 /************************************************************************
@@ -4,6 +4,9 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <map>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 #include "vtr_vector.h"
@@ -30,6 +33,26 @@ typedef std::vector<std::vector<std::vector<RRNodeId>>> t_track2track_map;
 typedef std::vector<std::vector<std::vector<RRNodeId>>> t_track2pin_map;
 typedef std::vector<std::vector<std::vector<RRNodeId>>> t_pin2track_map;
 
+/* A connection map in the context of a GSB, where each node is represented 
+ * by its side and its index on the side, rather than its id in the rr_graph
+ * [0..gsb_side][0..num_nodes-1][(side, node_index)]
+ */
+typedef std::vector<std::vector<std::vector<std::pair<size_t, size_t>>>> t_gsb_local_map;
+
+/* Connection maps in the context of GSBs, which are shared by the GSBs 
+ * with the same local routing resources, e.g., channel widths, segments, pins and Fc
+ * Each map is indexed by a signature of the local routing resources it depends on
+ * The cache can be shared by a number of threads
+ */
+struct t_gsb_local_map_cache {
+  std::map<std::vector<int>, t_gsb_local_map> track2track_maps;
+  std::map<std::vector<int>, t_gsb_local_map> track2ipin_maps;
+  std::map<std::vector<int>, t_gsb_local_map> opin2track_maps;
+  size_t num_hits = 0;
+  size_t num_queries = 0;
+  std::mutex mutex;
+};
+
 /************************************************************************
  * Functions 
  ***********************************************************************/
@@ -40,7 +63,8 @@ t_track2track_map build_gsb_track_to_track_map(const RRGraph& rr_graph,
                                                const e_switch_block_type& sb_subtype, 
                                                const int& subFs,
                                                const bool& wire_opposite_side,
-                                               const std::vector<t_segment_inf>& segment_inf);
+                                               const std::vector<t_segment_inf>& segment_inf,
+                                               t_gsb_local_map_cache* local_map_cache = nullptr);
 
 RRGSB build_one_tileable_rr_gsb(const DeviceGrid& grids, 
                                 const RRGraph& rr_graph,
@@ -48,6 +72,11 @@ RRGSB build_one_tileable_rr_gsb(const DeviceGrid& grids,
                                 const std::vector<t_segment_inf>& segment_inf,
                                 const vtr::Point<size_t>& gsb_coordinate);
 
+std::vector<std::pair<RRNodeId, RRNodeId>> find_edges_for_one_tileable_rr_gsb(const RRGSB& rr_gsb,
+                                                                              const t_track2pin_map& track2ipin_map,
+                                                                              const t_pin2track_map& opin2track_map,
+                                                                              const t_track2track_map& track2track_map);
+
 void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph, 
                                          const RRGSB& rr_gsb,
                                          const t_track2pin_map& track2ipin_map,
@@ -59,13 +88,15 @@ t_track2pin_map build_gsb_track_to_ipin_map(const RRGraph& rr_graph,
                                             const RRGSB& rr_gsb, 
                                             const DeviceGrid& grids, 
                                             const std::vector<t_segment_inf>& segment_inf, 
-                                            const std::vector<vtr::Matrix<int>>& Fc_in);
+                                            const std::vector<vtr::Matrix<int>>& Fc_in,
+                                            t_gsb_local_map_cache* local_map_cache = nullptr);
 
 t_pin2track_map build_gsb_opin_to_track_map(const RRGraph& rr_graph,
                                             const RRGSB& rr_gsb, 
                                             const DeviceGrid& grids, 
                                             const std::vector<t_segment_inf>& segment_inf, 
-                                            const std::vector<vtr::Matrix<int>>& Fc_out);
+                                            const std::vector<vtr::Matrix<int>>& Fc_out,
+                                            t_gsb_local_map_cache* local_map_cache = nullptr);
 
 void build_direct_connections_for_one_gsb(RRGraph& rr_graph,
                                           const DeviceGrid& grids,
@@ -1,5 +1,8 @@
 #ifndef VPR_CLB_DELAY_CALC_H
 #define VPR_CLB_DELAY_CALC_H
+#include <unordered_map>
+#include <vector>
+
 #include "DelayType.h"
 
 //Delay Calculator for routing internal to a clustered logic block
@@ -21,10 +24,18 @@ class ClbDelayCalc {
 
     float pb_route_delay(ClusterBlockId clb, int pb_route_idx, DelayType delay_type) const;
     const t_pb_graph_edge* find_pb_graph_edge(ClusterBlockId clb, int pb_route_idx) const;
-    const t_pb_graph_edge* find_pb_graph_edge(const t_pb_graph_pin* driver, const t_pb_graph_pin* sink) const;
+    const t_pb_graph_edge* find_pb_graph_edge(int type_index, int driver_pb_route_idx, int sink_pb_route_idx) const;
 
   private:
     IntraLbPbPinLookup intra_lb_pb_pin_lookup_;
+
+    //The pb_graph edge between each (driver, sink) pair of pb pins of each logical block type,
+    //keyed by driver_pin * total_pb_pins + sink_pin
+    //
+    //The same pin pairs are found for every block of a type (and at every timing analysis), so they
+    //are looked-up once here instead of scanning the driver output edges each time. This is only
+    //read after construction, so it can be used by concurrent timing analyses.
+    std::vector<std::unordered_map<size_t, const t_pb_graph_edge*>> pb_graph_edges_;
 };
 
 #include "clb_delay_calc.inl"
@@ -7,7 +7,31 @@
  */
 
 inline ClbDelayCalc::ClbDelayCalc()
-    : intra_lb_pb_pin_lookup_(g_vpr_ctx.device().logical_block_types) {}
+    : intra_lb_pb_pin_lookup_(g_vpr_ctx.device().logical_block_types) {
+    const auto& logical_block_types = g_vpr_ctx.device().logical_block_types;
+
+    pb_graph_edges_.resize(logical_block_types.size());
+    for (const t_logical_block_type& type : logical_block_types) {
+        if (!type.pb_graph_head) continue; //Empty type
+
+        size_t total_pb_pins = type.pb_graph_head->total_pb_pins;
+        for (size_t ipin = 0; ipin < total_pb_pins; ++ipin) {
+            const t_pb_graph_pin* driver = intra_lb_pb_pin_lookup_.pb_gpin(type.index, ipin);
+            if (!driver) continue;
+
+            for (int iedge = 0; iedge < driver->num_output_edges; ++iedge) {
+                const t_pb_graph_edge* edge = driver->output_edges[iedge];
+                VTR_ASSERT(edge);
+
+                VTR_ASSERT(edge->num_output_pins == 1);
+                size_t sink_pin = edge->output_pins[0]->pin_count_in_cluster;
+
+                //The last edge wins if several connect the same pins
+                pb_graph_edges_[type.index][ipin * total_pb_pins + sink_pin] = edge;
+            }
+        }
+    }
+}
 
 inline float ClbDelayCalc::clb_input_to_internal_sink_delay(const ClusterBlockId block_id, const int pin_index, int internal_sink_pin, DelayType delay_type) const {
     return trace_delay(block_id, pin_index, internal_sink_pin, delay_type);
@@ -79,33 +103,20 @@ inline const t_pb_graph_edge* ClbDelayCalc::find_pb_graph_edge(ClusterBlockId cl
 
         if(upstream_pb_route_idx >= 0) {
 
-            const t_pb_graph_pin* pb_gpin = intra_lb_pb_pin_lookup_.pb_gpin(type_index, pb_route_idx);
-            const t_pb_graph_pin* upstream_pb_gpin = intra_lb_pb_pin_lookup_.pb_gpin(type_index, upstream_pb_route_idx);
-
-            return find_pb_graph_edge(upstream_pb_gpin, pb_gpin); 
+            return find_pb_graph_edge(type_index, upstream_pb_route_idx, pb_route_idx);
         }
     }
 
     return nullptr;
 }
 
-inline const t_pb_graph_edge* ClbDelayCalc::find_pb_graph_edge(const t_pb_graph_pin* driver, const t_pb_graph_pin* sink) const {
-    VTR_ASSERT(driver);
-    VTR_ASSERT(sink);
-
-    const t_pb_graph_edge* pb_edge = nullptr;
-    for(int iedge = 0; iedge < driver->num_output_edges; ++iedge) {
-        const t_pb_graph_edge* check_edge = driver->output_edges[iedge];
-        VTR_ASSERT(check_edge);
+inline const t_pb_graph_edge* ClbDelayCalc::find_pb_graph_edge(int type_index, int driver_pb_route_idx, int sink_pb_route_idx) const {
+    const auto& type_pb_graph_edges = pb_graph_edges_[type_index];
+    size_t total_pb_pins = g_vpr_ctx.device().logical_block_types[type_index].pb_graph_head->total_pb_pins;
 
-        VTR_ASSERT(check_edge->num_output_pins == 1);
-        if(check_edge->output_pins[0] == sink) {
-            pb_edge = check_edge;
-        }
-
-    }
-    VTR_ASSERT_MSG(pb_edge, "Should find pb_graph_edge connecting PB pins");
+    auto itr = type_pb_graph_edges.find(size_t(driver_pb_route_idx) * total_pb_pins + sink_pb_route_idx);
+    VTR_ASSERT_MSG(itr != type_pb_graph_edges.end(), "Should find pb_graph_edge connecting PB pins");
 
-    return pb_edge;
+    return itr->second;
 }
 
@@ -133,6 +133,10 @@ class ConcreteSetupTimingInfo : public SetupTimingInfo {
         slack_crit_.update_slacks_and_criticalities(*timing_graph_, *setup_analyzer_);
     }
 
+    void invalidate_delay(const tatum::EdgeId edge) override {
+        setup_analyzer_->invalidate_edge(edge);
+    }
+
     void set_warn_unconstrained(bool val) override { warn_unconstrained_ = val; }
 
   private:
@@ -243,6 +247,10 @@ class ConcreteHoldTimingInfo : public HoldTimingInfo {
         slack_crit_.update_slacks_and_criticalities(*timing_graph_, *hold_analyzer_);
     }
 
+    void invalidate_delay(const tatum::EdgeId edge) override {
+        hold_analyzer_->invalidate_edge(edge);
+    }
+
     void set_warn_unconstrained(bool val) override { warn_unconstrained_ = val; }
 
   private:
@@ -348,6 +356,8 @@ class ConcreteSetupHoldTimingInfo : public SetupHoldTimingInfo {
         timing_ctx.stats.num_full_setup_hold_updates += 1;
     }
 
+    void invalidate_delay(const tatum::EdgeId edge) override { setup_hold_analyzer_->invalidate_edge(edge); }
+
     //Update hold only
     void update_hold() override { hold_timing_.update_hold(); }
 
@@ -420,6 +430,7 @@ class ConstantTimingInfo : public SetupHoldTimingInfo {
 
   public: //Mutators
     void update() override {}
+    void invalidate_delay(const tatum::EdgeId /*edge*/) override {}
     void update_hold() override {}
     void update_setup() override {}
 
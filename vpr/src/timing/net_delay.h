@@ -1,6 +1,8 @@
 #ifndef NET_DELAY_H
 #define NET_DELAY_H
 
+#include <vector>
+
 #include "vtr_memory.h"
 #include "vtr_vector.h"
 
@@ -11,4 +13,7 @@ void free_net_delay(vtr::vector<ClusterNetId, float*>& net_delay,
 
 void load_net_delay_from_routing(vtr::vector<ClusterNetId, float*>& net_delay);
 
+//Loads the delays of the given nets only
+void load_net_delay_from_routing(vtr::vector<ClusterNetId, float*>& net_delay, const std::vector<ClusterNetId>& nets);
+
 #endif
@@ -1,15 +1,57 @@
+#include <algorithm>
+
 #include "slack_evaluation.h"
 
 #include "tatum/TimingGraph.hpp"
 #include "timing_util.h"
 #include "vpr_error.h"
 #include "atom_netlist.h"
+#include "atom_lookup.h"
 #include "vtr_log.h"
 
 #if defined(VPR_USE_TBB)
 #    include <tbb/task_group.h>
 #    include <tbb/parallel_for_each.h>
 #endif
+
+//Returns true if the last timing update of analyzer was incremental, and collects
+//the pins of the timing nodes it modified
+static bool collect_modified_pins(const AtomLookup& netlist_lookup,
+                                  const tatum::TimingGraph& timing_graph,
+                                  const tatum::TimingAnalyzer& analyzer,
+                                  std::vector<AtomPinId>& modified_pins) {
+    modified_pins.clear();
+
+    auto modified_nodes = analyzer.modified_nodes();
+    if (modified_nodes.size() >= timing_graph.nodes().size()) {
+        return false;
+    }
+
+    for (tatum::NodeId node : modified_nodes) {
+        AtomPinId pin = netlist_lookup.tnode_atom_pin(node);
+        if (pin) {
+            modified_pins.push_back(pin);
+        }
+    }
+
+    //A pin may have both an external and an internal timing node
+    std::sort(modified_pins.begin(), modified_pins.end());
+    modified_pins.erase(std::unique(modified_pins.begin(), modified_pins.end()), modified_pins.end());
+    return true;
+}
+
+//Calls fn on each pin (in parallel if enabled)
+template<class PinRange, class Func>
+static void for_each_pin(PinRange&& pins, const Func& fn) {
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for_each(pins.begin(), pins.end(), fn);
+#else
+    for (auto pin : pins) {
+        fn(pin);
+    }
+#endif
+}
+
 /*
  * SetupSlackCrit
  */
@@ -31,28 +73,30 @@ float SetupSlackCrit::setup_pin_slack(AtomPinId pin) const { return pin_slacks_[
 float SetupSlackCrit::setup_pin_criticality(AtomPinId pin) const { return pin_criticalities_[pin]; }
 
 void SetupSlackCrit::update_slacks_and_criticalities(const tatum::TimingGraph& timing_graph, const tatum::SetupTimingAnalyzer& analyzer) {
+    //After an incremental timing update only the pins of the modified timing nodes may have changed
+    bool incremental = collect_modified_pins(netlist_lookup_, timing_graph, analyzer, modified_pins_);
+
 #if defined(VPR_USE_TBB)
     tbb::task_group g;
-    g.run([&] { update_slacks(analyzer); });
-    g.run([&] { update_criticalities(timing_graph, analyzer); });
+    g.run([&] { update_slacks(analyzer, incremental); });
+    g.run([&] { update_criticalities(timing_graph, analyzer, incremental); });
     g.wait();
 #else
-    update_slacks(analyzer);
-    update_criticalities(timing_graph, analyzer);
+    update_slacks(analyzer, incremental);
+    update_criticalities(timing_graph, analyzer, incremental);
 #endif
 }
 
-void SetupSlackCrit::update_slacks(const tatum::SetupTimingAnalyzer& analyzer) {
-    auto pins = netlist_.pins();
-#if defined(VPR_USE_TBB)
-    tbb::parallel_for_each(pins.begin(), pins.end(), [&, this](auto pin) {
+void SetupSlackCrit::update_slacks(const tatum::SetupTimingAnalyzer& analyzer, bool incremental) {
+    auto update_pin = [&, this](AtomPinId pin) {
         this->update_pin_slack(pin, analyzer);
-    });
-#else
-    for (auto pin : pins) {
-        update_pin_slack(pin, analyzer);
+    };
+
+    if (incremental) {
+        for_each_pin(modified_pins_, update_pin);
+    } else {
+        for_each_pin(netlist_.pins(), update_pin);
     }
-#endif
 }
 
 void SetupSlackCrit::update_pin_slack(const AtomPinId pin, const tatum::SetupTimingAnalyzer& analyzer) {
@@ -71,7 +115,7 @@ void SetupSlackCrit::update_pin_slack(const AtomPinId pin, const tatum::SetupTim
     }
 }
 
-void SetupSlackCrit::update_criticalities(const tatum::TimingGraph& timing_graph, const tatum::SetupTimingAnalyzer& analyzer) {
+void SetupSlackCrit::update_criticalities(const tatum::TimingGraph& timing_graph, const tatum::SetupTimingAnalyzer& analyzer, bool incremental) {
     //Record the maximum required time, and wost slack per domain pair
     std::map<DomainPair, float> max_req;
     std::map<DomainPair, float> worst_slack;
@@ -95,17 +139,19 @@ void SetupSlackCrit::update_criticalities(const tatum::TimingGraph& timing_graph
         }
     }
 
-    //Update the criticalities of each pin
-    auto pins = netlist_.pins();
-#if defined(VPR_USE_TBB)
-    tbb::parallel_for_each(pins.begin(), pins.end(), [&, this](auto pin) {
+    auto update_pin = [&, this](AtomPinId pin) {
         this->pin_criticalities_[pin] = this->calc_pin_criticality(pin, analyzer, max_req, worst_slack);
-    });
-#else
-    for (auto pin : pins) {
-        pin_criticalities_[pin] = calc_pin_criticality(pin, analyzer, max_req, worst_slack);
+    };
+
+    //The criticalities of the unmodified pins only remain valid if the normalization is unchanged
+    if (incremental && max_req == max_req_ && worst_slack == worst_slack_) {
+        for_each_pin(modified_pins_, update_pin);
+    } else {
+        for_each_pin(netlist_.pins(), update_pin);
+
+        max_req_ = std::move(max_req);
+        worst_slack_ = std::move(worst_slack);
     }
-#endif
 }
 
 float SetupSlackCrit::calc_pin_criticality(AtomPinId pin,
@@ -140,20 +186,29 @@ float HoldSlackCrit::hold_pin_slack(AtomPinId pin) const { return pin_slacks_[pi
 float HoldSlackCrit::hold_pin_criticality(AtomPinId pin) const { return pin_criticalities_[pin]; }
 
 void HoldSlackCrit::update_slacks_and_criticalities(const tatum::TimingGraph& timing_graph, const tatum::HoldTimingAnalyzer& analyzer) {
+    //After an incremental timing update only the pins of the modified timing nodes may have changed
+    bool incremental = collect_modified_pins(netlist_lookup_, timing_graph, analyzer, modified_pins_);
+
 #if defined(VPR_USE_TBB)
     tbb::task_group g;
-    g.run([&] { update_slacks(analyzer); });
-    g.run([&] { update_criticalities(timing_graph, analyzer); });
+    g.run([&] { update_slacks(analyzer, incremental); });
+    g.run([&] { update_criticalities(timing_graph, analyzer, incremental); });
     g.wait();
 #else
-    update_slacks(analyzer);
-    update_criticalities(timing_graph, analyzer);
+    update_slacks(analyzer, incremental);
+    update_criticalities(timing_graph, analyzer, incremental);
 #endif
 }
 
-void HoldSlackCrit::update_slacks(const tatum::HoldTimingAnalyzer& analyzer) {
-    for (AtomPinId pin : netlist_.pins()) {
-        update_pin_slack(pin, analyzer);
+void HoldSlackCrit::update_slacks(const tatum::HoldTimingAnalyzer& analyzer, bool incremental) {
+    if (incremental) {
+        for (AtomPinId pin : modified_pins_) {
+            update_pin_slack(pin, analyzer);
+        }
+    } else {
+        for (AtomPinId pin : netlist_.pins()) {
+            update_pin_slack(pin, analyzer);
+        }
     }
 }
 
@@ -173,7 +228,7 @@ void HoldSlackCrit::update_pin_slack(const AtomPinId pin, const tatum::HoldTimin
     }
 }
 
-void HoldSlackCrit::update_criticalities(const tatum::TimingGraph& timing_graph, const tatum::HoldTimingAnalyzer& analyzer) {
+void HoldSlackCrit::update_criticalities(const tatum::TimingGraph& timing_graph, const tatum::HoldTimingAnalyzer& analyzer, bool incremental) {
     //TODO: this calculates a simple shifted and scaled criticality, not clear if this is the
     //right approach (e.g. should we use a more intellegent method like the one used by setup slack?)
     float worst_slack = std::numeric_limits<float>::infinity();
@@ -192,17 +247,19 @@ void HoldSlackCrit::update_criticalities(const tatum::TimingGraph& timing_graph,
     float scale = 1. / std::abs(best_slack - worst_slack);
     float shift = -worst_slack;
 
-    //Update the criticalities of each pin
-    auto pins = netlist_.pins();
-#if defined(VPR_USE_TBB)
-    tbb::parallel_for_each(pins.begin(), pins.end(), [&, this](auto pin) {
+    auto update_pin = [&, this](AtomPinId pin) {
         this->pin_criticalities_[pin] = this->calc_pin_criticality(pin, analyzer, scale, shift);
-    });
-#else
-    for (auto pin : pins) {
-        pin_criticalities_[pin] = calc_pin_criticality(pin, analyzer, scale, shift);
+    };
+
+    //The criticalities of the unmodified pins only remain valid if the normalization is unchanged
+    if (incremental && scale == scale_ && shift == shift_) {
+        for_each_pin(modified_pins_, update_pin);
+    } else {
+        for_each_pin(netlist_.pins(), update_pin);
+
+        scale_ = scale;
+        shift_ = shift;
     }
-#endif
 }
 
 float HoldSlackCrit::calc_pin_criticality(AtomPinId pin,
@@ -1,6 +1,8 @@
 #ifndef VPR_SLACK_EVALUATOR
 #define VPR_SLACK_EVALUATOR
+#include <cmath>
 #include <map>
+#include <vector>
 #include "atom_netlist_fwd.h"
 #include "DomainPair.h"
 #include "tatum/timing_analyzers.hpp"
@@ -23,11 +25,11 @@ class SetupSlackCrit {
     void update_slacks_and_criticalities(const tatum::TimingGraph& timing_graph, const tatum::SetupTimingAnalyzer& analyzer);
 
   private: //Implementation
-    void update_slacks(const tatum::SetupTimingAnalyzer& analyzer);
+    void update_slacks(const tatum::SetupTimingAnalyzer& analyzer, bool incremental);
 
     void update_pin_slack(const AtomPinId pin, const tatum::SetupTimingAnalyzer& analyzer);
 
-    void update_criticalities(const tatum::TimingGraph& timing_graph, const tatum::SetupTimingAnalyzer& analyzer);
+    void update_criticalities(const tatum::TimingGraph& timing_graph, const tatum::SetupTimingAnalyzer& analyzer, bool incremental);
 
     float calc_pin_criticality(AtomPinId pin,
                                const tatum::SetupTimingAnalyzer& analyzer,
@@ -40,6 +42,13 @@ class SetupSlackCrit {
 
     vtr::vector<AtomPinId, float> pin_slacks_;
     vtr::vector<AtomPinId, float> pin_criticalities_;
+
+    //Pins of the timing nodes modified by the last incremental timing update
+    std::vector<AtomPinId> modified_pins_;
+
+    //Criticality normalization of the current pin criticalities
+    std::map<DomainPair, float> max_req_;
+    std::map<DomainPair, float> worst_slack_;
 };
 
 //TODO: implement a HoldSlackCrit class for hold analysis
@@ -61,11 +70,11 @@ class HoldSlackCrit {
     void update_slacks_and_criticalities(const tatum::TimingGraph& timing_graph, const tatum::HoldTimingAnalyzer& analyzer);
 
   private: //Implementation
-    void update_slacks(const tatum::HoldTimingAnalyzer& analyzer);
+    void update_slacks(const tatum::HoldTimingAnalyzer& analyzer, bool incremental);
 
     void update_pin_slack(const AtomPinId pin, const tatum::HoldTimingAnalyzer& analyzer);
 
-    void update_criticalities(const tatum::TimingGraph& timing_graph, const tatum::HoldTimingAnalyzer& analyzer);
+    void update_criticalities(const tatum::TimingGraph& timing_graph, const tatum::HoldTimingAnalyzer& analyzer, bool incremental);
 
     float calc_pin_criticality(AtomPinId pin,
                                const tatum::HoldTimingAnalyzer& analyzer,
@@ -78,6 +87,13 @@ class HoldSlackCrit {
 
     vtr::vector<AtomPinId, float> pin_slacks_;
     vtr::vector<AtomPinId, float> pin_criticalities_;
+
+    //Pins of the timing nodes modified by the last incremental timing update
+    std::vector<AtomPinId> modified_pins_;
+
+    //Criticality normalization of the current pin criticalities
+    float scale_ = NAN;
+    float shift_ = NAN;
 };
 
 #endif
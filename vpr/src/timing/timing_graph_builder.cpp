@@ -1,6 +1,13 @@
+#include <limits>
 #include <set>
+#include <unordered_map>
+
+#if defined(VPR_USE_TBB)
+#    include <tbb/parallel_for.h>
+#endif
 
 #include "vtr_log.h"
+#include "vtr_util.h"
 #include "vtr_linear_map.h"
 
 #include "timing_graph_builder.h"
@@ -16,6 +23,9 @@ using tatum::NodeId;
 using tatum::NodeType;
 using tatum::TimingGraph;
 
+//Placeholder for the pins without a tnode of some kind in TimingGraphBuilder::plan_block_timing_graph()
+constexpr size_t NO_BLOCK_TNODE = std::numeric_limits<size_t>::max();
+
 template<class K, class V>
 tatum::util::linear_map<K, V> remap_valid(const tatum::util::linear_map<K, V>& data, const tatum::util::linear_map<K, K>& id_map) {
     tatum::util::linear_map<K, V> new_data;
@@ -57,13 +67,33 @@ void TimingGraphBuilder::build(bool allow_dangling_combinational_nodes) {
     // Set by `--allow_dangling_combinational_nodes on`. Default value is false
     tg_->set_allow_dangling_combinational_nodes(allow_dangling_combinational_nodes);
 
-    for (AtomBlockId blk : netlist_.blocks()) {
+    //The nodes and edges of the primitives are found in parallel (which only reads the netlist),
+    //and then added to the timing graph in netlist order, so the timing graph is the same whatever
+    //the number of threads
+    std::vector<AtomBlockId> blocks(netlist_.blocks().begin(), netlist_.blocks().end());
+    std::vector<t_block_timing_graph> block_tgs(blocks.size());
+    auto plan_block = [&](size_t iblk) {
+        if (netlist_.block_type(blocks[iblk]) == AtomBlockType::BLOCK) {
+            block_tgs[iblk] = plan_block_timing_graph(blocks[iblk]);
+        }
+    };
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for(size_t(0), blocks.size(), plan_block);
+#else
+    for (size_t iblk = 0; iblk < blocks.size(); ++iblk) {
+        plan_block(iblk);
+    }
+#endif
+
+    for (size_t iblk = 0; iblk < blocks.size(); ++iblk) {
+        AtomBlockId blk = blocks[iblk];
         AtomBlockType blk_type = netlist_.block_type(blk);
 
         if (blk_type == AtomBlockType::INPAD || blk_type == AtomBlockType::OUTPAD) {
             add_io_to_timing_graph(blk);
         } else if (blk_type == AtomBlockType::BLOCK) {
-            add_block_to_timing_graph(blk);
+            add_block_to_timing_graph(block_tgs[iblk]);
+            block_tgs[iblk] = t_block_timing_graph();
         } else {
             VPR_FATAL_ERROR(VPR_ERROR_TIMING, "Unrecognized atom block type while constructing timing graph");
         }
@@ -116,7 +146,31 @@ void TimingGraphBuilder::add_io_to_timing_graph(const AtomBlockId blk) {
     netlist_lookup_.set_atom_pin_tnode(pin, tnode);
 }
 
-void TimingGraphBuilder::add_block_to_timing_graph(const AtomBlockId blk) {
+TimingGraphBuilder::t_block_timing_graph TimingGraphBuilder::plan_block_timing_graph(const AtomBlockId blk) const {
+    t_block_timing_graph block_tg;
+
+    //Index of the tnodes of each pin in block_tg.nodes
+    std::unordered_map<AtomPinId, size_t> external_tnodes;
+    std::unordered_map<AtomPinId, size_t> internal_tnodes;
+
+    auto add_node = [&](NodeType type) {
+        block_tg.nodes.push_back(type);
+        return block_tg.nodes.size() - 1;
+    };
+    auto set_pin_tnode = [&](AtomPinId pin, size_t tnode, BlockTnode blk_tnode_type) {
+        block_tg.pin_tnodes.push_back({pin, tnode, blk_tnode_type});
+        if (blk_tnode_type == BlockTnode::EXTERNAL) {
+            external_tnodes[pin] = tnode;
+        } else {
+            internal_tnodes[pin] = tnode;
+        }
+    };
+    auto find_pin_tnode = [&](AtomPinId pin, BlockTnode blk_tnode_type) {
+        const auto& tnodes = (blk_tnode_type == BlockTnode::EXTERNAL) ? external_tnodes : internal_tnodes;
+        auto itr = tnodes.find(pin);
+        return (itr != tnodes.end()) ? itr->second : NO_BLOCK_TNODE;
+    };
+
     std::set<std::string> output_ports_used_as_combinational_sinks;
 
     //Create the input pins
@@ -126,24 +180,24 @@ void TimingGraphBuilder::add_block_to_timing_graph(const AtomBlockId blk) {
         //Inspect the port model to determine pin type
         const t_model_ports* model_port = netlist_.port_model(input_port);
 
-        NodeId tnode;
+        size_t tnode;
         VTR_ASSERT(!model_port->is_clock);
         if (model_port->clock.empty()) {
             //No clock => combinational input
-            tnode = tg_->add_node(NodeType::IPIN);
+            tnode = add_node(NodeType::IPIN);
 
             //A combinational pin is really both internal and external, mark it internal here
             //and external in the default case below
-            netlist_lookup_.set_atom_pin_tnode(input_pin, tnode, BlockTnode::INTERNAL);
+            set_pin_tnode(input_pin, tnode, BlockTnode::INTERNAL);
         } else {
-            tnode = tg_->add_node(NodeType::SINK);
+            tnode = add_node(NodeType::SINK);
 
             if (!model_port->combinational_sink_ports.empty()) {
                 //There is an internal combinational connection starting at this sequential input
 
                 //Create the internal source
-                NodeId internal_tnode = tg_->add_node(NodeType::SOURCE);
-                netlist_lookup_.set_atom_pin_tnode(input_pin, internal_tnode, BlockTnode::INTERNAL);
+                size_t internal_tnode = add_node(NodeType::SOURCE);
+                set_pin_tnode(input_pin, internal_tnode, BlockTnode::INTERNAL);
             }
         }
 
@@ -152,7 +206,7 @@ void TimingGraphBuilder::add_block_to_timing_graph(const AtomBlockId blk) {
                                                         model_port->combinational_sink_ports.end());
 
         //Save the pin to external tnode mapping
-        netlist_lookup_.set_atom_pin_tnode(input_pin, tnode);
+        set_pin_tnode(input_pin, tnode, BlockTnode::EXTERNAL);
     }
 
     //Create the clock pins
@@ -165,23 +219,23 @@ void TimingGraphBuilder::add_block_to_timing_graph(const AtomBlockId blk) {
         VTR_ASSERT(model_port->is_clock);
         VTR_ASSERT(model_port->clock.empty());
 
-        NodeId tnode = tg_->add_node(NodeType::CPIN);
+        size_t tnode = add_node(NodeType::CPIN);
 
-        netlist_lookup_.set_atom_pin_tnode(clock_pin, tnode);
+        set_pin_tnode(clock_pin, tnode, BlockTnode::EXTERNAL);
     }
 
     //Create the output pins
-    std::set<tatum::NodeId> clock_generator_tnodes;
+    std::set<size_t> clock_generator_tnodes;
     for (AtomPinId output_pin : netlist_.block_output_pins(blk)) {
         AtomPortId output_port = netlist_.pin_port(output_pin);
 
         //Inspect the port model to determine pin type
         const t_model_ports* model_port = netlist_.port_model(output_port);
 
-        NodeId tnode;
+        size_t tnode;
         if (is_netlist_clock_source(output_pin)) {
             //A generated clock source
-            tnode = tg_->add_node(NodeType::SOURCE);
+            tnode = add_node(NodeType::SOURCE);
 
             clock_generator_tnodes.insert(tnode);
 
@@ -189,51 +243,51 @@ void TimingGraphBuilder::add_block_to_timing_graph(const AtomBlockId blk) {
                 //An implicit clock source, possibly clock derived from data
 
                 AtomNetId clock_net = netlist_.pin_net(output_pin);
-                VTR_LOG_WARN("Inferred implicit clock source %s for netlist clock %s (possibly data used as clock)\n",
-                             netlist_.pin_name(output_pin).c_str(), netlist_.net_name(clock_net).c_str());
+                block_tg.warnings.push_back(vtr::string_fmt("Inferred implicit clock source %s for netlist clock %s (possibly data used as clock)\n",
+                                                            netlist_.pin_name(output_pin).c_str(), netlist_.net_name(clock_net).c_str()));
 
                 //This type of situation often requires cutting paths between the implicit clock source and
                 //it's inputs which can cause dangling combinational nodes. Do not error if this occurs.
-                tg_->set_allow_dangling_combinational_nodes(true);
+                block_tg.allow_dangling_combinational_nodes = true;
             }
         } else {
             VTR_ASSERT_MSG(!model_port->is_clock, "Primitive data output can not be a clock generator");
 
             if (model_port->clock.empty()) {
                 //No clock => combinational output
-                tnode = tg_->add_node(NodeType::OPIN);
+                tnode = add_node(NodeType::OPIN);
 
                 //A combinational pin is really both internal and external, mark it internal here
                 //and external in the default case below
-                netlist_lookup_.set_atom_pin_tnode(output_pin, tnode, BlockTnode::INTERNAL);
+                set_pin_tnode(output_pin, tnode, BlockTnode::INTERNAL);
 
             } else {
                 VTR_ASSERT(!model_port->clock.empty());
                 //Has an associated clock => sequential output
-                tnode = tg_->add_node(NodeType::SOURCE);
+                tnode = add_node(NodeType::SOURCE);
 
                 if (output_ports_used_as_combinational_sinks.count(model_port->name)) {
                     //There is a combinational path within the primitive terminating at this sequential output
 
                     //Create the internal sink node
-                    NodeId internal_tnode = tg_->add_node(NodeType::SINK);
-                    netlist_lookup_.set_atom_pin_tnode(output_pin, internal_tnode, BlockTnode::INTERNAL);
+                    size_t internal_tnode = add_node(NodeType::SINK);
+                    set_pin_tnode(output_pin, internal_tnode, BlockTnode::INTERNAL);
                 }
             }
         }
 
-        netlist_lookup_.set_atom_pin_tnode(output_pin, tnode);
+        set_pin_tnode(output_pin, tnode, BlockTnode::EXTERNAL);
     }
 
     //Connect the clock pins to the sources and sinks
     for (AtomPinId pin : netlist_.block_pins(blk)) {
         for (auto blk_tnode_type : {BlockTnode::EXTERNAL, BlockTnode::INTERNAL}) {
-            NodeId tnode = netlist_lookup_.atom_pin_tnode(pin, blk_tnode_type);
-            if (!tnode) continue;
+            size_t tnode = find_pin_tnode(pin, blk_tnode_type);
+            if (tnode == NO_BLOCK_TNODE) continue;
 
             if (clock_generator_tnodes.count(tnode)) continue; //Clock sources don't have incomming clock pin connections
 
-            auto node_type = tg_->node_type(tnode);
+            auto node_type = block_tg.nodes[tnode];
 
             if (node_type == NodeType::SOURCE || node_type == NodeType::SINK) {
                 //Look-up the clock name on the port model
@@ -251,7 +305,7 @@ void TimingGraphBuilder::add_block_to_timing_graph(const AtomBlockId blk) {
                 VTR_ASSERT(clk_pin);
 
                 //Convert the pin to it's tnode
-                NodeId clk_tnode = netlist_lookup_.atom_pin_tnode(clk_pin);
+                size_t clk_tnode = find_pin_tnode(clk_pin, BlockTnode::EXTERNAL);
 
                 tatum::EdgeType type;
                 if (node_type == NodeType::SOURCE) {
@@ -262,7 +316,7 @@ void TimingGraphBuilder::add_block_to_timing_graph(const AtomBlockId blk) {
                 }
 
                 //Add the edge from the clock to the source/sink
-                tg_->add_edge(type, clk_tnode, tnode);
+                block_tg.edges.push_back({type, clk_tnode, tnode});
             }
         }
     }
@@ -274,10 +328,10 @@ void TimingGraphBuilder::add_block_to_timing_graph(const AtomBlockId blk) {
         //
         //We have already marked all internal SOURCE/SINK nodes internal, and all IPIN/OPIN nodes as internal
         //so we only need to look at tnode's of that class
-        NodeId src_tnode = netlist_lookup_.atom_pin_tnode(src_pin, BlockTnode::INTERNAL);
+        size_t src_tnode = find_pin_tnode(src_pin, BlockTnode::INTERNAL);
 
-        if (src_tnode) {
-            auto src_type = tg_->node_type(src_tnode);
+        if (src_tnode != NO_BLOCK_TNODE) {
+            auto src_type = block_tg.nodes[src_tnode];
 
             //Look-up the combinationally connected sink ports name on the port model
             AtomPortId src_port = netlist_.pin_port(src_pin);
@@ -291,28 +345,29 @@ void TimingGraphBuilder::add_block_to_timing_graph(const AtomBlockId blk) {
                 //output port
                 for (AtomPinId sink_pin : netlist_.port_pins(sink_port)) {
                     //Get the tnode of the sink
-                    NodeId sink_tnode = netlist_lookup_.atom_pin_tnode(sink_pin, BlockTnode::INTERNAL);
+                    size_t sink_tnode = find_pin_tnode(sink_pin, BlockTnode::INTERNAL);
 
-                    if (!sink_tnode) {
+                    if (sink_tnode == NO_BLOCK_TNODE) {
                         //No tnode found, either a combinational clock generator or an error
 
                         //Try again looking for an external tnode
-                        sink_tnode = netlist_lookup_.atom_pin_tnode(sink_pin, BlockTnode::EXTERNAL);
+                        sink_tnode = find_pin_tnode(sink_pin, BlockTnode::EXTERNAL);
 
                         //Is the sink a clock generator?
-                        if (sink_tnode && clock_generator_tnodes.count(sink_tnode)) {
+                        if (sink_tnode != NO_BLOCK_TNODE && clock_generator_tnodes.count(sink_tnode)) {
                             //Do not create the edge
-                            VTR_LOG_WARN("Timing edge from %s to %s will not be created since %s has been identified as a clock generator\n",
-                                         netlist_.pin_name(src_pin).c_str(), netlist_.pin_name(sink_pin).c_str(), netlist_.pin_name(sink_pin).c_str());
+                            block_tg.warnings.push_back(vtr::string_fmt("Timing edge from %s to %s will not be created since %s has been identified as a clock generator\n",
+                                                                        netlist_.pin_name(src_pin).c_str(), netlist_.pin_name(sink_pin).c_str(), netlist_.pin_name(sink_pin).c_str()));
                         } else {
                             //Unknown
-                            VPR_FATAL_ERROR(VPR_ERROR_TIMING, "Unable to find matching sink tnode for timing edge from %s to %s",
-                                            netlist_.pin_name(src_pin).c_str(), netlist_.pin_name(src_pin).c_str());
+                            block_tg.error = vtr::string_fmt("Unable to find matching sink tnode for timing edge from %s to %s",
+                                                             netlist_.pin_name(src_pin).c_str(), netlist_.pin_name(src_pin).c_str());
+                            return block_tg;
                         }
 
                     } else {
                         //Valid tnode create the edge
-                        auto sink_type = tg_->node_type(sink_tnode);
+                        auto sink_type = block_tg.nodes[sink_tnode];
 
                         VTR_ASSERT_MSG((src_type == NodeType::IPIN && sink_type == NodeType::OPIN)
                                            || (src_type == NodeType::SOURCE && sink_type == NodeType::SINK)
@@ -321,7 +376,7 @@ void TimingGraphBuilder::add_block_to_timing_graph(const AtomBlockId blk) {
                                        "Internal primitive combinational edges must be between {IPIN, SOURCE} and {OPIN, SINK}");
 
                         //Add the edge between the pins
-                        tg_->add_edge(tatum::EdgeType::PRIMITIVE_COMBINATIONAL, src_tnode, sink_tnode);
+                        block_tg.edges.push_back({tatum::EdgeType::PRIMITIVE_COMBINATIONAL, src_tnode, sink_tnode});
                     }
                 }
             }
@@ -332,9 +387,9 @@ void TimingGraphBuilder::add_block_to_timing_graph(const AtomBlockId blk) {
     //
     //These are typically used to represent clock buffers
     for (AtomPinId src_clock_pin : netlist_.block_clock_pins(blk)) {
-        NodeId src_tnode = netlist_lookup_.atom_pin_tnode(src_clock_pin, BlockTnode::EXTERNAL);
+        size_t src_tnode = find_pin_tnode(src_clock_pin, BlockTnode::EXTERNAL);
 
-        if (!src_tnode) continue;
+        if (src_tnode == NO_BLOCK_TNODE) continue;
 
         //Look-up the combinationally connected sink ports name on the port model
         AtomPortId src_port = netlist_.pin_port(src_clock_pin);
@@ -348,13 +403,46 @@ void TimingGraphBuilder::add_block_to_timing_graph(const AtomBlockId blk) {
             //output port
             for (AtomPinId sink_pin : netlist_.port_pins(sink_port)) {
                 //Get the tnode of the sink
-                NodeId sink_tnode = netlist_lookup_.atom_pin_tnode(sink_pin, BlockTnode::EXTERNAL);
+                size_t sink_tnode = find_pin_tnode(sink_pin, BlockTnode::EXTERNAL);
 
-                tg_->add_edge(tatum::EdgeType::PRIMITIVE_COMBINATIONAL, src_tnode, sink_tnode);
-                VTR_LOG("Adding edge from '%s' (%zu) -> '%s' (%zu)\n", netlist_.pin_name(src_clock_pin).c_str(), size_t(src_tnode), netlist_.pin_name(sink_pin).c_str(), size_t(sink_tnode));
+                block_tg.edges.push_back({tatum::EdgeType::PRIMITIVE_COMBINATIONAL, src_tnode, sink_tnode, src_clock_pin, sink_pin});
             }
         }
     }
+
+    return block_tg;
+}
+
+void TimingGraphBuilder::add_block_to_timing_graph(const t_block_timing_graph& block_tg) {
+    for (const std::string& warning : block_tg.warnings) {
+        VTR_LOG_WARN("%s", warning.c_str());
+    }
+    if (block_tg.allow_dangling_combinational_nodes) {
+        tg_->set_allow_dangling_combinational_nodes(true);
+    }
+    if (!block_tg.error.empty()) {
+        VPR_FATAL_ERROR(VPR_ERROR_TIMING, "%s", block_tg.error.c_str());
+    }
+
+    std::vector<NodeId> tnodes;
+    tnodes.reserve(block_tg.nodes.size());
+    for (NodeType node_type : block_tg.nodes) {
+        tnodes.push_back(tg_->add_node(node_type));
+    }
+
+    for (const auto& pin_tnode : block_tg.pin_tnodes) {
+        netlist_lookup_.set_atom_pin_tnode(pin_tnode.pin, tnodes[pin_tnode.tnode], pin_tnode.blk_tnode_type);
+    }
+
+    for (const auto& edge : block_tg.edges) {
+        NodeId src_tnode = tnodes[edge.src_tnode];
+        NodeId sink_tnode = tnodes[edge.sink_tnode];
+        tg_->add_edge(edge.type, src_tnode, sink_tnode);
+
+        if (edge.src_clock_pin) {
+            VTR_LOG("Adding edge from '%s' (%zu) -> '%s' (%zu)\n", netlist_.pin_name(edge.src_clock_pin).c_str(), size_t(src_tnode), netlist_.pin_name(edge.sink_pin).c_str(), size_t(sink_tnode));
+        }
+    }
 }
 
 void TimingGraphBuilder::add_net_to_timing_graph(const AtomNetId net) {
@@ -1,4 +1,6 @@
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "tatum/TimingGraphFwd.hpp"
 
@@ -12,12 +14,42 @@ class TimingGraphBuilder {
 
     std::unique_ptr<tatum::TimingGraph> timing_graph(bool allow_dangling_combinational_nodes);
 
+  private:
+    //The timing graph nodes and edges of a primitive, in creation order.
+    //Nodes are referred to by their index in nodes
+    struct t_block_timing_graph {
+        struct t_pin_tnode {
+            AtomPinId pin;
+            size_t tnode;
+            BlockTnode blk_tnode_type;
+        };
+
+        struct t_edge {
+            tatum::EdgeType type;
+            size_t src_tnode;
+            size_t sink_tnode;
+
+            //Set for the combinational edges from clock pins, which are logged
+            AtomPinId src_clock_pin = AtomPinId::INVALID();
+            AtomPinId sink_pin = AtomPinId::INVALID();
+        };
+
+        std::vector<tatum::NodeType> nodes;
+        std::vector<t_pin_tnode> pin_tnodes;
+        std::vector<t_edge> edges;
+
+        std::vector<std::string> warnings;
+        bool allow_dangling_combinational_nodes = false;
+        std::string error; //Non-empty if the primitive can not be added to the timing graph
+    };
+
   private:
     void build(bool allow_dangling_combinational_nodes);
     void opt_memory_layout();
 
     void add_io_to_timing_graph(const AtomBlockId blk);
-    void add_block_to_timing_graph(const AtomBlockId blk);
+    t_block_timing_graph plan_block_timing_graph(const AtomBlockId blk) const;
+    void add_block_to_timing_graph(const t_block_timing_graph& block_tg);
     void add_net_to_timing_graph(const AtomNetId net);
 
     void fix_comb_loops();
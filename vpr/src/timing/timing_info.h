@@ -41,6 +41,13 @@ class TimingInfo {
     //Update all timing information
     virtual void update() = 0;
 
+    //Marks the delay of a timing graph edge as changed since the last update, so the
+    //next update only needs to re-analyze the timing graph around the invalidated edges.
+    //
+    //Either all the edges whose delays changed should be invalidated, or none of them
+    //(in which case the next update re-analyzes the whole timing graph)
+    virtual void invalidate_delay(const tatum::EdgeId edge) = 0;
+
     //Return the underlying timing analyzer
     virtual std::shared_ptr<const tatum::TimingAnalyzer> analyzer() const = 0;
 
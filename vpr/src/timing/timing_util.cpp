@@ -59,7 +59,7 @@ float find_setup_total_negative_slack(const tatum::SetupTimingAnalyzer& setup_an
     float tns = 0.;
     for (tatum::NodeId node : timing_ctx.graph->logical_outputs()) {
         for (tatum::TimingTag tag : setup_analyzer.setup_slacks(node)) {
-            float slack = tag.time().value();
+            float slack = tag.time().min_value();
             if (slack < 0.) {
                 tns += slack;
             }
@@ -74,7 +74,7 @@ float find_setup_worst_negative_slack(const tatum::SetupTimingAnalyzer& setup_an
     float wns = 0.;
     for (tatum::NodeId node : timing_ctx.graph->logical_outputs()) {
         for (tatum::TimingTag tag : setup_analyzer.setup_slacks(node)) {
-            float slack = tag.time().value();
+            float slack = tag.time().min_value();
 
             if (slack < 0.) {
                 wns = std::min(wns, slack);
@@ -104,7 +104,7 @@ std::vector<HistogramBucket> create_setup_slack_histogram(const tatum::SetupTimi
     float max_slack = -std::numeric_limits<float>::infinity();
     for (tatum::NodeId node : timing_ctx.graph->logical_outputs()) {
         for (tatum::TimingTag tag : setup_analyzer.setup_slacks(node)) {
-            float slack = tag.time().value();
+            float slack = tag.time().min_value();
 
             min_slack = std::min(min_slack, slack);
             max_slack = std::max(max_slack, slack);
@@ -135,7 +135,7 @@ std::vector<HistogramBucket> create_setup_slack_histogram(const tatum::SetupTimi
 
     for (tatum::NodeId node : timing_ctx.graph->logical_outputs()) {
         for (tatum::TimingTag tag : setup_analyzer.setup_slacks(node)) {
-            float slack = tag.time().value();
+            float slack = tag.time().min_value();
 
             //Find the bucket who's max is less than the current slack
 
@@ -163,6 +163,9 @@ void print_setup_timing_summary(const tatum::TimingConstraints& constraints, con
     }
     VTR_LOG("\n");
 
+    if (tatum::Time::num_corners() > 1) {
+        VTR_LOG("Setup slacks are the worst across %zu timing corners\n", tatum::Time::num_corners());
+    }
     VTR_LOG("Setup Worst Negative Slack (sWNS): %g ns\n", sec_to_nanosec(find_setup_worst_negative_slack(setup_analyzer)));
     VTR_LOG("Setup Total Negative Slack (sTNS): %g ns\n", sec_to_nanosec(find_setup_total_negative_slack(setup_analyzer)));
     VTR_LOG("\n");
@@ -272,7 +275,7 @@ float find_hold_total_negative_slack(const tatum::HoldTimingAnalyzer& hold_analy
     float tns = 0.;
     for (tatum::NodeId node : timing_ctx.graph->logical_outputs()) {
         for (tatum::TimingTag tag : hold_analyzer.hold_slacks(node)) {
-            float slack = tag.time().value();
+            float slack = tag.time().min_value();
             if (slack < 0.) {
                 tns += slack;
             }
@@ -357,7 +360,7 @@ float find_hold_worst_negative_slack(const tatum::HoldTimingAnalyzer& hold_analy
     float wns = 0.;
     for (tatum::NodeId node : timing_ctx.graph->logical_outputs()) {
         for (tatum::TimingTag tag : hold_analyzer.hold_slacks(node)) {
-            float slack = tag.time().value();
+            float slack = tag.time().min_value();
 
             if (slack < 0.) {
                 wns = std::min(wns, slack);
@@ -393,7 +396,7 @@ std::vector<HistogramBucket> create_hold_slack_histogram(const tatum::HoldTiming
     float max_slack = -std::numeric_limits<float>::infinity();
     for (tatum::NodeId node : timing_ctx.graph->logical_outputs()) {
         for (tatum::TimingTag tag : hold_analyzer.hold_slacks(node)) {
-            float slack = tag.time().value();
+            float slack = tag.time().min_value();
 
             min_slack = std::min(min_slack, slack);
             max_slack = std::max(max_slack, slack);
@@ -424,7 +427,7 @@ std::vector<HistogramBucket> create_hold_slack_histogram(const tatum::HoldTiming
 
     for (tatum::NodeId node : timing_ctx.graph->logical_outputs()) {
         for (tatum::TimingTag tag : hold_analyzer.hold_slacks(node)) {
-            float slack = tag.time().value();
+            float slack = tag.time().min_value();
 
             //Find the bucket who's max is less than the current slack
             auto iter = std::lower_bound(histogram.begin(), histogram.end(), slack, comp);
@@ -439,6 +442,9 @@ std::vector<HistogramBucket> create_hold_slack_histogram(const tatum::HoldTiming
 }
 
 void print_hold_timing_summary(const tatum::TimingConstraints& constraints, const tatum::HoldTimingAnalyzer& hold_analyzer) {
+    if (tatum::Time::num_corners() > 1) {
+        VTR_LOG("Hold slacks are the worst across %zu timing corners\n", tatum::Time::num_corners());
+    }
     VTR_LOG("Hold Worst Negative Slack (hWNS): %g ns\n", sec_to_nanosec(find_hold_worst_negative_slack(hold_analyzer)));
     VTR_LOG("Hold Total Negative Slack (hTNS): %g ns\n", sec_to_nanosec(find_hold_total_negative_slack(hold_analyzer)));
     /*For testing*/
@@ -521,6 +527,36 @@ float calculate_clb_net_pin_criticality(const SetupTimingInfo& timing_info, cons
     return clb_pin_crit;
 }
 
+void invalidate_clb_net_timing_edges(TimingInfo& timing_info, ClusterNetId clb_net) {
+    auto& atom_ctx = g_vpr_ctx.atom();
+
+    AtomNetId atom_net = atom_ctx.lookup.atom_net(clb_net);
+    VTR_ASSERT(atom_net);
+
+    //The connections of the net are the out-going edges of its driver's timing node
+    AtomPinId driver_pin = atom_ctx.nlist.net_driver(atom_net);
+    tatum::NodeId driver_tnode = atom_ctx.lookup.atom_pin_tnode(driver_pin);
+    VTR_ASSERT(driver_tnode);
+
+    for (tatum::EdgeId edge : timing_info.timing_graph()->node_out_edges(driver_tnode)) {
+        timing_info.invalidate_delay(edge);
+    }
+}
+
+void invalidate_clb_connection_timing_edges(TimingInfo& timing_info, const ClusteredPinAtomPinsLookup& pin_lookup, ClusterPinId clb_sink_pin) {
+    auto& atom_ctx = g_vpr_ctx.atom();
+
+    //The connection is the in-coming (net) edge of the timing node of each atom pin it reaches
+    for (const AtomPinId atom_pin : pin_lookup.connected_atom_pins(clb_sink_pin)) {
+        tatum::NodeId sink_tnode = atom_ctx.lookup.atom_pin_tnode(atom_pin);
+        VTR_ASSERT(sink_tnode);
+
+        for (tatum::EdgeId edge : timing_info.timing_graph()->node_in_edges(sink_tnode)) {
+            timing_info.invalidate_delay(edge);
+        }
+    }
+}
+
 //Returns the worst (maximum) criticality of the set of slack tags specified. Requires the maximum
 //required time and worst slack for all domain pairs represent by the slack tags
 //
@@ -26,6 +26,9 @@ tatum::TimingPathInfo find_longest_critical_path_delay(const tatum::TimingConstr
 //Returns the path delay of the least-slack critical timing path (i.e. across all domains)
 tatum::TimingPathInfo find_least_slack_critical_path_delay(const tatum::TimingConstraints& constraints, const tatum::SetupTimingAnalyzer& setup_analyzer);
 
+//Note: with multiple timing corners (see tatum::Time) the slack of each timing end-point used by the
+//functions below (negative slacks and histograms) is its worst slack across the corners
+
 //Returns the total negative slack (setup) of all timing end-points and clock domain pairs
 float find_setup_total_negative_slack(const tatum::SetupTimingAnalyzer& setup_analyzer);
 
@@ -79,6 +82,14 @@ std::map<tatum::DomainId, size_t> count_clock_fanouts(const tatum::TimingGraph&
 //Return the criticality of a net's pin in the CLB netlist
 float calculate_clb_net_pin_criticality(const SetupTimingInfo& timing_info, const ClusteredPinAtomPinsLookup& pin_lookup, ClusterPinId clb_pin);
 
+//Marks the delays of the timing graph edges of a CLB net as changed (e.g. after it was re-routed),
+//so the next timing update only re-analyzes the timing graph around them
+void invalidate_clb_net_timing_edges(TimingInfo& timing_info, ClusterNetId clb_net);
+
+//Marks the delays of the timing graph edges of a single connection (to the sink pin clb_sink_pin) of a CLB net
+//as changed (e.g. after one of its end points was moved by the placer)
+void invalidate_clb_connection_timing_edges(TimingInfo& timing_info, const ClusteredPinAtomPinsLookup& pin_lookup, ClusterPinId clb_sink_pin);
+
 //Returns the worst (maximum) criticality of the set of slack tags specified. Requires the maximum
 //required time and worst slack for all domain pairs represent by the slack tags
 //
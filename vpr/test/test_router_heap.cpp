@@ -0,0 +1,60 @@
+#include "catch.hpp"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "router_heap.h"
+#include "route_common.h"
+
+namespace {
+
+//Pops all the entries of the heap, and checks that they come out once each, by increasing cost
+static void check_pops(RouterHeap& heap, std::vector<t_heap>& nodes) {
+    std::set<t_heap*> popped;
+    float prev_cost = -1.;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        t_heap* hptr = heap.pop();
+        REQUIRE(hptr != nullptr);
+        CHECK(hptr->cost >= prev_cost);
+        CHECK(popped.insert(hptr).second);
+        prev_cost = hptr->cost;
+    }
+    CHECK(heap.empty());
+    CHECK(heap.pop() == nullptr);
+}
+
+TEST_CASE("router_heap_build_heap", "[vpr]") {
+    //Costs in an order where build_heap() moves most of the entries
+    std::vector<t_heap> nodes(20);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i].cost = float((i * 7) % nodes.size()) + (i % 3) * 0.5;
+    }
+
+    RouterHeap heap;
+    for (t_heap& node : nodes) {
+        heap.push_back(&node);
+    }
+    heap.build_heap();
+    REQUIRE(heap.is_valid());
+    REQUIRE(heap.size() == nodes.size());
+
+    check_pops(heap, nodes);
+}
+
+TEST_CASE("router_heap_push_pop", "[vpr]") {
+    std::vector<t_heap> nodes(100);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i].cost = float(nodes.size() - i);
+    }
+
+    RouterHeap heap;
+    for (t_heap& node : nodes) {
+        heap.push(&node);
+        REQUIRE(heap.is_valid());
+    }
+
+    check_pops(heap, nodes);
+}
+
+} // namespace